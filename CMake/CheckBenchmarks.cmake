@@ -0,0 +1,67 @@
+# CheckBenchmarks.cmake: a CMake script that runs every benchmark of
+# mlpack_benchmarks once and checks its JSON report.  This is the script of the
+# 'benchmarks_test' test; it does not time anything meaningful.
+#
+# This script depends on the following arguments:
+#
+#   BENCHMARKS: the mlpack_benchmarks executable.
+#   DATA_DIR: the directory holding the test datasets.
+#   WORK_DIR: a directory for the files written by the benchmarks.
+#
+# The check fails if the executable fails, if a benchmark is missing from the
+# report or did not run exactly one iteration, or if a benchmark was skipped.
+
+file(MAKE_DIRECTORY "${WORK_DIR}")
+set(jsonFile "${WORK_DIR}/benchmarks_test.json")
+file(REMOVE "${jsonFile}")
+
+execute_process(COMMAND "${BENCHMARKS}" --list
+    WORKING_DIRECTORY "${WORK_DIR}"
+    RESULT_VARIABLE result
+    OUTPUT_VARIABLE names
+    ERROR_VARIABLE err)
+if (NOT result EQUAL 0)
+  message(FATAL_ERROR "Fatal error listing the benchmarks: ${err}")
+endif ()
+string(STRIP "${names}" names)
+string(REPLACE "\n" ";" names "${names}")
+list(LENGTH names numBenchmarks)
+if (numBenchmarks EQUAL 0)
+  message(FATAL_ERROR "No benchmarks are registered.")
+endif ()
+
+execute_process(COMMAND "${BENCHMARKS}" --min-time=0 --max-iterations=1
+    "--json=${jsonFile}" "--data-dir=${DATA_DIR}"
+    WORKING_DIRECTORY "${WORK_DIR}"
+    RESULT_VARIABLE result
+    OUTPUT_QUIET
+    ERROR_VARIABLE err)
+if (NOT result EQUAL 0 OR NOT EXISTS "${jsonFile}")
+  message(FATAL_ERROR "Fatal error running ${BENCHMARKS}: ${err}")
+endif ()
+
+file(READ "${jsonFile}" report)
+if (NOT report MATCHES "^{\n  \"context\": {\n.*\n  \"benchmarks\": \\[.*\n  \\]\n}\n$")
+  message(FATAL_ERROR "The report of ${BENCHMARKS} is malformed:\n${report}")
+endif ()
+
+string(FIND "${report}" "\"error_occurred\"" errorIndex)
+if (NOT errorIndex EQUAL -1)
+  message(FATAL_ERROR "Some benchmarks were skipped:\n${report}")
+endif ()
+
+foreach (name ${names})
+  string(FIND "${report}" "\"name\": \"${name}\"," nameIndex)
+  if (nameIndex EQUAL -1)
+    message(FATAL_ERROR "Benchmark ${name} is missing from the report.")
+  endif ()
+endforeach ()
+
+string(REGEX MATCHALL "\"iterations\": 1," iterations "${report}")
+list(LENGTH iterations numIterations)
+if (NOT numIterations EQUAL numBenchmarks)
+  message(FATAL_ERROR "Expected ${numBenchmarks} benchmarks with one "
+      "iteration, found ${numIterations}:\n${report}")
+endif ()
+
+message(STATUS "All ${numBenchmarks} benchmarks ran.")
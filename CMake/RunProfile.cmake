@@ -0,0 +1,147 @@
+# RunProfile.cmake: a CMake script that runs a fixed set of mlpack programs on
+# the test datasets, and writes their timers (with hardware counters and memory
+# statistics, if mlpack was built to collect them) into one JSON report.  This
+# is the script of the 'profile' target.
+#
+# This script depends on the following arguments:
+#
+#   PROGRAM_DIR: the directory holding the mlpack programs.
+#   PROGRAM_SUFFIX: the suffix of executables on this platform.
+#   DATA_DIR: the directory holding the test datasets.
+#   WORK_DIR: a directory for the outputs of the programs.
+#   OUTPUT_FILE: the file to write the report to.
+#   REPETITIONS: the number of runs of each program.
+#   BENCHMARKS: the mlpack_benchmarks executable, or empty to skip it.
+#   SOURCE_DIR: the source directory, to record the git revision.
+#   BUILD_TYPE, PERF_COUNTERS, MEMORY_TRACKING: recorded in the report.
+#
+# The report maps each workload to the list of its runs; each run is the output
+# of the --timers_file option of the program.  The workloads use fixed seeds,
+# so the same build does the same work on every run.
+
+file(MAKE_DIRECTORY "${WORK_DIR}")
+
+# The workloads, each a program with its arguments.
+set(WORKLOADS knn kmeans kde decision_tree random_forest)
+set(WORKLOAD_knn mlpack_knn
+    --reference_file "${DATA_DIR}/thyroid_train.csv"
+    --k 10
+    --neighbors_file "${WORK_DIR}/knn_neighbors.csv"
+    --distances_file "${WORK_DIR}/knn_distances.csv")
+set(WORKLOAD_kmeans mlpack_kmeans
+    --input_file "${DATA_DIR}/thyroid_train.csv"
+    --clusters 10
+    --max_iterations 100
+    --seed 42
+    --centroid_file "${WORK_DIR}/kmeans_centroids.csv")
+set(WORKLOAD_kde mlpack_kde
+    --reference_file "${DATA_DIR}/thyroid_train.csv"
+    --bandwidth 0.5
+    --rel_error 0.01
+    --predictions_file "${WORK_DIR}/kde_predictions.csv")
+set(WORKLOAD_decision_tree mlpack_decision_tree
+    --training_file "${DATA_DIR}/vc2.csv"
+    --labels_file "${DATA_DIR}/vc2_labels.txt"
+    --test_file "${DATA_DIR}/vc2_test.csv"
+    --predictions_file "${WORK_DIR}/decision_tree_predictions.csv")
+set(WORKLOAD_random_forest mlpack_random_forest
+    --training_file "${DATA_DIR}/vc2.csv"
+    --labels_file "${DATA_DIR}/vc2_labels.txt"
+    --num_trees 50
+    --seed 42
+    --test_file "${DATA_DIR}/vc2_test.csv"
+    --predictions_file "${WORK_DIR}/random_forest_predictions.csv")
+
+# Record what was profiled.
+string(TIMESTAMP timestamp "%Y-%m-%dT%H:%M:%SZ" UTC)
+cmake_host_system_information(RESULT hostname QUERY HOSTNAME)
+cmake_host_system_information(RESULT cores QUERY NUMBER_OF_PHYSICAL_CORES)
+set(revision "unknown")
+find_package(Git QUIET)
+if (GIT_FOUND)
+  execute_process(COMMAND "${GIT_EXECUTABLE}" rev-parse HEAD
+      WORKING_DIRECTORY "${SOURCE_DIR}"
+      OUTPUT_VARIABLE gitRevision
+      RESULT_VARIABLE gitResult
+      OUTPUT_STRIP_TRAILING_WHITESPACE
+      ERROR_QUIET)
+  if (gitResult EQUAL 0)
+    set(revision "${gitRevision}")
+  endif ()
+endif ()
+
+set(report "{\n")
+set(report "${report}  \"revision\": \"${revision}\",\n")
+set(report "${report}  \"date\": \"${timestamp}\",\n")
+set(report "${report}  \"host\": \"${hostname}\",\n")
+set(report "${report}  \"physical_cores\": ${cores},\n")
+set(report "${report}  \"build_type\": \"${BUILD_TYPE}\",\n")
+set(report "${report}  \"perf_counters\": \"${PERF_COUNTERS}\",\n")
+set(report "${report}  \"memory_tracking\": \"${MEMORY_TRACKING}\",\n")
+set(report "${report}  \"repetitions\": ${REPETITIONS},\n")
+set(report "${report}  \"workloads\": {")
+
+set(firstWorkload TRUE)
+foreach (workload ${WORKLOADS})
+  message(STATUS "Profiling ${workload}...")
+  set(command ${WORKLOAD_${workload}})
+  list(GET command 0 program)
+  list(REMOVE_AT command 0)
+  set(timersFile "${WORK_DIR}/${workload}_timers.json")
+
+  set(runs "")
+  foreach (run RANGE 1 ${REPETITIONS})
+    file(REMOVE "${timersFile}")
+    execute_process(COMMAND "${PROGRAM_DIR}/${program}${PROGRAM_SUFFIX}"
+        ${command} --timers_file "${timersFile}"
+        RESULT_VARIABLE result
+        OUTPUT_QUIET
+        ERROR_VARIABLE err)
+    if (NOT result EQUAL 0 OR NOT EXISTS "${timersFile}")
+      message(FATAL_ERROR "Fatal error running ${program}: ${err}")
+    endif ()
+
+    # Indent the timers of the run inside the report.
+    file(READ "${timersFile}" timers)
+    string(STRIP "${timers}" timers)
+    string(REPLACE "\n" "\n      " timers "${timers}")
+    if (NOT runs STREQUAL "")
+      set(runs "${runs},\n      ${timers}")
+    else ()
+      set(runs "      ${timers}")
+    endif ()
+  endforeach ()
+
+  if (firstWorkload)
+    set(report "${report}\n")
+    set(firstWorkload FALSE)
+  else ()
+    set(report "${report},\n")
+  endif ()
+  set(report "${report}    \"${workload}\": [\n${runs}\n    ]")
+endforeach ()
+set(report "${report}\n  }")
+
+# The micro-benchmarks, including the training of a feedforward network, are
+# run by mlpack_benchmarks if it was built.
+if (BENCHMARKS)
+  message(STATUS "Running mlpack_benchmarks...")
+  set(benchmarksFile "${WORK_DIR}/benchmarks.json")
+  execute_process(COMMAND "${BENCHMARKS}" "--json=${benchmarksFile}"
+      "--data-dir=${DATA_DIR}"
+      RESULT_VARIABLE result
+      OUTPUT_QUIET
+      ERROR_VARIABLE err)
+  if (NOT result EQUAL 0)
+    message(FATAL_ERROR "Fatal error running ${BENCHMARKS}: ${err}")
+  endif ()
+
+  file(READ "${benchmarksFile}" benchmarks)
+  string(STRIP "${benchmarks}" benchmarks)
+  string(REPLACE "\n" "\n  " benchmarks "${benchmarks}")
+  set(report "${report},\n  \"benchmarks\": ${benchmarks}")
+endif ()
+
+set(report "${report}\n}\n")
+file(WRITE "${OUTPUT_FILE}" "${report}")
+message(STATUS "Profile written to ${OUTPUT_FILE}.")
@@ -171,6 +171,10 @@ The full list of options mlpack allows:
  - ARMA_EXTRA_DEBUG=(ON/OFF): compile with extra Armadillo debugging symbols
        (default OFF)
  - BUILD_TESTS=(ON/OFF): compile the \c mlpack_test program (default ON)
+ - BUILD_BENCHMARKS=(ON/OFF): compile the \c mlpack_benchmarks program
+   (default OFF)
+ - PROFILE_REPETITIONS=(N): number of runs of each program by the \c profile
+   target (default 3)
  - BUILD_CLI_EXECUTABLES=(ON/OFF): compile the mlpack command-line executables
        (i.e. \c mlpack_knn, \c mlpack_kfn, \c mlpack_logistic_regression, etc.)
        (default ON)
@@ -286,6 +290,23 @@ to run BinaryClassificationMetricsTest implemented in cv_test.cpp you can run th
 ./bin/mlpack_test BinaryClassificationMetricsTest
 @endcode
 
+To measure the performance of a build, the \c profile target runs a fixed set
+of programs (\c mlpack_knn, \c mlpack_kmeans, \c mlpack_kde,
+\c mlpack_decision_tree and \c mlpack_random_forest) on the test datasets,
+several times each, and writes their timers to \c profile.json in the build
+directory.  The hardware counters of each timer are included if mlpack was
+configured with \c PERF_COUNTERS=ON, and the results of \c mlpack_benchmarks
+(including the training of a feedforward network) if it was configured with
+\c BUILD_BENCHMARKS=ON.  Reports of different commits can then be compared.
+
+@code
+$ cmake -D CMAKE_BUILD_TYPE=Release -D PERF_COUNTERS=ON -D BUILD_BENCHMARKS=ON ../
+$ make profile
+@endcode
+
+Any mlpack program can write its timers in the same format with the
+\c --timers_file option.
+
 If the build fails and you cannot figure out why, register an account on Github
 and submit an issue and the mlpack developers will quickly help you figure it
 out:
@@ -0,0 +1,184 @@
+/**
+ * @file benchmarks/ann_benchmark.cpp
+ *
+ * Benchmarks of the forward and backward passes of FFN networks, for each of
+ * the common layer types, and of the training of a small classifier.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ann/ffn.hpp>
+#include <mlpack/methods/ann/layer/layer.hpp>
+#include <mlpack/methods/ann/loss_functions/mean_squared_error.hpp>
+#include <mlpack/methods/ann/loss_functions/negative_log_likelihood.hpp>
+#include <mlpack/methods/ann/init_rules/random_init.hpp>
+#include "benchmark.hpp"
+
+using namespace mlpack;
+using namespace mlpack::ann;
+using namespace mlpack::benchmark;
+
+//! The type of the networks benchmarked.
+typedef FFN<MeanSquaredError<>, RandomInitialization> NetworkType;
+
+//! The number of points in each batch.
+static const size_t BatchSize = 64;
+
+/**
+ * Time the forward pass (or, if backward is true, the backward pass) of the
+ * network built by the given function on a batch of random inputs.
+ *
+ * @param state State of the benchmark.
+ * @param build Function adding the layers to the network.
+ * @param inputSize Dimensionality of the inputs of the network.
+ * @param outputSize Dimensionality of the outputs of the network.
+ * @param backward Whether to time the backward pass instead of the forward
+ *     pass.
+ */
+static void PassBenchmark(State& state,
+                          const std::function<void(NetworkType&)>& build,
+                          const size_t inputSize,
+                          const size_t outputSize,
+                          const bool backward)
+{
+  math::RandomSeed(42);
+  NetworkType model;
+  build(model);
+  model.ResetParameters();
+
+  const arma::mat input(inputSize, BatchSize, arma::fill::randu);
+  const arma::mat targets(outputSize, BatchSize, arma::fill::randu);
+  arma::mat output, gradients;
+  while (state.KeepRunning())
+  {
+    if (backward)
+    {
+      // The backward pass needs the activations of a forward pass.
+      state.PauseTiming();
+      model.Forward(input, output);
+      state.ResumeTiming();
+
+      model.Backward(input, targets, gradients);
+    }
+    else
+    {
+      model.Forward(input, output);
+    }
+  }
+
+  state.SetItemsProcessed(state.Iterations() * BatchSize);
+}
+
+//! Register the forward and backward benchmarks of a network.
+#define MLPACK_ANN_BENCHMARK(layer, build, inputSize, outputSize) \
+    MLPACK_BENCHMARK("ann/forward/" layer, [](State& state) \
+        { PassBenchmark(state, build, inputSize, outputSize, false); }); \
+    MLPACK_BENCHMARK("ann/backward/" layer, [](State& state) \
+        { PassBenchmark(state, build, inputSize, outputSize, true); })
+
+static void BuildLinear(NetworkType& model)
+{
+  model.Add<Linear<>>(256, 256);
+  model.Add<Linear<>>(256, 10);
+}
+
+static void BuildReLU(NetworkType& model)
+{
+  model.Add<Linear<>>(256, 256);
+  model.Add<ReLULayer<>>();
+  model.Add<Linear<>>(256, 10);
+}
+
+static void BuildSigmoid(NetworkType& model)
+{
+  model.Add<Linear<>>(256, 256);
+  model.Add<SigmoidLayer<>>();
+  model.Add<Linear<>>(256, 10);
+}
+
+static void BuildTanH(NetworkType& model)
+{
+  model.Add<Linear<>>(256, 256);
+  model.Add<TanHLayer<>>();
+  model.Add<Linear<>>(256, 10);
+}
+
+static void BuildDropout(NetworkType& model)
+{
+  model.Add<Linear<>>(256, 256);
+  model.Add<Dropout<>>(0.5);
+  model.Add<Linear<>>(256, 10);
+}
+
+static void BuildBatchNorm(NetworkType& model)
+{
+  model.Add<Linear<>>(256, 256);
+  model.Add<BatchNorm<>>(256);
+  model.Add<Linear<>>(256, 10);
+}
+
+static void BuildConvolution(NetworkType& model)
+{
+  // 28x28 single-channel images, as in MNIST.
+  model.Add<Convolution<>>(1, 8, 3, 3, 1, 1, 1, 1, 28, 28);
+  model.Add<Linear<>>(8 * 28 * 28, 10);
+}
+
+static void BuildMaxPooling(NetworkType& model)
+{
+  model.Add<Convolution<>>(1, 8, 3, 3, 1, 1, 1, 1, 28, 28);
+  model.Add<MaxPooling<>>(2, 2, 2, 2);
+  model.Add<Linear<>>(8 * 14 * 14, 10);
+}
+
+MLPACK_ANN_BENCHMARK("linear", BuildLinear, 256, 10);
+MLPACK_ANN_BENCHMARK("relu", BuildReLU, 256, 10);
+MLPACK_ANN_BENCHMARK("sigmoid", BuildSigmoid, 256, 10);
+MLPACK_ANN_BENCHMARK("tanh", BuildTanH, 256, 10);
+MLPACK_ANN_BENCHMARK("dropout", BuildDropout, 256, 10);
+MLPACK_ANN_BENCHMARK("batch_norm", BuildBatchNorm, 256, 10);
+MLPACK_ANN_BENCHMARK("convolution", BuildConvolution, 28 * 28, 10);
+MLPACK_ANN_BENCHMARK("max_pooling", BuildMaxPooling, 28 * 28, 10);
+
+/**
+ * Time one epoch of training of the network of the feedforward network tests
+ * on the thyroid dataset.
+ */
+static void TrainThyroid(State& state)
+{
+  arma::mat trainData;
+  if (!StandardData("thyroid_train.csv", trainData))
+  {
+    state.SkipWithError("cannot load thyroid_train.csv");
+    return;
+  }
+
+  // The last row holds the labels, from 1 to 3.
+  const arma::mat trainLabels = trainData.row(trainData.n_rows - 1) - 1;
+  trainData.shed_row(trainData.n_rows - 1);
+
+  math::RandomSeed(42);
+  FFN<NegativeLogLikelihood<>> model;
+  model.Add<Linear<>>(trainData.n_rows, 8);
+  model.Add<SigmoidLayer<>>();
+  model.Add<Linear<>>(8, 3);
+  model.Add<LogSoftMax<>>();
+
+  ens::RMSProp opt(0.01, 32, 0.88, 1e-8, trainData.n_cols, -1);
+  while (state.KeepRunning())
+  {
+    // Start each epoch from the same weights.
+    state.PauseTiming();
+    model.ResetParameters();
+    state.ResumeTiming();
+
+    model.Train(trainData, trainLabels, opt);
+  }
+
+  state.SetItemsProcessed(state.Iterations() * trainData.n_cols);
+}
+
+MLPACK_BENCHMARK("ann/train/thyroid", TrainThyroid);
@@ -0,0 +1,368 @@
+/**
+ * @file benchmarks/benchmark.cpp
+ *
+ * Implementation of the benchmark harness, and the main() of the
+ * mlpack_benchmarks executable.
+ *
+ * Usage: mlpack_benchmarks [--filter=REGEX] [--min-time=SECONDS]
+ *     [--max-iterations=N] [--json=FILE] [--data-dir=DIR] [--list]
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/util/version.hpp>
+#include "benchmark.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <regex>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+
+State::State(const double minTime, const size_t maxIterations) :
+    minTime(minTime),
+    maxIterations(maxIterations),
+    iterations(0),
+    itemsProcessed(0),
+    started(false),
+    running(false),
+    skipped(false),
+    realTime(0.0),
+    cpuTime(0.0),
+    cpuStart(0)
+{
+  // Nothing to do.
+}
+
+bool State::KeepRunning()
+{
+  if (skipped)
+    return false;
+
+  if (!started)
+  {
+    started = true;
+    ResumeTiming();
+    return true;
+  }
+
+  ++iterations;
+
+  // Check the time spent so far without stopping the timers.
+  double elapsed = realTime;
+  if (running)
+  {
+    elapsed += std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - realStart).count();
+  }
+
+  if (elapsed < minTime && iterations < maxIterations)
+    return true;
+
+  PauseTiming();
+  return false;
+}
+
+void State::PauseTiming()
+{
+  if (!running)
+    return;
+
+  realTime += std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - realStart).count();
+  cpuTime += (double) (std::clock() - cpuStart) / CLOCKS_PER_SEC;
+  running = false;
+}
+
+void State::ResumeTiming()
+{
+  if (running)
+    return;
+
+  running = true;
+  cpuStart = std::clock();
+  realStart = std::chrono::steady_clock::now();
+}
+
+void State::SkipWithError(const std::string& message)
+{
+  PauseTiming();
+  skipped = true;
+  errorMessage = message;
+}
+
+namespace {
+
+//! A registered benchmark.
+struct Benchmark
+{
+  std::string name;
+  BenchmarkFunction function;
+};
+
+//! The registered benchmarks.  This is a function so that the registry exists
+//! before any benchmark is registered at static initialization time.
+std::vector<Benchmark>& Registry()
+{
+  static std::vector<Benchmark> registry;
+  return registry;
+}
+
+//! The result of a benchmark.
+struct Result
+{
+  std::string name;
+  size_t iterations;
+  double realTime;
+  double cpuTime;
+  double itemsPerSecond;
+  bool skipped;
+  std::string errorMessage;
+};
+
+//! Escape a string for JSON output.
+std::string Escape(const std::string& s)
+{
+  std::ostringstream oss;
+  for (const char c : s)
+  {
+    if (c == '"' || c == '\\')
+      oss << '\\' << c;
+    else if (c == '\n')
+      oss << "\\n";
+    else
+      oss << c;
+  }
+  return oss.str();
+}
+
+//! Write the results as JSON, in the layout used by Google Benchmark.  Times
+//! are per iteration, in nanoseconds.
+void WriteJSON(std::ostream& out, const std::vector<Result>& results)
+{
+  const std::time_t now = std::time(NULL);
+  char date[64];
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+  #ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  #else
+  const size_t numThreads = 1;
+  #endif
+
+  out << "{\n"
+      << "  \"context\": {\n"
+      << "    \"date\": \"" << date << "\",\n"
+      << "    \"executable\": \"mlpack_benchmarks\",\n"
+      << "    \"mlpack_version\": \"" << Escape(util::GetVersion())
+      << "\",\n"
+      << "    \"num_threads\": " << numThreads << "\n"
+      << "  },\n"
+      << "  \"benchmarks\": [";
+
+  out << std::setprecision(10);
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    const Result& r = results[i];
+    out << ((i == 0) ? "\n" : ",\n")
+        << "    {\n"
+        << "      \"name\": \"" << Escape(r.name) << "\",\n"
+        << "      \"run_name\": \"" << Escape(r.name) << "\",\n"
+        << "      \"run_type\": \"iteration\",\n";
+    if (r.skipped)
+    {
+      out << "      \"error_occurred\": true,\n"
+          << "      \"error_message\": \"" << Escape(r.errorMessage) << "\"\n";
+    }
+    else
+    {
+      out << "      \"iterations\": " << r.iterations << ",\n"
+          << "      \"real_time\": " << 1e9 * r.realTime / r.iterations << ",\n"
+          << "      \"cpu_time\": " << 1e9 * r.cpuTime / r.iterations << ",\n"
+          << "      \"time_unit\": \"ns\"";
+      if (r.itemsPerSecond > 0.0)
+        out << ",\n      \"items_per_second\": " << r.itemsPerSecond;
+      out << "\n";
+    }
+    out << "    }";
+  }
+
+  out << "\n  ]\n}\n";
+}
+
+//! Print the usage of the executable.
+void PrintUsage()
+{
+  std::cout << "Usage: mlpack_benchmarks [options]\n"
+      << "  --filter=REGEX       Only run the benchmarks whose name matches.\n"
+      << "  --min-time=SECONDS   Minimum time of each benchmark (default "
+      << "0.5).\n"
+      << "  --max-iterations=N   Maximum iterations of each benchmark (default "
+      << "1000000).\n"
+      << "  --json=FILE          Also write the results as JSON to FILE ('-' "
+      << "for stdout).\n"
+      << "  --data-dir=DIR       Directory of the standard datasets (default "
+      << "'.').\n"
+      << "  --list               List the benchmarks and exit.\n";
+}
+
+} // namespace
+
+bool mlpack::benchmark::RegisterBenchmark(const std::string& name,
+                                          BenchmarkFunction function)
+{
+  Registry().push_back(Benchmark { name, function });
+  return true;
+}
+
+arma::mat mlpack::benchmark::SyntheticData(const size_t dimensions,
+                                           const size_t points,
+                                           const size_t clusters,
+                                           const size_t seed)
+{
+  std::mt19937 generator((uint32_t) seed);
+  std::uniform_real_distribution<> uniform(-10.0, 10.0);
+  std::normal_distribution<> normal;
+  std::uniform_int_distribution<size_t> cluster(0, clusters - 1);
+
+  arma::mat centers(dimensions, clusters);
+  centers.imbue([&]() { return uniform(generator); });
+
+  arma::mat dataset(dimensions, points);
+  for (size_t i = 0; i < points; ++i)
+  {
+    const size_t c = cluster(generator);
+    for (size_t d = 0; d < dimensions; ++d)
+      dataset(d, i) = centers(d, c) + normal(generator);
+  }
+
+  return dataset;
+}
+
+std::string& mlpack::benchmark::DataDirectory()
+{
+  static std::string dataDirectory = ".";
+  return dataDirectory;
+}
+
+bool mlpack::benchmark::StandardData(const std::string& name,
+                                     arma::mat& dataset)
+{
+  return data::Load(DataDirectory() + "/" + name, dataset);
+}
+
+int main(int argc, char** argv)
+{
+  std::string filter = ".*";
+  double minTime = 0.5;
+  size_t maxIterations = 1000000;
+  std::string jsonFile;
+  bool list = false;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg(argv[i]);
+    const size_t eq = arg.find('=');
+    const std::string key = arg.substr(0, eq);
+    const std::string value = (eq == std::string::npos) ? "" :
+        arg.substr(eq + 1);
+
+    if (key == "--filter")
+      filter = value;
+    else if (key == "--min-time")
+      minTime = std::stod(value);
+    else if (key == "--max-iterations")
+      maxIterations = std::stoul(value);
+    else if (key == "--json")
+      jsonFile = value;
+    else if (key == "--data-dir")
+      DataDirectory() = value;
+    else if (key == "--list")
+      list = true;
+    else
+    {
+      PrintUsage();
+      return (key == "--help") ? 0 : 1;
+    }
+  }
+
+  // Run the benchmarks in the order of their names, so that related ones are
+  // next to each other whatever the order of static initialization.
+  std::vector<Benchmark>& benchmarks = Registry();
+  std::stable_sort(benchmarks.begin(), benchmarks.end(),
+      [](const Benchmark& a, const Benchmark& b) { return a.name < b.name; });
+
+  // If the JSON goes to stdout, the table goes to stderr.
+  std::ostream& console = (jsonFile == "-") ? std::cerr : std::cout;
+
+  const std::regex pattern(filter);
+  std::vector<Result> results;
+  for (const Benchmark& b : benchmarks)
+  {
+    if (!std::regex_search(b.name, pattern))
+      continue;
+
+    if (list)
+    {
+      std::cout << b.name << std::endl;
+      continue;
+    }
+
+    State state(minTime, std::max(maxIterations, (size_t) 1));
+    b.function(state);
+
+    Result r;
+    r.name = b.name;
+    r.iterations = std::max(state.Iterations(), (size_t) 1);
+    r.realTime = state.RealTime();
+    r.cpuTime = state.CPUTime();
+    r.itemsPerSecond = (state.ItemsProcessed() > 0 && r.realTime > 0.0) ?
+        state.ItemsProcessed() / r.realTime : 0.0;
+    r.skipped = state.Skipped();
+    r.errorMessage = state.ErrorMessage();
+    results.push_back(r);
+
+    console << std::left << std::setw(48) << r.name << std::right;
+    if (r.skipped)
+    {
+      console << "  skipped: " << r.errorMessage << std::endl;
+      continue;
+    }
+
+    console << std::setw(14) << std::fixed << std::setprecision(0)
+        << 1e9 * r.realTime / r.iterations << " ns"
+        << std::setw(14) << 1e9 * r.cpuTime / r.iterations << " ns"
+        << std::setw(10) << r.iterations;
+    if (r.itemsPerSecond > 0.0)
+    {
+      console << std::setw(12) << std::setprecision(4) << std::scientific
+          << r.itemsPerSecond << " items/s";
+    }
+    console << std::endl;
+  }
+
+  if (jsonFile == "-")
+  {
+    WriteJSON(std::cout, results);
+  }
+  else if (!jsonFile.empty())
+  {
+    std::ofstream out(jsonFile);
+    if (!out.is_open())
+    {
+      std::cerr << "Cannot open '" << jsonFile << "' for writing!" << std::endl;
+      return 1;
+    }
+    WriteJSON(out, results);
+  }
+
+  return 0;
+}
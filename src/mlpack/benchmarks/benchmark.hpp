@@ -0,0 +1,173 @@
+/**
+ * @file benchmarks/benchmark.hpp
+ *
+ * A small benchmark harness for the mlpack_benchmarks target.  Benchmarks are
+ * registered with MLPACK_BENCHMARK() and run by the main() in benchmark.cpp,
+ * which reports their timings on the console or as JSON (in the same layout as
+ * Google Benchmark, so the same comparison tools can be used).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BENCHMARKS_BENCHMARK_HPP
+#define MLPACK_BENCHMARKS_BENCHMARK_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <chrono>
+#include <ctime>
+#include <functional>
+
+namespace mlpack {
+namespace benchmark /** Benchmarks of mlpack hot paths. */ {
+
+/**
+ * The state of a running benchmark.  A benchmark does its setup, then runs the
+ * code to be timed in a loop guarded by KeepRunning():
+ *
+ * @code
+ * void BenchmarkSomething(State& state)
+ * {
+ *   arma::mat data = SyntheticData(10, 10000);
+ *   while (state.KeepRunning())
+ *     DoSomething(data);
+ *   state.SetItemsProcessed(state.Iterations() * data.n_cols);
+ * }
+ * @endcode
+ *
+ * The loop runs until it has taken at least the minimum time, so that fast
+ * code is timed over many iterations.  Per-iteration work that should not be
+ * timed can be bracketed with PauseTiming() and ResumeTiming().
+ */
+class State
+{
+ public:
+  /**
+   * Create the state of a benchmark.
+   *
+   * @param minTime Minimum time (in seconds) to run the timed loop for.
+   * @param maxIterations Maximum number of iterations of the timed loop.
+   */
+  State(const double minTime, const size_t maxIterations);
+
+  /**
+   * Return true while the timed loop should run another iteration.  The first
+   * call starts the timers.
+   */
+  bool KeepRunning();
+
+  //! Stop the timers until ResumeTiming() is called.
+  void PauseTiming();
+  //! Restart the timers after a call to PauseTiming().
+  void ResumeTiming();
+
+  //! Record the number of items processed by all the iterations, to report
+  //! the throughput of the benchmark.
+  void SetItemsProcessed(const size_t items) { itemsProcessed = items; }
+
+  //! Mark the benchmark as skipped, with the given reason; KeepRunning() will
+  //! return false.
+  void SkipWithError(const std::string& message);
+
+  //! Get the number of completed iterations.
+  size_t Iterations() const { return iterations; }
+  //! Get the number of items processed.
+  size_t ItemsProcessed() const { return itemsProcessed; }
+  //! Get the total wall clock time of the timed iterations, in seconds.
+  double RealTime() const { return realTime; }
+  //! Get the total CPU time of the timed iterations, in seconds.
+  double CPUTime() const { return cpuTime; }
+  //! Get whether the benchmark was skipped.
+  bool Skipped() const { return skipped; }
+  //! Get the reason the benchmark was skipped.
+  const std::string& ErrorMessage() const { return errorMessage; }
+
+ private:
+  //! The minimum time to run for, in seconds.
+  double minTime;
+  //! The maximum number of iterations.
+  size_t maxIterations;
+  //! The number of completed iterations.
+  size_t iterations;
+  //! The number of items processed.
+  size_t itemsProcessed;
+  //! Whether the timed loop has started.
+  bool started;
+  //! Whether the timers are running.
+  bool running;
+  //! Whether the benchmark was skipped.
+  bool skipped;
+  //! The reason the benchmark was skipped.
+  std::string errorMessage;
+
+  //! The accumulated wall clock time, in seconds.
+  double realTime;
+  //! The accumulated CPU time, in seconds.
+  double cpuTime;
+  //! The wall clock time at which the timers were last started.
+  std::chrono::steady_clock::time_point realStart;
+  //! The CPU time at which the timers were last started.
+  std::clock_t cpuStart;
+};
+
+//! The type of a benchmark function.
+typedef std::function<void(State&)> BenchmarkFunction;
+
+/**
+ * Register the given benchmark under the given name.  Names are
+ * '/'-separated paths such as "knn/dual_tree/kd", which can be selected with
+ * the --filter option of mlpack_benchmarks.  This is usually called through
+ * MLPACK_BENCHMARK().
+ *
+ * @return Always true (so that it can initialize a static variable).
+ */
+bool RegisterBenchmark(const std::string& name, BenchmarkFunction function);
+
+/**
+ * Generate a synthetic dataset: the given number of points drawn from a mixture
+ * of Gaussians with random centers, so that trees built on it are not
+ * degenerate.  The same arguments always give the same dataset.
+ *
+ * @param dimensions Dimensionality of the points.
+ * @param points Number of points.
+ * @param clusters Number of Gaussians in the mixture.
+ * @param seed Seed of the generator.
+ */
+arma::mat SyntheticData(const size_t dimensions,
+                        const size_t points,
+                        const size_t clusters = 10,
+                        const size_t seed = 42);
+
+/**
+ * Load one of the standard datasets from the data directory given with the
+ * --data-dir option of mlpack_benchmarks (by default, the current directory,
+ * where the test datasets are copied when mlpack_test is built).  Returns
+ * false if the dataset could not be loaded.
+ *
+ * @param name Name of the file of the dataset.
+ * @param dataset Matrix to load the dataset into.
+ */
+bool StandardData(const std::string& name, arma::mat& dataset);
+
+//! Get the directory that holds the standard datasets.
+std::string& DataDirectory();
+
+} // namespace benchmark
+} // namespace mlpack
+
+//! Concatenate two tokens, after expanding them.
+#define MLPACK_BENCHMARK_CONCAT_(a, b) a##b
+#define MLPACK_BENCHMARK_CONCAT(a, b) MLPACK_BENCHMARK_CONCAT_(a, b)
+
+/**
+ * Register a benchmark at static initialization time.  The function must take a
+ * mlpack::benchmark::State&.  (__COUNTER__ is used rather than __LINE__ so that
+ * a macro can register several benchmarks.)
+ */
+#define MLPACK_BENCHMARK(name, function) \
+    static const bool MLPACK_BENCHMARK_CONCAT(mlpackBenchmark, __COUNTER__) = \
+        mlpack::benchmark::RegisterBenchmark(name, function)
+
+#endif
@@ -0,0 +1,82 @@
+/**
+ * @file benchmarks/decision_tree_benchmark.cpp
+ *
+ * Benchmarks of decision tree training and classification.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/decision_tree/decision_tree.hpp>
+#include "benchmark.hpp"
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+using namespace mlpack::tree;
+
+//! Get a synthetic classification dataset, labeled by the sign of a random
+//! linear function of the points.
+static void SyntheticClassification(arma::mat& dataset,
+                                    arma::Row<size_t>& labels)
+{
+  dataset = SyntheticData(10, 20000);
+  const arma::vec weights = SyntheticData(10, 1, 1, 7);
+  labels = arma::conv_to<arma::Row<size_t>>::from(
+      weights.t() * dataset > 0.0);
+}
+
+//! Train a decision tree on the given dataset.
+static void Train(State& state,
+                  const arma::mat& dataset,
+                  const arma::Row<size_t>& labels,
+                  const size_t numClasses)
+{
+  while (state.KeepRunning())
+    DecisionTree<> tree(dataset, labels, numClasses);
+
+  state.SetItemsProcessed(state.Iterations() * dataset.n_cols);
+}
+
+static void TrainSynthetic(State& state)
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  SyntheticClassification(dataset, labels);
+  Train(state, dataset, labels, 2);
+}
+
+static void TrainVC2(State& state)
+{
+  arma::mat dataset, labelsIn;
+  if (!StandardData("vc2.csv", dataset) ||
+      !StandardData("vc2_labels.txt", labelsIn))
+  {
+    state.SkipWithError("cannot load vc2.csv or vc2_labels.txt");
+    return;
+  }
+
+  const arma::Row<size_t> labels =
+      arma::conv_to<arma::Row<size_t>>::from(labelsIn);
+  Train(state, dataset, labels, 3);
+}
+
+//! Classify the whole training set with a trained tree.
+static void ClassifySynthetic(State& state)
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  SyntheticClassification(dataset, labels);
+  DecisionTree<> tree(dataset, labels, 2);
+
+  arma::Row<size_t> predictions;
+  while (state.KeepRunning())
+    tree.Classify(dataset, predictions);
+
+  state.SetItemsProcessed(state.Iterations() * dataset.n_cols);
+}
+
+MLPACK_BENCHMARK("decision_tree/train/synthetic", TrainSynthetic);
+MLPACK_BENCHMARK("decision_tree/train/vc2", TrainVC2);
+MLPACK_BENCHMARK("decision_tree/classify/synthetic", ClassifySynthetic);
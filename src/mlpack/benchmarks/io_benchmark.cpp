@@ -0,0 +1,78 @@
+/**
+ * @file benchmarks/io_benchmark.cpp
+ *
+ * Benchmarks of loading datasets (CSV and Armadillo binary) and serialized
+ * models.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/decision_tree/decision_tree.hpp>
+#include "benchmark.hpp"
+
+#include <cstdio>
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+using namespace mlpack::tree;
+
+//! Save a synthetic dataset to the given file, then time loading it.
+static void LoadMatrix(State& state, const std::string& filename)
+{
+  const arma::mat dataset = SyntheticData(10, 50000);
+  if (!data::Save(filename, dataset))
+  {
+    state.SkipWithError("cannot save " + filename);
+    return;
+  }
+
+  arma::mat loaded;
+  while (state.KeepRunning())
+    data::Load(filename, loaded, true);
+
+  std::remove(filename.c_str());
+  state.SetItemsProcessed(state.Iterations() * dataset.n_cols);
+}
+
+static void LoadCSV(State& state)
+{
+  LoadMatrix(state, "mlpack_benchmark_load.csv");
+}
+
+static void LoadArmaBinary(State& state)
+{
+  LoadMatrix(state, "mlpack_benchmark_load.bin");
+}
+
+//! Save a trained decision tree with cereal, then time loading it.
+template<typename ModelType>
+static void LoadModel(State& state, const std::string& filename)
+{
+  const arma::mat dataset = SyntheticData(10, 20000);
+  const arma::Row<size_t> labels =
+      arma::conv_to<arma::Row<size_t>>::from(dataset.row(0) > 0.0);
+  ModelType model(dataset, labels, 2, 1);
+  if (!data::Save(filename, "model", model))
+  {
+    state.SkipWithError("cannot save " + filename);
+    return;
+  }
+
+  while (state.KeepRunning())
+  {
+    ModelType loaded;
+    data::Load(filename, "model", loaded, true);
+  }
+
+  std::remove(filename.c_str());
+}
+
+MLPACK_BENCHMARK("io/load/csv", LoadCSV);
+MLPACK_BENCHMARK("io/load/arma_binary", LoadArmaBinary);
+MLPACK_BENCHMARK("io/load/model/binary", [](State& state)
+    { LoadModel<DecisionTree<>>(state, "mlpack_benchmark_model.bin"); });
+MLPACK_BENCHMARK("io/load/model/xml", [](State& state)
+    { LoadModel<DecisionTree<>>(state, "mlpack_benchmark_model.xml"); });
@@ -0,0 +1,62 @@
+/**
+ * @file benchmarks/kmeans_benchmark.cpp
+ *
+ * Benchmarks of k-means clustering, for each Lloyd step type.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/kmeans/kmeans.hpp>
+#include <mlpack/methods/kmeans/elkan_kmeans.hpp>
+#include <mlpack/methods/kmeans/hamerly_kmeans.hpp>
+#include <mlpack/methods/kmeans/pelleg_moore_kmeans.hpp>
+#include <mlpack/methods/kmeans/dual_tree_kmeans.hpp>
+#include "benchmark.hpp"
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+using namespace mlpack::kmeans;
+using namespace mlpack::metric;
+
+//! The number of Lloyd iterations run by each timed iteration.
+static const size_t LloydIterations = 10;
+
+/**
+ * Run a fixed number of Lloyd iterations of k-means with the given step type,
+ * from the same initial centroids every time, so that the timings of different
+ * step types are comparable.
+ */
+template<template<class, class> class LloydStepType>
+static void KMeansSteps(State& state)
+{
+  static const arma::mat dataset = SyntheticData(5, 50000, 20);
+  const size_t clusters = 20;
+
+  KMeans<EuclideanDistance, SampleInitialization, MaxVarianceNewCluster,
+      LloydStepType> kmeans(LloydIterations);
+
+  math::RandomSeed(42);
+  arma::mat initialCentroids;
+  SampleInitialization().Cluster(dataset, clusters, initialCentroids);
+
+  arma::mat centroids;
+  while (state.KeepRunning())
+  {
+    centroids = initialCentroids;
+    kmeans.Cluster(dataset, clusters, centroids, true);
+  }
+
+  state.SetItemsProcessed(state.Iterations() * LloydIterations *
+      dataset.n_cols);
+}
+
+MLPACK_BENCHMARK("kmeans/naive", KMeansSteps<NaiveKMeans>);
+MLPACK_BENCHMARK("kmeans/elkan", KMeansSteps<ElkanKMeans>);
+MLPACK_BENCHMARK("kmeans/hamerly", KMeansSteps<HamerlyKMeans>);
+MLPACK_BENCHMARK("kmeans/pelleg_moore", KMeansSteps<PellegMooreKMeans>);
+MLPACK_BENCHMARK("kmeans/dual_tree", KMeansSteps<DefaultDualTreeKMeans>);
+MLPACK_BENCHMARK("kmeans/dual_tree/cover",
+    KMeansSteps<CoverTreeDualTreeKMeans>);
@@ -0,0 +1,124 @@
+/**
+ * @file benchmarks/neighbor_search_benchmark.cpp
+ *
+ * Benchmarks of dual-tree k-nearest-neighbor search, range search and kernel
+ * density estimation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+#include <mlpack/methods/range_search/range_search.hpp>
+#include <mlpack/methods/kde/kde.hpp>
+#include "benchmark.hpp"
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+using namespace mlpack::kde;
+using namespace mlpack::kernel;
+using namespace mlpack::metric;
+using namespace mlpack::neighbor;
+using namespace mlpack::range;
+using namespace mlpack::tree;
+
+//! The reference set of the searches.
+static const arma::mat& SearchData()
+{
+  static const arma::mat dataset = SyntheticData(4, 20000);
+  return dataset;
+}
+
+//! Find the 5 nearest neighbors of every point of the dataset with the given
+//! tree type; the tree is built once, outside of the timed loop.
+template<template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+static void AllKNN(State& state, const arma::mat& dataset,
+                   const NeighborSearchMode mode)
+{
+  NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat, TreeType>
+      knn(dataset, mode);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  while (state.KeepRunning())
+    knn.Search(5, neighbors, distances);
+
+  state.SetItemsProcessed(state.Iterations() * dataset.n_cols);
+}
+
+template<template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+static void DualTreeKNN(State& state)
+{
+  AllKNN<TreeType>(state, SearchData(), DUAL_TREE_MODE);
+}
+
+static void SingleTreeKNN(State& state)
+{
+  AllKNN<KDTree>(state, SearchData(), SINGLE_TREE_MODE);
+}
+
+static void StandardDataKNN(State& state)
+{
+  arma::mat dataset;
+  if (!StandardData("test_data_3_1000.csv", dataset))
+  {
+    state.SkipWithError("cannot load test_data_3_1000.csv");
+    return;
+  }
+
+  AllKNN<KDTree>(state, dataset, DUAL_TREE_MODE);
+}
+
+MLPACK_BENCHMARK("knn/dual_tree/kd", DualTreeKNN<KDTree>);
+MLPACK_BENCHMARK("knn/dual_tree/ball", DualTreeKNN<BallTree>);
+MLPACK_BENCHMARK("knn/dual_tree/cover", DualTreeKNN<StandardCoverTree>);
+MLPACK_BENCHMARK("knn/dual_tree/r_star", DualTreeKNN<RStarTree>);
+MLPACK_BENCHMARK("knn/single_tree/kd", SingleTreeKNN);
+MLPACK_BENCHMARK("knn/dual_tree/kd/test_data_3_1000", StandardDataKNN);
+
+//! Find all the points within a fixed range of every point of the dataset.
+template<template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+static void DualTreeRangeSearch(State& state)
+{
+  const arma::mat& dataset = SearchData();
+  RangeSearch<EuclideanDistance, arma::mat, TreeType> rs(dataset);
+
+  std::vector<std::vector<size_t>> neighbors;
+  std::vector<std::vector<double>> distances;
+  while (state.KeepRunning())
+    rs.Search(dataset, math::Range(0.0, 0.5), neighbors, distances);
+
+  state.SetItemsProcessed(state.Iterations() * dataset.n_cols);
+}
+
+MLPACK_BENCHMARK("range_search/dual_tree/kd", DualTreeRangeSearch<KDTree>);
+MLPACK_BENCHMARK("range_search/dual_tree/ball", DualTreeRangeSearch<BallTree>);
+
+//! Estimate the density of every point of the dataset with a Gaussian kernel.
+template<template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+static void DualTreeKDE(State& state)
+{
+  const arma::mat& dataset = SearchData();
+  KDE<GaussianKernel, EuclideanDistance, arma::mat, TreeType> kde(0.05, 0.0,
+      GaussianKernel(0.5));
+  kde.Train(dataset);
+
+  arma::vec estimations;
+  while (state.KeepRunning())
+    kde.Evaluate(dataset, estimations);
+
+  state.SetItemsProcessed(state.Iterations() * dataset.n_cols);
+}
+
+MLPACK_BENCHMARK("kde/dual_tree/kd", DualTreeKDE<KDTree>);
+MLPACK_BENCHMARK("kde/dual_tree/ball", DualTreeKDE<BallTree>);
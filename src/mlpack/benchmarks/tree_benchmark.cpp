@@ -0,0 +1,81 @@
+/**
+ * @file benchmarks/tree_benchmark.cpp
+ *
+ * Benchmarks of tree construction, for each split type.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/tree/binary_space_tree.hpp>
+#include <mlpack/core/tree/cover_tree.hpp>
+#include <mlpack/core/tree/octree.hpp>
+#include <mlpack/core/tree/rectangle_tree.hpp>
+#include <mlpack/core/tree/spill_tree.hpp>
+#include "benchmark.hpp"
+
+using namespace mlpack;
+using namespace mlpack::benchmark;
+using namespace mlpack::metric;
+using namespace mlpack::tree;
+
+//! The dataset the trees are built on.
+static const arma::mat& TreeData()
+{
+  static const arma::mat dataset = SyntheticData(5, 50000);
+  return dataset;
+}
+
+//! Build a tree of the given type on a copy of the dataset; the copy is not
+//! timed.
+template<typename TreeType>
+static void BuildTree(State& state)
+{
+  const arma::mat& dataset = TreeData();
+  while (state.KeepRunning())
+  {
+    state.PauseTiming();
+    arma::mat copy(dataset);
+    state.ResumeTiming();
+
+    TreeType tree(std::move(copy));
+  }
+
+  state.SetItemsProcessed(state.Iterations() * dataset.n_cols);
+}
+
+MLPACK_BENCHMARK("tree/build/kd",
+    BuildTree<KDTree<EuclideanDistance, EmptyStatistic, arma::mat>>);
+MLPACK_BENCHMARK("tree/build/mean_split_kd",
+    BuildTree<MeanSplitKDTree<EuclideanDistance, EmptyStatistic, arma::mat>>);
+MLPACK_BENCHMARK("tree/build/ball",
+    BuildTree<BallTree<EuclideanDistance, EmptyStatistic, arma::mat>>);
+MLPACK_BENCHMARK("tree/build/vp",
+    BuildTree<VPTree<EuclideanDistance, EmptyStatistic, arma::mat>>);
+MLPACK_BENCHMARK("tree/build/rp",
+    BuildTree<RPTree<EuclideanDistance, EmptyStatistic, arma::mat>>);
+MLPACK_BENCHMARK("tree/build/max_rp",
+    BuildTree<MaxRPTree<EuclideanDistance, EmptyStatistic, arma::mat>>);
+MLPACK_BENCHMARK("tree/build/ub",
+    BuildTree<UBTree<EuclideanDistance, EmptyStatistic, arma::mat>>);
+MLPACK_BENCHMARK("tree/build/octree",
+    BuildTree<Octree<EuclideanDistance, EmptyStatistic, arma::mat>>);
+MLPACK_BENCHMARK("tree/build/cover",
+    BuildTree<StandardCoverTree<EuclideanDistance, EmptyStatistic,
+        arma::mat>>);
+MLPACK_BENCHMARK("tree/build/r",
+    BuildTree<RTree<EuclideanDistance, EmptyStatistic, arma::mat>>);
+MLPACK_BENCHMARK("tree/build/r_star",
+    BuildTree<RStarTree<EuclideanDistance, EmptyStatistic, arma::mat>>);
+MLPACK_BENCHMARK("tree/build/x",
+    BuildTree<XTree<EuclideanDistance, EmptyStatistic, arma::mat>>);
+MLPACK_BENCHMARK("tree/build/hilbert_r",
+    BuildTree<HilbertRTree<EuclideanDistance, EmptyStatistic, arma::mat>>);
+MLPACK_BENCHMARK("tree/build/r_plus",
+    BuildTree<RPlusTree<EuclideanDistance, EmptyStatistic, arma::mat>>);
+MLPACK_BENCHMARK("tree/build/r_plus_plus",
+    BuildTree<RPlusPlusTree<EuclideanDistance, EmptyStatistic, arma::mat>>);
+MLPACK_BENCHMARK("tree/build/spill",
+    BuildTree<SPTree<EuclideanDistance, EmptyStatistic, arma::mat>>);
@@ -31,6 +31,7 @@
 #include "get_allocated_memory.hpp"
 #include "delete_allocated_memory.hpp"
 #include "in_place_copy.hpp"
+#include "is_serializable.hpp"
 
 namespace mlpack {
 namespace bindings {
@@ -161,6 +162,8 @@ class CLIOption
     IO::GetSingleton().functionMap[tname]["DeleteAllocatedMemory"] =
         &DeleteAllocatedMemory<N>;
     IO::GetSingleton().functionMap[tname]["InPlaceCopy"] = &InPlaceCopy<N>;
+    IO::GetSingleton().functionMap[tname]["IsSerializable"] =
+        &IsSerializable<N>;
   }
 };
 
@@ -14,6 +14,9 @@
 #define MLPACK_BINDINGS_CLI_END_PROGRAM_HPP
 
 #include <mlpack/core/util/io.hpp>
+#include <mlpack/core/tree/traversal_statistics.hpp>
+
+#include <fstream>
 
 namespace mlpack {
 namespace bindings {
@@ -22,8 +25,11 @@ namespace cli {
 /**
  * Handle command-line program termination.  If --help or --info was passed, we
  * won't make it here, so we don't have to write any contingencies for that.
+ *
+ * @param printOutput Whether to print (or save) the output parameters; this is
+ *     false in serving mode, where they are given for each request.
  */
-inline void EndProgram()
+inline void EndProgram(const bool printOutput = true)
 {
   // Stop the CLI timers.
   IO::GetSingleton().timer.StopAllTimers();
@@ -33,7 +39,7 @@ inline void EndProgram()
   for (auto& it : parameters)
   {
     util::ParamData& d = it.second;
-    if (!d.input)
+    if (!d.input && printOutput)
       IO::GetSingleton().functionMap[d.tname]["OutputParam"](d, NULL, NULL);
   }
 
@@ -63,6 +69,31 @@ inline void EndProgram()
     {
       Log::Info << "  " << it2.first << ": ";
       IO::GetSingleton().timer.PrintTimer(it2.first);
+      // This prints nothing unless mlpack was compiled with hardware counters
+      // and they could be read.
+      IO::GetSingleton().timer.PrintCounters(it2.first);
+      // Likewise for the memory statistics, which need memory tracking.
+      IO::GetSingleton().timer.PrintMemory(it2.first);
+    }
+
+    // This prints nothing if no tree was traversed, or if mlpack was not
+    // compiled with traversal statistics.
+    tree::TraversalStatistics::Print();
+  }
+
+  // Write the timers in a form that tools comparing runs can read.
+  if (IO::HasParam("timers_file"))
+  {
+    const std::string& timersFile = IO::GetParam<std::string>("timers_file");
+    std::ofstream stream(timersFile);
+    if (stream.is_open())
+    {
+      IO::GetSingleton().timer.WriteJSON(stream);
+    }
+    else
+    {
+      Log::Warn << "Cannot open '" << timersFile << "' to write the timers!"
+          << std::endl;
     }
   }
 
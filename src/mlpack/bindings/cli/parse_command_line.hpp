@@ -14,6 +14,7 @@
 #define MLPACK_BINDINGS_CLI_PARSE_COMMAND_LINE_HPP
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/tree/traversal_statistics.hpp>
 #include "print_help.hpp"
 
 #include "third_party/CLI/CLI11.hpp"
@@ -28,6 +29,12 @@ PARAM_STRING_IN("info", "Print help on a specific option.", "", "");
 PARAM_FLAG("verbose", "Display informational messages and the full list of "
     "parameters and timers at the end of execution.", "v");
 PARAM_FLAG("version", "Display the version of mlpack.", "V");
+PARAM_STRING_IN("serve", "Instead of running once, load the input models once "
+    "and answer requests, each a line of options as on the command line, on the "
+    "Unix socket with the given path, or on standard input if '-'.", "", "");
+PARAM_STRING_IN("timers_file", "If specified, write the timers (with hardware "
+    "counters and memory statistics, if mlpack collects them) as JSON to the "
+    "given file at the end of execution.", "", "");
 
 /**
  * Parse the command line, setting all of the options inside of the CLI object
@@ -127,6 +134,9 @@ void ParseCommandLine(int argc, char** argv)
   {
     // Give [INFO ] output.
     Log::Info.ignoreInput = false;
+
+    // Collect tree traversal statistics, if mlpack was compiled with them.
+    tree::TraversalStatistics::Enable();
   }
 
   // Now, issue an error if we forgot any required options.
@@ -0,0 +1,457 @@
+/**
+ * @file bindings/cli/serve.hpp
+ *
+ * Serving mode of command-line programs: the input models are loaded once, and
+ * then requests (sets of options) are answered on standard input or on a Unix
+ * socket.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_SERVE_HPP
+#define MLPACK_BINDINGS_CLI_SERVE_HPP
+
+#include <mlpack/core/util/io.hpp>
+#include "map_parameter_name.hpp"
+
+#include "third_party/CLI/CLI11.hpp"
+
+#include <atomic>
+#include <csignal>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#ifndef _WIN32
+  #include <poll.h>
+  #include <sys/socket.h>
+  #include <sys/un.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+/**
+ * A Server runs a command-line program many times without loading its input
+ * models again.  When it is created, the input models given on the command
+ * line are loaded, and the options given on the command line are kept.  Then,
+ * each request is a line of options, written as on the command line (for
+ * instance "--query_file q.csv --neighbors_file n.csv"), that is added to the
+ * kept options before running the program.  The input models cannot be given
+ * in a request.
+ *
+ * The reply to a request is everything the program printed while running it
+ * (the output options that are not files, and the messages), followed by a
+ * line "ok", or by a line "error: " and the error if the request failed.
+ *
+ * Requests may be handled from several threads, but they are run one at a
+ * time: the options of the program are global, and the output of a request is
+ * caught by redirecting the buffers of std::cout and std::cerr, which are
+ * shared by the whole process.  So while a request runs, anything that another
+ * thread writes to std::cout, std::cerr or Log goes into the reply of that
+ * request; the server itself writes nothing to them while it serves.  A
+ * program that modifies its input model will see the modified model in the
+ * next requests.
+ */
+class Server
+{
+ public:
+  /**
+   * Load the input models given on the command line, and keep the options
+   * given on the command line for all requests.  The command line must already
+   * have been parsed.
+   *
+   * @param program Function that runs the program (mlpackMain()).
+   */
+  Server(std::function<void()> program) : program(std::move(program))
+  {
+    std::map<std::string, util::ParamData>& parameters = IO::Parameters();
+    for (auto& it : parameters)
+    {
+      util::ParamData& d = it.second;
+      bool isSerializable = false;
+      IO::GetSingleton().functionMap[d.tname]["IsSerializable"](d, NULL,
+          (void*) &isSerializable);
+      if (!d.input || !d.wasPassed || !isSerializable)
+        continue;
+
+      void* model;
+      IO::GetSingleton().functionMap[d.tname]["GetParam"](d, NULL,
+          (void*) &model);
+      IO::GetSingleton().functionMap[d.tname]["GetAllocatedMemory"](d, NULL,
+          (void*) &model);
+      servedModels.insert(model);
+      servedParameters.insert(d.name);
+    }
+
+    // Store a copy of the options, to start each request from.
+    IO::StoreSettings(SettingsName());
+    IO::RestoreSettings(SettingsName());
+  }
+
+  /**
+   * Go back to the options given on the command line, so that the only models
+   * held by the options are the input models loaded once.
+   */
+  ~Server()
+  {
+    std::lock_guard<std::mutex> lock(requestMutex);
+    IO::RestoreSettings(SettingsName());
+  }
+
+  Server(const Server&) = delete;
+  Server& operator=(const Server&) = delete;
+
+  /**
+   * Answer a request, and return the reply.  This is thread-safe: requests
+   * from several threads wait for each other.  While the request runs, the
+   * buffers of std::cout and std::cerr of the process are replaced to catch the
+   * output of the program, so other threads must not write to them.
+   *
+   * @param request Options of the request, as on the command line.
+   */
+  std::string Handle(const std::string& request)
+  {
+    std::lock_guard<std::mutex> lock(requestMutex);
+    IO::RestoreSettings(SettingsName());
+
+    // Catch everything printed by the program.  The buffers are process-wide,
+    // which is one more reason why requests must not overlap.
+    std::ostringstream reply;
+    std::streambuf* coutBuffer = std::cout.rdbuf(reply.rdbuf());
+    std::streambuf* cerrBuffer = std::cerr.rdbuf(reply.rdbuf());
+
+    std::string error;
+    try
+    {
+      ParseRequest(request);
+      program();
+
+      for (auto& it : IO::Parameters())
+      {
+        util::ParamData& d = it.second;
+        if (!d.input)
+          IO::GetSingleton().functionMap[d.tname]["OutputParam"](d, NULL, NULL);
+      }
+    }
+    catch (const std::exception& e)
+    {
+      error = e.what();
+    }
+    catch (...)
+    {
+      error = "unknown error";
+    }
+
+    std::cout.rdbuf(coutBuffer);
+    std::cerr.rdbuf(cerrBuffer);
+
+    StopThreadTimers();
+    DeleteRequestMemory();
+
+    if (error.empty())
+      reply << "ok" << std::endl;
+    else
+      reply << "error: " << error << std::endl;
+
+    return reply.str();
+  }
+
+  /**
+   * Answer the requests read from the given stream, one per line, until the
+   * end of the stream.
+   *
+   * @param input Stream to read the requests from.
+   * @param output Stream to write the replies to.
+   */
+  void Serve(std::istream& input, std::ostream& output)
+  {
+    std::string request;
+    while (std::getline(input, request))
+    {
+      if (!request.empty() && request.back() == '\r')
+        request.pop_back();
+
+      output << Handle(request) << std::flush;
+    }
+  }
+
+  /**
+   * Answer the requests of the clients of a Unix socket created at the given
+   * path, until the process receives SIGINT or SIGTERM.  Each connection is
+   * handled by its own thread, and is a sequence of requests, one per line.
+   * This is not available on Windows.
+   *
+   * @param path Path of the socket; an existing file at this path is removed.
+   */
+  void Serve(const std::string& path)
+  {
+    #ifdef _WIN32
+    Log::Fatal << "Serving on a socket is not supported on Windows; use "
+        << "'-' to serve on standard input." << std::endl;
+    #else
+    sockaddr_un address;
+    if (path.size() >= sizeof(address.sun_path))
+    {
+      Log::Fatal << "Socket path '" << path << "' is too long (the maximum "
+          << "length is " << sizeof(address.sun_path) - 1 << ")." << std::endl;
+    }
+
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, path.c_str());
+
+    const int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0)
+      Log::Fatal << "Could not create a socket." << std::endl;
+
+    unlink(path.c_str());
+    if (bind(listener, (sockaddr*) &address, sizeof(address)) != 0 ||
+        listen(listener, SOMAXCONN) != 0)
+    {
+      close(listener);
+      Log::Fatal << "Could not listen on socket '" << path << "'."
+          << std::endl;
+    }
+
+    // Clients that disconnect while a reply is sent must not kill the server.
+    std::signal(SIGPIPE, SIG_IGN);
+    Stopping() = 0;
+    void (*previousInt)(int) = std::signal(SIGINT, &Server::Stop);
+    void (*previousTerm)(int) = std::signal(SIGTERM, &Server::Stop);
+
+    Log::Info << "Serving on socket '" << path << "'." << std::endl;
+
+    struct Connection
+    {
+      std::thread thread;
+      std::atomic<bool> done;
+    };
+    std::list<std::unique_ptr<Connection>> connections;
+
+    while (!Stopping())
+    {
+      // Join the threads of the connections that were closed.
+      for (auto it = connections.begin(); it != connections.end(); )
+      {
+        if ((*it)->done)
+        {
+          (*it)->thread.join();
+          it = connections.erase(it);
+        }
+        else
+        {
+          ++it;
+        }
+      }
+
+      if (!WaitReadable(listener))
+        continue;
+
+      const int client = accept(listener, NULL, NULL);
+      if (client < 0)
+        continue;
+
+      connections.emplace_back(new Connection());
+      Connection& connection = *connections.back();
+      connection.done = false;
+      connection.thread = std::thread([this, client, &connection]()
+      {
+        ServeConnection(client);
+        close(client);
+        connection.done = true;
+      });
+    }
+
+    for (std::unique_ptr<Connection>& connection : connections)
+      connection->thread.join();
+
+    close(listener);
+    unlink(path.c_str());
+    std::signal(SIGINT, previousInt);
+    std::signal(SIGTERM, previousTerm);
+    #endif
+  }
+
+  //! Get the names of the input model options that were loaded once.
+  const std::set<std::string>& ServedParameters() const
+  {
+    return servedParameters;
+  }
+
+ private:
+  //! The name that the options of the command line are stored under.
+  static std::string SettingsName() { return "mlpack_serve"; }
+
+  //! Whether Serve() should stop; set by the signal handler.
+  static volatile std::sig_atomic_t& Stopping()
+  {
+    static volatile std::sig_atomic_t stopping = 0;
+    return stopping;
+  }
+
+  //! Signal handler that stops Serve().
+  static void Stop(int /* signal */) { Stopping() = 1; }
+
+  //! Parse the options of a request into IO.
+  void ParseRequest(const std::string& request)
+  {
+    CLI::App app;
+    app.set_help_flag();
+
+    std::map<std::string, util::ParamData>& parameters = IO::Parameters();
+    for (auto& it : parameters)
+    {
+      util::ParamData& d = it.second;
+      IO::GetSingleton().functionMap[d.tname]["AddToCLI11"](d, NULL,
+          (void*) &app);
+    }
+
+    app.parse(request, false);
+
+    for (auto& it : parameters)
+    {
+      util::ParamData& d = it.second;
+      const bool forbidden = (d.name == "help" || d.name == "info" ||
+          d.name == "version" || d.name == "serve" ||
+          d.name == "timers_file" ||
+          servedParameters.count(d.name) > 0);
+      if (!forbidden)
+        continue;
+
+      std::string cliName;
+      IO::GetSingleton().functionMap[d.tname]["MapParameterName"](d, NULL,
+          (void*) &cliName);
+      if (app.count("--" + cliName) > 0)
+      {
+        std::ostringstream oss;
+        oss << "option --" << cliName << " cannot be given in a request";
+        throw std::invalid_argument(oss.str());
+      }
+    }
+  }
+
+  //! Stop the timers that the program left running on the calling thread,
+  //! for instance because it failed.
+  void StopThreadTimers()
+  {
+    Timers& timers = IO::GetSingleton().timer;
+    for (auto& it : timers.GetAllTimers())
+    {
+      if (timers.GetState(it.first, std::this_thread::get_id()))
+        timers.StopTimer(it.first, std::this_thread::get_id());
+    }
+  }
+
+  //! Delete the models that the program created for a request.
+  void DeleteRequestMemory()
+  {
+    std::set<void*> deleted(servedModels);
+    for (auto& it : IO::Parameters())
+    {
+      util::ParamData& d = it.second;
+
+      void* result;
+      IO::GetSingleton().functionMap[d.tname]["GetAllocatedMemory"](d, NULL,
+          (void*) &result);
+      if (result != NULL && deleted.count(result) == 0)
+      {
+        IO::GetSingleton().functionMap[d.tname]["DeleteAllocatedMemory"](d,
+            NULL, NULL);
+        deleted.insert(result);
+      }
+    }
+  }
+
+  #ifndef _WIN32
+  //! Wait a short time for the given descriptor to be readable; return false
+  //! if it is not.
+  static bool WaitReadable(const int fd)
+  {
+    pollfd p;
+    p.fd = fd;
+    p.events = POLLIN;
+    p.revents = 0;
+    return (poll(&p, 1, 200) > 0);
+  }
+
+  //! Answer the requests of a connection until it is closed or Serve() stops.
+  void ServeConnection(const int client)
+  {
+    std::string buffer;
+    char data[4096];
+    while (!Stopping())
+    {
+      if (!WaitReadable(client))
+        continue;
+
+      const ssize_t size = recv(client, data, sizeof(data), 0);
+      if (size <= 0)
+        return;
+      buffer.append(data, size);
+
+      size_t end;
+      while ((end = buffer.find('\n')) != std::string::npos)
+      {
+        std::string request = buffer.substr(0, end);
+        buffer.erase(0, end + 1);
+        if (!request.empty() && request.back() == '\r')
+          request.pop_back();
+
+        const std::string reply = Handle(request);
+        for (size_t sent = 0; sent < reply.size(); )
+        {
+          const ssize_t written = send(client, reply.data() + sent,
+              reply.size() - sent, 0);
+          if (written <= 0)
+            return;
+          sent += written;
+        }
+      }
+    }
+  }
+  #endif
+
+  //! The function that runs the program.
+  std::function<void()> program;
+
+  //! The input models loaded once.
+  std::set<void*> servedModels;
+
+  //! The names of the options of the input models loaded once.
+  std::set<std::string> servedParameters;
+
+  //! Makes requests run one at a time.
+  std::mutex requestMutex;
+};
+
+/**
+ * Run the program in serving mode: answer requests on the Unix socket given
+ * with --serve, or on standard input if it is "-".  See Server.
+ *
+ * @param program Function that runs the program (mlpackMain()).
+ */
+inline void Serve(std::function<void()> program)
+{
+  const std::string path = IO::GetParam<std::string>("serve");
+
+  Server server(std::move(program));
+  if (path == "-")
+    server.Serve(std::cin, std::cout);
+  else
+    server.Serve(path);
+}
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
@@ -14,6 +14,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include "strip_type.hpp"
+#include "print_model_methods.hpp"
 
 namespace mlpack {
 namespace bindings {
@@ -39,10 +40,13 @@ void ImportDecl(
    *
    * cdef cppclass Type:
    *   Type() nogil
+   *
+   * followed by the declarations of the direct methods of the model, if any.
    */
   const std::string prefix = std::string(indent, ' ');
   std::cout << prefix << "cdef cppclass " << defaultsType << ":" << std::endl;
   std::cout << prefix << "  " << strippedType << "() nogil" << std::endl;
+  PrintModelMethodDecls<T>(prefix + "  ");
   std::cout << prefix << std::endl;
 }
 
@@ -12,6 +12,12 @@ object, then the numpy object will "own" the matrix.
 Thus, know that if you convert a matrix type, remember that the resulting type
 is what "owns" the allocated memory.
 
+A numpy matrix that does not own its memory (a view, or a memory-mapped array)
+is copied, because bindings may modify their inputs in place, unless the caller
+opted in with matrix_utils.alias_input_views() and ownership need not be taken.
+Read-only matrices are always copied.  The copies that are made are counted by
+matrix_utils.copy_count().
+
 mlpack is free software; you may redistribute it and/or modify it under the
 terms of the 3-clause BSD license.  You should have received a copy of the
 3-clause BSD license along with mlpack.  If not, see
@@ -26,6 +32,8 @@ numpy.import_array()
 cimport arma
 from libcpp cimport bool
 
+from matrix_utils import record_copy, aliasing_input_views
+
 import platform
 isWin = (platform.system() == "Windows")
 
@@ -43,19 +51,41 @@ cdef extern from "<mlpack/bindings/python/mlpack/arma_util.hpp>":
   size_t* GetMemory(arma.Col[size_t]& m)
   size_t* GetMemory(arma.Row[size_t]& m)
 
+cdef object copy_reason(numpy.ndarray X, bool takeOwnership):
+  """
+  Return why the given numpy array must be copied before it is used as the
+  memory of an Armadillo object, or None if it can be used in place.  On
+  Windows, Armadillo copies the memory itself.
+  """
+  if not X.flags.c_contiguous:
+    return "the matrix is not C-contiguous"
+  if isWin:
+    return None
+  if not X.flags.writeable:
+    return "the matrix is read-only"
+  if not X.flags.owndata and (takeOwnership or not aliasing_input_views()):
+    return "the matrix does not own its memory"
+  return None
+
 cdef arma.Mat[double]* numpy_to_mat_d(numpy.ndarray[numpy.double_t, ndim=2] X, \
                                       bool takeOwnership) except +:
   """
   Convert a numpy ndarray to a matrix.  The memory will still be owned by numpy.
   """
-  if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
-    # If needed, make a copy where we own the memory.
+  reason = copy_reason(X, takeOwnership)
+  if reason is not None:
+    # Make a copy where we own the memory.
     X = X.copy(order="C")
+    record_copy(X, reason)
     takeOwnership = True
 
   cdef arma.Mat[double]* m = new arma.Mat[double](<double*> X.data, X.shape[1],\
       X.shape[0], isWin, False)
 
+  # On Windows, Armadillo copies the memory instead of using it.
+  if isWin:
+    record_copy(X, "Armadillo copies the memory on Windows")
+
   # Take ownership of the memory, if we need to and we are not on Windows.
   if takeOwnership and not isWin:
     PyArray_CLEARFLAGS(X, numpy.NPY_OWNDATA)
@@ -68,15 +98,20 @@ cdef arma.Mat[size_t]* numpy_to_mat_s(numpy.ndarray[numpy.npy_intp, ndim=2] X, \
   """
   Convert a numpy ndarray to a matrix.  The memory will still be owned by numpy.
   """
-  if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  reason = copy_reason(X, takeOwnership)
+  if reason is not None:
+    # Make a copy where we own the memory.
     X = X.copy(order="C")
+    record_copy(X, reason)
     takeOwnership = True
 
   cdef arma.Mat[size_t]* m = new arma.Mat[size_t](<size_t*> X.data, X.shape[1],
       X.shape[0], isWin, False)
 
+  # On Windows, Armadillo copies the memory instead of using it.
+  if isWin:
+    record_copy(X, "Armadillo copies the memory on Windows")
+
   # Take ownership of the memory, if we need to.
   if takeOwnership and not isWin:
     PyArray_CLEARFLAGS(X, numpy.NPY_OWNDATA)
@@ -97,6 +132,7 @@ cdef numpy.ndarray[numpy.double_t, ndim=2] mat_to_numpy_d(arma.Mat[double]& X) \
       numpy.PyArray_SimpleNewFromData(2, &dims[0], numpy.NPY_DOUBLE, GetMemory(X))
   if isWin:
     output = output.copy(order="C")
+    record_copy(output, "memory cannot be handed over to numpy on Windows")
 
   # Transfer memory ownership, if needed.
   if GetMemState[arma.Mat[double]](X) == 0 and not isWin:
@@ -118,6 +154,7 @@ cdef numpy.ndarray[numpy.npy_intp, ndim=2] mat_to_numpy_s(arma.Mat[size_t]& X) \
       numpy.PyArray_SimpleNewFromData(2, &dims[0], numpy.NPY_INTP, GetMemory(X))
   if isWin:
     output = output.copy(order="C")
+    record_copy(output, "memory cannot be handed over to numpy on Windows")
 
   # Transfer memory ownership, if needed.
   if GetMemState[arma.Mat[size_t]](X) == 0 and not isWin:
@@ -132,15 +169,20 @@ cdef arma.Row[double]* numpy_to_row_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
   Convert a numpy one-dimensional ndarray to a row.  The memory will still be
   owned by numpy.
   """
-  if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  reason = copy_reason(X, takeOwnership)
+  if reason is not None:
+    # Make a copy where we own the memory.
     X = X.copy(order="C")
+    record_copy(X, reason)
     takeOwnership = True
 
   cdef arma.Row[double]* m = new arma.Row[double](<double*> X.data, X.shape[0],
       isWin, False)
 
+  # On Windows, Armadillo copies the memory instead of using it.
+  if isWin:
+    record_copy(X, "Armadillo copies the memory on Windows")
+
   # Transfer memory ownership, if needed.
   if takeOwnership and not isWin:
     PyArray_CLEARFLAGS(X, numpy.NPY_OWNDATA)
@@ -154,15 +196,20 @@ cdef arma.Row[size_t]* numpy_to_row_s(numpy.ndarray[numpy.npy_intp, ndim=1] X, \
   Convert a numpy one-dimensional ndarray to a row.  The memory will still be
   owned by numpy.
   """
-  if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  reason = copy_reason(X, takeOwnership)
+  if reason is not None:
+    # Make a copy where we own the memory.
     X = X.copy(order="C")
+    record_copy(X, reason)
     takeOwnership = True
 
   cdef arma.Row[size_t]* m = new arma.Row[size_t](<size_t*> X.data, X.shape[0],
       isWin, False)
 
+  # On Windows, Armadillo copies the memory instead of using it.
+  if isWin:
+    record_copy(X, "Armadillo copies the memory on Windows")
+
   # Transfer memory ownership, if needed.
   if takeOwnership and not isWin:
     PyArray_CLEARFLAGS(X, numpy.NPY_OWNDATA)
@@ -181,6 +228,7 @@ cdef numpy.ndarray[numpy.double_t, ndim=1] row_to_numpy_d(arma.Row[double]& X) \
       numpy.PyArray_SimpleNewFromData(1, &dim, numpy.NPY_DOUBLE, GetMemory(X))
   if isWin:
     output = output.copy(order="C")
+    record_copy(output, "memory cannot be handed over to numpy on Windows")
 
   # Transfer memory ownership, if needed.
   if GetMemState[arma.Row[double]](X) == 0 and not isWin:
@@ -201,6 +249,7 @@ cdef numpy.ndarray[numpy.npy_intp, ndim=1] row_to_numpy_s(arma.Row[size_t]& X) \
       numpy.PyArray_SimpleNewFromData(1, &dim, numpy.NPY_INTP, GetMemory(X))
   if isWin:
     output = output.copy(order="C")
+    record_copy(output, "memory cannot be handed over to numpy on Windows")
 
   # Transfer memory ownership, if needed.
   if GetMemState[arma.Row[size_t]](X) == 0 and not isWin:
@@ -215,15 +264,20 @@ cdef arma.Col[double]* numpy_to_col_d(numpy.ndarray[numpy.double_t, ndim=1] X, \
   Convert a numpy one-dimensional ndarray to a column vector.  The memory will
   still be owned by numpy.
   """
-  if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  reason = copy_reason(X, takeOwnership)
+  if reason is not None:
+    # Make a copy where we own the memory.
     X = X.copy(order="C")
+    record_copy(X, reason)
     takeOwnership = True
 
   cdef arma.Col[double]* m = new arma.Col[double](<double*> X.data, X.shape[0],
       isWin, False)
 
+  # On Windows, Armadillo copies the memory instead of using it.
+  if isWin:
+    record_copy(X, "Armadillo copies the memory on Windows")
+
   # Transfer memory ownership, if needed.
   if takeOwnership and not isWin:
     PyArray_CLEARFLAGS(X, numpy.NPY_OWNDATA)
@@ -237,15 +291,20 @@ cdef arma.Col[size_t]* numpy_to_col_s(numpy.ndarray[numpy.npy_intp, ndim=1] X, \
   Convert a numpy one-dimensional ndarray to a column vector.  The memory will
   still be owned by numpy.
   """
-  if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
-    # If needed, make a copy where we own the memory, except on Windows where
-    # we never copy.
+  reason = copy_reason(X, takeOwnership)
+  if reason is not None:
+    # Make a copy where we own the memory.
     X = X.copy(order="C")
+    record_copy(X, reason)
     takeOwnership = True
 
   cdef arma.Col[size_t]* m = new arma.Col[size_t](<size_t*> X.data, X.shape[0],
       isWin, False)
 
+  # On Windows, Armadillo copies the memory instead of using it.
+  if isWin:
+    record_copy(X, "Armadillo copies the memory on Windows")
+
   # Transfer memory ownership, if needed.
   if takeOwnership and not isWin:
     PyArray_CLEARFLAGS(X, numpy.NPY_OWNDATA)
@@ -264,6 +323,7 @@ cdef numpy.ndarray[numpy.double_t, ndim=1] col_to_numpy_d(arma.Col[double]& X) \
       numpy.PyArray_SimpleNewFromData(1, &dim, numpy.NPY_DOUBLE, GetMemory(X))
   if isWin:
     output = output.copy(order="C")
+    record_copy(output, "memory cannot be handed over to numpy on Windows")
 
   # Transfer memory ownership, if needed.
   if GetMemState[arma.Col[double]](X) == 0 and not isWin:
@@ -283,6 +343,7 @@ cdef numpy.ndarray[numpy.npy_intp, ndim=1] col_to_numpy_s(arma.Col[size_t]& X) \
       numpy.PyArray_SimpleNewFromData(1, &dim, numpy.NPY_INTP, GetMemory(X))
   if isWin:
     output = output.copy(order="C")
+    record_copy(output, "memory cannot be handed over to numpy on Windows")
 
   # Transfer memory ownership, if needed.
   if GetMemState[arma.Col[size_t]](X) == 0 and not isWin:
@@ -38,6 +38,12 @@ cdef extern from "<mlpack/core/util/io.hpp>" namespace "mlpack" nogil:
     @staticmethod
     void ClearSettings() nogil except +
 
+    @staticmethod
+    void BeginContext(string) nogil except +
+
+    @staticmethod
+    void EndContext() nogil except +
+
     @staticmethod
     void CheckInputMatrices() nogil except +
 
@@ -4,13 +4,16 @@ matrix_utils.py: utilities for matrix conversion
 
 This file defines the to_matrix() function, which can be used to convert Pandas
 dataframes or other types of array-like objects to numpy ndarrays for use in
-mlpack bindings.
+mlpack bindings.  It also keeps count of the matrices that had to be copied to
+be passed to mlpack; see copy_count().
 
 mlpack is free software; you may redistribute it and/or modify it under the
 terms of the 3-clause BSD license.  You should have received a copy of the
 3-clause BSD license along with mlpack.  If not, see
 http://www.opensource.org/licenses/BSD-3-Clause for more information.
 """
+import warnings
+
 import numpy as np
 import pandas as pd
 # The CategoricalDtype class has moved multiple times, so this insanity is
@@ -37,6 +40,78 @@ try:
 except:
   buffer = memoryview
 
+class CopyWarning(UserWarning):
+  """
+  Warning issued, if enabled with warn_on_copy(), when a matrix has to be copied
+  to be passed to mlpack.
+  """
+  pass
+
+_copies = { 'count': 0, 'bytes': 0, 'warn': False, 'alias_views': False }
+
+def copy_count():
+  """
+  Return the number of matrices that had to be copied to be passed to or from
+  mlpack since the last call to reset_copy_count().  Copies requested with
+  copy_all_inputs are not counted.
+
+  Matrices can only be passed without a copy if they are C-contiguous numpy
+  arrays (or pandas objects backed by one) of the element type of the parameter
+  (np.double for matrices, np.intp for index matrices and labels).  Any other
+  layout or type (for instance F-contiguous or np.float32 arrays) is copied.
+  """
+  return _copies['count']
+
+def copied_bytes():
+  """
+  Return the total size, in bytes, of the copies counted by copy_count().
+  """
+  return _copies['bytes']
+
+def reset_copy_count():
+  """
+  Reset the counts returned by copy_count() and copied_bytes().
+  """
+  _copies['count'] = 0
+  _copies['bytes'] = 0
+
+def warn_on_copy(enable=True):
+  """
+  Issue a CopyWarning each time a matrix has to be copied to be passed to or
+  from mlpack (if enable is True), or stop doing so (if enable is False).
+  """
+  _copies['warn'] = enable
+
+def alias_input_views(enable=True):
+  """
+  Pass writeable input matrices that do not own their memory (views of other
+  arrays, or writeable memory-mapped arrays) to mlpack without a copy (if
+  enable is True), or copy them (if enable is False, the default).
+
+  Bindings may modify their input matrices in place (for instance, building a
+  tree reorders the points), so with this option a view's base array may be
+  changed by a call.  Read-only arrays are always copied.
+  """
+  _copies['alias_views'] = enable
+
+def aliasing_input_views():
+  """
+  Return whether writeable input matrices that do not own their memory are
+  passed without a copy; see alias_input_views().
+  """
+  return _copies['alias_views']
+
+def record_copy(x, reason):
+  """
+  Count a copy of the given numpy array, made for the given reason, and warn
+  about it if warn_on_copy() was called.
+  """
+  _copies['count'] += 1
+  _copies['bytes'] += x.nbytes
+  if _copies['warn']:
+    warnings.warn("copying a matrix of shape " + str(x.shape) + " (" +
+        str(x.nbytes) + " bytes): " + reason, CopyWarning, stacklevel=3)
+
 def to_matrix(x, dtype=np.double, copy=False):
   """
   Given some array-like X, return a numpy ndarray of the same type.
@@ -54,7 +129,10 @@ def to_matrix(x, dtype=np.double, copy=False):
       return x, False
   elif (isinstance(x, np.ndarray) and x.dtype == dtype and x.flags.f_contiguous):
     # A copy is always necessary here.
-    return x.copy("C"), True
+    y = x.copy("C")
+    if not copy:
+      record_copy(y, "the matrix is not C-contiguous")
+    return y, True
   else:
     if isinstance(x, pd.core.series.Series) or isinstance(x, pd.DataFrame):
       # We can only avoid a copy if the dtype is the same and the copy flag is
@@ -66,9 +144,20 @@ def to_matrix(x, dtype=np.double, copy=False):
             False
       else:
         # We have to make a copy or change the dtype, so just do this directly.
-        return np.array(y, dtype=dtype, order='C', copy=True), True
+        z = np.array(y, dtype=dtype, order='C', copy=True)
+        if not copy:
+          record_copy(z, "the data is not C-contiguous or its type is " +
+              str(y.dtype) + " instead of " + str(np.dtype(dtype)))
+        return z, True
     else:
-      return np.array(x, copy=True, dtype=dtype, order='C'), True
+      y = np.array(x, copy=True, dtype=dtype, order='C')
+      if not copy:
+        if isinstance(x, np.ndarray):
+          record_copy(y, "the matrix is not C-contiguous or its type is " +
+              str(x.dtype) + " instead of " + str(np.dtype(dtype)))
+        else:
+          record_copy(y, "the matrix is not a numpy ndarray")
+      return y, True
 
 
 def to_matrix_with_info(x, dtype, copy=False):
@@ -89,11 +178,9 @@ def to_matrix_with_info(x, dtype, copy=False):
     else:
       d = np.zeros([x.shape[1]], dtype=np.bool)
 
-    # Copy the matrix if needed.
-    if copy:
-      return (x.copy(order="C"), True, d)
-    else:
-      return (x, False, d)
+    # Convert the matrix if needed; this only copies it if it has to be copied.
+    t = to_matrix(x, dtype=dtype, copy=copy)
+    return (t[0], t[1], d)
 
   if isinstance(x, pd.DataFrame) or isinstance(x, pd.Series):
     # It's a pandas dataframe.  So we need to see if any of the dtypes are
@@ -13,6 +13,7 @@
 #define MLPACK_BINDINGS_PYTHON_PRINT_CLASS_DEFN_HPP
 
 #include "strip_type.hpp"
+#include "print_model_methods.hpp"
 
 namespace mlpack {
 namespace bindings {
@@ -78,6 +79,9 @@ void PrintClassDefn(
    *   def __reduce_ex__(self):
    *     return (self.__class__, (), self.__getstate__())
    * @endcode
+   *
+   * followed by the direct methods of the model, if any (see
+   * PrintModelMethods()).
    */
   std::cout << "cdef class " << strippedType << "Type:" << std::endl;
   std::cout << "  cdef " << printedType << "* modelptr" << std::endl;
@@ -100,6 +104,7 @@ void PrintClassDefn(
   std::cout << "    return (self.__class__, (), self.__getstate__())"
       << std::endl;
   std::cout << std::endl;
+  PrintModelMethods<T>();
 }
 
 /**
@@ -0,0 +1,188 @@
+/**
+ * @file bindings/python/print_model_methods.hpp
+ *
+ * Print the direct methods of a model class: methods of the Python model
+ * object which call the C++ model without going through the parameters of the
+ * binding, for repeated calls on an already-trained model.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_PYTHON_PRINT_MODEL_METHODS_HPP
+#define MLPACK_BINDINGS_PYTHON_PRINT_MODEL_METHODS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/sfinae_utility.hpp>
+
+namespace mlpack {
+namespace bindings {
+namespace python {
+
+HAS_MEM_FUNC(Classify, HasDirectClassifyCheck);
+HAS_MEM_FUNC(Search, HasDirectSearchCheck);
+
+/**
+ * A model has a direct classify() method in Python if it has the member
+ *
+ * @code
+ * void Classify(const arma::mat& data,
+ *               arma::Row<size_t>& predictions,
+ *               arma::mat& probabilities) const;
+ * @endcode
+ */
+template<typename T>
+struct HasDirectClassify
+{
+  static const bool value = HasDirectClassifyCheck<T,
+      void(T::*)(const arma::mat&, arma::Row<size_t>&, arma::mat&)
+      const>::value;
+};
+
+/**
+ * A model has a direct search() method in Python if it has the member
+ *
+ * @code
+ * void Search(const arma::mat& querySet,
+ *             const size_t k,
+ *             arma::Mat<size_t>& neighbors,
+ *             arma::mat& distances);
+ * @endcode
+ */
+template<typename T>
+struct HasDirectSearch
+{
+  static const bool value = HasDirectSearchCheck<T,
+      void(T::*)(const arma::mat&, const size_t, arma::Mat<size_t>&,
+                 arma::mat&)>::value;
+};
+
+/**
+ * Print the declarations of the direct methods of the model in its cppclass
+ * definition.
+ *
+ * @param prefix Indentation of the members of the cppclass.
+ */
+template<typename T>
+void PrintModelMethodDecls(const std::string& prefix)
+{
+  if (HasDirectClassify<T>::value)
+  {
+    std::cout << prefix << "void Classify(arma.Mat[double]&, arma.Row[size_t]&,"
+        << " arma.Mat[double]&) nogil except +RuntimeError" << std::endl;
+  }
+
+  if (HasDirectSearch<T>::value)
+  {
+    std::cout << prefix << "void Search(arma.Mat[double]&, size_t, "
+        << "arma.Mat[size_t]&, arma.Mat[double]&) except +RuntimeError"
+        << std::endl;
+  }
+}
+
+/**
+ * Print the direct methods of the Python class of the model.  This gives code
+ * like:
+ *
+ * @code
+ *   def classify(self, test):
+ *     test_tuple = to_matrix(test, dtype=np.double, copy=False)
+ *     test_mat = arma_numpy.numpy_to_mat_d(test_tuple[0], test_tuple[1])
+ *     with nogil:
+ *       self.modelptr.Classify(dereference(test_mat), predictions,
+ *           probabilities)
+ *     ...
+ * @endcode
+ *
+ * The matrices are passed without copies where the usual input processing would
+ * not copy them either, and the model is neither copied nor serialized.
+ *
+ * classify() calls a const member, so it releases the GIL and several threads
+ * may classify with the same model at once.  search() calls a non-const member
+ * which updates the statistics of the model and writes to Log, so it keeps the
+ * GIL and calls on any model are serialized.
+ */
+template<typename T>
+void PrintModelMethods()
+{
+  if (HasDirectClassify<T>::value)
+  {
+    std::cout << "  def classify(self, test):" << std::endl;
+    std::cout << "    \"\"\"" << std::endl;
+    std::cout << "    Classify the points of the given matrix with the model "
+        << "directly, without" << std::endl;
+    std::cout << "    going through the parameters of the binding.  Return a "
+        << "dict with the" << std::endl;
+    std::cout << "    'predictions' and the 'probabilities'." << std::endl;
+    std::cout << std::endl;
+    std::cout << "    The GIL is released during the classification, so "
+        << "several threads may" << std::endl;
+    std::cout << "    call this method of the same model at once." << std::endl;
+    std::cout << "    \"\"\"" << std::endl;
+    std::cout << "    cdef arma.Mat[double]* test_mat" << std::endl;
+    std::cout << "    cdef arma.Row[size_t] predictions" << std::endl;
+    std::cout << "    cdef arma.Mat[double] probabilities" << std::endl;
+    std::cout << "    test_tuple = to_matrix(test, dtype=np.double, copy=False)"
+        << std::endl;
+    std::cout << "    test_mat = arma_numpy.numpy_to_mat_d(test_tuple[0], "
+        << "test_tuple[1])" << std::endl;
+    std::cout << "    try:" << std::endl;
+    std::cout << "      with nogil:" << std::endl;
+    std::cout << "        self.modelptr.Classify(dereference(test_mat), "
+        << "predictions, probabilities)" << std::endl;
+    std::cout << "    finally:" << std::endl;
+    std::cout << "      del test_mat" << std::endl;
+    std::cout << "    result = {}" << std::endl;
+    std::cout << "    result['predictions'] = arma_numpy.row_to_numpy_s("
+        << "predictions)" << std::endl;
+    std::cout << "    result['probabilities'] = arma_numpy.mat_to_numpy_d("
+        << "probabilities)" << std::endl;
+    std::cout << "    return result" << std::endl;
+    std::cout << std::endl;
+  }
+
+  if (HasDirectSearch<T>::value)
+  {
+    std::cout << "  def search(self, query, int k):" << std::endl;
+    std::cout << "    \"\"\"" << std::endl;
+    std::cout << "    Find the k nearest neighbors of the points of the given "
+        << "matrix with the" << std::endl;
+    std::cout << "    model directly, without going through the parameters of "
+        << "the binding." << std::endl;
+    std::cout << "    Return a dict with the 'neighbors' and the 'distances'."
+        << std::endl;
+    std::cout << std::endl;
+    std::cout << "    The GIL is held during the search, since it modifies the "
+        << "model, so calls" << std::endl;
+    std::cout << "    from several threads run one at a time." << std::endl;
+    std::cout << "    \"\"\"" << std::endl;
+    std::cout << "    cdef arma.Mat[double]* query_mat" << std::endl;
+    std::cout << "    cdef arma.Mat[size_t] neighbors" << std::endl;
+    std::cout << "    cdef arma.Mat[double] distances" << std::endl;
+    std::cout << "    if k <= 0:" << std::endl;
+    std::cout << "      raise ValueError(\"k must be positive!\")" << std::endl;
+    std::cout << "    query_tuple = to_matrix(query, dtype=np.double, "
+        << "copy=False)" << std::endl;
+    std::cout << "    query_mat = arma_numpy.numpy_to_mat_d(query_tuple[0], "
+        << "query_tuple[1])" << std::endl;
+    std::cout << "    try:" << std::endl;
+    std::cout << "      self.modelptr.Search(dereference(query_mat), k, "
+        << "neighbors, distances)" << std::endl;
+    std::cout << "    finally:" << std::endl;
+    std::cout << "      del query_mat" << std::endl;
+    std::cout << "    result = {}" << std::endl;
+    std::cout << "    result['neighbors'] = arma_numpy.mat_to_numpy_s("
+        << "neighbors)" << std::endl;
+    std::cout << "    result['distances'] = arma_numpy.mat_to_numpy_d("
+        << "distances)" << std::endl;
+    std::cout << "    return result" << std::endl;
+    std::cout << std::endl;
+  }
+}
+
+} // namespace python
+} // namespace bindings
+} // namespace mlpack
+
+#endif
@@ -185,24 +185,27 @@ void PrintPYX(const util::BindingDetails& doc,
       << "returned." << endl;
   cout << "  \"\"\"" << endl;
 
-  // Reset any timers and disable backtraces.
-  cout << "  ResetTimers()" << endl;
-  cout << "  EnableTimers()" << endl;
-  cout << "  DisableBacktrace()" << endl;
-  cout << "  DisableVerbose()" << endl;
+  // Give this call its own copy of the parameters, so that calls from
+  // different threads do not interfere.
+  cout << "  IO.BeginContext(\"" << doc.programName << "\")" << endl;
+
+  // Everything else is in a try block, so that the context is always ended.
+  cout << "  try:" << endl;
 
-  // Restore the parameters.
-  cout << "  IO.RestoreSettings(\"" << doc.programName << "\")"
-      << endl;
+  // Reset any timers and disable backtraces.
+  cout << "    ResetTimers()" << endl;
+  cout << "    EnableTimers()" << endl;
+  cout << "    DisableBacktrace()" << endl;
+  cout << "    DisableVerbose()" << endl;
 
   // Determine whether or not we need to copy parameters.
-  cout << "  if isinstance(copy_all_inputs, bool):" << endl;
-  cout << "    if copy_all_inputs:" << endl;
-  cout << "      SetParam[cbool](<const string> 'copy_all_inputs', "
+  cout << "    if isinstance(copy_all_inputs, bool):" << endl;
+  cout << "      if copy_all_inputs:" << endl;
+  cout << "        SetParam[cbool](<const string> 'copy_all_inputs', "
       << "copy_all_inputs)" << endl;
-  cout << "      IO.SetPassed(<const string> 'copy_all_inputs')" << endl;
-  cout << "  else:" << endl;
-  cout << "    raise TypeError(" <<"\"'copy_all_inputs\' must have type "
+  cout << "        IO.SetPassed(<const string> 'copy_all_inputs')" << endl;
+  cout << "    else:" << endl;
+  cout << "      raise TypeError(" <<"\"'copy_all_inputs\' must have type "
       << "\'bool'!\")" << endl;
   cout << endl;
 
@@ -211,53 +214,54 @@ void PrintPYX(const util::BindingDetails& doc,
   {
     util::ParamData& d = parameters.at(inputOptions[i]);
 
-    size_t indent = 2;
+    size_t indent = 4;
     IO::GetSingleton().functionMap[d.tname]["PrintInputProcessing"](d,
         (void*) &indent, NULL);
   }
 
   // Set all output options as passed.
-  cout << "  # Mark all output options as passed." << endl;
+  cout << "    # Mark all output options as passed." << endl;
   for (size_t i = 0; i < outputOptions.size(); ++i)
   {
     util::ParamData& d = parameters.at(outputOptions[i]);
-    cout << "  IO.SetPassed(<const string> '" << d.name << "')" << endl;
+    cout << "    IO.SetPassed(<const string> '" << d.name << "')" << endl;
   }
 
   // Checking the type of check_input_matrices parameter.
-  cout << "  if not isinstance(check_input_matrices, bool):" << endl;
-  cout << "    raise TypeError(" <<"\"'check_input_matrices\' must have type "
+  cout << "    if not isinstance(check_input_matrices, bool):" << endl;
+  cout << "      raise TypeError(" <<"\"'check_input_matrices\' must have type "
       << "\'bool'!\")" << endl;
   cout << endl;
 
   // Before calling mlpackMain(), we check input matrices for NaN values if needed.
-  cout << "  if check_input_matrices:" << endl;
-  cout << "    IO.CheckInputMatrices()" << endl;
+  cout << "    if check_input_matrices:" << endl;
+  cout << "      IO.CheckInputMatrices()" << endl;
 
-  // Call the method.
-  cout << "  # Call the mlpack program." << endl;
-  cout << "  mlpackMain()" << endl;
+  // Call the method.  The GIL is kept: Log verbosity and the random number
+  // generator are shared by all threads, so calls must not overlap.
+  cout << "    # Call the mlpack program." << endl;
+  cout << "    mlpackMain()" << endl;
 
   // Do any output processing and return.
-  cout << "  # Initialize result dictionary." << endl;
-  cout << "  result = {}" << endl;
+  cout << "    # Initialize result dictionary." << endl;
+  cout << "    result = {}" << endl;
   cout << endl;
 
   for (size_t i = 0; i < outputOptions.size(); ++i)
   {
     util::ParamData& d = parameters.at(outputOptions[i]);
 
-    std::tuple<size_t, bool> t = std::make_tuple(2, false);
+    std::tuple<size_t, bool> t = std::make_tuple(4, false);
     IO::GetSingleton().functionMap[d.tname]["PrintOutputProcessing"](d,
         (void*) &t, NULL);
   }
 
-  // Clear the parameters.
-  cout << endl;
-  cout << "  IO.ClearSettings()" << endl;
   cout << endl;
+  cout << "    return result" << endl;
 
-  cout << "  return result" << endl;
+  // Drop the parameters of this call, even if it failed.
+  cout << "  finally:" << endl;
+  cout << "    IO.EndContext()" << endl;
 }
 
 } // namespace python
@@ -15,6 +15,9 @@ import numpy as np
 
 from mlpack.matrix_utils import to_matrix
 from mlpack.matrix_utils import to_matrix_with_info
+from mlpack.matrix_utils import copy_count, copied_bytes, reset_copy_count
+from mlpack.matrix_utils import warn_on_copy, CopyWarning
+import warnings
 
 class TestToMatrix(unittest.TestCase):
   """
@@ -306,6 +309,80 @@ class TestToMatrixWithInfo(unittest.TestCase):
     self.assertTrue(m[1] != m[2])
     self.assertTrue(m[0] != m[2])
 
+class TestCopyCount(unittest.TestCase):
+  """
+  This class tests that the copies made to pass matrices to mlpack are counted.
+  """
+
+  def testCContiguousNoCopy(self):
+    """
+    A C-contiguous matrix of the right type, or a view of one, is not copied.
+    """
+    reset_copy_count()
+    x = np.random.randn(100, 4)
+
+    m, own = to_matrix(x)
+    self.assertFalse(own)
+    self.assertTrue(m is x)
+
+    m, own = to_matrix(x[10:20])
+    self.assertFalse(own)
+
+    self.assertEqual(copy_count(), 0)
+    self.assertEqual(copied_bytes(), 0)
+
+  def testFContiguousCopy(self):
+    """
+    An F-contiguous matrix is copied, and the copy is counted.
+    """
+    reset_copy_count()
+    x = np.asfortranarray(np.random.randn(100, 4))
+
+    m, own = to_matrix(x)
+    self.assertTrue(own)
+    self.assertTrue(m.flags.c_contiguous)
+    self.assertEqual(copy_count(), 1)
+    self.assertEqual(copied_bytes(), 100 * 4 * 8)
+
+  def testFloat32Copy(self):
+    """
+    A float32 matrix is converted, and the copy is counted.
+    """
+    reset_copy_count()
+    x = np.random.randn(100, 4).astype(np.float32)
+
+    m, own, _ = to_matrix_with_info(x, np.double)
+    self.assertTrue(own)
+    self.assertEqual(m.dtype, np.dtype(np.double))
+    self.assertEqual(copy_count(), 1)
+
+  def testRequestedCopyNotCounted(self):
+    """
+    A copy requested with copy=True is not counted.
+    """
+    reset_copy_count()
+    x = np.asfortranarray(np.random.randn(100, 4))
+
+    to_matrix(x, copy=True)
+    to_matrix(np.random.randn(100, 4), copy=True)
+    self.assertEqual(copy_count(), 0)
+
+  def testCopyWarning(self):
+    """
+    A CopyWarning is issued for each copy if warn_on_copy() was called.
+    """
+    x = np.random.randn(100, 4).astype(np.float32)
+
+    warn_on_copy()
+    with warnings.catch_warnings(record=True) as w:
+      warnings.simplefilter("always")
+      to_matrix(x)
+      to_matrix(np.random.randn(100, 4))
+    warn_on_copy(False)
+
+    self.assertEqual(len(w), 1)
+    self.assertTrue(issubclass(w[0].category, CopyWarning))
+
 def test_suite():
     """
     Run all tests.
@@ -314,6 +391,7 @@ def test_suite():
     suite = unittest.TestSuite()
     suite.addTest(loader.loadTestsFromTestCase(TestToMatrix))
     suite.addTest(loader.loadTestsFromTestCase(TestToMatrixWithInfo))
+    suite.addTest(loader.loadTestsFromTestCase(TestCopyCount))
     return suite
 
 if __name__ == '__main__':
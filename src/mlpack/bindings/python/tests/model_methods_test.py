@@ -0,0 +1,68 @@
+#!/usr/bin/env python
+"""
+model_methods_test.py
+
+Test that the direct methods of the model classes give the same results as the
+bindings themselves.
+
+mlpack is free software; you may redistribute it and/or modify it under the
+terms of the 3-clause BSD license.  You should have received a copy of the
+3-clause BSD license along with mlpack.  If not, see
+http://www.opensource.org/licenses/BSD-3-Clause for more information.
+"""
+import unittest
+import numpy as np
+
+from mlpack import knn
+from mlpack import random_forest
+
+class TestModelMethods(unittest.TestCase):
+  """
+  This class tests the classify() and search() methods of the models.
+  """
+
+  def testRandomForestClassify(self):
+    """
+    Test that classify() on a random forest model gives the predictions and
+    probabilities of the random_forest binding.
+    """
+    x = np.random.rand(100, 4)
+    y = (x[:, 0] > 0.5).astype(np.intp)
+    test = np.random.rand(20, 4)
+
+    output = random_forest(training=x, labels=y, num_trees=5, test=test)
+    model = output['output_model']
+
+    result = model.classify(test)
+    self.assertTrue(np.array_equal(result['predictions'],
+                                   output['predictions']))
+    self.assertTrue(np.allclose(result['probabilities'],
+                                output['probabilities']))
+
+    # The model can be used again, and the input is not modified.
+    test_copy = test.copy()
+    result = model.classify(test)
+    self.assertTrue(np.array_equal(result['predictions'],
+                                   output['predictions']))
+    self.assertTrue(np.array_equal(test, test_copy))
+
+  def testKNNSearch(self):
+    """
+    Test that search() on a kNN model gives the neighbors and distances of the
+    knn binding.
+    """
+    reference = np.random.rand(200, 3)
+    query = np.random.rand(30, 3)
+
+    output = knn(reference=reference, k=4, query=query)
+    model = output['output_model']
+
+    result = model.search(query, 4)
+    self.assertTrue(np.array_equal(result['neighbors'], output['neighbors']))
+    self.assertTrue(np.allclose(result['distances'], output['distances']))
+
+    with self.assertRaises(ValueError):
+      model.search(query, 0)
+
+if __name__ == '__main__':
+  unittest.main()
@@ -13,8 +13,10 @@ import unittest
 import pandas as pd
 import numpy as np
 import copy
+import threading
 
 from mlpack.test_python_binding import test_python_binding
+from mlpack.matrix_utils import alias_input_views, copy_count, reset_copy_count
 
 class TestPythonBinding(unittest.TestCase):
   """
@@ -157,6 +159,66 @@ class TestPythonBinding(unittest.TestCase):
       self.assertEqual(2 * x[j, 2], output['matrix_out'][j, 2])
 
 
+  def testNumpyReadOnlyMatrix(self):
+    """
+    A read-only matrix (such as a read-only memory-mapped array) is copied, so
+    it can be passed in and is not modified.
+    """
+    x = np.random.rand(100, 5);
+    z = copy.deepcopy(x)
+    z.setflags(write=False)
+
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 mat_req_in=[[1.0]],
+                                 col_req_in=[1.0],
+                                 matrix_in=z)
+
+    self.assertEqual(output['matrix_out'].shape[0], 100)
+    self.assertEqual(output['matrix_out'].shape[1], 4)
+    for j in range(100):
+      self.assertEqual(x[j, 0], output['matrix_out'][j, 0])
+      self.assertEqual(2 * x[j, 2], output['matrix_out'][j, 2])
+    self.assertTrue((z == x).all())
+
+  def testNumpyViewNotModified(self):
+    """
+    A view of another array is copied, so the array it views is not modified,
+    unless the caller opted in with alias_input_views().
+    """
+    x = np.random.rand(200, 5);
+    z = copy.deepcopy(x)
+
+    reset_copy_count()
+    output = test_python_binding(string_in='hello',
+                                 int_in=12,
+                                 double_in=4.0,
+                                 mat_req_in=[[1.0]],
+                                 col_req_in=[1.0],
+                                 matrix_in=z[50:150])
+
+    self.assertTrue(copy_count() >= 1)
+    self.assertTrue((z == x).all())
+    for j in range(100):
+      self.assertEqual(2 * x[j + 50, 2], output['matrix_out'][j, 2])
+
+    alias_input_views(True)
+    try:
+      reset_copy_count()
+      output = test_python_binding(string_in='hello',
+                                   int_in=12,
+                                   double_in=4.0,
+                                   mat_req_in=np.array([[1.0]]),
+                                   col_req_in=np.array([1.0]),
+                                   matrix_in=z[50:150])
+      self.assertEqual(copy_count(), 0)
+    finally:
+      alias_input_views(False)
+
+    for j in range(100):
+      self.assertEqual(2 * x[j + 50, 2], output['matrix_out'][j, 2])
+
   def testNumpyFContiguousMatrix(self):
     """
     The matrix with F_CONTIGUOUS set we pass in, we should get back with the third
@@ -1432,5 +1494,34 @@ class TestPythonBinding(unittest.TestCase):
                                                    matrix_and_info_in=x,
                                                    check_input_matrices=True))
 
+  def testConcurrentCalls(self):
+    """
+    Calls from several threads at the same time should each use their own
+    parameters.
+    """
+    inputs = [np.random.rand(100, 5) for i in range(8)]
+    outputs = [None] * 8
+
+    def run(i):
+      outputs[i] = test_python_binding(string_in='hello',
+                                       int_in=12,
+                                       double_in=4.0,
+                                       mat_req_in=[[1.0]],
+                                       col_req_in=[1.0],
+                                       matrix_in=copy.deepcopy(inputs[i]))
+
+    threads = [threading.Thread(target=run, args=(i,)) for i in range(8)]
+    for t in threads:
+      t.start()
+    for t in threads:
+      t.join()
+
+    for i in range(8):
+      self.assertEqual(outputs[i]['matrix_out'].shape[0], 100)
+      self.assertEqual(outputs[i]['matrix_out'].shape[1], 4)
+      for j in range(100):
+        self.assertEqual(inputs[i][j, 0], outputs[i]['matrix_out'][j, 0])
+        self.assertEqual(2 * inputs[i][j, 2], outputs[i]['matrix_out'][j, 2])
+
 if __name__ == '__main__':
   unittest.main()
@@ -14,6 +14,15 @@
 #define ARMA_EXTRA_MAT_PROTO mlpack/core/arma_extend/Mat_extra_bones.hpp
 #define ARMA_EXTRA_SPMAT_PROTO mlpack/core/arma_extend/SpMat_extra_bones.hpp
 
+// With memory tracking, Armadillo allocates through the MemoryTracker, so that
+// the memory of matrices is counted.
+#ifdef MLPACK_MEMORY_TRACKING
+  #include <mlpack/core/util/memory_tracker.hpp>
+  #define ARMA_ALIEN_MEM_ALLOC_FUNCTION(n_bytes) \
+      mlpack::MemoryTracker::Allocate(n_bytes)
+  #define ARMA_ALIEN_MEM_FREE_FUNCTION(ptr) mlpack::MemoryTracker::Free(ptr)
+#endif
+
 #include <armadillo>
 
 #endif
@@ -17,6 +17,8 @@
 #include <cereal/archives/json.hpp>
 
 #include <mlpack/core/cereal/array_wrapper.hpp>
+#include <mlpack/core/cereal/is_loading.hpp>
+#include <mlpack/core/cereal/matrix_blobs.hpp>
 
 #include <armadillo>
 
@@ -72,15 +74,12 @@ void serialize(Archive& ar, arma::Mat<eT>& mat)
   ar(CEREAL_NVP(n_cols));
   ar(CEREAL_NVP(vec_state));
 
+  // Directly serialize the contents of the matrix's memory (in one block for
+  // binary archives).
+  SerializeMatrixMemory(ar, mat, n_rows, n_cols);
+
   if (cereal::is_loading<Archive>())
-  {
-    mat.set_size(n_rows, n_cols);
     arma::access::rw(mat.vec_state) = vec_state;
-  }
-
-  // Directly serialize the contents of the matrix's memory.
-  for (size_t i = 0; i < mat.n_elem; ++i)
-    ar(cereal::make_nvp("elem", arma::access::rw(mat.mem[i])));
 }
 
 // Add a serialization function for armadillo Cube
@@ -0,0 +1,191 @@
+/**
+ * @file core/cereal/ensemble_wrapper.hpp
+ *
+ * A wrapper for the members of an ensemble (the trees of a forest, the weak
+ * learners of a boosted model), so that only the first members can be loaded.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CEREAL_ENSEMBLE_WRAPPER_HPP
+#define MLPACK_CORE_CEREAL_ENSEMBLE_WRAPPER_HPP
+
+#include <cereal/archives/binary.hpp>
+#include <cereal/archives/json.hpp>
+#include <cereal/archives/xml.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace cereal {
+
+/**
+ * While an EnsembleLoadLimit exists, the ensembles loaded by the calling thread
+ * keep only their first members.  The other members are skipped without being
+ * deserialized, so loading is faster for large ensembles:
+ *
+ * @code
+ * RandomForest<> rf;
+ * {
+ *   cereal::EnsembleLoadLimit limit(10);
+ *   data::Load("forest.bin", "rf", rf); // Loads the first 10 trees.
+ * }
+ * @endcode
+ *
+ * Limits may be nested; the innermost one applies.
+ */
+class EnsembleLoadLimit
+{
+ public:
+  /**
+   * Limit the ensembles loaded by the calling thread to the given number of
+   * members.
+   *
+   * @param limit Maximum number of members to load.
+   */
+  EnsembleLoadLimit(const size_t limit) : previous(Current())
+  {
+    Current() = limit;
+  }
+
+  //! Restore the previous limit.
+  ~EnsembleLoadLimit() { Current() = previous; }
+
+  EnsembleLoadLimit(const EnsembleLoadLimit&) = delete;
+  EnsembleLoadLimit& operator=(const EnsembleLoadLimit&) = delete;
+
+  //! Get the maximum number of members loaded by the calling thread.
+  static size_t Get() { return Current(); }
+
+ private:
+  //! The limit of the calling thread.
+  static size_t& Current()
+  {
+    static thread_local size_t limit = std::numeric_limits<size_t>::max();
+    return limit;
+  }
+
+  //! The limit before this one.
+  size_t previous;
+};
+
+/**
+ * EnsembleWrapper serializes the members of an ensemble, and loads only the
+ * first EnsembleLoadLimit::Get() of them.  In XML and JSON archives the members
+ * are stored like a std::vector, and the others are skipped when the node of
+ * the ensemble is left.  In binary archives each member is stored in its own
+ * archive, preceded by its size, so that the others can be skipped by size;
+ * this works wherever the ensemble is in the archive.  In other archives all
+ * members are loaded, and the vector is truncated.
+ */
+template<typename T>
+class EnsembleWrapper
+{
+ public:
+  EnsembleWrapper(std::vector<T>& members) : members(members) { }
+
+  template<typename Archive>
+  void save(Archive& ar) const
+  {
+    ar(make_size_tag(static_cast<size_type>(members.size())));
+    for (const T& member : members)
+      ar(member);
+  }
+
+  template<typename Archive>
+  void load(Archive& ar)
+  {
+    size_type size;
+    ar(make_size_tag(size));
+
+    const bool skips = std::is_same<Archive, XMLInputArchive>::value ||
+        std::is_same<Archive, JSONInputArchive>::value;
+    const size_t kept = std::min<size_t>(size, EnsembleLoadLimit::Get());
+    members.resize(skips ? kept : size_t(size));
+    for (T& member : members)
+      ar(member);
+    members.resize(kept);
+  }
+
+  void save(BinaryOutputArchive& ar) const
+  {
+    ar(make_size_tag(static_cast<size_type>(members.size())));
+    for (const T& member : members)
+    {
+      std::ostringstream stream(std::ios::out | std::ios::binary);
+      {
+        BinaryOutputArchive memberAr(stream);
+        memberAr(member);
+      }
+
+      const std::string bytes = stream.str();
+      const uint64_t memberSize = bytes.size();
+      ar(memberSize);
+      ar.saveBinary(bytes.data(), bytes.size());
+    }
+  }
+
+  void load(BinaryInputArchive& ar)
+  {
+    size_type size;
+    ar(make_size_tag(size));
+
+    const size_t kept = std::min<size_t>(size, EnsembleLoadLimit::Get());
+    members.clear();
+    members.resize(kept);
+    std::string bytes;
+    for (size_t i = 0; i < size; ++i)
+    {
+      uint64_t memberSize;
+      ar(memberSize);
+
+      // The skipped members are still read, but in pieces and without being
+      // deserialized.
+      if (i >= kept)
+      {
+        bytes.resize(std::min<uint64_t>(memberSize, 1 << 20));
+        for (uint64_t read = 0; read < memberSize; read += bytes.size())
+        {
+          ar.loadBinary(&bytes[0],
+              std::min<uint64_t>(bytes.size(), memberSize - read));
+        }
+        continue;
+      }
+
+      bytes.resize(memberSize);
+      ar.loadBinary(&bytes[0], memberSize);
+      std::istringstream stream(bytes, std::ios::in | std::ios::binary);
+      BinaryInputArchive memberAr(stream);
+      memberAr(members[i]);
+    }
+  }
+
+ private:
+  //! The members of the ensemble.
+  std::vector<T>& members;
+};
+
+/**
+ * Serialize the members of an ensemble, so that only the first members can be
+ * loaded; see EnsembleWrapper and EnsembleLoadLimit.
+ *
+ * @param t std::vector that holds the members of the ensemble.
+ */
+template<typename T>
+inline EnsembleWrapper<T> make_ensemble(std::vector<T>& t)
+{
+  return EnsembleWrapper<T>(t);
+}
+
+#define CEREAL_ENSEMBLE(T) cereal::make_ensemble(T)
+
+} // namespace cereal
+
+#endif
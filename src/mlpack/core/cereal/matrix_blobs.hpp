@@ -0,0 +1,282 @@
+/**
+ * @file core/cereal/matrix_blobs.hpp
+ *
+ * Binary archives that store the memory of large matrices as aligned blocks
+ * ("blobs") outside of the archive, so that it can be read in one piece or
+ * memory-mapped when loading.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CEREAL_MATRIX_BLOBS_HPP
+#define MLPACK_CORE_CEREAL_MATRIX_BLOBS_HPP
+
+#include <cereal/archives/adapters.hpp>
+#include <cereal/archives/binary.hpp>
+#include <mlpack/core/cereal/is_loading.hpp>
+
+#include <armadillo>
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace cereal {
+
+/**
+ * The user data of a BlobOutputArchive: it collects the memory of the matrices
+ * of at least MinBytes() bytes, which are written after the archive by
+ * Write(), each at an offset that is a multiple of Alignment().  Only the
+ * offset of such a matrix is written in the archive.  The matrices must not be
+ * modified or destroyed until Write() has been called.
+ */
+class MatrixBlobWriter
+{
+ public:
+  /**
+   * Create the writer.
+   *
+   * @param minBytes Size (in bytes) from which a matrix is stored as a blob.
+   * @param alignment Alignment (in bytes) of the blobs.
+   */
+  MatrixBlobWriter(const size_t minBytes, const size_t alignment = 64) :
+      minBytes(minBytes),
+      alignment(alignment),
+      size(0)
+  { }
+
+  //! Add a blob and return its offset.
+  uint64_t Add(const void* data, const size_t bytes)
+  {
+    const uint64_t offset = size;
+    blobs.push_back(Blob{ data, bytes });
+    size += bytes;
+    size = ((size + alignment - 1) / alignment) * alignment;
+    return offset;
+  }
+
+  //! Write all blobs, with their padding, to the given stream.
+  void Write(std::ostream& stream) const
+  {
+    const std::vector<char> padding(alignment, 0);
+    uint64_t written = 0;
+    for (const Blob& blob : blobs)
+    {
+      stream.write(static_cast<const char*>(blob.data), blob.bytes);
+      written += blob.bytes;
+      const size_t pad = (alignment - written % alignment) % alignment;
+      stream.write(padding.data(), pad);
+      written += pad;
+    }
+  }
+
+  //! Get the size from which a matrix is stored as a blob.
+  size_t MinBytes() const { return minBytes; }
+  //! Get the alignment of the blobs.
+  size_t Alignment() const { return alignment; }
+  //! Get the total size of the blobs, with their padding.
+  uint64_t Size() const { return size; }
+
+ private:
+  //! A block of memory to write.
+  struct Blob
+  {
+    const void* data;
+    size_t bytes;
+  };
+
+  //! The size from which a matrix is stored as a blob.
+  size_t minBytes;
+  //! The alignment of the blobs.
+  size_t alignment;
+  //! The total size of the blobs, with their padding.
+  uint64_t size;
+  //! The blobs to write.
+  std::vector<Blob> blobs;
+};
+
+/**
+ * The user data of a BlobInputArchive: it gives the memory of the matrices
+ * saved as blobs by a MatrixBlobWriter with the same minimum size.  The blobs
+ * are either in memory (for instance a memory-mapped file), in which case the
+ * matrices can use that memory directly, or read from a stream.
+ */
+class MatrixBlobReader
+{
+ public:
+  /**
+   * Read the blobs from memory.  If alias is true, the loaded matrices use the
+   * memory directly, and the memory must outlive them; otherwise the blobs are
+   * copied.
+   *
+   * @param region The blobs.
+   * @param regionSize Size of the blobs (in bytes).
+   * @param minBytes Size from which a matrix was stored as a blob.
+   * @param alias Whether the matrices should use the memory directly.
+   */
+  MatrixBlobReader(char* region,
+                   const uint64_t regionSize,
+                   const size_t minBytes,
+                   const bool alias) :
+      region(region),
+      stream(NULL),
+      regionStart(0),
+      regionSize(regionSize),
+      minBytes(minBytes),
+      alias(alias)
+  { }
+
+  /**
+   * Read the blobs from a stream, starting at the given position.
+   *
+   * @param stream Stream to read the blobs from.
+   * @param regionStart Position of the blobs in the stream.
+   * @param regionSize Size of the blobs (in bytes).
+   * @param minBytes Size from which a matrix was stored as a blob.
+   */
+  MatrixBlobReader(std::istream& stream,
+                   const uint64_t regionStart,
+                   const uint64_t regionSize,
+                   const size_t minBytes) :
+      region(NULL),
+      stream(&stream),
+      regionStart(regionStart),
+      regionSize(regionSize),
+      minBytes(minBytes),
+      alias(false)
+  { }
+
+  /**
+   * Load the matrix of the given size from the blob at the given offset.
+   */
+  template<typename eT>
+  void Read(arma::Mat<eT>& mat,
+            const uint64_t offset,
+            const arma::uword nRows,
+            const arma::uword nCols)
+  {
+    const uint64_t bytes = uint64_t(nRows) * nCols * sizeof(eT);
+    if (offset > regionSize || bytes > regionSize - offset ||
+        offset % sizeof(eT) != 0)
+      throw Exception("matrix blob is outside of the blob region");
+
+    if (region != NULL && alias)
+    {
+      // Use the memory directly.  The matrix is not strict, so that it can
+      // give the memory to the model with steal_mem().
+      arma::Mat<eT> blob(reinterpret_cast<eT*>(region + offset), nRows, nCols,
+          false, false);
+      mat.steal_mem(blob);
+      return;
+    }
+
+    mat.set_size(nRows, nCols);
+    if (region != NULL)
+    {
+      std::memcpy(mat.memptr(), region + offset, bytes);
+    }
+    else
+    {
+      stream->seekg(regionStart + offset);
+      stream->read(reinterpret_cast<char*>(mat.memptr()), bytes);
+      if (!(*stream))
+        throw Exception("could not read matrix blob");
+    }
+  }
+
+  //! Get the size from which a matrix was stored as a blob.
+  size_t MinBytes() const { return minBytes; }
+
+ private:
+  //! The blobs, if they are in memory.
+  char* region;
+  //! The stream to read the blobs from, if they are not in memory.
+  std::istream* stream;
+  //! The position of the blobs in the stream.
+  uint64_t regionStart;
+  //! The size of the blobs.
+  uint64_t regionSize;
+  //! The size from which a matrix was stored as a blob.
+  size_t minBytes;
+  //! Whether the matrices use the memory of the blobs directly.
+  bool alias;
+};
+
+//! A binary output archive that stores large matrices as blobs.
+typedef UserDataAdapter<MatrixBlobWriter, BinaryOutputArchive>
+    BlobOutputArchive;
+//! A binary input archive that loads large matrices from blobs.
+typedef UserDataAdapter<MatrixBlobReader, BinaryInputArchive>
+    BlobInputArchive;
+
+/**
+ * Serialize the elements of a matrix one by one, for text archives.
+ */
+template<typename Archive, typename eT>
+void SerializeMatrixMemory(Archive& ar,
+                           arma::Mat<eT>& mat,
+                           const arma::uword nRows,
+                           const arma::uword nCols)
+{
+  if (cereal::is_loading<Archive>())
+    mat.set_size(nRows, nCols);
+
+  for (size_t i = 0; i < mat.n_elem; ++i)
+    ar(cereal::make_nvp("elem", arma::access::rw(mat.mem[i])));
+}
+
+/**
+ * Save the memory of a matrix in one block, or as a blob if the archive is a
+ * BlobOutputArchive and the matrix is large enough.  A block has the same
+ * layout as the elements saved one by one.
+ */
+template<typename eT>
+void SerializeMatrixMemory(BinaryOutputArchive& ar,
+                           arma::Mat<eT>& mat,
+                           const arma::uword /* nRows */,
+                           const arma::uword /* nCols */)
+{
+  const size_t bytes = mat.n_elem * sizeof(eT);
+  BlobOutputArchive* blobAr = dynamic_cast<BlobOutputArchive*>(&ar);
+  if (blobAr != NULL && bytes > 0 && bytes >= blobAr->userdata.MinBytes())
+  {
+    const uint64_t offset = blobAr->userdata.Add(mat.memptr(), bytes);
+    ar(offset);
+  }
+  else
+  {
+    ar(binary_data(mat.memptr(), bytes));
+  }
+}
+
+/**
+ * Load the memory of a matrix saved by the previous function.
+ */
+template<typename eT>
+void SerializeMatrixMemory(BinaryInputArchive& ar,
+                           arma::Mat<eT>& mat,
+                           const arma::uword nRows,
+                           const arma::uword nCols)
+{
+  const size_t bytes = size_t(nRows) * nCols * sizeof(eT);
+  BlobInputArchive* blobAr = dynamic_cast<BlobInputArchive*>(&ar);
+  if (blobAr != NULL && bytes > 0 && bytes >= blobAr->userdata.MinBytes())
+  {
+    uint64_t offset;
+    ar(offset);
+    blobAr->userdata.Read(mat, offset, nRows, nCols);
+  }
+  else
+  {
+    mat.set_size(nRows, nCols);
+    ar(binary_data(mat.memptr(), bytes));
+  }
+}
+
+} // namespace cereal
+
+#endif
@@ -0,0 +1,55 @@
+/**
+ * @file core/cereal/template_class_version.hpp
+ *
+ * A version of CEREAL_CLASS_VERSION() for class templates.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CEREAL_TEMPLATE_CLASS_VERSION_HPP
+#define MLPACK_CORE_CEREAL_TEMPLATE_CLASS_VERSION_HPP
+
+#include <cereal/cereal.hpp>
+#include <cereal/details/static_object.hpp>
+#include <cereal/details/helpers.hpp>
+
+#include <typeindex>
+
+//! Remove the parentheses around a macro argument.
+#define MLPACK_CEREAL_STRIP_PARENS(...) __VA_ARGS__
+
+/**
+ * Set the version of all specializations of a class template, as
+ * CEREAL_CLASS_VERSION() does for a class.  The template parameters and the
+ * type are given in parentheses, because they contain commas:
+ *
+ * @code
+ * CEREAL_TEMPLATE_CLASS_VERSION((template<typename A, typename B>),
+ *     (MyClass<A, B>), (1));
+ * @endcode
+ *
+ * This must be used at global scope.
+ */
+#define CEREAL_TEMPLATE_CLASS_VERSION(SIGNATURE, TYPE, VERSION_NUMBER) \
+    namespace cereal { namespace detail { \
+    MLPACK_CEREAL_STRIP_PARENS SIGNATURE \
+    struct Version<MLPACK_CEREAL_STRIP_PARENS TYPE> \
+    { \
+      static std::uint32_t registerVersion() \
+      { \
+        ::cereal::detail::StaticObject<Versions>::getInstance().mapping.emplace( \
+            std::type_index(typeid(MLPACK_CEREAL_STRIP_PARENS TYPE)) \
+            .hash_code(), MLPACK_CEREAL_STRIP_PARENS VERSION_NUMBER); \
+        return MLPACK_CEREAL_STRIP_PARENS VERSION_NUMBER; \
+      } \
+      static void unused() { (void) version; } \
+      static const std::uint32_t version; \
+    }; \
+    MLPACK_CEREAL_STRIP_PARENS SIGNATURE \
+    const std::uint32_t Version<MLPACK_CEREAL_STRIP_PARENS TYPE>::version = \
+        Version<MLPACK_CEREAL_STRIP_PARENS TYPE>::registerVersion(); \
+    } }
+
+#endif
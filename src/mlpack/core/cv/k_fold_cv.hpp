@@ -15,6 +15,8 @@
 #include <mlpack/core/cv/meta_info_extractor.hpp>
 #include <mlpack/core/cv/cv_base.hpp>
 
+#include <exception>
+
 namespace mlpack {
 namespace cv {
 
@@ -44,6 +46,13 @@ namespace cv {
  * the @c Shuffle() function.  Shuffling is performed at construction time if
  * the parameter @c shuffle is set to @c true in the constructor.
  *
+ * The training and validation subsets of each fold are views of a single copy
+ * of the data, so no data is copied when the folds are trained.  If
+ * @c Parallel() is set to @c true, the folds are trained and evaluated in
+ * parallel, each with its own MLAlgorithm instance; this requires that training
+ * MLAlgorithm is thread-safe, and results of randomized algorithms may then
+ * depend on the scheduling of the folds.
+ *
  * @tparam MLAlgorithm A machine learning algorithm.
  * @tparam Metric A metric to assess the quality of a trained model.
  * @tparam MatType The type of data.
@@ -177,9 +186,40 @@ class KFoldCV
   template<typename... MLAlgorithmArgs>
   double Evaluate(const MLAlgorithmArgs& ...args);
 
+  /**
+   * Run k-fold cross-validation like Evaluate(), but store the model of the
+   * last fold in the given pointer instead of in this object.  This does not
+   * modify the object, so it may be called from several threads at once.
+   *
+   * @param model Pointer to store the model of the last fold in.
+   * @param args Arguments for MLAlgorithm (in addition to the passed
+   *     ones in the constructor).
+   */
+  template<typename... MLAlgorithmArgs>
+  double EvaluateInto(std::unique_ptr<MLAlgorithm>& model,
+                      const MLAlgorithmArgs& ...args);
+
   //! Access and modify a model from the last run of k-fold cross-validation.
   MLAlgorithm& Model();
 
+  //! Get the fraction of each training subset that is used for training.
+  double TrainingFraction() const { return trainingFraction; }
+
+  /**
+   * Set the fraction of each training subset that is used for training; the
+   * first points of each training subset are used, without copying.  The
+   * validation subsets are not affected.  This is useful to assess models
+   * cheaply on a smaller budget (see hpt::SuccessiveHalving).
+   *
+   * @param fraction Fraction of each training subset to use, in (0, 1].
+   */
+  void TrainingFraction(const double fraction);
+
+  //! Get whether the folds are trained in parallel.
+  bool Parallel() const { return parallel; }
+  //! Modify whether the folds are trained in parallel.
+  bool& Parallel() { return parallel; }
+
  private:
   //! A short alias for CVBase.
   using Base = CVBase<MLAlgorithm, MatType, PredictionsType, WeightsType>;
@@ -225,6 +265,12 @@ class KFoldCV
   //! A pointer to a model from the last run of k-fold cross-validation.
   std::unique_ptr<MLAlgorithm> modelPtr;
 
+  //! Whether or not the folds are trained in parallel.
+  bool parallel;
+
+  //! The fraction of each training subset that is used for training.
+  double trainingFraction;
+
   /**
    * Assert the k parameter and data consistency and initialize fields required
    * for running k-fold cross-validation.
@@ -259,7 +305,8 @@ class KFoldCV
   template<typename... MLAlgorithmArgs,
            bool Enabled = !Base::MIE::SupportsWeights,
            typename = typename std::enable_if<Enabled>::type>
-  double TrainAndEvaluate(const MLAlgorithmArgs& ...mlAlgorithmArgs);
+  double TrainAndEvaluate(std::unique_ptr<MLAlgorithm>& model,
+                          const MLAlgorithmArgs& ...mlAlgorithmArgs);
 
   /**
    * Train and run evaluation in the case of supporting weighted learning.
@@ -268,7 +315,20 @@ class KFoldCV
            bool Enabled = Base::MIE::SupportsWeights,
            typename = typename std::enable_if<Enabled>::type,
            typename = void>
-  double TrainAndEvaluate(const MLAlgorithmArgs& ...mlAlgorithmArgs);
+  double TrainAndEvaluate(std::unique_ptr<MLAlgorithm>& model,
+                          const MLAlgorithmArgs& ...mlAlgorithmArgs);
+
+  /**
+   * Run the given function, which trains and evaluates the model of one fold,
+   * for every fold, either serially or in parallel.  Exceptions thrown in
+   * parallel folds are rethrown.
+   *
+   * @param evaluateFold Function taking the index of a fold and returning its
+   *     score.
+   * @param evaluations Vector to store the score of each fold in.
+   */
+  template<typename FoldFunction>
+  void EvaluateFolds(FoldFunction evaluateFold, arma::vec& evaluations);
 
   /**
    * Calculate the index of the first column of the ith validation subset.
@@ -135,7 +135,9 @@ KFoldCV<MLAlgorithm,
                               const PredictionsType& ys,
                               const bool shuffle) :
     base(std::move(base)),
-    k(k)
+    k(k),
+    parallel(false),
+    trainingFraction(1.0)
 {
   if (k < 2)
     throw std::invalid_argument("KFoldCV: k should not be less than 2");
@@ -166,7 +168,9 @@ KFoldCV<MLAlgorithm,
                               const WeightsType& weights,
                               const bool shuffle) :
     base(std::move(base)),
-    k(k)
+    k(k),
+    parallel(false),
+    trainingFraction(1.0)
 {
   Base::AssertWeightsConsistency(xs, weights);
 
@@ -191,7 +195,41 @@ double KFoldCV<MLAlgorithm,
                PredictionsType,
                WeightsType>::Evaluate(const MLAlgorithmArgs&... args)
 {
-  return TrainAndEvaluate(args...);
+  return TrainAndEvaluate(modelPtr, args...);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs>
+double KFoldCV<MLAlgorithm,
+               Metric,
+               MatType,
+               PredictionsType,
+               WeightsType>::EvaluateInto(std::unique_ptr<MLAlgorithm>& model,
+                                          const MLAlgorithmArgs&... args)
+{
+  return TrainAndEvaluate(model, args...);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+void KFoldCV<MLAlgorithm,
+             Metric,
+             MatType,
+             PredictionsType,
+             WeightsType>::TrainingFraction(const double fraction)
+{
+  if (fraction <= 0.0 || fraction > 1.0)
+    throw std::invalid_argument("KFoldCV::TrainingFraction(): the fraction "
+        "should be more than 0 and at most 1");
+
+  trainingFraction = fraction;
 }
 
 template<typename MLAlgorithm,
@@ -242,17 +280,25 @@ double KFoldCV<MLAlgorithm,
                 Metric,
                 MatType,
                 PredictionsType,
-                WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
+                WeightsType>::TrainAndEvaluate(
+    std::unique_ptr<MLAlgorithm>& model,
+    const MLAlgorithmArgs&... args)
 {
   arma::vec evaluations(k);
+  EvaluateFolds([&](const size_t i)
+  {
+    MLAlgorithm&& foldModel = base.Train(GetTrainingSubset(xs, i),
+        GetTrainingSubset(ys, i), args...);
+    const double evaluation = Metric::Evaluate(foldModel,
+        GetValidationSubset(xs, i), GetValidationSubset(ys, i));
+    if (i == k - 1)
+      model.reset(new MLAlgorithm(std::move(foldModel)));
+    return evaluation;
+  }, evaluations);
 
   size_t numInvalidScores = 0;
   for (size_t i = 0; i < k; ++i)
   {
-    MLAlgorithm&& model  = base.Train(GetTrainingSubset(xs, i),
-        GetTrainingSubset(ys, i), args...);
-    evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
-        GetValidationSubset(ys, i));
     if (std::isnan(evaluations(i)) || std::isinf(evaluations(i)))
     {
       ++numInvalidScores;
@@ -260,8 +306,6 @@ double KFoldCV<MLAlgorithm,
           << "a score of " << evaluations(i) << "; ignoring when computing "
           << "the average score." << std::endl;
     }
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
   }
 
   if (numInvalidScores == k)
@@ -284,26 +328,70 @@ double KFoldCV<MLAlgorithm,
                 Metric,
                 MatType,
                 PredictionsType,
-                WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
+                WeightsType>::TrainAndEvaluate(
+    std::unique_ptr<MLAlgorithm>& model,
+    const MLAlgorithmArgs&... args)
 {
   arma::vec evaluations(k);
-
-  for (size_t i = 0; i < k; ++i)
+  EvaluateFolds([&](const size_t i)
   {
-    MLAlgorithm&& model = (weights.n_elem > 0) ?
+    MLAlgorithm&& foldModel = (weights.n_elem > 0) ?
         base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
             GetTrainingSubset(weights, i), args...) :
         base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
             args...);
-    evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
-        GetValidationSubset(ys, i));
+    const double evaluation = Metric::Evaluate(foldModel,
+        GetValidationSubset(xs, i), GetValidationSubset(ys, i));
     if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
-  }
+      model.reset(new MLAlgorithm(std::move(foldModel)));
+    return evaluation;
+  }, evaluations);
 
   return arma::mean(evaluations);
 }
 
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename FoldFunction>
+void KFoldCV<MLAlgorithm,
+             Metric,
+             MatType,
+             PredictionsType,
+             WeightsType>::EvaluateFolds(FoldFunction evaluateFold,
+                                         arma::vec& evaluations)
+{
+  if (!parallel)
+  {
+    for (size_t i = 0; i < k; ++i)
+      evaluations(i) = evaluateFold(i);
+    return;
+  }
+
+  // Each fold constructs its own model, and the training and validation
+  // subsets are read-only views, so the folds can run concurrently.  An
+  // exception cannot leave the parallel region, so it is kept and rethrown.
+  std::exception_ptr exception;
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
+  {
+    try
+    {
+      evaluations(i) = evaluateFold((size_t) i);
+    }
+    catch (...)
+    {
+      #pragma omp critical
+      exception = std::current_exception();
+    }
+  }
+
+  if (exception)
+    std::rethrow_exception(exception);
+}
+
 template<typename MLAlgorithm,
          typename Metric,
          typename MatType,
@@ -388,8 +476,10 @@ arma::Mat<ElementType> KFoldCV<MLAlgorithm,
   // If this is not the first fold, we have to handle it a little bit
   // differently, since the last fold may contain slightly more than 'binSize'
   // points.
-  const size_t subsetSize = (i != 0) ? lastBinSize + (k - 2) * binSize :
+  const size_t fullSubsetSize = (i != 0) ? lastBinSize + (k - 2) * binSize :
       (k - 1) * binSize;
+  const size_t subsetSize = std::max((size_t) std::round(fullSubsetSize *
+      trainingFraction), (size_t) 1);
 
   return arma::Mat<ElementType>(m.colptr(binSize * i), m.n_rows, subsetSize,
       false, true);
@@ -412,8 +502,10 @@ arma::Row<ElementType> KFoldCV<MLAlgorithm,
   // If this is not the first fold, we have to handle it a little bit
   // differently, since the last fold may contain slightly more than 'binSize'
   // points.
-  const size_t subsetSize = (i != 0) ? lastBinSize + (k - 2) * binSize :
+  const size_t fullSubsetSize = (i != 0) ? lastBinSize + (k - 2) * binSize :
       (k - 1) * binSize;
+  const size_t subsetSize = std::max((size_t) std::round(fullSubsetSize *
+      trainingFraction), (size_t) 1);
 
   return arma::Row<ElementType>(r.colptr(binSize * i), subsetSize, false, true);
 }
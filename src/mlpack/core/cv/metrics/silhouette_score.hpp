@@ -66,7 +66,8 @@ class SilhouetteScore
 
   /**
    * Find silhouette score of all individual elements.
-   * (Distance not precomputed).
+   * (Distance not precomputed; the pairwise distance matrix is never formed,
+   * see the overload below.)
    *
    * @param X Column-major data used for clustering.
    * @param labels Labels assigned to data by clustering.
@@ -78,6 +79,51 @@ class SilhouetteScore
                                    const arma::Row<size_t>& labels,
                                    const Metric& metric);
 
+  /**
+   * Find silhouette score of the given elements only, against all the data.
+   * The distances are streamed in blocks, so the memory used is proportional
+   * to the number of clusters rather than to the square of the number of
+   * points, and the elements are scored in parallel if OpenMP is enabled.
+   *
+   * @param X Column-major data used for clustering.
+   * @param labels Labels assigned to data by clustering.
+   * @param metric Metric to be used to calculate dissimilarity.
+   * @param points Indices of the elements to score.
+   * @return (arma::rowvec) silhouette score of each of the given elements.
+   */
+  template<typename DataType, typename Metric>
+  static arma::rowvec SamplesScore(const DataType& X,
+                                   const arma::Row<size_t>& labels,
+                                   const Metric& metric,
+                                   const arma::uvec& points);
+
+  /**
+   * Estimate the overall silhouette score from the scores of numSamples
+   * elements drawn uniformly without replacement, and give a confidence
+   * interval for the overall score (from the normal approximation of the
+   * sample mean).  Each sampled element costs one pass over the data, so
+   * this takes O(numSamples * n) time instead of O(n^2).  If numSamples is
+   * at least the number of points, the exact score is returned and both
+   * bounds are equal to it.
+   *
+   * @param X Column-major data used for clustering.
+   * @param labels Labels assigned to data by clustering.
+   * @param metric Metric to be used to calculate dissimilarity.
+   * @param numSamples Number of elements to sample.
+   * @param lowerBound Set to the lower bound of the confidence interval.
+   * @param upperBound Set to the upper bound of the confidence interval.
+   * @param confidence Confidence level of the interval, in (0, 1).
+   * @return (double) estimated silhouette score.
+   */
+  template<typename DataType, typename Metric>
+  static double OverallEstimate(const DataType& X,
+                                const arma::Row<size_t>& labels,
+                                const Metric& metric,
+                                const size_t numSamples,
+                                double& lowerBound,
+                                double& upperBound,
+                                const double confidence = 0.95);
+
   /**
    * Find mean distance of element from a given cluster.
    *
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_CV_METRICS_SILHOUETTE_SCORE_IMPL_HPP
 
 #include <mlpack/core/cv/metrics/facilities.hpp>
+#include <boost/math/distributions/normal.hpp>
 
 namespace mlpack {
 namespace cv {
@@ -77,8 +78,151 @@ arma::rowvec SilhouetteScore::SamplesScore(const DataType& X,
                                            const Metric& metric)
 {
   util::CheckSameSizes(X, labels, "SilhouetteScore::SamplesScore()");
-  DataType distances = PairwiseDistances(X, metric);
-  return SamplesScore(distances, labels);
+  if (X.n_cols == 0)
+    return arma::rowvec();
+
+  return SamplesScore(X, labels, metric,
+      arma::regspace<arma::uvec>(0, X.n_cols - 1));
+}
+
+template<typename DataType, typename Metric>
+arma::rowvec SilhouetteScore::SamplesScore(const DataType& X,
+                                           const arma::Row<size_t>& labels,
+                                           const Metric& metric,
+                                           const arma::uvec& points)
+{
+  util::CheckSameSizes(X, labels, "SilhouetteScore::SamplesScore()");
+
+  // Map the labels to contiguous cluster indices.
+  const arma::Row<size_t> uniqueLabels = arma::unique(labels);
+  const size_t numClusters = uniqueLabels.n_elem;
+  std::vector<size_t> clusters(labels.n_elem);
+  arma::uvec clusterSizes(numClusters, arma::fill::zeros);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+  {
+    clusters[i] = std::lower_bound(uniqueLabels.begin(), uniqueLabels.end(),
+        labels[i]) - uniqueLabels.begin();
+    ++clusterSizes[clusters[i]];
+  }
+
+  // The elements are scored in blocks of queryBlockSize; for each block the
+  // sums of the distances to each cluster are accumulated over blocks of
+  // referenceBlockSize points, so that the reference points are reused while
+  // they are in cache.
+  const size_t queryBlockSize = 64;
+  const size_t referenceBlockSize = 1024;
+  const size_t numBlocks = (points.n_elem + queryBlockSize - 1) /
+      queryBlockSize;
+
+  arma::rowvec sampleScores(points.n_elem);
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+  {
+    const size_t begin = block * queryBlockSize;
+    const size_t end = std::min((size_t) points.n_elem,
+        begin + queryBlockSize);
+
+    arma::mat sums(numClusters, end - begin, arma::fill::zeros);
+    for (size_t r = 0; r < X.n_cols; r += referenceBlockSize)
+    {
+      const size_t rEnd = std::min((size_t) X.n_cols, r + referenceBlockSize);
+      for (size_t q = begin; q < end; ++q)
+      {
+        for (size_t j = r; j < rEnd; ++j)
+        {
+          sums(clusters[j], q - begin) += metric.Evaluate(X.col(points[q]),
+              X.col(j));
+        }
+      }
+    }
+
+    for (size_t q = begin; q < end; ++q)
+    {
+      const size_t cluster = clusters[points[q]];
+      if (clusterSizes[cluster] == 1)
+      {
+        // The element is the only element in its cluster.
+        sampleScores[q] = 0.0;
+        continue;
+      }
+
+      const double intraClusterDistance = sums(cluster, q - begin) /
+          (clusterSizes[cluster] - 1);
+      if (intraClusterDistance == 0)
+      {
+        sampleScores[q] = 0.0;
+        continue;
+      }
+
+      double minInterClusterDistance = DBL_MAX;
+      for (size_t c = 0; c < numClusters; ++c)
+      {
+        if (c != cluster)
+        {
+          minInterClusterDistance = std::min(minInterClusterDistance,
+              sums(c, q - begin) / clusterSizes[c]);
+        }
+      }
+
+      sampleScores[q] = (minInterClusterDistance - intraClusterDistance) /
+          std::max(intraClusterDistance, minInterClusterDistance);
+    }
+  }
+
+  return sampleScores;
+}
+
+template<typename DataType, typename Metric>
+double SilhouetteScore::OverallEstimate(const DataType& X,
+                                        const arma::Row<size_t>& labels,
+                                        const Metric& metric,
+                                        const size_t numSamples,
+                                        double& lowerBound,
+                                        double& upperBound,
+                                        const double confidence)
+{
+  util::CheckSameSizes(X, labels, "SilhouetteScore::OverallEstimate()");
+  if (numSamples == 0)
+  {
+    throw std::invalid_argument("SilhouetteScore::OverallEstimate(): "
+        "numSamples must be positive!");
+  }
+  if (confidence <= 0.0 || confidence >= 1.0)
+  {
+    std::ostringstream oss;
+    oss << "SilhouetteScore::OverallEstimate(): confidence must be in (0, 1), "
+        << "but " << confidence << " was given!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const size_t n = X.n_cols;
+  if (numSamples >= n)
+  {
+    lowerBound = upperBound = arma::mean(SamplesScore(X, labels, metric));
+    return lowerBound;
+  }
+
+  // Draw the elements without replacement, with a partial Fisher-Yates
+  // shuffle.
+  arma::uvec indices = arma::regspace<arma::uvec>(0, n - 1);
+  for (size_t i = 0; i < numSamples; ++i)
+    std::swap(indices[i], indices[math::RandInt(i, n)]);
+
+  const arma::rowvec scores = SamplesScore(X, labels, metric,
+      indices.head(numSamples));
+  const double estimate = arma::mean(scores);
+
+  // Standard error of the mean of a sample without replacement, with the
+  // finite population correction.
+  const double variance = (numSamples > 1) ? arma::var(scores) : 1.0;
+  const double standardError = std::sqrt(variance / numSamples *
+      (double) (n - numSamples) / (n - 1));
+  const double z = boost::math::quantile(boost::math::normal(),
+      1.0 - (1.0 - confidence) / 2.0);
+
+  lowerBound = std::max(-1.0, estimate - z * standardError);
+  upperBound = std::min(1.0, estimate + z * standardError);
+  return estimate;
 }
 
 double SilhouetteScore::MeanDistanceFromCluster(const arma::colvec& distances,
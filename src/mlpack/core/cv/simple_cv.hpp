@@ -208,9 +208,36 @@ class SimpleCV
   template<typename... MLAlgorithmArgs>
   double Evaluate(const MLAlgorithmArgs&... args);
 
+  /**
+   * Train on the training set and assess performance on the validation set,
+   * like Evaluate(), but store the trained model in the given pointer instead
+   * of in this object.  This does not modify the object, so it may be called
+   * from several threads at once.
+   *
+   * @param model Pointer to store the trained model in.
+   * @param args Arguments for the given MLAlgorithm taken by its constructor
+   *     (in addition to the passed ones in the SimpleCV constructor).
+   */
+  template<typename... MLAlgorithmArgs>
+  double EvaluateInto(std::unique_ptr<MLAlgorithm>& model,
+                      const MLAlgorithmArgs&... args);
+
   //! Access and modify the last trained model.
   MLAlgorithm& Model();
 
+  //! Get the fraction of the training set that is used for training.
+  double TrainingFraction() const { return trainingFraction; }
+
+  /**
+   * Set the fraction of the training set that is used for training; the first
+   * points of the training set are used, without copying.  The validation set
+   * is not affected.  This is useful to assess models cheaply on a smaller
+   * budget (see hpt::SuccessiveHalving).
+   *
+   * @param fraction Fraction of the training set to use, in (0, 1].
+   */
+  void TrainingFraction(const double fraction);
+
  private:
   //! A short alias for CVBase.
   using Base = CVBase<MLAlgorithm, MatType, PredictionsType, WeightsType>;
@@ -240,6 +267,9 @@ class SimpleCV
   //! The pointer to the last trained model.
   std::unique_ptr<MLAlgorithm> modelPtr;
 
+  //! The fraction of the training set that is used for training.
+  double trainingFraction;
+
   /**
    * Assert data consistency and initialize fields required for running
    * cross-validation.
@@ -291,7 +321,8 @@ class SimpleCV
   template<typename... MLAlgorithmArgs,
            bool Enabled = !Base::MIE::SupportsWeights,
            typename = typename std::enable_if<Enabled>::type>
-  double TrainAndEvaluate(const MLAlgorithmArgs&... args);
+  double TrainAndEvaluate(std::unique_ptr<MLAlgorithm>& model,
+                          const MLAlgorithmArgs&... args);
 
   /**
    * Train and run evaluation in the case of supporting weighted learning.
@@ -300,7 +331,8 @@ class SimpleCV
            bool Enabled = Base::MIE::SupportsWeights,
            typename = typename std::enable_if<Enabled>::type,
            typename = void>
-  double TrainAndEvaluate(const MLAlgorithmArgs&... args);
+  double TrainAndEvaluate(std::unique_ptr<MLAlgorithm>& model,
+                          const MLAlgorithmArgs&... args);
 };
 
 } // namespace cv
@@ -143,7 +143,8 @@ SimpleCV<MLAlgorithm,
                                 PIT&& ys) :
     base(std::move(base)),
     xs(std::forward<MIT>(xs)),
-    ys(std::forward<PIT>(ys))
+    ys(std::forward<PIT>(ys)),
+    trainingFraction(1.0)
 {
   Base::AssertDataConsistency(this->xs, this->ys);
 
@@ -194,7 +195,41 @@ double SimpleCV<MLAlgorithm,
                 PredictionsType,
                 WeightsType>::Evaluate(const MLAlgorithmArgs&... args)
 {
-  return TrainAndEvaluate(args...);
+  return TrainAndEvaluate(modelPtr, args...);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+template<typename... MLAlgorithmArgs>
+double SimpleCV<MLAlgorithm,
+                Metric,
+                MatType,
+                PredictionsType,
+                WeightsType>::EvaluateInto(std::unique_ptr<MLAlgorithm>& model,
+                                           const MLAlgorithmArgs&... args)
+{
+  return TrainAndEvaluate(model, args...);
+}
+
+template<typename MLAlgorithm,
+         typename Metric,
+         typename MatType,
+         typename PredictionsType,
+         typename WeightsType>
+void SimpleCV<MLAlgorithm,
+              Metric,
+              MatType,
+              PredictionsType,
+              WeightsType>::TrainingFraction(const double fraction)
+{
+  if (fraction <= 0.0 || fraction > 1.0)
+    throw std::invalid_argument("SimpleCV::TrainingFraction(): the fraction "
+        "should be more than 0 and at most 1");
+
+  trainingFraction = fraction;
 }
 
 template<typename MLAlgorithm,
@@ -291,11 +326,16 @@ double SimpleCV<MLAlgorithm,
                 Metric,
                 MatType,
                 PredictionsType,
-                WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
+                WeightsType>::TrainAndEvaluate(
+    std::unique_ptr<MLAlgorithm>& model,
+    const MLAlgorithmArgs&... args)
 {
-  modelPtr.reset(new MLAlgorithm(base.Train(trainingXs, trainingYs, args...)));
+  const size_t lastCol = std::max((size_t) std::round(trainingXs.n_cols *
+      trainingFraction), (size_t) 1) - 1;
+  model.reset(new MLAlgorithm(base.Train(GetSubset(trainingXs, 0, lastCol),
+      GetSubset(trainingYs, 0, lastCol), args...)));
 
-  return Metric::Evaluate(*modelPtr, validationXs, validationYs);
+  return Metric::Evaluate(*model, validationXs, validationYs);
 }
 
 template<typename MLAlgorithm,
@@ -308,16 +348,21 @@ double SimpleCV<MLAlgorithm,
                 Metric,
                 MatType,
                 PredictionsType,
-                WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
+                WeightsType>::TrainAndEvaluate(
+    std::unique_ptr<MLAlgorithm>& model,
+    const MLAlgorithmArgs&... args)
 {
+  const size_t lastCol = std::max((size_t) std::round(trainingXs.n_cols *
+      trainingFraction), (size_t) 1) - 1;
   if (trainingWeights.n_elem > 0)
-    modelPtr.reset(new MLAlgorithm(
-        base.Train(trainingXs, trainingYs, trainingWeights, args...)));
+    model.reset(new MLAlgorithm(base.Train(GetSubset(trainingXs, 0, lastCol),
+        GetSubset(trainingYs, 0, lastCol), GetSubset(trainingWeights, 0,
+        lastCol), args...)));
   else
-    modelPtr.reset(new MLAlgorithm(
-        base.Train(trainingXs, trainingYs, args...)));
+    model.reset(new MLAlgorithm(base.Train(GetSubset(trainingXs, 0, lastCol),
+        GetSubset(trainingYs, 0, lastCol), args...)));
 
-  return Metric::Evaluate(*modelPtr, validationXs, validationYs);
+  return Metric::Evaluate(*model, validationXs, validationYs);
 }
 
 } // namespace cv
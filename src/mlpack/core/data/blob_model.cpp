@@ -0,0 +1,122 @@
+/**
+ * @file core/data/blob_model.cpp
+ *
+ * Implementation of the ModelMapping class and of the checks of the blob
+ * format.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "blob_model.hpp"
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+using namespace mlpack;
+using namespace mlpack::data;
+
+ModelMapping::ModelMapping() : mapping(NULL), mappingLength(0)
+{
+  // Nothing to do.
+}
+
+ModelMapping::~ModelMapping()
+{
+  Unmap();
+}
+
+void ModelMapping::Map(const std::string& filename)
+{
+  Unmap();
+
+#ifdef _WIN32
+  throw std::runtime_error("ModelMapping: memory mapping is not supported on "
+      "Windows.");
+#else
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1)
+  {
+    std::ostringstream oss;
+    oss << "ModelMapping: cannot open file '" << filename << "'.";
+    throw std::runtime_error(oss.str());
+  }
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) == -1)
+  {
+    close(fd);
+    std::ostringstream oss;
+    oss << "ModelMapping: cannot get size of file '" << filename << "'.";
+    throw std::runtime_error(oss.str());
+  }
+
+  // A private mapping can be written to even though the file is opened
+  // read-only; the written pages are copied and never reach the file.
+  void* newMapping = NULL;
+  if (fileStat.st_size > 0)
+  {
+    newMapping = mmap(NULL, fileStat.st_size, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+
+  if (newMapping == MAP_FAILED)
+  {
+    std::ostringstream oss;
+    oss << "ModelMapping: cannot memory-map file '" << filename << "'.";
+    throw std::runtime_error(oss.str());
+  }
+
+  mapping = newMapping;
+  mappingLength = fileStat.st_size;
+#endif
+}
+
+void ModelMapping::Unmap()
+{
+#ifndef _WIN32
+  if (mapping != NULL)
+    munmap(mapping, mappingLength);
+#endif
+
+  mapping = NULL;
+  mappingLength = 0;
+}
+
+bool ModelMapping::Supported()
+{
+#ifdef _WIN32
+  return false;
+#else
+  return true;
+#endif
+}
+
+void mlpack::data::CheckBlobModelHeader(const BlobModelHeader& header,
+                                        const uint64_t fileSize)
+{
+  if (std::memcmp(header.magic, "mlpkblob", sizeof(header.magic)) != 0)
+    throw cereal::Exception("file is not in the blob format");
+
+  if (header.version != 1)
+  {
+    std::ostringstream oss;
+    oss << "unsupported version " << header.version << " of the blob format";
+    throw cereal::Exception(oss.str());
+  }
+
+  if (header.archiveSize > fileSize - sizeof(header) ||
+      header.blobOffset < sizeof(header) + header.archiveSize ||
+      header.blobOffset > fileSize ||
+      header.blobSize > fileSize - header.blobOffset)
+  {
+    throw cereal::Exception("file in the blob format is truncated or "
+        "corrupted");
+  }
+}
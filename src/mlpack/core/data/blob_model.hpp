@@ -0,0 +1,175 @@
+/**
+ * @file core/data/blob_model.hpp
+ *
+ * Save and load models in the blob format, a binary format in which the large
+ * matrices of the model are stored as aligned blocks that can be
+ * memory-mapped when the model is loaded.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_BLOB_MODEL_HPP
+#define MLPACK_CORE_DATA_BLOB_MODEL_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/cereal/matrix_blobs.hpp>
+
+#include <cstdint>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The header of a file in the blob format (format::blob).  The file holds, in
+ * order:
+ *
+ *  - this header;
+ *  - a cereal binary archive of the model, in which each matrix of at least
+ *    minBytes bytes is replaced by the offset of its blob;
+ *  - padding up to blobOffset, which is a multiple of the page size;
+ *  - the blobs, each at an offset that is a multiple of 64 bytes.
+ *
+ * Numbers are stored in the byte order of the machine, as in cereal binary
+ * archives.
+ */
+struct BlobModelHeader
+{
+  //! Identifies the format; "mlpkblob".
+  char magic[8];
+  //! The version of the format.
+  uint64_t version;
+  //! The size (in bytes) from which a matrix is stored as a blob.
+  uint64_t minBytes;
+  //! The size of the archive, which follows the header.
+  uint64_t archiveSize;
+  //! The offset of the blobs in the file.
+  uint64_t blobOffset;
+  //! The size of the blobs.
+  uint64_t blobSize;
+};
+
+//! The default size (in bytes) from which a matrix is stored as a blob.
+constexpr size_t BlobModelMinBytes = 4096;
+
+/**
+ * A ModelMapping memory-maps a file in the blob format, so that the matrices
+ * of the model loaded from it with LoadMapped() use the mapped memory directly
+ * instead of a copy.  Loading is then about as fast as reading the (small)
+ * archive: the pages of the matrices are only read from disk when they are
+ * used, and are shared by all processes that map the same file.
+ *
+ * The file is mapped privately (copy-on-write), so the model may be modified
+ * or trained further; the changes are never written to the file.  The
+ * ModelMapping must outlive the model, and the model must not be loaded
+ * again while it is being used.
+ */
+class ModelMapping
+{
+ public:
+  //! Create an empty mapping.
+  ModelMapping();
+
+  //! Copying a mapping is not allowed.
+  ModelMapping(const ModelMapping& other) = delete;
+  //! Copying a mapping is not allowed.
+  ModelMapping& operator=(const ModelMapping& other) = delete;
+
+  //! Unmap the file.  The models loaded from it become invalid.
+  ~ModelMapping();
+
+  /**
+   * Map the given file, unmapping the previous one.  An exception is thrown if
+   * the file cannot be opened or mapped, or if memory mapping is not supported
+   * on this platform.
+   *
+   * @param filename Name of the file to map.
+   */
+  void Map(const std::string& filename);
+
+  //! Unmap the file.  The models loaded from it become invalid.
+  void Unmap();
+
+  //! Get the mapped memory (NULL if nothing is mapped).
+  char* Data() const { return static_cast<char*>(mapping); }
+  //! Get the size of the mapped memory.
+  size_t Size() const { return mappingLength; }
+
+  //! Return whether memory mapping is supported on this platform.
+  static bool Supported();
+
+ private:
+  //! The start of the mapped region.
+  void* mapping;
+  //! The length of the mapped region.
+  size_t mappingLength;
+};
+
+/**
+ * Save a model in the blob format to the given stream.  Matrices of at least
+ * minBytes bytes are stored as aligned blobs.  An exception is thrown on
+ * failure.
+ *
+ * @param stream Stream to save to; it should be opened in binary mode.
+ * @param name Name of the model.
+ * @param t Model to save.
+ * @param minBytes Size (in bytes) from which a matrix is stored as a blob.
+ */
+template<typename T>
+void SaveBlobModel(std::ostream& stream,
+                   const std::string& name,
+                   T& t,
+                   const size_t minBytes = BlobModelMinBytes);
+
+/**
+ * Load a model in the blob format from the given stream; each blob is read
+ * into its matrix in one piece.  An exception is thrown on failure.
+ *
+ * @param stream Stream to load from; it should be opened in binary mode and
+ *     support seeking.
+ * @param name Name of the model.
+ * @param t Model to load into.
+ */
+template<typename T>
+void LoadBlobModel(std::istream& stream, const std::string& name, T& t);
+
+/**
+ * Load a model saved in the blob format (format::blob) by memory-mapping the
+ * file, so that its large matrices use the mapped memory directly; see
+ * ModelMapping.  If memory mapping is not supported on this platform, the
+ * model is loaded normally.
+ *
+ * @code
+ * data::ModelMapping mapping;
+ * RandomForest<> rf;
+ * data::LoadMapped("forest.blob", "rf", rf, mapping, true);
+ * // Use rf while mapping exists.
+ * @endcode
+ *
+ * @param filename Name of the file to load.
+ * @param name Name of the model.
+ * @param t Model to load into.
+ * @param mapping Mapping of the file, which must outlive the model.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename T>
+bool LoadMapped(const std::string& filename,
+                const std::string& name,
+                T& t,
+                ModelMapping& mapping,
+                const bool fatal = false);
+
+// Implementation found in blob_model.cpp.  Check the header read from a file
+// of the given size and throw a cereal::Exception if it is not valid.
+void CheckBlobModelHeader(const BlobModelHeader& header,
+                          const uint64_t fileSize);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "blob_model_impl.hpp"
+
+#endif
@@ -0,0 +1,146 @@
+/**
+ * @file core/data/blob_model_impl.hpp
+ *
+ * Implementation of the functions that save and load models in the blob
+ * format.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_BLOB_MODEL_IMPL_HPP
+#define MLPACK_CORE_DATA_BLOB_MODEL_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "blob_model.hpp"
+
+#include <mlpack/core/util/log.hpp>
+
+#include <fstream>
+#include <sstream>
+
+namespace mlpack {
+namespace data {
+
+template<typename T>
+void SaveBlobModel(std::ostream& stream,
+                   const std::string& name,
+                   T& t,
+                   const size_t minBytes)
+{
+  // The archive is made first, because its size gives the offset of the blobs.
+  // The blobs themselves are written from the memory of the model.
+  cereal::MatrixBlobWriter writer(minBytes);
+  std::ostringstream archive(std::ios::out | std::ios::binary);
+  {
+    cereal::BlobOutputArchive ar(writer, archive);
+    ar(cereal::make_nvp(name.c_str(), t));
+  }
+  const std::string archiveData = archive.str();
+
+  const uint64_t pageSize = 4096;
+  BlobModelHeader header;
+  std::memcpy(header.magic, "mlpkblob", sizeof(header.magic));
+  header.version = 1;
+  header.minBytes = minBytes;
+  header.archiveSize = archiveData.size();
+  header.blobOffset = ((sizeof(header) + archiveData.size() + pageSize - 1) /
+      pageSize) * pageSize;
+  header.blobSize = writer.Size();
+
+  const std::vector<char> padding(header.blobOffset - sizeof(header) -
+      archiveData.size(), 0);
+  stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  stream.write(archiveData.data(), archiveData.size());
+  stream.write(padding.data(), padding.size());
+  writer.Write(stream);
+
+  if (!stream)
+    throw cereal::Exception("could not write model in blob format");
+}
+
+template<typename T>
+void LoadBlobModel(std::istream& stream, const std::string& name, T& t)
+{
+  const std::istream::pos_type start = stream.tellg();
+  stream.seekg(0, std::ios::end);
+  const uint64_t fileSize = stream.tellg() - start;
+  stream.seekg(start);
+
+  BlobModelHeader header;
+  stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!stream)
+    throw cereal::Exception("file is too small for the blob format");
+  CheckBlobModelHeader(header, fileSize);
+
+  std::string archiveData(header.archiveSize, '\0');
+  stream.read(&archiveData[0], archiveData.size());
+  std::istringstream archive(archiveData,
+      std::ios::in | std::ios::binary);
+
+  cereal::MatrixBlobReader reader(stream, uint64_t(start) + header.blobOffset,
+      header.blobSize, header.minBytes);
+  cereal::BlobInputArchive ar(reader, archive);
+  ar(cereal::make_nvp(name.c_str(), t));
+}
+
+template<typename T>
+bool LoadMapped(const std::string& filename,
+                const std::string& name,
+                T& t,
+                ModelMapping& mapping,
+                const bool fatal)
+{
+  try
+  {
+    if (!ModelMapping::Supported())
+    {
+      std::ifstream ifs(filename, std::ifstream::in | std::ifstream::binary);
+      if (!ifs.is_open())
+      {
+        std::ostringstream oss;
+        oss << "Unable to open file '" << filename << "' to load object '"
+            << name << "'.";
+        throw cereal::Exception(oss.str());
+      }
+
+      LoadBlobModel(ifs, name, t);
+      return true;
+    }
+
+    mapping.Map(filename);
+    if (mapping.Size() < sizeof(BlobModelHeader))
+      throw cereal::Exception("file is too small for the blob format");
+
+    BlobModelHeader header;
+    std::memcpy(&header, mapping.Data(), sizeof(header));
+    CheckBlobModelHeader(header, mapping.Size());
+
+    const std::string archiveData(mapping.Data() + sizeof(header),
+        header.archiveSize);
+    std::istringstream archive(archiveData,
+        std::ios::in | std::ios::binary);
+
+    cereal::MatrixBlobReader reader(mapping.Data() + header.blobOffset,
+        header.blobSize, header.minBytes, true);
+    cereal::BlobInputArchive ar(reader, archive);
+    ar(cereal::make_nvp(name.c_str(), t));
+
+    return true;
+  }
+  catch (std::exception& e)
+  {
+    if (fatal)
+      Log::Fatal << e.what() << std::endl;
+    else
+      Log::Warn << e.what() << std::endl;
+
+    return false;
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
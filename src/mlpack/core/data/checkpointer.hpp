@@ -0,0 +1,209 @@
+/**
+ * @file core/data/checkpointer.hpp
+ *
+ * Definition of the Checkpointer class, which saves snapshots of an object to
+ * a file in a background thread while training goes on.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_CHECKPOINTER_HPP
+#define MLPACK_CORE_DATA_CHECKPOINTER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/save.hpp>
+#include <atomic>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <thread>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A Checkpointer saves snapshots of an object (a model, or just its
+ * parameters) to a file with data::Save(), so that a long training run can be
+ * resumed after it is interrupted.  Save() only copies the object; the
+ * serialization and the disk writes are done in a background thread, so the
+ * training is never held up by them.  If the previous snapshot is still being
+ * written when Save() is called, the new one is skipped instead of waiting.
+ *
+ * Each snapshot is first written to a temporary file next to the checkpoint
+ * (with ".tmp" before the extension) and then renamed over it, so the
+ * checkpoint file always holds a complete snapshot, even if the program is
+ * killed during a write.
+ *
+ * @code
+ * data::Checkpointer<arma::mat> checkpointer("centroids.bin", "centroids");
+ * kmeans.IterationCallback() = [&](const size_t, const arma::mat& centroids)
+ * {
+ *   checkpointer.Save(centroids);
+ * };
+ * kmeans.Cluster(data, clusters, centroids);
+ * checkpointer.Wait();
+ * @endcode
+ *
+ * An exception thrown while writing a snapshot is rethrown by the next call to
+ * Save() or Wait().
+ *
+ * @tparam T Type of the object to save.
+ */
+template<typename T>
+class Checkpointer
+{
+ public:
+  /**
+   * Create the checkpointer.  Nothing is written until Save() is called.
+   *
+   * @param filename Name of the checkpoint file; its extension gives the
+   *     format, as for data::Save().
+   * @param name Name of the object in the file (to give to data::Load()).
+   */
+  Checkpointer(const std::string& filename, const std::string& name) :
+      filename(filename),
+      name(name),
+      writing(false),
+      saved(0),
+      skipped(0)
+  {
+    const size_t dot = filename.rfind('.');
+    const size_t slash = filename.find_last_of("/\\");
+    if (dot == std::string::npos ||
+        (slash != std::string::npos && dot < slash))
+    {
+      throw std::invalid_argument("Checkpointer::Checkpointer(): filename '" +
+          filename + "' has no extension to detect the format from!");
+    }
+
+    tmpFilename = filename.substr(0, dot) + ".tmp" + filename.substr(dot);
+  }
+
+  //! The writer thread refers to this object, so it cannot be copied or moved.
+  Checkpointer(const Checkpointer&) = delete;
+  //! The writer thread refers to this object, so it cannot be copied or moved.
+  Checkpointer& operator=(const Checkpointer&) = delete;
+
+  //! Wait for the snapshot being written, if any.
+  ~Checkpointer()
+  {
+    if (writer.joinable())
+      writer.join();
+  }
+
+  /**
+   * Take a snapshot of the given object and write it to the checkpoint file in
+   * the background, unless the previous snapshot is still being written.
+   *
+   * @param t Object to save.
+   * @return false if the snapshot was skipped.
+   */
+  bool Save(const T& t)
+  {
+    if (writing)
+    {
+      ++skipped;
+      return false;
+    }
+
+    return Save(std::make_shared<const T>(t));
+  }
+
+  /**
+   * Write the given snapshot to the checkpoint file in the background, unless
+   * the previous snapshot is still being written.  The snapshot is kept alive
+   * by the writer thread until it is written, and must not be modified.
+   *
+   * @param snapshot Snapshot to save.
+   * @return false if the snapshot was skipped.
+   */
+  bool Save(std::shared_ptr<const T> snapshot)
+  {
+    if (writing)
+    {
+      ++skipped;
+      return false;
+    }
+
+    Join();
+    writing = true;
+    writer = std::thread(&Checkpointer::Write, this, std::move(snapshot));
+    ++saved;
+    return true;
+  }
+
+  /**
+   * Wait until the snapshot being written, if any, is in the checkpoint file.
+   */
+  void Wait() { Join(); }
+
+  //! Get the name of the checkpoint file.
+  const std::string& Filename() const { return filename; }
+  //! Get the number of snapshots that were written (or are being written).
+  size_t Saved() const { return saved; }
+  //! Get the number of snapshots that were skipped.
+  size_t Skipped() const { return skipped; }
+
+ private:
+  //! Write a snapshot to the temporary file, then move it over the checkpoint.
+  void Write(std::shared_ptr<const T> snapshot)
+  {
+    try
+    {
+      // data::Save() takes a non-const reference, but does not modify the
+      // object.
+      data::Save(tmpFilename, name, const_cast<T&>(*snapshot), true);
+      if (std::rename(tmpFilename.c_str(), filename.c_str()) != 0)
+      {
+        throw std::runtime_error("Checkpointer::Save(): cannot rename '" +
+            tmpFilename + "' to '" + filename + "'!");
+      }
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+
+    writing = false;
+  }
+
+  //! Join the writer thread and rethrow its exception, if any.
+  void Join()
+  {
+    if (writer.joinable())
+      writer.join();
+
+    if (error)
+    {
+      std::exception_ptr e = error;
+      error = nullptr;
+      std::rethrow_exception(e);
+    }
+  }
+
+  //! The name of the checkpoint file.
+  std::string filename;
+  //! The name of the temporary file the snapshots are written to.
+  std::string tmpFilename;
+  //! The name of the object in the file.
+  std::string name;
+
+  //! Whether a snapshot is being written.
+  std::atomic<bool> writing;
+  //! The exception thrown while writing the last snapshot, if any.
+  std::exception_ptr error;
+  //! The thread that writes the snapshot.
+  std::thread writer;
+
+  //! The number of snapshots written.
+  size_t saved;
+  //! The number of snapshots skipped.
+  size_t skipped;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,96 @@
+/**
+ * @file core/data/columnar.hpp
+ *
+ * Load and save datasets in mlpack's binary columnar format, which stores each
+ * dimension (feature) contiguously with its type, and stores categorical
+ * dimensions as dictionary-encoded codes.  Datasets with mixed numeric and
+ * categorical dimensions can then be loaded without parsing or re-encoding any
+ * strings other than the dictionaries.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COLUMNAR_HPP
+#define MLPACK_CORE_DATA_COLUMNAR_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "dataset_mapper.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The type of each dimension stored in a columnar file.
+ */
+enum ColumnType : uint8_t
+{
+  //! Numeric values, stored as 64-bit floating point numbers.
+  COLUMN_FLOAT64 = 0,
+  //! Numeric values, stored as 32-bit floating point numbers.
+  COLUMN_FLOAT32 = 1,
+  //! Categorical values, stored as a dictionary of strings and one 32-bit code
+  //! for each point.
+  COLUMN_CATEGORICAL = 2
+};
+
+/**
+ * The compression codecs for the contents of a columnar file.  Only
+ * uncompressed files are currently supported; the codec is stored in the header
+ * so that other codecs can be added without changing the format.
+ */
+enum ColumnCodec : uint32_t
+{
+  CODEC_NONE = 0
+};
+
+/**
+ * Save a dataset with the given DatasetInfo in mlpack's binary columnar format
+ * (usually with the extension .mlcol).  Each point of the dataset is one column
+ * of the matrix.  Dimensions that are categorical in the DatasetInfo are
+ * dictionary-encoded; their values must be the mapped values (0 to
+ * NumMappings() - 1) that DatasetInfo gives.  Numeric dimensions are stored
+ * with the precision of eT (float or double).  The file uses the byte order of
+ * the machine it is written on.  An exception is thrown on failure.
+ *
+ * @param filename Name of file to save to.
+ * @param matrix Matrix to save (one point per column).
+ * @param info DatasetInfo holding the types and mappings of each dimension.
+ */
+template<typename eT, typename PolicyType>
+void SaveColumnar(const std::string& filename,
+                  const arma::Mat<eT>& matrix,
+                  const DatasetMapper<PolicyType>& info);
+
+/**
+ * Load a dataset in mlpack's binary columnar format, as written by
+ * SaveColumnar().  Each dimension is read in one block, and the dictionary of
+ * each categorical dimension is passed once through the DatasetInfo, so the
+ * codes of every point are translated with a lookup table.
+ *
+ * As with LoadARFF(), a pre-existing DatasetInfo object can be given (for
+ * instance, the one used to load the training set), in which case its
+ * mappings are reused; if its dimensionality does not match the file, a
+ * std::invalid_argument is thrown.  If info.Dimensionality() is 0, it is
+ * initialized from the file.
+ *
+ * @param filename Name of file to load.
+ * @param matrix Matrix to load data into.
+ * @param info DatasetInfo object; can be default-constructed or pre-existing.
+ * @param transpose If true (the default), each point is loaded as a column of
+ *     the matrix; otherwise, each dimension is a column.
+ */
+template<typename eT, typename PolicyType>
+void LoadColumnar(const std::string& filename,
+                  arma::Mat<eT>& matrix,
+                  DatasetMapper<PolicyType>& info,
+                  const bool transpose = true);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "columnar_impl.hpp"
+
+#endif
@@ -0,0 +1,299 @@
+/**
+ * @file core/data/columnar_impl.hpp
+ *
+ * Implementation of LoadColumnar() and SaveColumnar().
+ *
+ * A columnar file starts with the header
+ *
+ *   char[8]   magic "MLPKCOL\0"
+ *   uint32_t  format version (currently 1)
+ *   uint32_t  codec (see ColumnCodec)
+ *   uint64_t  number of points
+ *   uint64_t  number of dimensions
+ *
+ * followed by each dimension, in order, as a uint8_t ColumnType and then
+ *
+ *   - COLUMN_FLOAT64 / COLUMN_FLOAT32: one double / float for each point;
+ *   - COLUMN_CATEGORICAL: a uint64_t dictionary size, each dictionary entry as
+ *     a uint64_t length followed by its characters, then one uint32_t code (an
+ *     index into the dictionary) for each point.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COLUMNAR_IMPL_HPP
+#define MLPACK_CORE_DATA_COLUMNAR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "columnar.hpp"
+
+namespace mlpack {
+namespace data {
+namespace details {
+
+//! Magic bytes at the start of every columnar file.
+static const char columnarMagic[8] =
+    { 'M', 'L', 'P', 'K', 'C', 'O', 'L', '\0' };
+//! Current version of the columnar format.
+static const uint32_t columnarVersion = 1;
+
+//! Write a block of n objects of type T to the stream.
+template<typename T>
+inline void WriteColumnarBlock(std::ofstream& ofs,
+                               const T* data,
+                               const size_t n)
+{
+  ofs.write(reinterpret_cast<const char*>(data), n * sizeof(T));
+}
+
+//! Read a block of n objects of type T from the stream, throwing if the file
+//! ends first.
+template<typename T>
+inline void ReadColumnarBlock(std::ifstream& ifs,
+                              const std::string& filename,
+                              T* data,
+                              const size_t n)
+{
+  ifs.read(reinterpret_cast<char*>(data), n * sizeof(T));
+  if (!ifs)
+  {
+    throw std::runtime_error("data::LoadColumnar(): unexpected end of file in "
+        "'" + filename + "'");
+  }
+}
+
+} // namespace details
+
+template<typename eT, typename PolicyType>
+void SaveColumnar(const std::string& filename,
+                  const arma::Mat<eT>& matrix,
+                  const DatasetMapper<PolicyType>& info)
+{
+  if (info.Dimensionality() != matrix.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "data::SaveColumnar(): given DatasetInfo has dimensionality "
+        << info.Dimensionality() << ", but data has dimensionality "
+        << matrix.n_rows;
+    throw std::invalid_argument(oss.str());
+  }
+
+  std::ofstream ofs(filename, std::ios::out | std::ios::binary);
+  if (!ofs.is_open())
+  {
+    throw std::runtime_error("data::SaveColumnar(): cannot open file '" +
+        filename + "' for writing");
+  }
+
+  const uint32_t codec = CODEC_NONE;
+  const uint64_t numPoints = matrix.n_cols;
+  const uint64_t numDims = matrix.n_rows;
+  ofs.write(details::columnarMagic, sizeof(details::columnarMagic));
+  details::WriteColumnarBlock(ofs, &details::columnarVersion, 1);
+  details::WriteColumnarBlock(ofs, &codec, 1);
+  details::WriteColumnarBlock(ofs, &numPoints, 1);
+  details::WriteColumnarBlock(ofs, &numDims, 1);
+
+  // The matrix is column-major, so each dimension has to be gathered from a
+  // row into a contiguous buffer before writing it.
+  arma::Row<eT> values(matrix.n_cols);
+  std::vector<uint32_t> codes(matrix.n_cols);
+  for (size_t d = 0; d < matrix.n_rows; ++d)
+  {
+    values = matrix.row(d);
+    if (info.Type(d) == Datatype::categorical)
+    {
+      const uint8_t type = COLUMN_CATEGORICAL;
+      details::WriteColumnarBlock(ofs, &type, 1);
+
+      const uint64_t dictSize = info.NumMappings(d);
+      details::WriteColumnarBlock(ofs, &dictSize, 1);
+      for (size_t i = 0; i < dictSize; ++i)
+      {
+        const std::string& entry = info.UnmapString(i, d);
+        const uint64_t length = entry.size();
+        details::WriteColumnarBlock(ofs, &length, 1);
+        ofs.write(entry.data(), length);
+      }
+
+      for (size_t i = 0; i < values.n_elem; ++i)
+      {
+        // Categorical values must be the mapped values; anything else (for
+        // instance, NaN for a missing value) has no dictionary entry.
+        if (!(values[i] >= 0) || values[i] >= eT(dictSize) ||
+            values[i] != std::floor(values[i]))
+        {
+          std::ostringstream oss;
+          oss << "data::SaveColumnar(): value " << values[i] << " of point "
+              << i << " in categorical dimension " << d << " is not a mapped "
+              << "value";
+          throw std::invalid_argument(oss.str());
+        }
+        codes[i] = (uint32_t) values[i];
+      }
+      details::WriteColumnarBlock(ofs, codes.data(), codes.size());
+    }
+    else
+    {
+      const uint8_t type = std::is_same<eT, float>::value ? COLUMN_FLOAT32 :
+          COLUMN_FLOAT64;
+      details::WriteColumnarBlock(ofs, &type, 1);
+      if (std::is_same<eT, float>::value || std::is_same<eT, double>::value)
+      {
+        details::WriteColumnarBlock(ofs, values.memptr(), values.n_elem);
+      }
+      else
+      {
+        const arma::Row<double> converted =
+            arma::conv_to<arma::Row<double>>::from(values);
+        details::WriteColumnarBlock(ofs, converted.memptr(), converted.n_elem);
+      }
+    }
+  }
+
+  if (!ofs)
+  {
+    throw std::runtime_error("data::SaveColumnar(): error writing to file '" +
+        filename + "'");
+  }
+}
+
+template<typename eT, typename PolicyType>
+void LoadColumnar(const std::string& filename,
+                  arma::Mat<eT>& matrix,
+                  DatasetMapper<PolicyType>& info,
+                  const bool transpose)
+{
+  std::ifstream ifs(filename, std::ios::in | std::ios::binary);
+  if (!ifs.is_open())
+  {
+    throw std::runtime_error("data::LoadColumnar(): cannot open file '" +
+        filename + "'");
+  }
+
+  char magic[sizeof(details::columnarMagic)];
+  ifs.read(magic, sizeof(magic));
+  if (!ifs || !std::equal(magic, magic + sizeof(magic),
+      details::columnarMagic))
+  {
+    throw std::runtime_error("data::LoadColumnar(): '" + filename + "' is not "
+        "a columnar dataset");
+  }
+
+  uint32_t version, codec;
+  uint64_t numPoints, numDims;
+  details::ReadColumnarBlock(ifs, filename, &version, 1);
+  details::ReadColumnarBlock(ifs, filename, &codec, 1);
+  details::ReadColumnarBlock(ifs, filename, &numPoints, 1);
+  details::ReadColumnarBlock(ifs, filename, &numDims, 1);
+  if (version != details::columnarVersion)
+  {
+    std::ostringstream oss;
+    oss << "data::LoadColumnar(): unsupported format version " << version
+        << " in '" << filename << "'";
+    throw std::runtime_error(oss.str());
+  }
+  if (codec != CODEC_NONE)
+  {
+    std::ostringstream oss;
+    oss << "data::LoadColumnar(): unsupported compression codec " << codec
+        << " in '" << filename << "'";
+    throw std::runtime_error(oss.str());
+  }
+
+  // Take care of the DatasetInfo the same way LoadARFF() does.
+  if (info.Dimensionality() == 0)
+  {
+    info = DatasetMapper<PolicyType>(numDims);
+  }
+  else if (info.Dimensionality() != numDims)
+  {
+    std::ostringstream oss;
+    oss << "data::LoadColumnar(): given DatasetInfo has dimensionality "
+        << info.Dimensionality() << ", but data has dimensionality "
+        << numDims;
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (transpose)
+    matrix.set_size(numDims, numPoints);
+  else
+    matrix.set_size(numPoints, numDims);
+
+  // Each dimension is read into this buffer and then copied into a row of the
+  // matrix, or, when not transposing, read straight into a column.
+  arma::Col<eT> column(transpose ? numPoints : 0);
+  std::vector<double> doubles;
+  std::vector<float> floats;
+  std::vector<uint32_t> codes;
+  std::vector<eT> table;
+  std::string entry;
+  for (size_t d = 0; d < numDims; ++d)
+  {
+    eT* out = transpose ? column.memptr() : matrix.colptr(d);
+
+    uint8_t type;
+    details::ReadColumnarBlock(ifs, filename, &type, 1);
+    if (type == COLUMN_FLOAT64)
+    {
+      doubles.resize(numPoints);
+      details::ReadColumnarBlock(ifs, filename, doubles.data(), numPoints);
+      std::copy(doubles.begin(), doubles.end(), out);
+    }
+    else if (type == COLUMN_FLOAT32)
+    {
+      floats.resize(numPoints);
+      details::ReadColumnarBlock(ifs, filename, floats.data(), numPoints);
+      std::copy(floats.begin(), floats.end(), out);
+    }
+    else if (type == COLUMN_CATEGORICAL)
+    {
+      // Map each dictionary entry once; after that the codes only need a table
+      // lookup.
+      info.Type(d) = Datatype::categorical;
+      uint64_t dictSize;
+      details::ReadColumnarBlock(ifs, filename, &dictSize, 1);
+      table.resize(dictSize);
+      for (size_t i = 0; i < dictSize; ++i)
+      {
+        uint64_t length;
+        details::ReadColumnarBlock(ifs, filename, &length, 1);
+        entry.resize(length);
+        details::ReadColumnarBlock(ifs, filename, &entry[0], length);
+        table[i] = info.template MapString<eT>(entry, d);
+      }
+
+      codes.resize(numPoints);
+      details::ReadColumnarBlock(ifs, filename, codes.data(), numPoints);
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        if (codes[i] >= dictSize)
+        {
+          std::ostringstream oss;
+          oss << "data::LoadColumnar(): code " << codes[i] << " of point " << i
+              << " in dimension " << d << " is outside of the dictionary "
+              << "in '" << filename << "'";
+          throw std::runtime_error(oss.str());
+        }
+        out[i] = table[codes[i]];
+      }
+    }
+    else
+    {
+      std::ostringstream oss;
+      oss << "data::LoadColumnar(): unknown type " << (int) type << " for "
+          << "dimension " << d << " in '" << filename << "'";
+      throw std::runtime_error(oss.str());
+    }
+
+    if (transpose)
+      matrix.row(d) = column.t();
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,248 @@
+/**
+ * @file core/data/data_pipeline.hpp
+ *
+ * Definition of the DataPipeline class, which produces batches of data in a
+ * background thread while the previous batches are used.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_DATA_PIPELINE_HPP
+#define MLPACK_CORE_DATA_DATA_PIPELINE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A DataPipeline makes batches of predictors and responses with a given source
+ * function in a background thread, and keeps up to a given number of them
+ * ready in a queue.  The source function is called with the index of the batch
+ * to make (0, 1, 2, ...) and returns false when there are no more batches, so
+ * it can load, decode or augment the batch in any way; since it only depends
+ * on the index, the same pass over the data can be made again with Reset().
+ *
+ * This lets a model be trained on a dataset which does not fit in memory, while
+ * the cost of loading the next batches is hidden behind the training on the
+ * current one; see FFN::Train() and RNN::Train().
+ *
+ * @code
+ * data::DataPipeline<> pipeline([&](const size_t b, arma::mat& predictors,
+ *                                   arma::mat& responses)
+ * {
+ *   if (b == files.size())
+ *     return false;
+ *
+ *   data::Load(files[b], predictors);
+ *   data::Load(labelFiles[b], responses);
+ *   return true;
+ * });
+ *
+ * arma::mat predictors, responses;
+ * while (pipeline.Next(predictors, responses))
+ * {
+ *   // Use the batch.
+ * }
+ * @endcode
+ *
+ * The source function is called from the background thread only, so it does
+ * not need to be thread-safe, but it must not use anything that the caller
+ * modifies concurrently.  An exception thrown by the source function is
+ * rethrown by Next() once the batches made before it have been returned.
+ *
+ * @tparam PredictorsType Type of the predictors of a batch.
+ * @tparam ResponsesType Type of the responses of a batch.
+ */
+template<typename PredictorsType = arma::mat,
+         typename ResponsesType = arma::mat>
+class DataPipeline
+{
+ public:
+  //! The type of the function that makes the batches.
+  using SourceType = std::function<bool(const size_t,
+                                        PredictorsType&,
+                                        ResponsesType&)>;
+
+  /**
+   * Create the pipeline and start making the batches of the first pass.
+   *
+   * @param source Function that makes the batch with the given index, and
+   *     returns false if there is no such batch.
+   * @param capacity Number of batches to keep ready.
+   */
+  DataPipeline(SourceType source, const size_t capacity = 2) :
+      source(std::move(source)),
+      capacity(capacity),
+      finished(false),
+      stopping(false)
+  {
+    if (capacity == 0)
+    {
+      throw std::invalid_argument("DataPipeline::DataPipeline(): capacity must "
+          "be positive");
+    }
+
+    producer = std::thread(&DataPipeline::Produce, this);
+  }
+
+  //! The producer thread refers to this object, so it cannot be copied or
+  //! moved.
+  DataPipeline(const DataPipeline&) = delete;
+  //! The producer thread refers to this object, so it cannot be copied or
+  //! moved.
+  DataPipeline& operator=(const DataPipeline&) = delete;
+
+  //! Stop the producer thread.
+  ~DataPipeline() { Stop(); }
+
+  /**
+   * Get the next batch, waiting for it if it is not ready yet.
+   *
+   * @param predictors Matrix to store the predictors of the batch into.
+   * @param responses Matrix to store the responses of the batch into.
+   * @return false if all batches of the pass have been returned.
+   */
+  bool Next(PredictorsType& predictors, ResponsesType& responses)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    notEmpty.wait(lock, [this]() { return !queue.empty() || finished; });
+
+    if (!queue.empty())
+    {
+      predictors = std::move(queue.front().first);
+      responses = std::move(queue.front().second);
+      queue.pop_front();
+      notFull.notify_one();
+      return true;
+    }
+
+    if (error)
+    {
+      std::exception_ptr e = error;
+      error = nullptr;
+      std::rethrow_exception(e);
+    }
+
+    return false;
+  }
+
+  /**
+   * Drop the batches that are ready and start a new pass from the first batch.
+   */
+  void Reset()
+  {
+    Stop();
+    producer = std::thread(&DataPipeline::Produce, this);
+  }
+
+  //! Get the number of batches kept ready.
+  size_t Capacity() const { return capacity; }
+
+ private:
+  //! Make the batches of a pass, until there are no more or Stop() is called.
+  void Produce()
+  {
+    for (size_t b = 0; ; ++b)
+    {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (stopping)
+          return;
+      }
+
+      PredictorsType predictors;
+      ResponsesType responses;
+      bool more;
+      try
+      {
+        more = source(b, predictors, responses);
+      }
+      catch (...)
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        error = std::current_exception();
+        finished = true;
+        notEmpty.notify_all();
+        return;
+      }
+
+      std::unique_lock<std::mutex> lock(mutex);
+      if (!more)
+      {
+        finished = true;
+        notEmpty.notify_all();
+        return;
+      }
+
+      notFull.wait(lock, [this]() {
+          return stopping || queue.size() < capacity; });
+      if (stopping)
+        return;
+
+      queue.emplace_back(std::move(predictors), std::move(responses));
+      notEmpty.notify_one();
+    }
+  }
+
+  //! Stop the producer thread and clear the state of the pass.
+  void Stop()
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      stopping = true;
+      notFull.notify_all();
+    }
+
+    if (producer.joinable())
+      producer.join();
+
+    queue.clear();
+    finished = false;
+    stopping = false;
+    error = nullptr;
+  }
+
+  //! The function that makes the batches.
+  SourceType source;
+
+  //! The number of batches to keep ready.
+  size_t capacity;
+
+  //! The batches that are ready.
+  std::deque<std::pair<PredictorsType, ResponsesType>> queue;
+
+  //! Whether the producer made all batches of the pass (or failed).
+  bool finished;
+
+  //! Whether the producer should stop.
+  bool stopping;
+
+  //! The exception thrown by the source function, if any.
+  std::exception_ptr error;
+
+  //! Protects the queue and the flags.
+  std::mutex mutex;
+
+  //! Signaled when a batch is taken from the queue, or on Stop().
+  std::condition_variable notFull;
+
+  //! Signaled when a batch is added to the queue, or at the end of the pass.
+  std::condition_variable notEmpty;
+
+  //! The thread that makes the batches.
+  std::thread producer;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
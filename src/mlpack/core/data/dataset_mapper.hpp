@@ -63,6 +63,20 @@ class DatasetMapper
    */
   void SetDimensionality(const size_t dimensionality);
 
+  /**
+   * Replace the type and mappings of a dimension with those of a dimension of
+   * another DatasetMapper, which are moved out of it.  This is useful when the
+   * dimensions of a dataset are mapped separately (for instance, by different
+   * threads) and the results must be collected afterwards.
+   *
+   * @param dimension Dimension to replace.
+   * @param other DatasetMapper to take the dimension from.
+   * @param otherDimension Dimension of other to take.
+   */
+  void TakeDimension(const size_t dimension,
+                     DatasetMapper& other,
+                     const size_t otherDimension = 0);
+
   /**
    * Preprocessing: during a first pass of the data, pass the input on to the
    * MapPolicy if they are needed.
@@ -45,6 +45,23 @@ inline void DatasetMapper<PolicyType, InputType>::SetDimensionality(
   maps.clear();
 }
 
+template<typename PolicyType, typename InputType>
+inline void DatasetMapper<PolicyType, InputType>::TakeDimension(
+    const size_t dimension,
+    DatasetMapper& other,
+    const size_t otherDimension)
+{
+  Type(dimension) = other.Type(otherDimension);
+
+  maps.erase(dimension);
+  typename MapType::iterator it = other.maps.find(otherDimension);
+  if (it != other.maps.end())
+  {
+    maps[dimension] = std::move(it->second);
+    other.maps.erase(it);
+  }
+}
+
 // Utility helper function to call MapFirstPass.
 template<typename PolicyType, typename InputType, typename T>
 void CallMapFirstPass(
@@ -0,0 +1,111 @@
+/**
+ * @file core/data/hashing_dictionary.hpp
+ *
+ * Definition of the HashingDictionary class, which labels tokens by hashing
+ * them (the "hashing trick") instead of storing them.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_HASHING_DICTIONARY_HPP
+#define MLPACK_CORE_DATA_HASHING_DICTIONARY_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/boost_backport/boost_backport_string_view.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A dictionary for StringEncoding that does not store any tokens: the label of
+ * a token is its hash modulo the number of features (plus one, since labels
+ * start at one).  Every token is therefore already known, the dictionary never
+ * grows, and nothing has to be built before encoding, so it can be used to
+ * encode corpora whose vocabulary does not fit in memory, or strings that
+ * arrive in separate batches.  Distinct tokens may share a label; the number
+ * of features controls how often that happens.
+ *
+ * It can be used with any encoding policy; for instance, the following code
+ * computes hashed bag-of-words features.
+ *
+ * @code
+ * StringEncoding<BagOfWordsEncodingPolicy,
+ *     HashingDictionary<boost::string_view>> encoder;
+ * encoder.Dictionary().NumFeatures() = 1 << 18;
+ * arma::sp_mat output;
+ * encoder.Encode(input, output, SplitByAnyOf(" .,"));
+ * @endcode
+ *
+ * @tparam Token Type of the tokens.
+ */
+template<typename Token>
+class HashingDictionary
+{
+ public:
+  //! The type of the token that the dictionary labels.
+  using TokenType = Token;
+
+  /**
+   * Create the dictionary with the given number of features.
+   *
+   * @param numFeatures The number of distinct labels.
+   */
+  HashingDictionary(const size_t numFeatures = 1 << 20) :
+      numFeatures(numFeatures)
+  { }
+
+  /**
+   * Every token has a label, so this always returns true.
+   *
+   * @param * (token) The given token.
+   */
+  bool HasToken(const Token& /* token */) const { return true; }
+
+  /**
+   * Nothing has to be stored; return the label of the given token.
+   *
+   * @param token The given token.
+   */
+  size_t AddToken(const Token& token) const { return Value(token); }
+
+  /**
+   * Get the label of the given token.
+   *
+   * @param token The given token.
+   */
+  size_t Value(const Token& token) const
+  {
+    return boost::hash<Token>()(token) % numFeatures + 1;
+  }
+
+  //! Get the number of labels.
+  size_t Size() const { return numFeatures; }
+
+  //! Nothing to clear.
+  void Clear() { }
+
+  //! Get the number of features.
+  size_t NumFeatures() const { return numFeatures; }
+  //! Modify the number of features.
+  size_t& NumFeatures() { return numFeatures; }
+
+  /**
+   * Serialize the dictionary to the given archive.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(numFeatures));
+  }
+
+ private:
+  //! The number of distinct labels.
+  size_t numFeatures;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,174 @@
+/**
+ * @file core/data/image_batch_loader.hpp
+ *
+ * Definition of the ImageBatchLoader class, which loads a list of images in
+ * batches, and loads the next batch in the background.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_IMAGE_BATCH_LOADER_HPP
+#define MLPACK_CORE_DATA_IMAGE_BATCH_LOADER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <future>
+
+#include "load.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Load a list of images in batches of consecutive files, so that a dataset
+ * which does not fit in memory can be used batch by batch, and so that
+ * decoding overlaps with whatever is done with the previous batch.  While the
+ * caller uses a batch returned by Next(), the following batch is decoded in
+ * the background (itself in parallel, see data::Load()).
+ *
+ * For instance, a network can be trained for one pass over the images with
+ * the following code, where the labels of the images are in the same order as
+ * the files.
+ *
+ * @code
+ * data::ImageBatchLoader<> loader(files, info, 1024);
+ * arma::mat batch;
+ * while (loader.Next(batch))
+ * {
+ *   model.Train(batch, labels.cols(loader.BatchBegin(),
+ *       loader.BatchBegin() + batch.n_cols - 1), optimizer);
+ * }
+ * @endcode
+ *
+ * An image that cannot be loaded, or whose dimensions differ from the
+ * dimensions of the first one, makes Next() throw std::runtime_error.
+ *
+ * @tparam eT Element type of the batches.
+ */
+template<typename eT = double>
+class ImageBatchLoader
+{
+ public:
+  /**
+   * Create the loader and start loading the first batch.
+   *
+   * @param files Names of the image files.
+   * @param info Information about the images; the number of channels decides
+   *     whether images are loaded as grayscale.
+   * @param batchSize Number of images in each batch (the last batch may have
+   *     fewer).
+   */
+  ImageBatchLoader(const std::vector<std::string>& files,
+                   const ImageInfo& info,
+                   const size_t batchSize) :
+      files(files),
+      info(info),
+      batchSize(batchSize),
+      nextBegin(0),
+      batchBegin(0)
+  {
+    if (batchSize == 0)
+    {
+      throw std::invalid_argument("ImageBatchLoader::ImageBatchLoader(): "
+          "batchSize must be positive");
+    }
+
+    Prefetch();
+  }
+
+  //! The loading thread refers to this object, so it cannot be copied or
+  //! moved.
+  ImageBatchLoader(const ImageBatchLoader&) = delete;
+  //! The loading thread refers to this object, so it cannot be copied or
+  //! moved.
+  ImageBatchLoader& operator=(const ImageBatchLoader&) = delete;
+
+  /**
+   * Get the next batch.  The next batch after that starts loading in the
+   * background before this returns.
+   *
+   * @param batch Matrix to store the images of the batch into.
+   * @return false if all images have been returned already.
+   */
+  bool Next(arma::Mat<eT>& batch)
+  {
+    if (!pending.valid())
+      return false;
+
+    // Rethrows any error from the loading thread.
+    pending.get();
+    batch = std::move(nextBatch);
+    batchBegin = nextBegin;
+    nextBegin += batch.n_cols;
+
+    Prefetch();
+    return true;
+  }
+
+  /**
+   * Start again from the first image.
+   */
+  void Reset()
+  {
+    if (pending.valid())
+      pending.wait();
+
+    nextBegin = 0;
+    batchBegin = 0;
+    Prefetch();
+  }
+
+  //! Get the index of the first file of the last batch returned by Next().
+  size_t BatchBegin() const { return batchBegin; }
+
+  //! Get the information about the images (valid once a batch was returned).
+  const ImageInfo& Info() const { return info; }
+
+  //! Get the number of images in each batch.
+  size_t BatchSize() const { return batchSize; }
+
+ private:
+  //! Start loading the batch starting at nextBegin, if there are files left.
+  void Prefetch()
+  {
+    if (nextBegin >= files.size())
+      return;
+
+    const size_t begin = nextBegin;
+    const size_t end = std::min(nextBegin + batchSize, files.size());
+    pending = std::async(std::launch::async, [this, begin, end]()
+    {
+      const std::vector<std::string> batchFiles(files.begin() + begin,
+          files.begin() + end);
+      data::Load(batchFiles, nextBatch, info, true);
+    });
+  }
+
+  //! The names of the image files.
+  std::vector<std::string> files;
+
+  //! The information about the images.
+  ImageInfo info;
+
+  //! The number of images in each batch.
+  size_t batchSize;
+
+  //! The index of the first file of the batch being loaded.
+  size_t nextBegin;
+
+  //! The index of the first file of the last batch returned.
+  size_t batchBegin;
+
+  //! The batch being loaded.
+  arma::Mat<eT> nextBatch;
+
+  //! The task loading the next batch.  This is the last member, so that it is
+  //! destroyed first, which waits for the task to finish.
+  std::future<void> pending;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
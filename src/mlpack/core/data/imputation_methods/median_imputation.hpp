@@ -13,18 +13,36 @@
 #define MLPACK_CORE_DATA_IMPUTE_STRATEGIES_MEDIAN_IMPUTATION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
 
 namespace mlpack {
 namespace data {
 /**
  * This is a class implementation of simple median imputation.
  * replace missing value with middle or average of middle values
+ *
+ * The median is found by selection (std::nth_element), in linear time.  For
+ * very large or streamed inputs, a maximum number of samples can be given:
+ * the non-missing values are then reservoir-sampled and the median of the
+ * sample is used as an approximation of the median.
+ *
  * @tparam T Type of armadillo matrix
  */
 template <typename T>
 class MedianImputation
 {
  public:
+  /**
+   * Create the imputation strategy.
+   *
+   * @param maxSamples Maximum number of non-missing values to keep for the
+   *     median of each dimension; 0 computes the exact median.
+   */
+  MedianImputation(const size_t maxSamples = 0) : maxSamples(maxSamples)
+  {
+    // Nothing to do.
+  }
+
   /**
    * Impute function searches through the input looking for mappedValue and
    * replaces it with the median of the given dimension. The result is
@@ -43,48 +61,87 @@ class MedianImputation
     using PairType = std::pair<size_t, size_t>;
     // dimensions and indexes are saved as pairs inside this vector.
     std::vector<PairType> targets;
-    // good elements are kept inside this vector.
+    // good elements (or a reservoir sample of them) are kept inside this
+    // vector.
     std::vector<double> elemsToKeep;
+    size_t numKept = 0;
 
-    if (columnMajor)
+    const size_t numPoints = columnMajor ? input.n_cols : input.n_rows;
+    for (size_t i = 0; i < numPoints; ++i)
     {
-      for (size_t i = 0; i < input.n_cols; ++i)
-      {
-        if (input(dimension, i) == mappedValue ||
-            std::isnan(input(dimension, i)))
-        {
-          targets.emplace_back(dimension, i);
-        }
-        else
-        {
-          elemsToKeep.push_back(input(dimension, i));
-        }
-      }
-    }
-    else
-    {
-      for (size_t i = 0; i < input.n_rows; ++i)
-      {
-        if (input(i, dimension) == mappedValue ||
-            std::isnan(input(i, dimension)))
-        {
-          targets.emplace_back(i, dimension);
-        }
-        else
-        {
-           elemsToKeep.push_back(input(i, dimension));
-        }
-      }
+      const size_t row = columnMajor ? dimension : i;
+      const size_t col = columnMajor ? i : dimension;
+      if (input(row, col) == mappedValue || std::isnan(input(row, col)))
+        targets.emplace_back(row, col);
+      else
+        Keep(input(row, col), elemsToKeep, numKept);
     }
 
+    if (targets.empty())
+      return;
+
     // calculate median
-    const double median = arma::median(arma::vec(elemsToKeep));
+    const double median = Median(elemsToKeep);
 
     for (const PairType& target : targets)
     {
        input(target.first, target.second) = median;
     }
   }
+
+  //! Get the maximum number of values kept for each median (0 if exact).
+  size_t MaxSamples() const { return maxSamples; }
+  //! Modify the maximum number of values kept for each median (0 if exact).
+  size_t& MaxSamples() { return maxSamples; }
+
+ private:
+  /**
+   * Keep the given value for the median: append it, or, once maxSamples
+   * values are kept, replace a random kept value with probability
+   * maxSamples / numKept (reservoir sampling).
+   */
+  void Keep(const double value, std::vector<double>& kept, size_t& numKept)
+  {
+    ++numKept;
+    if (maxSamples == 0 || kept.size() < maxSamples)
+    {
+      kept.push_back(value);
+      return;
+    }
+
+    std::uniform_int_distribution<size_t> index(0, numKept - 1);
+    const size_t i = index(math::RandGen());
+    if (i < maxSamples)
+      kept[i] = value;
+  }
+
+  /**
+   * Find the median of the given values (the average of the two middle values
+   * if there is an even number of them) by selection; the values are
+   * reordered.
+   */
+  static double Median(std::vector<double>& values)
+  {
+    if (values.empty())
+    {
+      throw std::invalid_argument("MedianImputation::Impute(): all values of "
+          "the dimension are missing!");
+    }
+
+    const size_t middle = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + middle, values.end());
+    const double upper = values[middle];
+    if (values.size() % 2 == 1)
+      return upper;
+
+    // The lower middle value is the largest of the values before the middle.
+    const double lower = *std::max_element(values.begin(),
+        values.begin() + middle);
+    return (lower + upper) / 2.0;
+  }
+
+  //! The maximum number of values kept for each median (0 if exact).
+  size_t maxSamples;
 }; // class MedianImputation
 
 } // namespace data
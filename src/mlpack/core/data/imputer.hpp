@@ -14,6 +14,7 @@
 #define MLPACK_CORE_DATA_IMPUTER_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
 #include "dataset_mapper.hpp"
 #include "map_policies/missing_policy.hpp"
 #include "map_policies/increment_policy.hpp"
@@ -21,6 +22,28 @@
 namespace mlpack {
 namespace data {
 
+// Forward declaration, for the specialization of ImputesInPlace below.
+template<typename T>
+class ListwiseDeletion;
+
+/**
+ * Whether an imputation strategy only overwrites the missing values of the
+ * dimension it is applied to, so that several dimensions can be imputed at
+ * once.
+ */
+template<typename StrategyType>
+struct ImputesInPlace
+{
+  static const bool value = true;
+};
+
+//! ListwiseDeletion removes whole points, so it is not applied in parallel.
+template<typename T>
+struct ImputesInPlace<ListwiseDeletion<T>>
+{
+  static const bool value = false;
+};
+
 /**
  * Given a dataset of a particular datatype, replace user-specified missing
  * value with a variable dependent on the StrategyType and MapperType.
@@ -65,6 +88,47 @@ class Imputer
     strategy.Impute(input, mappedValue, dimension, columnMajor);
   }
 
+  /**
+  * Given an input dataset, replace missing values of each of the given
+  * dimensions with the imputation strategy.  The dimensions are imputed in
+  * parallel when OpenMP is enabled (except for strategies that remove points,
+  * such as ListwiseDeletion, which are applied to one dimension after
+  * another).  Each dimension draws from its own random stream, so strategies
+  * that sample give the same result for any number of threads.
+  *
+  * @param input Input dataset to apply imputation.
+  * @param missingValue User defined missing value; it can be anything.
+  * @param dimensions Dimensions to apply the imputation to.
+  */
+  void Impute(arma::Mat<T>& input,
+              const std::string& missingValue,
+              const std::vector<size_t>& dimensions)
+  {
+    if (!ImputesInPlace<StrategyType>::value)
+    {
+      for (const size_t dimension : dimensions)
+        Impute(input, missingValue, dimension);
+      return;
+    }
+
+    std::vector<T> mappedValues(dimensions.size());
+    for (size_t i = 0; i < dimensions.size(); ++i)
+    {
+      mappedValues[i] = static_cast<T>(mapper.UnmapValue(missingValue,
+          dimensions[i]));
+    }
+
+    const size_t seed = math::RandomStreamSeed();
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) dimensions.size(); ++i)
+    {
+      math::RandomStream stream(seed, dimensions[i]);
+      StrategyType threadStrategy(strategy);
+      threadStrategy.Impute(input, mappedValues[i], dimensions[i],
+          columnMajor);
+    }
+  }
+
   //! Get the strategy.
   const StrategyType& Strategy() const { return strategy; }
 
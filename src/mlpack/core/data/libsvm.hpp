@@ -0,0 +1,81 @@
+/**
+ * @file core/data/libsvm.hpp
+ *
+ * Load and save sparse datasets in the libsvm (or svmlight) text format, where
+ * each line holds the label of one point followed by its nonzero values as
+ * index:value pairs.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LIBSVM_HPP
+#define MLPACK_CORE_DATA_LIBSVM_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Load a sparse dataset and its labels in the libsvm (or svmlight) format:
+ *
+ * @code
+ * <label> <index>:<value> <index>:<value> ...
+ * @endcode
+ *
+ * Each nonempty line is one point, loaded as a column of the matrix; the
+ * indices start at 1, as in libsvm.  Comments (from '#' to the end of the line)
+ * and svmlight query ids (qid:<n>) are ignored, and values of zero are not
+ * stored.  If numDimensions is 0, the number of rows of the matrix is the
+ * largest index in the file; otherwise it is numDimensions, and an index larger
+ * than it is an error.
+ *
+ * The file is read into memory and its lines are parsed in parallel with
+ * OpenMP; each thread builds the compressed columns of its lines, which are
+ * then copied next to each other into the matrix, so no (row, column, value)
+ * triplets are sorted.
+ *
+ * The labels are parsed as floating point numbers and converted to LabelType.
+ * If LabelType is an integer type, non-integral labels are an error, as are
+ * negative labels if it is unsigned; use a signed or floating point LabelType
+ * for -1/+1 labels (data::NormalizeLabels() can map them to 0/1).  A
+ * std::runtime_error is thrown if the file cannot be read or is malformed.
+ *
+ * @param filename Name of file to load.
+ * @param matrix Sparse matrix to load the points into (one point per column).
+ * @param labels Row vector to load the labels into.
+ * @param numDimensions Number of dimensions of the points (0 means the largest
+ *     index in the file).
+ */
+template<typename eT, typename LabelType>
+void LoadLibSVM(const std::string& filename,
+                arma::SpMat<eT>& matrix,
+                arma::Row<LabelType>& labels,
+                const size_t numDimensions = 0);
+
+/**
+ * Save a sparse dataset and its labels in the libsvm (or svmlight) format, as
+ * read by LoadLibSVM().  Each column of the matrix is one line of the file,
+ * with indices starting at 1, and the values are written with enough digits to
+ * be read back exactly.  A std::runtime_error is thrown if the file cannot be
+ * written, and a std::invalid_argument if the number of labels is not the
+ * number of points.
+ *
+ * @param filename Name of file to save to.
+ * @param matrix Sparse matrix to save (one point per column).
+ * @param labels Labels of the points.
+ */
+template<typename eT, typename LabelType>
+void SaveLibSVM(const std::string& filename,
+                const arma::SpMat<eT>& matrix,
+                const arma::Row<LabelType>& labels);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "libsvm_impl.hpp"
+
+#endif
@@ -0,0 +1,352 @@
+/**
+ * @file core/data/libsvm_impl.hpp
+ *
+ * Implementation of LoadLibSVM() and SaveLibSVM().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LIBSVM_IMPL_HPP
+#define MLPACK_CORE_DATA_LIBSVM_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "libsvm.hpp"
+
+#include <cstring>
+#include <iomanip>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace data {
+namespace details {
+
+/**
+ * The points parsed from one block of lines of a libsvm file, as compressed
+ * columns.
+ */
+template<typename eT, typename LabelType>
+struct LibSVMBlock
+{
+  //! The label of each point.
+  std::vector<LabelType> labels;
+  //! The number of nonzero values of each point.
+  std::vector<arma::uword> counts;
+  //! The (zero-based) row index of each nonzero value.
+  std::vector<arma::uword> rowIndices;
+  //! Each nonzero value.
+  std::vector<eT> values;
+  //! The largest (one-based) index in the block.
+  size_t maxIndex = 0;
+  //! The number of lines in the block.
+  size_t numLines = 0;
+  //! The description of the first error, if any.
+  std::string error;
+  //! The line of the first error, within the block.
+  size_t errorLine = 0;
+};
+
+//! Whether the given character separates the tokens of a line.
+inline bool IsLibSVMSpace(const char c)
+{
+  return (c == ' ' || c == '\t' || c == '\r');
+}
+
+/**
+ * Parse one line (without its newline) of a libsvm file into the block.
+ * Returns false, with the error set, if the line is malformed.
+ */
+template<typename eT, typename LabelType>
+bool ParseLibSVMLine(const char* p,
+                     const char* lineEnd,
+                     LibSVMBlock<eT, LabelType>& block)
+{
+  // Skip empty lines and comments.
+  while (p < lineEnd && IsLibSVMSpace(*p))
+    ++p;
+  if (p == lineEnd || *p == '#')
+    return true;
+
+  // Tokens never span lines, so the conversions below stop before lineEnd.
+  char* next;
+  const double label = std::strtod(p, &next);
+  if (next == p || (next < lineEnd && !IsLibSVMSpace(*next) && *next != '#'))
+  {
+    block.error = "invalid label";
+    return false;
+  }
+  if (std::is_integral<LabelType>::value && (label != std::floor(label) ||
+      (std::is_unsigned<LabelType>::value && label < 0.0)))
+  {
+    block.error = "label cannot be represented by the label type";
+    return false;
+  }
+  p = next;
+
+  const size_t first = block.rowIndices.size();
+  bool increasing = true;
+  while (true)
+  {
+    while (p < lineEnd && IsLibSVMSpace(*p))
+      ++p;
+    if (p == lineEnd || *p == '#')
+      break;
+
+    // Query ids (svmlight) are not features.
+    if (lineEnd - p > 4 && std::strncmp(p, "qid:", 4) == 0)
+    {
+      while (p < lineEnd && !IsLibSVMSpace(*p))
+        ++p;
+      continue;
+    }
+
+    if (*p < '0' || *p > '9')
+    {
+      block.error = "invalid index";
+      return false;
+    }
+    const unsigned long long index = std::strtoull(p, &next, 10);
+    if (*next != ':' || index == 0)
+    {
+      block.error = "invalid index (indices start at 1)";
+      return false;
+    }
+    p = next + 1;
+
+    const double value = std::strtod(p, &next);
+    if (next == p || (next < lineEnd && !IsLibSVMSpace(*next) && *next != '#'))
+    {
+      block.error = "invalid value";
+      return false;
+    }
+    p = next;
+
+    block.maxIndex = std::max(block.maxIndex, (size_t) index);
+    if (value == 0.0)
+      continue;
+
+    if (block.rowIndices.size() > first &&
+        (arma::uword) (index - 1) <= block.rowIndices.back())
+      increasing = false;
+    block.rowIndices.push_back((arma::uword) (index - 1));
+    block.values.push_back((eT) value);
+  }
+
+  // The indices of a line should be increasing, but sort them if they are not.
+  const size_t count = block.rowIndices.size() - first;
+  if (!increasing)
+  {
+    std::vector<std::pair<arma::uword, eT>> entries(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      entries[i] = std::make_pair(block.rowIndices[first + i],
+          block.values[first + i]);
+    }
+    std::sort(entries.begin(), entries.end(),
+        [](const std::pair<arma::uword, eT>& a,
+           const std::pair<arma::uword, eT>& b) { return a.first < b.first; });
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (i > 0 && entries[i].first == entries[i - 1].first)
+      {
+        block.error = "duplicate index";
+        return false;
+      }
+      block.rowIndices[first + i] = entries[i].first;
+      block.values[first + i] = entries[i].second;
+    }
+  }
+
+  block.labels.push_back((LabelType) label);
+  block.counts.push_back(count);
+  return true;
+}
+
+//! Parse the lines between begin and end (which is at the end of a line or of
+//! the file) into the block, stopping at the first error.
+template<typename eT, typename LabelType>
+void ParseLibSVMBlock(const char* begin,
+                      const char* end,
+                      LibSVMBlock<eT, LabelType>& block)
+{
+  const char* p = begin;
+  while (p < end)
+  {
+    const char* lineEnd = static_cast<const char*>(
+        std::memchr(p, '\n', end - p));
+    if (lineEnd == NULL)
+      lineEnd = end;
+
+    ++block.numLines;
+    if (!ParseLibSVMLine(p, lineEnd, block))
+    {
+      block.errorLine = block.numLines;
+      return;
+    }
+
+    p = lineEnd + 1;
+  }
+}
+
+} // namespace details
+
+template<typename eT, typename LabelType>
+void LoadLibSVM(const std::string& filename,
+                arma::SpMat<eT>& matrix,
+                arma::Row<LabelType>& labels,
+                const size_t numDimensions)
+{
+  std::ifstream ifs(filename, std::ios::in | std::ios::binary);
+  if (!ifs.is_open())
+  {
+    throw std::runtime_error("data::LoadLibSVM(): cannot open file '" +
+        filename + "'");
+  }
+
+  // Read the whole file at once.
+  ifs.seekg(0, std::ios::end);
+  const std::streamoff size = ifs.tellg();
+  ifs.seekg(0, std::ios::beg);
+  std::string contents(size, '\0');
+  if (size > 0 && !ifs.read(&contents[0], size))
+  {
+    throw std::runtime_error("data::LoadLibSVM(): cannot read file '" +
+        filename + "'");
+  }
+
+  // Split the file into one block of whole lines for each thread (but don't
+  // bother with small files).
+  const size_t minBlockSize = 1 << 16;
+  #ifdef HAS_OPENMP
+  const size_t numBlocks = std::max((size_t) 1, std::min(
+      (size_t) omp_get_max_threads(), contents.size() / minBlockSize));
+  #else
+  const size_t numBlocks = 1;
+  #endif
+  std::vector<size_t> bounds(numBlocks + 1, contents.size());
+  bounds[0] = 0;
+  for (size_t b = 1; b < numBlocks; ++b)
+  {
+    size_t start = std::max(bounds[b - 1], b * contents.size() / numBlocks);
+    while (start < contents.size() && contents[start - 1] != '\n')
+      ++start;
+    bounds[b] = start;
+  }
+
+  std::vector<details::LibSVMBlock<eT, LabelType>> blocks(numBlocks);
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    details::ParseLibSVMBlock(contents.data() + bounds[b],
+        contents.data() + bounds[b + 1], blocks[b]);
+  }
+
+  // Report the first error, and count the points and nonzero values.
+  size_t numLines = 0, numPoints = 0, numNonzeros = 0, maxIndex = 0;
+  std::vector<size_t> pointOffsets(numBlocks), nonzeroOffsets(numBlocks);
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    if (!blocks[b].error.empty())
+    {
+      std::ostringstream oss;
+      oss << "data::LoadLibSVM(): " << blocks[b].error << " on line "
+          << (numLines + blocks[b].errorLine) << " of '" << filename << "'";
+      throw std::runtime_error(oss.str());
+    }
+
+    pointOffsets[b] = numPoints;
+    nonzeroOffsets[b] = numNonzeros;
+    numLines += blocks[b].numLines;
+    numPoints += blocks[b].labels.size();
+    numNonzeros += blocks[b].values.size();
+    maxIndex = std::max(maxIndex, blocks[b].maxIndex);
+  }
+
+  if (numDimensions != 0 && maxIndex > numDimensions)
+  {
+    std::ostringstream oss;
+    oss << "data::LoadLibSVM(): index " << maxIndex << " in '" << filename
+        << "' is larger than the given number of dimensions ("
+        << numDimensions << ")";
+    throw std::runtime_error(oss.str());
+  }
+
+  // Copy the compressed columns of each block next to each other.
+  arma::uvec rowIndices(numNonzeros);
+  arma::uvec colPtrs(numPoints + 1);
+  arma::Col<eT> values(numNonzeros);
+  labels.set_size(numPoints);
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const details::LibSVMBlock<eT, LabelType>& block = blocks[b];
+    std::copy(block.rowIndices.begin(), block.rowIndices.end(),
+        rowIndices.begin() + nonzeroOffsets[b]);
+    std::copy(block.values.begin(), block.values.end(),
+        values.begin() + nonzeroOffsets[b]);
+    std::copy(block.labels.begin(), block.labels.end(),
+        labels.begin() + pointOffsets[b]);
+
+    arma::uword colPtr = nonzeroOffsets[b];
+    for (size_t i = 0; i < block.counts.size(); ++i)
+    {
+      colPtrs[pointOffsets[b] + i] = colPtr;
+      colPtr += block.counts[i];
+    }
+  }
+  colPtrs[numPoints] = numNonzeros;
+
+  matrix = arma::SpMat<eT>(rowIndices, colPtrs, values,
+      (numDimensions == 0) ? maxIndex : numDimensions, numPoints);
+}
+
+template<typename eT, typename LabelType>
+void SaveLibSVM(const std::string& filename,
+                const arma::SpMat<eT>& matrix,
+                const arma::Row<LabelType>& labels)
+{
+  if (labels.n_elem != matrix.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "data::SaveLibSVM(): number of labels (" << labels.n_elem
+        << ") does not match number of points (" << matrix.n_cols << ")";
+    throw std::invalid_argument(oss.str());
+  }
+
+  std::ofstream ofs(filename, std::ios::out | std::ios::binary);
+  if (!ofs.is_open())
+  {
+    throw std::runtime_error("data::SaveLibSVM(): cannot open file '" +
+        filename + "' for writing");
+  }
+
+  // Write enough digits to read the values back exactly.  The unary + prints
+  // char types as numbers.
+  const int labelDigits = std::numeric_limits<LabelType>::max_digits10;
+  const int valueDigits = std::numeric_limits<eT>::max_digits10;
+  matrix.sync();
+  for (size_t c = 0; c < matrix.n_cols; ++c)
+  {
+    ofs << std::setprecision(labelDigits) << +labels[c]
+        << std::setprecision(valueDigits);
+    for (size_t i = matrix.col_ptrs[c]; i < matrix.col_ptrs[c + 1]; ++i)
+      ofs << ' ' << (matrix.row_indices[i] + 1) << ':' << +matrix.values[i];
+    ofs << '\n';
+  }
+
+  if (!ofs)
+  {
+    throw std::runtime_error("data::SaveLibSVM(): cannot write file '" +
+        filename + "'");
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
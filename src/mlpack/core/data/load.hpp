@@ -78,12 +78,15 @@ bool Load(const std::string& filename,
  * will transpose the matrix at load time (unless the transpose parameter is set
  * to false).  If the filetype cannot be determined, an error will be given.
  *
- * The supported types of files are the same as found in Armadillo:
+ * The supported types of files are the same as found in Armadillo, plus the
+ * libsvm format:
  *
  *  - TSV (coord_ascii), denoted by .tsv or .txt
  *  - TXT (coord_ascii), denoted by .txt
  *  - Raw binary (raw_binary), denoted by .bin
  *  - Armadillo binary (arma_binary), denoted by .bin
+ *  - libsvm / svmlight (see LoadLibSVM()), denoted by .svm or .libsvm; each
+ *    line is already a point, and the labels are discarded
  *
  * If the file extension is not one of those types, an error will be given.
  * This is preferable to Armadillo's default behavior of loading an unknown
@@ -255,12 +258,13 @@ bool Load(const std::string& filename,
  * Loads a matrix from a file, guessing the filetype from the extension and
  * mapping categorical features with a DatasetMapper object.  This will
  * transpose the matrix (unless the transpose parameter is set to false).
- * This particular overload of Load() can only load text-based formats, such as
- * those given below:
+ * This particular overload of Load() can only load the formats given below:
  *
  * - CSV (csv_ascii), denoted by .csv, or optionally .txt
  * - TSV (raw_ascii), denoted by .tsv, .csv, or .txt
  * - ASCII (raw_ascii), denoted by .txt
+ * - ARFF, denoted by .arff
+ * - mlpack's binary columnar format (see SaveColumnar()), denoted by .mlcol
  *
  * If the file extension is not one of those types, an error will be given.
  * This is preferable to Armadillo's default behavior of loading an unknown
@@ -347,9 +351,12 @@ extern template bool Load<double, IncrementPolicy>(
  *  - json, denoted by .json
  *  - xml, denoted by .xml
  *  - binary, denoted by .bin
+ *  - blob, denoted by .blob: binary, with the large matrices stored as aligned
+ *    blocks that are read in one piece (see LoadMapped() to memory-map them)
  *
  * The format parameter can take any of the values in the 'format' enum:
- * 'format::autodetect', 'format::json', 'format::xml', and 'format::binary'.
+ * 'format::autodetect', 'format::json', 'format::xml', 'format::binary', and
+ * 'format::blob'.
  * The autodetect functionality operates on the file extension (so, "file.txt"
  * would be autodetected as text).
  *
@@ -388,7 +395,10 @@ bool Load(const std::string& filename,
           const bool fatal = false);
 
 /**
- * Load the image file into the given matrix.
+ * Load the image files into the given matrix, one image per column.  All
+ * images must have the same dimensions as the first one; the matrix is sized
+ * from the dimensions of the first image, and the other images are decoded in
+ * parallel (when mlpack is built with OpenMP) directly into their columns.
  *
  * @param files A vector consisting of filenames.
  * @param matrix Matrix to save the image from.
@@ -408,6 +418,14 @@ bool LoadImage(const std::string& filename,
                ImageInfo& info,
                const bool fatal = false);
 
+// Implementation found in load_image.cpp.  This does not print anything, so it
+// can be called from several threads; on failure, the reason is stored in
+// error.
+bool DecodeImage(const std::string& filename,
+                 arma::Mat<unsigned char>& matrix,
+                 ImageInfo& info,
+                 std::string& error);
+
 } // namespace data
 } // namespace mlpack
 
@@ -20,7 +20,10 @@ namespace data {
 LoadCSV::LoadCSV(const std::string& file) :
   extension(Extension(file)),
   filename(file),
-  inFile(file)
+  inFile(file),
+  streaming(false),
+  streamDimensionality(0),
+  streamLine(0)
 {
   // Attempt to open stream.
   CheckOpen();
@@ -83,5 +86,27 @@ void LoadCSV::CheckOpen()
   inFile.unsetf(std::ios::skipws);
 }
 
+size_t LoadCSV::CountTokens(std::string& line)
+{
+  size_t tokens = 0;
+  auto countToken = [&tokens](iter_type) { ++tokens; };
+  qi::parse(line.begin(), line.end(), stringRule[countToken] % delimiterRule);
+
+  return tokens;
+}
+
+void LoadCSV::AppendToken(const iter_type& token, DimensionTokens& tokens)
+{
+  std::string::const_iterator begin = token.begin();
+  std::string::const_iterator end = token.end();
+  while (begin != end && std::isspace((unsigned char) *begin))
+    ++begin;
+  while (end != begin && std::isspace((unsigned char) *(end - 1)))
+    --end;
+
+  tokens.text.append(begin, end);
+  tokens.ends.push_back(tokens.text.size());
+}
+
 } // namespace data
 } // namespace mlpack
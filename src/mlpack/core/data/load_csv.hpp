@@ -18,8 +18,12 @@
 #include <mlpack/core.hpp>
 #include <mlpack/core/util/log.hpp>
 
+#include <exception>
 #include <set>
 #include <string>
+#include <unordered_map>
+
+#include <mlpack/core/boost_backport/boost_backport_string_view.hpp>
 
 #include "extension.hpp"
 #include "format.hpp"
@@ -58,12 +62,122 @@ class LoadCSV
   {
     CheckOpen();
 
+    // Any following call to LoadChunk() will start from the top of the file.
+    streaming = false;
+
     if (transpose)
       TransposeParse(inout, infoSet);
     else
       NonTransposeParse(inout, infoSet);
   }
 
+  /**
+   * Load the next chunk of at most maxPoints points (lines) of the file into
+   * the given matrix, so that a file can be processed in mini-batches without
+   * holding all of it in memory.  Each line is one point, as with a transposed
+   * Load().  The first call starts at the top of the file and initializes the
+   * DatasetMapper; pass the same DatasetMapper to every call so that mappings
+   * are consistent between chunks.  Throws exceptions on errors.
+   *
+   * Because the file is not scanned ahead of time, a dimension is treated as
+   * numeric until a value that cannot be read as a number is found in it;
+   * values in earlier chunks are not remapped.
+   *
+   * @param chunk Matrix to load the next chunk into.
+   * @param infoSet DatasetMapper to use while loading.
+   * @param maxPoints Maximum number of points to load.
+   * @return false if there were no more points to load.
+   */
+  template<typename T, typename PolicyType>
+  bool LoadChunk(arma::Mat<T>& chunk,
+                 DatasetMapper<PolicyType>& infoSet,
+                 const size_t maxPoints)
+  {
+    using namespace boost::spirit;
+
+    CheckOpen();
+    if (maxPoints == 0)
+    {
+      throw std::invalid_argument("LoadCSV::LoadChunk(): maxPoints must be "
+          "greater than 0!");
+    }
+
+    if (!streaming)
+    {
+      inFile.clear();
+      inFile.seekg(0, std::ios::beg);
+      streaming = true;
+      streamDimensionality = 0;
+      streamLine = 0;
+    }
+
+    size_t row = 0;
+    size_t col = 0;
+    auto parseString = [&](iter_type const &iter)
+    {
+      if (row < streamDimensionality)
+      {
+        std::string str(iter.begin(), iter.end());
+        boost::trim(str);
+
+        chunk(row, col) = infoSet.template MapString<T>(std::move(str), row);
+      }
+      ++row;
+    };
+
+    std::string line;
+    while (col < maxPoints && std::getline(inFile, line))
+    {
+      // Remove whitespace from either side.
+      boost::trim(line);
+
+      // The first line of the file gives the dimensionality.
+      if (streamDimensionality == 0)
+      {
+        streamDimensionality = CountTokens(line);
+        infoSet.SetDimensionality(streamDimensionality);
+      }
+
+      if (col == 0)
+        chunk.set_size(streamDimensionality, maxPoints);
+
+      row = 0;
+      const bool canParse = qi::parse(line.begin(), line.end(),
+          stringRule[parseString] % delimiterRule);
+
+      if (row != streamDimensionality)
+      {
+        std::ostringstream oss;
+        oss << "LoadCSV::LoadChunk(): wrong number of dimensions (" << row
+            << ") on line " << streamLine << "; should be "
+            << streamDimensionality << " dimensions.";
+        throw std::runtime_error(oss.str());
+      }
+
+      if (!canParse)
+      {
+        std::ostringstream oss;
+        oss << "LoadCSV::LoadChunk(): parsing error on line " << streamLine
+            << "!";
+        throw std::runtime_error(oss.str());
+      }
+
+      ++col;
+      ++streamLine;
+    }
+
+    if (col == 0)
+    {
+      chunk.set_size(streamDimensionality, 0);
+      return false;
+    }
+
+    if (col < maxPoints)
+      chunk.resize(streamDimensionality, col);
+
+    return true;
+  }
+
   /**
    * Peek at the file to determine the number of rows and columns in the matrix,
    * assuming a non-transposed matrix.  This will also take a first pass over
@@ -214,7 +328,27 @@ class LoadCSV
   void CheckOpen();
 
   /**
-   * Parse a non-transposed matrix.
+   * Count the number of tokens on the given line.
+   */
+  size_t CountTokens(std::string& line);
+
+  //! The tokens of one dimension, stored one after another.
+  struct DimensionTokens
+  {
+    //! The characters of all the tokens.
+    std::string text;
+    //! The end of each token in text.
+    std::vector<size_t> ends;
+  };
+
+  /**
+   * Trim the given token and append it to the tokens of its dimension.
+   */
+  void AppendToken(const iter_type& token, DimensionTokens& tokens);
+
+  /**
+   * Parse a non-transposed matrix.  The file is only tokenized here; the
+   * tokens are mapped by MapTokens().
    *
    * @param inout Matrix to load into.
    * @param infoSet DatasetMapper object to load with.
@@ -225,41 +359,36 @@ class LoadCSV
   {
     using namespace boost::spirit;
 
-    // Get the size of the matrix.
-    size_t rows, cols;
-    GetMatrixSize<T>(rows, cols, infoSet);
-
-    // Set up output matrix.
-    inout.set_size(rows, cols);
-    size_t row = 0;
-    size_t col = 0;
-
-    // Reset file position.
-    std::string line;
     inFile.clear();
     inFile.seekg(0, std::ios::beg);
 
-    auto setCharClass = [&](iter_type const &iter)
+    // Each line is a dimension.
+    std::vector<DimensionTokens> tokens;
+    size_t cols = 0;
+    size_t row = 0;
+    size_t col = 0;
+    auto parseString = [&](iter_type const &iter)
     {
-      std::string str(iter.begin(), iter.end());
-      if (str == "\t")
-      {
-        str.clear();
-      }
-      boost::trim(str);
-
-      inout(row, col++) = infoSet.template MapString<T>(std::move(str), row);
+      if (col < cols)
+        AppendToken(iter, tokens[row]);
+      ++col;
     };
 
+    std::string line;
     while (std::getline(inFile, line))
     {
       // Remove whitespace from either side.
       boost::trim(line);
 
-      // Parse the numbers from a line (ex: 1,2,3,4); if the parser finds a
-      // number it will execute the setNum function.
+      if (row == 0)
+        cols = CountTokens(line);
+
+      tokens.push_back(DimensionTokens());
+      tokens.back().ends.reserve(cols);
+
+      col = 0;
       const bool canParse = qi::parse(line.begin(), line.end(),
-          stringRule[setCharClass] % delimiterRule);
+          stringRule[parseString] % delimiterRule);
 
       // Make sure we got the right number of rows.
       if (col != cols)
@@ -274,17 +403,20 @@ class LoadCSV
       if (!canParse)
       {
         std::ostringstream oss;
-        oss << "LoadCSV::NonTransposeParse(): parsing error on line " << col
+        oss << "LoadCSV::NonTransposeParse(): parsing error on line " << row
             << "!";
         throw std::runtime_error(oss.str());
       }
 
-      ++row; col = 0;
+      ++row;
     }
+
+    MapTokens(inout, infoSet, tokens, cols);
   }
 
   /**
-   * Parse a transposed matrix.
+   * Parse a transposed matrix.  The file is only tokenized here; the tokens
+   * are mapped by MapTokens().
    *
    * @param inout Matrix to load into.
    * @param infoSet DatasetMapper to load with.
@@ -294,39 +426,45 @@ class LoadCSV
   {
     using namespace boost::spirit;
 
-    // Get matrix size.  This also initializes infoSet correctly.
-    size_t rows, cols;
-    GetTransposeMatrixSize<T>(rows, cols, infoSet);
-
-    // Set the matrix size.
-    inout.set_size(rows, cols);
-
-    // Initialize auxiliary variables.
-    size_t row = 0;
-    size_t col = 0;
-    std::string line;
+    // Find the size of the file, so that we can guess the number of points.
     inFile.clear();
+    inFile.seekg(0, std::ios::end);
+    const std::streamoff fileEnd = inFile.tellg();
+    const size_t fileSize = (fileEnd > 0) ? (size_t) fileEnd : 0;
     inFile.seekg(0, std::ios::beg);
 
-    /**
-     * This is the parse rule for strings.  When we get a string we have to pass
-     * it to the DatasetMapper.
-     */
+    // Each token of a line belongs to a different dimension.
+    std::vector<DimensionTokens> tokens;
+    size_t rows = 0;
+    size_t row = 0;
+    size_t col = 0;
     auto parseString = [&](iter_type const &iter)
     {
-      // All parsed values must be mapped.
-      std::string str(iter.begin(), iter.end());
-      boost::trim(str);
-
-      inout(row, col) = infoSet.template MapString<T>(std::move(str), row);
+      if (row < rows)
+        AppendToken(iter, tokens[row]);
       ++row;
     };
 
+    std::string line;
     while (std::getline(inFile, line))
     {
       // Remove whitespace from either side.
       boost::trim(line);
 
+      if (col == 0)
+      {
+        // The first line gives the dimensionality; use its length to estimate
+        // how many points there are.
+        rows = CountTokens(line);
+        tokens.resize(rows);
+        const size_t points = fileSize / (line.size() + 1) + 1;
+        for (size_t i = 0; i < rows; ++i)
+        {
+          tokens[i].ends.reserve(points);
+          tokens[i].text.reserve(points * (line.size() / rows + 1));
+        }
+      }
+
       // Reset the row we are looking at.  (Remember this is transposed.)
       row = 0;
 
@@ -355,6 +493,126 @@ class LoadCSV
       // Increment the column index.
       ++col;
     }
+
+    if (col == 0)
+    {
+      inout.set_size(0, 0);
+      return;
+    }
+
+    MapTokens(inout, infoSet, tokens, col);
+  }
+
+  /**
+   * Map the tokens of every dimension into the matrix (dimension d becomes row
+   * d), and set up the DatasetMapper.  The dimensions are mapped in parallel,
+   * each with its own single-dimension DatasetMapper (and a copy of the
+   * policy), and their mappings are then moved into infoSet in order, so the
+   * result is the same as mapping the whole file serially after a first pass.
+   * This assumes, as IncrementPolicy and MissingPolicy do, that the policy maps
+   * each dimension independently of the others.
+   *
+   * @param inout Matrix to load into.
+   * @param infoSet DatasetMapper to load with.
+   * @param tokens Tokens of each dimension.
+   * @param points Number of tokens in each dimension.
+   */
+  template<typename T, typename PolicyType>
+  void MapTokens(arma::Mat<T>& inout,
+                 DatasetMapper<PolicyType>& infoSet,
+                 const std::vector<DimensionTokens>& tokens,
+                 const size_t points)
+  {
+    PolicyType policy(infoSet.Policy());
+    const DatasetMapper<PolicyType> emptyMapper(policy, 1);
+    std::vector<DatasetMapper<PolicyType>> mappers(tokens.size(),
+        emptyMapper);
+
+    // Each dimension is a column here, so that every thread writes to its own
+    // memory.  Exceptions can't leave the parallel loop, so they are kept
+    // until it is done.
+    arma::Mat<T> mapped(points, tokens.size());
+    std::vector<std::exception_ptr> errors(tokens.size());
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t d = 0; d < (omp_size_t) tokens.size(); ++d)
+    {
+      try
+      {
+        MapDimension(mapped.colptr(d), mappers[d], tokens[d]);
+      }
+      catch (...)
+      {
+        errors[d] = std::current_exception();
+      }
+    }
+
+    infoSet.SetDimensionality(tokens.size());
+    for (size_t d = 0; d < tokens.size(); ++d)
+    {
+      if (errors[d])
+        std::rethrow_exception(errors[d]);
+
+      infoSet.TakeDimension(d, mappers[d]);
+    }
+
+    inout = mapped.t();
+  }
+
+  /**
+   * Map the tokens of one dimension with the given single-dimension
+   * DatasetMapper, taking a first pass over them if the policy needs one.
+   *
+   * @param values Array to store the mapped values in.
+   * @param mapper DatasetMapper with dimensionality 1.
+   * @param tokens Tokens of the dimension.
+   */
+  template<typename T, typename PolicyType>
+  void MapDimension(T* values,
+                    DatasetMapper<PolicyType>& mapper,
+                    const DimensionTokens& tokens)
+  {
+    // The policy takes strings, but one buffer can be reused for all of them.
+    std::string str;
+    size_t begin = 0;
+    if (PolicyType::NeedsFirstPass)
+    {
+      for (size_t i = 0; i < tokens.ends.size(); ++i)
+      {
+        str.assign(tokens.text, begin, tokens.ends[i] - begin);
+        mapper.template MapFirstPass<T>(str, 0);
+        begin = tokens.ends[i];
+      }
+    }
+
+    // The values of a categorical dimension repeat, so each distinct token is
+    // only given to the policy once; the mapping of the others is looked up by
+    // a view of the token.  (Numeric values rarely repeat, so they aren't
+    // worth interning.)
+    const bool intern = (mapper.Type(0) == Datatype::categorical);
+    std::unordered_map<boost::string_view, T, boost::hash<boost::string_view>>
+        interned;
+    begin = 0;
+    for (size_t i = 0; i < tokens.ends.size(); ++i)
+    {
+      const boost::string_view token(tokens.text.data() + begin,
+          tokens.ends[i] - begin);
+      begin = tokens.ends[i];
+
+      if (intern)
+      {
+        const auto it = interned.find(token);
+        if (it != interned.end())
+        {
+          values[i] = it->second;
+          continue;
+        }
+      }
+
+      str.assign(token.data(), token.size());
+      values[i] = mapper.template MapString<T>(str, 0);
+      if (intern)
+        interned.emplace(token, values[i]);
+    }
   }
 
   //! Spirit rule for parsing.
@@ -368,6 +626,13 @@ class LoadCSV
   std::string filename;
   //! Opened stream for reading.
   std::ifstream inFile;
+
+  //! Whether LoadChunk() has started reading the file.
+  bool streaming;
+  //! The dimensionality of the points read by LoadChunk().
+  size_t streamDimensionality;
+  //! The next line to be read by LoadChunk().
+  size_t streamLine;
 };
 
 } // namespace data
@@ -24,10 +24,10 @@
 namespace mlpack {
 namespace data {
 
-bool LoadImage(const std::string& filename,
-               arma::Mat<unsigned char>& matrix,
-               ImageInfo& info,
-               const bool fatal)
+bool DecodeImage(const std::string& filename,
+                 arma::Mat<unsigned char>& matrix,
+                 ImageInfo& info,
+                 std::string& error)
 {
   unsigned char* image;
 
@@ -38,17 +38,8 @@ bool LoadImage(const std::string& filename,
     oss << "Currently it supports: ";
     for (auto extension : loadFileTypes)
       oss << " " << extension;
-    oss << "." << std::endl;
-
-    if (fatal)
-    {
-      Log::Fatal << oss.str();
-    }
-    else
-    {
-      Log::Warn << oss.str();
-    }
-
+    oss << ".";
+    error = oss.str();
     return false;
   }
 
@@ -69,17 +60,8 @@ bool LoadImage(const std::string& filename,
 
   if (!image)
   {
-    if (fatal)
-    {
-      Log::Fatal << "Load(): failed to load image '" << filename << "': "
-          << stbi_failure_reason() << std::endl;
-    }
-    else
-    {
-      Log::Warn << "Load(): failed to load image '" << filename << "': "
-          << stbi_failure_reason() << std::endl;
-    }
-
+    error = "Load(): failed to load image '" + filename + "': " +
+        stbi_failure_reason();
     return false;
   }
 
@@ -96,6 +78,25 @@ bool LoadImage(const std::string& filename,
   return true;
 }
 
+bool LoadImage(const std::string& filename,
+               arma::Mat<unsigned char>& matrix,
+               ImageInfo& info,
+               const bool fatal)
+{
+  std::string error;
+  if (!DecodeImage(filename, matrix, info, error))
+  {
+    if (fatal)
+      Log::Fatal << error << std::endl;
+    else
+      Log::Warn << error << std::endl;
+
+    return false;
+  }
+
+  return true;
+}
+
 } // namespace data
 } // namespace mlpack
 
@@ -104,6 +105,16 @@ bool LoadImage(const std::string& filename,
 namespace mlpack {
 namespace data {
 
+bool DecodeImage(const std::string& /* filename */,
+                 arma::Mat<unsigned char>& /* matrix */,
+                 ImageInfo& /* info */,
+                 std::string& error)
+{
+  error = "Load(): mlpack was not compiled with STB support, so images "
+      "cannot be loaded!";
+  return false;
+}
+
 bool LoadImage(const std::string& /* filename */,
                arma::Mat<unsigned char>& /* matrix */,
                ImageInfo& /* info */,
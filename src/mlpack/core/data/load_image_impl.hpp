@@ -65,28 +65,68 @@ bool Load(const std::vector<std::string>& files,
     return false;
   }
 
+  // The first image gives the dimensions of the matrix.
   arma::Mat<unsigned char> img;
-  bool status = LoadImage(files[0], img, info, fatal);
-
-  if (!status)
+  if (!LoadImage(files[0], img, info, fatal))
     return false;
 
-  // Decide matrix dimension using the image height and width.
-  arma::Mat<unsigned char> tmpMatrix(
-      info.Width() * info.Height() * info.Channels(), files.size());
-  tmpMatrix.col(0) = img;
+  matrix.set_size(img.n_elem, files.size());
+  std::copy(img.begin(), img.end(), matrix.colptr(0));
 
-  for (size_t i = 1; i < files.size() ; ++i)
+  // Decode the other images in parallel; each thread writes only the columns
+  // of its own images.  Errors cannot be printed from the threads, so we keep
+  // the error of the first image that failed.
+  size_t firstFailure = files.size();
+  std::string firstError;
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 1; i < (omp_size_t) files.size(); ++i)
   {
-    arma::Mat<unsigned char> colImg(tmpMatrix.colptr(i), tmpMatrix.n_rows, 1,
-        false, true);
-    status = LoadImage(files[i], colImg, info, fatal);
+    arma::Mat<unsigned char> colImg;
+    ImageInfo colInfo(info);
+    std::string error;
+    bool status = DecodeImage(files[i], colImg, colInfo, error);
+    if (status && (colInfo.Width() != info.Width() ||
+        colInfo.Height() != info.Height() ||
+        colInfo.Channels() != info.Channels()))
+    {
+      std::ostringstream oss;
+      oss << "Load(): image '" << files[i] << "' has dimensions "
+          << colInfo.Width() << "x" << colInfo.Height() << "x"
+          << colInfo.Channels() << ", but the first image has dimensions "
+          << info.Width() << "x" << info.Height() << "x" << info.Channels()
+          << ".";
+      error = oss.str();
+      status = false;
+    }
 
     if (!status)
-      return false;
+    {
+      #pragma omp critical
+      {
+        if ((size_t) i < firstFailure)
+        {
+          firstFailure = i;
+          firstError = error;
+        }
+      }
+
+      continue;
+    }
+
+    std::copy(colImg.begin(), colImg.end(), matrix.colptr(i));
+  }
+
+  if (firstFailure != files.size())
+  {
+    matrix.clear();
+    if (fatal)
+      Log::Fatal << firstError << std::endl;
+    else
+      Log::Warn << firstError << std::endl;
+
+    return false;
   }
 
-  matrix = arma::conv_to<arma::Mat<eT>>::from(tmpMatrix);
   return true;
 }
 
@@ -28,6 +28,8 @@
 #include <boost/algorithm/string.hpp>
 
 #include "load_arff.hpp"
+#include "columnar.hpp"
+#include "libsvm.hpp"
 
 namespace mlpack {
 namespace data {
@@ -270,6 +272,25 @@ bool Load(const std::string& filename,
       return false;
     }
   }
+  else if (extension == "mlcol")
+  {
+    Log::Info << "Loading '" << filename << "' as columnar dataset.  "
+        << std::flush;
+    try
+    {
+      LoadColumnar(filename, matrix, info, transpose);
+    }
+    catch (std::exception& e)
+    {
+      Timer::Stop("loading_data");
+      if (fatal)
+        Log::Fatal << e.what() << std::endl;
+      else
+        Log::Warn << e.what() << std::endl;
+
+      return false;
+    }
+  }
   else
   {
     // The type is unknown.
@@ -323,6 +344,36 @@ bool Load(const std::string& filename,
     return false;
   }
 
+  if (extension == "svm" || extension == "libsvm")
+  {
+    // The labels of a libsvm file are discarded here; use LoadLibSVM() to get
+    // them.  Each point is already a column.
+    Log::Info << "Loading '" << filename << "' as libsvm data.  " << std::flush;
+    try
+    {
+      arma::rowvec labels;
+      LoadLibSVM(filename, matrix, labels);
+    }
+    catch (std::exception& e)
+    {
+      Timer::Stop("loading_data");
+      if (fatal)
+        Log::Fatal << e.what() << std::endl;
+      else
+        Log::Warn << e.what() << std::endl;
+
+      return false;
+    }
+
+    Log::Info << "Size is " << matrix.n_rows << " x " << matrix.n_cols
+        << ".\n";
+    if (!transpose)
+      matrix = matrix.t();
+
+    Timer::Stop("loading_data");
+    return true;
+  }
+
   bool unknownType = false;
   arma::file_type loadType;
   std::string stringType;
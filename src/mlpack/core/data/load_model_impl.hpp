@@ -19,6 +19,7 @@
 #include <mlpack/core/util/timers.hpp>
 
 #include "extension.hpp"
+#include "blob_model.hpp"
 
 #include <boost/tokenizer.hpp>
 #include <boost/algorithm/string.hpp>
@@ -49,6 +50,8 @@ bool Load(const std::string& filename,
       f = format::binary;
     else if (extension == "json")
       f = format::json;
+    else if (extension == "blob")
+      f = format::blob;
     else
     {
       if (fatal)
@@ -65,7 +68,7 @@ bool Load(const std::string& filename,
   // Now load the given format.
   std::ifstream ifs;
 #ifdef _WIN32 // Open non-text in binary mode on Windows.
-  if (f == format::binary)
+  if (f == format::binary || f == format::blob)
     ifs.open(filename, std::ifstream::in | std::ifstream::binary);
   else
     ifs.open(filename, std::ifstream::in);
@@ -101,6 +104,10 @@ bool Load(const std::string& filename,
       cereal::BinaryInputArchive ar(ifs);
       ar(cereal::make_nvp(name.c_str(), t));
     }
+    else if (f == format::blob)
+    {
+      LoadBlobModel(ifs, name, t);
+    }
 
     return true;
   }
@@ -0,0 +1,122 @@
+/**
+ * @file core/data/mapped_matrix.hpp
+ *
+ * Definition of the MappedMatrix class, which memory-maps a raw column-major
+ * binary file so that it can be used as an Armadillo matrix without copying it
+ * into process memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MAPPED_MATRIX_HPP
+#define MLPACK_CORE_DATA_MAPPED_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A MappedMatrix memory-maps a file holding a raw column-major matrix (as saved
+ * by Armadillo with the arma::raw_binary format) and exposes it as an
+ * Armadillo matrix that uses the mapped memory directly.  Because the pages are
+ * backed by the file, several processes mapping the same file share a single
+ * copy of the data in the page cache.
+ *
+ * The matrix returned by Matrix() can be moved into any class that takes
+ * ownership of a dataset with MatType&& (for instance the trees in
+ * mlpack::tree, or NeighborSearch), and no copy will be made.  Trees that
+ * rearrange their dataset (like the BinarySpaceTree) will reorder the points
+ * in place, so the mapping must be writable in that case; the permutation is
+ * written back to the file, and the mapping from old to new indices returned
+ * by the tree constructor should be stored alongside it.  A read-only mapping
+ * can be used for any computation that does not modify the data.
+ *
+ * The MappedMatrix must outlive any matrix obtained from Matrix().
+ *
+ * @code
+ * // Build a kd-tree in place over a 10-dimensional file of 1M points.
+ * data::MappedMatrix<double> points("points.bin", 10, 1000000, true);
+ * std::vector<size_t> oldFromNew;
+ * tree::KDTree<metric::EuclideanDistance, tree::EmptyStatistic, arma::mat>
+ *     tree(points.Matrix(), oldFromNew);
+ * @endcode
+ *
+ * @tparam eT Type of element held in the file.
+ */
+template<typename eT>
+class MappedMatrix
+{
+ public:
+  /**
+   * Map the given file.  The file must contain at least rows * cols elements
+   * of type eT after the given offset.  An exception is thrown if the file
+   * cannot be opened or mapped, or if memory mapping is not supported on this
+   * platform.
+   *
+   * @param filename Name of file to map.
+   * @param rows Number of rows (dimensions) of the matrix.
+   * @param cols Number of columns (points) of the matrix.
+   * @param writable If true, the file is mapped with write access and changes
+   *     to the matrix are written back to the file.
+   * @param offset Offset (in bytes) of the first element in the file.
+   */
+  MappedMatrix(const std::string& filename,
+               const size_t rows,
+               const size_t cols,
+               const bool writable = false,
+               const size_t offset = 0);
+
+  //! Copying a mapping is not allowed.
+  MappedMatrix(const MappedMatrix& other) = delete;
+  //! Copying a mapping is not allowed.
+  MappedMatrix& operator=(const MappedMatrix& other) = delete;
+
+  /**
+   * Unmap the file.  Any matrices obtained from Matrix() become invalid.
+   */
+  ~MappedMatrix();
+
+  /**
+   * Get an Armadillo matrix that uses the mapped memory directly.  If the
+   * matrix is resized, it will no longer refer to the mapped memory.  If the
+   * mapping is read-only, the matrix must not be modified.
+   */
+  arma::Mat<eT> Matrix() const;
+
+  /**
+   * Flush any changes made to a writable mapping back to the file.
+   */
+  void Sync();
+
+  //! Get the number of rows of the mapped matrix.
+  size_t Rows() const { return rows; }
+  //! Get the number of columns of the mapped matrix.
+  size_t Cols() const { return cols; }
+  //! Get whether or not the mapping is writable.
+  bool Writable() const { return writable; }
+
+ private:
+  //! The number of rows of the matrix.
+  size_t rows;
+  //! The number of columns of the matrix.
+  size_t cols;
+  //! Whether or not the mapping is writable.
+  bool writable;
+  //! The start of the mapped region.
+  void* mapping;
+  //! The length of the mapped region.
+  size_t mappingLength;
+  //! The first element of the matrix in the mapped region.
+  eT* memptr;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "mapped_matrix_impl.hpp"
+
+#endif
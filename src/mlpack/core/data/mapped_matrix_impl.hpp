@@ -0,0 +1,135 @@
+/**
+ * @file core/data/mapped_matrix_impl.hpp
+ *
+ * Implementation of the MappedMatrix class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MAPPED_MATRIX_IMPL_HPP
+#define MLPACK_CORE_DATA_MAPPED_MATRIX_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mapped_matrix.hpp"
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+MappedMatrix<eT>::MappedMatrix(const std::string& filename,
+                               const size_t rows,
+                               const size_t cols,
+                               const bool writable,
+                               const size_t offset) :
+    rows(rows),
+    cols(cols),
+    writable(writable),
+    mapping(NULL),
+    mappingLength(0),
+    memptr(NULL)
+{
+#ifdef _WIN32
+  throw std::runtime_error("MappedMatrix: memory mapping is not supported on "
+      "Windows.");
+#else
+  const int fd = open(filename.c_str(), writable ? O_RDWR : O_RDONLY);
+  if (fd == -1)
+  {
+    std::ostringstream oss;
+    oss << "MappedMatrix: cannot open file '" << filename << "'.";
+    throw std::runtime_error(oss.str());
+  }
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) == -1)
+  {
+    close(fd);
+    std::ostringstream oss;
+    oss << "MappedMatrix: cannot get size of file '" << filename << "'.";
+    throw std::runtime_error(oss.str());
+  }
+
+  const size_t needed = offset + rows * cols * sizeof(eT);
+  if ((size_t) fileStat.st_size < needed)
+  {
+    close(fd);
+    std::ostringstream oss;
+    oss << "MappedMatrix: file '" << filename << "' has size "
+        << fileStat.st_size << " bytes, but " << needed << " bytes are needed "
+        << "for a " << rows << "x" << cols << " matrix.";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (offset % sizeof(eT) != 0)
+  {
+    close(fd);
+    throw std::invalid_argument("MappedMatrix: offset must be a multiple of "
+        "the element size.");
+  }
+
+  // Map from the start of the file so that the offset does not need to be
+  // page-aligned.
+  mappingLength = needed;
+  if (mappingLength > 0)
+  {
+    mapping = mmap(NULL, mappingLength,
+        writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+
+  if (mapping == MAP_FAILED)
+  {
+    mapping = NULL;
+    std::ostringstream oss;
+    oss << "MappedMatrix: cannot memory-map file '" << filename << "'.";
+    throw std::runtime_error(oss.str());
+  }
+
+  if (mapping != NULL)
+    memptr = reinterpret_cast<eT*>(static_cast<char*>(mapping) + offset);
+#endif
+}
+
+template<typename eT>
+MappedMatrix<eT>::~MappedMatrix()
+{
+#ifndef _WIN32
+  if (mapping != NULL)
+    munmap(mapping, mappingLength);
+#endif
+}
+
+template<typename eT>
+arma::Mat<eT> MappedMatrix<eT>::Matrix() const
+{
+  if (memptr == NULL)
+    return arma::Mat<eT>(rows, cols);
+
+  // Use the auxiliary memory directly (no copy).  The matrix is not marked as
+  // strict, because Armadillo only transfers non-strict auxiliary memory when
+  // a matrix is moved; otherwise moving it into a tree would make a copy.
+  return arma::Mat<eT>(memptr, rows, cols, false, false);
+}
+
+template<typename eT>
+void MappedMatrix<eT>::Sync()
+{
+#ifndef _WIN32
+  if (mapping != NULL && writable)
+    msync(mapping, mappingLength, MS_SYNC);
+#endif
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
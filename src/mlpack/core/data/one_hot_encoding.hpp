@@ -47,12 +47,34 @@ void OneHotEncoding(const arma::Mat<eT>& input,
                     const arma::Col<size_t>& indices,
                     arma::Mat<eT>& output);
 
+/**
+ * Overloaded function for the above function, which takes a matrix as input
+ * and also a vector of indices to encode and outputs a sparse matrix.  Since
+ * each encoded point has a single non-zero value for each encoded dimension,
+ * this uses much less memory than the dense output when dimensions have many
+ * categories.
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param output Encoded sparse matrix.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::SpMat<eT>& output);
+
 /**
  * Overloaded function for the above function, which takes a matrix as input
  * and also a DatasetInfo object and outputs a matrix.
  * This function encodes all the dimensions marked `Datatype::categorical`
  * in the data::DatasetInfo.
  *
+ * The values of categorical dimensions must be the categories mapped by the
+ * DatasetInfo (as given by data::Load()), and each categorical dimension takes
+ * NumMappings() dimensions of the output.  The layout of the output therefore
+ * only depends on the DatasetInfo, so a large dataset can be encoded in chunks
+ * of points, and the chunks will be consistent with each other.
+ *
  * @param input Input dataset to be encoded.
  * @param output Encoded matrix.
  * @param datasetInfo DatasetInfo object that has information about data.
@@ -62,6 +84,19 @@ void OneHotEncoding(const arma::Mat<eT>& input,
                     arma::Mat<eT>& output,
                     const data::DatasetInfo& datasetInfo);
 
+/**
+ * Overloaded function for the above function, which takes a matrix as input
+ * and also a DatasetInfo object and outputs a sparse matrix.
+ *
+ * @param input Input dataset to be encoded.
+ * @param output Encoded sparse matrix.
+ * @param datasetInfo DatasetInfo object that has information about data.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    arma::SpMat<eT>& output,
+                    const data::DatasetInfo& datasetInfo);
+
 } // namespace data
 } // namespace mlpack
 
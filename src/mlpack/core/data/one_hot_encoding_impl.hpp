@@ -66,38 +66,35 @@ void OneHotEncoding(const RowType& labelsIn,
 }
 
 /**
- * Overloaded function for the above function, which takes a matrix as input
- * and also a vector of indices to encode and outputs a matrix.
- * Indices represent the IDs of the dimensions to be one-hot encoded.
+ * Compute the mappings from the values of the dimensions to be one-hot encoded
+ * to the index of the dimension they take in the encoded matrix, and the
+ * offset of each input dimension in the encoded matrix.  This is used by the
+ * OneHotEncoding() overloads that take a vector of indices.
  *
  * @param input Input dataset to be encoded.
  * @param indices Index of rows to be encoded.
- * @param output Encoded matrix.
+ * @param mappings Mappings for each dimension to be encoded.
+ * @param dimensionOffsets Offset of each dimension; the last element is the
+ *     total number of dimensions.
  */
 template<typename eT>
-void OneHotEncoding(const arma::Mat<eT>& input,
-                    const arma::Col<size_t>& indices,
-                    arma::Mat<eT>& output)
+void OneHotEncodingMappings(
+    const arma::Mat<eT>& input,
+    const arma::Col<size_t>& indices,
+    std::unordered_map<size_t, std::unordered_map<eT, size_t>>& mappings,
+    arma::Col<size_t>& dimensionOffsets)
 {
-  // Handle the edge case where there is nothing to encode.
-  if (indices.n_elem == 0)
-  {
-    output = input;
-    return;
-  }
-
-  // First, we need to compute the size of the output matrix.
-
   // This vector will eventually hold the offsets for each dimension in the
   // one-hot encoded matrix, but first it will just hold the counts of
   // dimensions for each dimension.
-  arma::Col<size_t> dimensionOffsets(input.n_rows, arma::fill::ones);
+  dimensionOffsets.ones(input.n_rows + 1);
+  dimensionOffsets[0] = 0;
   // This will hold the mappings from a value that should be one-hot encoded to
   // the index of the dimension it should take.
-  std::unordered_map<size_t, std::unordered_map<eT, size_t>> mappings;
+  mappings.clear();
   for (size_t i = 0; i < indices.n_elem; ++i)
   {
-    dimensionOffsets[indices[i]] = 0;
+    dimensionOffsets[indices[i] + 1] = 0;
     mappings.insert(
         std::make_pair(indices[i], std::unordered_map<eT, size_t>()));
   }
@@ -110,26 +107,53 @@ void OneHotEncoding(const arma::Mat<eT>& input,
       {
         // We have to one-hot encode this point.
         if (mappings[row].count(input(row, col)) == 0)
-          mappings[row][input(row, col)] = dimensionOffsets[row]++;
+          mappings[row][input(row, col)] = dimensionOffsets[row + 1]++;
       }
     }
   }
 
-  // Turn the dimension counts into offsets.  Note that the last element is the
-  // total number of dimensions, and the first element is the offset for
-  // dimension *2* (not 1).
+  // Turn the dimension counts into offsets.  The first element is the offset
+  // of the first dimension (zero), and the last element is the total number of
+  // dimensions.
   for (size_t i = 1; i < dimensionOffsets.n_elem; ++i)
     dimensionOffsets[i] += dimensionOffsets[i - 1];
+}
+
+/**
+ * Overloaded function for the above function, which takes a matrix as input
+ * and also a vector of indices to encode and outputs a matrix.
+ * Indices represent the IDs of the dimensions to be one-hot encoded.
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param output Encoded matrix.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::Mat<eT>& output)
+{
+  // Handle the edge case where there is nothing to encode.
+  if (indices.n_elem == 0)
+  {
+    output = input;
+    return;
+  }
+
+  // First, we need to compute the size of the output matrix.
+  std::unordered_map<size_t, std::unordered_map<eT, size_t>> mappings;
+  arma::Col<size_t> dimensionOffsets;
+  OneHotEncodingMappings(input, indices, mappings, dimensionOffsets);
 
   // Now, initialize the output matrix to the right size.
-  output.zeros(dimensionOffsets[dimensionOffsets.n_elem - 1], input.n_cols);
+  output.zeros(dimensionOffsets[input.n_rows], input.n_cols);
 
   // Finally, one-hot encode the matrix.
   for (size_t col = 0; col < input.n_cols; ++col)
   {
     for (size_t row = 0; row < input.n_rows; ++row)
     {
-      const size_t dimOffset = (row == 0) ? 0 : dimensionOffsets[row - 1];
+      const size_t dimOffset = dimensionOffsets[row];
       if (mappings.count(row) != 0)
       {
         output(dimOffset + mappings[row][input(row, col)], col) = eT(1);
@@ -143,6 +167,99 @@ void OneHotEncoding(const arma::Mat<eT>& input,
   }
 }
 
+/**
+ * Overloaded function for the above function, which takes a matrix as input
+ * and also a vector of indices to encode and outputs a sparse matrix.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::SpMat<eT>& output)
+{
+  std::unordered_map<size_t, std::unordered_map<eT, size_t>> mappings;
+  arma::Col<size_t> dimensionOffsets;
+  OneHotEncodingMappings(input, indices, mappings, dimensionOffsets);
+
+  // Collect the non-zero values in column-major order, so that the locations
+  // are already sorted.
+  arma::umat locations(2, input.n_elem);
+  arma::Col<eT> values(input.n_elem);
+  size_t nonZeros = 0;
+  for (size_t col = 0; col < input.n_cols; ++col)
+  {
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      if (mappings.count(row) != 0)
+      {
+        locations(0, nonZeros) = dimensionOffsets[row] +
+            mappings[row][input(row, col)];
+        values[nonZeros] = eT(1);
+      }
+      else if (input(row, col) != eT(0))
+      {
+        locations(0, nonZeros) = dimensionOffsets[row];
+        values[nonZeros] = input(row, col);
+      }
+      else
+      {
+        continue;
+      }
+
+      locations(1, nonZeros) = col;
+      ++nonZeros;
+    }
+  }
+
+  output = arma::SpMat<eT>(locations.head_cols(nonZeros),
+      values.head(nonZeros), dimensionOffsets[input.n_rows], input.n_cols,
+      false, false);
+}
+
+/**
+ * Compute the offset of each dimension of the input in the one-hot encoded
+ * matrix, where each categorical dimension takes as many dimensions as it has
+ * mappings in the given DatasetInfo.
+ *
+ * @param datasetInfo DatasetInfo object that has information about data.
+ * @param dimensionOffsets Offset of each dimension; the last element is the
+ *     total number of dimensions.
+ */
+inline void OneHotEncodingOffsets(const data::DatasetInfo& datasetInfo,
+                                  arma::Col<size_t>& dimensionOffsets)
+{
+  dimensionOffsets.set_size(datasetInfo.Dimensionality() + 1);
+  dimensionOffsets[0] = 0;
+  for (size_t i = 0; i < datasetInfo.Dimensionality(); ++i)
+  {
+    dimensionOffsets[i + 1] = dimensionOffsets[i] +
+        ((datasetInfo.Type(i) == data::Datatype::categorical) ?
+        datasetInfo.NumMappings(i) : 1);
+  }
+}
+
+/**
+ * Get the category of the given value of a categorical dimension, which is the
+ * value mapped by the DatasetInfo, and check that it is valid.
+ */
+template<typename eT>
+size_t OneHotEncodingCategory(const eT value,
+                              const size_t dimension,
+                              const data::DatasetInfo& datasetInfo)
+{
+  const double category = (double) value;
+  if (category < 0.0 || std::floor(category) != category ||
+      category >= (double) datasetInfo.NumMappings(dimension))
+  {
+    std::ostringstream oss;
+    oss << "OneHotEncoding(): value " << value << " of categorical dimension "
+        << dimension << " is not one of the " << datasetInfo.NumMappings(
+        dimension) << " mapped categories of the given DatasetInfo";
+    throw std::invalid_argument(oss.str());
+  }
+
+  return (size_t) category;
+}
+
 /**
  * Overloaded function for the above function, which takes a matrix as input
  * and also a DatasetInfo object and outputs a matrix.
@@ -158,15 +275,72 @@ void OneHotEncoding(const arma::Mat<eT>& input,
                     arma::Mat<eT>& output,
                     const data::DatasetInfo& datasetInfo)
 {
-  std::vector<size_t> indices;
-  for (size_t i = 0; i < datasetInfo.Dimensionality(); ++i)
+  arma::Col<size_t> dimensionOffsets;
+  OneHotEncodingOffsets(datasetInfo, dimensionOffsets);
+
+  output.zeros(dimensionOffsets[input.n_rows], input.n_cols);
+  for (size_t col = 0; col < input.n_cols; ++col)
   {
-    if (datasetInfo.Type(i) == data::Datatype::categorical)
+    for (size_t row = 0; row < input.n_rows; ++row)
     {
-      indices.push_back(i);
+      if (datasetInfo.Type(row) == data::Datatype::categorical)
+      {
+        output(dimensionOffsets[row] + OneHotEncodingCategory(input(row, col),
+            row, datasetInfo), col) = eT(1);
+      }
+      else
+      {
+        output(dimensionOffsets[row], col) = input(row, col);
+      }
+    }
+  }
+}
+
+/**
+ * Overloaded function for the above function, which takes a matrix as input
+ * and also a DatasetInfo object and outputs a sparse matrix.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    arma::SpMat<eT>& output,
+                    const data::DatasetInfo& datasetInfo)
+{
+  arma::Col<size_t> dimensionOffsets;
+  OneHotEncodingOffsets(datasetInfo, dimensionOffsets);
+
+  // Collect the non-zero values in column-major order, so that the locations
+  // are already sorted.
+  arma::umat locations(2, input.n_elem);
+  arma::Col<eT> values(input.n_elem);
+  size_t nonZeros = 0;
+  for (size_t col = 0; col < input.n_cols; ++col)
+  {
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      if (datasetInfo.Type(row) == data::Datatype::categorical)
+      {
+        locations(0, nonZeros) = dimensionOffsets[row] +
+            OneHotEncodingCategory(input(row, col), row, datasetInfo);
+        values[nonZeros] = eT(1);
+      }
+      else if (input(row, col) != eT(0))
+      {
+        locations(0, nonZeros) = dimensionOffsets[row];
+        values[nonZeros] = input(row, col);
+      }
+      else
+      {
+        continue;
+      }
+
+      locations(1, nonZeros) = col;
+      ++nonZeros;
     }
   }
-  OneHotEncoding(input, arma::Col<size_t>(indices), output);
+
+  output = arma::SpMat<eT>(locations.head_cols(nonZeros),
+      values.head(nonZeros), dimensionOffsets[input.n_rows], input.n_cols,
+      false, false);
 }
 
 } // namespace data
@@ -108,9 +108,12 @@ bool Save(const std::string& filename,
  *  - json, denoted by .json
  *  - xml, denoted by .xml
  *  - binary, denoted by .bin
+ *  - blob, denoted by .blob: binary, with the large matrices stored as aligned
+ *    blocks that are read in one piece (see LoadMapped() to memory-map them)
  *
  * The format parameter can take any of the values in the 'format' enum:
- * 'format::autodetect', 'format::json', 'format::xml', and 'format::binary'.
+ * 'format::autodetect', 'format::json', 'format::xml', 'format::binary', and
+ * 'format::blob'.
  * The autodetect functionality operates on the file extension (so, "file.txt"
  * would be autodetected as text).
  *
@@ -16,6 +16,7 @@
 #include "save.hpp"
 #include "extension.hpp"
 #include "detect_file_type.hpp"
+#include "blob_model.hpp"
 
 #include <cereal/archives/xml.hpp>
 #include <cereal/archives/json.hpp>
@@ -277,14 +278,16 @@ bool Save(const std::string& filename,
       f = format::binary;
     else if (extension == "json")
       f = format::json;
+    else if (extension == "blob")
+      f = format::blob;
     else
     {
       if (fatal)
         Log::Fatal << "Unable to detect type of '" << filename << "'; incorrect"
-            << " extension? (allowed: xml/bin/json)" << std::endl;
+            << " extension? (allowed: xml/bin/json/blob)" << std::endl;
       else
         Log::Warn << "Unable to detect type of '" << filename << "'; save "
-            << "failed.  Incorrect extension? (allowed: xml/bin/json)"
+            << "failed.  Incorrect extension? (allowed: xml/bin/json/blob)"
             << std::endl;
 
       return false;
@@ -294,7 +297,8 @@ bool Save(const std::string& filename,
   // Open the file to save to.
   std::ofstream ofs;
 #ifdef _WIN32
-  if (f == format::binary) // Open non-text types in binary mode on Windows.
+  // Open non-text types in binary mode on Windows.
+  if (f == format::binary || f == format::blob)
     ofs.open(filename, std::ofstream::out | std::ofstream::binary);
   else
     ofs.open(filename, std::ofstream::out);
@@ -331,6 +335,10 @@ bool Save(const std::string& filename,
       cereal::BinaryOutputArchive ar(ofs);
       ar(cereal::make_nvp(name.c_str(), t));
     }
+    else if (f == format::blob)
+    {
+      SaveBlobModel(ofs, name, t);
+    }
 
     return true;
   }
@@ -42,6 +42,10 @@ namespace data {
  * // Retransform the input.
  * scale.InverseTransform(output, input);
  * @endcode
+ *
+ * The scaler can also be fit on a dataset that arrives in chunks with
+ * PartialFit(), and scalers fit on different parts of a dataset can be
+ * combined with Merge().
  */
 class MaxAbsScaler
 {
@@ -56,14 +60,65 @@ class MaxAbsScaler
   {
     itemMin = arma::min(input, 1);
     itemMax = arma::max(input, 1);
-    scale = arma::max(arma::abs(itemMin), arma::abs(itemMax));
-    // Handling zeros in scale vector.
-    scale.for_each([](arma::vec::elem_type& val) { val =
-        (val == 0) ? 1 : val; });
+    UpdateScale();
   }
 
   /**
-   * Function to scale features.
+   * Update the minimum and maximum with the points of the given chunk, as if
+   * all the points given to PartialFit() since the last call to Fit() had been
+   * given to Fit() at once.
+   *
+   * @param input Chunk of the dataset to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    if (input.n_cols == 0)
+      return;
+
+    MaxAbsScaler chunk;
+    chunk.itemMin = arma::min(input, 1);
+    chunk.itemMax = arma::max(input, 1);
+    Merge(chunk);
+  }
+
+  /**
+   * Merge the minimum and maximum of another scaler into this one, as if the
+   * points it was fit on had been given to PartialFit().
+   *
+   * @param other Scaler to merge.
+   */
+  void Merge(const MaxAbsScaler& other)
+  {
+    if (other.itemMin.is_empty())
+      return;
+
+    if (itemMin.is_empty())
+    {
+      itemMin = other.itemMin;
+      itemMax = other.itemMax;
+    }
+    else
+    {
+      if (other.itemMin.n_elem != itemMin.n_elem)
+      {
+        std::ostringstream oss;
+        oss << "MaxAbsScaler::Merge(): dimensionality of the points ("
+            << other.itemMin.n_elem << ") does not match the fit points ("
+            << itemMin.n_elem << ")";
+        throw std::invalid_argument(oss.str());
+      }
+
+      itemMin = arma::min(itemMin, other.itemMin);
+      itemMax = arma::max(itemMax, other.itemMax);
+    }
+
+    UpdateScale();
+  }
+
+  /**
+   * Function to scale features.  The input and output may be the same
+   * matrix, in which case the features are scaled in place.
    *
    * @param input Dataset to scale features.
    * @param output Output matrix with scaled features.
@@ -76,12 +131,14 @@ class MaxAbsScaler
       throw std::runtime_error("Call Fit() before Transform(), please"
         " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = input.each_col() / scale;
+    if (&output != &input)
+      output = input;
+    output.each_col() /= scale;
   }
 
   /**
-   * Function to retrieve original dataset.
+   * Function to retrieve original dataset.  The input and output may be the
+   * same matrix, in which case the dataset is retrieved in place.
    *
    * @param input Scaled dataset.
    * @param output Output matrix with original Dataset.
@@ -89,8 +146,9 @@ class MaxAbsScaler
   template<typename MatType>
   void InverseTransform(const MatType& input, MatType& output)
   {
-    output.copy_size(input);
-    output = input.each_col() % scale;
+    if (&output != &input)
+      output = input;
+    output.each_col() %= scale;
   }
 
   //! Get the Min row vector.
@@ -108,6 +166,15 @@ class MaxAbsScaler
     ar(CEREAL_NVP(scale));
   }
  private:
+  //! Compute the scale from the minimum and maximum of each feature.
+  void UpdateScale()
+  {
+    scale = arma::max(arma::abs(itemMin), arma::abs(itemMax));
+    // Handling zeros in scale vector.
+    scale.for_each([](arma::vec::elem_type& val) { val =
+        (val == 0) ? 1 : val; });
+  }
+
   // Vector which holds minimum of each feature.
   arma::vec itemMin;
   // Vector which holds maximum of each feature.
@@ -42,10 +42,18 @@ namespace data {
  * // Retransform the input.
  * scale.InverseTransform(output, input);
  * @endcode
+ *
+ * The scaler can also be fit on a dataset that arrives in chunks with
+ * PartialFit(), and scalers fit on different parts of a dataset can be
+ * combined with Merge(); the means are combined weighted by the number of
+ * points.
  */
 class MeanNormalization
 {
  public:
+  //! Create a scaler that is not fit yet.
+  MeanNormalization() : itemCount(0) { }
+
   /**
    * Function to fit features, to find out the min max and scale.
    *
@@ -54,17 +62,83 @@ class MeanNormalization
   template<typename MatType>
   void Fit(const MatType& input)
   {
+    itemCount = input.n_cols;
     itemMean = arma::mean(input, 1);
     itemMin = arma::min(input, 1);
     itemMax = arma::max(input, 1);
-    scale = itemMax - itemMin;
-    // Handling zeros in scale vector.
-    scale.for_each([](arma::vec::elem_type& val) { val =
-        (val == 0) ? 1 : val; });
+    UpdateScale();
+  }
+
+  /**
+   * Update the mean, minimum and maximum with the points of the given chunk,
+   * as if all the points given to PartialFit() since the last call to Fit()
+   * had been given to Fit() at once.
+   *
+   * @param input Chunk of the dataset to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    if (input.n_cols == 0)
+      return;
+
+    MeanNormalization chunk;
+    chunk.itemCount = input.n_cols;
+    chunk.itemMean = arma::mean(input, 1);
+    chunk.itemMin = arma::min(input, 1);
+    chunk.itemMax = arma::max(input, 1);
+    Merge(chunk);
+  }
+
+  /**
+   * Merge the statistics of another scaler into this one, as if the points it
+   * was fit on had been given to PartialFit().
+   *
+   * @param other Scaler to merge.
+   */
+  void Merge(const MeanNormalization& other)
+  {
+    if ((itemCount == 0 && !itemMean.is_empty()) ||
+        (other.itemCount == 0 && !other.itemMean.is_empty()))
+    {
+      throw std::runtime_error("MeanNormalization::Merge(): a scaler loaded "
+          "from a model saved without its point count cannot be merged; call "
+          "Fit() instead");
+    }
+    if (other.itemCount == 0)
+      return;
+
+    if (itemCount == 0)
+    {
+      itemCount = other.itemCount;
+      itemMean = other.itemMean;
+      itemMin = other.itemMin;
+      itemMax = other.itemMax;
+    }
+    else
+    {
+      if (other.itemMean.n_elem != itemMean.n_elem)
+      {
+        std::ostringstream oss;
+        oss << "MeanNormalization::Merge(): dimensionality of the points ("
+            << other.itemMean.n_elem << ") does not match the fit points ("
+            << itemMean.n_elem << ")";
+        throw std::invalid_argument(oss.str());
+      }
+
+      const double count = itemCount + other.itemCount;
+      itemMean += (other.itemMean - itemMean) * (other.itemCount / count);
+      itemMin = arma::min(itemMin, other.itemMin);
+      itemMax = arma::max(itemMax, other.itemMax);
+      itemCount += other.itemCount;
+    }
+
+    UpdateScale();
   }
 
   /**
-   * Function to scale features.
+   * Function to scale features.  The input and output may be the same
+   * matrix, in which case the features are scaled in place.
    *
    * @param input Dataset to scale features.
    * @param output Output matrix with scaled features.
@@ -77,12 +151,15 @@ class MeanNormalization
       throw std::runtime_error("Call Fit() before Transform(), please"
         " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = (input.each_col() - itemMean).each_col() / scale;
+    if (&output != &input)
+      output = input;
+    output.each_col() -= itemMean;
+    output.each_col() /= scale;
   }
 
   /**
-   * Function to retrieve original dataset.
+   * Function to retrieve original dataset.  The input and output may be the
+   * same matrix, in which case the dataset is retrieved in place.
    *
    * @param input Scaled dataset.
    * @param output Output matrix with original Dataset.
@@ -90,8 +167,10 @@ class MeanNormalization
   template<typename MatType>
   void InverseTransform(const MatType& input, MatType& output)
   {
-    output.copy_size(input);
-    output = (input.each_col() % scale).each_col() + itemMean;
+    if (&output != &input)
+      output = input;
+    output.each_col() %= scale;
+    output.each_col() += itemMean;
   }
 
   //! Get the Mean row vector.
@@ -102,17 +181,36 @@ class MeanNormalization
   const arma::vec& ItemMax() const { return itemMax; }
   //! Get the Scale row vector.
   const arma::vec& Scale() const { return scale; }
+  //! Get the number of points the scaler was fit on.
+  size_t ItemCount() const { return itemCount; }
 
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */)
+  void serialize(Archive& ar, const uint32_t version)
   {
     ar(CEREAL_NVP(itemMin));
     ar(CEREAL_NVP(itemMax));
     ar(CEREAL_NVP(scale));
     ar(CEREAL_NVP(itemMean));
+
+    // Models saved before PartialFit() was added cannot be updated.
+    if (version >= 1)
+      ar(CEREAL_NVP(itemCount));
+    else if (cereal::is_loading<Archive>())
+      itemCount = 0;
   }
 
  private:
+  //! Compute the scale from the minimum and maximum of each feature.
+  void UpdateScale()
+  {
+    scale = itemMax - itemMin;
+    // Handling zeros in scale vector.
+    scale.for_each([](arma::vec::elem_type& val) { val =
+        (val == 0) ? 1 : val; });
+  }
+
+  // Number of points the scaler was fit on.
+  size_t itemCount;
   // Vector which holds mean of each feature.
   arma::vec itemMean;
   // Vector which holds minimum of each feature.
@@ -126,4 +224,7 @@ class MeanNormalization
 } // namespace data
 } // namespace mlpack
 
+//! Version 1 added the point count needed by PartialFit().
+CEREAL_CLASS_VERSION(mlpack::data::MeanNormalization, 1);
+
 #endif
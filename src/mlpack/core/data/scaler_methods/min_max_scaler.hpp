@@ -44,6 +44,10 @@ namespace data {
  * // Retransform the input.
  * scale.InverseTransform(output, input);
  * @endcode
+ *
+ * The scaler can also be fit on a dataset that arrives in chunks with
+ * PartialFit(), and scalers fit on different parts of a dataset can be
+ * combined with Merge().
  */
 class MinMaxScaler
 {
@@ -75,18 +79,66 @@ class MinMaxScaler
   {
     itemMin = arma::min(input, 1);
     itemMax = arma::max(input, 1);
-    scale = itemMax - itemMin;
-    // Handle zeros in scale vector.
-    scale.for_each([](arma::vec::elem_type& val) { val =
-        (val == 0) ? 1 : val; });
-    scale = (scaleMax - scaleMin) / scale;
-    scalerowmin.copy_size(itemMin);
-    scalerowmin.fill(scaleMin);
-    scalerowmin = scalerowmin - itemMin % scale;
+    UpdateScale();
   }
 
   /**
-   * Function to scale features.
+   * Update the minimum and maximum with the points of the given chunk, as if
+   * all the points given to PartialFit() since the last call to Fit() had been
+   * given to Fit() at once.
+   *
+   * @param input Chunk of the dataset to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    if (input.n_cols == 0)
+      return;
+
+    MinMaxScaler chunk(scaleMin, scaleMax);
+    chunk.itemMin = arma::min(input, 1);
+    chunk.itemMax = arma::max(input, 1);
+    Merge(chunk);
+  }
+
+  /**
+   * Merge the minimum and maximum of another scaler into this one, as if the
+   * points it was fit on had been given to PartialFit().  The range of this
+   * scaler is kept.
+   *
+   * @param other Scaler to merge.
+   */
+  void Merge(const MinMaxScaler& other)
+  {
+    if (other.itemMin.is_empty())
+      return;
+
+    if (itemMin.is_empty())
+    {
+      itemMin = other.itemMin;
+      itemMax = other.itemMax;
+    }
+    else
+    {
+      if (other.itemMin.n_elem != itemMin.n_elem)
+      {
+        std::ostringstream oss;
+        oss << "MinMaxScaler::Merge(): dimensionality of the points ("
+            << other.itemMin.n_elem << ") does not match the fit points ("
+            << itemMin.n_elem << ")";
+        throw std::invalid_argument(oss.str());
+      }
+
+      itemMin = arma::min(itemMin, other.itemMin);
+      itemMax = arma::max(itemMax, other.itemMax);
+    }
+
+    UpdateScale();
+  }
+
+  /**
+   * Function to scale features.  The input and output may be the same
+   * matrix, in which case the features are scaled in place.
    *
    * @param input Dataset to scale features.
    * @param output Output matrix with scaled features.
@@ -99,12 +151,15 @@ class MinMaxScaler
       throw std::runtime_error("Call Fit() before Transform(), please"
           " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = (input.each_col() % scale).each_col() + scalerowmin;
+    if (&output != &input)
+      output = input;
+    output.each_col() %= scale;
+    output.each_col() += scalerowmin;
   }
 
   /**
-   * Function to retrieve original dataset.
+   * Function to retrieve original dataset.  The input and output may be the
+   * same matrix, in which case the dataset is retrieved in place.
    *
    * @param input Scaled dataset.
    * @param output Output matrix with original Dataset.
@@ -112,8 +167,10 @@ class MinMaxScaler
   template<typename MatType>
   void InverseTransform(const MatType& input, MatType& output)
   {
-    output.copy_size(input);
-    output = (input.each_col() - scalerowmin).each_col() / scale;
+    if (&output != &input)
+      output = input;
+    output.each_col() -= scalerowmin;
+    output.each_col() /= scale;
   }
 
   //! Get the Min row vector.
@@ -139,6 +196,19 @@ class MinMaxScaler
   }
 
  private:
+  //! Compute the scale from the minimum and maximum of each feature.
+  void UpdateScale()
+  {
+    scale = itemMax - itemMin;
+    // Handle zeros in scale vector.
+    scale.for_each([](arma::vec::elem_type& val) { val =
+        (val == 0) ? 1 : val; });
+    scale = (scaleMax - scaleMin) / scale;
+    scalerowmin.copy_size(itemMin);
+    scalerowmin.fill(scaleMin);
+    scalerowmin = scalerowmin - itemMin % scale;
+  }
+
   // Vector which holds minimum of each feature.
   arma::vec itemMin;
   // Vector which holds maximum of each feature.
@@ -71,14 +71,29 @@ class PCAWhitening
   void Fit(const MatType& input)
   {
     itemMean = arma::mean(input, 1);
+
+    // Accumulate the covariance over blocks of centered columns, so that no
+    // centered copy of the whole input is needed.
+    const size_t blockSize = 4096;
+    arma::mat covariance(input.n_rows, input.n_rows, arma::fill::zeros);
+    for (size_t begin = 0; begin < input.n_cols; begin += blockSize)
+    {
+      const size_t end = std::min(begin + blockSize, (size_t) input.n_cols);
+      arma::mat block = input.cols(begin, end - 1);
+      block.each_col() -= itemMean;
+      covariance += block * block.t();
+    }
+    covariance /= (input.n_cols > 1) ? (input.n_cols - 1) : 1;
+
     // Get eigenvectors and eigenvalues of covariance of input matrix.
-    eig_sym(eigenValues, eigenVectors, mlpack::math::ColumnCovariance(
-        input.each_col() - itemMean));
+    eig_sym(eigenValues, eigenVectors, covariance);
     eigenValues += epsilon;
   }
 
   /**
-   * Function for PCA whitening.
+   * Function for PCA whitening.  The input and output may be the same matrix,
+   * in which case the features are whitened in place, one block of points at
+   * a time.
    *
    * @param input Dataset to scale features.
    * @param output Output matrix with whitened features.
@@ -91,10 +106,11 @@ class PCAWhitening
       throw std::runtime_error("Call Fit() before Transform(), please"
           " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = (input.each_col() - itemMean);
-    output = arma::diagmat(1.0 / (arma::sqrt(eigenValues))) * eigenVectors.t()
-        * output;
+    if (&output != &input)
+      output = input;
+    output.each_col() -= itemMean;
+    math::MultiplyInPlace(arma::mat(arma::diagmat(1.0 /
+        arma::sqrt(eigenValues)) * eigenVectors.t()), output);
   }
 
   /**
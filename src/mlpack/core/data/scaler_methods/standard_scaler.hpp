@@ -43,27 +43,110 @@ namespace data {
  * // Retransform the input.
  * scale.InverseTransform(output, input);
  * @endcode
+ *
+ * The scaler can also be fit on a dataset that arrives in chunks, with
+ * PartialFit(); the mean and variance of each chunk are merged into the
+ * running ones with the pairwise update of Chan et al., so the result is the
+ * same as fitting all the points at once.  Scalers fit on different parts of a
+ * dataset (for instance by different threads) can be combined with Merge().
+ *
+ * @code
+ * StandardScaler scale;
+ * while (ReadChunk(chunk)) // Some way of reading the data.
+ *   scale.PartialFit(chunk);
+ * @endcode
  */
 class StandardScaler
 {
  public:
+  //! Create a scaler that is not fit yet.
+  StandardScaler() : itemCount(0) { }
+
   /**
-   * Function to fit features, to find out the min max and scale.
+   * Function to fit features, to find out the mean and standard deviation.
    *
    * @param input Dataset to fit.
    */
   template<typename MatType>
   void Fit(const MatType& input)
   {
-    itemMean = arma::mean(input, 1);
-    itemStdDev = arma::stddev(input, 1, 1);
+    itemCount = 0;
+    itemMean.reset();
+    PartialFit(input);
+  }
+
+  /**
+   * Update the mean and standard deviation with the points of the given chunk,
+   * as if all the points given to PartialFit() since the last call to Fit()
+   * had been given to Fit() at once.
+   *
+   * @param input Chunk of the dataset to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    if (input.n_cols == 0)
+      return;
+
+    StandardScaler chunk;
+    chunk.itemCount = input.n_cols;
+    chunk.itemMean = arma::mean(input, 1);
+    chunk.itemSquaredDeviations = arma::var(input, 1, 1) * input.n_cols;
+    Merge(chunk);
+  }
+
+  /**
+   * Merge the statistics of another scaler into this one, as if the points it
+   * was fit on had been given to PartialFit().
+   *
+   * @param other Scaler to merge.
+   */
+  void Merge(const StandardScaler& other)
+  {
+    if ((itemCount == 0 && !itemMean.is_empty()) ||
+        (other.itemCount == 0 && !other.itemMean.is_empty()))
+    {
+      throw std::runtime_error("StandardScaler::Merge(): a scaler loaded from "
+          "a model saved without its point count cannot be merged; call Fit() "
+          "instead");
+    }
+    if (other.itemCount == 0)
+      return;
+
+    if (itemCount == 0)
+    {
+      itemCount = other.itemCount;
+      itemMean = other.itemMean;
+      itemSquaredDeviations = other.itemSquaredDeviations;
+    }
+    else
+    {
+      if (other.itemMean.n_elem != itemMean.n_elem)
+      {
+        std::ostringstream oss;
+        oss << "StandardScaler::Merge(): dimensionality of the points ("
+            << other.itemMean.n_elem << ") does not match the fit points ("
+            << itemMean.n_elem << ")";
+        throw std::invalid_argument(oss.str());
+      }
+
+      const double count = itemCount + other.itemCount;
+      const arma::vec delta = other.itemMean - itemMean;
+      itemMean += delta * (other.itemCount / count);
+      itemSquaredDeviations += other.itemSquaredDeviations +
+          arma::square(delta) * (itemCount * (other.itemCount / count));
+      itemCount += other.itemCount;
+    }
+
+    itemStdDev = arma::sqrt(itemSquaredDeviations / itemCount);
     // Handle zeros in scale vector.
     itemStdDev.for_each([](arma::vec::elem_type& val) { val =
         (val == 0) ? 1 : val; });
   }
 
   /**
-   * Function to scale features.
+   * Function to scale features.  The input and output may be the same
+   * matrix, in which case the features are scaled in place.
    *
    * @param input Dataset to scale features.
    * @param output Output matrix with scaled features.
@@ -76,12 +159,15 @@ class StandardScaler
       throw std::runtime_error("Call Fit() before Transform(), please"
         " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = (input.each_col() - itemMean).each_col() / itemStdDev;
+    if (&output != &input)
+      output = input;
+    output.each_col() -= itemMean;
+    output.each_col() /= itemStdDev;
   }
 
   /**
-   * Function to retrieve original dataset.
+   * Function to retrieve original dataset.  The input and output may be the
+   * same matrix, in which case the dataset is retrieved in place.
    *
    * @param input Scaled dataset.
    * @param output Output matrix with original Dataset.
@@ -89,20 +175,36 @@ class StandardScaler
   template<typename MatType>
   void InverseTransform(const MatType& input, MatType& output)
   {
-    output.copy_size(input);
-    output = (input.each_col() % itemStdDev).each_col() + itemMean;
+    if (&output != &input)
+      output = input;
+    output.each_col() %= itemStdDev;
+    output.each_col() += itemMean;
   }
 
   //! Get the mean row vector.
   const arma::vec& ItemMean() const { return itemMean; }
   //! Get the standard deviation row vector.
   const arma::vec& ItemStdDev() const { return itemStdDev; }
+  //! Get the number of points the scaler was fit on.
+  size_t ItemCount() const { return itemCount; }
 
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */)
+  void serialize(Archive& ar, const uint32_t version)
   {
     ar(CEREAL_NVP(itemMean));
     ar(CEREAL_NVP(itemStdDev));
+
+    // Models saved before PartialFit() was added cannot be updated.
+    if (version >= 1)
+    {
+      ar(CEREAL_NVP(itemCount));
+      ar(CEREAL_NVP(itemSquaredDeviations));
+    }
+    else if (cereal::is_loading<Archive>())
+    {
+      itemCount = 0;
+      itemSquaredDeviations.reset();
+    }
   }
 
  private:
@@ -110,9 +212,17 @@ class StandardScaler
   arma::vec itemMean;
   // Vector which holds standard devation of each feature.
   arma::vec itemStdDev;
+  // Number of points the scaler was fit on.
+  size_t itemCount;
+  // Vector which holds the sum of squared deviations from the mean of each
+  // feature.
+  arma::vec itemSquaredDeviations;
 }; // class StandardScaler
 
 } // namespace data
 } // namespace mlpack
 
+//! Version 1 added the statistics needed by PartialFit().
+CEREAL_CLASS_VERSION(mlpack::data::StandardScaler, 1);
+
 #endif
@@ -66,7 +66,9 @@ class ZCAWhitening
   }
 
   /**
-   * Function for ZCA whitening.
+   * Function for ZCA whitening.  The input and output may be the same matrix,
+   * in which case the features are whitened in place, one block of points at
+   * a time.
    *
    * @param input Dataset to scale features.
    * @param output Output matrix with whitened features.
@@ -74,8 +76,19 @@ class ZCAWhitening
   template<typename MatType>
   void Transform(const MatType& input, MatType& output)
   {
-    pca.Transform(input, output);
-    output = pca.EigenVectors() * output;
+    if (pca.EigenValues().is_empty() || pca.EigenVectors().is_empty())
+    {
+      throw std::runtime_error("Call Fit() before Transform(), please"
+          " refer to the documentation.");
+    }
+    if (&output != &input)
+      output = input;
+    output.each_col() -= pca.ItemMean();
+
+    // Rotate back after whitening, as a single transformation.
+    const arma::mat& eigenVectors = pca.EigenVectors();
+    math::MultiplyInPlace(arma::mat(eigenVectors * arma::diagmat(1.0 /
+        arma::sqrt(pca.EigenValues())) * eigenVectors.t()), output);
   }
 
   /**
@@ -0,0 +1,158 @@
+/**
+ * @file core/data/space_filling_curve.hpp
+ *
+ * Functions to reorder the points of a dataset along a space-filling curve
+ * (the Hilbert curve or the Z-order curve), so that points which are close to
+ * each other are also close in memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SPACE_FILLING_CURVE_HPP
+#define MLPACK_CORE_DATA_SPACE_FILLING_CURVE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/address.hpp>
+#include <mlpack/core/tree/rectangle_tree/discrete_hilbert_value.hpp>
+
+namespace mlpack {
+namespace data {
+
+//! The space-filling curves that points can be ordered along.
+enum CurveType
+{
+  //! The Hilbert curve, as used by the Hilbert R tree (DiscreteHilbertValue).
+  HILBERT_CURVE,
+  //! The Z-order (Morton) curve, as used by the UB tree (bound::addr).
+  Z_ORDER_CURVE
+};
+
+/**
+ * Convert the name of a curve ("hilbert" or "z-order") to a CurveType, as
+ * given to the bindings.  An invalid_argument exception is thrown for any other
+ * name.
+ *
+ * @param name Name of the curve.
+ */
+inline CurveType CurveTypeFromString(const std::string& name)
+{
+  if (name == "hilbert")
+    return HILBERT_CURVE;
+  else if (name == "z-order")
+    return Z_ORDER_CURVE;
+
+  throw std::invalid_argument("CurveTypeFromString(): unknown curve '" + name +
+      "'; must be 'hilbert' or 'z-order'!");
+}
+
+/**
+ * Compute the order of the points of the dataset along the given space-filling
+ * curve: the i'th point along the curve is data.col(order[i]).  The position
+ * of each point on the curve is computed from the bits of its coordinates, in
+ * the same way as for the Hilbert R tree or the UB tree, so no scaling of the
+ * data is needed.  Ties keep the original order of the points.
+ *
+ * @param data Dataset (one column per point).
+ * @param order Vector to store the order of the points in.
+ * @param curve Space-filling curve to use.
+ */
+template<typename MatType>
+void SpaceFillingCurveOrder(const MatType& data,
+                            arma::uvec& order,
+                            const CurveType curve = HILBERT_CURVE)
+{
+  typedef typename MatType::elem_type ElemType;
+  typedef typename std::conditional<sizeof(ElemType) * CHAR_BIT <= 32,
+                                    uint32_t,
+                                    uint64_t>::type KeyElemType;
+
+  // Compute the key of every point on the curve; each key is a column of the
+  // matrix, and keys compare lexicographically.
+  arma::Mat<KeyElemType> keys(data.n_rows, data.n_cols);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  {
+    const arma::Col<ElemType> point(data.col(i));
+    if (curve == HILBERT_CURVE)
+    {
+      keys.col(i) =
+          tree::DiscreteHilbertValue<ElemType>::CalculateValue(point);
+    }
+    else
+    {
+      arma::Col<KeyElemType> address(data.n_rows, arma::fill::zeros);
+      bound::addr::PointToAddress(address, point);
+      keys.col(i) = address;
+    }
+  }
+
+  order.set_size(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    order[i] = i;
+
+  const size_t dim = keys.n_rows;
+  std::stable_sort(order.begin(), order.end(),
+      [&](const arma::uword a, const arma::uword b)
+      {
+        const KeyElemType* keyA = keys.colptr(a);
+        const KeyElemType* keyB = keys.colptr(b);
+        return std::lexicographical_compare(keyA, keyA + dim, keyB, keyB + dim);
+      });
+}
+
+/**
+ * Reorder the points of the dataset along the given space-filling curve, so
+ * that algorithms which loop over the points (or build trees on them) access
+ * memory with better locality.  The returned order maps the new columns back
+ * to the old ones: the new column i was column order[i]; results computed for
+ * the reordered points can be put back in the original order with
+ * RestoreOrder().
+ *
+ * @code
+ * arma::uvec order = data::ReorderPoints(dataset);
+ * kmeans.Cluster(dataset, clusters, assignments);
+ * data::RestoreOrder(assignments, order);
+ * @endcode
+ *
+ * @param data Dataset to reorder (one column per point).
+ * @param curve Space-filling curve to use.
+ * @return The order of the original points along the curve.
+ */
+template<typename MatType>
+arma::uvec ReorderPoints(MatType& data, const CurveType curve = HILBERT_CURVE)
+{
+  arma::uvec order;
+  SpaceFillingCurveOrder(data, order, curve);
+  data = data.cols(order);
+  return order;
+}
+
+/**
+ * Put the columns of a matrix (or the elements of a row vector), given in the
+ * order returned by ReorderPoints(), back in the original order of the points.
+ *
+ * @param values Values to reorder (one column per point).
+ * @param order Order returned by ReorderPoints().
+ */
+template<typename MatType>
+void RestoreOrder(MatType& values, const arma::uvec& order)
+{
+  if (values.n_cols != order.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "RestoreOrder(): number of columns (" << values.n_cols << ") does "
+        << "not match size of order (" << order.n_elem << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  MatType restored(values.n_rows, values.n_cols);
+  restored.cols(order) = values;
+  values = std::move(restored);
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
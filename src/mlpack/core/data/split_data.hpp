@@ -62,6 +62,113 @@ void SplitHelper(const InputType& input,
   }
 }
 
+/**
+ * Compute the indices of the points of a training set and a test set, without
+ * copying any data.  The points are split in the same way as Split() with the
+ * same random seed, so `input.cols(trainIndices)` and `input.cols(testIndices)`
+ * are the training and test sets that Split() would return.  This is useful
+ * when the dataset is too large to hold two copies of it in memory: the
+ * indices can be used to gather only the points that are needed, when they
+ * are needed.
+ *
+ * @code
+ * arma::uvec trainIndices, testIndices;
+ * SplitIndices(input.n_cols, trainIndices, testIndices, 0.3);
+ * @endcode
+ *
+ * @param numPoints Number of points in the dataset.
+ * @param trainIndices Vector to store the indices of the training points into.
+ * @param testIndices Vector to store the indices of the test points into.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *     sample is visited in linear order. (Default true.)
+ */
+inline void SplitIndices(const size_t numPoints,
+                         arma::uvec& trainIndices,
+                         arma::uvec& testIndices,
+                         const double testRatio,
+                         const bool shuffleData = true)
+{
+  const size_t testSize = static_cast<size_t>(numPoints * testRatio);
+  const size_t trainSize = numPoints - testSize;
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, numPoints - 1, numPoints);
+  if (shuffleData)
+    order = arma::shuffle(order);
+
+  trainIndices = order.head(trainSize);
+  testIndices = order.tail(testSize);
+}
+
+/**
+ * Compute the indices of the points of a stratified training set and test
+ * set, without copying any data.  The points are split in the same way as
+ * StratifiedSplit() with the same random seed (see StratifiedSplit() for
+ * details and requirements on the labels).
+ *
+ * @param inputLabel Input labels to stratify.
+ * @param trainIndices Vector to store the indices of the training points into.
+ * @param testIndices Vector to store the indices of the test points into.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *     sample is visited in linear order. (Default true.)
+ */
+template<typename LabelsType,
+         typename = std::enable_if_t<arma::is_arma_type<LabelsType>::value> >
+void StratifiedSplitIndices(const LabelsType& inputLabel,
+                            arma::uvec& trainIndices,
+                            arma::uvec& testIndices,
+                            const double testRatio,
+                            const bool shuffleData = true)
+{
+  const bool typeCheck = (arma::is_Row<LabelsType>::value)
+      || (arma::is_Col<LabelsType>::value);
+  if (!typeCheck)
+    throw std::runtime_error("data::Split(): when stratified sampling is done, "
+        "labels must have type `arma::Row<>`!");
+  size_t trainIdx = 0;
+  size_t testIdx = 0;
+  size_t trainSize = 0;
+  size_t testSize = 0;
+  arma::uvec labelCounts;
+  arma::uvec testLabelCounts;
+  typename LabelsType::elem_type maxLabel = inputLabel.max();
+
+  labelCounts.zeros(maxLabel+1);
+  testLabelCounts.zeros(maxLabel+1);
+
+  for (typename LabelsType::elem_type label : inputLabel)
+    ++labelCounts[label];
+
+  for (arma::uword labelCount : labelCounts)
+  {
+    testSize += floor(labelCount * testRatio);
+    trainSize += labelCount - floor(labelCount * testRatio);
+  }
+
+  trainIndices.set_size(trainSize);
+  testIndices.set_size(testSize);
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, inputLabel.n_elem - 1,
+      inputLabel.n_elem);
+  if (shuffleData)
+    order = arma::shuffle(order);
+
+  for (arma::uword i : order)
+  {
+    typename LabelsType::elem_type label = inputLabel[i];
+    if (testLabelCounts[label] < floor(labelCounts[label] * testRatio))
+    {
+      testLabelCounts[label] += 1;
+      testIndices[testIdx++] = i;
+    }
+    else
+    {
+      trainIndices[trainIdx++] = i;
+    }
+  }
+}
+
 /**
  * Given an input dataset and labels, stratify into a training set and test set.
  * It is recommended to have the input labels between the range [0, n) where n
@@ -142,78 +249,26 @@ void StratifiedSplit(const arma::Mat<T>& input,
    * 0
    * 1 1
    */
-  const bool typeCheck = (arma::is_Row<LabelsType>::value)
-      || (arma::is_Col<LabelsType>::value);
-  if (!typeCheck)
-    throw std::runtime_error("data::Split(): when stratified sampling is done, "
-        "labels must have type `arma::Row<>`!");
-  size_t trainIdx = 0;
-  size_t testIdx = 0;
-  size_t trainSize = 0;
-  size_t testSize = 0;
-  arma::uvec labelCounts;
-  arma::uvec testLabelCounts;
-  typename LabelsType::elem_type maxLabel = inputLabel.max();
+  arma::uvec trainIndices;
+  arma::uvec testIndices;
+  StratifiedSplitIndices(inputLabel, trainIndices, testIndices, testRatio,
+      shuffleData);
 
-  labelCounts.zeros(maxLabel+1);
-  testLabelCounts.zeros(maxLabel+1);
+  trainData.set_size(input.n_rows, trainIndices.n_elem);
+  testData.set_size(input.n_rows, testIndices.n_elem);
+  trainLabel.set_size(inputLabel.n_rows, trainIndices.n_elem);
+  testLabel.set_size(inputLabel.n_rows, testIndices.n_elem);
 
-  for (typename LabelsType::elem_type label : inputLabel)
-    ++labelCounts[label];
-
-  for (arma::uword labelCount : labelCounts)
+  for (size_t i = 0; i < trainIndices.n_elem; ++i)
   {
-    testSize += floor(labelCount * testRatio);
-    trainSize += labelCount - floor(labelCount * testRatio);
+    trainData.col(i) = input.col(trainIndices[i]);
+    trainLabel[i] = inputLabel[trainIndices[i]];
   }
 
-  trainData.set_size(input.n_rows, trainSize);
-  testData.set_size(input.n_rows, testSize);
-  trainLabel.set_size(inputLabel.n_rows, trainSize);
-  testLabel.set_size(inputLabel.n_rows, testSize);
-
-  if (shuffleData)
+  for (size_t i = 0; i < testIndices.n_elem; ++i)
   {
-    arma::uvec order = arma::shuffle(
-        arma::linspace<arma::uvec>(0, input.n_cols - 1, input.n_cols));
-
-    for (arma::uword i : order)
-    {
-      typename LabelsType::elem_type label = inputLabel[i];
-      if (testLabelCounts[label] < floor(labelCounts[label] * testRatio))
-      {
-        testLabelCounts[label] += 1;
-        testData.col(testIdx) = input.col(i);
-        testLabel[testIdx] = inputLabel[i];
-        testIdx += 1;
-      }
-      else
-      {
-        trainData.col(trainIdx) = input.col(i);
-        trainLabel[trainIdx] = inputLabel[i];
-        trainIdx += 1;
-      }
-    }
-  }
-  else
-  {
-    for (arma::uword i = 0; i < input.n_cols; i++)
-    {
-      typename LabelsType::elem_type label = inputLabel[i];
-      if (testLabelCounts[label] < floor(labelCounts[label] * testRatio))
-      {
-        testLabelCounts[label] += 1;
-        testData.col(testIdx) = input.col(i);
-        testLabel[testIdx] = inputLabel[i];
-        testIdx += 1;
-      }
-      else
-      {
-        trainData.col(trainIdx) = input.col(i);
-        trainLabel[trainIdx] = inputLabel[i];
-        trainIdx += 1;
-      }
-    }
+    testData.col(i) = input.col(testIndices[i]);
+    testLabel[i] = inputLabel[testIndices[i]];
   }
 }
 
@@ -610,6 +665,115 @@ Split(const FieldType& input,
                          std::move(testData));
 }
 
+/**
+ * Rearrange the columns of the given matrix so that column i holds what was
+ * column order[i] before.  Each column is moved once, following the cycles of
+ * the permutation, so only a single column of extra memory is used.
+ *
+ * @param m Matrix to permute the columns of.
+ * @param order Permutation of the column indices.
+ */
+template<typename eT>
+void PermuteColumns(arma::Mat<eT>& m, const arma::uvec& order)
+{
+  std::vector<bool> visited(order.n_elem, false);
+  arma::Col<eT> first(m.n_rows);
+  for (size_t start = 0; start < order.n_elem; ++start)
+  {
+    if (visited[start])
+      continue;
+
+    first = m.col(start);
+    size_t i = start;
+    while (order[i] != start)
+    {
+      visited[i] = true;
+      m.col(i) = m.col(order[i]);
+      i = order[i];
+    }
+    visited[i] = true;
+    m.col(i) = first;
+  }
+}
+
+/**
+ * Given an input dataset and labels, split into a training set and test set in
+ * place: the columns of the dataset and the labels are rearranged so that the
+ * training points come first, followed by the test points.  The points are
+ * split in the same way as Split() (or StratifiedSplit()) with the same random
+ * seed, but no copy of the dataset is made, so this is suited to datasets
+ * that do not fit in memory twice.  The training and test sets can then be
+ * used through `input.cols()` or non-copying aliases.
+ *
+ * @code
+ * const size_t trainSize = SplitInPlace(input, labels, 0.3);
+ * arma::mat trainData(input.memptr(), input.n_rows, trainSize, false, true);
+ * @endcode
+ *
+ * @param input Input dataset to split; its columns are permuted.
+ * @param inputLabel Input labels to split; they are permuted along with the
+ *     dataset.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *     sample is visited in linear order. (Default true.)
+ * @param stratifyData If true, the train and test splits are stratified as
+ *     with StratifiedSplit(). (Default false.)
+ * @return The number of training points.
+ */
+template<typename T, typename U>
+size_t SplitInPlace(arma::Mat<T>& input,
+                    arma::Row<U>& inputLabel,
+                    const double testRatio,
+                    const bool shuffleData = true,
+                    const bool stratifyData = false)
+{
+  arma::uvec trainIndices;
+  arma::uvec testIndices;
+  if (stratifyData)
+  {
+    StratifiedSplitIndices(inputLabel, trainIndices, testIndices, testRatio,
+        shuffleData);
+  }
+  else
+  {
+    SplitIndices(input.n_cols, trainIndices, testIndices, testRatio,
+        shuffleData);
+  }
+
+  const arma::uvec order = arma::join_cols(trainIndices, testIndices);
+  PermuteColumns(input, order);
+  PermuteColumns(inputLabel, order);
+
+  return trainIndices.n_elem;
+}
+
+/**
+ * Given an input dataset, split into a training set and test set in place:
+ * the columns of the dataset are rearranged so that the training points come
+ * first, followed by the test points.  See the overload with labels for more
+ * details.
+ *
+ * @param input Input dataset to split; its columns are permuted.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *     sample is visited in linear order. (Default true.)
+ * @return The number of training points.
+ */
+template<typename T>
+size_t SplitInPlace(arma::Mat<T>& input,
+                    const double testRatio,
+                    const bool shuffleData = true)
+{
+  arma::uvec trainIndices;
+  arma::uvec testIndices;
+  SplitIndices(input.n_cols, trainIndices, testIndices, testRatio,
+      shuffleData);
+
+  PermuteColumns(input, arma::join_cols(trainIndices, testIndices));
+
+  return trainIndices.n_elem;
+}
+
 } // namespace data
 } // namespace mlpack
 
@@ -17,6 +17,7 @@
 #include <mlpack/core/boost_backport/boost_backport_string_view.hpp>
 #include <mlpack/core/data/string_encoding_dictionary.hpp>
 #include <mlpack/core/data/string_encoding_policies/policy_traits.hpp>
+#include <unordered_map>
 #include <vector>
 
 namespace mlpack {
@@ -97,7 +98,14 @@ class StringEncoding
    *
    * If the output type is either arma::mat or arma::sp_mat then the function
    * writes it in the column-major order. If the output type is 2D std::vector
-   * then the function writes it in the row major order.
+   * then the function writes it in the row major order.  An arma::sp_mat
+   * output is assembled at once from its non-zero values, so no dense matrix
+   * is ever allocated; this is the output to use with the bag-of-words and
+   * tf-idf policies on large corpora.
+   *
+   * When mlpack is built with OpenMP, the strings are tokenized and encoded in
+   * parallel.  The tokens are labeled in the order of their first occurrence
+   * in the input, as if the input was processed serially.
    *
    * @tparam OutputType Type of the output container. The function supports
    *                    the following types: arma::mat, arma::sp_mat,
@@ -114,6 +122,7 @@ class StringEncoding
    * the extracted token and returns the token;
    * 2. IsTokenEmpty() that accepts a token and returns true if the given
    *    token is empty.
+   * Both methods must be safe to call from several threads at once.
    */
   template<typename OutputType, typename TokenizerType>
   void Encode(const std::vector<std::string>& input,
@@ -202,6 +211,78 @@ class StringEncoding
                     typename std::enable_if<StringEncodingPolicyTraits<
                         PolicyType>::onePassEncoding>::type* = 0);
 
+  /**
+   * Tokenize each string of the input, add the new tokens to the dictionary,
+   * and store the labels of the tokens of each string.  Each thread builds
+   * a separate dictionary of new tokens for a contiguous block of strings;
+   * these are merged into the dictionary in the order of the blocks, so the
+   * labels are the same as those of a serial pass.
+   *
+   * @param input Corpus of text to tokenize.
+   * @param tokenizer The tokenizer object.
+   * @param labels Labels of the tokens of each string.
+   */
+  template<typename TokenizerType>
+  void Tokenize(const std::vector<std::string>& input,
+                const TokenizerType& tokenizer,
+                std::vector<std::vector<size_t>>& labels);
+
+  /**
+   * Write the encoded labels to the output.  Each string is written by
+   * a single thread, and only touches its own column (or row) of the output.
+   *
+   * @param labels Labels of the tokens of each string.
+   * @param output Output container to store the result.
+   * @param policy The policy object.
+   */
+  template<typename OutputType, typename PolicyType>
+  void EncodeLabels(const std::vector<std::vector<size_t>>& labels,
+                    OutputType& output,
+                    PolicyType& policy);
+
+  /**
+   * Write the encoded labels to a sparse output.  The non-zero values of each
+   * string are collected in parallel, and the matrix is built from all of them
+   * at once.
+   *
+   * @param labels Labels of the tokens of each string.
+   * @param output Output matrix to store the result.
+   * @param policy The policy object.
+   */
+  template<typename eT, typename PolicyType>
+  void EncodeLabels(const std::vector<std::vector<size_t>>& labels,
+                    arma::SpMat<eT>& output,
+                    PolicyType& policy);
+
+  /**
+   * A single column of a sparse matrix, which the encoding policies can write
+   * to in the same way as to an arma::SpMat.  It only holds the non-zero
+   * values of the column that is being encoded.
+   */
+  template<typename eT>
+  struct SparseColumn
+  {
+    //! The type of the values, as in Armadillo.
+    using elem_type = eT;
+
+    //! Create the column of a matrix of the given size.
+    SparseColumn(const size_t n_rows, const size_t n_cols) :
+        n_rows(n_rows), n_cols(n_cols) { }
+
+    //! Access the value in the given row (the column is ignored).
+    eT& operator()(const size_t row, const size_t /* col */)
+    {
+      return values[row];
+    }
+
+    //! The number of rows of the matrix.
+    const size_t n_rows;
+    //! The number of columns of the matrix.
+    const size_t n_cols;
+    //! The non-zero values of the column.
+    std::unordered_map<size_t, eT> values;
+  };
+
  private:
   //! The encoding policy object.
   EncodingPolicyType encodingPolicy;
@@ -17,6 +17,10 @@
 #include "string_encoding.hpp"
 #include <type_traits>
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace data {
 
@@ -110,50 +114,185 @@ EncodeHelper(const std::vector<std::string>& input,
   policy.Reset();
 
   // The first pass adds the extracted tokens to the dictionary.
-  for (size_t i = 0; i < input.size(); ++i)
+  std::vector<std::vector<size_t>> labels;
+  Tokenize(input, tokenizer, labels);
+
+  // The policy may gather statistics over the whole dataset, so the labels are
+  // passed to it serially; the input does not need to be tokenized again.
+  for (size_t i = 0; i < labels.size(); ++i)
   {
-    boost::string_view strView(input[i]);
-    auto token = tokenizer(strView);
+    for (size_t j = 0; j < labels[i].size(); ++j)
+      policy.PreprocessToken(i, j, labels[i][j]);
 
-    static_assert(
-        std::is_same<typename std::remove_reference<decltype(token)>::type,
-                     typename std::remove_reference<typename DictionaryType::
-                        TokenType>::type>::value,
-        "The dictionary token type doesn't match the return value type "
-        "of the tokenizer.");
+    numColumns = std::max(numColumns, labels[i].size());
+  }
+
+  policy.InitMatrix(output, input.size(), numColumns, dictionary.Size());
 
-    size_t numTokens = 0;
+  // The second pass writes the encoded values to the output.
+  EncodeLabels(labels, output, policy);
+}
 
-    while (!tokenizer.IsTokenEmpty(token))
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename TokenizerType>
+void StringEncoding<EncodingPolicyType, DictionaryType>::Tokenize(
+    const std::vector<std::string>& input,
+    const TokenizerType& tokenizer,
+    std::vector<std::vector<size_t>>& labels)
+{
+  using TokenType = typename std::remove_cv<typename std::remove_reference<
+      typename DictionaryType::TokenType>::type>::type;
+
+  labels.clear();
+  labels.resize(input.size());
+
+  #ifdef HAS_OPENMP
+  const size_t numBlocks = std::max((size_t) 1,
+      std::min((size_t) omp_get_max_threads(), input.size()));
+  #else
+  const size_t numBlocks = 1;
+  #endif
+
+  // Tokens that are already in the dictionary get their labels directly.  New
+  // tokens are labeled within each block first; these labels are offset by the
+  // size of the dictionary, so that they can be told apart and fixed once the
+  // blocks are merged.
+  const size_t knownSize = dictionary.Size();
+  std::vector<std::vector<TokenType>> newTokens(numBlocks);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    DictionaryType blockDictionary;
+    const size_t begin = b * input.size() / numBlocks;
+    const size_t end = (b + 1) * input.size() / numBlocks;
+    for (size_t i = begin; i < end; ++i)
     {
-      if (!dictionary.HasToken(token))
-        dictionary.AddToken(std::move(token));
+      boost::string_view strView(input[i]);
+      auto token = tokenizer(strView);
+
+      static_assert(
+          std::is_same<typename std::remove_reference<decltype(token)>::type,
+                       typename std::remove_reference<typename DictionaryType::
+                          TokenType>::type>::value,
+          "The dictionary token type doesn't match the return value type "
+          "of the tokenizer.");
+
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        if (dictionary.HasToken(token))
+        {
+          labels[i].push_back(dictionary.Value(token));
+        }
+        else if (blockDictionary.HasToken(token))
+        {
+          labels[i].push_back(knownSize + blockDictionary.Value(token));
+        }
+        else
+        {
+          newTokens[b].push_back(token);
+          labels[i].push_back(knownSize + blockDictionary.AddToken(token));
+        }
+
+        token = tokenizer(strView);
+      }
+    }
+  }
 
-      policy.PreprocessToken(i, numTokens, dictionary.Value(token));
+  // Merge the new tokens of each block into the dictionary, in order.
+  std::vector<std::vector<size_t>> blockLabels(numBlocks);
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    blockLabels[b].resize(newTokens[b].size() + 1);
+    for (size_t k = 0; k < newTokens[b].size(); ++k)
+    {
+      const TokenType& token = newTokens[b][k];
+      blockLabels[b][k + 1] = dictionary.HasToken(token) ?
+          dictionary.Value(token) : dictionary.AddToken(token);
+    }
+  }
 
-      token = tokenizer(strView);
-      numTokens++;
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const size_t begin = b * input.size() / numBlocks;
+    const size_t end = (b + 1) * input.size() / numBlocks;
+    for (size_t i = begin; i < end; ++i)
+    {
+      for (size_t& label : labels[i])
+      {
+        if (label > knownSize)
+          label = blockLabels[b][label - knownSize];
+      }
     }
+  }
+}
 
-    numColumns = std::max(numColumns, numTokens);
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename OutputType, typename PolicyType>
+void StringEncoding<EncodingPolicyType, DictionaryType>::EncodeLabels(
+    const std::vector<std::vector<size_t>>& labels,
+    OutputType& output,
+    PolicyType& policy)
+{
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (omp_size_t i = 0; i < (omp_size_t) labels.size(); ++i)
+  {
+    for (size_t j = 0; j < labels[i].size(); ++j)
+      policy.Encode(output, labels[i][j], i, j);
   }
+}
 
-  policy.InitMatrix(output, input.size(), numColumns, dictionary.Size());
+template<typename EncodingPolicyType, typename DictionaryType>
+template<typename eT, typename PolicyType>
+void StringEncoding<EncodingPolicyType, DictionaryType>::EncodeLabels(
+    const std::vector<std::vector<size_t>>& labels,
+    arma::SpMat<eT>& output,
+    PolicyType& policy)
+{
+  std::vector<arma::uword> rows;
+  std::vector<arma::uword> cols;
+  std::vector<eT> values;
 
-  // The second pass writes the encoded values to the output.
-  for (size_t i = 0; i < input.size(); ++i)
+  #pragma omp parallel
   {
-    boost::string_view strView(input[i]);
-    auto token = tokenizer(strView);
-    size_t numTokens = 0;
+    SparseColumn<eT> column(output.n_rows, output.n_cols);
+    std::vector<arma::uword> threadRows;
+    std::vector<arma::uword> threadCols;
+    std::vector<eT> threadValues;
 
-    while (!tokenizer.IsTokenEmpty(token))
+    #pragma omp for schedule(dynamic, 64)
+    for (omp_size_t i = 0; i < (omp_size_t) labels.size(); ++i)
     {
-      policy.Encode(output, dictionary.Value(token), i, numTokens);
-      token = tokenizer(strView);
-      numTokens++;
+      for (size_t j = 0; j < labels[i].size(); ++j)
+        policy.Encode(column, labels[i][j], i, j);
+
+      for (const std::pair<const size_t, eT>& value : column.values)
+      {
+        threadRows.push_back(value.first);
+        threadCols.push_back(i);
+        threadValues.push_back(value.second);
+      }
+      column.values.clear();
     }
+
+    #pragma omp critical
+    {
+      rows.insert(rows.end(), threadRows.begin(), threadRows.end());
+      cols.insert(cols.end(), threadCols.begin(), threadCols.end());
+      values.insert(values.end(), threadValues.begin(), threadValues.end());
+    }
+  }
+
+  arma::umat locations(2, values.size());
+  for (size_t k = 0; k < values.size(); ++k)
+  {
+    locations(0, k) = rows[k];
+    locations(1, k) = cols[k];
   }
+
+  output = arma::SpMat<eT>(locations, arma::Col<eT>(values), output.n_rows,
+      output.n_cols);
 }
 
 template<typename EncodingPolicyType, typename DictionaryType>
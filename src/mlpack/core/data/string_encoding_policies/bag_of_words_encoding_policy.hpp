@@ -15,6 +15,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/data/string_encoding_policies/policy_traits.hpp>
+#include <mlpack/core/data/hashing_dictionary.hpp>
 #include <mlpack/core/data/string_encoding.hpp>
 
 namespace mlpack {
@@ -165,6 +166,18 @@ class BagOfWordsEncodingPolicy
 template<typename TokenType>
 using BagOfWordsEncoding = StringEncoding<BagOfWordsEncodingPolicy,
                                           StringEncodingDictionary<TokenType>>;
+
+/**
+ * A convenient alias for the StringEncoding class with BagOfWordsEncodingPolicy
+ * and a HashingDictionary, which labels the tokens by hashing them instead of
+ * storing them.
+ *
+ * @tparam TokenType Type of the tokens.
+ */
+template<typename TokenType>
+using HashingBagOfWordsEncoding = StringEncoding<BagOfWordsEncodingPolicy,
+                                                 HashingDictionary<TokenType>>;
+
 } // namespace data
 } // namespace mlpack
 
@@ -15,6 +15,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/data/string_encoding_policies/policy_traits.hpp>
+#include <mlpack/core/data/hashing_dictionary.hpp>
 #include <mlpack/core/data/string_encoding.hpp>
 
 namespace mlpack {
@@ -150,13 +151,15 @@ class TfIdfEncodingPolicy
               const size_t line,
               const size_t /* index */)
   {
+    // The statistics are only looked up here, so several lines can be
+    // encoded at once.
     const typename MatType::elem_type tf =
         TermFrequency<typename MatType::elem_type>(
-            tokensFrequences[line][value], linesSizes[line]);
+            tokensFrequences[line].at(value), linesSizes[line]);
 
     const typename MatType::elem_type idf =
         InverseDocumentFrequency<typename MatType::elem_type>(
-            output.n_cols, numContainingStrings[value]);
+            output.n_cols, numContainingStrings.at(value));
 
     output(value - 1, line) =  tf * idf;
   }
@@ -183,10 +186,10 @@ class TfIdfEncodingPolicy
               const size_t /* index */)
   {
     const ElemType tf = TermFrequency<ElemType>(
-        tokensFrequences[line][value], linesSizes[line]);
+        tokensFrequences[line].at(value), linesSizes[line]);
 
     const ElemType idf = InverseDocumentFrequency<ElemType>(
-        output.size(), numContainingStrings[value]);
+        output.size(), numContainingStrings.at(value));
 
     output[line][value - 1] =  tf * idf;
   }
@@ -343,6 +346,18 @@ class TfIdfEncodingPolicy
 template<typename TokenType>
 using TfIdfEncoding = StringEncoding<TfIdfEncodingPolicy,
                                      StringEncodingDictionary<TokenType>>;
+
+/**
+ * A convenient alias for the StringEncoding class with TfIdfEncodingPolicy
+ * and a HashingDictionary, which labels the tokens by hashing them instead of
+ * storing them.
+ *
+ * @tparam TokenType Type of the tokens.
+ */
+template<typename TokenType>
+using HashingTfIdfEncoding = StringEncoding<TfIdfEncodingPolicy,
+                                            HashingDictionary<TokenType>>;
+
 } // namespace data
 } // namespace mlpack
 
@@ -0,0 +1,74 @@
+/**
+ * @file core/distributed/local_communicator.hpp
+ *
+ * Definition of the LocalCommunicator class, a communicator with a single
+ * rank.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DISTRIBUTED_LOCAL_COMMUNICATOR_HPP
+#define MLPACK_CORE_DISTRIBUTED_LOCAL_COMMUNICATOR_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <cstring>
+
+namespace mlpack {
+namespace distributed /** Distributed computation. */ {
+
+/**
+ * The LocalCommunicator is a communicator with only one rank, so that the
+ * distributed code (ann::DataParallel, kmeans::DistributedKMeans,
+ * neighbor::DistributedNeighborSearch and the distributed training of
+ * tree::RandomForest) can be used without MPI.  Every
+ * communicator used by the distributed code must provide the same methods:
+ *
+ * @code
+ * // Get the index of this process, in [0, Size()).
+ * size_t Rank() const;
+ * // Get the number of processes.
+ * size_t Size() const;
+ * // Send the given bytes to the given rank and receive the given number of
+ * // bytes from the given rank, at the same time.
+ * void SendReceive(const void* send, const size_t sendBytes,
+ *                  const size_t destination, void* receive,
+ *                  const size_t receiveBytes, const size_t source);
+ * // Copy the given bytes of the given rank to every other rank.
+ * void Broadcast(void* data, const size_t bytes, const size_t root);
+ * @endcode
+ */
+class LocalCommunicator
+{
+ public:
+  //! Get the index of this process.
+  size_t Rank() const { return 0; }
+
+  //! Get the number of processes.
+  size_t Size() const { return 1; }
+
+  //! Send bytes to this process, and receive them.
+  void SendReceive(const void* send,
+                   const size_t sendBytes,
+                   const size_t /* destination */,
+                   void* receive,
+                   const size_t receiveBytes,
+                   const size_t /* source */)
+  {
+    std::memcpy(receive, send, std::min(sendBytes, receiveBytes));
+  }
+
+  //! There is no other process to broadcast to.
+  void Broadcast(void* /* data */,
+                 const size_t /* bytes */,
+                 const size_t /* root */)
+  {
+    // Nothing to do here.
+  }
+};
+
+} // namespace distributed
+} // namespace mlpack
+
+#endif
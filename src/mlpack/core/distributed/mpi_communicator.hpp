@@ -0,0 +1,150 @@
+/**
+ * @file core/distributed/mpi_communicator.hpp
+ *
+ * Definition of the MPICommunicator class, which exchanges data between the
+ * processes of an MPI communicator.  It is only available when mlpack is
+ * configured with USE_MPI.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DISTRIBUTED_MPI_COMMUNICATOR_HPP
+#define MLPACK_CORE_DISTRIBUTED_MPI_COMMUNICATOR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#ifdef MLPACK_USE_MPI
+
+#include <mpi.h>
+#include <cstdlib>
+
+namespace mlpack {
+namespace distributed /** Distributed computation. */ {
+
+/**
+ * The MPICommunicator exchanges data between the processes of an MPI
+ * communicator, for the distributed code (ann::DataParallel,
+ * kmeans::DistributedKMeans and neighbor::DistributedNeighborSearch).  MPI
+ * must be initialized (with MPI_Init() or Initialize()) before the
+ * communicator is used.  Messages larger than what an MPI count can describe
+ * are sent in several pieces.
+ *
+ * @code
+ * MPI_Init(&argc, &argv);
+ * MPICommunicator communicator;
+ * // ... load the shard of the data of this rank ...
+ * DataParallel<ens::Adam, MPICommunicator> optimizer(ens::Adam(),
+ *     communicator);
+ * model.Train(shardData, shardLabels, optimizer);
+ * MPI_Finalize();
+ * @endcode
+ */
+class MPICommunicator
+{
+ public:
+  /**
+   * Create the communicator.
+   *
+   * @param communicator MPI communicator to use.
+   */
+  MPICommunicator(MPI_Comm communicator = MPI_COMM_WORLD) :
+      communicator(communicator)
+  {
+    // Nothing to do here.
+  }
+
+  /**
+   * Initialize MPI if it has not been initialized yet, and finalize it when
+   * the program exits.  This is used by the command-line programs, which
+   * don't get the arguments of the program for MPI_Init().
+   */
+  static void Initialize()
+  {
+    int initialized;
+    MPI_Initialized(&initialized);
+    if (initialized)
+      return;
+
+    MPI_Init(NULL, NULL);
+    std::atexit([]()
+    {
+      int finalized;
+      MPI_Finalized(&finalized);
+      if (!finalized)
+        MPI_Finalize();
+    });
+  }
+
+  //! Get the index of this process.
+  size_t Rank() const
+  {
+    int rank;
+    MPI_Comm_rank(communicator, &rank);
+    return (size_t) rank;
+  }
+
+  //! Get the number of processes.
+  size_t Size() const
+  {
+    int size;
+    MPI_Comm_size(communicator, &size);
+    return (size_t) size;
+  }
+
+  //! Send bytes to the given rank while receiving bytes from the given rank.
+  void SendReceive(const void* send,
+                   const size_t sendBytes,
+                   const size_t destination,
+                   void* receive,
+                   const size_t receiveBytes,
+                   const size_t source)
+  {
+    const size_t maxPiece = MaxPiece();
+    std::vector<MPI_Request> requests;
+    for (size_t offset = 0; offset < receiveBytes; offset += maxPiece)
+    {
+      requests.push_back(MPI_Request());
+      MPI_Irecv((char*) receive + offset,
+          (int) std::min(maxPiece, receiveBytes - offset), MPI_BYTE,
+          (int) source, 0, communicator, &requests.back());
+    }
+
+    for (size_t offset = 0; offset < sendBytes; offset += maxPiece)
+    {
+      requests.push_back(MPI_Request());
+      MPI_Isend((char*) send + offset,
+          (int) std::min(maxPiece, sendBytes - offset), MPI_BYTE,
+          (int) destination, 0, communicator, &requests.back());
+    }
+
+    MPI_Waitall((int) requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+  }
+
+  //! Copy the given bytes of the given rank to every other rank.
+  void Broadcast(void* data, const size_t bytes, const size_t root)
+  {
+    const size_t maxPiece = MaxPiece();
+    for (size_t offset = 0; offset < bytes; offset += maxPiece)
+    {
+      MPI_Bcast((char*) data + offset,
+          (int) std::min(maxPiece, bytes - offset), MPI_BYTE, (int) root,
+          communicator);
+    }
+  }
+
+ private:
+  //! Get the largest number of bytes sent in one MPI message.
+  static size_t MaxPiece() { return size_t(1) << 30; }
+
+  //! The MPI communicator.
+  MPI_Comm communicator;
+};
+
+} // namespace distributed
+} // namespace mlpack
+
+#endif
+
+#endif
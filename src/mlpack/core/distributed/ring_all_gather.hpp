@@ -0,0 +1,64 @@
+/**
+ * @file core/distributed/ring_all_gather.hpp
+ *
+ * Ring all-gather of blocks of bytes between the processes of a communicator.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DISTRIBUTED_RING_ALL_GATHER_HPP
+#define MLPACK_CORE_DISTRIBUTED_RING_ALL_GATHER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "ring_all_reduce.hpp"
+
+namespace mlpack {
+namespace distributed /** Distributed computation. */ {
+
+/**
+ * Give the block of bytes of every process of the communicator to every
+ * process, with the ring algorithm: the blocks travel around the ring, so that
+ * each process sends and receives every block once.  The blocks of the
+ * processes may have different sizes.
+ *
+ * @param communicator Communicator between the processes (see
+ *     LocalCommunicator).
+ * @param block Block of bytes of this process.
+ * @param blocks The blocks of all the processes, indexed by rank.
+ */
+template<typename CommunicatorType>
+void RingAllGather(CommunicatorType& communicator,
+                   const std::vector<char>& block,
+                   std::vector<std::vector<char>>& blocks)
+{
+  const size_t size = communicator.Size();
+  const size_t rank = communicator.Rank();
+
+  // Gather the size of every block.
+  arma::vec sizes(size, arma::fill::zeros);
+  sizes[rank] = (double) block.size();
+  RingAllReduce(communicator, sizes.memptr(), size);
+
+  blocks.resize(size);
+  blocks[rank] = block;
+
+  const size_t next = (rank + 1) % size;
+  const size_t previous = (rank + size - 1) % size;
+  for (size_t step = 0; step + 1 < size; ++step)
+  {
+    const size_t sendBlock = (rank + size - step) % size;
+    const size_t receiveBlock = (rank + size - step - 1) % size;
+    blocks[receiveBlock].resize((size_t) sizes[receiveBlock]);
+    communicator.SendReceive(blocks[sendBlock].data(),
+        blocks[sendBlock].size(), next, blocks[receiveBlock].data(),
+        blocks[receiveBlock].size(), previous);
+  }
+}
+
+} // namespace distributed
+} // namespace mlpack
+
+#endif
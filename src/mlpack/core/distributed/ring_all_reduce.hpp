@@ -0,0 +1,188 @@
+/**
+ * @file core/distributed/ring_all_reduce.hpp
+ *
+ * Ring all-reduce of a vector between the processes of a communicator, with
+ * optional half precision compression.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DISTRIBUTED_RING_ALL_REDUCE_HPP
+#define MLPACK_CORE_DISTRIBUTED_RING_ALL_REDUCE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <cstring>
+
+namespace mlpack {
+namespace distributed /** Distributed computation. */ {
+
+/**
+ * Convert the given value to an IEEE 754 half precision number, rounding to
+ * the nearest representable value.  Values too large for half precision become
+ * infinite.
+ *
+ * @param value Value to convert.
+ * @return The bits of the half precision number.
+ */
+inline uint16_t ToHalf(const float value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(float));
+  const uint16_t sign = (uint16_t) ((bits >> 16) & 0x8000);
+  const uint32_t magnitude = bits & 0x7FFFFFFF;
+
+  // Infinity and NaN.
+  if (magnitude >= 0x7F800000)
+    return sign | 0x7C00 | (magnitude > 0x7F800000 ? 0x200 : 0);
+  // Too large: 65520 and above round to infinity.
+  if (magnitude >= 0x477FF000)
+    return sign | 0x7C00;
+  // Subnormal half precision numbers are multiples of 2^-24.
+  if (magnitude < 0x38800000)
+  {
+    float absValue;
+    std::memcpy(&absValue, &magnitude, sizeof(float));
+    return sign | (uint16_t) std::nearbyint(absValue * 16777216.0f);
+  }
+
+  // Change the exponent bias from 127 to 15, and round the mantissa to the
+  // nearest even.
+  const uint32_t rounded = magnitude + 0xFFF + ((magnitude >> 13) & 1);
+  return sign | (uint16_t) ((rounded - 0x38000000) >> 13);
+}
+
+/**
+ * Convert the given IEEE 754 half precision number to a float.  The conversion
+ * is exact.
+ *
+ * @param half Bits of the half precision number.
+ * @return The value of the number.
+ */
+inline float FromHalf(const uint16_t half)
+{
+  const uint32_t sign = ((uint32_t) half & 0x8000) << 16;
+  const uint32_t exponent = (half >> 10) & 0x1F;
+  const uint32_t mantissa = half & 0x3FF;
+
+  if (exponent == 0)
+  {
+    const float value = mantissa / 16777216.0f;
+    return sign ? -value : value;
+  }
+
+  const uint32_t bits = (exponent == 31) ?
+      (sign | 0x7F800000 | (mantissa << 13)) :
+      (sign | ((exponent + 112) << 23) | (mantissa << 13));
+  float value;
+  std::memcpy(&value, &bits, sizeof(float));
+  return value;
+}
+
+/**
+ * Sum the given vectors of all the processes of the communicator, and store
+ * the sum in the vector of every process, with the ring algorithm: the vector
+ * is split into one chunk per process, each process sums one chunk as the
+ * partial sums travel around the ring, and the summed chunks travel around the
+ * ring once more.  Each process sends and receives about twice the size of the
+ * vector, however many processes there are.
+ *
+ * If compress is true, the chunks are sent as 16-bit half precision numbers
+ * instead of 64-bit doubles, which divides the traffic by four.  The received
+ * chunks are still added in double precision, and the final sum is rounded to
+ * half precision so that every process gets exactly the same result.  This is
+ * only suitable for values such as gradients, which tolerate a relative error
+ * of about 1e-3 and stay below 65504 in magnitude.
+ *
+ * Every process must call this function with vectors of the same size.
+ *
+ * @param communicator Communicator between the processes (see
+ *     LocalCommunicator).
+ * @param data Vector to sum.
+ * @param n Number of elements of the vector.
+ * @param compress Whether to send the chunks in half precision.
+ */
+template<typename CommunicatorType>
+void RingAllReduce(CommunicatorType& communicator,
+                   double* data,
+                   const size_t n,
+                   const bool compress = false)
+{
+  const size_t size = communicator.Size();
+  const size_t rank = communicator.Rank();
+  if (size <= 1 || n == 0)
+    return;
+
+  const size_t next = (rank + 1) % size;
+  const size_t previous = (rank + size - 1) % size;
+
+  // Chunk c holds the elements [begins[c], begins[c + 1]).
+  std::vector<size_t> begins(size + 1);
+  for (size_t c = 0; c <= size; ++c)
+    begins[c] = c * n / size;
+
+  std::vector<double> received;
+  std::vector<uint16_t> sendHalf, receivedHalf;
+
+  // Send the given chunk to the next process, and receive the given chunk
+  // from the previous process into received.
+  auto exchange = [&](const size_t sendChunk, const size_t receiveChunk)
+  {
+    const size_t sendSize = begins[sendChunk + 1] - begins[sendChunk];
+    const size_t receiveSize = begins[receiveChunk + 1] - begins[receiveChunk];
+    received.resize(receiveSize);
+    if (compress)
+    {
+      sendHalf.resize(sendSize);
+      receivedHalf.resize(receiveSize);
+      for (size_t i = 0; i < sendSize; ++i)
+        sendHalf[i] = ToHalf((float) data[begins[sendChunk] + i]);
+
+      communicator.SendReceive(sendHalf.data(), sendSize * sizeof(uint16_t),
+          next, receivedHalf.data(), receiveSize * sizeof(uint16_t), previous);
+
+      for (size_t i = 0; i < receiveSize; ++i)
+        received[i] = FromHalf(receivedHalf[i]);
+    }
+    else
+    {
+      communicator.SendReceive(data + begins[sendChunk],
+          sendSize * sizeof(double), next, received.data(),
+          receiveSize * sizeof(double), previous);
+    }
+  };
+
+  // Reduce-scatter: after size - 1 steps, this process holds the whole sum of
+  // the chunk (rank + 1) % size.
+  for (size_t step = 0; step < size - 1; ++step)
+  {
+    const size_t sendChunk = (rank + size - step) % size;
+    const size_t receiveChunk = (rank + size - step - 1) % size;
+    exchange(sendChunk, receiveChunk);
+    for (size_t i = 0; i < received.size(); ++i)
+      data[begins[receiveChunk] + i] += received[i];
+  }
+
+  // Round the summed chunk as the other processes will receive it.
+  if (compress)
+  {
+    const size_t chunk = (rank + 1) % size;
+    for (size_t i = begins[chunk]; i < begins[chunk + 1]; ++i)
+      data[i] = FromHalf(ToHalf((float) data[i]));
+  }
+
+  // All-gather: pass the summed chunks around the ring.
+  for (size_t step = 0; step < size - 1; ++step)
+  {
+    const size_t sendChunk = (rank + 1 + size - step) % size;
+    const size_t receiveChunk = (rank + size - step) % size;
+    exchange(sendChunk, receiveChunk);
+    std::copy(received.begin(), received.end(), data + begins[receiveChunk]);
+  }
+}
+
+} // namespace distributed
+} // namespace mlpack
+
+#endif
@@ -17,6 +17,25 @@
 namespace mlpack {
 namespace hpt {
 
+/**
+ * HasEvaluateInto::value is true if the cross-validation type CVType has an
+ * EvaluateInto() method taking a std::unique_ptr<MLAlgorithm>& followed by
+ * the given arguments (as SimpleCV and KFoldCV do).
+ */
+template<typename CVType, typename MLAlgorithm, typename... Args>
+struct HasEvaluateInto
+{
+  template<typename C>
+  static auto Check(int) -> decltype(std::declval<C&>().EvaluateInto(
+      std::declval<std::unique_ptr<MLAlgorithm>&>(),
+      std::declval<const Args&>()...), std::true_type());
+
+  template<typename C>
+  static std::false_type Check(...);
+
+  static const bool value = decltype(Check<CVType>(0))::value;
+};
+
 /**
  * This wrapper serves for adapting the interface of the cross-validation
  * classes to the one that can be utilized by the mlpack optimizers.
@@ -66,13 +85,37 @@ class CVFunction
              const BoundArgs&... args);
 
   /**
-   * Run cross-validation with the bound and passed parameters.
+   * Run cross-validation with the bound and passed parameters.  The
+   * objectives are cached, so cross-validation is run only once for each
+   * distinct set of arguments (categorical parameters are truncated to the
+   * index of the category first).
    *
    * @param parameters Arguments (rather than the bound arguments) that should
    *     be passed into the Evaluate method of the CVType object.
    */
   double Evaluate(const arma::mat& parameters);
 
+  /**
+   * Run cross-validation for each column of the given matrix (each column is
+   * a set of parameters, as for Evaluate()).  If parallel is true and mlpack
+   * is built with OpenMP, the candidates are evaluated concurrently; this
+   * requires that training MLAlgorithm is thread-safe, and that CVType has an
+   * EvaluateInto() method (as SimpleCV and KFoldCV do).  The best model is
+   * updated as if the candidates were evaluated one after another.  Cached
+   * objectives are reused as in Evaluate().
+   *
+   * In parallel, each candidate draws the random numbers of mlpack::math from
+   * its own math::RandomStream, so the results do not depend on the number of
+   * threads, but they may differ from those of a serial run.
+   *
+   * @param candidates Sets of parameters to evaluate, one per column.
+   * @param objectives Vector to output the objective of each candidate into.
+   * @param parallel Whether to evaluate the candidates concurrently.
+   */
+  void EvaluateCandidates(const arma::mat& candidates,
+                          arma::vec& objectives,
+                          const bool parallel = false);
+
   /**
    * Evaluate numerically the gradient of the CVFunction with the given
    * parameters.
@@ -86,6 +129,17 @@ class CVFunction
   //! Access and modify the best model so far.
   MLAlgorithm& BestModel() { return bestModel; }
 
+  /**
+   * Set the fraction of the training data that is used by the
+   * cross-validation object.  Since objectives obtained with different
+   * fractions are not comparable, the cached objectives and the best model so
+   * far are forgotten (the best model will be replaced by the next evaluated
+   * one).
+   *
+   * @param fraction Fraction of the training data to use, in (0, 1].
+   */
+  void TrainingFraction(const double fraction);
+
  private:
   //! The type of tuples of BoundArgs.
   using BoundArgsTupleType = std::tuple<BoundArgs...>;
@@ -125,6 +179,19 @@ class CVFunction
   //! Minimum absolute increase of arguments for calculation of gradient.
   double minDelta;
 
+  //! Objectives of the sets of arguments assessed so far.
+  std::map<std::vector<double>, double> cache;
+
+  //! Get the key of the given parameters in the cache.
+  std::vector<double> CacheKey(const arma::mat& parameters) const;
+
+  /**
+   * Replace the best model with the given one if the given objective is
+   * better, or if we probably have not assigned any valid model yet.
+   */
+  void UpdateBestModel(const double objective,
+                       std::unique_ptr<MLAlgorithm>& model);
+
   /**
    * Collect all arguments and run cross-validation.
    */
@@ -133,10 +200,13 @@ class CVFunction
            typename... Args,
            typename = typename
                std::enable_if<(BoundArgIndex + ParamIndex < TotalArgs)>::type>
-  inline double Evaluate(const arma::mat& parameters, const Args&... args);
+  inline double Evaluate(const arma::mat& parameters,
+                         std::unique_ptr<MLAlgorithm>& model,
+                         const Args&... args);
 
   /**
-   * Run cross-validation with the collected arguments.
+   * Run cross-validation with the collected arguments, and store the trained
+   * model in the given pointer.
    */
   template<size_t BoundArgIndex,
            size_t ParamIndex,
@@ -144,7 +214,28 @@ class CVFunction
            typename = typename
                std::enable_if<BoundArgIndex + ParamIndex == TotalArgs>::type,
            typename = void>
-  inline double Evaluate(const arma::mat& parameters, const Args&... args);
+  inline double Evaluate(const arma::mat& parameters,
+                         std::unique_ptr<MLAlgorithm>& model,
+                         const Args&... args);
+
+  /**
+   * Run cross-validation with the given arguments through the EvaluateInto()
+   * method of CVType, which stores the trained model in the given pointer.
+   */
+  template<typename... Args>
+  inline double EvaluateWithCV(std::unique_ptr<MLAlgorithm>& model,
+                               std::true_type /* hasEvaluateInto */,
+                               const Args&... args);
+
+  /**
+   * Run cross-validation with the given arguments through the Evaluate()
+   * method of CVType (which has no EvaluateInto() method), and move the
+   * trained model from the Model() method.
+   */
+  template<typename... Args>
+  inline double EvaluateWithCV(std::unique_ptr<MLAlgorithm>& model,
+                               std::false_type /* hasEvaluateInto */,
+                               const Args&... args);
 
   /**
    * Put the bound argument (at the BoundArgIndex position) as the next one.
@@ -154,7 +245,9 @@ class CVFunction
            typename... Args,
            typename = typename std::enable_if<
                UseBoundArg<BoundArgIndex, ParamIndex>::value>::type>
-  inline double PutNextArg(const arma::mat& parameters, const Args&... args);
+  inline double PutNextArg(const arma::mat& parameters,
+                           std::unique_ptr<MLAlgorithm>& model,
+                           const Args&... args);
 
   /**
    * Put the element (at the ParamIndex position) of the parameters as the next
@@ -166,7 +259,9 @@ class CVFunction
            typename = typename std::enable_if<
                !UseBoundArg<BoundArgIndex, ParamIndex>::value>::type,
            typename = void>
-  inline double PutNextArg(const arma::mat& parameters, const Args&... args);
+  inline double PutNextArg(const arma::mat& parameters,
+                           std::unique_ptr<MLAlgorithm>& model,
+                           const Args&... args);
 };
 
 
@@ -12,6 +12,8 @@
 #ifndef MLPACK_CORE_HPT_CV_FUNCTION_IMPL_HPP
 #define MLPACK_CORE_HPT_CV_FUNCTION_IMPL_HPP
 
+#include <exception>
+
 namespace mlpack {
 namespace hpt {
 
@@ -65,7 +67,167 @@ template<typename CVType,
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
     const arma::mat& parameters)
 {
-  return Evaluate<0, 0>(parameters);
+  // Optimizers (and Gradient()) often revisit the same point, so reuse the
+  // objective if we have already run cross-validation for it.
+  const std::vector<double> key = CacheKey(parameters);
+  const auto cached = cache.find(key);
+  if (cached != cache.end())
+    return cached->second;
+
+  std::unique_ptr<MLAlgorithm> model;
+  const double objective = Evaluate<0, 0>(parameters, model);
+  UpdateBestModel(objective, model);
+  cache[key] = objective;
+
+  return objective;
+}
+
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+void CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::
+EvaluateCandidates(const arma::mat& candidates,
+                   arma::vec& objectives,
+                   const bool parallel)
+{
+  objectives.set_size(candidates.n_cols);
+
+  // Take the objectives of candidates we have already assessed from the
+  // cache, and assess each of the other distinct candidates only once.
+  std::vector<std::vector<double>> keys(candidates.n_cols);
+  std::map<std::vector<double>, size_t> firstIndices;
+  std::vector<size_t> toEvaluate;
+  for (size_t i = 0; i < candidates.n_cols; ++i)
+  {
+    keys[i] = CacheKey(candidates.col(i));
+    const auto cached = cache.find(keys[i]);
+    if (cached != cache.end())
+    {
+      objectives[i] = cached->second;
+    }
+    else if (firstIndices.count(keys[i]) == 0)
+    {
+      firstIndices[keys[i]] = i;
+      toEvaluate.push_back(i);
+    }
+  }
+
+  // The best candidate of this batch; ties are resolved in favor of the
+  // earlier candidate, so that the result does not depend on the order in
+  // which the threads finish.
+  std::unique_ptr<MLAlgorithm> batchBestModel;
+  double batchBestObjective = std::numeric_limits<double>::max();
+  size_t batchBestIndex = candidates.n_cols;
+
+  // In parallel, each candidate draws random numbers from its own random
+  // stream, so that its model does not depend on the scheduling.
+  const size_t seed = parallel ? math::RandomStreamSeed() : 0;
+  auto evaluateCandidate = [&](const size_t i)
+  {
+    std::unique_ptr<math::RandomStream> stream(parallel ?
+        new math::RandomStream(seed, i) : NULL);
+    const arma::mat parameters = candidates.col(i);
+    std::unique_ptr<MLAlgorithm> model;
+    objectives[i] = Evaluate<0, 0>(parameters, model);
+
+    #pragma omp critical
+    {
+      if (batchBestIndex == candidates.n_cols ||
+          objectives[i] < batchBestObjective ||
+          (objectives[i] == batchBestObjective && i < batchBestIndex))
+      {
+        batchBestObjective = objectives[i];
+        batchBestIndex = i;
+        batchBestModel = std::move(model);
+      }
+    }
+  };
+
+  if (!parallel)
+  {
+    for (const size_t i : toEvaluate)
+      evaluateCandidate(i);
+  }
+  else
+  {
+    // An exception cannot leave the parallel region, so it is kept and
+    // rethrown.
+    std::exception_ptr exception;
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t j = 0; j < (omp_size_t) toEvaluate.size(); ++j)
+    {
+      try
+      {
+        evaluateCandidate(toEvaluate[j]);
+      }
+      catch (...)
+      {
+        #pragma omp critical
+        exception = std::current_exception();
+      }
+    }
+
+    if (exception)
+      std::rethrow_exception(exception);
+  }
+
+  for (const size_t i : toEvaluate)
+    cache[keys[i]] = objectives[i];
+  for (size_t i = 0; i < candidates.n_cols; ++i)
+    objectives[i] = cache.at(keys[i]);
+
+  if (batchBestModel)
+    UpdateBestModel(batchBestObjective, batchBestModel);
+}
+
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+void CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::
+TrainingFraction(const double fraction)
+{
+  cv.TrainingFraction(fraction);
+  bestObjective = std::numeric_limits<double>::max();
+  cache.clear();
+}
+
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+std::vector<double> CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::
+CacheKey(const arma::mat& parameters) const
+{
+  // Categorical parameters are truncated to the index of the category, as in
+  // PutNextArg(), so that all points that map to the same arguments share the
+  // same key.
+  std::vector<double> key(parameters.n_rows);
+  for (size_t i = 0; i < parameters.n_rows; ++i)
+  {
+    key[i] = (datasetInfo.Type(i) == data::Datatype::categorical) ?
+        (double) size_t(parameters(i, 0)) : parameters(i, 0);
+  }
+
+  return key;
+}
+
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+void CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::
+UpdateBestModel(const double objective, std::unique_ptr<MLAlgorithm>& model)
+{
+  // Change the best model if we have got a better score, or if we probably
+  // have not assigned any valid (trained) model yet.
+  if (model && (bestObjective > objective ||
+      bestObjective == std::numeric_limits<double>::max()))
+  {
+    bestObjective = objective;
+    bestModel = std::move(*model);
+  }
 }
 
 template<typename CVType,
@@ -99,9 +261,10 @@ template<size_t BoundArgIndex,
          typename>
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
     const arma::mat& parameters,
+    std::unique_ptr<MLAlgorithm>& model,
     const Args&... args)
 {
-  return PutNextArg<BoundArgIndex, ParamIndex>(parameters, args...);
+  return PutNextArg<BoundArgIndex, ParamIndex>(parameters, model, args...);
 }
 
 template<typename CVType,
@@ -115,19 +278,57 @@ template<size_t BoundArgIndex,
          typename>
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
     const arma::mat& /* parameters */,
+    std::unique_ptr<MLAlgorithm>& model,
     const Args&... args)
 {
-  double objective = cv.Evaluate(args...);
+  return EvaluateWithCV(model, std::integral_constant<bool,
+      HasEvaluateInto<CVType, MLAlgorithm, Args...>::value>(), args...);
+}
 
-  // Change the best model if we have got a better score, or if we probably
-  // have not assigned any valid (trained) model yet.
-  if (bestObjective > objective ||
-      bestObjective == std::numeric_limits<double>::max())
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+template<typename... Args>
+double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::EvaluateWithCV(
+    std::unique_ptr<MLAlgorithm>& model,
+    std::true_type /* hasEvaluateInto */,
+    const Args&... args)
+{
+  return cv.EvaluateInto(model, args...);
+}
+
+template<typename CVType,
+         typename MLAlgorithm,
+         size_t TotalArgs,
+         typename... BoundArgs>
+template<typename... Args>
+double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::EvaluateWithCV(
+    std::unique_ptr<MLAlgorithm>& model,
+    std::false_type /* hasEvaluateInto */,
+    const Args&... args)
+{
+  // The model is kept by the cross-validation object, so only one candidate
+  // can be assessed at a time.  An exception cannot leave the critical
+  // section, so it is kept and rethrown.
+  double objective = 0.0;
+  std::exception_ptr exception;
+  #pragma omp critical(mlpackCVFunctionEvaluate)
   {
-    bestObjective = objective;
-    bestModel = std::move(cv.Model());
+    try
+    {
+      objective = cv.Evaluate(args...);
+      model.reset(new MLAlgorithm(std::move(cv.Model())));
+    }
+    catch (...)
+    {
+      exception = std::current_exception();
+    }
   }
 
+  if (exception)
+    std::rethrow_exception(exception);
+
   return objective;
 }
 
@@ -141,10 +342,11 @@ template<size_t BoundArgIndex,
          typename>
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::PutNextArg(
     const arma::mat& parameters,
+    std::unique_ptr<MLAlgorithm>& model,
     const Args&... args)
 {
   return Evaluate<BoundArgIndex + 1, ParamIndex>(
-      parameters, args..., std::get<BoundArgIndex>(boundArgs).value);
+      parameters, model, args..., std::get<BoundArgIndex>(boundArgs).value);
 }
 
 template<typename CVType,
@@ -158,16 +360,17 @@ template<size_t BoundArgIndex,
          typename>
 double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::PutNextArg(
     const arma::mat& parameters,
+    std::unique_ptr<MLAlgorithm>& model,
     const Args&... args)
 {
   if (datasetInfo.Type(ParamIndex) == data::Datatype::categorical)
   {
-    return Evaluate<BoundArgIndex, ParamIndex + 1>(parameters, args...,
+    return Evaluate<BoundArgIndex, ParamIndex + 1>(parameters, model, args...,
         datasetInfo.UnmapString(size_t(parameters(ParamIndex, 0)), ParamIndex));
   }
   else
   {
-    return Evaluate<BoundArgIndex, ParamIndex + 1>(parameters, args...,
+    return Evaluate<BoundArgIndex, ParamIndex + 1>(parameters, model, args...,
         parameters(ParamIndex, 0));
   }
 }
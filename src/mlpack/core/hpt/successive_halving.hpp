@@ -0,0 +1,116 @@
+/**
+ * @file core/hpt/successive_halving.hpp
+ *
+ * Definition of the SuccessiveHalving optimizer, which searches a grid of
+ * hyper-parameters by assessing all candidates on a small part of the training
+ * data and repeatedly keeping only the best ones for a larger part.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_SUCCESSIVE_HALVING_HPP
+#define MLPACK_CORE_HPT_SUCCESSIVE_HALVING_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace hpt {
+
+/**
+ * SuccessiveHalving is an optimizer for HyperParameterTuner that chooses from
+ * the same sets of values as ens::GridSearch, but spends less time on poor
+ * candidates.  All combinations of values are first assessed with models
+ * trained on the first minFraction of the training data; the best 1 / eta of
+ * them are kept and assessed again with eta times more training data, and so
+ * on, until the remaining candidates are assessed with all of the training
+ * data.  If Parallel() is set to true, the candidates of each round are assessed
+ * concurrently (see CVFunction::EvaluateCandidates()).
+ *
+ * With minFraction equal to 1, all candidates are assessed once on all of the
+ * training data, so the result is the same as the result of ens::GridSearch.
+ *
+ * @code
+ * HyperParameterTuner<LinearRegression, MSE, SimpleCV, SuccessiveHalving>
+ *     hpt(0.2, data, responses);
+ * hpt.Optimizer().MinFraction() = 1.0 / 9.0;
+ *
+ * arma::vec lambdas{0.0, 0.001, 0.01, 0.1, 1.0};
+ * double bestLambda;
+ * std::tie(bestLambda) = hpt.Optimize(lambdas);
+ * @endcode
+ *
+ * All hyper-parameters that are not fixed must be passed as sets of values.
+ * Note that the assessment on a part of the training data is only a cheap
+ * estimate, so the best candidate may be discarded early if minFraction is too
+ * small.
+ */
+class SuccessiveHalving
+{
+ public:
+  /**
+   * Create the SuccessiveHalving optimizer.
+   *
+   * @param minFraction Fraction of the training data used in the first round,
+   *     in (0, 1].
+   * @param eta Factor by which the number of candidates is reduced, and the
+   *     fraction of the training data is increased, in each round (should be
+   *     more than 1).
+   * @param parallel Whether to assess the candidates of each round
+   *     concurrently.
+   */
+  SuccessiveHalving(const double minFraction = 0.1,
+                    const double eta = 3.0,
+                    const bool parallel = false);
+
+  /**
+   * Find the best candidate.  Each dimension of the parameters must be
+   * categorical; the candidates are all combinations of the categories.
+   *
+   * @tparam FunctionType Type of the function to optimize (a CVFunction).
+   * @param function Function to optimize.
+   * @param bestParameters Matrix to store the best candidate into.
+   * @param categoricalDimensions Whether each dimension is categorical.
+   * @param numCategories The number of categories of each dimension.
+   * @return The objective of the best candidate.
+   */
+  template<typename FunctionType>
+  double Optimize(FunctionType& function,
+                  arma::mat& bestParameters,
+                  const std::vector<bool>& categoricalDimensions,
+                  const arma::Row<size_t>& numCategories);
+
+  //! Get the fraction of the training data used in the first round.
+  double MinFraction() const { return minFraction; }
+  //! Modify the fraction of the training data used in the first round.
+  double& MinFraction() { return minFraction; }
+
+  //! Get the reduction factor.
+  double Eta() const { return eta; }
+  //! Modify the reduction factor.
+  double& Eta() { return eta; }
+
+  //! Get whether the candidates are assessed concurrently.
+  bool Parallel() const { return parallel; }
+  //! Modify whether the candidates are assessed concurrently.
+  bool& Parallel() { return parallel; }
+
+ private:
+  //! The fraction of the training data used in the first round.
+  double minFraction;
+
+  //! The reduction factor.
+  double eta;
+
+  //! Whether the candidates are assessed concurrently.
+  bool parallel;
+};
+
+} // namespace hpt
+} // namespace mlpack
+
+// Include implementation.
+#include "successive_halving_impl.hpp"
+
+#endif
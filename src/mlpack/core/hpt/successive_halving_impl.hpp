@@ -0,0 +1,112 @@
+/**
+ * @file core/hpt/successive_halving_impl.hpp
+ *
+ * Implementation of the SuccessiveHalving optimizer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_SUCCESSIVE_HALVING_IMPL_HPP
+#define MLPACK_CORE_HPT_SUCCESSIVE_HALVING_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "successive_halving.hpp"
+
+namespace mlpack {
+namespace hpt {
+
+inline SuccessiveHalving::SuccessiveHalving(const double minFraction,
+                                            const double eta,
+                                            const bool parallel) :
+    minFraction(minFraction),
+    eta(eta),
+    parallel(parallel)
+{
+  // Nothing to do.
+}
+
+template<typename FunctionType>
+double SuccessiveHalving::Optimize(
+    FunctionType& function,
+    arma::mat& bestParameters,
+    const std::vector<bool>& categoricalDimensions,
+    const arma::Row<size_t>& numCategories)
+{
+  if (minFraction <= 0.0 || minFraction > 1.0)
+    throw std::invalid_argument("SuccessiveHalving::Optimize(): minFraction "
+        "should be more than 0 and at most 1");
+  if (eta <= 1.0)
+    throw std::invalid_argument("SuccessiveHalving::Optimize(): eta should be "
+        "more than 1");
+
+  // Count all combinations of the categories.
+  size_t numCandidates = 1;
+  for (size_t d = 0; d < categoricalDimensions.size(); ++d)
+  {
+    if (!categoricalDimensions[d] || numCategories[d] == 0)
+    {
+      std::ostringstream oss;
+      oss << "SuccessiveHalving::Optimize(): dimension " << d << " should be "
+          << "categorical with at least one category; pass a set of values "
+          << "for each hyper-parameter that is not fixed" << std::endl;
+      throw std::invalid_argument(oss.str());
+    }
+
+    numCandidates *= numCategories[d];
+  }
+
+  arma::mat candidates(categoricalDimensions.size(), numCandidates);
+  for (size_t c = 0; c < numCandidates; ++c)
+  {
+    size_t remainder = c;
+    for (size_t d = 0; d < categoricalDimensions.size(); ++d)
+    {
+      candidates(d, c) = remainder % numCategories[d];
+      remainder /= numCategories[d];
+    }
+  }
+
+  // Each round assesses the remaining candidates on a larger part of the
+  // training data; the last round always uses all of it, so the objective we
+  // return (and the best model kept by the function) can be compared with
+  // other optimizers.
+  double fraction = (numCandidates == 1) ? 1.0 : minFraction;
+  arma::vec objectives;
+  try
+  {
+    while (true)
+    {
+      function.TrainingFraction(fraction);
+      function.EvaluateCandidates(candidates, objectives, parallel);
+
+      // Candidates whose assessment failed are considered the worst.
+      objectives.replace(arma::datum::nan, std::numeric_limits<double>::max());
+
+      if (fraction == 1.0)
+        break;
+
+      const size_t numKept = (size_t) std::ceil(candidates.n_cols / eta);
+      const arma::uvec order = arma::stable_sort_index(objectives);
+      candidates = candidates.cols(order.head(numKept));
+      fraction = (numKept == 1) ? 1.0 : std::min(fraction * eta, 1.0);
+    }
+  }
+  catch (...)
+  {
+    // Do not leave the cross-validation object with a part of the data.
+    function.TrainingFraction(1.0);
+    throw;
+  }
+
+  const size_t best = objectives.index_min();
+  bestParameters = candidates.col(best);
+
+  return objectives[best];
+}
+
+} // namespace hpt
+} // namespace mlpack
+
+#endif
@@ -89,6 +89,9 @@ class EpanechnikovKernel
    */
   double Normalizer(const size_t dimension);
 
+  //! Get the bandwidth of the kernel.
+  double Bandwidth() const { return bandwidth; }
+
   /**
    * Serialize the kernel.
    */
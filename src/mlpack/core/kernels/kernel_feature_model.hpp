@@ -0,0 +1,149 @@
+/**
+ * @file core/kernels/kernel_feature_model.hpp
+ *
+ * A model trained on an explicit feature map of its data, such as random
+ * Fourier features or Nystroem features, which approximates a kernel machine.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_KERNEL_FEATURE_MODEL_HPP
+#define MLPACK_CORE_KERNELS_KERNEL_FEATURE_MODEL_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace kernel {
+
+/**
+ * A KernelFeatureModel holds a feature map and a (usually linear) model that is
+ * trained on the mapped data.  Train() fits the feature map to the data, maps
+ * the data and trains the model on it; Classify() and Predict() map the points
+ * before passing them to the model.  With a feature map that approximates a
+ * kernel, this gives an approximate kernel machine whose training and
+ * prediction are linear in the number of points, without ever forming the
+ * kernel matrix.  The feature map is serialized with the model, so that the
+ * same features are used when a saved model is loaded.
+ *
+ * @code
+ * extern arma::mat data, testData;
+ * extern arma::Row<size_t> labels;
+ * KernelFeatureModel<RandomFourierFeatures<GaussianKernel>,
+ *     regression::LogisticRegression<>> model(
+ *     RandomFourierFeatures<GaussianKernel>(1024, GaussianKernel(2.0)));
+ * model.Train(data, labels);
+ *
+ * arma::Row<size_t> predictions;
+ * model.Classify(testData, predictions);
+ * @endcode
+ *
+ * The FeatureMapType must provide
+ *
+ * @code
+ * // Fit the map to the training points.
+ * void Train(const arma::mat& data);
+ * // Map the given points (one per column) to the features.
+ * void Transform(const arma::mat& input, arma::mat& output) const;
+ * @endcode
+ *
+ * as RandomFourierFeatures and NystroemFeatures do.
+ *
+ * @tparam FeatureMapType Feature map to apply to the data.
+ * @tparam ModelType Model trained on the features.
+ */
+template<typename FeatureMapType, typename ModelType>
+class KernelFeatureModel
+{
+ public:
+  /**
+   * Create the model with the given (untrained) feature map and model.
+   *
+   * @param featureMap Feature map to apply to the data.
+   * @param model Model to train on the features.
+   */
+  KernelFeatureModel(const FeatureMapType& featureMap = FeatureMapType(),
+                     const ModelType& model = ModelType()) :
+      featureMap(featureMap),
+      model(model)
+  { }
+
+  /**
+   * Fit the feature map to the given data, then train the model on the mapped
+   * data.  The other arguments (labels, responses, and so on) are passed to the
+   * Train() function of the model.
+   *
+   * @param data Training points, one per column.
+   * @param args Other arguments of ModelType::Train().
+   */
+  template<typename... Args>
+  void Train(const arma::mat& data, Args&&... args)
+  {
+    featureMap.Train(data);
+
+    arma::mat features;
+    featureMap.Transform(data, features);
+    model.Train(features, std::forward<Args>(args)...);
+  }
+
+  /**
+   * Map the given points and classify them with the model.  The other
+   * arguments (predictions, probabilities, and so on) are passed to the
+   * Classify() function of the model.
+   *
+   * @param data Points to classify, one per column.
+   * @param args Other arguments of ModelType::Classify().
+   */
+  template<typename... Args>
+  void Classify(const arma::mat& data, Args&&... args) const
+  {
+    arma::mat features;
+    featureMap.Transform(data, features);
+    model.Classify(features, std::forward<Args>(args)...);
+  }
+
+  /**
+   * Map the given points and compute the predictions of the model for them.
+   * The other arguments are passed to the Predict() function of the model.
+   *
+   * @param data Points to predict for, one per column.
+   * @param args Other arguments of ModelType::Predict().
+   */
+  template<typename... Args>
+  void Predict(const arma::mat& data, Args&&... args) const
+  {
+    arma::mat features;
+    featureMap.Transform(data, features);
+    model.Predict(features, std::forward<Args>(args)...);
+  }
+
+  //! Get the feature map.
+  const FeatureMapType& FeatureMap() const { return featureMap; }
+  //! Modify the feature map.
+  FeatureMapType& FeatureMap() { return featureMap; }
+
+  //! Get the model trained on the features.
+  const ModelType& Model() const { return model; }
+  //! Modify the model trained on the features.
+  ModelType& Model() { return model; }
+
+  //! Serialize the feature map and the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(featureMap));
+    ar(CEREAL_NVP(model));
+  }
+
+ private:
+  //! The feature map.
+  FeatureMapType featureMap;
+  //! The model trained on the features.
+  ModelType model;
+};
+
+} // namespace kernel
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,237 @@
+/**
+ * @file core/kernels/kernel_matrix.hpp
+ *
+ * Functions that compute the kernel matrix between two sets of points, or of a
+ * set of points with itself, with matrix products where the kernel allows it
+ * and in parallel blocks otherwise.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+#define MLPACK_CORE_KERNELS_KERNEL_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "linear_kernel.hpp"
+#include "polynomial_kernel.hpp"
+#include "hyperbolic_tangent_kernel.hpp"
+#include "cosine_distance.hpp"
+#include "gaussian_kernel.hpp"
+#include "laplacian_kernel.hpp"
+#include "epanechnikov_kernel.hpp"
+#include "spherical_kernel.hpp"
+#include "triangular_kernel.hpp"
+
+namespace mlpack {
+namespace kernel {
+
+/**
+ * This template class tells KernelMatrix() how the kernel matrix of a kernel
+ * can be computed.  By default each entry is computed with a call to
+ * KernelType::Evaluate(a, b).  A kernel can instead be declared as
+ *
+ *  - a dot-product kernel, if K(a, b) is a function of a^T b (and of the norms
+ *    of a and b).  The products are then computed with one matrix product,
+ *    and transformed with an overload of TransformDotProducts() for the
+ *    kernel, which must exist.
+ *  - a distance kernel, if K(a, b) only depends on the Euclidean distance
+ *    between a and b and KernelType::Evaluate(double) computes it from that
+ *    distance.  The distances are then computed from one matrix product.
+ */
+template<typename KernelType>
+class KernelMatrixTraits
+{
+ public:
+  //! If true, the kernel is a function of the dot product.
+  static const bool IsDotProductKernel = false;
+  //! If true, the kernel is a function of the Euclidean distance.
+  static const bool IsDistanceKernel = false;
+};
+
+/**
+ * Compute the kernel matrix between the points of a and the points of b, so
+ * that kernelMatrix(i, j) is the kernel evaluated between the i'th point of a
+ * and the j'th point of b.  For the kernels declared in KernelMatrixTraits the
+ * matrix is computed with a (multithreaded, BLAS) matrix product followed by an
+ * elementwise transformation.  For other kernels the matrix is split into
+ * square blocks that are filled in parallel, so KernelType::Evaluate() must be
+ * safe to call from several threads at once (this is the case for all kernels
+ * in mlpack).
+ *
+ * @param a First set of points, one per column.
+ * @param b Second set of points, one per column.
+ * @param kernel Kernel to evaluate.
+ * @param kernelMatrix Matrix to store the kernel matrix in.
+ */
+template<typename KernelType>
+void KernelMatrix(const arma::mat& a,
+                  const arma::mat& b,
+                  KernelType& kernel,
+                  arma::mat& kernelMatrix);
+
+/**
+ * Compute the symmetric kernel matrix of the given points with themselves.
+ * When the kernel is evaluated pair by pair, only the blocks on and above the
+ * diagonal are evaluated (in parallel); the others are copied from them.
+ *
+ * @param data Points, one per column.
+ * @param kernel Kernel to evaluate.
+ * @param kernelMatrix Matrix to store the kernel matrix in.
+ */
+template<typename KernelType>
+void KernelMatrix(const arma::mat& data,
+                  KernelType& kernel,
+                  arma::mat& kernelMatrix);
+
+/**
+ * Replace each of the given distances with the value of the kernel at that
+ * distance, as computed by KernelType::Evaluate(double).  By default the
+ * kernel is evaluated on each distance, in parallel; the Gaussian, Epanechnikov
+ * and triangular kernels have overloads that transform the whole matrix with
+ * vectorized expressions instead.  This is used by KernelMatrix() for distance
+ * kernels, and by algorithms that compute blocks of distances themselves.
+ *
+ * @param kernel Kernel to evaluate.
+ * @param distances Distances, to be replaced with the kernel values.
+ */
+template<typename KernelType>
+void TransformDistances(const KernelType& kernel, arma::mat& distances);
+
+//! Transform distances into the values of the Gaussian kernel, with one
+//! vectorized exponential.
+inline void TransformDistances(const GaussianKernel& kernel,
+                               arma::mat& distances);
+
+//! Transform distances into the values of the Epanechnikov kernel, which is a
+//! polynomial of the distance (clamped at zero).
+inline void TransformDistances(const EpanechnikovKernel& kernel,
+                               arma::mat& distances);
+
+//! Transform distances into the values of the triangular kernel, which is
+//! linear in the distance (clamped at zero).
+inline void TransformDistances(const TriangularKernel& kernel,
+                               arma::mat& distances);
+
+/**
+ * Transform the dot products of the points of a with the points of b into the
+ * values of the given kernel.  There is one overload for each dot-product
+ * kernel.
+ *
+ * @param kernel Kernel to evaluate.
+ * @param a First set of points, one per column.
+ * @param b Second set of points, one per column.
+ * @param products Dot products, to be replaced with the kernel values.
+ */
+inline void TransformDotProducts(const LinearKernel& kernel,
+                                 const arma::mat& a,
+                                 const arma::mat& b,
+                                 arma::mat& products);
+
+//! Transform dot products into the values of the polynomial kernel.
+inline void TransformDotProducts(const PolynomialKernel& kernel,
+                                 const arma::mat& a,
+                                 const arma::mat& b,
+                                 arma::mat& products);
+
+//! Transform dot products into the values of the hyperbolic tangent kernel.
+inline void TransformDotProducts(const HyperbolicTangentKernel& kernel,
+                                 const arma::mat& a,
+                                 const arma::mat& b,
+                                 arma::mat& products);
+
+//! Transform dot products into the values of the cosine distance.
+inline void TransformDotProducts(const CosineDistance& kernel,
+                                 const arma::mat& a,
+                                 const arma::mat& b,
+                                 arma::mat& products);
+
+//! The linear kernel is the dot product.
+template<>
+class KernelMatrixTraits<LinearKernel>
+{
+ public:
+  static const bool IsDotProductKernel = true;
+  static const bool IsDistanceKernel = false;
+};
+
+//! The polynomial kernel is a power of the dot product.
+template<>
+class KernelMatrixTraits<PolynomialKernel>
+{
+ public:
+  static const bool IsDotProductKernel = true;
+  static const bool IsDistanceKernel = false;
+};
+
+//! The hyperbolic tangent kernel is a tanh of the dot product.
+template<>
+class KernelMatrixTraits<HyperbolicTangentKernel>
+{
+ public:
+  static const bool IsDotProductKernel = true;
+  static const bool IsDistanceKernel = false;
+};
+
+//! The cosine distance is the normalized dot product.
+template<>
+class KernelMatrixTraits<CosineDistance>
+{
+ public:
+  static const bool IsDotProductKernel = true;
+  static const bool IsDistanceKernel = false;
+};
+
+//! The Gaussian kernel is a function of the distance.
+template<>
+class KernelMatrixTraits<GaussianKernel>
+{
+ public:
+  static const bool IsDotProductKernel = false;
+  static const bool IsDistanceKernel = true;
+};
+
+//! The Laplacian kernel is a function of the distance.
+template<>
+class KernelMatrixTraits<LaplacianKernel>
+{
+ public:
+  static const bool IsDotProductKernel = false;
+  static const bool IsDistanceKernel = true;
+};
+
+//! The Epanechnikov kernel is a function of the distance.
+template<>
+class KernelMatrixTraits<EpanechnikovKernel>
+{
+ public:
+  static const bool IsDotProductKernel = false;
+  static const bool IsDistanceKernel = true;
+};
+
+//! The spherical kernel is a function of the distance.
+template<>
+class KernelMatrixTraits<SphericalKernel>
+{
+ public:
+  static const bool IsDotProductKernel = false;
+  static const bool IsDistanceKernel = true;
+};
+
+//! The triangular kernel is a function of the distance.
+template<>
+class KernelMatrixTraits<TriangularKernel>
+{
+ public:
+  static const bool IsDotProductKernel = false;
+  static const bool IsDistanceKernel = true;
+};
+
+} // namespace kernel
+} // namespace mlpack
+
+// Include implementation.
+#include "kernel_matrix_impl.hpp"
+
+#endif
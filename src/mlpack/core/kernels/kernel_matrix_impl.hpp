@@ -0,0 +1,233 @@
+/**
+ * @file core/kernels/kernel_matrix_impl.hpp
+ *
+ * Implementation of the kernel matrix computations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_KERNEL_MATRIX_IMPL_HPP
+#define MLPACK_CORE_KERNELS_KERNEL_MATRIX_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "kernel_matrix.hpp"
+
+namespace mlpack {
+namespace kernel {
+
+//! The number of points on each side of a block of the kernel matrix; a block
+//! of points of this size fits in cache for moderate dimensionalities.
+static const size_t KernelMatrixBlockSize = 64;
+
+//! Tags that select how a kernel matrix is computed.
+struct PairwiseKernelMatrixTag { };
+struct DotProductKernelMatrixTag { };
+struct DistanceKernelMatrixTag { };
+
+//! The tag to use for the given kernel.
+template<typename KernelType>
+using KernelMatrixTag = typename std::conditional<
+    KernelMatrixTraits<KernelType>::IsDotProductKernel,
+    DotProductKernelMatrixTag,
+    typename std::conditional<
+        KernelMatrixTraits<KernelType>::IsDistanceKernel,
+        DistanceKernelMatrixTag,
+        PairwiseKernelMatrixTag>::type>::type;
+
+/**
+ * Evaluate the kernel on each pair of points, in parallel blocks.  If b is the
+ * same set as a, only the blocks on and above the diagonal are evaluated.
+ */
+template<typename KernelType>
+void KernelMatrix(const arma::mat& a,
+                  const arma::mat& b,
+                  const bool sameSet,
+                  KernelType& kernel,
+                  arma::mat& kernelMatrix,
+                  const PairwiseKernelMatrixTag& /* tag */)
+{
+  kernelMatrix.set_size(a.n_cols, b.n_cols);
+
+  // Enumerate the blocks to evaluate.
+  const size_t rowBlocks = (a.n_cols + KernelMatrixBlockSize - 1) /
+      KernelMatrixBlockSize;
+  const size_t colBlocks = (b.n_cols + KernelMatrixBlockSize - 1) /
+      KernelMatrixBlockSize;
+  std::vector<std::pair<size_t, size_t>> blocks;
+  blocks.reserve(rowBlocks * colBlocks);
+  for (size_t j = 0; j < colBlocks; ++j)
+    for (size_t i = 0; i < (sameSet ? j + 1 : rowBlocks); ++i)
+      blocks.push_back(std::make_pair(i, j));
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t block = 0; block < (omp_size_t) blocks.size(); ++block)
+  {
+    const size_t rowBegin = blocks[block].first * KernelMatrixBlockSize;
+    const size_t rowEnd = std::min(rowBegin + KernelMatrixBlockSize,
+        (size_t) a.n_cols);
+    const size_t colBegin = blocks[block].second * KernelMatrixBlockSize;
+    const size_t colEnd = std::min(colBegin + KernelMatrixBlockSize,
+        (size_t) b.n_cols);
+
+    for (size_t j = colBegin; j < colEnd; ++j)
+    {
+      // On a diagonal block of a symmetric matrix only the upper triangle is
+      // evaluated.
+      const size_t end = (sameSet && rowBegin == colBegin) ? j + 1 : rowEnd;
+      for (size_t i = rowBegin; i < end; ++i)
+        kernelMatrix(i, j) = kernel.Evaluate(a.col(i), b.col(j));
+    }
+  }
+
+  if (sameSet)
+    kernelMatrix = arma::symmatu(kernelMatrix);
+}
+
+/**
+ * Compute the dot products with one matrix product, and transform them into
+ * kernel values.
+ */
+template<typename KernelType>
+void KernelMatrix(const arma::mat& a,
+                  const arma::mat& b,
+                  const bool sameSet,
+                  KernelType& kernel,
+                  arma::mat& kernelMatrix,
+                  const DotProductKernelMatrixTag& /* tag */)
+{
+  if (sameSet)
+    kernelMatrix = a.t() * a;
+  else
+    kernelMatrix = a.t() * b;
+
+  TransformDotProducts(kernel, a, b, kernelMatrix);
+}
+
+/**
+ * Compute the squared distances from one matrix product as
+ * ||a||^2 + ||b||^2 - 2 a^T b, and evaluate the kernel on the distances in
+ * parallel.
+ */
+template<typename KernelType>
+void KernelMatrix(const arma::mat& a,
+                  const arma::mat& b,
+                  const bool sameSet,
+                  KernelType& kernel,
+                  arma::mat& kernelMatrix,
+                  const DistanceKernelMatrixTag& /* tag */)
+{
+  const arma::vec aNorms = arma::sum(arma::square(a), 0).t();
+  if (sameSet)
+  {
+    kernelMatrix = -2.0 * (a.t() * a);
+    kernelMatrix.each_col() += aNorms;
+    kernelMatrix.each_row() += aNorms.t();
+    // The distance of a point to itself is known exactly.
+    kernelMatrix.diag().zeros();
+  }
+  else
+  {
+    kernelMatrix = -2.0 * (a.t() * b);
+    kernelMatrix.each_col() += aNorms;
+    kernelMatrix.each_row() += arma::sum(arma::square(b), 0);
+  }
+
+  // Rounding can make the squared distance of close points negative.
+  kernelMatrix = arma::sqrt(arma::clamp(kernelMatrix, 0.0, DBL_MAX));
+  TransformDistances(kernel, kernelMatrix);
+}
+
+template<typename KernelType>
+void KernelMatrix(const arma::mat& a,
+                  const arma::mat& b,
+                  KernelType& kernel,
+                  arma::mat& kernelMatrix)
+{
+  KernelMatrix(a, b, false, kernel, kernelMatrix,
+      KernelMatrixTag<KernelType>());
+}
+
+template<typename KernelType>
+void KernelMatrix(const arma::mat& data,
+                  KernelType& kernel,
+                  arma::mat& kernelMatrix)
+{
+  KernelMatrix(data, data, true, kernel, kernelMatrix,
+      KernelMatrixTag<KernelType>());
+}
+
+template<typename KernelType>
+void TransformDistances(const KernelType& kernel, arma::mat& distances)
+{
+  #pragma omp parallel for
+  for (omp_size_t j = 0; j < (omp_size_t) distances.n_cols; ++j)
+    for (size_t i = 0; i < distances.n_rows; ++i)
+      distances(i, j) = kernel.Evaluate(distances(i, j));
+}
+
+inline void TransformDistances(const GaussianKernel& kernel,
+                               arma::mat& distances)
+{
+  distances = arma::exp(kernel.Gamma() * arma::square(distances));
+}
+
+inline void TransformDistances(const EpanechnikovKernel& kernel,
+                               arma::mat& distances)
+{
+  const double inverseBandwidthSquared = 1.0 /
+      (kernel.Bandwidth() * kernel.Bandwidth());
+  distances = arma::clamp(1.0 - inverseBandwidthSquared *
+      arma::square(distances), 0.0, DBL_MAX);
+}
+
+inline void TransformDistances(const TriangularKernel& kernel,
+                               arma::mat& distances)
+{
+  distances = arma::clamp(1.0 - distances / kernel.Bandwidth(), 0.0, DBL_MAX);
+}
+
+inline void TransformDotProducts(const LinearKernel& /* kernel */,
+                                 const arma::mat& /* a */,
+                                 const arma::mat& /* b */,
+                                 arma::mat& /* products */)
+{
+  // The dot products are the kernel values.
+}
+
+inline void TransformDotProducts(const PolynomialKernel& kernel,
+                                 const arma::mat& /* a */,
+                                 const arma::mat& /* b */,
+                                 arma::mat& products)
+{
+  products = arma::pow(products + kernel.Offset(), kernel.Degree());
+}
+
+inline void TransformDotProducts(const HyperbolicTangentKernel& kernel,
+                                 const arma::mat& /* a */,
+                                 const arma::mat& /* b */,
+                                 arma::mat& products)
+{
+  products = arma::tanh(kernel.Scale() * products + kernel.Offset());
+}
+
+inline void TransformDotProducts(const CosineDistance& /* kernel */,
+                                 const arma::mat& a,
+                                 const arma::mat& b,
+                                 arma::mat& products)
+{
+  // The cosine similarity with a point of norm zero is zero.
+  arma::vec aScales = 1.0 / arma::sqrt(arma::sum(arma::square(a), 0).t());
+  aScales.elem(arma::find_nonfinite(aScales)).zeros();
+  arma::rowvec bScales = 1.0 / arma::sqrt(arma::sum(arma::square(b), 0));
+  bScales.elem(arma::find_nonfinite(bScales)).zeros();
+
+  products.each_col() %= aScales;
+  products.each_row() %= bScales;
+}
+
+} // namespace kernel
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,200 @@
+/**
+ * @file core/kernels/random_fourier_features.hpp
+ *
+ * An explicit feature map whose dot products approximate a shift-invariant
+ * kernel, built from random Fourier features.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_KERNELS_RANDOM_FOURIER_FEATURES_HPP
+#define MLPACK_CORE_KERNELS_RANDOM_FOURIER_FEATURES_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "gaussian_kernel.hpp"
+#include "laplacian_kernel.hpp"
+
+namespace mlpack {
+namespace kernel {
+
+/**
+ * The spectral distribution of a shift-invariant kernel: by Bochner's theorem
+ * the kernel is the Fourier transform of this distribution.  Specializations
+ * must provide a static Sample() function that draws frequencies from it; they
+ * exist for the GaussianKernel and the LaplacianKernel.
+ */
+template<typename KernelType>
+class FourierSpectrum;
+
+//! The spectrum of the GaussianKernel is a Gaussian with standard deviation
+//! 1 / bandwidth.
+template<>
+class FourierSpectrum<GaussianKernel>
+{
+ public:
+  /**
+   * Draw the given number of frequencies, one per row.
+   *
+   * @param kernel Kernel to draw frequencies for.
+   * @param dimensionality Dimensionality of the frequencies.
+   * @param numFeatures Number of frequencies to draw.
+   * @param frequencies Matrix to store the frequencies in.
+   */
+  static void Sample(const GaussianKernel& kernel,
+                     const size_t dimensionality,
+                     const size_t numFeatures,
+                     arma::mat& frequencies)
+  {
+    frequencies.randn(numFeatures, dimensionality);
+    frequencies /= kernel.Bandwidth();
+  }
+};
+
+//! The spectrum of the LaplacianKernel (which uses the Euclidean distance) is
+//! a multivariate Cauchy distribution with scale 1 / bandwidth.
+template<>
+class FourierSpectrum<LaplacianKernel>
+{
+ public:
+  /**
+   * Draw the given number of frequencies, one per row.
+   *
+   * @param kernel Kernel to draw frequencies for.
+   * @param dimensionality Dimensionality of the frequencies.
+   * @param numFeatures Number of frequencies to draw.
+   * @param frequencies Matrix to store the frequencies in.
+   */
+  static void Sample(const LaplacianKernel& kernel,
+                     const size_t dimensionality,
+                     const size_t numFeatures,
+                     arma::mat& frequencies)
+  {
+    // A multivariate Cauchy variable is a standard normal variable divided by
+    // the absolute value of an independent univariate one.
+    frequencies.randn(numFeatures, dimensionality);
+    const arma::vec scales = arma::abs(arma::randn<arma::vec>(numFeatures)) *
+        kernel.Bandwidth();
+    frequencies.each_col() /= scales;
+  }
+};
+
+/**
+ * Random Fourier features ("Random Features for Large-Scale Kernel Machines",
+ * Rahimi and Recht, 2007) map each point x to the D-dimensional vector
+ *
+ *   z(x) = sqrt(2 / D) cos(W x + b),
+ *
+ * where the D rows of W are drawn from the spectrum of the kernel and b is
+ * uniform in [0, 2 pi), so that z(x)^T z(y) approximates K(x, y).  A linear
+ * model trained on the features then approximates a kernel machine, in time
+ * linear in the number of points; mapping a batch of points is one matrix
+ * product followed by a cosine.
+ *
+ * Only shift-invariant kernels for which FourierSpectrum is specialized can be
+ * used.  The map is drawn by Train() and can be serialized with the model that
+ * uses it (see KernelFeatureModel).
+ *
+ * @code
+ * extern arma::mat data;
+ * RandomFourierFeatures<GaussianKernel> features(1024, GaussianKernel(2.0));
+ * features.Train(data);
+ * arma::mat mapped;
+ * features.Transform(data, mapped);
+ * @endcode
+ *
+ * @tparam KernelType Shift-invariant kernel to approximate.
+ */
+template<typename KernelType>
+class RandomFourierFeatures
+{
+ public:
+  /**
+   * Create the feature map; it is drawn by Train().
+   *
+   * @param numFeatures Number of random features D.
+   * @param kernel Kernel to approximate.
+   */
+  RandomFourierFeatures(const size_t numFeatures = 512,
+                        const KernelType& kernel = KernelType()) :
+      numFeatures(numFeatures),
+      kernel(kernel)
+  {
+    if (numFeatures == 0)
+    {
+      throw std::invalid_argument("RandomFourierFeatures::"
+          "RandomFourierFeatures(): number of features must be positive!");
+    }
+  }
+
+  /**
+   * Draw the frequencies and the offsets of the features for points of the
+   * dimensionality of the given data.  Only the dimensionality of the data is
+   * used.
+   *
+   * @param data Points the map will be applied to, one per column.
+   */
+  void Train(const arma::mat& data)
+  {
+    FourierSpectrum<KernelType>::Sample(kernel, data.n_rows, numFeatures,
+        frequencies);
+    offsets = 2.0 * M_PI * arma::randu<arma::vec>(numFeatures);
+  }
+
+  /**
+   * Map the given points to the feature space.
+   *
+   * @param input Points to map, one per column.
+   * @param output Matrix to store the features in (D x number of points).
+   */
+  void Transform(const arma::mat& input, arma::mat& output) const
+  {
+    if (input.n_rows != frequencies.n_cols)
+    {
+      std::ostringstream oss;
+      oss << "RandomFourierFeatures::Transform(): dimensionality of points ("
+          << input.n_rows << ") does not match the dimensionality of the map ("
+          << frequencies.n_cols << ")!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    output = frequencies * input;
+    output.each_col() += offsets;
+    output = std::sqrt(2.0 / numFeatures) * arma::cos(output);
+  }
+
+  //! Get the number of features.
+  size_t NumFeatures() const { return numFeatures; }
+  //! Get the kernel.
+  const KernelType& Kernel() const { return kernel; }
+  //! Get the frequencies (one per row).
+  const arma::mat& Frequencies() const { return frequencies; }
+  //! Get the offsets.
+  const arma::vec& Offsets() const { return offsets; }
+
+  //! Serialize the feature map.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(numFeatures));
+    ar(CEREAL_NVP(kernel));
+    ar(CEREAL_NVP(frequencies));
+    ar(CEREAL_NVP(offsets));
+  }
+
+ private:
+  //! The number of features.
+  size_t numFeatures;
+  //! The kernel to approximate.
+  KernelType kernel;
+  //! The frequencies of the features, one per row.
+  arma::mat frequencies;
+  //! The offsets of the features.
+  arma::vec offsets;
+};
+
+} // namespace kernel
+} // namespace mlpack
+
+#endif
@@ -60,7 +60,7 @@ class TriangularKernel
    */
   double Evaluate(const double distance) const
   {
-    return std::max(0.0, (1 - distance) / bandwidth);
+    return std::max(0.0, 1 - distance / bandwidth);
   }
 
   /**
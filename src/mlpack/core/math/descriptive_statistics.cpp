@@ -0,0 +1,242 @@
+/**
+ * @file core/math/descriptive_statistics.cpp
+ *
+ * Implementation of the DescriptiveStatistics class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "descriptive_statistics.hpp"
+#include "random.hpp"
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace math {
+
+DescriptiveStatistics::DescriptiveStatistics(const size_t sketchSize) :
+    sketchSize(sketchSize),
+    seed((size_t) RandInt(std::numeric_limits<int>::max())),
+    count(0)
+{
+  // Nothing to do.
+}
+
+void DescriptiveStatistics::Update(const arma::mat& data, const bool rowMajor)
+{
+  const size_t dimensions = rowMajor ? data.n_cols : data.n_rows;
+  const size_t points = rowMajor ? data.n_rows : data.n_cols;
+  if (points == 0)
+    return;
+
+  if (count > 0 && dimensions != Dimensionality())
+  {
+    std::ostringstream oss;
+    oss << "DescriptiveStatistics::Update(): dimensionality of points ("
+        << dimensions << ") does not match dimensionality of statistics ("
+        << Dimensionality() << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Each thread summarizes one contiguous range of the points, one block at a
+  // time, and the ranges are merged in order.
+  const size_t blockSize = std::max((size_t) 1,
+      BlockElements / std::max((size_t) 1, dimensions));
+  const size_t numBlocks = (points + blockSize - 1) / blockSize;
+  #ifdef HAS_OPENMP
+  const size_t numRanges = std::max((size_t) 1,
+      std::min((size_t) omp_get_max_threads(), numBlocks));
+  #else
+  const size_t numRanges = 1;
+  #endif
+
+  // The sketches of each range make their own random choices.
+  std::vector<DescriptiveStatistics> ranges(numRanges,
+      DescriptiveStatistics(sketchSize));
+  for (size_t r = 0; r < numRanges; ++r)
+    ranges[r].seed = seed + (r + 1) * dimensions;
+  seed += (numRanges + 1) * dimensions;
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t r = 0; r < (omp_size_t) numRanges; ++r)
+  {
+    const size_t rangeBegin = (r * numBlocks / numRanges) * blockSize;
+    const size_t rangeEnd = std::min(((r + 1) * numBlocks / numRanges) *
+        blockSize, points);
+    for (size_t begin = rangeBegin; begin < rangeEnd; begin += blockSize)
+    {
+      const size_t end = std::min(begin + blockSize, rangeEnd) - 1;
+      if (rowMajor)
+      {
+        ranges[r].UpdateBlock(data.rows(begin, end).t());
+      }
+      else
+      {
+        // The columns are contiguous, so they are used without a copy.
+        const arma::mat block(const_cast<double*>(data.colptr(begin)),
+            data.n_rows, end - begin + 1, false, true);
+        ranges[r].UpdateBlock(block);
+      }
+    }
+  }
+
+  for (size_t r = 0; r < numRanges; ++r)
+    *this += ranges[r];
+}
+
+DescriptiveStatistics& DescriptiveStatistics::operator+=(
+    const DescriptiveStatistics& other)
+{
+  if (other.sketchSize != sketchSize)
+  {
+    std::ostringstream oss;
+    oss << "DescriptiveStatistics::operator+=(): sketch size of statistics ("
+        << other.sketchSize << ") does not match sketch size of these "
+        << "statistics (" << sketchSize << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (other.count == 0)
+    return *this;
+
+  if (count > 0 && other.Dimensionality() != Dimensionality())
+  {
+    std::ostringstream oss;
+    oss << "DescriptiveStatistics::operator+=(): dimensionality of statistics "
+        << "(" << other.Dimensionality() << ") does not match dimensionality "
+        << "of these statistics (" << Dimensionality() << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (count == 0)
+  {
+    mins = other.mins;
+    maxs = other.maxs;
+    sketches = other.sketches;
+  }
+  else
+  {
+    mins = arma::min(mins, other.mins);
+    maxs = arma::max(maxs, other.maxs);
+    for (size_t i = 0; i < sketches.size(); ++i)
+      sketches[i] += other.sketches[i];
+  }
+
+  MergeMoments(other.count, other.means, other.m2, other.m3, other.m4);
+  return *this;
+}
+
+arma::vec DescriptiveStatistics::Variance(const bool population) const
+{
+  return m2 / (population ? count : count - 1.0);
+}
+
+arma::vec DescriptiveStatistics::StandardDeviation(const bool population) const
+{
+  return arma::sqrt(Variance(population));
+}
+
+arma::vec DescriptiveStatistics::Skewness(const bool population) const
+{
+  const double n = count;
+  const arma::vec s3 = arma::pow(StandardDeviation(population), 3);
+  if (population)
+    return m3 / (n * s3);
+  else
+    return n * m3 / ((n - 1) * (n - 2) * s3);
+}
+
+arma::vec DescriptiveStatistics::Kurtosis(const bool population) const
+{
+  const double n = count;
+  if (population)
+    return n * (m4 / arma::square(m2)) - 3;
+
+  const arma::vec s4 = arma::square(Variance(false));
+  const double norm3 = (3 * (n - 1) * (n - 1)) / ((n - 2) * (n - 3));
+  const double normC = (n * (n + 1)) / ((n - 1) * (n - 2) * (n - 3));
+  return normC * (m4 / s4) - norm3;
+}
+
+arma::vec DescriptiveStatistics::Quantile(const double q) const
+{
+  arma::vec quantiles(sketches.size());
+  for (size_t i = 0; i < sketches.size(); ++i)
+    quantiles[i] = sketches[i].Quantile(q);
+
+  return quantiles;
+}
+
+void DescriptiveStatistics::UpdateBlock(const arma::mat& block)
+{
+  if (sketches.empty())
+  {
+    for (size_t i = 0; i < block.n_rows; ++i)
+      sketches.push_back(QuantileSketch(sketchSize, seed + i));
+  }
+
+  for (size_t j = 0; j < block.n_cols; ++j)
+    for (size_t i = 0; i < block.n_rows; ++i)
+      sketches[i].Update(block(i, j));
+
+  if (count == 0)
+  {
+    mins = arma::min(block, 1);
+    maxs = arma::max(block, 1);
+  }
+  else
+  {
+    mins = arma::min(mins, arma::vec(arma::min(block, 1)));
+    maxs = arma::max(maxs, arma::vec(arma::max(block, 1)));
+  }
+
+  // The moments of the block are computed around its own mean, and then
+  // merged.
+  const arma::vec blockMeans = arma::mean(block, 1);
+  const arma::mat deviations = block.each_col() - blockMeans;
+  const arma::mat squares = arma::square(deviations);
+  MergeMoments(block.n_cols, blockMeans, arma::sum(squares, 1),
+      arma::sum(squares % deviations, 1), arma::sum(arma::square(squares), 1));
+}
+
+void DescriptiveStatistics::MergeMoments(const size_t otherCount,
+                                         const arma::vec& otherMeans,
+                                         const arma::vec& otherM2,
+                                         const arma::vec& otherM3,
+                                         const arma::vec& otherM4)
+{
+  if (count == 0)
+  {
+    count = otherCount;
+    means = otherMeans;
+    m2 = otherM2;
+    m3 = otherM3;
+    m4 = otherM4;
+    return;
+  }
+
+  // The pairwise updates of Chan et al. and Pebay: the central moments of the
+  // union are those of the parts plus corrections for the distance between
+  // the means.  The higher moments need the old lower ones.
+  const double nA = count;
+  const double nB = otherCount;
+  const double n = nA + nB;
+  const arma::vec delta = otherMeans - means;
+  const arma::vec delta2 = arma::square(delta);
+
+  m4 += otherM4 + arma::square(delta2) * (nA * nB * (nA * nA - nA * nB +
+      nB * nB) / (n * n * n)) + 6 * delta2 % (nA * nA * otherM2 + nB * nB *
+      m2) / (n * n) + 4 * delta % (nA * otherM3 - nB * m3) / n;
+  m3 += otherM3 + delta2 % delta * (nA * nB * (nA - nB) / (n * n)) +
+      3 * delta % (nA * otherM2 - nB * m2) / n;
+  m2 += otherM2 + delta2 * (nA * nB / n);
+  means += delta * (nB / n);
+  count += otherCount;
+}
+
+} // namespace math
+} // namespace mlpack
@@ -0,0 +1,185 @@
+/**
+ * @file core/math/descriptive_statistics.hpp
+ *
+ * Definition of the DescriptiveStatistics class, which accumulates the
+ * moments, extremes and quantile sketches of each dimension of a dataset in a
+ * single pass.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_DESCRIPTIVE_STATISTICS_HPP
+#define MLPACK_CORE_MATH_DESCRIPTIVE_STATISTICS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "quantile_sketch.hpp"
+
+namespace mlpack {
+namespace math {
+
+/**
+ * DescriptiveStatistics summarizes each dimension of a dataset: its mean,
+ * variance, skewness and kurtosis (from the central moments up to the
+ * fourth), its minimum and maximum, and a QuantileSketch for its median and
+ * other quantiles.  The data is read once, so a dataset can also be streamed
+ * through Update() in chunks:
+ *
+ * @code
+ * DescriptiveStatistics stats;
+ * while (ReadChunk(data)) // Some way of reading the data.
+ *   stats.Update(data);
+ *
+ * arma::vec variances = stats.Variance();
+ * arma::vec medians = stats.Quantile(0.5);
+ * @endcode
+ *
+ * Each thread summarizes a contiguous range of the points, one block at a
+ * time, and the summaries are merged with the pairwise updates of Chan et al.
+ * and Pebay, which are much more accurate than sums of powers.  Statistics
+ * collected separately can be merged with operator+=().
+ */
+class DescriptiveStatistics
+{
+ public:
+  /**
+   * Create empty statistics.  The dimensionality is set by the first call to
+   * Update().
+   *
+   * @param sketchSize Size parameter k of the quantile sketches; the rank
+   *     error of the quantiles is about 1.7 / k.
+   */
+  DescriptiveStatistics(const size_t sketchSize = 200);
+
+  /**
+   * Add the given points to the statistics.
+   *
+   * @param data Matrix of points, one per column (or one per row if rowMajor
+   *     is true).
+   * @param rowMajor If true, each row of the data is a point.
+   */
+  void Update(const arma::mat& data, const bool rowMajor = false);
+
+  /**
+   * Merge other statistics into these, as if the points of the other
+   * statistics had been added to these.
+   *
+   * @param other Statistics to merge.
+   */
+  DescriptiveStatistics& operator+=(const DescriptiveStatistics& other);
+
+  //! Get the dimensionality of the points (0 if there are none yet).
+  size_t Dimensionality() const { return means.n_elem; }
+  //! Get the number of points.
+  size_t Count() const { return count; }
+
+  //! Get the mean of each dimension.
+  const arma::vec& Mean() const { return means; }
+  //! Get the minimum of each dimension.
+  const arma::vec& Min() const { return mins; }
+  //! Get the maximum of each dimension.
+  const arma::vec& Max() const { return maxs; }
+
+  /**
+   * Get the variance of each dimension.
+   *
+   * @param population If true, the data is the whole population (divide by n
+   *     instead of n - 1).
+   */
+  arma::vec Variance(const bool population = false) const;
+
+  /**
+   * Get the standard deviation of each dimension.
+   *
+   * @param population If true, the data is the whole population.
+   */
+  arma::vec StandardDeviation(const bool population = false) const;
+
+  /**
+   * Get the skewness of each dimension.
+   *
+   * @param population If true, the data is the whole population; otherwise
+   *     the sample skewness is adjusted for the number of points.
+   */
+  arma::vec Skewness(const bool population = false) const;
+
+  /**
+   * Get the excess kurtosis of each dimension.
+   *
+   * @param population If true, the data is the whole population; otherwise
+   *     the sample kurtosis is adjusted for the number of points.
+   */
+  arma::vec Kurtosis(const bool population = false) const;
+
+  /**
+   * Estimate the given quantile of each dimension with the quantile sketches.
+   *
+   * @param q Quantile to estimate, in [0, 1].
+   */
+  arma::vec Quantile(const double q) const;
+
+  //! Get the quantile sketch of the given dimension.
+  const QuantileSketch& Sketch(const size_t dimension) const
+  {
+    return sketches[dimension];
+  }
+
+  //! Serialize the statistics.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(sketchSize));
+    ar(CEREAL_NVP(seed));
+    ar(CEREAL_NVP(count));
+    ar(CEREAL_NVP(means));
+    ar(CEREAL_NVP(m2));
+    ar(CEREAL_NVP(m3));
+    ar(CEREAL_NVP(m4));
+    ar(CEREAL_NVP(mins));
+    ar(CEREAL_NVP(maxs));
+    ar(CEREAL_NVP(sketches));
+  }
+
+ private:
+  //! Add the given block of points (one per column) to the statistics.
+  void UpdateBlock(const arma::mat& block);
+
+  //! Merge the moments of other points into these.
+  void MergeMoments(const size_t otherCount,
+                    const arma::vec& otherMeans,
+                    const arma::vec& otherM2,
+                    const arma::vec& otherM3,
+                    const arma::vec& otherM4);
+
+  //! The size parameter of the quantile sketches.
+  size_t sketchSize;
+  //! The seed of the quantile sketches.
+  size_t seed;
+  //! The number of points.
+  size_t count;
+  //! The mean of each dimension.
+  arma::vec means;
+  //! The sum of the squared deviations from the mean of each dimension.
+  arma::vec m2;
+  //! The sum of the cubed deviations from the mean of each dimension.
+  arma::vec m3;
+  //! The sum of the fourth powers of the deviations from the mean of each
+  //! dimension.
+  arma::vec m4;
+  //! The minimum of each dimension.
+  arma::vec mins;
+  //! The maximum of each dimension.
+  arma::vec maxs;
+  //! The quantile sketch of each dimension.
+  std::vector<QuantileSketch> sketches;
+
+  //! The number of values summarized by each thread at once.
+  static const size_t BlockElements = 65536;
+};
+
+} // namespace math
+} // namespace mlpack
+
+#endif
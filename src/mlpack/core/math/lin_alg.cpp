@@ -45,7 +45,11 @@ void mlpack::math::Center(const arma::mat& x, arma::mat& xCentered)
   // Get the mean of the elements in each row.
   arma::vec rowMean = arma::sum(x, 1) / x.n_cols;
 
-  xCentered = x - arma::repmat(rowMean, 1, x.n_cols);
+  // Subtract the mean in place, so that no temporary matrix of the size of x
+  // is needed.
+  if (&xCentered != &x)
+    xCentered = x;
+  xCentered.each_col() -= rowMean;
 }
 
 /**
@@ -30,12 +30,28 @@ void VectorPower(arma::vec& vec, const double power);
 /**
  * Creates a centered matrix, where centering is done by subtracting
  * the sum over the columns (a column vector) from each column of the matrix.
+ * x and xCentered may be the same matrix, in which case it is centered in
+ * place without any copy.
  *
  * @param x Input matrix
  * @param xCentered Matrix to write centered output into
  */
 void Center(const arma::mat& x, arma::mat& xCentered);
 
+/**
+ * Overwrite each column c of the given matrix with transformation * c.  The
+ * columns are transformed in blocks, so only one block of columns is copied at
+ * a time instead of the whole matrix.  The transformation must be square.
+ *
+ * @param transformation Square matrix to multiply each column by.
+ * @param x Matrix to transform in place.
+ * @param blockSize Number of columns transformed at a time.
+ */
+template<typename eT>
+void MultiplyInPlace(const arma::Mat<eT>& transformation,
+                     arma::Mat<eT>& x,
+                     const size_t blockSize = 4096);
+
 /**
  * Whitens a matrix using the singular value decomposition of the covariance
  * matrix. Whitening means the covariance matrix of the result is the identity
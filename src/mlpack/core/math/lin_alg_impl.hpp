@@ -22,6 +22,29 @@ inline size_t SvecIndex(size_t i, size_t j, size_t n)
   return (j-i) + (n*(n+1) - (n-i)*(n-i+1))/2;
 }
 
+template<typename eT>
+void MultiplyInPlace(const arma::Mat<eT>& transformation,
+                     arma::Mat<eT>& x,
+                     const size_t blockSize)
+{
+  if (transformation.n_rows != x.n_rows ||
+      transformation.n_cols != x.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "MultiplyInPlace(): transformation has size "
+        << transformation.n_rows << " x " << transformation.n_cols << ", but "
+        << "it must be " << x.n_rows << " x " << x.n_rows << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const size_t step = std::max(blockSize, (size_t) 1);
+  for (size_t begin = 0; begin < x.n_cols; begin += step)
+  {
+    const size_t end = std::min(begin + step, (size_t) x.n_cols);
+    x.cols(begin, end - 1) = transformation * x.cols(begin, end - 1);
+  }
+}
+
 } // namespace math
 } // namespace mlpack
 
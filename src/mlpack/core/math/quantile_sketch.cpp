@@ -0,0 +1,160 @@
+/**
+ * @file core/math/quantile_sketch.cpp
+ *
+ * Implementation of the QuantileSketch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "quantile_sketch.hpp"
+
+namespace mlpack {
+namespace math {
+
+QuantileSketch::QuantileSketch(const size_t k, const size_t seed) :
+    k(k),
+    count(0),
+    size(0),
+    maxSize(0),
+    state(seed + 0x9E3779B97F4A7C15ULL)
+{
+  if (k < 2)
+  {
+    throw std::invalid_argument("QuantileSketch::QuantileSketch(): k must be "
+        "at least 2!");
+  }
+
+  // A zero state would only ever give zero bits.
+  if (state == 0)
+    state = 1;
+
+  Grow();
+}
+
+QuantileSketch& QuantileSketch::operator+=(const QuantileSketch& other)
+{
+  if (other.k != k)
+  {
+    std::ostringstream oss;
+    oss << "QuantileSketch::operator+=(): k of the other sketch (" << other.k
+        << ") does not match k of this sketch (" << k << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  while (compactors.size() < other.compactors.size())
+    Grow();
+
+  for (size_t h = 0; h < other.compactors.size(); ++h)
+  {
+    compactors[h].insert(compactors[h].end(), other.compactors[h].begin(),
+        other.compactors[h].end());
+  }
+  count += other.count;
+  size += other.size;
+
+  // Each compaction removes at least one value, and while the sketch is full
+  // some compactor is over its capacity.
+  while (size >= maxSize)
+    Compress();
+
+  return *this;
+}
+
+double QuantileSketch::Quantile(const double q) const
+{
+  if (q < 0.0 || q > 1.0)
+  {
+    std::ostringstream oss;
+    oss << "QuantileSketch::Quantile(): quantile " << q << " is not in "
+        << "[0, 1]!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (count == 0)
+    return std::numeric_limits<double>::quiet_NaN();
+
+  // Each value of compactor h stands for 2^h values of the stream, and the
+  // weights add up to the number of values.
+  std::vector<std::pair<double, size_t>> weighted;
+  weighted.reserve(size);
+  for (size_t h = 0; h < compactors.size(); ++h)
+  {
+    for (size_t i = 0; i < compactors[h].size(); ++i)
+      weighted.push_back(std::make_pair(compactors[h][i], size_t(1) << h));
+  }
+  std::sort(weighted.begin(), weighted.end());
+
+  const double target = q * count;
+  size_t rank = 0;
+  for (size_t i = 0; i < weighted.size(); ++i)
+  {
+    rank += weighted[i].second;
+    if (rank >= target)
+      return weighted[i].first;
+  }
+
+  return weighted.back().first;
+}
+
+size_t QuantileSketch::Capacity(const size_t level) const
+{
+  // The top compactor holds k values, and each one below holds 2/3 as many,
+  // but no fewer than 2.
+  const size_t depth = compactors.size() - level - 1;
+  return std::max((size_t) 2,
+      (size_t) std::ceil(k * std::pow(2.0 / 3.0, (double) depth)));
+}
+
+void QuantileSketch::Grow()
+{
+  compactors.push_back(std::vector<double>());
+
+  maxSize = 0;
+  for (size_t h = 0; h < compactors.size(); ++h)
+    maxSize += Capacity(h);
+}
+
+void QuantileSketch::Compress()
+{
+  for (size_t h = 0; h < compactors.size(); ++h)
+  {
+    if (compactors[h].size() < Capacity(h))
+      continue;
+
+    if (h + 1 == compactors.size())
+      Grow();
+
+    // Sort the compactor and promote every other value, keeping the last one
+    // if there is an odd number of them.
+    std::vector<double>& compactor = compactors[h];
+    std::sort(compactor.begin(), compactor.end());
+    const bool odd = (compactor.size() % 2 == 1);
+    const double last = compactor.back();
+    if (odd)
+      compactor.pop_back();
+
+    for (size_t i = (RandomBit() ? 1 : 0); i < compactor.size(); i += 2)
+      compactors[h + 1].push_back(compactor[i]);
+
+    size -= compactor.size() / 2;
+    compactor.clear();
+    if (odd)
+      compactor.push_back(last);
+
+    return;
+  }
+}
+
+bool QuantileSketch::RandomBit()
+{
+  // xorshift64.
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return (state >> 32) & 1;
+}
+
+} // namespace math
+} // namespace mlpack
@@ -0,0 +1,142 @@
+/**
+ * @file core/math/quantile_sketch.hpp
+ *
+ * Definition of the QuantileSketch class, which estimates the quantiles of a
+ * stream of values in a small amount of memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_QUANTILE_SKETCH_HPP
+#define MLPACK_CORE_MATH_QUANTILE_SKETCH_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * A KLL sketch of a stream of values, which answers quantile queries with a
+ * rank error of about 1.7 / k of the number of values, whatever their
+ * distribution, while keeping only O(k) of them (plus a few per doubling of
+ * the stream).  For more information, see the following paper:
+ *
+ * @code
+ * @inproceedings{karnin2016optimal,
+ *   title={Optimal Quantile Approximation in Streams},
+ *   author={Karnin, Zohar and Lang, Kevin and Liberty, Edo},
+ *   booktitle={Proceedings of the 57th Annual IEEE Symposium on Foundations
+ *       of Computer Science (FOCS '16)},
+ *   pages={71--78},
+ *   year={2016}
+ * }
+ * @endcode
+ *
+ * The values are kept in a hierarchy of compactors; a value in compactor h
+ * stands for 2^h values of the stream.  When the sketch is full, the first
+ * compactor over its capacity is sorted and every other value (starting from
+ * a random one of the first two) is promoted to the next compactor.  Sketches
+ * of different parts of a stream (for instance, built by different threads)
+ * can be merged with operator+=(), and the merged sketch has the same
+ * guarantees as a sketch of the whole stream.
+ *
+ * @code
+ * QuantileSketch sketch;
+ * for (size_t i = 0; i < values.n_elem; ++i)
+ *   sketch.Update(values[i]);
+ * const double median = sketch.Quantile(0.5);
+ * @endcode
+ */
+class QuantileSketch
+{
+ public:
+  /**
+   * Create an empty sketch.
+   *
+   * @param k Size parameter of the sketch; the rank error is about 1.7 / k.
+   * @param seed Seed of the random choices made by the compactions.
+   */
+  QuantileSketch(const size_t k = 200, const size_t seed = 0);
+
+  /**
+   * Add a value to the sketch.
+   *
+   * @param value Value to add.
+   */
+  void Update(const double value)
+  {
+    compactors[0].push_back(value);
+    ++count;
+    if (++size >= maxSize)
+      Compress();
+  }
+
+  /**
+   * Merge another sketch into this one, as if the values of the other sketch
+   * had been added to this one.  Both sketches must have the same k.
+   *
+   * @param other Sketch to merge.
+   */
+  QuantileSketch& operator+=(const QuantileSketch& other);
+
+  /**
+   * Estimate the given quantile of the values added to the sketch: the
+   * smallest retained value whose estimated rank is at least q times the
+   * number of values.  NaN is returned if the sketch is empty.
+   *
+   * @param q Quantile to estimate, in [0, 1].
+   */
+  double Quantile(const double q) const;
+
+  //! Get the size parameter k.
+  size_t K() const { return k; }
+  //! Get the number of values added to the sketch.
+  size_t Count() const { return count; }
+  //! Get the number of values retained by the sketch.
+  size_t Size() const { return size; }
+
+  //! Serialize the sketch.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(k));
+    ar(CEREAL_NVP(count));
+    ar(CEREAL_NVP(size));
+    ar(CEREAL_NVP(maxSize));
+    ar(CEREAL_NVP(compactors));
+    ar(CEREAL_NVP(state));
+  }
+
+ private:
+  //! Get the capacity of the given compactor; lower compactors are smaller.
+  size_t Capacity(const size_t level) const;
+
+  //! Add a compactor on top of the others.
+  void Grow();
+
+  //! Compact the first compactor that is over its capacity.
+  void Compress();
+
+  //! Return a random bit.
+  bool RandomBit();
+
+  //! The size parameter.
+  size_t k;
+  //! The number of values added to the sketch.
+  size_t count;
+  //! The number of retained values.
+  size_t size;
+  //! The total capacity of the compactors.
+  size_t maxSize;
+  //! The retained values of each compactor.
+  std::vector<std::vector<double>> compactors;
+  //! State of the generator of the random bits.
+  uint64_t state;
+};
+
+} // namespace math
+} // namespace mlpack
+
+#endif
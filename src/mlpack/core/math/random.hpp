@@ -30,6 +30,122 @@ extern MLPACK_EXPORT std::uniform_real_distribution<> randUniformDist;
 // Global normal distribution.
 extern MLPACK_EXPORT std::normal_distribution<> randNormalDist;
 
+/**
+ * A RandomStream is an independent stream of random numbers, seeded from a
+ * base seed and the index of a task.  While a RandomStream is alive, the random
+ * functions of this file (Random(), RandInt(), RandNormal() and so on) draw
+ * from it instead of the global generator on the thread that created it, so
+ * parallel code can draw random numbers without racing on the global generator
+ * and with results that do not depend on the number of threads:
+ *
+ * @code
+ * const size_t seed = math::RandomStreamSeed();
+ * #pragma omp parallel for
+ * for (omp_size_t i = 0; i < (omp_size_t) numTasks; ++i)
+ * {
+ *   math::RandomStream stream(seed, i);
+ *   // Every call to math::Random() here draws from the stream of task i.
+ * }
+ * @endcode
+ *
+ * Streams may be nested; the previous stream of the thread is restored when a
+ * stream is destroyed.  Armadillo's own random functions (such as
+ * arma::randu()) are not affected.
+ */
+class RandomStream
+{
+ public:
+  /**
+   * Create the stream of the given task and make it the current stream of the
+   * calling thread.
+   *
+   * @param seed Base seed shared by all the tasks; see RandomStreamSeed().
+   * @param task Index of the task.
+   */
+  RandomStream(const size_t seed, const size_t task) :
+      uniformDist(0.0, 1.0),
+      normalDist(0.0, 1.0),
+      previous(Current())
+  {
+    std::seed_seq seq = { (uint32_t) seed, (uint32_t) ((uint64_t) seed >> 32),
+        (uint32_t) task, (uint32_t) ((uint64_t) task >> 32) };
+    generator.seed(seq);
+    Current() = this;
+  }
+
+  //! Restore the previous stream of the calling thread.
+  ~RandomStream() { Current() = previous; }
+
+  // A stream is bound to the thread that created it.
+  RandomStream(const RandomStream&) = delete;
+  RandomStream& operator=(const RandomStream&) = delete;
+
+  //! Modify the generator of the stream.
+  std::mt19937& Generator() { return generator; }
+  //! Modify the uniform distribution of the stream.
+  std::uniform_real_distribution<>& UniformDist() { return uniformDist; }
+  //! Modify the normal distribution of the stream.
+  std::normal_distribution<>& NormalDist() { return normalDist; }
+
+  //! Get the current stream of the calling thread (NULL if there is none).
+  static RandomStream*& Current()
+  {
+    static thread_local RandomStream* current = NULL;
+    return current;
+  }
+
+ private:
+  //! The generator of the stream.
+  std::mt19937 generator;
+  //! The uniform distribution of the stream.
+  std::uniform_real_distribution<> uniformDist;
+  //! The normal distribution of the stream.
+  std::normal_distribution<> normalDist;
+  //! The stream that was current when this one was created.
+  RandomStream* previous;
+};
+
+/**
+ * Get the generator the random functions draw from on the calling thread: that
+ * of its current RandomStream, or the global generator if there is none.
+ */
+inline std::mt19937& RandGen()
+{
+  RandomStream* stream = RandomStream::Current();
+  return (stream == NULL) ? randGen : stream->Generator();
+}
+
+/**
+ * Get the uniform distribution the random functions use on the calling thread.
+ */
+inline std::uniform_real_distribution<>& RandUniformDist()
+{
+  RandomStream* stream = RandomStream::Current();
+  return (stream == NULL) ? randUniformDist : stream->UniformDist();
+}
+
+/**
+ * Get the normal distribution the random functions use on the calling thread.
+ */
+inline std::normal_distribution<>& RandNormalDist()
+{
+  RandomStream* stream = RandomStream::Current();
+  return (stream == NULL) ? randNormalDist : stream->NormalDist();
+}
+
+/**
+ * Draw a base seed for a set of RandomStreams from the generator of the calling
+ * thread.  Call this before entering a parallel region; the streams of its
+ * tasks then only depend on the seed given to RandomSeed() (or on the stream
+ * the region is nested in).
+ */
+inline size_t RandomStreamSeed()
+{
+  std::mt19937& generator = RandGen();
+  const uint64_t high = generator();
+  return (size_t) ((high << 32) | generator());
+}
+
 /**
  * Set the random seed used by the random functions (Random() and RandInt()).
  * The seed is casted to a 32-bit integer before being given to the random
@@ -82,7 +198,7 @@ inline void CustomRandomSeed(const size_t seed)
  */
 inline double Random()
 {
-  return randUniformDist(randGen);
+  return RandUniformDist()(RandGen());
 }
 
 /**
@@ -90,7 +206,7 @@ inline double Random()
  */
 inline double Random(const double lo, const double hi)
 {
-  return lo + (hi - lo) * randUniformDist(randGen);
+  return lo + (hi - lo) * RandUniformDist()(RandGen());
 }
 
 /**
@@ -109,7 +225,8 @@ inline double RandBernoulli(const double input)
  */
 inline int RandInt(const int hiExclusive)
 {
-  return (int) std::floor((double) hiExclusive * randUniformDist(randGen));
+  return (int) std::floor((double) hiExclusive *
+      RandUniformDist()(RandGen()));
 }
 
 /**
@@ -118,7 +235,7 @@ inline int RandInt(const int hiExclusive)
 inline int RandInt(const int lo, const int hiExclusive)
 {
   return lo + (int) std::floor((double) (hiExclusive - lo)
-                               * randUniformDist(randGen));
+                               * RandUniformDist()(RandGen()));
 }
 
 /**
@@ -126,7 +243,7 @@ inline int RandInt(const int lo, const int hiExclusive)
  */
 inline double RandNormal()
 {
-  return randNormalDist(randGen);
+  return RandNormalDist()(RandGen());
 }
 
 /**
@@ -138,22 +255,27 @@ inline double RandNormal()
  */
 inline double RandNormal(const double mean, const double variance)
 {
-  return variance * randNormalDist(randGen) + mean;
+  return variance * RandNormalDist()(RandGen()) + mean;
 }
 
 /**
- * Obtains no more than maxNumSamples distinct samples. Each sample belongs to
- * [loInclusive, hiExclusive).
+ * Obtains no more than maxNumSamples distinct samples, drawn with the given
+ * random number generator.  Each sample belongs to [loInclusive, hiExclusive).
+ * Giving each thread its own generator makes this safe to call from several
+ * threads at once.
  *
  * @param loInclusive The lower bound (inclusive).
  * @param hiExclusive The high bound (exclusive).
  * @param maxNumSamples The maximum number of samples to obtain.
  * @param distinctSamples The samples that will be obtained.
+ * @param generator The random number generator to draw the samples with.
  */
+template<typename RNGType>
 inline void ObtainDistinctSamples(const size_t loInclusive,
                                   const size_t hiExclusive,
                                   const size_t maxNumSamples,
-                                  arma::uvec& distinctSamples)
+                                  arma::uvec& distinctSamples,
+                                  RNGType& generator)
 {
   const size_t samplesRangeSize = hiExclusive - loInclusive;
 
@@ -163,8 +285,12 @@ inline void ObtainDistinctSamples(const size_t loInclusive,
 
     samples.zeros(samplesRangeSize);
 
+    std::uniform_real_distribution<> uniform;
     for (size_t i = 0; i < maxNumSamples; ++i)
-      samples [ (size_t) math::RandInt(samplesRangeSize) ]++;
+    {
+      samples[(size_t) std::floor((double) samplesRangeSize *
+          uniform(generator))]++;
+    }
 
     distinctSamples = arma::find(samples > 0);
 
@@ -179,6 +305,24 @@ inline void ObtainDistinctSamples(const size_t loInclusive,
   }
 }
 
+/**
+ * Obtains no more than maxNumSamples distinct samples. Each sample belongs to
+ * [loInclusive, hiExclusive).
+ *
+ * @param loInclusive The lower bound (inclusive).
+ * @param hiExclusive The high bound (exclusive).
+ * @param maxNumSamples The maximum number of samples to obtain.
+ * @param distinctSamples The samples that will be obtained.
+ */
+inline void ObtainDistinctSamples(const size_t loInclusive,
+                                  const size_t hiExclusive,
+                                  const size_t maxNumSamples,
+                                  arma::uvec& distinctSamples)
+{
+  ObtainDistinctSamples(loInclusive, hiExclusive, maxNumSamples,
+      distinctSamples, RandGen());
+}
+
 } // namespace math
 } // namespace mlpack
 
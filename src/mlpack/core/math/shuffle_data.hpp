@@ -237,6 +237,115 @@ void ShuffleData(const MatType& inputPoints,
   }
 }
 
+/**
+ * Shuffle the visitation order of a dataset without moving the dataset itself.
+ * The random ordering is drawn exactly as ShuffleData() draws it, so after the
+ * call, column i of the dataset that ShuffleData() would have produced (with
+ * the same random seed, and the same sequence of earlier shuffles) is column
+ * order[i] of the original dataset.  An empty order is taken to be the
+ * identity.  Batches of the shuffled dataset can be extracted with
+ * GatherColumns().
+ */
+template<typename MatType>
+void ShuffleOrder(const MatType& inputPoints,
+                  arma::uvec& order,
+                  const std::enable_if_t<!arma::is_SpMat<MatType>::value>* = 0)
+{
+  // Generate ordering.
+  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
+      inputPoints.n_cols - 1, inputPoints.n_cols));
+
+  if (order.n_elem == 0)
+    order = std::move(ordering);
+  else
+    order = arma::uvec(order.elem(ordering));
+}
+
+/**
+ * Shuffle the visitation order of a sparse dataset without moving the dataset
+ * itself.  For sparse data, ShuffleData() moves column i to column ordering[i],
+ * and the order is updated in the same way.
+ */
+template<typename MatType>
+void ShuffleOrder(const MatType& inputPoints,
+                  arma::uvec& order,
+                  const std::enable_if_t<arma::is_SpMat<MatType>::value>* = 0)
+{
+  // Generate ordering.
+  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
+      inputPoints.n_cols - 1, inputPoints.n_cols));
+
+  arma::uvec newOrder(inputPoints.n_cols);
+  for (size_t i = 0; i < ordering.n_elem; ++i)
+    newOrder[ordering[i]] = (order.n_elem == 0) ? i : order[i];
+
+  order = std::move(newOrder);
+}
+
+/**
+ * Extract the given batch of columns of a dataset whose visitation order was
+ * shuffled with ShuffleOrder(): column i of the result is column
+ * order[begin + i] of the dataset.  If the order is empty, the columns are
+ * contiguous.
+ */
+template<typename MatType>
+MatType GatherColumns(const MatType& points,
+                      const arma::uvec& order,
+                      const size_t begin,
+                      const size_t count,
+                      const std::enable_if_t<!arma::is_SpMat<MatType>::value>*
+                          = 0)
+{
+  if (order.n_elem == 0)
+    return MatType(points.cols(begin, begin + count - 1));
+
+  return MatType(points.cols(order.subvec(begin, begin + count - 1)));
+}
+
+/**
+ * Extract the given batch of columns of a sparse dataset whose visitation order
+ * was shuffled with ShuffleOrder().
+ */
+template<typename MatType>
+MatType GatherColumns(const MatType& points,
+                      const arma::uvec& order,
+                      const size_t begin,
+                      const size_t count,
+                      const std::enable_if_t<arma::is_SpMat<MatType>::value>*
+                          = 0)
+{
+  if (order.n_elem == 0)
+    return MatType(points.cols(begin, begin + count - 1));
+
+  size_t nonzeros = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    const size_t column = order[begin + i];
+    for (typename MatType::const_iterator it = points.begin_col(column);
+         it != points.end_col(column); ++it)
+      ++nonzeros;
+  }
+
+  // Columns are visited in order and rows are sorted within each column, so
+  // the locations are already sorted.
+  arma::umat locations(2, nonzeros);
+  arma::Col<typename MatType::elem_type> values(nonzeros);
+  size_t index = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    const size_t column = order[begin + i];
+    for (typename MatType::const_iterator it = points.begin_col(column);
+         it != points.end_col(column); ++it, ++index)
+    {
+      locations(0, index) = it.row();
+      locations(1, index) = i;
+      values(index) = (*it);
+    }
+  }
+
+  return MatType(locations, values, points.n_rows, count, false, false);
+}
+
 } // namespace math
 } // namespace mlpack
 
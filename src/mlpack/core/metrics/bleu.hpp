@@ -13,6 +13,7 @@
 #define MLPACK_CORE_METRICS_BLEU_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <unordered_map>
 
 namespace mlpack {
 namespace metric {
@@ -94,6 +95,12 @@ class BLEU
    * calculates other BLEU metrics (brevity penalty, translation length, reference
    * length, ratio and precisions) which can be accessed by their corresponding
    * accessor methods.
+   *
+   * The sentences are processed in parallel when OpenMP is enabled.  The
+   * tokens of each sentence and its references are mapped to integer IDs
+   * (integer tokens, such as the output of a tokenizer, are used as IDs
+   * directly) and the n-grams are counted in hash tables over these IDs, so
+   * the words are compared once per sentence rather than once per n-gram.
    */
   template <typename ReferenceCorpusType, typename TranslationCorpusType>
   ElemType Evaluate(const ReferenceCorpusType& referenceCorpus,
@@ -129,13 +136,66 @@ class BLEU
 
  private:
   /**
-   * Extracts all the n-grams.
+   * An n-gram, given as a sequence of token IDs in a flat buffer, with its
+   * hash.
+   */
+  struct NGram
+  {
+    //! The first token ID of the n-gram.
+    const size_t* tokens;
+    //! The number of tokens of the n-gram.
+    size_t order;
+    //! The hash of the token IDs.
+    size_t hash;
+
+    //! Compare the token IDs of two n-grams.
+    bool operator==(const NGram& other) const
+    {
+      return order == other.order && hash == other.hash &&
+          std::equal(tokens, tokens + order, other.tokens);
+    }
+  };
+
+  //! Hash an n-gram with its precomputed hash.
+  struct NGramHash
+  {
+    size_t operator()(const NGram& ngram) const { return ngram.hash; }
+  };
+
+  //! The counts of the n-grams of a segment.
+  typedef std::unordered_map<NGram, size_t, NGramHash> NGramCounts;
+
+  /**
+   * Count all the n-grams of order up to maxOrder of the given tokens.  The
+   * n-grams point into the given buffer of token IDs.
    *
-   * @tparam WordVector Type of the tokenized vector.
-   * @param segment Tokenized sequence represented in form of vector.
+   * @param tokens Token IDs of the segment.
+   * @param length Number of tokens of the segment.
+   * @param counts Map to store the counts of the n-grams in.
    */
-  template <typename WordVector>
-  std::map<WordVector, size_t> GetNGrams(const WordVector& segment);
+  void CountNGrams(const size_t* tokens,
+                   const size_t length,
+                   NGramCounts& counts) const;
+
+  //! Get the ID of an integer token, which is the token itself.
+  template<typename WordType>
+  static size_t TokenID(const WordType& word,
+                        std::map<WordType, size_t>& /* vocabulary */,
+                        const std::true_type /* isIntegral */)
+  {
+    return (size_t) word;
+  }
+
+  //! Get the ID of a token in the vocabulary of the sentence, adding it if
+  //! needed.
+  template<typename WordType>
+  static size_t TokenID(const WordType& word,
+                        std::map<WordType, size_t>& vocabulary,
+                        const std::false_type /* isIntegral */)
+  {
+    return vocabulary.insert(std::make_pair(word, vocabulary.size())).first->
+        second;
+  }
 
   //! Locally-stored value of maximum length of tokens in n-grams.
   size_t maxOrder;
@@ -28,21 +28,22 @@ BLEU<ElemType, PrecisionType>::BLEU(const size_t maxOrder) :
 }
 
 template <typename ElemType, typename PrecisionType>
-template <typename WordVector>
-std::map<WordVector, size_t> BLEU<ElemType, PrecisionType>::GetNGrams(
-    const WordVector& segment)
+void BLEU<ElemType, PrecisionType>::CountNGrams(const size_t* tokens,
+                                                const size_t length,
+                                                NGramCounts& counts) const
 {
-  std::map<WordVector, size_t> ngramsCount;
-  for (size_t order = 1; order < maxOrder + 1; ++order)
+  for (size_t i = 0; i < length; ++i)
   {
-    for (size_t i = 0; i + order < segment.size() + 1; ++i)
+    // The hash of each n-gram extends the hash of the n-gram one shorter.
+    size_t hash = 0;
+    for (size_t order = 1; order < maxOrder + 1 && i + order < length + 1;
+        ++order)
     {
-      WordVector seq = WordVector(segment.cbegin() + i,
-                                  segment.cbegin() + i + order);
-      ngramsCount[seq]++;
+      hash ^= tokens[i + order - 1] + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+      const NGram ngram = { tokens + i, order, hash };
+      counts[ngram]++;
     }
   }
-  return ngramsCount;
 }
 
 template <typename ElemType, typename PrecisionType>
@@ -55,6 +56,24 @@ ElemType BLEU<ElemType, PrecisionType>::Evaluate(
   // WordVector is a string container type.
   // Also, TranslationCorpusType is an array of such containers.
   typedef typename TranslationCorpusType::value_type WordVector;
+  typedef typename std::decay<decltype(*std::declval<WordVector>().cbegin())
+      >::type WordType;
+  typedef typename ReferenceCorpusType::value_type ReferencesType;
+  typedef std::integral_constant<bool, std::is_integral<WordType>::value>
+      IsIntegral;
+
+  // Collect the pairs of references and translations, so that they can be
+  // processed in parallel.
+  std::vector<const ReferencesType*> references;
+  std::vector<const WordVector*> translations;
+  auto refIt = referenceCorpus.cbegin();
+  auto trIt = translationCorpus.cbegin();
+  for (; refIt != referenceCorpus.cend() && trIt != translationCorpus.cend();
+      ++refIt, ++trIt)
+  {
+    references.push_back(&(*refIt));
+    translations.push_back(&(*trIt));
+  }
 
   // matchesByOrder: It catches how many times sequence of a particular order
   // is encountered in both reference corpus and translation corpus.
@@ -69,71 +88,110 @@ ElemType BLEU<ElemType, PrecisionType>::Evaluate(
   // translationLength: It is the sum of length of each paragraphs.
   referenceLength = 0, translationLength = 0;
 
-  auto refIt = referenceCorpus.cbegin();
-  auto trIt = translationCorpus.cbegin();
-  for (; refIt != referenceCorpus.cend() && trIt != translationCorpus.cend();
-      ++refIt, ++trIt)
+  #pragma omp parallel
   {
-    size_t min = std::numeric_limits<size_t>::max();
-    for (const auto& t : *refIt)
+    // Each thread accumulates its own counts, which are merged at the end.
+    std::vector<size_t> localMatches(maxOrder, 0);
+    std::vector<size_t> localPossibleMatches(maxOrder, 0);
+    size_t localReferenceLength = 0, localTranslationLength = 0;
+
+    // The buffers are reused from one sentence to the next.
+    std::map<WordType, size_t> vocabulary;
+    std::vector<size_t> ids;
+    std::vector<size_t> offsets;
+    NGramCounts referenceNGramCounts, mergedRefNGramCounts,
+        translationNGramCounts;
+
+    #pragma omp for schedule(dynamic, 64)
+    for (omp_size_t s = 0; s < (omp_size_t) translations.size(); ++s)
     {
-      if (min > t.size())
+      const ReferencesType& sentenceReferences = *references[s];
+      const WordVector& translation = *translations[s];
+
+      size_t min = std::numeric_limits<size_t>::max();
+      for (const auto& t : sentenceReferences)
       {
-        min = t.size();
+        if (min > t.size())
+        {
+          min = t.size();
+        }
       }
-    }
 
-    if (min == std::numeric_limits<size_t>::max())
-      min = 0;
+      if (min == std::numeric_limits<size_t>::max())
+        min = 0;
 
-    referenceLength += min;
-    translationLength += trIt->size();
+      localReferenceLength += min;
+      localTranslationLength += translation.size();
 
-    // mergedRefNGramCounts: It accumulates all the similar n-grams from
-    // various references or documents, so that there is no repetition of
-    // any key (sequence of order n).
-    std::map<WordVector, size_t> mergedRefNGramCounts;
-    for (const auto& t : *refIt)
-    {
-      // ngram: It holds the n-grams of each document/reference.
-      const std::map<WordVector, size_t> ngrams = GetNGrams(t);
-      for (auto it = ngrams.cbegin(); it != ngrams.cend(); ++it)
+      // Map the tokens of the references and of the translation to IDs in one
+      // flat buffer; the n-grams below point into it.
+      vocabulary.clear();
+      ids.clear();
+      offsets.assign(1, 0);
+      for (const auto& t : sentenceReferences)
       {
-        mergedRefNGramCounts[it->first] = std::max(it->second,
-            mergedRefNGramCounts[it->first]);
+        for (const auto& word : t)
+          ids.push_back(TokenID<WordType>(word, vocabulary, IsIntegral()));
+        offsets.push_back(ids.size());
       }
-    }
-    // translationNGramCounts: It extracts the n-grams of the generated text
-    // sequence.
-    const std::map<WordVector, size_t> translationNGramCounts
-        = GetNGrams(*trIt);
-
-    // overlap: It holds those keys (sequence of order n) which are common to
-    // reference corpus and translation corpus.
-    std::map<WordVector, size_t> overlap;
-    for (auto it = translationNGramCounts.cbegin();
-         it != translationNGramCounts.cend();
-         ++it)
-    {
-      auto mergedIt = mergedRefNGramCounts.find(it->first);
-      if (mergedIt != mergedRefNGramCounts.end())
+      for (const auto& word : translation)
+        ids.push_back(TokenID<WordType>(word, vocabulary, IsIntegral()));
+
+      // mergedRefNGramCounts: It accumulates all the similar n-grams from
+      // various references or documents, so that there is no repetition of
+      // any key (sequence of order n).
+      mergedRefNGramCounts.clear();
+      for (size_t r = 0; r + 1 < offsets.size(); ++r)
       {
-        // If the key (sequence of order n) is present in both translation
-        // corpus as well as reference corpus, then the minimum number of
-        // counts it has occurred in any is considered.
-        overlap[it->first] = std::min(mergedIt->second, it->second);
+        referenceNGramCounts.clear();
+        CountNGrams(ids.data() + offsets[r], offsets[r + 1] - offsets[r],
+            referenceNGramCounts);
+        for (auto it = referenceNGramCounts.cbegin();
+             it != referenceNGramCounts.cend();
+             ++it)
+        {
+          size_t& count = mergedRefNGramCounts[it->first];
+          count = std::max(it->second, count);
+        }
       }
-    }
 
-    for (auto it = overlap.cbegin(); it != overlap.cend(); ++it)
-    {
-      matchesByOrder[it->first.size() - 1] += it->second;
+      // translationNGramCounts: It extracts the n-grams of the generated text
+      // sequence.
+      translationNGramCounts.clear();
+      CountNGrams(ids.data() + offsets.back(), translation.size(),
+          translationNGramCounts);
+
+      for (auto it = translationNGramCounts.cbegin();
+           it != translationNGramCounts.cend();
+           ++it)
+      {
+        auto mergedIt = mergedRefNGramCounts.find(it->first);
+        if (mergedIt != mergedRefNGramCounts.end())
+        {
+          // If the key (sequence of order n) is present in both translation
+          // corpus as well as reference corpus, then the minimum number of
+          // counts it has occurred in any is considered.
+          localMatches[it->first.order - 1] += std::min(mergedIt->second,
+              it->second);
+        }
+      }
+
+      for (size_t order = 1; order < maxOrder + 1; ++order)
+      {
+        if (order < translation.size() + 1)
+          localPossibleMatches[order - 1] += translation.size() - order + 1;
+      }
     }
 
-    for (size_t order = 1; order < maxOrder + 1; ++order)
+    #pragma omp critical
     {
-      if (order < trIt->size() + 1)
-        possibleMatchesByOrder[order - 1] += trIt->size() - order + 1;
+      for (size_t i = 0; i < maxOrder; ++i)
+      {
+        matchesByOrder[i] += localMatches[i];
+        possibleMatchesByOrder[i] += localPossibleMatches[i];
+      }
+      referenceLength += localReferenceLength;
+      translationLength += localTranslationLength;
     }
   }
 
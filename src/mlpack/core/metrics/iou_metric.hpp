@@ -59,11 +59,42 @@ class IoU
   static typename VecTypeA::elem_type Evaluate(const VecTypeA& a,
                                                const VecTypeB& b);
 
+  /**
+   * Computes the Intersection over Union metric between every bounding box of
+   * a and every bounding box of b, in the same way as Evaluate(a, b).  The
+   * coordinates of each set of boxes are gathered into one contiguous array
+   * per coordinate first, so that the loop over the boxes of a is vectorized,
+   * and the columns of the result are computed in parallel.
+   *
+   * @tparam MatTypeA Type of the first set of bounding boxes.
+   * @tparam MatTypeB Type of the second set of bounding boxes.
+   * @param a First set of bounding boxes, one box per column.
+   * @param b Second set of bounding boxes, one box per column.
+   * @param ious Matrix to store the IoU of a.col(i) and b.col(j) in, as
+   *     ious(i, j).
+   */
+  template<typename MatTypeA, typename MatTypeB>
+  static void Evaluate(const MatTypeA& a,
+                       const MatTypeB& b,
+                       arma::Mat<typename MatTypeA::elem_type>& ious);
+
   static const bool useCoordinates = UseCoordinates;
 
   //! Serialize the metric.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Check the given bounding boxes and store their corners {x0, y0, x1, y1} as
+   * the columns of a matrix, with one row per box.
+   *
+   * @param boxes Bounding boxes, one box per column.
+   * @param corners Matrix to store the corners of the boxes in.
+   */
+  template<typename MatType>
+  static void Corners(const MatType& boxes,
+                      arma::Mat<typename MatType::elem_type>& corners);
 }; // class IoU
 
 } // namespace metric
@@ -64,6 +64,89 @@ typename VecTypeA::elem_type IoU<UseCoordinates>::Evaluate(
   return interSectionArea / (1.0 * ((a(2) + 1) * (a(3) + 1) + (b(2) + 1) *
       (b(3) + 1) - interSectionArea));
 }
+
+template<bool UseCoordinates>
+template<typename MatTypeA, typename MatTypeB>
+void IoU<UseCoordinates>::Evaluate(
+    const MatTypeA& a,
+    const MatTypeB& b,
+    arma::Mat<typename MatTypeA::elem_type>& ious)
+{
+  typedef typename MatTypeA::elem_type ElemType;
+
+  arma::Mat<ElemType> cornersA, cornersB;
+  Corners(a, cornersA);
+  Corners(b, cornersB);
+
+  const arma::Col<ElemType> areaA = (cornersA.col(2) - cornersA.col(0) + 1) %
+      (cornersA.col(3) - cornersA.col(1) + 1);
+  const arma::Col<ElemType> areaB = (cornersB.col(2) - cornersB.col(0) + 1) %
+      (cornersB.col(3) - cornersB.col(1) + 1);
+
+  const ElemType* ax0 = cornersA.colptr(0);
+  const ElemType* ay0 = cornersA.colptr(1);
+  const ElemType* ax1 = cornersA.colptr(2);
+  const ElemType* ay1 = cornersA.colptr(3);
+  const ElemType* aArea = areaA.memptr();
+
+  ious.set_size(a.n_cols, b.n_cols);
+
+  #pragma omp parallel for if (a.n_cols * b.n_cols > 16384)
+  for (omp_size_t j = 0; j < (omp_size_t) b.n_cols; ++j)
+  {
+    const ElemType bx0 = cornersB(j, 0);
+    const ElemType by0 = cornersB(j, 1);
+    const ElemType bx1 = cornersB(j, 2);
+    const ElemType by1 = cornersB(j, 3);
+    const ElemType bArea = areaB[j];
+
+    ElemType* out = ious.colptr(j);
+    for (size_t i = 0; i < a.n_cols; ++i)
+    {
+      const ElemType width = std::max(ElemType(0),
+          std::min(ax1[i], bx1) - std::max(ax0[i], bx0) + 1);
+      const ElemType height = std::max(ElemType(0),
+          std::min(ay1[i], by1) - std::max(ay0[i], by0) + 1);
+      const ElemType interSectionArea = width * height;
+      out[i] = interSectionArea / (aArea[i] + bArea - interSectionArea);
+    }
+  }
+}
+
+template<bool UseCoordinates>
+template<typename MatType>
+void IoU<UseCoordinates>::Corners(
+    const MatType& boxes,
+    arma::Mat<typename MatType::elem_type>& corners)
+{
+  Log::Assert(boxes.n_rows == 4, "Incorrect shape for bounding boxes. They \
+      must contain 4 rows either be {x0, y0, x1, y1} or {x0, y0, h, w}. Refer \
+      to the documentation for more information.");
+
+  corners = boxes.t();
+  if (UseCoordinates)
+  {
+    // Check the correctness of bounding boxes.
+    if (arma::any(corners.col(0) >= corners.col(2)) ||
+        arma::any(corners.col(1) >= corners.col(3)))
+    {
+      Log::Fatal << "Check the correctness of bounding boxes i.e. " <<
+          "{x0, y0} must represent lower left coordinates and " <<
+          "{x1, y1} must represent upper right coordinates of bounding " <<
+          "box." << std::endl;
+    }
+  }
+  else
+  {
+    Log::Assert(arma::all(corners.col(2) > 0) && arma::all(corners.col(3) > 0),
+        "Height and width of bounding boxes must be greater than zero.");
+
+    // Change height - width representation to coordinate represention.
+    corners.col(2) += corners.col(0);
+    corners.col(3) += corners.col(1);
+  }
+}
+
 template<bool UseCoordinates>
 template<typename Archive>
 void IoU<UseCoordinates>::serialize(
@@ -83,6 +83,40 @@ class LMetric
   static typename VecTypeA::elem_type Evaluate(const VecTypeA& a,
                                                const VecTypeB& b);
 
+  /**
+   * Computes the distance between two points whose dimensionality is known at
+   * compile time, so that the loop over the dimensions is unrolled.  Evaluate()
+   * uses this automatically for points of at most MaxFixedDimension
+   * dimensions, where the overhead of the general code dominates.
+   *
+   * @tparam Dim Dimensionality of the points.
+   * @param a First vector.
+   * @param b Second vector.
+   * @return Distance between vectors a and b.
+   */
+  template<size_t Dim, typename VecTypeA, typename VecTypeB>
+  static typename VecTypeA::elem_type EvaluateFixed(const VecTypeA& a,
+                                                    const VecTypeB& b);
+
+  /**
+   * Computes the distances between every pair of points in two dense sets of
+   * points, storing the distance between a.col(i) and b.col(j) in
+   * distances(i, j).  For the L2 distance this is done with a single matrix
+   * multiplication (using ||a||^2 + ||b||^2 - 2 a^T b); for other powers the
+   * loops are written so that the compiler can vectorize them.  This is much
+   * faster than calling Evaluate() for every pair when the sets are small and
+   * the dimensionality is high, as in the leaves of a tree.
+   *
+   * @tparam eT Element type of the matrices.
+   * @param a First set of points.
+   * @param b Second set of points.
+   * @param distances Matrix to store the a.n_cols x b.n_cols distances in.
+   */
+  template<typename eT>
+  static void BatchEvaluate(const arma::Mat<eT>& a,
+                            const arma::Mat<eT>& b,
+                            arma::Mat<eT>& distances);
+
   //! Serialize the metric (nothing to do).
   template<typename Archive>
   void serialize(Archive& /* ar */, const uint32_t /* version */) { }
@@ -91,6 +125,16 @@ class LMetric
   static const int Power = TPower;
   //! Whether or not the root is taken.
   static const bool TakeRoot = TTakeRoot;
+
+  //! The largest dimensionality for which Evaluate() uses EvaluateFixed().
+  static const size_t MaxFixedDimension = 4;
+
+ private:
+  //! Call EvaluateFixed() with the dimensionality of the given points, which
+  //! must be between 1 and MaxFixedDimension.
+  template<typename VecTypeA, typename VecTypeB>
+  static typename VecTypeA::elem_type EvaluateLowDimension(const VecTypeA& a,
+                                                           const VecTypeB& b);
 };
 
 // Convenience typedefs.
@@ -25,6 +25,9 @@ typename VecTypeA::elem_type LMetric<Power, TakeRoot>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  if (a.n_elem != 0 && a.n_elem <= MaxFixedDimension)
+    return EvaluateLowDimension(a, b);
+
   typename VecTypeA::elem_type sum = 0;
   for (size_t i = 0; i < a.n_elem; ++i)
     sum += std::pow(fabs(a[i] - b[i]), Power);
@@ -42,6 +45,9 @@ typename VecTypeA::elem_type LMetric<1, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  if (a.n_elem != 0 && a.n_elem <= MaxFixedDimension)
+    return EvaluateLowDimension(a, b);
+
   return arma::accu(abs(a - b));
 }
 
@@ -51,6 +57,9 @@ typename VecTypeA::elem_type LMetric<1, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  if (a.n_elem != 0 && a.n_elem <= MaxFixedDimension)
+    return EvaluateLowDimension(a, b);
+
   return arma::accu(abs(a - b));
 }
 
@@ -61,6 +70,9 @@ typename VecTypeA::elem_type LMetric<2, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  if (a.n_elem != 0 && a.n_elem <= MaxFixedDimension)
+    return EvaluateLowDimension(a, b);
+
   return arma::norm(a - b, 2);
 }
 
@@ -70,6 +82,9 @@ typename VecTypeA::elem_type LMetric<2, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  if (a.n_elem != 0 && a.n_elem <= MaxFixedDimension)
+    return EvaluateLowDimension(a, b);
+
   return accu(arma::square(a - b));
 }
 
@@ -80,6 +95,9 @@ typename VecTypeA::elem_type LMetric<3, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  if (a.n_elem != 0 && a.n_elem <= MaxFixedDimension)
+    return EvaluateLowDimension(a, b);
+
   typename VecTypeA::elem_type sum = 0;
   for (size_t i = 0; i < a.n_elem; ++i)
     sum += std::pow(fabs(a[i] - b[i]), 3.0);
@@ -93,6 +111,9 @@ typename VecTypeA::elem_type LMetric<3, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  if (a.n_elem != 0 && a.n_elem <= MaxFixedDimension)
+    return EvaluateLowDimension(a, b);
+
   return arma::accu(arma::pow(arma::abs(a - b), 3.0));
 }
 
@@ -103,9 +124,141 @@ typename VecTypeA::elem_type LMetric<INT_MAX, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
+  if (a.n_elem != 0 && a.n_elem <= MaxFixedDimension)
+    return EvaluateLowDimension(a, b);
+
   return arma::as_scalar(arma::max(arma::abs(a - b)));
 }
 
+// Fixed-dimension implementation, for all powers.
+template<int Power, bool TakeRoot>
+template<size_t Dim, typename VecTypeA, typename VecTypeB>
+inline typename VecTypeA::elem_type LMetric<Power, TakeRoot>::EvaluateFixed(
+    const VecTypeA& a,
+    const VecTypeB& b)
+{
+  typedef typename VecTypeA::elem_type ElemType;
+
+  ElemType result = 0;
+  for (size_t d = 0; d < Dim; ++d)
+  {
+    // This also works for unsigned types.
+    const ElemType ad = a[d];
+    const ElemType bd = b[d];
+    const ElemType diff = (ad > bd) ? ad - bd : bd - ad;
+
+    // The compiler should resolve all of these branches at compile-time.
+    if (Power == 1)
+      result += diff;
+    else if (Power == 2)
+      result += diff * diff;
+    else if (Power == INT_MAX)
+      result = std::max(result, diff);
+    else
+      result += std::pow(diff, Power);
+  }
+
+  if (!TakeRoot || Power == 1 || Power == INT_MAX)
+    return result;
+  else if (Power == 2)
+    return (ElemType) std::sqrt(result);
+  else
+    return (ElemType) std::pow(result, 1.0 / Power);
+}
+
+template<int Power, bool TakeRoot>
+template<typename VecTypeA, typename VecTypeB>
+inline typename VecTypeA::elem_type
+LMetric<Power, TakeRoot>::EvaluateLowDimension(const VecTypeA& a,
+                                               const VecTypeB& b)
+{
+  switch (a.n_elem)
+  {
+    case 1:
+      return EvaluateFixed<1>(a, b);
+    case 2:
+      return EvaluateFixed<2>(a, b);
+    case 3:
+      return EvaluateFixed<3>(a, b);
+    default:
+      return EvaluateFixed<4>(a, b);
+  }
+}
+
+// Batched implementation, for all powers.
+template<int Power, bool TakeRoot>
+template<typename eT>
+void LMetric<Power, TakeRoot>::BatchEvaluate(const arma::Mat<eT>& a,
+                                             const arma::Mat<eT>& b,
+                                             arma::Mat<eT>& distances)
+{
+  if (a.n_rows != b.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "LMetric::BatchEvaluate(): dimensionality of points (" << a.n_rows
+        << ") does not match dimensionality of other points (" << b.n_rows
+        << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  distances.set_size(a.n_cols, b.n_cols);
+  if (a.n_cols == 0 || b.n_cols == 0)
+    return;
+
+  // The compiler should resolve all of these branches at compile-time.
+  if (Power == 2)
+  {
+    // Center both sets on the mean of b before expanding the distance; this
+    // avoids catastrophic cancellation when the points are far from the origin.
+    const arma::Col<eT> center = arma::mean(b, 1);
+    const arma::Mat<eT> ac = a.each_col() - center;
+    const arma::Mat<eT> bc = b.each_col() - center;
+
+    distances = ac.t() * bc;
+    distances *= eT(-2);
+    distances.each_col() += arma::sum(arma::square(ac), 0).t();
+    distances.each_row() += arma::sum(arma::square(bc), 0);
+
+    // Rounding may have made some distances slightly negative; clamp them (and
+    // take the root) in place.
+    distances.transform([](const eT d) {
+        return (d < eT(0)) ? eT(0) : (TakeRoot ? std::sqrt(d) : d); });
+
+    return;
+  }
+
+  const size_t dims = a.n_rows;
+  for (size_t j = 0; j < b.n_cols; ++j)
+  {
+    const eT* bCol = b.colptr(j);
+    for (size_t i = 0; i < a.n_cols; ++i)
+    {
+      const eT* aCol = a.colptr(i);
+      eT result = 0;
+      if (Power == 1)
+      {
+        for (size_t d = 0; d < dims; ++d)
+          result += std::abs(aCol[d] - bCol[d]);
+      }
+      else if (Power == INT_MAX)
+      {
+        for (size_t d = 0; d < dims; ++d)
+          result = std::max(result, eT(std::abs(aCol[d] - bCol[d])));
+      }
+      else
+      {
+        for (size_t d = 0; d < dims; ++d)
+          result += std::pow(std::abs(aCol[d] - bCol[d]), Power);
+
+        if (TakeRoot)
+          result = std::pow(result, 1.0 / Power);
+      }
+
+      distances(i, j) = result;
+    }
+  }
+}
+
 } // namespace metric
 } // namespace mlpack
 
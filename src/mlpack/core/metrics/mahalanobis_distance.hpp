@@ -37,10 +37,11 @@ namespace metric {
  *
  * If you wish to use the KNN class or other tree-based algorithms with this
  * distance, it is recommended to instead stretch the dataset first, by
- * decomposing Q = L^T L (perhaps via a Cholesky decomposition), and then
- * multiply the data by L.  If you still wish to use the KNN class with a custom
- * distance anyway, you will need to use a different tree type than the default
- * KDTree, which only works with the LMetric class.
+ * decomposing Q = L^T L (Transformation() computes such an L), and then
+ * multiply the data by L; neighbor::MahalanobisNeighborSearch does this for
+ * nearest neighbor search.  If you still wish to use the KNN class with a
+ * custom distance anyway, you will need to use a different tree type than the
+ * default KDTree, which only works with the LMetric class.
  *
  * Similar to the LMetric class, this offers a template parameter TakeRoot
  * which, when set to false, will instead evaluate the distance
@@ -110,6 +111,19 @@ class MahalanobisDistance
    */
   arma::mat& Covariance() { return covariance; }
 
+  /**
+   * Compute a transformation matrix L such that Q = L^T L, so that the
+   * Mahalanobis distance between two points is the Euclidean distance between
+   * the points multiplied by L.  The symmetric part of the covariance matrix
+   * must be positive semidefinite; it is decomposed by its eigenvalues, so
+   * singular matrices are allowed.
+   *
+   * @return The d x d transformation matrix.
+   * @throws std::invalid_argument if the covariance matrix is not square or
+   *     has a negative eigenvalue.
+   */
+  arma::mat Transformation() const;
+
   //! Serialize the Mahalanobis distance.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t version);
@@ -47,6 +47,46 @@ double MahalanobisDistance<true>::Evaluate(const VecTypeA& a,
   return sqrt(out[0]);
 }
 
+// Decompose the covariance matrix.
+template<bool TakeRoot>
+arma::mat MahalanobisDistance<TakeRoot>::Transformation() const
+{
+  if (covariance.n_rows != covariance.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "MahalanobisDistance::Transformation(): covariance matrix must be "
+        << "square (got " << covariance.n_rows << " x " << covariance.n_cols
+        << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Only the symmetric part of Q contributes to (x - y)^T Q (x - y).  Its
+  // decomposition is V diag(lambda) V^T, so L = diag(sqrt(lambda)) V^T.
+  arma::vec eigenvalues;
+  arma::mat eigenvectors;
+  if (!arma::eig_sym(eigenvalues, eigenvectors,
+      arma::mat(0.5 * (covariance + covariance.t()))))
+  {
+    throw std::invalid_argument("MahalanobisDistance::Transformation(): "
+        "eigendecomposition of the covariance matrix failed!");
+  }
+
+  // Small negative eigenvalues are rounding errors of singular matrices.
+  const double tolerance = 1e-10 * std::max(1.0,
+      (eigenvalues.n_elem > 0) ? arma::abs(eigenvalues).max() : 0.0);
+  for (size_t i = 0; i < eigenvalues.n_elem; ++i)
+  {
+    if (eigenvalues[i] < -tolerance)
+    {
+      throw std::invalid_argument("MahalanobisDistance::Transformation(): "
+          "covariance matrix is not positive semidefinite!");
+    }
+    eigenvalues[i] = std::sqrt(std::max(eigenvalues[i], 0.0));
+  }
+
+  return arma::diagmat(eigenvalues) * eigenvectors.t();
+}
+
 // Serialize the Mahalanobis distance.
 template<bool TakeRoot>
 template<typename Archive>
@@ -70,11 +70,57 @@ class NMS
                        OutputType& selectedIndices,
                        const double threshold = 0.5);
 
+  /**
+   * Performs non-maximal suppression on each image of a batch.  The images
+   * are handled in parallel.
+   *
+   * @param boundingBoxes Bounding boxes of each image, as for the single image
+   *                      version of Evaluate().
+   * @param confidenceScores Confidence scores of the bounding boxes of each
+   *                         image.
+   * @param selectedIndices Output of Non Maximal Suppression (NMS) for each
+   *                        image is stored here.
+   * @param threshold Threshold used to discard all overlapping bounding boxes
+   *                  that have IoU greater than the threshold.
+   */
+  template<
+      typename BoundingBoxesType,
+      typename ConfidenceScoreType,
+      typename OutputType
+  >
+  static void Evaluate(const std::vector<BoundingBoxesType>& boundingBoxes,
+                       const std::vector<ConfidenceScoreType>& confidenceScores,
+                       std::vector<OutputType>& selectedIndices,
+                       const double threshold = 0.5);
+
   static const bool useCoordinates = UseCoordinates;
 
   //! Serialize the metric.
   template <typename Archive>
   void serialize(Archive &ar, const uint32_t /* version */);
+
+ private:
+  //! Check that the bounding boxes and confidence scores of an image match.
+  template<typename BoundingBoxesType, typename ConfidenceScoreType>
+  static void CheckInput(const BoundingBoxesType& boundingBoxes,
+                         const ConfidenceScoreType& confidenceScores);
+
+  /**
+   * Performs non-maximal suppression on checked input.  The boxes are sorted
+   * by decreasing confidence score and their corners are gathered into one
+   * contiguous array per coordinate; then each box that is kept suppresses the
+   * following boxes that overlap it too much, in a bitmask of 64 boxes per
+   * word.
+   */
+  template<
+      typename BoundingBoxesType,
+      typename ConfidenceScoreType,
+      typename OutputType
+  >
+  static void Sweep(const BoundingBoxesType& boundingBoxes,
+                    const ConfidenceScoreType& confidenceScores,
+                    OutputType& selectedIndices,
+                    const double threshold);
 }; // Class NMS.
 
 } // namespace metric
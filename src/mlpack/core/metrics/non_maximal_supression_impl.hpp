@@ -30,98 +30,135 @@ void NMS<UseCoordinates>::Evaluate(
     OutputType& selectedIndices,
     const double threshold)
 {
-  Log::Assert(boundingBoxes.n_rows == 4, "Bounding boxes must \
-      contain only 4 rows determining coordinates of bounding \
-      box either in {x1, y1, x2, y2} or {x1, y1, h, w} format.\
-      Refer to the documentation for more information.");
+  CheckInput(boundingBoxes, confidenceScores);
+  Sweep(boundingBoxes, confidenceScores, selectedIndices, threshold);
+}
 
-  Log::Assert(confidenceScores.n_cols != boundingBoxes.n_cols, "Each \
-      bounding box must correspond to atleast and only 1 bounding box. \
-      Found " + std::to_string(confidenceScores.n_cols) + " confidence \
-      scores for " + std::to_string(boundingBoxes.n_cols) + " bounding boxes.");
+template<bool UseCoordinates>
+template<
+    typename BoundingBoxesType,
+    typename ConfidenceScoreType,
+    typename OutputType
+>
+void NMS<UseCoordinates>::Evaluate(
+    const std::vector<BoundingBoxesType>& boundingBoxes,
+    const std::vector<ConfidenceScoreType>& confidenceScores,
+    std::vector<OutputType>& selectedIndices,
+    const double threshold)
+{
+  Log::Assert(boundingBoxes.size() == confidenceScores.size(), "Each image \
+      must have a set of bounding boxes and a set of confidence scores. Found \
+      " + std::to_string(confidenceScores.size()) + " sets of confidence \
+      scores for " + std::to_string(boundingBoxes.size()) + " images.");
 
-  // Clear selected bounding boxes.
-  selectedIndices.clear();
+  // Check all the input first, so that no exception is thrown inside the
+  // parallel region.
+  for (size_t i = 0; i < boundingBoxes.size(); ++i)
+    CheckInput(boundingBoxes[i], confidenceScores[i]);
 
-  // Obtain Sorted indices for bounding boxes according to
-  // their confidence scores.
-  arma::ucolvec sortedIndices = arma::sort_index(confidenceScores);
+  selectedIndices.resize(boundingBoxes.size());
 
-  // Pre-Compute area of each bounding box.
-  arma::mat area;
-  if (UseCoordinates)
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) boundingBoxes.size(); ++i)
   {
-    area = (boundingBoxes.row(2) - boundingBoxes.row(0)) %
-        (boundingBoxes.row(3) - boundingBoxes.row(1));
+    Sweep(boundingBoxes[i], confidenceScores[i], selectedIndices[i],
+        threshold);
   }
-  else
-  {
-    area = boundingBoxes.row(2) % boundingBoxes.row(3);
-  }
-
-  while (sortedIndices.n_elem > 0)
-  {
-    size_t selectedIndex = sortedIndices(sortedIndices.n_elem - 1);
+}
 
-    // Choose the box with the largest probability.
-    selectedIndices.insert_rows(0, arma::uvec(1).fill(selectedIndex));
+template<bool UseCoordinates>
+template<typename BoundingBoxesType, typename ConfidenceScoreType>
+void NMS<UseCoordinates>::CheckInput(
+    const BoundingBoxesType& boundingBoxes,
+    const ConfidenceScoreType& confidenceScores)
+{
+  Log::Assert(boundingBoxes.n_rows == 4, "Bounding boxes must \
+      contain only 4 rows determining coordinates of bounding \
+      box either in {x1, y1, x2, y2} or {x1, y1, h, w} format.\
+      Refer to the documentation for more information.");
 
-    // Check if there are other bounding boxes to compare with.
-    if (sortedIndices.n_elem == 1)
-    {
-      break;
-    }
+  Log::Assert(confidenceScores.n_elem == boundingBoxes.n_cols, "Each \
+      bounding box must correspond to atleast and only 1 confidence score. \
+      Found " + std::to_string(confidenceScores.n_elem) + " confidence \
+      scores for " + std::to_string(boundingBoxes.n_cols) + " bounding boxes.");
+}
 
-    // Remove the last index.
-    sortedIndices = sortedIndices(arma::span(0, sortedIndices.n_rows - 2),
-        arma::span());
+template<bool UseCoordinates>
+template<
+    typename BoundingBoxesType,
+    typename ConfidenceScoreType,
+    typename OutputType
+>
+void NMS<UseCoordinates>::Sweep(
+    const BoundingBoxesType& boundingBoxes,
+    const ConfidenceScoreType& confidenceScores,
+    OutputType& selectedIndices,
+    const double threshold)
+{
+  typedef typename BoundingBoxesType::elem_type ElemType;
+
+  // Obtain sorted indices for bounding boxes according to their confidence
+  // scores, and gather the corners {x1, y1, x2, y2} of the boxes in that order
+  // as the columns of a matrix.
+  const arma::uvec sortedIndices = arma::stable_sort_index(confidenceScores,
+      "descend");
+  arma::Mat<ElemType> corners = boundingBoxes.cols(sortedIndices).t();
+  if (!UseCoordinates)
+  {
+    // Change height - width representation to coordinate represention.
+    corners.col(2) += corners.col(0);
+    corners.col(3) += corners.col(1);
+  }
 
-    // Get x and y coordinates for remaining bounding boxes.
-    BoundingBoxesType x2 = boundingBoxes.submat(arma::uvec(1).fill(2),
-        sortedIndices);
+  // Pre-Compute area of each bounding box.
+  const arma::Col<ElemType> area = (corners.col(2) - corners.col(0)) %
+      (corners.col(3) - corners.col(1));
 
-    BoundingBoxesType x1 = boundingBoxes.submat(arma::uvec(1).fill(0),
-        sortedIndices);;
+  const ElemType* x1 = corners.colptr(0);
+  const ElemType* y1 = corners.colptr(1);
+  const ElemType* x2 = corners.colptr(2);
+  const ElemType* y2 = corners.colptr(3);
 
-    BoundingBoxesType y2 = boundingBoxes.submat(arma::uvec(1).fill(3),
-        sortedIndices);
+  const size_t n = sortedIndices.n_elem;
+  std::vector<uint64_t> suppressed((n + 63) / 64, 0);
+  std::vector<size_t> selected;
 
-    BoundingBoxesType y1 = boundingBoxes.submat(arma::uvec(1).fill(1),
-        sortedIndices);
+  for (size_t i = 0; i < n; ++i)
+  {
+    if ((suppressed[i / 64] >> (i % 64)) & 1)
+      continue;
 
-    size_t selectedX2 = boundingBoxes(2, selectedIndex);
-    size_t selectedY2 = boundingBoxes(3, selectedIndex);
-    size_t selectedX1 = boundingBoxes(0, selectedIndex);
-    size_t selectedY1 = boundingBoxes(1, selectedIndex);
+    // Choose the box with the largest confidence score that is left.
+    selected.push_back(sortedIndices[i]);
 
-    if (!UseCoordinates)
+    // Suppress the following boxes whose IoU with the chosen box is greater
+    // than the threshold.
+    for (size_t w = (i + 1) / 64; w < suppressed.size(); ++w)
     {
-      // Change height - width representation to coordinate represention.
-      x2 = x2 + x1;
-      y2 = y2 + y1;
-      selectedX2 = selectedX2 + selectedX1;
-      selectedY2 = selectedY2 + selectedY1;
+      const size_t begin = std::max(w * 64, i + 1);
+      const size_t end = std::min(w * 64 + 64, n);
+
+      uint64_t word = 0;
+      for (size_t j = begin; j < end; ++j)
+      {
+        const ElemType intersectionArea =
+            std::max(ElemType(0), std::min(x2[i], x2[j]) -
+                std::max(x1[i], x1[j])) *
+            std::max(ElemType(0), std::min(y2[i], y2[j]) -
+                std::max(y1[i], y1[j]));
+        const ElemType iou = intersectionArea /
+            (area[i] + area[j] - intersectionArea);
+
+        // Boxes whose IoU is not a number are suppressed too.
+        word |= uint64_t(!(iou <= threshold)) << (j % 64);
+      }
+      suppressed[w] |= word;
     }
-
-    // Calculate points of intersection between the bounding box with
-    // highest confidence score and remaining bounding boxes.
-    x2 = arma::clamp(x2, DBL_MIN, selectedX2);
-    y2 = arma::clamp(y2, DBL_MIN, selectedY2);
-    x1 = arma::clamp(x1, selectedX1, DBL_MAX);
-    y1 = arma::clamp(y1, selectedY1, DBL_MAX);
-
-    BoundingBoxesType intersectionArea = arma::clamp(x2 - x1, 0.0, DBL_MAX) %
-          arma::clamp(y2 - y1, 0.0, DBL_MAX);
-
-    // Calculate IoU of remaining boxes with the last bounding box with
-    // the highest confidence score.
-    BoundingBoxesType calculateIoU = intersectionArea /
-        (area(sortedIndices).t() - intersectionArea + area(selectedIndex));
-
-    sortedIndices = sortedIndices(arma::find(calculateIoU <= threshold));
   }
 
-  selectedIndices = arma::flipud(selectedIndices);
+  selectedIndices.set_size(selected.size());
+  for (size_t i = 0; i < selected.size(); ++i)
+    selectedIndices(i) = selected[i];
 }
 
 template<bool UseCoordinates>
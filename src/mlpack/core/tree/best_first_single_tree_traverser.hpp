@@ -0,0 +1,137 @@
+/**
+ * @file core/tree/best_first_single_tree_traverser.hpp
+ *
+ * Defines the BestFirstSingleTreeTraverser, a single-tree traverser that visits
+ * the nodes in order of their score, and may stop early after a given number of
+ * base cases or a given time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BEST_FIRST_SINGLE_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_BEST_FIRST_SINGLE_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <queue>
+
+#include "tree_traits.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A single-tree traverser that works with any tree type, and visits the nodes
+ * of the reference tree best-first: the scored nodes are kept in a priority
+ * queue, and the node with the lowest score is always visited next.  For
+ * nearest neighbor search, this means the closest nodes are searched first, so
+ * the results are good early in the traversal.
+ *
+ * The traversal of each query point can be given a budget: it stops once the
+ * given number of base cases has been performed, or once the given time has
+ * elapsed, even if some nodes have not been visited.  The budget is checked
+ * before each node is visited, so the budget may be exceeded by the points of
+ * one node.  After each traversal, RemainingScore() returns the lowest score of
+ * the nodes that were left unvisited (or DBL_MAX if the traversal was complete),
+ * which bounds the score of every point that was not seen.
+ *
+ * The RuleType class must implement BaseCase(), Score(), Rescore(), and
+ * BaseCases() (the number of base cases performed so far).
+ *
+ * @tparam TreeType Type of the reference tree.
+ * @tparam RuleType Type of the rules of the traversal.
+ */
+template<typename TreeType, typename RuleType>
+class BestFirstSingleTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the best-first single tree traverser with the given rule set
+   * and budget.
+   *
+   * @param rule Rules of the traversal.
+   * @param maxBaseCases Maximum number of base cases of each traversal (0 means
+   *     no limit).
+   * @param maxTime Maximum time of each traversal, in microseconds (0 means no
+   *     limit).
+   */
+  BestFirstSingleTreeTraverser(RuleType& rule,
+                               const size_t maxBaseCases = 0,
+                               const double maxTime = 0.0);
+
+  /**
+   * Traverse the tree with the given point, until every node has been visited
+   * or pruned, or the budget is exhausted.
+   *
+   * @param queryIndex The index of the point in the query set which is being
+   *     used as the query point.
+   * @param referenceNode The tree node to be traversed.
+   */
+  void Traverse(const size_t queryIndex, TreeType& referenceNode);
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+
+  //! Get the maximum number of base cases of each traversal (0 means no limit).
+  size_t MaxBaseCases() const { return maxBaseCases; }
+  //! Modify the maximum number of base cases of each traversal.
+  size_t& MaxBaseCases() { return maxBaseCases; }
+
+  //! Get the maximum time of each traversal, in microseconds (0 means no
+  //! limit).
+  double MaxTime() const { return maxTime; }
+  //! Modify the maximum time of each traversal, in microseconds.
+  double& MaxTime() { return maxTime; }
+
+  //! Get the lowest score of the nodes left unvisited by the last traversal,
+  //! or DBL_MAX if it visited or pruned every node.
+  double RemainingScore() const { return remainingScore; }
+
+ private:
+  //! A node waiting to be visited, with its score.
+  struct QueueEntry
+  {
+    //! The score of the node.
+    double score;
+    //! The order in which the node was scored, to break ties.
+    size_t order;
+    //! The node.
+    TreeType* node;
+
+    //! Compare two entries so that the lowest score is at the top of the queue.
+    bool operator<(const QueueEntry& other) const
+    {
+      if (score != other.score)
+        return score > other.score;
+      return order > other.order;
+    }
+  };
+
+  //! Reference to the rules with which the tree will be traversed.
+  RuleType& rule;
+
+  //! The maximum number of base cases of each traversal.
+  size_t maxBaseCases;
+
+  //! The maximum time of each traversal, in microseconds.
+  double maxTime;
+
+  //! The number of nodes which have been pruned during traversal.
+  size_t numPrunes;
+
+  //! The lowest score of the nodes left unvisited by the last traversal.
+  double remainingScore;
+
+  //! The nodes waiting to be visited; kept between traversals to avoid
+  //! allocations.
+  std::vector<QueueEntry> queue;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "best_first_single_tree_traverser_impl.hpp"
+
+#endif
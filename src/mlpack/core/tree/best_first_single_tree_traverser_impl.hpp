@@ -0,0 +1,122 @@
+/**
+ * @file core/tree/best_first_single_tree_traverser_impl.hpp
+ *
+ * Implementation of the BestFirstSingleTreeTraverser.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BEST_FIRST_SINGLE_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_BEST_FIRST_SINGLE_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "best_first_single_tree_traverser.hpp"
+#include <mlpack/core/tree/traversal_statistics.hpp>
+#include <chrono>
+
+namespace mlpack {
+namespace tree {
+
+template<typename TreeType, typename RuleType>
+BestFirstSingleTreeTraverser<TreeType, RuleType>::BestFirstSingleTreeTraverser(
+    RuleType& rule,
+    const size_t maxBaseCases,
+    const double maxTime) :
+    rule(rule),
+    maxBaseCases(maxBaseCases),
+    maxTime(maxTime),
+    numPrunes(0),
+    remainingScore(DBL_MAX)
+{ /* Nothing to do. */ }
+
+template<typename TreeType, typename RuleType>
+void BestFirstSingleTreeTraverser<TreeType, RuleType>::Traverse(
+    const size_t queryIndex,
+    TreeType& referenceNode)
+{
+  MLPACK_TRAVERSAL_LEVEL(rule, numPrunes);
+
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  const size_t startBaseCases = rule.BaseCases();
+
+  remainingScore = DBL_MAX;
+  queue.clear();
+  size_t order = 0;
+
+  const double rootScore = rule.Score(queryIndex, referenceNode);
+  if (rootScore == DBL_MAX)
+  {
+    ++numPrunes;
+    return;
+  }
+  queue.push_back(QueueEntry{ rootScore, order++, &referenceNode });
+
+  while (!queue.empty())
+  {
+    std::pop_heap(queue.begin(), queue.end());
+    const QueueEntry entry = queue.back();
+    queue.pop_back();
+
+    // The bound may have tightened since the node was scored.
+    const double score = rule.Rescore(queryIndex, *entry.node, entry.score);
+    if (score == DBL_MAX)
+    {
+      ++numPrunes;
+      continue;
+    }
+
+    // Stop if the budget is exhausted.  Every node left in the queue has a
+    // score at least as high as this one.
+    if (maxBaseCases != 0 && rule.BaseCases() - startBaseCases >= maxBaseCases)
+    {
+      remainingScore = score;
+      break;
+    }
+
+    if (maxTime != 0.0)
+    {
+      const double elapsed = std::chrono::duration<double, std::micro>(
+          std::chrono::steady_clock::now() - start).count();
+      if (elapsed >= maxTime)
+      {
+        remainingScore = score;
+        break;
+      }
+    }
+
+    // The first point of a self-child is the point of its parent, for which
+    // the base case has already been performed.
+    size_t firstPoint = 0;
+    if (TreeTraits<TreeType>::HasSelfChildren && entry.node->Parent() &&
+        entry.node->NumPoints() > 0 &&
+        entry.node->Point(0) == entry.node->Parent()->Point(0))
+      firstPoint = 1;
+
+    for (size_t i = firstPoint; i < entry.node->NumPoints(); ++i)
+      rule.BaseCase(queryIndex, entry.node->Point(i));
+
+    for (size_t i = 0; i < entry.node->NumChildren(); ++i)
+    {
+      TreeType* child = &entry.node->Child(i);
+      const double childScore = rule.Score(queryIndex, *child);
+      if (childScore == DBL_MAX)
+      {
+        ++numPrunes;
+        continue;
+      }
+
+      queue.push_back(QueueEntry{ childScore, order++, child });
+      std::push_heap(queue.begin(), queue.end());
+    }
+  }
+
+  queue.clear();
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
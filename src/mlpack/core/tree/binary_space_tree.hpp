@@ -20,13 +20,12 @@
 #include "binary_space_tree/rp_tree_max_split.hpp"
 #include "binary_space_tree/rp_tree_mean_split.hpp"
 #include "binary_space_tree/ub_tree_split.hpp"
+#include "binary_space_tree/split_traits.hpp"
 #include "binary_space_tree/binary_space_tree.hpp"
 #include "binary_space_tree/single_tree_traverser.hpp"
 #include "binary_space_tree/single_tree_traverser_impl.hpp"
 #include "binary_space_tree/dual_tree_traverser.hpp"
 #include "binary_space_tree/dual_tree_traverser_impl.hpp"
-#include "binary_space_tree/breadth_first_dual_tree_traverser.hpp"
-#include "binary_space_tree/breadth_first_dual_tree_traverser_impl.hpp"
 #include "binary_space_tree/traits.hpp"
 #include "binary_space_tree/typedef.hpp"
 
@@ -13,12 +13,27 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "../node_arena.hpp"
 #include "../statistic.hpp"
 #include "midpoint_split.hpp"
+#include "split_traits.hpp"
+#include "../frontier_dual_tree_traverser.hpp"
 
 namespace mlpack {
 namespace tree /** Trees and tree-building procedures. */ {
 
+// Forward declaration.
+template<typename TreeType>
+class FlatTreeIndex;
+
+//! The orders in which the nodes of a tree can be laid out in memory by
+//! BinarySpaceTree::CompactNodes().
+enum NodeLayout
+{
+  BREADTH_FIRST_LAYOUT,
+  VAN_EMDE_BOAS_LAYOUT
+};
+
 /**
  * A binary space partitioning tree, such as a KD-tree or a ball tree.  Once the
  * bound and type of dataset is defined, the tree will construct itself.  Call
@@ -29,6 +44,10 @@ namespace tree /** Trees and tree-building procedures. */ {
  * from it.  If you need to add or delete a node, the better procedure is to
  * rebuild the tree entirely.
  *
+ * The nodes of the tree (other than the root) are allocated in a NodeArena
+ * owned by the root, so that building and destroying a large tree does not
+ * allocate and free every node individually.
+ *
  * This tree does take one runtime parameter in the constructor, which is the
  * max leaf size to be used.
  *
@@ -88,6 +107,12 @@ class BinarySpaceTree
   //! The dataset.  If we are the root of the tree, we own the dataset and must
   //! delete it.
   MatType* dataset;
+  //! The arena holding every node of the tree but the root, created by the
+  //! root with its children.  It is NULL if the nodes are allocated
+  //! individually (as in copies of subtrees).  The root owns the arena and must
+  //! delete it.  After CompactNodes(), the arena is fixed, and holds the nodes
+  //! contiguously.
+  NodeArena<BinarySpaceTree>* arena;
 
  public:
   //! A single-tree traverser for binary space trees; see
@@ -99,8 +124,11 @@ class BinarySpaceTree
   template<typename RuleType>
   class DualTreeTraverser;
 
+  //! A breadth-first dual-tree traverser for binary space trees; see
+  //! frontier_dual_tree_traverser.hpp.
   template<typename RuleType>
-  class BreadthFirstDualTreeTraverser;
+  using BreadthFirstDualTreeTraverser =
+      FrontierDualTreeTraverser<BinarySpaceTree, RuleType>;
 
   /**
    * Construct this as the root node of a binary space tree using the given
@@ -167,6 +195,10 @@ class BinarySpaceTree
    * the matrix to have its ownership taken, consider using the constructor that
    * takes a const reference to a dataset.
    *
+   * If the given matrix uses auxiliary memory (for instance, a memory-mapped
+   * file given by data::MappedMatrix), no copy is made and the points are
+   * reordered directly in that memory.
+   *
    * @param data Dataset to create tree from.
    * @param oldFromNew Vector which will be filled with the old positions for
    *     each new point.
@@ -315,6 +347,21 @@ class BinarySpaceTree
    */
   ~BinarySpaceTree();
 
+  /**
+   * Move every node of the tree (except this root node) into one contiguous
+   * array, in the given order, so that traversals touch fewer cache lines and
+   * pages.  The van Emde Boas layout is cache-oblivious and works well for both
+   * depth-first and breadth-first traversals.  This can only be called on the
+   * root of the tree, and invalidates any pointers to non-root nodes.  Copies of
+   * a compacted tree are not compacted.
+   *
+   * @param layout Order in which to lay out the nodes.
+   */
+  void CompactNodes(const NodeLayout layout = VAN_EMDE_BOAS_LAYOUT);
+
+  //! Return whether or not the nodes of the tree are compacted.
+  bool IsCompacted() const { return arena != NULL && arena->Fixed(); }
+
   //! Return the bound object for this node.
   const BoundType<MetricType>& Bound() const { return bound; }
   //! Return the bound object for this node.
@@ -529,6 +576,93 @@ class BinarySpaceTree
                  const size_t maxLeafSize,
                  SplitType<BoundType<MetricType>, MatType>& splitter);
 
+  /**
+   * Split the current node, whose bound has already been computed, and build
+   * its children recursively.  If oldFromNew is not NULL, the changed indices
+   * are stored in it.  Unless SplitTraits::SupportsParallelBuild is false,
+   * large nodes have their two subtrees built in parallel with OpenMP tasks
+   * that share the splitter (if SplitTraits::UsesRandomNumbers is true, each
+   * of these subtrees draws from its own math::RandomStream, so the tree is
+   * the same for any number of threads).
+   *
+   * @param oldFromNew Vector holding permuted indices, or NULL.
+   * @param maxLeafSize Maximum number of points held in a leaf.
+   * @param splitter Instantiated SplitType object.
+   */
+  void SplitChildren(std::vector<size_t>* oldFromNew,
+                     const size_t maxLeafSize,
+                     SplitType<BoundType<MetricType>, MatType>& splitter);
+
+  //! Tag for the constructor of a child whose subtree is built later.
+  struct BoundOnly { };
+
+  /**
+   * Construct this node as a child of the given parent, computing only its
+   * bound; the subtree is built later with SplitChildren().  This is used when
+   * the two subtrees of a node are built in parallel: the bound of a right
+   * child may depend on the bound of its sibling (see UpdateBound()), so the
+   * bounds are computed in order before the subtrees are built.
+   *
+   * @param parent Parent of this node.
+   * @param begin Index of the first point of this node.
+   * @param count Number of points of this node.
+   */
+  BinarySpaceTree(BinarySpaceTree* parent,
+                  const size_t begin,
+                  const size_t count,
+                  BoundOnly);
+
+  //! The number of points from which the two subtrees of a node are built in
+  //! parallel.
+  static constexpr size_t ParallelBuildThreshold = 8192;
+
+  /**
+   * Delete the children of this node (taking into account whether they are
+   * held in an arena), and set them to NULL.
+   */
+  void FreeChildren();
+
+  /**
+   * Create a child of this node, in the arena of the tree if there is one,
+   * passing the given arguments to its constructor.
+   */
+  template<typename... Args>
+  BinarySpaceTree* NewChild(Args&&... args);
+
+  /**
+   * Copy the given other node as a child of the given parent, in the arena of
+   * the parent if it has one, and copy its subtree.
+   *
+   * @param other Node to copy.
+   * @param parent Parent of the new node.
+   */
+  BinarySpaceTree(const BinarySpaceTree& other, BinarySpaceTree* parent);
+
+  //! Copy the children of the given other node (and their subtrees).
+  void CopyChildren(const BinarySpaceTree& other);
+
+  /**
+   * Move every node of the tree (except this root node) into the given arena,
+   * in the given order, and free the old nodes.  The first node of the order
+   * must be this root node.
+   *
+   * @param order Every node of the tree, starting with the root.
+   * @param newArena Empty arena to move the nodes into.
+   */
+  void MoveNodes(const std::vector<BinarySpaceTree*>& order,
+                 NodeArena<BinarySpaceTree>* newArena);
+
+  //! Return the number of levels of the subtree rooted at this node.
+  size_t Height() const;
+
+  /**
+   * Append the nodes of the subtree rooted at the given node (truncated to the
+   * given height) to the given vector in van Emde Boas order.
+   */
+  static void VanEmdeBoasOrder(BinarySpaceTree* node,
+                               const size_t height,
+                               std::vector<BinarySpaceTree*>& order);
+
   /**
    * Update the bound of the current node. This method does not take into
    * account bound-specific properties.
@@ -546,6 +680,17 @@ class BinarySpaceTree
    */
   void UpdateBound(bound::HollowBallBound<MetricType>& boundToUpdate);
 
+  /**
+   * Update the bound of the current node. This method is designed for
+   * QuantizedHRectBound only: all bounds are quantized on the grid of the
+   * root.
+   *
+   * @param boundToUpdate The bound to update.
+   */
+  template<typename BoundElemType, typename CodeType>
+  void UpdateBound(bound::QuantizedHRectBound<MetricType, BoundElemType,
+      CodeType>& boundToUpdate);
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
@@ -558,6 +703,13 @@ class BinarySpaceTree
   //! Friend access is given for the default constructor.
   friend class cereal::access;
 
+  //! Flat tree indices restore the tree from a file without serialization.
+  template<typename TreeType>
+  friend class FlatTreeIndex;
+
+  //! The arena creates its nodes with the default constructor.
+  friend class NodeArena<BinarySpaceTree>;
+
  public:
   /**
    * Serialize the tree.
@@ -15,7 +15,14 @@
 #include "binary_space_tree.hpp"
 
 #include <mlpack/core/util/log.hpp>
+#include <mlpack/core/math/random.hpp>
 #include <queue>
+#include <stack>
+#include <unordered_map>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
 
 namespace mlpack {
 namespace tree {
@@ -39,7 +46,8 @@ BinarySpaceTree(
     count(data.n_cols), /* and spans all of the dataset. */
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(data)) // Copies the dataset.
+    dataset(new MatType(data)), // Copies the dataset.
+    arena(NULL)
 {
   // Do the actual splitting of this node.
   SplitType<BoundType<MetricType>, MatType> splitter;
@@ -67,7 +75,8 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(data)) // Copies the dataset.
+    dataset(new MatType(data)), // Copies the dataset.
+    arena(NULL)
 {
   // Initialize oldFromNew correctly.
   oldFromNew.resize(data.n_cols);
@@ -101,7 +110,8 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(data)) // Copies the dataset.
+    dataset(new MatType(data)), // Copies the dataset.
+    arena(NULL)
 {
   // Initialize the oldFromNew vector correctly.
   oldFromNew.resize(data.n_cols);
@@ -136,7 +146,8 @@ BinarySpaceTree(MatType&& data, const size_t maxLeafSize) :
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(std::move(data)))
+    dataset(new MatType(std::move(data))),
+    arena(NULL)
 {
   // Do the actual splitting of this node.
   SplitType<BoundType<MetricType>, MatType> splitter;
@@ -164,7 +175,8 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(std::move(data)))
+    dataset(new MatType(std::move(data))),
+    arena(NULL)
 {
   // Initialize oldFromNew correctly.
   oldFromNew.resize(dataset->n_cols);
@@ -198,7 +210,8 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(std::move(data)))
+    dataset(new MatType(std::move(data))),
+    arena(NULL)
 {
   // Initialize the oldFromNew vector correctly.
   oldFromNew.resize(dataset->n_cols);
@@ -237,7 +250,8 @@ BinarySpaceTree(
     begin(begin),
     count(count),
     bound(parent->Dataset().n_rows),
-    dataset(&parent->Dataset()) // Point to the parent's dataset.
+    dataset(&parent->Dataset()), // Point to the parent's dataset.
+    arena(parent->arena)
 {
   // Perform the actual splitting.
   SplitNode(maxLeafSize, splitter);
@@ -266,7 +280,8 @@ BinarySpaceTree(
     begin(begin),
     count(count),
     bound(parent->Dataset().n_rows),
-    dataset(&parent->Dataset())
+    dataset(&parent->Dataset()),
+    arena(parent->arena)
 {
   // Hopefully the vector is initialized correctly!  We can't check that
   // entirely but we can do a minor sanity check.
@@ -300,7 +315,8 @@ BinarySpaceTree(
     begin(begin),
     count(count),
     bound(parent->Dataset()->n_rows),
-    dataset(&parent->Dataset())
+    dataset(&parent->Dataset()),
+    arena(parent->arena)
 {
   // Hopefully the vector is initialized correctly!  We can't check that
   // entirely but we can do a minor sanity check.
@@ -318,6 +334,32 @@ BinarySpaceTree(
     newFromOld[oldFromNew[i]] = i;
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+BinarySpaceTree(
+    BinarySpaceTree* parent,
+    const size_t begin,
+    const size_t count,
+    BoundOnly) :
+    left(NULL),
+    right(NULL),
+    parent(parent),
+    begin(begin),
+    count(count),
+    bound(parent->Dataset().n_rows),
+    dataset(&parent->Dataset()),
+    arena(parent->arena)
+{
+  // The subtree and the statistic are built later, by the parent.
+  UpdateBound(bound);
+  furthestDescendantDistance = 0.5 * bound.Diameter();
+}
+
 /**
  * Create a binary space tree by copying the other tree.  Be careful!  This can
  * take a long time and use a lot of memory.
@@ -342,41 +384,55 @@ BinarySpaceTree(
     furthestDescendantDistance(other.furthestDescendantDistance),
     minimumBoundDistance(other.minimumBoundDistance),
     // Copy matrix, but only if we are the root.
-    dataset((other.parent == NULL) ? new MatType(*other.dataset) : NULL)
+    dataset((other.parent == NULL) ? new MatType(*other.dataset) : NULL),
+    arena(NULL)
 {
   // Create left and right children (if any).
-  if (other.Left())
-  {
-    left = new BinarySpaceTree(*other.Left());
-    left->Parent() = this; // Set parent to this, not other tree.
-  }
-
-  if (other.Right())
-  {
-    right = new BinarySpaceTree(*other.Right());
-    right->Parent() = this; // Set parent to this, not other tree.
-  }
+  CopyChildren(other);
+}
 
-  // Propagate matrix, but only if we are the root.
-  if (parent == NULL)
-  {
-    std::queue<BinarySpaceTree*> queue;
-    if (left)
-      queue.push(left);
-    if (right)
-      queue.push(right);
-    while (!queue.empty())
-    {
-      BinarySpaceTree* node = queue.front();
-      queue.pop();
+/**
+ * Copy the given node as a child of the given parent.
+ */
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+BinarySpaceTree(
+    const BinarySpaceTree& other,
+    BinarySpaceTree* parent) :
+    left(NULL),
+    right(NULL),
+    parent(parent),
+    begin(other.begin),
+    count(other.count),
+    bound(other.bound),
+    stat(other.stat),
+    parentDistance(other.parentDistance),
+    furthestDescendantDistance(other.furthestDescendantDistance),
+    minimumBoundDistance(other.minimumBoundDistance),
+    dataset(parent->dataset),
+    arena(parent->arena)
+{
+  CopyChildren(other);
+}
 
-      node->dataset = dataset;
-      if (node->left)
-        queue.push(node->left);
-      if (node->right)
-        queue.push(node->right);
-    }
-  }
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    CopyChildren(const BinarySpaceTree& other)
+{
+  if (other.left)
+    left = NewChild(*other.left, this);
+  if (other.right)
+    right = NewChild(*other.right, this);
 }
 
 /**
@@ -398,8 +454,7 @@ operator=(const BinarySpaceTree& other)
 
   // Freeing memory that will not be used anymore.
   delete dataset;
-  delete left;
-  delete right;
+  FreeChildren();
 
   left = NULL;
   right = NULL;
@@ -415,38 +470,7 @@ operator=(const BinarySpaceTree& other)
   dataset = ((other.parent == NULL) ? new MatType(*other.dataset) : NULL);
 
   // Create left and right children (if any).
-  if (other.Left())
-  {
-    left = new BinarySpaceTree(*other.Left());
-    left->Parent() = this; // Set parent to this, not other tree.
-  }
-
-  if (other.Right())
-  {
-    right = new BinarySpaceTree(*other.Right());
-    right->Parent() = this; // Set parent to this, not other tree.
-  }
-
-  // Propagate matrix, but only if we are the root.
-  if (parent == NULL)
-  {
-    std::queue<BinarySpaceTree*> queue;
-    if (left)
-      queue.push(left);
-    if (right)
-      queue.push(right);
-    while (!queue.empty())
-    {
-      BinarySpaceTree* node = queue.front();
-      queue.pop();
-
-      node->dataset = dataset;
-      if (node->left)
-        queue.push(node->left);
-      if (node->right)
-        queue.push(node->right);
-    }
-  }
+  CopyChildren(other);
 
   return *this;
 }
@@ -470,8 +494,7 @@ operator=(BinarySpaceTree&& other)
 
   // Freeing memory that will not be used anymore.
   delete dataset;
-  delete left;
-  delete right;
+  FreeChildren();
 
   parent = other.Parent();
   left = other.Left();
@@ -484,6 +507,7 @@ operator=(BinarySpaceTree&& other)
   furthestDescendantDistance = other.FurthestDescendantDistance();
   minimumBoundDistance = other.MinimumBoundDistance();
   dataset = other.dataset;
+  arena = other.arena;
 
   other.left = NULL;
   other.right = NULL;
@@ -494,6 +518,13 @@ operator=(BinarySpaceTree&& other)
   other.furthestDescendantDistance = 0.0;
   other.minimumBoundDistance = 0.0;
   other.dataset = NULL;
+  other.arena = NULL;
+
+  // Set new parent.
+  if (left)
+    left->parent = this;
+  if (right)
+    right->parent = this;
 
   return *this;
 }
@@ -520,7 +551,8 @@ BinarySpaceTree(BinarySpaceTree&& other) :
     parentDistance(other.parentDistance),
     furthestDescendantDistance(other.furthestDescendantDistance),
     minimumBoundDistance(other.minimumBoundDistance),
-    dataset(other.dataset)
+    dataset(other.dataset),
+    arena(other.arena)
 {
   // Now we are a clone of the other tree.  But we must also clear the other
   // tree's contents, so it doesn't delete anything when it is destructed.
@@ -533,6 +565,7 @@ BinarySpaceTree(BinarySpaceTree&& other) :
   other.furthestDescendantDistance = 0.0;
   other.minimumBoundDistance = 0.0;
   other.dataset = NULL;
+  other.arena = NULL;
 
   // Set new parent.
   if (left)
@@ -576,14 +609,225 @@ template<typename MetricType,
 BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
     ~BinarySpaceTree()
 {
-  delete left;
-  delete right;
+  FreeChildren();
 
   // If we're the root, delete the matrix.
   if (!parent)
     delete dataset;
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    FreeChildren()
+{
+  if (!arena)
+  {
+    delete left;
+    delete right;
+  }
+  else if (!parent)
+  {
+    // All of the descendants of the root are held in the arena.  Nodes inside
+    // the arena do not free anything themselves.
+    delete arena;
+  }
+
+  left = NULL;
+  right = NULL;
+  arena = NULL;
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename... Args>
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>*
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    NewChild(Args&&... args)
+{
+  // The root creates the arena holding the other nodes of the tree when its
+  // children are created.  (The nodes of a copy of a subtree are allocated
+  // individually.)
+  if (!parent && !arena)
+    arena = new NodeArena<BinarySpaceTree>();
+
+  if (arena)
+    return arena->Allocate(std::forward<Args>(args)...);
+  else
+    return new BinarySpaceTree(std::forward<Args>(args)...);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    CompactNodes(const NodeLayout layout)
+{
+  if (parent != NULL)
+    throw std::invalid_argument("BinarySpaceTree::CompactNodes(): can only be "
+        "called on the root of the tree!");
+
+  // Compute the order of the nodes.  The root itself is not moved.
+  std::vector<BinarySpaceTree*> order;
+  if (layout == BREADTH_FIRST_LAYOUT)
+  {
+    std::queue<BinarySpaceTree*> queue;
+    queue.push(this);
+    while (!queue.empty())
+    {
+      BinarySpaceTree* node = queue.front();
+      queue.pop();
+
+      order.push_back(node);
+      if (node->left)
+        queue.push(node->left);
+      if (node->right)
+        queue.push(node->right);
+    }
+  }
+  else
+  {
+    VanEmdeBoasOrder(this, Height(), order);
+  }
+
+  if (order.size() <= 1)
+    return;
+
+  // Now move every node (other than the root) into one block.
+  MoveNodes(order, new NodeArena<BinarySpaceTree>(order.size() - 1, true));
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    MoveNodes(const std::vector<BinarySpaceTree*>& order,
+              NodeArena<BinarySpaceTree>* newArena)
+{
+  std::unordered_map<const BinarySpaceTree*, BinarySpaceTree*> newFromOld;
+  newFromOld[this] = this;
+  for (size_t i = 1; i < order.size(); ++i)
+    newFromOld[order[i]] = newArena->Allocate();
+
+  for (size_t i = 1; i < order.size(); ++i)
+  {
+    BinarySpaceTree* oldNode = order[i];
+    BinarySpaceTree& newNode = *newFromOld[oldNode];
+
+    newNode.left = oldNode->left ? newFromOld[oldNode->left] : NULL;
+    newNode.right = oldNode->right ? newFromOld[oldNode->right] : NULL;
+    newNode.parent = newFromOld[oldNode->parent];
+    newNode.begin = oldNode->begin;
+    newNode.count = oldNode->count;
+    newNode.bound = std::move(oldNode->bound);
+    newNode.stat = std::move(oldNode->stat);
+    newNode.parentDistance = oldNode->parentDistance;
+    newNode.furthestDescendantDistance = oldNode->furthestDescendantDistance;
+    newNode.minimumBoundDistance = oldNode->minimumBoundDistance;
+    newNode.dataset = dataset;
+    newNode.arena = newArena;
+  }
+
+  // Free the old nodes, without letting them free their children.
+  if (arena)
+  {
+    delete arena;
+  }
+  else
+  {
+    for (size_t i = 1; i < order.size(); ++i)
+    {
+      order[i]->left = NULL;
+      order[i]->right = NULL;
+      delete order[i];
+    }
+  }
+
+  left = left ? newFromOld[left] : NULL;
+  right = right ? newFromOld[right] : NULL;
+  arena = newArena;
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+size_t BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+    SplitType>::Height() const
+{
+  size_t height = 0;
+  if (left)
+    height = left->Height();
+  if (right)
+    height = std::max(height, right->Height());
+
+  return height + 1;
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    VanEmdeBoasOrder(BinarySpaceTree* node,
+                     const size_t height,
+                     std::vector<BinarySpaceTree*>& order)
+{
+  if (height == 1)
+  {
+    order.push_back(node);
+    return;
+  }
+
+  // Lay out the top half of the levels first, then each of the subtrees that
+  // hang below them.
+  const size_t topHeight = height / 2;
+  VanEmdeBoasOrder(node, topHeight, order);
+
+  std::vector<BinarySpaceTree*> bottom;
+  std::stack<std::pair<BinarySpaceTree*, size_t>> stack;
+  stack.push(std::make_pair(node, 0));
+  while (!stack.empty())
+  {
+    BinarySpaceTree* current = stack.top().first;
+    const size_t depth = stack.top().second;
+    stack.pop();
+
+    if (depth == topHeight)
+    {
+      bottom.push_back(current);
+      continue;
+    }
+
+    // Push the right child first so that subtrees are visited left to right.
+    if (current->right)
+      stack.push(std::make_pair(current->right, depth + 1));
+    if (current->left)
+      stack.push(std::make_pair(current->left, depth + 1));
+  }
+
+  for (size_t i = 0; i < bottom.size(); ++i)
+    VanEmdeBoasOrder(bottom[i], height - topHeight, order);
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -874,54 +1118,7 @@ void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
   // Calculate the furthest descendant distance.
   furthestDescendantDistance = 0.5 * bound.Diameter();
 
-  // Now, check if we need to split at all.
-  if (count <= maxLeafSize)
-    return; // We can't split this.
-
-  // splitCol denotes the two partitions of the dataset after the split. The
-  // points on its left go to the left child and the others go to the right
-  // child.
-  size_t splitCol;
-
-  // Find the partition of the node. This method does not perform the split.
-  typename Split::SplitInfo splitInfo;
-
-  const bool split = splitter.SplitNode(bound, *dataset, begin, count,
-      splitInfo);
-
-  // The node may not be always split. For instance, if all the points are the
-  // same, we can't split them.
-  if (!split)
-    return;
-
-  // Perform the actual splitting.  This will order the dataset such that
-  // points that belong to the left subtree are on the left of splitCol, and
-  // points from the right subtree are on the right side of splitCol.
-  splitCol = splitter.PerformSplit(*dataset, begin, count, splitInfo);
-
-  assert(splitCol > begin);
-  assert(splitCol < begin + count);
-
-  // Now that we know the split column, we will recursively split the children
-  // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, splitter,
-      maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
-      splitter, maxLeafSize);
-
-  // Calculate parent distances for those two nodes.
-  arma::vec center, leftCenter, rightCenter;
-  Center(center);
-  left->Center(leftCenter);
-  right->Center(rightCenter);
-
-  const ElemType leftParentDistance = bound.Metric().Evaluate(center,
-      leftCenter);
-  const ElemType rightParentDistance = bound.Metric().Evaluate(center,
-      rightCenter);
-
-  left->ParentDistance() = leftParentDistance;
-  right->ParentDistance() = rightParentDistance;
+  SplitChildren(NULL, maxLeafSize, splitter);
 }
 
 template<typename MetricType,
@@ -941,6 +1138,20 @@ SplitNode(std::vector<size_t>& oldFromNew,
   // Calculate the furthest descendant distance.
   furthestDescendantDistance = 0.5 * bound.Diameter();
 
+  SplitChildren(&oldFromNew, maxLeafSize, splitter);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+SplitChildren(std::vector<size_t>* oldFromNew,
+              const size_t maxLeafSize,
+              SplitType<BoundType<MetricType>, MatType>& splitter)
+{
   // First, check if we need to split at all.
   if (count <= maxLeafSize)
     return; // We can't split this.
@@ -953,6 +1164,8 @@ SplitNode(std::vector<size_t>& oldFromNew,
   // Find the partition of the node. This method does not perform the split.
   typename Split::SplitInfo splitInfo;
 
+  // If the subtrees of a large ancestor are built in parallel, random numbers
+  // come from the random stream of the subtree (see below).
   const bool split = splitter.SplitNode(bound, *dataset, begin, count,
       splitInfo);
 
@@ -964,18 +1177,99 @@ SplitNode(std::vector<size_t>& oldFromNew,
   // Perform the actual splitting.  This will order the dataset such that
   // points that belong to the left subtree are on the left of splitCol, and
   // points from the right subtree are on the right side of splitCol.
-  splitCol = splitter.PerformSplit(*dataset, begin, count, splitInfo,
-      oldFromNew);
+  if (oldFromNew)
+  {
+    splitCol = splitter.PerformSplit(*dataset, begin, count, splitInfo,
+        *oldFromNew);
+  }
+  else
+  {
+    splitCol = splitter.PerformSplit(*dataset, begin, count, splitInfo);
+  }
 
   assert(splitCol > begin);
   assert(splitCol < begin + count);
 
-  // Now that we know the split column, we will recursively split the children
-  // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, oldFromNew,
-      splitter, maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
-      oldFromNew, splitter, maxLeafSize);
+  if (SplitTraits<Split>::SupportsParallelBuild &&
+      count >= ParallelBuildThreshold)
+  {
+    // The bounds of the children are computed in order; after that the two
+    // subtrees are independent, since they hold disjoint ranges of the
+    // dataset (and of oldFromNew).
+    left = NewChild(this, begin, splitCol - begin, BoundOnly());
+    right = NewChild(this, splitCol, begin + count - splitCol, BoundOnly());
+
+    // If the splitter draws random numbers, each subtree draws them from its
+    // own random stream, so that the tree does not depend on the number of
+    // threads or on the order in which they build the subtrees.
+    const size_t seed = SplitTraits<Split>::UsesRandomNumbers ?
+        math::RandomStreamSeed() : 0;
+    auto buildSubtree = [&](BinarySpaceTree* child, const size_t i)
+    {
+      std::unique_ptr<math::RandomStream> stream(
+          SplitTraits<Split>::UsesRandomNumbers ?
+          new math::RandomStream(seed, i) : NULL);
+      child->SplitChildren(oldFromNew, maxLeafSize, splitter);
+      child->stat = StatisticType(*child);
+    };
+
+    // OpenMP tasks need OpenMP 3.0; otherwise the subtrees are built one after
+    // the other.
+    #if defined(_OPENMP) && _OPENMP >= 200805
+    if (omp_get_max_threads() > 1)
+    {
+      auto buildSubtrees = [&]()
+      {
+        BinarySpaceTree* children[2] = { left, right };
+        for (size_t i = 0; i < 2; ++i)
+        {
+          BinarySpaceTree* child = children[i];
+          #pragma omp task firstprivate(child, i)
+          buildSubtree(child, i);
+        }
+        #pragma omp taskwait
+      };
+
+      // Start a team at the first large node; below it, the tasks are spread
+      // over the threads of that team.
+      if (omp_in_parallel())
+      {
+        buildSubtrees();
+      }
+      else
+      {
+        #pragma omp parallel
+        #pragma omp single
+        buildSubtrees();
+      }
+    }
+    else
+    #endif
+    {
+      buildSubtree(left, 0);
+      buildSubtree(right, 1);
+    }
+  }
+  else
+  {
+    // Now that we know the split column, we will recursively split the
+    // children by calling their constructors (which perform this splitting
+    // process).
+    if (oldFromNew)
+    {
+      left = NewChild(this, begin, splitCol - begin, *oldFromNew,
+          splitter, maxLeafSize);
+      right = NewChild(this, splitCol, begin + count - splitCol,
+          *oldFromNew, splitter, maxLeafSize);
+    }
+    else
+    {
+      left = NewChild(this, begin, splitCol - begin, splitter,
+          maxLeafSize);
+      right = NewChild(this, splitCol, begin + count - splitCol,
+          splitter, maxLeafSize);
+    }
+  }
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -1032,6 +1326,25 @@ UpdateBound(bound::HollowBallBound<MetricType>& boundToUpdate)
     boundToUpdate |= dataset->cols(begin, begin + count - 1);
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename BoundElemType, typename CodeType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+UpdateBound(bound::QuantizedHRectBound<MetricType, BoundElemType, CodeType>&
+    boundToUpdate)
+{
+  // The grid of the root is made when its points are added.
+  if (parent)
+    boundToUpdate.ShareGrid(parent->bound);
+
+  if (count > 0)
+    boundToUpdate |= dataset->cols(begin, begin + count - 1);
+}
+
 // Default constructor (private), for cereal.
 template<typename MetricType,
          typename StatisticType,
@@ -1049,7 +1362,8 @@ BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
     stat(*this),
     parentDistance(0),
     furthestDescendantDistance(0),
-    dataset(NULL)
+    dataset(NULL),
+    arena(NULL)
 {
   // Nothing to do.
 }
@@ -1070,16 +1384,11 @@ void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
   // If we're loading, and we have children, they need to be deleted.
   if (cereal::is_loading<Archive>())
   {
-    if (left)
-      delete left;
-    if (right)
-      delete right;
+    FreeChildren();
     if (!parent)
       delete dataset;
 
     parent = NULL;
-    left = NULL;
-    right = NULL;
   }
 
   ar(CEREAL_NVP(begin));
@@ -1134,6 +1443,29 @@ void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
        stack.push(node->right);
     }
   }
+
+  // The nodes were loaded one by one; gather them, in depth-first order, in
+  // the arena of the root.
+  if (cereal::is_loading<Archive>() && !hasParent)
+  {
+    std::vector<BinarySpaceTree*> order;
+    std::stack<BinarySpaceTree*> stack;
+    stack.push(this);
+    while (!stack.empty())
+    {
+      BinarySpaceTree* node = stack.top();
+      stack.pop();
+
+      order.push_back(node);
+      if (node->right)
+        stack.push(node->right);
+      if (node->left)
+        stack.push(node->left);
+    }
+
+    if (order.size() > 1)
+      MoveNodes(order, new NodeArena<BinarySpaceTree>());
+  }
 }
 
 } // namespace tree
@@ -16,12 +16,17 @@
 #define MLPACK_CORE_TREE_BINARY_SPACE_TREE_DUAL_TREE_TRAVERSER_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/sfinae_utility.hpp>
 
 #include "binary_space_tree.hpp"
 
 namespace mlpack {
 namespace tree {
 
+//! Detect whether a RuleType can evaluate all of the base cases between two
+//! leaves at once with a LeafBaseCases(queryNode, referenceNode) method.
+HAS_MEM_FUNC(LeafBaseCases, HasLeafBaseCasesCheck);
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -68,6 +73,28 @@ class BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
   size_t& NumBaseCases() { return numBaseCases; }
 
  private:
+  /**
+   * Evaluate the base cases between two leaves, using the rules'
+   * LeafBaseCases() method so that the distances are computed in one block.
+   */
+  template<typename Rule = RuleType>
+  void LeafBaseCases(BinarySpaceTree& queryNode,
+                     BinarySpaceTree& referenceNode,
+                     const typename std::enable_if<HasLeafBaseCasesCheck<Rule,
+                         size_t(Rule::*)(BinarySpaceTree&,
+                                         BinarySpaceTree&)>::value>::type* = 0);
+
+  /**
+   * Evaluate the base cases between two leaves one pair at a time, for rules
+   * without a LeafBaseCases() method.
+   */
+  template<typename Rule = RuleType>
+  void LeafBaseCases(BinarySpaceTree& queryNode,
+                     BinarySpaceTree& referenceNode,
+                     const typename std::enable_if<!HasLeafBaseCasesCheck<Rule,
+                         size_t(Rule::*)(BinarySpaceTree&,
+                                         BinarySpaceTree&)>::value>::type* = 0);
+
   //! Reference to the rules with which the trees will be traversed.
   RuleType& rule;
 
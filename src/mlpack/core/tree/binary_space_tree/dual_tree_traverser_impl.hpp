@@ -16,6 +16,7 @@
 
 // In case it hasn't been included yet.
 #include "dual_tree_traverser.hpp"
+#include <mlpack/core/tree/traversal_statistics.hpp>
 
 namespace mlpack {
 namespace tree {
@@ -50,6 +51,8 @@ DualTreeTraverser<RuleType>::Traverse(
     BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
         referenceNode)
 {
+  MLPACK_TRAVERSAL_LEVEL(rule, numPrunes);
+
   // Increment the visit counter.
   ++numVisited;
 
@@ -71,25 +74,7 @@ DualTreeTraverser<RuleType>::Traverse(
   // If both are leaves, we must evaluate the base case.
   if (queryNode.IsLeaf() && referenceNode.IsLeaf())
   {
-    // Loop through each of the points in each node.
-    const size_t queryEnd = queryNode.Begin() + queryNode.Count();
-    const size_t refEnd = referenceNode.Begin() + referenceNode.Count();
-    for (size_t query = queryNode.Begin(); query < queryEnd; ++query)
-    {
-      // See if we need to investigate this point (this function should be
-      // implemented for the single-tree recursion too).  Restore the traversal
-      // information first.
-      rule.TraversalInfo() = traversalInfo;
-      const double childScore = rule.Score(query, referenceNode);
-
-      if (childScore == DBL_MAX)
-        continue; // We can't improve this particular point.
-
-      for (size_t ref = referenceNode.Begin(); ref < refEnd; ++ref)
-        rule.BaseCase(query, ref);
-
-      numBaseCases += referenceNode.Count();
-    }
+    LeafBaseCases(queryNode, referenceNode);
   }
   else if (((!queryNode.IsLeaf()) && referenceNode.IsLeaf()) ||
            (queryNode.NumDescendants() > 3 * referenceNode.NumDescendants() &&
@@ -352,6 +337,63 @@ DualTreeTraverser<RuleType>::Traverse(
   }
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+template<typename Rule>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+DualTreeTraverser<RuleType>::LeafBaseCases(
+    BinarySpaceTree& queryNode,
+    BinarySpaceTree& referenceNode,
+    const typename std::enable_if<HasLeafBaseCasesCheck<Rule,
+        size_t(Rule::*)(BinarySpaceTree&, BinarySpaceTree&)>::value>::type*)
+{
+  // The rules will score each query point against the reference node
+  // themselves.
+  rule.TraversalInfo() = traversalInfo;
+  numBaseCases += rule.LeafBaseCases(queryNode, referenceNode);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+template<typename Rule>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+DualTreeTraverser<RuleType>::LeafBaseCases(
+    BinarySpaceTree& queryNode,
+    BinarySpaceTree& referenceNode,
+    const typename std::enable_if<!HasLeafBaseCasesCheck<Rule,
+        size_t(Rule::*)(BinarySpaceTree&, BinarySpaceTree&)>::value>::type*)
+{
+  // Loop through each of the points in each node.
+  const size_t queryEnd = queryNode.Begin() + queryNode.Count();
+  const size_t refEnd = referenceNode.Begin() + referenceNode.Count();
+  for (size_t query = queryNode.Begin(); query < queryEnd; ++query)
+  {
+    // See if we need to investigate this point (this function should be
+    // implemented for the single-tree recursion too).  Restore the traversal
+    // information first.
+    rule.TraversalInfo() = traversalInfo;
+    const double childScore = rule.Score(query, referenceNode);
+
+    if (childScore == DBL_MAX)
+      continue; // We can't improve this particular point.
+
+    for (size_t ref = referenceNode.Begin(); ref < refEnd; ++ref)
+      rule.BaseCase(query, ref);
+
+    numBaseCases += referenceNode.Count();
+  }
+}
+
 } // namespace tree
 } // namespace mlpack
 
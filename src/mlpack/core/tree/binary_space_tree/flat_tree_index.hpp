@@ -0,0 +1,196 @@
+/**
+ * @file core/tree/binary_space_tree/flat_tree_index.hpp
+ *
+ * Definition of FlatTreeIndex, a pointer-free on-disk layout for
+ * BinarySpaceTrees that can be loaded without deserialization.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_FLAT_TREE_INDEX_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_FLAT_TREE_INDEX_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/mapped_matrix.hpp>
+#include "../hrectbound.hpp"
+#include "binary_space_tree.hpp"
+
+namespace mlpack {
+namespace tree {
+
+//! Determine whether or not a bound type is a hyperrectangle bound.
+template<typename BoundType>
+struct IsHRectBound
+{
+  static const bool value = false;
+};
+
+//! HRectBound is a hyperrectangle bound.
+template<typename MetricType, typename ElemType>
+struct IsHRectBound<bound::HRectBound<MetricType, ElemType>>
+{
+  static const bool value = true;
+};
+
+/**
+ * A FlatTreeIndex stores a BinarySpaceTree (along with its dataset and the
+ * mapping of points produced when the tree was built) in a flat,
+ * pointer-free file.  The nodes are written in preorder as an array of
+ * fixed-size records holding child offsets, and the bounds of every node are
+ * written as one contiguous array.  The dataset is stored last, so that when
+ * the index is loaded it can be memory-mapped with data::MappedMatrix instead
+ * of being read; this means that loading takes a single read of the node
+ * arrays, and that several processes using the same index share one copy of
+ * the dataset in the page cache.
+ *
+ * The file is written in the native byte order of the machine, so it is not
+ * portable between architectures.  Tree statistics are not stored; they are
+ * rebuilt from the nodes, just like when the tree is constructed.  Only trees
+ * with hyperrectangle bounds (like the kd-tree) are supported, and the tree's
+ * MatType must be a dense Armadillo matrix.
+ *
+ * @code
+ * // Build and save an index once...
+ * std::vector<size_t> oldFromNew;
+ * KDTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>, arma::mat>
+ *     tree(dataset, oldFromNew);
+ * FlatTreeIndex<decltype(tree)>::Save("index.bin", tree, oldFromNew);
+ *
+ * // ...then load it quickly as many times as needed.
+ * FlatTreeIndex<decltype(tree)> index("index.bin");
+ * index.Tree(); // Use the tree.
+ * @endcode
+ *
+ * The tree returned by Tree() refers to memory owned by the FlatTreeIndex,
+ * so it (and any object it is moved into) must not outlive the index.
+ *
+ * @tparam TreeType Type of BinarySpaceTree to store.
+ */
+template<typename TreeType>
+class FlatTreeIndex
+{
+  static_assert(IsHRectBound<typename std::remove_reference<
+      decltype(std::declval<TreeType&>().Bound())>::type>::value,
+      "FlatTreeIndex only supports trees with HRectBound bounds.");
+
+ public:
+  //! The type of element held by the tree.
+  typedef typename TreeType::ElemType ElemType;
+
+  /**
+   * Save the given tree in flat format.  If the tree was built with a mapping
+   * of points, it should be given too so that it can be restored at load time.
+   * An exception is thrown if the file cannot be written.
+   *
+   * @param filename File to save to.
+   * @param tree Root of the tree to save.
+   * @param oldFromNew Mapping from new point indices to original indices.
+   */
+  static void Save(const std::string& filename,
+                   const TreeType& tree,
+                   const std::vector<size_t>& oldFromNew =
+                       std::vector<size_t>());
+
+  /**
+   * Load the flat index from the given file.  The node arrays are read and the
+   * tree is reconstructed from them, and the dataset is memory-mapped.  An
+   * exception is thrown if the file is not a valid index for this tree type.
+   *
+   * @param filename File to load from.
+   */
+  FlatTreeIndex(const std::string& filename);
+
+  //! Copying an index is not allowed.
+  FlatTreeIndex(const FlatTreeIndex& other) = delete;
+  //! Copying an index is not allowed.
+  FlatTreeIndex& operator=(const FlatTreeIndex& other) = delete;
+
+  //! Delete the tree and unmap the dataset.
+  ~FlatTreeIndex();
+
+  //! Get the loaded tree.
+  const TreeType& Tree() const { return *tree; }
+  //! Modify the loaded tree.
+  TreeType& Tree() { return *tree; }
+
+  //! Get the mapping from new point indices to original indices.  This is
+  //! empty if no mapping was saved.
+  const std::vector<size_t>& OldFromNew() const { return oldFromNew; }
+
+ private:
+  //! A single node record in the file.
+  struct Node
+  {
+    //! Index of the first point held by the node.
+    uint64_t begin;
+    //! Number of points held by the node.
+    uint64_t count;
+    //! Index of the left child record (0 if there is none).
+    uint64_t left;
+    //! Index of the right child record (0 if there is none).
+    uint64_t right;
+    //! Distance from the node's centroid to its parent's centroid.
+    double parentDistance;
+    //! Cached furthest descendant distance.
+    double furthestDescendantDistance;
+    //! Minimum width of the bound.
+    double minWidth;
+  };
+
+  //! The header of the file.
+  struct Header
+  {
+    //! Identifies the file format.
+    char magic[8];
+    //! Version of the file format.
+    uint64_t version;
+    //! Size of each element of the tree.
+    uint64_t elemSize;
+    //! Dimensionality of the dataset.
+    uint64_t dimensionality;
+    //! Number of points in the dataset.
+    uint64_t numPoints;
+    //! Number of nodes in the tree.
+    uint64_t numNodes;
+    //! Number of elements in the stored mapping (0 or numPoints).
+    uint64_t mappingSize;
+    //! Offset of the dataset in the file (in bytes).
+    uint64_t dataOffset;
+  };
+
+  //! Append the given node and its descendants to the flat arrays, returning
+  //! the index of the node's record.
+  static size_t Flatten(const TreeType& node,
+                        std::vector<Node>& nodes,
+                        std::vector<double>& bounds);
+
+  //! Check that the child offsets and point ranges of the given records
+  //! describe a tree over the given number of points; return a description of
+  //! the first problem, or an empty string if there is none.
+  static std::string CheckNodes(const std::vector<Node>& nodes,
+                                const uint64_t numPoints);
+
+  //! Rebuild the node with the given record index from the flat arrays.
+  TreeType* Unflatten(const size_t index,
+                      TreeType* parent,
+                      const std::vector<Node>& nodes,
+                      const std::vector<double>& bounds,
+                      const size_t dimensionality);
+
+  //! The mapped dataset.
+  data::MappedMatrix<ElemType>* mapping;
+  //! The root of the tree.
+  TreeType* tree;
+  //! The mapping from new point indices to original indices.
+  std::vector<size_t> oldFromNew;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "flat_tree_index_impl.hpp"
+
+#endif
@@ -0,0 +1,323 @@
+/**
+ * @file core/tree/binary_space_tree/flat_tree_index_impl.hpp
+ *
+ * Implementation of FlatTreeIndex.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_FLAT_TREE_INDEX_IMPL_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_FLAT_TREE_INDEX_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "flat_tree_index.hpp"
+
+#include <cstring>
+#include <fstream>
+
+namespace mlpack {
+namespace tree {
+
+template<typename TreeType>
+void FlatTreeIndex<TreeType>::Save(const std::string& filename,
+                                   const TreeType& tree,
+                                   const std::vector<size_t>& oldFromNew)
+{
+  if (tree.Parent() != NULL)
+    throw std::invalid_argument("FlatTreeIndex::Save(): the given node must be "
+        "the root of the tree!");
+
+  if (!oldFromNew.empty() && oldFromNew.size() != tree.Dataset().n_cols)
+    throw std::invalid_argument("FlatTreeIndex::Save(): size of oldFromNew "
+        "does not match the number of points in the tree!");
+
+  std::vector<Node> nodes;
+  std::vector<double> bounds;
+  Flatten(tree, nodes, bounds);
+
+  Header header;
+  std::memcpy(header.magic, "MLPKFTI\0", 8);
+  header.version = 1;
+  header.elemSize = sizeof(ElemType);
+  header.dimensionality = tree.Dataset().n_rows;
+  header.numPoints = tree.Dataset().n_cols;
+  header.numNodes = nodes.size();
+  header.mappingSize = oldFromNew.size();
+
+  // Align the start of the dataset to 64 bytes.
+  const size_t used = sizeof(Header) + nodes.size() * sizeof(Node) +
+      bounds.size() * sizeof(double) + oldFromNew.size() * sizeof(uint64_t);
+  header.dataOffset = ((used + 63) / 64) * 64;
+
+  std::ofstream out(filename, std::ios::binary);
+  if (!out.is_open())
+  {
+    std::ostringstream oss;
+    oss << "FlatTreeIndex::Save(): cannot open '" << filename << "' for "
+        << "writing.";
+    throw std::runtime_error(oss.str());
+  }
+
+  out.write((const char*) &header, sizeof(Header));
+  out.write((const char*) nodes.data(), nodes.size() * sizeof(Node));
+  out.write((const char*) bounds.data(), bounds.size() * sizeof(double));
+  for (size_t i = 0; i < oldFromNew.size(); ++i)
+  {
+    const uint64_t index = oldFromNew[i];
+    out.write((const char*) &index, sizeof(uint64_t));
+  }
+
+  const std::vector<char> padding(header.dataOffset - used, 0);
+  out.write(padding.data(), padding.size());
+  out.write((const char*) tree.Dataset().memptr(),
+      tree.Dataset().n_elem * sizeof(ElemType));
+
+  if (!out.good())
+  {
+    std::ostringstream oss;
+    oss << "FlatTreeIndex::Save(): error writing to '" << filename << "'.";
+    throw std::runtime_error(oss.str());
+  }
+}
+
+template<typename TreeType>
+FlatTreeIndex<TreeType>::FlatTreeIndex(const std::string& filename) :
+    mapping(NULL),
+    tree(NULL)
+{
+  std::ifstream in(filename, std::ios::binary);
+  if (!in.is_open())
+  {
+    std::ostringstream oss;
+    oss << "FlatTreeIndex: cannot open '" << filename << "'.";
+    throw std::runtime_error(oss.str());
+  }
+
+  Header header;
+  in.read((char*) &header, sizeof(Header));
+  if (!in.good() || std::memcmp(header.magic, "MLPKFTI\0", 8) != 0 ||
+      header.version != 1)
+  {
+    std::ostringstream oss;
+    oss << "FlatTreeIndex: '" << filename << "' is not a flat tree index.";
+    throw std::runtime_error(oss.str());
+  }
+
+  if (header.elemSize != sizeof(ElemType))
+  {
+    std::ostringstream oss;
+    oss << "FlatTreeIndex: '" << filename << "' holds elements of size "
+        << header.elemSize << ", but the tree type has elements of size "
+        << sizeof(ElemType) << ".";
+    throw std::runtime_error(oss.str());
+  }
+
+  // Make sure that the sizes in the header fit in the file before allocating
+  // anything for them.
+  in.seekg(0, std::ios::end);
+  const uint64_t fileSize = (uint64_t) in.tellg();
+  in.seekg(sizeof(Header), std::ios::beg);
+  const uint64_t maxCount = fileSize / sizeof(double);
+  if (header.numNodes == 0 || header.numNodes > fileSize / sizeof(Node) ||
+      header.dimensionality > maxCount / (2 * header.numNodes) ||
+      (header.mappingSize != 0 && header.mappingSize != header.numPoints) ||
+      header.mappingSize > maxCount || header.dataOffset > fileSize ||
+      (header.dimensionality > 0 && header.numPoints >
+          (fileSize - header.dataOffset) / sizeof(ElemType) /
+          header.dimensionality))
+  {
+    std::ostringstream oss;
+    oss << "FlatTreeIndex: '" << filename << "' is truncated or has an "
+        << "invalid header.";
+    throw std::runtime_error(oss.str());
+  }
+
+  std::vector<Node> nodes(header.numNodes);
+  std::vector<double> bounds(2 * header.dimensionality * header.numNodes);
+  std::vector<uint64_t> storedMapping(header.mappingSize);
+  in.read((char*) nodes.data(), nodes.size() * sizeof(Node));
+  in.read((char*) bounds.data(), bounds.size() * sizeof(double));
+  in.read((char*) storedMapping.data(),
+      storedMapping.size() * sizeof(uint64_t));
+  if (!in.good() || (uint64_t) in.tellg() > header.dataOffset)
+  {
+    std::ostringstream oss;
+    oss << "FlatTreeIndex: '" << filename << "' is truncated.";
+    throw std::runtime_error(oss.str());
+  }
+  in.close();
+
+  // Check the stored indices, so that the tree built from them cannot refer to
+  // records or points that do not exist.
+  const std::string error = CheckNodes(nodes, header.numPoints);
+  if (!error.empty())
+  {
+    std::ostringstream oss;
+    oss << "FlatTreeIndex: '" << filename << "' is not a valid index: "
+        << error << ".";
+    throw std::runtime_error(oss.str());
+  }
+
+  for (size_t i = 0; i < storedMapping.size(); ++i)
+  {
+    if (storedMapping[i] >= header.numPoints)
+    {
+      std::ostringstream oss;
+      oss << "FlatTreeIndex: '" << filename << "' is not a valid index: "
+          << "mapped point " << storedMapping[i] << " is out of range.";
+      throw std::runtime_error(oss.str());
+    }
+  }
+
+  oldFromNew.assign(storedMapping.begin(), storedMapping.end());
+
+  // Now map the dataset, and rebuild the nodes on top of it.
+  mapping = new data::MappedMatrix<ElemType>(filename, header.dimensionality,
+      header.numPoints, false, header.dataOffset);
+  tree = Unflatten(0, NULL, nodes, bounds, header.dimensionality);
+}
+
+template<typename TreeType>
+FlatTreeIndex<TreeType>::~FlatTreeIndex()
+{
+  // The tree must be deleted before the memory it refers to is unmapped.
+  delete tree;
+  delete mapping;
+}
+
+template<typename TreeType>
+size_t FlatTreeIndex<TreeType>::Flatten(const TreeType& node,
+                                        std::vector<Node>& nodes,
+                                        std::vector<double>& bounds)
+{
+  const size_t index = nodes.size();
+
+  Node record;
+  record.begin = node.begin;
+  record.count = node.count;
+  record.left = 0;
+  record.right = 0;
+  record.parentDistance = node.parentDistance;
+  record.furthestDescendantDistance = node.furthestDescendantDistance;
+  record.minWidth = node.bound.MinWidth();
+  nodes.push_back(record);
+
+  for (size_t d = 0; d < node.bound.Dim(); ++d)
+  {
+    bounds.push_back(node.bound[d].Lo());
+    bounds.push_back(node.bound[d].Hi());
+  }
+
+  // The root is always record 0, so 0 can mark a missing child.
+  if (node.left)
+    nodes[index].left = Flatten(*node.left, nodes, bounds);
+  if (node.right)
+    nodes[index].right = Flatten(*node.right, nodes, bounds);
+
+  return index;
+}
+
+template<typename TreeType>
+std::string FlatTreeIndex<TreeType>::CheckNodes(const std::vector<Node>& nodes,
+                                                const uint64_t numPoints)
+{
+  // The records are in preorder, so the children of a record come after it;
+  // each record other than the root must be the child of exactly one record.
+  std::vector<bool> isChild(nodes.size(), false);
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    const Node& record = nodes[i];
+    std::ostringstream oss;
+    if (record.begin > numPoints || record.count > numPoints - record.begin)
+    {
+      oss << "node " << i << " holds points outside of the dataset";
+      return oss.str();
+    }
+
+    const uint64_t children[2] = { record.left, record.right };
+    for (size_t c = 0; c < 2; ++c)
+    {
+      if (children[c] == 0)
+        continue;
+
+      if (children[c] <= i || children[c] >= nodes.size() ||
+          isChild[children[c]])
+      {
+        oss << "node " << i << " has an invalid child offset " << children[c];
+        return oss.str();
+      }
+
+      // The points of a child must be held by its parent too.
+      const Node& child = nodes[children[c]];
+      const uint64_t end = record.begin + record.count;
+      if (child.begin < record.begin || child.begin > end ||
+          child.count > end - child.begin)
+      {
+        oss << "child " << children[c] << " of node " << i << " holds points "
+            << "outside of its parent";
+        return oss.str();
+      }
+
+      isChild[children[c]] = true;
+    }
+  }
+
+  return std::string();
+}
+
+template<typename TreeType>
+TreeType* FlatTreeIndex<TreeType>::Unflatten(
+    const size_t index,
+    TreeType* parent,
+    const std::vector<Node>& nodes,
+    const std::vector<double>& bounds,
+    const size_t dimensionality)
+{
+  if (index >= nodes.size())
+    throw std::runtime_error("FlatTreeIndex: invalid child offset in index.");
+
+  typedef typename std::remove_reference<decltype(
+      std::declval<TreeType&>().Bound())>::type BoundType;
+  typedef typename std::remove_reference<decltype(
+      std::declval<TreeType&>().Stat())>::type StatisticType;
+
+  const Node& record = nodes[index];
+
+  // The nodes other than the root are held in the arena of the root.
+  TreeType* node = (parent == NULL) ? new TreeType() : parent->NewChild();
+  node->arena = (parent == NULL) ? NULL : parent->arena;
+  node->parent = parent;
+  node->begin = record.begin;
+  node->count = record.count;
+  node->parentDistance = record.parentDistance;
+  node->furthestDescendantDistance = record.furthestDescendantDistance;
+  node->minimumBoundDistance = record.minWidth / 2.0;
+  node->dataset = (parent == NULL) ?
+      new typename TreeType::Mat(mapping->Matrix()) : parent->dataset;
+
+  node->bound = BoundType(dimensionality);
+  const double* nodeBounds = bounds.data() + 2 * dimensionality * index;
+  for (size_t d = 0; d < dimensionality; ++d)
+  {
+    node->bound[d].Lo() = nodeBounds[2 * d];
+    node->bound[d].Hi() = nodeBounds[2 * d + 1];
+  }
+  node->bound.MinWidth() = record.minWidth;
+
+  if (record.left != 0)
+    node->left = Unflatten(record.left, node, nodes, bounds, dimensionality);
+  if (record.right != 0)
+    node->right = Unflatten(record.right, node, nodes, bounds, dimensionality);
+
+  // Statistics are built bottom-up, just like during tree construction.
+  node->stat = StatisticType(*node);
+
+  return node;
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
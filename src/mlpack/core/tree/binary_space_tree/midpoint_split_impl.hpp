@@ -29,6 +29,7 @@ bool MidpointSplit<BoundType, MatType>::SplitNode(const BoundType& bound,
 {
   double maxWidth = -1;
   splitInfo.splitDimension = data.n_rows; // Indicate invalid.
+  math::Range dataRange;
 
   // Find the split dimension.  If the bound is tight, we only need to consult
   // the bound's width.
@@ -75,6 +76,7 @@ bool MidpointSplit<BoundType, MatType>::SplitNode(const BoundType& bound,
         splitInfo.splitDimension = d;
         // Split in the midpoint of that dimension.
         splitInfo.splitVal = ranges[d].Mid();
+        dataRange = ranges[d];
       }
     }
 
@@ -87,6 +89,13 @@ bool MidpointSplit<BoundType, MatType>::SplitNode(const BoundType& bound,
   // Split in the midpoint of that dimension.
   splitInfo.splitVal = bound[splitInfo.splitDimension].Mid();
 
+  // A loose bound (such as a QuantizedHRectBound) may be much wider than the
+  // points, and then its midpoint may not separate them.
+  if (!bound::BoundTraits<BoundType>::HasTightBounds &&
+      (splitInfo.splitVal <= dataRange.Lo() ||
+       splitInfo.splitVal > dataRange.Hi()))
+    splitInfo.splitVal = dataRange.Mid();
+
   return true;
 }
 
@@ -15,6 +15,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/tree/perform_split.hpp>
+#include "split_traits.hpp"
 
 namespace mlpack {
 namespace tree /** Trees and tree-building procedures. */ {
@@ -137,6 +138,14 @@ class RPTreeMaxSplit
                           ElemType& splitVal);
 };
 
+//! RPTreeMaxSplit draws random numbers in SplitNode().
+template<typename BoundType, typename MatType>
+struct SplitTraits<RPTreeMaxSplit<BoundType, MatType>>
+{
+  static const bool SupportsParallelBuild = true;
+  static const bool UsesRandomNumbers = true;
+};
+
 } // namespace tree
 } // namespace mlpack
 
@@ -16,6 +16,7 @@
 #include <mlpack/prereqs.hpp>
 #include "rp_tree_max_split.hpp"
 #include <mlpack/core/tree/perform_split.hpp>
+#include "split_traits.hpp"
 #include <mlpack/core/math/lin_alg.hpp>
 
 namespace mlpack {
@@ -168,6 +169,14 @@ class RPTreeMeanSplit
                             ElemType& splitVal);
 };
 
+//! RPTreeMeanSplit draws random numbers in SplitNode().
+template<typename BoundType, typename MatType>
+struct SplitTraits<RPTreeMeanSplit<BoundType, MatType>>
+{
+  static const bool SupportsParallelBuild = true;
+  static const bool UsesRandomNumbers = true;
+};
+
 } // namespace tree
 } // namespace mlpack
 
@@ -16,6 +16,7 @@
 
 // In case it hasn't been included yet.
 #include "single_tree_traverser.hpp"
+#include <mlpack/core/tree/traversal_statistics.hpp>
 
 #include <stack>
 
@@ -48,6 +49,8 @@ SingleTreeTraverser<RuleType>::Traverse(
     BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>&
         referenceNode)
 {
+  MLPACK_TRAVERSAL_LEVEL(rule, numPrunes);
+
   // If we are a leaf, run the base case as necessary.
   if (referenceNode.IsLeaf())
   {
@@ -0,0 +1,44 @@
+/**
+ * @file core/tree/binary_space_tree/split_traits.hpp
+ *
+ * A class for template metaprogramming traits for the splitters of
+ * BinarySpaceTree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_SPLIT_TRAITS_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_SPLIT_TRAITS_HPP
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A class to obtain compile-time traits about the SplitType classes of
+ * BinarySpaceTree (and about the numeric and categorical splitters of
+ * DecisionTree, for which only UsesRandomNumbers is used).  If you are writing
+ * your own SplitType class, you should make a template specialization in
+ * order to set the values correctly.
+ *
+ * @see TreeTraits, BoundTraits
+ */
+template<typename SplitType>
+struct SplitTraits
+{
+  //! If true, then the two subtrees of a large node may be built in parallel,
+  //! so SplitNode() and PerformSplit() may be called concurrently for
+  //! disjoint ranges of points.  This defaults to true.
+  static const bool SupportsParallelBuild = true;
+
+  //! If true, then SplitNode() draws random numbers with the functions of
+  //! mlpack::math, so that subtrees (or dimensions) searched in parallel must
+  //! each get their own math::RandomStream.  This defaults to false.
+  static const bool UsesRandomNumbers = false;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
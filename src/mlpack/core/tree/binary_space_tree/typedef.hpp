@@ -79,6 +79,24 @@ using MeanSplitKDTree = BinarySpaceTree<MetricType,
                                         bound::HRectBound,
                                         MeanSplit>;
 
+/**
+ * A kd-tree whose bounds are quantized on a grid (see QuantizedHRectBound), so
+ * that each bound takes four bytes per dimension instead of sixteen.  The
+ * bounds are slightly looser than those of the KDTree, but searches with this
+ * tree are still exact.  This is useful for large high-dimensional datasets,
+ * for which the bounds of a KDTree take about as much memory as the data.
+ *
+ * This template typedef satisfies the TreeType policy API.
+ *
+ * @see @ref trees, BinarySpaceTree, KDTree
+ */
+template<typename MetricType, typename StatisticType, typename MatType>
+using QuantizedKDTree = BinarySpaceTree<MetricType,
+                                        StatisticType,
+                                        MatType,
+                                        bound::QuantizedHRectBound,
+                                        MidpointSplit>;
+
 /**
  * A midpoint-split ball tree.  This tree holds its points only in the leaves,
  * similar to the KDTree and MeanSplitKDTree.  However, the bounding shape of
@@ -15,6 +15,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include "../address.hpp"
+#include "split_traits.hpp"
 
 namespace mlpack {
 namespace tree /** Trees and tree-building procedures. */ {
@@ -111,6 +112,16 @@ class UBTreeSplit
   }
 };
 
+//! UBTreeSplit keeps the addresses of all points in the splitter, and
+//! SplitNode() modifies the addresses next to the node, so nodes cannot be
+//! split concurrently.
+template<typename BoundType, typename MatType>
+struct SplitTraits<UBTreeSplit<BoundType, MatType>>
+{
+  static const bool SupportsParallelBuild = false;
+  static const bool UsesRandomNumbers = false;
+};
+
 } // namespace tree
 } // namespace mlpack
 
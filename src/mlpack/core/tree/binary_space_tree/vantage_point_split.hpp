@@ -15,6 +15,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/tree/perform_split.hpp>
+#include "split_traits.hpp"
 #include <mlpack/core/math/random.hpp>
 
 namespace mlpack {
@@ -166,6 +167,14 @@ class VantagePointSplit
                                  ElemType& mu);
 };
 
+//! VantagePointSplit draws random numbers in SplitNode().
+template<typename BoundType, typename MatType, size_t MaxNumSamples>
+struct SplitTraits<VantagePointSplit<BoundType, MatType, MaxNumSamples>>
+{
+  static const bool SupportsParallelBuild = true;
+  static const bool UsesRandomNumbers = true;
+};
+
 } // namespace tree
 } // namespace mlpack
 
@@ -20,5 +20,6 @@
 #include "ballbound.hpp"
 #include "hollow_ball_bound.hpp"
 #include "cellbound.hpp"
+#include "quantized_hrectbound.hpp"
 
 #endif // MLPACK_CORE_TREE_BOUNDS_HPP
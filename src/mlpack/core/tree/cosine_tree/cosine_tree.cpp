@@ -11,6 +11,7 @@
  */
 #include "cosine_tree.hpp"
 #include <mlpack/core/util/log.hpp>
+#include <mlpack/core/math/random.hpp>
 
 #include <boost/math/distributions/normal.hpp>
 
@@ -30,11 +31,11 @@ CosineTree::CosineTree(const arma::mat& dataset) :
   l2NormsSquared.zeros(numColumns);
 
   // Set indices and calculate squared norms of the columns.
-  for (size_t i = 0; i < numColumns; ++i)
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numColumns; ++i)
   {
     indices[i] = i;
-    double l2Norm = arma::norm(dataset.col(i), 2);
-    l2NormsSquared(i) = l2Norm * l2Norm;
+    l2NormsSquared(i) = arma::dot(dataset.col(i), dataset.col(i));
   }
 
   // Frobenius norm of columns in the node.
@@ -77,13 +78,20 @@ CosineTree::CosineTree(CosineTree& parentNode,
 
 CosineTree::CosineTree(const arma::mat& dataset,
                        const double epsilon,
-                       const double delta) :
+                       const double delta,
+                       const size_t expansionsPerRound) :
     dataset(&dataset),
     delta(delta),
     left(NULL),
     right(NULL),
     localDataset(false)
 {
+  if (expansionsPerRound == 0)
+  {
+    throw std::invalid_argument("CosineTree::CosineTree(): expansionsPerRound "
+        "must be positive!");
+  }
+
   // Declare the cosine tree priority queue.
   CosineNodeQueue treeQueue;
 
@@ -97,17 +105,24 @@ CosineTree::CosineTree(const arma::mat& dataset,
   // Initialize Monte Carlo error estimate for comparison.
   double monteCarloError = root.FrobNormSquared();
 
+  std::vector<CosineTree*> expanded, children;
   while (treeQueue.size() > 0 &&
          (monteCarloError > epsilon * root.FrobNormSquared()))
   {
-    // Pop node from queue with highest projection error.
-    CosineTree* currentNode;
-    currentNode = treeQueue.top();
-    treeQueue.pop();
-
-    // If the priority is 0, we can't improve anything, and we can assume that
-    // we've done the best we can.
-    if (currentNode->L2Error() == 0.0)
+    // Pop the nodes from the queue with highest projection error.  If the
+    // priority of a node is 0, we can't improve anything by splitting it, so we
+    // stop there.
+    expanded.clear();
+    while (expanded.size() < expansionsPerRound && treeQueue.size() > 0 &&
+           treeQueue.top()->L2Error() != 0.0)
+    {
+      expanded.push_back(treeQueue.top());
+      treeQueue.pop();
+    }
+
+    // If the highest priority is 0, we can assume that we've done the best we
+    // can.
+    if (expanded.empty())
     {
       Log::Warn << "CosineTree::CosineTree(): could not build tree to "
           << "desired relative error " << epsilon << "; failing with estimated "
@@ -116,37 +131,73 @@ CosineTree::CosineTree(const arma::mat& dataset,
       break;
     }
 
-    // Split the node into left and right children.  We assume that this cannot
-    // fail; it might fail if L2Error() is 0, but we have already avoided that
-    // case.
-    currentNode->CosineNodeSplit();
+    // Split the nodes into left and right children.  We assume that this
+    // cannot fail; it might fail if L2Error() is 0, but we have already avoided
+    // that case.  Each split samples from its own stream, so the tree does not
+    // depend on the number of threads.
+    const size_t splitSeed = math::RandomStreamSeed();
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) expanded.size(); ++i)
+    {
+      math::RandomStream stream(splitSeed, i);
+      expanded[i]->CosineNodeSplit();
+    }
 
-    // Obtain pointers to the left and right children of the current node.
-    CosineTree *currentLeft, *currentRight;
-    currentLeft = currentNode->Left();
-    currentRight = currentNode->Right();
+    children.clear();
+    for (size_t i = 0; i < expanded.size(); ++i)
+    {
+      children.push_back(expanded[i]->Left());
+      children.push_back(expanded[i]->Right());
+    }
 
-    // Calculate basis vectors of left and right children.
-    arma::vec lBasisVector, rBasisVector;
+    // Calculate basis vectors of the children: remove the projections of all
+    // the centroids onto the current basis at once, then orthonormalize them
+    // against each other in order.
+    arma::mat queueBasis;
+    QueueBasis(treeQueue, queueBasis);
 
-    ModifiedGramSchmidt(treeQueue, currentLeft->Centroid(), lBasisVector);
-    ModifiedGramSchmidt(treeQueue, currentRight->Centroid(), rBasisVector,
-                        &lBasisVector);
+    arma::mat centroids(dataset.n_rows, children.size());
+    for (size_t i = 0; i < children.size(); ++i)
+      centroids.col(i) = children[i]->Centroid();
 
-    // Add basis vectors to their respective nodes.
-    currentLeft->BasisVector(lBasisVector);
-    currentRight->BasisVector(rBasisVector);
+    arma::mat newBasis = centroids;
+    if (queueBasis.n_cols > 0)
+      newBasis -= queueBasis * (queueBasis.t() * centroids);
+
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+      if (i > 0)
+      {
+        newBasis.col(i) -= newBasis.head_cols(i) *
+            (newBasis.head_cols(i).t() * centroids.col(i));
+      }
+
+      const double norm = arma::norm(newBasis.col(i), 2);
+      if (norm)
+        newBasis.col(i) /= norm;
+
+      // Add basis vectors to their respective nodes.
+      arma::vec basisVector = newBasis.col(i);
+      children[i]->BasisVector(basisVector);
+    }
 
     // Calculate Monte Carlo error estimates for child nodes.
-    MonteCarloError(currentLeft, treeQueue, &lBasisVector, &rBasisVector);
-    MonteCarloError(currentRight, treeQueue, &lBasisVector, &rBasisVector);
+    const arma::mat subspaceBasis = arma::join_rows(queueBasis, newBasis);
+    const size_t errorSeed = math::RandomStreamSeed();
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) children.size(); ++i)
+    {
+      math::RandomStream stream(errorSeed, i);
+      MonteCarloError(children[i], subspaceBasis);
+    }
 
     // Push child nodes into the priority queue.
-    treeQueue.push(currentLeft);
-    treeQueue.push(currentRight);
+    for (size_t i = 0; i < children.size(); ++i)
+      treeQueue.push(children[i]);
 
-    // Calculate Monte Carlo error estimate for the root node.
-    monteCarloError = MonteCarloError(&root, treeQueue);
+    // Calculate Monte Carlo error estimate for the root node.  The basis of the
+    // queue is now exactly the subspace basis.
+    monteCarloError = MonteCarloError(&root, subspaceBasis);
   }
 
   // Construct the subspace basis from the current priority queue.
@@ -372,39 +423,53 @@ void CosineTree::ModifiedGramSchmidt(CosineNodeQueue& treeQueue,
                                      arma::vec& newBasisVector,
                                      arma::vec* addBasisVector)
 {
-  // Set new basis vector to centroid.
-  newBasisVector = centroid;
-
-  // Variables for iterating throught the priority queue.
-  CosineTree *currentNode;
-  CosineNodeQueue::const_iterator i = treeQueue.begin();
-
-  // For every vector in the current basis, remove its projection from the
-  // centroid.
-  for ( ; i != treeQueue.end(); ++i)
-  {
-    currentNode = *i;
+  // Collect the current basis, including the additional basis vector if it is
+  // passed.
+  arma::mat subspaceBasis;
+  QueueBasis(treeQueue, subspaceBasis, addBasisVector ? 1 : 0);
+  if (addBasisVector)
+    subspaceBasis.col(subspaceBasis.n_cols - 1) = *addBasisVector;
 
-    double projection = arma::dot(currentNode->BasisVector(), centroid);
-    newBasisVector -= projection * currentNode->BasisVector();
-  }
+  ModifiedGramSchmidt(subspaceBasis, centroid, newBasisVector);
+}
 
-  // If additional basis vector is passed, take it into account.
-  if (addBasisVector)
-  {
-    double projection = arma::dot(*addBasisVector, centroid);
-    newBasisVector -= *addBasisVector * projection;
-  }
+void CosineTree::ModifiedGramSchmidt(const arma::mat& subspaceBasis,
+                                     const arma::vec& centroid,
+                                     arma::vec& newBasisVector)
+{
+  // Set new basis vector to centroid, and remove its projection onto every
+  // vector in the current basis.
+  newBasisVector = centroid;
+  if (subspaceBasis.n_cols > 0)
+    newBasisVector -= subspaceBasis * (subspaceBasis.t() * centroid);
 
   // Normalize the modified centroid vector.
-  if (arma::norm(newBasisVector, 2))
-    newBasisVector /= arma::norm(newBasisVector, 2);
+  const double norm = arma::norm(newBasisVector, 2);
+  if (norm)
+    newBasisVector /= norm;
 }
 
 double CosineTree::MonteCarloError(CosineTree* node,
                                    CosineNodeQueue& treeQueue,
                                    arma::vec* addBasisVector1,
                                    arma::vec* addBasisVector2)
+{
+  // Collect the current basis, including the additional basis vectors if both
+  // are passed.
+  const bool addVectors = (addBasisVector1 && addBasisVector2);
+  arma::mat subspaceBasis;
+  QueueBasis(treeQueue, subspaceBasis, addVectors ? 2 : 0);
+  if (addVectors)
+  {
+    subspaceBasis.col(subspaceBasis.n_cols - 2) = *addBasisVector1;
+    subspaceBasis.col(subspaceBasis.n_cols - 1) = *addBasisVector2;
+  }
+
+  return MonteCarloError(node, subspaceBasis);
+}
+
+double CosineTree::MonteCarloError(CosineTree* node,
+                                   const arma::mat& subspaceBasis)
 {
   std::vector<size_t> sampledIndices;
   arma::vec probabilities;
@@ -414,55 +479,19 @@ double CosineTree::MonteCarloError(CosineTree* node,
   size_t numSamples = log(node->NumColumns()) + 1;
   node->ColumnSamplesLS(sampledIndices, probabilities, numSamples);
 
-  // Get pointer to the original dataset.
-  const arma::mat& dataset = node->GetDataset();
-
-  // Initialize weighted projection magnitudes as zeros.
+  // Calculate the weighted projection magnitudes of all the samples onto the
+  // current basis at once.
   arma::vec weightedMagnitudes;
-  weightedMagnitudes.zeros(numSamples);
-
-  // Set size of projection vector, depending on whether additional basis
-  // vectors are passed.
-  size_t projectionSize;
-  if (addBasisVector1 && addBasisVector2)
-    projectionSize = treeQueue.size() + 2;
+  if (subspaceBasis.n_cols > 0)
+  {
+    const arma::mat samples = node->GetDataset().cols(
+        arma::conv_to<arma::uvec>::from(sampledIndices));
+    weightedMagnitudes = arma::sum(arma::square(subspaceBasis.t() * samples),
+        0).t() / probabilities;
+  }
   else
-    projectionSize = treeQueue.size();
-
-  // For each sample, calculate the weighted projection onto the current basis.
-  for (size_t i = 0; i < numSamples; ++i)
   {
-    // Initialize projection as a vector of zeros.
-    arma::vec projection;
-    projection.zeros(projectionSize);
-
-    CosineTree *currentNode;
-    CosineNodeQueue::const_iterator j = treeQueue.begin();
-
-    size_t k = 0;
-    // Compute the projection of the sampled vector onto the existing subspace.
-    for ( ; j != treeQueue.end(); ++j, ++k)
-    {
-      currentNode = *j;
-
-      projection(k) = arma::dot(dataset.col(sampledIndices[i]),
-                                currentNode->BasisVector());
-    }
-    // If two additional vectors are passed, take their projections.
-    if (addBasisVector1 && addBasisVector2)
-    {
-      projection(k++) = arma::dot(dataset.col(sampledIndices[i]),
-                                  *addBasisVector1);
-      projection(k) = arma::dot(dataset.col(sampledIndices[i]),
-                                *addBasisVector2);
-    }
-
-    // Calculate the Frobenius norm squared of the projected vector.
-    double frobProjection = arma::norm(projection, "frob");
-    double frobProjectionSquared = frobProjection * frobProjection;
-
-    // Calculate the weighted projection magnitude.
-    weightedMagnitudes(i) = frobProjectionSquared / probabilities(i);
+    weightedMagnitudes.zeros(numSamples);
   }
 
   // Compute mean and standard deviation of the weighted samples.
@@ -488,20 +517,21 @@ double CosineTree::MonteCarloError(CosineTree* node,
 
 void CosineTree::ConstructBasis(CosineNodeQueue& treeQueue)
 {
-  // Initialize basis as matrix of zeros.
-  basis.zeros(dataset->n_rows, treeQueue.size());
+  QueueBasis(treeQueue, basis);
+}
 
-  // Variables for iterating through the priority queue.
-  CosineTree *currentNode;
-  CosineNodeQueue::const_iterator i = treeQueue.begin();
+void CosineTree::QueueBasis(const CosineNodeQueue& treeQueue,
+                            arma::mat& queueBasis,
+                            const size_t extraColumns) const
+{
+  // Initialize basis as matrix of zeros.
+  queueBasis.zeros(dataset->n_rows, treeQueue.size() + extraColumns);
 
   // Transfer basis vectors from the queue to the basis matrix.
   size_t j = 0;
+  CosineNodeQueue::const_iterator i = treeQueue.begin();
   for ( ; i != treeQueue.end(); ++i, ++j)
-  {
-    currentNode = *i;
-    basis.col(j) = currentNode->BasisVector();
-  }
+    queueBasis.col(j) = (*i)->BasisVector();
 }
 
 void CosineTree::CosineNodeSplit()
@@ -563,7 +593,7 @@ void CosineTree::ColumnSamplesLS(std::vector<size_t>& sampledIndices,
   for (size_t i = 0; i < numSamples; ++i)
   {
     // Generate a random value for sampling.
-    double randValue = arma::randu();
+    double randValue = math::Random();
     size_t start = 0, end = numColumns, searchIndex;
 
     // Sample from the distribution and store corresponding probability.
@@ -593,7 +623,7 @@ size_t CosineTree::ColumnSampleLS()
   }
 
   // Generate a random value for sampling.
-  double randValue = arma::randu();
+  double randValue = math::Random();
   size_t start = 0, end = numColumns;
 
   // Sample from the distribution.
@@ -633,7 +663,8 @@ void CosineTree::CalculateCosines(arma::vec& cosines)
   // Initialize cosine vector as a vector of zeros.
   cosines.zeros(numColumns);
 
-  for (size_t i = 0; i < numColumns; ++i)
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numColumns; ++i)
   {
     // If norm is zero, store cosine value as zero. Else, calculate cosine value
     // between two vectors.
@@ -60,13 +60,21 @@ class CosineTree
    * input matrix's projection on the obtained subspace is less than a fraction
    * of the norm of the input matrix.
    *
+   * Up to 'expansionsPerRound' nodes are split in each round; the splits and
+   * the Monte Carlo error estimates of their children are computed in parallel
+   * when OpenMP is available.  Expanding more nodes per round gives more
+   * parallelism and fewer estimates of the root error, at the cost of a
+   * possibly larger basis than needed.
+   *
    * @param dataset Matrix for which the CosineTree is constructed.
    * @param epsilon Error tolerance fraction for calculated subspace.
    * @param delta Cumulative probability for Monte Carlo error lower bound.
+   * @param expansionsPerRound Maximum number of nodes to split in each round.
    */
   CosineTree(const arma::mat& dataset,
              const double epsilon,
-             const double delta);
+             const double delta,
+             const size_t expansionsPerRound = 1);
 
   /**
    * Copy the given tree.  Be careful!  This may use a lot of memory.
@@ -116,6 +124,18 @@ class CosineTree
                            arma::vec& newBasisVector,
                            arma::vec* addBasisVector = NULL);
 
+  /**
+   * Calculates the orthonormalization of the passed centroid, with respect to
+   * the subspace spanned by the columns of the given basis.
+   *
+   * @param subspaceBasis Orthonormal basis of the current subspace.
+   * @param centroid Centroid of the node being added to the basis.
+   * @param newBasisVector Orthonormalized centroid of the node.
+   */
+  void ModifiedGramSchmidt(const arma::mat& subspaceBasis,
+                           const arma::vec& centroid,
+                           arma::vec& newBasisVector);
+
   /**
    * Estimates the squared error of the projection of the input node's matrix
    * onto the current vector subspace. A normal distribution is fit using
@@ -133,6 +153,16 @@ class CosineTree
                          arma::vec* addBasisVector1 = NULL,
                          arma::vec* addBasisVector2 = NULL);
 
+  /**
+   * Estimates the squared error of the projection of the input node's matrix
+   * onto the subspace spanned by the columns of the given basis.  The
+   * projections of all the samples are computed with one matrix product.
+   *
+   * @param node Node for which Monte Carlo estimate is calculated.
+   * @param subspaceBasis Orthonormal basis of the current subspace.
+   */
+  double MonteCarloError(CosineTree* node, const arma::mat& subspaceBasis);
+
   /**
    * Constructs the final basis matrix, after the cosine tree construction.
    *
@@ -140,6 +170,19 @@ class CosineTree
    */
   void ConstructBasis(CosineNodeQueue& treeQueue);
 
+  /**
+   * Collect the basis vectors of the nodes in the priority queue into the
+   * columns of a matrix, leaving the given number of extra (zero) columns at
+   * the end.
+   *
+   * @param treeQueue Priority queue of cosine nodes.
+   * @param queueBasis Matrix to store the basis vectors in.
+   * @param extraColumns Number of extra columns to allocate.
+   */
+  void QueueBasis(const CosineNodeQueue& treeQueue,
+                  arma::mat& queueBasis,
+                  const size_t extraColumns = 0) const;
+
   /**
    * This function splits the cosine node into two children based on the cosines
    * of the columns contained in the node, with respect to the sampled splitting
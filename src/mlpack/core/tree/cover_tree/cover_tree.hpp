@@ -15,6 +15,8 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/math/range.hpp>
 
+#include <deque>
+
 #include "../statistic.hpp"
 #include "first_point_is_root.hpp"
 
@@ -549,6 +551,45 @@ class CoverTree
    */
   void RemoveNewImplicitNodes();
 
+  /**
+   * The memory used while building a tree, kept for the whole construction
+   * instead of being allocated for each node.  Each recursion level of
+   * CreateChildren() has its own near and far set, which is reused by all the
+   * children it creates, and SortPointSet() shares a scratch buffer.
+   */
+  struct BuildBuffers
+  {
+    BuildBuffers() : depth(0) { }
+
+    //! The near and far set of one recursion level.
+    struct Level
+    {
+      arma::Col<size_t> indices;
+      arma::vec distances;
+    };
+
+    //! The sets of each recursion level; a deque, so that the sets of the
+    //! outer levels do not move when a level is added.
+    std::deque<Level> levels;
+    //! The scratch indices of SortPointSet().
+    std::vector<size_t> indices;
+    //! The scratch distances of SortPointSet().
+    std::vector<double> distances;
+    //! The current recursion level of CreateChildren().
+    size_t depth;
+  };
+
+  //! Get the build buffers of the calling thread.
+  static BuildBuffers& Buffers()
+  {
+    static thread_local BuildBuffers buffers;
+    return buffers;
+  }
+
+  //! The number of points from which the distances of ComputeDistances() are
+  //! computed in parallel.
+  static constexpr size_t ParallelDistanceThreshold = 4096;
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
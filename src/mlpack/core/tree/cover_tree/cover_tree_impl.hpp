@@ -1140,6 +1140,20 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CreateChildren(
     size_t& farSetSize,
     size_t& usedSetSize)
 {
+  // Enter a recursion level of the build buffers, and release them once the
+  // root is built.
+  BuildBuffers& buffers = Buffers();
+  const size_t depth = buffers.depth++;
+  struct LevelGuard
+  {
+    BuildBuffers& buffers;
+    ~LevelGuard()
+    {
+      if (--buffers.depth == 0)
+        buffers = BuildBuffers();
+    }
+  } levelGuard{ buffers };
+
   // Determine the next scale level.  This should be the first level where there
   // are any points in the far set.  So, if we know the maximum distance in the
   // distances array, this will be the largest i such that
@@ -1268,12 +1282,20 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CreateChildren(
       break;
     }
 
-    // Create the near and far set indices and distance vectors.  We don't fill
-    // in the self-point, yet.
-    arma::Col<size_t> childIndices(nearSetSize + farSetSize);
+    // Create the near and far set indices and distance vectors, reusing the
+    // ones of this recursion level; they may be larger than needed.  We don't
+    // fill in the self-point, yet.
+    if (buffers.levels.size() <= depth)
+      buffers.levels.resize(depth + 1);
+    arma::Col<size_t>& childIndices = buffers.levels[depth].indices;
+    arma::vec& childDistances = buffers.levels[depth].distances;
+    if (childIndices.n_elem < nearSetSize + farSetSize)
+    {
+      childIndices.set_size(nearSetSize + farSetSize);
+      childDistances.set_size(nearSetSize + farSetSize);
+    }
     childIndices.rows(0, (nearSetSize + farSetSize - 2)) = indices.rows(1,
         nearSetSize + farSetSize - 1);
-    arma::vec childDistances(nearSetSize + farSetSize);
 
     // Build distances for the child.
     ComputeDistances(indices[0], childIndices, childDistances, nearSetSize
@@ -1393,8 +1415,11 @@ void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
 {
   // For each point, rebuild the distances.  The indices do not need to be
   // modified.
+  // The upper levels of the tree compute the distances to most of the
+  // dataset, so these are computed in parallel.
   distanceComps += pointSetSize;
-  for (size_t i = 0; i < pointSetSize; ++i)
+  #pragma omp parallel for if (pointSetSize >= ParallelDistanceThreshold)
+  for (omp_size_t i = 0; i < (omp_size_t) pointSetSize; ++i)
   {
     distances[i] = metric->Evaluate(dataset->col(pointIndex),
         dataset->col(indices[i]));
@@ -1425,8 +1450,14 @@ size_t CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
   if (bufferSize == 0)
     return (childFarSetSize + farSetSize);
 
-  size_t* indicesBuffer = new size_t[bufferSize];
-  ElemType* distancesBuffer = new ElemType[bufferSize];
+  BuildBuffers& buffers = Buffers();
+  if (buffers.indices.size() < bufferSize)
+  {
+    buffers.indices.resize(bufferSize);
+    buffers.distances.resize(bufferSize);
+  }
+  size_t* indicesBuffer = buffers.indices.data();
+  double* distancesBuffer = buffers.distances.data();
 
   // The start of the memory region to copy to the buffer.
   const size_t bufferFromLocation = ((bufferSize == farSetSize) ?
@@ -1445,22 +1476,19 @@ size_t CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
   memcpy(indicesBuffer, indices.memptr() + bufferFromLocation,
       sizeof(size_t) * bufferSize);
   memcpy(distancesBuffer, distances.memptr() + bufferFromLocation,
-      sizeof(ElemType) * bufferSize);
+      sizeof(double) * bufferSize);
 
   // Now move the other memory.
   memmove(indices.memptr() + directToLocation,
       indices.memptr() + directFromLocation, sizeof(size_t) * bigCopySize);
   memmove(distances.memptr() + directToLocation,
-      distances.memptr() + directFromLocation, sizeof(ElemType) * bigCopySize);
+      distances.memptr() + directFromLocation, sizeof(double) * bigCopySize);
 
   // Now copy the temporary memory to the right place.
   memcpy(indices.memptr() + bufferToLocation, indicesBuffer,
       sizeof(size_t) * bufferSize);
   memcpy(distances.memptr() + bufferToLocation, distancesBuffer,
-      sizeof(ElemType) * bufferSize);
-
-  delete[] indicesBuffer;
-  delete[] distancesBuffer;
+      sizeof(double) * bufferSize);
 
   // This returns the complete size of the far set.
   return (childFarSetSize + farSetSize);
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_TREE_COVER_TREE_DUAL_TREE_TRAVERSER_IMPL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/traversal_statistics.hpp>
 #include <queue>
 
 namespace mlpack {
@@ -42,6 +43,8 @@ void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
 DualTreeTraverser<RuleType>::Traverse(CoverTree& queryNode,
                                       CoverTree& referenceNode)
 {
+  MLPACK_TRAVERSAL_LEVEL(rule, numPrunes);
+
   // Start by creating a map and adding the reference root node to it.
   std::map<int, std::vector<DualCoverTreeMapEntry> > refMap;
 
@@ -72,6 +75,8 @@ DualTreeTraverser<RuleType>::Traverse(
     CoverTree& queryNode,
     std::map<int, std::vector<DualCoverTreeMapEntry> >& referenceMap)
 {
+  MLPACK_TRAVERSAL_LEVEL(rule, numPrunes);
+
   if (referenceMap.size() == 0)
     return; // Nothing to do!
 
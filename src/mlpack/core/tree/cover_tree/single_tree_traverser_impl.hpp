@@ -15,6 +15,7 @@
 
 // In case it hasn't been included yet.
 #include "single_tree_traverser.hpp"
+#include <mlpack/core/tree/traversal_statistics.hpp>
 
 #include <queue>
 
@@ -71,6 +72,8 @@ SingleTreeTraverser<RuleType>::Traverse(
     const size_t queryIndex,
     CoverTree& referenceNode)
 {
+  MLPACK_TRAVERSAL_LEVEL(rule, numPrunes);
+
   // This is a non-recursive implementation (which should be faster than a
   // recursive implementation).
   typedef CoverTreeMapEntry<MetricType, StatisticType, MatType, RootPointPolicy>
@@ -0,0 +1,183 @@
+/**
+ * @file core/tree/frontier_dual_tree_traverser.hpp
+ *
+ * Defines the FrontierDualTreeTraverser, a breadth-first dual-tree traverser
+ * that works with any tree type and processes each level of the query tree on
+ * several threads.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_FRONTIER_DUAL_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_FRONTIER_DUAL_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <queue>
+
+#include "tree_traits.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A pending combination of a query node and a reference node, along with the
+ * score of its parent combination and the traversal information to restore
+ * before it is scored.
+ */
+template<typename TreeType, typename TraversalInfoType>
+struct QueueFrame
+{
+  TreeType* queryNode;
+  TreeType* referenceNode;
+  size_t queryDepth;
+  double score;
+  TraversalInfoType traversalInfo;
+};
+
+/**
+ * The FrontierDualTreeTraverser traverses two trees breadth-first in the query
+ * tree.  All the reference nodes that must be compared with a query node are
+ * handled before any of its children, and the query nodes of each level of the
+ * query tree (the frontier) are handled one after another.  This works with any
+ * tree type whose points are held in its leaves; the BinarySpaceTree, Octree
+ * and RectangleTree classes use it as their BreadthFirstDualTreeTraverser.
+ *
+ * The query nodes of a frontier are disjoint, so if the rules declare
+ * RuleTraits<RuleType>::HasThreadSafeScoring and mlpack is compiled with
+ * OpenMP, the frontier is split between threads, each of which uses its own
+ * copy of the rules.  Otherwise the traversal runs on a single thread.
+ *
+ * @tparam TreeType Type of the query and reference trees.
+ * @tparam RuleType Type of the rules that guide the traversal.
+ */
+template<typename TreeType, typename RuleType>
+class FrontierDualTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the dual-tree traverser with the given rule set.
+   */
+  FrontierDualTreeTraverser(RuleType& rule);
+
+  typedef QueueFrame<TreeType, typename RuleType::TraversalInfoType>
+      QueueFrameType;
+
+  /**
+   * Traverse the two trees.  This does not reset the number of prunes.
+   *
+   * @param queryNode The query node to be traversed.
+   * @param referenceNode The reference node to be traversed.
+   */
+  void Traverse(TreeType& queryNode, TreeType& referenceNode);
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+  //! Modify the number of prunes.
+  size_t& NumPrunes() { return numPrunes; }
+
+  //! Get the number of visited combinations.
+  size_t NumVisited() const { return numVisited; }
+  //! Modify the number of visited combinations.
+  size_t& NumVisited() { return numVisited; }
+
+  //! Get the number of times a node combination was scored.
+  size_t NumScores() const { return numScores; }
+  //! Modify the number of times a node combination was scored.
+  size_t& NumScores() { return numScores; }
+
+  //! Get the number of times a base case was calculated.
+  size_t NumBaseCases() const { return numBaseCases; }
+  //! Modify the number of times a base case was calculated.
+  size_t& NumBaseCases() { return numBaseCases; }
+
+ private:
+  //! The reference nodes still to be compared with a query node.
+  typedef std::priority_queue<QueueFrameType> QueueType;
+
+  //! Reference to the rules with which the trees will be traversed.
+  RuleType& rule;
+
+  //! The number of prunes.
+  size_t numPrunes;
+
+  //! The number of node combinations that have been visited during traversal.
+  size_t numVisited;
+
+  //! The number of times a node combination was scored.
+  size_t numScores;
+
+  //! The number of times a base case was calculated.
+  size_t numBaseCases;
+
+  //! The copies of the rules used by the threads other than the first during
+  //! a parallel traversal.
+  std::vector<RuleType> threadRules;
+
+  /**
+   * Handle each query node of the given frontier on several threads, if the
+   * rules allow it and the frontier is large enough.  Returns false if the
+   * frontier was not handled.
+   *
+   * @param frontier Query nodes of the frontier.
+   * @param queues Reference nodes to compare each query node with.
+   * @param childQueues Queues of the children of each query node.
+   * @param prunes Number of prunes; incremented.
+   * @param visited Number of visited combinations; incremented.
+   * @param scores Number of scores; incremented.
+   * @param baseCases Number of base cases; incremented.
+   */
+  bool TraverseFrontier(const std::vector<TreeType*>& frontier,
+                        std::vector<QueueType>& queues,
+                        std::vector<std::vector<QueueType>>& childQueues,
+                        size_t& prunes,
+                        size_t& visited,
+                        size_t& scores,
+                        size_t& baseCases,
+                        const std::true_type& threadSafe);
+
+  //! Rules without thread-safe scoring are never traversed in parallel.
+  bool TraverseFrontier(const std::vector<TreeType*>& /* frontier */,
+                        std::vector<QueueType>& /* queues */,
+                        std::vector<std::vector<QueueType>>& /* childQueues */,
+                        size_t& /* prunes */,
+                        size_t& /* visited */,
+                        size_t& /* scores */,
+                        size_t& /* baseCases */,
+                        const std::false_type& /* threadSafe */)
+  {
+    return false;
+  }
+
+  /**
+   * Compare the given query node with each reference node in its queue,
+   * pushing the combinations to be handled at the next level onto the queues
+   * of its children (which are in the same order as its children).
+   *
+   * @param threadRule Rules to use (the rules of the calling thread).
+   * @param queryNode Query node to handle.
+   * @param referenceQueue Reference nodes to compare the query node with.
+   * @param childQueues Queues of the children of the query node.
+   * @param prunes Number of prunes; incremented.
+   * @param visited Number of visited combinations; incremented.
+   * @param scores Number of scores; incremented.
+   * @param baseCases Number of base cases; incremented.
+   */
+  static void Traverse(RuleType& threadRule,
+                       TreeType& queryNode,
+                       QueueType& referenceQueue,
+                       std::vector<QueueType>& childQueues,
+                       size_t& prunes,
+                       size_t& visited,
+                       size_t& scores,
+                       size_t& baseCases);
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "frontier_dual_tree_traverser_impl.hpp"
+
+#endif // MLPACK_CORE_TREE_FRONTIER_DUAL_TREE_TRAVERSER_HPP
@@ -0,0 +1,263 @@
+/**
+ * @file core/tree/frontier_dual_tree_traverser_impl.hpp
+ *
+ * Implementation of the FrontierDualTreeTraverser.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_FRONTIER_DUAL_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_FRONTIER_DUAL_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "frontier_dual_tree_traverser.hpp"
+#include <mlpack/core/tree/traversal_statistics.hpp>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+namespace tree {
+
+template<typename TreeType, typename RuleType>
+FrontierDualTreeTraverser<TreeType, RuleType>::FrontierDualTreeTraverser(
+    RuleType& rule) :
+    rule(rule),
+    numPrunes(0),
+    numVisited(0),
+    numScores(0),
+    numBaseCases(0)
+{ /* Nothing to do. */ }
+
+template<typename TreeType, typename TraversalInfoType>
+bool operator<(const QueueFrame<TreeType, TraversalInfoType>& a,
+               const QueueFrame<TreeType, TraversalInfoType>& b)
+{
+  if (a.queryDepth > b.queryDepth)
+    return true;
+  else if ((a.queryDepth == b.queryDepth) && (a.score > b.score))
+    return true;
+  return false;
+}
+
+template<typename TreeType, typename RuleType>
+void FrontierDualTreeTraverser<TreeType, RuleType>::Traverse(
+    TreeType& queryRoot,
+    TreeType& referenceRoot)
+{
+  // Must score the root combination.
+  const double rootScore = rule.Score(queryRoot, referenceRoot);
+  ++numScores;
+  if (rootScore == DBL_MAX)
+  {
+    ++numPrunes;
+    return; // This probably means something is wrong.
+  }
+
+  QueueFrameType rootFrame;
+  rootFrame.queryNode = &queryRoot;
+  rootFrame.referenceNode = &referenceRoot;
+  rootFrame.queryDepth = 0;
+  rootFrame.score = 0.0;
+  rootFrame.traversalInfo = rule.TraversalInfo();
+
+  // The frontier holds the query nodes of one level of the query tree that
+  // still have reference nodes to be compared with, and their queues.
+  std::vector<TreeType*> frontier(1, &queryRoot);
+  std::vector<QueueType> queues(1);
+  queues[0].push(rootFrame);
+
+  size_t prunes = 0, visited = 0, scores = 0, baseCases = 0;
+  while (!frontier.empty())
+  {
+    // The queues of the children of each frontier node, in order.
+    std::vector<std::vector<QueueType>> childQueues(frontier.size());
+
+    const bool parallel = TraverseFrontier(frontier, queues, childQueues,
+        prunes, visited, scores, baseCases,
+        std::integral_constant<bool,
+            RuleTraits<RuleType>::HasThreadSafeScoring>());
+    if (!parallel)
+    {
+      for (size_t i = 0; i < frontier.size(); ++i)
+      {
+        Traverse(rule, *frontier[i], queues[i], childQueues[i], prunes,
+            visited, scores, baseCases);
+      }
+    }
+
+    // Collect the children that have something to be compared with; they form
+    // the next frontier.
+    std::vector<TreeType*> nextFrontier;
+    std::vector<QueueType> nextQueues;
+    for (size_t i = 0; i < frontier.size(); ++i)
+    {
+      for (size_t j = 0; j < childQueues[i].size(); ++j)
+      {
+        if (childQueues[i][j].empty())
+          continue;
+
+        nextFrontier.push_back(&frontier[i]->Child(j));
+        nextQueues.push_back(std::move(childQueues[i][j]));
+      }
+    }
+
+    frontier.swap(nextFrontier);
+    queues.swap(nextQueues);
+  }
+
+  // The copies of the rules are not needed anymore.
+  threadRules.clear();
+
+  numPrunes += prunes;
+  numVisited += visited;
+  numScores += scores;
+  numBaseCases += baseCases;
+}
+
+template<typename TreeType, typename RuleType>
+bool FrontierDualTreeTraverser<TreeType, RuleType>::TraverseFrontier(
+    const std::vector<TreeType*>& frontier,
+    std::vector<QueueType>& queues,
+    std::vector<std::vector<QueueType>>& childQueues,
+    size_t& prunes,
+    size_t& visited,
+    size_t& scores,
+    size_t& baseCases,
+    const std::true_type& /* threadSafe */)
+{
+  #ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  if (numThreads == 1 || frontier.size() == 1 || omp_in_parallel())
+    return false;
+
+  // The copies of the rules used by the other threads are only made once a
+  // frontier is large enough to be split.
+  if (threadRules.empty())
+    threadRules.resize(numThreads - 1, rule);
+
+  // Each query node and its whole subtree are only touched by the thread that
+  // handles it.
+  size_t threadPrunes = 0, threadVisited = 0, threadScores = 0,
+      threadBaseCases = 0;
+  #pragma omp parallel for schedule(dynamic) num_threads(numThreads) \
+      reduction(+: threadPrunes, threadVisited, threadScores, threadBaseCases)
+  for (omp_size_t i = 0; i < (omp_size_t) frontier.size(); ++i)
+  {
+    const size_t thread = omp_get_thread_num();
+    RuleType& threadRule = (thread == 0) ? rule : threadRules[thread - 1];
+    Traverse(threadRule, *frontier[i], queues[i], childQueues[i],
+        threadPrunes, threadVisited, threadScores, threadBaseCases);
+  }
+
+  prunes += threadPrunes;
+  visited += threadVisited;
+  scores += threadScores;
+  baseCases += threadBaseCases;
+  return true;
+  #else
+  (void) frontier;
+  (void) queues;
+  (void) childQueues;
+  (void) prunes;
+  (void) visited;
+  (void) scores;
+  (void) baseCases;
+  return false;
+  #endif
+}
+
+template<typename TreeType, typename RuleType>
+void FrontierDualTreeTraverser<TreeType, RuleType>::Traverse(
+    RuleType& threadRule,
+    TreeType& queryNode,
+    QueueType& referenceQueue,
+    std::vector<QueueType>& childQueues,
+    size_t& prunes,
+    size_t& visited,
+    size_t& scores,
+    size_t& baseCases)
+{
+  MLPACK_TRAVERSAL_LEVEL(threadRule, prunes);
+
+  childQueues.resize(queryNode.NumChildren());
+
+  while (!referenceQueue.empty())
+  {
+    QueueFrameType currentFrame = referenceQueue.top();
+    referenceQueue.pop();
+
+    TreeType& referenceNode = *currentFrame.referenceNode;
+    typename RuleType::TraversalInfoType ti = currentFrame.traversalInfo;
+    threadRule.TraversalInfo() = ti;
+    const size_t queryDepth = currentFrame.queryDepth;
+
+    ++visited;
+    const double score = threadRule.Score(queryNode, referenceNode);
+    ++scores;
+
+    if (score == DBL_MAX)
+    {
+      ++prunes;
+      continue;
+    }
+
+    if (queryNode.IsLeaf() && referenceNode.IsLeaf())
+    {
+      // If both are leaves, we must evaluate the base case for each pair of
+      // points.
+      for (size_t query = 0; query < queryNode.NumPoints(); ++query)
+      {
+        for (size_t ref = 0; ref < referenceNode.NumPoints(); ++ref)
+          threadRule.BaseCase(queryNode.Point(query), referenceNode.Point(ref));
+
+        baseCases += referenceNode.NumPoints();
+      }
+    }
+    else if (queryNode.IsLeaf())
+    {
+      // We have to recurse down the reference node.  In this case the
+      // recursion order does matter, so the children go back into the queue.
+      for (size_t i = 0; i < referenceNode.NumChildren(); ++i)
+      {
+        QueueFrameType frame = { &queryNode, &referenceNode.Child(i),
+            queryDepth, score, threadRule.TraversalInfo() };
+        referenceQueue.push(frame);
+      }
+    }
+    else if (referenceNode.IsLeaf())
+    {
+      // We have to recurse down the query node; this is done at the next
+      // level.
+      for (size_t i = 0; i < queryNode.NumChildren(); ++i)
+      {
+        QueueFrameType frame = { &queryNode.Child(i), &referenceNode,
+            queryDepth + 1, score, threadRule.TraversalInfo() };
+        childQueues[i].push(frame);
+      }
+    }
+    else
+    {
+      // We have to recurse down both query and reference nodes.  Each child of
+      // the query node is compared with each child of the reference node at
+      // the next level.
+      for (size_t i = 0; i < queryNode.NumChildren(); ++i)
+      {
+        for (size_t j = 0; j < referenceNode.NumChildren(); ++j)
+        {
+          QueueFrameType frame = { &queryNode.Child(i), &referenceNode.Child(j),
+              queryDepth + 1, score, threadRule.TraversalInfo() };
+          childQueues[i].push(frame);
+        }
+      }
+    }
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif // MLPACK_CORE_TREE_FRONTIER_DUAL_TREE_TRAVERSER_IMPL_HPP
@@ -16,6 +16,7 @@
 
 // In case it hasn't been included yet.
 #include "greedy_single_tree_traverser.hpp"
+#include <mlpack/core/tree/traversal_statistics.hpp>
 
 namespace mlpack {
 namespace tree {
@@ -32,6 +33,8 @@ void GreedySingleTreeTraverser<TreeType, RuleType>::Traverse(
     const size_t queryIndex,
     TreeType& referenceNode)
 {
+  MLPACK_TRAVERSAL_LEVEL(rule, numPrunes);
+
   // Run the base case as necessary for all the points in the reference node.
   for (size_t i = 0; i < referenceNode.NumPoints(); ++i)
     rule.BaseCase(queryIndex, referenceNode.Point(i));
@@ -180,7 +180,9 @@ class HRectBound
       typename std::enable_if_t<IsVector<VecType>::value>* = 0) const;
 
   /**
-   * Expands this region to include new points.
+   * Expands this region to include new points.  If OpenMP is available and
+   * there are many points, they are scanned in parallel (unless this is called
+   * from a parallel region).
    *
    * @tparam MatType Type of matrix; could be Mat, SpMat, a subview, or just a
    *   vector.
@@ -244,6 +246,26 @@ class HRectBound
   ElemType minWidth;
   //! Instantiated metric (likely has size 0).
   MetricType metric;
+
+  //! The number of points from which operator|=() scans the points in
+  //! parallel.
+  static constexpr size_t ParallelThreshold = 65536;
+
+  // The sums over the dimensions behind MinDistance() and MaxDistance(), with
+  // the number of dimensions given at compile-time (or dim, if Dim is 0).
+
+  //! Sum the terms of the minimum bound-to-point distance.
+  template<size_t Dim, typename VecType>
+  ElemType MinPointSum(const VecType& point) const;
+  //! Sum the terms of the minimum bound-to-bound distance.
+  template<size_t Dim>
+  ElemType MinBoundSum(const HRectBound& other) const;
+  //! Sum the terms of the maximum bound-to-point distance.
+  template<size_t Dim, typename VecType>
+  ElemType MaxPointSum(const VecType& point) const;
+  //! Sum the terms of the maximum bound-to-bound distance.
+  template<size_t Dim>
+  ElemType MaxBoundSum(const HRectBound& other) const;
 };
 
 // A specialization of BoundTraits for this class.
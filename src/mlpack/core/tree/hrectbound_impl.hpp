@@ -17,6 +17,10 @@
 // In case it has not been included yet.
 #include "hrectbound.hpp"
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace bound {
 
@@ -182,20 +186,20 @@ inline ElemType HRectBound<MetricType, ElemType>::Volume() const
 }
 
 /**
- * Calculates minimum bound-to-point squared distance.
+ * Sums the per-dimension terms of the minimum bound-to-point distance, scaled
+ * by two.  If Dim is 0, the dimensionality of the bound is used.
  */
 template<typename MetricType, typename ElemType>
-template<typename VecType>
-inline ElemType HRectBound<MetricType, ElemType>::MinDistance(
-    const VecType& point,
-    typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
+template<size_t Dim, typename VecType>
+inline ElemType HRectBound<MetricType, ElemType>::MinPointSum(
+    const VecType& point) const
 {
-  Log::Assert(point.n_elem == dim);
+  const size_t n = (Dim == 0) ? dim : Dim;
 
   ElemType sum = 0;
 
   ElemType lower, higher;
-  for (size_t d = 0; d < dim; d++)
+  for (size_t d = 0; d < n; d++)
   {
     lower = bounds[d].Lo() - point[d];
     higher = point[d] - bounds[d].Hi();
@@ -217,44 +221,26 @@ inline ElemType HRectBound<MetricType, ElemType>::MinDistance(
     }
   }
 
-  // Now take the Power'th root (but make sure our result is squared if it needs
-  // to be); then cancel out the constant of 2 (which may have been squared now)
-  // that was introduced earlier.  The compiler should optimize out the if
-  // statement entirely.
-  if (MetricType::Power == 1)
-    return sum * 0.5;
-  else if (MetricType::Power == 2)
-  {
-    if (MetricType::TakeRoot)
-      return (ElemType) std::sqrt(sum) * 0.5;
-    else
-      return sum * 0.25;
-  }
-  else
-  {
-    if (MetricType::TakeRoot)
-      return (ElemType) pow((double) sum,
-          1.0 / (double) MetricType::Power) / 2.0;
-    else
-      return sum / pow(2.0, MetricType::Power);
-  }
+  return sum;
 }
 
 /**
- * Calculates minimum bound-to-bound squared distance.
+ * Sums the per-dimension terms of the minimum bound-to-bound distance, scaled
+ * by two.  If Dim is 0, the dimensionality of the bound is used.
  */
 template<typename MetricType, typename ElemType>
-ElemType HRectBound<MetricType, ElemType>::MinDistance(const HRectBound& other)
-    const
+template<size_t Dim>
+inline ElemType HRectBound<MetricType, ElemType>::MinBoundSum(
+    const HRectBound& other) const
 {
-  Log::Assert(dim == other.dim);
+  const size_t n = (Dim == 0) ? dim : Dim;
 
   ElemType sum = 0;
   const math::RangeType<ElemType>* mbound = bounds;
   const math::RangeType<ElemType>* obound = other.bounds;
 
   ElemType lower, higher;
-  for (size_t d = 0; d < dim; d++)
+  for (size_t d = 0; d < n; d++)
   {
     lower = obound->Lo() - mbound->Hi();
     higher = mbound->Lo() - obound->Hi();
@@ -281,6 +267,152 @@ ElemType HRectBound<MetricType, ElemType>::MinDistance(const HRectBound& other)
     obound++;
   }
 
+  return sum;
+}
+
+/**
+ * Sums the per-dimension terms of the maximum bound-to-point distance.  If Dim
+ * is 0, the dimensionality of the bound is used.
+ */
+template<typename MetricType, typename ElemType>
+template<size_t Dim, typename VecType>
+inline ElemType HRectBound<MetricType, ElemType>::MaxPointSum(
+    const VecType& point) const
+{
+  const size_t n = (Dim == 0) ? dim : Dim;
+
+  ElemType sum = 0;
+  for (size_t d = 0; d < n; d++)
+  {
+    ElemType v = std::max(fabs(point[d] - bounds[d].Lo()),
+        fabs(bounds[d].Hi() - point[d]));
+
+    // The compiler should optimize out this if statement entirely.
+    if (MetricType::Power == 1)
+      sum += v; // v is non-negative.
+    else if (MetricType::Power == 2)
+      sum += v * v;
+    else
+      sum += std::pow(v, (ElemType) MetricType::Power);
+  }
+
+  return sum;
+}
+
+/**
+ * Sums the per-dimension terms of the maximum bound-to-bound distance.  If Dim
+ * is 0, the dimensionality of the bound is used.
+ */
+template<typename MetricType, typename ElemType>
+template<size_t Dim>
+inline ElemType HRectBound<MetricType, ElemType>::MaxBoundSum(
+    const HRectBound& other) const
+{
+  const size_t n = (Dim == 0) ? dim : Dim;
+
+  ElemType sum = 0;
+
+  ElemType v;
+  for (size_t d = 0; d < n; d++)
+  {
+    v = std::max(fabs(other.bounds[d].Hi() - bounds[d].Lo()),
+        fabs(bounds[d].Hi() - other.bounds[d].Lo()));
+
+    // The compiler should optimize out this if statement entirely.
+    if (MetricType::Power == 1)
+      sum += v; // v is non-negative.
+    else if (MetricType::Power == 2)
+      sum += v * v;
+    else
+      sum += std::pow(v, (ElemType) MetricType::Power);
+  }
+
+  return sum;
+}
+
+/**
+ * Calculates minimum bound-to-point squared distance.
+ */
+template<typename MetricType, typename ElemType>
+template<typename VecType>
+inline ElemType HRectBound<MetricType, ElemType>::MinDistance(
+    const VecType& point,
+    typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
+{
+  Log::Assert(point.n_elem == dim);
+
+  // Low-dimensional bounds use a loop whose length is known at compile-time.
+  ElemType sum;
+  switch (dim)
+  {
+    case 1:
+      sum = MinPointSum<1>(point);
+      break;
+    case 2:
+      sum = MinPointSum<2>(point);
+      break;
+    case 3:
+      sum = MinPointSum<3>(point);
+      break;
+    case 4:
+      sum = MinPointSum<4>(point);
+      break;
+    default:
+      sum = MinPointSum<0>(point);
+  }
+
+  // Now take the Power'th root (but make sure our result is squared if it needs
+  // to be); then cancel out the constant of 2 (which may have been squared now)
+  // that was introduced earlier.  The compiler should optimize out the if
+  // statement entirely.
+  if (MetricType::Power == 1)
+    return sum * 0.5;
+  else if (MetricType::Power == 2)
+  {
+    if (MetricType::TakeRoot)
+      return (ElemType) std::sqrt(sum) * 0.5;
+    else
+      return sum * 0.25;
+  }
+  else
+  {
+    if (MetricType::TakeRoot)
+      return (ElemType) pow((double) sum,
+          1.0 / (double) MetricType::Power) / 2.0;
+    else
+      return sum / pow(2.0, MetricType::Power);
+  }
+}
+
+/**
+ * Calculates minimum bound-to-bound squared distance.
+ */
+template<typename MetricType, typename ElemType>
+ElemType HRectBound<MetricType, ElemType>::MinDistance(const HRectBound& other)
+    const
+{
+  Log::Assert(dim == other.dim);
+
+  // Low-dimensional bounds use a loop whose length is known at compile-time.
+  ElemType sum;
+  switch (dim)
+  {
+    case 1:
+      sum = MinBoundSum<1>(other);
+      break;
+    case 2:
+      sum = MinBoundSum<2>(other);
+      break;
+    case 3:
+      sum = MinBoundSum<3>(other);
+      break;
+    case 4:
+      sum = MinBoundSum<4>(other);
+      break;
+    default:
+      sum = MinBoundSum<0>(other);
+  }
+
   // The compiler should optimize out this if statement entirely.
   if (MetricType::Power == 1)
     return sum * 0.5;
@@ -310,22 +442,26 @@ inline ElemType HRectBound<MetricType, ElemType>::MaxDistance(
     const VecType& point,
     typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
 {
-  ElemType sum = 0;
-
   Log::Assert(point.n_elem == dim);
 
-  for (size_t d = 0; d < dim; d++)
+  // Low-dimensional bounds use a loop whose length is known at compile-time.
+  ElemType sum;
+  switch (dim)
   {
-    ElemType v = std::max(fabs(point[d] - bounds[d].Lo()),
-        fabs(bounds[d].Hi() - point[d]));
-
-    // The compiler should optimize out this if statement entirely.
-    if (MetricType::Power == 1)
-      sum += v; // v is non-negative.
-    else if (MetricType::Power == 2)
-      sum += v * v;
-    else
-      sum += std::pow(v, (ElemType) MetricType::Power);
+    case 1:
+      sum = MaxPointSum<1>(point);
+      break;
+    case 2:
+      sum = MaxPointSum<2>(point);
+      break;
+    case 3:
+      sum = MaxPointSum<3>(point);
+      break;
+    case 4:
+      sum = MaxPointSum<4>(point);
+      break;
+    default:
+      sum = MaxPointSum<0>(point);
   }
 
   // The compiler should optimize out this if statement entirely.
@@ -350,23 +486,26 @@ inline ElemType HRectBound<MetricType, ElemType>::MaxDistance(
     const HRectBound& other)
     const
 {
-  ElemType sum = 0;
-
   Log::Assert(dim == other.dim);
 
-  ElemType v;
-  for (size_t d = 0; d < dim; d++)
+  // Low-dimensional bounds use a loop whose length is known at compile-time.
+  ElemType sum;
+  switch (dim)
   {
-    v = std::max(fabs(other.bounds[d].Hi() - bounds[d].Lo()),
-        fabs(bounds[d].Hi() - other.bounds[d].Lo()));
-
-    // The compiler should optimize out this if statement entirely.
-    if (MetricType::Power == 1)
-      sum += v; // v is non-negative.
-    else if (MetricType::Power == 2)
-      sum += v * v;
-    else
-      sum += std::pow(v, (ElemType) MetricType::Power);
+    case 1:
+      sum = MaxBoundSum<1>(other);
+      break;
+    case 2:
+      sum = MaxBoundSum<2>(other);
+      break;
+    case 3:
+      sum = MaxBoundSum<3>(other);
+      break;
+    case 4:
+      sum = MaxBoundSum<4>(other);
+      break;
+    default:
+      sum = MaxBoundSum<0>(other);
   }
 
   // The compiler should optimize out this if statement entirely.
@@ -535,8 +674,35 @@ HRectBound<MetricType, ElemType>::operator|=(const MatType& data)
 {
   Log::Assert(data.n_rows == dim);
 
-  arma::Col<ElemType> mins(min(data, 1));
-  arma::Col<ElemType> maxs(max(data, 1));
+  arma::Col<ElemType> mins, maxs;
+  #ifdef HAS_OPENMP
+  if (data.n_cols >= ParallelThreshold && omp_get_max_threads() > 1 &&
+      !omp_in_parallel())
+  {
+    // Find the extrema of contiguous blocks of points in parallel, then the
+    // extrema of the blocks; the result is the same.
+    const size_t blocks = omp_get_max_threads();
+    arma::Mat<ElemType> blockMins(dim, blocks), blockMaxs(dim, blocks);
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t b = 0; b < (omp_size_t) blocks; ++b)
+    {
+      const size_t first = b * data.n_cols / blocks;
+      const size_t last = (b + 1) * data.n_cols / blocks - 1;
+      const arma::Col<ElemType> blockMin(min(data.cols(first, last), 1));
+      const arma::Col<ElemType> blockMax(max(data.cols(first, last), 1));
+      blockMins.col(b) = blockMin;
+      blockMaxs.col(b) = blockMax;
+    }
+
+    mins = min(blockMins, 1);
+    maxs = max(blockMaxs, 1);
+  }
+  else
+  #endif
+  {
+    mins = min(data, 1);
+    maxs = max(data, 1);
+  }
 
   minWidth = std::numeric_limits<ElemType>::max();
   for (size_t i = 0; i < dim; ++i)
@@ -0,0 +1,146 @@
+/**
+ * @file core/tree/node_arena.hpp
+ *
+ * Definition of NodeArena, which allocates the nodes of a tree in blocks and
+ * frees them all at once.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_NODE_ARENA_HPP
+#define MLPACK_CORE_TREE_NODE_ARENA_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mutex>
+
+namespace mlpack {
+namespace tree /** Trees and tree-building procedures. */ {
+
+/**
+ * A NodeArena holds the nodes of a tree in large blocks of memory, instead of
+ * allocating each node on its own.  Nodes are created with Allocate(), and are
+ * never freed individually: when the arena is destroyed, the destructor of
+ * every node is called, in the order in which the nodes were created, and the
+ * blocks are freed.  This makes building and (especially) destroying large
+ * trees much cheaper, and keeps nodes built one after the other close in
+ * memory.
+ *
+ * Because the arena destroys every node, the destructor of a node held in an
+ * arena must not destroy the other nodes (such as its children).
+ *
+ * Nodes may be allocated by several threads at once, and the constructor of a
+ * node may itself allocate nodes from the same arena (as the constructors of
+ * the trees do to build their children).
+ *
+ * A fixed arena has a single block; allocating more nodes than the size of the
+ * block throws an exception.  The nodes of a fixed arena are contiguous, in the
+ * order of allocation, as long as they are allocated by a single thread.
+ *
+ * @tparam NodeType Type of the nodes.
+ */
+template<typename NodeType>
+class NodeArena
+{
+ public:
+  /**
+   * Create an empty arena.
+   *
+   * @param blockSize Number of nodes held by each block.
+   * @param fixed If true, the arena holds a single block of blockSize nodes.
+   */
+  NodeArena(const size_t blockSize = 1024, const bool fixed = false) :
+      blockSize(blockSize),
+      fixed(fixed),
+      used(0)
+  {
+    if (blockSize == 0)
+    {
+      throw std::invalid_argument("NodeArena::NodeArena(): the block size must "
+          "be positive!");
+    }
+  }
+
+  //! An arena cannot be copied: the nodes point to each other.
+  NodeArena(const NodeArena& other) = delete;
+  //! An arena cannot be copied: the nodes point to each other.
+  NodeArena& operator=(const NodeArena& other) = delete;
+
+  /**
+   * Destroy every node of the arena, in the order in which they were created,
+   * and free the memory.
+   */
+  ~NodeArena()
+  {
+    for (size_t i = 0; i < nodes.size(); ++i)
+      nodes[i]->~NodeType();
+    for (size_t i = 0; i < blocks.size(); ++i)
+      ::operator delete(blocks[i]);
+  }
+
+  /**
+   * Create a node in the arena, passing the given arguments to its
+   * constructor.  The node is destroyed with the arena.
+   *
+   * @param args Arguments of the constructor of the node.
+   */
+  template<typename... Args>
+  NodeType* Allocate(Args&&... args)
+  {
+    // The constructor is called without holding the lock, since it may allocate
+    // other nodes.  If it throws, the slot is simply left unused.
+    NodeType* node = new (Reserve()) NodeType(std::forward<Args>(args)...);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    nodes.push_back(node);
+    return node;
+  }
+
+  //! Return the number of nodes held by the arena.
+  size_t Size() const { return nodes.size(); }
+
+  //! Return the number of nodes held by each block.
+  size_t BlockSize() const { return blockSize; }
+
+  //! Return whether the arena holds a single block.
+  bool Fixed() const { return fixed; }
+
+ private:
+  //! Return the memory for one more node.
+  void* Reserve()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (blocks.empty() || used == blockSize)
+    {
+      if (fixed && !blocks.empty())
+      {
+        throw std::length_error("NodeArena::Allocate(): the fixed arena is "
+            "full!");
+      }
+
+      blocks.push_back(::operator new(blockSize * sizeof(NodeType)));
+      used = 0;
+    }
+
+    return static_cast<char*>(blocks.back()) + (used++) * sizeof(NodeType);
+  }
+
+  //! The blocks of memory.
+  std::vector<void*> blocks;
+  //! The number of nodes held by each block.
+  size_t blockSize;
+  //! Whether the arena holds a single block.
+  bool fixed;
+  //! The number of slots taken in the last block.
+  size_t used;
+  //! Every node of the arena, in the order of creation.
+  std::vector<NodeType*> nodes;
+  //! The lock protecting the blocks and the list of nodes.
+  std::mutex mutex;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -18,5 +18,6 @@
 #include "octree/traits.hpp"
 #include "octree/single_tree_traverser.hpp"
 #include "octree/dual_tree_traverser.hpp"
+#include "octree/morton_octree.hpp"
 
 #endif
@@ -14,6 +14,7 @@
 
 // In case it hasn't been included yet.
 #include "dual_tree_traverser.hpp"
+#include <mlpack/core/tree/traversal_statistics.hpp>
 
 namespace mlpack {
 namespace tree {
@@ -36,6 +37,8 @@ template<typename RuleType>
 void Octree<MetricType, StatisticType, MatType>::DualTreeTraverser<RuleType>::
     Traverse(Octree& queryNode, Octree& referenceNode)
 {
+  MLPACK_TRAVERSAL_LEVEL(rule, numPrunes);
+
   // Increment the visit counter.
   ++numVisited;
 
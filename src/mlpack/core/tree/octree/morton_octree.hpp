@@ -0,0 +1,199 @@
+/**
+ * @file core/tree/octree/morton_octree.hpp
+ *
+ * Definition of MortonOctree, an octree specialized for batched radius queries
+ * on low-dimensional point clouds.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_OCTREE_MORTON_OCTREE_HPP
+#define MLPACK_CORE_TREE_OCTREE_MORTON_OCTREE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <array>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * MortonOctree is an octree (a 2^d-ary tree, for d = Dimensionality) built for
+ * fast batched radius queries on large, low-dimensional point clouds, such as
+ * 3-D LiDAR scans.  Unlike Octree, which works with the generic single-tree and
+ * dual-tree traversers, it is a self-contained structure:
+ *
+ *  - the dimensionality is a template parameter, so that all the loops over
+ *    coordinates (bound checks and distance computations) are unrolled by the
+ *    compiler;
+ *  - the points are stored in structure-of-arrays layout (one contiguous array
+ *    per coordinate), in single precision by default;
+ *  - the points are ordered along the Morton (Z-order) curve, with a parallel
+ *    radix sort of their Morton codes, so that each node is a contiguous range
+ *    of points and nearby points are nearby in memory;
+ *  - radius queries are answered in batches, in parallel, with the results in
+ *    compressed sparse row (CSR) form.
+ *
+ * @code
+ * arma::fmat cloud; // 3 x N point cloud.
+ * MortonOctree<> tree(cloud);
+ *
+ * // Find all the points within 0.5 of each query.
+ * arma::Col<size_t> offsets, neighbors;
+ * arma::fvec distances;
+ * tree.RadiusSearch(queries, 0.5, offsets, neighbors, distances);
+ *
+ * // The neighbors of query i are neighbors(offsets(i)) to
+ * // neighbors(offsets(i + 1) - 1).
+ * @endcode
+ *
+ * @tparam Dimensionality Dimensionality of the points.
+ * @tparam ElemType Type of the stored coordinates.
+ */
+template<size_t Dimensionality = 3, typename ElemType = float>
+class MortonOctree
+{
+ public:
+  //! A node of the tree: a contiguous range of points in Morton order, with
+  //! its bounding box.
+  struct Node
+  {
+    //! The index of the first point of the node.
+    size_t begin;
+    //! The number of points of the node.
+    size_t count;
+    //! The index of the first child (the children are contiguous).
+    size_t firstChild;
+    //! The number of children (0 for a leaf).
+    size_t numChildren;
+    //! The lower corner of the bounding box of the points of the node.
+    std::array<ElemType, Dimensionality> lo;
+    //! The upper corner of the bounding box of the points of the node.
+    std::array<ElemType, Dimensionality> hi;
+  };
+
+  /**
+   * Build the tree on the given points (one point per column).  The points are
+   * converted to ElemType and reordered, so the input is not modified.
+   *
+   * @param data Points to build the tree on; must have Dimensionality rows.
+   * @param maxLeafSize Maximum number of points in a leaf.
+   */
+  template<typename MatType>
+  MortonOctree(const MatType& data, const size_t maxLeafSize = 32);
+
+  /**
+   * Find, for each query point, all the points of the tree within the given
+   * radius, in compressed sparse row form: the neighbors of query i are
+   * neighbors(offsets(i)) to neighbors(offsets(i + 1) - 1), as indices into
+   * the original dataset.  The queries are processed in parallel, in Morton
+   * order, when OpenMP is available.
+   *
+   * @param queries Query points (one point per column).
+   * @param radius Search radius; points at distance radius are included.
+   * @param offsets Output offsets of the results of each query
+   *     (queries.n_cols + 1 elements).
+   * @param neighbors Output indices of the neighbors.
+   */
+  template<typename MatType>
+  void RadiusSearch(const MatType& queries,
+                    const double radius,
+                    arma::Col<size_t>& offsets,
+                    arma::Col<size_t>& neighbors) const;
+
+  /**
+   * Find, for each query point, all the points of the tree within the given
+   * radius, and their distances to the query, in compressed sparse row form.
+   *
+   * @param queries Query points (one point per column).
+   * @param radius Search radius; points at distance radius are included.
+   * @param offsets Output offsets of the results of each query
+   *     (queries.n_cols + 1 elements).
+   * @param neighbors Output indices of the neighbors.
+   * @param distances Output distances of the neighbors to their query.
+   */
+  template<typename MatType>
+  void RadiusSearch(const MatType& queries,
+                    const double radius,
+                    arma::Col<size_t>& offsets,
+                    arma::Col<size_t>& neighbors,
+                    arma::Col<ElemType>& distances) const;
+
+  //! Get the points, in Morton order, one coordinate per column.
+  const arma::Mat<ElemType>& Points() const { return points; }
+  //! Get the original index of each point of Points().
+  const arma::Col<size_t>& OldFromNew() const { return oldFromNew; }
+  //! Get the nodes of the tree; the root is node 0.
+  const std::vector<Node>& Nodes() const { return nodes; }
+  //! Get the maximum number of points in a leaf.
+  size_t MaxLeafSize() const { return maxLeafSize; }
+
+  //! The number of bits of each quantized coordinate in the Morton codes.
+  static constexpr size_t BitsPerDimension =
+      (64 / Dimensionality < 21) ? 64 / Dimensionality : 21;
+
+ private:
+  /**
+   * Interleave the bits of the given quantized coordinates into a Morton code.
+   */
+  static uint64_t MortonCode(
+      const std::array<uint64_t, Dimensionality>& quantized);
+
+  /**
+   * Sort the given codes with a parallel least significant digit radix sort,
+   * applying the same permutation to the given order.
+   */
+  static void RadixSort(std::vector<uint64_t>& codes,
+                        std::vector<size_t>& order);
+
+  //! Quantize a point to the grid of the Morton codes (clamping it to the
+  //! bounding box of the tree).
+  template<typename VecType>
+  std::array<uint64_t, Dimensionality> Quantize(const VecType& point) const;
+
+  //! Build the nodes from the sorted Morton codes.
+  void BuildNodes(const std::vector<uint64_t>& codes);
+
+  /**
+   * Search for the points within the given squared radius of one query,
+   * appending them (and their distances, if ComputeDistances is true) to the
+   * given buffers.
+   */
+  template<bool ComputeDistances>
+  void SearchOne(const std::array<ElemType, Dimensionality>& query,
+                 const ElemType radiusSquared,
+                 std::vector<size_t>& stack,
+                 std::vector<size_t>& results,
+                 std::vector<ElemType>& resultDistances) const;
+
+  //! Run a batch of radius queries.
+  template<bool ComputeDistances, typename MatType>
+  void Search(const MatType& queries,
+              const double radius,
+              arma::Col<size_t>& offsets,
+              arma::Col<size_t>& neighbors,
+              arma::Col<ElemType>& distances) const;
+
+  //! The points in Morton order; column d holds coordinate d.
+  arma::Mat<ElemType> points;
+  //! The original index of each point.
+  arma::Col<size_t> oldFromNew;
+  //! The nodes of the tree.
+  std::vector<Node> nodes;
+  //! The maximum number of points in a leaf.
+  size_t maxLeafSize;
+  //! The lower corner of the quantization grid.
+  std::array<double, Dimensionality> gridLo;
+  //! The number of grid cells per unit, in each dimension.
+  std::array<double, Dimensionality> gridScale;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "morton_octree_impl.hpp"
+
+#endif
@@ -0,0 +1,484 @@
+/**
+ * @file core/tree/octree/morton_octree_impl.hpp
+ *
+ * Implementation of MortonOctree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_OCTREE_MORTON_OCTREE_IMPL_HPP
+#define MLPACK_CORE_TREE_OCTREE_MORTON_OCTREE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "morton_octree.hpp"
+
+#include <algorithm>
+
+namespace mlpack {
+namespace tree {
+
+template<size_t Dimensionality, typename ElemType>
+template<typename MatType>
+MortonOctree<Dimensionality, ElemType>::MortonOctree(
+    const MatType& data,
+    const size_t maxLeafSize) :
+    maxLeafSize(maxLeafSize)
+{
+  static_assert(Dimensionality >= 1 && Dimensionality <= 16,
+      "MortonOctree: the dimensionality must be between 1 and 16!");
+
+  if (data.n_rows != Dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "MortonOctree::MortonOctree(): the data has " << data.n_rows
+        << " dimensions, but the tree is built for " << Dimensionality << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (maxLeafSize == 0)
+  {
+    throw std::invalid_argument("MortonOctree::MortonOctree(): the maximum "
+        "leaf size must be positive!");
+  }
+
+  const size_t n = data.n_cols;
+
+  // The quantization grid covers the bounding box of the data.
+  const double cells = double(uint64_t(1) << BitsPerDimension);
+  for (size_t d = 0; d < Dimensionality; ++d)
+  {
+    const double lo = (n == 0) ? 0.0 : double(data.row(d).min());
+    const double hi = (n == 0) ? 0.0 : double(data.row(d).max());
+    gridLo[d] = lo;
+    gridScale[d] = (hi > lo) ? cells / (hi - lo) : 0.0;
+  }
+
+  // Compute the Morton codes, and sort the points along the curve.
+  std::vector<uint64_t> codes(n);
+  std::vector<size_t> order(n);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) n; ++i)
+  {
+    codes[i] = MortonCode(Quantize(data.col(i)));
+    order[i] = i;
+  }
+
+  RadixSort(codes, order);
+
+  points.set_size(n, Dimensionality);
+  oldFromNew.set_size(n);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) n; ++i)
+  {
+    for (size_t d = 0; d < Dimensionality; ++d)
+      points(i, d) = ElemType(data(d, order[i]));
+    oldFromNew[i] = order[i];
+  }
+
+  BuildNodes(codes);
+}
+
+template<size_t Dimensionality, typename ElemType>
+template<typename MatType>
+void MortonOctree<Dimensionality, ElemType>::RadiusSearch(
+    const MatType& queries,
+    const double radius,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors) const
+{
+  arma::Col<ElemType> distances;
+  Search<false>(queries, radius, offsets, neighbors, distances);
+}
+
+template<size_t Dimensionality, typename ElemType>
+template<typename MatType>
+void MortonOctree<Dimensionality, ElemType>::RadiusSearch(
+    const MatType& queries,
+    const double radius,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::Col<ElemType>& distances) const
+{
+  Search<true>(queries, radius, offsets, neighbors, distances);
+}
+
+template<size_t Dimensionality, typename ElemType>
+uint64_t MortonOctree<Dimensionality, ElemType>::MortonCode(
+    const std::array<uint64_t, Dimensionality>& quantized)
+{
+  uint64_t code = 0;
+  for (size_t b = 0; b < BitsPerDimension; ++b)
+    for (size_t d = 0; d < Dimensionality; ++d)
+      code |= ((quantized[d] >> b) & 1) << (b * Dimensionality + d);
+
+  return code;
+}
+
+template<size_t Dimensionality, typename ElemType>
+void MortonOctree<Dimensionality, ElemType>::RadixSort(
+    std::vector<uint64_t>& codes,
+    std::vector<size_t>& order)
+{
+  const size_t n = codes.size();
+  const size_t passes = (Dimensionality * BitsPerDimension + 7) / 8;
+
+  std::vector<uint64_t> codesBuffer(n);
+  std::vector<size_t> orderBuffer(n);
+
+  #ifdef HAS_OPENMP
+  const size_t maxThreads = omp_get_max_threads();
+  #else
+  const size_t maxThreads = 1;
+  #endif
+  std::vector<size_t> histograms(256 * maxThreads);
+
+  // Each pass is a stable counting sort on one byte of the codes: every thread
+  // counts the digits of its own range of elements, and then scatters them to
+  // the positions given by the prefix sums (over digits, and then threads).
+  #pragma omp parallel
+  {
+    #ifdef HAS_OPENMP
+    const size_t thread = omp_get_thread_num();
+    const size_t numThreads = omp_get_num_threads();
+    #else
+    const size_t thread = 0;
+    const size_t numThreads = 1;
+    #endif
+
+    const size_t begin = n * thread / numThreads;
+    const size_t end = n * (thread + 1) / numThreads;
+    size_t* histogram = histograms.data() + 256 * thread;
+
+    uint64_t* sourceCodes = codes.data();
+    size_t* sourceOrder = order.data();
+    uint64_t* destCodes = codesBuffer.data();
+    size_t* destOrder = orderBuffer.data();
+
+    for (size_t pass = 0; pass < passes; ++pass)
+    {
+      const size_t shift = 8 * pass;
+      std::fill(histogram, histogram + 256, 0);
+      for (size_t i = begin; i < end; ++i)
+        ++histogram[(sourceCodes[i] >> shift) & 0xFF];
+
+      #pragma omp barrier
+      #pragma omp single
+      {
+        size_t sum = 0;
+        for (size_t digit = 0; digit < 256; ++digit)
+        {
+          for (size_t t = 0; t < numThreads; ++t)
+          {
+            const size_t count = histograms[256 * t + digit];
+            histograms[256 * t + digit] = sum;
+            sum += count;
+          }
+        }
+      }
+
+      for (size_t i = begin; i < end; ++i)
+      {
+        const size_t position = histogram[(sourceCodes[i] >> shift) & 0xFF]++;
+        destCodes[position] = sourceCodes[i];
+        destOrder[position] = sourceOrder[i];
+      }
+
+      #pragma omp barrier
+      std::swap(sourceCodes, destCodes);
+      std::swap(sourceOrder, destOrder);
+    }
+  }
+
+  if (passes % 2 == 1)
+  {
+    codes.swap(codesBuffer);
+    order.swap(orderBuffer);
+  }
+}
+
+template<size_t Dimensionality, typename ElemType>
+template<typename VecType>
+std::array<uint64_t, Dimensionality>
+MortonOctree<Dimensionality, ElemType>::Quantize(const VecType& point) const
+{
+  const double maxCell = double((uint64_t(1) << BitsPerDimension) - 1);
+
+  std::array<uint64_t, Dimensionality> quantized;
+  for (size_t d = 0; d < Dimensionality; ++d)
+  {
+    const double cell = (double(point[d]) - gridLo[d]) * gridScale[d];
+    quantized[d] = (uint64_t) std::min(std::max(cell, 0.0), maxCell);
+  }
+
+  return quantized;
+}
+
+template<size_t Dimensionality, typename ElemType>
+void MortonOctree<Dimensionality, ElemType>::BuildNodes(
+    const std::vector<uint64_t>& codes)
+{
+  const uint64_t mask = (uint64_t(1) << Dimensionality) - 1;
+
+  // The nodes are created in breadth-first order, so that the children of each
+  // node are contiguous and come after it.
+  nodes.clear();
+  nodes.push_back(Node());
+  nodes[0].begin = 0;
+  nodes[0].count = codes.size();
+  std::vector<size_t> levels(1, 0);
+
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    nodes[i].firstChild = nodes.size();
+    nodes[i].numChildren = 0;
+    if (nodes[i].count <= maxLeafSize || levels[i] == BitsPerDimension)
+      continue;
+
+    // The points of the node share the bits of the codes above this level, so
+    // they are sorted by the next group of Dimensionality bits.
+    const size_t shift = (BitsPerDimension - levels[i] - 1) * Dimensionality;
+    const size_t end = nodes[i].begin + nodes[i].count;
+    size_t childBegin = nodes[i].begin;
+    while (childBegin < end)
+    {
+      const uint64_t octant = (codes[childBegin] >> shift) & mask;
+      const size_t childEnd = std::partition_point(
+          codes.begin() + childBegin, codes.begin() + end,
+          [shift, mask, octant](const uint64_t code)
+          {
+            return ((code >> shift) & mask) <= octant;
+          }) - codes.begin();
+
+      Node child;
+      child.begin = childBegin;
+      child.count = childEnd - childBegin;
+      nodes.push_back(child);
+      levels.push_back(levels[i] + 1);
+      ++nodes[i].numChildren;
+
+      childBegin = childEnd;
+    }
+  }
+
+  // Compute the bounding boxes of the leaves in parallel, and then those of the
+  // internal nodes from their children, bottom-up.
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (omp_size_t i = 0; i < (omp_size_t) nodes.size(); ++i)
+  {
+    Node& node = nodes[i];
+    if (node.numChildren > 0)
+      continue;
+
+    node.lo.fill(std::numeric_limits<ElemType>::max());
+    node.hi.fill(std::numeric_limits<ElemType>::lowest());
+    for (size_t d = 0; d < Dimensionality; ++d)
+    {
+      const ElemType* column = points.colptr(d);
+      for (size_t p = node.begin; p < node.begin + node.count; ++p)
+      {
+        node.lo[d] = std::min(node.lo[d], column[p]);
+        node.hi[d] = std::max(node.hi[d], column[p]);
+      }
+    }
+  }
+
+  for (size_t i = nodes.size(); i > 0; --i)
+  {
+    Node& node = nodes[i - 1];
+    if (node.numChildren == 0)
+      continue;
+
+    node.lo = nodes[node.firstChild].lo;
+    node.hi = nodes[node.firstChild].hi;
+    for (size_t c = 1; c < node.numChildren; ++c)
+    {
+      const Node& child = nodes[node.firstChild + c];
+      for (size_t d = 0; d < Dimensionality; ++d)
+      {
+        node.lo[d] = std::min(node.lo[d], child.lo[d]);
+        node.hi[d] = std::max(node.hi[d], child.hi[d]);
+      }
+    }
+  }
+}
+
+template<size_t Dimensionality, typename ElemType>
+template<bool ComputeDistances>
+void MortonOctree<Dimensionality, ElemType>::SearchOne(
+    const std::array<ElemType, Dimensionality>& query,
+    const ElemType radiusSquared,
+    std::vector<size_t>& stack,
+    std::vector<size_t>& results,
+    std::vector<ElemType>& resultDistances) const
+{
+  std::array<const ElemType*, Dimensionality> columns;
+  for (size_t d = 0; d < Dimensionality; ++d)
+    columns[d] = points.colptr(d);
+
+  stack.clear();
+  stack.push_back(0);
+  while (!stack.empty())
+  {
+    const Node& node = nodes[stack.back()];
+    stack.pop_back();
+
+    ElemType minDistance = 0;
+    ElemType maxDistance = 0;
+    for (size_t d = 0; d < Dimensionality; ++d)
+    {
+      const ElemType below = node.lo[d] - query[d];
+      const ElemType above = query[d] - node.hi[d];
+      const ElemType gap = std::max(std::max(below, above), ElemType(0));
+      minDistance += gap * gap;
+
+      const ElemType far = std::max(-below, -above);
+      maxDistance += far * far;
+    }
+
+    if (minDistance > radiusSquared)
+      continue;
+
+    // If the whole node is within the radius, there is nothing to check.
+    if (!ComputeDistances && maxDistance <= radiusSquared)
+    {
+      results.insert(results.end(), oldFromNew.begin() + node.begin,
+          oldFromNew.begin() + node.begin + node.count);
+      continue;
+    }
+
+    if (node.numChildren > 0)
+    {
+      for (size_t c = 0; c < node.numChildren; ++c)
+        stack.push_back(node.firstChild + c);
+      continue;
+    }
+
+    for (size_t p = node.begin; p < node.begin + node.count; ++p)
+    {
+      ElemType distance = 0;
+      for (size_t d = 0; d < Dimensionality; ++d)
+      {
+        const ElemType diff = columns[d][p] - query[d];
+        distance += diff * diff;
+      }
+
+      if (distance <= radiusSquared)
+      {
+        results.push_back(oldFromNew[p]);
+        if (ComputeDistances)
+          resultDistances.push_back(std::sqrt(distance));
+      }
+    }
+  }
+}
+
+template<size_t Dimensionality, typename ElemType>
+template<bool ComputeDistances, typename MatType>
+void MortonOctree<Dimensionality, ElemType>::Search(
+    const MatType& queries,
+    const double radius,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::Col<ElemType>& distances) const
+{
+  if (queries.n_rows != Dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "MortonOctree::RadiusSearch(): the queries have " << queries.n_rows
+        << " dimensions, but the tree is built for " << Dimensionality << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (radius < 0.0)
+  {
+    throw std::invalid_argument("MortonOctree::RadiusSearch(): the radius "
+        "must be nonnegative!");
+  }
+
+  const size_t numQueries = queries.n_cols;
+  const ElemType radiusSquared = ElemType(radius * radius);
+
+  // Process the queries in Morton order, so that consecutive queries of a
+  // thread visit the same nodes.
+  std::vector<uint64_t> queryCodes(numQueries);
+  std::vector<size_t> queryOrder(numQueries);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numQueries; ++i)
+  {
+    queryCodes[i] = MortonCode(Quantize(queries.col(i)));
+    queryOrder[i] = i;
+  }
+
+  RadixSort(queryCodes, queryOrder);
+
+  // Each chunk of queries collects its results in its own buffers.
+  const size_t chunkSize = 256;
+  const size_t numChunks = (numQueries + chunkSize - 1) / chunkSize;
+  std::vector<size_t> counts(numQueries, 0);
+  std::vector<std::vector<size_t>> chunkResults(numChunks);
+  std::vector<std::vector<ElemType>> chunkDistances(numChunks);
+
+  if (!nodes.empty() && nodes[0].count > 0)
+  {
+    #pragma omp parallel
+    {
+      std::vector<size_t> stack;
+
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+      {
+        const size_t end = std::min(numQueries, (size_t) (c + 1) * chunkSize);
+        for (size_t q = c * chunkSize; q < end; ++q)
+        {
+          std::array<ElemType, Dimensionality> query;
+          for (size_t d = 0; d < Dimensionality; ++d)
+            query[d] = ElemType(queries(d, queryOrder[q]));
+
+          const size_t before = chunkResults[c].size();
+          SearchOne<ComputeDistances>(query, radiusSquared, stack,
+              chunkResults[c], chunkDistances[c]);
+          counts[queryOrder[q]] = chunkResults[c].size() - before;
+        }
+      }
+    }
+  }
+
+  // Assemble the results in CSR form, in the original order of the queries.
+  offsets.set_size(numQueries + 1);
+  offsets[0] = 0;
+  for (size_t i = 0; i < numQueries; ++i)
+    offsets[i + 1] = offsets[i] + counts[i];
+
+  neighbors.set_size(offsets[numQueries]);
+  if (ComputeDistances)
+    distances.set_size(offsets[numQueries]);
+
+  #pragma omp parallel for
+  for (omp_size_t c = 0; c < (omp_size_t) numChunks; ++c)
+  {
+    const size_t end = std::min(numQueries, (size_t) (c + 1) * chunkSize);
+    size_t position = 0;
+    for (size_t q = c * chunkSize; q < end; ++q)
+    {
+      const size_t query = queryOrder[q];
+      std::copy(chunkResults[c].begin() + position,
+          chunkResults[c].begin() + position + counts[query],
+          neighbors.begin() + offsets[query]);
+      if (ComputeDistances)
+      {
+        std::copy(chunkDistances[c].begin() + position,
+            chunkDistances[c].begin() + position + counts[query],
+            distances.begin() + offsets[query]);
+      }
+
+      position += counts[query];
+    }
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -14,7 +14,9 @@
 
 #include <mlpack/prereqs.hpp>
 #include "../hrectbound.hpp"
+#include "../node_arena.hpp"
 #include "../statistic.hpp"
+#include "../frontier_dual_tree_traverser.hpp"
 
 namespace mlpack {
 namespace tree {
@@ -38,6 +40,11 @@ class Octree
   template<typename RuleType>
   class DualTreeTraverser;
 
+  //! A breadth-first dual-tree traverser; see frontier_dual_tree_traverser.hpp.
+  template<typename RuleType>
+  using BreadthFirstDualTreeTraverser =
+      FrontierDualTreeTraverser<Octree, RuleType>;
+
  private:
   //! The children held by this node.
   std::vector<Octree*> children;
@@ -63,6 +70,11 @@ class Octree
   ElemType furthestDescendantDistance;
   //! An instantiated metric.
   MetricType metric;
+  //! The arena holding every node of the tree but the root, created by the
+  //! root with its children.  It is NULL if the nodes are allocated
+  //! individually (as in copies and loaded trees).  The root owns the arena
+  //! and must delete it.
+  NodeArena<Octree>* arena;
 
  public:
   /**
@@ -439,6 +451,34 @@ class Octree
                  std::vector<size_t>& oldFromNew,
                  const size_t maxLeafSize);
 
+  /**
+   * Create the children of this node, once its points have been reordered.
+   * The children of a large node are built in parallel with OpenMP tasks,
+   * since they hold disjoint ranges of the dataset (and of oldFromNew).
+   *
+   * @param childBegins Index of the first point of each child, followed by
+   *     the end of the node.
+   * @param center Center of the node.
+   * @param width Width of the current node.
+   * @param oldFromNew Mappings from old to new, or NULL.
+   * @param maxLeafSize Maximum number of points allowed in a leaf.
+   */
+  void CreateChildren(const arma::Col<size_t>& childBegins,
+                      const arma::vec& center,
+                      const double width,
+                      std::vector<size_t>* oldFromNew,
+                      const size_t maxLeafSize);
+
+  //! The number of points from which the children of a node are built in
+  //! parallel.
+  static constexpr size_t ParallelBuildThreshold = 8192;
+
+  /**
+   * Delete the children of this node (taking into account whether they are
+   * held in an arena), and clear the list of children.
+   */
+  void FreeChildren();
+
   /**
    * This is used for sorting points while splitting.
    */
@@ -16,6 +16,10 @@
 #include <mlpack/core/tree/perform_split.hpp>
 #include <stack>
 
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace tree {
 
@@ -28,7 +32,8 @@ Octree<MetricType, StatisticType, MatType>::Octree(const MatType& dataset,
     bound(dataset.n_rows),
     dataset(new MatType(dataset)),
     parent(NULL),
-    parentDistance(0.0)
+    parentDistance(0.0),
+    arena(NULL)
 {
   if (count > 0)
   {
@@ -66,7 +71,8 @@ Octree<MetricType, StatisticType, MatType>::Octree(
     bound(dataset.n_rows),
     dataset(new MatType(dataset)),
     parent(NULL),
-    parentDistance(0.0)
+    parentDistance(0.0),
+    arena(NULL)
 {
   oldFromNew.resize(this->dataset->n_cols);
   for (size_t i = 0; i < this->dataset->n_cols; ++i)
@@ -109,7 +115,8 @@ Octree<MetricType, StatisticType, MatType>::Octree(
     bound(dataset.n_rows),
     dataset(new MatType(dataset)),
     parent(NULL),
-    parentDistance(0.0)
+    parentDistance(0.0),
+    arena(NULL)
 {
   oldFromNew.resize(this->dataset->n_cols);
   for (size_t i = 0; i < this->dataset->n_cols; ++i)
@@ -154,7 +161,8 @@ Octree<MetricType, StatisticType, MatType>::Octree(MatType&& dataset,
     bound(dataset.n_rows),
     dataset(new MatType(std::move(dataset))),
     parent(NULL),
-    parentDistance(0.0)
+    parentDistance(0.0),
+    arena(NULL)
 {
   if (count > 0)
   {
@@ -192,7 +200,8 @@ Octree<MetricType, StatisticType, MatType>::Octree(
     bound(dataset.n_rows),
     dataset(new MatType(std::move(dataset))),
     parent(NULL),
-    parentDistance(0.0)
+    parentDistance(0.0),
+    arena(NULL)
 {
   oldFromNew.resize(this->dataset->n_cols);
   for (size_t i = 0; i < this->dataset->n_cols; ++i)
@@ -235,7 +244,8 @@ Octree<MetricType, StatisticType, MatType>::Octree(
     bound(dataset.n_rows),
     dataset(new MatType(std::move(dataset))),
     parent(NULL),
-    parentDistance(0.0)
+    parentDistance(0.0),
+    arena(NULL)
 {
   oldFromNew.resize(this->dataset->n_cols);
   for (size_t i = 0; i < this->dataset->n_cols; ++i)
@@ -284,7 +294,8 @@ Octree<MetricType, StatisticType, MatType>::Octree(
     count(count),
     bound(parent->dataset->n_rows),
     dataset(parent->dataset),
-    parent(parent)
+    parent(parent),
+    arena(parent->arena)
 {
   // Calculate empirical center of data.
   bound |= dataset->cols(begin, begin + count - 1);
@@ -319,7 +330,8 @@ Octree<MetricType, StatisticType, MatType>::Octree(
     count(count),
     bound(parent->dataset->n_rows),
     dataset(parent->dataset),
-    parent(parent)
+    parent(parent),
+    arena(parent->arena)
 {
   // Calculate empirical center of data.
   bound |= dataset->cols(begin, begin + count - 1);
@@ -351,7 +363,8 @@ Octree<MetricType, StatisticType, MatType>::Octree(const Octree& other) :
     stat(other.stat),
     parentDistance(other.parentDistance),
     furthestDescendantDistance(other.furthestDescendantDistance),
-    metric(other.metric)
+    metric(other.metric),
+    arena(NULL)
 {
   // If we have any children, we need to create them, and then ensure that their
   // parent links are set right.
@@ -375,9 +388,7 @@ operator=(const Octree& other)
 
   // Freeing memory that will not be used anymore.
   delete dataset;
-  for (size_t i = 0; i < children.size(); ++i)
-    delete children[i];
-  children.clear();
+  FreeChildren();
 
   begin = other.Begin();
   count = other.Count();
@@ -412,7 +423,8 @@ Octree<MetricType, StatisticType, MatType>::Octree(Octree&& other) :
     stat(std::move(other.stat)),
     parentDistance(other.parentDistance),
     furthestDescendantDistance(other.furthestDescendantDistance),
-    metric(std::move(other.metric))
+    metric(std::move(other.metric)),
+    arena(other.arena)
 {
   // Update the parent pointers of the direct children.
   for (size_t i = 0; i < children.size(); ++i)
@@ -424,6 +436,7 @@ Octree<MetricType, StatisticType, MatType>::Octree(Octree&& other) :
   other.parentDistance = 0.0;
   other.furthestDescendantDistance = 0.0;
   other.parent = NULL;
+  other.arena = NULL;
 }
 
 //! Move assignment operator: take ownership of the given tree.
@@ -438,9 +451,7 @@ operator=(Octree&& other)
 
   // Freeing memory that will not be used anymore.
   delete dataset;
-  for (size_t i = 0; i < children.size(); ++i)
-    delete children[i];
-  children.clear();
+  FreeChildren();
 
   children = std::move(other.children);
   begin = other.Begin();
@@ -452,6 +463,7 @@ operator=(Octree&& other)
   parentDistance = other.ParentDistance();
   furthestDescendantDistance = other.furthestDescendantDistance();
   metric = std::move(other.metric);
+  arena = other.arena;
 
   // Update the parent pointers of the direct children.
   for (size_t i = 0; i < children.size(); ++i)
@@ -464,6 +476,7 @@ operator=(Octree&& other)
   other.numDescendants = 0;
   other.furthestDescendantDistance = 0.0;
   other.parent = NULL;
+  other.arena = NULL;
 
   return *this;
 }
@@ -476,7 +489,8 @@ Octree<MetricType, StatisticType, MatType>::Octree() :
     dataset(new MatType()),
     parent(NULL),
     parentDistance(0.0),
-    furthestDescendantDistance(0.0)
+    furthestDescendantDistance(0.0),
+    arena(NULL)
 {
   // Nothing to do.
 }
@@ -500,9 +514,26 @@ Octree<MetricType, StatisticType, MatType>::~Octree()
     delete dataset;
 
   // Now delete each of the children.
-  for (size_t i = 0; i < children.size(); ++i)
-    delete children[i];
+  FreeChildren();
+}
+
+template<typename MetricType, typename StatisticType, typename MatType>
+void Octree<MetricType, StatisticType, MatType>::FreeChildren()
+{
+  if (!arena)
+  {
+    for (size_t i = 0; i < children.size(); ++i)
+      delete children[i];
+  }
+  else if (!parent)
+  {
+    // All of the descendants of the root are held in the arena.  Nodes inside
+    // the arena do not free anything themselves.
+    delete arena;
+  }
+
   children.clear();
+  arena = NULL;
 }
 
 template<typename MetricType, typename StatisticType, typename MatType>
@@ -715,9 +746,7 @@ void Octree<MetricType, StatisticType, MatType>::serialize(
   // If we're loading and we have children, they need to be deleted.
   if (cereal::is_loading<Archive>())
   {
-    for (size_t i = 0; i < children.size(); ++i)
-      delete children[i];
-    children.clear();
+    FreeChildren();
 
     if (!parent)
       delete dataset;
@@ -847,28 +876,7 @@ void Octree<MetricType, StatisticType, MatType>::SplitNode(
   }
 
   // Now that the dataset is reordered, we can create the children.
-  arma::vec childCenter(center.n_elem);
-  const double childWidth = width / 2.0;
-  for (size_t i = 0; i < childBegins.n_elem - 1; ++i)
-  {
-    // If the child has no points, don't create it.
-    if (childBegins[i + 1] - childBegins[i] == 0)
-      continue;
-
-    // Create the correct center.
-    for (size_t d = 0; d < center.n_elem; ++d)
-    {
-      // Is the dimension "right" (1) or "left" (0)?
-      if (((i >> d) & 1) == 0)
-        childCenter[d] = center[d] - childWidth;
-      else
-        childCenter[d] = center[d] + childWidth;
-    }
-
-    children.push_back(new Octree(this, childBegins[i],
-        childBegins[i + 1] - childBegins[i], childCenter, childWidth,
-        maxLeafSize));
-  }
+  CreateChildren(childBegins, center, width, NULL, maxLeafSize);
 }
 
 //! Split the node, and store mappings.
@@ -949,15 +957,37 @@ void Octree<MetricType, StatisticType, MatType>::SplitNode(
   }
 
   // Now that the dataset is reordered, we can create the children.
-  arma::vec childCenter(center.n_elem);
-  const double childWidth = width / 2.0;
+  CreateChildren(childBegins, center, width, &oldFromNew, maxLeafSize);
+}
+
+//! Create the children of the node.
+template<typename MetricType, typename StatisticType, typename MatType>
+void Octree<MetricType, StatisticType, MatType>::CreateChildren(
+    const arma::Col<size_t>& childBegins,
+    const arma::vec& center,
+    const double width,
+    std::vector<size_t>* oldFromNew,
+    const size_t maxLeafSize)
+{
+  // If a child has no points, don't create it.
+  std::vector<size_t> childIndices;
   for (size_t i = 0; i < childBegins.n_elem - 1; ++i)
+    if (childBegins[i + 1] - childBegins[i] > 0)
+      childIndices.push_back(i);
+
+  // The root creates the arena holding the other nodes of the tree when its
+  // children are created.
+  if (!parent && !arena && !childIndices.empty())
+    arena = new NodeArena<Octree>();
+
+  const double childWidth = width / 2.0;
+  children.resize(childIndices.size());
+  auto createChild = [&](const size_t c)
   {
-    // If the child has no points, don't create it.
-    if (childBegins[i + 1] - childBegins[i] == 0)
-      continue;
+    const size_t i = childIndices[c];
 
     // Create the correct center.
+    arma::vec childCenter(center.n_elem);
     for (size_t d = 0; d < center.n_elem; ++d)
     {
       // Is the dimension "right" (1) or "left" (0)?
@@ -967,10 +997,67 @@ void Octree<MetricType, StatisticType, MatType>::SplitNode(
         childCenter[d] = center[d] + childWidth;
     }
 
-    children.push_back(new Octree(this, childBegins[i],
-        childBegins[i + 1] - childBegins[i], oldFromNew, childCenter,
-        childWidth, maxLeafSize));
+    // The children are held in the arena of the tree, unless it has none.
+    if (oldFromNew && arena)
+    {
+      children[c] = arena->Allocate(this, childBegins[i],
+          childBegins[i + 1] - childBegins[i], *oldFromNew, childCenter,
+          childWidth, maxLeafSize);
+    }
+    else if (oldFromNew)
+    {
+      children[c] = new Octree(this, childBegins[i],
+          childBegins[i + 1] - childBegins[i], *oldFromNew, childCenter,
+          childWidth, maxLeafSize);
+    }
+    else if (arena)
+    {
+      children[c] = arena->Allocate(this, childBegins[i],
+          childBegins[i + 1] - childBegins[i], childCenter, childWidth,
+          maxLeafSize);
+    }
+    else
+    {
+      children[c] = new Octree(this, childBegins[i],
+          childBegins[i + 1] - childBegins[i], childCenter, childWidth,
+          maxLeafSize);
+    }
+  };
+
+  // Tasks need OpenMP 3.0; with older versions (such as MSVC's OpenMP 2.0)
+  // the children are built one after the other.
+  #if defined(_OPENMP) && _OPENMP >= 200805
+  if (count >= ParallelBuildThreshold && children.size() > 1 &&
+      omp_get_max_threads() > 1)
+  {
+    auto createChildren = [&]()
+    {
+      for (size_t c = 0; c < children.size(); ++c)
+      {
+        #pragma omp task firstprivate(c)
+        createChild(c);
+      }
+      #pragma omp taskwait
+    };
+
+    // Start a team at the first large node; below it, the tasks are spread
+    // over the threads of that team.
+    if (omp_in_parallel())
+    {
+      createChildren();
+    }
+    else
+    {
+      #pragma omp parallel
+      #pragma omp single
+      createChildren();
+    }
+    return;
   }
+  #endif
+
+  for (size_t c = 0; c < children.size(); ++c)
+    createChild(c);
 }
 
 } // namespace tree
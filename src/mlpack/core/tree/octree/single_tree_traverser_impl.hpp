@@ -14,6 +14,7 @@
 
 // In case it hasn't been included yet.
 #include "single_tree_traverser.hpp"
+#include <mlpack/core/tree/traversal_statistics.hpp>
 
 namespace mlpack {
 namespace tree {
@@ -33,6 +34,8 @@ template<typename RuleType>
 void Octree<MetricType, StatisticType, MatType>::SingleTreeTraverser<RuleType>::
     Traverse(const size_t queryIndex, Octree& referenceNode)
 {
+  MLPACK_TRAVERSAL_LEVEL(rule, numPrunes);
+
   // If we are a leaf, run the base cases.
   if (referenceNode.NumChildren() == 0)
   {
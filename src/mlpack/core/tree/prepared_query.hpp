@@ -0,0 +1,176 @@
+/**
+ * @file core/tree/prepared_query.hpp
+ *
+ * Definition of PreparedQuery, which holds a query tree built once and reused
+ * by several dual-tree searches.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_PREPARED_QUERY_HPP
+#define MLPACK_CORE_TREE_PREPARED_QUERY_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <stack>
+
+#include "tree_traits.hpp"
+
+namespace mlpack {
+namespace tree /** Trees and tree-building procedures. */ {
+
+/**
+ * A PreparedQuery holds a tree built on a set of query points, along with the
+ * mapping from the points of the tree to the original points (for trees that
+ * rearrange their dataset).  Dual-tree searches that take a query set build a
+ * new query tree for each call; when the same query points are searched again
+ * and again (with another k, another range, or after the reference set was
+ * trained again), a PreparedQuery can be given instead, and the tree is built
+ * only once.  The searches that take a PreparedQuery reset the statistics of
+ * the query tree before each use and return the results in the original order
+ * of the query points.
+ *
+ * @code
+ * tree::PreparedQuery<KNN::Tree> query(querySet);
+ * knn.Search(query, 5, neighbors, distances);
+ * knn.Search(query, 10, neighbors, distances); // The tree is not rebuilt.
+ * @endcode
+ *
+ * The statistic type of the tree must be the one of the search (for instance,
+ * use NeighborSearch::Tree, RangeSearch::Tree or KDE::Tree).
+ *
+ * @tparam TreeType Type of the query tree.
+ */
+template<typename TreeType>
+class PreparedQuery
+{
+ public:
+  //! The type of the query points.
+  typedef typename TreeType::Mat MatType;
+
+  /**
+   * Build the query tree on the given query points.  Use std::move() to avoid
+   * a copy of the points.
+   *
+   * @param querySet Set of query points.
+   */
+  explicit PreparedQuery(MatType querySet) :
+      queryTree(Build(std::move(querySet), oldFromNew))
+  { }
+
+  //! The query tree cannot be copied cheaply; use std::move() instead.
+  PreparedQuery(const PreparedQuery& other) = delete;
+  //! The query tree cannot be copied cheaply; use std::move() instead.
+  PreparedQuery& operator=(const PreparedQuery& other) = delete;
+
+  //! Take ownership of the query tree of the given PreparedQuery.
+  PreparedQuery(PreparedQuery&& other) :
+      oldFromNew(std::move(other.oldFromNew)),
+      queryTree(other.queryTree)
+  {
+    other.queryTree = NULL;
+  }
+
+  //! Free the query tree.
+  ~PreparedQuery() { delete queryTree; }
+
+  //! Get the query tree.
+  const TreeType& QueryTree() const { return *queryTree; }
+  //! Modify the query tree.
+  TreeType& QueryTree() { return *queryTree; }
+
+  //! Get the mapping from the points of the tree to the original points (empty
+  //! if the tree does not rearrange its dataset).
+  const std::vector<size_t>& OldFromNew() const { return oldFromNew; }
+
+  //! Get the number of query points.
+  size_t NumQueries() const { return queryTree->Dataset().n_cols; }
+
+  /**
+   * Reset the statistic of every node of the query tree with its Reset()
+   * method, so that the bounds of a previous search are forgotten.
+   */
+  void ResetStatistics()
+  {
+    std::stack<TreeType*> nodes;
+    nodes.push(queryTree);
+    while (!nodes.empty())
+    {
+      TreeType* node = nodes.top();
+      nodes.pop();
+
+      node->Stat().Reset();
+      for (size_t i = 0; i < node->NumChildren(); ++i)
+        nodes.push(&node->Child(i));
+    }
+  }
+
+  /**
+   * Put the columns of the given results (one column per point of the query
+   * tree) back in the original order of the query points.
+   *
+   * @param results Results to rearrange.
+   */
+  template<typename ResultMatType>
+  void Unmap(ResultMatType& results) const
+  {
+    if (oldFromNew.empty())
+      return;
+
+    ResultMatType mapped(results.n_rows, results.n_cols);
+    for (size_t i = 0; i < oldFromNew.size(); ++i)
+      mapped.col(oldFromNew[i]) = results.col(i);
+    results = std::move(mapped);
+  }
+
+  /**
+   * Put the elements of the given results (one element per point of the query
+   * tree) back in the original order of the query points.
+   *
+   * @param results Results to rearrange.
+   */
+  template<typename T>
+  void Unmap(std::vector<T>& results) const
+  {
+    if (oldFromNew.empty())
+      return;
+
+    std::vector<T> mapped(results.size());
+    for (size_t i = 0; i < oldFromNew.size(); ++i)
+      mapped[oldFromNew[i]] = std::move(results[i]);
+    results = std::move(mapped);
+  }
+
+ private:
+  //! Build a tree that rearranges its dataset.
+  template<typename T = TreeType>
+  static TreeType* Build(
+      MatType&& querySet,
+      std::vector<size_t>& oldFromNew,
+      typename std::enable_if_t<TreeTraits<T>::RearrangesDataset, T>* = 0)
+  {
+    return new TreeType(std::move(querySet), oldFromNew);
+  }
+
+  //! Build a tree that keeps its dataset in order.
+  template<typename T = TreeType>
+  static TreeType* Build(
+      MatType&& querySet,
+      std::vector<size_t>& /* oldFromNew */,
+      typename std::enable_if_t<!TreeTraits<T>::RearrangesDataset, T>* = 0)
+  {
+    return new TreeType(std::move(querySet));
+  }
+
+  //! The mapping from the points of the tree to the original points; it is
+  //! declared first since building the tree fills it.
+  std::vector<size_t> oldFromNew;
+  //! The query tree.
+  TreeType* queryTree;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
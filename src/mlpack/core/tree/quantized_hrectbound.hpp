@@ -0,0 +1,288 @@
+/**
+ * @file core/tree/quantized_hrectbound.hpp
+ *
+ * Definition of the QuantizedHRectBound class, a hyperrectangle bound whose
+ * limits are stored as small integer codes on a grid shared by all bounds of a
+ * tree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_QUANTIZED_HRECTBOUND_HPP
+#define MLPACK_CORE_TREE_QUANTIZED_HRECTBOUND_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/range.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+#include <cereal/types/memory.hpp>
+#include "bound_traits.hpp"
+#include "hrectbound.hpp"
+
+namespace mlpack {
+namespace bound {
+
+/**
+ * A hyperrectangle bound that takes much less memory than HRectBound: instead
+ * of two ElemTypes, each dimension stores two codes of type CodeType (by
+ * default uint16_t; uint8_t halves the size again).  The codes index a regular
+ * grid that spans the points of the first bound it is made for (the root of a
+ * tree), and is shared by all bounds quantized against it.  This is most
+ * useful for high-dimensional trees, in which the bounds otherwise take about
+ * as much memory as the data.
+ *
+ * The lower limit of each dimension is rounded down to the grid and the upper
+ * limit is rounded up, so the bound always contains the points that were added
+ * to it, and distances computed with it are valid (if slightly looser) bounds;
+ * pruning with it stays exact.  Values outside of the grid are represented by
+ * the lowest and largest codes, which mean an unbounded limit.
+ *
+ * A BinarySpaceTree using this bound (such as QuantizedKDTree) quantizes the
+ * bounds of all its nodes on the grid of its root.
+ *
+ * @tparam MetricType Type of metric to use; must be of type LMetric.
+ * @tparam ElemType Element type (double/float).
+ * @tparam CodeType Unsigned integer type of the codes.
+ */
+template<typename MetricType = metric::LMetric<2, true>,
+         typename ElemType = double,
+         typename CodeType = uint16_t>
+class QuantizedHRectBound
+{
+  // It is required that QuantizedHRectBound have an LMetric as the given
+  // MetricType.
+  static_assert(meta::IsLMetric<MetricType>::Value == true,
+      "QuantizedHRectBound can only be used with the LMetric<> metric type.");
+  static_assert(std::is_unsigned<CodeType>::value &&
+      sizeof(CodeType) < sizeof(size_t),
+      "QuantizedHRectBound requires a small unsigned integer code type.");
+
+ public:
+  //! The grid on which bounds are quantized.  Grid point k of dimension d is
+  //! origin[d] + k * step[d].
+  struct Grid
+  {
+    //! The first grid point of each dimension.
+    arma::Col<ElemType> origin;
+    //! The distance between grid points in each dimension.
+    arma::Col<ElemType> step;
+
+    //! Serialize the grid.
+    template<typename Archive>
+    void serialize(Archive& ar, const uint32_t /* version */)
+    {
+      ar(CEREAL_NVP(origin));
+      ar(CEREAL_NVP(step));
+    }
+  };
+
+  /**
+   * Empty constructor; creates a bound of dimensionality 0.
+   */
+  QuantizedHRectBound();
+
+  /**
+   * Initializes to specified dimensionality with each dimension the empty
+   * set.  The bound has no grid until points or a bound with a grid are added
+   * to it, or ShareGrid() is called.
+   *
+   * @param dimension Dimensionality of bound.
+   */
+  QuantizedHRectBound(const size_t dimension);
+
+  /**
+   * Resets all dimensions to the empty set (so that this bound contains
+   * nothing).  The grid is kept.
+   */
+  void Clear();
+
+  //! Gets the dimensionality.
+  size_t Dim() const { return dim; }
+
+  //! Get the (decoded) range for a particular dimension.  No bounds checking.
+  math::RangeType<ElemType> operator[](const size_t i) const
+  {
+    return math::RangeType<ElemType>(Decode(i, codes[2 * i]),
+        Decode(i, codes[2 * i + 1]));
+  }
+
+  //! Get the minimum width of the bound.
+  ElemType MinWidth() const { return minWidth; }
+
+  //! Get the instantiated metric associated with the bound.
+  const MetricType& Metric() const { return metric; }
+  //! Modify the instantiated metric associated with the bound.
+  MetricType& Metric() { return metric; }
+
+  //! Get the grid of the bound (NULL if it has none yet).
+  const Grid* GetGrid() const { return grid.get(); }
+
+  /**
+   * Quantize this bound on the same grid as the given bound, so that they
+   * share it.  This bound should be empty.
+   *
+   * @param other Bound whose grid is used.
+   */
+  void ShareGrid(const QuantizedHRectBound& other) { grid = other.grid; }
+
+  /**
+   * Calculates the center of the range, placing it into the given vector.
+   *
+   * @param center Vector which the center will be written to.
+   */
+  void Center(arma::Col<ElemType>& center) const;
+
+  /**
+   * Calculate the volume of the hyperrectangle.
+   *
+   * @return Volume of the hyperrectangle.
+   */
+  ElemType Volume() const;
+
+  /**
+   * Calculates minimum bound-to-point distance.
+   *
+   * @param point Point to which the minimum distance is requested.
+   */
+  template<typename VecType>
+  ElemType MinDistance(const VecType& point,
+                       typename std::enable_if_t<IsVector<VecType>::value>* = 0)
+      const;
+
+  /**
+   * Calculates minimum bound-to-bound distance.
+   *
+   * @param other Bound to which the minimum distance is requested.
+   */
+  ElemType MinDistance(const QuantizedHRectBound& other) const;
+
+  /**
+   * Calculates maximum bound-to-point distance.
+   *
+   * @param point Point to which the maximum distance is requested.
+   */
+  template<typename VecType>
+  ElemType MaxDistance(const VecType& point,
+                       typename std::enable_if_t<IsVector<VecType>::value>* = 0)
+      const;
+
+  /**
+   * Calculates maximum bound-to-bound distance.
+   *
+   * @param other Bound to which the maximum distance is requested.
+   */
+  ElemType MaxDistance(const QuantizedHRectBound& other) const;
+
+  /**
+   * Calculates minimum and maximum bound-to-bound distance.
+   *
+   * @param other Bound to which the minimum and maximum distances are
+   *     requested.
+   */
+  math::RangeType<ElemType> RangeDistance(const QuantizedHRectBound& other)
+      const;
+
+  /**
+   * Calculates minimum and maximum bound-to-point distance.
+   *
+   * @param point Point to which the minimum and maximum distances are
+   *     requested.
+   */
+  template<typename VecType>
+  math::RangeType<ElemType> RangeDistance(
+      const VecType& point,
+      typename std::enable_if_t<IsVector<VecType>::value>* = 0) const;
+
+  /**
+   * Expands this region to include new points.  If the bound has no grid yet,
+   * a grid spanning the points is made.
+   *
+   * @tparam MatType Type of matrix; could be Mat, SpMat, a subview, or just a
+   *   vector.
+   * @param data Data points to expand this region to include.
+   */
+  template<typename MatType>
+  QuantizedHRectBound& operator|=(const MatType& data);
+
+  /**
+   * Expands this region to encompass another bound.  If this bound has no grid
+   * yet, the grid of the other bound is used.
+   */
+  QuantizedHRectBound& operator|=(const QuantizedHRectBound& other);
+
+  /**
+   * Determines if a point is within this bound.
+   *
+   * @param point Point to check the condition.
+   */
+  template<typename VecType>
+  bool Contains(const VecType& point) const;
+
+  /**
+   * Determines if this bound partially contains a bound.
+   *
+   * @param bound Bound to check the condition.
+   */
+  bool Contains(const QuantizedHRectBound& bound) const;
+
+  /**
+   * Returns the diameter of the hyperrectangle (that is, the longest diagonal).
+   */
+  ElemType Diameter() const;
+
+  /**
+   * Serialize the bound object.  Bounds that share a grid still share it after
+   * they are loaded from the same archive.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t version);
+
+ private:
+  //! The dimensionality of the bound.
+  size_t dim;
+  //! The codes of the lower and upper limits of each dimension, interleaved.
+  std::vector<CodeType> codes;
+  //! The grid of the codes, shared by all bounds quantized against it.
+  std::shared_ptr<Grid> grid;
+  //! Cached minimum width of bound.
+  ElemType minWidth;
+  //! Instantiated metric (likely has size 0).
+  MetricType metric;
+
+  //! The code of an unbounded upper limit (and of the lower limit of an empty
+  //! dimension).  The code 0 is an unbounded lower limit (and the upper limit
+  //! of an empty dimension); the codes in between are grid points.
+  static constexpr CodeType MaxCode = std::numeric_limits<CodeType>::max();
+
+  //! Get the value of the given code in the given dimension.
+  ElemType Decode(const size_t d, const CodeType code) const;
+  //! Get the largest code whose value is at most the given value.
+  CodeType EncodeLo(const size_t d, const ElemType value) const;
+  //! Get the smallest code whose value is at least the given value.
+  CodeType EncodeHi(const size_t d, const ElemType value) const;
+
+  //! Recompute the cached minimum width.
+  void UpdateMinWidth();
+
+  //! Add the contribution of the given (non-negative) distance along one
+  //! dimension to a sum of distances.
+  static void Accumulate(ElemType& sum, const ElemType v);
+  //! Turn a sum of distances along each dimension into a distance.
+  static ElemType Finish(const ElemType sum);
+};
+
+// A specialization of BoundTraits for this class.
+template<typename MetricType, typename ElemType, typename CodeType>
+struct BoundTraits<QuantizedHRectBound<MetricType, ElemType, CodeType>>
+{
+  //! The limits are rounded outwards, so the bounds are not tight.
+  const static bool HasTightBounds = false;
+};
+
+} // namespace bound
+} // namespace mlpack
+
+#include "quantized_hrectbound_impl.hpp"
+
+#endif // MLPACK_CORE_TREE_QUANTIZED_HRECTBOUND_HPP
@@ -0,0 +1,434 @@
+/**
+ * @file core/tree/quantized_hrectbound_impl.hpp
+ *
+ * Implementation of the QuantizedHRectBound class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_QUANTIZED_HRECTBOUND_IMPL_HPP
+#define MLPACK_CORE_TREE_QUANTIZED_HRECTBOUND_IMPL_HPP
+
+// In case it has not been included yet.
+#include "quantized_hrectbound.hpp"
+
+namespace mlpack {
+namespace bound {
+
+template<typename MetricType, typename ElemType, typename CodeType>
+inline QuantizedHRectBound<MetricType, ElemType, CodeType>::
+QuantizedHRectBound() :
+    dim(0),
+    minWidth(0)
+{ /* Nothing to do. */ }
+
+template<typename MetricType, typename ElemType, typename CodeType>
+inline QuantizedHRectBound<MetricType, ElemType, CodeType>::
+QuantizedHRectBound(const size_t dimension) :
+    dim(dimension),
+    minWidth(0)
+{
+  Clear();
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+inline void QuantizedHRectBound<MetricType, ElemType, CodeType>::Clear()
+{
+  codes.resize(2 * dim);
+  for (size_t d = 0; d < dim; ++d)
+  {
+    codes[2 * d] = MaxCode;
+    codes[2 * d + 1] = 0;
+  }
+  minWidth = 0;
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+inline ElemType QuantizedHRectBound<MetricType, ElemType, CodeType>::Decode(
+    const size_t d,
+    const CodeType code) const
+{
+  if (code == 0)
+    return std::numeric_limits<ElemType>::lowest();
+  else if (code == MaxCode)
+    return std::numeric_limits<ElemType>::max();
+
+  return grid->origin[d] + (code - 1) * grid->step[d];
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+inline CodeType QuantizedHRectBound<MetricType, ElemType, CodeType>::EncodeLo(
+    const size_t d,
+    const ElemType value) const
+{
+  if (!(value >= grid->origin[d]))
+    return 0;
+
+  CodeType code = 1;
+  if (grid->step[d] > 0)
+  {
+    const ElemType k = std::floor((value - grid->origin[d]) / grid->step[d]);
+    code = (k >= ElemType(MaxCode - 2)) ? MaxCode - 1 : CodeType(k) + 1;
+  }
+
+  // Rounding errors may have put the grid point above the value.
+  while (Decode(d, code) > value)
+    --code;
+
+  return code;
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+inline CodeType QuantizedHRectBound<MetricType, ElemType, CodeType>::EncodeHi(
+    const size_t d,
+    const ElemType value) const
+{
+  CodeType code = 1;
+  if (grid->step[d] > 0 && value > grid->origin[d])
+  {
+    const ElemType k = std::ceil((value - grid->origin[d]) / grid->step[d]);
+    code = (k >= ElemType(MaxCode - 2)) ? MaxCode - 1 : CodeType(k) + 1;
+  }
+
+  // Rounding errors may have put the grid point below the value; if the value
+  // is above the grid, the limit is unbounded.
+  while (code < MaxCode && Decode(d, code) < value)
+    ++code;
+
+  return code;
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+inline void QuantizedHRectBound<MetricType, ElemType, CodeType>::
+UpdateMinWidth()
+{
+  minWidth = std::numeric_limits<ElemType>::max();
+  for (size_t d = 0; d < dim; ++d)
+  {
+    const ElemType width = (*this)[d].Width();
+    if (width < minWidth)
+      minWidth = width;
+  }
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+inline void QuantizedHRectBound<MetricType, ElemType, CodeType>::Accumulate(
+    ElemType& sum,
+    const ElemType v)
+{
+  // The compiler should optimize out this if statement entirely.
+  if (MetricType::Power == 1)
+    sum += v;
+  else if (MetricType::Power == 2)
+    sum += v * v;
+  else
+    sum += std::pow(v, (ElemType) MetricType::Power);
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+inline ElemType QuantizedHRectBound<MetricType, ElemType, CodeType>::Finish(
+    const ElemType sum)
+{
+  // The compiler should optimize out this if statement entirely.
+  if (MetricType::TakeRoot)
+  {
+    if (MetricType::Power == 1)
+      return sum;
+    else if (MetricType::Power == 2)
+      return (ElemType) std::sqrt(sum);
+    else
+      return (ElemType) pow((double) sum, 1.0 / (double) MetricType::Power);
+  }
+  else
+    return sum;
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+inline void QuantizedHRectBound<MetricType, ElemType, CodeType>::Center(
+    arma::Col<ElemType>& center) const
+{
+  // Set size correctly if necessary.
+  if (!(center.n_elem == dim))
+    center.set_size(dim);
+
+  for (size_t d = 0; d < dim; ++d)
+    center(d) = (*this)[d].Mid();
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+inline ElemType QuantizedHRectBound<MetricType, ElemType, CodeType>::Volume()
+    const
+{
+  ElemType volume = 1.0;
+  for (size_t d = 0; d < dim; ++d)
+  {
+    const math::RangeType<ElemType> range = (*this)[d];
+    if (range.Lo() >= range.Hi())
+      return 0;
+
+    volume *= (range.Hi() - range.Lo());
+  }
+
+  return volume;
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+template<typename VecType>
+inline ElemType QuantizedHRectBound<MetricType, ElemType, CodeType>::
+MinDistance(
+    const VecType& point,
+    typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
+{
+  Log::Assert(point.n_elem == dim);
+
+  ElemType sum = 0;
+  for (size_t d = 0; d < dim; ++d)
+  {
+    const math::RangeType<ElemType> range = (*this)[d];
+    const ElemType lower = range.Lo() - point[d];
+    const ElemType higher = point[d] - range.Hi();
+    Accumulate(sum, std::max(std::max(lower, higher), ElemType(0)));
+  }
+
+  return Finish(sum);
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+inline ElemType QuantizedHRectBound<MetricType, ElemType, CodeType>::
+MinDistance(const QuantizedHRectBound& other) const
+{
+  Log::Assert(dim == other.dim);
+
+  ElemType sum = 0;
+  for (size_t d = 0; d < dim; ++d)
+  {
+    const math::RangeType<ElemType> range = (*this)[d];
+    const math::RangeType<ElemType> otherRange = other[d];
+    const ElemType lower = otherRange.Lo() - range.Hi();
+    const ElemType higher = range.Lo() - otherRange.Hi();
+    Accumulate(sum, std::max(std::max(lower, higher), ElemType(0)));
+  }
+
+  return Finish(sum);
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+template<typename VecType>
+inline ElemType QuantizedHRectBound<MetricType, ElemType, CodeType>::
+MaxDistance(
+    const VecType& point,
+    typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
+{
+  Log::Assert(point.n_elem == dim);
+
+  ElemType sum = 0;
+  for (size_t d = 0; d < dim; ++d)
+  {
+    const math::RangeType<ElemType> range = (*this)[d];
+    Accumulate(sum, std::max(std::fabs(point[d] - range.Lo()),
+        std::fabs(range.Hi() - point[d])));
+  }
+
+  return Finish(sum);
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+inline ElemType QuantizedHRectBound<MetricType, ElemType, CodeType>::
+MaxDistance(const QuantizedHRectBound& other) const
+{
+  Log::Assert(dim == other.dim);
+
+  ElemType sum = 0;
+  for (size_t d = 0; d < dim; ++d)
+  {
+    const math::RangeType<ElemType> range = (*this)[d];
+    const math::RangeType<ElemType> otherRange = other[d];
+    Accumulate(sum, std::max(std::fabs(otherRange.Hi() - range.Lo()),
+        std::fabs(range.Hi() - otherRange.Lo())));
+  }
+
+  return Finish(sum);
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+inline math::RangeType<ElemType>
+QuantizedHRectBound<MetricType, ElemType, CodeType>::RangeDistance(
+    const QuantizedHRectBound& other) const
+{
+  Log::Assert(dim == other.dim);
+
+  ElemType loSum = 0;
+  ElemType hiSum = 0;
+  for (size_t d = 0; d < dim; ++d)
+  {
+    const math::RangeType<ElemType> range = (*this)[d];
+    const math::RangeType<ElemType> otherRange = other[d];
+    const ElemType v1 = otherRange.Lo() - range.Hi();
+    const ElemType v2 = range.Lo() - otherRange.Hi();
+    // One of v1 or v2 is negative.
+    Accumulate(loSum, std::max(std::max(v1, v2), ElemType(0)));
+    Accumulate(hiSum, -std::min(v1, v2));
+  }
+
+  return math::RangeType<ElemType>(Finish(loSum), Finish(hiSum));
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+template<typename VecType>
+inline math::RangeType<ElemType>
+QuantizedHRectBound<MetricType, ElemType, CodeType>::RangeDistance(
+    const VecType& point,
+    typename std::enable_if_t<IsVector<VecType>::value>* /* junk */) const
+{
+  Log::Assert(point.n_elem == dim);
+
+  ElemType loSum = 0;
+  ElemType hiSum = 0;
+  for (size_t d = 0; d < dim; ++d)
+  {
+    const math::RangeType<ElemType> range = (*this)[d];
+    const ElemType v1 = range.Lo() - point[d]; // Negative if point[d] > lo.
+    const ElemType v2 = point[d] - range.Hi(); // Negative if point[d] < hi.
+    Accumulate(loSum, std::max(std::max(v1, v2), ElemType(0)));
+    Accumulate(hiSum, std::max(-v1, -v2));
+  }
+
+  return math::RangeType<ElemType>(Finish(loSum), Finish(hiSum));
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+template<typename MatType>
+inline QuantizedHRectBound<MetricType, ElemType, CodeType>&
+QuantizedHRectBound<MetricType, ElemType, CodeType>::operator|=(
+    const MatType& data)
+{
+  Log::Assert(data.n_rows == dim);
+
+  if (data.n_cols == 0)
+    return *this;
+
+  const arma::Col<ElemType> mins(min(data, 1));
+  const arma::Col<ElemType> maxs(max(data, 1));
+
+  if (!grid)
+  {
+    // Spread the grid points evenly over the points; the last grid point must
+    // not be below the largest value, despite rounding errors.
+    grid.reset(new Grid());
+    grid->origin = mins;
+    grid->step = (maxs - mins) / ElemType(MaxCode - 2);
+    for (size_t d = 0; d < dim; ++d)
+    {
+      while (grid->origin[d] + (MaxCode - 2) * grid->step[d] < maxs[d])
+      {
+        grid->step[d] = std::nextafter(grid->step[d],
+            std::numeric_limits<ElemType>::max());
+      }
+    }
+  }
+
+  for (size_t d = 0; d < dim; ++d)
+  {
+    codes[2 * d] = std::min(codes[2 * d], EncodeLo(d, mins[d]));
+    codes[2 * d + 1] = std::max(codes[2 * d + 1], EncodeHi(d, maxs[d]));
+  }
+
+  UpdateMinWidth();
+  return *this;
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+inline QuantizedHRectBound<MetricType, ElemType, CodeType>&
+QuantizedHRectBound<MetricType, ElemType, CodeType>::operator|=(
+    const QuantizedHRectBound& other)
+{
+  Log::Assert(dim == other.dim);
+
+  if (!other.grid)
+    return *this; // The other bound is empty.
+
+  if (!grid)
+    grid = other.grid;
+
+  for (size_t d = 0; d < dim; ++d)
+  {
+    if (grid == other.grid)
+    {
+      codes[2 * d] = std::min(codes[2 * d], other.codes[2 * d]);
+      codes[2 * d + 1] = std::max(codes[2 * d + 1], other.codes[2 * d + 1]);
+    }
+    else if (other.codes[2 * d] <= other.codes[2 * d + 1])
+    {
+      // Requantize the other bound on our grid.
+      const math::RangeType<ElemType> otherRange = other[d];
+      codes[2 * d] = std::min(codes[2 * d], EncodeLo(d, otherRange.Lo()));
+      codes[2 * d + 1] = std::max(codes[2 * d + 1],
+          EncodeHi(d, otherRange.Hi()));
+    }
+  }
+
+  UpdateMinWidth();
+  return *this;
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+template<typename VecType>
+inline bool QuantizedHRectBound<MetricType, ElemType, CodeType>::Contains(
+    const VecType& point) const
+{
+  for (size_t d = 0; d < point.n_elem; ++d)
+  {
+    if (!(*this)[d].Contains(point(d)))
+      return false;
+  }
+
+  return true;
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+inline bool QuantizedHRectBound<MetricType, ElemType, CodeType>::Contains(
+    const QuantizedHRectBound& bound) const
+{
+  for (size_t d = 0; d < dim; ++d)
+  {
+    const math::RangeType<ElemType> rA = (*this)[d];
+    const math::RangeType<ElemType> rB = bound[d];
+
+    // If a does not overlap b at all.
+    if (rA.Hi() <= rB.Lo() || rA.Lo() >= rB.Hi())
+      return false;
+  }
+
+  return true;
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+inline ElemType QuantizedHRectBound<MetricType, ElemType, CodeType>::Diameter()
+    const
+{
+  ElemType sum = 0;
+  for (size_t d = 0; d < dim; ++d)
+    Accumulate(sum, (*this)[d].Width());
+
+  return Finish(sum);
+}
+
+template<typename MetricType, typename ElemType, typename CodeType>
+template<typename Archive>
+void QuantizedHRectBound<MetricType, ElemType, CodeType>::serialize(
+    Archive& ar,
+    const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(dim));
+  ar(CEREAL_NVP(codes));
+  ar(CEREAL_NVP(grid));
+  ar(CEREAL_NVP(minWidth));
+  ar(CEREAL_NVP(metric));
+}
+
+} // namespace bound
+} // namespace mlpack
+
+#endif // MLPACK_CORE_TREE_QUANTIZED_HRECTBOUND_IMPL_HPP
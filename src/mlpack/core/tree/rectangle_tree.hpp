@@ -18,6 +18,7 @@
  */
 #include "bounds.hpp"
 #include "rectangle_tree/rectangle_tree.hpp"
+#include "rectangle_tree/is_rectangle_tree.hpp"
 #include "rectangle_tree/single_tree_traverser.hpp"
 #include "rectangle_tree/single_tree_traverser_impl.hpp"
 #include "rectangle_tree/dual_tree_traverser.hpp"
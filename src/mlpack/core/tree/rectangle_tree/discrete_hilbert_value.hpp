@@ -205,6 +205,17 @@ class DiscreteHilbertValue
   template<typename TreeType>
   void UpdateLargestValue(TreeType* node);
 
+  /**
+   * Calculate the local Hilbert values of a node built by bulk loading.  The
+   * points of a leaf (or the children of an intermediate node) should be
+   * arranged according to their Hilbert values, and the children should
+   * already be handled.
+   *
+   * @param node The node that was built.
+   */
+  template<typename TreeType>
+  void HandleBulkLoad(TreeType* node);
+
   /**
    * This method updates the largest Hilbert value of a leaf node and
    * redistributes the Hilbert values of points according to their new position
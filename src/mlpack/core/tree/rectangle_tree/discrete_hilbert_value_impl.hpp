@@ -50,7 +50,8 @@ DiscreteHilbertValue<TreeElemType>::DiscreteHilbertValue(const TreeType* tree) :
   // Calculate the Hilbert value for all points.
   if (!tree->Parent()) // This is the root node.
     ownsLocalHilbertValues = true;
-  else if (tree->Parent()->Child(0).IsLeaf())
+  else if (tree->Parent()->NumChildren() > 0 &&
+           tree->Parent()->Child(0).IsLeaf())
   {
     // This is a leaf node.
     assert(tree->Parent()->NumChildren() > 0);
@@ -491,6 +492,39 @@ void DiscreteHilbertValue<TreeElemType>::UpdateLargestValue(TreeType* node)
   }
 }
 
+template<typename TreeElemType>
+template<typename TreeType>
+void DiscreteHilbertValue<TreeElemType>::HandleBulkLoad(TreeType* node)
+{
+  if (node->IsLeaf())
+  {
+    // Only leaf nodes own the localHilbertValues dataset.
+    if (!ownsLocalHilbertValues)
+    {
+      localHilbertValues = new arma::Mat<HilbertElemType>(
+          node->Dataset().n_rows, node->MaxLeafSize() + 1);
+      ownsLocalHilbertValues = true;
+    }
+
+    for (size_t i = 0; i < node->NumPoints(); ++i)
+    {
+      localHilbertValues->col(i) =
+          CalculateValue(node->Dataset().col(node->Point(i)));
+    }
+    numValues = node->NumPoints();
+  }
+  else
+  {
+    if (ownsLocalHilbertValues)
+    {
+      delete localHilbertValues;
+      ownsLocalHilbertValues = false;
+    }
+
+    UpdateLargestValue(node);
+  }
+}
+
 template<typename TreeElemType>
 template<typename TreeType>
 void DiscreteHilbertValue<TreeElemType>::RedistributeHilbertValues(
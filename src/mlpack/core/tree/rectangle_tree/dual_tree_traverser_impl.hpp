@@ -15,6 +15,7 @@
 #define MLPAC_CORE_TREE_RECTANGLE_TREE_DUAL_TREE_TRAVERSER_IMPL_HPP
 
 #include "dual_tree_traverser.hpp"
+#include <mlpack/core/tree/traversal_statistics.hpp>
 
 #include <algorithm>
 #include <stack>
@@ -51,6 +52,8 @@ void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
 DualTreeTraverser<RuleType>::Traverse(RectangleTree& queryNode,
                                       RectangleTree& referenceNode)
 {
+  MLPACK_TRAVERSAL_LEVEL(rule, numPrunes);
+
   // Increment the visit counter.
   ++numVisited;
 
@@ -117,6 +117,15 @@ class HilbertRTreeAuxiliaryInformation
    */
   bool UpdateAuxiliaryInfo(TreeType* node);
 
+  /**
+   * Calculate the Hilbert values of a node built by bulk loading.
+   *
+   * @param node The node that was built.
+   * @param * (cell) The region of space assigned to the node.
+   */
+  template<typename CellType>
+  void HandleBulkLoad(TreeType* node, const CellType& /* cell */);
+
   //! Clear memory.
   void NullifyData();
 
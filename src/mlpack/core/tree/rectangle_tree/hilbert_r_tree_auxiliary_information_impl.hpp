@@ -167,6 +167,15 @@ UpdateAuxiliaryInfo(TreeType* node)
   return false;
 }
 
+template<typename TreeType,
+         template<typename> class HilbertValueType>
+template<typename CellType>
+void HilbertRTreeAuxiliaryInformation<TreeType, HilbertValueType>::
+HandleBulkLoad(TreeType* node, const CellType& /* cell */)
+{
+  hilbertValue.HandleBulkLoad(node);
+}
+
 template<typename TreeType,
          template<typename> class HilbertValueType>
 void HilbertRTreeAuxiliaryInformation<TreeType, HilbertValueType>::
@@ -0,0 +1,43 @@
+/**
+ * @file core/tree/rectangle_tree/is_rectangle_tree.hpp
+ *
+ * Definition of IsRectangleTree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_RECTANGLE_TREE_IS_RECTANGLE_TREE_HPP
+#define MLPACK_CORE_TREE_RECTANGLE_TREE_IS_RECTANGLE_TREE_HPP
+
+#include "rectangle_tree.hpp"
+
+namespace mlpack {
+namespace tree /** Trees and tree-building procedures. */ {
+
+// Useful struct when specific behaviour for RectangleTrees is required, for
+// instance inserting and deleting points without rebuilding the tree.
+template<typename TreeType>
+struct IsRectangleTree
+{
+  static const bool value = false;
+};
+
+// Specialization for RectangleTree.
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+struct IsRectangleTree<tree::RectangleTree<MetricType, StatisticType, MatType,
+    SplitType, DescentType, AuxiliaryInformationType>>
+{
+  static const bool value = true;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
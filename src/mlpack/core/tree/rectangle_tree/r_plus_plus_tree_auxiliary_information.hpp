@@ -137,6 +137,15 @@ class RPlusPlusTreeAuxiliaryInformation
                           const size_t axis,
                           const ElemType cut);
 
+  /**
+   * Set the maximum bounding rectangle of a node built by bulk loading to the
+   * region of space assigned to it.
+   *
+   * @param * (node) The node that was built.
+   * @param cell The region of space assigned to the node.
+   */
+  void HandleBulkLoad(TreeType* /* node */, const BoundType& cell);
+
   /**
    * Nullify the auxiliary information in order to prevent an invalid free.
    */
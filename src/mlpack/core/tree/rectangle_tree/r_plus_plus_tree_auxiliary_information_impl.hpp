@@ -116,6 +116,14 @@ void RPlusPlusTreeAuxiliaryInformation<TreeType>::SplitAuxiliaryInfo(
   treeTwoBound[axis].Lo() = cut;
 }
 
+template<typename TreeType>
+void RPlusPlusTreeAuxiliaryInformation<TreeType>::HandleBulkLoad(
+    TreeType* /* node */,
+    const BoundType& cell)
+{
+  outerBound = cell;
+}
+
 template<typename TreeType>
 void RPlusPlusTreeAuxiliaryInformation<TreeType>::NullifyData()
 { /* Nothing to do */ }
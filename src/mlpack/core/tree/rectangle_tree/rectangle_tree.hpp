@@ -17,13 +17,30 @@
 
 #include "../hrectbound.hpp"
 #include "../statistic.hpp"
+#include "../frontier_dual_tree_traverser.hpp"
 #include "r_tree_split.hpp"
 #include "r_tree_descent_heuristic.hpp"
 #include "no_auxiliary_information.hpp"
+#include "hilbert_r_tree_descent_heuristic.hpp"
+#include "discrete_hilbert_value.hpp"
 
 namespace mlpack {
 namespace tree /** Trees and tree-building procedures. */ {
 
+//! The methods with which a RectangleTree can be bulk-loaded.
+enum BulkLoadType
+{
+  //! Sort-Tile-Recursive: the points of each node are sorted along each
+  //! dimension in turn and cut into tiles, one tile per child.  The children
+  //! of a node never overlap, so this can be used for every tree type but the
+  //! Hilbert R tree.
+  STR_BULK_LOAD,
+  //! The points are sorted by their Hilbert values (see DiscreteHilbertValue),
+  //! and each node holds a contiguous run of them.  This cannot be used for
+  //! R+ and R++ trees, whose children may not overlap.
+  HILBERT_BULK_LOAD
+};
+
 /**
  * A rectangle type tree tree, such as an R-tree or X-tree.  Once the
  * bound and type of dataset is defined, the tree will construct itself.  Call
@@ -113,6 +130,11 @@ class RectangleTree
   //! A dual tree traverser for rectangle type trees.
   template<typename RuleType>
   class DualTreeTraverser;
+  //! A breadth-first dual tree traverser for rectangle type trees.  See
+  //! frontier_dual_tree_traverser.hpp for implementation.
+  template<typename RuleType>
+  using BreadthFirstDualTreeTraverser =
+      FrontierDualTreeTraverser<RectangleTree, RuleType>;
 
   /**
    * Construct this as the root node of a rectangle type tree using the given
@@ -156,6 +178,52 @@ class RectangleTree
                 const size_t minNumChildren = 2,
                 const size_t firstDataIndex = 0);
 
+  /**
+   * Construct this as the root node of a rectangle type tree by bulk loading
+   * the given dataset, instead of inserting its points one at a time.  This
+   * is much faster, and gives fuller nodes that overlap less; points can still
+   * be inserted and deleted afterwards.  All leaves are at the same depth, and
+   * the points are spread evenly over as few nodes as possible.  An exception
+   * is thrown if the bulk loading method cannot be used for this tree type
+   * (see BulkLoadType).
+   *
+   * @param data Dataset from which to create the tree.
+   * @param bulkLoad Bulk loading method.
+   * @param maxLeafSize Maximum size of each leaf in the tree.
+   * @param minLeafSize Minimum size of each leaf in the tree.
+   * @param maxNumChildren The maximum number of child nodes a non-leaf node may
+   *      have.
+   * @param minNumChildren The minimum number of child nodes a non-leaf node may
+   *      have.
+   */
+  RectangleTree(const MatType& data,
+                const BulkLoadType bulkLoad,
+                const size_t maxLeafSize = 20,
+                const size_t minLeafSize = 8,
+                const size_t maxNumChildren = 5,
+                const size_t minNumChildren = 2);
+
+  /**
+   * Construct this as the root node of a rectangle type tree by bulk loading
+   * the given dataset, and taking ownership of the given dataset.  See the
+   * constructor above for details.
+   *
+   * @param data Dataset from which to create the tree.
+   * @param bulkLoad Bulk loading method.
+   * @param maxLeafSize Maximum size of each leaf in the tree.
+   * @param minLeafSize Minimum size of each leaf in the tree.
+   * @param maxNumChildren The maximum number of child nodes a non-leaf node may
+   *      have.
+   * @param minNumChildren The minimum number of child nodes a non-leaf node may
+   *      have.
+   */
+  RectangleTree(MatType&& data,
+                const BulkLoadType bulkLoad,
+                const size_t maxLeafSize = 20,
+                const size_t minLeafSize = 8,
+                const size_t maxNumChildren = 5,
+                const size_t minNumChildren = 2);
+
   /**
    * Construct this as an empty node with the specified parent.  Copying the
    * parameters (maxLeafSize, minLeafSize, maxNumChildren, minNumChildren,
@@ -564,6 +632,54 @@ class RectangleTree
    */
   void BuildStatistics(RectangleTree* node);
 
+  //! The type of the regions of space assigned to nodes by bulk loading.
+  typedef bound::HRectBound<metric::EuclideanDistance, ElemType> CellType;
+
+  /**
+   * Build the tree (this must be an empty root) by bulk loading all the points
+   * of the dataset.
+   *
+   * @param bulkLoad Bulk loading method.
+   */
+  void BulkLoad(const BulkLoadType bulkLoad);
+
+  /**
+   * Build the subtree of the given empty node from the points order[begin,
+   * end).  All leaves of the subtree are at the given height (0 for a leaf).
+   *
+   * @param node Node whose subtree is built.
+   * @param order Indices of the points; they are reordered.
+   * @param begin Index of the first point of the node in order.
+   * @param end Index after the last point of the node in order.
+   * @param height Height of the subtree.
+   * @param cell Region of space assigned to the node.
+   * @param bulkLoad Bulk loading method.
+   */
+  static void BulkLoadNode(RectangleTree* node,
+                           std::vector<size_t>& order,
+                           const size_t begin,
+                           const size_t end,
+                           const size_t height,
+                           const CellType& cell,
+                           const BulkLoadType bulkLoad);
+
+  /**
+   * Cut the points order[begin, end) into the given number of tiles of nearly
+   * equal size, sorting them along the given dimension and then along the
+   * next dimensions (Sort-Tile-Recursive).  The tiles, given by the index after
+   * their last point, are appended to ends, and their regions of space (which
+   * partition the given cell) to cells.
+   */
+  static void TilePoints(const MatType& dataset,
+                         std::vector<size_t>& order,
+                         const size_t begin,
+                         const size_t end,
+                         const size_t tiles,
+                         const size_t dim,
+                         const CellType& cell,
+                         std::vector<size_t>& ends,
+                         std::vector<CellType>& cells);
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
@@ -16,6 +16,7 @@
 #include "rectangle_tree.hpp"
 
 #include <mlpack/core/util/log.hpp>
+#include <mlpack/core/tree/tree_traits.hpp>
 
 namespace mlpack {
 namespace tree {
@@ -39,6 +40,223 @@ BuildStatistics(RectangleTree* node)
   node->Stat() = StatisticType(*node);
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+BulkLoad(const BulkLoadType bulkLoad)
+{
+  // The Hilbert R tree keeps its points sorted by their Hilbert values, and
+  // the children of R+ and R++ trees may not overlap.
+  if (bulkLoad != HILBERT_BULK_LOAD &&
+      std::is_same<DescentType, HilbertRTreeDescentHeuristic>::value)
+  {
+    std::ostringstream oss;
+    oss << "RectangleTree::RectangleTree(): Hilbert R trees can only be "
+        << "bulk-loaded with HILBERT_BULK_LOAD.";
+    throw std::invalid_argument(oss.str());
+  }
+  if (bulkLoad == HILBERT_BULK_LOAD &&
+      !TreeTraits<RectangleTree>::HasOverlappingChildren)
+  {
+    std::ostringstream oss;
+    oss << "RectangleTree::RectangleTree(): trees whose children may not "
+        << "overlap cannot be bulk-loaded with HILBERT_BULK_LOAD; use "
+        << "STR_BULK_LOAD instead.";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const size_t numPoints = dataset->n_cols;
+  std::vector<size_t> order(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+    order[i] = i;
+
+  if (bulkLoad == HILBERT_BULK_LOAD)
+  {
+    typedef DiscreteHilbertValue<ElemType> HilbertValueType;
+    typedef typename HilbertValueType::HilbertElemType HilbertElemType;
+
+    // Sort the points once by their Hilbert values; each node then gets a
+    // contiguous run of them.
+    arma::Mat<HilbertElemType> values(dataset->n_rows, numPoints);
+    for (size_t i = 0; i < numPoints; ++i)
+      values.col(i) = HilbertValueType::CalculateValue(dataset->col(i));
+
+    std::sort(order.begin(), order.end(),
+        [&values](const size_t a, const size_t b)
+        {
+          return std::lexicographical_compare(values.colptr(a),
+              values.colptr(a) + values.n_rows, values.colptr(b),
+              values.colptr(b) + values.n_rows);
+        });
+  }
+
+  // Find the height of the tree: the smallest one whose leaves can hold all
+  // the points.
+  size_t height = 0;
+  size_t capacity = maxLeafSize;
+  while (capacity < numPoints)
+  {
+    capacity *= maxNumChildren;
+    ++height;
+  }
+
+  CellType cell(dataset->n_rows);
+  for (size_t i = 0; i < dataset->n_rows; ++i)
+  {
+    cell[i] = math::RangeType<ElemType>(std::numeric_limits<ElemType>::lowest(),
+        std::numeric_limits<ElemType>::max());
+  }
+
+  BulkLoadNode(this, order, 0, numPoints, height, cell, bulkLoad);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+BulkLoadNode(RectangleTree* node,
+             std::vector<size_t>& order,
+             const size_t begin,
+             const size_t end,
+             const size_t height,
+             const CellType& cell,
+             const BulkLoadType bulkLoad)
+{
+  if (height == 0)
+  {
+    for (size_t i = begin; i < end; ++i)
+    {
+      node->points[node->count++] = order[i];
+      node->bound |= node->dataset->col(order[i]);
+    }
+    node->numDescendants = end - begin;
+
+    node->auxiliaryInfo.HandleBulkLoad(node, cell);
+    return;
+  }
+
+  // Use as few children as possible, and spread the points evenly over them,
+  // so that every child is more than half full.
+  size_t childCapacity = node->maxLeafSize;
+  for (size_t i = 1; i < height; ++i)
+    childCapacity *= node->maxNumChildren;
+  const size_t numChildren = (end - begin + childCapacity - 1) / childCapacity;
+
+  std::vector<size_t> ends;
+  std::vector<CellType> cells;
+  if (bulkLoad == STR_BULK_LOAD)
+  {
+    TilePoints(*node->dataset, order, begin, end, numChildren, 0, cell, ends,
+        cells);
+  }
+  else
+  {
+    for (size_t i = 0; i < numChildren; ++i)
+    {
+      ends.push_back(begin + (end - begin) * (i + 1) / numChildren);
+      cells.push_back(cell);
+    }
+  }
+
+  size_t childBegin = begin;
+  for (size_t i = 0; i < ends.size(); ++i)
+  {
+    RectangleTree* child = new RectangleTree(node);
+    node->children[node->numChildren++] = child;
+    BulkLoadNode(child, order, childBegin, ends[i], height - 1, cells[i],
+        bulkLoad);
+
+    node->bound |= child->bound;
+    node->numDescendants += child->numDescendants;
+    childBegin = ends[i];
+  }
+
+  node->auxiliaryInfo.HandleBulkLoad(node, cell);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+TilePoints(const MatType& dataset,
+           std::vector<size_t>& order,
+           const size_t begin,
+           const size_t end,
+           const size_t tiles,
+           const size_t dim,
+           const CellType& cell,
+           std::vector<size_t>& ends,
+           std::vector<CellType>& cells)
+{
+  if (tiles == 1 || dim >= dataset.n_rows)
+  {
+    // Nothing is left to cut along.
+    for (size_t i = 0; i < tiles; ++i)
+    {
+      ends.push_back(begin + (end - begin) * (i + 1) / tiles);
+      cells.push_back(cell);
+    }
+    return;
+  }
+
+  // Cut this dimension into the smallest number of slabs such that the
+  // remaining dimensions can each be cut into as many slabs.
+  const size_t remainingDims = dataset.n_rows - dim;
+  size_t slabs = 1;
+  while (true)
+  {
+    size_t product = 1;
+    for (size_t i = 0; i < remainingDims && product < tiles; ++i)
+      product *= slabs;
+    if (product >= tiles)
+      break;
+    ++slabs;
+  }
+
+  std::sort(order.begin() + begin, order.begin() + end,
+      [&dataset, dim](const size_t a, const size_t b)
+      {
+        return dataset(dim, a) < dataset(dim, b);
+      });
+
+  // Each slab gets whole tiles, and the tiles have nearly equal sizes.
+  const size_t numPoints = end - begin;
+  size_t tile = 0;
+  size_t slabBegin = begin;
+  for (size_t i = 0; i < slabs; ++i)
+  {
+    const size_t slabTiles = tiles / slabs + (i < tiles % slabs ? 1 : 0);
+    size_t slabEnd = slabBegin;
+    for (size_t j = 0; j < slabTiles; ++j, ++tile)
+      slabEnd += numPoints / tiles + (tile < numPoints % tiles ? 1 : 0);
+
+    // The slabs are separated by the coordinates of their first points, so
+    // their cells partition the cell of the node.
+    CellType slabCell(cell);
+    if (i > 0)
+      slabCell[dim].Lo() = dataset(dim, order[slabBegin]);
+    if (i < slabs - 1)
+      slabCell[dim].Hi() = dataset(dim, order[slabEnd]);
+
+    TilePoints(dataset, order, slabBegin, slabEnd, slabTiles, dim + 1,
+        slabCell, ends, cells);
+    slabBegin = slabEnd;
+  }
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -121,6 +339,100 @@ RectangleTree(MatType&& data,
   BuildStatistics(this);
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+RectangleTree(const MatType& data,
+              const BulkLoadType bulkLoad,
+              const size_t maxLeafSize,
+              const size_t minLeafSize,
+              const size_t maxNumChildren,
+              const size_t minNumChildren) :
+    maxNumChildren(maxNumChildren),
+    minNumChildren(minNumChildren),
+    numChildren(0),
+    children(maxNumChildren + 1), // Add one to make splitting the node simpler.
+    parent(NULL),
+    begin(0),
+    count(0),
+    numDescendants(0),
+    maxLeafSize(maxLeafSize),
+    minLeafSize(minLeafSize),
+    bound(data.n_rows),
+    parentDistance(0),
+    dataset(new MatType(data)),
+    ownsDataset(true),
+    points(maxLeafSize + 1), // Add one to make splitting the node simpler.
+    auxiliaryInfo(this)
+{
+  // If the bulk loading method is invalid, the dataset is the only resource
+  // that is not freed by the destructors of the members.
+  try
+  {
+    BulkLoad(bulkLoad);
+  }
+  catch (std::invalid_argument&)
+  {
+    delete dataset;
+    throw;
+  }
+
+  // Initialize statistic recursively after tree construction is complete.
+  BuildStatistics(this);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+RectangleTree(MatType&& data,
+              const BulkLoadType bulkLoad,
+              const size_t maxLeafSize,
+              const size_t minLeafSize,
+              const size_t maxNumChildren,
+              const size_t minNumChildren) :
+    maxNumChildren(maxNumChildren),
+    minNumChildren(minNumChildren),
+    numChildren(0),
+    children(maxNumChildren + 1), // Add one to make splitting the node simpler.
+    parent(NULL),
+    begin(0),
+    count(0),
+    numDescendants(0),
+    maxLeafSize(maxLeafSize),
+    minLeafSize(minLeafSize),
+    bound(data.n_rows),
+    parentDistance(0),
+    dataset(new MatType(std::move(data))),
+    ownsDataset(true),
+    points(maxLeafSize + 1), // Add one to make splitting the node simpler.
+    auxiliaryInfo(this)
+{
+  // If the bulk loading method is invalid, the dataset is the only resource
+  // that is not freed by the destructors of the members.
+  try
+  {
+    BulkLoad(bulkLoad);
+  }
+  catch (std::invalid_argument&)
+  {
+    delete dataset;
+    throw;
+  }
+
+  // Initialize statistic recursively after tree construction is complete.
+  BuildStatistics(this);
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -15,6 +15,7 @@
 #define MLPACK_CORE_TREE_RECTANGLE_TREE_SINGLE_TREE_TRAVERSER_IMPL_HPP
 
 #include "single_tree_traverser.hpp"
+#include <mlpack/core/tree/traversal_statistics.hpp>
 
 #include <algorithm>
 #include <stack>
@@ -49,6 +50,8 @@ SingleTreeTraverser<RuleType>::Traverse(
     const size_t queryIndex,
     const RectangleTree& referenceNode)
 {
+  MLPACK_TRAVERSAL_LEVEL(rule, numPrunes);
+
   // If we reach a leaf node, we need to run the base case.
   if (referenceNode.IsLeaf())
   {
@@ -156,6 +156,18 @@ class XTreeAuxiliaryInformation
     return false;
   }
 
+  /**
+   * Some tree types require to set up the auxiliary information of the nodes
+   * built by bulk loading.  This is called for each node once its subtree is
+   * built.
+   *
+   * @param * (node) The node that was built.
+   * @param * (cell) The region of space assigned to the node.
+   */
+  template<typename CellType>
+  void HandleBulkLoad(TreeType* /* node */, const CellType& /* cell */)
+  { }
+
   /**
    * Nullify the auxiliary information in order to prevent an invalid free.
    */
@@ -17,6 +17,7 @@
 
 // In case it hasn't been included yet.
 #include "spill_dual_tree_traverser.hpp"
+#include <mlpack/core/tree/traversal_statistics.hpp>
 
 namespace mlpack {
 namespace tree {
@@ -53,6 +54,8 @@ SpillDualTreeTraverser<RuleType, Defeatist>::Traverse(
         referenceNode,
     const bool bruteForce)
 {
+  MLPACK_TRAVERSAL_LEVEL(rule, numPrunes);
+
   // Increment the visit counter.
   ++numVisited;
 
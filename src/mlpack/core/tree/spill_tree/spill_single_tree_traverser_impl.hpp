@@ -17,6 +17,7 @@
 
 // In case it hasn't been included yet.
 #include "spill_single_tree_traverser.hpp"
+#include <mlpack/core/tree/traversal_statistics.hpp>
 
 namespace mlpack {
 namespace tree {
@@ -49,6 +50,8 @@ SpillSingleTreeTraverser<RuleType, Defeatist>::Traverse(
         referenceNode,
     const bool bruteForce)
 {
+  MLPACK_TRAVERSAL_LEVEL(rule, numPrunes);
+
   // If we have too few points, then we need to backtrack up one level and
   // brute-force search.
   if (!bruteForce && Defeatist &&
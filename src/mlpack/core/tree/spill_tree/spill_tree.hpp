@@ -466,6 +466,11 @@ class SpillTree
                    const arma::Col<size_t>& points,
                    arma::Col<size_t>& leftPoints,
                    arma::Col<size_t>& rightPoints);
+
+  //! The number of points (counting the points of the overlapping buffer
+  //! twice) from which the children of a node are built in parallel.
+  static constexpr size_t ParallelBuildThreshold = 8192;
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
@@ -16,6 +16,10 @@
 
 #include <queue>
 
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace tree {
 
@@ -766,9 +770,43 @@ void SpillTree<MetricType, StatisticType, MatType, HyperplaneType, SplitType>::
   }
 
   // Now we will recursively split the children by calling their constructors
-  // (which perform this splitting process).
-  left = new SpillTree(this, leftPoints, tau, maxLeafSize, rho);
-  right = new SpillTree(this, rightPoints, tau, maxLeafSize, rho);
+  // (which perform this splitting process).  The children of a large node are
+  // built in parallel: they only read the dataset, and the points of an
+  // overlapping buffer are simply copied into both lists, so the two subtrees
+  // are independent.  OpenMP tasks need OpenMP 3.0; otherwise the children
+  // are built one after the other.
+  #if defined(_OPENMP) && _OPENMP >= 200805
+  if (leftPoints.n_elem + rightPoints.n_elem >= ParallelBuildThreshold &&
+      omp_get_max_threads() > 1)
+  {
+    auto createChildren = [&]()
+    {
+      #pragma omp task
+      left = new SpillTree(this, leftPoints, tau, maxLeafSize, rho);
+      #pragma omp task
+      right = new SpillTree(this, rightPoints, tau, maxLeafSize, rho);
+      #pragma omp taskwait
+    };
+
+    // Start a team at the first large node; below it, the tasks are spread
+    // over the threads of that team.
+    if (omp_in_parallel())
+    {
+      createChildren();
+    }
+    else
+    {
+      #pragma omp parallel
+      #pragma omp single
+      createChildren();
+    }
+  }
+  else
+  #endif
+  {
+    left = new SpillTree(this, leftPoints, tau, maxLeafSize, rho);
+    right = new SpillTree(this, rightPoints, tau, maxLeafSize, rho);
+  }
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
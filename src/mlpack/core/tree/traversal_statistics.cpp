@@ -0,0 +1,135 @@
+/**
+ * @file core/tree/traversal_statistics.cpp
+ *
+ * Implementation of the TraversalStatistics class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "traversal_statistics.hpp"
+
+#include <mlpack/core/util/log.hpp>
+
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <mutex>
+
+using namespace mlpack;
+using namespace mlpack::tree;
+using namespace std;
+
+namespace {
+
+//! The statistics of all threads.
+struct StatisticsRegistry
+{
+  //! Protects the list of threads.
+  mutex registryMutex;
+  //! The statistics of each thread that made a traversal.  They are kept after
+  //! the thread exits, so that they can still be reported.
+  vector<unique_ptr<vector<TraversalStatistics::Level>>> threads;
+};
+
+StatisticsRegistry& Registry()
+{
+  static StatisticsRegistry registry;
+  return registry;
+}
+
+} // namespace
+
+atomic<bool> TraversalStatistics::enabled(false);
+
+TraversalStatistics::Level& TraversalStatistics::ThreadLevel(
+    const size_t depth)
+{
+  thread_local vector<Level>* levels = NULL;
+  if (levels == NULL)
+  {
+    StatisticsRegistry& registry = Registry();
+    lock_guard<mutex> lock(registry.registryMutex);
+    registry.threads.emplace_back(new vector<Level>());
+    levels = registry.threads.back().get();
+  }
+
+  if (levels->size() <= depth)
+    levels->resize(depth + 1);
+
+  return (*levels)[depth];
+}
+
+vector<TraversalStatistics::Level> TraversalStatistics::Levels()
+{
+  StatisticsRegistry& registry = Registry();
+  lock_guard<mutex> lock(registry.registryMutex);
+
+  vector<Level> levels;
+  for (const unique_ptr<vector<Level>>& threadLevels : registry.threads)
+  {
+    if (levels.size() < threadLevels->size())
+      levels.resize(threadLevels->size());
+
+    for (size_t d = 0; d < threadLevels->size(); ++d)
+    {
+      levels[d].visits += (*threadLevels)[d].visits;
+      levels[d].prunes += (*threadLevels)[d].prunes;
+      levels[d].scores += (*threadLevels)[d].scores;
+      levels[d].baseCases += (*threadLevels)[d].baseCases;
+    }
+  }
+
+  return levels;
+}
+
+void TraversalStatistics::Reset()
+{
+  StatisticsRegistry& registry = Registry();
+  lock_guard<mutex> lock(registry.registryMutex);
+  for (unique_ptr<vector<Level>>& threadLevels : registry.threads)
+    threadLevels->clear();
+}
+
+void TraversalStatistics::Print()
+{
+  const vector<Level> levels = Levels();
+  if (levels.empty())
+    return;
+
+  // Log::Info does not keep stream manipulators, so the table is formatted
+  // first.
+  ostringstream table;
+  table << "  " << setw(5) << "level" << setw(14) << "visits" << setw(14)
+      << "prunes" << setw(13) << "prune ratio" << setw(14) << "scores"
+      << setw(14) << "base cases" << endl;
+
+  Level total;
+  table << fixed << setprecision(3);
+  for (size_t d = 0; d < levels.size(); ++d)
+  {
+    // The prune ratio is the fraction of the children considered at this
+    // level that were pruned instead of visited.
+    const size_t childVisits = (d + 1 < levels.size()) ?
+        levels[d + 1].visits : 0;
+    const double ratio = (levels[d].prunes + childVisits == 0) ? 0.0 :
+        double(levels[d].prunes) / double(levels[d].prunes + childVisits);
+
+    table << "  " << setw(5) << d << setw(14) << levels[d].visits << setw(14)
+        << levels[d].prunes << setw(13) << ratio << setw(14)
+        << levels[d].scores << setw(14) << levels[d].baseCases << endl;
+
+    total.visits += levels[d].visits;
+    total.prunes += levels[d].prunes;
+    total.scores += levels[d].scores;
+    total.baseCases += levels[d].baseCases;
+  }
+
+  table << "  " << setw(5) << "total" << setw(14) << total.visits << setw(14)
+      << total.prunes << setw(13) << "" << setw(14) << total.scores
+      << setw(14) << total.baseCases << endl;
+
+  Log::Info << "Tree traversal statistics (by recursion level):" << endl;
+  Log::Info << table.str();
+}
@@ -0,0 +1,232 @@
+/**
+ * @file core/tree/traversal_statistics.hpp
+ *
+ * Collection of statistics about tree traversals (node visits, prunes, score
+ * calls and base cases for each recursion level), for all traversers and all
+ * tree-based methods.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_TRAVERSAL_STATISTICS_HPP
+#define MLPACK_CORE_TREE_TRAVERSAL_STATISTICS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * TraversalStatistics collects, for each recursion level of the tree
+ * traversers, how many nodes (or node combinations, for dual-tree traversals)
+ * were visited, how many children were pruned while visiting them, and how
+ * many Score() and BaseCase() calls the rules made.  These numbers can be used
+ * to choose a leaf size or a tree type for a dataset.
+ *
+ * The statistics are only collected when mlpack is compiled with
+ * MLPACK_TRAVERSAL_STATISTICS defined (the CMake option TRAVERSAL_STATISTICS),
+ * so that traversals have no overhead otherwise, and when collection has been
+ * enabled with Enable().  Each thread collects its own statistics without
+ * locking; Levels() sums them, and should be called once the traversals are
+ * done.  The command-line programs enable collection with --verbose and print
+ * the statistics at the end.
+ *
+ * Score() and BaseCase() calls are taken from the Scores() and BaseCases()
+ * counters of the rules, so they are zero for rules without these counters.
+ */
+class TraversalStatistics
+{
+ public:
+  //! The statistics of one recursion level.
+  struct Level
+  {
+    Level() : visits(0), prunes(0), scores(0), baseCases(0) { }
+
+    //! Number of times the traverser recursed to this level.
+    size_t visits;
+    //! Number of children pruned while at this level.
+    size_t prunes;
+    //! Number of Score() calls made while at this level.
+    size_t scores;
+    //! Number of BaseCase() calls made while at this level.
+    size_t baseCases;
+  };
+
+  //! Start collecting statistics.
+  static void Enable() { enabled = true; }
+
+  //! Stop collecting statistics.
+  static void Disable() { enabled = false; }
+
+  //! Return whether statistics are being collected.
+  static bool Enabled() { return enabled.load(std::memory_order_relaxed); }
+
+  //! Return whether statistics can be collected in this build.
+  static bool Compiled()
+  {
+    #ifdef MLPACK_TRAVERSAL_STATISTICS
+    return true;
+    #else
+    return false;
+    #endif
+  }
+
+  //! Get the statistics of each level, summed over all threads.
+  static std::vector<Level> Levels();
+
+  //! Remove all collected statistics.  Do not call this during a traversal.
+  static void Reset();
+
+  //! Print the statistics of each level to Log::Info.
+  static void Print();
+
+  //! Get the statistics of the given level for the calling thread.  This is
+  //! used by TraversalLevelGuard.
+  static Level& ThreadLevel(const size_t depth);
+
+ private:
+  //! Whether statistics are being collected.
+  static std::atomic<bool> enabled;
+};
+
+/**
+ * Record one visit of a traverser at the recursion level of the enclosing
+ * call, and attribute to this level the prunes, scores and base cases made
+ * during the call but not during the nested calls.  Use
+ * MLPACK_TRAVERSAL_LEVEL() at the start of a traversal function instead of
+ * this class directly.
+ *
+ * @tparam RuleType Type of the rules of the traversal.
+ */
+template<typename RuleType>
+class TraversalLevelGuard
+{
+ public:
+  /**
+   * Enter a level.
+   *
+   * @param rule Rules of the traversal.
+   * @param numPrunes Prune counter of the traverser.
+   */
+  TraversalLevelGuard(const RuleType& rule, const size_t& numPrunes) :
+      rule(rule),
+      numPrunes(numPrunes),
+      active(TraversalStatistics::Enabled()),
+      parent(NULL),
+      depth(0),
+      startPrunes(numPrunes),
+      startScores(ScoresOf(rule, 0)),
+      startBaseCases(BaseCasesOf(rule, 0)),
+      childPrunes(0),
+      childScores(0),
+      childBaseCases(0)
+  {
+    if (!active)
+      return;
+
+    parent = Current();
+    depth = (parent == NULL) ? 0 : parent->depth + 1;
+    Current() = this;
+  }
+
+  //! Leave the level and record its statistics.
+  ~TraversalLevelGuard()
+  {
+    if (!active)
+      return;
+
+    const size_t prunes = numPrunes - startPrunes;
+    const size_t scores = ScoresOf(rule, 0) - startScores;
+    const size_t baseCases = BaseCasesOf(rule, 0) - startBaseCases;
+
+    TraversalStatistics::Level& level = TraversalStatistics::ThreadLevel(depth);
+    ++level.visits;
+    level.prunes += prunes - childPrunes;
+    level.scores += scores - childScores;
+    level.baseCases += baseCases - childBaseCases;
+
+    if (parent != NULL)
+    {
+      parent->childPrunes += prunes;
+      parent->childScores += scores;
+      parent->childBaseCases += baseCases;
+    }
+
+    Current() = parent;
+  }
+
+  TraversalLevelGuard(const TraversalLevelGuard&) = delete;
+  TraversalLevelGuard& operator=(const TraversalLevelGuard&) = delete;
+
+ private:
+  //! The innermost level of the calling thread.
+  static TraversalLevelGuard*& Current()
+  {
+    static thread_local TraversalLevelGuard* current = NULL;
+    return current;
+  }
+
+  //! Get the number of Score() calls of rules that count them.
+  template<typename T>
+  static auto ScoresOf(const T& r, int) -> decltype(size_t(r.Scores()))
+  {
+    return r.Scores();
+  }
+
+  //! Rules without a Score() counter count no Score() calls.
+  template<typename T>
+  static size_t ScoresOf(const T& /* r */, long) { return 0; }
+
+  //! Get the number of BaseCase() calls of rules that count them.
+  template<typename T>
+  static auto BaseCasesOf(const T& r, int) ->
+      decltype(size_t(r.BaseCases()))
+  {
+    return r.BaseCases();
+  }
+
+  //! Rules without a BaseCase() counter count no BaseCase() calls.
+  template<typename T>
+  static size_t BaseCasesOf(const T& /* r */, long) { return 0; }
+
+  //! The rules of the traversal.
+  const RuleType& rule;
+  //! The prune counter of the traverser.
+  const size_t& numPrunes;
+  //! Whether statistics are collected for this level.
+  bool active;
+  //! The enclosing level, if any.
+  TraversalLevelGuard* parent;
+  //! The recursion level.
+  size_t depth;
+  //! The counters when the level was entered.
+  size_t startPrunes, startScores, startBaseCases;
+  //! The counts of the nested levels.
+  size_t childPrunes, childScores, childBaseCases;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+/**
+ * Record the enclosing traversal function call in the traversal statistics, if
+ * mlpack is compiled with MLPACK_TRAVERSAL_STATISTICS; otherwise this does
+ * nothing.
+ *
+ * @param rule Rules of the traversal.
+ * @param numPrunes Prune counter of the traverser.
+ */
+#ifdef MLPACK_TRAVERSAL_STATISTICS
+  #define MLPACK_TRAVERSAL_LEVEL(rule, numPrunes) \
+      ::mlpack::tree::TraversalLevelGuard<typename std::remove_reference< \
+          decltype(rule)>::type> mlpackTraversalLevel(rule, numPrunes)
+#else
+  #define MLPACK_TRAVERSAL_LEVEL(rule, numPrunes)
+#endif
+
+#endif
@@ -0,0 +1,96 @@
+/**
+ * @file core/tree/traversal_tasks.hpp
+ *
+ * Helpers to split a dual-tree traversal into tasks on the subtrees of the
+ * query tree, and to merge the results of the rules of each thread afterwards.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_TRAVERSAL_TASKS_HPP
+#define MLPACK_CORE_TREE_TRAVERSAL_TASKS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree /** Trees and tree-building procedures. */ {
+
+/**
+ * Collect the nodes at the given depth of the tree (or the leaves above that
+ * depth).  The descendants of these nodes partition the points of the tree, so
+ * each of them can be the query node of an independent dual-tree traversal.
+ *
+ * @param node Root of the (sub)tree to collect the nodes of.
+ * @param depth Depth of the nodes to collect, relative to node.
+ * @param nodes Vector to append the collected nodes to.
+ */
+template<typename TreeType>
+void CollectTaskNodes(TreeType& node,
+                      const size_t depth,
+                      std::vector<TreeType*>& nodes)
+{
+  if (depth == 0 || node.NumChildren() == 0)
+  {
+    nodes.push_back(&node);
+    return;
+  }
+
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    CollectTaskNodes(node.Child(i), depth - 1, nodes);
+}
+
+/**
+ * Merge the results of a parallel traversal of the given task nodes into the
+ * given rules.  Thread 0 uses the given rules themselves, and thread t > 0 the
+ * rules threadRules[t - 1]; owners[i] is the thread that traversed tasks[i].
+ * For each descendant point of a task traversed by another thread,
+ * merge(rules, threadRule, point) is called.
+ *
+ * @param rules Rules of thread 0, which receive the results.
+ * @param threadRules Rules of the other threads.
+ * @param tasks Task nodes of the traversal.
+ * @param owners The thread that traversed each task.
+ * @param merge Function that merges the results of one query point.
+ */
+template<typename TreeType, typename RuleType, typename MergeFunction>
+void MergeTaskResults(RuleType& rules,
+                      std::vector<RuleType>& threadRules,
+                      const std::vector<TreeType*>& tasks,
+                      const std::vector<size_t>& owners,
+                      const MergeFunction& merge)
+{
+  for (size_t i = 0; i < tasks.size(); ++i)
+  {
+    if (owners[i] == 0)
+      continue;
+
+    RuleType& taskRule = threadRules[owners[i] - 1];
+    for (size_t j = 0; j < tasks[i]->NumDescendants(); ++j)
+      merge(rules, taskRule, tasks[i]->Descendant(j));
+  }
+}
+
+/**
+ * Add the numbers of base cases and scores of the rules of each thread to the
+ * given rules.
+ *
+ * @param rules Rules to add the counts to.
+ * @param threadRules Rules of the threads.
+ */
+template<typename RuleType>
+void MergeTraversalCounts(RuleType& rules,
+                          std::vector<RuleType>& threadRules)
+{
+  for (size_t t = 0; t < threadRules.size(); ++t)
+  {
+    rules.BaseCases() += threadRules[t].BaseCases();
+    rules.Scores() += threadRules[t].Scores();
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
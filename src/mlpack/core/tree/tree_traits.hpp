@@ -116,6 +116,27 @@ class TreeTraits
   static const bool UniqueNumDescendants = true;
 };
 
+/**
+ * The RuleTraits class provides compile-time information on the rules of a
+ * tree traversal (the RuleType of a traverser), in the same way as TreeTraits
+ * does for trees.  By default no assumptions are made about the rules;
+ * specialize this class for your rules to declare their characteristics.
+ */
+template<typename RuleType>
+class RuleTraits
+{
+ public:
+  /**
+   * This is true if copies of the rules can score node combinations and
+   * compute base cases for disjoint query subtrees on different threads at the
+   * same time.  Each copy must only modify its own members, the results of the
+   * query points it is given and the statistics of the query nodes it is given
+   * (and of their descendants).  Counters kept by the copies, such as the
+   * number of base cases, are not merged back into the original rules.
+   */
+  static const bool HasThreadSafeScoring = false;
+};
+
 } // namespace tree
 } // namespace mlpack
 
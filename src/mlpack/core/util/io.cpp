@@ -14,9 +14,22 @@
 #include "log.hpp"
 #include "hyphenate_string.hpp"
 
+#include <mutex>
+
 using namespace mlpack;
 using namespace mlpack::util;
 
+namespace {
+
+//! Protects the stored settings, which threads with a context read.
+std::mutex& StorageMutex()
+{
+  static std::mutex storageMutex;
+  return storageMutex;
+}
+
+} // namespace
+
 /* Constructors, Destructors, Copy */
 /* Make the constructor private, to preclude unauthorized instances */
 IO::IO() : didParse(false)
@@ -143,13 +156,25 @@ void IO::MakeInPlaceCopy(const std::string& outputParamName,
   }
 }
 
-// Returns the sole instance of this class.
+// Returns the context of the calling thread, or the global instance.
 IO& IO::GetSingleton()
+{
+  std::unique_ptr<IO>& context = Context();
+  return context ? *context : Global();
+}
+
+IO& IO::Global()
 {
   static IO singleton;
   return singleton;
 }
 
+std::unique_ptr<IO>& IO::Context()
+{
+  static thread_local std::unique_ptr<IO> context;
+  return context;
+}
+
 // Get the parameters that the IO object knows about.
 std::map<std::string, ParamData>& IO::Parameters()
 {
@@ -184,6 +209,8 @@ void IO::SetPassed(const std::string& name)
 // Store settings.
 void IO::StoreSettings(const std::string& name)
 {
+  std::lock_guard<std::mutex> lock(StorageMutex());
+
   // Take all of the parameters and put them in the map.  Clear anything old
   // first.
   std::get<0>(GetSingleton().storageMap[name]) = GetSingleton().parameters;
@@ -196,6 +223,8 @@ void IO::StoreSettings(const std::string& name)
 // Restore settings.
 void IO::RestoreSettings(const std::string& name, const bool fatal)
 {
+  std::lock_guard<std::mutex> lock(StorageMutex());
+
   if (GetSingleton().storageMap.count(name) == 0 && fatal)
   {
     throw std::invalid_argument("no settings stored under the name '" + name
@@ -214,6 +243,33 @@ void IO::RestoreSettings(const std::string& name, const bool fatal)
   }
 }
 
+// Give the calling thread its own settings.
+void IO::BeginContext(const std::string& name)
+{
+  std::unique_ptr<IO> context(new IO());
+  {
+    std::lock_guard<std::mutex> lock(StorageMutex());
+    IO& global = Global();
+    if (global.storageMap.count(name) == 0)
+    {
+      throw std::invalid_argument("IO::BeginContext(): no settings stored "
+          "under the name '" + name + "'");
+    }
+
+    context->parameters = std::get<0>(global.storageMap[name]);
+    context->aliases = std::get<1>(global.storageMap[name]);
+    context->functionMap = std::get<2>(global.storageMap[name]);
+  }
+
+  Context() = std::move(context);
+}
+
+// Go back to the global settings.
+void IO::EndContext()
+{
+  Context().reset();
+}
+
 // Clear settings.
 void IO::ClearSettings()
 {
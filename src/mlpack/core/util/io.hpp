@@ -16,6 +16,7 @@
 #include <iostream>
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
 
 #include <boost/any.hpp>
@@ -294,6 +295,29 @@ class IO
    */
   static void ClearSettings();
 
+  /**
+   * Give the calling thread its own parameters, aliases, function mappings and
+   * timers, starting from the settings stored under the given name (with
+   * StoreSettings()), until EndContext() is called.  While a thread has a
+   * context, every IO function called from that thread uses it instead of the
+   * global settings, so bindings called from several threads do not share
+   * their parameters.  Note that the verbosity of Log::Info and the random
+   * number generator are still shared by all threads, so bindings should not
+   * run at the same time.  If the thread already has a context, it is
+   * replaced.  A std::invalid_argument
+   * exception is thrown if no settings were stored under the given name.
+   *
+   * @param name Name of the settings to start from.
+   */
+  static void BeginContext(const std::string& name);
+
+  /**
+   * Remove the context of the calling thread (see BeginContext()), so that it
+   * uses the global settings again.  This does nothing if the thread has no
+   * context.
+   */
+  static void EndContext();
+
   /**
    * Checks all input matrices for NaN and inf values, exits if found any.
    */
@@ -343,6 +367,12 @@ class IO
   IO(const IO& other);
   //! Private copy operator; we don't want copies floating around.
   IO& operator=(const IO& other);
+
+  //! Get the global object, used by threads without a context.
+  static IO& Global();
+
+  //! Get the context of the calling thread, if it has one.
+  static std::unique_ptr<IO>& Context();
 };
 
 } // namespace mlpack
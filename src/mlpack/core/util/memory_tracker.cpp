@@ -0,0 +1,172 @@
+/**
+ * @file core/util/memory_tracker.cpp
+ *
+ * Implementation of the MemoryTracker class, and (with MLPACK_MEMORY_TRACKING)
+ * of the global operator new and operator delete that it counts.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "memory_tracker.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <sys/resource.h>
+#endif
+
+#if defined(_WIN32) || defined(MLPACK_MEMORY_TRACKING)
+  #include <malloc.h>
+#endif
+
+using namespace mlpack;
+
+namespace {
+
+//! The number of bytes currently allocated.
+std::atomic<int64_t> liveBytes(0);
+//! The peak of liveBytes since the last call to TakePeak().
+std::atomic<int64_t> peakBytes(0);
+//! The number of allocations.
+std::atomic<uint64_t> allocations(0);
+//! The number of bytes allocated.
+std::atomic<uint64_t> allocatedBytes(0);
+
+#ifdef MLPACK_MEMORY_TRACKING
+
+//! Count an allocation of the given block.
+inline void RecordAllocation(void* ptr)
+{
+  if (ptr == NULL)
+    return;
+
+  const int64_t bytes = (int64_t) malloc_usable_size(ptr);
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  allocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+  const int64_t live = liveBytes.fetch_add(bytes, std::memory_order_relaxed) +
+      bytes;
+
+  int64_t peak = peakBytes.load(std::memory_order_relaxed);
+  while (live > peak && !peakBytes.compare_exchange_weak(peak, live,
+      std::memory_order_relaxed)) { }
+}
+
+//! Count the release of the given block.
+inline void RecordFree(void* ptr)
+{
+  if (ptr == NULL)
+    return;
+
+  liveBytes.fetch_sub((int64_t) malloc_usable_size(ptr),
+      std::memory_order_relaxed);
+}
+
+#endif
+
+} // anonymous namespace
+
+bool MemoryTracker::Enabled()
+{
+  #ifdef MLPACK_MEMORY_TRACKING
+  return true;
+  #else
+  return false;
+  #endif
+}
+
+void* MemoryTracker::Allocate(const size_t bytes)
+{
+  // Use the same alignment as Armadillo's own allocator.
+  void* ptr = NULL;
+  const size_t alignment = (bytes >= 1024) ? 32 : 16;
+  #if defined(_WIN32)
+  ptr = _aligned_malloc(bytes, alignment);
+  #else
+  if (posix_memalign(&ptr, alignment, bytes) != 0)
+    ptr = NULL;
+  #endif
+
+  #ifdef MLPACK_MEMORY_TRACKING
+  RecordAllocation(ptr);
+  #endif
+  return ptr;
+}
+
+void MemoryTracker::Free(void* ptr)
+{
+  #ifdef MLPACK_MEMORY_TRACKING
+  RecordFree(ptr);
+  #endif
+
+  #if defined(_WIN32)
+  _aligned_free(ptr);
+  #else
+  free(ptr);
+  #endif
+}
+
+int64_t MemoryTracker::LiveBytes()
+{
+  return liveBytes.load(std::memory_order_relaxed);
+}
+
+uint64_t MemoryTracker::Allocations()
+{
+  return allocations.load(std::memory_order_relaxed);
+}
+
+uint64_t MemoryTracker::AllocatedBytes()
+{
+  return allocatedBytes.load(std::memory_order_relaxed);
+}
+
+int64_t MemoryTracker::TakePeak()
+{
+  const int64_t live = liveBytes.load(std::memory_order_relaxed);
+  const int64_t peak = peakBytes.exchange(live, std::memory_order_relaxed);
+  return (peak > live) ? peak : live;
+}
+
+uint64_t MemoryTracker::PeakResident()
+{
+  #if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+
+  // ru_maxrss is in kilobytes on Linux, but in bytes on macOS.
+  #if defined(__APPLE__)
+  return (uint64_t) usage.ru_maxrss;
+  #else
+  return (uint64_t) usage.ru_maxrss * 1024;
+  #endif
+  #else
+  return 0;
+  #endif
+}
+
+#ifdef MLPACK_MEMORY_TRACKING
+
+// Count the allocations of operator new too; the other forms of operator new
+// and operator delete (arrays, nothrow, sized) call these two.
+void* operator new(size_t bytes)
+{
+  void* ptr = malloc(bytes == 0 ? 1 : bytes);
+  if (ptr == NULL)
+    throw std::bad_alloc();
+
+  RecordAllocation(ptr);
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+  RecordFree(ptr);
+  free(ptr);
+}
+
+#endif
@@ -0,0 +1,90 @@
+/**
+ * @file core/util/memory_tracker.hpp
+ *
+ * Opt-in tracking of the heap allocations of mlpack programs, used by the
+ * timers to report the memory used by each named region.
+ *
+ * This file is included before Armadillo, so it must not include anything
+ * else from mlpack.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTILITIES_MEMORY_TRACKER_HPP
+#define MLPACK_CORE_UTILITIES_MEMORY_TRACKER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mlpack {
+
+/**
+ * The memory used by a region of code (a named timer).
+ */
+struct MemoryStats
+{
+  //! Number of heap allocations.
+  uint64_t allocations;
+  //! Total number of bytes allocated (freed memory is not subtracted).
+  uint64_t allocatedBytes;
+  //! Largest increase of the live heap bytes over their level at the start.
+  int64_t peakBytes;
+  //! Peak resident memory of the process, in bytes, at the end.
+  uint64_t peakResident;
+
+  //! Set all the values to zero.
+  MemoryStats() :
+      allocations(0),
+      allocatedBytes(0),
+      peakBytes(0),
+      peakResident(0)
+  { }
+};
+
+/**
+ * MemoryTracker counts the heap allocations of the whole process: the
+ * allocations of Armadillo objects (through ARMA_ALIEN_MEM_ALLOC_FUNCTION) and
+ * of operator new.  The tracking is only compiled in with
+ * MLPACK_MEMORY_TRACKING defined (the CMake option MEMORY_TRACKING, which
+ * needs malloc_usable_size()); otherwise Enabled() returns false and all the
+ * counts are zero.
+ *
+ * Allocations are counted with atomic operations, so they cost little, but
+ * they are shared between threads: the values reported for a timer include
+ * the allocations that other threads made while it ran.
+ *
+ * The peak of the live bytes is kept in one place; TakePeak() returns it and
+ * starts a new peak from the current level, so that the timers can fold the
+ * peak into every region that is running whenever one starts or stops.
+ */
+class MemoryTracker
+{
+ public:
+  //! Return whether allocations are tracked.
+  static bool Enabled();
+
+  //! Allocate memory for Armadillo (with Armadillo's alignment).
+  static void* Allocate(const size_t bytes);
+  //! Free memory allocated by Allocate().
+  static void Free(void* ptr);
+
+  //! Get the number of bytes currently allocated (relative to the start).
+  static int64_t LiveBytes();
+  //! Get the number of allocations since the start of the program.
+  static uint64_t Allocations();
+  //! Get the number of bytes allocated since the start of the program.
+  static uint64_t AllocatedBytes();
+
+  //! Get the peak of the live bytes since the last call, and start a new peak
+  //! from the current level.
+  static int64_t TakePeak();
+
+  //! Get the peak resident memory of the process in bytes (0 if unknown).
+  static uint64_t PeakResident();
+};
+
+} // namespace mlpack
+
+#endif
@@ -91,6 +91,7 @@ static const std::string testName = "";
 #include <mlpack/core/util/param.hpp>
 #include <mlpack/bindings/cli/parse_command_line.hpp>
 #include <mlpack/bindings/cli/end_program.hpp>
+#include <mlpack/bindings/cli/serve.hpp>
 
 static void mlpackMain(); // This is typically defined after this include.
 
@@ -104,11 +105,16 @@ int main(int argc, char** argv)
   // A "total_time" timer is run by default for each mlpack program.
   mlpack::Timer::Start("total_time");
 
-  mlpackMain();
+  // With --serve, run the program once per request instead of once.
+  const bool serve = mlpack::IO::HasParam("serve");
+  if (serve)
+    mlpack::bindings::cli::Serve(&mlpackMain);
+  else
+    mlpackMain();
 
   // Print output options, print verbose information, save model parameters,
   // clean up, and so forth.
-  mlpack::bindings::cli::EndProgram();
+  mlpack::bindings::cli::EndProgram(!serve);
 }
 
 #elif(BINDING_TYPE == BINDING_TYPE_TEST) // This is a unit test.
@@ -0,0 +1,121 @@
+/**
+ * @file core/util/numa.hpp
+ *
+ * Placement of matrices and of OpenMP threads on NUMA machines, enabled with
+ * the USE_NUMA CMake option.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_NUMA_HPP
+#define MLPACK_CORE_UTIL_NUMA_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+/**
+ * The binding of the threads of the parallel regions of the parallel methods
+ * (NeighborSearch, KMeans, RandomForest, ...), to be put after
+ * "#pragma omp parallel".  When mlpack is compiled with MLPACK_USE_NUMA
+ * defined (the USE_NUMA CMake option), the threads are spread over the places
+ * of the machine (see the OMP_PLACES environment variable; with
+ * OMP_PLACES=cores, every thread gets its own core), so that they stay on the
+ * socket whose memory they first touched.  Otherwise, this is empty, and the
+ * threads are bound as the OMP_PROC_BIND environment variable says.
+ */
+#ifdef MLPACK_USE_NUMA
+  #define MLPACK_OMP_PROC_BIND proc_bind(spread)
+#else
+  #define MLPACK_OMP_PROC_BIND
+#endif
+
+namespace mlpack {
+namespace util {
+
+/**
+ * Copy the given matrix into the given output matrix, which is allocated
+ * again.  When mlpack is compiled with MLPACK_USE_NUMA defined, the columns of
+ * the output are written by the OpenMP threads with a static schedule, so that
+ * (with the first-touch policy of the operating system) the memory of each
+ * block of columns is placed on the NUMA node of the thread that wrote it, and
+ * the matrix is spread over the memory of all the sockets instead of sitting
+ * in the memory of one.  Otherwise, this is a plain copy.
+ *
+ * @param input Matrix to copy.
+ * @param output Matrix to copy into.
+ */
+template<typename eT>
+void FirstTouchCopy(const arma::Mat<eT>& input, arma::Mat<eT>& output)
+{
+  #if defined(MLPACK_USE_NUMA) && defined(HAS_OPENMP)
+  // The memory of a new matrix is not touched until it is written.
+  output.set_size(input.n_rows, input.n_cols);
+
+  const size_t rows = input.n_rows;
+  #pragma omp parallel for schedule(static) MLPACK_OMP_PROC_BIND
+  for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
+    std::copy(input.colptr(i), input.colptr(i) + rows, output.colptr(i));
+  #else
+  output = input;
+  #endif
+}
+
+/**
+ * Copy the given matrix into the given output matrix.  Only dense matrices are
+ * placed in memory by the threads; see the overload for arma::Mat.
+ *
+ * @param input Matrix to copy.
+ * @param output Matrix to copy into.
+ */
+template<typename MatType>
+void FirstTouchCopy(const MatType& input, MatType& output)
+{
+  output = input;
+}
+
+/**
+ * Place the memory of the given matrix again, as FirstTouchCopy() does, so that
+ * it is spread over the memory of all the sockets.  This does nothing unless
+ * mlpack is compiled with MLPACK_USE_NUMA defined, and the matrix owns its
+ * memory.  This is useful for large matrices that are read by all the threads
+ * of the parallel methods, but were created by a single thread.
+ *
+ * @param matrix Matrix to place in memory.
+ */
+template<typename eT>
+void FirstTouch(arma::Mat<eT>& matrix)
+{
+  #if defined(MLPACK_USE_NUMA) && defined(HAS_OPENMP)
+  // Matrices using external memory (aliases) are left alone.
+  if (matrix.mem_state != 0 || omp_get_max_threads() == 1)
+    return;
+
+  arma::Mat<eT> placed;
+  FirstTouchCopy(matrix, placed);
+  matrix.steal_mem(placed);
+  #else
+  (void) matrix;
+  #endif
+}
+
+/**
+ * Place the memory of the given matrix again.  Only dense matrices are placed
+ * in memory by the threads; see the overload for arma::Mat.
+ *
+ * @param matrix Matrix to place in memory.
+ */
+template<typename MatType>
+void FirstTouch(MatType& /* matrix */)
+{
+  // Nothing to do.
+}
+
+} // namespace util
+} // namespace mlpack
+
+#endif
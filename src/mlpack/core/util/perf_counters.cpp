@@ -0,0 +1,139 @@
+/**
+ * @file core/util/perf_counters.cpp
+ *
+ * Implementation of the PerfCounters class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "perf_counters.hpp"
+
+#ifdef MLPACK_PERF_COUNTERS
+  #include <cstring>
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+using namespace mlpack;
+
+#ifdef MLPACK_PERF_COUNTERS
+
+namespace {
+
+/**
+ * The group of counters of one thread.  The cycle counter leads the group, so
+ * that all four are scheduled on the PMU together and read with one call.
+ */
+class ThreadCounters
+{
+ public:
+  ThreadCounters() : available(false)
+  {
+    const uint64_t configs[4] = { PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES };
+
+    for (size_t i = 0; i < 4; ++i)
+      fds[i] = -1;
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+      perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = configs[i];
+      attr.disabled = (i == 0);
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP;
+
+      fds[i] = (int) syscall(__NR_perf_event_open, &attr, 0, -1,
+          (i == 0) ? -1 : fds[0], 0);
+      if (fds[i] == -1)
+      {
+        Close();
+        return;
+      }
+    }
+
+    ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    available = true;
+  }
+
+  ~ThreadCounters() { Close(); }
+
+  bool Available() const { return available; }
+
+  PerfCounterValues Read() const
+  {
+    PerfCounterValues values;
+    if (!available)
+      return values;
+
+    // With PERF_FORMAT_GROUP, the number of counters comes first.
+    uint64_t buffer[5];
+    if (read(fds[0], buffer, sizeof(buffer)) != (ssize_t) sizeof(buffer))
+      return values;
+
+    values.cycles = buffer[1];
+    values.instructions = buffer[2];
+    values.llcMisses = buffer[3];
+    values.branchMisses = buffer[4];
+    return values;
+  }
+
+ private:
+  void Close()
+  {
+    for (size_t i = 0; i < 4; ++i)
+    {
+      if (fds[i] != -1)
+        close(fds[i]);
+      fds[i] = -1;
+    }
+    available = false;
+  }
+
+  //! The file descriptors of the counters.
+  int fds[4];
+  //! Whether all the counters could be opened.
+  bool available;
+};
+
+ThreadCounters& GetThreadCounters()
+{
+  thread_local ThreadCounters counters;
+  return counters;
+}
+
+} // anonymous namespace
+
+bool PerfCounters::Available()
+{
+  return GetThreadCounters().Available();
+}
+
+PerfCounterValues PerfCounters::Read()
+{
+  return GetThreadCounters().Read();
+}
+
+#else
+
+bool PerfCounters::Available()
+{
+  return false;
+}
+
+PerfCounterValues PerfCounters::Read()
+{
+  return PerfCounterValues();
+}
+
+#endif
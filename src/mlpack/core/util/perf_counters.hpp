@@ -0,0 +1,93 @@
+/**
+ * @file core/util/perf_counters.hpp
+ *
+ * Hardware performance counters (cycles, instructions, cache and branch
+ * misses) of the calling thread, read through the Linux perf_event interface.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTILITIES_PERF_COUNTERS_HPP
+#define MLPACK_CORE_UTILITIES_PERF_COUNTERS_HPP
+
+#include <cstdint>
+
+namespace mlpack {
+
+/**
+ * The values of the hardware counters over some span of execution.
+ */
+struct PerfCounterValues
+{
+  //! Number of CPU cycles.
+  uint64_t cycles;
+  //! Number of instructions retired.
+  uint64_t instructions;
+  //! Number of last-level cache misses.
+  uint64_t llcMisses;
+  //! Number of mispredicted branches.
+  uint64_t branchMisses;
+
+  //! Set all the counts to zero.
+  PerfCounterValues() :
+      cycles(0),
+      instructions(0),
+      llcMisses(0),
+      branchMisses(0)
+  { }
+
+  //! Get the number of instructions per cycle.
+  double IPC() const
+  {
+    return (cycles == 0) ? 0.0 : double(instructions) / double(cycles);
+  }
+
+  //! Add the given counts.
+  PerfCounterValues& operator+=(const PerfCounterValues& other)
+  {
+    cycles += other.cycles;
+    instructions += other.instructions;
+    llcMisses += other.llcMisses;
+    branchMisses += other.branchMisses;
+    return *this;
+  }
+
+  //! Get the counts between the given (earlier) values and these.
+  PerfCounterValues operator-(const PerfCounterValues& other) const
+  {
+    PerfCounterValues result;
+    result.cycles = cycles - other.cycles;
+    result.instructions = instructions - other.instructions;
+    result.llcMisses = llcMisses - other.llcMisses;
+    result.branchMisses = branchMisses - other.branchMisses;
+    return result;
+  }
+};
+
+/**
+ * PerfCounters reads the hardware counters of the calling thread.  The
+ * counters are only compiled in with MLPACK_PERF_COUNTERS defined (the CMake
+ * option PERF_COUNTERS, on Linux), and are opened the first time a thread
+ * reads them; if the kernel refuses to open them (for instance because of
+ * /proc/sys/kernel/perf_event_paranoid, or inside a virtual machine without a
+ * PMU), Available() returns false for that thread and Read() returns zeros.
+ *
+ * Only user-space events of the calling thread are counted, so work that is
+ * handed to other threads (for instance OpenMP worker threads) is not
+ * included.
+ */
+class PerfCounters
+{
+ public:
+  //! Return whether the counters can be read on the calling thread.
+  static bool Available();
+
+  //! Read the counters of the calling thread (zeros if not available).
+  static PerfCounterValues Read();
+};
+
+} // namespace mlpack
+
+#endif
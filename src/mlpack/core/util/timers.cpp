@@ -15,6 +15,7 @@
 #include "io.hpp"
 #include "log.hpp"
 
+#include <algorithm>
 #include <map>
 #include <string>
 
@@ -46,6 +47,22 @@ microseconds Timer::Get(const string& name)
   return IO::GetSingleton().timer.GetTimer(name);
 }
 
+/**
+ * Get the hardware counters of the given timer, summing over all threads.
+ */
+PerfCounterValues Timer::GetCounters(const string& name)
+{
+  return IO::GetSingleton().timer.GetCounters(name);
+}
+
+/**
+ * Get the memory statistics of the given timer.
+ */
+MemoryStats Timer::GetMemory(const string& name)
+{
+  return IO::GetSingleton().timer.GetMemory(name);
+}
+
 // Enable timing.
 void Timer::EnableTiming()
 {
@@ -70,6 +87,10 @@ void Timers::Reset()
   lock_guard<mutex> lock(timersMutex);
   timers.clear();
   timerStartTime.clear();
+  counters.clear();
+  counterStartValues.clear();
+  memory.clear();
+  memoryStartValues.clear();
 }
 
 map<string, microseconds> Timers::GetAllTimers()
@@ -88,6 +109,87 @@ microseconds Timers::GetTimer(const string& timerName)
   return timers[timerName];
 }
 
+map<string, PerfCounterValues> Timers::GetAllCounters()
+{
+  lock_guard<mutex> lock(timersMutex);
+  return counters;
+}
+
+PerfCounterValues Timers::GetCounters(const string& timerName)
+{
+  if (!enabled)
+    return PerfCounterValues();
+
+  lock_guard<mutex> lock(timersMutex);
+  map<string, PerfCounterValues>::const_iterator it = counters.find(timerName);
+  return (it == counters.end()) ? PerfCounterValues() : it->second;
+}
+
+void Timers::PrintCounters(const string& timerName)
+{
+  {
+    lock_guard<mutex> lock(timersMutex);
+    if (counters.count(timerName) == 0)
+      return;
+  }
+
+  // Format the line first, so that the precision of Log::Info isn't changed.
+  const PerfCounterValues values = GetCounters(timerName);
+  ostringstream oss;
+  oss << "cycles: " << values.cycles << ", instructions: "
+      << values.instructions << " (IPC " << fixed << setprecision(2)
+      << values.IPC() << "), LLC misses: " << values.llcMisses
+      << ", branch misses: " << values.branchMisses;
+  Log::Info << "    " << oss.str() << endl;
+}
+
+map<string, MemoryStats> Timers::GetAllMemory()
+{
+  lock_guard<mutex> lock(timersMutex);
+  return memory;
+}
+
+MemoryStats Timers::GetMemory(const string& timerName)
+{
+  if (!enabled)
+    return MemoryStats();
+
+  lock_guard<mutex> lock(timersMutex);
+  map<string, MemoryStats>::const_iterator it = memory.find(timerName);
+  return (it == memory.end()) ? MemoryStats() : it->second;
+}
+
+void Timers::PrintMemory(const string& timerName)
+{
+  {
+    lock_guard<mutex> lock(timersMutex);
+    if (memory.count(timerName) == 0)
+      return;
+  }
+
+  const MemoryStats stats = GetMemory(timerName);
+  Log::Info << "    allocations: " << stats.allocations << " ("
+      << stats.allocatedBytes << " bytes), peak heap growth: "
+      << stats.peakBytes << " bytes, peak resident: " << stats.peakResident
+      << " bytes" << endl;
+}
+
+void Timers::FoldMemoryPeak()
+{
+  if (memoryStartValues.empty())
+    return;
+
+  const int64_t peak = MemoryTracker::TakePeak();
+  for (auto& it : memoryStartValues)
+  {
+    for (auto& it2 : it.second)
+    {
+      if (peak > it2.second.peakBytes)
+        it2.second.peakBytes = peak;
+    }
+  }
+}
+
 bool Timers::GetState(const string& timerName,
                       const thread::id& threadId)
 {
@@ -157,6 +259,56 @@ void Timers::PrintTimer(const string& timerName)
   Log::Info << endl;
 }
 
+void Timers::WriteJSON(ostream& stream)
+{
+  const map<string, microseconds> allTimers = GetAllTimers();
+  const map<string, PerfCounterValues> allCounters = GetAllCounters();
+  const map<string, MemoryStats> allMemory = GetAllMemory();
+
+  stream << "{";
+  bool first = true;
+  for (auto& it : allTimers)
+  {
+    // Timer names are identifiers, but escape them anyway.
+    string name;
+    for (const char c : it.first)
+    {
+      if (c == '"' || c == '\\')
+        name += '\\';
+      name += c;
+    }
+
+    // Format the time first, so that the precision of the stream isn't changed.
+    ostringstream totalTime;
+    totalTime << fixed << setprecision(6) << it.second.count() / 1e6;
+    stream << (first ? "\n" : ",\n") << "  \"" << name << "\": { \"seconds\": "
+        << totalTime.str();
+    first = false;
+
+    auto countersIt = allCounters.find(it.first);
+    if (countersIt != allCounters.end())
+    {
+      const PerfCounterValues& values = countersIt->second;
+      stream << ", \"cycles\": " << values.cycles << ", \"instructions\": "
+          << values.instructions << ", \"llc_misses\": " << values.llcMisses
+          << ", \"branch_misses\": " << values.branchMisses;
+    }
+
+    auto memoryIt = allMemory.find(it.first);
+    if (memoryIt != allMemory.end())
+    {
+      const MemoryStats& stats = memoryIt->second;
+      stream << ", \"allocations\": " << stats.allocations
+          << ", \"allocated_bytes\": " << stats.allocatedBytes
+          << ", \"peak_bytes\": " << stats.peakBytes
+          << ", \"peak_resident\": " << stats.peakResident;
+    }
+
+    stream << " }";
+  }
+  stream << (first ? "}" : "\n}") << endl;
+}
+
 void Timers::StopAllTimers()
 {
   // Terminate the program timers.  Don't use StopTimer() since that modifies
@@ -168,8 +320,34 @@ void Timers::StopAllTimers()
     for (auto it2 : it.second)
       timers[it2.first] += duration_cast<microseconds>(currTime - it2.second);
 
+  // The hardware counters can only be read for the calling thread.
+  if (counterStartValues.count(this_thread::get_id()) > 0)
+  {
+    const PerfCounterValues currValues = PerfCounters::Read();
+    for (auto it : counterStartValues[this_thread::get_id()])
+      counters[it.first] += currValues - it.second;
+  }
+
+  FoldMemoryPeak();
+  for (auto it : memoryStartValues)
+  {
+    for (auto it2 : it.second)
+    {
+      MemoryStats& stats = memory[it2.first];
+      stats.allocations += MemoryTracker::Allocations() -
+          it2.second.allocations;
+      stats.allocatedBytes += MemoryTracker::AllocatedBytes() -
+          it2.second.allocatedBytes;
+      stats.peakBytes = std::max(stats.peakBytes,
+          it2.second.peakBytes - it2.second.liveBytes);
+      stats.peakResident = MemoryTracker::PeakResident();
+    }
+  }
+
   // If all timers are stopped, we can clear the maps.
   timerStartTime.clear();
+  counterStartValues.clear();
+  memoryStartValues.clear();
 }
 
 void Timers::StartTimer(const string& timerName,
@@ -199,6 +377,30 @@ void Timers::StartTimer(const string& timerName,
   }
 
   timerStartTime[threadId][timerName] = currTime;
+
+  // Allocations are counted for the whole process, so the memory state is
+  // recorded for every timer.
+  if (MemoryTracker::Enabled())
+  {
+    FoldMemoryPeak();
+    if (memory.count(timerName) == 0)
+      memory[timerName] = MemoryStats();
+
+    MemoryStart& start = memoryStartValues[threadId][timerName];
+    start.allocations = MemoryTracker::Allocations();
+    start.allocatedBytes = MemoryTracker::AllocatedBytes();
+    start.liveBytes = MemoryTracker::LiveBytes();
+    start.peakBytes = start.liveBytes;
+  }
+
+  // The hardware counters belong to the calling thread, so they are only
+  // collected when the timer is started from it.
+  if (threadId == this_thread::get_id() && PerfCounters::Available())
+  {
+    if (counters.count(timerName) == 0)
+      counters[timerName] = PerfCounterValues();
+    counterStartValues[threadId][timerName] = PerfCounters::Read();
+  }
 }
 
 void Timers::StopTimer(const string& timerName,
@@ -208,6 +410,10 @@ void Timers::StopTimer(const string& timerName,
   if (!enabled)
     return;
 
+  // Read the counters before taking the lock, so that waiting for it isn't
+  // counted.
+  const PerfCounterValues currValues = PerfCounters::Read();
+
   lock_guard<mutex> lock(timersMutex);
 
   if ((timerStartTime.count(threadId) == 0) ||
@@ -229,4 +435,31 @@ void Timers::StopTimer(const string& timerName,
   timerStartTime[threadId].erase(timerName);
   if (timerStartTime[threadId].empty())
     timerStartTime.erase(threadId);
+
+  if ((counterStartValues.count(threadId) > 0) &&
+      (counterStartValues[threadId].count(timerName) > 0))
+  {
+    counters[timerName] += currValues - counterStartValues[threadId][timerName];
+    counterStartValues[threadId].erase(timerName);
+    if (counterStartValues[threadId].empty())
+      counterStartValues.erase(threadId);
+  }
+
+  if ((memoryStartValues.count(threadId) > 0) &&
+      (memoryStartValues[threadId].count(timerName) > 0))
+  {
+    FoldMemoryPeak();
+    const MemoryStart& start = memoryStartValues[threadId][timerName];
+    MemoryStats& stats = memory[timerName];
+    stats.allocations += MemoryTracker::Allocations() - start.allocations;
+    stats.allocatedBytes += MemoryTracker::AllocatedBytes() -
+        start.allocatedBytes;
+    stats.peakBytes = std::max(stats.peakBytes,
+        start.peakBytes - start.liveBytes);
+    stats.peakResident = MemoryTracker::PeakResident();
+
+    memoryStartValues[threadId].erase(timerName);
+    if (memoryStartValues[threadId].empty())
+      memoryStartValues.erase(threadId);
+  }
 }
@@ -23,6 +23,9 @@
 #include <string>
 #include <thread> // std::thread is used for thread safety.
 
+#include "memory_tracker.hpp"
+#include "perf_counters.hpp"
+
 #if defined(_WIN32)
   // uint64_t isn't defined on every windows.
   #if !defined(HAVE_UINT64_T)
@@ -76,6 +79,23 @@ class Timer
    */
   static std::chrono::microseconds Get(const std::string& name);
 
+  /**
+   * Get the hardware counters collected by the given timer (see
+   * PerfCounters).  They are all zero unless mlpack was compiled with
+   * MLPACK_PERF_COUNTERS and the counters could be opened.
+   *
+   * @param name Name of timer to return the counters of.
+   */
+  static PerfCounterValues GetCounters(const std::string& name);
+
+  /**
+   * Get the memory used by the given timer (see MemoryTracker).  The values
+   * are all zero unless mlpack was compiled with MLPACK_MEMORY_TRACKING.
+   *
+   * @param name Name of timer to return the memory statistics of.
+   */
+  static MemoryStats GetMemory(const std::string& name);
+
   /**
    * Enable timing of mlpack programs.  Do not run this while timers are
    * running!
@@ -120,6 +140,49 @@ class Timers
    */
   std::chrono::microseconds GetTimer(const std::string& timerName);
 
+  /**
+   * Returns a copy of the hardware counters of all the timers that collected
+   * any.
+   */
+  std::map<std::string, PerfCounterValues> GetAllCounters();
+
+  /**
+   * Returns the hardware counters collected by the timer specified, summed
+   * over the runs of the timer that have been stopped.
+   *
+   * @param timerName The name of the timer in question.
+   */
+  PerfCounterValues GetCounters(const std::string& timerName);
+
+  /**
+   * Prints the hardware counters of the specified timer, if it collected any.
+   *
+   * @param timerName The name of the timer in question.
+   */
+  void PrintCounters(const std::string& timerName);
+
+  /**
+   * Returns a copy of the memory statistics of all the timers that collected
+   * any.
+   */
+  std::map<std::string, MemoryStats> GetAllMemory();
+
+  /**
+   * Returns the memory statistics of the timer specified: the allocations are
+   * summed over the runs of the timer that have been stopped, and the peaks are
+   * the largest of those runs.
+   *
+   * @param timerName The name of the timer in question.
+   */
+  MemoryStats GetMemory(const std::string& timerName);
+
+  /**
+   * Prints the memory statistics of the specified timer, if it collected any.
+   *
+   * @param timerName The name of the timer in question.
+   */
+  void PrintMemory(const std::string& timerName);
+
   /**
    * Prints the specified timer.  If it took longer than a minute to complete
    * the timer will be displayed in days, hours, and minutes as well.
@@ -128,6 +191,17 @@ class Timers
    */
   void PrintTimer(const std::string& timerName);
 
+  /**
+   * Writes all the timers as one JSON object to the given stream.  Each timer
+   * name maps to an object with the total time in seconds ("seconds") and, if
+   * they were collected, the hardware counters ("cycles", "instructions",
+   * "llc_misses", "branch_misses") and the memory statistics ("allocations",
+   * "allocated_bytes", "peak_bytes", "peak_resident").
+   *
+   * @param stream Stream to write the timers to.
+   */
+  void WriteJSON(std::ostream& stream);
+
   /**
    * Initializes a timer, available like a normal value specified on
    * the command line.  Timers are of type timeval.  If a timer is started, then
@@ -169,6 +243,23 @@ class Timers
   bool Enabled() const { return enabled; }
 
  private:
+  //! The memory state at the start of a run of a timer.
+  struct MemoryStart
+  {
+    //! The number of allocations.
+    uint64_t allocations;
+    //! The number of bytes allocated.
+    uint64_t allocatedBytes;
+    //! The live bytes.
+    int64_t liveBytes;
+    //! The peak of the live bytes during the run so far.
+    int64_t peakBytes;
+  };
+
+  //! Fold the peak of the live bytes since the last start or stop of a timer
+  //! into all the running timers.  timersMutex must be held.
+  void FoldMemoryPeak();
+
   //! A map of all the timers that are being tracked.
   std::map<std::string, std::chrono::microseconds> timers;
   //! A mutex for modifying the timers.
@@ -176,6 +267,16 @@ class Timers
   //! A map for the starting values of the timers.
   std::map<std::thread::id, std::map<std::string,
       std::chrono::high_resolution_clock::time_point>> timerStartTime;
+  //! A map of the hardware counters of the timers.
+  std::map<std::string, PerfCounterValues> counters;
+  //! A map for the starting values of the hardware counters of the timers.
+  std::map<std::thread::id, std::map<std::string, PerfCounterValues>>
+      counterStartValues;
+  //! A map of the memory statistics of the timers.
+  std::map<std::string, MemoryStats> memory;
+  //! A map for the memory state at the start of the running timers.
+  std::map<std::thread::id, std::map<std::string, MemoryStart>>
+      memoryStartValues;
 
   //! Whether or not timing is enabled.
   std::atomic<bool> enabled;
@@ -0,0 +1,252 @@
+/**
+ * @file core/util/trace.cpp
+ *
+ * Implementation of the Trace class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "trace.hpp"
+
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+using namespace mlpack;
+using namespace std;
+using namespace chrono;
+
+namespace {
+
+//! The regions entered and recorded by one thread.  Only the owning thread
+//! modifies it.
+struct ThreadData
+{
+  //! A region that has been entered but not left yet.
+  struct OpenRegion
+  {
+    size_t id;
+    steady_clock::time_point start;
+  };
+
+  //! A recorded region.
+  struct Event
+  {
+    size_t id;
+    nanoseconds start;
+    nanoseconds duration;
+  };
+
+  //! The total time spent in each region, indexed by region id.
+  vector<nanoseconds> times;
+  //! The number of times each region was entered, indexed by region id.
+  vector<size_t> counts;
+  //! The regions that have been entered but not left yet.
+  vector<OpenRegion> stack;
+  //! The recorded regions.
+  vector<Event> events;
+};
+
+//! The state shared by all threads.
+struct TraceRegistry
+{
+  TraceRegistry() : origin(steady_clock::now()) { }
+
+  //! Protects the names and the list of threads.
+  mutex registryMutex;
+  //! The name of each region, indexed by region id.
+  vector<string> names;
+  //! The id of each region name.
+  unordered_map<string, size_t> ids;
+  //! The data of each thread that entered a region.  The data is kept after
+  //! the thread exits, so that it can still be reported.
+  vector<unique_ptr<ThreadData>> threads;
+  //! The time that event start times are relative to.
+  steady_clock::time_point origin;
+};
+
+TraceRegistry& Registry()
+{
+  static TraceRegistry registry;
+  return registry;
+}
+
+ThreadData& LocalData()
+{
+  thread_local ThreadData* data = nullptr;
+  if (!data)
+  {
+    TraceRegistry& registry = Registry();
+    lock_guard<mutex> lock(registry.registryMutex);
+    registry.threads.emplace_back(new ThreadData());
+    data = registry.threads.back().get();
+  }
+
+  return *data;
+}
+
+//! Write the given string as a JSON string.
+void WriteJSONString(ostream& stream, const string& str)
+{
+  stream << '"';
+  for (const char c : str)
+  {
+    if (c == '"' || c == '\\')
+      stream << '\\' << c;
+    else if ((unsigned char) c < 0x20)
+      stream << ' ';
+    else
+      stream << c;
+  }
+  stream << '"';
+}
+
+} // namespace
+
+atomic<bool> Trace::enabled(false);
+atomic<size_t> Trace::maxEvents(1 << 20);
+
+void Trace::Enable()
+{
+  enabled = true;
+}
+
+void Trace::Disable()
+{
+  enabled = false;
+}
+
+size_t Trace::Register(const string& name)
+{
+  TraceRegistry& registry = Registry();
+  lock_guard<mutex> lock(registry.registryMutex);
+  auto it = registry.ids.find(name);
+  if (it != registry.ids.end())
+    return it->second;
+
+  registry.names.push_back(name);
+  registry.ids[name] = registry.names.size() - 1;
+  return registry.names.size() - 1;
+}
+
+void Trace::Begin(const size_t id)
+{
+  ThreadData& data = LocalData();
+  data.stack.push_back({ id, steady_clock::now() });
+}
+
+void Trace::End()
+{
+  const steady_clock::time_point end = steady_clock::now();
+  ThreadData& data = LocalData();
+  // The region may have been removed by Reset().
+  if (data.stack.empty())
+    return;
+
+  const ThreadData::OpenRegion region = data.stack.back();
+  data.stack.pop_back();
+
+  if (data.times.size() <= region.id)
+  {
+    data.times.resize(region.id + 1, nanoseconds(0));
+    data.counts.resize(region.id + 1, 0);
+  }
+
+  const nanoseconds duration = duration_cast<nanoseconds>(end - region.start);
+  data.times[region.id] += duration;
+  ++data.counts[region.id];
+
+  if (data.events.size() < maxEvents.load(memory_order_relaxed))
+  {
+    data.events.push_back({ region.id, duration_cast<nanoseconds>(
+        region.start - Registry().origin), duration });
+  }
+}
+
+map<string, Trace::RegionTotal> Trace::Totals()
+{
+  map<string, RegionTotal> totals;
+  for (const map<string, RegionTotal>& threadTotals : ThreadTotals())
+  {
+    for (const auto& total : threadTotals)
+    {
+      // New entries are value-initialized to zero.
+      RegionTotal& sum = totals[total.first];
+      sum.time += total.second.time;
+      sum.count += total.second.count;
+    }
+  }
+
+  return totals;
+}
+
+vector<map<string, Trace::RegionTotal>> Trace::ThreadTotals()
+{
+  TraceRegistry& registry = Registry();
+  lock_guard<mutex> lock(registry.registryMutex);
+
+  vector<map<string, RegionTotal>> totals(registry.threads.size());
+  for (size_t t = 0; t < registry.threads.size(); ++t)
+  {
+    const ThreadData& data = *registry.threads[t];
+    for (size_t id = 0; id < data.counts.size(); ++id)
+    {
+      if (data.counts[id] > 0)
+        totals[t][registry.names[id]] = { data.times[id], data.counts[id] };
+    }
+  }
+
+  return totals;
+}
+
+void Trace::ExportChromeTrace(ostream& stream)
+{
+  TraceRegistry& registry = Registry();
+  lock_guard<mutex> lock(registry.registryMutex);
+
+  // Keep nanosecond precision.
+  const ios::fmtflags flags = stream.flags();
+  const streamsize precision = stream.precision();
+  stream << fixed << setprecision(3);
+
+  stream << "{\"traceEvents\":[";
+  bool first = true;
+  for (size_t t = 0; t < registry.threads.size(); ++t)
+  {
+    for (const ThreadData::Event& event : registry.threads[t]->events)
+    {
+      if (!first)
+        stream << ",";
+      first = false;
+
+      // Chrome trace times are in microseconds.
+      stream << "\n{\"name\":";
+      WriteJSONString(stream, registry.names[event.id]);
+      stream << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << t << ",\"ts\":"
+          << (event.start.count() / 1000.0) << ",\"dur\":"
+          << (event.duration.count() / 1000.0) << "}";
+    }
+  }
+  stream << "\n],\"displayTimeUnit\":\"ns\"}" << endl;
+
+  stream.flags(flags);
+  stream.precision(precision);
+}
+
+void Trace::Reset()
+{
+  TraceRegistry& registry = Registry();
+  lock_guard<mutex> lock(registry.registryMutex);
+  for (unique_ptr<ThreadData>& data : registry.threads)
+  {
+    data->times.clear();
+    data->counts.clear();
+    data->stack.clear();
+    data->events.clear();
+  }
+
+  registry.origin = steady_clock::now();
+}
@@ -0,0 +1,178 @@
+/**
+ * @file core/util/trace.hpp
+ *
+ * Low-overhead scoped tracing of code regions, with per-thread totals and
+ * export to the Chrome trace format.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTILITIES_TRACE_HPP
+#define MLPACK_CORE_UTILITIES_TRACE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace mlpack {
+
+/**
+ * Trace records the time spent in regions of code that are cheap enough to be
+ * timed in inner loops, unlike Timer, which takes a global lock and looks up a
+ * std::map on every call.  A region is marked with MLPACK_TRACE_SCOPE(), which
+ * registers the name of the region once per call site and times the enclosing
+ * scope:
+ *
+ * @code
+ * void Traverse(...)
+ * {
+ *   MLPACK_TRACE_SCOPE("dual_tree_traversal");
+ *   ...
+ * }
+ * @endcode
+ *
+ * When tracing is disabled (the default), a region costs a single atomic load.
+ * When it is enabled, each thread adds the duration of each region to its own
+ * totals, without any lock, and records each region as an event with its
+ * start time and nesting depth (up to MaxEvents() events per thread), so that
+ * nested regions can be seen in a trace viewer.
+ *
+ * The results should be read with Totals(), ThreadTotals() or
+ * ExportChromeTrace() once the traced code has finished running.
+ */
+class Trace
+{
+ public:
+  //! Totals of a region.
+  struct RegionTotal
+  {
+    //! Total time spent in the region, including nested regions.
+    std::chrono::nanoseconds time;
+    //! Number of times the region was entered.
+    size_t count;
+  };
+
+  //! Start tracing.
+  static void Enable();
+
+  //! Stop tracing; regions that are running will not be recorded.
+  static void Disable();
+
+  //! Return whether tracing is enabled.
+  static bool Enabled()
+  {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Register a region with the given name and return its id.  Registering the
+   * same name twice returns the same id.  This takes a lock, so it should be
+   * called once per call site (which MLPACK_TRACE_SCOPE() does).
+   *
+   * @param name Name of the region.
+   */
+  static size_t Register(const std::string& name);
+
+  /**
+   * Enter the region with the given id on the calling thread.  Regions must be
+   * left in the reverse order they are entered; TraceScope does that.
+   *
+   * @param id Id of the region, as returned by Register().
+   */
+  static void Begin(const size_t id);
+
+  //! Leave the last region entered on the calling thread.
+  static void End();
+
+  /**
+   * Get the totals of each region, summed over all threads.
+   */
+  static std::map<std::string, RegionTotal> Totals();
+
+  /**
+   * Get the totals of each region for each thread that entered a region, in
+   * the order the threads first entered a region.
+   */
+  static std::vector<std::map<std::string, RegionTotal>> ThreadTotals();
+
+  /**
+   * Write the recorded events in the Chrome trace (JSON) format, which can be
+   * opened with chrome://tracing or Perfetto.  Each thread is shown as a
+   * separate track.
+   *
+   * @param stream Stream to write the trace to.
+   */
+  static void ExportChromeTrace(std::ostream& stream);
+
+  /**
+   * Remove all recorded totals and events.  Registered regions are kept.  Do
+   * not call this while regions are running.
+   */
+  static void Reset();
+
+  //! Get the maximum number of events recorded for each thread.
+  static size_t MaxEvents() { return maxEvents; }
+  //! Modify the maximum number of events recorded for each thread.  Regions
+  //! are still added to the totals once this is reached.
+  static void MaxEvents(const size_t max) { maxEvents = max; }
+
+ private:
+  //! Whether tracing is enabled.
+  static std::atomic<bool> enabled;
+
+  //! The maximum number of events recorded for each thread.
+  static std::atomic<size_t> maxEvents;
+};
+
+/**
+ * Enter a region when created and leave it when destroyed, if tracing is
+ * enabled when the object is created.  Use MLPACK_TRACE_SCOPE() instead of
+ * this class directly.
+ */
+class TraceScope
+{
+ public:
+  //! Enter the region with the given id.
+  TraceScope(const size_t id) : active(Trace::Enabled())
+  {
+    if (active)
+      Trace::Begin(id);
+  }
+
+  //! Leave the region.
+  ~TraceScope()
+  {
+    if (active)
+      Trace::End();
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+ private:
+  //! Whether the region was entered.
+  bool active;
+};
+
+} // namespace mlpack
+
+#define MLPACK_TRACE_CONCAT_INNER(a, b) a ## b
+#define MLPACK_TRACE_CONCAT(a, b) MLPACK_TRACE_CONCAT_INNER(a, b)
+
+/**
+ * Time the enclosing scope as a region with the given name, which should be a
+ * string literal.
+ */
+#define MLPACK_TRACE_SCOPE(name) \
+    static const size_t MLPACK_TRACE_CONCAT(mlpackTraceId, __LINE__) = \
+        ::mlpack::Trace::Register(name); \
+    ::mlpack::TraceScope MLPACK_TRACE_CONCAT(mlpackTraceScope, __LINE__)( \
+        MLPACK_TRACE_CONCAT(mlpackTraceId, __LINE__))
+
+#endif // MLPACK_CORE_UTILITIES_TRACE_HPP
@@ -70,6 +70,9 @@ namespace adaboost {
  * void Classify(const MatType& data, arma::Row<size_t>& predictedLabels);
  * @endcode
  *
+ * Classify() of a weak learner must not modify it, because AdaBoost classifies
+ * blocks of points with the same weak learner on several threads at once.
+ *
  * For more information on and examples of weak learners, see
  * perceptron::Perceptron<> and tree::ID3DecisionStump.
  *
@@ -151,17 +154,22 @@ class AdaBoost
                const double tolerance = 1e-6);
 
   /**
-   * Classify the given test points.
+   * Classify the given test points.  Only the first numWeakLearners weak
+   * learners may be used, for instance to meet a latency budget; with a
+   * cereal::EnsembleLoadLimit, only these weak learners need to be loaded.
    *
    * @param test Testing data.
    * @param predictedLabels Vector in which the predicted labels of the test
    *      set will be stored.
    * @param probabilities matrix to store the predicted class probabilities for
    *      each point in the test set.
+   * @param numWeakLearners Number of weak learners to use (the first ones); 0
+   *      (the default) or more than WeakLearners() means all weak learners.
    */
   void Classify(const MatType& test,
                 arma::Row<size_t>& predictedLabels,
-                arma::mat& probabilities);
+                arma::mat& probabilities,
+                const size_t numWeakLearners = 0);
 
   /**
    * Classify the given test points.
@@ -169,15 +177,19 @@ class AdaBoost
    * @param test Testing data.
    * @param predictedLabels Vector in which the predicted labels of the test
    *      set will be stored.
+   * @param numWeakLearners Number of weak learners to use (the first ones); 0
+   *      (the default) or more than WeakLearners() means all weak learners.
    */
   void Classify(const MatType& test,
-                arma::Row<size_t>& predictedLabels);
+                arma::Row<size_t>& predictedLabels,
+                const size_t numWeakLearners = 0);
 
   /**
-   * Serialize the AdaBoost model.
+   * Serialize the AdaBoost model.  While a cereal::EnsembleLoadLimit exists,
+   * only the first weak learners are loaded.
    */
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */);
+  void serialize(Archive& ar, const uint32_t version);
 
  private:
   //! The number of classes in the model.
@@ -189,6 +201,9 @@ class AdaBoost
   std::vector<WeakLearnerType> wl;
   //! The weights corresponding to each weak learner.
   std::vector<double> alpha;
+
+  //! The number of points classified by all the weak learners at once.
+  static const size_t ClassifyBlockSize = 4096;
 }; // class AdaBoost
 
 } // namespace adaboost
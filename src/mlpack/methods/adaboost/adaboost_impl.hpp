@@ -87,9 +87,6 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
   // To be used for prediction by the weak learner.
   arma::Row<size_t> predictedLabels(labels.n_cols);
 
-  // Use tempData to modify input data for incorporating weights.
-  MatType tempData(data);
-
   // This matrix is a helper matrix used to calculate the final hypothesis.
   arma::mat sumFinalH = arma::zeros<arma::mat>(numClasses,
       predictedLabels.n_cols);
@@ -102,9 +99,6 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
   // Weights are stored in this row vector.
   arma::rowvec weights(predictedLabels.n_cols);
 
-  // This is the final hypothesis.
-  arma::Row<size_t> finalH(predictedLabels.n_cols);
-
   // Now, start the boosting rounds.
   for (size_t i = 0; i < iterations; ++i)
   {
@@ -120,14 +114,16 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     weights = arma::sum(D);
 
     // Use the existing weak learner to train a new one with new weights.
-    WeakLearnerType w(other, tempData, labels, numClasses, weights);
-    w.Classify(tempData, predictedLabels);
+    WeakLearnerType w(other, data, labels, numClasses, weights);
+    w.Classify(data, predictedLabels);
 
     // Now from predictedLabels, build ht, the weak hypothesis
     // buildClassificationMatrix(ht, predictedLabels);
 
-    // Now, calculate alpha(t) using ht.
-    for (size_t j = 0; j < D.n_cols; ++j) // instead of D, ht
+    // Now, calculate alpha(t) using ht.  Each point only touches its own
+    // column of D, so the points are split between threads.
+    #pragma omp parallel for reduction(+: rt)
+    for (omp_size_t j = 0; j < (omp_size_t) D.n_cols; ++j) // instead of D, ht
     {
       if (predictedLabels(j) == labels(j))
         rt += arma::accu(D.col(j));
@@ -157,9 +153,10 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     wl.push_back(w);
 
     // Now start modifying the weights.
-    for (size_t j = 0; j < D.n_cols; ++j)
+    const double expo = exp(alphat);
+    #pragma omp parallel for reduction(+: zt)
+    for (omp_size_t j = 0; j < (omp_size_t) D.n_cols; ++j)
     {
-      const double expo = exp(alphat);
       if (predictedLabels(j) == labels(j))
       {
         for (size_t k = 0; k < D.n_rows; ++k)
@@ -208,12 +205,13 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
 template<typename WeakLearnerType, typename MatType>
 void AdaBoost<WeakLearnerType, MatType>::Classify(
     const MatType& test,
-    arma::Row<size_t>& predictedLabels)
+    arma::Row<size_t>& predictedLabels,
+    const size_t numWeakLearners)
 {
   arma::Row<size_t> tempPredictedLabels(test.n_cols);
   arma::mat probabilities;
 
-  Classify(test, predictedLabels, probabilities);
+  Classify(test, predictedLabels, probabilities, numWeakLearners);
 }
 
 /**
@@ -223,30 +221,44 @@ template<typename WeakLearnerType, typename MatType>
 void AdaBoost<WeakLearnerType, MatType>::Classify(
     const MatType& test,
     arma::Row<size_t>& predictedLabels,
-    arma::mat& probabilities)
+    arma::mat& probabilities,
+    const size_t numWeakLearners)
 {
-  arma::Row<size_t> tempPredictedLabels(test.n_cols);
-
   probabilities.zeros(numClasses, test.n_cols);
   predictedLabels.set_size(test.n_cols);
 
-  for (size_t i = 0; i < wl.size(); ++i)
+  const size_t usedWeakLearners = (numWeakLearners == 0) ? wl.size() :
+      std::min(numWeakLearners, wl.size());
+
+  // The points are classified in blocks, each of which goes through all the
+  // weak learners while its probabilities are still in cache; the blocks are
+  // split between threads.
+  const size_t numBlocks = (test.n_cols + ClassifyBlockSize - 1) /
+      ClassifyBlockSize;
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
   {
-    wl[i].Classify(test, tempPredictedLabels);
+    const size_t begin = b * ClassifyBlockSize;
+    const size_t end = std::min(begin + ClassifyBlockSize,
+        (size_t) test.n_cols);
+    const MatType block = test.cols(begin, end - 1);
+    arma::Row<size_t> tempPredictedLabels(block.n_cols);
 
-    for (size_t j = 0; j < tempPredictedLabels.n_cols; ++j)
-      probabilities(tempPredictedLabels(j), j) += alpha[i];
-  }
+    for (size_t i = 0; i < usedWeakLearners; ++i)
+    {
+      wl[i].Classify(block, tempPredictedLabels);
 
-  arma::colvec pRow;
-  arma::uword maxIndex = 0;
+      for (size_t j = 0; j < tempPredictedLabels.n_cols; ++j)
+        probabilities(tempPredictedLabels(j), begin + j) += alpha[i];
+    }
 
-  for (size_t i = 0; i < predictedLabels.n_cols; ++i)
-  {
-    probabilities.col(i) /= arma::accu(probabilities.col(i));
-    pRow = probabilities.unsafe_col(i);
-    pRow.max(maxIndex);
-    predictedLabels(i) = maxIndex;
+    arma::uword maxIndex = 0;
+    for (size_t j = begin; j < end; ++j)
+    {
+      probabilities.col(j) /= arma::accu(probabilities.col(j));
+      probabilities.unsafe_col(j).max(maxIndex);
+      predictedLabels(j) = maxIndex;
+    }
   }
 }
 
@@ -256,22 +268,42 @@ void AdaBoost<WeakLearnerType, MatType>::Classify(
 template<typename WeakLearnerType, typename MatType>
 template<typename Archive>
 void AdaBoost<WeakLearnerType, MatType>::serialize(Archive& ar,
-                                                   const uint32_t /* version */)
+                                                   const uint32_t version)
 {
   ar(CEREAL_NVP(numClasses));
   ar(CEREAL_NVP(tolerance));
   ar(CEREAL_NVP(alpha));
 
-  // Now serialize each weak learner.
-  if (cereal::is_loading<Archive>())
+  // Now serialize each weak learner.  Since version 1, only the first weak
+  // learners are loaded under a cereal::EnsembleLoadLimit.
+  if (version >= 1)
   {
-    wl.clear();
-    wl.resize(alpha.size());
+    ar(cereal::make_nvp("wl", CEREAL_ENSEMBLE(wl)));
+  }
+  else
+  {
+    if (cereal::is_loading<Archive>())
+    {
+      wl.clear();
+      wl.resize(alpha.size());
+    }
+    ar(CEREAL_NVP(wl));
+
+    if (cereal::is_loading<Archive>() &&
+        wl.size() > cereal::EnsembleLoadLimit::Get())
+      wl.resize(cereal::EnsembleLoadLimit::Get());
   }
-  ar(CEREAL_NVP(wl));
+
+  if (cereal::is_loading<Archive>())
+    alpha.resize(wl.size());
 }
 
 } // namespace adaboost
 } // namespace mlpack
 
+// Set the version of the serialization of all AdaBoost models.
+CEREAL_TEMPLATE_CLASS_VERSION((template<typename WeakLearnerType,
+    typename MatType>), (mlpack::adaboost::AdaBoost<WeakLearnerType, MatType>),
+    (1));
+
 #endif
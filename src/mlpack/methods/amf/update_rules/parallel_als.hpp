@@ -0,0 +1,221 @@
+/**
+ * @file methods/amf/update_rules/parallel_als.hpp
+ *
+ * Update rules for weighted-lambda-regularized alternating least squares, which
+ * only fit the observed (nonzero) entries of a sparse matrix, and solve the
+ * least squares problem of each row and column in parallel.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_AMF_UPDATE_RULES_PARALLEL_ALS_HPP
+#define MLPACK_METHODS_AMF_UPDATE_RULES_PARALLEL_ALS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace amf {
+
+/**
+ * This class implements alternating least squares with weighted-lambda
+ * regularization (ALS-WR), as described in the following paper:
+ *
+ * @code
+ * @inproceedings{zhou2008large,
+ *   title={Large-scale parallel collaborative filtering for the Netflix
+ *       prize},
+ *   author={Zhou, Yunhong and Wilkinson, Dennis and Schreiber, Robert and
+ *       Pan, Rong},
+ *   booktitle={International Conference on Algorithmic Applications in
+ *       Management},
+ *   pages={337--348},
+ *   year={2008}
+ * }
+ * @endcode
+ *
+ * Unlike NMFALSUpdate, only the nonzero entries of V are treated as observed,
+ * so that W * H fits the known entries of a sparse matrix (such as a rating
+ * matrix) instead of also fitting the missing entries as zeros.  With W fixed,
+ * each column h_j of H is the solution of the small rank x rank system
+ *
+ * \f[
+ * (W_j^T W_j + \lambda n_j I) h_j = W_j^T v_j
+ * \f]
+ *
+ * where W_j holds the rows of W for the n_j observed entries v_j of column j;
+ * the rows of W are found the same way with H fixed.  The systems are
+ * independent, so they are solved in parallel with OpenMP.  The columns of V
+ * are read directly from the compressed sparse column storage, and the rows
+ * from a transposed copy made once by Initialize(), so each update costs
+ * O(nnz(V) * rank^2 + (n + m) * rank^3) and never forms a dense n x m matrix.
+ */
+class ParallelALSUpdate
+{
+ public:
+  /**
+   * Create the update rule with the given regularization.
+   *
+   * @param lambda Regularization parameter; the penalty of each row or column
+   *     is scaled by its number of observed entries.
+   */
+  ParallelALSUpdate(const double lambda = 0.05) : lambda(lambda) { }
+
+  /**
+   * Prepare the sparse row access to the given sparse matrix.  This must be
+   * called before a new factorization.
+   *
+   * @param dataset Input matrix to be factorized.
+   * @param * (rank) Rank of the factorization.
+   */
+  void Initialize(const arma::sp_mat& dataset, const size_t /* rank */)
+  {
+    columns.reset();
+    rows = dataset.t();
+  }
+
+  /**
+   * Prepare the sparse row and column access to the given dense matrix, whose
+   * zero entries are treated as missing.  This must be called before a new
+   * factorization.
+   *
+   * @param dataset Input matrix to be factorized.
+   * @param * (rank) Rank of the factorization.
+   */
+  template<typename MatType>
+  void Initialize(const MatType& dataset, const size_t /* rank */)
+  {
+    columns = arma::sp_mat(dataset);
+    rows = columns.t();
+  }
+
+  /**
+   * The update rule for the basis matrix W: each row of W is the regularized
+   * least squares fit of the observed entries of the corresponding row of V.
+   *
+   * @param * (V) Input matrix to be factorized; its rows are read from the
+   *     copy made by Initialize().
+   * @param W Basis matrix to be updated.
+   * @param H Encoding matrix.
+   */
+  template<typename MatType>
+  void WUpdate(const MatType& /* V */, arma::mat& W, const arma::mat& H)
+  {
+    arma::mat wt(W.n_cols, W.n_rows);
+    Solve(rows, arma::mat(H.t()), wt);
+    W = wt.t();
+  }
+
+  /**
+   * The update rule for the encoding matrix H: each column of H is the
+   * regularized least squares fit of the observed entries of the
+   * corresponding column of V.
+   *
+   * @param V Input matrix to be factorized.
+   * @param W Basis matrix.
+   * @param H Encoding matrix to be updated.
+   */
+  void HUpdate(const arma::sp_mat& V, const arma::mat& W, arma::mat& H)
+  {
+    Solve(V, W, H);
+  }
+
+  /**
+   * The update rule for the encoding matrix H, for a dense input matrix; the
+   * columns are read from the sparse copy made by Initialize().
+   *
+   * @param * (V) Input matrix to be factorized.
+   * @param W Basis matrix.
+   * @param H Encoding matrix to be updated.
+   */
+  template<typename MatType>
+  void HUpdate(const MatType& /* V */, const arma::mat& W, arma::mat& H)
+  {
+    Solve(columns, W, H);
+  }
+
+  //! Get the regularization parameter.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization parameter.
+  double& Lambda() { return lambda; }
+
+  //! Serialize the object.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(lambda));
+  }
+
+ private:
+  /**
+   * Solve the regularized least squares problem of each column of the given
+   * sparse matrix, with the given fixed factor, and store the solutions in the
+   * columns of result.
+   *
+   * @param data Sparse matrix whose columns are the subproblems.
+   * @param fixed Fixed factor, with one row for each row of data.
+   * @param result Matrix to store the solutions in (rank x data.n_cols).
+   */
+  void Solve(const arma::sp_mat& data,
+             const arma::mat& fixed,
+             arma::mat& result) const
+  {
+    const size_t rank = fixed.n_cols;
+    result.set_size(rank, data.n_cols);
+    const arma::uvec allColumns = arma::regspace<arma::uvec>(0, rank - 1);
+
+    // Make sure the compressed storage is up to date before it is read from
+    // several threads.
+    data.sync();
+
+    #pragma omp parallel
+    {
+      arma::uvec indices;
+      arma::vec values, solution;
+      arma::mat sub, gram;
+
+      #pragma omp for schedule(dynamic, 64)
+      for (omp_size_t j = 0; j < (omp_size_t) data.n_cols; ++j)
+      {
+        const size_t begin = data.col_ptrs[j];
+        const size_t count = data.col_ptrs[j + 1] - begin;
+        if (count == 0)
+        {
+          // Nothing is known about this column.
+          result.col(j).zeros();
+          continue;
+        }
+
+        indices.set_size(count);
+        values.set_size(count);
+        for (size_t k = 0; k < count; ++k)
+        {
+          indices[k] = data.row_indices[begin + k];
+          values[k] = data.values[begin + k];
+        }
+
+        sub = fixed.submat(indices, allColumns);
+        gram = sub.t() * sub;
+        gram.diag() += lambda * count;
+
+        if (!arma::solve(solution, gram, sub.t() * values))
+          solution = arma::pinv(gram) * (sub.t() * values);
+
+        result.col(j) = solution;
+      }
+    }
+  }
+
+  //! Regularization parameter.
+  double lambda;
+  //! Transpose of the input matrix, for row access.
+  arma::sp_mat rows;
+  //! Sparse copy of a dense input matrix, for column access.
+  arma::sp_mat columns;
+}; // class ParallelALSUpdate
+
+} // namespace amf
+} // namespace mlpack
+
+#endif
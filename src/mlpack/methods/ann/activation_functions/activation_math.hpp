@@ -0,0 +1,94 @@
+/**
+ * @file methods/ann/activation_functions/activation_math.hpp
+ *
+ * Elementwise exponential and hyperbolic tangent used by the activation
+ * functions, with optional fast polynomial approximations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_ACTIVATION_MATH_HPP
+#define MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_ACTIVATION_MATH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <cstring>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Compute e^x with a branch-free approximation: x is reduced to
+ * x = n * ln(2) + r with |r| <= ln(2) / 2, e^r is evaluated with a degree 7
+ * polynomial, and 2^n is built directly from the exponent bits.  The relative
+ * error is below 1e-8 for x in [-708, 709]; inputs outside this range are
+ * clamped to it.  Since there are no branches and no calls into libm, loops
+ * over this function can be vectorized by the compiler.
+ *
+ * @param x Input value.
+ * @return Approximation of e^x.
+ */
+inline double ApproximateExp(double x)
+{
+  x = std::min(std::max(x, -708.0), 709.0);
+
+  // ln(2) is split in two parts so that n * ln2Hi is exact.
+  const double ln2Hi = 6.93145751953125e-1;
+  const double ln2Lo = 1.42860682030941723212e-6;
+  const double n = std::floor(x * 1.4426950408889634 + 0.5);
+  const double r = (x - n * ln2Hi) - n * ln2Lo;
+
+  const double p = 1.0 + r * (1.0 + r * (1.0 / 2 + r * (1.0 / 6 +
+      r * (1.0 / 24 + r * (1.0 / 120 + r * (1.0 / 720 + r * (1.0 / 5040)))))));
+
+  const int64_t bits = (static_cast<int64_t>(n) + 1023) << 52;
+  double scale;
+  std::memcpy(&scale, &bits, sizeof(double));
+  return p * scale;
+}
+
+/**
+ * Compute tanh(x) as 1 - 2 / (e^(2x) + 1), using ApproximateExp().  The
+ * absolute error is below 1e-8.
+ *
+ * @param x Input value.
+ * @return Approximation of tanh(x).
+ */
+inline double ApproximateTanh(const double x)
+{
+  return 1.0 - 2.0 / (ApproximateExp(2.0 * x) + 1.0);
+}
+
+/**
+ * The exponential used by the activation functions.  When mlpack is compiled
+ * with MLPACK_APPROXIMATE_ACTIVATIONS defined (the APPROXIMATE_ACTIVATIONS
+ * CMake option), this is ApproximateExp(); otherwise it is std::exp().
+ */
+inline double ActivationExp(const double x)
+{
+  #ifdef MLPACK_APPROXIMATE_ACTIVATIONS
+  return ApproximateExp(x);
+  #else
+  return std::exp(x);
+  #endif
+}
+
+/**
+ * The hyperbolic tangent used by the activation functions.  When mlpack is
+ * compiled with MLPACK_APPROXIMATE_ACTIVATIONS defined, this is
+ * ApproximateTanh(); otherwise it is std::tanh().
+ */
+inline double ActivationTanh(const double x)
+{
+  #ifdef MLPACK_APPROXIMATE_ACTIVATIONS
+  return ApproximateTanh(x);
+  #else
+  return std::tanh(x);
+  #endif
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
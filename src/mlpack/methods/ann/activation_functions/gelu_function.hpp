@@ -15,6 +15,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "activation_math.hpp"
+
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
 
@@ -39,8 +41,8 @@ class GELUFunction
    */
   static double Fn(const double x)
   {
-    return 0.5 * x * (1 + std::tanh(std::sqrt(2 / M_PI) *
-           (x + 0.044715 * std::pow(x, 3))));
+    return 0.5 * x * (1 + ActivationTanh(std::sqrt(2 / M_PI) *
+           (x + 0.044715 * x * x * x)));
   }
 
   /**
@@ -52,8 +54,10 @@ class GELUFunction
   template<typename InputVecType, typename OutputVecType>
   static void Fn(const InputVecType& x, OutputVecType& y)
   {
-    y = 0.5 * x % (1 + arma::tanh(std::sqrt(2 / M_PI) *
-        (x + 0.044715 * arma::pow(x, 3))));
+    y.set_size(arma::size(x));
+
+    for (size_t i = 0; i < x.n_elem; ++i)
+      y(i) = Fn(x(i));
   }
 
   /**
@@ -64,10 +68,10 @@ class GELUFunction
    */
   static double Deriv(const double y)
   {
-    return 0.5 * std::tanh(0.0356774 * std::pow(y, 3) + 0.797885 * y) +
-           (0.0535161 * std::pow(y, 3) + 0.398942 * y) *
-           std::pow(1 / std::cosh(0.0356774 * std::pow(y, 3) +
-           0.797885 * y), 2) + 0.5;
+    // sech^2(z) = 1 - tanh^2(z), so only one tanh is needed.
+    const double y3 = y * y * y;
+    const double t = ActivationTanh(0.0356774 * y3 + 0.797885 * y);
+    return 0.5 * t + (0.0535161 * y3 + 0.398942 * y) * (1 - t * t) + 0.5;
   }
 
   /**
@@ -79,10 +83,10 @@ class GELUFunction
   template<typename InputVecType, typename OutputVecType>
   static void Deriv(const InputVecType& y, OutputVecType& x)
   {
-    x = 0.5 * arma::tanh(0.0356774 * arma::pow(y, 3) + 0.797885 * y) +
-        (0.0535161 * arma::pow(y, 3) + 0.398942 * y) %
-        arma::pow(1 / arma::cosh(0.0356774 * arma::pow(y, 3) +
-        0.797885 * y), 2) + 0.5;
+    x.set_size(arma::size(y));
+
+    for (size_t i = 0; i < y.n_elem; ++i)
+      x(i) = Deriv(y(i));
   }
 }; // class GELUFunction
 
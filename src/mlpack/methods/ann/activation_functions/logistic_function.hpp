@@ -14,6 +14,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "activation_math.hpp"
+
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
 
@@ -41,7 +43,7 @@ class LogisticFunction
     if (x < arma::Datum<eT>::log_max)
     {
       if (x > -arma::Datum<eT>::log_max)
-        return 1.0 / (1.0 + std::exp(-x));
+        return 1.0 / (1.0 + ActivationExp(-x));
 
       return 0.0;
     }
@@ -58,7 +60,10 @@ class LogisticFunction
   template<typename InputVecType, typename OutputVecType>
   static void Fn(const InputVecType& x, OutputVecType& y)
   {
-    y = (1.0 / (1 + arma::exp(-x)));
+    y.set_size(arma::size(x));
+
+    for (size_t i = 0; i < x.n_elem; ++i)
+      y(i) = 1.0 / (1.0 + ActivationExp(-x(i)));
   }
 
   /**
@@ -24,6 +24,8 @@
 #define MLPACK_METHODS_ANN_ACTIVATION_FUNCTIONS_MISH_FUNCTION_HPP
 
 #include <mlpack/prereqs.hpp>
+
+#include "activation_math.hpp"
 #include <algorithm>
 
 namespace mlpack {
@@ -48,8 +50,8 @@ class MishFunction
    */
   static double Fn(const double x)
   {
-    return x * (std::exp(2 * x) + 2 * std::exp(x)) /
-           (2 + 2 * std::exp(x) + std::exp(2 * x));
+    const double e = ActivationExp(x);
+    return x * (e * e + 2 * e) / (2 + 2 * e + e * e);
   }
 
   /**
@@ -61,8 +63,10 @@ class MishFunction
   template <typename InputVecType, typename OutputVecType>
   static void Fn(const InputVecType &x, OutputVecType &y)
   {
-    y = x % (arma::exp(2 * x) + 2 * arma::exp(x)) /
-        (2 + 2 * arma::exp(x) + arma::exp(2 * x));
+    y.set_size(arma::size(x));
+
+    for (size_t i = 0; i < x.n_elem; ++i)
+      y(i) = Fn(x(i));
   }
 
   /**
@@ -73,9 +77,10 @@ class MishFunction
    */
   static double Deriv(const double y)
   {
-    return std::exp(y) * (4 * (y + 1) + std::exp(y) * (4 * y + 6) +
-           4 * std::exp(2 * y) + std::exp(3 * y)) /
-           std::pow(std::exp(2 * y) + 2 * std::exp(y) + 2, 2);
+    const double e = ActivationExp(y);
+    const double d = e * e + 2 * e + 2;
+    return e * (4 * (y + 1) + e * (4 * y + 6) + 4 * e * e + e * e * e) /
+        (d * d);
   }
 
   /**
@@ -87,9 +92,10 @@ class MishFunction
   template <typename InputVecType, typename OutputVecType>
   static void Deriv(const InputVecType &y, OutputVecType &x)
   {
-    x = arma::exp(y) % (4 * (y + 1) + arma::exp(y) % (4 * y + 6) +
-        4 * arma::exp(2 * y) + arma::exp(3 * y)) /
-        arma::pow(arma::exp(2 * y) + 2 * arma::exp(y) + 2, 2);
+    x.set_size(arma::size(y));
+
+    for (size_t i = 0; i < y.n_elem; ++i)
+      x(i) = Deriv(y(i));
   }
 }; // class MishFunction
 
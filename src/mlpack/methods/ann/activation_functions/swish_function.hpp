@@ -15,6 +15,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "activation_math.hpp"
+
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
 
@@ -38,7 +40,7 @@ class SwishFunction
    */
   static double Fn(const double x)
   {
-    return x / (1.0 + std::exp(-x));
+    return x / (1.0 + ActivationExp(-x));
   }
 
   /**
@@ -50,7 +52,10 @@ class SwishFunction
   template<typename eT>
   static void Fn(const arma::Mat<eT>& x, arma::Mat<eT>& y)
   {
-    y = x / (1.0 + arma::exp(-x));
+    y.set_size(arma::size(x));
+
+    for (size_t i = 0; i < x.n_elem; ++i)
+      y(i) = x(i) / (1.0 + ActivationExp(-x(i)));
   }
 
   /**
@@ -76,8 +81,8 @@ class SwishFunction
    */
   static double Deriv(const double y)
   {
-    return y / (1 + std::exp(-y)) + (1 - y / (1 + std::exp(-y))) /
-                                             (1 + std::exp(-y));
+    const double sigmoid = 1.0 / (1.0 + ActivationExp(-y));
+    return y * sigmoid + (1 - y * sigmoid) * sigmoid;
   }
 
   /**
@@ -89,8 +94,10 @@ class SwishFunction
   template<typename InputVecType, typename OutputVecType>
   static void Deriv(const InputVecType& y, OutputVecType& x)
   {
-    x = y / (1 + arma::exp(-y)) + (1 - y / (1 + arma::exp(-y))) /
-                                           (1 + arma::exp(-y));
+    x.set_size(arma::size(y));
+
+    for (size_t i = 0; i < y.n_elem; ++i)
+      x(i) = Deriv(y(i));
   }
 }; // class SwishFunction
 
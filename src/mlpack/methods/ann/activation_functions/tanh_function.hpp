@@ -14,6 +14,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "activation_math.hpp"
+
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
 
@@ -37,7 +39,7 @@ class TanhFunction
    */
   static double Fn(const double x)
   {
-    return std::tanh(x);
+    return ActivationTanh(x);
   }
 
   /**
@@ -49,7 +51,10 @@ class TanhFunction
   template<typename InputVecType, typename OutputVecType>
   static void Fn(const InputVecType& x, OutputVecType& y)
   {
-    y = arma::tanh(x);
+    y.set_size(arma::size(x));
+
+    for (size_t i = 0; i < x.n_elem; ++i)
+      y(i) = ActivationTanh(x(i));
   }
 
   /**
@@ -60,7 +65,7 @@ class TanhFunction
    */
   static double Deriv(const double y)
   {
-    return 1 - std::pow(y, 2);
+    return 1 - y * y;
   }
 
   /**
@@ -72,7 +77,7 @@ class TanhFunction
   template<typename InputVecType, typename OutputVecType>
   static void Deriv(const InputVecType& y, OutputVecType& x)
   {
-    x = 1 - arma::pow(y, 2);
+    x = 1 - arma::square(y);
   }
 
   /**
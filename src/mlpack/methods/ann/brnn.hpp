@@ -326,6 +326,42 @@ class BRNN
    */
   void ResetDeterministic();
 
+  /**
+   * Forward the given batch of sequences through the RNN of one direction,
+   * saving the output of its last layer at each time step.
+   *
+   * @param direction 0 for the forward RNN, 1 for the backward RNN (which sees
+   *     the sequences in reverse order).
+   * @param sequences Input sequences.
+   * @param begin Index of the first sequence of the batch.
+   * @param batchSize Number of sequences in the batch.
+   * @param results Vector to save the output of the last layer into.
+   * @param outputParameters If not NULL, vector to save the output of every
+   *     layer into, for BPTT.
+   */
+  void ForwardDirection(const size_t direction,
+                        const arma::cube& sequences,
+                        const size_t begin,
+                        const size_t batchSize,
+                        std::vector<arma::mat>& results,
+                        std::vector<arma::mat>* outputParameters);
+
+  /**
+   * Run BPTT through the RNN of one direction, after ForwardDirection() was
+   * called with output parameters, and add its gradient to the given matrix.
+   *
+   * @param direction 0 for the forward RNN, 1 for the backward RNN.
+   * @param begin Index of the first sequence of the batch.
+   * @param batchSize Number of sequences in the batch.
+   * @param allDelta Error of the merge layer at each time step.
+   * @param gradient Gradient of the parameters of the RNN.
+   */
+  void BackwardDirection(const size_t direction,
+                         const size_t begin,
+                         const size_t batchSize,
+                         const std::vector<arma::mat>& allDelta,
+                         arma::mat& gradient);
+
   //! Number of steps to backpropagate through time (BPTT).
   size_t rho;
 
@@ -405,9 +441,6 @@ class BRNN
   //! The current gradient for the gradient pass for backward RNN.
   arma::mat backwardGradient;
 
-  //! The total gradient from each gradient pass.
-  arma::mat totalGradient;
-
   //! Forward RNN
   RNN<OutputLayerType, InitializationRuleType, CustomLayers...> forwardRNN;
 
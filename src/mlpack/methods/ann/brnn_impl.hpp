@@ -221,19 +221,12 @@ void BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
   {
     const size_t effectiveBatchSize = std::min(batchSize,
         size_t(predictors.n_cols - begin));
-    for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+    // The two directions are independent until the merge layer.
+    #pragma omp parallel for num_threads(2)
+    for (omp_size_t direction = 0; direction < 2; ++direction)
     {
-      forwardRNN.Forward(arma::mat(
-          predictors.slice(seqNum).colptr(begin),
-          predictors.n_rows, effectiveBatchSize, false, true));
-      backwardRNN.Forward(std::move(arma::mat(
-          predictors.slice(rho - seqNum - 1).colptr(begin),
-          predictors.n_rows, effectiveBatchSize, false, true)));
-
-      boost::apply_visitor(SaveOutputParameterVisitor(results1),
-          forwardRNN.network.back());
-      boost::apply_visitor(SaveOutputParameterVisitor(results2),
-          backwardRNN.network.back());
+      ForwardDirection(direction, predictors, begin, effectiveBatchSize,
+          (direction == 0) ? results1 : results2, NULL);
     }
     reverse(results1.begin(), results1.end());
 
@@ -298,19 +291,11 @@ double BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
   size_t responseSeq = 0;
 
   std::vector<arma::mat> results1, results2;
-  for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+  #pragma omp parallel for num_threads(2)
+  for (omp_size_t direction = 0; direction < 2; ++direction)
   {
-    forwardRNN.Forward(arma::mat(
-        predictors.slice(seqNum).colptr(begin),
-        predictors.n_rows, batchSize, false, true));
-    backwardRNN.Forward(arma::mat(
-        predictors.slice(rho - seqNum - 1).colptr(begin),
-        predictors.n_rows, batchSize, false, true));
-
-    boost::apply_visitor(SaveOutputParameterVisitor(results1),
-        forwardRNN.network.back());
-    boost::apply_visitor(SaveOutputParameterVisitor(results2),
-        backwardRNN.network.back());
+    ForwardDirection(direction, predictors, begin, batchSize,
+        (direction == 0) ? results1 : results2, NULL);
   }
   if (outputSize == 0)
   {
@@ -412,30 +397,16 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
 
   forwardRNN.ResetCells();
   backwardRNN.ResetCells();
-  size_t networkSize = backwardRNN.network.size();
 
-  // Forward propogation from both directions.
+  // Forward propogation from both directions, on one thread each.
   std::vector<arma::mat> results1, results2;
-  for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+  #pragma omp parallel for num_threads(2)
+  for (omp_size_t direction = 0; direction < 2; ++direction)
   {
-    forwardRNN.Forward(arma::mat(
-        predictors.slice(seqNum).colptr(begin),
-        predictors.n_rows, batchSize, false, true));
-    backwardRNN.Forward(arma::mat(
-        predictors.slice(rho - seqNum - 1).colptr(begin),
-        predictors.n_rows, batchSize, false, true));
-
-    for (size_t l = 0; l < networkSize; ++l)
-    {
-      boost::apply_visitor(SaveOutputParameterVisitor(
-          forwardRNNOutputParameter), forwardRNN.network[l]);
-      boost::apply_visitor(SaveOutputParameterVisitor(
-          backwardRNNOutputParameter), backwardRNN.network[l]);
-    }
-    boost::apply_visitor(SaveOutputParameterVisitor(results1),
-        forwardRNN.network.back());
-    boost::apply_visitor(SaveOutputParameterVisitor(results2),
-        backwardRNN.network.back());
+    ForwardDirection(direction, predictors, begin, batchSize,
+        (direction == 0) ? results1 : results2,
+        (direction == 0) ? &forwardRNNOutputParameter :
+        &backwardRNNOutputParameter);
   }
   if (outputSize == 0)
   {
@@ -509,88 +480,118 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     allDelta.push_back(arma::mat(delta));
   }
 
-  // BPTT ForwardRNN from t = T to 1.
-  totalGradient = arma::mat(gradient.memptr(),
-      parameter.n_elem / 2, 1, false, false);
-
   forwardGradient.zeros();
   forwardRNN.ResetGradients(forwardGradient);
   backwardGradient.zeros();
   backwardRNN.ResetGradients(backwardGradient);
 
+  // BPTT of the forward RNN from t = T to 1, and of the backward RNN from
+  // t = 1 to T, on one thread each.  Each direction accumulates into its own
+  // half of the gradient.
+  #pragma omp parallel for num_threads(2)
+  for (omp_size_t direction = 0; direction < 2; ++direction)
+  {
+    arma::mat directionGradient(gradient.memptr() + direction *
+        (parameter.n_elem / 2), parameter.n_elem / 2, 1, false, true);
+    BackwardDirection(direction, begin, batchSize, allDelta,
+        directionGradient);
+  }
+
+  return performance;
+}
+
+template<typename OutputLayerType, typename MergeLayerType,
+         typename MergeOutputType, typename InitializationRuleType,
+         typename... CustomLayers>
+void BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
+    InitializationRuleType, CustomLayers...>::ForwardDirection(
+    const size_t direction,
+    const arma::cube& sequences,
+    const size_t begin,
+    const size_t batchSize,
+    std::vector<arma::mat>& results,
+    std::vector<arma::mat>* outputParameters)
+{
+  RNN<OutputLayerType, InitializationRuleType, CustomLayers...>& rnn =
+      (direction == 0) ? forwardRNN : backwardRNN;
+
   for (size_t seqNum = 0; seqNum < rho; ++seqNum)
   {
-    forwardGradient.zeros();
-    for (size_t l = 0; l < networkSize; ++l)
-    {
-      boost::apply_visitor(LoadOutputParameterVisitor(
-          forwardRNNOutputParameter),
-          forwardRNN.network[networkSize - 1 - l]);
-    }
-    boost::apply_visitor(BackwardVisitor(boost::apply_visitor(
-        outputParameterVisitor, forwardRNN.network.back()),
-        allDelta[rho - seqNum - 1], delta, 0),
-        mergeLayer);
+    // The backward RNN sees the sequence in reverse order.
+    const size_t slice = (direction == 0) ? seqNum : rho - seqNum - 1;
+    rnn.Forward(arma::mat(const_cast<double*>(
+        sequences.slice(slice).colptr(begin)), sequences.n_rows, batchSize,
+        false, true));
 
-    for (size_t i = 2; i < networkSize; ++i)
+    if (outputParameters)
     {
-      boost::apply_visitor(BackwardVisitor(
-          boost::apply_visitor(outputParameterVisitor,
-          forwardRNN.network[networkSize - i]),
-          boost::apply_visitor(deltaVisitor,
-          forwardRNN.network[networkSize - i + 1]),
-          boost::apply_visitor(deltaVisitor,
-          forwardRNN.network[networkSize - i])),
-          forwardRNN.network[networkSize - i]);
+      for (size_t l = 0; l < rnn.network.size(); ++l)
+      {
+        boost::apply_visitor(SaveOutputParameterVisitor(*outputParameters),
+            rnn.network[l]);
+      }
     }
-    forwardRNN.Gradient(
-        arma::mat(predictors.slice(rho - seqNum - 1).colptr(begin),
-        predictors.n_rows, batchSize, false, true));
-    boost::apply_visitor(GradientVisitor(
-        boost::apply_visitor(outputParameterVisitor,
-        forwardRNN.network[networkSize - 2]),
-        allDelta[rho - seqNum - 1], 0), mergeLayer);
-    totalGradient += forwardGradient;
+    boost::apply_visitor(SaveOutputParameterVisitor(results),
+        rnn.network.back());
   }
+}
 
-  // BPTT BackwardRNN from t = 1 to T.
-  totalGradient = arma::mat(gradient.memptr() + parameter.n_elem/2,
-      parameter.n_elem/2, 1, false, false);
+template<typename OutputLayerType, typename MergeLayerType,
+         typename MergeOutputType, typename InitializationRuleType,
+         typename... CustomLayers>
+void BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
+    InitializationRuleType, CustomLayers...>::BackwardDirection(
+    const size_t direction,
+    const size_t begin,
+    const size_t batchSize,
+    const std::vector<arma::mat>& allDelta,
+    arma::mat& gradient)
+{
+  RNN<OutputLayerType, InitializationRuleType, CustomLayers...>& rnn =
+      (direction == 0) ? forwardRNN : backwardRNN;
+  arma::mat& rnnGradient = (direction == 0) ? forwardGradient :
+      backwardGradient;
+  std::vector<arma::mat>& outputParameters = (direction == 0) ?
+      forwardRNNOutputParameter : backwardRNNOutputParameter;
+  const size_t networkSize = rnn.network.size();
 
+  arma::mat delta;
   for (size_t seqNum = 0; seqNum < rho; ++seqNum)
   {
-    backwardGradient.zeros();
+    // The forward RNN goes back from t = T, and the backward RNN from t = 1;
+    // in both cases this is the input slice of the time step being undone.
+    const size_t slice = (direction == 0) ? rho - seqNum - 1 : seqNum;
+
+    rnnGradient.zeros();
     for (size_t l = 0; l < networkSize; ++l)
     {
-      boost::apply_visitor(LoadOutputParameterVisitor(
-          backwardRNNOutputParameter),
-          backwardRNN.network[networkSize - 1 - l]);
+      boost::apply_visitor(LoadOutputParameterVisitor(outputParameters),
+          rnn.network[networkSize - 1 - l]);
     }
-    boost::apply_visitor(BackwardVisitor(
-        boost::apply_visitor(outputParameterVisitor,
-        backwardRNN.network.back()),
-        allDelta[seqNum], delta, 1), mergeLayer);
+    boost::apply_visitor(BackwardVisitor(boost::apply_visitor(
+        outputParameterVisitor, rnn.network.back()), allDelta[slice], delta,
+        direction), mergeLayer);
+
     for (size_t i = 2; i < networkSize; ++i)
     {
       boost::apply_visitor(BackwardVisitor(
-        boost::apply_visitor(outputParameterVisitor,
-        backwardRNN.network[networkSize - i]), boost::apply_visitor(
-        deltaVisitor, backwardRNN.network[networkSize - i + 1]),
-        boost::apply_visitor(deltaVisitor,
-        backwardRNN.network[networkSize - i])),
-        backwardRNN.network[networkSize - i]);
+          boost::apply_visitor(outputParameterVisitor,
+          rnn.network[networkSize - i]),
+          boost::apply_visitor(deltaVisitor,
+          rnn.network[networkSize - i + 1]),
+          boost::apply_visitor(deltaVisitor,
+          rnn.network[networkSize - i])),
+          rnn.network[networkSize - i]);
     }
 
-    backwardRNN.Gradient(
-        arma::mat(predictors.slice(seqNum).colptr(begin),
+    rnn.Gradient(arma::mat(predictors.slice(slice).colptr(begin),
         predictors.n_rows, batchSize, false, true));
     boost::apply_visitor(GradientVisitor(
-        std::move(boost::apply_visitor(outputParameterVisitor,
-        backwardRNN.network[networkSize - 2])),
-        allDelta[seqNum], 1), mergeLayer);
-    totalGradient += backwardGradient;
+        boost::apply_visitor(outputParameterVisitor,
+        rnn.network[networkSize - 2]), allDelta[slice], direction),
+        mergeLayer);
+    gradient += rnnGradient;
   }
-  return performance;
 }
 
 template<typename OutputLayerType, typename MergeLayerType,
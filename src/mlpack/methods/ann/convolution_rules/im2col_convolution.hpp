@@ -0,0 +1,557 @@
+/**
+ * @file methods/ann/convolution_rules/im2col_convolution.hpp
+ *
+ * Implementation of the convolution through im2col and matrix multiplication.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_IM2COL_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_IM2COL_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "border_modes.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Computes the two-dimensional convolution by unfolding every filter-sized
+ * patch of the input into a column of a matrix (im2col), so that the
+ * convolution itself is a single matrix multiplication that can be handed to
+ * BLAS.  The Convolution() functions have the same interface and results as
+ * NaiveConvolution, so this class can be used as the convolution rule of any
+ * layer (Convolution, AtrousConvolution, TransposedConvolution).
+ *
+ * In addition, the BatchForward(), BatchBackward() and BatchGradient()
+ * functions handle all input maps, output maps and points of a layer at once;
+ * the Convolution layer uses them instead of looping over every pair of maps
+ * when its convolution rules are Im2ColConvolution.
+ *
+ * Strides and dilations along the rows of the input are given by dW and
+ * dilationW, and along the columns by dH and dilationH.
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ */
+template<typename BorderMode = FullConvolution>
+class Im2ColConvolution
+{
+ public:
+  /*
+   * Perform a convolution (valid mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, ValidConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    const size_t outRows = (input.n_rows - (filter.n_rows - 1) * dilationW -
+        1) / dW + 1;
+    const size_t outCols = (input.n_cols - (filter.n_cols - 1) * dilationH -
+        1) / dH + 1;
+
+    arma::Mat<eT> columns(filter.n_elem, outRows * outCols);
+    Im2Col(input.memptr(), input.n_rows, filter.n_rows, filter.n_cols, outRows,
+        outCols, dW, dH, dilationW, dilationH, columns.memptr());
+
+    output.set_size(outRows, outCols);
+    arma::Col<eT> outputVec(output.memptr(), output.n_elem, false, true);
+    const arma::Col<eT> filterVec(const_cast<eT*>(filter.memptr()),
+        filter.n_elem, false, true);
+    outputVec = columns.t() * filterVec;
+  }
+
+  /*
+   * Perform a convolution (full mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, FullConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    // Pad the input the same way NaiveConvolution does, so that both rules
+    // give the same output shape.
+    size_t outputRows = (input.n_rows - 1) * dW + 2 * (filter.n_rows - 1)
+        * dilationW + 1;
+    size_t outputCols = (input.n_cols - 1) * dH + 2 * (filter.n_cols - 1)
+        * dilationH + 1;
+
+    for (size_t i = 0; i < dW; ++i)
+    {
+      if (((((i + outputRows - 2 * (filter.n_rows - 1) * dilationW - 1) % dW)
+          + dW) % dW) == i)
+      {
+        outputRows += i;
+        break;
+      }
+    }
+    for (size_t i = 0; i < dH; ++i)
+    {
+      if (((((i + outputCols - 2 * (filter.n_cols - 1) * dilationH - 1) % dH)
+          + dH) % dH) == i)
+      {
+        outputCols += i;
+        break;
+      }
+    }
+
+    arma::Mat<eT> inputPadded = arma::zeros<arma::Mat<eT> >(outputRows,
+        outputCols);
+    inputPadded.submat((filter.n_rows - 1) * dilationW, (filter.n_cols - 1)
+        * dilationH, (filter.n_rows - 1) * dilationW + input.n_rows - 1,
+        (filter.n_cols - 1) * dilationH + input.n_cols - 1) = input;
+
+    Im2ColConvolution<ValidConvolution>::Convolution(inputPadded, filter,
+        output, 1, 1, dilationW, dilationH);
+  }
+
+  /*
+   * Perform a convolution using 3rd order tensors.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    Im2ColConvolution<BorderMode>::Convolution(input.slice(0),
+        filter.slice(0), convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      Im2ColConvolution<BorderMode>::Convolution(input.slice(i),
+          filter.slice(i), convOutput, dW, dH, dilationW, dilationH);
+      output.slice(i) = convOutput;
+    }
+  }
+
+  /*
+   * Perform a convolution using dense matrix as input and a 3rd order tensors
+   * as filter and output.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Mat<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    Im2ColConvolution<BorderMode>::Convolution(input, filter.slice(0),
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        filter.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < filter.n_slices; ++i)
+    {
+      Im2ColConvolution<BorderMode>::Convolution(input, filter.slice(i),
+          convOutput, dW, dH, dilationW, dilationH);
+      output.slice(i) = convOutput;
+    }
+  }
+
+  /*
+   * Perform a convolution using a 3rd order tensors as input and output and a
+   * dense matrix as filter.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Mat<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    Im2ColConvolution<BorderMode>::Convolution(input.slice(0), filter,
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      Im2ColConvolution<BorderMode>::Convolution(input.slice(i), filter,
+          convOutput, dW, dH, dilationW, dilationH);
+      output.slice(i) = convOutput;
+    }
+  }
+
+  /**
+   * Perform the (valid) forward convolution of a whole layer with one matrix
+   * multiplication.  The input holds inMaps slices for each point, the filter
+   * holds inMaps slices for each output map, and the output will hold one
+   * slice for each output map of each point, each the sum of the convolutions
+   * of all input maps of that point.
+   *
+   * @param input Input maps of all points (inMaps * batchSize slices).
+   * @param filter Filters of all map pairs (inMaps * outMaps slices).
+   * @param output Output maps of all points (outMaps * batchSize slices).
+   * @param inMaps Number of input maps of each point.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void BatchForward(const arma::Cube<eT>& input,
+                           const arma::Cube<eT>& filter,
+                           arma::Cube<eT>& output,
+                           const size_t inMaps,
+                           const size_t dW = 1,
+                           const size_t dH = 1,
+                           const size_t dilationW = 1,
+                           const size_t dilationH = 1)
+  {
+    const size_t outMaps = filter.n_slices / inMaps;
+    const size_t batchSize = input.n_slices / inMaps;
+    const size_t outRows = (input.n_rows - (filter.n_rows - 1) * dilationW -
+        1) / dW + 1;
+    const size_t outCols = (input.n_cols - (filter.n_cols - 1) * dilationH -
+        1) / dH + 1;
+    const size_t points = outRows * outCols;
+
+    arma::Mat<eT> columns;
+    BatchIm2Col(input, inMaps, filter.n_rows, filter.n_cols, outRows, outCols,
+        dW, dH, dilationW, dilationH, columns);
+
+    // Column o of the filter matrix holds the filters of output map o for
+    // every input map, in the same order as the rows of the columns matrix.
+    const arma::Mat<eT> filterMat(const_cast<eT*>(filter.memptr()),
+        filter.n_rows * filter.n_cols * inMaps, outMaps, false, true);
+
+    output.set_size(outRows, outCols, outMaps * batchSize);
+    if (batchSize == 1)
+    {
+      arma::Mat<eT> outputMat(output.memptr(), points, outMaps, false, true);
+      outputMat = columns.t() * filterMat;
+    }
+    else
+    {
+      // Row (b * points + p) of the product holds pixel p of every output map
+      // of point b.
+      const arma::Mat<eT> product = columns.t() * filterMat;
+      for (size_t b = 0; b < batchSize; ++b)
+      {
+        arma::Mat<eT> outputMat(output.slice_memptr(b * outMaps), points,
+            outMaps, false, true);
+        outputMat = product.rows(b * points, (b + 1) * points - 1);
+      }
+    }
+  }
+
+  /**
+   * Propagate the error of a whole layer back to its input maps, with one
+   * matrix multiplication; this is the transposed convolution of
+   * BatchForward().  The given output must already have the size of the
+   * (padded) input; the result is added to it.
+   *
+   * @param error Error of the output maps of all points.
+   * @param filter Filters of all map pairs (inMaps * outMaps slices).
+   * @param output Error of the input maps of all points (result is added).
+   * @param inMaps Number of input maps of each point.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void BatchBackward(const arma::Cube<eT>& error,
+                            const arma::Cube<eT>& filter,
+                            arma::Cube<eT>& output,
+                            const size_t inMaps,
+                            const size_t dW = 1,
+                            const size_t dH = 1,
+                            const size_t dilationW = 1,
+                            const size_t dilationH = 1)
+  {
+    const size_t outMaps = filter.n_slices / inMaps;
+    const arma::Mat<eT> filterMat(const_cast<eT*>(filter.memptr()),
+        filter.n_rows * filter.n_cols * inMaps, outMaps, false, true);
+
+    arma::Mat<eT> errorMat;
+    BatchMaps(error, outMaps, errorMat);
+    const arma::Mat<eT> columns = filterMat * errorMat.t();
+
+    BatchCol2Im(columns, inMaps, filter.n_rows, filter.n_cols, error.n_rows,
+        error.n_cols, dW, dH, dilationW, dilationH, output);
+  }
+
+  /**
+   * Compute the gradient of the filters of a whole layer with one matrix
+   * multiplication.  The gradient will hold one slice for each pair of maps,
+   * in the same order as the filter given to BatchForward().
+   *
+   * @param input Input maps of all points (inMaps * batchSize slices).
+   * @param error Error of the output maps of all points.
+   * @param gradient Gradient of the filters of all map pairs.
+   * @param inMaps Number of input maps of each point.
+   * @param filterRows Number of rows of each filter.
+   * @param filterCols Number of columns of each filter.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void BatchGradient(const arma::Cube<eT>& input,
+                            const arma::Cube<eT>& error,
+                            arma::Cube<eT>& gradient,
+                            const size_t inMaps,
+                            const size_t filterRows,
+                            const size_t filterCols,
+                            const size_t dW = 1,
+                            const size_t dH = 1,
+                            const size_t dilationW = 1,
+                            const size_t dilationH = 1)
+  {
+    const size_t batchSize = input.n_slices / inMaps;
+    const size_t outMaps = error.n_slices / batchSize;
+
+    arma::Mat<eT> columns;
+    BatchIm2Col(input, inMaps, filterRows, filterCols, error.n_rows,
+        error.n_cols, dW, dH, dilationW, dilationH, columns);
+
+    arma::Mat<eT> errorMat;
+    BatchMaps(error, outMaps, errorMat);
+
+    gradient.set_size(filterRows, filterCols, inMaps * outMaps);
+    arma::Mat<eT> gradientMat(gradient.memptr(), filterRows * filterCols *
+        inMaps, outMaps, false, true);
+    gradientMat = columns * errorMat;
+  }
+
+ private:
+  /**
+   * Unfold a single map: column p of the columns matrix (which must hold
+   * filterRows * filterCols rows) gets the input patch that output pixel p is
+   * computed from.
+   */
+  template<typename eT>
+  static void Im2Col(const eT* input,
+                     const size_t inputRows,
+                     const size_t filterRows,
+                     const size_t filterCols,
+                     const size_t outRows,
+                     const size_t outCols,
+                     const size_t dW,
+                     const size_t dH,
+                     const size_t dilationW,
+                     const size_t dilationH,
+                     eT* columns)
+  {
+    for (size_t j = 0; j < outCols; ++j)
+    {
+      for (size_t i = 0; i < outRows; ++i)
+      {
+        for (size_t kj = 0; kj < filterCols; ++kj)
+        {
+          const eT* inputPtr = input + (j * dH + kj * dilationH) * inputRows +
+              i * dW;
+          for (size_t ki = 0; ki < filterRows; ++ki, inputPtr += dilationW)
+            *columns++ = *inputPtr;
+        }
+      }
+    }
+  }
+
+  /**
+   * Unfold the maps of all points.  The columns matrix gets one row for each
+   * filter element of each input map, and one column for each output pixel of
+   * each point.
+   */
+  template<typename eT>
+  static void BatchIm2Col(const arma::Cube<eT>& input,
+                          const size_t inMaps,
+                          const size_t filterRows,
+                          const size_t filterCols,
+                          const size_t outRows,
+                          const size_t outCols,
+                          const size_t dW,
+                          const size_t dH,
+                          const size_t dilationW,
+                          const size_t dilationH,
+                          arma::Mat<eT>& columns)
+  {
+    const size_t filterSize = filterRows * filterCols;
+    const size_t points = outRows * outCols;
+    const size_t batchSize = input.n_slices / inMaps;
+    columns.set_size(filterSize * inMaps, points * batchSize);
+
+    for (size_t b = 0; b < batchSize; ++b)
+    {
+      for (size_t j = 0; j < outCols; ++j)
+      {
+        for (size_t i = 0; i < outRows; ++i)
+        {
+          eT* columnPtr = columns.colptr(b * points + j * outRows + i);
+          for (size_t m = 0; m < inMaps; ++m)
+          {
+            const arma::Mat<eT>& map = input.slice(b * inMaps + m);
+            for (size_t kj = 0; kj < filterCols; ++kj)
+            {
+              const eT* inputPtr = map.colptr(j * dH + kj * dilationH) +
+                  i * dW;
+              for (size_t ki = 0; ki < filterRows; ++ki,
+                  inputPtr += dilationW)
+                *columnPtr++ = *inputPtr;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * The inverse of BatchIm2Col(): add every column of the columns matrix back
+   * onto the input patch it belongs to.
+   */
+  template<typename eT>
+  static void BatchCol2Im(const arma::Mat<eT>& columns,
+                          const size_t inMaps,
+                          const size_t filterRows,
+                          const size_t filterCols,
+                          const size_t outRows,
+                          const size_t outCols,
+                          const size_t dW,
+                          const size_t dH,
+                          const size_t dilationW,
+                          const size_t dilationH,
+                          arma::Cube<eT>& output)
+  {
+    const size_t points = outRows * outCols;
+    const size_t batchSize = output.n_slices / inMaps;
+
+    for (size_t b = 0; b < batchSize; ++b)
+    {
+      for (size_t j = 0; j < outCols; ++j)
+      {
+        for (size_t i = 0; i < outRows; ++i)
+        {
+          const eT* columnPtr = columns.colptr(b * points + j * outRows + i);
+          for (size_t m = 0; m < inMaps; ++m)
+          {
+            arma::Mat<eT>& map = output.slice(b * inMaps + m);
+            for (size_t kj = 0; kj < filterCols; ++kj)
+            {
+              eT* outputPtr = map.colptr(j * dH + kj * dilationH) + i * dW;
+              for (size_t ki = 0; ki < filterRows; ++ki,
+                  outputPtr += dilationW)
+                *outputPtr += *columnPtr++;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Arrange maps so that row (b * points + p) holds pixel p of every map of
+   * point b, where each point has the given number of maps.
+   */
+  template<typename eT>
+  static void BatchMaps(const arma::Cube<eT>& maps,
+                        const size_t numMaps,
+                        arma::Mat<eT>& result)
+  {
+    const size_t points = maps.n_rows * maps.n_cols;
+    const size_t batchSize = maps.n_slices / numMaps;
+    result.set_size(points * batchSize, numMaps);
+    for (size_t b = 0; b < batchSize; ++b)
+    {
+      const arma::Mat<eT> pointMaps(const_cast<eT*>(maps.slice_memptr(b *
+          numMaps)), points, numMaps, false, true);
+      result.rows(b * points, (b + 1) * points - 1) = pointMaps;
+    }
+  }
+};  // class Im2ColConvolution
+
+/**
+ * Whether the given convolution rule is an Im2ColConvolution, whose batched
+ * functions can compute a whole layer at once.
+ */
+template<typename ConvolutionRule>
+struct IsIm2ColConvolution
+{
+  static const bool value = false;
+};
+
+template<typename BorderMode>
+struct IsIm2ColConvolution<Im2ColConvolution<BorderMode> >
+{
+  static const bool value = true;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
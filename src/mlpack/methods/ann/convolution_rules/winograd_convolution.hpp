@@ -0,0 +1,497 @@
+/**
+ * @file methods/ann/convolution_rules/winograd_convolution.hpp
+ *
+ * Implementation of the 3x3 convolution with Winograd's minimal filtering
+ * algorithm F(2x2, 3x3).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_WINOGRAD_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_WINOGRAD_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "border_modes.hpp"
+#include "naive_convolution.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Computes the two-dimensional convolution of 3x3 filters with unit stride and
+ * dilation with Winograd's minimal filtering algorithm F(2x2, 3x3).  Each 2x2
+ * tile of the output is computed from a 4x4 tile of the input with 16
+ * multiplications instead of 36.  For more information, see the following
+ * paper:
+ *
+ * @code
+ * @inproceedings{lavin2016fast,
+ *   title={Fast Algorithms for Convolutional Neural Networks},
+ *   author={Lavin, Andrew and Gray, Scott},
+ *   booktitle={Proceedings of the IEEE Conference on Computer Vision and
+ *       Pattern Recognition (CVPR)},
+ *   pages={4013--4021},
+ *   year={2016}
+ * }
+ * @endcode
+ *
+ * The Convolution() functions have the same interface and results as
+ * NaiveConvolution (to rounding), and fall back to it for any other filter
+ * size, stride or dilation.
+ *
+ * For whole layers, TransformFilters() transforms all filters once, and
+ * BatchForward() then convolves all maps of all points: the transformed tiles
+ * of all input maps and points form one matrix for each of the 16 tile
+ * elements, so that the sums over the input maps are 16 matrix
+ * multiplications.  The Convolution layer uses these functions for 3x3
+ * kernels with unit stride when its convolution rules are NaiveConvolution
+ * (the default) or WinogradConvolution.
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ */
+template<typename BorderMode = FullConvolution>
+class WinogradConvolution
+{
+ public:
+  /**
+   * Whether a filter of the given size, with the given strides and dilations,
+   * can be applied with the Winograd algorithm.
+   */
+  static bool Supported(const size_t filterRows,
+                        const size_t filterCols,
+                        const size_t dW = 1,
+                        const size_t dH = 1,
+                        const size_t dilationW = 1,
+                        const size_t dilationH = 1)
+  {
+    return filterRows == 3 && filterCols == 3 && dW == 1 && dH == 1 &&
+        dilationW == 1 && dilationH == 1;
+  }
+
+  /*
+   * Perform a convolution (valid mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, ValidConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    if (!Supported(filter.n_rows, filter.n_cols, dW, dH, dilationW,
+        dilationH) || input.n_rows < 3 || input.n_cols < 3)
+    {
+      NaiveConvolution<ValidConvolution>::Convolution(input, filter, output,
+          dW, dH, dilationW, dilationH);
+      return;
+    }
+
+    const arma::Cube<eT> inputCube(const_cast<eT*>(input.memptr()),
+        input.n_rows, input.n_cols, 1, false, true);
+    const arma::Cube<eT> filterCube(const_cast<eT*>(filter.memptr()), 3, 3, 1,
+        false, true);
+    arma::Cube<eT> transformed, outputCube;
+    TransformFilters(filterCube, 1, transformed);
+    BatchForward(inputCube, transformed, outputCube);
+    output = outputCube.slice(0);
+  }
+
+  /*
+   * Perform a convolution (full mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, FullConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    if (!Supported(filter.n_rows, filter.n_cols, dW, dH, dilationW,
+        dilationH))
+    {
+      NaiveConvolution<FullConvolution>::Convolution(input, filter, output,
+          dW, dH, dilationW, dilationH);
+      return;
+    }
+
+    // With unit strides, the full convolution is the valid convolution of the
+    // input padded with two zeros on every side.
+    arma::Mat<eT> inputPadded = arma::zeros<arma::Mat<eT> >(input.n_rows + 4,
+        input.n_cols + 4);
+    inputPadded.submat(2, 2, input.n_rows + 1, input.n_cols + 1) = input;
+
+    WinogradConvolution<ValidConvolution>::Convolution(inputPadded, filter,
+        output);
+  }
+
+  /*
+   * Perform a convolution using 3rd order tensors.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input.slice(0),
+        filter.slice(0), convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input.slice(i),
+          filter.slice(i), convOutput, dW, dH, dilationW, dilationH);
+      output.slice(i) = convOutput;
+    }
+  }
+
+  /*
+   * Perform a convolution using dense matrix as input and a 3rd order tensors
+   * as filter and output.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Mat<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input, filter.slice(0),
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        filter.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < filter.n_slices; ++i)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input, filter.slice(i),
+          convOutput, dW, dH, dilationW, dilationH);
+      output.slice(i) = convOutput;
+    }
+  }
+
+  /*
+   * Perform a convolution using a 3rd order tensors as input and output and a
+   * dense matrix as filter.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Mat<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    WinogradConvolution<BorderMode>::Convolution(input.slice(0), filter,
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      WinogradConvolution<BorderMode>::Convolution(input.slice(i), filter,
+          convOutput, dW, dH, dilationW, dilationH);
+      output.slice(i) = convOutput;
+    }
+  }
+
+  /**
+   * Transform the 3x3 filters of a whole layer, ordered as for
+   * Im2ColConvolution::BatchForward() (the filters of output map o are the
+   * slices o * inMaps to (o + 1) * inMaps - 1).  Slice e of the result holds
+   * element e of the transformed filters, with one row for each output map and
+   * one column for each input map.
+   *
+   * If rotate is true, the filters are rotated by 180 degrees, and the roles of
+   * the input and output maps are swapped; the result then propagates the
+   * error of the output maps back to the input maps with BatchForward().
+   *
+   * @param filter Filters of all map pairs (inMaps * outMaps slices).
+   * @param inMaps Number of input maps.
+   * @param transformed Transformed filters (16 slices).
+   * @param rotate Whether to transform the filters for the backward pass.
+   */
+  template<typename eT>
+  static void TransformFilters(const arma::Cube<eT>& filter,
+                               const size_t inMaps,
+                               arma::Cube<eT>& transformed,
+                               const bool rotate = false)
+  {
+    const size_t outMaps = filter.n_slices / inMaps;
+    if (rotate)
+      transformed.set_size(inMaps, outMaps, 16);
+    else
+      transformed.set_size(outMaps, inMaps, 16);
+
+    eT g[9], u[16];
+    for (size_t o = 0; o < outMaps; ++o)
+    {
+      for (size_t m = 0; m < inMaps; ++m)
+      {
+        const eT* f = filter.slice_memptr(o * inMaps + m);
+        for (size_t k = 0; k < 9; ++k)
+          g[k] = rotate ? f[8 - k] : f[k];
+
+        TransformFilter(g, u);
+        for (size_t e = 0; e < 16; ++e)
+        {
+          if (rotate)
+            transformed(m, o, e) = u[e];
+          else
+            transformed(o, m, e) = u[e];
+        }
+      }
+    }
+  }
+
+  /**
+   * Perform the (valid) convolution of a whole layer with filters transformed
+   * by TransformFilters().  The input holds inMaps slices for each point, and
+   * the output will hold one slice for each output map of each point, each the
+   * sum of the convolutions of all input maps of that point.
+   *
+   * @param input Input maps of all points (inMaps * batchSize slices).
+   * @param transformed Transformed filters (outMaps x inMaps x 16).
+   * @param output Output maps of all points (outMaps * batchSize slices).
+   */
+  template<typename eT>
+  static void BatchForward(const arma::Cube<eT>& input,
+                           const arma::Cube<eT>& transformed,
+                           arma::Cube<eT>& output)
+  {
+    const size_t outMaps = transformed.n_rows;
+    const size_t inMaps = transformed.n_cols;
+    const size_t batchSize = input.n_slices / inMaps;
+    const size_t outRows = input.n_rows - 2;
+    const size_t outCols = input.n_cols - 2;
+    const size_t tileRows = (outRows + 1) / 2;
+    const size_t tileCols = (outCols + 1) / 2;
+    const size_t tiles = tileRows * tileCols;
+
+    // Transform the input tiles: slice e holds element e of the tile of each
+    // input map (rows) for each tile of each point (columns).
+    arma::Cube<eT> v(inMaps, tiles * batchSize, 16);
+    eT d[16], t[16];
+    for (size_t b = 0; b < batchSize; ++b)
+    {
+      for (size_t m = 0; m < inMaps; ++m)
+      {
+        const arma::Mat<eT>& map = input.slice(b * inMaps + m);
+        for (size_t tj = 0; tj < tileCols; ++tj)
+        {
+          for (size_t ti = 0; ti < tileRows; ++ti)
+          {
+            // The tiles at the end of an odd-sized output reach one past the
+            // input, which is read as zero.
+            for (size_t c = 0; c < 4; ++c)
+            {
+              for (size_t r = 0; r < 4; ++r)
+              {
+                const size_t i = 2 * ti + r;
+                const size_t j = 2 * tj + c;
+                d[r + 4 * c] = (i < map.n_rows && j < map.n_cols) ?
+                    map(i, j) : eT(0);
+              }
+            }
+
+            TransformInput(d, t);
+            const size_t tile = b * tiles + tj * tileRows + ti;
+            for (size_t e = 0; e < 16; ++e)
+              v(m, tile, e) = t[e];
+          }
+        }
+      }
+    }
+
+    // Sum over the input maps, for each of the 16 tile elements.
+    arma::Cube<eT> products(outMaps, tiles * batchSize, 16);
+    for (size_t e = 0; e < 16; ++e)
+      products.slice(e) = transformed.slice(e) * v.slice(e);
+
+    output.set_size(outRows, outCols, outMaps * batchSize);
+    eT y[4];
+    for (size_t b = 0; b < batchSize; ++b)
+    {
+      for (size_t tj = 0; tj < tileCols; ++tj)
+      {
+        for (size_t ti = 0; ti < tileRows; ++ti)
+        {
+          const size_t tile = b * tiles + tj * tileRows + ti;
+          for (size_t o = 0; o < outMaps; ++o)
+          {
+            for (size_t e = 0; e < 16; ++e)
+              t[e] = products(o, tile, e);
+
+            TransformOutput(t, y);
+            arma::Mat<eT>& map = output.slice(b * outMaps + o);
+            for (size_t c = 0; c < 2 && 2 * tj + c < outCols; ++c)
+              for (size_t r = 0; r < 2 && 2 * ti + r < outRows; ++r)
+                map(2 * ti + r, 2 * tj + c) = y[r + 2 * c];
+          }
+        }
+      }
+    }
+  }
+
+ private:
+  /**
+   * Compute G g G^T for a column-major 3x3 filter g, where
+   * G = [1 0 0; 1/2 1/2 1/2; 1/2 -1/2 1/2; 0 0 1].
+   */
+  template<typename eT>
+  static void TransformFilter(const eT* g, eT* u)
+  {
+    // First along the columns (G g, 4x3), then along the rows.
+    eT gg[12];
+    for (size_t c = 0; c < 3; ++c)
+    {
+      const eT* col = g + 3 * c;
+      gg[0 + 4 * c] = col[0];
+      gg[1 + 4 * c] = (col[0] + col[1] + col[2]) / 2;
+      gg[2 + 4 * c] = (col[0] - col[1] + col[2]) / 2;
+      gg[3 + 4 * c] = col[2];
+    }
+
+    for (size_t r = 0; r < 4; ++r)
+    {
+      u[r + 0] = gg[r];
+      u[r + 4] = (gg[r] + gg[r + 4] + gg[r + 8]) / 2;
+      u[r + 8] = (gg[r] - gg[r + 4] + gg[r + 8]) / 2;
+      u[r + 12] = gg[r + 8];
+    }
+  }
+
+  /**
+   * Compute B^T d B for a column-major 4x4 input tile d, where
+   * B^T = [1 0 -1 0; 0 1 1 0; 0 -1 1 0; 0 1 0 -1].
+   */
+  template<typename eT>
+  static void TransformInput(const eT* d, eT* v)
+  {
+    eT bd[16];
+    for (size_t c = 0; c < 4; ++c)
+    {
+      const eT* col = d + 4 * c;
+      bd[0 + 4 * c] = col[0] - col[2];
+      bd[1 + 4 * c] = col[1] + col[2];
+      bd[2 + 4 * c] = col[2] - col[1];
+      bd[3 + 4 * c] = col[1] - col[3];
+    }
+
+    for (size_t r = 0; r < 4; ++r)
+    {
+      v[r + 0] = bd[r] - bd[r + 8];
+      v[r + 4] = bd[r + 4] + bd[r + 8];
+      v[r + 8] = bd[r + 8] - bd[r + 4];
+      v[r + 12] = bd[r + 4] - bd[r + 12];
+    }
+  }
+
+  /**
+   * Compute A^T m A for a column-major 4x4 tile m of products, where
+   * A^T = [1 1 1 0; 0 1 -1 -1].
+   */
+  template<typename eT>
+  static void TransformOutput(const eT* m, eT* y)
+  {
+    eT am[8];
+    for (size_t c = 0; c < 4; ++c)
+    {
+      const eT* col = m + 4 * c;
+      am[0 + 2 * c] = col[0] + col[1] + col[2];
+      am[1 + 2 * c] = col[1] - col[2] - col[3];
+    }
+
+    for (size_t r = 0; r < 2; ++r)
+    {
+      y[r + 0] = am[r] + am[r + 2] + am[r + 4];
+      y[r + 2] = am[r + 2] - am[r + 4] - am[r + 6];
+    }
+  }
+};  // class WinogradConvolution
+
+/**
+ * Whether the given convolution rule is a WinogradConvolution.
+ */
+template<typename ConvolutionRule>
+struct IsWinogradConvolution
+{
+  static const bool value = false;
+};
+
+template<typename BorderMode>
+struct IsWinogradConvolution<WinogradConvolution<BorderMode> >
+{
+  static const bool value = true;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,199 @@
+/**
+ * @file methods/ann/distributed/data_parallel.hpp
+ *
+ * Definition of the DataParallel optimizer wrapper and the DataParallelFunction
+ * class, for data-parallel training of neural networks over several processes.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_DISTRIBUTED_DATA_PARALLEL_HPP
+#define MLPACK_METHODS_ANN_DISTRIBUTED_DATA_PARALLEL_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <mlpack/core/distributed/local_communicator.hpp>
+#include <mlpack/core/distributed/mpi_communicator.hpp>
+#include <mlpack/core/distributed/ring_all_reduce.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * DataParallelFunction wraps a separable function (such as an FFN or an RNN
+ * with its training data) that holds the shard of the data of one process, so
+ * that an ensmallen optimizer run in every process trains on the data of all
+ * the processes.  The gradient and the objective of each batch are averaged
+ * over the processes with distributed::RingAllReduce(), so every process takes
+ * the same step.  The number of functions is the smallest shard, so that every
+ * process takes the same number of steps.
+ *
+ * @tparam FunctionType Type of the wrapped separable function.
+ * @tparam CommunicatorType Type of the communicator between the processes.
+ */
+template<typename FunctionType, typename CommunicatorType>
+class DataParallelFunction
+{
+ public:
+  /**
+   * Wrap the given function.  Every process must create its wrapper at the
+   * same time.
+   *
+   * @param function Function holding the shard of this process.
+   * @param communicator Communicator between the processes.
+   * @param compress Whether to send the gradients in half precision.
+   */
+  DataParallelFunction(FunctionType& function,
+                       CommunicatorType& communicator,
+                       const bool compress = false);
+
+  //! Get the number of functions (points) that every process goes over.
+  size_t NumFunctions() const { return numFunctions; }
+
+  //! Shuffle the shard of this process.
+  void Shuffle() { function.Shuffle(); }
+
+  /**
+   * Evaluate the objective of a batch, averaged over the processes.
+   *
+   * @param parameters Parameters of the function.
+   * @param begin Index of the first point of the batch of this process.
+   * @param batchSize Number of points in the batch of each process.
+   */
+  double Evaluate(const arma::mat& parameters,
+                  const size_t begin,
+                  const size_t batchSize);
+
+  /**
+   * Evaluate the objective and the gradient of a batch, averaged over the
+   * processes.
+   *
+   * @param parameters Parameters of the function.
+   * @param begin Index of the first point of the batch of this process.
+   * @param gradient Matrix to output the gradient into.
+   * @param batchSize Number of points in the batch of each process.
+   */
+  double EvaluateWithGradient(const arma::mat& parameters,
+                              const size_t begin,
+                              arma::mat& gradient,
+                              const size_t batchSize);
+
+  /**
+   * Evaluate the gradient of a batch, averaged over the processes.
+   *
+   * @param parameters Parameters of the function.
+   * @param begin Index of the first point of the batch of this process.
+   * @param gradient Matrix to output the gradient into.
+   * @param batchSize Number of points in the batch of each process.
+   */
+  void Gradient(const arma::mat& parameters,
+                const size_t begin,
+                arma::mat& gradient,
+                const size_t batchSize);
+
+ private:
+  //! Average the given objective over the processes.
+  double AverageObjective(const double objective);
+
+  //! The wrapped function.
+  FunctionType& function;
+
+  //! The communicator between the processes.
+  CommunicatorType& communicator;
+
+  //! Whether to send the gradients in half precision.
+  bool compress;
+
+  //! The number of points every process goes over.
+  size_t numFunctions;
+};
+
+/**
+ * DataParallel wraps an ensmallen optimizer for separable functions (such as
+ * ens::Adam or ens::StandardSGD) for data-parallel training: every process
+ * holds a shard of the data and a copy of the model, the parameters of the
+ * first process are broadcast to the others before the optimization, and the
+ * gradients are averaged over the processes before each step (see
+ * DataParallelFunction).  Since the model is trained with the FFN::Train() or
+ * RNN::Train() overload that takes an optimizer, every process ends up with
+ * the same parameters.
+ *
+ * The processes communicate through the given communicator, which is an
+ * distributed::MPICommunicator for multi-node training (when mlpack is
+ * configured with USE_MPI), or any class with the same interface (see
+ * distributed::LocalCommunicator).
+ *
+ * @code
+ * distributed::MPICommunicator communicator;
+ * DataParallel<ens::Adam, distributed::MPICommunicator> optimizer(
+ *     ens::Adam(0.001, 32), communicator, true);
+ * model.Train(shardData, shardLabels, optimizer);
+ * @endcode
+ *
+ * Each batch of the optimizer is a batch of every process, so the effective
+ * batch size is the batch size of the optimizer times the number of processes.
+ *
+ * @tparam OptimizerType Type of the wrapped optimizer.
+ * @tparam CommunicatorType Type of the communicator between the processes.
+ */
+template<typename OptimizerType, typename CommunicatorType>
+class DataParallel
+{
+ public:
+  /**
+   * Create the DataParallel optimizer.
+   *
+   * @param optimizer Optimizer to run in every process.
+   * @param communicator Communicator between the processes; it must outlive
+   *     this object.
+   * @param compress Whether to send the gradients in half precision, which
+   *     divides the traffic by four.
+   */
+  DataParallel(const OptimizerType& optimizer,
+               CommunicatorType& communicator,
+               const bool compress = false);
+
+  /**
+   * Optimize the given function, which holds the shard of this process,
+   * starting from the parameters of the first process.
+   *
+   * @param function Function to optimize.
+   * @param parameters Starting point, and the final parameters.
+   * @param callbacks Callbacks of the optimizer.
+   * @return The final objective, averaged over the processes.
+   */
+  template<typename FunctionType, typename... CallbackTypes>
+  double Optimize(FunctionType& function,
+                  arma::mat& parameters,
+                  CallbackTypes&&... callbacks);
+
+  //! Get the wrapped optimizer.
+  const OptimizerType& Optimizer() const { return optimizer; }
+  //! Modify the wrapped optimizer.
+  OptimizerType& Optimizer() { return optimizer; }
+
+  //! Get whether the gradients are sent in half precision.
+  bool Compress() const { return compress; }
+  //! Modify whether the gradients are sent in half precision.
+  bool& Compress() { return compress; }
+
+ private:
+  //! The wrapped optimizer.
+  OptimizerType optimizer;
+
+  //! The communicator between the processes.
+  CommunicatorType& communicator;
+
+  //! Whether to send the gradients in half precision.
+  bool compress;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "data_parallel_impl.hpp"
+
+#endif
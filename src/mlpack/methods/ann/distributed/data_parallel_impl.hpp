@@ -0,0 +1,124 @@
+/**
+ * @file methods/ann/distributed/data_parallel_impl.hpp
+ *
+ * Implementation of the DataParallel optimizer wrapper and the
+ * DataParallelFunction class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_DISTRIBUTED_DATA_PARALLEL_IMPL_HPP
+#define MLPACK_METHODS_ANN_DISTRIBUTED_DATA_PARALLEL_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "data_parallel.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename FunctionType, typename CommunicatorType>
+DataParallelFunction<FunctionType, CommunicatorType>::DataParallelFunction(
+    FunctionType& function,
+    CommunicatorType& communicator,
+    const bool compress) :
+    function(function),
+    communicator(communicator),
+    compress(compress)
+{
+  // Gather the size of the shard of every process.
+  arma::vec sizes(communicator.Size(), arma::fill::zeros);
+  sizes[communicator.Rank()] = (double) function.NumFunctions();
+  distributed::RingAllReduce(communicator, sizes.memptr(), sizes.n_elem);
+  numFunctions = (size_t) sizes.min();
+
+  if (numFunctions < function.NumFunctions())
+  {
+    Log::Warn << "DataParallelFunction::DataParallelFunction(): the shards "
+        << "have different sizes; only " << numFunctions << " of the "
+        << function.NumFunctions() << " points of this process are used in "
+        << "each epoch." << std::endl;
+  }
+}
+
+template<typename FunctionType, typename CommunicatorType>
+double DataParallelFunction<FunctionType, CommunicatorType>::Evaluate(
+    const arma::mat& parameters,
+    const size_t begin,
+    const size_t batchSize)
+{
+  return AverageObjective(function.Evaluate(parameters, begin, batchSize));
+}
+
+template<typename FunctionType, typename CommunicatorType>
+double DataParallelFunction<FunctionType, CommunicatorType>::
+EvaluateWithGradient(const arma::mat& parameters,
+                     const size_t begin,
+                     arma::mat& gradient,
+                     const size_t batchSize)
+{
+  const double objective = function.EvaluateWithGradient(parameters, begin,
+      gradient, batchSize);
+
+  distributed::RingAllReduce(communicator, gradient.memptr(), gradient.n_elem,
+      compress);
+  gradient /= communicator.Size();
+
+  return AverageObjective(objective);
+}
+
+template<typename FunctionType, typename CommunicatorType>
+void DataParallelFunction<FunctionType, CommunicatorType>::Gradient(
+    const arma::mat& parameters,
+    const size_t begin,
+    arma::mat& gradient,
+    const size_t batchSize)
+{
+  EvaluateWithGradient(parameters, begin, gradient, batchSize);
+}
+
+template<typename FunctionType, typename CommunicatorType>
+double DataParallelFunction<FunctionType, CommunicatorType>::AverageObjective(
+    const double objective)
+{
+  // The objective is never compressed, so that every process makes the same
+  // decisions based on it (such as stopping the optimization).
+  double sum = objective;
+  distributed::RingAllReduce(communicator, &sum, 1);
+  return sum / communicator.Size();
+}
+
+template<typename OptimizerType, typename CommunicatorType>
+DataParallel<OptimizerType, CommunicatorType>::DataParallel(
+    const OptimizerType& optimizer,
+    CommunicatorType& communicator,
+    const bool compress) :
+    optimizer(optimizer),
+    communicator(communicator),
+    compress(compress)
+{
+  // Nothing to do here.
+}
+
+template<typename OptimizerType, typename CommunicatorType>
+template<typename FunctionType, typename... CallbackTypes>
+double DataParallel<OptimizerType, CommunicatorType>::Optimize(
+    FunctionType& function,
+    arma::mat& parameters,
+    CallbackTypes&&... callbacks)
+{
+  // Start every process from the parameters of the first one.
+  communicator.Broadcast(parameters.memptr(), parameters.n_elem *
+      sizeof(double), 0);
+
+  DataParallelFunction<FunctionType, CommunicatorType> parallelFunction(
+      function, communicator, compress);
+  return optimizer.Optimize(parallelFunction, parameters,
+      std::forward<CallbackTypes>(callbacks)...);
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_ANN_FFN_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/data_pipeline.hpp>
 
 #include "visitor/delete_visitor.hpp"
 #include "visitor/delta_visitor.hpp"
@@ -24,6 +25,7 @@
 #include "visitor/weight_size_visitor.hpp"
 #include "visitor/copy_visitor.hpp"
 #include "visitor/loss_visitor.hpp"
+#include "visitor/fold_batch_norm_visitor.hpp"
 
 #include "init_rules/network_init.hpp"
 
@@ -163,18 +165,53 @@ class FFN
                arma::mat responses,
                CallbackTypes&&... callbacks);
 
+  /**
+   * Train the feedforward network on the batches of the given data pipeline, so that
+   * the whole dataset never has to be in memory.  For each epoch, the model is
+   * trained with the given optimizer on each batch in turn, while the pipeline
+   * makes the next batches in the background; then the pipeline is reset for
+   * the next epoch.
+   *
+   * Each batch is passed to the optimizer like a dataset, so the optimizer
+   * should make a single pass over it (for instance, MaxIterations() equal to
+   * the batch size), and optimizers with state should not reset it between
+   * batches (for instance, ResetPolicy() set to false).
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param pipeline Data pipeline that makes the batches of the dataset; the
+   *     first epoch starts at the current batch of the pipeline.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param epochs Number of passes over the dataset.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The sum of the final objectives of the batches of the last epoch.
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  double Train(data::DataPipeline<arma::mat, arma::mat>& pipeline,
+               OptimizerType& optimizer,
+               const size_t epochs,
+               CallbackTypes&&... callbacks);
+
   /**
    * Predict the responses to a given set of predictors. The responses will
    * reflect the output of the given output layer as returned by the
    * output layer function.
    *
-   * If you want to pass in a parameter and discard the original parameter
-   * object, be sure to use std::move to avoid unnecessary copy.
+   * The predictors are passed through the network batchSize points at a time.
+   * Since every batch (except possibly the last) has the same size, the output
+   * matrices of each layer and the given results matrix are reused across
+   * batches and across calls, so repeated calls with the same batch size do not
+   * need to allocate new layer outputs.  A batchSize of 1 passes each point
+   * through the network separately.
    *
    * @param predictors Input predictors.
    * @param results Matrix to put output predictions of responses into.
+   * @param batchSize Number of points to pass through the network at once.
    */
-  void Predict(arma::mat predictors, arma::mat& results);
+  void Predict(const arma::mat& predictors,
+               arma::mat& results,
+               const size_t batchSize = 128);
 
   /**
    * Evaluate the feedforward network with the given predictors and responses.
@@ -329,6 +366,103 @@ class FFN
    */
   void ResetParameters();
 
+  /**
+   * Turn this network into a replica of the given network for inference.  The
+   * layers of the given network are copied, but the weights of every copied
+   * layer alias the parameters of the given network instead of holding a copy
+   * of them.  Each replica holds its own layer outputs, so several replicas of
+   * one network can call Predict() from different threads at the same time,
+   * while the parameters are only stored once.
+   *
+   * The given network must outlive this replica, and neither network may be
+   * trained or have its parameters reset while the replica is in use.
+   *
+   * @param network Network whose layers and parameters will be shared.
+   */
+  void ShareParameters(FFN& network);
+
+  /**
+   * Prepare the network for inference by folding every BatchNorm layer that
+   * directly follows a Linear or Convolution layer into the weights and biases
+   * of that layer, using the running mean and variance of the BatchNorm layer,
+   * and removing the BatchNorm layer.  The predictions of the network in
+   * deterministic mode are unchanged (up to rounding), but each folded layer
+   * saves a pass over its input.
+   *
+   * The folded network can't be trained any more, since the batch statistics
+   * of the removed layers would be lost, so this should only be called once
+   * training is finished.  The parameters of the network are reallocated, so
+   * any replica (see ShareParameters()) must be rebuilt.
+   *
+   * @return The number of BatchNorm layers that were folded.
+   */
+  size_t FoldBatchNorm();
+
+  /**
+   * Prepare the network for inference by replacing every Linear layer whose
+   * weights are sparse enough (for instance after PruneLinear()) with a
+   * SparseLinear layer, which only stores and multiplies by the non-zero
+   * weights.  The predictions of the network are unchanged.
+   *
+   * SparseLinear layers can't be trained, so this should only be called once
+   * training is finished.  The parameters of the network are reallocated, so
+   * any replica (see ShareParameters()) must be rebuilt.
+   *
+   * @param maxDensity Largest fraction of non-zero weights of the Linear layers
+   *     to convert; denser layers are faster with dense weights.
+   * @return The number of Linear layers that were converted.
+   */
+  size_t SparsifyLinear(const double maxDensity = 0.5);
+
+  //! Get the number of threads used to compute the gradient of a batch.
+  size_t NumThreads() const { return numThreads; }
+  /**
+   * Modify the number of threads used to compute the gradient of a batch.  If
+   * more than one thread is used, each batch given to EvaluateWithGradient() is
+   * split into one part for each thread, and each part is passed through a
+   * replica of the network that shares its parameters (see ShareParameters()).
+   * The output layer is evaluated once on the whole batch, so the objective
+   * and gradient match those of one thread whether the loss is summed or
+   * averaged over the batch; layer losses and regularizers are weighted by
+   * the size of each part.  Layers that use statistics of the whole batch
+   * (such as BatchNorm) see only the part of their thread.
+   * This is only useful when mlpack is compiled with OpenMP.
+   */
+  size_t& NumThreads() { return numThreads; }
+
+  //! Get whether the layers share buffers for their outputs and errors.
+  bool ReuseBuffers() const { return reuseBuffers; }
+  /**
+   * Modify whether the layers share buffers for their outputs and errors.  If
+   * true, Predict() passes each batch through two buffers that the layers use
+   * in turn, since only the input and the output of the current layer are
+   * needed; and EvaluateWithGradient(), which must keep the outputs of all
+   * the layers for the backward pass, computes the gradient of each layer as
+   * soon as its error is known, so that the errors also go through two
+   * buffers.  The buffers are planned from the sizes seen on the first batch,
+   * which is processed as usual.  After Predict(), only the output of the last
+   * layer is kept.
+   */
+  bool& ReuseBuffers() { return reuseBuffers; }
+
+  /**
+   * Estimate the memory taken by the outputs and the errors of the layers
+   * when a batch of the given size goes through the network, taking
+   * ReuseBuffers() into account.  The sizes of the layers are found by passing
+   * the first point of the given data through the network in deterministic
+   * mode.
+   *
+   * @param input Data the network will be used on.
+   * @param batchSize Number of points in a batch.
+   * @param training If true, estimate the memory needed for training (the
+   *     outputs and the errors of the layers); otherwise, the memory needed
+   *     for prediction (the outputs of the layers).
+   * @return The estimated peak memory, in bytes.
+   */
+  size_t PeakMemory(const arma::mat& input,
+                    const size_t batchSize,
+                    const bool training);
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -415,6 +549,39 @@ class FFN
   template<typename InputType>
   void Gradient(const InputType& input);
 
+  /**
+   * Run the backward pass and compute the gradient of each layer as soon as
+   * its error is known, so that the error of a layer is no longer needed once
+   * the error of the layer before it is computed.  This is the same as
+   * Backward() followed by Gradient(), and is used when the errors go through
+   * the shared buffers.
+   */
+  template<typename InputType>
+  void BackwardGradient(const InputType& input);
+
+  /**
+   * Make the outputs (or the errors) of the layers alias the two shared
+   * buffers, layer i using buffer i % 2, for a batch of the given size.
+   *
+   * @param sizes Number of elements of the output (or error) of each layer,
+   *     per point.
+   * @param batchSize Number of points in the batch.
+   * @param errors Whether to alias the errors instead of the outputs.
+   */
+  void AliasBuffers(const std::vector<size_t>& sizes,
+                    const size_t batchSize,
+                    const bool errors);
+
+  //! Record the number of elements per point of the outputs (or the errors)
+  //! of the layers, after a batch of the given size.
+  void RecordSizes(std::vector<size_t>& sizes,
+                   const size_t batchSize,
+                   const bool errors);
+
+  //! Stop the outputs (or the errors) of the layers from aliasing the shared
+  //! buffers; only the output of the last layer is kept.
+  void ReleaseBuffers(const bool errors);
+
   /**
    * Reset the module status by setting the current deterministic parameter
    * for all modules that implement the Deterministic function.
@@ -426,6 +593,35 @@ class FFN
    */
   void ResetGradients(arma::mat& gradient);
 
+  /**
+   * Evaluate the network and its gradient on the given batch, splitting the
+   * batch across numThreads replicas of the network.
+   *
+   * @param begin Index of the first point of the batch.
+   * @param gradient Matrix to output gradient into.
+   * @param batchSize Number of points in the batch.
+   */
+  double ParallelEvaluateWithGradient(const size_t begin,
+                                      arma::mat& gradient,
+                                      const size_t batchSize);
+
+  //! Delete the replicas used by ParallelEvaluateWithGradient().
+  void DeleteReplicas();
+
+  /**
+   * Replace the layers of the network with the given layers, and pack the
+   * parameters of the new layers.  Each new layer takes the weights of the
+   * layer of the current network given in origins (which must have the same
+   * number of weights), or keeps zero weights if its origin is not an index
+   * of the current network.  Layers of the current network that are not the
+   * origin of a new layer are deleted.
+   *
+   * @param layers New layers of the network.
+   * @param origins Index in the current network of each new layer.
+   */
+  void ReplaceLayers(std::vector<LayerTypes<CustomLayers...> >& layers,
+                     const std::vector<size_t>& origins);
+
   /**
    * Swap the content of this network with given network.
    *
@@ -509,6 +705,25 @@ class FFN
   //! Locally-stored copy visitor
   CopyVisitor<CustomLayers...> copyVisitor;
 
+  //! The number of threads used to compute the gradient of a batch.
+  size_t numThreads;
+
+  //! Replicas of the network that share its parameters, one for each thread.
+  std::vector<FFN*> replicas;
+
+  //! The gradient computed by each replica.
+  std::vector<arma::mat> replicaGradients;
+
+  //! Whether the layers share buffers for their outputs and errors.
+  bool reuseBuffers;
+
+  //! The two buffers shared by the outputs or the errors of the layers.
+  std::vector<arma::vec> buffers;
+
+  //! The number of elements per point of the error of each layer, for the
+  //! shared buffers.
+  std::vector<size_t> errorSizes;
+
   // The GAN class should have access to internal members.
   template<
     typename Model,
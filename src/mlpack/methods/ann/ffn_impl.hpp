@@ -22,6 +22,7 @@
 #include "visitor/gradient_visitor.hpp"
 #include "visitor/set_input_height_visitor.hpp"
 #include "visitor/set_input_width_visitor.hpp"
+#include "visitor/weight_set_visitor.hpp"
 
 #include "util/check_input_shape.hpp"
 
@@ -39,7 +40,9 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     height(0),
     reset(false),
     numFunctions(0),
-    deterministic(false)
+    deterministic(false),
+    numThreads(1),
+    reuseBuffers(false)
 {
   /* Nothing to do here. */
 }
@@ -48,6 +51,7 @@ template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::~FFN()
 {
+  DeleteReplicas();
   std::for_each(network.begin(), network.end(),
       boost::apply_visitor(deleteVisitor));
 }
@@ -119,6 +123,13 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
 
   WarnMessageMaxIterations<OptimizerType>(optimizer, this->predictors.n_cols);
 
+  if (reuseBuffers)
+  {
+    Log::Info << "FFN::Train(): the outputs and errors of the layers take "
+        << "about " << PeakMemory(this->predictors, 1, true) << " bytes for "
+        << "each point of a batch." << std::endl;
+  }
+
   // Train the model.
   Timer::Start("ffn_optimization");
   const double out = optimizer.Optimize(*this, parameter, callbacks...);
@@ -157,6 +168,34 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
   return out;
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType, typename... CallbackTypes>
+double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
+    data::DataPipeline<arma::mat, arma::mat>& pipeline,
+    OptimizerType& optimizer,
+    const size_t epochs,
+    CallbackTypes&&... callbacks)
+{
+  double out = 0.0;
+  arma::mat predictors, responses;
+  for (size_t epoch = 0; epoch < epochs; ++epoch)
+  {
+    // The pipeline starts the first pass when it is created.
+    if (epoch > 0)
+      pipeline.Reset();
+
+    out = 0.0;
+    while (pipeline.Next(predictors, responses))
+    {
+      out += Train(std::move(predictors), std::move(responses), optimizer,
+          callbacks...);
+    }
+  }
+
+  return out;
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename PredictorsType, typename ResponsesType>
@@ -225,12 +264,18 @@ double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Backward(
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
-    arma::mat predictors, arma::mat& results)
+    const arma::mat& predictors, arma::mat& results, const size_t batchSize)
 {
   CheckInputShape<std::vector<LayerTypes<CustomLayers...> > >(network, 
                                                               predictors.n_rows, 
                                                               "FFN<>::Predict()");
 
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("FFN<>::Predict(): batchSize must be greater "
+        "than 0");
+  }
+
   if (parameter.is_empty())
     ResetParameters();
 
@@ -240,22 +285,44 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
     ResetDeterministic();
   }
 
-  arma::mat resultsTemp;
-  Forward(arma::mat(predictors.colptr(0), predictors.n_rows, 1, false, true));
-  resultsTemp = boost::apply_visitor(outputParameterVisitor,
-      network.back()).col(0);
-
-  results = arma::mat(resultsTemp.n_elem, predictors.n_cols);
-  results.col(0) = resultsTemp.col(0);
+  if (predictors.n_cols == 0)
+  {
+    results.set_size(0, 0);
+    return;
+  }
 
-  for (size_t i = 1; i < predictors.n_cols; ++i)
+  // With shared buffers, the outputs of the layers go through two buffers
+  // sized from the first batch.
+  const bool shareOutputs = reuseBuffers && network.size() > 1;
+  std::vector<size_t> outputSizes;
+  for (size_t i = 0; i < predictors.n_cols; i += batchSize)
   {
-    Forward(arma::mat(predictors.colptr(i), predictors.n_rows, 1, false, true));
+    const size_t effectiveBatchSize = std::min(batchSize,
+        size_t(predictors.n_cols - i));
+
+    if (shareOutputs && i > 0)
+      AliasBuffers(outputSizes, effectiveBatchSize, false);
 
-    resultsTemp = boost::apply_visitor(outputParameterVisitor,
+    // Alias the batch instead of copying it; Forward() only reads its input.
+    Forward(arma::mat(const_cast<double*>(predictors.colptr(i)),
+        predictors.n_rows, effectiveBatchSize, false, true));
+
+    const arma::mat& output = boost::apply_visitor(outputParameterVisitor,
         network.back());
-    results.col(i) = resultsTemp.col(0);
+
+    // The output dimensionality is only known after the first batch.
+    if (i == 0)
+    {
+      results.set_size(output.n_rows, predictors.n_cols);
+      if (shareOutputs)
+        RecordSizes(outputSizes, effectiveBatchSize, false);
+    }
+
+    results.cols(i, i + effectiveBatchSize - 1) = output;
   }
+
+  if (shareOutputs)
+    ReleaseBuffers(false);
 }
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -374,6 +441,9 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     gradient.zeros();
   }
 
+  if (numThreads > 1 && batchSize > 1)
+    return ParallelEvaluateWithGradient(begin, gradient, batchSize);
+
   if (this->deterministic)
   {
     this->deterministic = false;
@@ -395,13 +465,147 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
       responses.cols(begin, begin + batchSize - 1),
       error);
 
-  Backward();
-  ResetGradients(gradient);
-  Gradient(predictors.cols(begin, begin + batchSize - 1));
+  // With shared buffers, the errors of the layers go through two buffers once
+  // their sizes are known.
+  if (reuseBuffers && network.size() > 1 &&
+      errorSizes.size() == network.size())
+  {
+    AliasBuffers(errorSizes, batchSize, true);
+    ResetGradients(gradient);
+    BackwardGradient(predictors.cols(begin, begin + batchSize - 1));
+    ReleaseBuffers(true);
+  }
+  else
+  {
+    Backward();
+    ResetGradients(gradient);
+    Gradient(predictors.cols(begin, begin + batchSize - 1));
+
+    if (reuseBuffers && network.size() > 1)
+      RecordSizes(errorSizes, batchSize, true);
+  }
+
+  return res;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::
+ParallelEvaluateWithGradient(const size_t begin,
+                             arma::mat& gradient,
+                             const size_t batchSize)
+{
+  const size_t threads = std::min(numThreads, batchSize);
+
+  // (Re)build the replicas if the parameters have been reallocated or layers
+  // have been added since they were built.
+  if (replicas.size() < threads || replicas[0]->parameter.memptr() !=
+      parameter.memptr() || replicas[0]->network.size() != network.size())
+  {
+    DeleteReplicas();
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+      replicas.push_back(new FFN());
+      replicas.back()->ShareParameters(*this);
+    }
+    replicaGradients.resize(numThreads);
+  }
+
+  // Thread t handles the points [partBegins[t], partBegins[t + 1]) of the
+  // batch, and weights[t] is its fraction of the batch.
+  std::vector<size_t> partBegins(threads + 1);
+  arma::vec weights(threads);
+  for (size_t t = 0; t <= threads; ++t)
+    partBegins[t] = (t * batchSize) / threads;
+  for (size_t t = 0; t < threads; ++t)
+    weights[t] = (double) (partBegins[t + 1] - partBegins[t]) / batchSize;
+
+  // The replicas only read the data, so they can alias it.  First each
+  // replica passes its part of the batch forward.
+  #pragma omp parallel for num_threads(threads)
+  for (omp_size_t t = 0; t < (omp_size_t) threads; ++t)
+  {
+    FFN& replica = *replicas[t];
+    replica.predictors = arma::mat(predictors.memptr(), predictors.n_rows,
+        predictors.n_cols, false, true);
+    if (replica.deterministic)
+    {
+      replica.deterministic = false;
+      replica.ResetDeterministic();
+    }
+
+    replica.Forward(replica.predictors.cols(begin + partBegins[t],
+        begin + partBegins[t + 1] - 1));
+  }
+
+  // The output layer sees the whole batch, so the loss and its error are
+  // reduced (summed or averaged) over the batch as without threads.
+  arma::mat output;
+  for (size_t t = 0; t < threads; ++t)
+  {
+    output = arma::join_rows(output, boost::apply_visitor(
+        outputParameterVisitor, replicas[t]->network.back()));
+  }
+  const arma::mat batchResponses = responses.cols(begin,
+      begin + batchSize - 1);
+  double res = outputLayer.Forward(output, batchResponses);
+  outputLayer.Backward(output, batchResponses, error);
+
+  // Each replica's part of the error is scaled by batchSize / partSize, and its
+  // gradient by partSize / batchSize.  So the error terms of the gradients add
+  // up as for one pass over the batch, and the terms that each replica adds
+  // once (layer losses and regularizers) are averaged over the replicas.
+  #pragma omp parallel for num_threads(threads)
+  for (omp_size_t t = 0; t < (omp_size_t) threads; ++t)
+  {
+    FFN& replica = *replicas[t];
+    replica.error = error.cols(partBegins[t], partBegins[t + 1] - 1) /
+        weights[t];
+    if (replicaGradients[t].n_elem != parameter.n_elem)
+      replicaGradients[t].zeros(parameter.n_rows, parameter.n_cols);
+    else
+      replicaGradients[t].zeros();
+
+    replica.Backward();
+    replica.ResetGradients(replicaGradients[t]);
+    replica.Gradient(replica.predictors.cols(begin + partBegins[t],
+        begin + partBegins[t + 1] - 1));
+  }
+
+  for (size_t t = 0; t < threads; ++t)
+  {
+    for (size_t i = 0; i < network.size(); ++i)
+    {
+      res += weights[t] * boost::apply_visitor(lossVisitor,
+          replicas[t]->network[i]);
+    }
+  }
+
+  // Sum the weighted gradients of the replicas.  Each thread sums its own
+  // range of the parameters, so no locking is needed.
+  #pragma omp parallel for num_threads(threads)
+  for (omp_size_t i = 0; i < (omp_size_t) gradient.n_elem; ++i)
+  {
+    double sum = 0;
+    for (size_t t = 0; t < threads; ++t)
+      sum += weights[t] * replicaGradients[t][i];
+    gradient[i] = sum;
+  }
 
   return res;
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::DeleteReplicas()
+{
+  for (size_t t = 0; t < replicas.size(); ++t)
+    delete replicas[t];
+  replicas.clear();
+  replicaGradients.clear();
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Gradient(
@@ -425,6 +629,7 @@ template<typename OutputLayerType, typename InitializationRuleType,
 void FFN<OutputLayerType, InitializationRuleType,
          CustomLayers...>::ResetParameters()
 {
+  DeleteReplicas();
   ResetDeterministic();
 
   // Reset the network parameter with the given initialization rule.
@@ -433,6 +638,205 @@ void FFN<OutputLayerType, InitializationRuleType,
   networkInit.Initialize(network, parameter);
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ShareParameters(FFN& network)
+{
+  if (&network == this)
+    return;
+
+  if (network.parameter.is_empty())
+    network.ResetParameters();
+
+  std::for_each(this->network.begin(), this->network.end(),
+      boost::apply_visitor(deleteVisitor));
+  this->network.clear();
+
+  outputLayer = network.outputLayer;
+  initializeRule = network.initializeRule;
+  width = network.width;
+  height = network.height;
+  reset = network.reset;
+  numFunctions = 0;
+  predictors.reset();
+  responses.reset();
+  error.reset();
+  delta.reset();
+  inputParameter.reset();
+  outputParameter.reset();
+  gradient.reset();
+
+  // Alias the parameters of the other network.  Each layer is copied and then
+  // immediately pointed at the shared parameters, so that at most one layer's
+  // weights are ever held twice.
+  parameter = arma::mat(network.parameter.memptr(), network.parameter.n_rows,
+      network.parameter.n_cols, false, true);
+
+  size_t offset = 0;
+  for (size_t i = 0; i < network.network.size(); ++i)
+  {
+    this->network.push_back(boost::apply_visitor(copyVisitor,
+        network.network[i]));
+    offset += boost::apply_visitor(WeightSetVisitor(parameter, offset),
+        this->network.back());
+    boost::apply_visitor(resetVisitor, this->network.back());
+  }
+
+  deterministic = true;
+  ResetDeterministic();
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+size_t FFN<OutputLayerType, InitializationRuleType,
+           CustomLayers...>::FoldBatchNorm()
+{
+  if (parameter.is_empty())
+    ResetParameters();
+
+  // Fold each BatchNorm layer into the layer before it, when possible.
+  std::vector<bool> folded(network.size(), false);
+  size_t numFolded = 0;
+  for (size_t i = 1; i < network.size(); ++i)
+  {
+    BatchNorm<>** batchNorm = boost::get<BatchNorm<>*>(&network[i]);
+    if (batchNorm && boost::apply_visitor(
+        FoldBatchNormVisitor(**batchNorm), network[i - 1]))
+    {
+      folded[i] = true;
+      ++numFolded;
+    }
+  }
+
+  if (numFolded == 0)
+    return 0;
+
+  // Remove the folded layers.
+  std::vector<LayerTypes<CustomLayers...> > layers;
+  std::vector<size_t> origins;
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    if (!folded[i])
+    {
+      layers.push_back(network[i]);
+      origins.push_back(i);
+    }
+  }
+
+  ReplaceLayers(layers, origins);
+  return numFolded;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+size_t FFN<OutputLayerType, InitializationRuleType,
+           CustomLayers...>::SparsifyLinear(const double maxDensity)
+{
+  if (parameter.is_empty())
+    ResetParameters();
+
+  std::vector<LayerTypes<CustomLayers...> > layers;
+  std::vector<size_t> origins;
+  size_t numSparsified = 0;
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    Linear<>** linear = boost::get<Linear<>*>(&network[i]);
+    if (linear)
+    {
+      SparseLinear<>* sparse = new SparseLinear<>(**linear);
+      if (sparse->NonZeros() <= maxDensity * (*linear)->InputSize() *
+          (*linear)->OutputSize())
+      {
+        // The sparse layer has no trainable weights.
+        layers.push_back(sparse);
+        origins.push_back(network.size());
+        ++numSparsified;
+        continue;
+      }
+
+      delete sparse;
+    }
+
+    layers.push_back(network[i]);
+    origins.push_back(i);
+  }
+
+  if (numSparsified > 0)
+    ReplaceLayers(layers, origins);
+
+  return numSparsified;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::
+ReplaceLayers(std::vector<LayerTypes<CustomLayers...> >& layers,
+              const std::vector<size_t>& origins)
+{
+  DeleteReplicas();
+  errorSizes.clear();
+
+  // Find the weights of each layer of the current network.
+  std::vector<size_t> offsets(network.size() + 1, 0);
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    offsets[i + 1] = offsets[i] + boost::apply_visitor(weightSizeVisitor,
+        network[i]);
+  }
+
+  // Pack the weights of the new layers.
+  std::vector<bool> kept(network.size(), false);
+  std::vector<size_t> sizes(layers.size());
+  size_t size = 0;
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    sizes[i] = boost::apply_visitor(weightSizeVisitor, layers[i]);
+    size += sizes[i];
+  }
+
+  arma::mat weights(size, 1, arma::fill::zeros);
+  size_t offset = 0;
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    if (origins[i] < network.size())
+    {
+      kept[origins[i]] = true;
+      if (sizes[i] > 0)
+      {
+        weights.rows(offset, offset + sizes[i] - 1) = parameter.rows(
+            offsets[origins[i]], offsets[origins[i]] + sizes[i] - 1);
+      }
+    }
+
+    offset += sizes[i];
+  }
+
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    if (!kept[i])
+      boost::apply_visitor(deleteVisitor, network[i]);
+  }
+
+  // Point the new layers at the new parameters.  Resetting a layer may
+  // initialize some of its weights, so the weights are restored afterwards.
+  network = std::move(layers);
+  parameter.set_size(size, 1);
+  offset = 0;
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    offset += boost::apply_visitor(WeightSetVisitor(parameter, offset),
+        network[i]);
+    boost::apply_visitor(resetVisitor, network[i]);
+  }
+
+  if (size > 0)
+    parameter = weights;
+
+  deterministic = true;
+  ResetDeterministic();
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void FFN<OutputLayerType, InitializationRuleType,
@@ -553,6 +957,179 @@ void FFN<OutputLayerType, InitializationRuleType,
       network[network.size() - 1]);
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename InputType>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::BackwardGradient(const InputType& input)
+{
+  const size_t n = network.size();
+  boost::apply_visitor(BackwardVisitor(boost::apply_visitor(
+      outputParameterVisitor, network.back()), error,
+      boost::apply_visitor(deltaVisitor, network.back())), network.back());
+  boost::apply_visitor(GradientVisitor(boost::apply_visitor(
+      outputParameterVisitor, network[n - 2]), error), network.back());
+
+  // Once the error of layer i and the gradient of layer i are computed, the
+  // error of layer i + 1 is no longer needed, and its buffer can be used for
+  // the error of layer i - 1.
+  for (size_t i = n - 2; i > 0; --i)
+  {
+    boost::apply_visitor(BackwardVisitor(boost::apply_visitor(
+        outputParameterVisitor, network[i]),
+        boost::apply_visitor(deltaVisitor, network[i + 1]),
+        boost::apply_visitor(deltaVisitor, network[i])), network[i]);
+    boost::apply_visitor(GradientVisitor(boost::apply_visitor(
+        outputParameterVisitor, network[i - 1]),
+        boost::apply_visitor(deltaVisitor, network[i + 1])), network[i]);
+  }
+
+  boost::apply_visitor(GradientVisitor(input,
+      boost::apply_visitor(deltaVisitor, network[1])), network.front());
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::AliasBuffers(const std::vector<size_t>& sizes,
+                                        const size_t batchSize,
+                                        const bool errors)
+{
+  // The first layer has no error.
+  const size_t first = errors ? 1 : 0;
+
+  buffers.resize(2);
+  size_t needed[2] = { 0, 0 };
+  for (size_t i = first; i < network.size(); ++i)
+    needed[i % 2] = std::max(needed[i % 2], sizes[i] * batchSize);
+
+  // No layer aliases the buffers at this point, so they can be reallocated.
+  for (size_t b = 0; b < 2; ++b)
+  {
+    if (buffers[b].n_elem < needed[b])
+      buffers[b].set_size(needed[b]);
+  }
+
+  // If a layer produces a matrix of another size than planned, it simply
+  // allocates its own memory.
+  for (size_t i = first; i < network.size(); ++i)
+  {
+    arma::mat& m = errors ? boost::apply_visitor(deltaVisitor, network[i]) :
+        boost::apply_visitor(outputParameterVisitor, network[i]);
+    m = arma::mat(buffers[i % 2].memptr(), sizes[i], batchSize, false, false);
+  }
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::RecordSizes(std::vector<size_t>& sizes,
+                                       const size_t batchSize,
+                                       const bool errors)
+{
+  sizes.assign(network.size(), 0);
+  for (size_t i = (errors ? 1 : 0); i < network.size(); ++i)
+  {
+    const arma::mat& m = errors ?
+        boost::apply_visitor(deltaVisitor, network[i]) :
+        boost::apply_visitor(outputParameterVisitor, network[i]);
+    sizes[i] = m.n_elem / batchSize;
+  }
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ReleaseBuffers(const bool errors)
+{
+  for (size_t i = (errors ? 1 : 0); i < network.size(); ++i)
+  {
+    arma::mat& m = errors ? boost::apply_visitor(deltaVisitor, network[i]) :
+        boost::apply_visitor(outputParameterVisitor, network[i]);
+    if (!errors && i == network.size() - 1)
+    {
+      // Keep a copy of the output of the network.
+      arma::mat output(m);
+      m.reset();
+      m = std::move(output);
+    }
+    else
+    {
+      m.reset();
+    }
+  }
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+size_t FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::
+PeakMemory(const arma::mat& input, const size_t batchSize, const bool training)
+{
+  CheckInputShape<std::vector<LayerTypes<CustomLayers...> > >(network,
+      input.n_rows, "FFN<>::PeakMemory()");
+
+  if (input.n_cols == 0 || network.empty())
+    return 0;
+
+  if (parameter.is_empty())
+    ResetParameters();
+
+  // Find the sizes of the outputs of the layers with one point.
+  const bool oldDeterministic = deterministic;
+  if (!deterministic)
+  {
+    deterministic = true;
+    ResetDeterministic();
+  }
+
+  Forward(arma::mat(const_cast<double*>(input.colptr(0)), input.n_rows, 1,
+      false, true));
+  std::vector<size_t> outputSizes;
+  RecordSizes(outputSizes, 1, false);
+
+  if (oldDeterministic != deterministic)
+  {
+    deterministic = oldDeterministic;
+    ResetDeterministic();
+  }
+
+  // With shared buffers, each buffer must hold the largest matrix of the
+  // layers that use it.
+  size_t elements = 0;
+  size_t largest[2] = { 0, 0 };
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    elements += outputSizes[i];
+    largest[i % 2] = std::max(largest[i % 2], outputSizes[i]);
+  }
+
+  if (!training)
+  {
+    if (reuseBuffers && network.size() > 1)
+      elements = largest[0] + largest[1];
+  }
+  else
+  {
+    // The error of the output layer, and the error of each layer but the
+    // first, which has the size of its input.
+    elements += outputSizes.back();
+    size_t errorElements = 0;
+    size_t largestError[2] = { 0, 0 };
+    for (size_t i = 1; i < network.size(); ++i)
+    {
+      errorElements += outputSizes[i - 1];
+      largestError[i % 2] = std::max(largestError[i % 2],
+          outputSizes[i - 1]);
+    }
+
+    if (reuseBuffers)
+      errorElements = largestError[0] + largestError[1];
+    elements += errorElements;
+  }
+
+  return elements * batchSize * sizeof(double);
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename Archive>
@@ -613,6 +1190,15 @@ void FFN<OutputLayerType, InitializationRuleType,
   std::swap(inputParameter, network.inputParameter);
   std::swap(outputParameter, network.outputParameter);
   std::swap(gradient, network.gradient);
+  std::swap(numThreads, network.numThreads);
+  std::swap(reuseBuffers, network.reuseBuffers);
+  std::swap(buffers, network.buffers);
+  std::swap(errorSizes, network.errorSizes);
+
+  // The replicas alias the parameters of their network, so they can't follow
+  // the swap.
+  DeleteReplicas();
+  network.DeleteReplicas();
 };
 
 template<typename OutputLayerType, typename InitializationRuleType,
@@ -633,7 +1219,9 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     delta(network.delta),
     inputParameter(network.inputParameter),
     outputParameter(network.outputParameter),
-    gradient(network.gradient)
+    gradient(network.gradient),
+    numThreads(network.numThreads),
+    reuseBuffers(network.reuseBuffers)
 {
   // Build new layers according to source network
   for (size_t i = 0; i < network.network.size(); ++i)
@@ -662,7 +1250,11 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     delta(std::move(network.delta)),
     inputParameter(std::move(network.inputParameter)),
     outputParameter(std::move(network.outputParameter)),
-    gradient(std::move(network.gradient))
+    gradient(std::move(network.gradient)),
+    numThreads(network.numThreads),
+    reuseBuffers(network.reuseBuffers),
+    buffers(std::move(network.buffers)),
+    errorSizes(std::move(network.errorSizes))
 {
   this->network = std::move(network.network);
 };
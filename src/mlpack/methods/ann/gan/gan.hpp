@@ -51,7 +51,10 @@ namespace ann /** Artificial Neural Network. **/ {
  *
  * @tparam Model The class type of Generator and Discriminator.
  * @tparam InitializationRuleType Type of Initializer.
- * @tparam Noise The noise function to use.
+ * @tparam Noise The noise function to use: either a functor that returns one
+ *     noise value, or a functor that fills a whole arma::mat of noise at once
+ *     (which is faster, since the noise of a batch is then generated in one
+ *     vectorized call).
  * @tparam PolicyType The GAN variant to be used (GAN, DCGAN, WGAN or WGANGP).
  */
 template<
@@ -104,7 +107,7 @@ class GAN
    *
    * @param trainData The data points of real distribution.
    */
-  void ResetData(arma::mat trainData);
+  void ResetData(const arma::mat& trainData);
 
   // Reset function.
   void Reset();
@@ -121,7 +124,7 @@ class GAN
    * @return The final objective of the trained model (NaN or Inf on error).
    */
   template<typename OptimizerType, typename... CallbackTypes>
-  double Train(arma::mat trainData,
+  double Train(const arma::mat& trainData,
                OptimizerType& Optimizer,
                CallbackTypes&&... callbacks);
 
@@ -337,6 +340,33 @@ class GAN
   */
   void ResetDeterministic();
 
+  /**
+   * Fill the noise matrix with the noise function, in one call if the noise
+   * function can fill a whole matrix, or one call per element otherwise.
+   */
+  void GenerateNoise() { GenerateNoise(noiseFunction, 0); }
+
+  //! Fill the noise matrix with a noise function that fills whole matrices.
+  template<typename NoiseType>
+  auto GenerateNoise(NoiseType& function, int) ->
+      decltype(function(std::declval<arma::mat&>()), void());
+
+  //! Fill the noise matrix with a noise function that returns one value.
+  template<typename NoiseType>
+  void GenerateNoise(NoiseType& function, long);
+
+  /**
+   * Make sure that realDiscriminator is a replica of the discriminator that
+   * shares its current parameters and reads the training data, so that the
+   * real and the generated batches can be passed through the discriminator at
+   * the same time.
+   *
+   * @return false if the discriminator has layers that keep running
+   *     statistics (BatchNorm), which must see both batches, so the replica
+   *     can't be used.
+   */
+  bool ResetRealDiscriminator();
+
   //! Locally stored parameter for training data + noise data.
   arma::mat predictors;
   //! Locally stored parameters of the network.
@@ -345,6 +375,9 @@ class GAN
   Model generator;
   //! Locally stored Discriminator network.
   Model discriminator;
+  //! Replica of the Discriminator network for the real data (see
+  //! ResetRealDiscriminator()).
+  Model realDiscriminator;
   //! Locally stored Initializer.
   InitializationRuleType initializeRule;
   //! Locally stored Noise function
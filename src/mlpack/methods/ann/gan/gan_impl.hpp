@@ -137,7 +137,7 @@ template<
   typename PolicyType
 >
 void GAN<Model, InitializationRuleType, Noise, PolicyType>::ResetData(
-    arma::mat trainData)
+    const arma::mat& trainData)
 {
   currentBatch = 0;
 
@@ -153,7 +153,7 @@ void GAN<Model, InitializationRuleType, Noise, PolicyType>::ResetData(
    * For more details please look in EvaluateWithGradient() function.
    */
   this->predictors.set_size(trainData.n_rows, numFunctions + batchSize);
-  this->predictors.cols(0, numFunctions - 1) = std::move(trainData);
+  this->predictors.cols(0, numFunctions - 1) = trainData;
   this->discriminator.predictors = arma::mat(this->predictors.memptr(),
       this->predictors.n_rows, this->predictors.n_cols, false, false);
 
@@ -218,11 +218,11 @@ template<
 >
 template<typename OptimizerType, typename... CallbackTypes>
 double GAN<Model, InitializationRuleType, Noise, PolicyType>::Train(
-    arma::mat trainData,
+    const arma::mat& trainData,
     OptimizerType& Optimizer,
     CallbackTypes&&... callbacks)
 {
-  ResetData(std::move(trainData));
+  ResetData(trainData);
 
   return Optimizer.Optimize(*this, parameter, callbacks...);
 }
@@ -263,7 +263,7 @@ GAN<Model, InitializationRuleType, Noise, PolicyType>::Evaluate(
       outputParameterVisitor,
       discriminator.network.back()), currentTarget);
 
-  noise.imbue( [&]() { return noiseFunction();} );
+  GenerateNoise();
   generator.Forward(noise);
 
   predictors.cols(numFunctions, numFunctions + batchSize - 1) =
@@ -334,20 +334,40 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
       gradientGenerator.n_elem,
       discriminator.Parameters().n_elem, 1, false, false);
 
-  // Get the gradients of the Discriminator.
-  double res = discriminator.EvaluateWithGradient(discriminator.parameter,
-      i, gradientDiscriminator, batchSize);
-
-  noise.imbue( [&]() { return noiseFunction();} );
-  generator.Forward(noise);
-  predictors.cols(numFunctions, numFunctions + batchSize - 1) =
-      boost::apply_visitor(outputParameterVisitor, generator.network.back());
-  responses.cols(numFunctions, numFunctions + batchSize - 1) =
-      arma::zeros(1, batchSize);
-
-  // Get the gradients of the Generator.
-  res += discriminator.EvaluateWithGradient(discriminator.parameter,
-      numFunctions, noiseGradientDiscriminator, batchSize);
+  // The gradient of the Discriminator on the real batch is computed by a
+  // replica of the Discriminator, at the same time as the noise is generated
+  // and passed through the Generator and the Discriminator.  This is only safe
+  // if the real batch does not overlap the generated one.
+  Model& realModel = ResetRealDiscriminator() ? realDiscriminator :
+      discriminator;
+  const bool overlap = (&realModel != &discriminator) &&
+      (i + batchSize <= numFunctions);
+  double realRes = 0, fakeRes = 0;
+  #pragma omp parallel for num_threads(2) if (overlap)
+  for (omp_size_t task = 0; task < 2; ++task)
+  {
+    if (task == 0)
+    {
+      // Get the gradients of the Discriminator.
+      realRes = realModel.EvaluateWithGradient(
+          discriminator.parameter, i, gradientDiscriminator, batchSize);
+    }
+    else
+    {
+      GenerateNoise();
+      generator.Forward(noise);
+      predictors.cols(numFunctions, numFunctions + batchSize - 1) =
+          boost::apply_visitor(outputParameterVisitor,
+          generator.network.back());
+      responses.cols(numFunctions, numFunctions + batchSize - 1) =
+          arma::zeros(1, batchSize);
+
+      // Get the gradients of the Generator.
+      fakeRes = discriminator.EvaluateWithGradient(discriminator.parameter,
+          numFunctions, noiseGradientDiscriminator, batchSize);
+    }
+  }
+  double res = realRes + fakeRes;
   gradientDiscriminator += noiseGradientDiscriminator;
 
   if (currentBatch % generatorUpdateStep == 0 && preTrainSize == 0)
@@ -463,6 +483,67 @@ Predict(arma::mat input, arma::mat& output)
       discriminator.network.back());
 }
 
+template<
+  typename Model,
+  typename InitializationRuleType,
+  typename Noise,
+  typename PolicyType
+>
+template<typename NoiseType>
+auto GAN<Model, InitializationRuleType, Noise, PolicyType>::GenerateNoise(
+    NoiseType& function, int) ->
+    decltype(function(std::declval<arma::mat&>()), void())
+{
+  function(noise);
+}
+
+template<
+  typename Model,
+  typename InitializationRuleType,
+  typename Noise,
+  typename PolicyType
+>
+template<typename NoiseType>
+void GAN<Model, InitializationRuleType, Noise, PolicyType>::GenerateNoise(
+    NoiseType& function, long)
+{
+  noise.imbue([&]() { return function(); });
+}
+
+template<
+  typename Model,
+  typename InitializationRuleType,
+  typename Noise,
+  typename PolicyType
+>
+bool GAN<Model, InitializationRuleType, Noise, PolicyType>::
+ResetRealDiscriminator()
+{
+  // Layers that keep running statistics of their input must see both batches,
+  // so then both batches go through the Discriminator itself.
+  for (size_t l = 0; l < discriminator.Model().size(); ++l)
+  {
+    if (boost::get<BatchNorm<>*>(&discriminator.Model()[l]))
+      return false;
+  }
+
+  // Rebuild the replica if the parameters have been reallocated.
+  if (realDiscriminator.Parameters().memptr() !=
+      discriminator.Parameters().memptr() ||
+      realDiscriminator.Model().size() != discriminator.Model().size())
+  {
+    realDiscriminator.ShareParameters(discriminator);
+  }
+
+  // The replica only reads the data, so it can alias it.
+  realDiscriminator.predictors = arma::mat(predictors.memptr(),
+      predictors.n_rows, predictors.n_cols, false, true);
+  realDiscriminator.responses = arma::mat(responses.memptr(),
+      responses.n_rows, responses.n_cols, false, true);
+
+  return true;
+}
+
 template<
   typename Model,
   typename InitializationRuleType,
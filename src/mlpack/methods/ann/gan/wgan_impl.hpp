@@ -56,7 +56,7 @@ GAN<Model, InitializationRuleType, Noise, PolicyType>::Evaluate(
       outputParameterVisitor,
       discriminator.network.back()), currentTarget);
 
-  noise.imbue( [&]() { return noiseFunction();} );
+  GenerateNoise();
   generator.Forward(noise);
 
   predictors.cols(numFunctions, numFunctions + batchSize - 1) =
@@ -131,7 +131,7 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   double res = discriminator.EvaluateWithGradient(discriminator.parameter,
       i, gradientDiscriminator, batchSize);
 
-  noise.imbue( [&]() { return noiseFunction();} );
+  GenerateNoise();
   generator.Forward(noise);
   predictors.cols(numFunctions, numFunctions + batchSize - 1) =
       boost::apply_visitor(outputParameterVisitor, generator.network.back());
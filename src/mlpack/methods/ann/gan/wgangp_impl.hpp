@@ -57,11 +57,11 @@ GAN<Model, InitializationRuleType, Noise, PolicyType>::Evaluate(
       outputParameterVisitor,
       discriminator.network.back())), std::move(currentTarget));
 
-  noise.imbue( [&]() { return noiseFunction();} );
+  GenerateNoise();
   generator.Forward(std::move(noise));
 
-  arma::mat generatedData = boost::apply_visitor(outputParameterVisitor,
-      generator.network.back());
+  const arma::mat& generatedData = boost::apply_visitor(
+      outputParameterVisitor, generator.network.back());
   predictors.cols(numFunctions, numFunctions + batchSize - 1) =
       generatedData;
   discriminator.Forward(std::move(predictors.cols(numFunctions,
@@ -76,10 +76,12 @@ GAN<Model, InitializationRuleType, Noise, PolicyType>::Evaluate(
       outputParameterVisitor,
       discriminator.network.back())), std::move(currentTarget));
 
-  // Gradient Penalty is calculated here.
-  double epsilon = math::Random();
+  // Gradient Penalty is calculated here, on points drawn uniformly between
+  // each real point and a generated point, for the whole batch at once.
+  arma::rowvec epsilon(batchSize);
+  epsilon.imbue([]() { return math::Random(); });
   predictors.cols(numFunctions, numFunctions + batchSize - 1) =
-      (epsilon * currentInput) + ((1.0 - epsilon) * generatedData);
+      generatedData + (currentInput - generatedData).each_row() % epsilon;
   responses.cols(numFunctions, numFunctions + batchSize - 1) =
       -arma::ones(1, batchSize);
   discriminator.Gradient(discriminator.parameter, numFunctions,
@@ -148,15 +150,17 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   double res = discriminator.EvaluateWithGradient(discriminator.parameter,
       i, gradientDiscriminator, batchSize);
 
-  noise.imbue( [&]() { return noiseFunction();} );
+  GenerateNoise();
   generator.Forward(std::move(noise));
-  arma::mat generatedData = boost::apply_visitor(outputParameterVisitor,
-      generator.network.back());
+  const arma::mat& generatedData = boost::apply_visitor(
+      outputParameterVisitor, generator.network.back());
 
-  // Gradient Penalty is calculated here.
-  double epsilon = math::Random();
+  // Gradient Penalty is calculated here, on points drawn uniformly between
+  // each real point and a generated point, for the whole batch at once.
+  arma::rowvec epsilon(batchSize);
+  epsilon.imbue([]() { return math::Random(); });
   predictors.cols(numFunctions, numFunctions + batchSize - 1) =
-      (epsilon * currentInput) + ((1.0 - epsilon) * generatedData);
+      generatedData + (currentInput - generatedData).each_row() % epsilon;
   responses.cols(numFunctions, numFunctions + batchSize - 1) =
       -arma::ones(1, batchSize);
   discriminator.Gradient(discriminator.parameter, numFunctions,
@@ -42,6 +42,10 @@ template<
 class AddMerge
 {
  public:
+  static_assert(std::is_same<InputDataType, arma::mat>::value &&
+      std::is_same<OutputDataType, arma::mat>::value,
+      "AddMerge holds LayerTypes, which only support arma::mat");
+
   /**
    * Create the AddMerge object using the specified parameters.
    *
@@ -17,6 +17,7 @@
 #define MLPACK_METHODS_ANN_LAYER_ALPHA_DROPOUT_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/util/dropout_mask.hpp>
 
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
@@ -107,8 +108,14 @@ class AlphaDropout
   //! Value of alphaDash.
   double AlphaDash() const {return alphaDash; }
 
-  //! Get the mask.
-  OutputDataType const& Mask() const {return mask;}
+  //! Get the mask as a column (ones for the kept elements, zeros for the
+  //! others).
+  OutputDataType Mask() const
+  {
+    OutputDataType m;
+    mask.Unpack(mask.Size(), 1, m);
+    return m;
+  }
 
   //! Modify the probability of setting a value to alphaDash. As
   //! 'a' and 'b' depend on 'ratio', modify them as well.
@@ -132,8 +139,8 @@ class AlphaDropout
   //! Locally-stored output parameter object.
   OutputDataType outputParameter;
 
-  //! Locally-stored mast object.
-  OutputDataType mask;
+  //! Locally-stored mask object (one bit per element).
+  DropoutMask mask;
 
   //! The probability of setting a value to aplhaDash.
   double ratio;
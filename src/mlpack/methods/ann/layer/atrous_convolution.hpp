@@ -52,6 +52,9 @@ template <
 class AtrousConvolution
 {
  public:
+  // Convenience typedefs.
+  typedef typename OutputDataType::elem_type ElemType;
+
   //! Create the AtrousConvolution object.
   AtrousConvolution();
 
@@ -172,14 +175,14 @@ class AtrousConvolution
   OutputDataType& Parameters() { return weights; }
 
   //! Get the weight of the layer.
-  arma::cube const& Weight() const { return weight; }
+  arma::Cube<ElemType> const& Weight() const { return weight; }
   //! Modify the weight of the layer.
-  arma::cube& Weight() { return weight; }
+  arma::Cube<ElemType>& Weight() { return weight; }
 
   //! Get the bias of the layer.
-  arma::mat const& Bias() const { return bias; }
+  OutputDataType const& Bias() const { return bias; }
   //! Modify the bias of the layer.
-  arma::mat& Bias() { return bias; }
+  OutputDataType& Bias() { return bias; }
 
   //! Get the output parameter.
   OutputDataType const& OutputParameter() const { return outputParameter; }
@@ -359,10 +362,10 @@ class AtrousConvolution
   OutputDataType weights;
 
   //! Locally-stored weight object.
-  arma::cube weight;
+  arma::Cube<ElemType> weight;
 
   //! Locally-stored bias term object.
-  arma::mat bias;
+  OutputDataType bias;
 
   //! Locally-stored input width.
   size_t inputWidth;
@@ -383,16 +386,16 @@ class AtrousConvolution
   size_t dilationHeight;
 
   //! Locally-stored transformed output parameter.
-  arma::cube outputTemp;
+  arma::Cube<ElemType> outputTemp;
 
   //! Locally-stored transformed padded input parameter.
-  arma::cube inputPaddedTemp;
+  arma::Cube<ElemType> inputPaddedTemp;
 
   //! Locally-stored transformed error parameter.
-  arma::cube gTemp;
+  arma::Cube<ElemType> gTemp;
 
   //! Locally-stored transformed gradient parameter.
-  arma::cube gradientTemp;
+  arma::Cube<ElemType> gradientTemp;
 
   //! Locally-stored padding layer.
   ann::Padding<> padding;
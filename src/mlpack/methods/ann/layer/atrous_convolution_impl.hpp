@@ -161,9 +161,9 @@ void AtrousConvolution<
     OutputDataType
 >::Reset()
 {
-    weight = arma::cube(weights.memptr(), kernelWidth, kernelHeight,
-        outSize * inSize, false, false);
-    bias = arma::mat(weights.memptr() + weight.n_elem,
+    weight = arma::Cube<ElemType>(weights.memptr(), kernelWidth,
+        kernelHeight, outSize * inSize, false, false);
+    bias = OutputDataType(weights.memptr() + weight.n_elem,
         outSize, 1, false, false);
 }
 
@@ -184,7 +184,7 @@ void AtrousConvolution<
 >::Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output)
 {
   batchSize = input.n_cols;
-  arma::cube inputTemp(const_cast<arma::Mat<eT>&>(input).memptr(),
+  arma::Cube<eT> inputTemp(const_cast<arma::Mat<eT>&>(input).memptr(),
       inputWidth, inputHeight, inSize * batchSize, false, false);
 
   if (padding.PadWLeft() != 0 || padding.PadWRight() != 0 ||
@@ -265,7 +265,7 @@ void AtrousConvolution<
 >::Backward(
     const arma::Mat<eT>& /* input */, const arma::Mat<eT>& gy, arma::Mat<eT>& g)
 {
-  arma::cube mappedError(((arma::Mat<eT>&) gy).memptr(), outputWidth,
+  arma::Cube<eT> mappedError(((arma::Mat<eT>&) gy).memptr(), outputWidth,
       outputHeight, outSize * batchSize, false, false);
 
   g.set_size(inputWidth * inputHeight * inSize, batchSize);
@@ -326,9 +326,9 @@ void AtrousConvolution<
     const arma::Mat<eT>& error,
     arma::Mat<eT>& gradient)
 {
-  arma::cube mappedError(((arma::Mat<eT>&) error).memptr(), outputWidth,
+  arma::Cube<eT> mappedError(((arma::Mat<eT>&) error).memptr(), outputWidth,
       outputHeight, outSize * batchSize, false, false);
-  arma::cube inputTemp(const_cast<arma::Mat<eT>&>(input).memptr(),
+  arma::Cube<eT> inputTemp(const_cast<arma::Mat<eT>&>(input).memptr(),
       inputWidth, inputHeight, inSize * batchSize, false, false);
 
   gradient.set_size(weights.n_elem, 1);
@@ -56,6 +56,9 @@ template <
 class BatchNorm
 {
  public:
+  // Convenience typedefs.
+  typedef typename OutputDataType::elem_type ElemType;
+
   //! Create the BatchNorm object.
   BatchNorm();
 
@@ -230,10 +233,10 @@ class BatchNorm
   OutputDataType outputParameter;
 
   //! Locally-stored normalized input.
-  arma::cube normalized;
+  arma::Cube<ElemType> normalized;
 
   //! Locally-stored zero mean input.
-  arma::cube inputMean;
+  arma::Cube<ElemType> inputMean;
 }; // class BatchNorm
 
 } // namespace ann
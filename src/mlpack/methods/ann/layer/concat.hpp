@@ -45,6 +45,10 @@ template <
 class Concat
 {
  public:
+  static_assert(std::is_same<InputDataType, arma::mat>::value &&
+      std::is_same<OutputDataType, arma::mat>::value,
+      "Concat holds LayerTypes, which only support arma::mat");
+
   /**
    * Create the Concat object using the specified parameters.
    *
@@ -18,6 +18,8 @@
 #include <mlpack/methods/ann/convolution_rules/naive_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/fft_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/svd_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/im2col_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/winograd_convolution.hpp>
 #include <mlpack/core/util/to_lower.hpp>
 
 #include "layer_types.hpp"
@@ -77,6 +79,9 @@ template <
 class Convolution
 {
  public:
+  // Convenience typedefs.
+  typedef typename OutputDataType::elem_type ElemType;
+
   //! Create the Convolution object.
   Convolution();
 
@@ -187,14 +192,14 @@ class Convolution
   OutputDataType& Parameters() { return weights; }
 
   //! Get the weight of the layer.
-  arma::cube const& Weight() const { return weight; }
+  arma::Cube<ElemType> const& Weight() const { return weight; }
   //! Modify the weight of the layer.
-  arma::cube& Weight() { return weight; }
+  arma::Cube<ElemType>& Weight() { return weight; }
 
   //! Get the bias of the layer.
-  arma::mat const& Bias() const { return bias; }
+  OutputDataType const& Bias() const { return bias; }
   //! Modify the bias of the layer.
-  arma::mat& Bias() { return bias; }
+  OutputDataType& Bias() { return bias; }
 
   //! Get the input parameter.
   InputDataType const& InputParameter() const { return inputParameter; }
@@ -325,6 +330,23 @@ class Convolution
    */
   void InitializeSamePadding();
 
+  /**
+   * Whether the given convolution rule is computed with the batched Winograd
+   * functions: that is the case for 3x3 kernels with unit strides, when the
+   * rule is the default NaiveConvolution or a WinogradConvolution.
+   */
+  template<typename ConvolutionRule>
+  bool UseWinograd() const
+  {
+    const bool rule = IsWinogradConvolution<ConvolutionRule>::value ||
+        std::is_same<ConvolutionRule,
+            NaiveConvolution<ValidConvolution> >::value ||
+        std::is_same<ConvolutionRule,
+            NaiveConvolution<FullConvolution> >::value;
+    return rule && WinogradConvolution<>::Supported(kernelWidth, kernelHeight,
+        strideWidth, strideHeight);
+  }
+
   /*
    * Rotates a 3rd-order tensor counterclockwise by 180 degrees.
    *
@@ -391,10 +413,10 @@ class Convolution
   OutputDataType weights;
 
   //! Locally-stored weight object.
-  arma::cube weight;
+  arma::Cube<ElemType> weight;
 
   //! Locally-stored bias term object.
-  arma::mat bias;
+  OutputDataType bias;
 
   //! Locally-stored input width.
   size_t inputWidth;
@@ -409,16 +431,19 @@ class Convolution
   size_t outputHeight;
 
   //! Locally-stored transformed output parameter.
-  arma::cube outputTemp;
+  arma::Cube<ElemType> outputTemp;
 
   //! Locally-stored transformed padded input parameter.
-  arma::cube inputPaddedTemp;
+  arma::Cube<ElemType> inputPaddedTemp;
 
   //! Locally-stored transformed error parameter.
-  arma::cube gTemp;
+  arma::Cube<ElemType> gTemp;
 
   //! Locally-stored transformed gradient parameter.
-  arma::cube gradientTemp;
+  arma::Cube<ElemType> gradientTemp;
+
+  //! Locally-stored Winograd transforms of the filters.
+  arma::Cube<ElemType> winogradFilter;
 
   //! Locally-stored padding layer.
   ann::Padding<> padding;
@@ -152,9 +152,9 @@ void Convolution<
     OutputDataType
 >::Reset()
 {
-    weight = arma::cube(weights.memptr(), kernelWidth, kernelHeight,
-        outSize * inSize, false, false);
-    bias = arma::mat(weights.memptr() + weight.n_elem,
+    weight = arma::Cube<ElemType>(weights.memptr(), kernelWidth,
+        kernelHeight, outSize * inSize, false, false);
+    bias = OutputDataType(weights.memptr() + weight.n_elem,
         outSize, 1, false, false);
 }
 
@@ -175,7 +175,7 @@ void Convolution<
 >::Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output)
 {
   batchSize = input.n_cols;
-  arma::cube inputTemp(const_cast<arma::Mat<eT>&>(input).memptr(),
+  arma::Cube<eT> inputTemp(const_cast<arma::Mat<eT>&>(input).memptr(),
       inputWidth, inputHeight, inSize * batchSize, false, false);
 
   if (padWLeft != 0 || padWRight != 0 || padHTop != 0 || padHBottom != 0)
@@ -199,6 +199,42 @@ void Convolution<
       outSize * batchSize, false, false);
   outputTemp.zeros();
 
+  if (IsIm2ColConvolution<ForwardConvolutionRule>::value)
+  {
+    // Convolve all map pairs of all points with one matrix multiplication.
+    const bool padded = (padWLeft != 0 || padWRight != 0 || padHTop != 0 ||
+        padHBottom != 0);
+    Im2ColConvolution<ValidConvolution>::BatchForward(padded ?
+        inputPaddedTemp : inputTemp, weight, outputTemp, inSize, strideWidth,
+        strideHeight);
+
+    for (size_t outMap = 0; outMap < outSize * batchSize; outMap++)
+      outputTemp.slice(outMap) += bias(outMap % outSize);
+
+    outputWidth = outputTemp.n_rows;
+    outputHeight = outputTemp.n_cols;
+    return;
+  }
+
+  if (UseWinograd<ForwardConvolutionRule>())
+  {
+    // Transform the filters once, and convolve all map pairs of all points
+    // with one matrix multiplication for each element of the Winograd tiles.
+    const bool padded = (padWLeft != 0 || padWRight != 0 || padHTop != 0 ||
+        padHBottom != 0);
+    WinogradConvolution<ValidConvolution>::TransformFilters(weight, inSize,
+        winogradFilter);
+    WinogradConvolution<ValidConvolution>::BatchForward(padded ?
+        inputPaddedTemp : inputTemp, winogradFilter, outputTemp);
+
+    for (size_t outMap = 0; outMap < outSize * batchSize; outMap++)
+      outputTemp.slice(outMap) += bias(outMap % outSize);
+
+    outputWidth = outputTemp.n_rows;
+    outputHeight = outputTemp.n_cols;
+    return;
+  }
+
   for (size_t outMap = 0, outMapIdx = 0, batchCount = 0; outMap <
       outSize * batchSize; outMap++)
   {
@@ -252,7 +288,7 @@ void Convolution<
 >::Backward(
     const arma::Mat<eT>& /* input */, const arma::Mat<eT>& gy, arma::Mat<eT>& g)
 {
-  arma::cube mappedError(((arma::Mat<eT>&) gy).memptr(), outputWidth,
+  arma::Cube<eT> mappedError(((arma::Mat<eT>&) gy).memptr(), outputWidth,
       outputHeight, outSize * batchSize, false, false);
 
   g.set_size(inputWidth * inputHeight * inSize, batchSize);
@@ -260,6 +296,57 @@ void Convolution<
       inSize * batchSize, false, false);
   gTemp.zeros();
 
+  if (IsIm2ColConvolution<BackwardConvolutionRule>::value)
+  {
+    // Propagate the error of all map pairs of all points back with one matrix
+    // multiplication (the transposed convolution of the forward pass).
+    if (padWLeft != 0 || padWRight != 0 || padHTop != 0 || padHBottom != 0)
+    {
+      arma::Cube<eT> gPadded(inputWidth + padWLeft + padWRight,
+          inputHeight + padHTop + padHBottom, inSize * batchSize,
+          arma::fill::zeros);
+      Im2ColConvolution<ValidConvolution>::BatchBackward(mappedError, weight,
+          gPadded, inSize, strideWidth, strideHeight);
+      gTemp = gPadded.tube(padWLeft, padHTop, padWLeft + inputWidth - 1,
+          padHTop + inputHeight - 1);
+    }
+    else
+    {
+      Im2ColConvolution<ValidConvolution>::BatchBackward(mappedError, weight,
+          gTemp, inSize, strideWidth, strideHeight);
+    }
+
+    return;
+  }
+
+  if (UseWinograd<BackwardConvolutionRule>())
+  {
+    // The full convolution with the rotated filters is the valid convolution
+    // of the error padded with two zeros on every side; the rotated filters
+    // map the output maps back to the input maps.
+    arma::Cube<eT> errorPadded(outputWidth + 4, outputHeight + 4,
+        outSize * batchSize, arma::fill::zeros);
+    errorPadded.tube(2, 2, outputWidth + 1, outputHeight + 1) = mappedError;
+    WinogradConvolution<ValidConvolution>::TransformFilters(weight, inSize,
+        winogradFilter, true);
+
+    if (padWLeft != 0 || padWRight != 0 || padHTop != 0 || padHBottom != 0)
+    {
+      arma::Cube<eT> gPadded;
+      WinogradConvolution<ValidConvolution>::BatchForward(errorPadded,
+          winogradFilter, gPadded);
+      gTemp = gPadded.tube(padWLeft, padHTop, padWLeft + inputWidth - 1,
+          padHTop + inputHeight - 1);
+    }
+    else
+    {
+      WinogradConvolution<ValidConvolution>::BatchForward(errorPadded,
+          winogradFilter, gTemp);
+    }
+
+    return;
+  }
+
   for (size_t outMap = 0, outMapIdx = 0, batchCount = 0; outMap <
       outSize * batchSize; outMap++)
   {
@@ -309,9 +396,9 @@ void Convolution<
     const arma::Mat<eT>& error,
     arma::Mat<eT>& gradient)
 {
-  arma::cube mappedError(((arma::Mat<eT>&) error).memptr(), outputWidth,
+  arma::Cube<eT> mappedError(((arma::Mat<eT>&) error).memptr(), outputWidth,
       outputHeight, outSize * batchSize, false, false);
-  arma::cube inputTemp(((arma::Mat<eT>&) input).memptr(), inputWidth,
+  arma::Cube<eT> inputTemp(((arma::Mat<eT>&) input).memptr(), inputWidth,
       inputHeight, inSize * batchSize, false, false);
 
   gradient.set_size(weights.n_elem, 1);
@@ -319,6 +406,26 @@ void Convolution<
       weight.n_cols, weight.n_slices, false, false);
   gradientTemp.zeros();
 
+  if (IsIm2ColConvolution<GradientConvolutionRule>::value)
+  {
+    // Compute the filter gradient of all map pairs, summed over all points,
+    // with one matrix multiplication.
+    const bool padded = (padWLeft != 0 || padWRight != 0 || padHTop != 0 ||
+        padHBottom != 0);
+    Im2ColConvolution<ValidConvolution>::BatchGradient(padded ?
+        inputPaddedTemp : inputTemp, mappedError, gradientTemp, inSize,
+        weight.n_rows, weight.n_cols, strideWidth, strideHeight);
+
+    gradient.rows(weight.n_elem, gradient.n_rows - 1).zeros();
+    for (size_t outMap = 0; outMap < outSize * batchSize; outMap++)
+    {
+      gradient(weight.n_elem + (outMap % outSize)) +=
+          arma::accu(mappedError.slice(outMap));
+    }
+
+    return;
+  }
+
   for (size_t outMap = 0, outMapIdx = 0, batchCount = 0; outMap <
       outSize * batchSize; outMap++)
   {
@@ -15,6 +15,7 @@
 #define MLPACK_METHODS_ANN_LAYER_DROPCONNECT_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/util/dropout_mask.hpp>
 
 #include "layer_types.hpp"
 #include "add_merge.hpp"
@@ -63,6 +64,10 @@ template<
 class DropConnect
 {
  public:
+  static_assert(std::is_same<InputDataType, arma::mat>::value &&
+      std::is_same<OutputDataType, arma::mat>::value,
+      "DropConnect holds LayerTypes, which only support arma::mat");
+
   //! Create the DropConnect object.
   DropConnect();
 
@@ -178,8 +183,8 @@ class DropConnect
   //! Locally-stored output parameter object.
   OutputDataType outputParameter;
 
-  //! Locally-stored mask object.
-  OutputDataType mask;
+  //! Locally-stored mask object (one bit per weight).
+  DropoutMask mask;
 
   //! If true dropout and scaling is disabled, see notes above.
   bool deterministic;
@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_ANN_LAYER_DROPOUT_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/util/dropout_mask.hpp>
 
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
@@ -131,8 +132,8 @@ class Dropout
   //! Locally-stored output parameter object.
   OutputDataType outputParameter;
 
-  //! Locally-stored mast object.
-  OutputDataType mask;
+  //! Locally-stored mask object (one bit per element).
+  DropoutMask mask;
 
   //! The probability of setting a value to zero.
   double ratio;
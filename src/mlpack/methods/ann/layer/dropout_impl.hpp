@@ -93,9 +93,8 @@ void Dropout<InputDataType, OutputDataType>::Forward(
   {
     // Scale with input / (1 - ratio) and set values to zero with probability
     // 'ratio'.
-    mask = arma::randu<arma::Mat<eT> >(input.n_rows, input.n_cols);
-    mask.transform([&](double val) { return (val > ratio); });
-    output = input % mask * scale;
+    mask.Generate(input.n_elem, ratio);
+    mask.Apply(input, output, scale);
   }
 }
 
@@ -106,7 +105,7 @@ void Dropout<InputDataType, OutputDataType>::Backward(
     const arma::Mat<eT>& gy,
     arma::Mat<eT>& g)
 {
-  g = gy % mask * scale;
+  mask.Apply(gy, g, scale);
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -20,7 +20,7 @@ namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
 
 template<typename InputDataType, typename OutputDataType>
-FastLSTM<InputDataType, OutputDataType>::FastLSTM()
+FastLSTM<InputDataType, OutputDataType>::FastLSTM() : projectedEnd(0)
 {
   // Nothing to do here.
 }
@@ -38,7 +38,8 @@ FastLSTM<InputDataType, OutputDataType>::FastLSTM(
     batchStep(0),
     gradientStepIdx(0),
     rhoSize(rho),
-    bpttSteps(0)
+    bpttSteps(0),
+    projectedEnd(0)
 {
   // Weights for: input to gate layer (4 * outsize * inSize + 4 * outsize)
   // and output to gate (4 * outSize).
@@ -59,7 +60,8 @@ FastLSTM<InputDataType, OutputDataType>::FastLSTM(const FastLSTM& layer) :
     gradientStepIdx(layer.gradientStepIdx),
     grad(layer.grad),
     rhoSize(layer.rho),
-    bpttSteps(layer.bpttSteps)
+    bpttSteps(layer.bpttSteps),
+    projectedEnd(0)
 {
   // Nothing to do here.
 }
@@ -78,7 +80,8 @@ FastLSTM<InputDataType, OutputDataType>::FastLSTM(FastLSTM&& layer) :
     gradientStepIdx(std::move(layer.gradientStepIdx)),
     grad(std::move(layer.grad)),
     rhoSize(std::move(layer.rho)),
-    bpttSteps(std::move(layer.bpttSteps))
+    bpttSteps(std::move(layer.bpttSteps)),
+    projectedEnd(0)
 {
   // Nothing to do here.
 }
@@ -102,6 +105,7 @@ FastLSTM<InputDataType, OutputDataType>::operator=(const FastLSTM& layer)
     grad = layer.grad;
     rhoSize = layer.rho;
     bpttSteps = layer.bpttSteps;
+    projectedEnd = 0;
   }
   return *this;
 }
@@ -125,6 +129,7 @@ FastLSTM<InputDataType, OutputDataType>::operator=(FastLSTM&& layer)
     grad = std::move(layer.grad);
     rhoSize = std::move(layer.rho);
     bpttSteps = std::move(layer.bpttSteps);
+    projectedEnd = 0;
   }
   return *this;
 }
@@ -158,6 +163,7 @@ void FastLSTM<InputDataType, OutputDataType>::ResetCell(const size_t size)
 
   bpttSteps = std::min(rho, rhoSize);
   forwardStep = 0;
+  projectedEnd = 0;
   gradientStepIdx = 0;
   backwardStep = batchSize * size - 1;
   gradientStep = batchSize * size - 1;
@@ -193,50 +199,49 @@ void FastLSTM<InputDataType, OutputDataType>::Forward(
     ResetCell(rhoSize);
   }
 
-  gate.cols(forwardStep, forwardStep + batchStep) = input2GateWeight * input +
-      output2GateWeight * outParameter.cols(
-      forwardStep, forwardStep + batchStep);
-  gate.cols(forwardStep, forwardStep + batchStep).each_col() += input2GateBias;
-
-  arma::subview<double> sigmoidOut = gateActivation.cols(forwardStep,
-      forwardStep + batchStep);
-  FastSigmoid(
-      gate.submat(0, forwardStep, 3 * outSize - 1, forwardStep + batchStep),
-      sigmoidOut);
-
-  stateActivation.cols(forwardStep, forwardStep + batchStep) = arma::tanh(
-      gate.submat(3 * outSize, forwardStep, 4 * outSize - 1,
-      forwardStep + batchStep));
-
-  // Update the cell: cmul1 + cmul2
-  // where cmul1 is input gate * hidden state and
-  // cmul2 is forget gate * cell (prevCell).
-  if (forwardStep == 0)
+  // If the input projection of this step was computed by ProjectInputs(),
+  // only the recurrent part is left to add.
+  if (forwardStep + batchStep >= projectedEnd)
+    gate.cols(forwardStep, forwardStep + batchStep) = input2GateWeight * input;
+  gate.cols(forwardStep, forwardStep + batchStep) += output2GateWeight *
+      outParameter.cols(forwardStep, forwardStep + batchStep);
+
+  // Apply the bias and the gate activations and update the cell in a single
+  // pass over each column, writing straight into the per-step buffers.  The
+  // rows of the gates are the input gate, the output gate, the forget gate and
+  // the hidden state, each of size outSize.
+  for (size_t j = forwardStep; j <= forwardStep + batchStep; ++j)
   {
-    cell.cols(forwardStep, forwardStep + batchStep) =
-        gateActivation.submat(0, forwardStep, outSize - 1,
-        forwardStep + batchStep) %
-        stateActivation.cols(forwardStep, forwardStep + batchStep);
-  }
-  else
-  {
-    cell.cols(forwardStep, forwardStep + batchStep) =
-        gateActivation.submat(0, forwardStep, outSize - 1,
-        forwardStep + batchStep) %
-        stateActivation.cols(forwardStep, forwardStep + batchStep) +
-        gateActivation.submat(2 * outSize, forwardStep, 3 * outSize - 1,
-        forwardStep + batchStep) %
-        cell.cols(forwardStep - batchSize, forwardStep - batchSize + batchStep);
+    ElemType* gateCol = gate.colptr(j);
+    ElemType* inputGate = gateActivation.colptr(j);
+    ElemType* outputGate = inputGate + outSize;
+    ElemType* forgetGate = inputGate + 2 * outSize;
+    ElemType* state = stateActivation.colptr(j);
+    ElemType* cellCol = cell.colptr(j);
+    ElemType* cellAct = cellActivation.colptr(j);
+    ElemType* out = outParameter.colptr(j + batchSize);
+    const ElemType* prevCell = (forwardStep == 0) ? NULL :
+        cell.colptr(j - batchSize);
+
+    for (size_t i = 0; i < 4 * outSize; ++i)
+      gateCol[i] += input2GateBias[i];
+
+    for (size_t i = 0; i < 3 * outSize; ++i)
+      inputGate[i] = FastSigmoid(gateCol[i]);
+
+    // Update the cell: input gate * hidden state + forget gate * prevCell.
+    for (size_t i = 0; i < outSize; ++i)
+    {
+      state[i] = std::tanh(gateCol[3 * outSize + i]);
+      cellCol[i] = inputGate[i] * state[i];
+      if (prevCell)
+        cellCol[i] += forgetGate[i] * prevCell[i];
+
+      cellAct[i] = std::tanh(cellCol[i]);
+      out[i] = cellAct[i] * outputGate[i];
+    }
   }
 
-  cellActivation.cols(forwardStep, forwardStep + batchStep) =
-      arma::tanh(cell.cols(forwardStep, forwardStep + batchStep));
-
-  outParameter.cols(forwardStep + batchSize,
-      forwardStep + batchSize + batchStep) = cellActivation.cols(
-      forwardStep, forwardStep + batchStep) % gateActivation.submat(
-      outSize, forwardStep, 2 * outSize - 1, forwardStep + batchStep);
-
   output = OutputType(outParameter.memptr() +
       (forwardStep + batchSize) * outSize, outSize, batchSize, false, false);
 
@@ -244,9 +249,34 @@ void FastLSTM<InputDataType, OutputDataType>::Forward(
   if ((forwardStep / batchSize) == bpttSteps)
   {
     forwardStep = 0;
+    projectedEnd = 0;
   }
 }
 
+template<typename InputDataType, typename OutputDataType>
+template<typename InputType>
+void FastLSTM<InputDataType, OutputDataType>::ProjectInputs(
+    const InputType& input, const size_t batchSize)
+{
+  if (batchSize != this->batchSize)
+  {
+    this->batchSize = batchSize;
+    batchStep = batchSize - 1;
+    ResetCell(rhoSize);
+  }
+
+  // Only the steps left before the BPTT window wraps around can be stored.
+  const size_t end = std::min(forwardStep + input.n_cols,
+      bpttSteps * batchSize);
+  if (end <= forwardStep)
+    return;
+
+  // The biases are added by Forward().
+  gate.cols(forwardStep, end - 1) = input2GateWeight *
+      input.cols(0, end - forwardStep - 1);
+  projectedEnd = end;
+}
+
 template<typename InputDataType, typename OutputDataType>
 template<typename InputType, typename ErrorType, typename GradientType>
 void FastLSTM<InputDataType, OutputDataType>::Backward(
@@ -263,50 +293,47 @@ void FastLSTM<InputDataType, OutputDataType>::Backward(
         false);
   }
 
-  cellActivationError = gyLocal % gateActivation.submat(outSize,
-      backwardStep - batchStep, 2 * outSize - 1, backwardStep) %
-      (1 - arma::pow(cellActivation.cols(backwardStep - batchStep,
-      backwardStep), 2));
-
-  if (gradientStepIdx > 0)
-    cellActivationError += forgetGateError;
+  if (forgetGateError.n_rows != outSize || forgetGateError.n_cols != batchSize)
+    forgetGateError.zeros(outSize, batchSize);
 
-  forgetGateError = gateActivation.submat(2 * outSize,
-      backwardStep - batchStep, 3 * outSize - 1, backwardStep) %
-      cellActivationError;
-
-  if (backwardStep > batchStep)
+  // Compute the cell error and the error of each gate in a single pass over
+  // each column of the step, writing into the preallocated prevError.
+  const size_t firstCol = backwardStep - batchStep;
+  for (size_t k = 0; k <= batchStep; ++k)
   {
-    prevError.submat(2 * outSize, 0, 3 * outSize - 1, batchStep) =
-        cell.cols((backwardStep - batchSize) - batchStep,
-        (backwardStep - batchSize)) % cellActivationError %
-        gateActivation.submat(2 * outSize, backwardStep - batchStep,
-        3 * outSize - 1, backwardStep) % (1.0 - gateActivation.submat(
-        2 * outSize, backwardStep - batchStep, 3 * outSize - 1, backwardStep));
+    const size_t j = firstCol + k;
+    const ElemType* inputGate = gateActivation.colptr(j);
+    const ElemType* outputGate = inputGate + outSize;
+    const ElemType* forgetGate = inputGate + 2 * outSize;
+    const ElemType* state = stateActivation.colptr(j);
+    const ElemType* cellAct = cellActivation.colptr(j);
+    const ElemType* prevCell = (backwardStep > batchStep) ?
+        cell.colptr(j - batchSize) : NULL;
+    const ElemType* error = gyLocal.colptr(k);
+    ElemType* cellError = cellActivationError.colptr(k);
+    ElemType* forgetError = forgetGateError.colptr(k);
+    ElemType* inputGateError = prevError.colptr(k);
+    ElemType* outputGateError = inputGateError + outSize;
+    ElemType* forgetGateErrorOut = inputGateError + 2 * outSize;
+    ElemType* stateError = inputGateError + 3 * outSize;
+
+    for (size_t i = 0; i < outSize; ++i)
+    {
+      ElemType c = error[i] * outputGate[i] * (1 - cellAct[i] * cellAct[i]);
+      if (gradientStepIdx > 0)
+        c += forgetError[i];
+
+      cellError[i] = c;
+      forgetError[i] = forgetGate[i] * c;
+
+      forgetGateErrorOut[i] = prevCell ? (prevCell[i] * c * forgetGate[i] *
+          (1.0 - forgetGate[i])) : 0.0;
+      inputGateError[i] = state[i] * c * inputGate[i] * (1.0 - inputGate[i]);
+      stateError[i] = inputGate[i] * c * (1 - state[i] * state[i]);
+      outputGateError[i] = cellAct[i] * error[i] * outputGate[i] *
+          (1.0 - outputGate[i]);
+    }
   }
-  else
-  {
-    prevError.submat(2 * outSize, 0, 3 * outSize - 1, batchStep).zeros();
-  }
-
-  prevError.submat(0, 0, outSize - 1, batchStep) =
-      stateActivation.cols(backwardStep - batchStep,
-      backwardStep) % cellActivationError % gateActivation.submat(
-      0, backwardStep - batchStep, outSize - 1, backwardStep) %
-      (1.0 - gateActivation.submat(
-      0, backwardStep - batchStep, outSize - 1, backwardStep));
-
-  prevError.submat(3 * outSize, 0, 4 * outSize - 1, batchStep) =
-      gateActivation.submat(0, backwardStep - batchStep,
-      outSize - 1, backwardStep) % cellActivationError % (1 - arma::pow(
-      stateActivation.cols(backwardStep - batchStep, backwardStep), 2));
-
-  prevError.submat(outSize, 0, 2 * outSize - 1, batchStep) =
-      cellActivation.cols(backwardStep - batchStep,
-      backwardStep) % gyLocal % gateActivation.submat(
-       outSize, backwardStep - batchStep, 2 * outSize - 1, backwardStep) %
-      (1.0 - gateActivation.submat(
-      outSize, backwardStep - batchStep, 2 * outSize - 1, backwardStep));
 
   g = input2GateWeight.t() * prevError;
 
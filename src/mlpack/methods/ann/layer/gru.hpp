@@ -58,6 +58,10 @@ template <
 class GRU
 {
  public:
+  static_assert(std::is_same<InputDataType, arma::mat>::value &&
+      std::is_same<OutputDataType, arma::mat>::value,
+      "GRU holds LayerTypes, which only support arma::mat");
+
   //! Create the GRU object.
   GRU();
 
@@ -82,6 +86,20 @@ class GRU
   template<typename eT>
   void Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output);
 
+  /**
+   * Compute the input projections of the gates for the next steps with one
+   * matrix multiplication, so that the following calls to Forward() only need
+   * to add the recurrent part.  The projections are used by the next
+   * min(steps, remaining BPTT steps) calls to Forward(), which must be given
+   * the same inputs; they are dropped when the cell is reset.
+   *
+   * @param input Inputs of the next steps, one block of batchSize columns for
+   *     each step.
+   * @param batchSize Number of points of each step.
+   */
+  template<typename eT>
+  void ProjectInputs(const arma::Mat<eT>& input, const size_t batchSize);
+
   /**
    * Ordinary feed backward pass of a neural network, calculating the function
    * f(x) by propagating x backwards trough f. Using the results from the feed
@@ -243,6 +261,15 @@ class GRU
   //! If true dropout and scaling is disabled, see notes above.
   bool deterministic;
 
+  //! Locally-stored input projections from ProjectInputs().
+  arma::mat projectedInput;
+
+  //! The first step of the input projections.
+  size_t projectedBegin;
+
+  //! The step after the last step of the input projections.
+  size_t projectedEnd;
+
   //! Locally-stored delta object.
   OutputDataType delta;
 
@@ -24,7 +24,9 @@ namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
 
 template<typename InputDataType, typename OutputDataType>
-GRU<InputDataType, OutputDataType>::GRU()
+GRU<InputDataType, OutputDataType>::GRU() :
+    projectedBegin(0),
+    projectedEnd(0)
 {
   // Nothing to do here.
 }
@@ -41,7 +43,9 @@ GRU<InputDataType, OutputDataType>::GRU(
     forwardStep(0),
     backwardStep(0),
     gradientStep(0),
-    deterministic(false)
+    deterministic(false),
+    projectedBegin(0),
+    projectedEnd(0)
 {
   // Input specific linear layers(for zt, rt, ot).
   input2GateModule = new Linear<>(inSize, 3 * outSize);
@@ -102,10 +106,21 @@ void GRU<InputDataType, OutputDataType>::Forward(
     gradIterator = outParameter.end();
   }
 
-  // Process the input linearly(zt, rt, ot).
-  boost::apply_visitor(ForwardVisitor(input,
-      boost::apply_visitor(outputParameterVisitor, input2GateModule)),
-      input2GateModule);
+  // Process the input linearly(zt, rt, ot), unless that was done by
+  // ProjectInputs().
+  if (forwardStep >= projectedBegin && forwardStep < projectedEnd &&
+      projectedInput.n_cols == (projectedEnd - projectedBegin) * batchSize)
+  {
+    boost::apply_visitor(outputParameterVisitor, input2GateModule) =
+        projectedInput.cols((forwardStep - projectedBegin) * batchSize,
+        (forwardStep - projectedBegin + 1) * batchSize - 1);
+  }
+  else
+  {
+    boost::apply_visitor(ForwardVisitor(input,
+        boost::apply_visitor(outputParameterVisitor, input2GateModule)),
+        input2GateModule);
+  }
 
   // Process the output(zt, rt) linearly.
   boost::apply_visitor(ForwardVisitor(*prevOutput,
@@ -158,6 +173,7 @@ void GRU<InputDataType, OutputDataType>::Forward(
   if (forwardStep == rho)
   {
     forwardStep = 0;
+    projectedEnd = 0;
     if (!deterministic)
     {
       outParameter.emplace_back(allZeros.memptr(),
@@ -191,6 +207,23 @@ void GRU<InputDataType, OutputDataType>::Forward(
   }
 }
 
+template<typename InputDataType, typename OutputDataType>
+template<typename eT>
+void GRU<InputDataType, OutputDataType>::ProjectInputs(
+    const arma::Mat<eT>& input, const size_t batchSize)
+{
+  // Only the steps left before the BPTT window wraps around are projected.
+  const size_t steps = std::min(input.n_cols / batchSize, rho - forwardStep);
+  projectedBegin = forwardStep;
+  projectedEnd = forwardStep + steps;
+  if (steps == 0)
+    return;
+
+  Linear<>& linear = *boost::get<Linear<>*>(input2GateModule);
+  projectedInput = linear.Weight() * input.cols(0, steps * batchSize - 1);
+  projectedInput.each_col() += linear.Bias();
+}
+
 template<typename InputDataType, typename OutputDataType>
 template<typename eT>
 void GRU<InputDataType, OutputDataType>::Backward(
@@ -375,6 +408,8 @@ void GRU<InputDataType, OutputDataType>::ResetCell(const size_t /* size */)
 
   forwardStep = 0;
   backwardStep = 0;
+  projectedBegin = 0;
+  projectedEnd = 0;
 }
 
 template<typename InputDataType, typename OutputDataType>
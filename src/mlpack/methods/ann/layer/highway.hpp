@@ -60,6 +60,10 @@ template <
 class Highway
 {
  public:
+  static_assert(std::is_same<InputDataType, arma::mat>::value &&
+      std::is_same<OutputDataType, arma::mat>::value,
+      "Highway holds LayerTypes, which only support arma::mat");
+
   //! Create the Highway object.
   Highway();
 
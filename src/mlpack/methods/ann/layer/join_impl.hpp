@@ -43,8 +43,8 @@ void Join<InputDataType, OutputDataType>::Backward(
     const arma::Mat<eT>& gy,
     arma::Mat<eT>& g)
 {
-  g = arma::mat(((arma::Mat<eT>&) gy).memptr(), inSizeRows, inSizeCols, false,
-      false);
+  g = arma::Mat<eT>(((arma::Mat<eT>&) gy).memptr(), inSizeRows, inSizeCols,
+      false, false);
 }
 
 template<typename InputDataType, typename OutputDataType>
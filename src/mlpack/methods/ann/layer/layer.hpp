@@ -43,6 +43,7 @@
 #include "layer_types.hpp"
 #include "leaky_relu.hpp"
 #include "linear.hpp"
+#include "linear_activation.hpp"
 #include "linear_no_bias.hpp"
 #include "linear3d.hpp"
 #include "log_softmax.hpp"
@@ -69,6 +70,7 @@
 #include "softshrink.hpp"
 #include "softmax.hpp"
 #include "softmin.hpp"
+#include "sparse_linear.hpp"
 #include "spatial_dropout.hpp"
 #include "subview.hpp"
 #include "transposed_convolution.hpp"
@@ -120,6 +120,11 @@ HAS_MEM_FUNC(Bias, HasBiasCheck);
 // we can use with SFINAE to catch when a type has a MaxIterations() function.
 HAS_MEM_FUNC(MaxIterations, HasMaxIterations);
 
+// This gives us a HasProjectInputsCheck<T, U> type (where U is a function
+// pointer) we can use with SFINAE to catch when a type has a ProjectInputs()
+// function.
+HAS_MEM_FUNC(ProjectInputs, HasProjectInputsCheck);
+
 // This gives us a HasInShapeCheck<T> type we can use with SFINAE to catch when
 // a type has a function named InputShape.
 HAS_ANY_METHOD_FORM(InputShape, HasInputShapeCheck);
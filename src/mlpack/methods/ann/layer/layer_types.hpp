@@ -88,6 +88,12 @@ template<typename InputDataType,
          typename RegularizerType>
 class Linear;
 
+template<typename ActivationFunction,
+         typename InputDataType,
+         typename OutputDataType,
+         typename RegularizerType>
+class LinearActivation;
+
 template<typename InputDataType,
          typename OutputDataType,
          typename Activation>
@@ -107,6 +113,10 @@ template<typename InputDataType,
          typename RegularizerType>
 class Linear3D;
 
+template<typename InputDataType,
+         typename OutputDataType>
+class SparseLinear;
+
 template<typename InputDataType,
          typename OutputDataType
 >
@@ -240,7 +250,12 @@ using MoreTypes = boost::variant<
         RBF<arma::mat, arma::mat, GaussianFunction>*,
         BaseLayer<GaussianFunction, arma::mat, arma::mat>*,
         PositionalEncoding<arma::mat, arma::mat>*,
-        ISRLU<arma::mat, arma::mat>*
+        ISRLU<arma::mat, arma::mat>*,
+        LinearActivation<RectifierFunction, arma::mat, arma::mat,
+            NoRegularizer>*,
+        LinearActivation<LogisticFunction, arma::mat, arma::mat,
+            NoRegularizer>*,
+        SparseLinear<arma::mat, arma::mat>*
 >;
 
 template <typename... CustomLayers>
@@ -0,0 +1,253 @@
+/**
+ * @file methods/ann/layer/linear_activation.hpp
+ *
+ * Definition of the LinearActivation class, a Linear layer fused with an
+ * activation function.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_LINEAR_ACTIVATION_HPP
+#define MLPACK_METHODS_ANN_LAYER_LINEAR_ACTIVATION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/regularizer/no_regularizer.hpp>
+#include <mlpack/methods/ann/activation_functions/logistic_function.hpp>
+#include <mlpack/methods/ann/activation_functions/rectifier_function.hpp>
+
+#include "layer_types.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Implementation of the LinearActivation layer class, which computes the same
+ * function as a Linear layer followed by a BaseLayer with the given activation
+ * function, f(W x + b).  The activation is applied in place on the output of
+ * the linear transformation, and the backward pass scales the error by the
+ * derivative of the activation, computed from the output, without storing the
+ * derivative.  So the layer keeps two matrices of the size of its output
+ * (the output and the scaled error) where a Linear layer followed by an
+ * activation layer keeps four.
+ *
+ * A few convenience typedefs are given:
+ *
+ *  - LinearReLU
+ *  - LinearSigmoid
+ *
+ * @tparam ActivationFunction Activation function applied to the output; its
+ *         derivative must be given in terms of its output, as for BaseLayer.
+ * @tparam InputDataType Type of the input data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ * @tparam OutputDataType Type of the output data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ * @tparam RegularizerType Type of the regularizer applied to the weights.
+ */
+template <
+    class ActivationFunction = RectifierFunction,
+    typename InputDataType = arma::mat,
+    typename OutputDataType = arma::mat,
+    typename RegularizerType = NoRegularizer
+>
+class LinearActivation
+{
+ public:
+  //! Create the LinearActivation object.
+  LinearActivation();
+
+  /**
+   * Create the LinearActivation layer object using the specified number of
+   * units.
+   *
+   * @param inSize The number of input units.
+   * @param outSize The number of output units.
+   * @param regularizer The regularizer to use, optional.
+   */
+  LinearActivation(const size_t inSize,
+                   const size_t outSize,
+                   RegularizerType regularizer = RegularizerType());
+
+  //! Copy constructor.
+  LinearActivation(const LinearActivation& layer);
+
+  //! Move constructor.
+  LinearActivation(LinearActivation&& layer);
+
+  //! Copy assignment operator.
+  LinearActivation& operator=(const LinearActivation& layer);
+
+  //! Move assignment operator.
+  LinearActivation& operator=(LinearActivation&& layer);
+
+  /*
+   * Reset the layer parameter.
+   */
+  void Reset();
+
+  /**
+   * Ordinary feed forward pass of a neural network, evaluating the function
+   * f(W x + b) by propagating the activity forward through f.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  template<typename eT>
+  void Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output);
+
+  /**
+   * Ordinary feed backward pass of a neural network, calculating the function
+   * f(x) by propagating x backwards trough f. Using the results from the feed
+   * forward pass.  The error scaled by the derivative of the activation is
+   * kept for the following call to Gradient().
+   *
+   * @param input The output of the layer in the forward pass.
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  template<typename eT>
+  void Backward(const arma::Mat<eT>& input,
+                const arma::Mat<eT>& gy,
+                arma::Mat<eT>& g);
+
+  /*
+   * Calculate the gradient using the output delta and the input activation.
+   * The error scaled by the derivative of the activation in the last call to
+   * Backward() is used, so Backward() must be called first.
+   *
+   * @param input The input parameter used for calculating the gradient.
+   * @param * (error) The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  template<typename eT>
+  void Gradient(const arma::Mat<eT>& input,
+                const arma::Mat<eT>& /* error */,
+                arma::Mat<eT>& gradient);
+
+  //! Get the parameters.
+  OutputDataType const& Parameters() const { return weights; }
+  //! Modify the parameters.
+  OutputDataType& Parameters() { return weights; }
+
+  //! Get the input parameter.
+  InputDataType const& InputParameter() const { return inputParameter; }
+  //! Modify the input parameter.
+  InputDataType& InputParameter() { return inputParameter; }
+
+  //! Get the output parameter.
+  OutputDataType const& OutputParameter() const { return outputParameter; }
+  //! Modify the output parameter.
+  OutputDataType& OutputParameter() { return outputParameter; }
+
+  //! Get the delta.
+  OutputDataType const& Delta() const { return delta; }
+  //! Modify the delta.
+  OutputDataType& Delta() { return delta; }
+
+  //! Get the input size.
+  size_t InputSize() const { return inSize; }
+
+  //! Get the output size.
+  size_t OutputSize() const { return outSize; }
+
+  //! Get the gradient.
+  OutputDataType const& Gradient() const { return gradient; }
+  //! Modify the gradient.
+  OutputDataType& Gradient() { return gradient; }
+
+  //! Get the weight of the layer.
+  OutputDataType const& Weight() const { return weight; }
+  //! Modify the weight of the layer.
+  OutputDataType& Weight() { return weight; }
+
+  //! Get the bias of the layer.
+  OutputDataType const& Bias() const { return bias; }
+  //! Modify the bias weights of the layer.
+  OutputDataType& Bias() { return bias; }
+
+  //! Get the size of the weights.
+  size_t WeightSize() const
+  {
+    return (inSize * outSize) + outSize;
+  }
+
+  //! Get the shape of the input.
+  size_t InputShape() const
+  {
+    return inSize;
+  }
+
+  /**
+   * Serialize the layer
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored number of input units.
+  size_t inSize;
+
+  //! Locally-stored number of output units.
+  size_t outSize;
+
+  //! Locally-stored weight object.
+  OutputDataType weights;
+
+  //! Locally-stored weight parameters.
+  OutputDataType weight;
+
+  //! Locally-stored bias term parameters.
+  OutputDataType bias;
+
+  //! Locally-stored delta object.
+  OutputDataType delta;
+
+  //! Locally-stored backpropagated error scaled by the derivative of the
+  //! activation.
+  OutputDataType activationError;
+
+  //! Locally-stored gradient object.
+  OutputDataType gradient;
+
+  //! Locally-stored input parameter object.
+  InputDataType inputParameter;
+
+  //! Locally-stored output parameter object.
+  OutputDataType outputParameter;
+
+  //! Locally-stored regularizer object.
+  RegularizerType regularizer;
+}; // class LinearActivation
+
+// Convenience typedefs.
+
+/**
+ * Standard Linear layer fused with a rectified linear unit activation.
+ */
+template <
+    typename InputDataType = arma::mat,
+    typename OutputDataType = arma::mat,
+    typename RegularizerType = NoRegularizer
+>
+using LinearReLU = LinearActivation<
+    RectifierFunction, InputDataType, OutputDataType, RegularizerType>;
+
+/**
+ * Standard Linear layer fused with a sigmoid activation.
+ */
+template <
+    typename InputDataType = arma::mat,
+    typename OutputDataType = arma::mat,
+    typename RegularizerType = NoRegularizer
+>
+using LinearSigmoid = LinearActivation<
+    LogisticFunction, InputDataType, OutputDataType, RegularizerType>;
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "linear_activation_impl.hpp"
+
+#endif
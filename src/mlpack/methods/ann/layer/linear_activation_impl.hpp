@@ -0,0 +1,174 @@
+/**
+ * @file methods/ann/layer/linear_activation_impl.hpp
+ *
+ * Implementation of the LinearActivation class, a Linear layer fused with an
+ * activation function.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_LINEAR_ACTIVATION_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_LINEAR_ACTIVATION_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "linear_activation.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename ActivationFunction, typename InputDataType,
+    typename OutputDataType, typename RegularizerType>
+LinearActivation<ActivationFunction, InputDataType, OutputDataType,
+    RegularizerType>::LinearActivation() :
+    inSize(0),
+    outSize(0)
+{
+  // Nothing to do here.
+}
+
+template<typename ActivationFunction, typename InputDataType,
+    typename OutputDataType, typename RegularizerType>
+LinearActivation<ActivationFunction, InputDataType, OutputDataType,
+    RegularizerType>::LinearActivation(
+    const size_t inSize,
+    const size_t outSize,
+    RegularizerType regularizer) :
+    inSize(inSize),
+    outSize(outSize),
+    regularizer(regularizer)
+{
+  weights.set_size(WeightSize(), 1);
+}
+
+template<typename ActivationFunction, typename InputDataType,
+    typename OutputDataType, typename RegularizerType>
+LinearActivation<ActivationFunction, InputDataType, OutputDataType,
+    RegularizerType>::LinearActivation(const LinearActivation& layer) :
+    inSize(layer.inSize),
+    outSize(layer.outSize),
+    weights(layer.weights),
+    regularizer(layer.regularizer)
+{
+  // Nothing to do here.
+}
+
+template<typename ActivationFunction, typename InputDataType,
+    typename OutputDataType, typename RegularizerType>
+LinearActivation<ActivationFunction, InputDataType, OutputDataType,
+    RegularizerType>::LinearActivation(LinearActivation&& layer) :
+    inSize(layer.inSize),
+    outSize(layer.outSize),
+    weights(std::move(layer.weights)),
+    regularizer(std::move(layer.regularizer))
+{
+  // Nothing to do here.
+}
+
+template<typename ActivationFunction, typename InputDataType,
+    typename OutputDataType, typename RegularizerType>
+LinearActivation<ActivationFunction, InputDataType, OutputDataType,
+    RegularizerType>&
+LinearActivation<ActivationFunction, InputDataType, OutputDataType,
+    RegularizerType>::operator=(const LinearActivation& layer)
+{
+  if (this != &layer)
+  {
+    inSize = layer.inSize;
+    outSize = layer.outSize;
+    weights = layer.weights;
+    regularizer = layer.regularizer;
+  }
+  return *this;
+}
+
+template<typename ActivationFunction, typename InputDataType,
+    typename OutputDataType, typename RegularizerType>
+LinearActivation<ActivationFunction, InputDataType, OutputDataType,
+    RegularizerType>&
+LinearActivation<ActivationFunction, InputDataType, OutputDataType,
+    RegularizerType>::operator=(LinearActivation&& layer)
+{
+  if (this != &layer)
+  {
+    inSize = layer.inSize;
+    outSize = layer.outSize;
+    weights = std::move(layer.weights);
+    regularizer = std::move(layer.regularizer);
+  }
+  return *this;
+}
+
+template<typename ActivationFunction, typename InputDataType,
+    typename OutputDataType, typename RegularizerType>
+void LinearActivation<ActivationFunction, InputDataType, OutputDataType,
+    RegularizerType>::Reset()
+{
+  weight = OutputDataType(weights.memptr(), outSize, inSize, false, false);
+  bias = OutputDataType(weights.memptr() + weight.n_elem,
+      outSize, 1, false, false);
+}
+
+template<typename ActivationFunction, typename InputDataType,
+    typename OutputDataType, typename RegularizerType>
+template<typename eT>
+void LinearActivation<ActivationFunction, InputDataType, OutputDataType,
+    RegularizerType>::Forward(const arma::Mat<eT>& input,
+                              arma::Mat<eT>& output)
+{
+  output = weight * input;
+  output.each_col() += bias;
+
+  // Apply the activation in place, one element at a time, so that no
+  // temporary matrix for the activation is needed.
+  output.transform([](const eT x) { return (eT) ActivationFunction::Fn(x); });
+}
+
+template<typename ActivationFunction, typename InputDataType,
+    typename OutputDataType, typename RegularizerType>
+template<typename eT>
+void LinearActivation<ActivationFunction, InputDataType, OutputDataType,
+    RegularizerType>::Backward(const arma::Mat<eT>& input,
+                               const arma::Mat<eT>& gy,
+                               arma::Mat<eT>& g)
+{
+  // The derivative is a function of the output of the activation, so it can
+  // be applied to the error element by element without being stored.
+  activationError.set_size(gy.n_rows, gy.n_cols);
+  for (size_t i = 0; i < gy.n_elem; ++i)
+    activationError[i] = gy[i] * ActivationFunction::Deriv(input[i]);
+
+  g = weight.t() * activationError;
+}
+
+template<typename ActivationFunction, typename InputDataType,
+    typename OutputDataType, typename RegularizerType>
+template<typename eT>
+void LinearActivation<ActivationFunction, InputDataType, OutputDataType,
+    RegularizerType>::Gradient(const arma::Mat<eT>& input,
+                               const arma::Mat<eT>& /* error */,
+                               arma::Mat<eT>& gradient)
+{
+  gradient.submat(0, 0, weight.n_elem - 1, 0) = arma::vectorise(
+      activationError * input.t());
+  gradient.submat(weight.n_elem, 0, gradient.n_elem - 1, 0) =
+      arma::sum(activationError, 1);
+  regularizer.Evaluate(weights, gradient);
+}
+
+template<typename ActivationFunction, typename InputDataType,
+    typename OutputDataType, typename RegularizerType>
+template<typename Archive>
+void LinearActivation<ActivationFunction, InputDataType, OutputDataType,
+    RegularizerType>::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(outSize));
+  ar(CEREAL_NVP(weights));
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -45,7 +45,7 @@ template<typename InputDataType, typename OutputDataType,
     typename RegularizerType>
 void LinearNoBias<InputDataType, OutputDataType, RegularizerType>::Reset()
 {
-  weight = arma::mat(weights.memptr(), outSize, inSize, false, false);
+  weight = OutputDataType(weights.memptr(), outSize, inSize, false, false);
 }
 
 template<typename InputDataType, typename OutputDataType,
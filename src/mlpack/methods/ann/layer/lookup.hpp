@@ -29,6 +29,29 @@ namespace ann /* Artificial Neural Network. */ {
  * The input shape : (sequenceLength, batchSize).
  * The output shape : (embeddingSize, sequenceLength, batchSize).
  *
+ * A batch only touches the embeddings of its own tokens, so Gradient() also
+ * keeps the gradient in compact form: the distinct tokens of the batch
+ * (GradientIndices()) and the gradient of each of their embeddings
+ * (SparseGradient()).  For large vocabularies, the layer can be made sparse;
+ * then Gradient() leaves the dense gradient (which FFN already zeroes) as it
+ * is, and the embeddings are expected to be trained with a sparse update
+ * rule, such as SparseAdamUpdate, that only touches the embeddings of the
+ * batch:
+ *
+ * @code
+ * Lookup<>* lookup = new Lookup<>(vocabSize, embeddingSize, true);
+ * model.Add(lookup);
+ * ...
+ * SparseAdamUpdate<> update(0.001);
+ * model.EvaluateWithGradient(model.Parameters(), begin, gradient, batchSize);
+ * update.Update(lookup->Parameters(), lookup->GradientIndices(),
+ *     lookup->SparseGradient());
+ * @endcode
+ *
+ * The compact gradient only covers the batches passed through this layer
+ * object, so a sparse layer should not be combined with FFN::NumThreads() > 1,
+ * where each thread uses a replica of the layer.
+ *
  * @tparam InputDataType Type of the input data (arma::colvec, arma::mat,
  *         arma::sp_mat or arma::cube).
  * @tparam OutputDataType Type of the output data (arma::colvec, arma::mat,
@@ -46,8 +69,11 @@ class Lookup
    *
    * @param vocabSize The size of the vocabulary.
    * @param embeddingSize The length of each embedding vector.
+   * @param sparse Whether to only compute the compact gradient.
    */
-  Lookup(const size_t vocabSize = 0, const size_t embeddingSize = 0);
+  Lookup(const size_t vocabSize = 0,
+         const size_t embeddingSize = 0,
+         const bool sparse = false);
 
   /**
    * Ordinary feed forward pass of a neural network, evaluating the function
@@ -105,6 +131,17 @@ class Lookup
   //! Modify the gradient.
   OutputDataType& Gradient() { return gradient; }
 
+  //! Get the distinct tokens (as column indices of the parameters) of the last
+  //! batch passed to Gradient(), in increasing order.
+  const arma::uvec& GradientIndices() const { return gradientIndices; }
+  //! Get the gradient of the embedding of each token of GradientIndices().
+  OutputDataType const& SparseGradient() const { return sparseGradient; }
+
+  //! Get whether only the compact gradient is computed.
+  bool Sparse() const { return sparse; }
+  //! Modify whether only the compact gradient is computed.
+  bool& Sparse() { return sparse; }
+
   //! Get the size of the vocabulary.
   size_t VocabSize() const { return vocabSize; }
 
@@ -124,6 +161,9 @@ class Lookup
   //! Locally-stored length of each embedding vector.
   size_t embeddingSize;
 
+  //! Whether only the compact gradient is computed.
+  bool sparse;
+
   //! Locally-stored weight object.
   OutputDataType weights;
 
@@ -133,6 +173,12 @@ class Lookup
   //! Locally-stored gradient object.
   OutputDataType gradient;
 
+  //! The distinct tokens of the last batch.
+  arma::uvec gradientIndices;
+
+  //! The gradient of the embeddings of the distinct tokens of the last batch.
+  OutputDataType sparseGradient;
+
   //! Locally-stored output parameter object.
   OutputDataType outputParameter;
 }; // class Lookup
@@ -22,9 +22,11 @@ namespace ann /** Artificial Neural Network. */ {
 template <typename InputDataType, typename OutputDataType>
 Lookup<InputDataType, OutputDataType>::Lookup(
     const size_t vocabSize,
-    const size_t embeddingSize) :
+    const size_t embeddingSize,
+    const bool sparse) :
     vocabSize(vocabSize),
-    embeddingSize(embeddingSize)
+    embeddingSize(embeddingSize),
+    sparse(sparse)
 {
   weights.set_size(embeddingSize, vocabSize);
 }
@@ -66,29 +68,50 @@ void Lookup<InputDataType, OutputDataType>::Gradient(
     const arma::Mat<eT>& error,
     arma::Mat<eT>& gradient)
 {
-  const size_t seqLength = input.n_rows;
-  const size_t batchSize = input.n_cols;
+  // The error of the token input(k) is column k of the error (viewed as an
+  // (embeddingSize, seqLength * batchSize) matrix), since both are stored in
+  // column-major order.
+  const arma::Mat<eT> errors(const_cast<arma::Mat<eT>&>(error).memptr(),
+      embeddingSize, input.n_elem, false, false);
+  const arma::uvec tokens = arma::conv_to<arma::uvec>::from(
+      arma::vectorise(input)) - 1;
 
-  arma::Cube<eT> errorTemp(const_cast<arma::Mat<eT>&>(error).memptr(),
-      embeddingSize, seqLength, batchSize, false, false);
-
-  gradient.set_size(arma::size(weights));
-  gradient.zeros();
+  // Sum the errors of each distinct token.
+  gradientIndices = arma::unique(tokens);
+  sparseGradient.zeros(embeddingSize, gradientIndices.n_elem);
+  for (size_t k = 0; k < tokens.n_elem; ++k)
+  {
+    const size_t index = std::lower_bound(gradientIndices.begin(),
+        gradientIndices.end(), tokens[k]) - gradientIndices.begin();
+    sparseGradient.col(index) += errors.col(k);
+  }
 
-  for (size_t i = 0; i < batchSize; ++i)
+  if (sparse)
   {
-    gradient.cols(arma::conv_to<arma::uvec>::from(input.col(i)) - 1)
-        += errorTemp.slice(i);
+    // The dense gradient is left to the caller, but must have the right size.
+    if (arma::size(gradient) != arma::size(weights))
+      gradient.zeros(arma::size(weights));
+
+    return;
   }
+
+  gradient.set_size(arma::size(weights));
+  gradient.zeros();
+  for (size_t i = 0; i < gradientIndices.n_elem; ++i)
+    gradient.col(gradientIndices[i]) = sparseGradient.col(i);
 }
 
 template<typename InputDataType, typename OutputDataType>
 template<typename Archive>
 void Lookup<InputDataType, OutputDataType>::serialize(
-    Archive& ar, const uint32_t /* version */)
+    Archive& ar, const uint32_t version)
 {
   ar(CEREAL_NVP(vocabSize));
   ar(CEREAL_NVP(embeddingSize));
+  if (version >= 1)
+    ar(CEREAL_NVP(sparse));
+  else if (cereal::is_loading<Archive>())
+    sparse = false;
 
   // This is inefficient, but we have to allocate this memory so that
   // WeightSetVisitor gets the right size.
@@ -99,4 +122,9 @@ void Lookup<InputDataType, OutputDataType>::serialize(
 } // namespace ann
 } // namespace mlpack
 
+// Version 1 adds the sparse flag.
+CEREAL_TEMPLATE_CLASS_VERSION((template<typename InputDataType,
+    typename OutputDataType>), (mlpack::ann::Lookup<InputDataType,
+    OutputDataType>), (1));
+
 #endif
@@ -32,6 +32,9 @@ template <
 class LpPooling
 {
  public:
+  // Convenience typedefs.
+  typedef typename OutputDataType::elem_type ElemType;
+
   //! Create the LpPooling object.
   LpPooling();
 
@@ -152,60 +155,91 @@ class LpPooling
   void serialize(Archive& ar, const uint32_t /* version */);
 
  private:
+  //! Raise the given value to the given power (with a fast path for the
+  //! square, used by the usual L2 norm).
+  template<typename eT>
+  eT Power(const eT value, const double exponent) const
+  {
+    return (exponent == 2.0) ? value * value : std::pow(value, exponent);
+  }
+
   /**
-   * Apply pooling to the input and store the results.
+   * Apply Lp pooling to one slice of the input.  The kernel size can be fixed
+   * at compile time (with FixedWidth and FixedHeight) so that the loops over
+   * the window are unrolled; 0 means the size of the layer is used.
    *
-   * @param input The input to be apply the pooling rule.
+   * @param input The slice to pool.
    * @param output The pooled result.
    */
-  template<typename eT>
-  void Pooling(const arma::Mat<eT>& input, arma::Mat<eT>& output)
+  template<size_t FixedWidth, size_t FixedHeight, typename eT>
+  void Pooling(const eT* input, eT* output)
   {
-    for (size_t j = 0, colidx = 0; j < output.n_cols;
+    const size_t windowWidth = FixedWidth ? FixedWidth :
+        kernelWidth - offset;
+    const size_t windowHeight = FixedHeight ? FixedHeight :
+        kernelHeight - offset;
+
+    for (size_t j = 0, colidx = 0; j < outputHeight;
          ++j, colidx += strideHeight)
     {
-      for (size_t i = 0, rowidx = 0; i < output.n_rows;
+      const size_t colEnd = std::min(colidx + windowHeight, inputHeight);
+      for (size_t i = 0, rowidx = 0; i < outputWidth;
            ++i, rowidx += strideWidth)
       {
-        arma::mat subInput = input(
-            arma::span(rowidx, rowidx + kernelWidth - 1 - offset),
-            arma::span(colidx, colidx + kernelHeight - 1 - offset));
+        const size_t rowEnd = std::min(rowidx + windowWidth, inputWidth);
+
+        eT sum = 0;
+        for (size_t c = colidx; c < colEnd; ++c)
+          for (size_t r = rowidx; r < rowEnd; ++r)
+            sum += Power(input[r + c * inputWidth], (double) normType);
 
-        output(i, j) = pow(arma::accu(arma::pow(subInput,
-            normType)), 1.0 / normType);
+        output[i + j * outputWidth] = std::pow(sum, 1.0 / normType);
       }
     }
   }
 
   /**
-   * Apply unpooling to the input and store the results.
+   * Apply unpooling to one slice of the error.  The gradient of
+   * y = (sum_i x_i^p)^(1 / p) with respect to x_i is x_i^(p - 1) / y^(p - 1),
+   * so each element of a window gets the error of the window times that.
    *
-   * @param input The input to be apply the unpooling rule.
-   * @param output The pooled result.
+   * @param input The slice of the input of the forward pass.
+   * @param pooled The slice of the output of the forward pass.
+   * @param error The backward error of the slice.
+   * @param output The unpooled result.
    */
   template<typename eT>
-  void Unpooling(const arma::Mat<eT>& input,
-                 const arma::Mat<eT>& error,
-                 arma::Mat<eT>& output)
+  void Unpooling(const eT* input,
+                 const eT* pooled,
+                 const eT* error,
+                 eT* output)
   {
-    const size_t rStep = input.n_rows / error.n_rows - offset;
-    const size_t cStep = input.n_cols / error.n_cols - offset;
+    const size_t windowWidth = kernelWidth - offset;
+    const size_t windowHeight = kernelHeight - offset;
 
-    arma::Mat<eT> unpooledError;
-    for (size_t j = 0; j < input.n_cols - cStep; j += cStep)
+    for (size_t j = 0, colidx = 0; j < outputHeight;
+         ++j, colidx += strideHeight)
     {
-      for (size_t i = 0; i < input.n_rows - rStep; i += rStep)
+      const size_t colEnd = std::min(colidx + windowHeight, inputHeight);
+      for (size_t i = 0, rowidx = 0; i < outputWidth;
+           ++i, rowidx += strideWidth)
       {
-        const arma::Mat<eT>& inputArea = input(arma::span(i, i + rStep - 1),
-            arma::span(j, j + cStep - 1));
-        size_t sum = pow(arma::accu(arma::pow(inputArea, normType)),
-            (normType - 1) / normType);
-        unpooledError = arma::Mat<eT>(inputArea.n_rows, inputArea.n_cols);
-        unpooledError.fill(error(i / rStep, j / cStep));
-        unpooledError %= arma::pow(inputArea, normType - 1);
-        unpooledError /= sum;
-        output(arma::span(i, i + rStep - 1 - offset),
-            arma::span(j, j + cStep - 1 - offset)) += unpooledError;
+        const size_t rowEnd = std::min(rowidx + windowWidth, inputWidth);
+
+        const eT y = pooled[i + j * outputWidth];
+        if (y == 0)
+          continue;
+
+        const eT scale = error[i + j * outputWidth] /
+            Power(y, (double) normType - 1.0);
+        for (size_t c = colidx; c < colEnd; ++c)
+        {
+          for (size_t r = rowidx; r < rowEnd; ++r)
+          {
+            output[r + c * inputWidth] += scale *
+                Power(input[r + c * inputWidth], (double) normType - 1.0);
+          }
+        }
       }
     }
   }
@@ -256,13 +290,13 @@ class LpPooling
   size_t batchSize;
 
   //! Locally-stored output parameter.
-  arma::cube outputTemp;
+  arma::Cube<ElemType> outputTemp;
 
   //! Locally-stored transformed input parameter.
-  arma::cube inputTemp;
+  arma::Cube<ElemType> inputTemp;
 
   //! Locally-stored transformed output parameter.
-  arma::cube gTemp;
+  arma::Cube<ElemType> gTemp;
 
   //! Locally-stored delta object.
   OutputDataType delta;
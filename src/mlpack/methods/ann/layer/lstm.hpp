@@ -113,6 +113,20 @@ class LSTM
                OutputType& cellState,
                bool useCellState = false);
 
+  /**
+   * Compute the input projections of the gates for the next steps at once, so
+   * that the following calls to Forward() only need to add the recurrent
+   * part.  The projections are used by the next min(steps, remaining BPTT
+   * steps) calls to Forward(), which must be given the same inputs; they are
+   * dropped when the cell is reset.
+   *
+   * @param input Inputs of the next steps, one block of batchSize columns for
+   *     each step.
+   * @param batchSize Number of points of each step.
+   */
+  template<typename InputType>
+  void ProjectInputs(const InputType& input, const size_t batchSize);
+
   /**
    * Ordinary feed backward pass of a neural network, calculating the function
    * f(x) by propagating x backwards trough f. Using the results from the feed
@@ -346,6 +360,10 @@ class LSTM
 
   //! Current backpropagate through time steps.
   size_t bpttSteps;
+
+  //! Column up to which the gates hold input projections from
+  //! ProjectInputs().
+  size_t projectedEnd;
 }; // class LSTM
 
 } // namespace ann
@@ -19,7 +19,7 @@ namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
 
 template<typename InputDataType, typename OutputDataType>
-LSTM<InputDataType, OutputDataType>::LSTM()
+LSTM<InputDataType, OutputDataType>::LSTM() : projectedEnd(0)
 {
   // Nothing to do here.
 }
@@ -38,7 +38,8 @@ LSTM<InputDataType, OutputDataType>::LSTM(
     batchStep(layer.batchStep),
     gradientStepIdx(layer.gradientStepIdx),
     rhoSize(layer.rho),
-    bpttSteps(layer.bpttSteps)
+    bpttSteps(layer.bpttSteps),
+    projectedEnd(0)
 {
   // Nothing to do here.
 }
@@ -57,7 +58,8 @@ LSTM<InputDataType, OutputDataType>::LSTM(
     batchStep(std::move(layer.batchStep)),
     gradientStepIdx(std::move(layer.gradientStepIdx)),
     rhoSize(std::move(layer.rho)),
-    bpttSteps(std::move(layer.bpttSteps))
+    bpttSteps(std::move(layer.bpttSteps)),
+    projectedEnd(0)
 {
   // Nothing to do here.
 }
@@ -81,6 +83,7 @@ LSTM<InputDataType, OutputDataType> :: operator=(const LSTM& layer)
     grad = layer.grad;
     rhoSize = layer.rho;
     bpttSteps = layer.bpttSteps;
+    projectedEnd = 0;
   }
   return *this; 
 }
@@ -104,6 +107,7 @@ LSTM<InputDataType, OutputDataType> :: operator=(LSTM&& layer)
     grad = std::move(layer.grad);
     rhoSize = std::move(layer.rho);
     bpttSteps = std::move(layer.bpttSteps);
+    projectedEnd = 0;
   }
   return *this; 
 }
@@ -121,7 +125,8 @@ LSTM<InputDataType, OutputDataType>::LSTM(
     batchStep(0),
     gradientStepIdx(0),
     rhoSize(rho),
-    bpttSteps(0)
+    bpttSteps(0),
+    projectedEnd(0)
 {
   weights.set_size(WeightSize(), 1);
 }
@@ -139,6 +144,7 @@ void LSTM<InputDataType, OutputDataType>::ResetCell(const size_t size)
 
   bpttSteps = std::min(rho, rhoSize);
   forwardStep = 0;
+  projectedEnd = 0;
   gradientStepIdx = 0;
   backwardStep = batchSize * size - 1;
   gradientStep = batchSize * size - 1;
@@ -259,17 +265,32 @@ void LSTM<InputDataType, OutputDataType>::Forward(const InputType& input,
     ResetCell(rhoSize);
   }
 
-  inputGate.cols(forwardStep, forwardStep + batchStep) = input2GateInputWeight *
-      input + output2GateInputWeight * outParameter.cols(forwardStep,
-      forwardStep + batchStep);
-  inputGate.cols(forwardStep, forwardStep + batchStep).each_col() +=
-      input2GateInputBias;
-
-  forgetGate.cols(forwardStep, forwardStep + batchStep) = input2GateForgetWeight
-      * input + output2GateForgetWeight * outParameter.cols(
-      forwardStep, forwardStep + batchStep);
-  forgetGate.cols(forwardStep, forwardStep + batchStep).each_col() +=
-      input2GateForgetBias;
+  // If the input projections of this step were computed by ProjectInputs(),
+  // only the recurrent parts are left to add.
+  const bool projected = (forwardStep + batchStep < projectedEnd);
+  if (projected)
+  {
+    inputGate.cols(forwardStep, forwardStep + batchStep) +=
+        output2GateInputWeight * outParameter.cols(forwardStep,
+        forwardStep + batchStep);
+    forgetGate.cols(forwardStep, forwardStep + batchStep) +=
+        output2GateForgetWeight * outParameter.cols(forwardStep,
+        forwardStep + batchStep);
+  }
+  else
+  {
+    inputGate.cols(forwardStep, forwardStep + batchStep) =
+        input2GateInputWeight * input + output2GateInputWeight *
+        outParameter.cols(forwardStep, forwardStep + batchStep);
+    inputGate.cols(forwardStep, forwardStep + batchStep).each_col() +=
+        input2GateInputBias;
+
+    forgetGate.cols(forwardStep, forwardStep + batchStep) =
+        input2GateForgetWeight * input + output2GateForgetWeight *
+        outParameter.cols(forwardStep, forwardStep + batchStep);
+    forgetGate.cols(forwardStep, forwardStep + batchStep).each_col() +=
+        input2GateForgetBias;
+  }
 
   if (forwardStep > 0)
   {
@@ -300,12 +321,21 @@ void LSTM<InputDataType, OutputDataType>::Forward(const InputType& input,
   forgetGateActivation.cols(forwardStep, forwardStep + batchStep) = 1.0 /
       (1 + arma::exp(-forgetGate.cols(forwardStep, forwardStep + batchStep)));
 
-  hiddenLayer.cols(forwardStep, forwardStep + batchStep) = input2HiddenWeight *
-      input + output2HiddenWeight * outParameter.cols(
-      forwardStep, forwardStep + batchStep);
+  if (projected)
+  {
+    hiddenLayer.cols(forwardStep, forwardStep + batchStep) +=
+        output2HiddenWeight * outParameter.cols(forwardStep,
+        forwardStep + batchStep);
+  }
+  else
+  {
+    hiddenLayer.cols(forwardStep, forwardStep + batchStep) =
+        input2HiddenWeight * input + output2HiddenWeight * outParameter.cols(
+        forwardStep, forwardStep + batchStep);
 
-  hiddenLayer.cols(forwardStep, forwardStep + batchStep).each_col() +=
-      input2HiddenBias;
+    hiddenLayer.cols(forwardStep, forwardStep + batchStep).each_col() +=
+        input2HiddenBias;
+  }
 
   hiddenLayerActivation.cols(forwardStep, forwardStep + batchStep) =
       arma::tanh(hiddenLayer.cols(forwardStep, forwardStep + batchStep));
@@ -325,13 +355,24 @@ void LSTM<InputDataType, OutputDataType>::Forward(const InputType& input,
         hiddenLayerActivation.cols(forwardStep, forwardStep + batchStep);
   }
 
-  outputGate.cols(forwardStep, forwardStep + batchStep) = input2GateOutputWeight
-      * input + output2GateOutputWeight * outParameter.cols(
-      forwardStep, forwardStep + batchStep) + cell.cols(forwardStep,
-      forwardStep + batchStep).each_col() % cell2GateOutputWeight;
-
-  outputGate.cols(forwardStep, forwardStep + batchStep).each_col() +=
-      input2GateOutputBias;
+  if (projected)
+  {
+    outputGate.cols(forwardStep, forwardStep + batchStep) +=
+        output2GateOutputWeight * outParameter.cols(forwardStep,
+        forwardStep + batchStep) + cell.cols(forwardStep,
+        forwardStep + batchStep).each_col() % cell2GateOutputWeight;
+  }
+  else
+  {
+    outputGate.cols(forwardStep, forwardStep + batchStep) =
+        input2GateOutputWeight * input + output2GateOutputWeight *
+        outParameter.cols(forwardStep, forwardStep + batchStep) +
+        cell.cols(forwardStep, forwardStep + batchStep).each_col() %
+        cell2GateOutputWeight;
+
+    outputGate.cols(forwardStep, forwardStep + batchStep).each_col() +=
+        input2GateOutputBias;
+  }
 
   outputGateActivation.cols(forwardStep, forwardStep + batchStep) = 1.0 /
       (1 + arma::exp(-outputGate.cols(forwardStep, forwardStep + batchStep)));
@@ -354,9 +395,46 @@ void LSTM<InputDataType, OutputDataType>::Forward(const InputType& input,
   if ((forwardStep / batchSize) == bpttSteps)
   {
     forwardStep = 0;
+    projectedEnd = 0;
   }
 }
 
+template<typename InputDataType, typename OutputDataType>
+template<typename InputType>
+void LSTM<InputDataType, OutputDataType>::ProjectInputs(
+    const InputType& input, const size_t batchSize)
+{
+  if (batchSize != this->batchSize)
+  {
+    this->batchSize = batchSize;
+    batchStep = batchSize - 1;
+    ResetCell(rhoSize);
+  }
+
+  // Only the steps left before the BPTT window wraps around can be stored.
+  const size_t end = std::min(forwardStep + input.n_cols,
+      bpttSteps * batchSize);
+  if (end <= forwardStep)
+    return;
+
+  const size_t last = end - 1;
+  const size_t columns = end - forwardStep;
+  inputGate.cols(forwardStep, last) = input2GateInputWeight *
+      input.cols(0, columns - 1);
+  inputGate.cols(forwardStep, last).each_col() += input2GateInputBias;
+  forgetGate.cols(forwardStep, last) = input2GateForgetWeight *
+      input.cols(0, columns - 1);
+  forgetGate.cols(forwardStep, last).each_col() += input2GateForgetBias;
+  hiddenLayer.cols(forwardStep, last) = input2HiddenWeight *
+      input.cols(0, columns - 1);
+  hiddenLayer.cols(forwardStep, last).each_col() += input2HiddenBias;
+  outputGate.cols(forwardStep, last) = input2GateOutputWeight *
+      input.cols(0, columns - 1);
+  outputGate.cols(forwardStep, last).each_col() += input2GateOutputBias;
+
+  projectedEnd = end;
+}
+
 template<typename InputDataType, typename OutputDataType>
 template<typename InputType, typename ErrorType, typename GradientType>
 void LSTM<InputDataType, OutputDataType>::Backward(
@@ -52,6 +52,9 @@ template <
 class MaxPooling
 {
  public:
+  // Convenience typedefs.
+  typedef typename OutputDataType::elem_type ElemType;
+
   //! Create the MaxPooling object.
   MaxPooling();
 
@@ -170,58 +173,58 @@ class MaxPooling
   void serialize(Archive& ar, const uint32_t /* version */);
 
  private:
- /**
-   * Apply pooling to the input and store the results.
+  /**
+   * Apply max pooling to one slice of the input, and store the index (within
+   * the slice) of the maximum of each window if storeIndices is true.  Ties
+   * go to the first element of the window in column-major order.  The kernel
+   * size can be fixed at compile time (with FixedWidth and FixedHeight) so
+   * that the loops over the window are unrolled; 0 means the size of the
+   * layer is used.
    *
-   * @param input The input to be apply the pooling rule.
+   * @param input The slice to pool.
    * @param output The pooled result.
-   * @param poolingIndices The pooled indices.
+   * @param indices The indices of the pooled values.
+   * @param storeIndices Whether to store the indices.
    */
-  template<typename eT>
-  void PoolingOperation(const arma::Mat<eT>& input,
-                        arma::Mat<eT>& output,
-                        arma::Mat<eT>& poolingIndices)
+  template<size_t FixedWidth, size_t FixedHeight, typename eT>
+  void PoolingOperation(const eT* input,
+                        eT* output,
+                        size_t* indices,
+                        const bool storeIndices)
   {
-    for (size_t j = 0, colidx = 0; j < output.n_cols;
+    const size_t windowWidth = FixedWidth ? FixedWidth :
+        kernelWidth - offset;
+    const size_t windowHeight = FixedHeight ? FixedHeight :
+        kernelHeight - offset;
+
+    for (size_t j = 0, colidx = 0; j < outputHeight;
         ++j, colidx += strideHeight)
     {
-      for (size_t i = 0, rowidx = 0; i < output.n_rows;
+      const size_t colEnd = std::min(colidx + windowHeight, inputHeight);
+      for (size_t i = 0, rowidx = 0; i < outputWidth;
           ++i, rowidx += strideWidth)
       {
-        arma::mat subInput = input(
-            arma::span(rowidx, rowidx + kernelWidth - 1 - offset),
-            arma::span(colidx, colidx + kernelHeight - 1 - offset));
-
-        const size_t idx = pooling.Pooling(subInput);
-        output(i, j) = subInput(idx);
+        const size_t rowEnd = std::min(rowidx + windowWidth, inputWidth);
 
-        if (!deterministic)
+        size_t maxIndex = rowidx + colidx * inputWidth;
+        eT maxValue = input[maxIndex];
+        for (size_t c = colidx; c < colEnd; ++c)
         {
-          arma::Mat<size_t> subIndices = indices(arma::span(rowidx,
-              rowidx + kernelWidth - 1 - offset),
-              arma::span(colidx, colidx + kernelHeight - 1 - offset));
-
-          poolingIndices(i, j) = subIndices(idx);
+          for (size_t r = rowidx; r < rowEnd; ++r)
+          {
+            const size_t index = r + c * inputWidth;
+            if (input[index] > maxValue)
+            {
+              maxValue = input[index];
+              maxIndex = index;
+            }
+          }
         }
-      }
-    }
-  }
 
-  /**
-   * Apply unpooling to the input and store the results.
-   *
-   * @param error The backward error.
-   * @param output The pooled result.
-   * @param poolingIndices The pooled indices.
-   */
-  template<typename eT>
-  void Unpooling(const arma::Mat<eT>& error,
-                 arma::Mat<eT>& output,
-                 arma::Mat<eT>& poolingIndices)
-  {
-    for (size_t i = 0; i < poolingIndices.n_elem; ++i)
-    {
-      output(poolingIndices(i)) += error(i);
+        output[i + j * outputWidth] = maxValue;
+        if (storeIndices)
+          indices[i + j * outputWidth] = maxIndex;
+      }
     }
   }
 
@@ -246,9 +249,6 @@ class MaxPooling
   //! Locally-stored number of output channels.
   size_t outSize;
 
-  //! Locally-stored reset parameter used to initialize the module once.
-  bool reset;
-
   //! Locally-stored input width.
   size_t inputWidth;
 
@@ -271,16 +271,13 @@ class MaxPooling
   size_t batchSize;
 
   //! Locally-stored output parameter.
-  arma::cube outputTemp;
+  arma::Cube<ElemType> outputTemp;
 
   //! Locally-stored transformed input parameter.
-  arma::cube inputTemp;
+  arma::Cube<ElemType> inputTemp;
 
   //! Locally-stored transformed output parameter.
-  arma::cube gTemp;
-
-  //! Locally-stored pooling strategy.
-  MaxPoolingRule pooling;
+  arma::Cube<ElemType> gTemp;
 
   //! Locally-stored delta object.
   OutputDataType delta;
@@ -291,14 +288,10 @@ class MaxPooling
   //! Locally-stored output parameter object.
   OutputDataType outputParameter;
 
-  //! Locally-stored indices matrix parameter.
-  arma::Mat<size_t> indices;
-
-  //! Locally-stored indices column parameter.
-  arma::Col<size_t> indicesCol;
-
-  //! Locally-stored pooling indicies.
-  std::vector<arma::cube> poolingIndices;
+  //! Locally-stored indices of the maxima of the forward passes not yet
+  //! propagated backward: for each output element, the index of its maximum
+  //! within its slice of the input.
+  std::vector<arma::Col<size_t>> poolingIndices;
 }; // class MaxPooling
 
 } // namespace ann
@@ -39,7 +39,6 @@ MaxPooling<InputDataType, OutputDataType>::MaxPooling(
     floor(floor),
     inSize(0),
     outSize(0),
-    reset(false),
     inputWidth(0),
     inputHeight(0),
     outputWidth(0),
@@ -58,7 +57,7 @@ void MaxPooling<InputDataType, OutputDataType>::Forward(
 {
   batchSize = input.n_cols;
   inSize = input.n_elem / (inputWidth * inputHeight * batchSize);
-  inputTemp = arma::cube(const_cast<arma::Mat<eT>&>(input).memptr(),
+  inputTemp = arma::Cube<eT>(const_cast<arma::Mat<eT>&>(input).memptr(),
       inputWidth, inputHeight, batchSize * inSize, false, false);
 
   if (floor)
@@ -78,37 +77,28 @@ void MaxPooling<InputDataType, OutputDataType>::Forward(
     offset = 1;
   }
 
-  outputTemp = arma::zeros<arma::Cube<eT> >(outputWidth, outputHeight,
-      batchSize * inSize);
+  outputTemp.set_size(outputWidth, outputHeight, batchSize * inSize);
 
   if (!deterministic)
+    poolingIndices.push_back(arma::Col<size_t>(outputTemp.n_elem));
+  size_t* indices = deterministic ? NULL : poolingIndices.back().memptr();
+
+  // The slices (channels of each point of the batch) are pooled in parallel;
+  // the common 2x2 and 3x3 kernels have their loops unrolled.
+  const size_t sliceSize = outputWidth * outputHeight;
+  #pragma omp parallel for
+  for (omp_size_t s = 0; s < (omp_size_t) inputTemp.n_slices; ++s)
   {
-    poolingIndices.push_back(outputTemp);
-  }
-
-  if (!reset)
-  {
-    size_t elements = inputWidth * inputHeight;
-    indicesCol = arma::linspace<arma::Col<size_t> >(0, (elements - 1),
-        elements);
-
-    indices = arma::Mat<size_t>(indicesCol.memptr(), inputWidth, inputHeight);
-
-    reset = true;
-  }
-
-  for (size_t s = 0; s < inputTemp.n_slices; s++)
-  {
-    if (!deterministic)
-    {
-      PoolingOperation(inputTemp.slice(s), outputTemp.slice(s),
-        poolingIndices.back().slice(s));
-    }
+    const eT* in = inputTemp.slice_memptr(s);
+    eT* out = outputTemp.slice_memptr(s);
+    size_t* sliceIndices = deterministic ? NULL : indices + s * sliceSize;
+
+    if (offset == 0 && kernelWidth == 2 && kernelHeight == 2)
+      PoolingOperation<2, 2>(in, out, sliceIndices, !deterministic);
+    else if (offset == 0 && kernelWidth == 3 && kernelHeight == 3)
+      PoolingOperation<3, 3>(in, out, sliceIndices, !deterministic);
     else
-    {
-      PoolingOperation(inputTemp.slice(s), outputTemp.slice(s),
-          inputTemp.slice(s));
-    }
+      PoolingOperation<0, 0>(in, out, sliceIndices, !deterministic);
   }
 
   output = arma::Mat<eT>(outputTemp.memptr(), outputTemp.n_elem / batchSize,
@@ -124,21 +114,29 @@ template<typename eT>
 void MaxPooling<InputDataType, OutputDataType>::Backward(
     const arma::Mat<eT>& /* input */, const arma::Mat<eT>& gy, arma::Mat<eT>& g)
 {
-  arma::cube mappedError = arma::cube(((arma::Mat<eT>&) gy).memptr(),
+  arma::Cube<eT> mappedError = arma::Cube<eT>(((arma::Mat<eT>&) gy).memptr(),
       outputWidth, outputHeight, outSize, false, false);
 
-  gTemp = arma::zeros<arma::cube>(inputTemp.n_rows,
+  gTemp = arma::zeros<arma::Cube<eT>>(inputTemp.n_rows,
       inputTemp.n_cols, inputTemp.n_slices);
 
-  for (size_t s = 0; s < mappedError.n_slices; s++)
+  // Each error goes to the maximum of its window; the indices of a slice only
+  // point into the same slice, so the slices can be unpooled in parallel.
+  const arma::Col<size_t>& indices = poolingIndices.back();
+  const size_t sliceSize = outputWidth * outputHeight;
+  #pragma omp parallel for
+  for (omp_size_t s = 0; s < (omp_size_t) mappedError.n_slices; ++s)
   {
-    Unpooling(mappedError.slice(s), gTemp.slice(s),
-        poolingIndices.back().slice(s));
+    const eT* error = mappedError.slice_memptr(s);
+    const size_t* sliceIndices = indices.memptr() + s * sliceSize;
+    eT* gSlice = gTemp.slice_memptr(s);
+    for (size_t i = 0; i < sliceSize; ++i)
+      gSlice[sliceIndices[i]] += error[i];
   }
 
   poolingIndices.pop_back();
 
-  g = arma::mat(gTemp.memptr(), gTemp.n_elem / batchSize, batchSize);
+  g = arma::Mat<eT>(gTemp.memptr(), gTemp.n_elem / batchSize, batchSize);
 }
 
 template<typename InputDataType, typename OutputDataType>
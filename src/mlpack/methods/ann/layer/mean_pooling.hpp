@@ -33,6 +33,9 @@ template <
 class MeanPooling
 {
  public:
+  // Convenience typedefs.
+  typedef typename OutputDataType::elem_type ElemType;
+
   //! Create the MeanPooling object.
   MeanPooling();
 
@@ -152,78 +155,64 @@ class MeanPooling
 
  private:
   /**
-   * Apply pooling to the input and store the results.
+   * Apply mean pooling to one slice of the input; windows that go past the
+   * edge of the input are clipped.  The kernel size can be fixed at compile
+   * time (with FixedWidth and FixedHeight) so that the loops over the window
+   * are unrolled; 0 means the size of the layer is used.
    *
-   * @param input The input to be apply the pooling rule.
+   * @param input The slice to pool.
    * @param output The pooled result.
    */
-  template<typename eT>
-  void Pooling(const arma::Mat<eT>& input, arma::Mat<eT>& output)
+  template<size_t FixedWidth, size_t FixedHeight, typename eT>
+  void Pooling(const eT* input, eT* output)
   {
-    for (size_t j = 0, colidx = 0; j < output.n_cols;
+    const size_t windowWidth = FixedWidth ? FixedWidth : kernelWidth;
+    const size_t windowHeight = FixedHeight ? FixedHeight : kernelHeight;
+
+    for (size_t j = 0, colidx = 0; j < outputHeight;
          ++j, colidx += strideHeight)
     {
-      for (size_t i = 0, rowidx = 0; i < output.n_rows;
+      const size_t colEnd = std::min(colidx + windowHeight, inputHeight);
+      for (size_t i = 0, rowidx = 0; i < outputWidth;
            ++i, rowidx += strideWidth)
       {
-        size_t rowEnd = rowidx + kernelWidth - 1;
-        size_t colEnd = colidx + kernelHeight - 1;
+        const size_t rowEnd = std::min(rowidx + windowWidth, inputWidth);
 
-        if (rowEnd > input.n_rows - 1)
-          rowEnd = input.n_rows - 1;
-        if (colEnd > input.n_cols - 1)
-          colEnd = input.n_cols - 1;
+        eT sum = 0;
+        for (size_t c = colidx; c < colEnd; ++c)
+          for (size_t r = rowidx; r < rowEnd; ++r)
+            sum += input[r + c * inputWidth];
 
-        arma::mat subInput = input(
-            arma::span(rowidx, rowEnd),
-            arma::span(colidx, colEnd));
-
-        output(i, j) = arma::mean(arma::mean(subInput));
+        output[i + j * outputWidth] = sum / ((rowEnd - rowidx) *
+            (colEnd - colidx));
       }
     }
   }
 
   /**
-   * Apply unpooling to the input and store the results.
+   * Apply unpooling to one slice of the error: the error of each window is
+   * spread evenly over the (clipped) window.
    *
-   * @param input The input to be apply the unpooling rule.
-   * @param output The pooled result.
+   * @param error The backward error of the slice.
+   * @param output The unpooled result.
    */
   template<typename eT>
-  void Unpooling(const arma::Mat<eT>& input,
-                 const arma::Mat<eT>& error,
-                 arma::Mat<eT>& output)
+  void Unpooling(const eT* error, eT* output)
   {
-
-    arma::Mat<eT> unpooledError;
-    for (size_t j = 0, colidx = 0; j < input.n_cols; j += strideHeight, colidx++)
+    for (size_t j = 0, colidx = 0; j < outputHeight;
+         ++j, colidx += strideHeight)
     {
-      for (size_t i = 0, rowidx = 0; i < input.n_rows; i += strideWidth, rowidx++)
-      { 
-        size_t rowEnd = i + kernelWidth - 1;
-        size_t colEnd = j + kernelHeight - 1;
-
-        if (rowEnd > input.n_rows - 1)
-        {
-          if (floor)
-            continue;
-          rowEnd = input.n_rows - 1;
-        }
-
-        if (colEnd > input.n_cols - 1)
-        {
-          if (floor)
-            continue;
-          colEnd = input.n_cols - 1;
-        }
-
-        arma::mat InputArea = input(arma::span(i, rowEnd), arma::span(j, colEnd));
-
-        unpooledError = arma::Mat<eT>(InputArea.n_rows, InputArea.n_cols);
-        unpooledError.fill(error(rowidx, colidx) / InputArea.n_elem);
-
-        output(arma::span(i, i + InputArea.n_rows - 1),
-            arma::span(j, j + InputArea.n_cols - 1)) += unpooledError;
+      const size_t colEnd = std::min(colidx + kernelHeight, inputHeight);
+      for (size_t i = 0, rowidx = 0; i < outputWidth;
+           ++i, rowidx += strideWidth)
+      {
+        const size_t rowEnd = std::min(rowidx + kernelWidth, inputWidth);
+
+        const eT value = error[i + j * outputWidth] /
+            ((rowEnd - rowidx) * (colEnd - colidx));
+        for (size_t c = colidx; c < colEnd; ++c)
+          for (size_t r = rowidx; r < rowEnd; ++r)
+            output[r + c * inputWidth] += value;
       }
     }
   }
@@ -271,13 +260,13 @@ class MeanPooling
   size_t batchSize;
 
   //! Locally-stored output parameter.
-  arma::cube outputTemp;
+  arma::Cube<ElemType> outputTemp;
 
   //! Locally-stored transformed input parameter.
-  arma::cube inputTemp;
+  arma::Cube<ElemType> inputTemp;
 
   //! Locally-stored transformed output parameter.
-  arma::cube gTemp;
+  arma::Cube<ElemType> gTemp;
 
   //! Locally-stored delta object.
   OutputDataType delta;
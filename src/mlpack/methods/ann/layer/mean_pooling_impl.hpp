@@ -57,7 +57,7 @@ void MeanPooling<InputDataType, OutputDataType>::Forward(
 {
   batchSize = input.n_cols;
   inSize = input.n_elem / (inputWidth * inputHeight * batchSize);
-  inputTemp = arma::cube(const_cast<arma::Mat<eT>&>(input).memptr(),
+  inputTemp = arma::Cube<eT>(const_cast<arma::Mat<eT>&>(input).memptr(),
       inputWidth, inputHeight, batchSize * inSize, false, false);
 
   if (floor)
@@ -75,11 +75,22 @@ void MeanPooling<InputDataType, OutputDataType>::Forward(
         (double) kernelHeight) / (double) strideHeight + 1);
   }
 
-  outputTemp = arma::zeros<arma::Cube<eT> >(outputWidth, outputHeight,
-      batchSize * inSize);
+  outputTemp.set_size(outputWidth, outputHeight, batchSize * inSize);
 
-  for (size_t s = 0; s < inputTemp.n_slices; s++)
-    Pooling(inputTemp.slice(s), outputTemp.slice(s));
+  // The slices (channels of each point of the batch) are pooled in parallel;
+  // the common 2x2 and 3x3 kernels have their loops unrolled.
+  #pragma omp parallel for
+  for (omp_size_t s = 0; s < (omp_size_t) inputTemp.n_slices; ++s)
+  {
+    const eT* in = inputTemp.slice_memptr(s);
+    eT* out = outputTemp.slice_memptr(s);
+    if (kernelWidth == 2 && kernelHeight == 2)
+      Pooling<2, 2>(in, out);
+    else if (kernelWidth == 3 && kernelHeight == 3)
+      Pooling<3, 3>(in, out);
+    else
+      Pooling<0, 0>(in, out);
+  }
 
   output = arma::Mat<eT>(outputTemp.memptr(), outputTemp.n_elem / batchSize,
       batchSize);
@@ -96,18 +107,17 @@ void MeanPooling<InputDataType, OutputDataType>::Backward(
   const arma::Mat<eT>& gy,
   arma::Mat<eT>& g)
 {
-  arma::cube mappedError = arma::cube(((arma::Mat<eT>&) gy).memptr(),
+  arma::Cube<eT> mappedError = arma::Cube<eT>(((arma::Mat<eT>&) gy).memptr(),
       outputWidth, outputHeight, outSize, false, false);
 
-  gTemp = arma::zeros<arma::cube>(inputTemp.n_rows,
+  gTemp = arma::zeros<arma::Cube<eT>>(inputTemp.n_rows,
       inputTemp.n_cols, inputTemp.n_slices);
 
-  for (size_t s = 0; s < mappedError.n_slices; s++)
-  {
-    Unpooling(inputTemp.slice(s), mappedError.slice(s), gTemp.slice(s));
-  }
+  #pragma omp parallel for
+  for (omp_size_t s = 0; s < (omp_size_t) mappedError.n_slices; ++s)
+    Unpooling(mappedError.slice_memptr(s), gTemp.slice_memptr(s));
 
-  g = arma::mat(gTemp.memptr(), gTemp.n_elem / batchSize, batchSize);
+  g = arma::Mat<eT>(gTemp.memptr(), gTemp.n_elem / batchSize, batchSize);
 }
 
 template<typename InputDataType, typename OutputDataType>
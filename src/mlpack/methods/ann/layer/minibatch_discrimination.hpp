@@ -53,6 +53,9 @@ template <
 class MiniBatchDiscrimination
 {
  public:
+  // Convenience typedefs.
+  typedef typename OutputDataType::elem_type ElemType;
+
   //! Create the MiniBatchDiscrimination object.
   MiniBatchDiscrimination();
 
@@ -154,7 +157,7 @@ class MiniBatchDiscrimination
   size_t batchSize;
 
   //! Locally-stored temporary features object.
-  arma::mat tempM;
+  OutputDataType tempM;
 
   //! Locally-stored weight object.
   OutputDataType weights;
@@ -163,13 +166,13 @@ class MiniBatchDiscrimination
   OutputDataType weight;
 
   //! Locally-stored features of input.
-  arma::cube M;
+  arma::Cube<ElemType> M;
 
   //! Locally-stored delta for features object.
-  arma::cube deltaM;
+  arma::Cube<ElemType> deltaM;
 
   //! Locally-stored L1 distances between features.
-  arma::cube distances;
+  arma::Cube<ElemType> distances;
 
   //! Locally-stored delta object.
   OutputDataType delta;
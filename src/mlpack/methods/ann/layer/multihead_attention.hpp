@@ -25,7 +25,6 @@
 #define MLPACK_METHODS_ANN_LAYER_MULTIHEAD_ATTENTION_HPP
 
 #include <mlpack/prereqs.hpp>
-#include <mlpack/methods/ann/layer/softmax.hpp>
 #include <mlpack/methods/ann/layer/dropout.hpp>
 #include <mlpack/methods/ann/init_rules/glorot_init.hpp>
 #include <mlpack/methods/ann/regularizer/no_regularizer.hpp>
@@ -48,6 +47,15 @@ namespace ann /** Artificial Neural Network. */ {
  * of shape `(embedDim * tgtSeqLen, batchSize)`. The embeddings are stored
  * consequently.
  *
+ * For autoregressive inference, the layer can keep a cache of the projected
+ * keys and values (see UseCache()).  Each call to Forward() then takes the
+ * query, key and value of a single new position, of shape
+ * `(3 * embedDim, batchSize)`, appends the projected key and value to the
+ * cache, and returns the attention of the new query over all positions seen
+ * so far, of shape `(embedDim, batchSize)`.  A new position therefore costs
+ * O(srcSeqLen) instead of recomputing the whole sequence.  This gives the same
+ * result as attending over the whole sequence with a causal attention mask.
+ *
  * @tparam InputDataType Type of the input data (arma::colvec, arma::mat,
  *         arma::sp_mat or arma::cube).
  * @tparam OutputDataType Type of the output data (arma::colvec, arma::mat,
@@ -159,6 +167,27 @@ class MultiheadAttention
   //! Modify the Key Padding Mask.
   OutputDataType& KeyPaddingMask() { return keyPaddingMask; }
 
+  //! Get whether the key/value cache is used for incremental inference.
+  bool UseCache() const { return useCache; }
+  /**
+   * Modify whether the key/value cache is used for incremental inference.
+   * When true, each call to Forward() processes one new position of the
+   * sequence, as described above; at most srcSeqLen positions can be cached,
+   * and all positions of a sequence must have the same batch size (otherwise
+   * Forward() throws std::runtime_error).  The attention mask is ignored, and
+   * Backward() and Gradient() can't be used.
+   */
+  bool& UseCache() { return useCache; }
+
+  //! Get the number of positions currently held in the key/value cache.
+  size_t CacheLength() const { return cacheLength; }
+
+  /**
+   * Empty the key/value cache, so that the next call to Forward() starts a new
+   * sequence.
+   */
+  void ResetCache();
+
   //! Get the output parameter.
   OutputDataType const& OutputParameter() const { return outputParameter; }
   //! Modify the output parameter.
@@ -188,6 +217,24 @@ class MultiheadAttention
   //! Element Type of the input.
   typedef typename OutputDataType::elem_type ElemType;
 
+  /**
+   * Forward pass of a single new position using the key/value cache.
+   *
+   * @param input The query, key and value of the new position.
+   * @param output Resulting output activation.
+   */
+  template<typename eT>
+  void ForwardCached(const arma::Mat<eT>& input, arma::Mat<eT>& output);
+
+  //! Apply the softmax function to each row of the given scores, in place.
+  template<typename eT>
+  void SoftmaxRows(arma::Mat<eT>& scores);
+
+  //! Backpropagate the error gy through the row-wise softmax that gave the
+  //! given scores, in place.
+  template<typename eT>
+  void SoftmaxRowsBackward(const arma::Mat<eT>& scores, arma::Mat<eT>& gy);
+
   //! Target sequence length.
   size_t tgtSeqLen;
 
@@ -251,8 +298,19 @@ class MultiheadAttention
   //! Locally-stored attention output weight to be fed to last linear layer.
   arma::Cube<ElemType> attnOut;
 
-  //! Softmax layer to represent the probabilities of next sequence.
-  Softmax<InputDataType, OutputDataType> softmax;
+  //! Whether to use the key/value cache.
+  bool useCache;
+
+  //! Number of positions held in the key/value cache.
+  size_t cacheLength;
+
+  //! Projected keys of the cached positions, of shape
+  //! (srcSeqLen, embedDim, batchSize).
+  arma::Cube<ElemType> keyCache;
+
+  //! Projected values of the cached positions, of shape
+  //! (srcSeqLen, embedDim, batchSize).
+  arma::Cube<ElemType> valueCache;
 
   //! Locally-stored delta object.
   OutputDataType delta;
@@ -29,7 +29,9 @@ MultiheadAttention() :
     srcSeqLen(0),
     embedDim(0),
     numHeads(0),
-    headDim(0)
+    headDim(0),
+    useCache(false),
+    cacheLength(0)
 {
   // Nothing to do here.
 }
@@ -45,7 +47,9 @@ MultiheadAttention(
     tgtSeqLen(tgtSeqLen),
     srcSeqLen(srcSeqLen),
     embedDim(embedDim),
-    numHeads(numHeads)
+    numHeads(numHeads),
+    useCache(false),
+    cacheLength(0)
 {
   if (embedDim % numHeads != 0)
   {
@@ -89,6 +93,13 @@ void MultiheadAttention<InputDataType, OutputDataType, RegularizerType>::
 Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output)
 {
   typedef typename arma::Cube<eT> CubeType;
+  typedef typename arma::Mat<eT> MatType;
+
+  if (useCache)
+  {
+    ForwardCached(input, output);
+    return;
+  }
 
   if (input.n_rows != embedDim * (tgtSeqLen + 2 * srcSeqLen))
   {
@@ -119,14 +130,26 @@ Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output)
   kProj.set_size(srcSeqLen, embedDim, batchSize);
   vProj.set_size(srcSeqLen, embedDim, batchSize);
 
+  // Project the whole batch with one matrix multiplication each, instead of
+  // one for every point.
+  MatType qAll = queryWt * MatType(const_cast<eT*>(q.memptr()), embedDim,
+      tgtSeqLen * batchSize, false, true);
+  MatType kAll = keyWt * MatType(const_cast<eT*>(k.memptr()), embedDim,
+      srcSeqLen * batchSize, false, true);
+  MatType vAll = valueWt * MatType(const_cast<eT*>(v.memptr()), embedDim,
+      srcSeqLen * batchSize, false, true);
+  qAll.each_col() += qBias.col(0);
+  kAll.each_col() += kBias.col(0);
+  vAll.each_col() += vBias.col(0);
+
   for (size_t i = 0; i < batchSize; ++i)
   {
-    qProj.slice(i) = arma::trans(
-        queryWt * q.slice(i) + arma::repmat(qBias, 1, tgtSeqLen));
-    kProj.slice(i) = arma::trans(
-        keyWt * k.slice(i) + arma::repmat(kBias, 1, srcSeqLen));
-    vProj.slice(i) = arma::trans(
-        valueWt * v.slice(i) + arma::repmat(vBias, 1, srcSeqLen));
+    qProj.slice(i) = arma::trans(qAll.cols(i * tgtSeqLen,
+        (i + 1) * tgtSeqLen - 1));
+    kProj.slice(i) = arma::trans(kAll.cols(i * srcSeqLen,
+        (i + 1) * srcSeqLen - 1));
+    vProj.slice(i) = arma::trans(vAll.cols(i * srcSeqLen,
+        (i + 1) * srcSeqLen - 1));
   }
 
   // The scaling factor sqrt(headDim) is used to prevent exploding values
@@ -165,11 +188,9 @@ Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output)
     scores.each_slice() += arma::repmat(keyPaddingMask, tgtSeqLen, 1);
   }
 
+  // Each query attends to the keys, so the softmax is taken along the rows.
   for (size_t i = 0; i < numHeads * batchSize; ++i)
-  {
-    softmax.Forward(scores.slice(i), softmax.OutputParameter());
-    scores.slice(i) = softmax.OutputParameter();
-  }
+    SoftmaxRows(scores.slice(i));
 
   // Calculate the attention output i.e. matrix multiplication of softmax
   // output and vProj.
@@ -246,7 +267,7 @@ Backward(const arma::Mat<eT>& /* input */,
   for (size_t i = 0; i < numHeads * batchSize; ++i)
   {
     // We will perform backpropagation of softmax over each slice of gyTemp.
-    softmax.Backward(scores.slice(i), gyTemp.slice(i), gyTemp.slice(i));
+    SoftmaxRowsBackward(scores.slice(i), gyTemp.slice(i));
   }
 
   // Obtain backpropagated error of key.
@@ -377,7 +398,7 @@ Gradient(const arma::Mat<eT>& input,
     // The shape of scores : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
     // The shape of errorTemp : (tgtSeqLen, srcSeqLen, numHeads * batchSize).
     // The new shape of errorTemp remain same.
-    softmax.Backward(scores.slice(i), errorTemp.slice(i), errorTemp.slice(i));
+    SoftmaxRowsBackward(scores.slice(i), errorTemp.slice(i));
   }
 
   // The shape of qProj : (tgtSeqLen, headDim, numHeads * batchSize).
@@ -430,6 +451,118 @@ Gradient(const arma::Mat<eT>& input,
   regularizer.Evaluate(weights, gradient);
 }
 
+template <typename InputDataType, typename OutputDataType,
+          typename RegularizerType>
+void MultiheadAttention<InputDataType, OutputDataType, RegularizerType>::
+ResetCache()
+{
+  cacheLength = 0;
+  keyCache.reset();
+  valueCache.reset();
+}
+
+template <typename InputDataType, typename OutputDataType,
+          typename RegularizerType>
+template <typename eT>
+void MultiheadAttention<InputDataType, OutputDataType, RegularizerType>::
+ForwardCached(const arma::Mat<eT>& input, arma::Mat<eT>& output)
+{
+  typedef typename arma::Mat<eT> MatType;
+
+  if (input.n_rows != 3 * embedDim)
+  {
+    Log::Fatal << "Incorrect input dimensions! When the key/value cache is "
+        << "used, each column must hold the query, key and value of one "
+        << "position." << std::endl;
+  }
+
+  const size_t batchSize = input.n_cols;
+  if (cacheLength == 0)
+  {
+    keyCache.set_size(srcSeqLen, embedDim, batchSize);
+    valueCache.set_size(srcSeqLen, embedDim, batchSize);
+  }
+  else if (keyCache.n_slices != batchSize)
+  {
+    Log::Fatal << "The key/value cache holds sequences of a batch of size "
+        << keyCache.n_slices << ", but the input has " << batchSize
+        << " columns; call ResetCache() before starting a new batch."
+        << std::endl;
+  }
+
+  if (cacheLength == srcSeqLen)
+  {
+    Log::Fatal << "The key/value cache already holds srcSeqLen positions; "
+        << "call ResetCache() before starting a new sequence." << std::endl;
+  }
+
+  // Only the projections of the new position have to be computed; the ones of
+  // all previous positions are in the cache.
+  MatType qNew = queryWt * input.rows(0, embedDim - 1);
+  MatType kNew = keyWt * input.rows(embedDim, 2 * embedDim - 1);
+  MatType vNew = valueWt * input.rows(2 * embedDim, 3 * embedDim - 1);
+  qNew.each_col() += qBias.col(0);
+  kNew.each_col() += kBias.col(0);
+  vNew.each_col() += vBias.col(0);
+  qNew /= std::sqrt(headDim);
+
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    keyCache.slice(i).row(cacheLength) = kNew.col(i).t();
+    valueCache.slice(i).row(cacheLength) = vNew.col(i).t();
+  }
+  ++cacheLength;
+
+  // The new query attends to all cached positions (including itself), so no
+  // attention mask is needed.
+  MatType attn(embedDim, batchSize);
+  arma::Col<eT> weightsHead;
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    for (size_t h = 0; h < numHeads; ++h)
+    {
+      const size_t first = h * headDim;
+      const size_t last = (h + 1) * headDim - 1;
+      weightsHead = keyCache.slice(i).submat(0, first, cacheLength - 1, last) *
+          qNew.submat(first, i, last, i);
+
+      if (!keyPaddingMask.is_empty())
+        weightsHead += keyPaddingMask.head_cols(cacheLength).t();
+
+      weightsHead = arma::exp(weightsHead - weightsHead.max());
+      weightsHead /= arma::accu(weightsHead);
+
+      attn.submat(first, i, last, i) = valueCache.slice(i).submat(0, first,
+          cacheLength - 1, last).t() * weightsHead;
+    }
+  }
+
+  output = outWt.t() * attn;
+  output.each_col() += outBias.row(0).t();
+}
+
+template <typename InputDataType, typename OutputDataType,
+          typename RegularizerType>
+template <typename eT>
+void MultiheadAttention<InputDataType, OutputDataType, RegularizerType>::
+SoftmaxRows(arma::Mat<eT>& scores)
+{
+  scores.each_col() -= arma::max(scores, 1);
+  scores = arma::exp(scores);
+  scores.each_col() /= arma::sum(scores, 1);
+}
+
+template <typename InputDataType, typename OutputDataType,
+          typename RegularizerType>
+template <typename eT>
+void MultiheadAttention<InputDataType, OutputDataType, RegularizerType>::
+SoftmaxRowsBackward(const arma::Mat<eT>& scores, arma::Mat<eT>& gy)
+{
+  const arma::Col<eT> dot = arma::sum(gy % scores, 1);
+  gy.each_col() -= dot;
+  gy %= scores;
+}
+
 template <typename InputDataType, typename OutputDataType,
           typename RegularizerType>
 template <typename Archive>
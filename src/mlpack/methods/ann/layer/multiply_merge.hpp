@@ -42,6 +42,10 @@ template<
 class MultiplyMerge
 {
  public:
+  static_assert(std::is_same<InputDataType, arma::mat>::value &&
+      std::is_same<OutputDataType, arma::mat>::value,
+      "MultiplyMerge holds LayerTypes, which only support arma::mat");
+
   /**
    * Create the MultiplyMerge object using the specified parameters.
    *
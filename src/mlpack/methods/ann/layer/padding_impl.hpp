@@ -42,7 +42,7 @@ void Padding<InputDataType, OutputDataType>::Forward(
 {
   nRows = input.n_rows;
   nCols = input.n_cols;
-  output = arma::zeros(nRows + padWLeft + padWRight,
+  output = arma::zeros<arma::Mat<eT>>(nRows + padWLeft + padWRight,
       nCols + padHTop + padHBottom);
   output.submat(padWLeft, padHTop, padWLeft + nRows - 1,
       padHTop + nCols - 1) = input;
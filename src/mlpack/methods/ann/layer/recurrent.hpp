@@ -44,6 +44,10 @@ template <
 class Recurrent
 {
  public:
+  static_assert(std::is_same<InputDataType, arma::mat>::value &&
+      std::is_same<OutputDataType, arma::mat>::value,
+      "Recurrent holds LayerTypes, which only support arma::mat");
+
   /**
    * Default constructor---this will create a Recurrent object that can't be
    * used, so be careful!  Make sure to set all the parameters before use.
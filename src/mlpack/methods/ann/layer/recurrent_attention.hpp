@@ -56,6 +56,10 @@ template <
 class RecurrentAttention
 {
  public:
+  static_assert(std::is_same<InputDataType, arma::mat>::value &&
+      std::is_same<OutputDataType, arma::mat>::value,
+      "RecurrentAttention holds LayerTypes, which only support arma::mat");
+
   /**
    * Default constructor: this will not give a usable RecurrentAttention object,
    * so be sure to set all the parameters before use.
@@ -73,6 +73,10 @@ template <
 class Sequential
 {
  public:
+  static_assert(std::is_same<InputDataType, arma::mat>::value &&
+      std::is_same<OutputDataType, arma::mat>::value,
+      "Sequential holds LayerTypes, which only support arma::mat");
+
   /**
    * Create the Sequential object using the specified parameters.
    *
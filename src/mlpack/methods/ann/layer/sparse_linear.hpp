@@ -0,0 +1,182 @@
+/**
+ * @file methods/ann/layer/sparse_linear.hpp
+ *
+ * Definition of the SparseLinear layer class, a linear layer whose weights are
+ * stored as a sparse matrix.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_SPARSE_LINEAR_HPP
+#define MLPACK_METHODS_ANN_LAYER_SPARSE_LINEAR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "layer_types.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Implementation of the SparseLinear layer class.  The SparseLinear layer
+ * computes the same affine transformation as the Linear layer, but its weights
+ * are stored as a sparse matrix, so that a pruned layer (see pruning.hpp) only
+ * uses memory and time in proportion to its number of non-zero weights.  The
+ * bias is stored densely.
+ *
+ * The weights of a SparseLinear layer are not trainable: the layer is meant
+ * for serving a network that was trained and pruned with Linear layers.  The
+ * error is still propagated backwards through the layer.  A trained network
+ * can be converted with FFN::SparsifyLinear().
+ *
+ * @code
+ * PruneLinear(model, 0.9);
+ * model.SparsifyLinear();
+ * data::Save("model.bin", "model", model);
+ * @endcode
+ *
+ * @tparam InputDataType Type of the input data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ * @tparam OutputDataType Type of the output data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ */
+template <
+    typename InputDataType = arma::mat,
+    typename OutputDataType = arma::mat
+>
+class SparseLinear
+{
+ public:
+  //! Create the SparseLinear object.
+  SparseLinear();
+
+  /**
+   * Create the SparseLinear layer object using the specified number of units.
+   * All the weights and biases are zero.
+   *
+   * @param inSize The number of input units.
+   * @param outSize The number of output units.
+   */
+  SparseLinear(const size_t inSize, const size_t outSize);
+
+  /**
+   * Create the SparseLinear layer object from the given weights; only the
+   * non-zero weights are stored.
+   *
+   * @param weight The weights, with one row for each output unit.
+   * @param bias The bias of each output unit.
+   */
+  SparseLinear(const arma::mat& weight, const arma::vec& bias);
+
+  /**
+   * Create the SparseLinear layer object from the weights of the given Linear
+   * layer; only the non-zero weights are stored.
+   *
+   * @param layer The Linear layer to convert.
+   */
+  template<typename RegularizerType>
+  SparseLinear(
+      const Linear<InputDataType, OutputDataType, RegularizerType>& layer);
+
+  /**
+   * Ordinary feed forward pass of a neural network, evaluating the function
+   * f(x) by propagating the activity forward through f.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  template<typename eT>
+  void Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output);
+
+  /**
+   * Ordinary feed backward pass of a neural network, calculating the function
+   * f(x) by propagating x backwards trough f. Using the results from the feed
+   * forward pass.
+   *
+   * @param * (input) The propagated input activation.
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  template<typename eT>
+  void Backward(const arma::Mat<eT>& /* input */,
+                const arma::Mat<eT>& gy,
+                arma::Mat<eT>& g);
+
+  //! Get the input parameter.
+  InputDataType const& InputParameter() const { return inputParameter; }
+  //! Modify the input parameter.
+  InputDataType& InputParameter() { return inputParameter; }
+
+  //! Get the output parameter.
+  OutputDataType const& OutputParameter() const { return outputParameter; }
+  //! Modify the output parameter.
+  OutputDataType& OutputParameter() { return outputParameter; }
+
+  //! Get the delta.
+  OutputDataType const& Delta() const { return delta; }
+  //! Modify the delta.
+  OutputDataType& Delta() { return delta; }
+
+  //! Get the input size.
+  size_t InputSize() const { return inSize; }
+
+  //! Get the output size.
+  size_t OutputSize() const { return outSize; }
+
+  //! Get the sparse weight of the layer.
+  arma::sp_mat const& Weight() const { return weight; }
+  //! Modify the sparse weight of the layer.
+  arma::sp_mat& Weight() { return weight; }
+
+  //! Get the bias of the layer.
+  arma::vec const& Bias() const { return bias; }
+  //! Modify the bias of the layer.
+  arma::vec& Bias() { return bias; }
+
+  //! Get the number of non-zero weights.
+  size_t NonZeros() const { return weight.n_nonzero; }
+
+  //! Get the shape of the input.
+  size_t InputShape() const
+  {
+    return inSize;
+  }
+
+  /**
+   * Serialize the layer.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored number of input units.
+  size_t inSize;
+
+  //! Locally-stored number of output units.
+  size_t outSize;
+
+  //! Locally-stored sparse weight, with one row for each output unit.
+  arma::sp_mat weight;
+
+  //! Locally-stored bias term parameters.
+  arma::vec bias;
+
+  //! Locally-stored delta object.
+  OutputDataType delta;
+
+  //! Locally-stored input parameter object.
+  InputDataType inputParameter;
+
+  //! Locally-stored output parameter object.
+  OutputDataType outputParameter;
+}; // class SparseLinear
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "sparse_linear_impl.hpp"
+
+#endif
@@ -0,0 +1,111 @@
+/**
+ * @file methods/ann/layer/sparse_linear_impl.hpp
+ *
+ * Implementation of the SparseLinear layer class, a linear layer whose weights
+ * are stored as a sparse matrix.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_SPARSE_LINEAR_IMPL_HPP
+#define MLPACK_METHODS_ANN_LAYER_SPARSE_LINEAR_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "sparse_linear.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename InputDataType, typename OutputDataType>
+SparseLinear<InputDataType, OutputDataType>::SparseLinear() :
+    inSize(0),
+    outSize(0)
+{
+  // Nothing to do here.
+}
+
+template<typename InputDataType, typename OutputDataType>
+SparseLinear<InputDataType, OutputDataType>::SparseLinear(
+    const size_t inSize,
+    const size_t outSize) :
+    inSize(inSize),
+    outSize(outSize),
+    weight(outSize, inSize),
+    bias(outSize, arma::fill::zeros)
+{
+  // Nothing to do here.
+}
+
+template<typename InputDataType, typename OutputDataType>
+SparseLinear<InputDataType, OutputDataType>::SparseLinear(
+    const arma::mat& weight,
+    const arma::vec& bias) :
+    inSize(weight.n_cols),
+    outSize(weight.n_rows),
+    weight(weight),
+    bias(bias)
+{
+  if (bias.n_elem != outSize)
+  {
+    std::ostringstream oss;
+    oss << "SparseLinear::SparseLinear(): the bias has " << bias.n_elem
+        << " elements, but the weight has " << outSize << " rows!";
+    throw std::invalid_argument(oss.str());
+  }
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename RegularizerType>
+SparseLinear<InputDataType, OutputDataType>::SparseLinear(
+    const Linear<InputDataType, OutputDataType, RegularizerType>& layer) :
+    inSize(layer.InputSize()),
+    outSize(layer.OutputSize())
+{
+  // The parameters of the Linear layer hold the weight (column-major), then
+  // the bias.
+  const OutputDataType& parameters = layer.Parameters();
+  if (parameters.n_elem != layer.WeightSize())
+  {
+    throw std::invalid_argument("SparseLinear::SparseLinear(): the weights of "
+        "the Linear layer are not initialized!");
+  }
+
+  weight = arma::sp_mat(arma::mat(const_cast<double*>(parameters.memptr()),
+      outSize, inSize, false, true));
+  bias = parameters.rows(inSize * outSize, parameters.n_elem - 1);
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename eT>
+void SparseLinear<InputDataType, OutputDataType>::Forward(
+    const arma::Mat<eT>& input, arma::Mat<eT>& output)
+{
+  output = weight * input;
+  output.each_col() += bias;
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename eT>
+void SparseLinear<InputDataType, OutputDataType>::Backward(
+    const arma::Mat<eT>& /* input */, const arma::Mat<eT>& gy, arma::Mat<eT>& g)
+{
+  g = weight.t() * gy;
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename Archive>
+void SparseLinear<InputDataType, OutputDataType>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(outSize));
+  ar(CEREAL_NVP(weight));
+  ar(CEREAL_NVP(bias));
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -13,7 +13,7 @@
 #define MLPACK_METHODS_ANN_LAYER_SPATIAL_DROPOUT_HPP
 
 #include <mlpack/prereqs.hpp>
-#include <mlpack/methods/ann/dists/bernoulli_distribution.hpp>
+#include <mlpack/methods/ann/util/dropout_mask.hpp>
 
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
@@ -123,8 +123,8 @@ class SpatialDropout
   //! Locally-stored output parameter object.
   OutputDataType outputParameter;
 
-  //! Locally-stored mast object.
-  OutputDataType mask;
+  //! Locally-stored mask object (one bit per channel).
+  DropoutMask mask;
 
   //! The number of channels of each input image.
   size_t size;
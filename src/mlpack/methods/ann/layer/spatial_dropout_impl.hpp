@@ -70,15 +70,16 @@ void SpatialDropout<InputDataType, OutputDataType>::Forward(
         size, batchSize, false, false);
     arma::cube outputTemp(const_cast<arma::mat&>(output).memptr(), inputSize,
         size, batchSize, false, false);
-    arma::mat probabilities(1, size);
-    arma::mat maskRow(1, size);
-    probabilities.fill(ratio);
-    ann::BernoulliDistribution<> bernoulli_dist(probabilities, false);
-    maskRow = bernoulli_dist.Sample();
-    mask = arma::repmat(maskRow, inputSize, 1);
-
+    // Drop whole feature maps with probability ratio.
+    mask.Generate(size, ratio);
     for (size_t n = 0; n < batchSize; n++)
-      outputTemp.slice(n) = inputTemp.slice(n) % mask * scale;
+    {
+      for (size_t c = 0; c < size; ++c)
+      {
+        if (mask.Kept(c))
+          outputTemp.slice(n).col(c) = inputTemp.slice(n).col(c) * scale;
+      }
+    }
   }
 }
 
@@ -94,7 +95,13 @@ void SpatialDropout<InputDataType, OutputDataType>::Backward(
       batchSize, false, false);
 
   for (size_t n = 0; n < batchSize; n++)
-    gTemp.slice(n) = gyTemp.slice(n) % mask * scale;
+  {
+    for (size_t c = 0; c < size; ++c)
+    {
+      if (mask.Kept(c))
+        gTemp.slice(n).col(c) = gyTemp.slice(n).col(c) * scale;
+    }
+  }
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -49,6 +49,9 @@ template <
 class TransposedConvolution
 {
  public:
+  // Convenience typedefs.
+  typedef typename OutputDataType::elem_type ElemType;
+
   //! Create the Transposed Convolution object.
   TransposedConvolution();
 
@@ -179,14 +182,14 @@ class TransposedConvolution
   OutputDataType& Parameters() { return weights; }
 
   //! Get the weight of the layer.
-  arma::cube const& Weight() const { return weight; }
+  arma::Cube<ElemType> const& Weight() const { return weight; }
   //! Modify the weight of the layer.
-  arma::cube& Weight() { return weight; }
+  arma::Cube<ElemType>& Weight() { return weight; }
 
   //! Get the bias of the layer.
-  arma::mat const& Bias() const { return bias; }
+  OutputDataType const& Bias() const { return bias; }
   //! Modify the bias of the layer.
-  arma::mat& Bias() { return bias; }
+  OutputDataType& Bias() { return bias; }
 
   //! Get the input parameter.
   InputDataType const& InputParameter() const { return inputParameter; }
@@ -428,10 +431,10 @@ class TransposedConvolution
   OutputDataType weights;
 
   //! Locally-stored weight object.
-  arma::cube weight;
+  arma::Cube<ElemType> weight;
 
   //! Locally-stored bias term object.
-  arma::mat bias;
+  OutputDataType bias;
 
   //! Locally-stored input width.
   size_t inputWidth;
@@ -446,19 +449,19 @@ class TransposedConvolution
   size_t outputHeight;
 
   //! Locally-stored transformed output parameter.
-  arma::cube outputTemp;
+  arma::Cube<ElemType> outputTemp;
 
   //! Locally-stored transformed padded input parameter.
-  arma::cube inputPaddedTemp;
+  arma::Cube<ElemType> inputPaddedTemp;
 
   //! Locally-stored transformed expanded input parameter.
-  arma::cube inputExpandedTemp;
+  arma::Cube<ElemType> inputExpandedTemp;
 
   //! Locally-stored transformed error parameter.
-  arma::cube gTemp;
+  arma::Cube<ElemType> gTemp;
 
   //! Locally-stored transformed gradient parameter.
-  arma::cube gradientTemp;
+  arma::Cube<ElemType> gradientTemp;
 
   //! Locally-stored padding layer for forward propagation.
   ann::Padding<> paddingForward;
@@ -38,6 +38,10 @@ template <
 class VRClassReward
 {
  public:
+  static_assert(std::is_same<InputDataType, arma::mat>::value &&
+      std::is_same<OutputDataType, arma::mat>::value,
+      "VRClassReward holds LayerTypes, which only support arma::mat");
+
   /**
    * Create the VRClassReward object.
    *
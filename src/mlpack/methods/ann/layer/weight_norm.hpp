@@ -61,6 +61,10 @@ template <
 class WeightNorm
 {
  public:
+  static_assert(std::is_same<InputDataType, arma::mat>::value &&
+      std::is_same<OutputDataType, arma::mat>::value,
+      "WeightNorm holds LayerTypes, which only support arma::mat");
+
   /**
    * Create the WeightNorm layer object.
    *
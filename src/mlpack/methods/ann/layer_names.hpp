@@ -184,6 +184,17 @@ class LayerNameVisitor : public boost::static_visitor<std::string>
     return "noisylinear";
   }
 
+  /**
+   * Return the name of the given layer of type SparseLinear as a string.
+   *
+   * @param * Given layer of type SparseLinear.
+   * @return The string representation of the layer.
+   */
+  std::string LayerString(SparseLinear<>* /*layer*/) const
+  {
+    return "sparselinear";
+  }
+
   /**
    * Return the name of the given layer of type MaxPooling as a string.
    *
@@ -0,0 +1,107 @@
+/**
+ * @file methods/ann/loss_functions/softmax_cross_entropy_loss.hpp
+ *
+ * Definition of the SoftmaxCrossEntropyLoss class, which fuses a softmax with
+ * the negative log likelihood.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LOSS_FUNCTION_SOFTMAX_CROSS_ENTROPY_LOSS_HPP
+#define MLPACK_METHODS_ANN_LOSS_FUNCTION_SOFTMAX_CROSS_ENTROPY_LOSS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * The softmax cross-entropy loss computes the negative log likelihood of the
+ * softmax of its input, directly from the unnormalized log-probabilities
+ * (logits).  It replaces a LogSoftMax layer followed by the
+ * NegativeLogLikelihood loss: the loss of each point is computed in one pass
+ * over its logits with the log-sum-exp trick, and the gradient with respect to
+ * the logits, softmax(x) - onehot(target), is computed in one more pass,
+ * without storing the log-probabilities or propagating the error through the
+ * LogSoftMax layer.  This saves memory and time when there are many classes,
+ * and avoids taking the exponential of large log-probabilities.
+ *
+ * As with NegativeLogLikelihood, the target of each point is a class index, in
+ * the range between 0 and the number of classes minus 1.  Since the network
+ * has no softmax layer, FFN::Predict() returns the logits; their largest
+ * element is still the predicted class.
+ *
+ * @code
+ * FFN<SoftmaxCrossEntropyLoss<>> model;
+ * model.Add<Linear<>>(inputSize, hiddenSize);
+ * model.Add<ReLULayer<>>();
+ * model.Add<Linear<>>(hiddenSize, numClasses);
+ * @endcode
+ *
+ * @tparam InputDataType Type of the input data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ * @tparam OutputDataType Type of the output data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ */
+template <
+    typename InputDataType = arma::mat,
+    typename OutputDataType = arma::mat
+>
+class SoftmaxCrossEntropyLoss
+{
+ public:
+  /**
+   * Create the SoftmaxCrossEntropyLoss object.
+   */
+  SoftmaxCrossEntropyLoss();
+
+  /**
+   * Computes the softmax cross-entropy loss.
+   *
+   * @param prediction Logits (one column per point).
+   * @param target The target vector, that contains the class index in the range
+   *        between 0 and the number of classes minus 1.
+   */
+  template<typename PredictionType, typename TargetType>
+  typename PredictionType::elem_type Forward(const PredictionType& prediction,
+                                             const TargetType& target);
+
+  /**
+   * Ordinary feed backward pass of a neural network: computes the gradient of
+   * the loss with respect to the logits, softmax(prediction) - onehot(target).
+   *
+   * @param prediction Logits (one column per point).
+   * @param target The target vector, that contains the class index in the range
+   *        between 0 and the number of classes minus 1.
+   * @param loss The calculated error.
+   */
+  template<typename PredictionType, typename TargetType, typename LossType>
+  void Backward(const PredictionType& prediction,
+                const TargetType& target,
+                LossType& loss);
+
+  //! Get the output parameter.
+  OutputDataType& OutputParameter() const { return outputParameter; }
+  //! Modify the output parameter.
+  OutputDataType& OutputParameter() { return outputParameter; }
+
+  /**
+   * Serialize the layer.
+   */
+  template<typename Archive>
+  void serialize(Archive& /* ar */, const uint32_t /* version */);
+
+ private:
+  //! Locally-stored output parameter object.
+  OutputDataType outputParameter;
+}; // class SoftmaxCrossEntropyLoss
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "softmax_cross_entropy_loss_impl.hpp"
+
+#endif
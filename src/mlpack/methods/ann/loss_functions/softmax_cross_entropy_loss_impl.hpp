@@ -0,0 +1,103 @@
+/**
+ * @file methods/ann/loss_functions/softmax_cross_entropy_loss_impl.hpp
+ *
+ * Implementation of the SoftmaxCrossEntropyLoss class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LOSS_FUNCTION_SOFTMAX_CROSS_ENTROPY_LOSS_IMPL_HPP
+#define MLPACK_METHODS_ANN_LOSS_FUNCTION_SOFTMAX_CROSS_ENTROPY_LOSS_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "softmax_cross_entropy_loss.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename InputDataType, typename OutputDataType>
+SoftmaxCrossEntropyLoss<InputDataType, OutputDataType>::
+SoftmaxCrossEntropyLoss()
+{
+  // Nothing to do here.
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename PredictionType, typename TargetType>
+typename PredictionType::elem_type
+SoftmaxCrossEntropyLoss<InputDataType, OutputDataType>::Forward(
+    const PredictionType& prediction,
+    const TargetType& target)
+{
+  typedef typename PredictionType::elem_type ElemType;
+  const size_t n = prediction.n_rows;
+
+  ElemType output = 0;
+  #pragma omp parallel for reduction(+:output)
+  for (omp_size_t i = 0; i < (omp_size_t) prediction.n_cols; ++i)
+  {
+    Log::Assert(target(i) >= 0 && target(i) < n, "Target class out of range.");
+
+    // log(sum(exp(x))) - x[target], shifted by the largest logit so that no
+    // exponential overflows.
+    const ElemType* logits = prediction.colptr(i);
+    const ElemType maxLogit = *std::max_element(logits, logits + n);
+    ElemType sum = 0;
+    for (size_t j = 0; j < n; ++j)
+      sum += std::exp(logits[j] - maxLogit);
+
+    output += maxLogit + std::log(sum) - logits[(size_t) target(i)];
+  }
+
+  return output;
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename PredictionType, typename TargetType, typename LossType>
+void SoftmaxCrossEntropyLoss<InputDataType, OutputDataType>::Backward(
+    const PredictionType& prediction,
+    const TargetType& target,
+    LossType& loss)
+{
+  typedef typename PredictionType::elem_type ElemType;
+  const size_t n = prediction.n_rows;
+
+  loss.set_size(prediction.n_rows, prediction.n_cols);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) prediction.n_cols; ++i)
+  {
+    Log::Assert(target(i) >= 0 && target(i) < n, "Target class out of range.");
+
+    const ElemType* logits = prediction.colptr(i);
+    ElemType* gradient = loss.colptr(i);
+    const ElemType maxLogit = *std::max_element(logits, logits + n);
+    ElemType sum = 0;
+    for (size_t j = 0; j < n; ++j)
+    {
+      gradient[j] = std::exp(logits[j] - maxLogit);
+      sum += gradient[j];
+    }
+
+    const ElemType scale = 1 / sum;
+    for (size_t j = 0; j < n; ++j)
+      gradient[j] *= scale;
+
+    gradient[(size_t) target(i)] -= 1;
+  }
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename Archive>
+void SoftmaxCrossEntropyLoss<InputDataType, OutputDataType>::serialize(
+    Archive& /* ar */,
+    const uint32_t /* version */)
+{
+  // Nothing to do here.
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
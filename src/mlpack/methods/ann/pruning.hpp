@@ -0,0 +1,116 @@
+/**
+ * @file methods/ann/pruning.hpp
+ *
+ * Magnitude pruning of the weights of trained networks.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_PRUNING_HPP
+#define MLPACK_METHODS_ANN_PRUNING_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "layer/layer.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Unstructured magnitude pruning: set the given fraction of the weights with
+ * the smallest absolute values to zero.
+ *
+ * @param weight Weights to prune.
+ * @param sparsity Fraction of the weights to set to zero, in [0, 1].
+ * @return The number of weights that were set to zero.
+ */
+inline size_t PruneWeights(arma::mat& weight, const double sparsity)
+{
+  if (sparsity < 0.0 || sparsity > 1.0)
+  {
+    throw std::invalid_argument("PruneWeights(): the sparsity must be in "
+        "[0, 1]!");
+  }
+
+  const size_t numPruned = (size_t) (sparsity * weight.n_elem);
+  if (numPruned == 0)
+    return 0;
+
+  const arma::uvec order = arma::sort_index(arma::abs(arma::vectorise(
+      weight)));
+  weight.elem(order.head(numPruned)).zeros();
+  return numPruned;
+}
+
+/**
+ * Structured magnitude pruning: set the weights of the given fraction of the
+ * units (rows of the weight matrix) with the smallest L2 norms to zero.  The
+ * output of a pruned unit is then its bias.
+ *
+ * @param weight Weights to prune, with one row for each unit.
+ * @param sparsity Fraction of the units to prune, in [0, 1].
+ * @return The number of units that were pruned.
+ */
+inline size_t PruneUnits(arma::mat& weight, const double sparsity)
+{
+  if (sparsity < 0.0 || sparsity > 1.0)
+  {
+    throw std::invalid_argument("PruneUnits(): the sparsity must be in "
+        "[0, 1]!");
+  }
+
+  const size_t numPruned = (size_t) (sparsity * weight.n_rows);
+  if (numPruned == 0)
+    return 0;
+
+  const arma::uvec order = arma::sort_index(arma::sum(arma::square(weight),
+      1));
+  weight.rows(order.head(numPruned)).zeros();
+  return numPruned;
+}
+
+/**
+ * Prune the weights of each Linear layer of the given trained network in
+ * place, with PruneWeights() or PruneUnits().  The biases are not pruned.  The
+ * pruned network can then be fine-tuned (the pruned weights may become
+ * non-zero again), and converted for inference with FFN::SparsifyLinear().
+ *
+ * @param network Network to prune.
+ * @param sparsity Fraction of the weights (or units) of each Linear layer to
+ *     prune, in [0, 1].
+ * @param structured If true, prune whole units instead of single weights.
+ * @return The number of weights that were set to zero.
+ */
+template<typename NetworkType>
+size_t PruneLinear(NetworkType& network,
+                   const double sparsity,
+                   const bool structured = false)
+{
+  if (network.Parameters().is_empty())
+    network.ResetParameters();
+
+  size_t numPruned = 0;
+  for (size_t i = 0; i < network.Model().size(); ++i)
+  {
+    Linear<>** layer = boost::get<Linear<>*>(&network.Model()[i]);
+    if (!layer)
+      continue;
+
+    // The weight is stored first in the parameters of the layer.
+    arma::mat weight((*layer)->Parameters().memptr(), (*layer)->OutputSize(),
+        (*layer)->InputSize(), false, true);
+    if (structured)
+      numPruned += PruneUnits(weight, sparsity) * weight.n_cols;
+    else
+      numPruned += PruneWeights(weight, sparsity);
+  }
+
+  return numPruned;
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
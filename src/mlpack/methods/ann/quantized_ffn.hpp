@@ -0,0 +1,176 @@
+/**
+ * @file methods/ann/quantized_ffn.hpp
+ *
+ * Definition of the QuantizedFFN class, an int8 inference version of a trained
+ * feed forward network.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_QUANTIZED_FFN_HPP
+#define MLPACK_METHODS_ANN_QUANTIZED_FFN_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "ffn.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * QuantizedFFN is a post-training quantized copy of a trained FFN, for fast
+ * inference with less memory.  The weights of the Linear and Convolution
+ * layers are stored as 8-bit integers, with one scale per output (or output
+ * map), and the inputs of these layers are quantized to 8-bit integers with
+ * one scale per layer, calibrated on a sample of the data: the largest
+ * absolute value of the input of the layer over the sample is mapped to 127.
+ * The products are then computed with 8-bit integers and 32-bit accumulators,
+ * and the outputs are scaled back to floating point, where the bias and the
+ * activation functions are applied.  The integer dot products are written so
+ * that the compiler can vectorize them (with VNNI instructions when compiling
+ * for a CPU that has them).
+ *
+ * The following layers are supported: Linear, Convolution, ReLULayer,
+ * LeakyReLU, SigmoidLayer, TanHLayer, IdentityLayer, Softmax and LogSoftMax,
+ * as well as Dropout, which does nothing at inference time.
+ * BatchNorm layers can be folded into the layers before them with
+ * FFN::FoldBatchNorm() before quantization.
+ *
+ * @code
+ * FFN<NegativeLogLikelihood<>> model;
+ * // ... build and train the model ...
+ * QuantizedFFN quantized(model, calibrationData);
+ * quantized.Predict(testData, predictions);
+ * @endcode
+ */
+class QuantizedFFN
+{
+ public:
+  //! Create an empty QuantizedFFN (to be loaded).
+  QuantizedFFN() { }
+
+  /**
+   * Quantize the given trained network, calibrating the scales of the inputs
+   * of its layers on the given data.  The network is run on the calibration
+   * data in deterministic mode.
+   *
+   * @param network Trained network to quantize.
+   * @param calibrationData Sample of the data the network will be used on.
+   */
+  template<typename OutputLayerType, typename InitializationRuleType,
+           typename... CustomLayers>
+  QuantizedFFN(
+      FFN<OutputLayerType, InitializationRuleType, CustomLayers...>& network,
+      const arma::mat& calibrationData);
+
+  /**
+   * Predict the responses to the given predictors, passing batchSize points
+   * through the network at a time.  The points of each batch are processed in
+   * parallel when OpenMP is available.
+   *
+   * @param predictors Input predictors.
+   * @param results Matrix to put the output predictions into.
+   * @param batchSize Number of points to pass through the network at once.
+   */
+  void Predict(const arma::mat& predictors,
+               arma::mat& results,
+               const size_t batchSize = 128) const;
+
+  //! Get the number of layers.
+  size_t NumLayers() const { return layers.size(); }
+
+  //! Get the number of bytes used by the quantized weights.
+  size_t WeightBytes() const;
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! The types of layers supported by QuantizedFFN.
+  enum LayerKind
+  {
+    LINEAR,
+    CONVOLUTION,
+    RELU,
+    LEAKY_RELU,
+    SIGMOID,
+    TANH,
+    IDENTITY,
+    SOFTMAX,
+    LOG_SOFTMAX
+  };
+
+  //! A layer of the quantized network.
+  struct QuantizedLayer
+  {
+    //! The type of the layer.
+    size_t kind = IDENTITY;
+    //! The number of inputs (or input maps) of a Linear (or Convolution)
+    //! layer.
+    size_t inSize = 0;
+    //! The number of outputs (or output maps) of a Linear (or Convolution)
+    //! layer.
+    size_t outSize = 0;
+    //! The shape of a Convolution layer: input width and height, kernel width
+    //! and height, strides, paddings (left, top), and output width and height.
+    size_t inputWidth = 0, inputHeight = 0;
+    size_t kernelWidth = 0, kernelHeight = 0;
+    size_t strideWidth = 0, strideHeight = 0;
+    size_t padWLeft = 0, padHTop = 0;
+    size_t outputWidth = 0, outputHeight = 0;
+    //! The quantized weights, one contiguous row of inputs (input maps times
+    //! kernel elements, for a Convolution layer) for each output.
+    std::vector<int8_t> weights;
+    //! The scale of the quantized weights of each output.
+    arma::vec weightScales;
+    //! The bias of each output.
+    arma::vec bias;
+    //! The scale of the quantized input.
+    double inputScale = 1.0;
+    //! The slope of a LeakyReLU layer for negative inputs.
+    double alpha = 0.0;
+
+    //! Serialize the layer.
+    template<typename Archive>
+    void serialize(Archive& ar, const uint32_t /* version */);
+  };
+
+  //! Quantize the weights of a layer (one row of the given matrix for each
+  //! output).
+  static void QuantizeWeights(const arma::mat& weights, QuantizedLayer& layer);
+
+  //! Quantize the given values with the given scale.
+  static void QuantizeInput(const arma::mat& input,
+                            const double scale,
+                            std::vector<int8_t>& output);
+
+  //! Compute the dot product of two vectors of 8-bit integers.
+  static int32_t Dot(const int8_t* a, const int8_t* b, const size_t n);
+
+  //! Apply a quantized Linear layer.
+  static void LinearForward(const QuantizedLayer& layer,
+                            const arma::mat& input,
+                            arma::mat& output);
+
+  //! Apply a quantized Convolution layer.
+  static void ConvolutionForward(const QuantizedLayer& layer,
+                                 const arma::mat& input,
+                                 arma::mat& output);
+
+  //! Apply an activation layer in place.
+  static void ActivationForward(const QuantizedLayer& layer, arma::mat& data);
+
+  //! The layers of the network.
+  std::vector<QuantizedLayer> layers;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "quantized_ffn_impl.hpp"
+
+#endif
@@ -0,0 +1,421 @@
+/**
+ * @file methods/ann/quantized_ffn_impl.hpp
+ *
+ * Implementation of the QuantizedFFN class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_QUANTIZED_FFN_IMPL_HPP
+#define MLPACK_METHODS_ANN_QUANTIZED_FFN_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "quantized_ffn.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+QuantizedFFN::QuantizedFFN(
+    FFN<OutputLayerType, InitializationRuleType, CustomLayers...>& network,
+    const arma::mat& calibrationData)
+{
+  if (calibrationData.n_cols == 0)
+  {
+    throw std::invalid_argument("QuantizedFFN::QuantizedFFN(): the "
+        "calibration data must not be empty!");
+  }
+
+  // A full pass in deterministic mode also sets the input shape of the
+  // Convolution layers.
+  arma::mat output;
+  network.Predict(calibrationData, output);
+
+  // Pass the calibration data through the network one layer at a time, to see
+  // the range of the input of every layer.
+  arma::mat input = calibrationData;
+  for (size_t i = 0; i < network.Model().size(); ++i)
+  {
+    const LayerTypes<CustomLayers...>& layer = network.Model()[i];
+    QuantizedLayer quantized;
+    quantized.inputScale = arma::abs(input).max() / 127.0;
+    if (quantized.inputScale == 0.0)
+      quantized.inputScale = 1.0;
+
+    if (Linear<>* const* linear = boost::get<Linear<>*>(&layer))
+    {
+      quantized.kind = LINEAR;
+      quantized.inSize = (*linear)->InputSize();
+      quantized.outSize = (*linear)->OutputSize();
+      QuantizeWeights((*linear)->Weight(), quantized);
+      quantized.bias = arma::vectorise((*linear)->Bias());
+    }
+    else if (Convolution<>* const* convolution =
+        boost::get<Convolution<>*>(&layer))
+    {
+      const Convolution<>& conv = **convolution;
+      quantized.kind = CONVOLUTION;
+      quantized.inSize = conv.InputSize();
+      quantized.outSize = conv.OutputSize();
+      quantized.inputWidth = conv.InputWidth();
+      quantized.inputHeight = conv.InputHeight();
+      quantized.kernelWidth = conv.KernelWidth();
+      quantized.kernelHeight = conv.KernelHeight();
+      quantized.strideWidth = conv.StrideWidth();
+      quantized.strideHeight = conv.StrideHeight();
+      quantized.padWLeft = conv.PadWLeft();
+      quantized.padHTop = conv.PadHTop();
+      quantized.outputWidth = conv.OutputWidth();
+      quantized.outputHeight = conv.OutputHeight();
+
+      // Column o of this matrix holds the kernels of output map o for every
+      // input map, in the order used to unfold the input.
+      const arma::mat kernels(const_cast<double*>(conv.Weight().memptr()),
+          conv.Weight().n_elem / quantized.outSize, quantized.outSize, false,
+          true);
+      QuantizeWeights(kernels.t(), quantized);
+      quantized.bias = arma::vectorise(conv.Bias());
+    }
+    else if (boost::get<ReLULayer<>*>(&layer))
+    {
+      quantized.kind = RELU;
+    }
+    else if (LeakyReLU<>* const* leakyReLU = boost::get<LeakyReLU<>*>(&layer))
+    {
+      quantized.kind = LEAKY_RELU;
+      quantized.alpha = (*leakyReLU)->Alpha();
+    }
+    else if (boost::get<SigmoidLayer<>*>(&layer))
+    {
+      quantized.kind = SIGMOID;
+    }
+    else if (boost::get<TanHLayer<>*>(&layer))
+    {
+      quantized.kind = TANH;
+    }
+    else if (boost::get<IdentityLayer<>*>(&layer) ||
+        boost::get<Dropout<>*>(&layer))
+    {
+      // Dropout does nothing in deterministic mode.
+      quantized.kind = IDENTITY;
+    }
+    else if (boost::get<Softmax<>*>(&layer))
+    {
+      quantized.kind = SOFTMAX;
+    }
+    else if (boost::get<LogSoftMax<>*>(&layer))
+    {
+      quantized.kind = LOG_SOFTMAX;
+    }
+    else
+    {
+      std::ostringstream oss;
+      oss << "QuantizedFFN::QuantizedFFN(): layer " << i << " of the network "
+          << "is not supported!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    layers.push_back(std::move(quantized));
+
+    if (i + 1 < network.Model().size())
+    {
+      arma::mat next;
+      network.Forward(input, next, i, i);
+      input = std::move(next);
+    }
+  }
+}
+
+inline void QuantizedFFN::Predict(const arma::mat& predictors,
+                                  arma::mat& results,
+                                  const size_t batchSize) const
+{
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("QuantizedFFN::Predict(): batchSize must be "
+        "greater than 0");
+  }
+
+  if (predictors.n_cols == 0 || layers.empty())
+  {
+    results.set_size(0, 0);
+    return;
+  }
+
+  for (size_t i = 0; i < predictors.n_cols; i += batchSize)
+  {
+    const size_t end = std::min(i + batchSize, (size_t) predictors.n_cols);
+    arma::mat data = predictors.cols(i, end - 1);
+    arma::mat next;
+    for (size_t l = 0; l < layers.size(); ++l)
+    {
+      if (layers[l].kind == LINEAR)
+      {
+        LinearForward(layers[l], data, next);
+        data.swap(next);
+      }
+      else if (layers[l].kind == CONVOLUTION)
+      {
+        ConvolutionForward(layers[l], data, next);
+        data.swap(next);
+      }
+      else
+      {
+        ActivationForward(layers[l], data);
+      }
+    }
+
+    // The output dimensionality is only known after the first batch.
+    if (i == 0)
+      results.set_size(data.n_rows, predictors.n_cols);
+
+    results.cols(i, end - 1) = data;
+  }
+}
+
+inline size_t QuantizedFFN::WeightBytes() const
+{
+  size_t bytes = 0;
+  for (size_t l = 0; l < layers.size(); ++l)
+    bytes += layers[l].weights.size() * sizeof(int8_t);
+
+  return bytes;
+}
+
+template<typename Archive>
+void QuantizedFFN::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(layers));
+}
+
+template<typename Archive>
+void QuantizedFFN::QuantizedLayer::serialize(Archive& ar,
+                                             const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(kind));
+  ar(CEREAL_NVP(inSize));
+  ar(CEREAL_NVP(outSize));
+  ar(CEREAL_NVP(inputWidth));
+  ar(CEREAL_NVP(inputHeight));
+  ar(CEREAL_NVP(kernelWidth));
+  ar(CEREAL_NVP(kernelHeight));
+  ar(CEREAL_NVP(strideWidth));
+  ar(CEREAL_NVP(strideHeight));
+  ar(CEREAL_NVP(padWLeft));
+  ar(CEREAL_NVP(padHTop));
+  ar(CEREAL_NVP(outputWidth));
+  ar(CEREAL_NVP(outputHeight));
+  ar(CEREAL_NVP(weights));
+  ar(CEREAL_NVP(weightScales));
+  ar(CEREAL_NVP(bias));
+  ar(CEREAL_NVP(inputScale));
+  ar(CEREAL_NVP(alpha));
+}
+
+inline void QuantizedFFN::QuantizeWeights(const arma::mat& weights,
+                                          QuantizedLayer& layer)
+{
+  // Each output gets its own scale, so that outputs with small weights keep
+  // their precision.
+  layer.weightScales = arma::max(arma::abs(weights), 1) / 127.0;
+  layer.weightScales.replace(0.0, 1.0);
+
+  layer.weights.resize(weights.n_elem);
+  for (size_t o = 0; o < weights.n_rows; ++o)
+  {
+    for (size_t i = 0; i < weights.n_cols; ++i)
+    {
+      layer.weights[o * weights.n_cols + i] = (int8_t) std::round(
+          weights(o, i) / layer.weightScales[o]);
+    }
+  }
+}
+
+inline void QuantizedFFN::QuantizeInput(const arma::mat& input,
+                                        const double scale,
+                                        std::vector<int8_t>& output)
+{
+  output.resize(input.n_elem);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) input.n_elem; ++i)
+  {
+    // Values outside the calibrated range saturate.
+    const double value = std::round(input[i] / scale);
+    output[i] = (int8_t) std::min(std::max(value, -127.0), 127.0);
+  }
+}
+
+inline int32_t QuantizedFFN::Dot(const int8_t* a,
+                                 const int8_t* b,
+                                 const size_t n)
+{
+  int32_t sum = 0;
+  for (size_t i = 0; i < n; ++i)
+    sum += int32_t(a[i]) * int32_t(b[i]);
+
+  return sum;
+}
+
+inline void QuantizedFFN::LinearForward(const QuantizedLayer& layer,
+                                        const arma::mat& input,
+                                        arma::mat& output)
+{
+  if (input.n_rows != layer.inSize)
+  {
+    std::ostringstream oss;
+    oss << "QuantizedFFN::Predict(): the input of a linear layer has "
+        << input.n_rows << " dimensions, but " << layer.inSize
+        << " are expected!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  std::vector<int8_t> quantized;
+  QuantizeInput(input, layer.inputScale, quantized);
+  const arma::vec scales = layer.weightScales * layer.inputScale;
+
+  output.set_size(layer.outSize, input.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t j = 0; j < (omp_size_t) input.n_cols; ++j)
+  {
+    const int8_t* x = quantized.data() + j * layer.inSize;
+    for (size_t o = 0; o < layer.outSize; ++o)
+    {
+      output(o, j) = Dot(layer.weights.data() + o * layer.inSize, x,
+          layer.inSize) * scales[o] + layer.bias[o];
+    }
+  }
+}
+
+inline void QuantizedFFN::ConvolutionForward(const QuantizedLayer& layer,
+                                             const arma::mat& input,
+                                             arma::mat& output)
+{
+  const size_t inputMapSize = layer.inputWidth * layer.inputHeight;
+  if (input.n_rows != inputMapSize * layer.inSize)
+  {
+    std::ostringstream oss;
+    oss << "QuantizedFFN::Predict(): the input of a convolution layer has "
+        << input.n_rows << " dimensions, but " << inputMapSize * layer.inSize
+        << " are expected!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  std::vector<int8_t> quantized;
+  QuantizeInput(input, layer.inputScale, quantized);
+  const arma::vec scales = layer.weightScales * layer.inputScale;
+
+  const size_t outputPixels = layer.outputWidth * layer.outputHeight;
+  const size_t fanIn = layer.kernelWidth * layer.kernelHeight * layer.inSize;
+  output.set_size(outputPixels * layer.outSize, input.n_cols);
+
+  #pragma omp parallel
+  {
+    std::vector<int8_t> columns(fanIn * outputPixels);
+
+    #pragma omp for
+    for (omp_size_t j = 0; j < (omp_size_t) input.n_cols; ++j)
+    {
+      const int8_t* x = quantized.data() + j * input.n_rows;
+
+      // Unfold each kernel-sized patch of the input into a column (im2col).
+      // The padding is zero, which is also zero once quantized.
+      int8_t* column = columns.data();
+      for (size_t oc = 0; oc < layer.outputHeight; ++oc)
+      {
+        for (size_t orow = 0; orow < layer.outputWidth; ++orow)
+        {
+          for (size_t m = 0; m < layer.inSize; ++m)
+          {
+            const int8_t* map = x + m * inputMapSize;
+            for (size_t kc = 0; kc < layer.kernelHeight; ++kc)
+            {
+              const ptrdiff_t c = (ptrdiff_t) (oc * layer.strideHeight + kc) -
+                  (ptrdiff_t) layer.padHTop;
+              for (size_t kr = 0; kr < layer.kernelWidth; ++kr)
+              {
+                const ptrdiff_t r = (ptrdiff_t) (orow * layer.strideWidth +
+                    kr) - (ptrdiff_t) layer.padWLeft;
+                const bool inside = (r >= 0 &&
+                    r < (ptrdiff_t) layer.inputWidth && c >= 0 &&
+                    c < (ptrdiff_t) layer.inputHeight);
+                *column++ = inside ? map[c * layer.inputWidth + r] : 0;
+              }
+            }
+          }
+        }
+      }
+
+      // Output map o of the point occupies a contiguous block of the column
+      // of the output.
+      for (size_t o = 0; o < layer.outSize; ++o)
+      {
+        const int8_t* w = layer.weights.data() + o * fanIn;
+        double* out = output.colptr(j) + o * outputPixels;
+        for (size_t p = 0; p < outputPixels; ++p)
+        {
+          out[p] = Dot(w, columns.data() + p * fanIn, fanIn) * scales[o] +
+              layer.bias[o];
+        }
+      }
+    }
+  }
+}
+
+inline void QuantizedFFN::ActivationForward(const QuantizedLayer& layer,
+                                            arma::mat& data)
+{
+  switch (layer.kind)
+  {
+    case RELU:
+      data.transform([](const double x) { return std::max(x, 0.0); });
+      break;
+
+    case LEAKY_RELU:
+    {
+      const double alpha = layer.alpha;
+      data.transform([alpha](const double x)
+          { return (x > 0.0) ? x : alpha * x; });
+      break;
+    }
+
+    case SIGMOID:
+      data = 1.0 / (1.0 + arma::exp(-data));
+      break;
+
+    case TANH:
+      data = arma::tanh(data);
+      break;
+
+    case SOFTMAX:
+    {
+      const arma::rowvec maxima = arma::max(data, 0);
+      data.each_row() -= maxima;
+      data = arma::exp(data);
+      const arma::rowvec sums = arma::sum(data, 0);
+      data.each_row() /= sums;
+      break;
+    }
+
+    case LOG_SOFTMAX:
+    {
+      const arma::rowvec maxima = arma::max(data, 0);
+      data.each_row() -= maxima;
+      const arma::rowvec logSums = arma::log(arma::sum(arma::exp(data), 0));
+      data.each_row() -= logSums;
+      break;
+    }
+
+    default:
+      break;
+  }
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
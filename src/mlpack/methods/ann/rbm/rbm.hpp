@@ -380,6 +380,25 @@ class RBM
   void serialize(Archive& ar, const uint32_t version);
 
  private:
+  /**
+   * Replace each probability of the given matrix with a Bernoulli sample.  The
+   * columns (one per Gibbs chain) are sampled in parallel, each from its own
+   * random stream, so the samples do not depend on the number of threads.
+   *
+   * @param probabilities Probabilities to sample; overwritten with the samples.
+   */
+  void SampleBernoulli(arma::Mat<ElemType>& probabilities);
+
+  /**
+   * Add Gaussian noise of the given scale to each element of the given matrix
+   * of means.  As with SampleBernoulli(), the columns are sampled in parallel
+   * from their own random streams.
+   *
+   * @param means Means of the samples; overwritten with the samples.
+   * @param scale Scale of the noise.
+   */
+  void SampleNormal(arma::Mat<ElemType>& means, const ElemType scale);
+
   //! Locally stored parameters of the network.
   arma::Mat<ElemType> parameter;
   //! The matrix of data points (predictors).
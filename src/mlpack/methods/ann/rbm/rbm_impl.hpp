@@ -169,10 +169,7 @@ RBM<InitializationRuleType, DataType, PolicyType>::SampleHidden(
 {
   HiddenMean(input, output);
 
-  for (size_t i = 0; i < output.n_elem; ++i)
-  {
-    output(i) = math::RandBernoulli(output(i));
-  }
+  SampleBernoulli(output);
 }
 
 template<
@@ -188,10 +185,7 @@ RBM<InitializationRuleType, DataType, PolicyType>::SampleVisible(
 {
   VisibleMean(input, output);
 
-  for (size_t i = 0; i < output.n_elem; ++i)
-  {
-    output(i) = math::RandBernoulli(output(i));
-  }
+  SampleBernoulli(output);
 }
 
 template<
@@ -277,7 +271,7 @@ void RBM<InitializationRuleType, DataType, PolicyType>::Gradient(
   Phase(predictors.cols(i, i + batchSize - 1),
       positiveGradient);
 
-  for (size_t i = 0; i < negSteps; ++i)
+  for (size_t step = 0; step < negSteps; ++step)
   {
     Gibbs(predictors.cols(i, i + batchSize - 1),
         negativeSamples);
@@ -289,6 +283,45 @@ void RBM<InitializationRuleType, DataType, PolicyType>::Gradient(
   gradient = ((negativeGradient / negSteps) - positiveGradient);
 }
 
+template<
+  typename InitializationRuleType,
+  typename DataType,
+  typename PolicyType
+>
+void RBM<InitializationRuleType, DataType, PolicyType>::SampleBernoulli(
+    arma::Mat<ElemType>& probabilities)
+{
+  const size_t seed = math::RandomStreamSeed();
+  #pragma omp parallel for
+  for (omp_size_t c = 0; c < (omp_size_t) probabilities.n_cols; ++c)
+  {
+    math::RandomStream stream(seed, c);
+    ElemType* column = probabilities.colptr(c);
+    for (size_t r = 0; r < probabilities.n_rows; ++r)
+      column[r] = (math::Random() < column[r]) ? 1 : 0;
+  }
+}
+
+template<
+  typename InitializationRuleType,
+  typename DataType,
+  typename PolicyType
+>
+void RBM<InitializationRuleType, DataType, PolicyType>::SampleNormal(
+    arma::Mat<ElemType>& means,
+    const ElemType scale)
+{
+  const size_t seed = math::RandomStreamSeed();
+  #pragma omp parallel for
+  for (omp_size_t c = 0; c < (omp_size_t) means.n_cols; ++c)
+  {
+    math::RandomStream stream(seed, c);
+    ElemType* column = means.colptr(c);
+    for (size_t r = 0; r < means.n_rows; ++r)
+      column[r] += scale * math::RandNormal();
+  }
+}
+
 template<
   typename InitializationRuleType,
   typename DataType,
@@ -75,12 +75,15 @@ RBM<InitializationRuleType, DataType, PolicyType>::FreeEnergy(
   freeEnergy -= 0.5 * hiddenSize * poolSize *
       std::log((2.0 * M_PI) / slabPenalty);
 
+  // The squared norms of input^T W_i for all hidden units, from one product
+  // with the D x (K * N) matrix of all the weights.
+  const arma::Mat<ElemType> weights(weight.memptr(), visibleSize,
+      poolSize * hiddenSize, false, true);
+  const arma::Row<ElemType> sums = arma::sum(arma::reshape(arma::sum(
+      arma::square(input.t() * weights), 0), poolSize, hiddenSize), 0) /
+      (2.0 * slabPenalty);
   for (size_t i = 0; i < hiddenSize; ++i)
-  {
-    ElemType sum = arma::accu(arma::square(input.t() * weight.slice(i))) /
-        (2.0 * slabPenalty);
-    freeEnergy -= SoftplusFunction::Fn(spikeBias(i) - sum);
-  }
+    freeEnergy -= SoftplusFunction::Fn(spikeBias(i) - sums(i));
 
   return freeEnergy;
 }
@@ -106,11 +109,13 @@ RBM<InitializationRuleType, DataType, PolicyType>::Phase(
   SampleSpike(spikeMean, spikeSamples);
   SlabMean(input, spikeSamples, slabMean);
 
-  for (size_t i = 0 ; i < hiddenSize; ++i)
-  {
-    weightGrad.slice(i) = input * arma::repmat(slabMean.col(i).t(),
-        input.n_cols, 1) * spikeMean(i);
-  }
+  // input * repmat(m_i^T, n, 1) is the outer product of the sum of the
+  // columns of the input with m_i, so all the slices are one outer product.
+  arma::Mat<ElemType> weightGradMat(weightGrad.memptr(), visibleSize,
+      poolSize * hiddenSize, false, true);
+  arma::Mat<ElemType> scaledSlab = slabMean;
+  scaledSlab.each_row() %= spikeMean.t();
+  weightGradMat = arma::sum(input, 1) * arma::vectorise(scaledSlab).t();
 
   spikeBiasGrad = spikeMean;
   // Setting visiblePenaltyGrad.
@@ -160,10 +165,8 @@ RBM<InitializationRuleType, DataType, PolicyType>::SampleVisible(
 
   for (k = 0; k < numMaxTrials; ++k)
   {
-    for (size_t i = 0; i < visibleSize; ++i)
-    {
-      output(i) = math::RandNormal(visibleMean(i), 1.0 / visiblePenalty(0));
-    }
+    output = visibleMean;
+    SampleNormal(output, 1.0 / visiblePenalty(0));
     if (arma::norm(output, 2) < radius)
     {
       break;
@@ -190,18 +193,16 @@ RBM<InitializationRuleType, DataType, PolicyType>::VisibleMean(
     InputType& input,
     DataType& output)
 {
-  output.zeros(visibleSize, 1);
-
   DataType spike(input.memptr(), hiddenSize, 1, false, false);
   DataType slab(input.memptr() + hiddenSize, poolSize, hiddenSize, false,
       false);
 
-  for (size_t i = 0; i < hiddenSize; ++i)
-  {
-    output += weight.slice(i) * slab.col(i) * spike(i);
-  }
-
-  output = ((1.0 / visiblePenalty(0)) * output);
+  // sum_i W_i s_i h_i is a single product with the matrix of all the weights.
+  const arma::Mat<ElemType> weights(weight.memptr(), visibleSize,
+      poolSize * hiddenSize, false, true);
+  arma::Mat<ElemType> scaledSlab = slab;
+  scaledSlab.each_row() %= spike.t();
+  output = weights * arma::vectorise(scaledSlab) / visiblePenalty(0);
 }
 
 template<
@@ -237,12 +238,18 @@ RBM<InitializationRuleType, DataType, PolicyType>::SpikeMean(
     const InputType& visible,
     DataType& spikeMean)
 {
-  for (size_t i = 0; i < hiddenSize; ++i)
-  {
-    spikeMean(i) = LogisticFunction::Fn(0.5 * (1.0 / slabPenalty) * arma::accu(
-        visible.t() * (weight.slice(i) * weight.slice(i).t()) * visible)
-        / std::pow(visible.n_cols, 2) + spikeBias(i));
-  }
+  // accu(v^T W_i W_i^T v) sums (W_i^T v_a)^T (W_i^T v_b) over all pairs of
+  // columns, which is ||W_i^T sum_a v_a||^2; so all the hidden units need one
+  // matrix-vector product, instead of a D x D and a batch x batch product
+  // each.
+  const arma::Mat<ElemType> weights(weight.memptr(), visibleSize,
+      poolSize * hiddenSize, false, true);
+  const arma::Mat<ElemType> projection = arma::reshape(weights.t() *
+      arma::sum(visible, 1), poolSize, hiddenSize);
+  spikeMean = 0.5 * (1.0 / slabPenalty) *
+      arma::sum(arma::square(projection), 0).t() /
+      std::pow(visible.n_cols, 2) + spikeBias;
+  LogisticFunction::Fn(spikeMean, spikeMean);
 }
 
 template<
@@ -256,10 +263,9 @@ RBM<InitializationRuleType, DataType, PolicyType>::SampleSpike(
     InputType& spikeMean,
     DataType& spike)
 {
-  for (size_t i = 0; i < hiddenSize; ++i)
-  {
-    spike(i) = math::RandBernoulli(spikeMean(i));
-  }
+  if ((void*) &spike != (void*) &spikeMean)
+    spike = spikeMean;
+  SampleBernoulli(spike);
 }
 
 template<
@@ -274,11 +280,12 @@ RBM<InitializationRuleType, DataType, PolicyType>::SlabMean(
     DataType& spike,
     DataType& slabMean)
 {
-  for (size_t i = 0; i < hiddenSize; ++i)
-  {
-    slabMean.col(i) = arma::mean((1.0 / slabPenalty) * spike(i) *
-        weight.slice(i).t() * visible, 1);
-  }
+  // The mean over the columns of W_i^T v is W_i^T times the mean column.
+  const arma::Mat<ElemType> weights(weight.memptr(), visibleSize,
+      poolSize * hiddenSize, false, true);
+  slabMean = arma::reshape(weights.t() * arma::mean(visible, 1), poolSize,
+      hiddenSize) / slabPenalty;
+  slabMean.each_row() %= spike.t();
 }
 
 template<
@@ -292,13 +299,9 @@ RBM<InitializationRuleType, DataType, PolicyType>::SampleSlab(
     InputType& slabMean,
     DataType& slab)
 {
-  for (size_t i = 0; i < hiddenSize; ++i)
-  {
-    for (size_t j = 0; j < poolSize; ++j)
-    {
-      slab(j, i) = math::RandNormal(slabMean(j, i), 1.0 / slabPenalty);
-    }
-  }
+  if ((void*) &slab != (void*) &slabMean)
+    slab = slabMean;
+  SampleNormal(slab, 1.0 / slabPenalty);
 }
 
 } // namespace ann
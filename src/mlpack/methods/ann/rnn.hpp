@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_ANN_RNN_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/data_pipeline.hpp>
 
 #include "visitor/delete_visitor.hpp"
 #include "visitor/delta_visitor.hpp"
@@ -179,6 +180,34 @@ class RNN
                arma::cube responses,
                CallbackTypes&&... callbacks);
 
+  /**
+   * Train the recurrent network on the batches of the given data pipeline, so that
+   * the whole dataset never has to be in memory.  For each epoch, the model is
+   * trained with the given optimizer on each batch in turn, while the pipeline
+   * makes the next batches in the background; then the pipeline is reset for
+   * the next epoch.
+   *
+   * Each batch is passed to the optimizer like a dataset, so the optimizer
+   * should make a single pass over it (for instance, MaxIterations() equal to
+   * the batch size), and optimizers with state should not reset it between
+   * batches (for instance, ResetPolicy() set to false).
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param pipeline Data pipeline that makes the batches of the dataset; the
+   *     first epoch starts at the current batch of the pipeline.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param epochs Number of passes over the dataset.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The sum of the final objectives of the batches of the last epoch.
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  double Train(data::DataPipeline<arma::cube, arma::cube>& pipeline,
+               OptimizerType& optimizer,
+               const size_t epochs,
+               CallbackTypes&&... callbacks);
+
   /**
    * Predict the responses to a given set of predictors. The responses will
    * reflect the output of the given output layer as returned by the
@@ -303,6 +332,30 @@ class RNN
   //! Modify the maximum length of backpropagation through time.
   size_t& Rho() { return rho; }
 
+  /**
+   * Get whether layer outputs are recomputed during backpropagation through
+   * time instead of being stored for every step.
+   */
+  bool Recompute() const { return recompute; }
+  /**
+   * Modify whether layer outputs are recomputed during backpropagation through
+   * time.  By default the output of every layer is stored for each of the rho
+   * steps.  If set to true, only the outputs of the layers that keep state
+   * across steps (such as LSTM or GRU), behave differently during training
+   * (such as Dropout), or hold other layers are stored; the outputs of all
+   * other layers (such as Linear or the activation functions) are computed
+   * again from the stored outputs during the backward pass.  This trades one
+   * extra forward pass of those layers for memory, and gives the same
+   * gradient.
+   *
+   * There is no option to store the outputs only at every k-th step and replay
+   * the steps in between: layers such as LSTM, GRU or Recurrent keep their
+   * per-step state internally and advance it on every Forward() call, and they
+   * can't be rewound to a checkpoint.  Their internal per-step storage is not
+   * affected by this option.
+   */
+  bool& Recompute() { return recompute; }
+
   //! Get the matrix of responses to the input data points.
   const arma::cube& Responses() const { return responses; }
   //! Modify the matrix of responses to the input data points.
@@ -325,6 +378,21 @@ class RNN
    */
   void ResetParameters();
 
+  /**
+   * Turn this network into a replica of the given network for inference.  The
+   * layers of the given network are copied, but the weights of every copied
+   * layer alias the parameters of the given network instead of holding a copy
+   * of them.  Each replica holds its own layer outputs and cell states, so
+   * several replicas of one network can call Predict() from different threads
+   * at the same time, while the parameters are only stored once.
+   *
+   * The given network must outlive this replica, and neither network may be
+   * trained or have its parameters reset while the replica is in use.
+   *
+   * @param network Network whose layers and parameters will be shared.
+   */
+  void ShareParameters(RNN& network);
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -345,6 +413,21 @@ class RNN
    */
   void ResetCells();
 
+  /**
+   * Let the first recurrent layer of the network (after any leading identity
+   * layers) compute the input projections of the next steps at once, if it
+   * implements ProjectInputs().
+   *
+   * @param input Sequences to project.
+   * @param begin Index of the first sequence of the batch.
+   * @param batchSize Number of sequences in the batch.
+   * @param steps Number of steps to project.
+   */
+  void ProjectInputs(const arma::cube& input,
+                     const size_t begin,
+                     const size_t batchSize,
+                     const size_t steps);
+
   /**
    * The Backward algorithm (part of the Forward-Backward algorithm). Computes
    * backward pass for module.
@@ -394,6 +477,10 @@ class RNN
     //! Only predict the last element of the input sequence.
   bool single;
 
+  //! Whether to recompute the outputs of stateless layers during the backward
+  //! pass instead of storing them.
+  bool recompute;
+
   //! Locally-stored model modules.
   std::vector<LayerTypes<CustomLayers...> > network;
 
@@ -20,6 +20,8 @@
 #include "visitor/forward_visitor.hpp"
 #include "visitor/backward_visitor.hpp"
 #include "visitor/reset_cell_visitor.hpp"
+#include "visitor/project_inputs_visitor.hpp"
+#include "visitor/recompute_visitor.hpp"
 #include "visitor/deterministic_set_visitor.hpp"
 #include "visitor/gradient_set_visitor.hpp"
 #include "visitor/gradient_visitor.hpp"
@@ -45,6 +47,7 @@ RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::RNN(
     targetSize(0),
     reset(false),
     single(single),
+    recompute(false),
     numFunctions(0),
     deterministic(true)
 {
@@ -63,6 +66,7 @@ RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::RNN(
     targetSize(network.targetSize),
     reset(network.reset),
     single(network.single),
+    recompute(network.recompute),
     parameter(network.parameter),
     numFunctions(network.numFunctions),
     deterministic(network.deterministic)
@@ -87,6 +91,7 @@ RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::RNN(
     targetSize(std::move(network.targetSize)),
     reset(std::move(network.reset)),
     single(std::move(network.single)),
+    recompute(std::move(network.recompute)),
     network(std::move(network.network)),
     parameter(std::move(network.parameter)),
     numFunctions(std::move(network.numFunctions)),
@@ -140,6 +145,53 @@ WarnMessageMaxIterations(OptimizerType& /* optimizer */,
   return;
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void RNN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ProjectInputs(const arma::cube& input,
+                                         const size_t begin,
+                                         const size_t batchSize,
+                                         const size_t sequenceSteps)
+{
+  const size_t steps = std::min(sequenceSteps, size_t(input.n_slices));
+
+  // Leading identity layers pass the input on unchanged, so the first layer
+  // after them sees the same input at every step.
+  size_t first = 0;
+  while (first < network.size() &&
+      boost::get<IdentityLayer<>*>(&network[first]) != NULL)
+  {
+    ++first;
+  }
+
+  if (first == network.size() ||
+      !boost::apply_visitor(ProjectInputsVisitor(), network[first]))
+  {
+    return;
+  }
+
+  if (begin == 0 && batchSize == input.n_cols)
+  {
+    // The slices are stored one after another, so the steps of the whole
+    // batch can be wrapped without a copy.
+    const arma::mat steppedInput(const_cast<double*>(input.memptr()),
+        input.n_rows, batchSize * steps, false, true);
+    boost::apply_visitor(ProjectInputsVisitor(steppedInput, batchSize),
+        network[first]);
+  }
+  else
+  {
+    arma::mat steppedInput(input.n_rows, batchSize * steps);
+    for (size_t seqNum = 0; seqNum < steps; ++seqNum)
+    {
+      steppedInput.cols(seqNum * batchSize, (seqNum + 1) * batchSize - 1) =
+          input.slice(seqNum).cols(begin, begin + batchSize - 1);
+    }
+    boost::apply_visitor(ProjectInputsVisitor(steppedInput, batchSize),
+        network[first]);
+  }
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename OptimizerType, typename... CallbackTypes>
@@ -228,6 +280,34 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
   return out;
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType, typename... CallbackTypes>
+double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Train(
+    data::DataPipeline<arma::cube, arma::cube>& pipeline,
+    OptimizerType& optimizer,
+    const size_t epochs,
+    CallbackTypes&&... callbacks)
+{
+  double out = 0.0;
+  arma::cube predictors, responses;
+  for (size_t epoch = 0; epoch < epochs; ++epoch)
+  {
+    // The pipeline starts the first pass when it is created.
+    if (epoch > 0)
+      pipeline.Reset();
+
+    out = 0.0;
+    while (pipeline.Next(predictors, responses))
+    {
+      out += Train(std::move(predictors), std::move(responses), optimizer,
+          callbacks...);
+    }
+  }
+
+  return out;
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
@@ -253,6 +333,7 @@ void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
   const size_t effectiveBatchSize = std::min(batchSize,
       size_t(predictors.n_cols));
 
+  ProjectInputs(predictors, 0, effectiveBatchSize, rho);
   Forward(arma::mat(predictors.slice(0).colptr(0), predictors.n_rows,
       effectiveBatchSize, false, true));
   arma::mat resultsTemp = boost::apply_visitor(outputParameterVisitor,
@@ -268,6 +349,9 @@ void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
   {
     const size_t effectiveBatchSize = std::min(batchSize,
         size_t(predictors.n_cols - begin));
+    if (begin > 0)
+      ProjectInputs(predictors, begin, effectiveBatchSize, rho);
+
     for (size_t seqNum = !begin; seqNum < rho; ++seqNum)
     {
       Forward(arma::mat(predictors.slice(seqNum).colptr(begin),
@@ -310,6 +394,7 @@ double RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Evaluate(
   }
 
   ResetCells();
+  ProjectInputs(predictors, begin, batchSize, rho);
 
   double performance = 0;
   size_t responseSeq = 0;
@@ -395,6 +480,16 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   double performance = 0;
   size_t responseSeq = 0;
   const size_t effectiveRho = std::min(rho, size_t(responses.size()));
+  ProjectInputs(predictors, begin, batchSize, effectiveRho);
+
+  // When recomputing, only the outputs of the layers that can't simply be run
+  // again on the same input are stored for the backward pass.
+  std::vector<bool> stored(network.size(), true);
+  if (recompute)
+  {
+    for (size_t l = 0; l < network.size(); ++l)
+      stored[l] = !boost::apply_visitor(RecomputeVisitor(), network[l]);
+  }
 
   for (size_t seqNum = 0; seqNum < effectiveRho; ++seqNum)
   {
@@ -409,8 +504,11 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
 
     for (size_t l = 0; l < network.size(); ++l)
     {
-      boost::apply_visitor(SaveOutputParameterVisitor(moduleOutputParameter),
-          network[l]);
+      if (stored[l])
+      {
+        boost::apply_visitor(SaveOutputParameterVisitor(
+            moduleOutputParameter), network[l]);
+      }
     }
 
     performance += outputLayer.Forward(boost::apply_visitor(
@@ -439,8 +537,37 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     currentGradient.zeros();
     for (size_t l = 0; l < network.size(); ++l)
     {
-      boost::apply_visitor(LoadOutputParameterVisitor(moduleOutputParameter),
-          network[network.size() - 1 - l]);
+      if (stored[network.size() - 1 - l])
+      {
+        boost::apply_visitor(LoadOutputParameterVisitor(
+            moduleOutputParameter), network[network.size() - 1 - l]);
+      }
+    }
+
+    // Run the layers whose outputs weren't stored again on the restored
+    // outputs (or the input) of this step.
+    if (recompute)
+    {
+      arma::mat stepData(
+          predictors.slice(effectiveRho - seqNum - 1).colptr(begin),
+          predictors.n_rows, batchSize, false, true);
+      for (size_t l = 0; l < network.size(); ++l)
+      {
+        if (stored[l])
+          continue;
+
+        if (l == 0)
+        {
+          boost::apply_visitor(ForwardVisitor(stepData, boost::apply_visitor(
+              outputParameterVisitor, network[0])), network[0]);
+        }
+        else
+        {
+          boost::apply_visitor(ForwardVisitor(boost::apply_visitor(
+              outputParameterVisitor, network[l - 1]), boost::apply_visitor(
+              outputParameterVisitor, network[l])), network[l]);
+        }
+      }
     }
 
     if (single && seqNum > 0)
@@ -509,6 +636,57 @@ void RNN<OutputLayerType, InitializationRuleType,
   reset = true;
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void RNN<OutputLayerType, InitializationRuleType,
+         CustomLayers...>::ShareParameters(RNN& network)
+{
+  if (&network == this)
+    return;
+
+  if (network.parameter.is_empty())
+    network.ResetParameters();
+
+  for (LayerTypes<CustomLayers...>& layer : this->network)
+    boost::apply_visitor(deleteVisitor, layer);
+  this->network.clear();
+
+  rho = network.rho;
+  outputLayer = network.outputLayer;
+  initializeRule = network.initializeRule;
+  inputSize = network.inputSize;
+  outputSize = network.outputSize;
+  targetSize = network.targetSize;
+  reset = network.reset;
+  single = network.single;
+  recompute = network.recompute;
+  numFunctions = 0;
+  predictors.reset();
+  responses.reset();
+  error.reset();
+  moduleOutputParameter.clear();
+  currentGradient.reset();
+
+  // Alias the parameters of the other network.  Each layer is copied and then
+  // immediately pointed at the shared parameters, so that at most one layer's
+  // weights are ever held twice.
+  parameter = arma::mat(network.parameter.memptr(), network.parameter.n_rows,
+      network.parameter.n_cols, false, true);
+
+  size_t offset = 0;
+  for (size_t i = 0; i < network.network.size(); ++i)
+  {
+    this->network.push_back(boost::apply_visitor(copyVisitor,
+        network.network[i]));
+    offset += boost::apply_visitor(WeightSetVisitor(parameter, offset),
+        this->network.back());
+    boost::apply_visitor(resetVisitor, this->network.back());
+  }
+
+  deterministic = true;
+  ResetDeterministic();
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void RNN<OutputLayerType, InitializationRuleType, CustomLayers...>::Reset()
@@ -0,0 +1,102 @@
+/**
+ * @file methods/ann/sparse_update/sparse_adagrad_update.hpp
+ *
+ * Definition of SparseAdagradUpdate, an AdaGrad step on the columns of a
+ * parameter matrix that have a gradient.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_SPARSE_UPDATE_SPARSE_ADAGRAD_UPDATE_HPP
+#define MLPACK_METHODS_ANN_SPARSE_UPDATE_SPARSE_ADAGRAD_UPDATE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * SparseAdagradUpdate takes an AdaGrad step on the given columns of a
+ * parameter matrix:
+ *
+ * \f[
+ * s_j \leftarrow s_j + g_j^2, \qquad
+ * w_j \leftarrow w_j - \alpha \frac{g_j}{\sqrt{s_j} + \epsilon}
+ * \f]
+ *
+ * where the gradient is given in compact form, as with Lookup::GradientIndices()
+ * and Lookup::SparseGradient().  The other columns, and their accumulated
+ * squared gradients, are not touched, which is exactly AdaGrad since their
+ * gradient is zero.
+ *
+ * @tparam MatType Type of the parameter matrix.
+ */
+template<typename MatType = arma::mat>
+class SparseAdagradUpdate
+{
+ public:
+  /**
+   * Create the update rule with the given parameters.
+   *
+   * @param stepSize Step size of each update.
+   * @param epsilon Value used to avoid division by zero.
+   */
+  SparseAdagradUpdate(const double stepSize = 0.01,
+                      const double epsilon = 1e-8) :
+      stepSize(stepSize),
+      epsilon(epsilon)
+  { }
+
+  /**
+   * Update the given columns of the parameters.  The accumulated squared
+   * gradients are reset if the size of the parameters changes.
+   *
+   * @param parameters Parameters to update.
+   * @param indices Distinct indices of the columns to update.
+   * @param gradient Gradient of each column to update (one column for each
+   *     index).
+   */
+  void Update(MatType& parameters,
+              const arma::uvec& indices,
+              const MatType& gradient)
+  {
+    if (arma::size(squaredGradient) != arma::size(parameters))
+      squaredGradient.zeros(arma::size(parameters));
+
+    for (size_t i = 0; i < indices.n_elem; ++i)
+    {
+      const size_t j = indices[i];
+      squaredGradient.col(j) += arma::square(gradient.col(i));
+      parameters.col(j) -= stepSize * gradient.col(i) /
+          (arma::sqrt(squaredGradient.col(j)) + epsilon);
+    }
+  }
+
+  //! Get the step size.
+  double StepSize() const { return stepSize; }
+  //! Modify the step size.
+  double& StepSize() { return stepSize; }
+
+  //! Get the value used to avoid division by zero.
+  double Epsilon() const { return epsilon; }
+  //! Modify the value used to avoid division by zero.
+  double& Epsilon() { return epsilon; }
+
+  //! Get the accumulated squared gradients.
+  const MatType& SquaredGradient() const { return squaredGradient; }
+
+ private:
+  //! The step size of each update.
+  double stepSize;
+  //! The value used to avoid division by zero.
+  double epsilon;
+  //! The accumulated squared gradients.
+  MatType squaredGradient;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
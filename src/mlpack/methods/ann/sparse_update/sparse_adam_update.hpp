@@ -0,0 +1,155 @@
+/**
+ * @file methods/ann/sparse_update/sparse_adam_update.hpp
+ *
+ * Definition of SparseAdamUpdate, a lazy Adam step on the columns of a
+ * parameter matrix that have a gradient.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_SPARSE_UPDATE_SPARSE_ADAM_UPDATE_HPP
+#define MLPACK_METHODS_ANN_SPARSE_UPDATE_SPARSE_ADAM_UPDATE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * SparseAdamUpdate takes a "lazy" Adam step on the given columns of a
+ * parameter matrix: the moment estimates of the columns with a gradient are
+ * updated as in Adam,
+ *
+ * \f[
+ * m_j \leftarrow \beta_1 m_j + (1 - \beta_1) g_j, \qquad
+ * v_j \leftarrow \beta_2 v_j + (1 - \beta_2) g_j^2, \qquad
+ * w_j \leftarrow w_j - \alpha \frac{\sqrt{1 - \beta_2^t}}{1 - \beta_1^t}
+ *     \frac{m_j}{\sqrt{v_j} + \epsilon}
+ * \f]
+ *
+ * where t is the number of updates so far, and the other columns and their
+ * moments are not touched.  Unlike dense Adam, the columns without a gradient
+ * do not keep moving with their momentum, so that an update only costs the
+ * size of the gradient.  This is the usual way to train large embedding
+ * tables.
+ *
+ * For more information, see the following.
+ *
+ * @code
+ * @article{Kingma2014,
+ *   author  = {Diederik P. Kingma and Jimmy Ba},
+ *   title   = {Adam: {A} Method for Stochastic Optimization},
+ *   journal = {CoRR},
+ *   year    = {2014},
+ *   url     = {http://arxiv.org/abs/1412.6980}
+ * }
+ * @endcode
+ *
+ * @tparam MatType Type of the parameter matrix.
+ */
+template<typename MatType = arma::mat>
+class SparseAdamUpdate
+{
+ public:
+  /**
+   * Create the update rule with the given parameters.
+   *
+   * @param stepSize Step size of each update.
+   * @param beta1 Exponential decay rate of the first moment estimates.
+   * @param beta2 Exponential decay rate of the second moment estimates.
+   * @param epsilon Value used to avoid division by zero.
+   */
+  SparseAdamUpdate(const double stepSize = 0.001,
+                   const double beta1 = 0.9,
+                   const double beta2 = 0.999,
+                   const double epsilon = 1e-8) :
+      stepSize(stepSize),
+      beta1(beta1),
+      beta2(beta2),
+      epsilon(epsilon),
+      iteration(0)
+  { }
+
+  /**
+   * Update the given columns of the parameters.  The moment estimates are
+   * reset if the size of the parameters changes.
+   *
+   * @param parameters Parameters to update.
+   * @param indices Distinct indices of the columns to update.
+   * @param gradient Gradient of each column to update (one column for each
+   *     index).
+   */
+  void Update(MatType& parameters,
+              const arma::uvec& indices,
+              const MatType& gradient)
+  {
+    if (arma::size(m) != arma::size(parameters))
+    {
+      m.zeros(arma::size(parameters));
+      v.zeros(arma::size(parameters));
+      iteration = 0;
+    }
+
+    ++iteration;
+    const double biasCorrection1 = 1.0 - std::pow(beta1, iteration);
+    const double biasCorrection2 = 1.0 - std::pow(beta2, iteration);
+    const double step = stepSize * std::sqrt(biasCorrection2) /
+        biasCorrection1;
+
+    for (size_t i = 0; i < indices.n_elem; ++i)
+    {
+      const size_t j = indices[i];
+      m.col(j) *= beta1;
+      m.col(j) += (1 - beta1) * gradient.col(i);
+      v.col(j) *= beta2;
+      v.col(j) += (1 - beta2) * arma::square(gradient.col(i));
+      parameters.col(j) -= step * m.col(j) / (arma::sqrt(v.col(j)) + epsilon);
+    }
+  }
+
+  //! Get the step size.
+  double StepSize() const { return stepSize; }
+  //! Modify the step size.
+  double& StepSize() { return stepSize; }
+
+  //! Get the exponential decay rate of the first moment estimates.
+  double Beta1() const { return beta1; }
+  //! Modify the exponential decay rate of the first moment estimates.
+  double& Beta1() { return beta1; }
+
+  //! Get the exponential decay rate of the second moment estimates.
+  double Beta2() const { return beta2; }
+  //! Modify the exponential decay rate of the second moment estimates.
+  double& Beta2() { return beta2; }
+
+  //! Get the value used to avoid division by zero.
+  double Epsilon() const { return epsilon; }
+  //! Modify the value used to avoid division by zero.
+  double& Epsilon() { return epsilon; }
+
+  //! Get the number of updates so far.
+  size_t Iteration() const { return iteration; }
+
+ private:
+  //! The step size of each update.
+  double stepSize;
+  //! The exponential decay rate of the first moment estimates.
+  double beta1;
+  //! The exponential decay rate of the second moment estimates.
+  double beta2;
+  //! The value used to avoid division by zero.
+  double epsilon;
+  //! The number of updates so far.
+  size_t iteration;
+  //! The first moment estimates.
+  MatType m;
+  //! The second moment estimates.
+  MatType v;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,73 @@
+/**
+ * @file methods/ann/sparse_update/sparse_sgd_update.hpp
+ *
+ * Definition of SparseSGDUpdate, a stochastic gradient descent step on the
+ * columns of a parameter matrix that have a gradient.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_SPARSE_UPDATE_SPARSE_SGD_UPDATE_HPP
+#define MLPACK_METHODS_ANN_SPARSE_UPDATE_SPARSE_SGD_UPDATE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * SparseSGDUpdate takes a plain stochastic gradient descent step on the given
+ * columns of a parameter matrix:
+ *
+ * \f[
+ * w_j \leftarrow w_j - \alpha g_j
+ * \f]
+ *
+ * where the gradient is given in compact form, as with Lookup::GradientIndices()
+ * and Lookup::SparseGradient().  The other columns are not touched.
+ *
+ * @tparam MatType Type of the parameter matrix.
+ */
+template<typename MatType = arma::mat>
+class SparseSGDUpdate
+{
+ public:
+  /**
+   * Create the update rule with the given step size.
+   *
+   * @param stepSize Step size of each update.
+   */
+  SparseSGDUpdate(const double stepSize = 0.01) : stepSize(stepSize) { }
+
+  /**
+   * Update the given columns of the parameters.
+   *
+   * @param parameters Parameters to update.
+   * @param indices Distinct indices of the columns to update.
+   * @param gradient Gradient of each column to update (one column for each
+   *     index).
+   */
+  void Update(MatType& parameters,
+              const arma::uvec& indices,
+              const MatType& gradient)
+  {
+    for (size_t i = 0; i < indices.n_elem; ++i)
+      parameters.col(indices[i]) -= stepSize * gradient.col(i);
+  }
+
+  //! Get the step size.
+  double StepSize() const { return stepSize; }
+  //! Modify the step size.
+  double& StepSize() { return stepSize; }
+
+ private:
+  //! The step size of each update.
+  double stepSize;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,20 @@
+/**
+ * @file methods/ann/sparse_update/sparse_update.hpp
+ *
+ * Convenience include for the sparse update rules, which update only the
+ * columns of a parameter matrix (such as the embeddings of a Lookup layer) that
+ * have a gradient.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_SPARSE_UPDATE_SPARSE_UPDATE_HPP
+#define MLPACK_METHODS_ANN_SPARSE_UPDATE_SPARSE_UPDATE_HPP
+
+#include "sparse_sgd_update.hpp"
+#include "sparse_adagrad_update.hpp"
+#include "sparse_adam_update.hpp"
+
+#endif
@@ -0,0 +1,549 @@
+/**
+ * @file methods/ann/static_ffn.hpp
+ *
+ * Definition of the StaticFFN class, a feed forward network whose layer types
+ * are fixed at compile time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_STATIC_FFN_HPP
+#define MLPACK_METHODS_ANN_STATIC_FFN_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "visitor/deterministic_set_visitor.hpp"
+#include "visitor/loss_visitor.hpp"
+#include "visitor/reset_visitor.hpp"
+#include "visitor/weight_size_visitor.hpp"
+
+#include "init_rules/init_rules_traits.hpp"
+#include <mlpack/methods/ann/layer/layer.hpp>
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+#include <mlpack/methods/ann/init_rules/random_init.hpp>
+#include <ensmallen.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Check whether every layer in Layers uses MatType as the type of its output.
+ */
+template<typename MatType, typename... Layers>
+struct LayersUseMatType : public std::true_type { };
+
+template<typename MatType, typename LayerType, typename... Layers>
+struct LayersUseMatType<MatType, LayerType, Layers...> :
+    public std::integral_constant<bool, std::is_same<MatType,
+        typename std::decay<decltype(
+            std::declval<LayerType&>().OutputParameter())>::type>::value &&
+        LayersUseMatType<MatType, Layers...>::value> { };
+
+/**
+ * Implementation of a feed forward network whose layers are given as template
+ * parameters.  Unlike FFN, which stores its layers as a vector of LayerTypes
+ * variants and dispatches every call through boost::apply_visitor(), a
+ * StaticFFN stores its layers by value in a std::tuple, so every call to a
+ * layer is resolved at compile time and can be inlined.  The layers also do
+ * not need to be part of LayerTypes.
+ *
+ * The structure of the network is part of its type, so layers cannot be added
+ * or removed after construction.  For example, a network with one hidden layer
+ * can be built as follows:
+ *
+ * @code
+ * StaticFFN<NegativeLogLikelihood<>, RandomInitialization,
+ *     Linear<>, ReLULayer<>, Linear<>, LogSoftMax<>> model(
+ *     Linear<>(10, 32), ReLULayer<>(), Linear<>(32, 3), LogSoftMax<>());
+ * model.Train(data, labels, optimizer);
+ * @endcode
+ *
+ * Since no input width or height is passed between the layers, the sizes of
+ * layers such as Convolution have to be given to their constructors.
+ *
+ * The matrix type of the network (for instance arma::mat or arma::fmat) is the
+ * type of the output of the first layer, and all layers, as well as the output
+ * layer, must use it.  So a network that trains in single precision can be
+ * built by giving arma::fmat as the data types of every layer:
+ *
+ * @code
+ * StaticFFN<NegativeLogLikelihood<arma::fmat, arma::fmat>,
+ *     RandomInitialization, Linear<arma::fmat, arma::fmat>,
+ *     LogSoftMax<arma::fmat, arma::fmat>> model(
+ *     Linear<arma::fmat, arma::fmat>(10, 3),
+ *     LogSoftMax<arma::fmat, arma::fmat>());
+ * @endcode
+ *
+ * Layers that hold other layers as LayerTypes variants (such as Sequential,
+ * Concat or Highway) only support arma::mat, like FFN itself.
+ *
+ * @tparam OutputLayerType The output layer type used to evaluate the network.
+ * @tparam InitializationRuleType Rule used to initialize the weight matrix.
+ * @tparam Layers The types of the layers of the network, in order.
+ */
+template<
+  typename OutputLayerType,
+  typename InitializationRuleType,
+  typename... Layers
+>
+class StaticFFN
+{
+ public:
+  static_assert(sizeof...(Layers) > 0,
+      "StaticFFN must have at least one layer");
+
+  //! The type of the first layer.
+  typedef typename std::tuple_element<0, std::tuple<Layers...>>::type
+      FirstLayerType;
+  //! The matrix type used by the network.
+  typedef typename std::decay<decltype(
+      std::declval<FirstLayerType&>().OutputParameter())>::type MatType;
+
+  static_assert(LayersUseMatType<MatType, Layers...>::value,
+      "all layers of a StaticFFN must use the same matrix type");
+
+  /**
+   * Create the StaticFFN object from the given layers.
+   *
+   * @param layers The layers of the network, in order.
+   */
+  StaticFFN(const Layers&... layers);
+
+  //! Copy constructor.
+  StaticFFN(const StaticFFN& network);
+
+  //! Move constructor.
+  StaticFFN(StaticFFN&& network);
+
+  //! Copy assignment operator.
+  StaticFFN& operator=(const StaticFFN& network);
+
+  /**
+   * Train the network on the given data, using the given optimizer.
+   *
+   * @tparam OptimizerType Type of the optimizer used to train the model.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param predictors Input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective of the trained model (NaN or Inf on error).
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  double Train(MatType predictors,
+               MatType responses,
+               OptimizerType& optimizer,
+               CallbackTypes&&... callbacks);
+
+  /**
+   * Train the network on the given data, using a default-constructed
+   * optimizer (RMSProp by default).
+   *
+   * @tparam OptimizerType Type of the optimizer used to train the model.
+   * @tparam CallbackTypes Types of callback functions.
+   * @param predictors Input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   * @return The final objective of the trained model (NaN or Inf on error).
+   */
+  template<typename OptimizerType = ens::RMSProp, typename... CallbackTypes>
+  double Train(MatType predictors,
+               MatType responses,
+               CallbackTypes&&... callbacks);
+
+  /**
+   * Predict the responses to a given set of predictors, passing batchSize
+   * points through the network at a time.
+   *
+   * @param predictors Input predictors.
+   * @param results Matrix to put output predictions of responses into.
+   * @param batchSize Number of points to pass through the network at once.
+   */
+  void Predict(const MatType& predictors,
+               MatType& results,
+               const size_t batchSize = 128);
+
+  /**
+   * Evaluate the network with the given parameters, one point at a time.
+   *
+   * @param parameters Matrix model parameters.
+   */
+  double Evaluate(const MatType& parameters);
+
+  /**
+   * Evaluate the network with the given parameters, but using only a number
+   * of data points.
+   *
+   * @param parameters Matrix model parameters.
+   * @param begin Index of the starting point to use for objective function
+   *        evaluation.
+   * @param batchSize Number of points to be passed at a time to use for
+   *        objective function evaluation.
+   * @param deterministic Whether or not to train or test the model.
+   */
+  double Evaluate(const MatType& parameters,
+                  const size_t begin,
+                  const size_t batchSize,
+                  const bool deterministic);
+
+  /**
+   * Evaluate the network with the given parameters, but using only a number
+   * of data points, in testing mode.
+   *
+   * @param parameters Matrix model parameters.
+   * @param begin Index of the starting point to use for objective function
+   *        evaluation.
+   * @param batchSize Number of points to be passed at a time to use for
+   *        objective function evaluation.
+   */
+  double Evaluate(const MatType& parameters,
+                  const size_t begin,
+                  const size_t batchSize);
+
+  /**
+   * Evaluate the network and its gradient with the given parameters, one
+   * point at a time.
+   *
+   * @param parameters Matrix model parameters.
+   * @param gradient Matrix to output gradient into.
+   */
+  template<typename GradType>
+  double EvaluateWithGradient(const MatType& parameters, GradType& gradient);
+
+  /**
+   * Evaluate the network and its gradient with the given parameters, but
+   * using only a number of data points.
+   *
+   * @param parameters Matrix model parameters.
+   * @param begin Index of the starting point to use for objective function
+   *        evaluation.
+   * @param gradient Matrix to output gradient into.
+   * @param batchSize Number of points to be passed at a time to use for
+   *        objective function evaluation.
+   */
+  template<typename GradType>
+  double EvaluateWithGradient(const MatType& parameters,
+                              const size_t begin,
+                              GradType& gradient,
+                              const size_t batchSize);
+
+  /**
+   * Evaluate the gradient of the network with the given parameters, and with
+   * respect to only a number of points in the dataset.
+   *
+   * @param parameters Matrix of the model parameters to be optimized.
+   * @param begin Index of the starting point to use for objective function
+   *        gradient evaluation.
+   * @param gradient Matrix to output gradient into.
+   * @param batchSize Number of points to be processed as a batch for objective
+   *        function gradient evaluation.
+   */
+  void Gradient(const MatType& parameters,
+                const size_t begin,
+                MatType& gradient,
+                const size_t batchSize);
+
+  /**
+   * Shuffle the order of function visitation.  This may be called by the
+   * optimizer.
+   */
+  void Shuffle();
+
+  /**
+   * Perform the forward pass of the given data, and store the output of the
+   * network in results.
+   *
+   * @param inputs The input data.
+   * @param results The predicted results.
+   */
+  void Forward(const MatType& inputs, MatType& results);
+
+  //! Get the layers of the network.
+  const std::tuple<Layers...>& Model() const { return network; }
+  //! Modify the layers of the network.  Be sure to call ResetParameters()
+  //! afterwards if the number of weights of any layer changes.
+  std::tuple<Layers...>& Model() { return network; }
+
+  //! Return the number of separable functions (the number of predictor points).
+  size_t NumFunctions() const { return numFunctions; }
+
+  //! Return the initial point for the optimization.
+  const MatType& Parameters() const { return parameter; }
+  //! Modify the initial point for the optimization.
+  MatType& Parameters() { return parameter; }
+
+  //! Get the matrix of responses to the input data points.
+  const MatType& Responses() const { return responses; }
+  //! Modify the matrix of responses to the input data points.
+  MatType& Responses() { return responses; }
+
+  //! Get the matrix of data points (predictors).
+  const MatType& Predictors() const { return predictors; }
+  //! Modify the matrix of data points (predictors).
+  MatType& Predictors() { return predictors; }
+
+  //! Get the output layer.
+  const OutputLayerType& OutputLayer() const { return outputLayer; }
+  //! Modify the output layer.
+  OutputLayerType& OutputLayer() { return outputLayer; }
+
+  /**
+   * Reset the module information (weights/parameters), using the
+   * initialization rule.
+   */
+  void ResetParameters();
+
+ private:
+  //! The number of layers in the network.
+  static const size_t numLayers = sizeof...(Layers);
+
+  //! Point the weights of every layer into the parameter matrix.
+  void SetWeights();
+
+  //! Set the deterministic mode of every layer.
+  void ResetDeterministic();
+
+  //! Return the output of the last layer.
+  MatType& NetworkOutput()
+  {
+    return std::get<numLayers - 1>(network).OutputParameter();
+  }
+
+  //! Return the total number of weights of layers I and above.
+  template<size_t I = 0>
+  typename std::enable_if<(I < numLayers), size_t>::type WeightSize()
+  {
+    return WeightSizeVisitor()(&std::get<I>(network)) + WeightSize<I + 1>();
+  }
+
+  template<size_t I = 0>
+  typename std::enable_if<(I == numLayers), size_t>::type WeightSize()
+  {
+    return 0;
+  }
+
+  //! Initialize the weights of layers I and above one layer at a time,
+  //! starting at the given offset in the parameter matrix.
+  template<size_t I = 0>
+  typename std::enable_if<(I < numLayers), void>::type
+  InitializeLayers(const size_t offset)
+  {
+    const size_t weights = WeightSizeVisitor()(&std::get<I>(network));
+    MatType tmp(parameter.memptr() + offset, weights, 1, false, false);
+    initializeRule.Initialize(tmp, tmp.n_elem, 1);
+    InitializeLayers<I + 1>(offset + weights);
+  }
+
+  template<size_t I = 0>
+  typename std::enable_if<(I == numLayers), void>::type
+  InitializeLayers(const size_t /* offset */) { }
+
+  //! Point the weights of layers I and above into the parameter matrix.
+  template<size_t I = 0>
+  typename std::enable_if<(I < numLayers), void>::type
+  SetLayerWeights(const size_t offset)
+  {
+    const size_t weights = LayerWeightSet(std::get<I>(network), offset);
+    ResetVisitor()(&std::get<I>(network));
+    SetLayerWeights<I + 1>(offset + weights);
+  }
+
+  template<size_t I = 0>
+  typename std::enable_if<(I == numLayers), void>::type
+  SetLayerWeights(const size_t /* offset */) { }
+
+  //! Point the weights of the given layer into the parameter matrix, and
+  //! return the number of weights of the layer.
+  template<typename LayerType>
+  typename std::enable_if<
+      HasParametersCheck<LayerType, MatType&(LayerType::*)()>::value,
+      size_t>::type
+  LayerWeightSet(LayerType& layer, const size_t offset)
+  {
+    layer.Parameters() = MatType(parameter.memptr() + offset,
+        layer.Parameters().n_rows, layer.Parameters().n_cols, false, false);
+    return layer.Parameters().n_elem;
+  }
+
+  template<typename LayerType>
+  typename std::enable_if<
+      !HasParametersCheck<LayerType, MatType&(LayerType::*)()>::value,
+      size_t>::type
+  LayerWeightSet(LayerType& /* layer */, const size_t /* offset */)
+  {
+    return 0;
+  }
+
+  //! Point the gradients of layers I and above into the given matrix.
+  template<size_t I = 0>
+  typename std::enable_if<(I < numLayers), void>::type
+  SetLayerGradients(MatType& gradient, const size_t offset)
+  {
+    const size_t weights = LayerGradientSet(std::get<I>(network), gradient,
+        offset);
+    SetLayerGradients<I + 1>(gradient, offset + weights);
+  }
+
+  template<size_t I = 0>
+  typename std::enable_if<(I == numLayers), void>::type
+  SetLayerGradients(MatType& /* gradient */, const size_t /* offset */) { }
+
+  //! Point the gradient of the given layer into the given matrix, and return
+  //! the number of weights of the layer.
+  template<typename LayerType>
+  typename std::enable_if<
+      HasGradientCheck<LayerType, MatType&(LayerType::*)()>::value,
+      size_t>::type
+  LayerGradientSet(LayerType& layer, MatType& gradient, const size_t offset)
+  {
+    layer.Gradient() = MatType(gradient.memptr() + offset,
+        layer.Parameters().n_rows, layer.Parameters().n_cols, false, false);
+    return layer.Parameters().n_elem;
+  }
+
+  template<typename LayerType>
+  typename std::enable_if<
+      !HasGradientCheck<LayerType, MatType&(LayerType::*)()>::value,
+      size_t>::type
+  LayerGradientSet(LayerType& /* layer */,
+                   MatType& /* gradient */,
+                   const size_t /* offset */)
+  {
+    return 0;
+  }
+
+  //! Set the deterministic mode of layers I and above.
+  template<size_t I = 0>
+  typename std::enable_if<(I < numLayers), void>::type
+  SetLayerDeterministic()
+  {
+    DeterministicSetVisitor(deterministic)(&std::get<I>(network));
+    SetLayerDeterministic<I + 1>();
+  }
+
+  template<size_t I = 0>
+  typename std::enable_if<(I == numLayers), void>::type
+  SetLayerDeterministic() { }
+
+  //! Return the sum of the losses of layers I and above.
+  template<size_t I = 0>
+  typename std::enable_if<(I < numLayers), double>::type LayerLoss()
+  {
+    return LossVisitor()(&std::get<I>(network)) + LayerLoss<I + 1>();
+  }
+
+  template<size_t I = 0>
+  typename std::enable_if<(I == numLayers), double>::type LayerLoss()
+  {
+    return 0;
+  }
+
+  //! Pass the given input through layers I and above.
+  template<size_t I = 0>
+  typename std::enable_if<(I < numLayers), void>::type
+  ForwardLayers(const MatType& input)
+  {
+    MatType& output = std::get<I>(network).OutputParameter();
+    std::get<I>(network).Forward(input, output);
+    ForwardLayers<I + 1>(output);
+  }
+
+  template<size_t I = 0>
+  typename std::enable_if<(I == numLayers), void>::type
+  ForwardLayers(const MatType& /* input */) { }
+
+  //! Return the error that flows into layer I - 1: the delta of layer I, or
+  //! the error of the output layer after the last layer.
+  template<size_t I>
+  typename std::enable_if<(I < numLayers), MatType&>::type LayerError()
+  {
+    return std::get<I>(network).Delta();
+  }
+
+  template<size_t I>
+  typename std::enable_if<(I == numLayers), MatType&>::type LayerError()
+  {
+    return error;
+  }
+
+  //! Propagate the error back through layers I down to 1.
+  template<size_t I>
+  typename std::enable_if<(I > 0), void>::type BackwardLayers()
+  {
+    std::get<I>(network).Backward(std::get<I>(network).OutputParameter(),
+        LayerError<I + 1>(), std::get<I>(network).Delta());
+    BackwardLayers<I - 1>();
+  }
+
+  template<size_t I>
+  typename std::enable_if<(I == 0), void>::type BackwardLayers() { }
+
+  //! Compute the gradients of layers I and above, where the given input is
+  //! the input of layer I.
+  template<size_t I = 0>
+  typename std::enable_if<(I < numLayers), void>::type
+  GradientLayers(const MatType& input)
+  {
+    LayerGradient(std::get<I>(network), input, LayerError<I + 1>());
+    GradientLayers<I + 1>(std::get<I>(network).OutputParameter());
+  }
+
+  template<size_t I = 0>
+  typename std::enable_if<(I == numLayers), void>::type
+  GradientLayers(const MatType& /* input */) { }
+
+  //! Compute the gradient of the given layer, if it has any weights.
+  template<typename LayerType>
+  typename std::enable_if<
+      HasGradientCheck<LayerType, MatType&(LayerType::*)()>::value, void>::type
+  LayerGradient(LayerType& layer, const MatType& input, const MatType& error)
+  {
+    layer.Gradient(input, error, layer.Gradient());
+  }
+
+  template<typename LayerType>
+  typename std::enable_if<
+      !HasGradientCheck<LayerType, MatType&(LayerType::*)()>::value, void>::type
+  LayerGradient(LayerType& /* layer */,
+                const MatType& /* input */,
+                const MatType& /* error */) { }
+
+  //! Instantiated output layer used to evaluate the network.
+  OutputLayerType outputLayer;
+
+  //! Instantiated InitializationRule object for initializing the network
+  //! parameter.
+  InitializationRuleType initializeRule;
+
+  //! The layers of the network.
+  std::tuple<Layers...> network;
+
+  //! The matrix of data points (predictors).
+  MatType predictors;
+
+  //! The matrix of responses to the input data points.
+  MatType responses;
+
+  //! Matrix of (trained) parameters.
+  MatType parameter;
+
+  //! The number of separable functions (the number of predictor points).
+  size_t numFunctions;
+
+  //! The current error for the backward pass.
+  MatType error;
+
+  //! The current evaluation mode (training or testing).
+  bool deterministic;
+}; // class StaticFFN
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "static_ffn_impl.hpp"
+
+#endif
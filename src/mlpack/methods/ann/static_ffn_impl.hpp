@@ -0,0 +1,342 @@
+/**
+ * @file methods/ann/static_ffn_impl.hpp
+ *
+ * Implementation of the StaticFFN class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_STATIC_FFN_IMPL_HPP
+#define MLPACK_METHODS_ANN_STATIC_FFN_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "static_ffn.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+StaticFFN<OutputLayerType, InitializationRuleType, Layers...>::StaticFFN(
+    const Layers&... layers) :
+    network(layers...),
+    numFunctions(0),
+    deterministic(false)
+{
+  // Nothing to do here.
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+StaticFFN<OutputLayerType, InitializationRuleType, Layers...>::StaticFFN(
+    const StaticFFN& network) :
+    outputLayer(network.outputLayer),
+    initializeRule(network.initializeRule),
+    network(network.network),
+    predictors(network.predictors),
+    responses(network.responses),
+    parameter(network.parameter),
+    numFunctions(network.numFunctions),
+    error(network.error),
+    deterministic(network.deterministic)
+{
+  // The copied layers hold their own weights; point them at our parameters.
+  if (!parameter.is_empty())
+    SetWeights();
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+StaticFFN<OutputLayerType, InitializationRuleType, Layers...>::StaticFFN(
+    StaticFFN&& network) :
+    outputLayer(std::move(network.outputLayer)),
+    initializeRule(std::move(network.initializeRule)),
+    network(std::move(network.network)),
+    predictors(std::move(network.predictors)),
+    responses(std::move(network.responses)),
+    parameter(std::move(network.parameter)),
+    numFunctions(network.numFunctions),
+    error(std::move(network.error)),
+    deterministic(network.deterministic)
+{
+  if (!parameter.is_empty())
+    SetWeights();
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+StaticFFN<OutputLayerType, InitializationRuleType, Layers...>&
+StaticFFN<OutputLayerType, InitializationRuleType, Layers...>::operator=(
+    const StaticFFN& network)
+{
+  if (this != &network)
+  {
+    outputLayer = network.outputLayer;
+    initializeRule = network.initializeRule;
+    this->network = network.network;
+    predictors = network.predictors;
+    responses = network.responses;
+    parameter = network.parameter;
+    numFunctions = network.numFunctions;
+    error = network.error;
+    deterministic = network.deterministic;
+
+    if (!parameter.is_empty())
+      SetWeights();
+  }
+
+  return *this;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+template<typename OptimizerType, typename... CallbackTypes>
+double StaticFFN<OutputLayerType, InitializationRuleType, Layers...>::Train(
+    MatType predictors,
+    MatType responses,
+    OptimizerType& optimizer,
+    CallbackTypes&&... callbacks)
+{
+  numFunctions = responses.n_cols;
+  this->predictors = std::move(predictors);
+  this->responses = std::move(responses);
+  this->deterministic = false;
+  ResetDeterministic();
+
+  if (parameter.is_empty())
+    ResetParameters();
+
+  // Train the model.
+  Timer::Start("ffn_optimization");
+  const double out = optimizer.Optimize(*this, parameter, callbacks...);
+  Timer::Stop("ffn_optimization");
+
+  Log::Info << "StaticFFN::Train(): final objective of trained model is "
+      << out << "." << std::endl;
+  return out;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+template<typename OptimizerType, typename... CallbackTypes>
+double StaticFFN<OutputLayerType, InitializationRuleType, Layers...>::Train(
+    MatType predictors,
+    MatType responses,
+    CallbackTypes&&... callbacks)
+{
+  OptimizerType optimizer;
+  return Train(std::move(predictors), std::move(responses), optimizer,
+      callbacks...);
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+void StaticFFN<OutputLayerType, InitializationRuleType, Layers...>::Predict(
+    const MatType& predictors, MatType& results, const size_t batchSize)
+{
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("StaticFFN<>::Predict(): batchSize must be "
+        "greater than 0");
+  }
+
+  if (parameter.is_empty())
+    ResetParameters();
+
+  if (!deterministic)
+  {
+    deterministic = true;
+    ResetDeterministic();
+  }
+
+  if (predictors.n_cols == 0)
+  {
+    results.set_size(0, 0);
+    return;
+  }
+
+  for (size_t i = 0; i < predictors.n_cols; i += batchSize)
+  {
+    const size_t effectiveBatchSize = std::min(batchSize,
+        size_t(predictors.n_cols - i));
+
+    // Alias the batch instead of copying it; the layers only read their input.
+    ForwardLayers(MatType(const_cast<typename MatType::elem_type*>(
+        predictors.colptr(i)),
+        predictors.n_rows, effectiveBatchSize, false, true));
+
+    const MatType& output = NetworkOutput();
+    if (i == 0)
+      results.set_size(output.n_rows, predictors.n_cols);
+
+    results.cols(i, i + effectiveBatchSize - 1) = output;
+  }
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+double StaticFFN<OutputLayerType, InitializationRuleType, Layers...>::Evaluate(
+    const MatType& parameters)
+{
+  double res = 0;
+  for (size_t i = 0; i < predictors.n_cols; ++i)
+    res += Evaluate(parameters, i, 1, true);
+
+  return res;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+double StaticFFN<OutputLayerType, InitializationRuleType, Layers...>::Evaluate(
+    const MatType& /* parameters */,
+    const size_t begin,
+    const size_t batchSize,
+    const bool deterministic)
+{
+  if (parameter.is_empty())
+    ResetParameters();
+
+  if (deterministic != this->deterministic)
+  {
+    this->deterministic = deterministic;
+    ResetDeterministic();
+  }
+
+  ForwardLayers(predictors.cols(begin, begin + batchSize - 1));
+  return outputLayer.Forward(NetworkOutput(),
+      responses.cols(begin, begin + batchSize - 1)) + LayerLoss();
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+double StaticFFN<OutputLayerType, InitializationRuleType, Layers...>::Evaluate(
+    const MatType& parameters, const size_t begin, const size_t batchSize)
+{
+  return Evaluate(parameters, begin, batchSize, true);
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+template<typename GradType>
+double StaticFFN<OutputLayerType, InitializationRuleType, Layers...>::
+EvaluateWithGradient(const MatType& parameters, GradType& gradient)
+{
+  double res = 0;
+  for (size_t i = 0; i < predictors.n_cols; ++i)
+    res += EvaluateWithGradient(parameters, i, gradient, 1);
+
+  return res;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+template<typename GradType>
+double StaticFFN<OutputLayerType, InitializationRuleType, Layers...>::
+EvaluateWithGradient(const MatType& /* parameters */,
+                     const size_t begin,
+                     GradType& gradient,
+                     const size_t batchSize)
+{
+  if (gradient.is_empty())
+  {
+    if (parameter.is_empty())
+      ResetParameters();
+
+    gradient = arma::zeros<MatType>(parameter.n_rows, parameter.n_cols);
+  }
+  else
+  {
+    gradient.zeros();
+  }
+
+  if (this->deterministic)
+  {
+    this->deterministic = false;
+    ResetDeterministic();
+  }
+
+  const MatType input = predictors.cols(begin, begin + batchSize - 1);
+  ForwardLayers(input);
+  const double res = outputLayer.Forward(NetworkOutput(),
+      responses.cols(begin, begin + batchSize - 1)) + LayerLoss();
+
+  outputLayer.Backward(NetworkOutput(),
+      responses.cols(begin, begin + batchSize - 1), error);
+
+  BackwardLayers<numLayers - 1>();
+  SetLayerGradients(gradient, 0);
+  GradientLayers(input);
+
+  return res;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+void StaticFFN<OutputLayerType, InitializationRuleType, Layers...>::Gradient(
+    const MatType& parameters,
+    const size_t begin,
+    MatType& gradient,
+    const size_t batchSize)
+{
+  this->EvaluateWithGradient(parameters, begin, gradient, batchSize);
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+void StaticFFN<OutputLayerType, InitializationRuleType, Layers...>::Shuffle()
+{
+  math::ShuffleData(predictors, responses, predictors, responses);
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+void StaticFFN<OutputLayerType, InitializationRuleType, Layers...>::Forward(
+    const MatType& inputs, MatType& results)
+{
+  if (parameter.is_empty())
+    ResetParameters();
+
+  ForwardLayers(inputs);
+  results = NetworkOutput();
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+void StaticFFN<OutputLayerType, InitializationRuleType,
+               Layers...>::ResetParameters()
+{
+  ResetDeterministic();
+
+  parameter.set_size(WeightSize(), 1);
+
+  // Initialize the network layer by layer or the complete network.
+  if (ann::InitTraits<InitializationRuleType>::UseLayer)
+    InitializeLayers(0);
+  else
+    initializeRule.Initialize(parameter, parameter.n_elem, 1);
+
+  SetWeights();
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+void StaticFFN<OutputLayerType, InitializationRuleType,
+               Layers...>::SetWeights()
+{
+  SetLayerWeights(0);
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... Layers>
+void StaticFFN<OutputLayerType, InitializationRuleType,
+               Layers...>::ResetDeterministic()
+{
+  SetLayerDeterministic();
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
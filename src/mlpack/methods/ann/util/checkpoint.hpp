@@ -0,0 +1,116 @@
+/**
+ * @file methods/ann/util/checkpoint.hpp
+ *
+ * Definition of the Checkpoint callback, which saves the parameters of a
+ * network in the background during training.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_UTIL_CHECKPOINT_HPP
+#define MLPACK_METHODS_ANN_UTIL_CHECKPOINT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/checkpointer.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Checkpoint is an ensmallen callback that saves the parameters of the network
+ * being trained every few epochs, with a data::Checkpointer: the parameters are
+ * copied at the end of the epoch and written to the file in a background
+ * thread, so the next epoch starts right away.  If the previous checkpoint is
+ * still being written, the parameters of this epoch are not saved.
+ *
+ * To resume training, load the parameters into the network before calling
+ * Train() again (after ResetParameters(), or a first call to Train() or
+ * Predict(), so that the layers are set up):
+ *
+ * @code
+ * FFN<> model;
+ * // Add the layers...
+ * model.Train(data, labels, optimizer, ann::Checkpoint("params.bin", 5));
+ *
+ * // After an interruption:
+ * model.ResetParameters();
+ * data::Load("params.bin", "parameters", model.Parameters(), true);
+ * model.Train(data, labels, optimizer, ann::Checkpoint("params.bin", 5));
+ * @endcode
+ *
+ * The callback can be copied (the copies share the same writer), as ensmallen
+ * may take it by value.  The last checkpoint is complete on disk when the
+ * callback and all its copies are destroyed, or after Wait().
+ */
+class Checkpoint
+{
+ public:
+  /**
+   * Create the callback.
+   *
+   * @param filename Name of the file to save the parameters to; its extension
+   *     gives the format, as for data::Save().
+   * @param period Number of epochs between checkpoints.
+   * @param name Name of the parameters in the file.
+   */
+  Checkpoint(const std::string& filename,
+             const size_t period = 1,
+             const std::string& name = "parameters") :
+      checkpointer(std::make_shared<data::Checkpointer<arma::mat>>(filename,
+          name)),
+      period(period)
+  {
+    if (period == 0)
+    {
+      throw std::invalid_argument("Checkpoint::Checkpoint(): period must be "
+          "positive!");
+    }
+  }
+
+  /**
+   * Called by the optimizer at the end of each epoch; saves the coordinates
+   * every period epochs.
+   *
+   * @param optimizer The optimizer used to train the network.
+   * @param function The network being trained.
+   * @param coordinates The current parameters of the network.
+   * @param epoch The index of the epoch that ended.
+   * @param objective The objective value of the epoch.
+   */
+  template<typename OptimizerType, typename FunctionType>
+  bool EndEpoch(OptimizerType& /* optimizer */,
+                FunctionType& /* function */,
+                const arma::mat& coordinates,
+                const size_t epoch,
+                const double /* objective */)
+  {
+    if (epoch % period == 0)
+      checkpointer->Save(coordinates);
+
+    return false;
+  }
+
+  //! Wait until the last checkpoint is written.
+  void Wait() { checkpointer->Wait(); }
+
+  //! Get the number of checkpoints saved.
+  size_t Saved() const { return checkpointer->Saved(); }
+  //! Get the number of checkpoints skipped (because a write was running).
+  size_t Skipped() const { return checkpointer->Skipped(); }
+
+  //! Get the number of epochs between checkpoints.
+  size_t Period() const { return period; }
+
+ private:
+  //! The writer of the checkpoints.
+  std::shared_ptr<data::Checkpointer<arma::mat>> checkpointer;
+  //! The number of epochs between checkpoints.
+  size_t period;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
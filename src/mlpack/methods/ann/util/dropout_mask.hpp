@@ -0,0 +1,222 @@
+/**
+ * @file methods/ann/util/dropout_mask.hpp
+ *
+ * Definition of the DropoutMask class, a bit-packed random mask for the
+ * dropout layers, drawn from a counter-based random number generator.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_UTIL_DROPOUT_MASK_HPP
+#define MLPACK_METHODS_ANN_UTIL_DROPOUT_MASK_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * A DropoutMask holds which elements of a matrix are kept by a dropout layer,
+ * as one bit per element.  The bits are drawn from the Philox4x32-10
+ * counter-based generator of Salmon et al.:
+ *
+ * @code
+ * @inproceedings{salmon2011parallel,
+ *   title={Parallel Random Numbers: As Easy as 1, 2, 3},
+ *   author={Salmon, John K. and Moraes, Mark A. and Dror, Ron O. and
+ *       Shaw, David E.},
+ *   booktitle={Proceedings of the 2011 International Conference for High
+ *       Performance Computing, Networking, Storage and Analysis (SC '11)},
+ *   year={2011}
+ * }
+ * @endcode
+ *
+ * The random number of element i of a mask only depends on the seed of the
+ * mask, the index of the mask (one for each call to Generate()) and i, so
+ * there is no generator state to share: the words of the mask are filled in
+ * parallel, and any mask can be drawn again with Generate(n, ratio, stream)
+ * instead of being kept around.
+ */
+class DropoutMask
+{
+ public:
+  /**
+   * Create the mask, with a seed drawn from mlpack's random number generator
+   * (so that math::RandomSeed() makes the masks reproducible).
+   */
+  DropoutMask() :
+      seed((uint64_t(math::RandGen()()) << 32) | uint64_t(math::RandGen()())),
+      stream(0),
+      size(0)
+  {
+    // Nothing to do here.
+  }
+
+  /**
+   * Create the mask with the given seed.
+   *
+   * @param seed Seed of the masks.
+   */
+  DropoutMask(const uint64_t seed) : seed(seed), stream(0), size(0)
+  {
+    // Nothing to do here.
+  }
+
+  /**
+   * Draw a new mask of n elements, where each element is dropped with the
+   * given probability.
+   *
+   * @param n Number of elements of the mask.
+   * @param ratio Probability of dropping an element.
+   */
+  void Generate(const size_t n, const double ratio)
+  {
+    Generate(n, ratio, stream + 1);
+  }
+
+  /**
+   * Draw the mask with the given index again (or for the first time).
+   *
+   * @param n Number of elements of the mask.
+   * @param ratio Probability of dropping an element.
+   * @param stream Index of the mask.
+   */
+  void Generate(const size_t n, const double ratio, const uint64_t stream)
+  {
+    this->stream = stream;
+    size = n;
+    bits.resize((n + 63) / 64);
+
+    // An element is kept when its 32-bit random number is at least the
+    // threshold.
+    const uint64_t threshold = (uint64_t) std::min(std::max(ratio, 0.0) *
+        4294967296.0, 4294967296.0);
+
+    #pragma omp parallel for if (bits.size() > 1024)
+    for (omp_size_t w = 0; w < (omp_size_t) bits.size(); ++w)
+    {
+      uint64_t word = 0;
+      // Each block of the generator gives four random numbers.
+      for (size_t b = 0; b < 16; ++b)
+      {
+        uint32_t r[4];
+        Philox((uint64_t) w * 16 + b, r);
+        for (size_t j = 0; j < 4; ++j)
+        {
+          if (r[j] >= threshold)
+            word |= uint64_t(1) << (4 * b + j);
+        }
+      }
+      bits[w] = word;
+    }
+
+    // Clear the bits past the end, so that they never count as kept.
+    if (n % 64 != 0)
+      bits.back() &= (uint64_t(1) << (n % 64)) - 1;
+  }
+
+  //! Return whether element i is kept.
+  bool Kept(const size_t i) const { return (bits[i / 64] >> (i % 64)) & 1; }
+
+  /**
+   * Compute output(i) = scale * input(i) + shift for the kept elements, and
+   * output(i) = dropped for the others.  The input and output may be the same
+   * matrix.
+   *
+   * @param input Input matrix (with as many elements as the mask).
+   * @param output Matrix to store the result in.
+   * @param scale Factor of the kept elements.
+   * @param shift Offset of the kept elements.
+   * @param dropped Value of the dropped elements.
+   */
+  template<typename eT>
+  void Apply(const arma::Mat<eT>& input,
+             arma::Mat<eT>& output,
+             const double scale,
+             const double shift = 0.0,
+             const double dropped = 0.0) const
+  {
+    if (input.n_elem != size)
+    {
+      std::ostringstream oss;
+      oss << "DropoutMask::Apply(): number of elements (" << input.n_elem
+          << ") does not match size of mask (" << size << ")!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    output.set_size(input.n_rows, input.n_cols);
+    const eT* in = input.memptr();
+    eT* out = output.memptr();
+    for (size_t i = 0; i < size; ++i)
+      out[i] = Kept(i) ? eT(scale * in[i] + shift) : eT(dropped);
+  }
+
+  /**
+   * Store the mask in a matrix of the given shape, with ones for the kept
+   * elements and zeros for the others.
+   *
+   * @param rows Number of rows of the matrix.
+   * @param cols Number of columns of the matrix.
+   * @param mask Matrix to store the mask in.
+   */
+  template<typename eT>
+  void Unpack(const size_t rows, const size_t cols, arma::Mat<eT>& mask) const
+  {
+    mask.set_size(rows, cols);
+    for (size_t i = 0; i < mask.n_elem && i < size; ++i)
+      mask[i] = Kept(i);
+  }
+
+  //! Get the number of elements of the mask.
+  size_t Size() const { return size; }
+  //! Get the index of the current mask.
+  uint64_t Stream() const { return stream; }
+  //! Get the seed of the masks.
+  uint64_t Seed() const { return seed; }
+
+ private:
+  /**
+   * Compute the four random numbers of the given block of the current mask
+   * with ten rounds of Philox4x32.
+   */
+  void Philox(const uint64_t block, uint32_t r[4]) const
+  {
+    uint32_t c0 = (uint32_t) block, c1 = (uint32_t) (block >> 32);
+    uint32_t c2 = (uint32_t) stream, c3 = (uint32_t) (stream >> 32);
+    uint32_t k0 = (uint32_t) seed, k1 = (uint32_t) (seed >> 32);
+    for (size_t round = 0; round < 10; ++round)
+    {
+      const uint64_t p0 = uint64_t(0xD2511F53) * c0;
+      const uint64_t p1 = uint64_t(0xCD9E8D57) * c2;
+      const uint32_t n0 = uint32_t(p1 >> 32) ^ c1 ^ k0;
+      const uint32_t n2 = uint32_t(p0 >> 32) ^ c3 ^ k1;
+      c1 = (uint32_t) p1;
+      c3 = (uint32_t) p0;
+      c0 = n0;
+      c2 = n2;
+      k0 += 0x9E3779B9;
+      k1 += 0xBB67AE85;
+    }
+    r[0] = c0;
+    r[1] = c1;
+    r[2] = c2;
+    r[3] = c3;
+  }
+
+  //! The seed (key) of the generator.
+  uint64_t seed;
+  //! The index of the current mask.
+  uint64_t stream;
+  //! The number of elements of the current mask.
+  size_t size;
+  //! The bits of the mask, 64 elements per word.
+  std::vector<uint64_t> bits;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
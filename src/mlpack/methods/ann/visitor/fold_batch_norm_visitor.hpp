@@ -0,0 +1,75 @@
+/**
+ * @file methods/ann/visitor/fold_batch_norm_visitor.hpp
+ *
+ * Boost static visitor abstraction for folding the inference-time affine
+ * transformation of a BatchNorm layer into the layer before it.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_FOLD_BATCH_NORM_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_FOLD_BATCH_NORM_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+#include <mlpack/methods/ann/layer/layer_types.hpp>
+
+#include <boost/variant.hpp>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * FoldBatchNormVisitor folds the given BatchNorm layer, as it is applied in
+ * deterministic mode,
+ *
+ *   y = gamma * (x - runningMean) / sqrt(runningVariance + eps) + beta,
+ *
+ * into the weights and biases of the visited layer, if that layer is a Linear
+ * or a Convolution layer with one output (map) per BatchNorm channel.  The
+ * visitor returns whether the layer was modified; other layers are left as
+ * they are.
+ */
+class FoldBatchNormVisitor : public boost::static_visitor<bool>
+{
+ public:
+  //! Fold the given BatchNorm layer.
+  FoldBatchNormVisitor(const BatchNorm<>& batchNorm);
+
+  //! Scale the rows of the weights and the biases of a Linear layer.
+  template<typename InputDataType, typename OutputDataType,
+           typename RegularizerType>
+  bool operator()(
+      Linear<InputDataType, OutputDataType, RegularizerType>* layer) const;
+
+  //! Scale the kernels and the biases of each output map of a Convolution
+  //! layer.
+  template<typename ForwardConvolutionRule,
+           typename BackwardConvolutionRule,
+           typename GradientConvolutionRule,
+           typename InputDataType,
+           typename OutputDataType>
+  bool operator()(Convolution<ForwardConvolutionRule, BackwardConvolutionRule,
+      GradientConvolutionRule, InputDataType, OutputDataType>* layer) const;
+
+  //! Other layers can't absorb the BatchNorm layer.
+  template<typename LayerType>
+  bool operator()(LayerType* layer) const;
+
+  bool operator()(MoreTypes layer) const;
+
+ private:
+  //! The scale of each channel.
+  arma::vec scale;
+  //! The shift of each channel, applied after the scale.
+  arma::vec shift;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "fold_batch_norm_visitor_impl.hpp"
+
+#endif
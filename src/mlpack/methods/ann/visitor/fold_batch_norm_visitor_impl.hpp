@@ -0,0 +1,85 @@
+/**
+ * @file methods/ann/visitor/fold_batch_norm_visitor_impl.hpp
+ *
+ * Implementation of the BatchNorm folding layer abstraction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_FOLD_BATCH_NORM_VISITOR_IMPL_HPP
+#define MLPACK_METHODS_ANN_VISITOR_FOLD_BATCH_NORM_VISITOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "fold_batch_norm_visitor.hpp"
+
+namespace mlpack {
+namespace ann {
+
+//! FoldBatchNormVisitor visitor class.
+inline FoldBatchNormVisitor::FoldBatchNormVisitor(
+    const BatchNorm<>& batchNorm)
+{
+  // The parameters of the BatchNorm layer are gamma followed by beta.
+  const size_t size = batchNorm.InputSize();
+  const arma::vec gamma = batchNorm.Parameters().rows(0, size - 1);
+  const arma::vec beta = batchNorm.Parameters().rows(size, 2 * size - 1);
+
+  scale = gamma / arma::sqrt(arma::vectorise(batchNorm.TrainingVariance()) +
+      batchNorm.Epsilon());
+  shift = beta - scale % arma::vectorise(batchNorm.TrainingMean());
+}
+
+template<typename InputDataType, typename OutputDataType,
+         typename RegularizerType>
+inline bool FoldBatchNormVisitor::operator()(
+    Linear<InputDataType, OutputDataType, RegularizerType>* layer) const
+{
+  if (layer->OutputSize() != scale.n_elem)
+    return false;
+
+  layer->Weight().each_col() %= scale;
+  layer->Bias() = scale % layer->Bias() + shift;
+  return true;
+}
+
+template<typename ForwardConvolutionRule,
+         typename BackwardConvolutionRule,
+         typename GradientConvolutionRule,
+         typename InputDataType,
+         typename OutputDataType>
+inline bool FoldBatchNormVisitor::operator()(
+    Convolution<ForwardConvolutionRule, BackwardConvolutionRule,
+        GradientConvolutionRule, InputDataType, OutputDataType>* layer) const
+{
+  if (layer->OutputSize() != scale.n_elem)
+    return false;
+
+  // The kernels of output map o are the slices o * inSize to
+  // (o + 1) * inSize - 1.
+  const size_t inSize = layer->InputSize();
+  for (size_t o = 0; o < scale.n_elem; ++o)
+  {
+    layer->Weight().slices(o * inSize, (o + 1) * inSize - 1) *= scale[o];
+    layer->Bias()[o] = scale[o] * layer->Bias()[o] + shift[o];
+  }
+
+  return true;
+}
+
+template<typename LayerType>
+inline bool FoldBatchNormVisitor::operator()(LayerType* /* layer */) const
+{
+  return false;
+}
+
+inline bool FoldBatchNormVisitor::operator()(MoreTypes layer) const
+{
+  return layer.apply_visitor(*this);
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,71 @@
+/**
+ * @file methods/ann/visitor/project_inputs_visitor.hpp
+ *
+ * This file provides an abstraction for the ProjectInputs() function of the
+ * recurrent layers, which computes the input projections of several steps at
+ * once.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_PROJECT_INPUTS_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_PROJECT_INPUTS_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+
+#include <boost/variant.hpp>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * ProjectInputsVisitor executes the ProjectInputs() function, and returns
+ * whether the layer implements it.  If no input is given, it only returns
+ * whether the layer implements the function.
+ */
+class ProjectInputsVisitor : public boost::static_visitor<bool>
+{
+ public:
+  //! Only check whether the layer implements ProjectInputs().
+  ProjectInputsVisitor();
+
+  //! Project the given inputs (one block of batchSize columns for each step).
+  ProjectInputsVisitor(const arma::mat& input, const size_t batchSize);
+
+  //! Execute the ProjectInputs() function.
+  template<typename LayerType>
+  bool operator()(LayerType* layer) const;
+
+  bool operator()(MoreTypes layer) const;
+
+ private:
+  //! The inputs of the steps, or NULL to only check for the function.
+  const arma::mat* input;
+
+  //! The number of points of each step.
+  size_t batchSize;
+
+  //! Execute the ProjectInputs() function for a module which implements it.
+  template<typename T>
+  typename std::enable_if<
+      HasProjectInputsCheck<T, void(T::*)(const arma::mat&,
+          const size_t)>::value, bool>::type
+  LayerProjectInputs(T* layer) const;
+
+  //! Do nothing for a module which doesn't implement ProjectInputs().
+  template<typename T>
+  typename std::enable_if<
+      !HasProjectInputsCheck<T, void(T::*)(const arma::mat&,
+          const size_t)>::value, bool>::type
+  LayerProjectInputs(T* layer) const;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "project_inputs_visitor_impl.hpp"
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ * @file methods/ann/visitor/project_inputs_visitor_impl.hpp
+ *
+ * Implementation of the ProjectInputs() function layer abstraction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_PROJECT_INPUTS_VISITOR_IMPL_HPP
+#define MLPACK_METHODS_ANN_VISITOR_PROJECT_INPUTS_VISITOR_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "project_inputs_visitor.hpp"
+
+namespace mlpack {
+namespace ann {
+
+inline ProjectInputsVisitor::ProjectInputsVisitor() :
+    input(NULL),
+    batchSize(0)
+{
+  /* Nothing to do here. */
+}
+
+inline ProjectInputsVisitor::ProjectInputsVisitor(const arma::mat& input,
+                                                  const size_t batchSize) :
+    input(&input),
+    batchSize(batchSize)
+{
+  /* Nothing to do here. */
+}
+
+template<typename LayerType>
+inline bool ProjectInputsVisitor::operator()(LayerType* layer) const
+{
+  return LayerProjectInputs(layer);
+}
+
+inline bool ProjectInputsVisitor::operator()(MoreTypes layer) const
+{
+  return layer.apply_visitor(*this);
+}
+
+template<typename T>
+inline typename std::enable_if<
+    HasProjectInputsCheck<T, void(T::*)(const arma::mat&,
+        const size_t)>::value, bool>::type
+ProjectInputsVisitor::LayerProjectInputs(T* layer) const
+{
+  if (input)
+    layer->ProjectInputs(*input, batchSize);
+
+  return true;
+}
+
+template<typename T>
+inline typename std::enable_if<
+    !HasProjectInputsCheck<T, void(T::*)(const arma::mat&,
+        const size_t)>::value, bool>::type
+ProjectInputsVisitor::LayerProjectInputs(T* /* layer */) const
+{
+  return false;
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,65 @@
+/**
+ * @file methods/ann/visitor/recompute_visitor.hpp
+ *
+ * This file provides an abstraction that tells whether the output of a layer
+ * can be recomputed from its input alone, so that it doesn't have to be stored
+ * for the backward pass.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_RECOMPUTE_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_RECOMPUTE_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+
+#include <boost/variant.hpp>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * RecomputeVisitor returns true if the output of the given layer only depends
+ * on the input of the current step, so that calling Forward() again gives the
+ * same output.  That is not the case for layers that keep state across steps
+ * (the ones that implement ResetCell()), layers with random or
+ * training-dependent behavior (the ones that implement Deterministic()), and
+ * layers that hold other layers (the ones that implement Model()).
+ */
+class RecomputeVisitor : public boost::static_visitor<bool>
+{
+ public:
+  //! Return whether the output of the layer can be recomputed.
+  template<typename LayerType>
+  bool operator()(LayerType* layer) const;
+
+  bool operator()(MoreTypes layer) const;
+
+ private:
+  //! Return false if the module keeps state, may be random, or holds other
+  //! modules.
+  template<typename T>
+  typename std::enable_if<
+      HasResetCellCheck<T, void(T::*)(const size_t)>::value ||
+      HasDeterministicCheck<T, bool&(T::*)(void)>::value ||
+      HasModelCheck<T>::value, bool>::type
+  LayerRecompute(T* layer) const;
+
+  //! Return true for all other modules.
+  template<typename T>
+  typename std::enable_if<
+      !HasResetCellCheck<T, void(T::*)(const size_t)>::value &&
+      !HasDeterministicCheck<T, bool&(T::*)(void)>::value &&
+      !HasModelCheck<T>::value, bool>::type
+  LayerRecompute(T* layer) const;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "recompute_visitor_impl.hpp"
+
+#endif
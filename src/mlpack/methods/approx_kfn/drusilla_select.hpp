@@ -83,6 +83,10 @@ class DrusillaSelect
    * the k'th row in that column will refer to the k'th candidate neighbor or
    * distance for that query point.
    *
+   * The distances between blocks of query points and the candidates are
+   * computed with matrix products, and the blocks are searched in parallel if
+   * OpenMP is available.
+   *
    * @param querySet Set of query points to search.
    * @param k Number of furthest neighbors to search for.
    * @param neighbors Matrix to store resulting neighbors in.
@@ -119,6 +123,10 @@ class DrusillaSelect
   size_t l;
   //! The number of points in each projection.
   size_t m;
+
+  //! The number of query points whose distances to the candidates are computed
+  //! at once by each thread.
+  static const size_t BlockSize = 256;
 };
 
 } // namespace neighbor
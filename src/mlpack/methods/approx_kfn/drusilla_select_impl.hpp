@@ -16,9 +16,7 @@
 #include "drusilla_select.hpp"
 
 #include <queue>
-#include <mlpack/methods/neighbor_search/neighbor_search_rules.hpp>
-#include <mlpack/methods/neighbor_search/sort_policies/furthest_neighbor_sort.hpp>
-#include <mlpack/core/tree/binary_space_tree.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
 #include <algorithm>
 
 namespace mlpack {
@@ -85,7 +83,8 @@ void DrusillaSelect<MatType>::Train(
   arma::vec norms(referenceSet.n_cols);
 
   MatType refCopy(referenceSet.n_rows, referenceSet.n_cols);
-  for (size_t i = 0; i < refCopy.n_cols; ++i)
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) refCopy.n_cols; ++i)
   {
     refCopy.col(i) = referenceSet.col(i) - dataMean;
     norms[i] = arma::norm(refCopy.col(i));
@@ -100,10 +99,14 @@ void DrusillaSelect<MatType>::Train(
 
     arma::vec line(refCopy.col(maxIndex) / arma::norm(refCopy.col(maxIndex)));
 
-    // Calculate distortion and offset and make scores.
-    std::vector<bool> closeAngle(referenceSet.n_cols, false);
+    // Calculate distortion and offset and make scores.  Each point is scored
+    // independently, so this is done in parallel (closeAngle is not a
+    // std::vector<bool> so that neighboring elements can be written by
+    // different threads).
+    std::vector<char> closeAngle(referenceSet.n_cols, false);
     arma::vec sums(referenceSet.n_cols);
-    for (size_t j = 0; j < referenceSet.n_cols; ++j)
+    #pragma omp parallel for
+    for (omp_size_t j = 0; j < (omp_size_t) referenceSet.n_cols; ++j)
     {
       if (norms[j] > 0.0)
       {
@@ -179,23 +182,57 @@ void DrusillaSelect<MatType>::Search(const MatType& querySet,
     throw std::invalid_argument("DrusillaSelect::Search(): requested k is "
         "greater than number of points in candidate set!  Increase l or m.");
 
-  // We'll use the NeighborSearchRules class to perform our brute-force search.
-  // Note that we aren't using trees for our search, so we can use 'int' as a
-  // TreeType.
-  metric::EuclideanDistance metric;
-  NeighborSearchRules<FurthestNeighborSort, metric::EuclideanDistance,
-      tree::KDTree<metric::EuclideanDistance, tree::EmptyStatistic, MatType>>
-      rules(candidateSet, querySet, k, metric, 0, false);
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
 
-  for (size_t q = 0; q < querySet.n_cols; ++q)
-    for (size_t r = 0; r < candidateSet.n_cols; ++r)
-      rules.BaseCase(q, r);
+  // The squared norms of the candidates, for the distance computations below.
+  arma::vec candidateNorms(candidateSet.n_cols);
+  for (size_t r = 0; r < candidateSet.n_cols; ++r)
+    candidateNorms[r] = arma::dot(candidateSet.col(r), candidateSet.col(r));
 
-  rules.GetResults(neighbors, distances);
-
-  // Map the neighbors back to their original indices in the reference set.
-  for (size_t i = 0; i < neighbors.n_elem; ++i)
-    neighbors[i] = candidateIndices[neighbors[i]];
+  // The queries are handled in blocks; the distances between a block of
+  // queries and all the candidates are computed at once with a matrix
+  // product, and the blocks are handled in parallel.
+  const size_t numBlocks = (querySet.n_cols + BlockSize - 1) / BlockSize;
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const size_t begin = b * BlockSize;
+    const size_t end = std::min(begin + BlockSize,
+        (size_t) querySet.n_cols) - 1;
+
+    // Squared distances, up to the squared norm of each query point (which
+    // does not change the order of the candidates of a query point).
+    arma::mat scores = candidateSet.t() * querySet.cols(begin, end);
+    scores *= -2.0;
+    scores.each_col() += candidateNorms;
+
+    std::vector<std::pair<double, size_t>> results(candidateSet.n_cols);
+    for (size_t q = begin; q <= end; ++q)
+    {
+      for (size_t r = 0; r < candidateSet.n_cols; ++r)
+        results[r] = std::make_pair(scores(r, q - begin), r);
+
+      // Ties are broken in favor of the candidate with the smaller index.
+      std::partial_sort(results.begin(), results.begin() + k, results.end(),
+          [](const std::pair<double, size_t>& a,
+             const std::pair<double, size_t>& b)
+          {
+            return (a.first > b.first) ||
+                (a.first == b.first && a.second < b.second);
+          });
+
+      // Compute the distances to the chosen candidates exactly, and map them
+      // back to their original indices in the reference set.
+      for (size_t j = 0; j < k; ++j)
+      {
+        const size_t r = results[j].second;
+        neighbors(j, q) = candidateIndices[r];
+        distances(j, q) = metric::EuclideanDistance::Evaluate(querySet.col(q),
+            candidateSet.col(r));
+      }
+    }
+  }
 }
 
 //! Serialize the model.
@@ -72,7 +72,10 @@ class QDAFN
    * Search for the k furthest neighbors of the given query set.  (The query set
    * can contain just one point, that is okay.)  The results will be stored in
    * the given neighbors and distances matrices, in the same format as the
-   * mlpack NeighborSearch and LSHSearch classes.
+   * mlpack NeighborSearch and LSHSearch classes.  Each reference point is
+   * returned at most once for each query point; if fewer than k distinct
+   * candidates are found, the remaining neighbors are set to SIZE_MAX.  The
+   * query points are searched in parallel if OpenMP is available.
    */
   void Search(const MatType& querySet,
               const size_t k,
@@ -16,6 +16,7 @@
 #include "qdafn.hpp"
 
 #include <queue>
+#include <algorithm>
 #include <mlpack/methods/neighbor_search/sort_policies/furthest_neighbor_sort.hpp>
 
 namespace mlpack {
@@ -70,11 +71,13 @@ void QDAFN<MatType>::Train(const MatType& referenceSet,
   // top m elements.
   projections = referenceSet.t() * lines;
 
-  // Loop over each projection and find the top m elements.
+  // Loop over each projection and find the top m elements.  The tables are
+  // independent, so they are built in parallel.
   sIndices.set_size(m, l);
   sValues.set_size(m, l);
   candidateSet.resize(l);
-  for (size_t i = 0; i < l; ++i)
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) l; ++i)
   {
     candidateSet[i].set_size(referenceSet.n_rows, m);
     arma::uvec sortedIndices = arma::sort_index(projections.col(i), "descend");
@@ -104,42 +107,38 @@ void QDAFN<MatType>::Search(const MatType& querySet,
   neighbors.fill(size_t() - 1);
   distances.zeros(k, querySet.n_cols);
 
-  // Search for each point.
-  for (size_t q = 0; q < querySet.n_cols; ++q)
+  // Project all the query points onto all the lines at once.
+  const arma::mat queryProjections = lines.t() * querySet;
+
+  // Search for each point.  The query points are independent, so they are
+  // handled in parallel.
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (omp_size_t q = 0; q < (omp_size_t) querySet.n_cols; ++q)
   {
     // Initialize a priority queue.
     // The size_t represents the index of the table, and the double represents
     // the value of l_i * S_i - l_i * query (see line 6 of Algorithm 1).
     std::priority_queue<std::pair<double, size_t>> queue;
     for (size_t i = 0; i < l; ++i)
-    {
-      const double val = sValues(0, i) - arma::dot(querySet.col(q),
-          lines.col(i));
-      queue.push(std::make_pair(val, i));
-    }
+      queue.push(std::make_pair(sValues(0, i) - queryProjections(i, q), i));
 
     // To track where we are in each S table, we keep the next index to look at
     // in each table (they start at 0).
     arma::Col<size_t> tableLocations = arma::zeros<arma::Col<size_t>>(l);
 
-    // Now that the queue is initialized, iterate over m elements.
-    std::vector<std::pair<double, size_t>> v(k, std::make_pair(-1.0,
-        size_t(-1)));
-    std::priority_queue<std::pair<double, size_t>>
-        resultsQueue(std::less<std::pair<double, size_t>>(), std::move(v));
+    // Now that the queue is initialized, iterate over m elements, collecting
+    // the (table, location) of each candidate.  No distance is needed for
+    // this, so all the distances can be computed afterwards.
+    std::vector<std::pair<size_t, size_t>> visited;
+    visited.reserve(m);
     for (size_t i = 0; i < m; ++i)
     {
-      std::pair<size_t, double> p = queue.top();
+      std::pair<double, size_t> p = queue.top();
       queue.pop();
 
       // Get index of reference point to look at.
       const size_t tableIndex = tableLocations[p.second];
-
-      // Calculate distance from query point.
-      const double dist = mlpack::metric::EuclideanDistance::Evaluate(
-          querySet.col(q), candidateSet[p.second].col(tableIndex));
-
-      resultsQueue.push(std::make_pair(dist, sIndices(tableIndex, p.second)));
+      visited.push_back(std::make_pair(p.second, tableIndex));
 
       // Now (line 14) get the next element and insert into the queue.  Do this
       // by adjusting the previous value.  Don't insert anything if we are at
@@ -154,27 +153,39 @@ void QDAFN<MatType>::Search(const MatType& querySet,
       }
     }
 
-    // Extract the results and deduplicate them.
-    size_t extracted = 1;
-    neighbors(0, q) = resultsQueue.top().second;
-    distances(0, q) = resultsQueue.top().first;
-    resultsQueue.pop();
-
-    while (!resultsQueue.empty())
+    // A reference point may be at the top of several tables; order the
+    // candidates by reference point so that each distance is only computed
+    // once.
+    std::sort(visited.begin(), visited.end(),
+        [this](const std::pair<size_t, size_t>& a,
+               const std::pair<size_t, size_t>& b)
+        {
+          return sIndices(a.second, a.first) < sIndices(b.second, b.first);
+        });
+
+    std::vector<std::pair<double, size_t>> results;
+    results.reserve(visited.size());
+    for (size_t i = 0; i < visited.size(); ++i)
     {
-      if (extracted == k)
-        break;
+      const size_t index = sIndices(visited[i].second, visited[i].first);
+      if (!results.empty() && results.back().second == index)
+        continue;
 
-      std::pair<double, size_t> result = resultsQueue.top();
-      resultsQueue.pop();
+      // Each table stores its candidates contiguously.
+      const double dist = mlpack::metric::EuclideanDistance::Evaluate(
+          querySet.col(q), candidateSet[visited[i].first].col(
+          visited[i].second));
+      results.push_back(std::make_pair(dist, index));
+    }
 
-      // Avoid inserting any duplicates.
-      if (neighbors(extracted - 1, q) != result.second)
-      {
-        neighbors(extracted, q) = resultsQueue.top().second;
-        distances(extracted, q) = resultsQueue.top().first;
-        ++extracted;
-      }
+    // Extract the k furthest candidates.
+    const size_t found = std::min(k, results.size());
+    std::partial_sort(results.begin(), results.begin() + found, results.end(),
+        std::greater<std::pair<double, size_t>>());
+    for (size_t j = 0; j < found; ++j)
+    {
+      neighbors(j, q) = results[j].second;
+      distances(j, q) = results[j].first;
     }
   }
 }
@@ -30,32 +30,21 @@ BayesianLinearRegression::BayesianLinearRegression(const bool centerData,
   gamma(0.0)
 {/* Nothing to do */}
 
-double BayesianLinearRegression::Train(const arma::mat& data,
-                                       const arma::rowvec& responses)
+template<typename ResidualFunction>
+void BayesianLinearRegression::Optimize(const arma::colvec& eigVal,
+                                        const arma::mat& eigVec,
+                                        const arma::colvec& cross,
+                                        const double responsesVariance,
+                                        const double numPoints,
+                                        ResidualFunction residual)
 {
-  Timer::Start("bayesian_linear_regression");
-
-  arma::mat phi;
-  arma::rowvec t;
-  arma::colvec eigVal;
-  arma::mat eigVec;
-
-  // Preprocess the data. Center and scale.
-  responsesOffset = CenterScaleData(data, responses, phi, t);
-
-  if (!arma::eig_sym(eigVal, eigVec, arma::symmatu(phi * phi.t())))
-  {
-    Log::Fatal << "BayesianLinearRegression::Train(): Eigendecomposition "
-               << "of covariance failed!" << std::endl;
-  }
-
   // Compute this quantities once and for all.
   const arma::mat eigVecInv = inv(eigVec);
-  const arma::colvec eigVecInvPhitT = eigVecInv * phi * t.t();
+  const arma::colvec eigVecInvPhitT = eigVecInv * cross;
 
   // Initialize the hyperparameters and begin with an infinitely broad prior.
   alpha = 1e-6;
-  beta =  1 / (var(t, 1) * 0.1);
+  beta =  1 / (responsesVariance * 0.1);
 
   unsigned short i = 0;
   double deltaAlpha = 1.0, deltaBeta = 1.0, crit = 1.0;
@@ -73,8 +62,7 @@ double BayesianLinearRegression::Train(const arma::mat& data,
     alpha = gamma / dot(omega, omega);
 
     // Update beta.
-    const arma::rowvec temp = t - omega.t() * phi;
-    beta = (data.n_cols - gamma) / dot(temp, temp);
+    beta = (numPoints - gamma) / residual(omega);
 
     // Compute the stopping criterion.
     deltaAlpha += alpha;
@@ -84,12 +72,107 @@ double BayesianLinearRegression::Train(const arma::mat& data,
   }
   // Compute the covariance matrix for the uncertainties later.
   matCovariance = eigVec * diagmat(1 / (beta * eigVal + alpha)) * eigVecInv;
+}
+
+double BayesianLinearRegression::Train(const arma::mat& data,
+                                       const arma::rowvec& responses)
+{
+  Timer::Start("bayesian_linear_regression");
+
+  arma::mat phi;
+  arma::rowvec t;
+  arma::colvec eigVal;
+  arma::mat eigVec;
+
+  // Preprocess the data. Center and scale.
+  responsesOffset = CenterScaleData(data, responses, phi, t);
+
+  if (!arma::eig_sym(eigVal, eigVec, arma::symmatu(phi * phi.t())))
+  {
+    Log::Fatal << "BayesianLinearRegression::Train(): Eigendecomposition "
+               << "of covariance failed!" << std::endl;
+  }
+
+  const arma::colvec cross = phi * t.t();
+  Optimize(eigVal, eigVec, cross, var(t, 1), data.n_cols,
+      [&phi, &t](const arma::colvec& omega)
+      {
+        const arma::rowvec temp = t - omega.t() * phi;
+        return dot(temp, temp);
+      });
 
   Timer::Stop("bayesian_linear_regression");
 
   return RMSE(data, responses);
 }
 
+double BayesianLinearRegression::Train(const RegressionStatistics& statistics)
+{
+  if (statistics.WeightSum() == 0.0)
+  {
+    throw std::invalid_argument("BayesianLinearRegression::Train(): "
+        "statistics do not hold any (weighted) points!");
+  }
+
+  Timer::Start("bayesian_linear_regression");
+
+  // Build phi * phi^T, phi * t^T and t * t^T of the processed data from the
+  // centered statistics, as CenterScaleData() would process the points.
+  const double n = statistics.WeightSum();
+  const arma::colvec& means = statistics.Means();
+  arma::mat gram = statistics.Scatter();
+  arma::colvec cross = statistics.CrossScatter();
+  double responsesSquares = statistics.ResponsesScatter();
+
+  if (centerData)
+  {
+    dataOffset = means;
+    responsesOffset = statistics.ResponsesMean();
+  }
+  else
+  {
+    dataOffset.clear();
+    responsesOffset = 0.0;
+    gram += n * means * means.t();
+    cross += n * statistics.ResponsesMean() * means;
+    responsesSquares += n * statistics.ResponsesMean() *
+        statistics.ResponsesMean();
+  }
+
+  if (scaleData)
+  {
+    dataScale = sqrt(statistics.Scatter().diag() / (n - 1));
+    gram /= dataScale * dataScale.t();
+    cross /= dataScale;
+  }
+  else
+  {
+    dataScale.clear();
+  }
+
+  arma::colvec eigVal;
+  arma::mat eigVec;
+  if (!arma::eig_sym(eigVal, eigVec, arma::symmatu(gram)))
+  {
+    Log::Fatal << "BayesianLinearRegression::Train(): Eigendecomposition "
+               << "of covariance failed!" << std::endl;
+  }
+
+  // The squared norm of the residual is expanded in terms of the statistics.
+  auto residual = [&](const arma::colvec& omega)
+  {
+    return std::max(responsesSquares - 2 * dot(omega, cross) +
+        arma::as_scalar(omega.t() * gram * omega), 0.0);
+  };
+
+  Optimize(eigVal, eigVec, cross, statistics.ResponsesScatter() / n, n,
+      residual);
+
+  Timer::Stop("bayesian_linear_regression");
+
+  return std::sqrt(residual(omega) / n);
+}
+
 void BayesianLinearRegression::Predict(const arma::mat& points,
                                        arma::rowvec& predictions) const
 {
@@ -16,6 +16,7 @@
 #define MLPACK_METHODS_BAYESIAN_LINEAR_REGRESSION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/methods/linear_regression/regression_statistics.hpp>
 
 namespace mlpack {
 namespace regression {
@@ -129,6 +130,18 @@ class BayesianLinearRegression
   double Train(const arma::mat& data,
                const arma::rowvec& responses);
 
+  /**
+   * Run BayesianLinearRegression on the points summarized by the given
+   * statistics, which can be accumulated in chunks (see RegressionStatistics).
+   * The centering and scaling of the data are taken from the statistics; if
+   * the statistics hold weighted points, the weights are treated as numbers of
+   * repetitions of the points.
+   *
+   * @param statistics Statistics of the training points.
+   * @return Root mean squared error.
+   */
+  double Train(const RegressionStatistics& statistics);
+
   /**
    * Predict \f$y_{i}\f$ for each data point in the given data matrix using the
    * currently-trained Bayesian Ridge model.
@@ -282,6 +295,28 @@ class BayesianLinearRegression
   //! Covariance matrix of the solution vector omega.
   arma::mat matCovariance;
 
+  /**
+   * Find the hyperparameters and the solution by maximizing the evidence,
+   * given the eigendecomposition of the (processed) design matrix times its
+   * transpose, phi * phi^T.
+   *
+   * @param eigVal Eigenvalues of phi * phi^T.
+   * @param eigVec Eigenvectors of phi * phi^T.
+   * @param cross The product phi * t^T of the design matrix and the processed
+   *     responses t.
+   * @param responsesVariance Variance of the processed responses.
+   * @param numPoints Number of training points.
+   * @param residual Function that returns the squared norm of the residual
+   *     t - omega^T * phi of a solution omega.
+   */
+  template<typename ResidualFunction>
+  void Optimize(const arma::colvec& eigVal,
+                const arma::mat& eigVec,
+                const arma::colvec& cross,
+                const double responsesVariance,
+                const double numPoints,
+                ResidualFunction residual);
+
   /**
    * Center and scale the data accordind to centerData and scaleData.
    * Allows future modifications of new points.
@@ -15,6 +15,7 @@
 
 #include "bias_svd_function.hpp"
 #include <mlpack/core/math/make_alias.hpp>
+#include <mlpack/methods/cf/rating_blocks.hpp>
 
 namespace mlpack {
 namespace svd {
@@ -267,17 +268,29 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
   double overallObjective = DBL_MAX;
   double lastObjective;
 
-  // The order in which the functions will be visited.
-  arma::Col<size_t> visitationOrder = arma::linspace<arma::Col<size_t>>(0,
-      (function.NumFunctions() - 1), function.NumFunctions());
-
-  const arma::mat data = function.Dataset();
   const size_t numUsers = function.NumUsers();
   const double lambda = function.Lambda();
 
   // Rank of decomposition.
   const size_t rank = function.Rank();
 
+  // Partition the ratings into a grid of blocks, one row and one column of
+  // blocks per thread.  The threads process the blocks of one stratum at a
+  // time; these share no user or item, so no synchronization is needed and
+  // no parameter column is written by two threads.
+  #ifdef HAS_OPENMP
+    const size_t numBlocks = omp_get_max_threads();
+  #else
+    const size_t numBlocks = 1;
+  #endif
+  const mlpack::cf::RatingBlocks blocks(function.Dataset(), numUsers,
+      function.NumItems(), numBlocks);
+  const arma::mat& data = blocks.Ratings();
+
+  // The order in which the strata will be visited.
+  std::vector<size_t> strata(numBlocks);
+  std::iota(strata.begin(), strata.end(), 0);
+
   // Iterate till the objective is within tolerance or the maximum number of
   // allowed iterations is reached. If maxIterations is 0, this will iterate
   // till convergence.
@@ -316,58 +329,44 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
     double stepSize = decayPolicy.StepSize(i);
 
     if (shuffle) // Determine order of visitation.
-      std::shuffle(visitationOrder.begin(), visitationOrder.end(),
-          mlpack::math::randGen);
+      std::shuffle(strata.begin(), strata.end(), mlpack::math::RandGen());
 
-    #pragma omp parallel
+    for (size_t s = 0; s < numBlocks; ++s)
     {
-      // Each processor gets a subset of the instances.
-      // Each subset is of size threadShareSize.
-      size_t threadId = 0;
-      #ifdef HAS_OPENMP
-        threadId = omp_get_thread_num();
-      #endif
-
-      for (size_t j = threadId * threadShareSize;
-          j < (threadId + 1) * threadShareSize && j < visitationOrder.n_elem;
-          ++j)
+      #pragma omp parallel for
+      for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
       {
-        // Indices for accessing the the correct parameter columns.
-        const size_t user = data(0, visitationOrder[j]);
-        const size_t item = data(1, visitationOrder[j]) + numUsers;
-
-        // Prediction error for the example.
-        const double rating = data(2, visitationOrder[j]);
-        const double userBias = iterate(rank, user);
-        const double itemBias = iterate(rank, item);
-        double ratingError = rating - userBias - itemBias -
-            arma::dot(iterate.col(user).subvec(0, rank - 1),
-                      iterate.col(item).subvec(0, rank - 1));
-
-        arma::mat userVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(user).subvec(0, rank - 1) -
-            ratingError * iterate.col(item).subvec(0, rank - 1));
-        arma::mat itemVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(item).subvec(0, rank - 1) -
-            ratingError * iterate.col(user).subvec(0, rank - 1));
-        double userBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, user) - ratingError);
-        double itemBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, item) - ratingError);
-
-        // Gradient is non-zero only for the parameter columns corresponding to
-        // the example.
-        for (size_t i = 0; i < rank; ++i)
+        const size_t itemBlock = (b + strata[s]) % numBlocks;
+        for (size_t j = blocks.BlockBegin(b, itemBlock);
+            j < blocks.BlockEnd(b, itemBlock); ++j)
         {
-          #pragma omp atomic
-          iterate(i, user) -= userVecUpdate(i);
-          #pragma omp atomic
-          iterate(i, item) -= itemVecUpdate(i);
+          // Indices for accessing the the correct parameter columns.
+          const size_t user = data(0, j);
+          const size_t item = data(1, j) + numUsers;
+
+          // Prediction error for the example.
+          const double rating = data(2, j);
+          const double userBias = iterate(rank, user);
+          const double itemBias = iterate(rank, item);
+          double ratingError = rating - userBias - itemBias -
+              arma::dot(iterate.col(user).subvec(0, rank - 1),
+                        iterate.col(item).subvec(0, rank - 1));
+
+          const arma::vec userVec = iterate.col(user).subvec(0, rank - 1);
+
+          // Gradient is non-zero only for the parameter columns corresponding
+          // to the example.
+          iterate.col(user).subvec(0, rank - 1) -= stepSize * 2 * (
+              lambda * userVec -
+              ratingError * iterate.col(item).subvec(0, rank - 1));
+          iterate.col(item).subvec(0, rank - 1) -= stepSize * 2 * (
+              lambda * iterate.col(item).subvec(0, rank - 1) -
+              ratingError * userVec);
+          iterate(rank, user) -= stepSize * 2 * (
+              lambda * userBias - ratingError);
+          iterate(rank, item) -= stepSize * 2 * (
+              lambda * itemBias - ratingError);
         }
-        #pragma omp atomic
-        iterate(rank, user) -= userBiasUpdate;
-        #pragma omp atomic
-        iterate(rank, item) -= itemBiasUpdate;
       }
     }
   }
@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_BLOCK_KRYLOV_SVD_RANDOMIZED_BLOCK_KRYLOV_SVD_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/methods/randomized_svd/randomized_svd_utils.hpp>
 
 namespace mlpack {
 namespace svd {
@@ -69,6 +70,8 @@ class RandomizedBlockKrylovSVD
    *        (Default: 2).
    * @param rank Rank of the approximation (Default: number of rows.)
    * @param blockSize The block size, must be >= rank (Default: rank + 10).
+   * @param orthogonalization Strategy used to orthogonalize the Krylov
+   *        blocks.
    */
   RandomizedBlockKrylovSVD(const arma::mat& data,
                            arma::mat& u,
@@ -76,7 +79,9 @@ class RandomizedBlockKrylovSVD
                            arma::mat& v,
                            const size_t maxIterations = 2,
                            const size_t rank = 0,
-                           const size_t blockSize = 0);
+                           const size_t blockSize = 0,
+                           const OrthogonalizationType orthogonalization =
+                               QR_ORTHOGONALIZATION);
 
   /**
    * Create object for the randomized block krylov SVD method.
@@ -84,13 +89,20 @@ class RandomizedBlockKrylovSVD
    * @param maxIterations Number of iterations for the power method
    *        (Default: 2).
    * @param blockSize The block size, must be >= rank (Default: rank + 10).
+   * @param orthogonalization Strategy used to orthogonalize the Krylov
+   *        blocks.
    */
   RandomizedBlockKrylovSVD(const size_t maxIterations = 2,
-                           const size_t blockSize = 0);
+                           const size_t blockSize = 0,
+                           const OrthogonalizationType orthogonalization =
+                               QR_ORTHOGONALIZATION);
 
   /**
    * Apply Principal Component Analysis to the provided data set using the
-   * randomized block krylov SVD.
+   * randomized block krylov SVD.  The data may be dense or sparse, in single
+   * or double precision (arma::mat, arma::fmat, arma::sp_mat or
+   * arma::sp_fmat); the products of sparse data with the dense blocks are
+   * multithreaded when OpenMP is available.
    *
    * @param data Data matrix.
    * @param u First unitary matrix.
@@ -98,10 +110,11 @@ class RandomizedBlockKrylovSVD
    * @param s Diagonal matrix of singular values.
    * @param rank Rank of the approximation.
    */
-  void Apply(const arma::mat& data,
-             arma::mat& u,
-             arma::vec& s,
-             arma::mat& v,
+  template<typename MatType>
+  void Apply(const MatType& data,
+             arma::Mat<typename MatType::elem_type>& u,
+             arma::Col<typename MatType::elem_type>& s,
+             arma::Mat<typename MatType::elem_type>& v,
              const size_t rank);
 
   //! Get the number of iterations for the power method.
@@ -114,15 +127,26 @@ class RandomizedBlockKrylovSVD
   //! Modify the block size.
   size_t& BlockSize() { return blockSize; }
 
+  //! Get the orthogonalization strategy.
+  OrthogonalizationType Orthogonalization() const { return orthogonalization; }
+  //! Modify the orthogonalization strategy.
+  OrthogonalizationType& Orthogonalization() { return orthogonalization; }
+
  private:
   //! Locally stored number of iterations for the power method.
   size_t maxIterations;
 
   //! The block size value.
   size_t blockSize;
+
+  //! The strategy used to orthogonalize the Krylov blocks.
+  OrthogonalizationType orthogonalization;
 };
 
 } // namespace svd
 } // namespace mlpack
 
+// Include implementation.
+#include "randomized_block_krylov_svd_impl.hpp"
+
 #endif
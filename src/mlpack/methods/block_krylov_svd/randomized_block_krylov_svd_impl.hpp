@@ -0,0 +1,76 @@
+/**
+ * @file methods/block_krylov_svd/randomized_block_krylov_svd_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the randomized block krylov SVD method.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_BLOCK_KRYLOV_SVD_RANDOMIZED_BLOCK_KRYLOV_SVD_IMPL_HPP
+#define MLPACK_METHODS_BLOCK_KRYLOV_SVD_RANDOMIZED_BLOCK_KRYLOV_SVD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "randomized_block_krylov_svd.hpp"
+
+namespace mlpack {
+namespace svd {
+
+template<typename MatType>
+void RandomizedBlockKrylovSVD::Apply(
+    const MatType& data,
+    arma::Mat<typename MatType::elem_type>& u,
+    arma::Col<typename MatType::elem_type>& s,
+    arma::Mat<typename MatType::elem_type>& v,
+    const size_t rank)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  arma::Mat<ElemType> block, product;
+
+  if (blockSize == 0)
+  {
+    blockSize = rank + 10;
+  }
+
+  // Random block initialization.
+  arma::Mat<ElemType> G = arma::randn<arma::Mat<ElemType>>(data.n_cols,
+      blockSize);
+
+  // Construct and orthonormalize Krylov subspace.  (If there are fewer rows
+  // than the block size, the blocks are narrower and the remaining columns of
+  // K stay zero.)
+  arma::Mat<ElemType> K(data.n_rows, blockSize * (maxIterations + 1),
+      arma::fill::zeros);
+
+  BlockTimes(data, G, block);
+  OrthogonalizeBlock(block, orthogonalization, false);
+  K.cols(0, block.n_cols - 1) = block;
+
+  for (size_t i = 1; i <= maxIterations; ++i)
+  {
+    BlockTransTimes(data, block, product);
+    BlockTimes(data, product, block);
+    OrthogonalizeBlock(block, orthogonalization, false);
+
+    K.cols(i * blockSize, i * blockSize + block.n_cols - 1) = block;
+  }
+
+  OrthogonalizeBlock(K, orthogonalization, true);
+
+  // Approximate eigenvalues and eigenvectors using Rayleigh-Ritz method.
+  BlockTransTimes(data, K, product);
+  arma::svd_econ(u, s, v, arma::Mat<ElemType>(product.t()));
+
+  // Do economical singular value decomposition and compute only the
+  // approximations of the left singular vectors by using the centered data
+  // applied to Q.
+  u = K * u;
+}
+
+} // namespace svd
+} // namespace mlpack
+
+#endif
@@ -143,6 +143,40 @@ class CFType
              const double minResidue = 1e-5,
              const bool mit = false);
 
+  /**
+   * Add a new user to the trained model without retraining it.  The ratings
+   * are normalized with the trained normalization, and the latent vector of
+   * the user is found from them by a regularized least squares solution with
+   * the item factors held fixed.  The new user gets the next user ID, and is
+   * immediately available to Predict() and GetRecommendations(), both as a
+   * query user and as a neighbor of other users.
+   *
+   * @param items Items rated by the new user; each item may appear only once.
+   * @param ratings Ratings of the new user.
+   * @param lambda Regularization parameter of the least squares solution; the
+   *     penalty is scaled by the number of ratings.
+   * @return ID of the new user.
+   */
+  size_t FoldInUser(const arma::Col<size_t>& items,
+                    const arma::vec& ratings,
+                    const double lambda = 0.05);
+
+  /**
+   * Add a new item to the trained model without retraining it.  The latent
+   * vector of the item is found from its normalized ratings with the user
+   * factors held fixed.  The new item gets the next item ID.
+   *
+   * @param users Users that rated the new item; each user may appear only
+   *     once.
+   * @param ratings Ratings of the new item.
+   * @param lambda Regularization parameter of the least squares solution; the
+   *     penalty is scaled by the number of ratings.
+   * @return ID of the new item.
+   */
+  size_t FoldInItem(const arma::Col<size_t>& users,
+                    const arma::vec& ratings,
+                    const double lambda = 0.05);
+
   //! Sets number of users for calculating similarity.
   void NumUsersForSimilarity(const size_t num)
   {
@@ -200,6 +234,8 @@ class CFType
 
   /**
    * Generates the given number of recommendations for the specified users.
+   * The ratings of the neighbors of each block of users are computed with a
+   * single matrix multiplication, and the blocks are handled in parallel.
    *
    * @tparam NeighborSearchPolicy The policy used to search neighbors of
    *     query set in referece set.
@@ -209,12 +245,15 @@ class CFType
    * @param numRecs Number of Recommendations.
    * @param recommendations Matrix to save recommendations.
    * @param users Users for which recommendations are to be generated.
+   * @param blockSize Number of neighbor rating vectors computed by each matrix
+   *     multiplication; larger blocks are faster but use more memory.
    */
   template<typename NeighborSearchPolicy = EuclideanSearch,
            typename InterpolationPolicy = AverageInterpolation>
   void GetRecommendations(const size_t numRecs,
                           arma::Mat<size_t>& recommendations,
-                          const arma::Col<size_t>& users);
+                          const arma::Col<size_t>& users,
+                          const size_t blockSize = 128);
 
   //! Converts the User, Item, Value Matrix to User-Item Table.
   static void CleanData(const arma::mat& data, arma::sp_mat& cleanedData);
@@ -154,6 +154,88 @@ Train(const arma::sp_mat& data,
   Timer::Stop("cf_factorization");
 }
 
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+size_t CFType<DecompositionPolicy,
+              NormalizationType>::
+FoldInUser(const arma::Col<size_t>& items,
+           const arma::vec& ratings,
+           const double lambda)
+{
+  if (items.n_elem != ratings.n_elem)
+  {
+    std::stringstream ss;
+    ss << "CFType::FoldInUser(): the number of items (" << items.n_elem
+        << ") must be equal to the number of ratings (" << ratings.n_elem
+        << ")!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  if (items.n_elem > 0 && arma::max(items) >= cleanedData.n_rows)
+  {
+    std::stringstream ss;
+    ss << "CFType::FoldInUser(): item " << arma::max(items) << " is not in "
+        << "the model (" << cleanedData.n_rows << " items)!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  const size_t user = cleanedData.n_cols;
+  arma::vec normalizedRatings(ratings);
+  normalization.NormalizeNewUser(user, items, normalizedRatings);
+  decomposition.FoldInUser(items, normalizedRatings, lambda);
+
+  // Append the ratings of the new user to the rating matrix.
+  arma::umat locations(2, items.n_elem);
+  locations.row(0) = arma::conv_to<arma::urowvec>::from(items);
+  locations.row(1).zeros();
+  const arma::sp_mat userRatings(locations, normalizedRatings,
+      cleanedData.n_rows, 1);
+  cleanedData = arma::join_rows(cleanedData, userRatings);
+
+  return user;
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+size_t CFType<DecompositionPolicy,
+              NormalizationType>::
+FoldInItem(const arma::Col<size_t>& users,
+           const arma::vec& ratings,
+           const double lambda)
+{
+  if (users.n_elem != ratings.n_elem)
+  {
+    std::stringstream ss;
+    ss << "CFType::FoldInItem(): the number of users (" << users.n_elem
+        << ") must be equal to the number of ratings (" << ratings.n_elem
+        << ")!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  if (users.n_elem > 0 && arma::max(users) >= cleanedData.n_cols)
+  {
+    std::stringstream ss;
+    ss << "CFType::FoldInItem(): user " << arma::max(users) << " is not in "
+        << "the model (" << cleanedData.n_cols << " users)!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  const size_t item = cleanedData.n_rows;
+  arma::vec normalizedRatings(ratings);
+  normalization.NormalizeNewItem(item, users, normalizedRatings);
+  decomposition.FoldInItem(users, normalizedRatings, lambda);
+
+  // Append the ratings of the new item to the rating matrix.
+  arma::umat locations(2, users.n_elem);
+  locations.row(0).zeros();
+  locations.row(1) = arma::conv_to<arma::urowvec>::from(users);
+  const arma::sp_mat itemRatings(locations, normalizedRatings, 1,
+      cleanedData.n_cols);
+  cleanedData = arma::join_cols(cleanedData, itemRatings);
+
+  return item;
+}
+
 template<typename DecompositionPolicy,
          typename NormalizationType>
 template<typename NeighborSearchPolicy,
@@ -183,7 +265,8 @@ void CFType<DecompositionPolicy,
             NormalizationType>::
 GetRecommendations(const size_t numRecs,
                    arma::Mat<size_t>& recommendations,
-                   const arma::Col<size_t>& users)
+                   const arma::Col<size_t>& users,
+                   const size_t blockSize)
 {
   // Temporary storage for neighborhood of the queried users.
   arma::Mat<size_t> neighborhood;
@@ -194,79 +277,119 @@ GetRecommendations(const size_t numRecs,
   // is part of the neighborhood---this is intentional.  We want to use the
   // weighted sum of both the query user and the local neighborhood of the
   // query user.
-  // Calculate the neighborhood of the queried users.
   decomposition.template GetNeighborhood<NeighborSearchPolicy>(
       users, numUsersForSimilarity, neighborhood, similarities);
 
-  // Generate recommendations for each query user by finding the maximum numRecs
-  // elements in the ratings vector.
-  recommendations.set_size(numRecs, users.n_elem);
-  arma::mat values(numRecs, users.n_elem);
-  recommendations.fill(SIZE_MAX);
-  values.fill(DBL_MAX);
-
   // Initialization of an InterpolationPolicy object should be put ahead of the
   // following loop, because the initialization may takes a relatively long
   // time and we don't want to repeat the initialization process in each loop.
+  // The interpolation policies may cache intermediate results, so the weights
+  // are computed serially.
   InterpolationPolicy interpolation(cleanedData);
-
+  const size_t numNeighbors = neighborhood.n_rows;
+  arma::mat weights(numNeighbors, users.n_elem);
   for (size_t i = 0; i < users.n_elem; ++i)
   {
-    // First, calculate the weighted sum of neighborhood values.
-    arma::vec ratings;
-    ratings.zeros(cleanedData.n_rows);
-
-    // Calculate interpolation weights.
-    arma::vec weights(numUsersForSimilarity);
-    interpolation.GetWeights(weights, decomposition, users(i),
+    interpolation.GetWeights(weights.col(i), decomposition, users(i),
         neighborhood.col(i), similarities.col(i), cleanedData);
+  }
 
-    for (size_t j = 0; j < neighborhood.n_rows; ++j)
+  // Generate recommendations for each query user by finding the maximum numRecs
+  // elements in the ratings vector.  If there are not enough un-rated items,
+  // the remaining recommendations are set to an invalid item number.
+  const size_t numItems = cleanedData.n_rows;
+  recommendations.set_size(numRecs, users.n_elem);
+  recommendations.fill(numItems);
+  arma::Col<size_t> numFound(users.n_elem);
+
+  // The ratings of the neighbors of a block of users are computed with a single
+  // matrix multiplication, and the blocks are handled in parallel.
+  const size_t usersPerBlock = std::max(blockSize /
+      std::max(numNeighbors, (size_t) 1), (size_t) 1);
+  const size_t numBlocks = (users.n_elem + usersPerBlock - 1) / usersPerBlock;
+  const arma::sp_mat& data = cleanedData;
+  data.sync();
+
+  #pragma omp parallel
+  {
+    // The candidates of the current user, kept as a heap whose front is the
+    // worst candidate.
+    std::vector<Candidate> candidates;
+    candidates.reserve(numRecs);
+    // Marks the items rated by the current user.
+    std::vector<char> rated(numItems, 0);
+    arma::Col<size_t> blockNeighbors;
+    arma::mat neighborRatings;
+    arma::vec ratings;
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
     {
-      arma::vec neighborRatings;
-      decomposition.GetRatingOfUser(neighborhood(j, i), neighborRatings);
-      ratings += weights(j) * neighborRatings;
-    }
+      const size_t begin = b * usersPerBlock;
+      const size_t end = std::min(begin + usersPerBlock, (size_t) users.n_elem);
 
-    // Let's build the list of candidate recomendations for the given user.
-    // Default candidate: the smallest possible value and invalid item number.
-    const Candidate def = std::make_pair(-DBL_MAX, cleanedData.n_rows);
-    std::vector<Candidate> vect(numRecs, def);
-    typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
-        CandidateList;
-    CandidateList pqueue(CandidateCmp(), std::move(vect));
+      blockNeighbors = arma::vectorise(neighborhood.cols(begin, end - 1));
+      decomposition.GetRatingOfUsers(blockNeighbors, neighborRatings);
 
-    // Look through the ratings column corresponding to the current user.
-    for (size_t j = 0; j < ratings.n_rows; ++j)
-    {
-      // Ensure that the user hasn't already rated the item.
-      // The algorithm omits rating of zero. Thus, when normalizing original
-      // ratings in Normalize(), if normalized rating equals zero, it is set
-      // to the smallest positive double value.
-      if (cleanedData(j, users(i)) != 0.0)
-        continue; // The user already rated the item.
-
-      // Is the estimated value better than the worst candidate?
-      // Denormalize rating before comparison.
-      double realRating = normalization.Denormalize(users(i), j, ratings[j]);
-      if (realRating > pqueue.top().first)
+      for (size_t i = begin; i < end; ++i)
       {
-        Candidate c = std::make_pair(realRating, j);
-        pqueue.pop();
-        pqueue.push(c);
+        // First, calculate the weighted sum of neighborhood values.
+        const size_t first = (i - begin) * numNeighbors;
+        ratings = neighborRatings.cols(first, first + numNeighbors - 1) *
+            weights.col(i);
+
+        // The algorithm omits rating of zero. Thus, when normalizing original
+        // ratings in Normalize(), if normalized rating equals zero, it is set
+        // to the smallest positive double value.  So the nonzero entries of
+        // the user's column are exactly the items the user already rated.
+        const size_t user = users(i);
+        arma::sp_mat::const_iterator it = data.begin_col(user);
+        for (; it != data.end_col(user); ++it)
+          rated[it.row()] = 1;
+
+        candidates.clear();
+        for (size_t j = 0; j < numItems; ++j)
+        {
+          if (rated[j])
+            continue; // The user already rated the item.
+
+          // Is the estimated value better than the worst candidate?
+          // Denormalize rating before comparison.
+          const double realRating = normalization.Denormalize(user, j,
+              ratings[j]);
+          if (candidates.size() < numRecs)
+          {
+            candidates.push_back(std::make_pair(realRating, j));
+            std::push_heap(candidates.begin(), candidates.end(),
+                CandidateCmp());
+          }
+          else if (realRating > candidates.front().first)
+          {
+            std::pop_heap(candidates.begin(), candidates.end(),
+                CandidateCmp());
+            candidates.back() = std::make_pair(realRating, j);
+            std::push_heap(candidates.begin(), candidates.end(),
+                CandidateCmp());
+          }
+        }
+
+        for (it = data.begin_col(user); it != data.end_col(user); ++it)
+          rated[it.row()] = 0;
+
+        // Sort the candidates from best to worst.
+        std::sort_heap(candidates.begin(), candidates.end(), CandidateCmp());
+        for (size_t p = 0; p < candidates.size(); ++p)
+          recommendations(p, i) = candidates[p].second;
+        numFound[i] = candidates.size();
       }
     }
+  }
 
-    for (size_t p = 1; p <= numRecs; p++)
-    {
-      recommendations(numRecs - p, i) = pqueue.top().second;
-      values(numRecs - p, i) = pqueue.top().first;
-      pqueue.pop();
-    }
-
-    // If we were not able to come up with enough recommendations, issue a
-    // warning.
-    if (recommendations(numRecs - 1, i) == def.second)
+  // If we were not able to come up with enough recommendations, issue a
+  // warning.
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    if (numFound[i] < numRecs)
       Log::Warn << "Could not provide " << numRecs << " recommendations "
           << "for user " << users(i) << " (not enough un-rated items)!"
           << std::endl;
@@ -353,7 +476,8 @@ Predict(const arma::Mat<size_t>& combinations,
 
   arma::mat weights(numUsersForSimilarity, users.n_elem);
 
-  // Calculate interpolation weights.
+  // Calculate interpolation weights.  The interpolation policies may cache
+  // intermediate results, so the weights are computed serially.
   InterpolationPolicy interpolation(cleanedData);
   for (size_t i = 0; i < users.n_elem; ++i)
   {
@@ -361,27 +485,42 @@ Predict(const arma::Mat<size_t>& combinations,
         neighborhood.col(i), similarities.col(i), cleanedData);
   }
 
+  // Find the range of sorted combinations of each user.
+  arma::Col<size_t> userBegins(users.n_elem + 1);
+  for (size_t i = 0, user = 0; user < users.n_elem; ++user)
+  {
+    userBegins[user] = i;
+    while (i < sortedCombinations.n_cols && sortedCombinations(0, i) ==
+        users[user])
+      ++i;
+  }
+  userBegins[users.n_elem] = sortedCombinations.n_cols;
+
   // Now that we have the neighborhoods we need, calculate the predictions.
+  // The ratings of the neighbors of a user for all the items it is queried
+  // with are computed with a single matrix multiplication, and the weighted
+  // sum of them is a matrix-vector product; users are handled in parallel.
   predictions.set_size(combinations.n_cols);
 
-  size_t user = 0; // Cumulative user count, because we are doing it in order.
-  for (size_t i = 0; i < sortedCombinations.n_cols; ++i)
+  #pragma omp parallel
   {
-    // Could this be made faster by calculating dot products for multiple items
-    // at once?
-    double rating = 0.0;
-
-    // Map the combination's user to the user ID used for kNN.
-    while (users[user] < sortedCombinations(0, i))
-      ++user;
+    arma::Col<size_t> neighbors, items;
+    arma::mat neighborRatings;
 
-    for (size_t j = 0; j < neighborhood.n_rows; ++j)
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t user = 0; user < (omp_size_t) users.n_elem; ++user)
     {
-      rating += weights(j, user) * decomposition.GetRating(
-          neighborhood(j, user), sortedCombinations(1, i));
-    }
+      const size_t begin = userBegins[user];
+      const size_t end = userBegins[user + 1];
+
+      neighbors = neighborhood.col(user);
+      items = sortedCombinations.submat(1, begin, 1, end - 1).t();
+      decomposition.GetRatingOfUsers(neighbors, items, neighborRatings);
 
-    predictions(ordering[i]) = rating;
+      const arma::vec ratings = neighborRatings * weights.col(user);
+      for (size_t i = begin; i < end; ++i)
+        predictions(ordering[i]) = ratings[i - begin];
+    }
   }
 
   // Denormalize ratings.
@@ -24,6 +24,7 @@
 #include <mlpack/methods/cf/decomposition_policies/svd_incomplete_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/bias_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/svdplusplus_method.hpp>
+#include <mlpack/methods/cf/decomposition_policies/als_method.hpp>
 
 #include <mlpack/methods/cf/interpolation_policies/average_interpolation.hpp>
 #include <mlpack/methods/cf/interpolation_policies/regression_interpolation.hpp>
@@ -90,6 +91,8 @@ BINDING_LONG_DESC(
     " - 'SVDCompleteIncremental' -- SVD complete incremental learning\n"
     " - 'BiasSVD' -- Bias SVD using a SGD optimizer\n"
     " - 'SVDPP' -- SVD++ using a SGD optimizer\n"
+    " - 'ALS' -- Alternating least squares on the observed ratings, solved in "
+    "parallel\n"
     "\n\n"
     "The following neighbor search algorithms can be specified via" +
     " the " + PRINT_PARAM_STRING("neighbor_search") + " parameter:"
@@ -215,7 +218,7 @@ static void mlpackMain()
 
   RequireParamInSet<string>("algorithm", { "NMF", "BatchSVD",
       "SVDIncompleteIncremental", "SVDCompleteIncremental", "RegSVD",
-      "RandSVD", "BiasSVD", "SVDPP" }, true, "unknown algorithm");
+      "RandSVD", "BiasSVD", "SVDPP", "ALS" }, true, "unknown algorithm");
 
   ReportIgnoredParam({{ "iteration_only_termination", true }}, "min_residue");
 
@@ -297,6 +300,12 @@ static void mlpackMain()
           "when max_iterations is reached");
       cf->DecompositionType() = CFModel::SVD_PLUS_PLUS;
     }
+    else if (algo == "ALS")
+    {
+      ReportIgnoredParam("min_residue", "ALS terminates only when "
+          "max_iterations is reached");
+      cf->DecompositionType() = CFModel::ALS;
+    }
 
     // Perform the factorization and do whatever the user wanted.
     const size_t neighborhood = (size_t) IO::GetParam<int>("neighborhood");
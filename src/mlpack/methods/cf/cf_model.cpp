@@ -171,6 +171,11 @@ void CFModel::Train(const arma::mat& data,
       cf = TrainHelper(SVDPlusPlusPolicy(), normalizationType, data,
           numUsersForSimilarity, rank, maxIterations, minResidue, mit);
       break;
+
+    case ALS:
+      cf = TrainHelper(ALSPolicy(), normalizationType, data,
+          numUsersForSimilarity, rank, maxIterations, minResidue, mit);
+      break;
   }
 }
 
@@ -203,5 +208,21 @@ void CFModel::GetRecommendations(const NeighborSearchTypes nsType,
   cf->GetRecommendations(nsType, interpolationType, numRecs, recommendations);
 }
 
+//! Add a new user to the model.
+size_t CFModel::FoldInUser(const arma::Col<size_t>& items,
+                           const arma::vec& ratings,
+                           const double lambda)
+{
+  return cf->FoldInUser(items, ratings, lambda);
+}
+
+//! Add a new item to the model.
+size_t CFModel::FoldInItem(const arma::Col<size_t>& users,
+                           const arma::vec& ratings,
+                           const double lambda)
+{
+  return cf->FoldInItem(users, ratings, lambda);
+}
+
 } // namespace cf
 } // namespace mlpack
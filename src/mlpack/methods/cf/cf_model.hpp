@@ -78,6 +78,16 @@ class CFWrapperBase
       const size_t numRecs,
       arma::Mat<size_t>& recommendations,
       const arma::Col<size_t>& users) = 0;
+
+  //! Add a new user to the model; returns the ID of the user.
+  virtual size_t FoldInUser(const arma::Col<size_t>& items,
+                            const arma::vec& ratings,
+                            const double lambda) = 0;
+
+  //! Add a new item to the model; returns the ID of the item.
+  virtual size_t FoldInItem(const arma::Col<size_t>& users,
+                            const arma::vec& ratings,
+                            const double lambda) = 0;
 };
 
 /**
@@ -144,6 +154,22 @@ class CFWrapper : public CFWrapperBase
       arma::Mat<size_t>& recommendations,
       const arma::Col<size_t>& users);
 
+  //! Add a new user to the model; returns the ID of the user.
+  virtual size_t FoldInUser(const arma::Col<size_t>& items,
+                            const arma::vec& ratings,
+                            const double lambda)
+  {
+    return cf.FoldInUser(items, ratings, lambda);
+  }
+
+  //! Add a new item to the model; returns the ID of the item.
+  virtual size_t FoldInItem(const arma::Col<size_t>& users,
+                            const arma::vec& ratings,
+                            const double lambda)
+  {
+    return cf.FoldInItem(users, ratings, lambda);
+  }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
@@ -171,7 +197,8 @@ class CFModel
     SVD_COMPLETE,
     SVD_INCOMPLETE,
     BIAS_SVD,
-    SVD_PLUS_PLUS
+    SVD_PLUS_PLUS,
+    ALS
   };
 
   enum NormalizationTypes
@@ -267,6 +294,32 @@ class CFModel
                           const size_t numRecs,
                           arma::Mat<size_t>& recommendations);
 
+  /**
+   * Add a new user to the trained model without retraining it; see
+   * CFType::FoldInUser().
+   *
+   * @param items Items rated by the new user.
+   * @param ratings Ratings of the new user.
+   * @param lambda Regularization parameter of the least squares solution.
+   * @return ID of the new user.
+   */
+  size_t FoldInUser(const arma::Col<size_t>& items,
+                    const arma::vec& ratings,
+                    const double lambda = 0.05);
+
+  /**
+   * Add a new item to the trained model without retraining it; see
+   * CFType::FoldInItem().
+   *
+   * @param users Users that rated the new item.
+   * @param ratings Ratings of the new item.
+   * @param lambda Regularization parameter of the least squares solution.
+   * @return ID of the new item.
+   */
+  size_t FoldInItem(const arma::Col<size_t>& users,
+                    const arma::vec& ratings,
+                    const double lambda = 0.05);
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -30,6 +30,7 @@
 #include "decomposition_policies/svd_complete_method.hpp"
 #include "decomposition_policies/svd_incomplete_method.hpp"
 #include "decomposition_policies/svdplusplus_method.hpp"
+#include "decomposition_policies/als_method.hpp"
 
 #include "normalization/no_normalization.hpp"
 #include "normalization/overall_mean_normalization.hpp"
@@ -261,6 +262,9 @@ inline CFWrapperBase* InitializeModel(
 
     case CFModel::SVD_PLUS_PLUS:
       return InitializeModelHelper<SVDPlusPlusPolicy>(normalizationType);
+
+    case CFModel::ALS:
+      return InitializeModelHelper<ALSPolicy>(normalizationType);
   }
 
   // This shouldn't ever happen.
@@ -368,6 +372,10 @@ void CFModel::serialize(Archive& ar, const uint32_t /* version */)
     case SVD_PLUS_PLUS:
       SerializeHelper<SVDPlusPlusPolicy>(ar, cf, normalizationType);
       break;
+
+    case ALS:
+      SerializeHelper<ALSPolicy>(ar, cf, normalizationType);
+      break;
   }
 }
 
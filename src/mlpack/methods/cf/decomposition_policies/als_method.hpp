@@ -0,0 +1,258 @@
+/**
+ * @file methods/cf/decomposition_policies/als_method.hpp
+ *
+ * Implementation of the parallel alternating least squares method for use in
+ * Collaborative Filtering.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_ALS_METHOD_HPP
+#define MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_ALS_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/amf/amf.hpp>
+#include <mlpack/methods/amf/update_rules/parallel_als.hpp>
+#include <mlpack/methods/amf/termination_policies/max_iteration_termination.hpp>
+#include <mlpack/methods/cf/decomposition_policies/fold_in.hpp>
+
+namespace mlpack {
+namespace cf {
+
+/**
+ * Implementation of the ALS policy to act as a wrapper when accessing
+ * weighted-lambda-regularized alternating least squares
+ * (amf::ParallelALSUpdate) from within CFType.  Only the observed ratings are
+ * fit, and the least squares problems of the users and items are solved in
+ * parallel, reading the ratings directly from the sparse item-user matrix, so
+ * this scales to large, very sparse rating matrices.
+ *
+ * An example of how to use ALSPolicy in CF is shown below:
+ *
+ * @code
+ * extern arma::mat data; // data is a (user, item, rating) table.
+ * // Users for whom recommendations are generated.
+ * extern arma::Col<size_t> users;
+ * arma::Mat<size_t> recommendations; // Resulting recommendations.
+ *
+ * CFType<ALSPolicy> cf(data);
+ *
+ * // Generate 10 recommendations for all users.
+ * cf.GetRecommendations(10, recommendations);
+ * @endcode
+ */
+class ALSPolicy
+{
+ public:
+  /**
+   * Use alternating least squares to perform collaborative filtering.
+   *
+   * @param lambda Regularization parameter.
+   */
+  ALSPolicy(const double lambda = 0.05) :
+      lambda(lambda)
+  {
+    /* Nothing to do here */
+  }
+
+  /**
+   * Apply Collaborative Filtering to the provided data set using alternating
+   * least squares.  Each iteration updates the item and the user matrices
+   * once; iteration stops when maxIterations is reached.
+   *
+   * @param * (data) Data matrix: dense matrix (coordinate lists)
+   *    or sparse matrix(cleaned).
+   * @param cleanedData item user table in form of sparse matrix.
+   * @param rank Rank parameter for matrix factorization.
+   * @param maxIterations Maximum number of iterations.
+   * @param * (minResidue) Residue required to terminate.
+   * @param * (mit) Whether to terminate only when maxIterations is reached.
+   */
+  template<typename MatType>
+  void Apply(const MatType& /* data */,
+             const arma::sp_mat& cleanedData,
+             const size_t rank,
+             const size_t maxIterations,
+             const double /* minResidue */,
+             const bool /* mit */)
+  {
+    // The residue-based termination policies compute the dense product W * H,
+    // which is exactly what this policy avoids, so only the number of
+    // iterations is used.
+    amf::MaxIterationTermination iter(maxIterations);
+    amf::AMF<amf::MaxIterationTermination, amf::RandomInitialization,
+        amf::ParallelALSUpdate> als(iter, amf::RandomInitialization(),
+        amf::ParallelALSUpdate(lambda));
+    als.Apply(cleanedData, rank, w, h);
+  }
+
+  /**
+   * Return predicted rating given user ID and item ID.
+   *
+   * @param user User ID.
+   * @param item Item ID.
+   */
+  double GetRating(const size_t user, const size_t item) const
+  {
+    double rating = arma::as_scalar(w.row(item) * h.col(user));
+    return rating;
+  }
+
+  /**
+   * Get predicted ratings for a user.
+   *
+   * @param user User ID.
+   * @param rating Resulting rating vector.
+   */
+  void GetRatingOfUser(const size_t user, arma::vec& rating) const
+  {
+    rating = w * h.col(user);
+  }
+
+  /**
+   * Get predicted ratings for several users with a single matrix
+   * multiplication.
+   *
+   * @param users User IDs.
+   * @param ratings Resulting ratings, with one column for each user.
+   */
+  void GetRatingOfUsers(const arma::Col<size_t>& users,
+                        arma::mat& ratings) const
+  {
+    arma::mat userVecs(h.n_rows, users.n_elem);
+    for (size_t i = 0; i < users.n_elem; ++i)
+      userVecs.col(i) = h.col(users(i));
+
+    ratings = w * userVecs;
+  }
+
+  /**
+   * Get predicted ratings of the given items for several users with a single
+   * matrix multiplication.
+   *
+   * @param users User IDs.
+   * @param items Item IDs.
+   * @param ratings Resulting ratings, with one row for each item and one column
+   *     for each user.
+   */
+  void GetRatingOfUsers(const arma::Col<size_t>& users,
+                        const arma::Col<size_t>& items,
+                        arma::mat& ratings) const
+  {
+    arma::mat userVecs(h.n_rows, users.n_elem);
+    for (size_t i = 0; i < users.n_elem; ++i)
+      userVecs.col(i) = h.col(users(i));
+
+    ratings = w.rows(arma::conv_to<arma::uvec>::from(items)) * userVecs;
+  }
+
+  /**
+   * Add a new user to the trained model.  The latent vector of the user is
+   * found from the given ratings with the item factors held fixed.
+   *
+   * @param items Items rated by the new user.
+   * @param ratings Normalized ratings of the new user.
+   * @param lambda Regularization parameter of the least squares solution.
+   */
+  void FoldInUser(const arma::Col<size_t>& items,
+                  const arma::vec& ratings,
+                  const double lambda)
+  {
+    arma::vec userVec;
+    FoldIn(w.rows(arma::conv_to<arma::uvec>::from(items)), ratings, lambda,
+        userVec);
+    h.insert_cols(h.n_cols, userVec);
+  }
+
+  /**
+   * Add a new item to the trained model.  The latent vector of the item is
+   * found from the given ratings with the user factors held fixed.
+   *
+   * @param users Users that rated the new item.
+   * @param ratings Normalized ratings of the new item.
+   * @param lambda Regularization parameter of the least squares solution.
+   */
+  void FoldInItem(const arma::Col<size_t>& users,
+                  const arma::vec& ratings,
+                  const double lambda)
+  {
+    arma::vec itemVec;
+    FoldIn(h.cols(arma::conv_to<arma::uvec>::from(users)).t(), ratings, lambda,
+        itemVec);
+    w.insert_rows(w.n_rows, itemVec.t());
+  }
+
+  /**
+   * Get the neighborhood and corresponding similarities for a set of users.
+   *
+   * @tparam NeighborSearchPolicy The policy to perform neighbor search.
+   *
+   * @param users Users whose neighborhood is to be computed.
+   * @param numUsersForSimilarity The number of neighbors returned for
+   *     each user.
+   * @param neighborhood Neighbors represented by user IDs.
+   * @param similarities Similarity between each user and each of its
+   *     neighbors.
+   */
+  template<typename NeighborSearchPolicy>
+  void GetNeighborhood(const arma::Col<size_t>& users,
+                       const size_t numUsersForSimilarity,
+                       arma::Mat<size_t>& neighborhood,
+                       arma::mat& similarities) const
+  {
+    // We want to avoid calculating the full rating matrix, so we will do
+    // nearest neighbor search only on the H matrix, using the observation that
+    // if the rating matrix X = W*H, then d(X.col(i), X.col(j)) = d(W H.col(i),
+    // W H.col(j)).  This can be seen as nearest neighbor search on the H
+    // matrix with the Mahalanobis distance where M^{-1} = W^T W.  So, we'll
+    // decompose M^{-1} = L L^T (the Cholesky decomposition), and then multiply
+    // H by L^T. Then we can perform nearest neighbor search.
+    arma::mat l = arma::chol(w.t() * w);
+    arma::mat stretchedH = l * h; // Due to the Armadillo API, l is L^T.
+
+    // Temporarily store feature vector of queried users.
+    arma::mat query(stretchedH.n_rows, users.n_elem);
+    // Select feature vectors of queried users.
+    for (size_t i = 0; i < users.n_elem; ++i)
+      query.col(i) = stretchedH.col(users(i));
+
+    NeighborSearchPolicy neighborSearch(stretchedH);
+    neighborSearch.Search(
+        query, numUsersForSimilarity, neighborhood, similarities);
+  }
+
+  //! Get the Item Matrix.
+  const arma::mat& W() const { return w; }
+  //! Get the User Matrix.
+  const arma::mat& H() const { return h; }
+
+  //! Get the regularization parameter.
+  double Lambda() const { return lambda; }
+  //! Modify the regularization parameter.
+  double& Lambda() { return lambda; }
+
+  /**
+   * Serialization.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(w));
+    ar(CEREAL_NVP(h));
+  }
+
+ private:
+  //! Regularization parameter.
+  double lambda;
+  //! Item matrix.
+  arma::mat w;
+  //! User matrix.
+  arma::mat h;
+};
+
+} // namespace cf
+} // namespace mlpack
+
+#endif
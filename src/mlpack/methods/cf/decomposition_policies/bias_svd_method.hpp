@@ -16,6 +16,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/methods/bias_svd/bias_svd.hpp>
+#include <mlpack/methods/cf/decomposition_policies/fold_in.hpp>
 
 namespace mlpack {
 namespace cf {
@@ -106,6 +107,100 @@ class BiasSVDPolicy
     rating = w * h.col(user) + p + q(user);
   }
 
+  /**
+   * Get predicted ratings for several users with a single matrix
+   * multiplication.
+   *
+   * @param users User IDs.
+   * @param ratings Resulting ratings, with one column for each user.
+   */
+  void GetRatingOfUsers(const arma::Col<size_t>& users,
+                        arma::mat& ratings) const
+  {
+    arma::mat userVecs(h.n_rows, users.n_elem);
+    for (size_t i = 0; i < users.n_elem; ++i)
+      userVecs.col(i) = h.col(users(i));
+
+    ratings = w * userVecs;
+    ratings.each_col() += p;
+    for (size_t i = 0; i < users.n_elem; ++i)
+      ratings.col(i) += q(users(i));
+  }
+
+  /**
+   * Get predicted ratings of the given items for several users with a single
+   * matrix multiplication.
+   *
+   * @param users User IDs.
+   * @param items Item IDs.
+   * @param ratings Resulting ratings, with one row for each item and one column
+   *     for each user.
+   */
+  void GetRatingOfUsers(const arma::Col<size_t>& users,
+                        const arma::Col<size_t>& items,
+                        arma::mat& ratings) const
+  {
+    arma::mat userVecs(h.n_rows, users.n_elem);
+    for (size_t i = 0; i < users.n_elem; ++i)
+      userVecs.col(i) = h.col(users(i));
+
+    const arma::uvec indices = arma::conv_to<arma::uvec>::from(items);
+    ratings = w.rows(indices) * userVecs;
+    ratings.each_col() += p.elem(indices);
+    for (size_t i = 0; i < users.n_elem; ++i)
+      ratings.col(i) += q(users(i));
+  }
+
+  /**
+   * Add a new user to the trained model.  The latent vector and the bias of
+   * the user are found from the given ratings with the item factors and biases
+   * held fixed.
+   *
+   * @param items Items rated by the new user.
+   * @param ratings Normalized ratings of the new user.
+   * @param lambda Regularization parameter of the least squares solution.
+   */
+  void FoldInUser(const arma::Col<size_t>& items,
+                  const arma::vec& ratings,
+                  const double lambda)
+  {
+    const arma::uvec indices = arma::conv_to<arma::uvec>::from(items);
+    arma::mat factors(indices.n_elem, w.n_cols + 1);
+    factors.head_cols(w.n_cols) = w.rows(indices);
+    factors.col(w.n_cols).ones();
+
+    arma::vec userVec;
+    FoldIn(factors, ratings - p.elem(indices), lambda, userVec);
+    h.insert_cols(h.n_cols, userVec.head(w.n_cols));
+    q.resize(q.n_elem + 1);
+    q[q.n_elem - 1] = userVec[w.n_cols];
+  }
+
+  /**
+   * Add a new item to the trained model.  The latent vector and the bias of
+   * the item are found from the given ratings with the user factors and biases
+   * held fixed.
+   *
+   * @param users Users that rated the new item.
+   * @param ratings Normalized ratings of the new item.
+   * @param lambda Regularization parameter of the least squares solution.
+   */
+  void FoldInItem(const arma::Col<size_t>& users,
+                  const arma::vec& ratings,
+                  const double lambda)
+  {
+    const arma::uvec indices = arma::conv_to<arma::uvec>::from(users);
+    arma::mat factors(indices.n_elem, h.n_rows + 1);
+    factors.head_cols(h.n_rows) = h.cols(indices).t();
+    factors.col(h.n_rows).ones();
+
+    arma::vec itemVec;
+    FoldIn(factors, ratings - q.elem(indices), lambda, itemVec);
+    w.insert_rows(w.n_rows, itemVec.head(h.n_rows).t());
+    p.resize(p.n_elem + 1);
+    p[p.n_elem - 1] = itemVec[h.n_rows];
+  }
+
   /**
    * Get the neighborhood and corresponding similarities for a set of users.
    *
@@ -0,0 +1,137 @@
+/**
+ * @file methods/cf/decomposition_policies/fold_in.hpp
+ *
+ * A utility function used by the decomposition policies to add a new user or
+ * item to a trained model.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_FOLD_IN_HPP
+#define MLPACK_METHODS_CF_DECOMPOSITION_POLICIES_FOLD_IN_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace cf {
+
+/**
+ * Find the latent vector x of a new user (or item) from its known ratings r,
+ * with the factors of the items (or users) held fixed.  If F holds the fixed
+ * factors of the n rated items, one row for each rating, x is the solution of
+ * the regularized least squares problem
+ *
+ * \f[
+ * (F^T F + \lambda n I) x = F^T r,
+ * \f]
+ *
+ * which is the same regularization that alternating least squares uses for
+ * each user and item.  If nothing is known about the new user (or item), a
+ * zero vector is returned.
+ *
+ * @param factors Fixed factors of the rated items (or users), one row for each
+ *     rating.
+ * @param ratings Known (normalized) ratings.
+ * @param lambda Regularization parameter.
+ * @param vector Resulting latent vector.
+ */
+inline void FoldIn(const arma::mat& factors,
+                   const arma::vec& ratings,
+                   const double lambda,
+                   arma::vec& vector)
+{
+  if (factors.n_rows != ratings.n_elem)
+  {
+    std::stringstream ss;
+    ss << "FoldIn(): the number of factors (" << factors.n_rows << ") must be "
+        << "equal to the number of ratings (" << ratings.n_elem << ")!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  if (ratings.n_elem == 0)
+  {
+    vector.zeros(factors.n_cols);
+    return;
+  }
+
+  arma::mat gram = factors.t() * factors;
+  gram.diag() += lambda * ratings.n_elem;
+  const arma::vec rhs = factors.t() * ratings;
+  if (!arma::solve(vector, gram, rhs))
+    vector = arma::pinv(gram) * rhs;
+}
+
+/**
+ * Find the nonnegative latent vector x of a new user (or item) from its known
+ * ratings r, with the factors of the items (or users) held fixed.  This solves
+ * the same regularized least squares problem as FoldIn(), subject to x >= 0,
+ * which is what the factors of a nonnegative matrix factorization must
+ * satisfy.  The problem is solved by projected coordinate descent, which
+ * converges to the exact solution since the problem is convex.  If nothing is
+ * known about the new user (or item), a zero vector is returned.
+ *
+ * @param factors Fixed factors of the rated items (or users), one row for each
+ *     rating.
+ * @param ratings Known (normalized) ratings.
+ * @param lambda Regularization parameter.
+ * @param vector Resulting latent vector.
+ * @param maxIterations Maximum number of passes over the coordinates.
+ * @param tolerance The descent stops when no coordinate changes by more than
+ *     this.
+ */
+inline void NonNegativeFoldIn(const arma::mat& factors,
+                              const arma::vec& ratings,
+                              const double lambda,
+                              arma::vec& vector,
+                              const size_t maxIterations = 1000,
+                              const double tolerance = 1e-10)
+{
+  if (factors.n_rows != ratings.n_elem)
+  {
+    std::stringstream ss;
+    ss << "NonNegativeFoldIn(): the number of factors (" << factors.n_rows
+        << ") must be equal to the number of ratings (" << ratings.n_elem
+        << ")!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  vector.zeros(factors.n_cols);
+  if (ratings.n_elem == 0)
+    return;
+
+  arma::mat gram = factors.t() * factors;
+  gram.diag() += lambda * ratings.n_elem;
+  const arma::vec rhs = factors.t() * ratings;
+
+  // The gradient of the objective is gram * vector - rhs; it is kept up to
+  // date as each coordinate changes.
+  arma::vec gradient = -rhs;
+  for (size_t iteration = 0; iteration < maxIterations; ++iteration)
+  {
+    double maxChange = 0.0;
+    for (size_t j = 0; j < vector.n_elem; ++j)
+    {
+      // A coordinate without curvature can only be zero at the minimum (or
+      // does not matter at all).
+      const double value = (gram(j, j) > 0.0) ?
+          std::max(0.0, vector[j] - gradient[j] / gram(j, j)) : 0.0;
+      const double change = value - vector[j];
+      if (change != 0.0)
+      {
+        gradient += change * gram.col(j);
+        vector[j] = value;
+        maxChange = std::max(maxChange, std::abs(change));
+      }
+    }
+
+    if (maxChange <= tolerance)
+      break;
+  }
+}
+
+} // namespace cf
+} // namespace mlpack
+
+#endif
@@ -18,6 +18,7 @@
 #include <mlpack/methods/amf/update_rules/nmf_als.hpp>
 #include <mlpack/methods/amf/termination_policies/max_iteration_termination.hpp>
 #include <mlpack/methods/amf/termination_policies/simple_residue_termination.hpp>
+#include <mlpack/methods/cf/decomposition_policies/fold_in.hpp>
 
 namespace mlpack {
 namespace cf {
@@ -104,6 +105,81 @@ class NMFPolicy
     rating = w * h.col(user);
   }
 
+  /**
+   * Get predicted ratings for several users with a single matrix
+   * multiplication.
+   *
+   * @param users User IDs.
+   * @param ratings Resulting ratings, with one column for each user.
+   */
+  void GetRatingOfUsers(const arma::Col<size_t>& users,
+                        arma::mat& ratings) const
+  {
+    arma::mat userVecs(h.n_rows, users.n_elem);
+    for (size_t i = 0; i < users.n_elem; ++i)
+      userVecs.col(i) = h.col(users(i));
+
+    ratings = w * userVecs;
+  }
+
+  /**
+   * Get predicted ratings of the given items for several users with a single
+   * matrix multiplication.
+   *
+   * @param users User IDs.
+   * @param items Item IDs.
+   * @param ratings Resulting ratings, with one row for each item and one column
+   *     for each user.
+   */
+  void GetRatingOfUsers(const arma::Col<size_t>& users,
+                        const arma::Col<size_t>& items,
+                        arma::mat& ratings) const
+  {
+    arma::mat userVecs(h.n_rows, users.n_elem);
+    for (size_t i = 0; i < users.n_elem; ++i)
+      userVecs.col(i) = h.col(users(i));
+
+    ratings = w.rows(arma::conv_to<arma::uvec>::from(items)) * userVecs;
+  }
+
+  /**
+   * Add a new user to the trained model.  The latent vector of the user is
+   * found from the given ratings with the item factors held fixed, and is
+   * nonnegative like the rest of the factorization.
+   *
+   * @param items Items rated by the new user.
+   * @param ratings Normalized ratings of the new user.
+   * @param lambda Regularization parameter of the least squares solution.
+   */
+  void FoldInUser(const arma::Col<size_t>& items,
+                  const arma::vec& ratings,
+                  const double lambda)
+  {
+    arma::vec userVec;
+    NonNegativeFoldIn(w.rows(arma::conv_to<arma::uvec>::from(items)), ratings,
+        lambda, userVec);
+    h.insert_cols(h.n_cols, userVec);
+  }
+
+  /**
+   * Add a new item to the trained model.  The latent vector of the item is
+   * found from the given ratings with the user factors held fixed, and is
+   * nonnegative like the rest of the factorization.
+   *
+   * @param users Users that rated the new item.
+   * @param ratings Normalized ratings of the new item.
+   * @param lambda Regularization parameter of the least squares solution.
+   */
+  void FoldInItem(const arma::Col<size_t>& users,
+                  const arma::vec& ratings,
+                  const double lambda)
+  {
+    arma::vec itemVec;
+    NonNegativeFoldIn(h.cols(arma::conv_to<arma::uvec>::from(users)).t(),
+        ratings, lambda, itemVec);
+    w.insert_rows(w.n_rows, itemVec.t());
+  }
+
   /**
    * Get the neighborhood and corresponding similarities for a set of users.
    *
@@ -16,6 +16,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/methods/regularized_svd/regularized_svd.hpp>
+#include <mlpack/methods/cf/decomposition_policies/fold_in.hpp>
 
 namespace mlpack {
 namespace cf {
@@ -100,6 +101,79 @@ class RegSVDPolicy
     rating = w * h.col(user);
   }
 
+  /**
+   * Get predicted ratings for several users with a single matrix
+   * multiplication.
+   *
+   * @param users User IDs.
+   * @param ratings Resulting ratings, with one column for each user.
+   */
+  void GetRatingOfUsers(const arma::Col<size_t>& users,
+                        arma::mat& ratings) const
+  {
+    arma::mat userVecs(h.n_rows, users.n_elem);
+    for (size_t i = 0; i < users.n_elem; ++i)
+      userVecs.col(i) = h.col(users(i));
+
+    ratings = w * userVecs;
+  }
+
+  /**
+   * Get predicted ratings of the given items for several users with a single
+   * matrix multiplication.
+   *
+   * @param users User IDs.
+   * @param items Item IDs.
+   * @param ratings Resulting ratings, with one row for each item and one column
+   *     for each user.
+   */
+  void GetRatingOfUsers(const arma::Col<size_t>& users,
+                        const arma::Col<size_t>& items,
+                        arma::mat& ratings) const
+  {
+    arma::mat userVecs(h.n_rows, users.n_elem);
+    for (size_t i = 0; i < users.n_elem; ++i)
+      userVecs.col(i) = h.col(users(i));
+
+    ratings = w.rows(arma::conv_to<arma::uvec>::from(items)) * userVecs;
+  }
+
+  /**
+   * Add a new user to the trained model.  The latent vector of the user is
+   * found from the given ratings with the item factors held fixed.
+   *
+   * @param items Items rated by the new user.
+   * @param ratings Normalized ratings of the new user.
+   * @param lambda Regularization parameter of the least squares solution.
+   */
+  void FoldInUser(const arma::Col<size_t>& items,
+                  const arma::vec& ratings,
+                  const double lambda)
+  {
+    arma::vec userVec;
+    FoldIn(w.rows(arma::conv_to<arma::uvec>::from(items)), ratings, lambda,
+        userVec);
+    h.insert_cols(h.n_cols, userVec);
+  }
+
+  /**
+   * Add a new item to the trained model.  The latent vector of the item is
+   * found from the given ratings with the user factors held fixed.
+   *
+   * @param users Users that rated the new item.
+   * @param ratings Normalized ratings of the new item.
+   * @param lambda Regularization parameter of the least squares solution.
+   */
+  void FoldInItem(const arma::Col<size_t>& users,
+                  const arma::vec& ratings,
+                  const double lambda)
+  {
+    arma::vec itemVec;
+    FoldIn(h.cols(arma::conv_to<arma::uvec>::from(users)).t(), ratings, lambda,
+        itemVec);
+    w.insert_rows(w.n_rows, itemVec.t());
+  }
+
   /**
    * Get the neighborhood and corresponding similarities for a set of users.
    *
@@ -16,6 +16,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/methods/svdplusplus/svdplusplus.hpp>
+#include <mlpack/methods/cf/decomposition_policies/fold_in.hpp>
 
 namespace mlpack {
 namespace cf {
@@ -141,6 +142,132 @@ class SVDPlusPlusPolicy
     rating = w * userVec + p + q(user);
   }
 
+  /**
+   * Get predicted ratings for several users with a single matrix
+   * multiplication.
+   *
+   * @param users User IDs.
+   * @param ratings Resulting ratings, with one column for each user.
+   */
+  void GetRatingOfUsers(const arma::Col<size_t>& users,
+                        arma::mat& ratings) const
+  {
+    arma::mat userVecs;
+    GetUserVectors(users, userVecs);
+
+    ratings = w * userVecs;
+    ratings.each_col() += p;
+    for (size_t i = 0; i < users.n_elem; ++i)
+      ratings.col(i) += q(users(i));
+  }
+
+  /**
+   * Get predicted ratings of the given items for several users with a single
+   * matrix multiplication.
+   *
+   * @param users User IDs.
+   * @param items Item IDs.
+   * @param ratings Resulting ratings, with one row for each item and one column
+   *     for each user.
+   */
+  void GetRatingOfUsers(const arma::Col<size_t>& users,
+                        const arma::Col<size_t>& items,
+                        arma::mat& ratings) const
+  {
+    arma::mat userVecs;
+    GetUserVectors(users, userVecs);
+
+    const arma::uvec indices = arma::conv_to<arma::uvec>::from(items);
+    ratings = w.rows(indices) * userVecs;
+    ratings.each_col() += p.elem(indices);
+    for (size_t i = 0; i < users.n_elem; ++i)
+      ratings.col(i) += q(users(i));
+  }
+
+  /**
+   * Add a new user to the trained model.  The items rated by the user are its
+   * implicit feedback, and the latent vector and the bias of the user are found
+   * from the given ratings with all item parameters held fixed.
+   *
+   * @param items Items rated by the new user.
+   * @param ratings Normalized ratings of the new user.
+   * @param lambda Regularization parameter of the least squares solution.
+   */
+  void FoldInUser(const arma::Col<size_t>& items,
+                  const arma::vec& ratings,
+                  const double lambda)
+  {
+    const arma::uvec indices = arma::conv_to<arma::uvec>::from(items);
+
+    // The implicit part of the user vector is fixed by the rated items.
+    arma::vec implicitVec(h.n_rows, arma::fill::zeros);
+    for (size_t i = 0; i < indices.n_elem; ++i)
+      implicitVec += y.col(indices[i]);
+    if (indices.n_elem != 0)
+      implicitVec /= std::sqrt(indices.n_elem);
+
+    arma::mat factors(indices.n_elem, w.n_cols + 1);
+    factors.head_cols(w.n_cols) = w.rows(indices);
+    factors.col(w.n_cols).ones();
+
+    arma::vec userVec;
+    FoldIn(factors, ratings - p.elem(indices) -
+        factors.head_cols(w.n_cols) * implicitVec, lambda, userVec);
+    h.insert_cols(h.n_cols, userVec.head(w.n_cols));
+    q.resize(q.n_elem + 1);
+    q[q.n_elem - 1] = userVec[w.n_cols];
+
+    implicitData.resize(implicitData.n_rows, implicitData.n_cols + 1);
+    for (size_t i = 0; i < indices.n_elem; ++i)
+      implicitData(indices[i], implicitData.n_cols - 1) = 1;
+  }
+
+  /**
+   * Add a new item to the trained model.  The latent vector and the bias of
+   * the item are found from the given ratings with all user parameters held
+   * fixed.  The implicit factors of the new item are zero, so the user vectors
+   * do not change.
+   *
+   * @param users Users that rated the new item.
+   * @param ratings Normalized ratings of the new item.
+   * @param lambda Regularization parameter of the least squares solution.
+   */
+  void FoldInItem(const arma::Col<size_t>& users,
+                  const arma::vec& ratings,
+                  const double lambda)
+  {
+    arma::mat factors(users.n_elem, h.n_rows + 1);
+    arma::vec offsets(users.n_elem);
+    for (size_t i = 0; i < users.n_elem; ++i)
+    {
+      // Compute the user vector as in GetRatingOfUser().
+      arma::vec userVec(h.n_rows, arma::fill::zeros);
+      arma::sp_mat::const_iterator it = implicitData.begin_col(users(i));
+      arma::sp_mat::const_iterator it_end = implicitData.end_col(users(i));
+      size_t implicitCount = 0;
+      for (; it != it_end; ++it)
+      {
+        userVec += y.col(it.row());
+        implicitCount += 1;
+      }
+      if (implicitCount != 0)
+        userVec /= std::sqrt(implicitCount);
+      userVec += h.col(users(i));
+
+      factors.submat(i, 0, i, h.n_rows - 1) = userVec.t();
+      offsets[i] = q(users(i));
+    }
+    factors.col(h.n_rows).ones();
+
+    arma::vec itemVec;
+    FoldIn(factors, ratings - offsets, lambda, itemVec);
+    w.insert_rows(w.n_rows, itemVec.head(h.n_rows).t());
+    p.resize(p.n_elem + 1);
+    p[p.n_elem - 1] = itemVec[h.n_rows];
+    y.insert_cols(y.n_cols, arma::vec(h.n_rows, arma::fill::zeros));
+    implicitData.resize(implicitData.n_rows + 1, implicitData.n_cols);
+  }
+
   /**
    * Get the neighborhood and corresponding similarities for a set of users.
    *
@@ -217,6 +344,35 @@ class SVDPlusPlusPolicy
   }
 
  private:
+  /**
+   * Compute the user vectors of several users: each one is the same
+   * combination of the user's factors and the implicit item factors as in
+   * GetRatingOfUser().
+   *
+   * @param users User IDs.
+   * @param userVecs Resulting user vectors, with one column for each user.
+   */
+  void GetUserVectors(const arma::Col<size_t>& users,
+                      arma::mat& userVecs) const
+  {
+    userVecs.set_size(h.n_rows, users.n_elem);
+    for (size_t i = 0; i < users.n_elem; ++i)
+    {
+      arma::vec userVec(h.n_rows, arma::fill::zeros);
+      arma::sp_mat::const_iterator it = implicitData.begin_col(users(i));
+      arma::sp_mat::const_iterator it_end = implicitData.end_col(users(i));
+      size_t implicitCount = 0;
+      for (; it != it_end; ++it)
+      {
+        userVec += y.col(it.row());
+        implicitCount += 1;
+      }
+      if (implicitCount != 0)
+        userVec /= std::sqrt(implicitCount);
+      userVecs.col(i) = userVec + h.col(users(i));
+    }
+  }
+
   //! Locally stored number of iterations.
   size_t maxIterations;
   //! Learning rate for optimization.
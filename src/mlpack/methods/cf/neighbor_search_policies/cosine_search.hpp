@@ -13,7 +13,7 @@
 #define MLPACK_METHODS_CF_COSINE_SEARCH_HPP
 
 #include <mlpack/prereqs.hpp>
-#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+#include <mlpack/methods/neighbor_search/cosine_neighbor_search.hpp>
 
 namespace mlpack {
 namespace cf {
@@ -22,10 +22,10 @@ namespace cf {
  * Nearest neighbor search with cosine distance.
  * Note that, with normalized vectors, neighbor search with cosine distance is
  * equivalent to neighbor search with Euclidean distance. Therefore, instead
- * of performing neighbor search directly with cosine distance, we first
- * normalize all vectors to unit length, and then use neighbor::KNN (i.e.
- * NeighborSearch with Euclidean distance, KDTree). Cosine similarities are
- * calculated from Euclidean distance.
+ * of performing neighbor search directly with cosine distance, we use
+ * neighbor::CosineNeighborSearch, which normalizes all vectors to unit length
+ * and searches them with Euclidean distance (and a KDTree). Cosine
+ * similarities are calculated from the returned cosine distances.
  *
  * An example of how to use CosineSearch in CF is shown below:
  *
@@ -50,13 +50,8 @@ class CosineSearch
    *
    * @param referenceSet Set of reference points.
    */
-  CosineSearch(const arma::mat& referenceSet)
-  {
-    // Normalize all vectors to unit length.
-    arma::mat normalizedSet = arma::normalise(referenceSet, 2, 0);
-
-    neighborSearch.Train(std::move(normalizedSet));
-  }
+  CosineSearch(const arma::mat& referenceSet) : neighborSearch(referenceSet)
+  { }
 
   /**
    * Given a set of query points, find the nearest k neighbors, and return
@@ -70,23 +65,18 @@ class CosineSearch
   void Search(const arma::mat& query, const size_t k,
               arma::Mat<size_t>& neighbors, arma::mat& similarities)
   {
-    // Normalize query vectors to unit length.
-    arma::mat normalizedQuery = arma::normalise(query, 2, 0);
-
-    neighborSearch.Search(normalizedQuery, k, neighbors, similarities);
+    neighborSearch.Search(query, k, neighbors, similarities);
 
-    // Resulting similarities from Search() are Euclidean distance.
-    // For unit vectors a and b, cos(a, b) = 1 - dis(a, b) ^ 2 / 2,
-    // where dis(a, b) is Euclidean distance.
-    // Furthermore, we restrict the range of similarity to be [0, 1]:
+    // Resulting similarities from Search() are cosine distances,
+    // 1 - cos(a, b).  We restrict the range of similarity to be [0, 1]:
     // similarities = (cos(a,b) + 1) / 2.0. As a result we have the following
     // formula.
-    similarities = 1 - arma::pow(similarities, 2) / 4.0;
+    similarities = 1 - similarities / 2.0;
   }
 
  private:
-  //! NeighborSearch object.
-  neighbor::KNN neighborSearch;
+  //! CosineNeighborSearch object.
+  neighbor::CosineNeighborSearch<> neighborSearch;
 };
 
 } // namespace cf
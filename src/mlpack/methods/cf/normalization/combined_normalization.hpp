@@ -60,6 +60,36 @@ class CombinedNormalization
     SequenceNormalize<0>(data);
   }
 
+  /**
+   * Normalize the ratings of a new user added after training by calling
+   * NormalizeNewUser() in each normalization object.
+   *
+   * @param user ID of the new user.
+   * @param items Items rated by the new user.
+   * @param ratings Ratings of the new user, normalized in place.
+   */
+  void NormalizeNewUser(const size_t user,
+                        const arma::Col<size_t>& items,
+                        arma::vec& ratings)
+  {
+    SequenceNormalizeNewUser<0>(user, items, ratings);
+  }
+
+  /**
+   * Normalize the ratings of a new item added after training by calling
+   * NormalizeNewItem() in each normalization object.
+   *
+   * @param item ID of the new item.
+   * @param users Users that rated the new item.
+   * @param ratings Ratings of the new item, normalized in place.
+   */
+  void NormalizeNewItem(const size_t item,
+                        const arma::Col<size_t>& users,
+                        arma::vec& ratings)
+  {
+    SequenceNormalizeNewItem<0>(item, users, ratings);
+  }
+
   /**
    * Denormalize rating by calling Denormalize() in each normalization object.
    * Note that the order of objects calling Denormalize() should be the
@@ -130,6 +160,48 @@ class CombinedNormalization
       typename = void>
   void SequenceNormalize(MatType& /* data */) { }
 
+  //! Unpack normalizations tuple to normalize the ratings of a new user.
+  template<
+      int I, /* Which normalization in tuple to use */
+      typename = std::enable_if_t<(I < std::tuple_size<TupleType>::value)>>
+  void SequenceNormalizeNewUser(const size_t user,
+                                const arma::Col<size_t>& items,
+                                arma::vec& ratings)
+  {
+    std::get<I>(normalizations).NormalizeNewUser(user, items, ratings);
+    SequenceNormalizeNewUser<I + 1>(user, items, ratings);
+  }
+
+  //! End of tuple unpacking.
+  template<
+      int I, /* Which normalization in tuple to use */
+      typename = std::enable_if_t<(I >= std::tuple_size<TupleType>::value)>,
+      typename = void>
+  void SequenceNormalizeNewUser(const size_t /* user */,
+                                const arma::Col<size_t>& /* items */,
+                                arma::vec& /* ratings */) { }
+
+  //! Unpack normalizations tuple to normalize the ratings of a new item.
+  template<
+      int I, /* Which normalization in tuple to use */
+      typename = std::enable_if_t<(I < std::tuple_size<TupleType>::value)>>
+  void SequenceNormalizeNewItem(const size_t item,
+                                const arma::Col<size_t>& users,
+                                arma::vec& ratings)
+  {
+    std::get<I>(normalizations).NormalizeNewItem(item, users, ratings);
+    SequenceNormalizeNewItem<I + 1>(item, users, ratings);
+  }
+
+  //! End of tuple unpacking.
+  template<
+      int I, /* Which normalization in tuple to use */
+      typename = std::enable_if_t<(I >= std::tuple_size<TupleType>::value)>,
+      typename = void>
+  void SequenceNormalizeNewItem(const size_t /* item */,
+                                const arma::Col<size_t>& /* users */,
+                                arma::vec& /* ratings */) { }
+
   //! Unpack normalizations tuple to denormalize.
   template<
       int I, /* Which normalization in tuple to use */
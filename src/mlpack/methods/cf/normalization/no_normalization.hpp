@@ -36,6 +36,28 @@ class NoNormalization
   template<typename MatType>
   inline void Normalize(const MatType& /* data */) const { }
 
+  /**
+   * Do nothing.
+   *
+   * @param * (user) ID of the new user.
+   * @param * (items) Items rated by the new user.
+   * @param * (ratings) Ratings of the new user.
+   */
+  inline void NormalizeNewUser(const size_t /* user */,
+                               const arma::Col<size_t>& /* items */,
+                               const arma::vec& /* ratings */) const { }
+
+  /**
+   * Do nothing.
+   *
+   * @param * (item) ID of the new item.
+   * @param * (users) Users that rated the new item.
+   * @param * (ratings) Ratings of the new item.
+   */
+  inline void NormalizeNewItem(const size_t /* item */,
+                               const arma::Col<size_t>& /* users */,
+                               const arma::vec& /* ratings */) const { }
+
   /**
    * Do nothing.
    *
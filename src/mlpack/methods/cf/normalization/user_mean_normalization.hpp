@@ -120,6 +120,57 @@ class UserMeanNormalization
     }
   }
 
+  /**
+   * Normalize the ratings of a new user added after training by subtracting
+   * their mean, which is stored as the mean of the new user.
+   *
+   * @param user ID of the new user.
+   * @param * (items) Items rated by the new user.
+   * @param ratings Ratings of the new user, normalized in place.
+   */
+  void NormalizeNewUser(const size_t user,
+                        const arma::Col<size_t>& /* items */,
+                        arma::vec& ratings)
+  {
+    if (userMean.n_elem <= user)
+      userMean.resize(user + 1);
+    userMean(user) = (ratings.n_elem == 0) ? 0.0 : arma::mean(ratings);
+
+    ratings -= userMean(user);
+
+    // The algorithm omits rating of zero. If normalized rating equals zero,
+    // it is set to the smallest positive float value.
+    ratings.for_each([](double& x)
+    {
+      if (x == 0)
+        x = std::numeric_limits<float>::min();
+    });
+  }
+
+  /**
+   * Normalize the ratings of a new item added after training by subtracting
+   * the mean of each user.
+   *
+   * @param * (item) ID of the new item.
+   * @param users Users that rated the new item.
+   * @param ratings Ratings of the new item, normalized in place.
+   */
+  void NormalizeNewItem(const size_t /* item */,
+                        const arma::Col<size_t>& users,
+                        arma::vec& ratings) const
+  {
+    for (size_t i = 0; i < ratings.n_elem; ++i)
+      ratings[i] -= userMean(users[i]);
+
+    // The algorithm omits rating of zero. If normalized rating equals zero,
+    // it is set to the smallest positive float value.
+    ratings.for_each([](double& x)
+    {
+      if (x == 0)
+        x = std::numeric_limits<float>::min();
+    });
+  }
+
   /**
    * Denormalize computed rating by adding user mean.
    *
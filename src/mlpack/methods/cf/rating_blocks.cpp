@@ -0,0 +1,82 @@
+/**
+ * @file methods/cf/rating_blocks.cpp
+ *
+ * Implementation of the partition of a rating dataset into blocks.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "rating_blocks.hpp"
+
+#include <mlpack/core/math/random.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+namespace mlpack {
+namespace cf {
+
+RatingBlocks::RatingBlocks(const arma::mat& data,
+                           const size_t numUsers,
+                           const size_t numItems,
+                           const size_t numBlocks) :
+    numBlocks(numBlocks),
+    userBlocks(numUsers),
+    itemBlocks(numItems)
+{
+  if (numBlocks == 0)
+  {
+    throw std::invalid_argument("RatingBlocks::RatingBlocks(): the number of "
+        "blocks must be positive!");
+  }
+
+  // Assign users and items to the groups in the order of random permutations.
+  std::vector<size_t> order(std::max(numUsers, numItems));
+  std::iota(order.begin(), order.begin() + numUsers, 0);
+  std::shuffle(order.begin(), order.begin() + numUsers, math::RandGen());
+  for (size_t i = 0; i < numUsers; ++i)
+    userBlocks[order[i]] = i % numBlocks;
+
+  std::iota(order.begin(), order.begin() + numItems, 0);
+  std::shuffle(order.begin(), order.begin() + numItems, math::RandGen());
+  for (size_t i = 0; i < numItems; ++i)
+    itemBlocks[order[i]] = i % numBlocks;
+
+  // Count the ratings of each block, and place each rating with a counting
+  // sort.
+  std::vector<size_t> blockOf(data.n_cols);
+  offsets.assign(numBlocks * numBlocks + 1, 0);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    blockOf[i] = userBlocks[(size_t) data(0, i)] * numBlocks +
+        itemBlocks[(size_t) data(1, i)];
+    ++offsets[blockOf[i] + 1];
+  }
+
+  for (size_t b = 0; b < numBlocks * numBlocks; ++b)
+    offsets[b + 1] += offsets[b];
+
+  std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+  std::vector<arma::uword> sorted(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    sorted[next[blockOf[i]]++] = i;
+
+  // Sort each block by user, and then by item.
+  #pragma omp parallel for
+  for (omp_size_t b = 0; b < (omp_size_t) (numBlocks * numBlocks); ++b)
+  {
+    std::sort(sorted.begin() + offsets[b], sorted.begin() + offsets[b + 1],
+        [&data](const arma::uword a, const arma::uword c)
+        {
+          return (data(0, a) < data(0, c)) ||
+              (data(0, a) == data(0, c) && data(1, a) < data(1, c));
+        });
+  }
+
+  ratings = data.cols(arma::uvec(sorted));
+}
+
+} // namespace cf
+} // namespace mlpack
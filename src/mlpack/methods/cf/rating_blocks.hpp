@@ -0,0 +1,107 @@
+/**
+ * @file methods/cf/rating_blocks.hpp
+ *
+ * A partition of a rating dataset into a grid of user x item blocks, for
+ * block-stratified parallel SGD.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_CF_RATING_BLOCKS_HPP
+#define MLPACK_METHODS_CF_RATING_BLOCKS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace cf {
+
+/**
+ * RatingBlocks partitions the users and the items of a rating dataset into
+ * 'numBlocks' groups each, giving a numBlocks x numBlocks grid of blocks of
+ * ratings.  Two blocks in different rows and columns of the grid share no user
+ * and no item, so the blocks of a stratum
+ *
+ *   (0, s), (1, s + 1), ..., (numBlocks - 1, s + numBlocks - 1) (mod numBlocks)
+ *
+ * can be processed by different threads without any synchronization on the
+ * user and item parameters.  Running the numBlocks strata one after the other
+ * visits every rating once; this is the scheduling of DSGD and FPSGD:
+ *
+ * @code
+ * @inproceedings{gemulla2011large,
+ *   title = {Large-scale Matrix Factorization with Distributed Stochastic
+ *       Gradient Descent},
+ *   author = {Gemulla, Rainer and Nijkamp, Erik and Haas, Peter J. and
+ *       Sismanis, Yannis},
+ *   booktitle = {Proceedings of the 17th ACM SIGKDD International Conference
+ *       on Knowledge Discovery and Data Mining},
+ *   pages = {69--77},
+ *   year = {2011}
+ * }
+ * @endcode
+ *
+ * Users and items are assigned to the groups at random, so that the blocks
+ * hold about the same number of ratings even when popular users or items have
+ * neighbouring ids.  The ratings are stored block by block, and sorted by user
+ * and then item inside each block, so that a block is a contiguous range of
+ * columns and consecutive updates touch the same user parameters.
+ */
+class RatingBlocks
+{
+ public:
+  /**
+   * Partition the given ratings.
+   *
+   * @param data Ratings in coordinate list form: one column (user, item,
+   *     rating) per rating.
+   * @param numUsers Number of users.
+   * @param numItems Number of items.
+   * @param numBlocks Number of groups of users and of items.
+   */
+  RatingBlocks(const arma::mat& data,
+               const size_t numUsers,
+               const size_t numItems,
+               const size_t numBlocks);
+
+  //! Get the number of groups of users and of items.
+  size_t NumBlocks() const { return numBlocks; }
+
+  //! Get the ratings, block by block, in the same form as the dataset.
+  const arma::mat& Ratings() const { return ratings; }
+
+  //! Get the index of the first rating of the given block in Ratings().
+  size_t BlockBegin(const size_t userBlock, const size_t itemBlock) const
+  {
+    return offsets[userBlock * numBlocks + itemBlock];
+  }
+
+  //! Get one past the index of the last rating of the given block.
+  size_t BlockEnd(const size_t userBlock, const size_t itemBlock) const
+  {
+    return offsets[userBlock * numBlocks + itemBlock + 1];
+  }
+
+  //! Get the group of the given user.
+  size_t UserBlock(const size_t user) const { return userBlocks[user]; }
+  //! Get the group of the given item.
+  size_t ItemBlock(const size_t item) const { return itemBlocks[item]; }
+
+ private:
+  //! The number of groups of users and of items.
+  size_t numBlocks;
+  //! The ratings, block by block.
+  arma::mat ratings;
+  //! The start of each block in the ratings, and the total number of ratings.
+  std::vector<size_t> offsets;
+  //! The group of each user.
+  std::vector<size_t> userBlocks;
+  //! The group of each item.
+  std::vector<size_t> itemBlocks;
+};
+
+} // namespace cf
+} // namespace mlpack
+
+#endif
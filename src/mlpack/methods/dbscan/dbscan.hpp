@@ -16,6 +16,8 @@
 #include <mlpack/core.hpp>
 #include <mlpack/methods/range_search/range_search.hpp>
 #include <mlpack/methods/emst/union_find.hpp>
+#include <mlpack/methods/emst/concurrent_union_find.hpp>
+#include "epsilon_grid.hpp"
 #include "random_point_selection.hpp"
 #include "ordered_point_selection.hpp"
 #include <boost/dynamic_bitset.hpp>
@@ -44,6 +46,16 @@ namespace dbscan {
  * range search technique used and the point selection strategy by means of
  * template parameters.
  *
+ * If LowMemory() is set, the neighbors of the points are never all stored at
+ * once; this mode only supports dense data (arma::mat).  For data with at most
+ * EpsilonGrid::MaxDimensionality dimensions (and the Euclidean distance), the
+ * pairs of points within epsilon are found with an epsilon-grid instead of
+ * range searches: the points in one cell are all within epsilon of each other,
+ * and two neighboring cells are merged as soon as one pair of their points is
+ * found to be within epsilon.  Otherwise, the range searches are run on blocks
+ * of BlockSize() points.  In both cases, the components are merged in parallel
+ * (when OpenMP is available) with a lock-free union-find structure.
+ *
  * @tparam RangeSearchType Class to use for range searching.
  * @tparam PointSelectionPolicy Strategy for selecting next point to cluster
  *      with.
@@ -112,6 +124,18 @@ class DBSCAN
                  arma::Row<size_t>& assignments,
                  arma::mat& centroids);
 
+  //! Get whether the low-memory mode is used.
+  bool LowMemory() const { return lowMemory; }
+  //! Modify whether the low-memory mode is used.  In this mode, the neighbors
+  //! of all points are never stored at once, and batchMode is ignored.
+  bool& LowMemory() { return lowMemory; }
+
+  //! Get the number of points searched at once in low-memory mode, when the
+  //! epsilon-grid is not used.
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of points searched at once in low-memory mode.
+  size_t& BlockSize() { return blockSize; }
+
  private:
   //! Maximum distance between two points to be part of same cluster.
   double epsilon;
@@ -123,6 +147,12 @@ class DBSCAN
   //! Whether or not to perform the search in batch mode.  If false, single
   bool batchMode;
 
+  //! Whether or not to avoid storing the neighbors of all points at once.
+  bool lowMemory;
+
+  //! The number of points searched at once in low-memory mode.
+  size_t blockSize;
+
   //! Instantiated range search policy.
   RangeSearchType rangeSearch;
 
@@ -155,6 +185,48 @@ class DBSCAN
   template<typename MatType>
   void BatchCluster(const MatType& data,
                     emst::UnionFind& uf);
+
+  /**
+   * The low-memory mode only supports dense data, so this overload (for any
+   * other matrix type) throws std::invalid_argument.
+   *
+   * @param data Dataset to cluster.
+   * @param uf ConcurrentUnionFind structure that will be modified.
+   */
+  template<typename MatType>
+  void LowMemoryCluster(const MatType& data,
+                        emst::ConcurrentUnionFind& uf);
+
+  /**
+   * Performs DBSCAN clustering on dense data without storing the neighbors of
+   * all points at once; the epsilon-grid is used if the dimensionality is low
+   * enough and the range search uses the Euclidean distance.
+   *
+   * @param data Dataset to cluster.
+   * @param uf ConcurrentUnionFind structure that will be modified.
+   */
+  void LowMemoryCluster(const arma::mat& data,
+                        emst::ConcurrentUnionFind& uf);
+
+  /**
+   * Find the pairs of points within epsilon with an epsilon-grid, and merge
+   * their components.
+   *
+   * @param data Dataset to cluster.
+   * @param uf ConcurrentUnionFind structure that will be modified.
+   */
+  void GridCluster(const arma::mat& data,
+                   emst::ConcurrentUnionFind& uf);
+
+  /**
+   * Find the pairs of points within epsilon with range searches on blocks of
+   * points, and merge their components.
+   *
+   * @param data Dataset to cluster.
+   * @param uf ConcurrentUnionFind structure that will be modified.
+   */
+  void BlockCluster(const arma::mat& data,
+                    emst::ConcurrentUnionFind& uf);
 };
 
 } // namespace dbscan
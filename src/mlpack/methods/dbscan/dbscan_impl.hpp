@@ -17,6 +17,24 @@
 namespace mlpack {
 namespace dbscan {
 
+//! Whether the range search type uses the Euclidean distance, which the
+//! epsilon-grid relies on.
+template<typename RangeSearchType>
+struct UsesEuclideanDistance
+{
+  static const bool value = false;
+};
+
+template<typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+struct UsesEuclideanDistance<range::RangeSearch<metric::EuclideanDistance,
+    MatType, TreeType>>
+{
+  static const bool value = true;
+};
+
 /**
  * Construct the DBSCAN object with the given parameters.
  */
@@ -30,6 +48,8 @@ DBSCAN<RangeSearchType, PointSelectionPolicy>::DBSCAN(
     epsilon(epsilon),
     minPoints(minPoints),
     batchMode(batchMode),
+    lowMemory(false),
+    blockSize(4096),
     rangeSearch(rangeSearch),
     pointSelector(pointSelector)
 {
@@ -100,19 +120,31 @@ size_t DBSCAN<RangeSearchType, PointSelectionPolicy>::Cluster(
     const MatType& data,
     arma::Row<size_t>& assignments)
 {
-  // Initialize the UnionFind object.
-  emst::UnionFind uf(data.n_cols);
-  rangeSearch.Train(data);
+  assignments.set_size(data.n_cols);
+  if (lowMemory)
+  {
+    emst::ConcurrentUnionFind uf(data.n_cols);
+    LowMemoryCluster(data, uf);
 
-  if (batchMode)
-    BatchCluster(data, uf);
+    // Now set assignments.
+    for (size_t i = 0; i < data.n_cols; ++i)
+      assignments[i] = uf.Find(i);
+  }
   else
-    PointwiseCluster(data, uf);
+  {
+    // Initialize the UnionFind object.
+    emst::UnionFind uf(data.n_cols);
+    rangeSearch.Train(data);
 
-  // Now set assignments.
-  assignments.set_size(data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
-    assignments[i] = uf.Find(i);
+    if (batchMode)
+      BatchCluster(data, uf);
+    else
+      PointwiseCluster(data, uf);
+
+    // Now set assignments.
+    for (size_t i = 0; i < data.n_cols; ++i)
+      assignments[i] = uf.Find(i);
+  }
 
   // Get a count of all clusters.
   const size_t numClusters = arma::max(assignments) + 1;
@@ -199,6 +231,121 @@ void DBSCAN<RangeSearchType, PointSelectionPolicy>::BatchCluster(
   }
 }
 
+/**
+ * The low-memory mode is only implemented for dense data.
+ */
+template<typename RangeSearchType, typename PointSelectionPolicy>
+template<typename MatType>
+void DBSCAN<RangeSearchType, PointSelectionPolicy>::LowMemoryCluster(
+    const MatType& /* data */,
+    emst::ConcurrentUnionFind& /* uf */)
+{
+  throw std::invalid_argument("DBSCAN::Cluster(): the low-memory mode only "
+      "supports dense data (arma::mat)!");
+}
+
+/**
+ * Performs DBSCAN clustering on dense data without storing the neighbors of
+ * all points at once, with the epsilon-grid if possible.
+ */
+template<typename RangeSearchType, typename PointSelectionPolicy>
+void DBSCAN<RangeSearchType, PointSelectionPolicy>::LowMemoryCluster(
+    const arma::mat& data,
+    emst::ConcurrentUnionFind& uf)
+{
+  if (UsesEuclideanDistance<RangeSearchType>::value &&
+      EpsilonGrid::CanBuild(data, epsilon))
+    GridCluster(data, uf);
+  else
+    BlockCluster(data, uf);
+}
+
+/**
+ * Find the pairs of points within epsilon with an epsilon-grid.
+ */
+template<typename RangeSearchType, typename PointSelectionPolicy>
+void DBSCAN<RangeSearchType, PointSelectionPolicy>::GridCluster(
+    const arma::mat& data,
+    emst::ConcurrentUnionFind& uf)
+{
+  Log::Info << "Building epsilon-grid." << std::endl;
+  const EpsilonGrid grid(data, epsilon);
+  Log::Info << "Epsilon-grid has " << grid.NumCells() << " non-empty cells."
+      << std::endl;
+
+  // All points in a cell are within epsilon of each other.
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (omp_size_t c = 0; c < (omp_size_t) grid.NumCells(); ++c)
+  {
+    const size_t first = grid.Point(grid.CellBegin(c));
+    for (size_t i = grid.CellBegin(c) + 1; i < grid.CellEnd(c); ++i)
+      uf.Union(first, grid.Point(i));
+  }
+
+  // Two neighboring cells are merged if any pair of their points is within
+  // epsilon, so the search stops at the first such pair, and cells that are
+  // already in the same component are skipped.
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (omp_size_t c = 0; c < (omp_size_t) grid.NumCells(); ++c)
+  {
+    const size_t first = grid.Point(grid.CellBegin(c));
+    for (size_t o = 0; o < grid.NumOffsets(); ++o)
+    {
+      const size_t other = grid.NeighborCell(c, o);
+      if (other == SIZE_MAX ||
+          uf.Find(first) == uf.Find(grid.Point(grid.CellBegin(other))))
+        continue;
+
+      bool found = false;
+      for (size_t i = grid.CellBegin(c); i < grid.CellEnd(c) && !found; ++i)
+      {
+        for (size_t j = grid.CellBegin(other); j < grid.CellEnd(other); ++j)
+        {
+          if (metric::EuclideanDistance::Evaluate(data.col(grid.Point(i)),
+              data.col(grid.Point(j))) <= epsilon)
+          {
+            uf.Union(grid.Point(i), grid.Point(j));
+            found = true;
+            break;
+          }
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Find the pairs of points within epsilon with range searches on blocks of
+ * points.
+ */
+template<typename RangeSearchType, typename PointSelectionPolicy>
+void DBSCAN<RangeSearchType, PointSelectionPolicy>::BlockCluster(
+    const arma::mat& data,
+    emst::ConcurrentUnionFind& uf)
+{
+  rangeSearch.Train(data);
+
+  // Only the neighbors of one block are stored at a time.
+  const size_t block = std::max(blockSize, (size_t) 1);
+  std::vector<std::vector<size_t>> neighbors;
+  std::vector<std::vector<double>> distances;
+  for (size_t begin = 0; begin < data.n_cols; begin += block)
+  {
+    const size_t end = std::min(begin + block, (size_t) data.n_cols);
+    Log::Info << "DBSCAN clustering on points " << begin << " to " << end - 1
+        << "..." << std::endl;
+
+    const MatType queries = data.cols(begin, end - 1);
+    rangeSearch.Search(queries, math::Range(0.0, epsilon), neighbors,
+        distances);
+
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (omp_size_t i = 0; i < (omp_size_t) neighbors.size(); ++i)
+      for (size_t j = 0; j < neighbors[i].size(); ++j)
+        uf.Union(begin + i, neighbors[i][j]);
+  }
+}
+
 } // namespace dbscan
 } // namespace mlpack
 
@@ -11,6 +11,7 @@
  */
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/util/io.hpp>
+#include <mlpack/core/data/space_filling_curve.hpp>
 #include <mlpack/core/util/mlpack_main.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
 #include <mlpack/core/tree/rectangle_tree.hpp>
@@ -63,7 +64,14 @@ BINDING_LONG_DESC(
     " 'hilbert-r', 'r-plus', 'r-plus-plus', 'cover', 'ball'. The " +
     PRINT_PARAM_STRING("single_mode") + " parameter will force single-tree "
     "search (as opposed to the default dual-tree search), and '" +
-    PRINT_PARAM_STRING("naive") + " will force brute-force range search.");
+    PRINT_PARAM_STRING("naive") + " will force brute-force range search."
+    "\n\n"
+    "If the " + PRINT_PARAM_STRING("low_memory") + " flag is specified, the "
+    "neighbors of all points are never stored at once.  For data with at most "
+    "4 dimensions (and the default Euclidean distance), the points within "
+    "epsilon of each other are then found with a grid of cells of diagonal "
+    "epsilon instead of range searches; otherwise the range searches are done "
+    "in blocks of points.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -98,6 +106,13 @@ PARAM_FLAG("single_mode", "If set, single-tree range search (not dual-tree) "
     "will be used.", "S");
 PARAM_FLAG("naive", "If set, brute-force range search (not tree-based) "
     "will be used.", "N");
+PARAM_FLAG("low_memory", "If set, the neighbors of all points are never "
+    "stored at once, and an epsilon-grid is used for low-dimensional data.",
+    "L");
+PARAM_STRING_IN("reorder", "Reorder the points along a space-filling curve "
+    "('hilbert' or 'z-order') before clustering, for better memory locality; "
+    "the assignments are in the original order ('none' keeps the order).", "",
+    "none");
 
 // Actually run the clustering, and process the output.
 template<typename RangeSearchType, typename PointSelectionPolicy>
@@ -113,8 +128,16 @@ void RunDBSCAN(RangeSearchType rs,
   const size_t minSize = (size_t) IO::GetParam<int>("min_size");
   arma::Row<size_t> assignments;
 
+  // Points that are close to each other are also close in memory after they
+  // are reordered along a space-filling curve.
+  const string reorder = IO::GetParam<string>("reorder");
+  arma::uvec order;
+  if (reorder != "none")
+    order = data::ReorderPoints(dataset, data::CurveTypeFromString(reorder));
+
   DBSCAN<RangeSearchType, PointSelectionPolicy> d(epsilon, minSize,
       !IO::HasParam("single_mode"), rs, pointSelector);
+  d.LowMemory() = IO::HasParam("low_memory");
 
   // If possible, avoid the overhead of calculating centroids.
   if (IO::HasParam("centroids"))
@@ -131,7 +154,11 @@ void RunDBSCAN(RangeSearchType rs,
   }
 
   if (IO::HasParam("assignments"))
+  {
+    if (reorder != "none")
+      data::RestoreOrder(assignments, order);
     IO::GetParam<arma::Row<size_t>>("assignments") = std::move(assignments);
+  }
 }
 
 // Choose the point selection policy.
@@ -156,6 +183,8 @@ static void mlpackMain()
   RequireParamInSet<string>("tree_type", { "kd", "cover", "r", "r-star", "x",
       "hilbert-r", "r-plus", "r-plus-plus", "ball" }, true,
       "unknown tree type");
+  RequireParamInSet<string>("reorder", { "none", "hilbert", "z-order" }, true,
+      "unknown space-filling curve");
 
   // Value of epsilon should be positive.
   RequireParamValue<double>("epsilon", [](double x) { return x > 0; },
@@ -0,0 +1,150 @@
+/**
+ * @file methods/dbscan/epsilon_grid.cpp
+ *
+ * Implementation of the EpsilonGrid class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "epsilon_grid.hpp"
+
+using namespace mlpack;
+using namespace mlpack::dbscan;
+
+namespace {
+
+//! Lexicographic comparison of two columns of cell coordinates.
+bool LessThan(const arma::sword* a, const arma::sword* b, const size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (a[i] != b[i])
+      return a[i] < b[i];
+  }
+
+  return false;
+}
+
+} // namespace
+
+EpsilonGrid::EpsilonGrid(const arma::mat& data, const double epsilon)
+{
+  const size_t dimensionality = data.n_rows;
+  const double side = epsilon / std::sqrt((double) dimensionality);
+  const arma::vec minimums = arma::min(data, 1);
+
+  arma::Mat<arma::sword> coordinates(dimensionality, data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    for (size_t j = 0; j < dimensionality; ++j)
+    {
+      coordinates(j, i) = (arma::sword) std::floor((data(j, i) - minimums[j]) /
+          side);
+    }
+  }
+
+  // Sort the points by cell.
+  std::vector<size_t> sorted(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    sorted[i] = i;
+  std::sort(sorted.begin(), sorted.end(),
+      [&coordinates, dimensionality](const size_t a, const size_t b)
+      {
+        return LessThan(coordinates.colptr(a), coordinates.colptr(b),
+            dimensionality);
+      });
+  order = arma::Col<size_t>(sorted);
+
+  // Find the cells.
+  std::vector<size_t> begins;
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    if (i == 0 || LessThan(coordinates.colptr(order[i - 1]),
+        coordinates.colptr(order[i]), dimensionality))
+      begins.push_back(i);
+  }
+
+  cells.set_size(dimensionality, begins.size());
+  for (size_t c = 0; c < begins.size(); ++c)
+    cells.col(c) = coordinates.col(order[begins[c]]);
+  begins.push_back(data.n_cols);
+  cellBegins = arma::Col<size_t>(begins);
+
+  // Two cells can contain points within epsilon of each other if the gaps
+  // between them, in units of cell sides, have a sum of squares of at most the
+  // dimensionality.  Only the offsets that are lexicographically positive are
+  // kept.
+  const arma::sword radius = (arma::sword) std::ceil(std::sqrt(
+      (double) dimensionality));
+  std::vector<arma::sword> kept;
+  arma::Col<arma::sword> offset(dimensionality);
+  offset.fill(-radius);
+  while (true)
+  {
+    arma::sword gaps = 0;
+    for (size_t j = 0; j < dimensionality; ++j)
+    {
+      const arma::sword gap = std::max(std::abs(offset[j]) - 1,
+          (arma::sword) 0);
+      gaps += gap * gap;
+    }
+
+    // The first nonzero coordinate of a positive offset is positive.
+    size_t first = 0;
+    while (first < dimensionality && offset[first] == 0)
+      ++first;
+
+    if (gaps <= (arma::sword) dimensionality && first < dimensionality &&
+        offset[first] > 0)
+      kept.insert(kept.end(), offset.begin(), offset.end());
+
+    // Move to the next offset.
+    size_t j = 0;
+    while (j < dimensionality && offset[j] == radius)
+      offset[j++] = -radius;
+    if (j == dimensionality)
+      break;
+    ++offset[j];
+  }
+
+  offsets = arma::Mat<arma::sword>(kept.data(), dimensionality,
+      kept.size() / dimensionality);
+}
+
+bool EpsilonGrid::CanBuild(const arma::mat& data, const double epsilon)
+{
+  if (data.n_rows == 0 || data.n_rows > MaxDimensionality ||
+      data.n_cols == 0 || epsilon <= 0.0)
+    return false;
+
+  const double side = epsilon / std::sqrt((double) data.n_rows);
+  const double extent = arma::max(arma::max(data, 1) - arma::min(data, 1));
+  return (extent / side < 1e15);
+}
+
+size_t EpsilonGrid::NeighborCell(const size_t cell, const size_t offset) const
+{
+  const size_t dimensionality = cells.n_rows;
+  arma::sword key[MaxDimensionality];
+  for (size_t j = 0; j < dimensionality; ++j)
+    key[j] = cells(j, cell) + offsets(j, offset);
+
+  // Binary search for the first cell that is not less than the key.
+  size_t lo = 0;
+  size_t hi = cells.n_cols;
+  while (lo < hi)
+  {
+    const size_t mid = (lo + hi) / 2;
+    if (LessThan(cells.colptr(mid), key, dimensionality))
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  if (lo == cells.n_cols || LessThan(key, cells.colptr(lo), dimensionality))
+    return SIZE_MAX;
+
+  return lo;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file methods/dbscan/epsilon_grid.hpp
+ *
+ * A uniform grid over a low-dimensional dataset whose cells have a diagonal
+ * of length epsilon, used by DBSCAN to find the pairs of points within
+ * epsilon without range searches.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DBSCAN_EPSILON_GRID_HPP
+#define MLPACK_METHODS_DBSCAN_EPSILON_GRID_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace dbscan {
+
+/**
+ * The EpsilonGrid splits the space into hypercubes of side epsilon / sqrt(d),
+ * so that any two points in the same cell are within epsilon of each other,
+ * and only stores the non-empty cells (sorted by their coordinates, so that a
+ * cell can be found by binary search).  Two points within epsilon of each
+ * other are either in the same cell or in one of a fixed set of neighboring
+ * cells; the number of neighboring cells grows exponentially with the
+ * dimensionality, so the grid is only useful in low dimensions.
+ */
+class EpsilonGrid
+{
+ public:
+  //! The largest dimensionality for which a grid is built; in 4 dimensions,
+  //! each cell already has 312 neighboring cells to check.
+  static const size_t MaxDimensionality = 4;
+
+  /**
+   * Build the grid on the given dataset.
+   *
+   * @param data Dataset to build the grid on.
+   * @param epsilon Length of the diagonal of each cell.
+   */
+  EpsilonGrid(const arma::mat& data, const double epsilon);
+
+  /**
+   * Return whether a grid should be built on the given dataset: the
+   * dimensionality must be at most MaxDimensionality, and the coordinates of
+   * the cells must fit in integers.
+   *
+   * @param data Dataset to build the grid on.
+   * @param epsilon Length of the diagonal of each cell.
+   */
+  static bool CanBuild(const arma::mat& data, const double epsilon);
+
+  //! Get the number of non-empty cells.
+  size_t NumCells() const { return cellBegins.n_elem - 1; }
+  //! Get the position (in the result of Point()) of the first point of a cell.
+  size_t CellBegin(const size_t cell) const { return cellBegins[cell]; }
+  //! Get the position after the last point of a cell.
+  size_t CellEnd(const size_t cell) const { return cellBegins[cell + 1]; }
+  //! Get the index of the point at the given position of the cell order.
+  size_t Point(const size_t position) const { return order[position]; }
+
+  //! Get the number of neighboring cells checked for each cell.  Only half of
+  //! the neighbors are included, so that each pair of cells is seen once.
+  size_t NumOffsets() const { return offsets.n_cols; }
+
+  /**
+   * Return the index of the given neighbor of a cell, or SIZE_MAX if that
+   * cell is empty.
+   *
+   * @param cell Index of the cell.
+   * @param offset Index of the neighbor (less than NumOffsets()).
+   */
+  size_t NeighborCell(const size_t cell, const size_t offset) const;
+
+ private:
+  //! Coordinates of each non-empty cell, one column per cell.
+  arma::Mat<arma::sword> cells;
+  //! The position of the first point of each cell, and the number of points.
+  arma::Col<size_t> cellBegins;
+  //! Indices of the points, sorted by cell.
+  arma::Col<size_t> order;
+  //! Offsets of the neighboring cells, one column per offset.
+  arma::Mat<arma::sword> offsets;
+};
+
+} // namespace dbscan
+} // namespace mlpack
+
+#endif
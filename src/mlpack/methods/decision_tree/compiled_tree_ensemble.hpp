@@ -0,0 +1,208 @@
+/**
+ * @file methods/decision_tree/compiled_tree_ensemble.hpp
+ *
+ * Definition of the CompiledTreeEnsemble class, which stores one or more
+ * trained decision trees in flat arrays for fast batch classification.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_COMPILED_TREE_ENSEMBLE_HPP
+#define MLPACK_METHODS_DECISION_TREE_COMPILED_TREE_ENSEMBLE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "best_binary_numeric_split.hpp"
+#include "histogram_numeric_split.hpp"
+#include "random_binary_numeric_split.hpp"
+#include "all_categorical_split.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * Whether a numeric split type sends a point to child 0 if its value is less
+ * than or equal to classProbabilities[0], and to child 1 otherwise.  Only trees
+ * with such numeric splits can be compiled.
+ */
+template<typename SplitType>
+struct IsThresholdNumericSplit : std::false_type { };
+
+template<typename FitnessFunction>
+struct IsThresholdNumericSplit<BestBinaryNumericSplit<FitnessFunction>> :
+    std::true_type { };
+
+template<typename FitnessFunction>
+struct IsThresholdNumericSplit<HistogramNumericSplit<FitnessFunction>> :
+    std::true_type { };
+
+template<typename FitnessFunction>
+struct IsThresholdNumericSplit<RandomBinaryNumericSplit<FitnessFunction>> :
+    std::true_type { };
+
+/**
+ * Whether a categorical split type sends a point to the child given by its
+ * value.  Only trees with such categorical splits can be compiled.
+ */
+template<typename SplitType>
+struct IsIndexCategoricalSplit : std::false_type { };
+
+template<typename FitnessFunction>
+struct IsIndexCategoricalSplit<AllCategoricalSplit<FitnessFunction>> :
+    std::true_type { };
+
+/**
+ * A CompiledTreeEnsemble holds trained decision trees (a single DecisionTree,
+ * or all the trees of a RandomForest) in a flat struct-of-arrays layout: each
+ * node is an index into arrays of split dimensions, split values and first
+ * children, and the children of a node are stored next to each other, so no
+ * pointers are followed and no per-node vectors are allocated.  The class
+ * probabilities of all the leaves are stored in one contiguous array.
+ *
+ * Classify() scores the points in blocks of BlockSize() points: every tree
+ * classifies all the points of a block before the next tree is used, so the
+ * nodes of each tree and the probabilities of the points of the block stay in
+ * cache.  The blocks are classified in parallel with OpenMP.  The predicted
+ * probabilities are the average of the leaf probabilities of each tree, as in
+ * RandomForest::Classify(); for a single tree they are the probabilities of
+ * its leaf, as in DecisionTree::Classify().
+ *
+ * The trees are copied, so the compiled ensemble does not change if they are
+ * later retrained.  Trees may use BestBinaryNumericSplit,
+ * HistogramNumericSplit or RandomBinaryNumericSplit for numeric dimensions, and
+ * AllCategoricalSplit for categorical dimensions.
+ *
+ * @code
+ * RandomForest<> rf(data, labels, numClasses, 100);
+ * CompiledTreeEnsemble compiled = rf.Compile();
+ * compiled.Classify(testData, predictions, probabilities);
+ * @endcode
+ */
+class CompiledTreeEnsemble
+{
+ public:
+  /**
+   * Create an empty ensemble.  Classify() will throw an exception until a tree
+   * is added.
+   */
+  CompiledTreeEnsemble();
+
+  /**
+   * Create an ensemble holding the given tree.
+   *
+   * @param tree Trained decision tree.
+   * @param blockSize Number of points classified by all trees together.
+   */
+  template<typename TreeType>
+  CompiledTreeEnsemble(const TreeType& tree, const size_t blockSize = 64);
+
+  /**
+   * Add a tree to the ensemble.  It must have the same number of classes as
+   * the trees already in the ensemble.
+   *
+   * @param tree Trained decision tree.
+   */
+  template<typename TreeType>
+  void Add(const TreeType& tree);
+
+  /**
+   * Predict the class of the given point.
+   *
+   * @param point Point to be classified.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Predict the class of the given point and return the predicted class
+   * probabilities.
+   *
+   * @param point Point to be classified.
+   * @param prediction size_t to store predicted class in.
+   * @param probabilities Output vector of class probabilities.
+   */
+  template<typename VecType>
+  void Classify(const VecType& point,
+                size_t& prediction,
+                arma::vec& probabilities) const;
+
+  /**
+   * Predict the classes of each point in the given dataset.
+   *
+   * @param data Dataset to be classified.
+   * @param predictions Output predictions for each point in the dataset.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions) const;
+
+  /**
+   * Predict the classes of each point in the given dataset, also returning the
+   * predicted class probabilities for each point.
+   *
+   * @param data Dataset to be classified.
+   * @param predictions Output predictions for each point in the dataset.
+   * @param probabilities Output matrix of class probabilities for each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  //! Get the number of trees.
+  size_t NumTrees() const { return roots.size(); }
+  //! Get the total number of nodes of all the trees.
+  size_t NumNodes() const { return nodeTypes.size(); }
+  //! Get the number of classes.
+  size_t NumClasses() const { return numClasses; }
+
+  //! Get the number of points classified by all trees together.
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of points classified by all trees together.
+  size_t& BlockSize() { return blockSize; }
+
+  //! Serialize the ensemble.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! The kinds of nodes.
+  enum NodeType : unsigned char
+  {
+    LEAF = 0,
+    NUMERIC_SPLIT = 1,
+    CATEGORICAL_SPLIT = 2
+  };
+
+  //! Find the leaf that the given point reaches in the tree with the given
+  //! root, and return the offset of its class probabilities.
+  template<typename VecType>
+  size_t Leaf(const VecType& point, const size_t root) const;
+
+  //! The number of points classified by all trees together.
+  size_t blockSize;
+  //! The number of classes.
+  size_t numClasses;
+  //! The index of the root of each tree.
+  std::vector<size_t> roots;
+  //! The type of each node.
+  std::vector<unsigned char> nodeTypes;
+  //! The split dimension of each non-leaf.
+  std::vector<size_t> splitDimensions;
+  //! The split value of each numeric split.
+  std::vector<double> splitValues;
+  //! The index of the first child of each non-leaf, or the offset of the class
+  //! probabilities of each leaf in leafProbabilities.
+  std::vector<size_t> children;
+  //! The class probabilities of every leaf, one after another.
+  std::vector<double> leafProbabilities;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "compiled_tree_ensemble_impl.hpp"
+
+#endif
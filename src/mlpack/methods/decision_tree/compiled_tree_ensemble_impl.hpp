@@ -0,0 +1,209 @@
+/**
+ * @file methods/decision_tree/compiled_tree_ensemble_impl.hpp
+ *
+ * Implementation of the CompiledTreeEnsemble class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_COMPILED_TREE_ENSEMBLE_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_COMPILED_TREE_ENSEMBLE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "compiled_tree_ensemble.hpp"
+
+namespace mlpack {
+namespace tree {
+
+inline CompiledTreeEnsemble::CompiledTreeEnsemble() :
+    blockSize(64),
+    numClasses(0)
+{
+  // Nothing to do here.
+}
+
+template<typename TreeType>
+CompiledTreeEnsemble::CompiledTreeEnsemble(const TreeType& tree,
+                                           const size_t blockSize) :
+    blockSize(blockSize),
+    numClasses(0)
+{
+  Add(tree);
+}
+
+template<typename TreeType>
+void CompiledTreeEnsemble::Add(const TreeType& tree)
+{
+  static_assert(IsThresholdNumericSplit<typename TreeType::NumericSplit>::value,
+      "CompiledTreeEnsemble: the numeric split type of the tree must send "
+      "points less than or equal to a split value left");
+  static_assert(
+      IsIndexCategoricalSplit<typename TreeType::CategoricalSplit>::value,
+      "CompiledTreeEnsemble: the categorical split type of the tree must send "
+      "points to the child of their category");
+
+  const size_t treeClasses = tree.NumClasses();
+  if (roots.empty())
+  {
+    numClasses = treeClasses;
+  }
+  else if (treeClasses != numClasses)
+  {
+    std::ostringstream oss;
+    oss << "CompiledTreeEnsemble::Add(): tree has " << treeClasses
+        << " classes, but the ensemble has " << numClasses << " classes";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Lay the tree out in breadth-first order, so that the children of each
+  // node are next to each other.
+  const size_t first = nodeTypes.size();
+  roots.push_back(first);
+  std::vector<const TreeType*> nodes(1, &tree);
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    const TreeType& node = *nodes[i];
+    if (node.NumChildren() == 0)
+    {
+      nodeTypes.push_back(LEAF);
+      splitDimensions.push_back(0);
+      splitValues.push_back(0.0);
+      children.push_back(leafProbabilities.size());
+      leafProbabilities.insert(leafProbabilities.end(),
+          node.ClassProbabilities().begin(), node.ClassProbabilities().end());
+      continue;
+    }
+
+    const bool categorical =
+        (node.SplitDimensionType() == data::Datatype::categorical);
+    nodeTypes.push_back(categorical ? CATEGORICAL_SPLIT : NUMERIC_SPLIT);
+    splitDimensions.push_back(node.SplitDimension());
+    splitValues.push_back(categorical ? 0.0 : node.ClassProbabilities()[0]);
+    children.push_back(first + nodes.size());
+    for (size_t c = 0; c < node.NumChildren(); ++c)
+      nodes.push_back(&node.Child(c));
+  }
+}
+
+template<typename VecType>
+size_t CompiledTreeEnsemble::Classify(const VecType& point) const
+{
+  size_t prediction;
+  arma::vec probabilities;
+  Classify(point, prediction, probabilities);
+  return prediction;
+}
+
+template<typename VecType>
+void CompiledTreeEnsemble::Classify(const VecType& point,
+                                    size_t& prediction,
+                                    arma::vec& probabilities) const
+{
+  if (roots.empty())
+  {
+    throw std::invalid_argument("CompiledTreeEnsemble::Classify(): no trees "
+        "in the ensemble!");
+  }
+
+  probabilities.zeros(numClasses);
+  for (size_t t = 0; t < roots.size(); ++t)
+  {
+    const double* leaf = leafProbabilities.data() + Leaf(point, roots[t]);
+    for (size_t c = 0; c < numClasses; ++c)
+      probabilities[c] += leaf[c];
+  }
+
+  probabilities /= roots.size();
+  prediction = probabilities.index_max();
+}
+
+template<typename MatType>
+void CompiledTreeEnsemble::Classify(const MatType& data,
+                                    arma::Row<size_t>& predictions) const
+{
+  arma::mat probabilities;
+  Classify(data, predictions, probabilities);
+}
+
+template<typename MatType>
+void CompiledTreeEnsemble::Classify(const MatType& data,
+                                    arma::Row<size_t>& predictions,
+                                    arma::mat& probabilities) const
+{
+  if (roots.empty())
+  {
+    throw std::invalid_argument("CompiledTreeEnsemble::Classify(): no trees "
+        "in the ensemble!");
+  }
+
+  predictions.set_size(data.n_cols);
+  probabilities.zeros(numClasses, data.n_cols);
+
+  const size_t block = std::max(blockSize, size_t(1));
+  const size_t numBlocks = (data.n_cols + block - 1) / block;
+
+  #pragma omp parallel for
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const size_t begin = b * block;
+    const size_t end = std::min(begin + block, (size_t) data.n_cols);
+
+    // Run every point of the block through one tree before moving on to the
+    // next tree.
+    for (size_t t = 0; t < roots.size(); ++t)
+    {
+      for (size_t i = begin; i < end; ++i)
+      {
+        const double* leaf = leafProbabilities.data() +
+            Leaf(data.col(i), roots[t]);
+        double* out = probabilities.colptr(i);
+        for (size_t c = 0; c < numClasses; ++c)
+          out[c] += leaf[c];
+      }
+    }
+
+    for (size_t i = begin; i < end; ++i)
+    {
+      probabilities.col(i) /= roots.size();
+      predictions[i] = probabilities.col(i).index_max();
+    }
+  }
+}
+
+template<typename Archive>
+void CompiledTreeEnsemble::serialize(Archive& ar,
+                                     const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(blockSize));
+  ar(CEREAL_NVP(numClasses));
+  ar(CEREAL_NVP(roots));
+  ar(CEREAL_NVP(nodeTypes));
+  ar(CEREAL_NVP(splitDimensions));
+  ar(CEREAL_NVP(splitValues));
+  ar(CEREAL_NVP(children));
+  ar(CEREAL_NVP(leafProbabilities));
+}
+
+template<typename VecType>
+size_t CompiledTreeEnsemble::Leaf(const VecType& point,
+                                  const size_t root) const
+{
+  size_t node = root;
+  while (nodeTypes[node] != LEAF)
+  {
+    const double value = point[splitDimensions[node]];
+    if (nodeTypes[node] == NUMERIC_SPLIT)
+      node = children[node] + ((value <= splitValues[node]) ? 0 : 1);
+    else
+      node = children[node] + (size_t) value;
+  }
+
+  return children[node];
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
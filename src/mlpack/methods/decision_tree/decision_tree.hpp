@@ -17,6 +17,8 @@
 #include "gini_gain.hpp"
 #include "information_gain.hpp"
 #include "best_binary_numeric_split.hpp"
+#include "histogram_numeric_split.hpp"
+#include "random_binary_numeric_split.hpp"
 #include "all_categorical_split.hpp"
 #include "all_dimension_select.hpp"
 #include <type_traits>
@@ -467,6 +469,18 @@ class DecisionTree :
   //! trained tree).
   size_t SplitDimension() const { return splitDimension; }
 
+  //! Get the type of the split dimension (only meaningful if this is a
+  //! non-leaf in a trained tree).
+  data::Datatype SplitDimensionType() const
+  { return (data::Datatype) dimensionTypeOrMajorityClass; }
+
+  //! Get the majority class (only meaningful if this is a leaf).
+  size_t MajorityClass() const { return dimensionTypeOrMajorityClass; }
+
+  //! Get the class probabilities of a leaf, or the information used by the
+  //! split type to calculate the direction of points of a non-leaf.
+  const arma::vec& ClassProbabilities() const { return classProbabilities; }
+
   /**
    * Given a point and that this node is not a leaf, calculate the index of the
    * child node this point would go towards.  This method is primarily used by
@@ -507,6 +521,11 @@ class DecisionTree :
   typedef typename CategoricalSplit::AuxiliarySplitInfo
       CategoricalAuxiliarySplitInfo;
 
+  //! The dimensions of a node are searched in parallel when the number of
+  //! dimensions times the number of points reaches this value; below it,
+  //! starting the threads costs more than the search.
+  static const size_t ParallelSplitWork = 16384;
+
   /**
    * Calculate the class probabilities of the given labels.
    */
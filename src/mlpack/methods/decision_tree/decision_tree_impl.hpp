@@ -636,13 +636,42 @@ double DecisionTree<FitnessFunction,
 
   if (maximumDepth != 1)
   {
+    // Collect the dimensions to search, so that they can be searched in
+    // parallel.
+    std::vector<size_t> dimensions;
     for (size_t i = dimensionSelector.Begin(); i != end;
          i = dimensionSelector.Next())
+      dimensions.push_back(i);
+
+    // Each dimension is compared against the gain of this node, and keeps its
+    // own split information until the best dimension is known.
+    const double nodeGain = bestGain;
+    arma::vec gains(dimensions.size());
+    std::vector<arma::vec> splitInfo(dimensions.size());
+    std::vector<NumericAuxiliarySplitInfo> numericAux(dimensions.size());
+    std::vector<CategoricalAuxiliarySplitInfo> categoricalAux(
+        dimensions.size());
+
+    // Splitters that draw random numbers get a random stream for each
+    // dimension, so the tree does not depend on the number of threads.
+    const bool randomSplits =
+        SplitTraits<NumericSplit>::UsesRandomNumbers ||
+        SplitTraits<CategoricalSplit>::UsesRandomNumbers;
+    const size_t seed = randomSplits ? math::RandomStreamSeed() : 0;
+
+    const bool parallel = (dimensions.size() * count >= ParallelSplitWork);
+    #pragma omp parallel for if (parallel)
+    for (omp_size_t k = 0; k < (omp_size_t) dimensions.size(); ++k)
     {
-      double dimGain = -DBL_MAX;
+      std::unique_ptr<math::RandomStream> stream(randomSplits ?
+          new math::RandomStream(seed, k) : NULL);
+
+      const size_t i = dimensions[k];
+      gains[k] = DBL_MAX;
       if (datasetInfo.Type(i) == data::Datatype::categorical)
       {
-        dimGain = CategoricalSplit::template SplitIfBetter<UseWeights>(bestGain,
+        gains[k] = CategoricalSplit::template SplitIfBetter<UseWeights>(
+            nodeGain,
             data.cols(begin, begin + count - 1).row(i),
             datasetInfo.NumMappings(i),
             labels.subvec(begin, begin + count - 1),
@@ -650,35 +679,50 @@ double DecisionTree<FitnessFunction,
             UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
             minimumLeafSize,
             minimumGainSplit,
-            classProbabilities,
-            *this);
+            splitInfo[k],
+            categoricalAux[k]);
       }
       else if (datasetInfo.Type(i) == data::Datatype::numeric)
       {
-        dimGain = NumericSplit::template SplitIfBetter<UseWeights>(bestGain,
+        gains[k] = NumericSplit::template SplitIfBetter<UseWeights>(nodeGain,
             data.cols(begin, begin + count - 1).row(i),
             labels.subvec(begin, begin + count - 1),
             numClasses,
             UseWeights ? weights.subvec(begin, begin + count - 1) : weights,
             minimumLeafSize,
             minimumGainSplit,
-            classProbabilities,
-            *this);
+            splitInfo[k],
+            numericAux[k]);
       }
+    }
 
-      // If the splitter reported that it did not split, move to the next
-      // dimension.
-      if (dimGain == DBL_MAX)
+    // Now choose a dimension as the serial search would: in selection order,
+    // each dimension is kept only if it improves on the best gain so far by
+    // minimumGainSplit, and a perfect split ends the search.  This does not
+    // depend on the number of threads.
+    size_t bestIndex = dimensions.size();
+    for (size_t k = 0; k < dimensions.size(); ++k)
+    {
+      if (gains[k] == DBL_MAX || gains[k] <= bestGain + minimumGainSplit)
         continue;
 
-      // Was there an improvement?  If so mark that it's the new best dimension.
-      bestDim = i;
-      bestGain = dimGain;
+      bestIndex = k;
+      bestDim = dimensions[k];
+      bestGain = gains[k];
 
       // If the gain is the best possible, no need to keep looking.
       if (bestGain >= 0.0)
         break;
     }
+
+    if (bestIndex != dimensions.size())
+    {
+      classProbabilities = std::move(splitInfo[bestIndex]);
+      if (datasetInfo.Type(bestDim) == data::Datatype::categorical)
+        CategoricalAuxiliarySplitInfo::operator=(categoricalAux[bestIndex]);
+      else
+        NumericAuxiliarySplitInfo::operator=(numericAux[bestIndex]);
+    }
   }
 
   // Did we split or not?  If so, then split the data and create the children.
@@ -821,12 +865,37 @@ double DecisionTree<FitnessFunction,
 
   if (maximumDepth != 1)
   {
+    // Collect the dimensions to search, so that they can be searched in
+    // parallel.
+    std::vector<size_t> dimensions;
     for (size_t i = dimensionSelector.Begin(); i != dimensionSelector.End();
          i = dimensionSelector.Next())
+      dimensions.push_back(i);
+
+    // Each dimension is compared against the gain of this node, and keeps its
+    // own split information until the best dimension is known.
+    const double nodeGain = bestGain;
+    arma::vec gains(dimensions.size());
+    std::vector<arma::vec> splitInfo(dimensions.size());
+    std::vector<NumericAuxiliarySplitInfo> numericAux(dimensions.size());
+
+    // Splitters that draw random numbers get a random stream for each
+    // dimension, so the tree does not depend on the number of threads.
+    const bool randomSplits =
+        SplitTraits<NumericSplitType<FitnessFunction>>::UsesRandomNumbers;
+    const size_t seed = randomSplits ? math::RandomStreamSeed() : 0;
+
+    const bool parallel = (dimensions.size() * count >= ParallelSplitWork);
+    #pragma omp parallel for if (parallel)
+    for (omp_size_t k = 0; k < (omp_size_t) dimensions.size(); ++k)
     {
-      const double dimGain = NumericSplitType<FitnessFunction>::template
-          SplitIfBetter<UseWeights>(bestGain,
-                                    data.cols(begin, begin + count - 1).row(i),
+      std::unique_ptr<math::RandomStream> stream(randomSplits ?
+          new math::RandomStream(seed, k) : NULL);
+
+      gains[k] = NumericSplitType<FitnessFunction>::template
+          SplitIfBetter<UseWeights>(nodeGain,
+                                    data.cols(begin, begin + count - 1).row(
+                                        dimensions[k]),
                                     labels.cols(begin, begin + count - 1),
                                     numClasses,
                                     UseWeights ?
@@ -834,21 +903,34 @@ double DecisionTree<FitnessFunction,
                                         weights,
                                     minimumLeafSize,
                                     minimumGainSplit,
-                                    classProbabilities,
-                                    *this);
+                                    splitInfo[k],
+                                    numericAux[k]);
+    }
 
-      // If the splitter did not report that it improved, then move to the next
-      // dimension.
-      if (dimGain == DBL_MAX)
+    // Now choose a dimension as the serial search would: in selection order,
+    // each dimension is kept only if it improves on the best gain so far by
+    // minimumGainSplit, and a perfect split ends the search.  This does not
+    // depend on the number of threads.
+    size_t bestIndex = dimensions.size();
+    for (size_t k = 0; k < dimensions.size(); ++k)
+    {
+      if (gains[k] == DBL_MAX || gains[k] <= bestGain + minimumGainSplit)
         continue;
 
-      bestDim = i;
-      bestGain = dimGain;
+      bestIndex = k;
+      bestDim = dimensions[k];
+      bestGain = gains[k];
 
       // If the gain is the best possible, no need to keep looking.
       if (bestGain >= 0.0)
         break;
     }
+
+    if (bestIndex != dimensions.size())
+    {
+      classProbabilities = std::move(splitInfo[bestIndex]);
+      NumericAuxiliarySplitInfo::operator=(numericAux[bestIndex]);
+    }
   }
 
   // Did we split or not?  If so, then split the data and create the children.
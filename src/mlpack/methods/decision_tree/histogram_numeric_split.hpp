@@ -0,0 +1,112 @@
+/**
+ * @file methods/decision_tree/histogram_numeric_split.hpp
+ *
+ * A tree splitter that finds the best binary numeric split from a histogram of
+ * the values of a dimension.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_HPP
+#define MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The HistogramNumericSplit is a splitting function for decision trees that
+ * searches a numeric dimension for the best binary split without sorting it.
+ * The values of the node are quantized into at most MaxBins equal-width bins
+ * between their minimum and maximum, a histogram of the classes of each bin is
+ * built in one pass, and only the boundaries between bins are evaluated as
+ * split points, with cumulative class counts.  This takes O(n + MaxBins) time
+ * for each dimension of each node, instead of the O(n log n) of
+ * BestBinaryNumericSplit.
+ *
+ * If the values of a node are integers spanning fewer than MaxBins values
+ * (for instance, a dataset that was quantized to 8-bit values beforehand, and
+ * is given as an arma::Mat<unsigned char>), every value gets its own bin, and
+ * the split found is the same as the one BestBinaryNumericSplit finds.
+ * Otherwise, the split is the best one among the bin boundaries.  The split
+ * value is always halfway between the largest value on the left and the
+ * smallest value on the right, so the training points go to the same side
+ * when they are classified.
+ *
+ * @tparam FitnessFunction Fitness function to use to calculate gain.
+ */
+template<typename FitnessFunction>
+class HistogramNumericSplit
+{
+ public:
+  //! The maximum number of bins of a histogram.
+  static const size_t MaxBins = 256;
+
+  // No extra info needed for split.
+  class AuxiliarySplitInfo { };
+
+  /**
+   * Check if we can split a node.  If we can split a node in a way that
+   * improves on 'bestGain', then we return the improved gain.  Otherwise we
+   * return the value 'bestGain'.  If a split is made, then classProbabilities
+   * and aux may be modified.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param labels Labels for each point.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights associated with labels.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param classProbabilities Class probabilities vector, which may be filled
+   *      with split information a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   */
+  template<bool UseWeights, typename VecType, typename WeightVecType>
+  static double SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const arma::Row<size_t>& labels,
+      const size_t numClasses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::vec& classProbabilities,
+      AuxiliarySplitInfo& aux);
+
+  /**
+   * Returns 2, since the binary split always has two children.
+   */
+  static size_t NumChildren(const arma::vec& /* classProbabilities */,
+                            const AuxiliarySplitInfo& /* aux */)
+  {
+    return 2;
+  }
+
+  /**
+   * Given a point, calculate which child it should go to (left or right).
+   *
+   * @param point Point to calculate direction of.
+   * @param classProbabilities Auxiliary information for the split.
+   * @param * (aux) Auxiliary information for the split (Unused).
+   */
+  template<typename ElemType>
+  static size_t CalculateDirection(
+      const ElemType& point,
+      const arma::vec& classProbabilities,
+      const AuxiliarySplitInfo& /* aux */);
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "histogram_numeric_split_impl.hpp"
+
+#endif
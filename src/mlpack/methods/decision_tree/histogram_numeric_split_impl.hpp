@@ -0,0 +1,227 @@
+/**
+ * @file methods/decision_tree/histogram_numeric_split_impl.hpp
+ *
+ * Implementation of strategy that finds the best binary numeric split from a
+ * histogram of the values of a dimension.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_IMPL_HPP
+
+namespace mlpack {
+namespace tree {
+
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double HistogramNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& classProbabilities,
+    AuxiliarySplitInfo& /* aux */)
+{
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  const size_t n = data.n_elem;
+  double minValue = data[0];
+  double maxValue = data[0];
+  bool integral = true;
+  for (size_t i = 0; i < n; ++i)
+  {
+    const double value = data[i];
+    minValue = std::min(minValue, value);
+    maxValue = std::max(maxValue, value);
+    integral &= (value == std::floor(value));
+  }
+
+  // Sanity check: if all values are the same, we can't split in this
+  // dimension.
+  if (minValue == maxValue)
+    return DBL_MAX;
+
+  // Integer values that span few enough values get one bin each, so that the
+  // split is exact; otherwise, use equal-width bins.
+  size_t numBins = MaxBins;
+  double binWidth = (maxValue - minValue) / MaxBins;
+  if (integral && maxValue - minValue < MaxBins)
+  {
+    numBins = (size_t) (maxValue - minValue) + 1;
+    binWidth = 1.0;
+  }
+
+  // Build the histogram: the counts (or weight sums) of each class in each
+  // bin, and the smallest and largest value in each bin.
+  arma::Mat<size_t> binClassCounts;
+  arma::mat binClassWeights;
+  if (UseWeights)
+    binClassWeights.zeros(numClasses, numBins);
+  else
+    binClassCounts.zeros(numClasses, numBins);
+  arma::Col<size_t> binCounts(numBins, arma::fill::zeros);
+  arma::vec binMin(numBins), binMax(numBins);
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    const double value = data[i];
+    const size_t bin = std::min((size_t) ((value - minValue) / binWidth),
+        numBins - 1);
+    if (binCounts[bin] == 0)
+    {
+      binMin[bin] = value;
+      binMax[bin] = value;
+    }
+    else
+    {
+      binMin[bin] = std::min(binMin[bin], value);
+      binMax[bin] = std::max(binMax[bin], value);
+    }
+
+    ++binCounts[bin];
+    if (UseWeights)
+      binClassWeights(labels[i], bin) += weights[i];
+    else
+      ++binClassCounts(labels[i], bin);
+  }
+
+  // Loop through all bin boundaries, choosing the best one.  Also, force a
+  // minimum leaf size of 1 (empty children don't make sense).  The allowed
+  // sizes of the left child are the same as for BestBinaryNumericSplit.
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  arma::Col<size_t> leftCounts, rightCounts;
+  arma::vec leftWeights, rightWeights;
+  double totalWeight = 0.0;
+  double totalLeftWeight = 0.0;
+  double totalRightWeight = 0.0;
+  if (UseWeights)
+  {
+    leftWeights.zeros(numClasses);
+    rightWeights = arma::sum(binClassWeights, 1);
+    totalWeight = arma::accu(rightWeights);
+    totalRightWeight = totalWeight;
+    bestFoundGain *= totalWeight;
+  }
+  else
+  {
+    leftCounts.zeros(numClasses);
+    rightCounts = arma::sum(binClassCounts, 1);
+    bestFoundGain *= n;
+  }
+
+  size_t leftSize = 0;
+  for (size_t bin = 0; bin < numBins - 1; ++bin)
+  {
+    if (binCounts[bin] == 0)
+      continue;
+
+    // Move this bin to the left child.
+    leftSize += binCounts[bin];
+    if (UseWeights)
+    {
+      for (size_t c = 0; c < numClasses; ++c)
+      {
+        leftWeights[c] += binClassWeights(c, bin);
+        rightWeights[c] -= binClassWeights(c, bin);
+        totalLeftWeight += binClassWeights(c, bin);
+        totalRightWeight -= binClassWeights(c, bin);
+      }
+    }
+    else
+    {
+      leftCounts += binClassCounts.col(bin);
+      rightCounts -= binClassCounts.col(bin);
+    }
+
+    if (leftSize < minimum)
+      continue;
+    if (leftSize >= n - minimum)
+      break;
+
+    // The split value will be halfway between the largest value on the left
+    // and the smallest value on the right.
+    size_t nextBin = bin + 1;
+    while (binCounts[nextBin] == 0)
+      ++nextBin;
+
+    // Calculate the gain for the left and right child.  Only use weights if
+    // needed.
+    const double leftGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(leftWeights.memptr(),
+            numClasses, totalLeftWeight) :
+        FitnessFunction::template EvaluatePtr<false>(leftCounts.memptr(),
+            numClasses, leftSize);
+    const double rightGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(rightWeights.memptr(),
+            numClasses, totalRightWeight) :
+        FitnessFunction::template EvaluatePtr<false>(rightCounts.memptr(),
+            numClasses, size_t(n - leftSize));
+
+    double gain;
+    if (UseWeights)
+      gain = totalLeftWeight * leftGain + totalRightWeight * rightGain;
+    else
+      gain = double(leftSize) * leftGain + double(n - leftSize) * rightGain;
+
+    // Corner case: is this the best possible split?
+    if (gain >= 0.0)
+    {
+      // We can take a shortcut: no split will be better than this, so just take
+      // this one.
+      classProbabilities.set_size(1);
+      classProbabilities[0] = (binMax[bin] + binMin[nextBin]) / 2.0;
+      return gain;
+    }
+    else if (gain > bestFoundGain)
+    {
+      // We still have a better split.
+      bestFoundGain = gain;
+      classProbabilities.set_size(1);
+      classProbabilities[0] = (binMax[bin] + binMin[nextBin]) / 2.0;
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= n;
+
+  return bestFoundGain;
+}
+
+template<typename FitnessFunction>
+template<typename ElemType>
+size_t HistogramNumericSplit<FitnessFunction>::CalculateDirection(
+    const ElemType& point,
+    const arma::vec& classProbabilities,
+    const AuxiliarySplitInfo& /* aux */)
+{
+  if (point <= classProbabilities[0])
+    return 0; // Go left.
+  else
+    return 1; // Go right.
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
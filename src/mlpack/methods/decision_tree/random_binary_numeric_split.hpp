@@ -0,0 +1,126 @@
+/**
+ * @file methods/decision_tree/random_binary_numeric_split.hpp
+ *
+ * A tree splitter that draws a random binary numeric split, as in extremely
+ * randomized trees.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_RANDOM_BINARY_NUMERIC_SPLIT_HPP
+#define MLPACK_METHODS_DECISION_TREE_RANDOM_BINARY_NUMERIC_SPLIT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/binary_space_tree/split_traits.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The RandomBinaryNumericSplit is a splitting function for decision trees that
+ * does not search a numeric dimension for its best split: it draws one split
+ * value uniformly at random between the smallest and the largest value of the
+ * node, and evaluates only that split.  This takes O(n) time for each
+ * dimension of each node, instead of the O(n log n) of BestBinaryNumericSplit.
+ * Together with MultipleRandomDimensionSelect, this builds the extremely
+ * randomized trees of Geurts et al.:
+ *
+ * @code
+ * @article{geurts2006extremely,
+ *   title={Extremely randomized trees},
+ *   author={Geurts, Pierre and Ernst, Damien and Wehenkel, Louis},
+ *   journal={Machine Learning},
+ *   volume={63},
+ *   number={1},
+ *   pages={3--42},
+ *   year={2006},
+ *   publisher={Springer}
+ * }
+ * @endcode
+ *
+ * The best of the random splits of the candidate dimensions is kept, so each
+ * tree is weaker than a tree with exhaustive splits, but an ensemble of them
+ * (see ExtraTrees) usually reaches a similar accuracy, and trains much faster.
+ * If the random split leaves fewer than minimumLeafSize points in a child, the
+ * dimension is not split.
+ *
+ * @tparam FitnessFunction Fitness function to use to calculate gain.
+ */
+template<typename FitnessFunction>
+class RandomBinaryNumericSplit
+{
+ public:
+  // No extra info needed for split.
+  class AuxiliarySplitInfo { };
+
+  /**
+   * Draw a random split of a node.  If the split improves on 'bestGain', then
+   * we return the improved gain.  Otherwise we return DBL_MAX.  If a split is
+   * made, then classProbabilities and aux may be modified.
+   *
+   * @param bestGain Best gain seen so far (we'll only split if we find gain
+   *      better than this).
+   * @param data The dimension of data points to check for a split in.
+   * @param labels Labels for each point.
+   * @param numClasses Number of classes in the dataset.
+   * @param weights Weights associated with labels.
+   * @param minimumLeafSize Minimum number of points in a leaf node for
+   *      splitting.
+   * @param minimumGainSplit Minimum gain split.
+   * @param classProbabilities Class probabilities vector, which may be filled
+   *      with split information a successful split.
+   * @param aux Auxiliary split information, which may be modified on a
+   *      successful split.
+   */
+  template<bool UseWeights, typename VecType, typename WeightVecType>
+  static double SplitIfBetter(
+      const double bestGain,
+      const VecType& data,
+      const arma::Row<size_t>& labels,
+      const size_t numClasses,
+      const WeightVecType& weights,
+      const size_t minimumLeafSize,
+      const double minimumGainSplit,
+      arma::vec& classProbabilities,
+      AuxiliarySplitInfo& aux);
+
+  /**
+   * Returns 2, since the binary split always has two children.
+   */
+  static size_t NumChildren(const arma::vec& /* classProbabilities */,
+                            const AuxiliarySplitInfo& /* aux */)
+  {
+    return 2;
+  }
+
+  /**
+   * Given a point, calculate which child it should go to (left or right).
+   *
+   * @param point Point to calculate direction of.
+   * @param classProbabilities Auxiliary information for the split.
+   * @param * (aux) Auxiliary information for the split (Unused).
+   */
+  template<typename ElemType>
+  static size_t CalculateDirection(
+      const ElemType& point,
+      const arma::vec& classProbabilities,
+      const AuxiliarySplitInfo& /* aux */);
+};
+
+//! The RandomBinaryNumericSplit draws its split values at random.
+template<typename FitnessFunction>
+struct SplitTraits<RandomBinaryNumericSplit<FitnessFunction>>
+{
+  static const bool SupportsParallelBuild = true;
+  static const bool UsesRandomNumbers = true;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "random_binary_numeric_split_impl.hpp"
+
+#endif
@@ -0,0 +1,134 @@
+/**
+ * @file methods/decision_tree/random_binary_numeric_split_impl.hpp
+ *
+ * Implementation of strategy that draws a random binary numeric split.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_RANDOM_BINARY_NUMERIC_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_RANDOM_BINARY_NUMERIC_SPLIT_IMPL_HPP
+
+namespace mlpack {
+namespace tree {
+
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double RandomBinaryNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::vec& classProbabilities,
+    AuxiliarySplitInfo& /* aux */)
+{
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  const size_t n = data.n_elem;
+  double minValue = data[0];
+  double maxValue = data[0];
+  for (size_t i = 1; i < n; ++i)
+  {
+    minValue = std::min(minValue, (double) data[i]);
+    maxValue = std::max(maxValue, (double) data[i]);
+  }
+
+  // Sanity check: if all values are the same, we can't split in this
+  // dimension.
+  if (minValue == maxValue)
+    return DBL_MAX;
+
+  // Draw the split value; the smallest value always goes left.  DecisionTree
+  // gives the search of each dimension its own random stream (see
+  // SplitTraits), so this is safe in its parallel loop.
+  const double splitValue = math::Random(minValue, maxValue);
+
+  // Count the classes (or sum the weights) of each child in one pass.
+  arma::Col<size_t> leftCounts, rightCounts;
+  arma::vec leftWeights, rightWeights;
+  if (UseWeights)
+  {
+    leftWeights.zeros(numClasses);
+    rightWeights.zeros(numClasses);
+  }
+  else
+  {
+    leftCounts.zeros(numClasses);
+    rightCounts.zeros(numClasses);
+  }
+
+  size_t leftSize = 0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    const bool left = (data[i] <= splitValue);
+    leftSize += left;
+    if (UseWeights)
+      (left ? leftWeights : rightWeights)[labels[i]] += weights[i];
+    else
+      ++(left ? leftCounts : rightCounts)[labels[i]];
+  }
+
+  // Force a minimum leaf size of 1 (empty children don't make sense).
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+  if (leftSize < minimum || n - leftSize < minimum)
+    return DBL_MAX;
+
+  // Calculate the gain for the left and right child.  Only use weights if
+  // needed.
+  double gain, totalWeight;
+  if (UseWeights)
+  {
+    const double totalLeftWeight = arma::accu(leftWeights);
+    const double totalRightWeight = arma::accu(rightWeights);
+    totalWeight = totalLeftWeight + totalRightWeight;
+    gain = totalLeftWeight * FitnessFunction::template EvaluatePtr<true>(
+        leftWeights.memptr(), numClasses, totalLeftWeight) +
+        totalRightWeight * FitnessFunction::template EvaluatePtr<true>(
+        rightWeights.memptr(), numClasses, totalRightWeight);
+  }
+  else
+  {
+    totalWeight = (double) n;
+    gain = double(leftSize) * FitnessFunction::template EvaluatePtr<false>(
+        leftCounts.memptr(), numClasses, leftSize) +
+        double(n - leftSize) * FitnessFunction::template EvaluatePtr<false>(
+        rightCounts.memptr(), numClasses, size_t(n - leftSize));
+  }
+
+  // Only split if the gain improves enough on the gain of the node.
+  const double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0) *
+      totalWeight;
+  if (gain < 0.0 && gain <= bestFoundGain)
+    return DBL_MAX;
+
+  classProbabilities.set_size(1);
+  classProbabilities[0] = splitValue;
+  return gain / totalWeight;
+}
+
+template<typename FitnessFunction>
+template<typename ElemType>
+size_t RandomBinaryNumericSplit<FitnessFunction>::CalculateDirection(
+    const ElemType& point,
+    const arma::vec& classProbabilities,
+    const AuxiliarySplitInfo& /* aux */)
+{
+  if (point <= classProbabilities[0])
+    return 0; // Go left.
+  else
+    return 1; // Go right.
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -138,6 +138,11 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
   if (skipPruning)
     return dtree;
 
+  // Growing the tree is deterministic, so the tree that is pruned with the
+  // optimal alpha at the end is a copy of this one, not a tree grown again.
+  const DTree<MatType, TagType> unprunedTree(*dtree);
+  const double unprunedAlpha = alpha;
+
   if (folds == dataset.n_cols)
     Log::Info << "Performing leave-one-out cross validation." << std::endl;
   else
@@ -176,15 +181,19 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
   const MatType cvData(dataset);
   const size_t testSize = dataset.n_cols / folds;
 
-  arma::vec regularizationConstants(prunedSequence.size());
-  regularizationConstants.fill(0.0);
+  // The regularization constants of each fold are summed once all the folds
+  // are done, in order, so that the result does not depend on the number of
+  // threads.
+  arma::mat foldRegularizationConstants(prunedSequence.size(), folds);
 
   Timer::Start("cross_validation");
-  // Go through each fold.  On the Visual Studio compiler, we have to use
-  // intmax_t because size_t is not yet supported by their OpenMP
-  // implementation. omp_size_t is the appropriate type according to the
-  // platform.
-  #pragma omp parallel for shared(prunedSequence, regularizationConstants)
+  // Go through each fold.  The folds are handled concurrently; the growth of
+  // each fold's tree can also spread over idle threads.  On the Visual Studio
+  // compiler, we have to use intmax_t because size_t is not yet supported by
+  // their OpenMP implementation. omp_size_t is the appropriate type according
+  // to the platform.
+  #pragma omp parallel for schedule(dynamic) \
+      shared(prunedSequence, foldRegularizationConstants)
   for (omp_size_t fold = 0; fold < (omp_size_t) folds; fold++)
   {
     // Break up data into train and test sets.
@@ -258,9 +267,13 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
       cvRegularizationConstants[prunedSequence.size() - 2] += 2.0 * cvVal
         / (double) cvData.n_cols;
 
-    #pragma omp critical(DTreeCVUpdate)
-    regularizationConstants += cvRegularizationConstants;
+    foldRegularizationConstants.col(fold) = cvRegularizationConstants;
   }
+
+  arma::vec regularizationConstants(prunedSequence.size());
+  regularizationConstants.fill(0.0);
+  for (size_t fold = 0; fold < folds; ++fold)
+    regularizationConstants += foldRegularizationConstants.col(fold);
   Timer::Stop("cross_validation");
 
   double optimalAlpha = -1.0;
@@ -282,30 +295,16 @@ DTree<MatType, TagType>* Trainer(MatType& dataset,
 
   Log::Info << "Optimal alpha: " << optimalAlpha << "." << std::endl;
 
-  // Re-Initialize the tree.
-  delete dtree;
-  dtree = new DTree<MatType, TagType>(dataset);
-
-  // Getting ready to grow the tree...
-  for (size_t i = 0; i < oldFromNew.n_elem; ++i)
-    oldFromNew[i] = i;
-
-  // Save the dataset since it would be modified while growing the tree.
-  newDataset = dataset;
-
-  // Grow the tree.
+  // Restore the unpruned tree.
+  *dtree = unprunedTree;
   oldAlpha = -DBL_MAX;
-  alpha = dtree->Grow(newDataset,
-                         oldFromNew,
-                         useVolumeReg,
-                         maxLeafSize,
-                         minLeafSize);
+  alpha = unprunedAlpha;
 
   // Prune with optimal alpha.
   while ((oldAlpha < optimalAlpha) && (dtree->SubtreeLeaves() > 1))
   {
     oldAlpha = alpha;
-    alpha = dtree->PruneAndUpdate(oldAlpha, newDataset.n_cols, useVolumeReg);
+    alpha = dtree->PruneAndUpdate(oldAlpha, dataset.n_cols, useVolumeReg);
 
     // Some sanity checks.
     Log::Assert((alpha < std::numeric_limits<double>::max()) ||
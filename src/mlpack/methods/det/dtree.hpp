@@ -353,8 +353,25 @@ class DTree
                    const ElemType splitValue,
                    arma::Col<size_t>& oldFromNew) const;
 
+  /**
+   * Grow the children of this node, which has just been split.  The children
+   * hold disjoint ranges of the dataset and of oldFromNew, so the children of
+   * large nodes of dense datasets are grown in parallel with OpenMP tasks.
+   */
+  void GrowChildren(MatType& data,
+                    arma::Col<size_t>& oldFromNew,
+                    const bool useVolReg,
+                    const size_t maxLeafSize,
+                    const size_t minLeafSize,
+                    double& leftG,
+                    double& rightG);
+
   void  FillMinMax(const StatType& mins,
                    const StatType& maxs);
+
+  //! The number of points from which the children of a node are grown in
+  //! parallel.
+  static constexpr size_t ParallelGrowThreshold = 8192;
 };
 
 } // namespace det
@@ -15,6 +15,10 @@
 #include <stack>
 #include <vector>
 
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
 using namespace mlpack;
 using namespace det;
 
@@ -450,17 +454,17 @@ bool DTree<MatType, TagType>::FindSplit(const MatType& data,
 
   const size_t points = end - start;
 
-  double minError = logNegError;
-  bool splitFound = false;
+  // The best split of each dimension.  The dimensions are searched in
+  // parallel, and the best of them is chosen afterwards in order, so that ties
+  // are always broken the same way.
+  std::vector<double> dimErrors(maxVals.n_elem, -DBL_MAX);
+  std::vector<double> dimLeftErrors(maxVals.n_elem);
+  std::vector<double> dimRightErrors(maxVals.n_elem);
+  std::vector<ElemType> dimSplitValues(maxVals.n_elem);
 
   // Loop through each dimension.
-#ifdef _WIN32
-  #pragma omp parallel for default(shared)
-  for (intmax_t dim = 0; dim < (intmax_t) maxVals.n_elem; ++dim)
-#else
-  #pragma omp parallel for default(shared)
-  for (size_t dim = 0; dim < maxVals.n_elem; ++dim)
-#endif
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t dim = 0; dim < (omp_size_t) maxVals.n_elem; ++dim)
   {
     const ElemType min = minVals[dim];
     const ElemType max = maxVals[dim];
@@ -469,9 +473,6 @@ bool DTree<MatType, TagType>::FindSplit(const MatType& data,
     if (max - min == 0.0)
       continue; // Skip to next dimension.
 
-    // Find the log volume of all the other dimensions.
-    const double volumeWithoutDim = logVolume - std::log(max - min);
-
     // Initializing all other stuff for this dimension.
     bool dimSplitFound = false;
     // Take an error estimate for this dimension.
@@ -528,21 +529,42 @@ bool DTree<MatType, TagType>::FindSplit(const MatType& data,
       }
     }
 
-    const double actualMinDimError = std::log(minDimError)
+    if (dimSplitFound)
+    {
+      dimErrors[dim] = minDimError;
+      dimLeftErrors[dim] = dimLeftError;
+      dimRightErrors[dim] = dimRightError;
+      dimSplitValues[dim] = dimSplitValue;
+    }
+  }
+
+  double minError = logNegError;
+  bool splitFound = false;
+  for (size_t dim = 0; dim < maxVals.n_elem; ++dim)
+  {
+    if (dimErrors[dim] == -DBL_MAX)
+      continue;
+
+    // Find the log volume of all the other dimensions.
+    const double volumeWithoutDim = logVolume -
+        std::log(maxVals[dim] - minVals[dim]);
+
+    const double actualMinDimError = std::log(dimErrors[dim])
       - 2 * std::log((double) data.n_cols)
       - volumeWithoutDim;
 
-#pragma omp critical(DTreeFindUpdate)
-    if ((actualMinDimError > minError) && dimSplitFound)
+    if (actualMinDimError > minError)
     {
       // Calculate actual error (in logspace) by adding terms back to our
       // estimate.
       minError = actualMinDimError;
       splitDim = dim;
-      splitValue = dimSplitValue;
-      leftError = std::log(dimLeftError) - 2 * std::log((double) data.n_cols)
+      splitValue = dimSplitValues[dim];
+      leftError = std::log(dimLeftErrors[dim])
+        - 2 * std::log((double) data.n_cols)
         - volumeWithoutDim;
-      rightError = std::log(dimRightError) - 2 * std::log((double) data.n_cols)
+      rightError = std::log(dimRightErrors[dim])
+        - 2 * std::log((double) data.n_cols)
         - volumeWithoutDim;
       splitFound = true;
     } // end if better split found in this dimension.
@@ -637,10 +659,8 @@ double DTree<MatType, TagType>::Grow(MatType& data,
       left = new DTree(maxValsL, minValsL, start, splitIndex, leftError);
       right = new DTree(maxValsR, minValsR, splitIndex, end, rightError);
 
-      leftG = left->Grow(data, oldFromNew, useVolReg, maxLeafSize,
-                         minLeafSize);
-      rightG = right->Grow(data, oldFromNew, useVolReg, maxLeafSize,
-                           minLeafSize);
+      GrowChildren(data, oldFromNew, useVolReg, maxLeafSize, minLeafSize,
+          leftG, rightG);
 
       // Store values of R(T~) and |T~|.
       subtreeLeaves = left->SubtreeLeaves() + right->SubtreeLeaves();
@@ -735,6 +755,48 @@ double DTree<MatType, TagType>::Grow(MatType& data,
 }
 
 
+template<typename MatType, typename TagType>
+void DTree<MatType, TagType>::GrowChildren(MatType& data,
+                                           arma::Col<size_t>& oldFromNew,
+                                           const bool useVolReg,
+                                           const size_t maxLeafSize,
+                                           const size_t minLeafSize,
+                                           double& leftG,
+                                           double& rightG)
+{
+  // OpenMP tasks need OpenMP 3.0; otherwise the children are grown one after
+  // the other.
+  #if defined(_OPENMP) && _OPENMP >= 200805
+  // Swapping columns of a sparse matrix moves the elements of the other
+  // columns too, so only dense datasets can be split concurrently.
+  if (!arma::is_SpMat<MatType>::value && end - start >= ParallelGrowThreshold &&
+      omp_get_max_threads() > 1)
+  {
+    // Start a team at the first large node; below it, the tasks are spread
+    // over the threads of that team.
+    if (!omp_in_parallel())
+    {
+      #pragma omp parallel
+      #pragma omp single
+      GrowChildren(data, oldFromNew, useVolReg, maxLeafSize, minLeafSize,
+          leftG, rightG);
+      return;
+    }
+
+    #pragma omp task default(shared)
+    leftG = left->Grow(data, oldFromNew, useVolReg, maxLeafSize, minLeafSize);
+    #pragma omp task default(shared)
+    rightG = right->Grow(data, oldFromNew, useVolReg, maxLeafSize,
+        minLeafSize);
+    #pragma omp taskwait
+    return;
+  }
+  #endif
+
+  leftG = left->Grow(data, oldFromNew, useVolReg, maxLeafSize, minLeafSize);
+  rightG = right->Grow(data, oldFromNew, useVolReg, maxLeafSize, minLeafSize);
+}
+
 template<typename MatType, typename TagType>
 double DTree<MatType, TagType>::PruneAndUpdate(const double oldAlpha,
                                                const size_t points,
@@ -0,0 +1,104 @@
+/**
+ * @file methods/emst/concurrent_union_find.hpp
+ *
+ * A union-find data structure that can be used by several threads at once.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_EMST_CONCURRENT_UNION_FIND_HPP
+#define MLPACK_METHODS_EMST_CONCURRENT_UNION_FIND_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <atomic>
+
+namespace mlpack {
+namespace emst {
+
+/**
+ * A lock-free union-find data structure.  Like UnionFind, it tracks the
+ * components of a graph, but Find() and Union() may be called concurrently
+ * from several threads.
+ *
+ * The parent of each element is stored atomically.  Union() links the root
+ * with the larger index below the root with the smaller index with a single
+ * compare-and-swap, retrying if another thread changed the root in the
+ * meantime; since links always point to a smaller index, no cycle can form.
+ * Find() shortens the paths it follows by path halving.
+ */
+class ConcurrentUnionFind
+{
+ public:
+  //! Construct the object with the given size.
+  ConcurrentUnionFind(const size_t size) : parent(size)
+  {
+    for (size_t i = 0; i < size; ++i)
+      parent[i].store(i);
+  }
+
+  /**
+   * Returns the component containing an element.
+   *
+   * @param x The element to find the component of.
+   * @return The index of the component containing x.
+   */
+  size_t Find(size_t x)
+  {
+    size_t p = parent[x].load();
+    while (p != x)
+    {
+      // Path halving: point x at its grandparent.  If this fails, another
+      // thread has already changed the parent of x, which is fine.
+      const size_t grandparent = parent[p].load();
+      if (grandparent != p)
+        parent[x].compare_exchange_weak(p, grandparent);
+
+      x = grandparent;
+      p = parent[x].load();
+    }
+
+    return x;
+  }
+
+  /**
+   * Union the components containing x and y.
+   *
+   * @param x One element.
+   * @param y The other element.
+   * @return true if the components were different and have been united by
+   *     this call, false if x and y were already in the same component.
+   */
+  bool Union(size_t x, size_t y)
+  {
+    while (true)
+    {
+      x = Find(x);
+      y = Find(y);
+      if (x == y)
+        return false;
+
+      // Link the root with the larger index below the other root.  This only
+      // succeeds if it is still a root.
+      if (x < y)
+        std::swap(x, y);
+
+      size_t expected = x;
+      if (parent[x].compare_exchange_strong(expected, y))
+        return true;
+    }
+  }
+
+  //! Get the number of elements.
+  size_t Size() const { return parent.size(); }
+
+ private:
+  //! The parent of each element; roots are their own parents.
+  std::vector<std::atomic<size_t>> parent;
+}; // class ConcurrentUnionFind
+
+} // namespace emst
+} // namespace mlpack
+
+#endif // MLPACK_METHODS_EMST_CONCURRENT_UNION_FIND_HPP
@@ -27,6 +27,7 @@
 
 #include "dtb_stat.hpp"
 #include "edge_pair.hpp"
+#include "concurrent_union_find.hpp"
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
@@ -103,7 +104,7 @@ class DualTreeBoruvka
   std::vector<EdgePair> edges; // We must use vector with non-numerical types.
 
   //! Connections.
-  UnionFind connections;
+  ConcurrentUnionFind connections;
 
   //! List of edge nodes.
   arma::Col<size_t> neighborsInComponent;
@@ -118,6 +119,14 @@ class DualTreeBoruvka
   //! The instantiated metric.
   MetricType metric;
 
+  //! The core distance of each point (in the order of the tree's dataset), if
+  //! the mutual reachability MST is being computed; otherwise empty.
+  arma::vec coreDistances;
+
+  //! The depth of the tree at which each round's traversal is split into
+  //! parallel tasks (0 means the traversal is not split).
+  size_t parallelDepth;
+
   //! For sorting the edge list after the computation.
   struct SortEdgesHelper
   {
@@ -175,14 +184,57 @@ class DualTreeBoruvka
    */
   void ComputeMST(arma::mat& results);
 
+  /**
+   * Compute the minimum spanning tree under the mutual reachability distance
+   * max(d(a, b), core(a), core(b)) instead of the metric, as used by density
+   * based clustering (e.g. HDBSCAN).  The results have the same format as the
+   * other overload, and the third row holds the mutual reachability distances.
+   * The core distances are given in the order of the original dataset.
+   *
+   * @param coreDistances The core distance of each point.
+   * @param results Matrix which results will be stored in.
+   */
+  void ComputeMST(const arma::vec& coreDistances, arma::mat& results);
+
+  /**
+   * Get the depth of the tree at which the traversal of each Boruvka round is
+   * split into independent parallel tasks.  If this is 0 (the default), or if
+   * mlpack was compiled without OpenMP, the dual-tree traversals are performed
+   * on a single thread.  (The naive computation is always parallel when
+   * OpenMP is available.)
+   */
+  size_t ParallelDepth() const { return parallelDepth; }
+  /**
+   * Modify the depth of the tree at which the traversal of each Boruvka round
+   * is split into independent parallel tasks.  Each node at this depth (or
+   * each leaf above it) is traversed against the whole tree as a separate
+   * task; the tasks share the candidate edge of each component, which is
+   * updated under a lock.
+   */
+  size_t& ParallelDepth() { return parallelDepth; }
+
  private:
   /**
-   * Adds a single edge to the edge list
+   * Adds a single edge to the given edge list.
+   */
+  static void AddEdge(std::vector<EdgePair>& edgeList,
+                      const size_t e1,
+                      const size_t e2,
+                      const double distance);
+
+  /**
+   * Find the candidate edge of each component for one Boruvka round, with the
+   * naive computation or the dual-tree traversal (in parallel, if possible).
+   *
+   * @param rules The rules to use; the base cases and scores of all threads
+   *     are added to it.
    */
-  void AddEdge(const size_t e1, const size_t e2, const double distance);
+  template<typename RuleType>
+  void FindCandidates(RuleType& rules);
 
   /**
-   * Adds all the edges found in one iteration to the list of neighbors.
+   * Adds all the edges found in one iteration to the list of neighbors.  The
+   * candidate edges of the components are merged in parallel if possible.
    */
   void AddAllEdges();
 
@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_EMST_DTB_IMPL_HPP
 
 #include "dtb_rules.hpp"
+#include <mlpack/core/tree/traversal_tasks.hpp>
 
 namespace mlpack {
 namespace emst {
@@ -59,7 +60,8 @@ DualTreeBoruvka<MetricType, MatType, TreeType>::DualTreeBoruvka(
     naive(naive),
     connections(dataset.n_cols),
     totalDist(0.0),
-    metric(metric)
+    metric(metric),
+    parallelDepth(0)
 {
   edges.reserve(data.n_cols - 1); // Set size.
 
@@ -84,7 +86,8 @@ DualTreeBoruvka<MetricType, MatType, TreeType>::DualTreeBoruvka(
     naive(false),
     connections(data.n_cols),
     totalDist(0.0),
-    metric(metric)
+    metric(metric),
+    parallelDepth(0)
 {
   edges.reserve(data.n_cols - 1); // Fill with EdgePairs.
 
@@ -125,21 +128,11 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
 
   typedef DTBRules<MetricType, Tree> RuleType;
   RuleType rules(data, connections, neighborsDistances, neighborsInComponent,
-                 neighborsOutComponent, metric);
+                 neighborsOutComponent, metric, NULL,
+                 (coreDistances.n_elem > 0) ? &coreDistances : NULL);
   while (edges.size() < (data.n_cols - 1))
   {
-    if (naive)
-    {
-      // Full O(N^2) traversal.
-      for (size_t i = 0; i < data.n_cols; ++i)
-        for (size_t j = 0; j < data.n_cols; ++j)
-          rules.BaseCase(i, j);
-    }
-    else
-    {
-      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-      traverser.Traverse(*tree, *tree);
-    }
+    FindCandidates(rules);
 
     AddAllEdges();
 
@@ -162,7 +155,129 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
 }
 
 /**
- * Adds a single edge to the edge list
+ * Compute the MST under the mutual reachability distance.
+ */
+template<
+    typename MetricType,
+    typename MatType,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
+    const arma::vec& coreDistances,
+    arma::mat& results)
+{
+  if (coreDistances.n_elem != data.n_cols)
+  {
+    std::stringstream ss;
+    ss << "DualTreeBoruvka::ComputeMST(): the number of core distances ("
+        << coreDistances.n_elem << ") must be equal to the number of points ("
+        << data.n_cols << ")!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  // The rules see the points in the order of the tree's dataset.
+  if (!naive && ownTree && tree::TreeTraits<Tree>::RearrangesDataset)
+  {
+    this->coreDistances.set_size(data.n_cols);
+    for (size_t i = 0; i < data.n_cols; ++i)
+      this->coreDistances[i] = coreDistances[oldFromNew[i]];
+  }
+  else
+  {
+    this->coreDistances = coreDistances;
+  }
+
+  ComputeMST(results);
+  this->coreDistances.reset();
+}
+
+/**
+ * Find the candidate edge of each component for one round.
+ */
+template<
+    typename MetricType,
+    typename MatType,
+    template<typename TreeMetricType,
+             typename TreeStatType,
+             typename TreeMatType> class TreeType>
+template<typename RuleType>
+void DualTreeBoruvka<MetricType, MatType, TreeType>::FindCandidates(
+    RuleType& rules)
+{
+  // Compress the paths of the union-find structure, so that finding the
+  // component of a point during the traversal takes one step.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    connections.Find(i);
+
+  #ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  std::vector<Tree*> tasks;
+  if (!naive && parallelDepth > 0 && numThreads > 1)
+    tree::CollectTaskNodes(*tree, parallelDepth, tasks);
+
+  if (numThreads > 1 && (naive || tasks.size() > 1))
+  {
+    // The candidate of each component is shared by all threads and guarded by
+    // a set of locks.  Each thread gets its own copy of the rules for the
+    // traversal information and the counters.  The traversal only writes the
+    // statistics of query nodes, and each query subtree is only touched by
+    // the thread that traverses it.
+    neighbor::NodeLocks locks(std::min((size_t) data.n_cols, (size_t) 4096));
+    RuleType sharedRules(data, connections, neighborsDistances,
+        neighborsInComponent, neighborsOutComponent, metric, &locks,
+        (coreDistances.n_elem > 0) ? &coreDistances : NULL);
+    std::vector<RuleType> threadRules(numThreads, sharedRules);
+
+    if (naive)
+    {
+      // Full O(N^2) traversal.
+      #pragma omp parallel for schedule(dynamic, 16) num_threads(numThreads)
+      for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+      {
+        RuleType& threadRule = threadRules[omp_get_thread_num()];
+        for (size_t j = 0; j < data.n_cols; ++j)
+          threadRule.BaseCase(i, j);
+      }
+    }
+    else
+    {
+      #pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+      for (omp_size_t i = 0; i < (omp_size_t) tasks.size(); ++i)
+      {
+        RuleType& threadRule = threadRules[omp_get_thread_num()];
+
+        // Information cached from the previous task refers to another subtree.
+        threadRule.TraversalInfo() = sharedRules.TraversalInfo();
+        typename Tree::template DualTreeTraverser<RuleType>
+            traverser(threadRule);
+        traverser.Traverse(*tasks[i], *tree);
+      }
+    }
+
+    tree::MergeTraversalCounts(rules, threadRules);
+
+    return;
+  }
+  #endif
+
+  if (naive)
+  {
+    // Full O(N^2) traversal.
+    for (size_t i = 0; i < data.n_cols; ++i)
+      for (size_t j = 0; j < data.n_cols; ++j)
+        rules.BaseCase(i, j);
+  }
+  else
+  {
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+    traverser.Traverse(*tree, *tree);
+  }
+}
+
+/**
+ * Adds a single edge to the given edge list.
  */
 template<
     typename MetricType,
@@ -171,6 +286,7 @@ template<
              typename TreeStatType,
              typename TreeMatType> class TreeType>
 void DualTreeBoruvka<MetricType, MatType, TreeType>::AddEdge(
+    std::vector<EdgePair>& edgeList,
     const size_t e1,
     const size_t e2,
     const double distance)
@@ -179,9 +295,9 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::AddEdge(
       "DualTreeBoruvka::AddEdge(): distance cannot be negative.");
 
   if (e1 < e2)
-    edges.push_back(EdgePair(e1, e2, distance));
+    edgeList.push_back(EdgePair(e1, e2, distance));
   else
-    edges.push_back(EdgePair(e2, e1, distance));
+    edgeList.push_back(EdgePair(e2, e1, distance));
 }
 
 /**
@@ -195,18 +311,36 @@ template<
              typename TreeMatType> class TreeType>
 void DualTreeBoruvka<MetricType, MatType, TreeType>::AddAllEdges()
 {
-  for (size_t i = 0; i < data.n_cols; ++i)
+  #pragma omp parallel
   {
-    size_t component = connections.Find(i);
-    size_t inEdge = neighborsInComponent[component];
-    size_t outEdge = neighborsOutComponent[component];
-    if (connections.Find(inEdge) != connections.Find(outEdge))
+    std::vector<EdgePair> threadEdges;
+    double threadDist = 0.0;
+
+    // The candidate of each component is stored at the index of the root of
+    // the component at the time of the traversal; all other entries are still
+    // DBL_MAX.  Union() only succeeds for one of the candidate edges that
+    // connect the same pair of components, so each edge is added once.
+    #pragma omp for
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
     {
-      // totalDist = totalDist + dist;
-      // changed to make this agree with the cover tree code
-      totalDist += neighborsDistances[component];
-      AddEdge(inEdge, outEdge, neighborsDistances[component]);
-      connections.Union(inEdge, outEdge);
+      if (neighborsDistances[i] == DBL_MAX)
+        continue;
+
+      const size_t inEdge = neighborsInComponent[i];
+      const size_t outEdge = neighborsOutComponent[i];
+      if (connections.Union(inEdge, outEdge))
+      {
+        // totalDist = totalDist + dist;
+        // changed to make this agree with the cover tree code
+        threadDist += neighborsDistances[i];
+        AddEdge(threadEdges, inEdge, outEdge, neighborsDistances[i]);
+      }
+    }
+
+    #pragma omp critical
+    {
+      edges.insert(edges.end(), threadEdges.begin(), threadEdges.end());
+      totalDist += threadDist;
     }
   }
 }
@@ -318,8 +452,7 @@ template<
              typename TreeMatType> class TreeType>
 void DualTreeBoruvka<MetricType, MatType, TreeType>::Cleanup()
 {
-  for (size_t i = 0; i < data.n_cols; ++i)
-    neighborsDistances[i] = DBL_MAX;
+  neighborsDistances.fill(DBL_MAX);
 
   if (!naive)
     CleanupHelper(tree);
@@ -15,6 +15,9 @@
 #include <mlpack/prereqs.hpp>
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/methods/hnsw/node_locks.hpp>
+
+#include "concurrent_union_find.hpp"
 
 namespace mlpack {
 namespace emst {
@@ -23,12 +26,32 @@ template<typename MetricType, typename TreeType>
 class DTBRules
 {
  public:
+  /**
+   * Construct the rules.  Copies of the rules share the candidate edges of the
+   * components, so several copies may be used by different threads at once if
+   * a set of locks is given; the candidate of component c is then only
+   * modified while holding lock (c % locks->Size()).
+   *
+   * @param dataSet The data points.
+   * @param connections Components of the tree found so far.
+   * @param neighborsDistances Candidate edge distance of each component.
+   * @param neighborsInComponent Candidate edge point inside each component.
+   * @param neighborsOutComponent Candidate edge point outside each component.
+   * @param metric The instantiated metric.
+   * @param locks Locks guarding the candidates, or NULL if the rules are only
+   *     used by one thread.
+   * @param coreDistances If not NULL, the core distance of each point; the
+   *     mutual reachability distance max(d(a, b), core(a), core(b)) is then
+   *     used instead of the metric.
+   */
   DTBRules(const arma::mat& dataSet,
-           UnionFind& connections,
+           ConcurrentUnionFind& connections,
            arma::vec& neighborsDistances,
            arma::Col<size_t>& neighborsInComponent,
            arma::Col<size_t>& neighborsOutComponent,
-           MetricType& metric);
+           MetricType& metric,
+           neighbor::NodeLocks* locks = NULL,
+           const arma::vec* coreDistances = NULL);
 
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
@@ -102,7 +125,7 @@ class DTBRules
   const arma::mat& dataSet;
 
   //! Stores the tree structure so far
-  UnionFind& connections;
+  ConcurrentUnionFind& connections;
 
   //! The distance to the candidate nearest neighbor for each component.
   arma::vec& neighborsDistances;
@@ -118,6 +141,13 @@ class DTBRules
   //! The instantiated metric.
   MetricType& metric;
 
+  //! The locks guarding the candidates of the components, if any.
+  neighbor::NodeLocks* locks;
+
+  //! The core distance of each point, if the mutual reachability distance is
+  //! used.
+  const arma::vec* coreDistances;
+
   /**
    * Update the bound for the given query node.
    */
@@ -18,11 +18,13 @@ namespace emst {
 template<typename MetricType, typename TreeType>
 DTBRules<MetricType, TreeType>::
 DTBRules(const arma::mat& dataSet,
-         UnionFind& connections,
+         ConcurrentUnionFind& connections,
          arma::vec& neighborsDistances,
          arma::Col<size_t>& neighborsInComponent,
          arma::Col<size_t>& neighborsOutComponent,
-         MetricType& metric)
+         MetricType& metric,
+         neighbor::NodeLocks* locks,
+         const arma::vec* coreDistances)
 :
   dataSet(dataSet),
   connections(connections),
@@ -30,6 +32,8 @@ DTBRules(const arma::mat& dataSet,
   neighborsInComponent(neighborsInComponent),
   neighborsOutComponent(neighborsOutComponent),
   metric(metric),
+  locks(locks),
+  coreDistances(coreDistances),
   baseCases(0),
   scores(0)
 {
@@ -56,14 +60,34 @@ double DTBRules<MetricType, TreeType>::BaseCase(const size_t queryIndex,
     ++baseCases;
     double distance = metric.Evaluate(dataSet.col(queryIndex),
                                       dataSet.col(referenceIndex));
+    if (coreDistances != NULL)
+    {
+      distance = std::max(distance, std::max((*coreDistances)[queryIndex],
+          (*coreDistances)[referenceIndex]));
+    }
 
     if (distance < neighborsDistances[queryComponentIndex])
     {
       Log::Assert(queryIndex != referenceIndex);
 
-      neighborsDistances[queryComponentIndex] = distance;
-      neighborsInComponent[queryComponentIndex] = queryIndex;
-      neighborsOutComponent[queryComponentIndex] = referenceIndex;
+      // Another thread may have found a better candidate for this component
+      // in the meantime, so check again while holding the lock.  Candidate
+      // distances only decrease, so reading a stale value elsewhere only makes
+      // pruning less effective.
+      const size_t lock = (locks == NULL) ? 0 :
+          queryComponentIndex % locks->Size();
+      if (locks != NULL)
+        locks->Lock(lock);
+
+      if (distance < neighborsDistances[queryComponentIndex])
+      {
+        neighborsDistances[queryComponentIndex] = distance;
+        neighborsInComponent[queryComponentIndex] = queryIndex;
+        neighborsOutComponent[queryComponentIndex] = referenceIndex;
+      }
+
+      if (locks != NULL)
+        locks->Unlock(lock);
     }
   }
 
@@ -176,8 +200,14 @@ inline double DTBRules<MetricType, TreeType>::CalculateBound(
   // Now calculate the actual bounds.
   const double worstBound = std::max(worstPointBound, worstChildBound);
   const double bestBound = std::min(bestPointBound, bestChildBound);
-  // We must check that bestBound != DBL_MAX; otherwise, we risk overflow.
-  const double bestAdjustedBound = (bestBound == DBL_MAX) ? DBL_MAX :
+  // We must check that bestBound != DBL_MAX; otherwise, we risk overflow.  The
+  // adjusted bound relies on the triangle inequality along the query node, and
+  // the core distances of the query points can exceed it, so it is not used
+  // for mutual reachability distances.  (The minimum distance between nodes is
+  // still a valid lower bound, because the mutual reachability distance is
+  // never less than the metric.)
+  const double bestAdjustedBound =
+      (bestBound == DBL_MAX || coreDistances != NULL) ? DBL_MAX :
       bestBound + 2 * queryNode.FurthestDescendantDistance();
 
   // Update the relevant quantities in the node.
@@ -0,0 +1,159 @@
+/**
+ * @file methods/fastmks/approximate_mips.hpp
+ *
+ * Definition of the ApproximateMIPS class, which performs approximate maximum
+ * inner product search by reduction to nearest neighbor search.
+ *
+ * The reduction is described in the following paper:
+ *
+ * @code
+ * @inproceedings{bachrach2014speeding,
+ *   title={Speeding up the Xbox recommender system using a euclidean
+ *       transformation for inner-product spaces},
+ *   author={Bachrach, Yoram and Finkelstein, Yehuda and Gilad-Bachrach, Ran
+ *       and Katzir, Liran and Koenigstein, Noam and Nice, Nir and Paquet,
+ *       Ulrich},
+ *   booktitle={Proceedings of the 8th ACM Conference on Recommender Systems},
+ *   pages={257--264},
+ *   year={2014}
+ * }
+ * @endcode
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_FASTMKS_APPROXIMATE_MIPS_HPP
+#define MLPACK_METHODS_FASTMKS_APPROXIMATE_MIPS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/hnsw/hnsw_search.hpp>
+
+namespace mlpack {
+namespace fastmks {
+
+/**
+ * An implementation of approximate maximum inner product search (that is,
+ * max-kernel search with the linear kernel).  Each reference point r is given
+ * one extra coordinate sqrt(M^2 - ||r||^2), where M is the largest norm of any
+ * reference point, and each query point q is given an extra coordinate of 0.
+ * Then ||q' - r'||^2 = ||q||^2 + M^2 - 2 q^T r, so the reference points with
+ * the largest inner products with q are exactly the nearest neighbors of q' in
+ * the augmented space.  Those neighbors are found approximately with a
+ * hierarchical navigable small world graph (neighbor::HNSWSearch), which works
+ * well in high dimensions, where tree-based search degrades to brute force.
+ *
+ * The inner products that are returned are computed exactly; only the set of
+ * returned points is approximate.  The width of the search beam (EfSearch())
+ * trades search speed for recall.
+ *
+ * @tparam MatType Type of data matrix (usually arma::mat).
+ */
+template<typename MatType = arma::mat>
+class ApproximateMIPS
+{
+ public:
+  //! Convenience typedef for the nearest neighbor index.
+  typedef neighbor::HNSWSearch<metric::EuclideanDistance, MatType> IndexType;
+
+  /**
+   * Build the index on the given reference set.
+   *
+   * @param referenceSet Set of reference points.
+   * @param m Number of links of each node of the graph in its upper layers.
+   * @param efConstruction Width of the beam used when building the graph.
+   * @param efSearch Width of the beam used when searching.
+   */
+  ApproximateMIPS(const MatType& referenceSet,
+                  const size_t m = 16,
+                  const size_t efConstruction = 200,
+                  const size_t efSearch = 50);
+
+  /**
+   * Create an untrained index with the given parameters.  Be sure to call
+   * Train() before calling Search().
+   *
+   * @param m Number of links of each node of the graph in its upper layers.
+   * @param efConstruction Width of the beam used when building the graph.
+   * @param efSearch Width of the beam used when searching.
+   */
+  ApproximateMIPS(const size_t m = 16,
+                  const size_t efConstruction = 200,
+                  const size_t efSearch = 50);
+
+  /**
+   * Build the index on the given reference set, replacing any previous index.
+   *
+   * @param referenceSet Set of reference points.
+   */
+  void Train(const MatType& referenceSet);
+
+  /**
+   * Search for the k reference points with (approximately) maximum inner
+   * product with each point in the query set.  The results for each query
+   * point are stored in the corresponding column of the indices and kernels
+   * matrices, in order of decreasing inner product.  If fewer than k points are
+   * found for a query point, the remaining indices are set to SIZE_MAX and the
+   * remaining kernels to -DBL_MAX.
+   *
+   * @param querySet Set of query points.
+   * @param k The number of maximum inner products to find.
+   * @param indices Matrix to store resulting indices in.
+   * @param kernels Matrix to store resulting inner products in.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& indices,
+              arma::mat& kernels) const;
+
+  /**
+   * Search for the k reference points with (approximately) maximum inner
+   * product with each point in the reference set; a point is not returned as
+   * its own candidate.
+   *
+   * @param k The number of maximum inner products to find.
+   * @param indices Matrix to store resulting indices in.
+   * @param kernels Matrix to store resulting inner products in.
+   */
+  void Search(const size_t k,
+              arma::Mat<size_t>& indices,
+              arma::mat& kernels) const;
+
+  //! Get the width of the beam used when searching.
+  size_t EfSearch() const { return index.EfSearch(); }
+  //! Modify the width of the beam used when searching.  Larger values give
+  //! better recall but slower searches.
+  size_t& EfSearch() { return index.EfSearch(); }
+
+  //! Get the largest norm of any reference point.
+  double MaxNorm() const { return maxNorm; }
+  //! Get the nearest neighbor index built on the augmented reference set.
+  const IndexType& Index() const { return index; }
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Compute the exact inner products between the given query points and the
+   * found reference points, replacing the distances in the given matrix.
+   */
+  void ComputeKernels(const MatType& querySet,
+                      const arma::Mat<size_t>& indices,
+                      arma::mat& kernels) const;
+
+  //! The nearest neighbor index on the augmented reference set.
+  IndexType index;
+  //! The largest norm of any reference point.
+  double maxNorm;
+};
+
+} // namespace fastmks
+} // namespace mlpack
+
+// Include implementation.
+#include "approximate_mips_impl.hpp"
+
+#endif
@@ -0,0 +1,176 @@
+/**
+ * @file methods/fastmks/approximate_mips_impl.hpp
+ *
+ * Implementation of the ApproximateMIPS class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_FASTMKS_APPROXIMATE_MIPS_IMPL_HPP
+#define MLPACK_METHODS_FASTMKS_APPROXIMATE_MIPS_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "approximate_mips.hpp"
+
+namespace mlpack {
+namespace fastmks {
+
+template<typename MatType>
+ApproximateMIPS<MatType>::ApproximateMIPS(const MatType& referenceSet,
+                                          const size_t m,
+                                          const size_t efConstruction,
+                                          const size_t efSearch) :
+    index(m, efConstruction, efSearch),
+    maxNorm(0.0)
+{
+  Train(referenceSet);
+}
+
+template<typename MatType>
+ApproximateMIPS<MatType>::ApproximateMIPS(const size_t m,
+                                          const size_t efConstruction,
+                                          const size_t efSearch) :
+    index(m, efConstruction, efSearch),
+    maxNorm(0.0)
+{
+  // Nothing to do.
+}
+
+template<typename MatType>
+void ApproximateMIPS<MatType>::Train(const MatType& referenceSet)
+{
+  const arma::rowvec squaredNorms = arma::sum(arma::square(referenceSet));
+  maxNorm = (referenceSet.n_cols == 0) ? 0.0 :
+      std::sqrt(arma::max(squaredNorms));
+
+  // Append the coordinate that gives every point the same norm.
+  MatType augmented(referenceSet.n_rows + 1, referenceSet.n_cols);
+  augmented.head_rows(referenceSet.n_rows) = referenceSet;
+  for (size_t i = 0; i < referenceSet.n_cols; ++i)
+  {
+    augmented(referenceSet.n_rows, i) = std::sqrt(std::max(maxNorm * maxNorm -
+        squaredNorms[i], 0.0));
+  }
+
+  index.Train(std::move(augmented));
+}
+
+template<typename MatType>
+void ApproximateMIPS<MatType>::Search(const MatType& querySet,
+                                      const size_t k,
+                                      arma::Mat<size_t>& indices,
+                                      arma::mat& kernels) const
+{
+  const MatType& referenceSet = index.ReferenceSet();
+  if (querySet.n_rows + 1 != referenceSet.n_rows)
+  {
+    std::stringstream ss;
+    ss << "ApproximateMIPS::Search(): the number of dimensions in the query set"
+        << " (" << querySet.n_rows << ") must be equal to the number of "
+        << "dimensions in the reference set (" << referenceSet.n_rows - 1
+        << ")!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  if (k > referenceSet.n_cols)
+  {
+    std::stringstream ss;
+    ss << "ApproximateMIPS::Search(): requested value of k (" << k << ") is "
+        << "greater than the number of points in the reference set ("
+        << referenceSet.n_cols << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  // The extra coordinate of each query point is 0.
+  MatType augmented(querySet.n_rows + 1, querySet.n_cols);
+  augmented.head_rows(querySet.n_rows) = querySet;
+  augmented.row(querySet.n_rows).zeros();
+
+  index.Search(augmented, k, indices, kernels);
+  ComputeKernels(querySet, indices, kernels);
+}
+
+template<typename MatType>
+void ApproximateMIPS<MatType>::Search(const size_t k,
+                                      arma::Mat<size_t>& indices,
+                                      arma::mat& kernels) const
+{
+  const MatType& referenceSet = index.ReferenceSet();
+  if (k >= referenceSet.n_cols)
+  {
+    std::stringstream ss;
+    ss << "ApproximateMIPS::Search(): requested value of k (" << k << ") must "
+        << "be less than the number of points in the reference set ("
+        << referenceSet.n_cols << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  const MatType querySet = referenceSet.head_rows(referenceSet.n_rows - 1);
+  MatType augmented(referenceSet);
+  augmented.row(referenceSet.n_rows - 1).zeros();
+
+  // Each point will usually find itself, so one more candidate is needed.
+  arma::Mat<size_t> selfIndices;
+  arma::mat selfDistances;
+  index.Search(augmented, k + 1, selfIndices, selfDistances);
+
+  indices.set_size(k, referenceSet.n_cols);
+  for (size_t i = 0; i < selfIndices.n_cols; ++i)
+  {
+    size_t found = 0;
+    for (size_t j = 0; j < selfIndices.n_rows && found < k; ++j)
+    {
+      if (selfIndices(j, i) == i)
+        continue;
+
+      indices(found++, i) = selfIndices(j, i);
+    }
+  }
+
+  ComputeKernels(querySet, indices, kernels);
+}
+
+template<typename MatType>
+void ApproximateMIPS<MatType>::ComputeKernels(
+    const MatType& querySet,
+    const arma::Mat<size_t>& indices,
+    arma::mat& kernels) const
+{
+  const MatType& referenceSet = index.ReferenceSet();
+  const size_t dimensionality = querySet.n_rows;
+
+  kernels.set_size(indices.n_rows, indices.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) indices.n_cols; ++i)
+  {
+    for (size_t j = 0; j < indices.n_rows; ++j)
+    {
+      const size_t r = indices(j, i);
+      if (r == SIZE_MAX)
+      {
+        kernels(j, i) = -DBL_MAX;
+        continue;
+      }
+
+      kernels(j, i) = arma::dot(querySet.col(i),
+          referenceSet.submat(0, r, dimensionality - 1, r));
+    }
+  }
+}
+
+template<typename MatType>
+template<typename Archive>
+void ApproximateMIPS<MatType>::serialize(Archive& ar,
+                                         const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(index));
+  ar(CEREAL_NVP(maxNorm));
+}
+
+} // namespace fastmks
+} // namespace mlpack
+
+#endif
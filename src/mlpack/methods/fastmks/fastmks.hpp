@@ -302,6 +302,23 @@ class FastMKS
   //! Modify whether or not brute-force (naive) search is used.
   bool& Naive() { return naive; }
 
+  /**
+   * Get the depth of the query tree at which the dual-tree search is split into
+   * independent parallel tasks.  If this is 0 (the default), or if mlpack was
+   * compiled without OpenMP, dual-tree search is performed on a single thread.
+   */
+  size_t ParallelDepth() const { return parallelDepth; }
+  /**
+   * Modify the depth of the query tree at which the dual-tree search is split
+   * into independent parallel tasks.  Each query node at this depth (or each
+   * leaf above it) is traversed against the reference tree as a separate task.
+   * Each thread keeps its own candidate lists, so this requires O(k * n) extra
+   * memory per thread, where n is the number of query points.  Single-tree
+   * search caches kernel evaluations in the reference tree, so it is always
+   * performed on a single thread.
+   */
+  size_t& ParallelDepth() { return parallelDepth; }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -325,6 +342,42 @@ class FastMKS
   //! The instantiated inner-product metric induced by the given kernel.
   metric::IPMetric<KernelType> metric;
 
+  //! The depth of the query tree at which dual-tree search is split into
+  //! parallel tasks (0 means no parallelism).
+  size_t parallelDepth;
+
+  /**
+   * Perform brute-force search of the given query set, in parallel over
+   * blocks of query points.  For the linear kernel, the kernel values between
+   * a block of query points and a block of reference points are computed with
+   * a single matrix product.
+   *
+   * @param querySet Set of query points.
+   * @param k The number of maximum kernels to find.
+   * @param indices Matrix to store resulting indices of max-kernel search in.
+   * @param kernels Matrix to store resulting max-kernel values in.
+   * @param sameSet If true, the query set is the reference set, and a point is
+   *     not returned as its own candidate.
+   */
+  void NaiveSearch(const MatType& querySet,
+                   const size_t k,
+                   arma::Mat<size_t>& indices,
+                   arma::mat& kernels,
+                   const bool sameSet);
+
+  /**
+   * Perform the dual-tree traversal of the given query tree against the
+   * reference tree, storing the results in the given rules object.  If
+   * parallelDepth is nonzero and OpenMP is available, the query tree is split
+   * into independent subtrees that are traversed in parallel with separate
+   * rules objects, and the results are merged back into the given rules.
+   *
+   * @param queryTree Tree built on query points.
+   * @param rules Rules object to use for the traversal.
+   */
+  template<typename RuleType>
+  void DualTreeTraverse(Tree& queryTree, RuleType& rules);
+
   //! Candidate represents a possible candidate point (value, index).
   typedef std::pair<double, size_t> Candidate;
 
@@ -18,6 +18,9 @@
 #include "fastmks_rules.hpp"
 
 #include <mlpack/core/kernels/gaussian_kernel.hpp>
+#include <mlpack/core/kernels/linear_kernel.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
+#include <mlpack/core/tree/traversal_tasks.hpp>
 
 namespace mlpack {
 namespace fastmks {
@@ -35,7 +38,8 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(const bool singleMode,
     treeOwner(true),
     setOwner(true),
     singleMode(singleMode),
-    naive(naive)
+    naive(naive),
+    parallelDepth(0)
 {
   Timer::Start("tree_building");
   if (!naive)
@@ -58,7 +62,8 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(
     treeOwner(true),
     setOwner(false),
     singleMode(singleMode),
-    naive(naive)
+    naive(naive),
+    parallelDepth(0)
 {
   Timer::Start("tree_building");
   if (!naive)
@@ -82,7 +87,8 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(const MatType& referenceSet,
     setOwner(false),
     singleMode(singleMode),
     naive(naive),
-    metric(kernel)
+    metric(kernel),
+    parallelDepth(0)
 {
   Timer::Start("tree_building");
 
@@ -108,7 +114,8 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(
     treeOwner(true),
     setOwner(naive),
     singleMode(singleMode),
-    naive(naive)
+    naive(naive),
+    parallelDepth(0)
 {
   Timer::Start("tree_building");
   if (!naive)
@@ -135,7 +142,8 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(MatType&& referenceSet,
     setOwner(naive),
     singleMode(singleMode),
     naive(naive),
-    metric(kernel)
+    metric(kernel),
+    parallelDepth(0)
 {
   Timer::Start("tree_building");
 
@@ -163,7 +171,8 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(Tree* referenceTree,
     setOwner(false),
     singleMode(singleMode),
     naive(false),
-    metric(referenceTree->Metric())
+    metric(referenceTree->Metric()),
+    parallelDepth(0)
 {
   // Nothing to do.
 }
@@ -180,7 +189,8 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(const FastMKS& other) :
     setOwner(other.referenceTree == NULL),
     singleMode(other.singleMode),
     naive(other.naive),
-    metric(other.metric)
+    metric(other.metric),
+    parallelDepth(other.parallelDepth)
 {
   // Set reference set correctly.
   if (referenceTree)
@@ -201,7 +211,8 @@ FastMKS<KernelType, MatType, TreeType>::FastMKS(FastMKS&& other) :
     setOwner(other.setOwner),
     singleMode(other.singleMode),
     naive(other.naive),
-    metric(std::move(other.metric))
+    metric(std::move(other.metric)),
+    parallelDepth(other.parallelDepth)
 {
   // Clear information from the other.
   other.referenceSet = NULL;
@@ -248,6 +259,7 @@ FastMKS<KernelType, MatType, TreeType>::operator=(const FastMKS& other)
 
   singleMode = other.singleMode;
   naive = other.naive;
+  parallelDepth = other.parallelDepth;
 }
 
 template<typename KernelType,
@@ -267,6 +279,7 @@ FastMKS<KernelType, MatType, TreeType>::operator=(FastMKS&& other)
     singleMode = other.singleMode;
     naive = other.naive;
     metric = std::move(other.metric);
+    parallelDepth = other.parallelDepth;
 
     // Clear information from the other.
     other.referenceSet = nullptr;
@@ -455,33 +468,7 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < querySet.n_cols; ++q)
-    {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-      std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
-
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
-      {
-        const double eval = metric.Kernel().Evaluate(querySet.col(q),
-                                                     referenceSet->col(r));
-
-        if (eval > pqueue.top().first)
-        {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
-        }
-      }
-
-      for (size_t j = 1; j <= k; ++j)
-      {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
-      }
-    }
+    NaiveSearch(querySet, k, indices, kernels, false);
 
     Timer::Stop("computing_products");
 
@@ -562,9 +549,7 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   typedef FastMKSRules<KernelType, Tree> RuleType;
   RuleType rules(*referenceSet, queryTree->Dataset(), k, metric.Kernel());
 
-  typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-
-  traverser.Traverse(*queryTree, *referenceTree);
+  DualTreeTraverse(*queryTree, rules);
 
   Log::Info << rules.BaseCases() << " base cases." << std::endl;
   Log::Info << rules.Scores() << " scores." << std::endl;
@@ -592,36 +577,7 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < referenceSet->n_cols; ++q)
-    {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-      std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
-
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
-      {
-        if (q == r)
-          continue; // Don't return the point as its own candidate.
-
-        const double eval = metric.Kernel().Evaluate(referenceSet->col(q),
-                                                     referenceSet->col(r));
-
-        if (eval > pqueue.top().first)
-        {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
-        }
-      }
-
-      for (size_t j = 1; j <= k; ++j)
-      {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
-      }
-    }
+    NaiveSearch(*referenceSet, k, indices, kernels, true);
 
     Timer::Stop("computing_products");
 
@@ -661,6 +617,146 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   Search(referenceTree, k, indices, kernels);
 }
 
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void FastMKS<KernelType, MatType, TreeType>::NaiveSearch(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& indices,
+    arma::mat& kernels,
+    const bool sameSet)
+{
+  // For dot-product and distance kernels, all the kernel values between a
+  // block of query points and a block of reference points can be computed at
+  // once from one (BLAS) matrix product.
+  const bool batch = std::is_same<MatType, arma::mat>::value &&
+      (kernel::KernelMatrixTraits<KernelType>::IsDotProductKernel ||
+       kernel::KernelMatrixTraits<KernelType>::IsDistanceKernel);
+  const size_t queryBlockSize = batch ? 64 : 1;
+  const size_t referenceBlockSize = 1024;
+  const size_t numBlocks = (querySet.n_cols + queryBlockSize - 1) /
+      queryBlockSize;
+
+  // Each block of query points has its own candidate lists, so the blocks can
+  // be searched in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const size_t begin = b * queryBlockSize;
+    const size_t end = std::min(begin + queryBlockSize,
+        (size_t) querySet.n_cols);
+
+    const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
+    std::vector<CandidateList> pqueues(end - begin,
+        CandidateList(CandidateCmp(), std::vector<Candidate>(k, def)));
+
+    arma::mat products;
+    for (size_t r = 0; r < referenceSet->n_cols; r += referenceBlockSize)
+    {
+      const size_t rEnd = std::min(r + referenceBlockSize,
+          (size_t) referenceSet->n_cols);
+      if (batch)
+      {
+        kernel::KernelMatrix(arma::mat(referenceSet->cols(r, rEnd - 1)),
+            arma::mat(querySet.cols(begin, end - 1)), metric.Kernel(),
+            products);
+      }
+
+      for (size_t q = begin; q < end; ++q)
+      {
+        CandidateList& pqueue = pqueues[q - begin];
+        for (size_t i = r; i < rEnd; ++i)
+        {
+          if (sameSet && q == i)
+            continue; // Don't return the point as its own candidate.
+
+          const double eval = batch ? (double) products(i - r, q - begin) :
+              metric.Kernel().Evaluate(querySet.col(q), referenceSet->col(i));
+
+          if (eval > pqueue.top().first)
+          {
+            Candidate c = std::make_pair(eval, i);
+            pqueue.pop();
+            pqueue.push(c);
+          }
+        }
+      }
+    }
+
+    for (size_t q = begin; q < end; ++q)
+    {
+      CandidateList& pqueue = pqueues[q - begin];
+      for (size_t j = 1; j <= k; ++j)
+      {
+        indices(k - j, q) = pqueue.top().second;
+        kernels(k - j, q) = pqueue.top().first;
+        pqueue.pop();
+      }
+    }
+  }
+}
+
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename RuleType>
+void FastMKS<KernelType, MatType, TreeType>::DualTreeTraverse(
+    Tree& queryTree,
+    RuleType& rules)
+{
+  #ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  if (parallelDepth > 0 && numThreads > 1)
+  {
+    std::vector<Tree*> tasks;
+    tree::CollectTaskNodes(queryTree, parallelDepth, tasks);
+
+    if (tasks.size() > 1)
+    {
+      // Each thread other than the first gets its own copy of the rules, so
+      // that candidate lists, base case caches and traversal information are
+      // never shared.  The dual-tree rules only write the statistics of query
+      // nodes, and each query subtree is only touched by the thread that
+      // traverses it.
+      const typename RuleType::TraversalInfoType initialInfo =
+          rules.TraversalInfo();
+      std::vector<RuleType> threadRules(numThreads - 1, rules);
+      std::vector<size_t> owners(tasks.size());
+
+      #pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+      for (omp_size_t i = 0; i < (omp_size_t) tasks.size(); ++i)
+      {
+        const size_t thread = omp_get_thread_num();
+        RuleType& threadRule = (thread == 0) ? rules : threadRules[thread - 1];
+
+        // Information cached from the previous task refers to another subtree.
+        threadRule.TraversalInfo() = initialInfo;
+        typename Tree::template DualTreeTraverser<RuleType>
+            traverser(threadRule);
+        traverser.Traverse(*tasks[i], *referenceTree);
+        owners[i] = thread;
+      }
+
+      // Merge the results of each task back into the given rules object.
+      tree::MergeTaskResults(rules, threadRules, tasks, owners,
+          [](RuleType& to, RuleType& from, const size_t point)
+          { to.MergeCandidates(from, point); });
+      tree::MergeTraversalCounts(rules, threadRules);
+
+      return;
+    }
+  }
+  #endif
+
+  typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+  traverser.Traverse(queryTree, *referenceTree);
+}
+
 //! Serialize the model.
 template<typename KernelType,
          typename MatType,
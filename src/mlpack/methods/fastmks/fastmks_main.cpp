@@ -64,7 +64,15 @@ BINDING_EXAMPLE(
     "\n\n"
     "This program performs FastMKS using a cover tree.  The base used to build "
     "the cover tree can be specified with the " + PRINT_PARAM_STRING("base") +
-    " parameter.");
+    " parameter."
+    "\n\n"
+    "For the linear kernel, the " + PRINT_PARAM_STRING("approximate") + " flag "
+    "can be specified to instead reduce the search to approximate nearest "
+    "neighbor search with a hierarchical navigable small world graph; this is "
+    "much faster for high-dimensional data, but may miss some of the maximum "
+    "kernels.  The width of the search beam (" +
+    PRINT_PARAM_STRING("ef_search") + ") trades speed for recall, and can be "
+    "changed when a saved model is reused.");
 
 // See also...
 BINDING_SEE_ALSO("Fast max-kernel search tutorial (fastmks)",
@@ -101,6 +109,11 @@ PARAM_INT_IN("k", "Number of maximum kernels to find.", "k", 0);
 PARAM_FLAG("naive", "If true, O(n^2) naive mode is used for computation.", "N");
 PARAM_FLAG("single", "If true, single-tree search is used (as opposed to "
     "dual-tree search.", "S");
+PARAM_FLAG("approximate", "If true, approximate search is performed with a "
+    "hierarchical navigable small world graph (linear kernel only).", "A");
+PARAM_INT_IN("ef_search", "Width of the search beam for approximate search.  "
+    "If 0, the value stored in the model (or 50 for a new model) is used.", "e",
+    0);
 
 PARAM_MATRIX_OUT("kernels", "Output matrix of kernels.", "p");
 PARAM_UMATRIX_OUT("indices", "Output matrix of indices.", "i");
@@ -146,6 +159,18 @@ static void mlpackMain()
   // Naive mode overrides single mode.
   ReportIgnoredParam({{ "naive", true }}, "single");
 
+  ReportIgnoredParam({{ "input_model", true }}, "approximate");
+  ReportIgnoredParam({{ "approximate", true }}, "naive");
+  ReportIgnoredParam({{ "approximate", true }}, "single");
+  ReportIgnoredParam({{ "approximate", true }}, "base");
+  RequireParamValue<int>("ef_search", [](int x) { return x >= 0; }, true,
+      "ef_search must be nonnegative");
+  if (IO::HasParam("approximate") && IO::GetParam<string>("kernel") != "linear")
+  {
+    Log::Fatal << "Approximate search (" << PRINT_PARAM_STRING("approximate")
+        << ") is only available for the linear kernel!" << endl;
+  }
+
   FastMKSModel* model;
   arma::mat referenceData;
   if (IO::HasParam("reference"))
@@ -170,7 +195,12 @@ static void mlpackMain()
     const bool naive = IO::HasParam("naive");
     const bool single = IO::HasParam("single");
 
-    if (kernelType == "linear")
+    if (kernelType == "linear" && IO::HasParam("approximate"))
+    {
+      model->KernelType() = FastMKSModel::LINEAR_KERNEL;
+      model->BuildApproximateModel(std::move(referenceData), 16, 200, 50);
+    }
+    else if (kernelType == "linear")
     {
       LinearKernel lk;
       model->KernelType() = FastMKSModel::LINEAR_KERNEL;
@@ -220,8 +250,16 @@ static void mlpackMain()
   }
 
   // Set search preferences.
-  model->Naive() = IO::HasParam("naive");
-  model->SingleMode() = IO::HasParam("single");
+  if (model->Approximate())
+  {
+    if (IO::GetParam<int>("ef_search") != 0)
+      model->EfSearch() = (size_t) IO::GetParam<int>("ef_search");
+  }
+  else
+  {
+    model->Naive() = IO::HasParam("naive");
+    model->SingleMode() = IO::HasParam("single");
+  }
 
   // Should we do search?
   if (IO::HasParam("k"))
@@ -23,7 +23,8 @@ FastMKSModel::FastMKSModel(const int kernelType) :
     gaussian(NULL),
     epan(NULL),
     triangular(NULL),
-    hyptan(NULL)
+    hyptan(NULL),
+    approximate(NULL)
 {
   // Nothing to do.
 }
@@ -43,7 +44,9 @@ FastMKSModel::FastMKSModel(const FastMKSModel& other) :
     triangular(other.triangular == NULL ? NULL :
         new FastMKS<TriangularKernel>(*other.triangular)),
     hyptan(other.hyptan == NULL ? NULL :
-        new FastMKS<HyperbolicTangentKernel>(*other.hyptan))
+        new FastMKS<HyperbolicTangentKernel>(*other.hyptan)),
+    approximate(other.approximate == NULL ? NULL :
+        new ApproximateMIPS<>(*other.approximate))
 {
   // Nothing to do.
 }
@@ -56,7 +59,8 @@ FastMKSModel::FastMKSModel(FastMKSModel&& other) :
     gaussian(other.gaussian),
     epan(other.epan),
     triangular(other.triangular),
-    hyptan(other.hyptan)
+    hyptan(other.hyptan),
+    approximate(other.approximate)
 {
   // Clear other object.
   other.kernelType = KernelTypes::LINEAR_KERNEL;
@@ -67,6 +71,7 @@ FastMKSModel::FastMKSModel(FastMKSModel&& other) :
   other.epan = NULL;
   other.triangular = NULL;
   other.hyptan = NULL;
+  other.approximate = NULL;
 }
 
 FastMKSModel& FastMKSModel::operator=(const FastMKSModel& other)
@@ -81,6 +86,7 @@ FastMKSModel& FastMKSModel::operator=(const FastMKSModel& other)
     delete epan;
     delete triangular;
     delete hyptan;
+    delete approximate;
 
     // Set pointers to null.
     linear = NULL;
@@ -90,6 +96,7 @@ FastMKSModel& FastMKSModel::operator=(const FastMKSModel& other)
     epan = NULL;
     triangular = NULL;
     hyptan = NULL;
+    approximate = NULL;
 
     kernelType = other.kernelType;
     if (other.linear)
@@ -106,6 +113,8 @@ FastMKSModel& FastMKSModel::operator=(const FastMKSModel& other)
       triangular = new FastMKS<TriangularKernel>(*other.triangular);
     if (other.hyptan)
       hyptan = new FastMKS<HyperbolicTangentKernel>(*other.hyptan);
+    if (other.approximate)
+      approximate = new ApproximateMIPS<>(*other.approximate);
   }
   return *this;
 }
@@ -122,6 +131,7 @@ FastMKSModel& FastMKSModel::operator=(FastMKSModel&& other)
     epan = other.epan;
     triangular = other.triangular;
     hyptan = other.hyptan;
+    approximate = other.approximate;
 
     // Clear other object.
     other.kernelType = KernelTypes::LINEAR_KERNEL;
@@ -132,6 +142,7 @@ FastMKSModel& FastMKSModel::operator=(FastMKSModel&& other)
     other.epan = nullptr;
     other.triangular = nullptr;
     other.hyptan = nullptr;
+    other.approximate = nullptr;
   }
   return *this;
 }
@@ -153,6 +164,65 @@ FastMKSModel::~FastMKSModel()
     delete triangular;
   if (hyptan)
     delete hyptan;
+  if (approximate)
+    delete approximate;
+}
+
+void FastMKSModel::BuildApproximateModel(arma::mat&& referenceData,
+                                         const size_t m,
+                                         const size_t efConstruction,
+                                         const size_t efSearch)
+{
+  if (kernelType != LINEAR_KERNEL)
+  {
+    throw std::invalid_argument("FastMKSModel::BuildApproximateModel(): "
+        "approximate search is only available for the linear kernel!");
+  }
+
+  // Clean memory if necessary.
+  delete linear;
+  delete polynomial;
+  delete cosine;
+  delete gaussian;
+  delete epan;
+  delete triangular;
+  delete hyptan;
+  delete approximate;
+
+  linear = NULL;
+  polynomial = NULL;
+  cosine = NULL;
+  gaussian = NULL;
+  epan = NULL;
+  triangular = NULL;
+  hyptan = NULL;
+
+  Timer::Start("graph_building");
+  approximate = new ApproximateMIPS<>(m, efConstruction, efSearch);
+  approximate->Train(referenceData);
+  Timer::Stop("graph_building");
+}
+
+size_t FastMKSModel::EfSearch() const
+{
+  if (!approximate)
+  {
+    throw std::invalid_argument("FastMKSModel::EfSearch(): the model does not "
+        "use approximate search");
+  }
+
+  return approximate->EfSearch();
+}
+
+size_t& FastMKSModel::EfSearch()
+{
+  if (!approximate)
+  {
+    throw std::invalid_argument("FastMKSModel::EfSearch(): the model does not "
+        "use approximate search");
+  }
+
+  return approximate->EfSearch();
 }
 
 bool FastMKSModel::Naive() const
@@ -160,7 +230,7 @@ bool FastMKSModel::Naive() const
   switch (kernelType)
   {
     case LINEAR_KERNEL:
-      return linear->Naive();
+      return (approximate != NULL) ? false : linear->Naive();
     case POLYNOMIAL_KERNEL:
       return polynomial->Naive();
     case COSINE_DISTANCE:
@@ -180,6 +250,12 @@ bool FastMKSModel::Naive() const
 
 bool& FastMKSModel::Naive()
 {
+  if (approximate)
+  {
+    throw std::invalid_argument("FastMKSModel::Naive(): approximate models "
+        "do not use naive search");
+  }
+
   switch (kernelType)
   {
     case LINEAR_KERNEL:
@@ -206,7 +282,7 @@ bool FastMKSModel::SingleMode() const
   switch (kernelType)
   {
     case LINEAR_KERNEL:
-      return linear->SingleMode();
+      return (approximate != NULL) ? false : linear->SingleMode();
     case POLYNOMIAL_KERNEL:
       return polynomial->SingleMode();
     case COSINE_DISTANCE:
@@ -226,6 +302,12 @@ bool FastMKSModel::SingleMode() const
 
 bool& FastMKSModel::SingleMode()
 {
+  if (approximate)
+  {
+    throw std::invalid_argument("FastMKSModel::SingleMode(): approximate models "
+        "do not use single-tree search");
+  }
+
   switch (kernelType)
   {
     case LINEAR_KERNEL:
@@ -256,7 +338,10 @@ void FastMKSModel::Search(const arma::mat& querySet,
   switch (kernelType)
   {
     case LINEAR_KERNEL:
-      Search(*linear, querySet, k, indices, kernels, base);
+      if (approximate)
+        approximate->Search(querySet, k, indices, kernels);
+      else
+        Search(*linear, querySet, k, indices, kernels, base);
       break;
     case POLYNOMIAL_KERNEL:
       Search(*polynomial, querySet, k, indices, kernels, base);
@@ -288,7 +373,10 @@ void FastMKSModel::Search(const size_t k,
   switch (kernelType)
   {
     case LINEAR_KERNEL:
-      linear->Search(k, indices, kernels);
+      if (approximate)
+        approximate->Search(k, indices, kernels);
+      else
+        linear->Search(k, indices, kernels);
       break;
     case POLYNOMIAL_KERNEL:
       polynomial->Search(k, indices, kernels);
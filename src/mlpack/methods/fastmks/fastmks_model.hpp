@@ -14,6 +14,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include "fastmks.hpp"
+#include "approximate_mips.hpp"
 #include <mlpack/core/kernels/kernel_traits.hpp>
 #include <mlpack/core/kernels/linear_kernel.hpp>
 #include <mlpack/core/kernels/polynomial_kernel.hpp>
@@ -79,6 +80,31 @@ class FastMKSModel
                   const bool naive,
                   const double base);
 
+  /**
+   * Build an approximate model on the given reference set.  This is only
+   * possible for the linear kernel: maximum inner product search is reduced to
+   * nearest neighbor search, which is performed with an HNSW graph (see
+   * ApproximateMIPS).  Make sure kernelType is LINEAR_KERNEL!
+   *
+   * @param referenceData Set of reference points.
+   * @param m Number of links of each node of the graph in its upper layers.
+   * @param efConstruction Width of the beam used when building the graph.
+   * @param efSearch Width of the beam used when searching.
+   */
+  void BuildApproximateModel(arma::mat&& referenceData,
+                             const size_t m,
+                             const size_t efConstruction,
+                             const size_t efSearch);
+
+  //! Get whether or not approximate search is used.
+  bool Approximate() const { return approximate != NULL; }
+
+  //! Get the width of the search beam of an approximate model.
+  size_t EfSearch() const;
+  //! Modify the width of the search beam of an approximate model.  Larger
+  //! values give better recall, at the cost of slower searches.
+  size_t& EfSearch();
+
   //! Get whether or not naive search is used.
   bool Naive() const;
   //! Set whether or not naive search is used.
@@ -129,7 +155,7 @@ class FastMKSModel
    * Serialize the model.
    */
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */);
+  void serialize(Archive& ar, const uint32_t version);
 
  private:
   //! The type of kernel we are using.
@@ -149,6 +175,9 @@ class FastMKSModel
   FastMKS<kernel::TriangularKernel>* triangular;
   //! This will only be non-NULL if this is the type of kernel we are using.
   FastMKS<kernel::HyperbolicTangentKernel>* hyptan;
+  //! This will only be non-NULL if approximate search with the linear kernel
+  //! is used (in which case linear is NULL).
+  ApproximateMIPS<>* approximate;
 
   //! Build a query tree and execute the search.
   template<typename FastMKSType>
@@ -163,6 +192,9 @@ class FastMKSModel
 } // namespace fastmks
 } // namespace mlpack
 
+//! Version 1 added approximate models.
+CEREAL_CLASS_VERSION(mlpack::fastmks::FastMKSModel, 1);
+
 #include "fastmks_model_impl.hpp"
 
 #endif
@@ -82,6 +82,8 @@ void FastMKSModel::BuildModel(arma::mat&& referenceData,
     delete triangular;
   if (hyptan)
     delete hyptan;
+  if (approximate)
+    delete approximate;
 
   linear = NULL;
   polynomial = NULL;
@@ -90,6 +92,7 @@ void FastMKSModel::BuildModel(arma::mat&& referenceData,
   epan = NULL;
   triangular = NULL;
   hyptan = NULL;
+  approximate = NULL;
 
   // Instantiate the right model.
   switch (kernelType)
@@ -132,10 +135,17 @@ void FastMKSModel::BuildModel(arma::mat&& referenceData,
 }
 
 template<typename Archive>
-void FastMKSModel::serialize(Archive& ar, const uint32_t /* version */)
+void FastMKSModel::serialize(Archive& ar, const uint32_t version)
 {
   ar(CEREAL_NVP(kernelType));
 
+  // Models saved before approximate search was added are never approximate.
+  bool isApproximate = (approximate != NULL);
+  if (version >= 1)
+    ar(CEREAL_NVP(isApproximate));
+  else if (cereal::is_loading<Archive>())
+    isApproximate = false;
+
   if (cereal::is_loading<Archive>())
   {
     // Clean memory.
@@ -153,6 +163,8 @@ void FastMKSModel::serialize(Archive& ar, const uint32_t /* version */)
       delete triangular;
     if (hyptan)
       delete hyptan;
+    if (approximate)
+      delete approximate;
 
     linear = NULL;
     polynomial = NULL;
@@ -161,13 +173,17 @@ void FastMKSModel::serialize(Archive& ar, const uint32_t /* version */)
     epan = NULL;
     triangular = NULL;
     hyptan = NULL;
+    approximate = NULL;
   }
 
   // Serialize the correct model.
   switch (kernelType)
   {
     case LINEAR_KERNEL:
-      ar(CEREAL_POINTER(linear));
+      if (isApproximate)
+        ar(CEREAL_POINTER(approximate));
+      else
+        ar(CEREAL_POINTER(linear));
       break;
 
     case POLYNOMIAL_KERNEL:
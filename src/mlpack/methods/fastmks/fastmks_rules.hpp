@@ -109,6 +109,16 @@ class FastMKSRules
                  TreeType& referenceNode,
                  const double oldScore) const;
 
+  /**
+   * Merge the candidates of the given query point found by another rules
+   * object (built on the same reference and query sets) into the candidates of
+   * this object.  This is used to combine the results of parallel traversals.
+   *
+   * @param other Rules object to take candidates from.
+   * @param queryIndex Index of the query point whose candidates are merged.
+   */
+  void MergeCandidates(const FastMKSRules& other, const size_t queryIndex);
+
   //! Get the number of times BaseCase() was called.
   size_t BaseCases() const { return baseCases; }
   //! Modify the number of times BaseCase() was called.
@@ -523,6 +523,17 @@ double FastMKSRules<KernelType, TreeType>::CalculateBound(TreeType& queryNode)
  * @param index Index of reference point which is being inserted.
  * @param product Kernel value for given candidate.
  */
+template<typename KernelType, typename TreeType>
+void FastMKSRules<KernelType, TreeType>::MergeCandidates(
+    const FastMKSRules& other,
+    const size_t queryIndex)
+{
+  typedef typename CandidateList::const_iterator CandidateIterator;
+  const CandidateList& otherList = other.candidates[queryIndex];
+  for (CandidateIterator it = otherList.begin(); it != otherList.end(); ++it)
+    InsertNeighbor(queryIndex, it->second, it->first);
+}
+
 template<typename KernelType, typename TreeType>
 inline void FastMKSRules<KernelType, TreeType>::InsertNeighbor(
     const size_t queryIndex,
@@ -45,6 +45,10 @@ template<typename InitialClusteringType = kmeans::KMeans<>,
 class EMFit
 {
  public:
+  //! The type of the function called after each iteration.
+  using IterationCallbackType = std::function<void(
+      const size_t, const std::vector<Distribution>&, const arma::vec&)>;
+
   /**
    * Construct the EMFit object, optionally passing an InitialClusteringType
    * object (just in case it needs to store state).  Setting the maximum number
@@ -127,6 +131,18 @@ class EMFit
   //! Modify the tolerance for the convergence of the EM algorithm.
   double& Tolerance() { return tolerance; }
 
+  /**
+   * Get the function called after each iteration of EM, if any.  It is called
+   * with the number of iterations done so far and the current distributions
+   * and weights, so it can save them (for instance with data::Checkpointer) and
+   * training can be resumed from them with useInitialModel = true.  (It is not
+   * called when the model is fitted by arma::gmm_diag.)
+   */
+  const IterationCallbackType& IterationCallback() const
+  { return iterationCallback; }
+  //! Modify the function called after each iteration of EM.
+  IterationCallbackType& IterationCallback() { return iterationCallback; }
+
   //! Serialize the fitter.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t version);
@@ -148,19 +164,42 @@ class EMFit
       arma::vec& weights);
 
   /**
-   * Calculate the log-likelihood of a model.  Yes, this is reimplemented in the
-   * GMM code.  Intuition suggests that the log-likelihood is not the best way
-   * to determine if the EM algorithm has converged.
+   * Compute the conditional log-probability of each observation being from
+   * each distribution, normalized over the distributions, and return the
+   * log-likelihood of the model.  This is the E-step of the EM algorithm; it is
+   * computed in parallel over blocks of observations.
    *
-   * @param data Data matrix.
-   * @param means Vector of means.
-   * @param dists Distributions to store model in.
+   * @param observations List of observations.
+   * @param dists Distributions of the model.
    * @param weights Vector of a priori weights.
+   * @param condLogProb Matrix to store the conditional log-probabilities in,
+   *     with one row per observation and one column per distribution.
    */
-  double LogLikelihood(
-      const arma::mat& data,
+  double ConditionalLogProbabilities(
+      const arma::mat& observations,
       const std::vector<Distribution>& dists,
-      const arma::vec& weights) const;
+      const arma::vec& weights,
+      arma::mat& condLogProb) const;
+
+  /**
+   * Update the means and covariances of the distributions from the
+   * conditional log-probabilities.  This is the M-step of the EM algorithm; it
+   * is computed in parallel over the distributions.
+   *
+   * @param observations List of observations.
+   * @param condLogProb Conditional log-probabilities from the E-step.
+   * @param logProbabilities Log-probability of each observation, or an empty
+   *     vector if the observations are not weighted.
+   * @param dists Distributions to update.
+   * @param probRowSums Vector to store the log of the total conditional
+   *     probability of each distribution in.
+   */
+  void UpdateDistributions(
+      const arma::mat& observations,
+      const arma::mat& condLogProb,
+      const arma::vec& logProbabilities,
+      std::vector<Distribution>& dists,
+      arma::vec& probRowSums);
 
   /**
    * Use the Armadillo gmm_diag clusterer to train a GMM with diagonal
@@ -178,6 +217,9 @@ class EMFit
       arma::vec& weights,
       const bool useInitialModel);
 
+  //! Number of observations processed at once by the E-step and M-step.
+  static const size_t BlockSize = 1024;
+
   //! Maximum iterations of EM algorithm.
   size_t maxIterations;
   //! Tolerance for convergence of EM.
@@ -186,6 +228,8 @@ class EMFit
   InitialClusteringType clusterer;
   //! Object which applies constraints to the covariance matrix.
   CovarianceConstraintPolicy constraint;
+  //! Function called after each iteration (not serialized).
+  IterationCallbackType iterationCallback;
 };
 
 } // namespace gmm
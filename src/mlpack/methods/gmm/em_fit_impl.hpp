@@ -71,13 +71,17 @@ Estimate(const arma::mat& observations,
   if (!useInitialModel)
     InitialClustering(observations, dists, weights);
 
-  double l = LogLikelihood(observations, dists, weights);
+  // The E-step also gives the log-likelihood of the current model, so each
+  // iteration only evaluates the components once.
+  arma::mat condLogProb;
+  double l = ConditionalLogProbabilities(observations, dists, weights,
+      condLogProb);
 
   Log::Debug << "EMFit::Estimate(): initial clustering log-likelihood: "
       << l << std::endl;
 
   double lOld = -DBL_MAX;
-  arma::mat condLogProb(observations.n_cols, dists.size());
+  arma::vec probRowSums(dists.size());
 
   // Iterate to update the model until no more improvement is found.
   size_t iteration = 1;
@@ -86,81 +90,23 @@ Estimate(const arma::mat& observations,
     Log::Info << "EMFit::Estimate(): iteration " << iteration << ", "
         << "log-likelihood " << l << "." << std::endl;
 
-    // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      // Store conditional log probabilities into condLogProb vector for each
-      // Gaussian.  First we make an alias of the condLogProb vector.
-      arma::vec condLogProbAlias = condLogProb.unsafe_col(i);
-      dists[i].LogProbability(observations, condLogProbAlias);
-      condLogProbAlias += log(weights[i]);
-    }
-
-    // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; ++i)
-    {
-      // Avoid dividing by zero; if the probability for everything is 0, we
-      // don't want to make it NaN.
-      const double probSum = mlpack::math::AccuLog(condLogProb.row(i));
-      if (probSum != -std::numeric_limits<double>::infinity())
-        condLogProb.row(i) -= probSum;
-    }
-
-    // Store the sum of the probability of each state over all the observations.
-    arma::vec probRowSums(dists.size());
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      probRowSums(i) = mlpack::math::AccuLog(condLogProb.col(i));
-    }
-
-    // Calculate the new value of the means using the updated conditional
-    // probabilities.
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      // Don't update if there's no probability of the Gaussian having points.
-      if (probRowSums[i] != -std::numeric_limits<double>::infinity())
-        dists[i].Mean() = observations * arma::exp(condLogProb.col(i) -
-                                                   probRowSums[i]);
-      else
-        continue;
-
-      // Calculate the new value of the covariances using the updated
-      // conditional probabilities and the updated means.
-      arma::mat tmp = observations.each_col() - dists[i].Mean();
-
-      // If the distribution is DiagonalGaussianDistribution, calculate the
-      // covariance only with diagonal components.
-      if (std::is_same<Distribution,
-          distribution::DiagonalGaussianDistribution>::value)
-      {
-        arma::vec covariance = arma::sum((tmp % tmp) %
-            (arma::ones<arma::vec>(observations.n_rows) *
-            trans(arma::exp(condLogProb.col(i) - probRowSums[i]))), 1);
-
-        // Apply covariance constraint.
-        constraint.ApplyConstraint(covariance);
-        dists[i].Covariance(std::move(covariance));
-      }
-      else
-      {
-        arma::mat tmpB = tmp.each_row() % trans(arma::exp(condLogProb.col(i) -
-                                                          probRowSums[i]));
-        arma::mat covariance = tmp * trans(tmpB);
-
-        // Apply covariance constraint.
-        constraint.ApplyConstraint(covariance);
-        dists[i].Covariance(std::move(covariance));
-      }
-    }
+    // Calculate the new means and covariances from the conditional
+    // probabilities of the current model.
+    UpdateDistributions(observations, condLogProb, arma::vec(), dists,
+        probRowSums);
 
     // Calculate the new values for omega using the updated conditional
     // probabilities.
     weights = arma::exp(probRowSums - std::log(observations.n_cols));
 
-    // Update values of l; calculate new log-likelihood.
+    // Update values of l; calculate new log-likelihood and the conditional
+    // probabilities of choosing a particular Gaussian given the observations
+    // and the new theta value.
     lOld = l;
-    l = LogLikelihood(observations, dists, weights);
+    l = ConditionalLogProbabilities(observations, dists, weights, condLogProb);
+
+    if (iterationCallback)
+      iterationCallback(iteration, dists, weights);
 
     iteration++;
   }
@@ -179,93 +125,29 @@ Estimate(const arma::mat& observations,
   if (!useInitialModel)
     InitialClustering(observations, dists, weights);
 
-  double l = LogLikelihood(observations, dists, weights);
+  arma::mat condLogProb;
+  double l = ConditionalLogProbabilities(observations, dists, weights,
+      condLogProb);
 
   Log::Debug << "EMFit::Estimate(): initial clustering log-likelihood: "
       << l << std::endl;
 
   double lOld = -DBL_MAX;
-  arma::mat condLogProb(observations.n_cols, dists.size());
+
+  // This will store the sum of probabilities of each state over all the
+  // observations.
+  arma::vec probRowSums(dists.size());
+  const arma::vec logProbabilities = arma::log(probabilities);
 
   // Iterate to update the model until no more improvement is found.
   size_t iteration = 1;
   while (std::abs(l - lOld) > tolerance && iteration != maxIterations)
   {
-    // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      // Store conditional log probabilities into condLogProb vector for each
-      // Gaussian.  First we make an alias of the condLogProb vector.
-      arma::vec condLogProbAlias = condLogProb.unsafe_col(i);
-      dists[i].LogProbability(observations, condLogProbAlias);
-      condLogProbAlias += log(weights[i]);
-    }
-
-    // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; ++i)
-    {
-      // Avoid dividing by zero; if the probability for everything is 0, we
-      // don't want to make it NaN.
-      const double probSum = mlpack::math::AccuLog(condLogProb.row(i));
-      if (probSum != -std::numeric_limits<double>::infinity())
-        condLogProb.row(i) -= probSum;
-    }
-
-    // This will store the sum of probabilities of each state over all the
-    // observations.
-    arma::vec probRowSums(dists.size());
-
-    // Calculate the new value of the means using the updated conditional
-    // probabilities.
-    arma::vec logProbabilities = arma::log(probabilities);
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      // Calculate the sum of probabilities of points, which is the
-      // conditional probability of each point being from Gaussian i
-      // multiplied by the probability of the point being from this mixture
-      // model.
-      arma::vec tmpProb = condLogProb.col(i) + logProbabilities;
-      probRowSums[i] = mlpack::math::AccuLog(tmpProb);
-
-      // Don't update if there's no probability of the Gaussian having points.
-      if (probRowSums[i] != -std::numeric_limits<double>::infinity())
-      {
-        dists[i].Mean() = observations *
-              arma::exp(condLogProb.col(i) + logProbabilities - probRowSums[i]);
-      }
-      else
-        continue;
-
-      // Calculate the new value of the covariances using the updated
-      // conditional probabilities and the updated means.
-      arma::mat tmp = observations.each_col() - dists[i].Mean();
-
-      // If the distribution is DiagonalGaussianDistribution, calculate the
-      // covariance only with diagonal components.
-      if (std::is_same<Distribution,
-          distribution::DiagonalGaussianDistribution>::value)
-      {
-        arma::vec cov = arma::sum((tmp % tmp) %
-            (arma::ones<arma::vec>(observations.n_rows) *
-            trans(arma::exp(condLogProb.col(i) +
-                            logProbabilities - probRowSums[i]))), 1);
-
-        // Apply covariance constraint.
-        constraint.ApplyConstraint(cov);
-        dists[i].Covariance(std::move(cov));
-      }
-      else
-      {
-        arma::mat tmpB = tmp.each_row() % trans(arma::exp(condLogProb.col(i) +
-            logProbabilities - probRowSums[i]));
-        arma::mat cov = (tmp * trans(tmpB));
-
-        // Apply covariance constraint.
-        constraint.ApplyConstraint(cov);
-        dists[i].Covariance(std::move(cov));
-      }
-    }
+    // Calculate the new means and covariances, where the conditional
+    // probability of each point being from each Gaussian is multiplied by the
+    // probability of the point being from this mixture model.
+    UpdateDistributions(observations, condLogProb, logProbabilities, dists,
+        probRowSums);
 
     // Calculate the new values for omega using the updated conditional
     // probabilities.
@@ -273,7 +155,10 @@ Estimate(const arma::mat& observations,
 
     // Update values of l; calculate new log-likelihood.
     lOld = l;
-    l = LogLikelihood(observations, dists, weights);
+    l = ConditionalLogProbabilities(observations, dists, weights, condLogProb);
+
+    if (iterationCallback)
+      iterationCallback(iteration, dists, weights);
 
     iteration++;
   }
@@ -377,34 +262,138 @@ template<typename InitialClusteringType,
          typename CovarianceConstraintPolicy,
          typename Distribution>
 double EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
-LogLikelihood(const arma::mat& observations,
-              const std::vector<Distribution>& dists,
-              const arma::vec& weights) const
+ConditionalLogProbabilities(const arma::mat& observations,
+                            const std::vector<Distribution>& dists,
+                            const arma::vec& weights,
+                            arma::mat& condLogProb) const
 {
-  double logLikelihood = 0;
+  condLogProb.set_size(observations.n_cols, dists.size());
+  const arma::vec logWeights = arma::log(weights);
+  const size_t numBlocks = (observations.n_cols + BlockSize - 1) / BlockSize;
+
+  // The points are split into blocks, so that each component is evaluated on
+  // a whole block at once (which is a matrix product for Gaussians), and the
+  // blocks are processed in parallel.
+  double logLikelihood = 0.0;
+  omp_size_t outliers = 0;
+  #pragma omp parallel for schedule(dynamic) \
+      reduction(+:logLikelihood, outliers)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const size_t begin = b * BlockSize;
+    const size_t end = std::min(begin + BlockSize,
+        (size_t) observations.n_cols) - 1;
+    const arma::mat block = observations.cols(begin, end);
+
+    // Each column holds the weighted log-probabilities of one point.  It has
+    // to be LogProbability() otherwise Probability() would overflow easily.
+    arma::mat blockLogProb(dists.size(), block.n_cols);
+    arma::vec logProbs;
+    for (size_t i = 0; i < dists.size(); ++i)
+    {
+      dists[i].LogProbability(block, logProbs);
+      blockLogProb.row(i) = trans(logProbs) + logWeights[i];
+    }
 
-  arma::vec logPhis;
-  arma::mat logLikelihoods(dists.size(), observations.n_cols);
+    // Normalize each point.  Avoid dividing by zero; if the probability for
+    // everything is 0, we don't want to make it NaN.
+    for (size_t j = 0; j < block.n_cols; ++j)
+    {
+      const double probSum = mlpack::math::AccuLog(blockLogProb.col(j));
+      if (probSum != -std::numeric_limits<double>::infinity())
+        blockLogProb.col(j) -= probSum;
+      else
+        ++outliers;
 
-  // It has to be LogProbability() otherwise Probability() would overflow easily
-  for (size_t i = 0; i < dists.size(); ++i)
+      logLikelihood += probSum;
+    }
+
+    condLogProb.rows(begin, end) = trans(blockLogProb);
+  }
+
+  if (outliers > 0)
   {
-    dists[i].LogProbability(observations, logPhis);
-    logLikelihoods.row(i) = log(weights(i)) + trans(logPhis);
+    Log::Info << "Likelihood of " << outliers << " points is 0!  They are "
+        << "probably outliers." << std::endl;
   }
-  // Now sum over every point.
-  for (size_t j = 0; j < observations.n_cols; ++j)
+
+  return logLikelihood;
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+UpdateDistributions(const arma::mat& observations,
+                    const arma::mat& condLogProb,
+                    const arma::vec& logProbabilities,
+                    std::vector<Distribution>& dists,
+                    arma::vec& probRowSums)
+{
+  // If the distribution is DiagonalGaussianDistribution, calculate the
+  // covariance only with diagonal components.
+  const bool isDiagGaussDist = std::is_same<Distribution,
+      distribution::DiagonalGaussianDistribution>::value;
+
+  std::vector<arma::vec> means(dists.size());
+  std::vector<typename std::conditional<isDiagGaussDist,
+      arma::vec, arma::mat>::type> covs(dists.size());
+
+  // The components are independent, so they are computed in parallel.  The
+  // centered observations are formed one block at a time, to avoid a copy of
+  // the whole dataset for each component.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
   {
-    if (mlpack::math::AccuLog(logLikelihoods.col(j)) ==
-        -std::numeric_limits<double>::infinity())
+    arma::vec logResponsibilities = condLogProb.col(i);
+    if (!logProbabilities.is_empty())
+      logResponsibilities += logProbabilities;
+
+    probRowSums[i] = mlpack::math::AccuLog(logResponsibilities);
+
+    // Don't update if there's no probability of the Gaussian having points.
+    if (probRowSums[i] == -std::numeric_limits<double>::infinity())
+      continue;
+
+    const arma::rowvec responsibilities =
+        trans(arma::exp(logResponsibilities - probRowSums[i]));
+    means[i] = observations * trans(responsibilities);
+
+    // Calculate the new value of the covariances using the updated
+    // conditional probabilities and the updated means.
+    if (isDiagGaussDist)
+      covs[i].zeros(observations.n_rows);
+    else
+      covs[i].zeros(observations.n_rows, observations.n_rows);
+
+    for (size_t begin = 0; begin < observations.n_cols; begin += BlockSize)
     {
-      Log::Info << "Likelihood of point " << j << " is 0!  It is probably an "
-          << "outlier." << std::endl;
+      const size_t end = std::min(begin + BlockSize,
+          (size_t) observations.n_cols) - 1;
+      const arma::mat tmp = observations.cols(begin, end).each_col() -
+          means[i];
+      const arma::mat tmpB = tmp.each_row() %
+          responsibilities.subvec(begin, end);
+
+      if (isDiagGaussDist)
+        covs[i] += arma::sum(tmp % tmpB, 1);
+      else
+        covs[i] += tmp * trans(tmpB);
     }
-    logLikelihood += mlpack::math::AccuLog(logLikelihoods.col(j));
   }
 
-  return logLikelihood;
+  // Applying the constraints refactors the covariances; this may throw, so it
+  // is done outside of the parallel region.
+  for (size_t i = 0; i < dists.size(); ++i)
+  {
+    if (probRowSums[i] == -std::numeric_limits<double>::infinity())
+      continue;
+
+    // Apply covariance constraint.
+    constraint.ApplyConstraint(covs[i]);
+    dists[i].Mean() = std::move(means[i]);
+    dists[i].Covariance(std::move(covs[i]));
+  }
 }
 
 template<typename InitialClusteringType,
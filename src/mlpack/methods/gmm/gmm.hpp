@@ -17,6 +17,8 @@
 
 // This is the default fitting method class.
 #include "em_fit.hpp"
+// This is the default online fitting method class.
+#include "online_em_fit.hpp"
 
 namespace mlpack {
 namespace gmm /** Gaussian Mixture Models. */ {
@@ -276,6 +278,30 @@ class GMM
                const bool useExistingModel = false,
                FittingType fitter = FittingType());
 
+  /**
+   * Update the model with a mini-batch of observations, using the given online
+   * fitting method, without refitting from scratch.  The fitter keeps its state
+   * between calls, so the same fitter object should be passed for each
+   * mini-batch of the stream.  The model should already be trained (or set
+   * up by hand) before the first update.
+   *
+   * The FittingType class must provide the following function:
+   *
+   * @code
+   * double Update(const arma::mat& observations,
+   *               std::vector<distribution::GaussianDistribution>& dists,
+   *               arma::vec& weights);
+   * @endcode
+   *
+   * @tparam FittingType The type of online fitting method which should be used
+   *     (OnlineEMFit<> is suggested).
+   * @param observations Mini-batch of observations.
+   * @param fitter The online fitter to use.
+   * @return The log-likelihood of the mini-batch before the update.
+   */
+  template<typename FittingType = OnlineEMFit<>>
+  double Update(const arma::mat& observations, FittingType& fitter);
+
   /**
    * Classify the given observations as being from an individual component in
    * this GMM.  The resultant classifications are stored in the 'labels' object,
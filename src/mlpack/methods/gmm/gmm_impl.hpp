@@ -187,6 +187,24 @@ double GMM::Train(const arma::mat& observations,
   return bestLikelihood;
 }
 
+/**
+ * Update the GMM with a mini-batch of observations.
+ */
+template<typename FittingType>
+double GMM::Update(const arma::mat& observations, FittingType& fitter)
+{
+  if (observations.n_rows != dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "GMM::Update(): dimensionality of observations ("
+        << observations.n_rows << ") does not match the dimensionality of the "
+        << "model (" << dimensionality << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  return fitter.Update(observations, dists, weights);
+}
+
 /**
  * Serialize the object.
  */
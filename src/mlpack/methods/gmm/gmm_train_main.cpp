@@ -11,6 +11,7 @@
  */
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/util/io.hpp>
+#include <mlpack/core/data/space_filling_curve.hpp>
 #include <mlpack/core/util/mlpack_main.hpp>
 
 #include "gmm.hpp"
@@ -139,6 +140,9 @@ PARAM_INT_IN("samplings", "If using --refined_start, specify the number of "
 PARAM_DOUBLE_IN("percentage", "If using --refined_start, specify the percentage"
     " of the dataset used for each sampling (should be between 0.0 and 1.0).",
     "p", 0.02);
+PARAM_STRING_IN("reorder", "Reorder the points along a space-filling curve "
+    "('hilbert' or 'z-order') before training, for better memory locality "
+    "('none' keeps the order).", "", "none");
 
 // Parameters for model saving/loading.
 PARAM_MODEL_IN(GMM, "input_model", "Initial input GMM model to start training "
@@ -171,8 +175,18 @@ static void mlpackMain()
   RequireParamValue<int>("kmeans_max_iterations", [](int x) { return x >= 0; },
       true, "kmeans_max_iterations must be greater than or equal to 0");
 
+  RequireParamInSet<string>("reorder", { "none", "hilbert", "z-order" }, true,
+      "unknown space-filling curve");
+
   arma::mat dataPoints = std::move(IO::GetParam<arma::mat>("input"));
 
+  // Points that are close to each other are also close in memory after they
+  // are reordered along a space-filling curve; the order of the points does
+  // not matter to the model.
+  const string reorder = IO::GetParam<string>("reorder");
+  if (reorder != "none")
+    data::ReorderPoints(dataPoints, data::CurveTypeFromString(reorder));
+
   // Do we need to add noise to the dataset?
   if (IO::HasParam("noise"))
   {
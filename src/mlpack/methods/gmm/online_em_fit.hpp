@@ -0,0 +1,146 @@
+/**
+ * @file methods/gmm/online_em_fit.hpp
+ *
+ * Online (stepwise) EM for updating a GMM from mini-batches of observations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_ONLINE_EM_FIT_HPP
+#define MLPACK_METHODS_GMM_ONLINE_EM_FIT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/dists/gaussian_distribution.hpp>
+
+// Default covariance matrix constraint.
+#include "positive_definite_constraint.hpp"
+
+namespace mlpack {
+namespace gmm {
+
+/**
+ * This class updates a Gaussian mixture model from a stream of mini-batches
+ * with the stepwise (online) EM algorithm.  Instead of the exact sufficient
+ * statistics of the whole dataset, running averages of the statistics (the
+ * responsibility of each Gaussian, and the responsibility-weighted first and
+ * second moments of the observations) are kept.  Each mini-batch moves the
+ * running averages towards the statistics of the batch by the step size
+ *
+ * \f[ \eta_t = (t_0 + t)^{-\alpha}, \f]
+ *
+ * and the weights, means and covariances are then recomputed from the
+ * averages.  For 0.5 < alpha <= 1 this converges to a local maximum of the
+ * likelihood.  For more information, see the following papers:
+ *
+ * @code
+ * @article{cappe2009online,
+ *   title={On-line expectation-maximization algorithm for latent data
+ *       models},
+ *   author={Capp{\'e}, Olivier and Moulines, Eric},
+ *   journal={Journal of the Royal Statistical Society: Series B},
+ *   volume={71},
+ *   number={3},
+ *   pages={593--613},
+ *   year={2009}
+ * }
+ *
+ * @inproceedings{liang2009online,
+ *   title={Online EM for unsupervised models},
+ *   author={Liang, Percy and Klein, Dan},
+ *   booktitle={Proceedings of Human Language Technologies: NAACL 2009},
+ *   pages={611--619},
+ *   year={2009}
+ * }
+ * @endcode
+ *
+ * The object holds the running averages, so the same OnlineEMFit should be
+ * passed to every call of GMM::Update().  The averages are initialized from the
+ * model at the first update, so the model should already be trained (for
+ * instance with GMM::Train() on a first batch).
+ *
+ * @tparam CovarianceConstraintPolicy The policy which ensures that the
+ *     covariance matrices are positive definite.
+ */
+template<typename CovarianceConstraintPolicy = PositiveDefiniteConstraint>
+class OnlineEMFit
+{
+ public:
+  /**
+   * Construct the online EM fitter with the given parameters.
+   *
+   * @param decay Exponent alpha of the step size decay; must be in (0.5, 1].
+   * @param offset Offset t_0 of the step size; must be at least 1.  Larger
+   *     values give more weight to the existing model.
+   * @param constraint Constraint policy for covariance matrices.
+   */
+  OnlineEMFit(const double decay = 0.6,
+              const double offset = 2.0,
+              CovarianceConstraintPolicy constraint =
+                  CovarianceConstraintPolicy());
+
+  /**
+   * Update the model with one mini-batch of observations.
+   *
+   * @param observations Mini-batch of observations.
+   * @param dists Distributions of the model to update.
+   * @param weights A priori weights of the model to update.
+   * @return The log-likelihood of the mini-batch under the model before the
+   *     update.
+   */
+  double Update(const arma::mat& observations,
+                std::vector<distribution::GaussianDistribution>& dists,
+                arma::vec& weights);
+
+  //! Forget the running averages, so that the next update starts over from
+  //! the model.
+  void Reset();
+
+  //! Get the step size decay.
+  double Decay() const { return decay; }
+  //! Get the step size offset.
+  double Offset() const { return offset; }
+  //! Get the number of mini-batches seen since the last reset.
+  size_t Steps() const { return steps; }
+
+  //! Get the covariance constraint policy class.
+  const CovarianceConstraintPolicy& Constraint() const { return constraint; }
+  //! Modify the covariance constraint policy class.
+  CovarianceConstraintPolicy& Constraint() { return constraint; }
+
+  //! Serialize the fitter, including the running averages.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! Set the running averages to the statistics implied by the model.
+  void InitializeStatistics(
+      const std::vector<distribution::GaussianDistribution>& dists,
+      const arma::vec& weights);
+
+  //! Exponent of the step size decay.
+  double decay;
+  //! Offset of the step size.
+  double offset;
+  //! Number of mini-batches seen.
+  size_t steps;
+  //! Running average of the responsibility of each Gaussian.
+  arma::vec weightStatistics;
+  //! Running average of the weighted sum of observations, one column per
+  //! Gaussian.
+  arma::mat meanStatistics;
+  //! Running average of the weighted outer products of observations, one slice
+  //! per Gaussian.
+  arma::cube covarianceStatistics;
+  //! Object which applies constraints to the covariance matrix.
+  CovarianceConstraintPolicy constraint;
+};
+
+} // namespace gmm
+} // namespace mlpack
+
+// Include implementation.
+#include "online_em_fit_impl.hpp"
+
+#endif
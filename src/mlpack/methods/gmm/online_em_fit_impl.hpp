@@ -0,0 +1,165 @@
+/**
+ * @file methods/gmm/online_em_fit_impl.hpp
+ *
+ * Implementation of online (stepwise) EM for GMMs.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_ONLINE_EM_FIT_IMPL_HPP
+#define MLPACK_METHODS_GMM_ONLINE_EM_FIT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "online_em_fit.hpp"
+#include <mlpack/core/math/log_add.hpp>
+
+namespace mlpack {
+namespace gmm {
+
+template<typename CovarianceConstraintPolicy>
+OnlineEMFit<CovarianceConstraintPolicy>::OnlineEMFit(
+    const double decay,
+    const double offset,
+    CovarianceConstraintPolicy constraint) :
+    decay(decay),
+    offset(offset),
+    steps(0),
+    constraint(constraint)
+{
+  if (decay <= 0.5 || decay > 1.0)
+  {
+    throw std::invalid_argument("OnlineEMFit::OnlineEMFit(): decay must be "
+        "in (0.5, 1]!");
+  }
+
+  if (offset < 1.0)
+  {
+    throw std::invalid_argument("OnlineEMFit::OnlineEMFit(): offset must be "
+        "at least 1!");
+  }
+}
+
+template<typename CovarianceConstraintPolicy>
+double OnlineEMFit<CovarianceConstraintPolicy>::Update(
+    const arma::mat& observations,
+    std::vector<distribution::GaussianDistribution>& dists,
+    arma::vec& weights)
+{
+  if (observations.n_cols == 0)
+    return 0.0;
+
+  if (weightStatistics.n_elem != dists.size())
+    InitializeStatistics(dists, weights);
+
+  // E-step: compute the responsibilities of each Gaussian for each point of the
+  // batch.  Each column holds one point.
+  arma::mat condLogProb(dists.size(), observations.n_cols);
+  arma::vec logProbs;
+  for (size_t i = 0; i < dists.size(); ++i)
+  {
+    dists[i].LogProbability(observations, logProbs);
+    condLogProb.row(i) = trans(logProbs) + std::log(weights[i]);
+  }
+
+  double logLikelihood = 0.0;
+  for (size_t j = 0; j < observations.n_cols; ++j)
+  {
+    // Avoid dividing by zero; if the probability for everything is 0, we
+    // don't want to make it NaN.
+    const double probSum = mlpack::math::AccuLog(condLogProb.col(j));
+    if (probSum != -std::numeric_limits<double>::infinity())
+      condLogProb.col(j) -= probSum;
+
+    logLikelihood += probSum;
+  }
+  const arma::mat responsibilities = arma::exp(condLogProb);
+
+  // Move the running averages towards the (per-point) statistics of the batch.
+  const double stepSize = std::pow(offset + steps, -decay);
+  const double batchScale = stepSize / observations.n_cols;
+  weightStatistics = (1.0 - stepSize) * weightStatistics +
+      batchScale * arma::sum(responsibilities, 1);
+  meanStatistics = (1.0 - stepSize) * meanStatistics +
+      batchScale * (observations * trans(responsibilities));
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
+  {
+    const arma::mat weighted = observations.each_row() %
+        responsibilities.row(i);
+    covarianceStatistics.slice(i) = (1.0 - stepSize) *
+        covarianceStatistics.slice(i) + batchScale *
+        (weighted * trans(observations));
+  }
+
+  ++steps;
+
+  // M-step: recompute the model from the running averages.
+  weights = weightStatistics / arma::accu(weightStatistics);
+  for (size_t i = 0; i < dists.size(); ++i)
+  {
+    // Don't update if there's no probability of the Gaussian having points.
+    if (weightStatistics[i] == 0.0)
+      continue;
+
+    arma::vec mean = meanStatistics.col(i) / weightStatistics[i];
+    arma::mat covariance = covarianceStatistics.slice(i) / weightStatistics[i] -
+        mean * trans(mean);
+
+    // Apply covariance constraint.
+    constraint.ApplyConstraint(covariance);
+    dists[i].Mean() = std::move(mean);
+    dists[i].Covariance(std::move(covariance));
+  }
+
+  return logLikelihood;
+}
+
+template<typename CovarianceConstraintPolicy>
+void OnlineEMFit<CovarianceConstraintPolicy>::Reset()
+{
+  steps = 0;
+  weightStatistics.clear();
+  meanStatistics.clear();
+  covarianceStatistics.clear();
+}
+
+template<typename CovarianceConstraintPolicy>
+void OnlineEMFit<CovarianceConstraintPolicy>::InitializeStatistics(
+    const std::vector<distribution::GaussianDistribution>& dists,
+    const arma::vec& weights)
+{
+  const size_t dimensionality = (dists.empty()) ? 0 : dists[0].Mean().n_elem;
+
+  weightStatistics = weights;
+  meanStatistics.set_size(dimensionality, dists.size());
+  covarianceStatistics.set_size(dimensionality, dimensionality, dists.size());
+  for (size_t i = 0; i < dists.size(); ++i)
+  {
+    const arma::vec& mean = dists[i].Mean();
+    meanStatistics.col(i) = weights[i] * mean;
+    covarianceStatistics.slice(i) = weights[i] * (dists[i].Covariance() +
+        mean * trans(mean));
+  }
+}
+
+template<typename CovarianceConstraintPolicy>
+template<typename Archive>
+void OnlineEMFit<CovarianceConstraintPolicy>::serialize(
+    Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(decay));
+  ar(CEREAL_NVP(offset));
+  ar(CEREAL_NVP(steps));
+  ar(CEREAL_NVP(weightStatistics));
+  ar(CEREAL_NVP(meanStatistics));
+  ar(CEREAL_NVP(covarianceStatistics));
+  ar(CEREAL_NVP(constraint));
+}
+
+} // namespace gmm
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,323 @@
+/**
+ * @file methods/gradient_boosting/gradient_boosting.hpp
+ *
+ * Definition of the GradientBoosting class, a classifier made of an ensemble
+ * of gradient boosted decision trees.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_HPP
+#define MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "gradient_boosting_tree.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The GradientBoosting class implements gradient boosted decision trees for
+ * classification, in the style of XGBoost:
+ *
+ * @code
+ * @inproceedings{chen2016xgboost,
+ *   title={XGBoost: A Scalable Tree Boosting System},
+ *   author={Chen, Tianqi and Guestrin, Carlos},
+ *   booktitle={Proceedings of the 22nd ACM SIGKDD International Conference on
+ *       Knowledge Discovery and Data Mining},
+ *   pages={785--794},
+ *   year={2016}
+ * }
+ * @endcode
+ *
+ * The model minimizes the log-loss of a logistic model (for two classes) or a
+ * softmax model (for more classes, with one tree per class in each round).
+ * Each tree is fitted with the first and second derivatives of the loss
+ * (see GradientBoostingTree), on each dimension quantized into at most
+ * MaxBins() bins.  Each round may use a random subset of the points
+ * (Subsample()) and of the dimensions (ColumnSubsample()).  When a validation
+ * set is given to Train(), the model keeps the number of rounds with the
+ * lowest validation log-loss, and training stops once the validation log-loss
+ * has not improved for EarlyStoppingRounds() rounds.
+ *
+ * Categorical dimensions, as given by a data::DatasetInfo, are binned by their
+ * mapped value; a categorical split sends one category left and every other
+ * category right.
+ */
+class GradientBoosting
+{
+ public:
+  /**
+   * Create the model without training it.  Classify() will throw an exception
+   * until Train() is called.
+   *
+   * @param numRounds Number of boosting rounds.
+   * @param learningRate Factor the output of each tree is multiplied by.
+   * @param maximumDepth Maximum depth of each tree (0 means no limit).
+   * @param minimumLeafSize Minimum number of points in each leaf.
+   */
+  GradientBoosting(const size_t numRounds = 100,
+                   const double learningRate = 0.1,
+                   const size_t maximumDepth = 6,
+                   const size_t minimumLeafSize = 1);
+
+  /**
+   * Train the model on the given numeric data.  The log-loss of the model on
+   * the training set is returned.
+   *
+   * @param data Dataset to train on.
+   * @param labels Labels of the dataset.
+   * @param numClasses Number of classes in the dataset.
+   */
+  template<typename MatType>
+  double Train(const MatType& data,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses);
+
+  /**
+   * Train the model on the given data, which may have categorical dimensions.
+   * The log-loss of the model on the training set is returned.
+   *
+   * @param data Dataset to train on.
+   * @param datasetInfo Type information for each dimension of the dataset.
+   * @param labels Labels of the dataset.
+   * @param numClasses Number of classes in the dataset.
+   */
+  template<typename MatType>
+  double Train(const MatType& data,
+               const data::DatasetInfo& datasetInfo,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses);
+
+  /**
+   * Train the model on the given numeric data, using the given validation set
+   * for early stopping.  The log-loss of the model on the validation set is
+   * returned.
+   *
+   * @param data Dataset to train on.
+   * @param labels Labels of the dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param validationData Validation dataset.
+   * @param validationLabels Labels of the validation dataset.
+   */
+  template<typename MatType>
+  double Train(const MatType& data,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const MatType& validationData,
+               const arma::Row<size_t>& validationLabels);
+
+  /**
+   * Train the model on the given data, which may have categorical dimensions,
+   * using the given validation set for early stopping.  The log-loss of the
+   * model on the validation set is returned.
+   *
+   * @param data Dataset to train on.
+   * @param datasetInfo Type information for each dimension of the dataset.
+   * @param labels Labels of the dataset.
+   * @param numClasses Number of classes in the dataset.
+   * @param validationData Validation dataset.
+   * @param validationLabels Labels of the validation dataset.
+   */
+  template<typename MatType>
+  double Train(const MatType& data,
+               const data::DatasetInfo& datasetInfo,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const MatType& validationData,
+               const arma::Row<size_t>& validationLabels);
+
+  /**
+   * Predict the class of the given point.  If the model has not been trained,
+   * this will throw an exception.
+   *
+   * @param point Point to be classified.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Predict the class of the given point and return the predicted class
+   * probabilities.  If the model has not been trained, this will throw an
+   * exception.
+   *
+   * @param point Point to be classified.
+   * @param prediction size_t to store predicted class in.
+   * @param probabilities Output vector of class probabilities.
+   */
+  template<typename VecType>
+  void Classify(const VecType& point,
+                size_t& prediction,
+                arma::vec& probabilities) const;
+
+  /**
+   * Predict the classes of each point in the given dataset.  If the model has
+   * not been trained, this will throw an exception.
+   *
+   * @param data Dataset to be classified.
+   * @param predictions Output predictions for each point in the dataset.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions) const;
+
+  /**
+   * Predict the classes of each point in the given dataset, also returning the
+   * predicted class probabilities for each point.  If the model has not been
+   * trained, this will throw an exception.
+   *
+   * @param data Dataset to be classified.
+   * @param predictions Output predictions for each point in the dataset.
+   * @param probabilities Output matrix of class probabilities for each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  //! Get the number of boosting rounds.
+  size_t NumRounds() const { return numRounds; }
+  //! Modify the number of boosting rounds.
+  size_t& NumRounds() { return numRounds; }
+
+  //! Get the learning rate.
+  double LearningRate() const { return learningRate; }
+  //! Modify the learning rate.
+  double& LearningRate() { return learningRate; }
+
+  //! Get the maximum depth of each tree.
+  size_t MaximumDepth() const { return maximumDepth; }
+  //! Modify the maximum depth of each tree.
+  size_t& MaximumDepth() { return maximumDepth; }
+
+  //! Get the minimum number of points in each leaf.
+  size_t MinimumLeafSize() const { return minimumLeafSize; }
+  //! Modify the minimum number of points in each leaf.
+  size_t& MinimumLeafSize() { return minimumLeafSize; }
+
+  //! Get the minimum sum of hessians in each leaf.
+  double MinimumChildWeight() const { return minimumChildWeight; }
+  //! Modify the minimum sum of hessians in each leaf.
+  double& MinimumChildWeight() { return minimumChildWeight; }
+
+  //! Get the L2 regularization of the leaf values.
+  double Lambda() const { return lambda; }
+  //! Modify the L2 regularization of the leaf values.
+  double& Lambda() { return lambda; }
+
+  //! Get the minimum reduction of the loss for a split.
+  double Gamma() const { return gamma; }
+  //! Modify the minimum reduction of the loss for a split.
+  double& Gamma() { return gamma; }
+
+  //! Get the fraction of the points used by each round.
+  double Subsample() const { return subsample; }
+  //! Modify the fraction of the points used by each round.
+  double& Subsample() { return subsample; }
+
+  //! Get the fraction of the dimensions used by each round.
+  double ColumnSubsample() const { return columnSubsample; }
+  //! Modify the fraction of the dimensions used by each round.
+  double& ColumnSubsample() { return columnSubsample; }
+
+  //! Get the maximum number of bins of each dimension (at most 256).
+  size_t MaxBins() const { return maxBins; }
+  //! Modify the maximum number of bins of each dimension (at most 256).
+  size_t& MaxBins() { return maxBins; }
+
+  //! Get the number of rounds without improvement before stopping early.
+  size_t EarlyStoppingRounds() const { return earlyStoppingRounds; }
+  //! Modify the number of rounds without improvement before stopping early
+  //! (0 means training never stops early).
+  size_t& EarlyStoppingRounds() { return earlyStoppingRounds; }
+
+  //! Get the number of classes of the trained model.
+  size_t NumClasses() const { return numClasses; }
+
+  //! Get the number of trees in the model.
+  size_t NumTrees() const { return trees.size(); }
+  //! Access a tree of the model.
+  const GradientBoostingTree& Tree(const size_t i) const { return trees[i]; }
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Train the model.  If validationData is not NULL, it is used for early
+   * stopping and the validation log-loss is returned; otherwise the training
+   * log-loss is returned.
+   */
+  template<typename MatType>
+  double TrainInternal(const MatType& data,
+                       const std::vector<bool>& categorical,
+                       const std::vector<size_t>& numMappings,
+                       const arma::Row<size_t>& labels,
+                       const size_t numClasses,
+                       const MatType* validationData,
+                       const arma::Row<size_t>* validationLabels);
+
+  /**
+   * Quantize each dimension of the dataset into at most maxBins bins.
+   * Categorical dimensions get one bin for each mapped value.
+   */
+  template<typename MatType>
+  void BinData(const MatType& data,
+               const std::vector<bool>& categorical,
+               const std::vector<size_t>& numMappings,
+               arma::Mat<unsigned char>& bins,
+               std::vector<arma::vec>& splitValues) const;
+
+  //! Compute the raw scores of each output for the given point.
+  template<typename VecType>
+  void Scores(const VecType& point, arma::vec& scores) const;
+
+  //! Turn the raw scores of a point into class probabilities.
+  void Probabilities(const arma::vec& scores, arma::vec& probabilities) const;
+
+  //! Compute the mean log-loss of the given scores.
+  double LogLoss(const arma::mat& scores,
+                 const arma::Row<size_t>& labels) const;
+
+  //! The number of boosting rounds.
+  size_t numRounds;
+  //! The learning rate.
+  double learningRate;
+  //! The maximum depth of each tree.
+  size_t maximumDepth;
+  //! The minimum number of points in each leaf.
+  size_t minimumLeafSize;
+  //! The minimum sum of hessians in each leaf.
+  double minimumChildWeight;
+  //! The L2 regularization of the leaf values.
+  double lambda;
+  //! The minimum reduction of the loss for a split.
+  double gamma;
+  //! The fraction of the points used by each round.
+  double subsample;
+  //! The fraction of the dimensions used by each round.
+  double columnSubsample;
+  //! The maximum number of bins of each dimension.
+  size_t maxBins;
+  //! The number of rounds without improvement before stopping early.
+  size_t earlyStoppingRounds;
+
+  //! The number of classes of the model.
+  size_t numClasses;
+  //! The initial score of each output.
+  arma::vec baseScores;
+  //! The trees; the trees of round r are r * outputs to (r + 1) * outputs - 1.
+  std::vector<GradientBoostingTree> trees;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "gradient_boosting_impl.hpp"
+
+#endif
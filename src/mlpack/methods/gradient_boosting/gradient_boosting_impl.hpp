@@ -0,0 +1,485 @@
+/**
+ * @file methods/gradient_boosting/gradient_boosting_impl.hpp
+ *
+ * Implementation of the GradientBoosting class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_IMPL_HPP
+#define MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "gradient_boosting.hpp"
+
+namespace mlpack {
+namespace tree {
+
+inline GradientBoosting::GradientBoosting(const size_t numRounds,
+                                          const double learningRate,
+                                          const size_t maximumDepth,
+                                          const size_t minimumLeafSize) :
+    numRounds(numRounds),
+    learningRate(learningRate),
+    maximumDepth(maximumDepth),
+    minimumLeafSize(minimumLeafSize),
+    minimumChildWeight(1.0),
+    lambda(1.0),
+    gamma(0.0),
+    subsample(1.0),
+    columnSubsample(1.0),
+    maxBins(256),
+    earlyStoppingRounds(0),
+    numClasses(0)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+double GradientBoosting::Train(const MatType& data,
+                               const arma::Row<size_t>& labels,
+                               const size_t numClasses)
+{
+  const std::vector<bool> categorical(data.n_rows, false);
+  const std::vector<size_t> numMappings(data.n_rows, 0);
+  return TrainInternal(data, categorical, numMappings, labels, numClasses,
+      (const MatType*) NULL, (const arma::Row<size_t>*) NULL);
+}
+
+template<typename MatType>
+double GradientBoosting::Train(const MatType& data,
+                               const data::DatasetInfo& datasetInfo,
+                               const arma::Row<size_t>& labels,
+                               const size_t numClasses)
+{
+  if (datasetInfo.Dimensionality() != data.n_rows)
+  {
+    throw std::invalid_argument("GradientBoosting::Train(): dimensionality of "
+        "datasetInfo does not match the dimensionality of the data");
+  }
+
+  std::vector<bool> categorical(data.n_rows);
+  std::vector<size_t> numMappings(data.n_rows);
+  for (size_t d = 0; d < data.n_rows; ++d)
+  {
+    categorical[d] = (datasetInfo.Type(d) == data::Datatype::categorical);
+    numMappings[d] = datasetInfo.NumMappings(d);
+  }
+
+  return TrainInternal(data, categorical, numMappings, labels, numClasses,
+      (const MatType*) NULL, (const arma::Row<size_t>*) NULL);
+}
+
+template<typename MatType>
+double GradientBoosting::Train(const MatType& data,
+                               const arma::Row<size_t>& labels,
+                               const size_t numClasses,
+                               const MatType& validationData,
+                               const arma::Row<size_t>& validationLabels)
+{
+  const std::vector<bool> categorical(data.n_rows, false);
+  const std::vector<size_t> numMappings(data.n_rows, 0);
+  return TrainInternal(data, categorical, numMappings, labels, numClasses,
+      &validationData, &validationLabels);
+}
+
+template<typename MatType>
+double GradientBoosting::Train(const MatType& data,
+                               const data::DatasetInfo& datasetInfo,
+                               const arma::Row<size_t>& labels,
+                               const size_t numClasses,
+                               const MatType& validationData,
+                               const arma::Row<size_t>& validationLabels)
+{
+  if (datasetInfo.Dimensionality() != data.n_rows)
+  {
+    throw std::invalid_argument("GradientBoosting::Train(): dimensionality of "
+        "datasetInfo does not match the dimensionality of the data");
+  }
+
+  std::vector<bool> categorical(data.n_rows);
+  std::vector<size_t> numMappings(data.n_rows);
+  for (size_t d = 0; d < data.n_rows; ++d)
+  {
+    categorical[d] = (datasetInfo.Type(d) == data::Datatype::categorical);
+    numMappings[d] = datasetInfo.NumMappings(d);
+  }
+
+  return TrainInternal(data, categorical, numMappings, labels, numClasses,
+      &validationData, &validationLabels);
+}
+
+template<typename VecType>
+size_t GradientBoosting::Classify(const VecType& point) const
+{
+  size_t prediction;
+  arma::vec probabilities;
+  Classify(point, prediction, probabilities);
+  return prediction;
+}
+
+template<typename VecType>
+void GradientBoosting::Classify(const VecType& point,
+                                size_t& prediction,
+                                arma::vec& probabilities) const
+{
+  if (baseScores.is_empty())
+  {
+    throw std::invalid_argument("GradientBoosting::Classify(): model is not "
+        "trained!");
+  }
+
+  arma::vec scores;
+  Scores(point, scores);
+  Probabilities(scores, probabilities);
+  prediction = probabilities.index_max();
+}
+
+template<typename MatType>
+void GradientBoosting::Classify(const MatType& data,
+                                arma::Row<size_t>& predictions) const
+{
+  arma::mat probabilities;
+  Classify(data, predictions, probabilities);
+}
+
+template<typename MatType>
+void GradientBoosting::Classify(const MatType& data,
+                                arma::Row<size_t>& predictions,
+                                arma::mat& probabilities) const
+{
+  if (baseScores.is_empty())
+  {
+    throw std::invalid_argument("GradientBoosting::Classify(): model is not "
+        "trained!");
+  }
+
+  predictions.set_size(data.n_cols);
+  probabilities.set_size(numClasses, data.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  {
+    arma::vec scores, pointProbabilities;
+    Scores(data.col(i), scores);
+    Probabilities(scores, pointProbabilities);
+    predictions[i] = pointProbabilities.index_max();
+    probabilities.col(i) = pointProbabilities;
+  }
+}
+
+template<typename Archive>
+void GradientBoosting::serialize(Archive& ar, const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(numRounds));
+  ar(CEREAL_NVP(learningRate));
+  ar(CEREAL_NVP(maximumDepth));
+  ar(CEREAL_NVP(minimumLeafSize));
+  ar(CEREAL_NVP(minimumChildWeight));
+  ar(CEREAL_NVP(lambda));
+  ar(CEREAL_NVP(gamma));
+  ar(CEREAL_NVP(subsample));
+  ar(CEREAL_NVP(columnSubsample));
+  ar(CEREAL_NVP(maxBins));
+  ar(CEREAL_NVP(earlyStoppingRounds));
+  ar(CEREAL_NVP(numClasses));
+  ar(CEREAL_NVP(baseScores));
+  ar(CEREAL_NVP(trees));
+}
+
+template<typename MatType>
+double GradientBoosting::TrainInternal(
+    const MatType& data,
+    const std::vector<bool>& categorical,
+    const std::vector<size_t>& numMappings,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const MatType* validationData,
+    const arma::Row<size_t>* validationLabels)
+{
+  if (data.n_cols != labels.n_elem)
+  {
+    throw std::invalid_argument("GradientBoosting::Train(): number of points "
+        "does not match number of labels");
+  }
+  if (data.n_cols == 0)
+  {
+    throw std::invalid_argument("GradientBoosting::Train(): cannot train on "
+        "an empty dataset");
+  }
+  if (numClasses < 2)
+  {
+    throw std::invalid_argument("GradientBoosting::Train(): numClasses must "
+        "be at least 2");
+  }
+  if (maxBins < 2 || maxBins > 256)
+  {
+    throw std::invalid_argument("GradientBoosting::Train(): maxBins must be "
+        "between 2 and 256");
+  }
+  if (arma::any(labels >= numClasses))
+  {
+    throw std::invalid_argument("GradientBoosting::Train(): labels must be "
+        "less than numClasses");
+  }
+  if (validationData != NULL &&
+      (validationData->n_cols != validationLabels->n_elem ||
+       validationData->n_rows != data.n_rows))
+  {
+    throw std::invalid_argument("GradientBoosting::Train(): validation set "
+        "does not match the training set");
+  }
+
+  // The values of categorical dimensions are used as their bins, so they must
+  // fit in the bins.
+  for (size_t d = 0; d < data.n_rows; ++d)
+  {
+    if (!categorical[d])
+      continue;
+
+    if (numMappings[d] > maxBins)
+    {
+      std::ostringstream oss;
+      oss << "GradientBoosting::Train(): categorical dimension " << d << " has "
+          << numMappings[d] << " categories, but at most " << maxBins
+          << " (maxBins) are supported";
+      throw std::invalid_argument(oss.str());
+    }
+
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      if (!(data(d, i) >= 0) || data(d, i) >= std::max(numMappings[d],
+          size_t(1)))
+      {
+        std::ostringstream oss;
+        oss << "GradientBoosting::Train(): value " << data(d, i) << " of point "
+            << i << " in categorical dimension " << d << " is not a mapped "
+            << "value";
+        throw std::invalid_argument(oss.str());
+      }
+    }
+  }
+
+  this->numClasses = numClasses;
+  const size_t outputs = (numClasses == 2) ? 1 : numClasses;
+  const size_t n = data.n_cols;
+
+  // Start from the (smoothed) class priors.
+  arma::vec priors(numClasses, arma::fill::ones);
+  for (size_t i = 0; i < n; ++i)
+    priors[labels[i]] += 1.0;
+  priors /= (n + numClasses);
+  if (outputs == 1)
+    baseScores = arma::vec({ std::log(priors[1] / priors[0]) });
+  else
+    baseScores = arma::log(priors);
+
+  trees.clear();
+  trees.reserve(numRounds * outputs);
+
+  Timer::Start("gradient_boosting_binning");
+  arma::Mat<unsigned char> bins;
+  std::vector<arma::vec> splitValues;
+  BinData(data, categorical, numMappings, bins, splitValues);
+  Timer::Stop("gradient_boosting_binning");
+
+  arma::mat scores = arma::repmat(baseScores, 1, n);
+  arma::mat validationScores;
+  double bestLoss = 0.0;
+  size_t bestRound = 0;
+  if (validationData != NULL)
+  {
+    validationScores = arma::repmat(baseScores, 1, validationData->n_cols);
+    bestLoss = LogLoss(validationScores, *validationLabels);
+  }
+
+  GradientBoostingTree::TrainingParameters parameters;
+  parameters.maximumDepth = maximumDepth;
+  parameters.minimumLeafSize = std::max(minimumLeafSize, size_t(1));
+  parameters.minimumChildWeight = minimumChildWeight;
+  parameters.lambda = lambda;
+  parameters.gamma = gamma;
+  parameters.learningRate = learningRate;
+
+  const size_t sampleSize = std::min(n, std::max(size_t(1),
+      (size_t) std::round(subsample * n)));
+  const size_t dimensionSize = std::min((size_t) data.n_rows,
+      std::max(size_t(1), (size_t) std::round(columnSubsample * data.n_rows)));
+
+  arma::mat probabilities(numClasses, n);
+  arma::vec gradients(n), hessians(n);
+  for (size_t r = 0; r < numRounds; ++r)
+  {
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) n; ++i)
+    {
+      arma::vec pointProbabilities;
+      Probabilities(scores.col(i), pointProbabilities);
+      probabilities.col(i) = pointProbabilities;
+    }
+
+    const arma::uvec rows = (sampleSize < n) ?
+        arma::uvec(arma::randperm(n, sampleSize)) :
+        arma::uvec(arma::regspace<arma::uvec>(0, n - 1));
+    const arma::uvec dimensions = (dimensionSize < data.n_rows) ?
+        arma::uvec(arma::sort(arma::randperm(data.n_rows, dimensionSize))) :
+        arma::uvec(arma::regspace<arma::uvec>(0, data.n_rows - 1));
+
+    // Each output gets a tree fitted to the derivatives of the loss with
+    // respect to its score.
+    for (size_t k = 0; k < outputs; ++k)
+    {
+      const size_t c = (outputs == 1) ? 1 : k;
+      for (size_t i = 0; i < n; ++i)
+      {
+        const double p = probabilities(c, i);
+        gradients[i] = p - ((labels[i] == c) ? 1.0 : 0.0);
+        hessians[i] = std::max(p * (1.0 - p), 1e-16);
+      }
+
+      trees.push_back(GradientBoostingTree());
+      trees.back().Train(bins, splitValues, categorical, gradients, hessians,
+          rows, dimensions, parameters);
+    }
+
+    const size_t firstTree = r * outputs;
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) n; ++i)
+      for (size_t k = 0; k < outputs; ++k)
+        scores(k, i) += trees[firstTree + k].Predict(data.col(i));
+
+    if (validationData != NULL)
+    {
+      #pragma omp parallel for
+      for (omp_size_t i = 0; i < (omp_size_t) validationData->n_cols; ++i)
+        for (size_t k = 0; k < outputs; ++k)
+        {
+          validationScores(k, i) += trees[firstTree + k].Predict(
+              validationData->col(i));
+        }
+
+      const double loss = LogLoss(validationScores, *validationLabels);
+      if (loss < bestLoss)
+      {
+        bestLoss = loss;
+        bestRound = r + 1;
+      }
+      else if (earlyStoppingRounds > 0 &&
+          r + 1 - bestRound >= earlyStoppingRounds)
+      {
+        Log::Info << "GradientBoosting::Train(): validation log-loss has not "
+            << "improved for " << earlyStoppingRounds << " rounds; stopping "
+            << "after " << r + 1 << " rounds." << std::endl;
+        break;
+      }
+    }
+  }
+
+  if (validationData != NULL)
+  {
+    // Keep only the rounds up to the best validation log-loss.
+    trees.resize(bestRound * outputs);
+    Log::Info << "GradientBoosting::Train(): keeping " << bestRound
+        << " rounds with validation log-loss " << bestLoss << "." << std::endl;
+    return bestLoss;
+  }
+
+  return LogLoss(scores, labels);
+}
+
+template<typename MatType>
+void GradientBoosting::BinData(const MatType& data,
+                               const std::vector<bool>& categorical,
+                               const std::vector<size_t>& numMappings,
+                               arma::Mat<unsigned char>& bins,
+                               std::vector<arma::vec>& splitValues) const
+{
+  // Each dimension is one column, so the points of a node can be binned with
+  // one contiguous pass per dimension.
+  bins.set_size(data.n_cols, data.n_rows);
+  splitValues.resize(data.n_rows);
+
+  #pragma omp parallel for
+  for (omp_size_t d = 0; d < (omp_size_t) data.n_rows; ++d)
+  {
+    unsigned char* dimBins = bins.colptr(d);
+    if (categorical[d])
+    {
+      const size_t numBins = std::max(numMappings[d], size_t(1));
+      splitValues[d] = arma::regspace<arma::vec>(0, numBins - 1);
+      for (size_t i = 0; i < data.n_cols; ++i)
+        dimBins[i] = (unsigned char) data(d, i);
+      continue;
+    }
+
+    arma::vec sorted(data.n_cols);
+    for (size_t i = 0; i < data.n_cols; ++i)
+      sorted[i] = data(d, i);
+    sorted = arma::sort(sorted);
+
+    // Use every value if there are few enough of them; otherwise, use
+    // quantiles, so each bin holds about the same number of points.
+    arma::vec edges = arma::unique(sorted);
+    if (edges.n_elem > maxBins)
+    {
+      edges.set_size(maxBins);
+      for (size_t b = 0; b < maxBins; ++b)
+        edges[b] = sorted[((b + 1) * sorted.n_elem) / maxBins - 1];
+      edges = arma::unique(edges);
+    }
+
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      const size_t b = std::lower_bound(edges.begin(), edges.end(),
+          (double) data(d, i)) - edges.begin();
+      dimBins[i] = (unsigned char) std::min(b, (size_t) edges.n_elem - 1);
+    }
+
+    splitValues[d] = std::move(edges);
+  }
+}
+
+template<typename VecType>
+void GradientBoosting::Scores(const VecType& point, arma::vec& scores) const
+{
+  scores = baseScores;
+  for (size_t t = 0; t < trees.size(); ++t)
+    scores[t % scores.n_elem] += trees[t].Predict(point);
+}
+
+inline void GradientBoosting::Probabilities(const arma::vec& scores,
+                                            arma::vec& probabilities) const
+{
+  probabilities.set_size(numClasses);
+  if (scores.n_elem == 1)
+  {
+    probabilities[1] = 1.0 / (1.0 + std::exp(-scores[0]));
+    probabilities[0] = 1.0 - probabilities[1];
+  }
+  else
+  {
+    probabilities = arma::exp(scores - scores.max());
+    probabilities /= arma::accu(probabilities);
+  }
+}
+
+inline double GradientBoosting::LogLoss(const arma::mat& scores,
+                                        const arma::Row<size_t>& labels) const
+{
+  double loss = 0.0;
+  arma::vec probabilities;
+  for (size_t i = 0; i < scores.n_cols; ++i)
+  {
+    Probabilities(scores.col(i), probabilities);
+    loss -= std::log(std::max(probabilities[labels[i]], 1e-15));
+  }
+
+  return loss / scores.n_cols;
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
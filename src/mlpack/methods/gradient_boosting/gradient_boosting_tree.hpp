@@ -0,0 +1,165 @@
+/**
+ * @file methods/gradient_boosting/gradient_boosting_tree.hpp
+ *
+ * Definition of the GradientBoostingTree class, a regression tree fitted to
+ * the gradients and hessians of a loss function on a binned dataset.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_TREE_HPP
+#define MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The GradientBoostingTree is a regression tree used by GradientBoosting.  It
+ * is trained with second-order gradient statistics, as in XGBoost: each leaf
+ * predicts -G / (H + lambda), where G and H are the sums of the gradients and
+ * hessians of the points in the leaf, and a split is made where it gives the
+ * largest reduction of the regularized objective.
+ *
+ * Training works on a binned dataset (each dimension quantized to at most 256
+ * bins, stored as one byte per value), so that the best split of a node is
+ * found from a histogram of the gradient statistics of each bin.  Only the
+ * histogram of the smaller child of each split is computed from its points;
+ * the histogram of the larger child is the histogram of the parent minus the
+ * one of the smaller child.  The histograms of the dimensions are built in
+ * parallel with OpenMP.
+ *
+ * The nodes of the tree are stored in flat arrays; internal nodes keep the
+ * value of their split, so the tree classifies points of the original
+ * (unbinned) dataset.
+ */
+class GradientBoostingTree
+{
+ public:
+  /**
+   * The settings used to grow a tree.
+   */
+  struct TrainingParameters
+  {
+    //! Maximum depth of the tree (0 means no limit).
+    size_t maximumDepth;
+    //! Minimum number of points in each leaf.
+    size_t minimumLeafSize;
+    //! Minimum sum of hessians in each leaf.
+    double minimumChildWeight;
+    //! L2 regularization of the leaf values.
+    double lambda;
+    //! Minimum reduction of the objective for a split.
+    double gamma;
+    //! Factor the leaf values are multiplied by.
+    double learningRate;
+  };
+
+  /**
+   * Create an empty tree, which predicts 0 for every point.
+   */
+  GradientBoostingTree();
+
+  /**
+   * Fit the tree to the given gradient statistics.
+   *
+   * @param bins Binned dataset, with one row per point and one column per
+   *     dimension.
+   * @param splitValues For each dimension, the value of the split at each bin
+   *     (points of the original dataset go left if their value is less than or
+   *     equal to it); for categorical dimensions, the category of each bin.
+   * @param categorical For each dimension, whether it is categorical.
+   *     Categorical splits send one category left and all others right.
+   * @param gradients Gradient of the loss for each point.
+   * @param hessians Hessian of the loss for each point.
+   * @param rows Indices of the points to fit the tree to.
+   * @param dimensions Indices of the dimensions that may be split on.
+   * @param parameters Settings used to grow the tree.
+   */
+  void Train(const arma::Mat<unsigned char>& bins,
+             const std::vector<arma::vec>& splitValues,
+             const std::vector<bool>& categorical,
+             const arma::vec& gradients,
+             const arma::vec& hessians,
+             arma::uvec rows,
+             const arma::uvec& dimensions,
+             const TrainingParameters& parameters);
+
+  /**
+   * Get the value the tree predicts for the given point.
+   *
+   * @param point Point to predict.
+   */
+  template<typename VecType>
+  double Predict(const VecType& point) const;
+
+  //! Get the number of nodes of the tree.
+  size_t NumNodes() const { return values.size(); }
+
+  //! Get the number of leaves of the tree.
+  size_t NumLeaves() const;
+
+  //! Serialize the tree.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Grow the node holding the points rows[begin, end), whose histogram is
+   * given, and return its index.
+   */
+  size_t Grow(const arma::Mat<unsigned char>& bins,
+              const std::vector<arma::vec>& splitValues,
+              const std::vector<bool>& categorical,
+              const arma::vec& gradients,
+              const arma::vec& hessians,
+              arma::uvec& rows,
+              const size_t begin,
+              const size_t end,
+              const arma::uvec& dimensions,
+              const arma::cube& histogram,
+              const size_t depth,
+              const TrainingParameters& parameters);
+
+  /**
+   * Compute the histogram of the points rows[begin, end) for the given
+   * dimensions.  Slice 0 holds the gradient sums, slice 1 the hessian sums and
+   * slice 2 the number of points, with one row for each bin and one column for
+   * each dimension.
+   */
+  static void BuildHistogram(const arma::Mat<unsigned char>& bins,
+                             const arma::vec& gradients,
+                             const arma::vec& hessians,
+                             const arma::uvec& rows,
+                             const size_t begin,
+                             const size_t end,
+                             const arma::uvec& dimensions,
+                             arma::cube& histogram);
+
+  //! Add a leaf with the given statistics, and return its index.
+  size_t AddLeaf(const double gradient,
+                 const double hessian,
+                 const TrainingParameters& parameters);
+
+  //! The dimension each internal node splits on.
+  std::vector<size_t> splitDimensions;
+  //! The split value of each internal node, or the value of each leaf.
+  std::vector<double> values;
+  //! Whether each node splits on a categorical dimension.
+  std::vector<bool> categoricalSplits;
+  //! The index of the left child of each node; 0 (the root) for a leaf.
+  std::vector<size_t> leftChildren;
+  //! The index of the right child of each node.
+  std::vector<size_t> rightChildren;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "gradient_boosting_tree_impl.hpp"
+
+#endif
@@ -0,0 +1,270 @@
+/**
+ * @file methods/gradient_boosting/gradient_boosting_tree_impl.hpp
+ *
+ * Implementation of the GradientBoostingTree class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_TREE_IMPL_HPP
+#define MLPACK_METHODS_GRADIENT_BOOSTING_GRADIENT_BOOSTING_TREE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "gradient_boosting_tree.hpp"
+
+namespace mlpack {
+namespace tree {
+
+inline GradientBoostingTree::GradientBoostingTree()
+{
+  // A single leaf predicting 0.
+  splitDimensions.push_back(0);
+  values.push_back(0.0);
+  categoricalSplits.push_back(false);
+  leftChildren.push_back(0);
+  rightChildren.push_back(0);
+}
+
+inline void GradientBoostingTree::Train(
+    const arma::Mat<unsigned char>& bins,
+    const std::vector<arma::vec>& splitValues,
+    const std::vector<bool>& categorical,
+    const arma::vec& gradients,
+    const arma::vec& hessians,
+    arma::uvec rows,
+    const arma::uvec& dimensions,
+    const TrainingParameters& parameters)
+{
+  splitDimensions.clear();
+  values.clear();
+  categoricalSplits.clear();
+  leftChildren.clear();
+  rightChildren.clear();
+
+  arma::cube histogram;
+  BuildHistogram(bins, gradients, hessians, rows, 0, rows.n_elem, dimensions,
+      histogram);
+  Grow(bins, splitValues, categorical, gradients, hessians, rows, 0,
+      rows.n_elem, dimensions, histogram, 0, parameters);
+}
+
+template<typename VecType>
+double GradientBoostingTree::Predict(const VecType& point) const
+{
+  size_t node = 0;
+  while (leftChildren[node] != 0)
+  {
+    const double value = point[splitDimensions[node]];
+    const bool left = categoricalSplits[node] ? (value == values[node]) :
+        (value <= values[node]);
+    node = left ? leftChildren[node] : rightChildren[node];
+  }
+
+  return values[node];
+}
+
+inline size_t GradientBoostingTree::NumLeaves() const
+{
+  size_t leaves = 0;
+  for (size_t i = 0; i < leftChildren.size(); ++i)
+    if (leftChildren[i] == 0)
+      ++leaves;
+
+  return leaves;
+}
+
+inline size_t GradientBoostingTree::Grow(
+    const arma::Mat<unsigned char>& bins,
+    const std::vector<arma::vec>& splitValues,
+    const std::vector<bool>& categorical,
+    const arma::vec& gradients,
+    const arma::vec& hessians,
+    arma::uvec& rows,
+    const size_t begin,
+    const size_t end,
+    const arma::uvec& dimensions,
+    const arma::cube& histogram,
+    const size_t depth,
+    const TrainingParameters& parameters)
+{
+  double gradient = 0.0, hessian = 0.0;
+  for (size_t i = begin; i < end; ++i)
+  {
+    gradient += gradients[rows[i]];
+    hessian += hessians[rows[i]];
+  }
+
+  const size_t count = end - begin;
+  if ((parameters.maximumDepth != 0 && depth >= parameters.maximumDepth) ||
+      count < 2 * parameters.minimumLeafSize || dimensions.n_elem == 0)
+    return AddLeaf(gradient, hessian, parameters);
+
+  // Find the split with the largest gain.  For numeric dimensions the
+  // candidates are the bins from the left; for categorical dimensions each
+  // category on its own.
+  const double parentScore = gradient * gradient /
+      (hessian + parameters.lambda);
+  double bestGain = 0.0;
+  size_t bestIndex = dimensions.n_elem;
+  size_t bestBin = 0;
+  for (size_t k = 0; k < dimensions.n_elem; ++k)
+  {
+    const size_t dim = dimensions[k];
+    const size_t numBins = splitValues[dim].n_elem;
+    const double* g = histogram.slice_colptr(0, k);
+    const double* h = histogram.slice_colptr(1, k);
+    const double* n = histogram.slice_colptr(2, k);
+
+    double leftGradient = 0.0, leftHessian = 0.0, leftCount = 0.0;
+    for (size_t b = 0; b < numBins; ++b)
+    {
+      if (categorical[dim])
+      {
+        leftGradient = g[b];
+        leftHessian = h[b];
+        leftCount = n[b];
+      }
+      else
+      {
+        // Splitting after the last bin would send every point left.
+        if (b == numBins - 1)
+          break;
+
+        leftGradient += g[b];
+        leftHessian += h[b];
+        leftCount += n[b];
+      }
+
+      const double rightGradient = gradient - leftGradient;
+      const double rightHessian = hessian - leftHessian;
+      const double rightCount = count - leftCount;
+      if (leftCount < parameters.minimumLeafSize ||
+          rightCount < parameters.minimumLeafSize ||
+          leftHessian < parameters.minimumChildWeight ||
+          rightHessian < parameters.minimumChildWeight)
+        continue;
+
+      const double gain = 0.5 * (leftGradient * leftGradient /
+          (leftHessian + parameters.lambda) + rightGradient * rightGradient /
+          (rightHessian + parameters.lambda) - parentScore) - parameters.gamma;
+      if (gain > bestGain)
+      {
+        bestGain = gain;
+        bestIndex = k;
+        bestBin = b;
+      }
+    }
+  }
+
+  if (bestIndex == dimensions.n_elem)
+    return AddLeaf(gradient, hessian, parameters);
+
+  // Send the points of the chosen bins to the front of the range.
+  const size_t bestDim = dimensions[bestIndex];
+  const bool bestCategorical = categorical[bestDim];
+  const unsigned char* dimBins = bins.colptr(bestDim);
+  const unsigned char splitBin = (unsigned char) bestBin;
+  const size_t middle = std::partition(rows.begin() + begin,
+      rows.begin() + end, [&](const arma::uword row)
+      {
+        return bestCategorical ? (dimBins[row] == splitBin) :
+            (dimBins[row] <= splitBin);
+      }) - rows.begin();
+
+  // Reserve the node before its children are grown.
+  const size_t node = values.size();
+  splitDimensions.push_back(bestDim);
+  values.push_back(splitValues[bestDim][bestBin]);
+  categoricalSplits.push_back(bestCategorical);
+  leftChildren.push_back(0);
+  rightChildren.push_back(0);
+
+  // Only build the histogram of the smaller child; the other one is what is
+  // left of the parent.
+  arma::cube leftHistogram, rightHistogram;
+  if (middle - begin <= end - middle)
+  {
+    BuildHistogram(bins, gradients, hessians, rows, begin, middle, dimensions,
+        leftHistogram);
+    rightHistogram = histogram - leftHistogram;
+  }
+  else
+  {
+    BuildHistogram(bins, gradients, hessians, rows, middle, end, dimensions,
+        rightHistogram);
+    leftHistogram = histogram - rightHistogram;
+  }
+
+  const size_t left = Grow(bins, splitValues, categorical, gradients, hessians,
+      rows, begin, middle, dimensions, leftHistogram, depth + 1, parameters);
+  leftHistogram.reset();
+  const size_t right = Grow(bins, splitValues, categorical, gradients,
+      hessians, rows, middle, end, dimensions, rightHistogram, depth + 1,
+      parameters);
+
+  leftChildren[node] = left;
+  rightChildren[node] = right;
+  return node;
+}
+
+inline void GradientBoostingTree::BuildHistogram(
+    const arma::Mat<unsigned char>& bins,
+    const arma::vec& gradients,
+    const arma::vec& hessians,
+    const arma::uvec& rows,
+    const size_t begin,
+    const size_t end,
+    const arma::uvec& dimensions,
+    arma::cube& histogram)
+{
+  histogram.zeros(256, dimensions.n_elem, 3);
+
+  #pragma omp parallel for
+  for (omp_size_t k = 0; k < (omp_size_t) dimensions.n_elem; ++k)
+  {
+    const unsigned char* dimBins = bins.colptr(dimensions[k]);
+    double* g = histogram.slice_colptr(0, k);
+    double* h = histogram.slice_colptr(1, k);
+    double* n = histogram.slice_colptr(2, k);
+    for (size_t i = begin; i < end; ++i)
+    {
+      const size_t row = rows[i];
+      const size_t b = dimBins[row];
+      g[b] += gradients[row];
+      h[b] += hessians[row];
+      n[b] += 1.0;
+    }
+  }
+}
+
+inline size_t GradientBoostingTree::AddLeaf(
+    const double gradient,
+    const double hessian,
+    const TrainingParameters& parameters)
+{
+  splitDimensions.push_back(0);
+  values.push_back(-parameters.learningRate * gradient /
+      (hessian + parameters.lambda));
+  categoricalSplits.push_back(false);
+  leftChildren.push_back(0);
+  rightChildren.push_back(0);
+  return values.size() - 1;
+}
+
+template<typename Archive>
+void GradientBoostingTree::serialize(Archive& ar,
+                                     const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(splitDimensions));
+  ar(CEREAL_NVP(values));
+  ar(CEREAL_NVP(categoricalSplits));
+  ar(CEREAL_NVP(leftChildren));
+  ar(CEREAL_NVP(rightChildren));
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
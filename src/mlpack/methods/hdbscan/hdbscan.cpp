@@ -0,0 +1,168 @@
+/**
+ * @file methods/hdbscan/hdbscan.cpp
+ *
+ * Implementation of the non-templated functions of the HDBSCAN class: the
+ * extraction of the clusters from the mutual reachability spanning tree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "hdbscan.hpp"
+
+using namespace mlpack;
+using namespace mlpack::hdbscan;
+
+HDBSCAN::HDBSCAN(const size_t minClusterSize,
+                 const size_t minPoints,
+                 const bool allowSingleCluster) :
+    minClusterSize(minClusterSize),
+    minPoints(minPoints),
+    allowSingleCluster(allowSingleCluster),
+    parallelDepth(0)
+{
+  // Nothing to do.
+}
+
+size_t HDBSCAN::ExtractClusters(const size_t numPoints,
+                                arma::Row<size_t>& assignments) const
+{
+  assignments.set_size(numPoints);
+  assignments.fill(SIZE_MAX);
+  if (numPoints < minClusterSize)
+    return 0;
+
+  // Build the single linkage dendrogram from the sorted edges.  Nodes
+  // 0, ..., n - 1 are the points, and node n + i is the merge made by edge i.
+  // The density level of a merge is lambda = 1 / distance.
+  const size_t numMerges = numPoints - 1;
+  std::vector<size_t> left(numMerges), right(numMerges);
+  std::vector<size_t> sizes(numPoints + numMerges, 1);
+  std::vector<double> lambdas(numMerges);
+  std::vector<size_t> componentNode(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+    componentNode[i] = i;
+
+  emst::UnionFind components(numPoints);
+  for (size_t i = 0; i < numMerges; ++i)
+  {
+    const size_t a = components.Find((size_t) spanningTree(0, i));
+    const size_t b = components.Find((size_t) spanningTree(1, i));
+    left[i] = componentNode[a];
+    right[i] = componentNode[b];
+    sizes[numPoints + i] = sizes[left[i]] + sizes[right[i]];
+    lambdas[i] = (spanningTree(2, i) > 0.0) ? 1.0 / spanningTree(2, i) :
+        DBL_MAX;
+
+    components.Union(a, b);
+    componentNode[components.Find(a)] = numPoints + i;
+  }
+
+  // Walk down the dendrogram to build the condensed tree.  A cluster only
+  // splits when both parts have at least minClusterSize points; otherwise the
+  // points of the smaller parts fall out of the cluster.  The stability of a
+  // cluster is the sum over its points of (lambda at which the point leaves
+  // the cluster - lambda at which the cluster was born).  Children are always
+  // created after their parents, so cluster c has a larger index than its
+  // parent.
+  std::vector<size_t> clusterParent(1, SIZE_MAX);
+  std::vector<double> birth(1, 0.0);
+  std::vector<double> stability(1, 0.0);
+  // The last cluster each point belonged to.
+  std::vector<size_t> pointCluster(numPoints);
+
+  std::vector<std::pair<size_t, size_t>> stack;
+  std::vector<size_t> fallenNodes;
+  stack.push_back(std::make_pair(numPoints + numMerges - 1, 0));
+  while (!stack.empty())
+  {
+    size_t node = stack.back().first;
+    const size_t cluster = stack.back().second;
+    stack.pop_back();
+
+    // Follow the cluster down until it splits or vanishes.  Since
+    // minClusterSize is at least 2, the nodes followed are always merges.
+    while (true)
+    {
+      const size_t merge = node - numPoints;
+      const double lambda = lambdas[merge];
+      const bool leftLarge = (sizes[left[merge]] >= minClusterSize);
+      const bool rightLarge = (sizes[right[merge]] >= minClusterSize);
+
+      if (leftLarge && rightLarge)
+      {
+        // A true split: all points leave this cluster for the two children.
+        stability[cluster] += sizes[node] * (lambda - birth[cluster]);
+        const size_t children[2] = { left[merge], right[merge] };
+        for (size_t c = 0; c < 2; ++c)
+        {
+          stack.push_back(std::make_pair(children[c], clusterParent.size()));
+          clusterParent.push_back(cluster);
+          birth.push_back(lambda);
+          stability.push_back(0.0);
+        }
+        break;
+      }
+
+      // The points of the small parts fall out of the cluster.
+      size_t fallen = node;
+      if (leftLarge)
+        fallen = right[merge];
+      else if (rightLarge)
+        fallen = left[merge];
+
+      stability[cluster] += sizes[fallen] * (lambda - birth[cluster]);
+      fallenNodes.push_back(fallen);
+      while (!fallenNodes.empty())
+      {
+        const size_t n = fallenNodes.back();
+        fallenNodes.pop_back();
+        if (n < numPoints)
+        {
+          pointCluster[n] = cluster;
+        }
+        else
+        {
+          fallenNodes.push_back(left[n - numPoints]);
+          fallenNodes.push_back(right[n - numPoints]);
+        }
+      }
+
+      if (fallen == node)
+        break; // The cluster has vanished.
+
+      node = leftLarge ? left[merge] : right[merge];
+    }
+  }
+
+  // Select the clusters bottom-up: a cluster is kept if it is at least as
+  // stable as the best selection among its descendants.
+  const size_t numClusters = clusterParent.size();
+  std::vector<double> childStability(numClusters, 0.0);
+  std::vector<bool> selected(numClusters, false);
+  for (size_t c = numClusters - 1; c > 0; --c)
+  {
+    selected[c] = (stability[c] >= childStability[c]);
+    childStability[clusterParent[c]] += selected[c] ? stability[c] :
+        childStability[c];
+  }
+  selected[0] = allowSingleCluster && (stability[0] >= childStability[0]);
+
+  // Label the clusters top-down; a selected cluster claims all of its
+  // descendants.
+  std::vector<size_t> labels(numClusters, SIZE_MAX);
+  size_t numLabels = 0;
+  for (size_t c = 0; c < numClusters; ++c)
+  {
+    if (c > 0 && labels[clusterParent[c]] != SIZE_MAX)
+      labels[c] = labels[clusterParent[c]];
+    else if (selected[c])
+      labels[c] = numLabels++;
+  }
+
+  for (size_t i = 0; i < numPoints; ++i)
+    assignments[i] = labels[pointCluster[i]];
+
+  return numLabels;
+}
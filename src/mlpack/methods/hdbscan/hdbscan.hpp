@@ -0,0 +1,170 @@
+/**
+ * @file methods/hdbscan/hdbscan.hpp
+ *
+ * An implementation of the HDBSCAN clustering technique, which finds the
+ * clusters of DBSCAN at all density levels at once and keeps the most stable
+ * ones.
+ *
+ * The details of this method can be found in the following paper:
+ *
+ * @code
+ * @inproceedings{campello2013density,
+ *   title={Density-based clustering based on hierarchical density estimates},
+ *   author={Campello, Ricardo J.G.B. and Moulavi, Davoud and Sander, J{\"o}rg},
+ *   booktitle={Pacific-Asia Conference on Knowledge Discovery and Data
+ *       Mining},
+ *   pages={160--172},
+ *   year={2013}
+ * }
+ * @endcode
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HDBSCAN_HDBSCAN_HPP
+#define MLPACK_METHODS_HDBSCAN_HDBSCAN_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+#include <mlpack/methods/emst/dtb.hpp>
+#include <mlpack/methods/emst/union_find.hpp>
+
+namespace mlpack {
+namespace hdbscan /** HDBSCAN clustering. */ {
+
+/**
+ * HDBSCAN (hierarchical DBSCAN) is a density-based clustering technique that
+ * does not need the epsilon parameter of DBSCAN.  The core distance of a point
+ * is the distance to its minPoints'th nearest neighbor (counting the point
+ * itself), and the mutual reachability distance between two points is the
+ * largest of their distance and their two core distances.  The clusters that
+ * DBSCAN would find for every value of epsilon are the connected components of
+ * the minimum spanning tree of the mutual reachability distances after the
+ * edges longer than epsilon are removed.
+ *
+ * The computation therefore consists of one all-nearest-neighbors search (with
+ * neighbor::NeighborSearch) for the core distances, one minimum spanning tree
+ * computation (with emst::DualTreeBoruvka) for the mutual reachability
+ * distances, and a pass over the sorted edges of the tree.  That pass builds
+ * the condensed cluster tree, where a cluster only splits when both parts have
+ * at least minClusterSize points (smaller parts are points falling out of the
+ * cluster), and selects the set of non-overlapping clusters of maximum
+ * stability.  Points that do not belong to any selected cluster are noise.
+ *
+ * Both the nearest neighbor search and the spanning tree computation are
+ * split into parallel tasks if ParallelDepth() is set and mlpack was compiled
+ * with OpenMP.
+ */
+class HDBSCAN
+{
+ public:
+  /**
+   * Construct the HDBSCAN object with the given parameters.
+   *
+   * @param minClusterSize Minimum number of points in a cluster; this must be
+   *     at least 2.
+   * @param minPoints Number of neighbors (counting the point itself) used to
+   *     compute the core distance of each point.  If 0, minClusterSize is used.
+   * @param allowSingleCluster If true, the whole dataset may be returned as a
+   *     single cluster; otherwise, the root of the cluster tree is never
+   *     selected.
+   */
+  HDBSCAN(const size_t minClusterSize = 5,
+          const size_t minPoints = 0,
+          const bool allowSingleCluster = false);
+
+  /**
+   * Perform HDBSCAN clustering on the given data, returning the number of
+   * clusters found.  The cluster of each point is stored in the given
+   * assignments vector; noise points are assigned SIZE_MAX.
+   *
+   * @param data Dataset to cluster.
+   * @param assignments Vector to store cluster assignments in.
+   * @return The number of clusters found.
+   */
+  template<typename MatType>
+  size_t Cluster(const MatType& data, arma::Row<size_t>& assignments);
+
+  /**
+   * Perform HDBSCAN clustering on the given data, returning the number of
+   * clusters found and the centroid of each cluster.
+   *
+   * @param data Dataset to cluster.
+   * @param assignments Vector to store cluster assignments in.
+   * @param centroids Matrix in which centroids are stored.
+   * @return The number of clusters found.
+   */
+  template<typename MatType>
+  size_t Cluster(const MatType& data,
+                 arma::Row<size_t>& assignments,
+                 arma::mat& centroids);
+
+  //! Get the minimum number of points in a cluster.
+  size_t MinClusterSize() const { return minClusterSize; }
+  //! Modify the minimum number of points in a cluster.
+  size_t& MinClusterSize() { return minClusterSize; }
+
+  //! Get the number of neighbors used for the core distances (0 means
+  //! MinClusterSize()).
+  size_t MinPoints() const { return minPoints; }
+  //! Modify the number of neighbors used for the core distances.
+  size_t& MinPoints() { return minPoints; }
+
+  //! Get whether the whole dataset may be returned as one cluster.
+  bool AllowSingleCluster() const { return allowSingleCluster; }
+  //! Modify whether the whole dataset may be returned as one cluster.
+  bool& AllowSingleCluster() { return allowSingleCluster; }
+
+  //! Get the depth of the trees at which the searches are split into parallel
+  //! tasks (0 means they are not split).
+  size_t ParallelDepth() const { return parallelDepth; }
+  //! Modify the depth of the trees at which the searches are split into
+  //! parallel tasks.
+  size_t& ParallelDepth() { return parallelDepth; }
+
+  //! Get the core distance of each point, from the last call to Cluster().
+  const arma::vec& CoreDistances() const { return coreDistances; }
+  //! Get the mutual reachability minimum spanning tree from the last call to
+  //! Cluster(), in the format of emst::DualTreeBoruvka::ComputeMST().
+  const arma::mat& SpanningTree() const { return spanningTree; }
+
+ private:
+  //! Compute the core distance of each point.
+  template<typename MatType>
+  void ComputeCoreDistances(const MatType& data);
+
+  /**
+   * Build the condensed cluster tree from the spanning tree, select the most
+   * stable clusters, and label the points with them.
+   *
+   * @param numPoints Number of points in the dataset.
+   * @param assignments Vector to store cluster assignments in.
+   * @return The number of clusters found.
+   */
+  size_t ExtractClusters(const size_t numPoints,
+                         arma::Row<size_t>& assignments) const;
+
+  //! Minimum number of points in a cluster.
+  size_t minClusterSize;
+  //! Number of neighbors used for the core distances.
+  size_t minPoints;
+  //! Whether the whole dataset may be returned as one cluster.
+  bool allowSingleCluster;
+  //! The depth at which the searches are split into parallel tasks.
+  size_t parallelDepth;
+
+  //! The core distance of each point.
+  arma::vec coreDistances;
+  //! The mutual reachability minimum spanning tree.
+  arma::mat spanningTree;
+};
+
+} // namespace hdbscan
+} // namespace mlpack
+
+// Include implementation.
+#include "hdbscan_impl.hpp"
+
+#endif
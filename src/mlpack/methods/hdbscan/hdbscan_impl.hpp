@@ -0,0 +1,106 @@
+/**
+ * @file methods/hdbscan/hdbscan_impl.hpp
+ *
+ * Implementation of the templated functions of the HDBSCAN class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HDBSCAN_HDBSCAN_IMPL_HPP
+#define MLPACK_METHODS_HDBSCAN_HDBSCAN_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "hdbscan.hpp"
+
+namespace mlpack {
+namespace hdbscan {
+
+template<typename MatType>
+size_t HDBSCAN::Cluster(const MatType& data, arma::Row<size_t>& assignments)
+{
+  if (minClusterSize < 2)
+  {
+    std::stringstream ss;
+    ss << "HDBSCAN::Cluster(): the minimum cluster size (" << minClusterSize
+        << ") must be at least 2!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  ComputeCoreDistances(data);
+
+  if (data.n_cols < 2)
+  {
+    spanningTree.set_size(3, 0);
+  }
+  else
+  {
+    emst::DualTreeBoruvka<metric::EuclideanDistance, MatType> dtb(data);
+    dtb.ParallelDepth() = parallelDepth;
+    dtb.ComputeMST(coreDistances, spanningTree);
+  }
+
+  return ExtractClusters(data.n_cols, assignments);
+}
+
+template<typename MatType>
+size_t HDBSCAN::Cluster(const MatType& data,
+                        arma::Row<size_t>& assignments,
+                        arma::mat& centroids)
+{
+  const size_t numClusters = Cluster(data, assignments);
+
+  // Now calculate the centroids.
+  centroids.zeros(data.n_rows, numClusters);
+  arma::Row<size_t> counts(numClusters, arma::fill::zeros);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    if (assignments[i] != SIZE_MAX)
+    {
+      centroids.col(assignments[i]) += data.col(i);
+      ++counts[assignments[i]];
+    }
+  }
+
+  // Every selected cluster has at least minClusterSize points.
+  for (size_t i = 0; i < numClusters; ++i)
+    centroids.col(i) /= counts[i];
+
+  return numClusters;
+}
+
+template<typename MatType>
+void HDBSCAN::ComputeCoreDistances(const MatType& data)
+{
+  const size_t k = (minPoints == 0) ? minClusterSize : minPoints;
+  if (k > data.n_cols)
+  {
+    std::stringstream ss;
+    ss << "HDBSCAN::Cluster(): the number of neighbors for the core distances ("
+        << k << ") must not be greater than the number of points ("
+        << data.n_cols << ")!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  // The point itself is its first neighbor.
+  if (k <= 1)
+  {
+    coreDistances.zeros(data.n_cols);
+    return;
+  }
+
+  neighbor::NeighborSearch<neighbor::NearestNeighborSort,
+      metric::EuclideanDistance, MatType> knn(data);
+  knn.ParallelDepth() = parallelDepth;
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(k - 1, neighbors, distances);
+  coreDistances = arma::trans(distances.row(k - 2));
+}
+
+} // namespace hdbscan
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,116 @@
+/**
+ * @file methods/hdbscan/hdbscan_main.cpp
+ *
+ * Implementation of program to run HDBSCAN.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/io.hpp>
+#include <mlpack/core/util/mlpack_main.hpp>
+#include "hdbscan.hpp"
+
+using namespace mlpack;
+using namespace mlpack::hdbscan;
+using namespace mlpack::util;
+using namespace std;
+
+// Program Name.
+BINDING_NAME("HDBSCAN clustering");
+
+// Short description.
+BINDING_SHORT_DESC(
+    "An implementation of HDBSCAN clustering.  Given a dataset, this can "
+    "compute and return a clustering of that dataset without needing a fixed "
+    "search radius.");
+
+// Long description.
+BINDING_LONG_DESC(
+    "This program implements the HDBSCAN algorithm for clustering, which finds "
+    "the clusters that DBSCAN would find for every search radius at once and "
+    "keeps the most stable ones.  The core distance of each point is found "
+    "with one nearest neighbor search, and the cluster hierarchy is built "
+    "from the minimum spanning tree of the mutual reachability distances, "
+    "which is computed with the dual-tree Boruvka algorithm."
+    "\n\n"
+    "The input dataset to be clustered may be specified with the " +
+    PRINT_PARAM_STRING("input") + " parameter; the minimum number of points in "
+    "a cluster may be specified with the " +
+    PRINT_PARAM_STRING("min_cluster_size") + " parameter, and the number of "
+    "neighbors used to compute the core distances may be specified with the " +
+    PRINT_PARAM_STRING("min_points") + " parameter (if it is 0, the minimum "
+    "cluster size is used).  If " +
+    PRINT_PARAM_STRING("allow_single_cluster") + " is specified, the whole "
+    "dataset may be returned as one cluster."
+    "\n\n"
+    "The " + PRINT_PARAM_STRING("assignments") + " and " +
+    PRINT_PARAM_STRING("centroids") + " output parameters may be "
+    "used to save the output of the clustering. " +
+    PRINT_PARAM_STRING("assignments") + " contains the cluster assignments of "
+    "each point (noise points are assigned the largest possible value), and " +
+    PRINT_PARAM_STRING("centroids") + " contains the centroids of each "
+    "cluster.");
+
+// Example.
+BINDING_EXAMPLE(
+    "An example usage to run HDBSCAN on the dataset in " +
+    PRINT_DATASET("input") + " with a minimum cluster size of 10 is given "
+    "below:"
+    "\n\n" +
+    PRINT_CALL("hdbscan", "input", "input", "min_cluster_size", 10,
+        "assignments", "assignments"));
+
+// See also...
+BINDING_SEE_ALSO("@dbscan", "#dbscan");
+BINDING_SEE_ALSO("@emst", "#emst");
+BINDING_SEE_ALSO("Density-based clustering based on hierarchical density "
+        "estimates", "https://doi.org/10.1007/978-3-642-37456-2_14");
+BINDING_SEE_ALSO("mlpack::hdbscan::HDBSCAN class documentation",
+        "@doxygen/classmlpack_1_1hdbscan_1_1HDBSCAN.html");
+
+PARAM_MATRIX_IN_REQ("input", "Input dataset to cluster.", "i");
+PARAM_UROW_OUT("assignments", "Output matrix for assignments of each "
+    "point.", "a");
+PARAM_MATRIX_OUT("centroids", "Matrix to save output centroids to.", "C");
+
+PARAM_INT_IN("min_cluster_size", "Minimum number of points for a cluster.",
+    "m", 5);
+PARAM_INT_IN("min_points", "Number of neighbors used to compute the core "
+    "distance of each point (0 means the minimum cluster size is used).", "p",
+    0);
+PARAM_FLAG("allow_single_cluster", "If set, the whole dataset may be returned "
+    "as a single cluster.", "S");
+
+static void mlpackMain()
+{
+  RequireAtLeastOnePassed({ "assignments", "centroids" }, false,
+      "no output will be saved");
+
+  RequireParamValue<int>("min_cluster_size", [](int x) { return x >= 2; },
+      true, "min_cluster_size must be at least 2");
+  RequireParamValue<int>("min_points", [](int x) { return x >= 0; },
+      true, "min_points must be non-negative");
+
+  arma::mat dataset = std::move(IO::GetParam<arma::mat>("input"));
+  HDBSCAN h((size_t) IO::GetParam<int>("min_cluster_size"),
+      (size_t) IO::GetParam<int>("min_points"),
+      IO::HasParam("allow_single_cluster"));
+
+  arma::Row<size_t> assignments;
+  if (IO::HasParam("centroids"))
+  {
+    arma::mat centroids;
+    h.Cluster(dataset, assignments, centroids);
+    IO::GetParam<arma::mat>("centroids") = std::move(centroids);
+  }
+  else
+  {
+    h.Cluster(dataset, assignments);
+  }
+
+  if (IO::HasParam("assignments"))
+    IO::GetParam<arma::Row<size_t>>("assignments") = std::move(assignments);
+}
@@ -215,6 +215,21 @@ class HMM
                      arma::mat& backwardLogProb,
                      arma::vec& logScales) const;
 
+  /**
+   * Estimate the log-probabilities of each hidden state at each time step of
+   * each of the given data sequences, using the Forward-Backward algorithm.
+   * The sequences are processed in parallel with OpenMP.
+   *
+   * @param dataSeq Vector of observation sequences.
+   * @param stateLogProb Vector in which the matrix of state log-probabilities
+   *    of each sequence will be stored.
+   * @param logLikelihoods Vector in which the log-likelihood of each sequence
+   *    will be stored.
+   */
+  void LogEstimate(const std::vector<arma::mat>& dataSeq,
+                   std::vector<arma::mat>& stateLogProb,
+                   arma::vec& logLikelihoods) const;
+
   /**
    * Estimate the probabilities of each hidden state at each time step for each
    * given data observation, using the Forward-Backward algorithm.  Each matrix
@@ -282,6 +297,21 @@ class HMM
   double Predict(const arma::mat& dataSeq,
                  arma::Row<size_t>& stateSeq) const;
 
+  /**
+   * Compute the most probable hidden state sequence of each of the given data
+   * sequences, using the Viterbi algorithm.  The sequences are processed in
+   * parallel with OpenMP.
+   *
+   * @param dataSeq Vector of observation sequences.
+   * @param stateSeq Vector in which the most probable state sequence of each
+   *    data sequence will be stored.
+   * @param logLikelihoods Vector in which the log-likelihood of the most
+   *    probable state sequence of each data sequence will be stored.
+   */
+  void Predict(const std::vector<arma::mat>& dataSeq,
+               std::vector<arma::Row<size_t> >& stateSeq,
+               arma::vec& logLikelihoods) const;
+
   /**
    * Compute the log-likelihood of the given data sequence.
    *
@@ -290,6 +320,18 @@ class HMM
    */
   double LogLikelihood(const arma::mat& dataSeq) const;
 
+  /**
+   * Compute the log-likelihood of each of the given data sequences.  The
+   * sequences are processed in parallel with OpenMP.
+   *
+   * @param dataSeq Vector of data sequences to evaluate the likelihood of.
+   * @param logLikelihoods Vector in which the log-likelihood of each sequence
+   *    will be stored.
+   * @return Sum of the log-likelihoods of all sequences.
+   */
+  double LogLikelihood(const std::vector<arma::mat>& dataSeq,
+                       arma::vec& logLikelihoods) const;
+
   /**
    * Compute the log of the scaling factor of the given emission probability
    * at time t. To calculate the log-likelihood for the whole sequence,
@@ -493,6 +535,18 @@ class HMM
                 arma::mat& backwardLogProb,
                 arma::mat& logProbs) const;
 
+  /**
+   * Compute the emission log-probabilities of each observation of the given
+   * data sequence for each state, in one pass per state.  The returned matrix
+   * has rows equal to the number of observations and columns equal to the
+   * number of hidden states.
+   *
+   * @param dataSeq Data sequence to compute probabilities for.
+   * @param logProbs Matrix in which the log-probabilities will be saved.
+   */
+  void EmissionLogProbabilities(const arma::mat& dataSeq,
+                                arma::mat& logProbs) const;
+
   //! Set of emission probability distributions; one for each state.
   std::vector<Distribution> emission;
 
@@ -114,10 +114,24 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
   }
 
   // These are used later for training of each distribution.  We initialize it
-  // all now so we don't have to do any allocation later on.
+  // all now so we don't have to do any allocation later on.  The observations
+  // don't change between iterations, so they are gathered once; each sequence
+  // owns the columns starting at its offset.
   std::vector<arma::vec> emissionProb(logTransition.n_cols,
       arma::vec(totalLength));
   arma::mat emissionList(dimensionality, totalLength);
+  std::vector<size_t> offsets(dataSeq.size());
+  size_t sumTime = 0;
+  for (size_t seq = 0; seq < dataSeq.size(); seq++)
+  {
+    offsets[seq] = sumTime;
+    if (dataSeq[seq].n_cols > 0)
+    {
+      emissionList.cols(sumTime, sumTime + dataSeq[seq].n_cols - 1) =
+          dataSeq[seq];
+    }
+    sumTime += dataSeq[seq].n_cols;
+  }
 
   // This should be the Baum-Welch algorithm (EM for HMM estimation). This
   // follows the procedure outlined in Elliot, Aggoun, and Moore's book "Hidden
@@ -133,70 +147,86 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
     // Reset log likelihood.
     loglik = 0;
 
-    // Sum over time.
-    size_t sumTime = 0;
+    // Synchronize the log-space parameters before the threads read them.
+    ConvertToLogSpace();
 
-    // Loop over each sequence.
-    for (size_t seq = 0; seq < dataSeq.size(); seq++)
+    // The sequences are independent, so the E-step is split between threads.
+    // Each thread accumulates its own initial and transition estimates, which
+    // are combined at the end; the emission weights of each sequence are
+    // written to its own columns.
+    #pragma omp parallel reduction(+:loglik)
     {
-      arma::mat stateLogProb;
-      arma::mat forwardLog;
-      arma::mat backwardLog;
-      arma::vec logScales;
-
-      // Add the log-likelihood of this sequence.  This is the E-step.
-      loglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
-          backwardLog, logScales);
-
-      // Add to estimate of initial probability for state j.
-      math::LogSumExp<arma::vec, true>(stateLogProb.unsafe_col(0),
-          newLogInitial);
-
-      // Define a variable to store the value of log-probability for data.
-      arma::mat logProbs(dataSeq[seq].n_cols, logTransition.n_rows);
-      // Save the values of log-probability to logProbs.
-      for (size_t i = 0; i < logTransition.n_rows; i++)
-      {
-        // Define alias of desired column.
-        arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
-        // Use advanced constructor for using logProbs directly.
-        emission[i].LogProbability(dataSeq[seq], alias);
-      }
-
-      // Now re-estimate the parameters.  This is the M-step.
-      //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
-      //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t]) b(i,
-      //           t + 1)))
-      //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t) b(i, t)
-      // We store the new estimates in a different matrix.
-      for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+      arma::vec localLogInitial(logTransition.n_rows);
+      localLogInitial.fill(-std::numeric_limits<double>::infinity());
+      arma::mat localLogTransition(logTransition.n_rows, logTransition.n_cols);
+      localLogTransition.fill(-std::numeric_limits<double>::infinity());
+
+      // Loop over each sequence.
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t seq = 0; seq < (omp_size_t) dataSeq.size(); seq++)
       {
-        // Assemble temporary vector that's used in log-sum computation.
-        if (t < dataSeq[seq].n_cols - 1)
+        arma::mat stateLogProb;
+        arma::mat forwardLog;
+        arma::mat backwardLog;
+        arma::vec logScales;
+
+        // Add the log-likelihood of this sequence.  This is the E-step.
+        loglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
+            backwardLog, logScales);
+
+        // Add to estimate of initial probability for state j.
+        math::LogSumExp<arma::vec, true>(stateLogProb.unsafe_col(0),
+            localLogInitial);
+
+        // Define a variable to store the value of log-probability for data.
+        arma::mat logProbs;
+        EmissionLogProbabilities(dataSeq[seq], logProbs);
+
+        // Now re-estimate the parameters.  This is the M-step.
+        //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
+        //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t])
+        //           b(i, t + 1)))
+        //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t)
+        //           b(i, t)
+        // We store the new estimates in a different matrix.
+        for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
         {
-          // This term is the same across all states, so compute it once and
-          // cache it.
-          const arma::vec tmp = backwardLog.col(t + 1) +
-              logProbs.row(t + 1).t() - logScales[t + 1];
-          arma::vec output;
-          math::LogSumExp(tmp, output);
-
-          for (size_t j = 0; j < logTransition.n_cols; ++j)
+          // Assemble temporary vector that's used in log-sum computation.
+          if (t < dataSeq[seq].n_cols - 1)
           {
-            // Compute the estimate of T_ij (probability of transition from
-            // state j to state i).  We postpone multiplication of the old T_ij
-            // until later.
-            arma::vec tmp2 = output + forwardLog(j, t);
-            arma::vec alias = newLogTransition.unsafe_col(j);
-            math::LogSumExp<arma::vec, true>(tmp2, alias);
+            // This term is the same across all states, so compute it once and
+            // cache it.
+            const arma::vec tmp = backwardLog.col(t + 1) +
+                logProbs.row(t + 1).t() - logScales[t + 1];
+            arma::vec output;
+            math::LogSumExp(tmp, output);
+
+            for (size_t j = 0; j < logTransition.n_cols; ++j)
+            {
+              // Compute the estimate of T_ij (probability of transition from
+              // state j to state i).  We postpone multiplication of the old
+              // T_ij until later.
+              arma::vec tmp2 = output + forwardLog(j, t);
+              arma::vec alias = localLogTransition.unsafe_col(j);
+              math::LogSumExp<arma::vec, true>(tmp2, alias);
+            }
           }
+
+          // Add to list of emission observations, for Distribution::Train().
+          for (size_t j = 0; j < logTransition.n_cols; ++j)
+            emissionProb[j][offsets[seq] + t] = exp(stateLogProb(j, t));
         }
+      }
 
-        // Add to list of emission observations, for Distribution::Train().
-        for (size_t j = 0; j < logTransition.n_cols; ++j)
-          emissionProb[j][sumTime] = exp(stateLogProb(j, t));
-        emissionList.col(sumTime) = dataSeq[seq].col(t);
-        sumTime++;
+      // Combine the estimates of each thread.
+      #pragma omp critical
+      {
+        for (size_t i = 0; i < newLogInitial.n_elem; ++i)
+          newLogInitial[i] = math::LogAdd(newLogInitial[i],
+              localLogInitial[i]);
+        for (size_t i = 0; i < newLogTransition.n_elem; ++i)
+          newLogTransition[i] = math::LogAdd(newLogTransition[i],
+              localLogTransition[i]);
       }
     }
 
@@ -354,16 +384,8 @@ double HMM<Distribution>::LogEstimate(const arma::mat& dataSeq,
                                       arma::mat& backwardLogProb,
                                       arma::vec& logScales) const
 {
-  arma::mat logProbs(dataSeq.n_cols, logTransition.n_rows);
-
-  // Save the values of log-probability to logProbs.
-  for (size_t i = 0; i < logTransition.n_rows; i++)
-  {
-    // Define alias of desired column.
-    arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
-    // Use advanced constructor for using logProbs directly.
-    emission[i].LogProbability(dataSeq, alias);
-  }
+  arma::mat logProbs;
+  EmissionLogProbabilities(dataSeq, logProbs);
 
   // First run the forward-backward algorithm.
   Forward(dataSeq, logScales, forwardLogProb, logProbs);
@@ -377,6 +399,34 @@ double HMM<Distribution>::LogEstimate(const arma::mat& dataSeq,
   return accu(logScales);
 }
 
+/**
+ * Estimate the log-probabilities of each hidden state at each time step of each
+ * of the given data sequences, in parallel.
+ */
+template<typename Distribution>
+void HMM<Distribution>::LogEstimate(const std::vector<arma::mat>& dataSeq,
+                                    std::vector<arma::mat>& stateLogProb,
+                                    arma::vec& logLikelihoods) const
+{
+  // Synchronize the log-space parameters before the threads read them.
+  ConvertToLogSpace();
+
+  stateLogProb.resize(dataSeq.size());
+  logLikelihoods.set_size(dataSeq.size());
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) dataSeq.size(); ++i)
+  {
+    // We don't need to save these.
+    arma::mat forwardLogProb;
+    arma::mat backwardLogProb;
+    arma::vec logScales;
+
+    logLikelihoods[i] = LogEstimate(dataSeq[i], stateLogProb[i],
+        forwardLogProb, backwardLogProb, logScales);
+  }
+}
+
 /**
  * Estimate the probabilities of each hidden state at each time step for each
  * given data observation.
@@ -487,55 +537,39 @@ double HMM<Distribution>::Predict(const arma::mat& dataSeq,
                                   arma::Row<size_t>& stateSeq) const
 {
   // This is an implementation of the Viterbi algorithm for finding the most
-  // probable sequence of states to produce the observed data sequence.  We
-  // don't use log-likelihoods to save that little bit of time, but we'll
-  // calculate the log-likelihood at the end of it all.
+  // probable sequence of states to produce the observed data sequence.  Each
+  // step is a max-plus product of the previous log-probabilities with the
+  // transition matrix.
   stateSeq.set_size(dataSeq.n_cols);
   arma::mat logStateProb(logTransition.n_rows, dataSeq.n_cols);
-  arma::mat stateSeqBack(logTransition.n_rows, dataSeq.n_cols);
+  arma::umat stateSeqBack(logTransition.n_rows, dataSeq.n_cols);
 
   ConvertToLogSpace();
 
-  // The calculation of the first state is slightly different; the probability
-  // of the first state being state j is the maximum probability that the state
-  // came to be j from another state.
-  logStateProb.col(0).zeros();
-  for (size_t state = 0; state < logTransition.n_rows; state++)
-  {
-    logStateProb(state, 0) = logInitial[state] +
-        emission[state].LogProbability(dataSeq.unsafe_col(0));
-    stateSeqBack(state, 0) = state;
-  }
-
-  // Store the best first state.
-  arma::uword index;
-
   // Define a variable to store the value of log-probability for dataSeq.
-  arma::mat logProbs(dataSeq.n_cols, logTransition.n_rows);
+  arma::mat logProbs;
+  EmissionLogProbabilities(dataSeq, logProbs);
 
-  // Save the values of log-probability to logProbs.
-  for (size_t i = 0; i < logTransition.n_rows; i++)
-  {
-    // Define alias of desired column.
-    arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
-    // Use advanced constructor for using logProbs directly.
-    emission[i].LogProbability(dataSeq, alias);
-  }
+  // The calculation of the first state is slightly different; the probability
+  // of the first state being state j is the probability that the sequence
+  // started in j.
+  logStateProb.col(0) = logInitial + logProbs.row(0).t();
+  stateSeqBack.col(0) = arma::regspace<arma::uvec>(0,
+      logTransition.n_rows - 1);
 
   for (size_t t = 1; t < dataSeq.n_cols; t++)
   {
-    // Assemble the state probability for this element.
-    // Given that we are in state j, we use state with the highest probability
-    // of being the previous state.
-    for (size_t j = 0; j < logTransition.n_rows; j++)
-    {
-      arma::vec prob = logStateProb.col(t - 1) + logTransition.row(j).t();
-      logStateProb(j, t) = prob.max(index) + logProbs(t, j);
-      stateSeqBack(j, t) = index;
-    }
+    // Given that we are in state j, we use the state with the highest
+    // probability of being the previous state.  Element (j, i) of the scores
+    // is the log-probability of being in state i and moving to state j.
+    const arma::mat scores = logTransition.each_row() +
+        logStateProb.col(t - 1).t();
+    stateSeqBack.col(t) = arma::index_max(scores, 1);
+    logStateProb.col(t) = arma::max(scores, 1) + logProbs.row(t).t();
   }
 
   // Backtrack to find the most probable state sequence.
+  arma::uword index;
   logStateProb.unsafe_col(dataSeq.n_cols - 1).max(index);
   stateSeq[dataSeq.n_cols - 1] = index;
   for (size_t t = 2; t <= dataSeq.n_cols; t++)
@@ -547,6 +581,26 @@ double HMM<Distribution>::Predict(const arma::mat& dataSeq,
   return logStateProb(stateSeq(dataSeq.n_cols - 1), dataSeq.n_cols - 1);
 }
 
+/**
+ * Compute the most probable hidden state sequence of each of the given data
+ * sequences, in parallel.
+ */
+template<typename Distribution>
+void HMM<Distribution>::Predict(const std::vector<arma::mat>& dataSeq,
+                                std::vector<arma::Row<size_t> >& stateSeq,
+                                arma::vec& logLikelihoods) const
+{
+  // Synchronize the log-space parameters before the threads read them.
+  ConvertToLogSpace();
+
+  stateSeq.resize(dataSeq.size());
+  logLikelihoods.set_size(dataSeq.size());
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) dataSeq.size(); ++i)
+    logLikelihoods[i] = Predict(dataSeq[i], stateSeq[i]);
+}
+
 /**
  * Compute the log-likelihood of the given data sequence.
  */
@@ -557,16 +611,8 @@ double HMM<Distribution>::LogLikelihood(const arma::mat& dataSeq) const
   arma::vec logScales;
 
   // This is needed here.
-  arma::mat logProbs(dataSeq.n_cols, logTransition.n_rows);
-
-  // Save the values of log-probability to logProbs.
-  for (size_t i = 0; i < logTransition.n_rows; i++)
-  {
-    // Define alias of desired column.
-    arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
-    // Use advanced constructor for using logProbs directly.
-    emission[i].LogProbability(dataSeq, alias);
-  }
+  arma::mat logProbs;
+  EmissionLogProbabilities(dataSeq, logProbs);
 
   Forward(dataSeq, logScales, forwardLog, logProbs);
 
@@ -574,6 +620,25 @@ double HMM<Distribution>::LogLikelihood(const arma::mat& dataSeq) const
   return accu(logScales);
 }
 
+/**
+ * Compute the log-likelihood of each of the given data sequences, in parallel.
+ */
+template<typename Distribution>
+double HMM<Distribution>::LogLikelihood(const std::vector<arma::mat>& dataSeq,
+                                        arma::vec& logLikelihoods) const
+{
+  // Synchronize the log-space parameters before the threads read them.
+  ConvertToLogSpace();
+
+  logLikelihoods.set_size(dataSeq.size());
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) dataSeq.size(); ++i)
+    logLikelihoods[i] = LogLikelihood(dataSeq[i]);
+
+  return arma::accu(logLikelihoods);
+}
+
 /**
  * Compute the log of the scaling factor of the given emission probability
  * at time t. To calculate the log-likelihood for the whole sequence,
@@ -659,16 +724,8 @@ void HMM<Distribution>::Filter(const arma::mat& dataSeq,
   arma::mat forwardLogProb;
   arma::vec logScales;
   // This is needed here.
-  arma::mat logProbs(dataSeq.n_cols, logTransition.n_rows);
-
-  // Save the values of log-probability to logProbs.
-  for (size_t i = 0; i < logTransition.n_rows; i++)
-  {
-    // Define alias of desired column.
-    arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
-    // Use advanced constructor for using logProbs directly.
-    emission[i].LogProbability(dataSeq, alias);
-  }
+  arma::mat logProbs;
+  EmissionLogProbabilities(dataSeq, logProbs);
 
   Forward(dataSeq, logScales, forwardLogProb, logProbs);
 
@@ -750,8 +807,7 @@ arma::vec HMM<Distribution>::ForwardAtTn(const arma::vec& emissionLogProb,
   // and emitting the given observation.  To do this computation in log-space,
   // we can use LogSumExp().
   arma::vec forwardLogProb;
-  arma::mat tmp = logTransition + repmat(prevForwardLogProb.t(),
-      logTransition.n_rows, 1);
+  const arma::mat tmp = logTransition.each_row() + prevForwardLogProb.t();
   math::LogSumExp(tmp, forwardLogProb);
   forwardLogProb += emissionLogProb;
 
@@ -817,9 +873,8 @@ void HMM<Distribution>::Backward(const arma::mat& dataSeq,
     // from the current state multiplied by the probability of each of those
     // states emitting the given observation.  To compute this in log-space, we
     // can use LogSumExpT().
-    const arma::mat tmp = logTransition +
-        repmat(backwardLogProb.col(t + 1), 1, logTransition.n_cols) +
-        repmat(logProbs.row(t + 1).t(), 1, logTransition.n_cols);
+    const arma::mat tmp = logTransition.each_col() +
+        (backwardLogProb.col(t + 1) + logProbs.row(t + 1).t());
     arma::vec alias = backwardLogProb.unsafe_col(t);
     math::LogSumExpT<arma::mat, true>(tmp, alias);
 
@@ -829,6 +884,25 @@ void HMM<Distribution>::Backward(const arma::mat& dataSeq,
   }
 }
 
+/**
+ * Compute the emission log-probabilities of every observation for every state.
+ */
+template<typename Distribution>
+void HMM<Distribution>::EmissionLogProbabilities(const arma::mat& dataSeq,
+                                                 arma::mat& logProbs) const
+{
+  logProbs.set_size(dataSeq.n_cols, logTransition.n_rows);
+
+  // Save the values of log-probability to logProbs.
+  for (size_t i = 0; i < logTransition.n_rows; i++)
+  {
+    // Define alias of desired column.
+    arma::vec alias(logProbs.colptr(i), logProbs.n_rows, false, true);
+    // Use advanced constructor for using logProbs directly.
+    emission[i].LogProbability(dataSeq, alias);
+  }
+}
+
 /**
  * Make sure the variables in log space are in sync with the linear
  * counterparts.
@@ -0,0 +1,131 @@
+/**
+ * @file methods/hmm/streaming_viterbi.hpp
+ *
+ * Definition of the StreamingViterbi class, a fixed-lag Viterbi decoder for
+ * HMMs that consumes one observation at a time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HMM_STREAMING_VITERBI_HPP
+#define MLPACK_METHODS_HMM_STREAMING_VITERBI_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "hmm.hpp"
+
+namespace mlpack {
+namespace hmm /** Hidden Markov Models. */ {
+
+/**
+ * The StreamingViterbi class decodes the hidden states of an HMM online.  Each
+ * call to Step() consumes one observation and advances the Viterbi recursion
+ * by one step, which costs O(states^2); the backpointers of the last `lag`
+ * steps are kept in a ring buffer.  Once more than `lag` observations have
+ * been seen, every step commits the state `lag` steps back, found by
+ * backtracking from the currently most probable state.  At the end of the
+ * stream, Flush() returns the states that were not committed yet.
+ *
+ * With a lag at least as long as the stream, the decoded states are exactly
+ * those of HMM::Predict(); with a shorter lag, a committed state may differ
+ * from the one that later observations would have chosen, but the lag is
+ * usually only needed to be a few times the mixing time of the chain.
+ *
+ * @code
+ * HMM<GaussianDistribution> hmm; // Some trained HMM.
+ * StreamingViterbi<GaussianDistribution> decoder(hmm, 20);
+ * arma::vec observation;
+ * size_t state;
+ * while (ReadSensor(observation)) // Some way of reading the stream.
+ * {
+ *   if (decoder.Step(observation, state))
+ *     std::cout << "state: " << state << std::endl;
+ * }
+ * @endcode
+ *
+ * @tparam Distribution Type of emission distribution of the HMM.
+ */
+template<typename Distribution = distribution::DiscreteDistribution>
+class StreamingViterbi
+{
+ public:
+  /**
+   * Create the decoder for the given HMM.  The HMM is not copied, so it must
+   * outlive the decoder; if its parameters change, call Reset().
+   *
+   * @param hmm HMM to decode the states of.
+   * @param lag Number of steps before a state is committed.
+   */
+  StreamingViterbi(const HMM<Distribution>& hmm, const size_t lag);
+
+  /**
+   * Consume the next observation of the stream.  If a state was committed,
+   * it is stored in `state` and true is returned.
+   *
+   * @param observation Next observation.
+   * @param state Variable to store the committed state in.
+   * @return Whether a state was committed.
+   */
+  bool Step(const arma::vec& observation, size_t& state);
+
+  /**
+   * Finish the stream: store the states that were not committed yet (the
+   * last min(lag, steps) states) in `states`, and reset the decoder.
+   *
+   * @param states Vector to store the remaining states in.
+   * @return Log-likelihood of the most probable state sequence of the stream.
+   */
+  double Flush(arma::Row<size_t>& states);
+
+  /**
+   * Forget the stream, and take the parameters of the HMM again.
+   */
+  void Reset();
+
+  //! Get the log-likelihood of the most probable state sequence so far.
+  double LogLikelihood() const;
+
+  //! Get the number of observations consumed.
+  size_t Steps() const { return steps; }
+  //! Get the number of states committed.
+  size_t Committed() const { return committed; }
+  //! Get the lag.
+  size_t Lag() const { return lag; }
+
+ private:
+  //! The HMM.
+  const HMM<Distribution>* hmm;
+  //! The number of steps before a state is committed.
+  size_t lag;
+
+  //! The log of the transition matrix.
+  arma::mat logTransition;
+  //! The log of the initial state probabilities.
+  arma::vec logInitial;
+
+  //! The log-probabilities of the most probable sequences ending in each
+  //! state, relative to logOffset.
+  arma::vec logStateProb;
+  //! The offset of the log-probabilities.
+  double logOffset;
+  //! The backpointers of the last steps (step t is in column t % n_cols).
+  arma::umat backpointers;
+  //! The log-probabilities of the current observation.
+  arma::vec emissionLogProb;
+  //! The scores of the current step.
+  arma::mat scores;
+
+  //! The number of observations consumed.
+  size_t steps;
+  //! The number of states committed.
+  size_t committed;
+};
+
+} // namespace hmm
+} // namespace mlpack
+
+// Include implementation.
+#include "streaming_viterbi_impl.hpp"
+
+#endif
@@ -0,0 +1,135 @@
+/**
+ * @file methods/hmm/streaming_viterbi_impl.hpp
+ *
+ * Implementation of the StreamingViterbi class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HMM_STREAMING_VITERBI_IMPL_HPP
+#define MLPACK_METHODS_HMM_STREAMING_VITERBI_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "streaming_viterbi.hpp"
+
+namespace mlpack {
+namespace hmm {
+
+template<typename Distribution>
+StreamingViterbi<Distribution>::StreamingViterbi(
+    const HMM<Distribution>& hmm,
+    const size_t lag) :
+    hmm(&hmm),
+    lag(lag)
+{
+  Reset();
+}
+
+template<typename Distribution>
+bool StreamingViterbi<Distribution>::Step(const arma::vec& observation,
+                                          size_t& state)
+{
+  if (observation.n_elem != hmm->Dimensionality())
+  {
+    std::ostringstream oss;
+    oss << "StreamingViterbi::Step(): dimensionality of observation ("
+        << observation.n_elem << ") does not match dimensionality of HMM ("
+        << hmm->Dimensionality() << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Compute the log-probability of the observation under each state.
+  const arma::mat point(const_cast<double*>(observation.memptr()),
+      observation.n_elem, 1, false, true);
+  for (size_t i = 0; i < logTransition.n_rows; ++i)
+  {
+    arma::vec alias(emissionLogProb.memptr() + i, 1, false, true);
+    hmm->Emission()[i].LogProbability(point, alias);
+  }
+
+  if (steps == 0)
+  {
+    logStateProb = logInitial + emissionLogProb;
+  }
+  else
+  {
+    // Element (j, i) of the scores is the log-probability of being in state i
+    // and moving to state j, as in HMM::Predict().
+    scores = logTransition.each_row() + logStateProb.t();
+    backpointers.col(steps % backpointers.n_cols) = arma::index_max(scores, 1);
+    logStateProb = arma::max(scores, 1) + emissionLogProb;
+  }
+
+  // Keep the log-probabilities near zero, so that they don't underflow on
+  // long streams.
+  const double top = logStateProb.max();
+  if (std::isfinite(top))
+  {
+    logStateProb -= top;
+    logOffset += top;
+  }
+
+  ++steps;
+  if (steps <= lag)
+    return false;
+
+  // Backtrack from the most probable state to the step that is lag steps
+  // back.
+  state = logStateProb.index_max();
+  for (size_t t = steps - 1; t > steps - 1 - lag; --t)
+    state = backpointers(state, t % backpointers.n_cols);
+
+  ++committed;
+  return true;
+}
+
+template<typename Distribution>
+double StreamingViterbi<Distribution>::Flush(arma::Row<size_t>& states)
+{
+  states.set_size(steps - committed);
+  if (states.n_elem == 0)
+    return 0.0;
+
+  const double logLikelihood = LogLikelihood();
+  size_t state = logStateProb.index_max();
+  states[states.n_elem - 1] = state;
+  for (size_t t = steps - 1; t > committed; --t)
+  {
+    state = backpointers(state, t % backpointers.n_cols);
+    states[t - 1 - committed] = state;
+  }
+
+  Reset();
+  return logLikelihood;
+}
+
+template<typename Distribution>
+void StreamingViterbi<Distribution>::Reset()
+{
+  logTransition = arma::log(hmm->Transition());
+  logInitial = arma::log(hmm->Initial());
+  emissionLogProb.set_size(logTransition.n_rows);
+
+  // A committed state needs the backpointers of the last lag steps.
+  backpointers.set_size(logTransition.n_rows, std::max(lag, size_t(1)));
+  logStateProb.reset();
+  logOffset = 0.0;
+  steps = 0;
+  committed = 0;
+}
+
+template<typename Distribution>
+double StreamingViterbi<Distribution>::LogLikelihood() const
+{
+  if (steps == 0)
+    return 0.0;
+
+  return logOffset + logStateProb.max();
+}
+
+} // namespace hmm
+} // namespace mlpack
+
+#endif
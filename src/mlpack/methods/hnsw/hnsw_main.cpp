@@ -0,0 +1,249 @@
+/**
+ * @file methods/hnsw/hnsw_main.cpp
+ *
+ * This file computes the approximate nearest-neighbors using a hierarchical
+ * navigable small world graph.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/io.hpp>
+#include <mlpack/core/util/mlpack_main.hpp>
+
+#include "hnsw_search.hpp"
+
+using namespace std;
+using namespace mlpack;
+using namespace mlpack::neighbor;
+using namespace mlpack::util;
+
+// Program Name.
+BINDING_NAME("K-Approximate-Nearest-Neighbor Search with HNSW");
+
+// Short description.
+BINDING_SHORT_DESC(
+    "An implementation of approximate k-nearest-neighbor search with a "
+    "hierarchical navigable small world (HNSW) graph.  Given a set of reference"
+    " points and a set of query points, this will compute the k approximate "
+    "nearest neighbors of each query point in the reference set; models can be "
+    "saved for future use.");
+
+// Long description.
+BINDING_LONG_DESC(
+    "This program will calculate the k approximate-nearest-neighbors of a set "
+    "of points using a hierarchical navigable small world graph built on the "
+    "reference points.  You may specify a separate set of reference points and "
+    "query points, or just a reference set which will be used as both the "
+    "reference and query set.  This method is well suited to high-dimensional "
+    "data, where tree-based search is slow."
+    "\n\n"
+    "The graph links each point to about " + PRINT_PARAM_STRING("m") +
+    " of its neighbors, and is built with a search beam of width " +
+    PRINT_PARAM_STRING("ef_construction") + "; larger values of either give a "
+    "better graph but take longer to build.  Searches use a beam of width " +
+    PRINT_PARAM_STRING("ef_search") + ", which trades search speed for recall "
+    "and can be changed when a saved model is reused.");
+
+// Example.
+BINDING_EXAMPLE(
+    "For example, the following will return 5 neighbors from the data for each "
+    "point in " + PRINT_DATASET("input") + " and store the distances in " +
+    PRINT_DATASET("distances") + " and the neighbors in " +
+    PRINT_DATASET("neighbors") + ":"
+    "\n\n" +
+    PRINT_CALL("hnsw", "k", 5, "reference", "input", "distances", "distances",
+        "neighbors", "neighbors") +
+    "\n\n"
+    "The output is organized such that row i and column j in the neighbors "
+    "output corresponds to the index of the point in the reference set which "
+    "is the j'th nearest neighbor from the point in the query set with index "
+    "i.  Row j and column i in the distances output file corresponds to the "
+    "distance between those two points."
+    "\n\n"
+    "Because this is approximate-nearest-neighbors search, results may be "
+    "different from run to run.  Thus, the " + PRINT_PARAM_STRING("seed") +
+    " parameter can be specified to set the random seed (when the graph is "
+    "built with more than one thread, the results may still differ slightly).");
+
+// See also...
+BINDING_SEE_ALSO("@knn", "#knn");
+BINDING_SEE_ALSO("@lsh", "#lsh");
+BINDING_SEE_ALSO("Efficient and robust approximate nearest neighbor search "
+        "using Hierarchical Navigable Small World graphs (pdf)",
+        "https://arxiv.org/pdf/1603.09320.pdf");
+BINDING_SEE_ALSO("mlpack::neighbor::HNSWSearch C++ class documentation",
+        "@doxygen/classmlpack_1_1neighbor_1_1HNSWSearch.html");
+
+// Define our input parameters that this program will take.
+PARAM_MATRIX_IN("reference", "Matrix containing the reference dataset.", "r");
+PARAM_MATRIX_OUT("distances", "Matrix to output distances into.", "d");
+PARAM_UMATRIX_OUT("neighbors", "Matrix to output neighbors into.", "n");
+
+// We can load or save models.
+PARAM_MODEL_IN(HNSWSearch<>, "input_model", "Input HNSW model.", "m");
+PARAM_MODEL_OUT(HNSWSearch<>, "output_model", "Output for trained HNSW model.",
+    "M");
+
+// For testing recall.
+PARAM_UMATRIX_IN("true_neighbors", "Matrix of true neighbors to compute "
+    "recall with (the recall is printed when -v is specified).", "t");
+
+PARAM_INT_IN("k", "Number of nearest neighbors to find.", "k", 0);
+PARAM_MATRIX_IN("query", "Matrix containing query points (optional).", "q");
+
+PARAM_INT_IN("m", "Number of links of each point in the upper layers of the "
+    "graph (twice as many are allowed in the bottom layer).", "L", 16);
+PARAM_INT_IN("ef_construction", "Width of the search beam used when building "
+    "the graph.", "c", 200);
+PARAM_INT_IN("ef_search", "Width of the search beam used when searching.  If "
+    "0, the value stored in the model (or 50 for a new model) is used.", "e",
+    0);
+PARAM_INT_IN("seed", "Random seed.  If 0, 'std::time(NULL)' is used.", "s", 0);
+
+static void mlpackMain()
+{
+  if (IO::GetParam<int>("seed") != 0)
+    math::RandomSeed((size_t) IO::GetParam<int>("seed"));
+  else
+    math::RandomSeed((size_t) time(NULL));
+
+  // Get all the parameters after checking them.
+  if (IO::HasParam("k"))
+  {
+    RequireParamValue<int>("k", [](int x) { return x > 0; }, true,
+        "k must be greater than 0");
+  }
+  RequireParamValue<int>("m", [](int x) { return x >= 2; }, true,
+      "m must be at least 2");
+  RequireParamValue<int>("ef_construction", [](int x) { return x > 0; }, true,
+      "ef_construction must be greater than 0");
+  RequireParamValue<int>("ef_search", [](int x) { return x >= 0; }, true,
+      "ef_search must be nonnegative");
+
+  const size_t k = IO::GetParam<int>("k");
+
+  RequireOnlyOnePassed({ "input_model", "reference" }, true);
+  RequireAtLeastOnePassed({ "neighbors", "distances", "output_model" }, false,
+      "no results will be saved");
+  if (IO::HasParam("k"))
+  {
+    RequireAtLeastOnePassed({ "query", "reference", "input_model" }, true,
+        "must pass set to search");
+  }
+
+  if (IO::HasParam("input_model") && IO::HasParam("k") &&
+      !IO::HasParam("query"))
+  {
+    Log::Info << "Performing HNSW-based approximate nearest neighbor search on "
+        << "the reference dataset in the model stored in '"
+        << IO::GetPrintableParam<HNSWSearch<>>("input_model") << "'." << endl;
+  }
+
+  ReportIgnoredParam({{ "k", false }}, "neighbors");
+  ReportIgnoredParam({{ "k", false }}, "distances");
+  ReportIgnoredParam({{ "k", false }}, "ef_search");
+
+  ReportIgnoredParam({{ "reference", false }}, "m");
+  ReportIgnoredParam({{ "reference", false }}, "ef_construction");
+
+  if (IO::HasParam("input_model") && !IO::HasParam("k"))
+  {
+    Log::Warn << PRINT_PARAM_STRING("k") << " not passed; no search will be "
+        << "performed!" << std::endl;
+  }
+
+  // These declarations are here so that the matrices don't go out of scope.
+  arma::mat referenceData;
+  arma::mat queryData;
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+
+  HNSWSearch<>* hnsw;
+  if (IO::HasParam("reference"))
+  {
+    const size_t m = (size_t) IO::GetParam<int>("m");
+    const size_t efConstruction = (size_t) IO::GetParam<int>("ef_construction");
+
+    Log::Info << "Using HNSW with M = " << m << " and efConstruction = "
+        << efConstruction << "." << endl;
+
+    hnsw = new HNSWSearch<>(m, efConstruction);
+    Log::Info << "Using reference data from "
+        << IO::GetPrintableParam<arma::mat>("reference") << "." << endl;
+    referenceData = std::move(IO::GetParam<arma::mat>("reference"));
+
+    Timer::Start("graph_building");
+    hnsw->Train(std::move(referenceData));
+    Timer::Stop("graph_building");
+  }
+  else // We must have an input model.
+  {
+    hnsw = IO::GetParam<HNSWSearch<>*>("input_model");
+  }
+
+  if (IO::GetParam<int>("ef_search") != 0)
+    hnsw->EfSearch() = (size_t) IO::GetParam<int>("ef_search");
+
+  if (IO::HasParam("k"))
+  {
+    Log::Info << "Computing " << k << " distance approximate nearest neighbors "
+        << "with efSearch = " << hnsw->EfSearch() << "." << endl;
+
+    Timer::Start("computing_neighbors");
+    if (IO::HasParam("query"))
+    {
+      Log::Info << "Loaded query data from "
+          << IO::GetPrintableParam<arma::mat>("query") << "." << endl;
+      queryData = std::move(IO::GetParam<arma::mat>("query"));
+
+      hnsw->Search(queryData, k, neighbors, distances);
+    }
+    else
+    {
+      hnsw->Search(k, neighbors, distances);
+    }
+    Timer::Stop("computing_neighbors");
+
+    Log::Info << "Neighbors computed." << endl;
+  }
+
+  // Compute recall, if desired.
+  if (IO::HasParam("true_neighbors"))
+  {
+    Log::Info << "Using true neighbor indices from '"
+        << IO::GetPrintableParam<arma::Mat<size_t>>("true_neighbors") << "'."
+        << endl;
+
+    // Load the true neighbors.
+    arma::Mat<size_t> trueNeighbors =
+        std::move(IO::GetParam<arma::Mat<size_t>>("true_neighbors"));
+
+    if (trueNeighbors.n_rows != neighbors.n_rows ||
+        trueNeighbors.n_cols != neighbors.n_cols)
+    {
+      // Delete the model if needed.
+      if (IO::HasParam("reference"))
+        delete hnsw;
+      Log::Fatal << "The true neighbors file must have the same number of "
+          << "values as the set of neighbors being queried!" << endl;
+    }
+
+    // Compute recall and print it.
+    const double recallPercentage = 100 * hnsw->ComputeRecall(neighbors,
+        trueNeighbors);
+
+    Log::Info << "Recall: " << recallPercentage << endl;
+  }
+
+  // Save output, if we did a search.
+  if (IO::HasParam("k"))
+  {
+    IO::GetParam<arma::mat>("distances") = std::move(distances);
+    IO::GetParam<arma::Mat<size_t>>("neighbors") = std::move(neighbors);
+  }
+  IO::GetParam<HNSWSearch<>*>("output_model") = hnsw;
+}
@@ -0,0 +1,277 @@
+/**
+ * @file methods/hnsw/hnsw_search.hpp
+ *
+ * Defines the HNSWSearch class, which performs approximate nearest neighbor
+ * search with a hierarchical navigable small world (HNSW) graph.
+ *
+ * The details of this method can be found in the following paper:
+ *
+ * @code
+ * @article{malkov2018efficient,
+ *   title={Efficient and robust approximate nearest neighbor search using
+ *       hierarchical navigable small world graphs},
+ *   author={Malkov, Yu A. and Yashunin, Dmitry A.},
+ *   journal={IEEE Transactions on Pattern Analysis and Machine Intelligence},
+ *   volume={42},
+ *   number={4},
+ *   pages={824--836},
+ *   year={2018}
+ * }
+ * @endcode
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HNSW_HNSW_SEARCH_HPP
+#define MLPACK_METHODS_HNSW_HNSW_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+#include <cereal/types/vector.hpp>
+
+#include "node_locks.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The HNSWSearch class builds a hierarchical navigable small world graph on
+ * the reference set and uses it to compute approximate nearest neighbors of
+ * query points.
+ *
+ * Every reference point is a node of the bottom layer of the graph; each
+ * point is also placed on the layers above with exponentially decreasing
+ * probability.  In each layer a node is linked to about M of its nearest
+ * neighbors (2M in the bottom layer), chosen with a heuristic that keeps
+ * links in diverse directions.  A search descends greedily through the sparse
+ * upper layers and then explores the bottom layer with a beam of width
+ * efSearch; larger values of efSearch give better recall at the cost of slower
+ * searches.  The quality of the graph itself is controlled by efConstruction,
+ * the beam width used while inserting points.
+ *
+ * The graph is built in parallel when OpenMP is available: the layer of each
+ * point is drawn beforehand, and the points are then inserted concurrently,
+ * with a lock protecting the links of each node.  Because of this, the graph
+ * (and so the results) may differ slightly from run to run when more than one
+ * thread is used.
+ *
+ * @tparam MetricType The metric to use for distance computations.
+ * @tparam MatType Type of matrix to use to store the data.
+ */
+template<
+    typename MetricType = metric::EuclideanDistance,
+    typename MatType = arma::mat
+>
+class HNSWSearch
+{
+ public:
+  /**
+   * Build the graph on the given reference set.  In order to avoid copying the
+   * reference set, it is suggested to pass that parameter with std::move().
+   *
+   * @param referenceSet Set of reference points.
+   * @param m Number of links of each node in the upper layers (the bottom
+   *     layer allows twice as many).  Must be at least 2.
+   * @param efConstruction Width of the beam used when inserting points.
+   * @param efSearch Width of the beam used when searching.
+   * @param metric Instantiated metric.
+   */
+  HNSWSearch(MatType referenceSet,
+             const size_t m = 16,
+             const size_t efConstruction = 200,
+             const size_t efSearch = 50,
+             MetricType metric = MetricType());
+
+  /**
+   * Create an untrained HNSW model with the given parameters.  Be sure to call
+   * Train() before calling Search(); otherwise, an exception will be thrown
+   * when Search() is called.
+   *
+   * @param m Number of links of each node in the upper layers (the bottom
+   *     layer allows twice as many).  Must be at least 2.
+   * @param efConstruction Width of the beam used when inserting points.
+   * @param efSearch Width of the beam used when searching.
+   * @param metric Instantiated metric.
+   */
+  HNSWSearch(const size_t m = 16,
+             const size_t efConstruction = 200,
+             const size_t efSearch = 50,
+             MetricType metric = MetricType());
+
+  /**
+   * Build the graph on the given reference set, replacing any previous graph.
+   * The values of M and efConstruction set with M() and EfConstruction() are
+   * used.
+   *
+   * @param referenceSet Set of reference points.
+   */
+  void Train(MatType referenceSet);
+
+  /**
+   * Compute the approximate nearest neighbors of the points in the given query
+   * set and store the output in the given matrices.  The matrices will be set
+   * to the size of n columns by k rows, where n is the number of points in the
+   * query dataset and k is the number of neighbors being searched for.  The
+   * queries are answered in parallel.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances) const;
+
+  /**
+   * Compute the approximate nearest neighbors of each point in the reference
+   * set (the point itself is not returned as its own neighbor) and store the
+   * output in the given matrices.
+   *
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each point.
+   * @param distances Matrix storing distances of neighbors for each point.
+   */
+  void Search(const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances) const;
+
+  /**
+   * Compute the recall (% of neighbors found) given the neighbors returned by
+   * HNSWSearch::Search and a "ground truth" set of neighbors.  The recall
+   * returned will be in the range [0, 1].
+   *
+   * @param foundNeighbors Set of neighbors to compute recall of.
+   * @param realNeighbors Set of "ground truth" neighbors to compute recall
+   *     against.
+   */
+  static double ComputeRecall(const arma::Mat<size_t>& foundNeighbors,
+                              const arma::Mat<size_t>& realNeighbors);
+
+  /**
+   * Serialize the HNSW model.
+   *
+   * @param ar Archive to serialize to.
+   * @param version serialize class version to provide backward compatibility
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t version);
+
+  //! Return the reference dataset.
+  const MatType& ReferenceSet() const { return referenceSet; }
+
+  //! Get the number of links of each node in the upper layers.
+  size_t M() const { return m; }
+  //! Modify the number of links of each node in the upper layers.  This only
+  //! takes effect the next time Train() is called.
+  size_t& M() { return m; }
+
+  //! Get the width of the beam used when inserting points.
+  size_t EfConstruction() const { return efConstruction; }
+  //! Modify the width of the beam used when inserting points.  This only takes
+  //! effect the next time Train() is called.
+  size_t& EfConstruction() { return efConstruction; }
+
+  //! Get the width of the beam used when searching.
+  size_t EfSearch() const { return efSearch; }
+  //! Modify the width of the beam used when searching.
+  size_t& EfSearch() { return efSearch; }
+
+  //! Get the highest layer of the graph.
+  size_t MaxLevel() const { return maxLevel; }
+  //! Get the layer of each reference point.
+  const std::vector<size_t>& Levels() const { return levels; }
+  //! Get the links of the given point in the given layer.
+  const std::vector<size_t>& Links(const size_t point, const size_t level) const
+  { return links[point][level]; }
+
+  //! Get the instantiated metric.
+  const MetricType& Metric() const { return metric; }
+  //! Modify the instantiated metric.
+  MetricType& Metric() { return metric; }
+
+ private:
+  //! A candidate: the distance to a point, and the index of the point.
+  typedef std::pair<double, size_t> Candidate;
+
+  //! Insert the given reference point into the graph.
+  void InsertPoint(const size_t point, NodeLocks& locks);
+
+  /**
+   * Starting from the given point, walk greedily through the given layer
+   * towards the given query point, and return the closest point found.
+   */
+  template<typename VecType>
+  Candidate GreedySearch(const VecType& query,
+                         Candidate entry,
+                         const size_t level,
+                         NodeLocks& locks) const;
+
+  /**
+   * Search the given layer for the ef nearest points to the given query point,
+   * starting from the given point.  The results are sorted by increasing
+   * distance.
+   */
+  template<typename VecType>
+  void SearchLayer(const VecType& query,
+                   const Candidate& entry,
+                   const size_t ef,
+                   const size_t level,
+                   NodeLocks& locks,
+                   std::vector<Candidate>& results) const;
+
+  /**
+   * Choose at most maxLinks of the given candidates (sorted by increasing
+   * distance) to link to: a candidate is kept only if it is closer to the
+   * point than to all the candidates kept before it.
+   */
+  void SelectNeighbors(const std::vector<Candidate>& candidates,
+                       const size_t maxLinks,
+                       std::vector<size_t>& selected) const;
+
+  //! Add a link from the given point to the given new neighbor, pruning the
+  //! links of the point if it has too many.
+  void AddLink(const size_t point, const size_t neighbor, const size_t level);
+
+  //! Search the graph for the nearest neighbors of one query point.
+  template<typename VecType>
+  void SearchPoint(const VecType& query,
+                   const size_t ef,
+                   std::vector<Candidate>& results) const;
+
+  //! Get the largest number of links a node may have in the given layer.
+  size_t MaxLinks(const size_t level) const
+  { return (level == 0) ? 2 * m : m; }
+
+  //! Reference dataset.
+  MatType referenceSet;
+  //! Number of links of each node in the upper layers.
+  size_t m;
+  //! Width of the beam used when inserting points.
+  size_t efConstruction;
+  //! Width of the beam used when searching.
+  size_t efSearch;
+  //! Instantiated metric.
+  MetricType metric;
+
+  //! Highest layer of each point.
+  std::vector<size_t> levels;
+  //! Links of each point in each of its layers.
+  std::vector<std::vector<std::vector<size_t>>> links;
+  //! Point on the highest layer, where searches start.
+  size_t entryPoint;
+  //! Highest layer of the graph.
+  size_t maxLevel;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "hnsw_search_impl.hpp"
+
+#endif
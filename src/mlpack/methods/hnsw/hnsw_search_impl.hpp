@@ -0,0 +1,475 @@
+/**
+ * @file methods/hnsw/hnsw_search_impl.hpp
+ *
+ * Implementation of the HNSWSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HNSW_HNSW_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_HNSW_HNSW_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "hnsw_search.hpp"
+
+#include <queue>
+#include <unordered_set>
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename MetricType, typename MatType>
+HNSWSearch<MetricType, MatType>::HNSWSearch(MatType referenceSet,
+                                            const size_t m,
+                                            const size_t efConstruction,
+                                            const size_t efSearch,
+                                            MetricType metric) :
+    m(m),
+    efConstruction(efConstruction),
+    efSearch(efSearch),
+    metric(std::move(metric)),
+    entryPoint(0),
+    maxLevel(0)
+{
+  Train(std::move(referenceSet));
+}
+
+template<typename MetricType, typename MatType>
+HNSWSearch<MetricType, MatType>::HNSWSearch(const size_t m,
+                                            const size_t efConstruction,
+                                            const size_t efSearch,
+                                            MetricType metric) :
+    m(m),
+    efConstruction(efConstruction),
+    efSearch(efSearch),
+    metric(std::move(metric)),
+    entryPoint(0),
+    maxLevel(0)
+{
+  if (m < 2)
+    throw std::invalid_argument("HNSWSearch: M must be at least 2!");
+}
+
+template<typename MetricType, typename MatType>
+void HNSWSearch<MetricType, MatType>::Train(MatType referenceSetIn)
+{
+  if (m < 2)
+    throw std::invalid_argument("HNSWSearch::Train(): M must be at least 2!");
+
+  if (efConstruction == 0)
+  {
+    throw std::invalid_argument("HNSWSearch::Train(): efConstruction must be "
+        "positive!");
+  }
+
+  referenceSet = std::move(referenceSetIn);
+  const size_t numPoints = referenceSet.n_cols;
+
+  levels.assign(numPoints, 0);
+  links.clear();
+  links.resize(numPoints);
+  entryPoint = 0;
+  maxLevel = 0;
+  if (numPoints == 0)
+    return;
+
+  // Draw the layer of each point from an exponential distribution.  This uses
+  // the shared random number generator, so it is done before the parallel
+  // insertions.
+  const double levelScale = 1.0 / std::log((double) m);
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    levels[i] = (size_t) std::floor(-std::log(1.0 - math::Random()) *
+        levelScale);
+    links[i].resize(levels[i] + 1);
+
+    if (levels[i] > maxLevel)
+    {
+      maxLevel = levels[i];
+      entryPoint = i;
+    }
+  }
+
+  // The entry point of the graph is the first point in its highest layer, so
+  // it does not need to be inserted, and it never changes while the other
+  // points are inserted concurrently.
+  NodeLocks locks(numPoints);
+
+  #pragma omp parallel for schedule(dynamic, 16)
+  for (omp_size_t i = 0; i < (omp_size_t) numPoints; ++i)
+  {
+    if ((size_t) i != entryPoint)
+      InsertPoint(i, locks);
+  }
+}
+
+template<typename MetricType, typename MatType>
+void HNSWSearch<MetricType, MatType>::Search(const MatType& querySet,
+                                             const size_t k,
+                                             arma::Mat<size_t>& neighbors,
+                                             arma::mat& distances) const
+{
+  if (k > referenceSet.n_cols)
+  {
+    std::stringstream ss;
+    ss << "HNSWSearch::Search(): requested " << k << " approximate nearest "
+        << "neighbors, but reference set has " << referenceSet.n_cols
+        << " points!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  if (querySet.n_rows != referenceSet.n_rows)
+  {
+    std::stringstream ss;
+    ss << "HNSWSearch::Search(): dimensionality of query set ("
+        << querySet.n_rows << ") is not equal to the dimensionality the model "
+        << "was trained on (" << referenceSet.n_rows << ")!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+  if (k == 0)
+    return;
+
+  const size_t ef = std::max(efSearch, k);
+
+  #pragma omp parallel
+  {
+    std::vector<Candidate> results;
+
+    #pragma omp for schedule(dynamic, 16)
+    for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+    {
+      SearchPoint(querySet.col(i), ef, results);
+      for (size_t j = 0; j < k; ++j)
+      {
+        // If part of the graph can't be reached from the entry point, fewer
+        // than k points may be found.
+        if (j < results.size())
+        {
+          neighbors(j, i) = results[j].second;
+          distances(j, i) = results[j].first;
+        }
+        else
+        {
+          neighbors(j, i) = SIZE_MAX;
+          distances(j, i) = DBL_MAX;
+        }
+      }
+    }
+  }
+}
+
+template<typename MetricType, typename MatType>
+void HNSWSearch<MetricType, MatType>::Search(const size_t k,
+                                             arma::Mat<size_t>& neighbors,
+                                             arma::mat& distances) const
+{
+  if (k >= referenceSet.n_cols)
+  {
+    std::stringstream ss;
+    ss << "HNSWSearch::Search(): requested " << k << " approximate nearest "
+        << "neighbors, but reference set has " << referenceSet.n_cols
+        << " points (and the query point itself is not a neighbor)!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  neighbors.set_size(k, referenceSet.n_cols);
+  distances.set_size(k, referenceSet.n_cols);
+  if (k == 0)
+    return;
+
+  // One more neighbor is needed, since the point itself will usually be
+  // found.
+  const size_t ef = std::max(efSearch, k + 1);
+
+  #pragma omp parallel
+  {
+    std::vector<Candidate> results;
+
+    #pragma omp for schedule(dynamic, 16)
+    for (omp_size_t i = 0; i < (omp_size_t) referenceSet.n_cols; ++i)
+    {
+      SearchPoint(referenceSet.col(i), ef, results);
+      size_t found = 0;
+      for (size_t j = 0; j < results.size() && found < k; ++j)
+      {
+        if (results[j].second == (size_t) i)
+          continue;
+
+        neighbors(found, i) = results[j].second;
+        distances(found, i) = results[j].first;
+        ++found;
+      }
+
+      for (; found < k; ++found)
+      {
+        neighbors(found, i) = SIZE_MAX;
+        distances(found, i) = DBL_MAX;
+      }
+    }
+  }
+}
+
+template<typename MetricType, typename MatType>
+double HNSWSearch<MetricType, MatType>::ComputeRecall(
+    const arma::Mat<size_t>& foundNeighbors,
+    const arma::Mat<size_t>& realNeighbors)
+{
+  if (foundNeighbors.n_rows != realNeighbors.n_rows ||
+      foundNeighbors.n_cols != realNeighbors.n_cols)
+    throw std::invalid_argument("HNSWSearch::ComputeRecall(): matrices "
+        "provided must have equal size");
+
+  // The recall is the set intersection of found and real neighbors.
+  size_t found = 0;
+  for (size_t col = 0; col < foundNeighbors.n_cols; ++col)
+    for (size_t row = 0; row < foundNeighbors.n_rows; ++row)
+      for (size_t nei = 0; nei < realNeighbors.n_rows; ++nei)
+        if (realNeighbors(row, col) == foundNeighbors(nei, col))
+        {
+          found++;
+          break;
+        }
+
+  return (realNeighbors.n_elem == 0) ? 1.0 :
+      ((double) found) / realNeighbors.n_elem;
+}
+
+template<typename MetricType, typename MatType>
+template<typename Archive>
+void HNSWSearch<MetricType, MatType>::serialize(Archive& ar,
+                                                const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(referenceSet));
+  ar(CEREAL_NVP(m));
+  ar(CEREAL_NVP(efConstruction));
+  ar(CEREAL_NVP(efSearch));
+  ar(CEREAL_NVP(metric));
+  ar(CEREAL_NVP(levels));
+  ar(CEREAL_NVP(links));
+  ar(CEREAL_NVP(entryPoint));
+  ar(CEREAL_NVP(maxLevel));
+}
+
+template<typename MetricType, typename MatType>
+void HNSWSearch<MetricType, MatType>::InsertPoint(const size_t point,
+                                                  NodeLocks& locks)
+{
+  const auto query = referenceSet.col(point);
+  Candidate entry(metric.Evaluate(query, referenceSet.col(entryPoint)),
+      entryPoint);
+
+  // Descend greedily through the layers above the layer of the point.
+  for (size_t level = maxLevel; level > levels[point]; --level)
+    entry = GreedySearch(query, entry, level, locks);
+
+  std::vector<Candidate> candidates;
+  std::vector<size_t> selected;
+  for (size_t l = std::min(levels[point], maxLevel) + 1; l > 0; --l)
+  {
+    const size_t level = l - 1;
+    SearchLayer(query, entry, efConstruction, level, locks, candidates);
+
+    // Another thread may already have linked to this point, so it can be found
+    // by its own search.
+    for (size_t i = 0; i < candidates.size(); ++i)
+    {
+      if (candidates[i].second == point)
+      {
+        candidates.erase(candidates.begin() + i);
+        break;
+      }
+    }
+
+    if (candidates.empty())
+      continue;
+
+    SelectNeighbors(candidates, m, selected);
+
+    // Other threads may already have linked to this point, so its links may
+    // need to be pruned too.
+    locks.Lock(point);
+    for (size_t i = 0; i < selected.size(); ++i)
+      AddLink(point, selected[i], level);
+    locks.Unlock(point);
+
+    // Link the neighbors back to the point.
+    for (size_t i = 0; i < selected.size(); ++i)
+    {
+      locks.Lock(selected[i]);
+      AddLink(selected[i], point, level);
+      locks.Unlock(selected[i]);
+    }
+
+    entry = candidates[0];
+  }
+}
+
+template<typename MetricType, typename MatType>
+template<typename VecType>
+typename HNSWSearch<MetricType, MatType>::Candidate
+HNSWSearch<MetricType, MatType>::GreedySearch(const VecType& query,
+                                              Candidate entry,
+                                              const size_t level,
+                                              NodeLocks& locks) const
+{
+  std::vector<size_t> neighbors;
+  bool changed = true;
+  while (changed)
+  {
+    changed = false;
+
+    locks.Lock(entry.second);
+    neighbors = links[entry.second][level];
+    locks.Unlock(entry.second);
+
+    for (size_t i = 0; i < neighbors.size(); ++i)
+    {
+      const double distance = metric.Evaluate(query,
+          referenceSet.col(neighbors[i]));
+      if (distance < entry.first)
+      {
+        entry = Candidate(distance, neighbors[i]);
+        changed = true;
+      }
+    }
+  }
+
+  return entry;
+}
+
+template<typename MetricType, typename MatType>
+template<typename VecType>
+void HNSWSearch<MetricType, MatType>::SearchLayer(
+    const VecType& query,
+    const Candidate& entry,
+    const size_t ef,
+    const size_t level,
+    NodeLocks& locks,
+    std::vector<Candidate>& results) const
+{
+  // Points still to be expanded, nearest first.
+  std::priority_queue<Candidate, std::vector<Candidate>,
+      std::greater<Candidate>> candidates;
+  // The ef nearest points found so far, farthest first.
+  std::priority_queue<Candidate> nearest;
+  std::unordered_set<size_t> visited;
+
+  candidates.push(entry);
+  nearest.push(entry);
+  visited.insert(entry.second);
+
+  std::vector<size_t> neighbors;
+  while (!candidates.empty())
+  {
+    const Candidate current = candidates.top();
+    if (current.first > nearest.top().first && nearest.size() >= ef)
+      break;
+    candidates.pop();
+
+    locks.Lock(current.second);
+    neighbors = links[current.second][level];
+    locks.Unlock(current.second);
+
+    for (size_t i = 0; i < neighbors.size(); ++i)
+    {
+      if (!visited.insert(neighbors[i]).second)
+        continue;
+
+      const double distance = metric.Evaluate(query,
+          referenceSet.col(neighbors[i]));
+      if (nearest.size() < ef || distance < nearest.top().first)
+      {
+        candidates.push(Candidate(distance, neighbors[i]));
+        nearest.push(Candidate(distance, neighbors[i]));
+        if (nearest.size() > ef)
+          nearest.pop();
+      }
+    }
+  }
+
+  results.resize(nearest.size());
+  for (size_t i = results.size(); i > 0; --i)
+  {
+    results[i - 1] = nearest.top();
+    nearest.pop();
+  }
+}
+
+template<typename MetricType, typename MatType>
+void HNSWSearch<MetricType, MatType>::SelectNeighbors(
+    const std::vector<Candidate>& candidates,
+    const size_t maxLinks,
+    std::vector<size_t>& selected) const
+{
+  selected.clear();
+  for (size_t i = 0; i < candidates.size() && selected.size() < maxLinks; ++i)
+  {
+    bool keep = true;
+    for (size_t j = 0; j < selected.size(); ++j)
+    {
+      if (metric.Evaluate(referenceSet.col(candidates[i].second),
+          referenceSet.col(selected[j])) < candidates[i].first)
+      {
+        keep = false;
+        break;
+      }
+    }
+
+    if (keep)
+      selected.push_back(candidates[i].second);
+  }
+}
+
+template<typename MetricType, typename MatType>
+void HNSWSearch<MetricType, MatType>::AddLink(const size_t point,
+                                              const size_t neighbor,
+                                              const size_t level)
+{
+  std::vector<size_t>& pointLinks = links[point][level];
+  if (std::find(pointLinks.begin(), pointLinks.end(), neighbor) !=
+      pointLinks.end())
+    return;
+
+  pointLinks.push_back(neighbor);
+  if (pointLinks.size() <= MaxLinks(level))
+    return;
+
+  // There are too many links; keep a diverse subset of them.
+  std::vector<Candidate> candidates(pointLinks.size());
+  for (size_t i = 0; i < pointLinks.size(); ++i)
+  {
+    candidates[i] = Candidate(metric.Evaluate(referenceSet.col(point),
+        referenceSet.col(pointLinks[i])), pointLinks[i]);
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  SelectNeighbors(candidates, MaxLinks(level), pointLinks);
+}
+
+template<typename MetricType, typename MatType>
+template<typename VecType>
+void HNSWSearch<MetricType, MatType>::SearchPoint(
+    const VecType& query,
+    const size_t ef,
+    std::vector<Candidate>& results) const
+{
+  // The graph is not modified during searches, so no locks are needed.
+  NodeLocks locks;
+
+  Candidate entry(metric.Evaluate(query, referenceSet.col(entryPoint)),
+      entryPoint);
+  for (size_t level = maxLevel; level > 0; --level)
+    entry = GreedySearch(query, entry, level, locks);
+
+  SearchLayer(query, entry, ef, 0, locks, results);
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
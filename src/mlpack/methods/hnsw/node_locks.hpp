@@ -0,0 +1,99 @@
+/**
+ * @file methods/hnsw/node_locks.hpp
+ *
+ * A set of per-node locks, used to guard the adjacency lists of the HNSW graph
+ * while it is built in parallel.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HNSW_NODE_LOCKS_HPP
+#define MLPACK_METHODS_HNSW_NODE_LOCKS_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * NodeLocks holds one lock for each node of a graph.  When OpenMP is not
+ * available, or when the object was created with no nodes (as is done when
+ * the graph is only read), locking and unlocking do nothing.
+ */
+class NodeLocks
+{
+ public:
+  /**
+   * Create the locks.
+   *
+   * @param nodes Number of nodes to create a lock for.
+   */
+  NodeLocks(const size_t nodes = 0)
+  {
+    #ifdef HAS_OPENMP
+    locks.resize(nodes);
+    for (size_t i = 0; i < nodes; ++i)
+      omp_init_lock(&locks[i]);
+    #else
+    (void) nodes;
+    #endif
+  }
+
+  // The locks can't be copied.
+  NodeLocks(const NodeLocks& other) = delete;
+  NodeLocks& operator=(const NodeLocks& other) = delete;
+
+  //! Destroy the locks.
+  ~NodeLocks()
+  {
+    #ifdef HAS_OPENMP
+    for (size_t i = 0; i < locks.size(); ++i)
+      omp_destroy_lock(&locks[i]);
+    #endif
+  }
+
+  //! Get the number of locks (0 if OpenMP is not available).
+  size_t Size() const
+  {
+    #ifdef HAS_OPENMP
+    return locks.size();
+    #else
+    return 0;
+    #endif
+  }
+
+  //! Acquire the lock of the given node.
+  void Lock(const size_t node)
+  {
+    #ifdef HAS_OPENMP
+    if (!locks.empty())
+      omp_set_lock(&locks[node]);
+    #else
+    (void) node;
+    #endif
+  }
+
+  //! Release the lock of the given node.
+  void Unlock(const size_t node)
+  {
+    #ifdef HAS_OPENMP
+    if (!locks.empty())
+      omp_unset_lock(&locks[node]);
+    #else
+    (void) node;
+    #endif
+  }
+
+ private:
+  #ifdef HAS_OPENMP
+  //! The lock of each node.
+  std::vector<omp_lock_t> locks;
+  #endif
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
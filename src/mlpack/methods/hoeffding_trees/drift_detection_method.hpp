@@ -0,0 +1,153 @@
+/**
+ * @file methods/hoeffding_trees/drift_detection_method.hpp
+ *
+ * Definition of the DriftDetectionMethod class, which watches the errors of a
+ * streaming classifier for signs of concept drift.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HOEFFDING_TREES_DRIFT_DETECTION_METHOD_HPP
+#define MLPACK_METHODS_HOEFFDING_TREES_DRIFT_DETECTION_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The drift detection method (DDM) of Gama et al. watches the stream of errors
+ * of a classifier.  While the concept is stable, the error rate p (and its
+ * standard deviation s) should not grow, so the method remembers the smallest
+ * p + s seen, and signals a warning when p + s exceeds it by warningLevel
+ * times that standard deviation, and a drift when it exceeds it by driftLevel
+ * times.  For more information, see the following paper:
+ *
+ * @code
+ * @inproceedings{gama2004learning,
+ *   title={Learning with Drift Detection},
+ *   author={Gama, Jo{\~a}o and Medas, Pedro and Castillo, Gladys and
+ *       Rodrigues, Pedro},
+ *   booktitle={Proceedings of the 17th Brazilian Symposium on Artificial
+ *       Intelligence (SBIA 2004)},
+ *   pages={286--295},
+ *   year={2004}
+ * }
+ * @endcode
+ *
+ * The error rate is estimated as (errors + 1) / (samples + 2), so that a run
+ * without any errors does not make the very next error a drift.
+ */
+class DriftDetectionMethod
+{
+ public:
+  //! The state of the stream after an update.
+  enum Status
+  {
+    STABLE,
+    WARNING,
+    DRIFT
+  };
+
+  /**
+   * Create the detector.
+   *
+   * @param minSamples Number of samples before a warning or drift can be
+   *     signaled.
+   * @param warningLevel Number of standard deviations for a warning.
+   * @param driftLevel Number of standard deviations for a drift.
+   */
+  DriftDetectionMethod(const size_t minSamples = 30,
+                       const double warningLevel = 2.0,
+                       const double driftLevel = 3.0) :
+      minSamples(minSamples),
+      warningLevel(warningLevel),
+      driftLevel(driftLevel)
+  {
+    Reset();
+  }
+
+  /**
+   * Add the result of one prediction.  When a drift is signaled, the detector
+   * is reset.
+   *
+   * @param error Whether the prediction was wrong.
+   * @return The state of the stream.
+   */
+  Status Update(const bool error)
+  {
+    ++samples;
+    if (error)
+      ++errors;
+
+    const double n = samples + 2.0;
+    const double p = (errors + 1.0) / n;
+    const double s = std::sqrt(p * (1.0 - p) / n);
+    if (samples < minSamples)
+      return STABLE;
+
+    if (p + s < minP + minS)
+    {
+      minP = p;
+      minS = s;
+    }
+
+    if (p + s > minP + driftLevel * minS)
+    {
+      Reset();
+      return DRIFT;
+    }
+
+    return (p + s > minP + warningLevel * minS) ? WARNING : STABLE;
+  }
+
+  //! Forget everything seen so far.
+  void Reset()
+  {
+    samples = 0;
+    errors = 0;
+    minP = std::numeric_limits<double>::max();
+    minS = std::numeric_limits<double>::max();
+  }
+
+  //! Get the number of samples since the last reset.
+  size_t Samples() const { return samples; }
+  //! Get the number of errors since the last reset.
+  size_t Errors() const { return errors; }
+
+  //! Serialize the detector.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(minSamples));
+    ar(CEREAL_NVP(warningLevel));
+    ar(CEREAL_NVP(driftLevel));
+    ar(CEREAL_NVP(samples));
+    ar(CEREAL_NVP(errors));
+    ar(CEREAL_NVP(minP));
+    ar(CEREAL_NVP(minS));
+  }
+
+ private:
+  //! The number of samples before a warning or drift can be signaled.
+  size_t minSamples;
+  //! The number of standard deviations for a warning.
+  double warningLevel;
+  //! The number of standard deviations for a drift.
+  double driftLevel;
+  //! The number of samples since the last reset.
+  size_t samples;
+  //! The number of errors since the last reset.
+  size_t errors;
+  //! The error rate where p + s was smallest.
+  double minP;
+  //! The standard deviation where p + s was smallest.
+  double minS;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
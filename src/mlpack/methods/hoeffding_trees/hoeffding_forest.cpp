@@ -0,0 +1,240 @@
+/**
+ * @file methods/hoeffding_trees/hoeffding_forest.cpp
+ *
+ * Implementation of the HoeffdingForest class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "hoeffding_forest.hpp"
+
+#include <mlpack/core/math/random.hpp>
+
+using namespace mlpack;
+using namespace mlpack::tree;
+
+HoeffdingForest::HoeffdingForest(const HoeffdingTreeModel::TreeType type,
+                                 const size_t numTrees,
+                                 const double lambda,
+                                 const double warningLevel,
+                                 const double driftLevel) :
+    type(type),
+    numTrees(numTrees),
+    lambda(lambda),
+    warningLevel(warningLevel),
+    driftLevel(driftLevel),
+    numClasses(0),
+    successProbability(0.95),
+    maxSamples(0),
+    checkInterval(100),
+    minSamples(100),
+    bins(10),
+    observationsBeforeBinning(100),
+    drifts(0)
+{
+  if (numTrees == 0)
+  {
+    throw std::invalid_argument("HoeffdingForest::HoeffdingForest(): the "
+        "number of trees must be positive!");
+  }
+
+  if (lambda <= 0.0)
+  {
+    throw std::invalid_argument("HoeffdingForest::HoeffdingForest(): lambda "
+        "must be positive!");
+  }
+
+  if (warningLevel > driftLevel)
+  {
+    throw std::invalid_argument("HoeffdingForest::HoeffdingForest(): the "
+        "warning level must not be greater than the drift level!");
+  }
+}
+
+void HoeffdingForest::BuildModel(const data::DatasetInfo& datasetInfo,
+                                 const size_t numClasses,
+                                 const double successProbability,
+                                 const size_t maxSamples,
+                                 const size_t checkInterval,
+                                 const size_t minSamples,
+                                 const size_t bins,
+                                 const size_t observationsBeforeBinning)
+{
+  this->datasetInfo = datasetInfo;
+  this->numClasses = numClasses;
+  this->successProbability = successProbability;
+  this->maxSamples = maxSamples;
+  this->checkInterval = checkInterval;
+  this->minSamples = minSamples;
+  this->bins = bins;
+  this->observationsBeforeBinning = observationsBeforeBinning;
+
+  drifts = 0;
+  trees.clear();
+  trees.resize(numTrees);
+  for (size_t i = 0; i < numTrees; ++i)
+  {
+    trees[i].tree = NewTree();
+    trees[i].hasBackground = false;
+    trees[i].detector = DriftDetectionMethod(30, warningLevel, driftLevel);
+    trees[i].tested = 0;
+    trees[i].correct = 0;
+  }
+}
+
+void HoeffdingForest::Train(const arma::mat& dataset,
+                            const arma::Row<size_t>& labels)
+{
+  if (trees.empty())
+  {
+    throw std::invalid_argument("HoeffdingForest::Train(): BuildModel() must "
+        "be called before Train()!");
+  }
+
+  if (dataset.n_cols != labels.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "HoeffdingForest::Train(): number of labels (" << labels.n_elem
+        << ") does not match number of points (" << dataset.n_cols << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (dataset.n_cols == 0)
+    return;
+
+  // Draw the seeds of the Poisson weights here, so that the result does not
+  // depend on the number of threads.
+  std::vector<size_t> seeds(trees.size());
+  for (size_t i = 0; i < trees.size(); ++i)
+    seeds[i] = math::RandGen()();
+
+  std::vector<char> drifted(trees.size(), false);
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) trees.size(); ++i)
+    drifted[i] = TrainMember(trees[i], dataset, labels, seeds[i]);
+
+  for (size_t i = 0; i < trees.size(); ++i)
+  {
+    if (drifted[i])
+      ++drifts;
+  }
+}
+
+void HoeffdingForest::Classify(const arma::mat& dataset,
+                               arma::Row<size_t>& predictions) const
+{
+  arma::rowvec probabilities;
+  Classify(dataset, predictions, probabilities);
+}
+
+void HoeffdingForest::Classify(const arma::mat& dataset,
+                               arma::Row<size_t>& predictions,
+                               arma::rowvec& probabilities) const
+{
+  if (trees.empty())
+  {
+    throw std::invalid_argument("HoeffdingForest::Classify(): BuildModel() "
+        "must be called before Classify()!");
+  }
+
+  // Each tree classifies the points on its own (the trees classify points in
+  // parallel themselves), and then the votes are counted.
+  arma::mat votes(numClasses, dataset.n_cols, arma::fill::zeros);
+  arma::Row<size_t> treePredictions;
+  for (size_t t = 0; t < trees.size(); ++t)
+  {
+    // The accuracy is estimated as if the tree had already been right and
+    // wrong once, so that new trees still get a vote.
+    const Member& member = trees[t];
+    const double weight = (member.correct + 1.0) / (member.tested + 2.0);
+    member.tree.Classify(dataset, treePredictions);
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+      votes(treePredictions[i], i) += weight;
+  }
+
+  predictions.set_size(dataset.n_cols);
+  probabilities.set_size(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    predictions[i] = votes.col(i).index_max();
+    probabilities[i] = votes(predictions[i], i) / arma::accu(votes.col(i));
+  }
+}
+
+HoeffdingTreeModel HoeffdingForest::NewTree() const
+{
+  HoeffdingTreeModel tree(type);
+  tree.BuildModel(arma::mat(datasetInfo.Dimensionality(), 0), datasetInfo,
+      arma::Row<size_t>(), numClasses, false, successProbability, maxSamples,
+      checkInterval, minSamples, bins, observationsBeforeBinning);
+  return tree;
+}
+
+bool HoeffdingForest::TrainMember(Member& member,
+                                  const arma::mat& dataset,
+                                  const arma::Row<size_t>& labels,
+                                  const size_t seed) const
+{
+  // Test the tree on the batch before training on it.
+  arma::Row<size_t> predictions;
+  member.tree.Classify(dataset, predictions);
+  bool warning = false;
+  bool drift = false;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    const bool error = (predictions[i] != labels[i]);
+    member.tested++;
+    if (!error)
+      member.correct++;
+
+    const DriftDetectionMethod::Status status = member.detector.Update(error);
+    if (status == DriftDetectionMethod::WARNING)
+      warning = true;
+    else if (status == DriftDetectionMethod::DRIFT)
+      drift = true;
+  }
+
+  // Online bagging: each point is given to the tree k times, with k drawn from
+  // a Poisson distribution.
+  std::mt19937 generator(seed);
+  std::poisson_distribution<size_t> poisson(lambda);
+  std::vector<arma::uword> indices;
+  indices.reserve((size_t) (lambda * dataset.n_cols) + 1);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    const size_t k = poisson(generator);
+    for (size_t j = 0; j < k; ++j)
+      indices.push_back(i);
+  }
+
+  if (!indices.empty())
+  {
+    const arma::uvec weighted(indices);
+    const arma::mat weightedData = dataset.cols(weighted);
+    const arma::Row<size_t> weightedLabels = labels.cols(weighted);
+    member.tree.Train(weightedData, weightedLabels, false);
+    if (member.hasBackground)
+      member.background.Train(weightedData, weightedLabels, false);
+  }
+
+  if (drift)
+  {
+    // Replace the tree by its background tree, or by a new one.
+    member.tree = member.hasBackground ? std::move(member.background) :
+        NewTree();
+    member.background = HoeffdingTreeModel(type);
+    member.hasBackground = false;
+    member.detector.Reset();
+    member.tested = 0;
+    member.correct = 0;
+  }
+  else if (warning && !member.hasBackground)
+  {
+    member.background = NewTree();
+    member.hasBackground = true;
+  }
+
+  return drift;
+}
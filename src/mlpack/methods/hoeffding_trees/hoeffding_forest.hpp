@@ -0,0 +1,263 @@
+/**
+ * @file methods/hoeffding_trees/hoeffding_forest.hpp
+ *
+ * Definition of the HoeffdingForest class, an online bagging ensemble of
+ * Hoeffding trees that adapts to concept drift.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_FOREST_HPP
+#define MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_FOREST_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "hoeffding_tree_model.hpp"
+#include "drift_detection_method.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The HoeffdingForest is an ensemble of Hoeffding trees for classifying
+ * streams whose concept may drift, in the manner of the adaptive random forest
+ * of Gomes et al.:
+ *
+ * @code
+ * @article{gomes2017adaptive,
+ *   title={Adaptive Random Forests for Evolving Data Stream Classification},
+ *   author={Gomes, Heitor M. and Bifet, Albert and Read, Jesse and Barddal,
+ *       Jean Paul and Enembreck, Fabr{\'i}cio and Pfharinger, Bernhard and
+ *       Holmes, Geoff and Abdessalem, Talel},
+ *   journal={Machine Learning},
+ *   volume={106},
+ *   number={9},
+ *   pages={1469--1495},
+ *   year={2017}
+ * }
+ * @endcode
+ *
+ * Each tree is trained with online bagging: every point is given to it k
+ * times, where k is drawn from a Poisson distribution with mean lambda.  The
+ * errors each tree makes on the points before training on them are watched by
+ * a DriftDetectionMethod; on a warning a background tree starts to grow next
+ * to the tree, and on a drift the background tree (or a new tree, if there is
+ * none) replaces it.  Predictions are votes of the trees, weighted by their
+ * accuracy since they were created.
+ *
+ * The trees are HoeffdingTreeModel objects, so any of its tree types can be
+ * used, and the forest is trained on mini-batches: each call to Train() first
+ * classifies the batch with every tree, then trains the trees in parallel.
+ *
+ * @code
+ * HoeffdingForest forest(HoeffdingTreeModel::GINI_HOEFFDING, 10);
+ * forest.BuildModel(info, numClasses);
+ * while (ReadBatch(batch, labels)) // Some way of reading the stream.
+ *   forest.Train(batch, labels);
+ *
+ * arma::Row<size_t> predictions;
+ * forest.Classify(testData, predictions);
+ * @endcode
+ */
+class HoeffdingForest
+{
+ public:
+  /**
+   * Create the forest, but don't initialize any trees.  Be sure to call
+   * BuildModel() before doing anything with the forest!
+   *
+   * @param type Type of the trees.
+   * @param numTrees Number of trees in the forest.
+   * @param lambda Mean of the Poisson distribution of the weight of each point
+   *     for each tree.
+   * @param warningLevel Number of standard deviations of the error rate of a
+   *     tree for a warning (which starts a background tree).
+   * @param driftLevel Number of standard deviations of the error rate of a
+   *     tree for a drift (which replaces the tree).
+   */
+  HoeffdingForest(const HoeffdingTreeModel::TreeType type =
+                      HoeffdingTreeModel::GINI_HOEFFDING,
+                  const size_t numTrees = 10,
+                  const double lambda = 6.0,
+                  const double warningLevel = 2.0,
+                  const double driftLevel = 3.0);
+
+  /**
+   * Create the (empty) trees of the forest.  The parameters are those of
+   * HoeffdingTreeModel::BuildModel(), and are also used for every tree that is
+   * created later.
+   *
+   * @param datasetInfo Information about the dimensions of the data.
+   * @param numClasses Number of classes in the data.
+   * @param successProbability Probability of success required in Hoeffding
+   *      bound before a split can happen.
+   * @param maxSamples Maximum number of samples before a split is forced.
+   * @param checkInterval Number of samples required before each split check.
+   * @param minSamples If the node has seen this many points or fewer, no split
+   *      will be allowed.
+   * @param bins Number of bins, for Hoeffding numeric split.
+   * @param observationsBeforeBinning Number of observations before binning, for
+   *      Hoeffding numeric split.
+   */
+  void BuildModel(const data::DatasetInfo& datasetInfo,
+                  const size_t numClasses,
+                  const double successProbability = 0.95,
+                  const size_t maxSamples = 0,
+                  const size_t checkInterval = 100,
+                  const size_t minSamples = 100,
+                  const size_t bins = 10,
+                  const size_t observationsBeforeBinning = 100);
+
+  /**
+   * Train the forest on a mini-batch of the stream.  Each tree is tested on the
+   * batch (for drift detection and its voting weight) and then trained on it,
+   * with Poisson weights; the trees are handled in parallel.
+   *
+   * @param dataset Points of the mini-batch.
+   * @param labels Labels of the points.
+   */
+  void Train(const arma::mat& dataset, const arma::Row<size_t>& labels);
+
+  /**
+   * Classify the given points by the weighted votes of the trees.
+   *
+   * @param dataset Points to classify.
+   * @param predictions Vector to store the predictions in.
+   */
+  void Classify(const arma::mat& dataset,
+                arma::Row<size_t>& predictions) const;
+
+  /**
+   * Classify the given points by the weighted votes of the trees, and return
+   * the fraction of the votes that each prediction received.
+   *
+   * @param dataset Points to classify.
+   * @param predictions Vector to store the predictions in.
+   * @param probabilities Vector to store the fractions of the votes in.
+   */
+  void Classify(const arma::mat& dataset,
+                arma::Row<size_t>& predictions,
+                arma::rowvec& probabilities) const;
+
+  //! Get the number of trees.
+  size_t NumTrees() const { return trees.size(); }
+  //! Get the given tree.
+  const HoeffdingTreeModel& Tree(const size_t i) const { return trees[i].tree; }
+  //! Get whether the given tree has a background tree.
+  bool HasBackground(const size_t i) const { return trees[i].hasBackground; }
+
+  //! Get the number of drifts detected (that is, trees replaced) so far.
+  size_t Drifts() const { return drifts; }
+
+  //! Get the mean of the Poisson weights.
+  double Lambda() const { return lambda; }
+  //! Modify the mean of the Poisson weights.
+  double& Lambda() { return lambda; }
+
+  //! Serialize the forest.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(type));
+    ar(CEREAL_NVP(numTrees));
+    ar(CEREAL_NVP(lambda));
+    ar(CEREAL_NVP(warningLevel));
+    ar(CEREAL_NVP(driftLevel));
+    ar(CEREAL_NVP(datasetInfo));
+    ar(CEREAL_NVP(numClasses));
+    ar(CEREAL_NVP(successProbability));
+    ar(CEREAL_NVP(maxSamples));
+    ar(CEREAL_NVP(checkInterval));
+    ar(CEREAL_NVP(minSamples));
+    ar(CEREAL_NVP(bins));
+    ar(CEREAL_NVP(observationsBeforeBinning));
+    ar(CEREAL_NVP(drifts));
+    ar(CEREAL_NVP(trees));
+  }
+
+ private:
+  //! A tree of the forest, with its background tree and drift detector.
+  struct Member
+  {
+    //! The tree.
+    HoeffdingTreeModel tree;
+    //! Whether a background tree is being grown.
+    bool hasBackground;
+    //! The background tree, if any.
+    HoeffdingTreeModel background;
+    //! The drift detector of the tree.
+    DriftDetectionMethod detector;
+    //! The number of points the tree was tested on.
+    size_t tested;
+    //! The number of points the tree classified correctly.
+    size_t correct;
+
+    //! Serialize the member.
+    template<typename Archive>
+    void serialize(Archive& ar, const uint32_t /* version */)
+    {
+      ar(CEREAL_NVP(tree));
+      ar(CEREAL_NVP(hasBackground));
+      ar(CEREAL_NVP(background));
+      ar(CEREAL_NVP(detector));
+      ar(CEREAL_NVP(tested));
+      ar(CEREAL_NVP(correct));
+    }
+  };
+
+  //! Create a new, empty tree with the parameters of the forest.
+  HoeffdingTreeModel NewTree() const;
+
+  /**
+   * Test and train one tree of the forest on a mini-batch.
+   *
+   * @param member Tree to train.
+   * @param dataset Points of the mini-batch.
+   * @param labels Labels of the points.
+   * @param seed Seed for the Poisson weights.
+   * @return Whether a drift was detected.
+   */
+  bool TrainMember(Member& member,
+                   const arma::mat& dataset,
+                   const arma::Row<size_t>& labels,
+                   const size_t seed) const;
+
+  //! The type of the trees.
+  HoeffdingTreeModel::TreeType type;
+  //! The number of trees.
+  size_t numTrees;
+  //! The mean of the Poisson weights.
+  double lambda;
+  //! The number of standard deviations for a warning.
+  double warningLevel;
+  //! The number of standard deviations for a drift.
+  double driftLevel;
+
+  //! Information about the dimensions of the data.
+  data::DatasetInfo datasetInfo;
+  //! The number of classes.
+  size_t numClasses;
+  //! The probability of success required for a split.
+  double successProbability;
+  //! The maximum number of samples before a split is forced.
+  size_t maxSamples;
+  //! The number of samples between split checks.
+  size_t checkInterval;
+  //! The minimum number of samples for a split.
+  size_t minSamples;
+  //! The number of bins of the Hoeffding numeric splits.
+  size_t bins;
+  //! The number of observations before binning.
+  size_t observationsBeforeBinning;
+
+  //! The number of drifts detected so far.
+  size_t drifts;
+  //! The trees.
+  std::vector<Member> trees;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
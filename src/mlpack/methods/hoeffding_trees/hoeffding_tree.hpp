@@ -185,6 +185,12 @@ class HoeffdingTree
    * Train on a set of points, either in streaming mode or in batch mode, with
    * the given labels.
    *
+   * In streaming mode, the points are first routed to the current leaves, and
+   * then each leaf updates its split statistics with all of its points at once,
+   * one dimension at a time.  The leaves are trained in parallel.  This gives
+   * the same tree as training on each point in turn, because the points a leaf
+   * sees (and their order) do not depend on the other leaves.
+   *
    * @param data Data points to train on.
    * @param labels Labels of data points.
    * @param batchTraining If true, perform training in batch.
@@ -301,7 +307,8 @@ class HoeffdingTree
 
   /**
    * Classify the given points, using this node and the entire (sub)tree beneath
-   * it.  The predicted labels for each point are returned.
+   * it.  The predicted labels for each point are returned.  The points are
+   * classified in parallel.
    *
    * @param data Points to classify.
    * @param predictions Predicted labels for each point.
@@ -335,6 +342,34 @@ class HoeffdingTree
   void serialize(Archive& ar, const uint32_t /* version */);
 
  private:
+  /**
+   * Route the given points down the tree, and collect the points that reach
+   * each leaf.  The order of the points is kept.
+   *
+   * @param data Data points to route.
+   * @param indices Indices of the points in data to route.
+   * @param leafBatches Leaves and the indices of the points that reach them.
+   */
+  template<typename MatType>
+  void RouteToLeaves(
+      const MatType& data,
+      const arma::uvec& indices,
+      std::vector<std::pair<HoeffdingTree*, arma::uvec>>& leafBatches);
+
+  /**
+   * Train this leaf in streaming mode on the given points, updating the split
+   * statistics for each run of points between split checks at once.  If the
+   * node splits, the remaining points are passed to the new children.
+   *
+   * @param data Data points to train on.
+   * @param labels Labels of data points.
+   * @param indices Indices of the points in data to train on.
+   */
+  template<typename MatType>
+  void TrainLeafBatch(const MatType& data,
+                      const arma::Row<size_t>& labels,
+                      const arma::uvec& indices);
+
   // We need to keep some information for before we have split.
 
   //! Information for splitting of numeric features (used before split).
@@ -442,9 +442,149 @@ void HoeffdingTree<
   }
   else
   {
-    // We aren't training in batch mode; loop through the points.
-    for (size_t i = 0; i < data.n_cols; ++i)
-      Train(data.col(i), labels[i]);
+    // We aren't training in batch mode.  Find the points that reach each leaf,
+    // and then train the leaves in parallel; each leaf only affects its own
+    // subtree, so this is the same as training on each point in turn.
+    if (data.n_cols == 0)
+      return;
+
+    std::vector<std::pair<HoeffdingTree*, arma::uvec>> leafBatches;
+    RouteToLeaves(data, arma::regspace<arma::uvec>(0, data.n_cols - 1),
+        leafBatches);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) leafBatches.size(); ++i)
+    {
+      leafBatches[i].first->TrainLeafBatch(data, labels,
+          leafBatches[i].second);
+    }
+  }
+}
+
+//! Find the points that reach each leaf.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::RouteToLeaves(
+    const MatType& data,
+    const arma::uvec& indices,
+    std::vector<std::pair<HoeffdingTree*, arma::uvec>>& leafBatches)
+{
+  if (indices.n_elem == 0)
+    return;
+
+  if (children.size() == 0)
+  {
+    leafBatches.push_back(std::make_pair(this, indices));
+    return;
+  }
+
+  // Assign each point to a child, keeping the order of the points.
+  std::vector<arma::uvec> childIndices(children.size(),
+      arma::uvec(indices.n_elem));
+  arma::Col<size_t> counts = arma::zeros<arma::Col<size_t>>(children.size());
+  for (size_t i = 0; i < indices.n_elem; ++i)
+  {
+    const size_t direction = CalculateDirection(data.col(indices[i]));
+    childIndices[direction][counts[direction]++] = indices[i];
+  }
+
+  for (size_t i = 0; i < children.size(); ++i)
+  {
+    if (counts[i] > 0)
+    {
+      children[i]->RouteToLeaves(data, childIndices[i].subvec(0,
+          counts[i] - 1), leafBatches);
+    }
+  }
+}
+
+//! Train a leaf on the points that reach it.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::TrainLeafBatch(const MatType& data,
+                  const arma::Row<size_t>& labels,
+                  const arma::uvec& indices)
+{
+  size_t start = 0;
+  while (start < indices.n_elem)
+  {
+    if (splitDimension != size_t(-1))
+    {
+      // We have split during this batch; the rest of the points go to the
+      // children.
+      std::vector<std::pair<HoeffdingTree*, arma::uvec>> leafBatches;
+      RouteToLeaves(data, indices.subvec(start, indices.n_elem - 1),
+          leafBatches);
+      for (size_t i = 0; i < leafBatches.size(); ++i)
+      {
+        leafBatches[i].first->TrainLeafBatch(data, labels,
+            leafBatches[i].second);
+      }
+      return;
+    }
+
+    // Take all the points up to the next split check.
+    const size_t end = std::min((size_t) indices.n_elem,
+        start + checkInterval - (numSamples % checkInterval));
+
+    // Update the statistics of each dimension with all of the points.
+    size_t numericIndex = 0;
+    size_t categoricalIndex = 0;
+    for (size_t d = 0; d < data.n_rows; ++d)
+    {
+      if (datasetInfo->Type(d) == data::Datatype::categorical)
+      {
+        CategoricalSplitType<FitnessFunction>& split =
+            categoricalSplits[categoricalIndex++];
+        for (size_t i = start; i < end; ++i)
+          split.Train(data(d, indices[i]), labels[indices[i]]);
+      }
+      else if (datasetInfo->Type(d) == data::Datatype::numeric)
+      {
+        NumericSplitType<FitnessFunction>& split =
+            numericSplits[numericIndex++];
+        for (size_t i = start; i < end; ++i)
+          split.Train(data(d, indices[i]), labels[indices[i]]);
+      }
+    }
+    numSamples += end - start;
+
+    // Grab majority class from splits.
+    if (categoricalSplits.size() > 0)
+    {
+      majorityClass = categoricalSplits[0].MajorityClass();
+      majorityProbability = categoricalSplits[0].MajorityProbability();
+    }
+    else
+    {
+      majorityClass = numericSplits[0].MajorityClass();
+      majorityProbability = numericSplits[0].MajorityProbability();
+    }
+
+    // Check for a split, if we should.
+    if (numSamples % checkInterval == 0)
+    {
+      const size_t numChildren = SplitCheck();
+      if (numChildren > 0)
+      {
+        children.clear();
+        CreateChildren();
+      }
+    }
+
+    start = end;
   }
 }
 
@@ -825,7 +965,8 @@ void HoeffdingTree<
 >::Classify(const MatType& data, arma::Row<size_t>& predictions) const
 {
   predictions.set_size(data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
     predictions[i] = Classify(data.col(i));
 }
 
@@ -846,7 +987,8 @@ void HoeffdingTree<
 {
   predictions.set_size(data.n_cols);
   probabilities.set_size(data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
     Classify(data.col(i), predictions[i], probabilities[i]);
 }
 
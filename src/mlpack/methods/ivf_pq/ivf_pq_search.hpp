@@ -0,0 +1,212 @@
+/**
+ * @file methods/ivf_pq/ivf_pq_search.hpp
+ *
+ * Defines the IVFPQSearch class, which performs approximate nearest neighbor
+ * search with an inverted file index of product-quantized vectors.
+ *
+ * The details of this method can be found in the following paper:
+ *
+ * @code
+ * @article{jegou2011product,
+ *   title={Product quantization for nearest neighbor search},
+ *   author={J{\'e}gou, Herv{\'e} and Douze, Matthijs and Schmid, Cordelia},
+ *   journal={IEEE Transactions on Pattern Analysis and Machine Intelligence},
+ *   volume={33},
+ *   number={1},
+ *   pages={117--128},
+ *   year={2011}
+ * }
+ * @endcode
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_IVF_PQ_IVF_PQ_SEARCH_HPP
+#define MLPACK_METHODS_IVF_PQ_IVF_PQ_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/kmeans/kmeans.hpp>
+#include <cereal/types/vector.hpp>
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The IVFPQSearch class builds a compressed index on the reference set and
+ * uses it to compute approximate Euclidean nearest neighbors of query points.
+ *
+ * A coarse quantizer (found with k-means) splits the reference points into
+ * inverted lists.  The residual of each point with respect to the centroid of
+ * its list is split into subspaces, and each subspace is quantized with its
+ * own codebook of at most 256 codewords (also found with k-means), so that a
+ * point is stored as one byte per subspace.
+ *
+ * A search visits the lists of the numProbes centroids nearest to the query.
+ * For each visited list, a table of the squared distances between each
+ * subspace of the query residual and each codeword is computed with one
+ * matrix-vector product per subspace; the approximate distance to a stored
+ * point is then the sum of one table entry per subspace (asymmetric distance
+ * computation).  If the reference set is kept, the best candidates can be
+ * re-ranked with exact distances.
+ *
+ * @tparam MatType Type of matrix to use to store the data.
+ */
+template<typename MatType = arma::mat>
+class IVFPQSearch
+{
+ public:
+  /**
+   * Build the index on the given reference set.
+   *
+   * @param referenceSet Set of reference points.
+   * @param numLists Number of inverted lists (coarse centroids).
+   * @param numSubspaces Number of subspaces the residuals are split into;
+   *     each point takes one byte per subspace.
+   * @param codebookSize Number of codewords of each subspace (at most 256).
+   * @param keepReferenceSet If true, a copy of the reference set is kept so
+   *     that candidates can be re-ranked with exact distances.
+   * @param maxIterations Maximum number of k-means iterations for the coarse
+   *     quantizer and each codebook.
+   */
+  IVFPQSearch(const MatType& referenceSet,
+              const size_t numLists,
+              const size_t numSubspaces,
+              const size_t codebookSize = 256,
+              const bool keepReferenceSet = false,
+              const size_t maxIterations = 25);
+
+  /**
+   * Create an untrained index with the given parameters.  Be sure to call
+   * Train() before calling Search(); otherwise, an exception will be thrown
+   * when Search() is called.
+   *
+   * @param numLists Number of inverted lists (coarse centroids).
+   * @param numSubspaces Number of subspaces the residuals are split into.
+   * @param codebookSize Number of codewords of each subspace (at most 256).
+   * @param keepReferenceSet If true, a copy of the reference set is kept so
+   *     that candidates can be re-ranked with exact distances.
+   * @param maxIterations Maximum number of k-means iterations.
+   */
+  IVFPQSearch(const size_t numLists = 1,
+              const size_t numSubspaces = 1,
+              const size_t codebookSize = 256,
+              const bool keepReferenceSet = false,
+              const size_t maxIterations = 25);
+
+  /**
+   * Build the index on the given reference set, replacing any previous index.
+   *
+   * @param referenceSet Set of reference points.
+   */
+  void Train(const MatType& referenceSet);
+
+  /**
+   * Compute the approximate nearest neighbors of the points in the given query
+   * set and store the output in the given matrices.  The matrices will be set
+   * to the size of n columns by k rows, where n is the number of points in the
+   * query dataset and k is the number of neighbors being searched for.  If
+   * fewer than k points are stored in the visited lists, the remaining
+   * neighbors are set to SIZE_MAX and their distances to DBL_MAX.  The queries
+   * are answered in parallel.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing (approximate, unless the neighbors were
+   *     re-ranked) Euclidean distances of neighbors for each query point.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances) const;
+
+  /**
+   * Serialize the index.
+   *
+   * @param ar Archive to serialize to.
+   * @param version serialize class version to provide backward compatibility
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t version);
+
+  //! Get the number of inverted lists.
+  size_t NumLists() const { return numLists; }
+  //! Get the number of subspaces.
+  size_t NumSubspaces() const { return numSubspaces; }
+  //! Get the number of codewords of each subspace.
+  size_t CodebookSize() const { return codebookSize; }
+
+  //! Get the number of lists visited by each search.
+  size_t NumProbes() const { return numProbes; }
+  //! Modify the number of lists visited by each search.
+  size_t& NumProbes() { return numProbes; }
+
+  //! Get the number of candidates re-ranked with exact distances (0 means no
+  //! re-ranking).
+  size_t ReRank() const { return reRank; }
+  //! Modify the number of candidates re-ranked with exact distances.  This
+  //! requires the reference set to be kept.
+  size_t& ReRank() { return reRank; }
+
+  //! Get the coarse centroids.
+  const arma::mat& Centroids() const { return centroids; }
+  //! Get the codebook of the given subspace.
+  const arma::mat& Codebook(const size_t subspace) const
+  { return codebooks[subspace]; }
+  //! Get the codes of the points of the given list (one column per point).
+  const arma::Mat<unsigned char>& ListCodes(const size_t list) const
+  { return listCodes[list]; }
+  //! Get the indices of the points of the given list.
+  const arma::Col<size_t>& ListIndices(const size_t list) const
+  { return listIndices[list]; }
+  //! Get the kept reference set (empty if it was not kept).
+  const MatType& ReferenceSet() const { return referenceSet; }
+
+ private:
+  //! Get the first dimension of the given subspace.
+  size_t SubspaceBegin(const size_t subspace) const
+  { return subspace * dimensionality / numSubspaces; }
+
+  //! Check the parameters of the index against a reference set.
+  void CheckParameters(const MatType& referenceSet) const;
+
+  //! Number of inverted lists.
+  size_t numLists;
+  //! Number of subspaces.
+  size_t numSubspaces;
+  //! Number of codewords of each subspace.
+  size_t codebookSize;
+  //! Whether to keep the reference set for re-ranking.
+  bool keepReferenceSet;
+  //! Maximum number of k-means iterations.
+  size_t maxIterations;
+  //! Number of lists visited by each search.
+  size_t numProbes;
+  //! Number of candidates re-ranked with exact distances.
+  size_t reRank;
+
+  //! Dimensionality of the data.
+  size_t dimensionality;
+  //! Coarse centroids, one per column.
+  arma::mat centroids;
+  //! Codebook of each subspace, one codeword per column.
+  std::vector<arma::mat> codebooks;
+  //! Squared norm of each codeword of each subspace.
+  std::vector<arma::vec> codebookNorms;
+  //! Codes of the points of each list.
+  std::vector<arma::Mat<unsigned char>> listCodes;
+  //! Indices of the points of each list.
+  std::vector<arma::Col<size_t>> listIndices;
+  //! Reference set, if kept.
+  MatType referenceSet;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "ivf_pq_search_impl.hpp"
+
+#endif
@@ -0,0 +1,319 @@
+/**
+ * @file methods/ivf_pq/ivf_pq_search_impl.hpp
+ *
+ * Implementation of the IVFPQSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_IVF_PQ_IVF_PQ_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_IVF_PQ_IVF_PQ_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "ivf_pq_search.hpp"
+
+#include <queue>
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename MatType>
+IVFPQSearch<MatType>::IVFPQSearch(const MatType& referenceSet,
+                                  const size_t numLists,
+                                  const size_t numSubspaces,
+                                  const size_t codebookSize,
+                                  const bool keepReferenceSet,
+                                  const size_t maxIterations) :
+    numLists(numLists),
+    numSubspaces(numSubspaces),
+    codebookSize(codebookSize),
+    keepReferenceSet(keepReferenceSet),
+    maxIterations(maxIterations),
+    numProbes(8),
+    reRank(0),
+    dimensionality(0)
+{
+  Train(referenceSet);
+}
+
+template<typename MatType>
+IVFPQSearch<MatType>::IVFPQSearch(const size_t numLists,
+                                  const size_t numSubspaces,
+                                  const size_t codebookSize,
+                                  const bool keepReferenceSet,
+                                  const size_t maxIterations) :
+    numLists(numLists),
+    numSubspaces(numSubspaces),
+    codebookSize(codebookSize),
+    keepReferenceSet(keepReferenceSet),
+    maxIterations(maxIterations),
+    numProbes(8),
+    reRank(0),
+    dimensionality(0)
+{
+  // Nothing to do.
+}
+
+template<typename MatType>
+void IVFPQSearch<MatType>::CheckParameters(const MatType& data) const
+{
+  if (numLists == 0 || numLists > data.n_cols)
+  {
+    std::stringstream ss;
+    ss << "IVFPQSearch::Train(): the number of lists (" << numLists << ") must "
+        << "be between 1 and the number of reference points (" << data.n_cols
+        << ")!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  if (numSubspaces == 0 || numSubspaces > data.n_rows)
+  {
+    std::stringstream ss;
+    ss << "IVFPQSearch::Train(): the number of subspaces (" << numSubspaces
+        << ") must be between 1 and the dimensionality of the data ("
+        << data.n_rows << ")!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  if (codebookSize == 0 || codebookSize > 256 || codebookSize > data.n_cols)
+  {
+    std::stringstream ss;
+    ss << "IVFPQSearch::Train(): the codebook size (" << codebookSize << ") "
+        << "must be between 1 and 256, and no more than the number of "
+        << "reference points (" << data.n_cols << ")!";
+    throw std::invalid_argument(ss.str());
+  }
+}
+
+template<typename MatType>
+void IVFPQSearch<MatType>::Train(const MatType& data)
+{
+  CheckParameters(data);
+  dimensionality = data.n_rows;
+
+  // Find the coarse quantizer and the residual of each point.
+  kmeans::KMeans<> kmeans(maxIterations);
+  arma::Row<size_t> assignments;
+  kmeans.Cluster(data, numLists, assignments, centroids);
+
+  arma::mat residuals(data.n_rows, data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    residuals.col(i) = data.col(i) - centroids.col(assignments[i]);
+
+  // Find the codebook of each subspace.  The k-means initialization uses the
+  // shared random number generator, so the subspaces are handled one at a
+  // time.
+  codebooks.resize(numSubspaces);
+  codebookNorms.resize(numSubspaces);
+  for (size_t s = 0; s < numSubspaces; ++s)
+  {
+    const size_t begin = SubspaceBegin(s);
+    const size_t end = SubspaceBegin(s + 1);
+    const arma::mat subspace = residuals.rows(begin, end - 1);
+
+    kmeans.Cluster(subspace, codebookSize, codebooks[s]);
+    codebookNorms[s] = arma::trans(arma::sum(arma::square(codebooks[s])));
+  }
+
+  // Encode each residual with the nearest codeword of each subspace.
+  arma::Mat<unsigned char> codes(numSubspaces, data.n_cols);
+  #pragma omp parallel for
+  for (omp_size_t s = 0; s < (omp_size_t) numSubspaces; ++s)
+  {
+    const size_t begin = SubspaceBegin(s);
+    const size_t end = SubspaceBegin(s + 1);
+
+    // ||r - c||^2 = ||r||^2 - 2 r^T c + ||c||^2, and ||r||^2 doesn't change
+    // which codeword is nearest.
+    const arma::mat products = arma::trans(codebooks[s]) *
+        residuals.rows(begin, end - 1);
+    arma::vec scores;
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      scores = codebookNorms[s] - 2.0 * products.col(i);
+      arma::uword nearest;
+      scores.min(nearest);
+      codes(s, i) = (unsigned char) nearest;
+    }
+  }
+
+  // Sort the codes into the inverted lists.
+  arma::Col<size_t> listSizes(numLists, arma::fill::zeros);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    ++listSizes[assignments[i]];
+
+  listCodes.resize(numLists);
+  listIndices.resize(numLists);
+  for (size_t l = 0; l < numLists; ++l)
+  {
+    listCodes[l].set_size(numSubspaces, listSizes[l]);
+    listIndices[l].set_size(listSizes[l]);
+  }
+
+  listSizes.zeros();
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    const size_t l = assignments[i];
+    listCodes[l].col(listSizes[l]) = codes.col(i);
+    listIndices[l][listSizes[l]] = i;
+    ++listSizes[l];
+  }
+
+  if (keepReferenceSet)
+    referenceSet = data;
+  else
+    referenceSet.reset();
+}
+
+template<typename MatType>
+void IVFPQSearch<MatType>::Search(const MatType& querySet,
+                                  const size_t k,
+                                  arma::Mat<size_t>& neighbors,
+                                  arma::mat& distances) const
+{
+  if (centroids.n_cols == 0)
+  {
+    throw std::invalid_argument("IVFPQSearch::Search(): the index must be "
+        "trained before searching!");
+  }
+
+  if (querySet.n_rows != dimensionality)
+  {
+    std::stringstream ss;
+    ss << "IVFPQSearch::Search(): dimensionality of query set ("
+        << querySet.n_rows << ") is not equal to the dimensionality the index "
+        << "was trained on (" << dimensionality << ")!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  if (reRank > 0 && referenceSet.n_cols == 0)
+  {
+    throw std::invalid_argument("IVFPQSearch::Search(): re-ranking requires "
+        "the reference set to be kept!");
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+  if (k == 0)
+    return;
+
+  const size_t probes = std::min(std::max(numProbes, (size_t) 1), numLists);
+  const size_t candidates = std::max(reRank, k);
+  const arma::rowvec centroidNorms = arma::sum(arma::square(centroids));
+
+  typedef std::pair<double, size_t> Candidate;
+
+  #pragma omp parallel
+  {
+    arma::mat table(codebookSize, numSubspaces);
+    arma::uvec lists;
+    std::vector<Candidate> results;
+
+    #pragma omp for schedule(dynamic, 16)
+    for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+    {
+      const arma::vec query(querySet.col(i));
+
+      // Find the lists to visit.
+      const arma::rowvec centroidDistances = centroidNorms -
+          2.0 * arma::trans(query) * centroids;
+      lists = arma::sort_index(centroidDistances);
+
+      // The farthest of the best candidates is at the top.
+      std::priority_queue<Candidate> best;
+      for (size_t p = 0; p < probes; ++p)
+      {
+        const size_t l = lists[p];
+        const arma::vec residual = query - centroids.col(l);
+
+        // Squared distances between each subspace of the residual and each
+        // codeword.
+        for (size_t s = 0; s < numSubspaces; ++s)
+        {
+          const size_t begin = SubspaceBegin(s);
+          const size_t end = SubspaceBegin(s + 1);
+          const arma::vec part = residual.subvec(begin, end - 1);
+          table.col(s) = codebookNorms[s] + arma::dot(part, part) -
+              2.0 * arma::trans(codebooks[s]) * part;
+        }
+
+        const arma::Mat<unsigned char>& codes = listCodes[l];
+        for (size_t j = 0; j < codes.n_cols; ++j)
+        {
+          double distance = 0.0;
+          for (size_t s = 0; s < numSubspaces; ++s)
+            distance += table(codes(s, j), s);
+
+          if (best.size() < candidates)
+            best.push(Candidate(distance, listIndices[l][j]));
+          else if (distance < best.top().first)
+          {
+            best.pop();
+            best.push(Candidate(distance, listIndices[l][j]));
+          }
+        }
+      }
+
+      results.resize(best.size());
+      for (size_t j = results.size(); j > 0; --j)
+      {
+        results[j - 1] = best.top();
+        best.pop();
+      }
+
+      // Re-rank the candidates with the exact distances.
+      if (reRank > 0)
+      {
+        for (size_t j = 0; j < results.size(); ++j)
+        {
+          const arma::vec diff = query - referenceSet.col(results[j].second);
+          results[j].first = arma::dot(diff, diff);
+        }
+        std::sort(results.begin(), results.end());
+      }
+
+      for (size_t j = 0; j < k; ++j)
+      {
+        if (j < results.size())
+        {
+          neighbors(j, i) = results[j].second;
+          // Rounding can make an approximate squared distance negative.
+          distances(j, i) = std::sqrt(std::max(results[j].first, 0.0));
+        }
+        else
+        {
+          neighbors(j, i) = SIZE_MAX;
+          distances(j, i) = DBL_MAX;
+        }
+      }
+    }
+  }
+}
+
+template<typename MatType>
+template<typename Archive>
+void IVFPQSearch<MatType>::serialize(Archive& ar,
+                                     const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(numLists));
+  ar(CEREAL_NVP(numSubspaces));
+  ar(CEREAL_NVP(codebookSize));
+  ar(CEREAL_NVP(keepReferenceSet));
+  ar(CEREAL_NVP(maxIterations));
+  ar(CEREAL_NVP(numProbes));
+  ar(CEREAL_NVP(reRank));
+  ar(CEREAL_NVP(dimensionality));
+  ar(CEREAL_NVP(centroids));
+  ar(CEREAL_NVP(codebooks));
+  ar(CEREAL_NVP(codebookNorms));
+  ar(CEREAL_NVP(listCodes));
+  ar(CEREAL_NVP(listIndices));
+  ar(CEREAL_NVP(referenceSet));
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * @file methods/kde/binned_kde.hpp
+ *
+ * Grid-binned approximation of Gaussian kernel sums, used by the binned mode
+ * of KDE for low-dimensional data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KDE_BINNED_KDE_HPP
+#define MLPACK_METHODS_KDE_BINNED_KDE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace kde {
+
+/**
+ * BinnedKDE approximates, for each query point q, the Gaussian kernel sum
+ *
+ * \f[ \sum_j \exp(-\| q - r_j \|^2 / (2 h^2)) \f]
+ *
+ * over all reference points r_j, with the binned KDE technique.  The reference
+ * points are linearly binned onto a regular grid that covers the reference and
+ * query points; since the Gaussian kernel is separable, the binned weights are
+ * then convolved with the (truncated) kernel one dimension at a time, and the
+ * sum at each query point is obtained by multilinear interpolation of the
+ * convolved grid.  An evaluation costs O(2^d (N + M)) for N reference and M
+ * query points, plus O(d G L) for a grid of G points and a kernel truncated at
+ * L grid points, independently of how the points are distributed.
+ *
+ * The error is controlled by the grid spacing relative to the bandwidth (it
+ * decreases quadratically as the grid is refined) and by the cutoff of the
+ * kernel.  Since the grid has (grid size)^d points, this is intended for
+ * low-dimensional data (up to about five dimensions).  For more information,
+ * see the following paper:
+ *
+ * @code
+ * @article{wand1994fast,
+ *   title={Fast computation of multivariate kernel estimators},
+ *   author={Wand, Matt P.},
+ *   journal={Journal of Computational and Graphical Statistics},
+ *   volume={3},
+ *   number={4},
+ *   pages={433--445},
+ *   year={1994}
+ * }
+ * @endcode
+ */
+class BinnedKDE
+{
+ public:
+  /**
+   * Create the BinnedKDE object.
+   *
+   * @param bandwidth Bandwidth of the Gaussian kernel.
+   * @param gridSize Maximum number of grid points in each dimension.  If 0,
+   *     the size is chosen from the dimensionality so that the grid has about
+   *     four million points.
+   * @param cutoff Number of bandwidths after which the kernel is truncated.
+   */
+  BinnedKDE(const double bandwidth,
+            const size_t gridSize = 0,
+            const double cutoff = 5.0);
+
+  /**
+   * Compute the approximate Gaussian kernel sums of the query points.
+   *
+   * @param referenceSet Set of reference points.
+   * @param querySet Set of query points.
+   * @param sums Vector to store the kernel sum of each query point in.
+   */
+  template<typename MatType>
+  void Evaluate(const MatType& referenceSet,
+                const MatType& querySet,
+                arma::vec& sums) const;
+
+  //! Get the bandwidth of the kernel.
+  double Bandwidth() const { return bandwidth; }
+  //! Get the maximum number of grid points in each dimension.
+  size_t GridSize() const { return gridSize; }
+  //! Get the number of bandwidths after which the kernel is truncated.
+  double Cutoff() const { return cutoff; }
+
+  //! The largest number of grid points an evaluation may use.
+  static const size_t MaxGridPoints = 268435456;
+  //! The largest dimensionality binned estimation is available for.
+  static const size_t MaxDimensionality = 16;
+
+ private:
+  //! Convolve each line of the grid along the given dimension with the
+  //! truncated kernel.
+  void Convolve(arma::vec& grid,
+                const arma::Col<size_t>& dims,
+                const arma::Col<size_t>& strides,
+                const size_t dim,
+                const double spacing) const;
+
+  //! Bandwidth of the kernel.
+  double bandwidth;
+  //! Maximum number of grid points in each dimension.
+  size_t gridSize;
+  //! Number of bandwidths after which the kernel is truncated.
+  double cutoff;
+};
+
+} // namespace kde
+} // namespace mlpack
+
+// Include implementation.
+#include "binned_kde_impl.hpp"
+
+#endif
@@ -0,0 +1,264 @@
+/**
+ * @file methods/kde/binned_kde_impl.hpp
+ *
+ * Implementation of the grid-binned approximation of Gaussian kernel sums.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KDE_BINNED_KDE_IMPL_HPP
+#define MLPACK_METHODS_KDE_BINNED_KDE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "binned_kde.hpp"
+
+namespace mlpack {
+namespace kde {
+
+inline BinnedKDE::BinnedKDE(const double bandwidth,
+                            const size_t gridSize,
+                            const double cutoff) :
+    bandwidth(bandwidth),
+    gridSize(gridSize),
+    cutoff(cutoff)
+{
+  if (bandwidth <= 0.0)
+    throw std::invalid_argument("BinnedKDE: bandwidth must be positive!");
+
+  if (gridSize == 1)
+  {
+    throw std::invalid_argument("BinnedKDE: grid size must be 0 (automatic) or "
+        "at least 2!");
+  }
+
+  if (cutoff <= 0.0)
+    throw std::invalid_argument("BinnedKDE: cutoff must be positive!");
+}
+
+template<typename MatType>
+void BinnedKDE::Evaluate(const MatType& referenceSet,
+                         const MatType& querySet,
+                         arma::vec& sums) const
+{
+  sums.zeros(querySet.n_cols);
+  if (querySet.n_cols == 0 || referenceSet.n_cols == 0)
+    return;
+
+  if (querySet.n_rows != referenceSet.n_rows)
+  {
+    throw std::invalid_argument("BinnedKDE::Evaluate(): querySet and "
+        "referenceSet dimensions don't match");
+  }
+
+  // Each point touches the 2^d corners of its grid cell.
+  const size_t dimensionality = referenceSet.n_rows;
+  if (dimensionality > MaxDimensionality)
+  {
+    throw std::invalid_argument("BinnedKDE::Evaluate(): binned estimation is "
+        "only available for low-dimensional data");
+  }
+
+  // The grid covers the bounding box of both sets, so that every query point
+  // lies inside it.
+  const arma::vec lo = arma::min(arma::vec(arma::min(referenceSet, 1)),
+      arma::vec(arma::min(querySet, 1)));
+  const arma::vec hi = arma::max(arma::vec(arma::max(referenceSet, 1)),
+      arma::vec(arma::max(querySet, 1)));
+
+  // Choose the number of grid points along each dimension.  There is no need
+  // for a grid much finer than the bandwidth.
+  size_t maxPoints = gridSize;
+  if (maxPoints == 0)
+  {
+    maxPoints = (size_t) std::pow(4194304.0, 1.0 / dimensionality);
+    maxPoints = std::min(std::max(maxPoints, (size_t) 2), (size_t) 4096);
+  }
+
+  arma::Col<size_t> dims(dimensionality);
+  arma::Col<size_t> strides(dimensionality);
+  arma::vec spacing(dimensionality);
+  double totalPoints = 1.0;
+  for (size_t k = 0; k < dimensionality; ++k)
+  {
+    const double range = hi[k] - lo[k];
+    if (range == 0.0)
+    {
+      dims[k] = 1;
+      spacing[k] = 1.0;
+    }
+    else
+    {
+      dims[k] = std::min(maxPoints,
+          (size_t) std::ceil(16.0 * range / bandwidth) + 1);
+      dims[k] = std::max(dims[k], (size_t) 2);
+      spacing[k] = range / (dims[k] - 1);
+    }
+
+    strides[k] = (k == 0) ? 1 : strides[k - 1] * dims[k - 1];
+    totalPoints *= dims[k];
+  }
+
+  if (totalPoints > MaxGridPoints)
+  {
+    throw std::invalid_argument("BinnedKDE::Evaluate(): the grid would be too "
+        "large; use a smaller grid size or a tree-based mode for "
+        "high-dimensional data");
+  }
+
+  const size_t corners = ((size_t) 1) << dimensionality;
+
+  // Linearly bin the reference points: each point spreads its unit weight
+  // over the corners of its grid cell.  This is a scatter, so it is serial.
+  arma::vec grid((size_t) totalPoints, arma::fill::zeros);
+  arma::vec frac(dimensionality);
+  for (size_t j = 0; j < referenceSet.n_cols; ++j)
+  {
+    size_t base = 0;
+    for (size_t k = 0; k < dimensionality; ++k)
+    {
+      if (dims[k] == 1)
+      {
+        frac[k] = 0.0;
+        continue;
+      }
+
+      const double t = (referenceSet(k, j) - lo[k]) / spacing[k];
+      const size_t cell = std::min((size_t) std::max(std::floor(t), 0.0),
+          (size_t) dims[k] - 2);
+      frac[k] = std::min(std::max(t - cell, 0.0), 1.0);
+      base += cell * strides[k];
+    }
+
+    for (size_t c = 0; c < corners; ++c)
+    {
+      double weight = 1.0;
+      size_t index = base;
+      for (size_t k = 0; k < dimensionality; ++k)
+      {
+        if ((c >> k) & 1)
+        {
+          weight *= frac[k];
+          index += strides[k];
+        }
+        else
+        {
+          weight *= 1.0 - frac[k];
+        }
+      }
+
+      if (weight > 0.0)
+        grid[index] += weight;
+    }
+  }
+
+  // The Gaussian kernel is separable, so the convolution is done one
+  // dimension at a time.
+  for (size_t k = 0; k < dimensionality; ++k)
+    if (dims[k] > 1)
+      Convolve(grid, dims, strides, k, spacing[k]);
+
+  // Interpolate the convolved grid at each query point.
+  #pragma omp parallel
+  {
+    arma::vec queryFrac(dimensionality);
+
+    #pragma omp for
+    for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+    {
+      size_t base = 0;
+      for (size_t k = 0; k < dimensionality; ++k)
+      {
+        if (dims[k] == 1)
+        {
+          queryFrac[k] = 0.0;
+          continue;
+        }
+
+        const double t = (querySet(k, i) - lo[k]) / spacing[k];
+        const size_t cell = std::min((size_t) std::max(std::floor(t), 0.0),
+            (size_t) dims[k] - 2);
+        queryFrac[k] = std::min(std::max(t - cell, 0.0), 1.0);
+        base += cell * strides[k];
+      }
+
+      double sum = 0.0;
+      for (size_t c = 0; c < corners; ++c)
+      {
+        double weight = 1.0;
+        size_t index = base;
+        for (size_t k = 0; k < dimensionality; ++k)
+        {
+          if ((c >> k) & 1)
+          {
+            weight *= queryFrac[k];
+            index += strides[k];
+          }
+          else
+          {
+            weight *= 1.0 - queryFrac[k];
+          }
+        }
+
+        if (weight > 0.0)
+          sum += weight * grid[index];
+      }
+
+      sums[i] = sum;
+    }
+  }
+}
+
+inline void BinnedKDE::Convolve(arma::vec& grid,
+                                const arma::Col<size_t>& dims,
+                                const arma::Col<size_t>& strides,
+                                const size_t dim,
+                                const double spacing) const
+{
+  const size_t length = dims[dim];
+  const size_t stride = strides[dim];
+
+  // Kernel values at each grid offset, up to the cutoff.
+  const size_t width = std::min(length - 1,
+      (size_t) std::ceil(cutoff * bandwidth / spacing));
+  arma::vec weights(width + 1);
+  for (size_t l = 0; l <= width; ++l)
+  {
+    const double offset = l * spacing / bandwidth;
+    weights[l] = std::exp(-0.5 * offset * offset);
+  }
+
+  // Each line along the dimension is convolved independently.
+  const size_t lines = grid.n_elem / length;
+  #pragma omp parallel
+  {
+    arma::vec line(length);
+
+    #pragma omp for
+    for (omp_size_t p = 0; p < (omp_size_t) lines; ++p)
+    {
+      const size_t start = (p / stride) * stride * length + (p % stride);
+      for (size_t m = 0; m < length; ++m)
+        line[m] = grid[start + m * stride];
+
+      for (size_t m = 0; m < length; ++m)
+      {
+        double sum = weights[0] * line[m];
+        const size_t lower = std::min(m, width);
+        const size_t upper = std::min(length - 1 - m, width);
+        for (size_t l = 1; l <= lower; ++l)
+          sum += weights[l] * line[m - l];
+        for (size_t l = 1; l <= upper; ++l)
+          sum += weights[l] * line[m + l];
+
+        grid[start + m * stride] = sum;
+      }
+    }
+  }
+}
+
+} // namespace kde
+} // namespace mlpack
+
+#endif
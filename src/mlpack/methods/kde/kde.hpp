@@ -15,8 +15,11 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
+#include <mlpack/core/tree/prepared_query.hpp>
+#include <mlpack/core/kernels/gaussian_kernel.hpp>
 
 #include "kde_stat.hpp"
+#include "binned_kde.hpp"
 
 namespace mlpack {
 namespace kde /** Kernel Density Estimation. */ {
@@ -25,7 +28,8 @@ namespace kde /** Kernel Density Estimation. */ {
 enum KDEMode
 {
   DUAL_TREE_MODE,
-  SINGLE_TREE_MODE
+  SINGLE_TREE_MODE,
+  BINNED_MODE
 };
 
 //! KDEDefaultParams contains the default input parameter values for KDE.
@@ -55,6 +59,10 @@ struct KDEDefaultParams
 
   //! Monte Carlo break coefficient.
   static constexpr double mcBreakCoef = 0.4;
+
+  //! Maximum number of grid points in each dimension for binned estimation (0
+  //! means it is chosen automatically).
+  static constexpr size_t binnedGridSize = 0;
 };
 
 /**
@@ -63,6 +71,8 @@ struct KDEDefaultParams
  * probability density function of a variable in a non parametric way.
  * This implementation performs this estimation using a tree-independent
  * dual-tree algorithm. Details about this algorithm are available in KDERules.
+ * For low-dimensional data and the Gaussian kernel, the BINNED_MODE instead
+ * approximates the estimations on a regular grid (see BinnedKDE).
  *
  * @tparam KernelType Kernel function to use for KDE calculations.
  * @tparam MetricType Metric to use for KDE calculations.
@@ -186,13 +196,26 @@ class KDE
    * - Dimension of each point in the query set must match the dimension of each
    *   point in the reference set.
    *
-   * - Use std::move if the query set is no longer needed.
+   * - In dual-tree mode the query tree needs its own copy of the query set;
+   *   use std::move if the query set is no longer needed to avoid the copy.
+   *   In single-tree mode the query set is never copied.
+   *
+   * @pre The model has to be previously trained.
+   * @param querySet Set of query points to get the density of.
+   * @param estimations Object which will hold the density of each query point.
+   */
+  void Evaluate(const MatType& querySet, arma::vec& estimations);
+
+  /**
+   * Estimate density of each point in the query set given the data of the
+   * reference set, taking ownership of the query set.  In dual-tree mode the
+   * query tree is built on the given matrix without copying it.
    *
    * @pre The model has to be previously trained.
    * @param querySet Set of query points to get the density of.
    * @param estimations Object which will hold the density of each query point.
    */
-  void Evaluate(MatType querySet, arma::vec& estimations);
+  void Evaluate(MatType&& querySet, arma::vec& estimations);
 
   /**
    * Estimate density of each point in the query set given the data of an
@@ -213,6 +236,17 @@ class KDE
                 const std::vector<size_t>& oldFromNewQueries,
                 arma::vec& estimations);
 
+  /**
+   * Estimate density of each point of the given prepared query, reusing its
+   * query tree instead of building a new one.  The estimations are in the
+   * original order of the query points.
+   *
+   * @pre The model has to be previously trained and mode has to be dual-tree.
+   * @param query Query tree built on the points to get the density of.
+   * @param estimations Object which will hold the density of each query point.
+   */
+  void Evaluate(tree::PreparedQuery<Tree>& query, arma::vec& estimations);
+
   /**
    * Estimate density of each point in the reference set given the data of the
    * reference set. It does not compute the estimation of a point with itself.
@@ -295,6 +329,38 @@ class KDE
   //! Modify Monte Carlo break coefficient. (0 < newCoef <= 1).
   void MCBreakCoef(const double newCoef);
 
+  /**
+   * Get the depth of the query tree at which dual-tree evaluation is split into
+   * independent parallel tasks.  If this is 0 (the default), or if mlpack was
+   * compiled without OpenMP, dual-tree evaluation is performed on a single
+   * thread.
+   */
+  size_t ParallelDepth() const { return parallelDepth; }
+
+  /**
+   * Modify the depth of the query tree at which dual-tree evaluation is split
+   * into independent parallel tasks.  Each query node at this depth (or each
+   * leaf above it) is traversed against the reference tree as a separate task,
+   * with the error tolerance of each query node accounted for in its own
+   * statistic.  Monte Carlo estimation with the Gaussian kernel is always
+   * performed on a single thread.
+   */
+  size_t& ParallelDepth() { return parallelDepth; }
+
+  /**
+   * Get the maximum number of grid points in each dimension used by the binned
+   * mode.  If this is 0 (the default), the grid size is chosen from the
+   * dimensionality of the data.
+   */
+  size_t BinnedGridSize() const { return binnedGridSize; }
+
+  /**
+   * Modify the maximum number of grid points in each dimension used by the
+   * binned mode.  Finer grids give smaller errors, at the cost of
+   * (grid size)^d memory.
+   */
+  size_t& BinnedGridSize() { return binnedGridSize; }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t version);
@@ -346,6 +412,50 @@ class KDE
   //! is the limit before Monte Carlo estimation recurses.
   double mcBreakCoef;
 
+  //! The depth of the query tree at which dual-tree evaluation is split into
+  //! parallel tasks (0 means no parallelism).
+  size_t parallelDepth;
+
+  //! Maximum number of grid points in each dimension for the binned mode.
+  size_t binnedGridSize;
+
+  /**
+   * Perform the dual-tree traversal of the given query tree against the
+   * reference tree with the given rules object.  If parallelDepth is nonzero
+   * and OpenMP is available, the query tree is split into independent subtrees
+   * that are traversed in parallel with separate rules objects.  Every subtree
+   * only writes the estimations of its own descendants.
+   *
+   * @param queryTree Tree built on query points.
+   * @param rules Rules object to use for the traversal.
+   */
+  template<typename RuleType>
+  void DualTreeTraverse(Tree& queryTree, RuleType& rules);
+
+  /**
+   * Estimate the unnormalized density of each query point with the binned
+   * approximation.  This is only available for the Gaussian kernel and the
+   * Euclidean distance; for anything else, std::invalid_argument is thrown.
+   *
+   * @param querySet Set of query points to get the density of.
+   * @param estimations Object which will hold the density of each query point.
+   */
+  void BinnedEvaluate(const MatType& querySet, arma::vec& estimations) const;
+
+  //! Get the bandwidth for binned estimation with the Gaussian kernel.
+  static double BinnedBandwidth(const kernel::GaussianKernel& kernel)
+  {
+    return kernel.Bandwidth();
+  }
+
+  //! Binned estimation is not available for other kernels.
+  template<typename OtherKernelType>
+  static double BinnedBandwidth(const OtherKernelType& /* kernel */)
+  {
+    throw std::invalid_argument("cannot evaluate KDE model: binned mode is "
+                                "only available for the Gaussian kernel");
+  }
+
   //! Check whether absolute and relative error values are compatible.
   static void CheckErrorValues(const double relError, const double absError);
 
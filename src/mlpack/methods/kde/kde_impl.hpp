@@ -12,6 +12,7 @@
 
 #include "kde.hpp"
 #include "kde_rules.hpp"
+#include <mlpack/core/tree/traversal_tasks.hpp>
 
 namespace mlpack {
 namespace kde {
@@ -72,7 +73,9 @@ KDE(const double relError,
     trained(false),
     mode(mode),
     monteCarlo(monteCarlo),
-    initialSampleSize(initialSampleSize)
+    initialSampleSize(initialSampleSize),
+    parallelDepth(0),
+    binnedGridSize(KDEDefaultParams::binnedGridSize)
 {
   CheckErrorValues(relError, absError);
   MCProb(mcProb);
@@ -106,7 +109,9 @@ KDE(const KDE& other) :
     mcProb(other.mcProb),
     initialSampleSize(other.initialSampleSize),
     mcEntryCoef(other.mcEntryCoef),
-    mcBreakCoef(other.mcBreakCoef)
+    mcBreakCoef(other.mcBreakCoef),
+    parallelDepth(other.parallelDepth),
+    binnedGridSize(other.binnedGridSize)
 {
   if (trained)
   {
@@ -152,7 +157,9 @@ KDE(KDE&& other) :
     mcProb(other.mcProb),
     initialSampleSize(other.initialSampleSize),
     mcEntryCoef(other.mcEntryCoef),
-    mcBreakCoef(other.mcBreakCoef)
+    mcBreakCoef(other.mcBreakCoef),
+    parallelDepth(other.parallelDepth),
+    binnedGridSize(other.binnedGridSize)
 {
   other.kernel = std::move(KernelType());
   other.metric = std::move(MetricType());
@@ -168,6 +175,8 @@ KDE(KDE&& other) :
   other.initialSampleSize = KDEDefaultParams::initialSampleSize;
   other.mcEntryCoef = KDEDefaultParams::mcEntryCoef;
   other.mcBreakCoef = KDEDefaultParams::mcBreakCoef;
+  other.parallelDepth = 0;
+  other.binnedGridSize = KDEDefaultParams::binnedGridSize;
 }
 
 template<typename KernelType,
@@ -212,6 +221,8 @@ operator=(const KDE& other)
     initialSampleSize = other.initialSampleSize;
     mcEntryCoef = other.mcEntryCoef;
     mcBreakCoef = other.mcBreakCoef;
+    parallelDepth = other.parallelDepth;
+    binnedGridSize = other.binnedGridSize;
     if (trained)
     {
       if (ownsReferenceTree)
@@ -278,6 +289,8 @@ operator=(KDE&& other)
     this->initialSampleSize = other.initialSampleSize;
     this->mcEntryCoef = other.mcEntryCoef;
     this->mcBreakCoef = other.mcBreakCoef;
+    this->parallelDepth = other.parallelDepth;
+    this->binnedGridSize = other.binnedGridSize;
   }
   return *this;
 }
@@ -392,13 +405,15 @@ void KDE<KernelType,
          TreeType,
          DualTreeTraversalType,
          SingleTreeTraversalType>::
-Evaluate(MatType querySet, arma::vec& estimations)
+Evaluate(const MatType& querySet, arma::vec& estimations)
 {
   if (mode == DUAL_TREE_MODE)
   {
+    // The query tree has to own (and possibly rearrange) its points, so it is
+    // built on a copy of the query set.
     Timer::Start("building_query_tree");
     std::vector<size_t> oldFromNewQueries;
-    Tree* queryTree = BuildTree<Tree>(std::move(querySet), oldFromNewQueries);
+    Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
     Timer::Stop("building_query_tree");
     try
     {
@@ -474,6 +489,77 @@ Evaluate(MatType querySet, arma::vec& estimations)
     Log::Info << rules.BaseCases() << " base cases were calculated."
               << std::endl;
   }
+  else if (mode == BINNED_MODE)
+  {
+    estimations.clear();
+
+    // Check whether has already been trained.
+    if (!trained)
+    {
+      throw std::runtime_error("cannot evaluate KDE model: model needs to be "
+                               "trained before evaluation");
+    }
+
+    // Check querySet has at least 1 element to evaluate.
+    if (querySet.n_cols == 0)
+    {
+      Log::Warn << "KDE::Evaluate(): querySet is empty, no predictions will "
+                << "be returned" << std::endl;
+      return;
+    }
+
+    // Check whether dimensions match.
+    if (querySet.n_rows != referenceTree->Dataset().n_rows)
+    {
+      throw std::invalid_argument("cannot evaluate KDE model: querySet and "
+                                  "referenceSet dimensions don't match");
+    }
+
+    Timer::Start("computing_kde");
+    BinnedEvaluate(querySet, estimations);
+    estimations /= referenceTree->Dataset().n_cols;
+    Timer::Stop("computing_kde");
+  }
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+Evaluate(MatType&& querySet, arma::vec& estimations)
+{
+  if (mode != DUAL_TREE_MODE)
+  {
+    // Single-tree evaluation doesn't need to own the query set.
+    Evaluate(static_cast<const MatType&>(querySet), estimations);
+    return;
+  }
+
+  Timer::Start("building_query_tree");
+  std::vector<size_t> oldFromNewQueries;
+  Tree* queryTree = BuildTree<Tree>(std::move(querySet), oldFromNewQueries);
+  Timer::Stop("building_query_tree");
+  try
+  {
+    this->Evaluate(queryTree, oldFromNewQueries, estimations);
+  }
+  catch (std::exception& e)
+  {
+    // Make sure we delete the query tree.
+    delete queryTree;
+    throw;
+  }
+  delete queryTree;
 }
 
 template<typename KernelType,
@@ -557,9 +643,7 @@ Evaluate(Tree* queryTree,
                             monteCarlo,
                             false);
 
-  // Create traverser.
-  DualTreeTraversalType<RuleType> traverser(rules);
-  traverser.Traverse(*queryTree, *referenceTree);
+  DualTreeTraverse(*queryTree, rules);
   estimations /= referenceTree->Dataset().n_cols;
   Timer::Stop("computing_kde");
 
@@ -570,6 +654,30 @@ Evaluate(Tree* queryTree,
   Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
 }
 
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+Evaluate(tree::PreparedQuery<Tree>& query, arma::vec& estimations)
+{
+  // Forget the error accumulated in the query tree by the last evaluation.
+  KDECleanRules<Tree> cleanRules;
+  SingleTreeTraversalType<KDECleanRules<Tree>> cleanTraverser(cleanRules);
+  cleanTraverser.Traverse(0, query.QueryTree());
+
+  Evaluate(&query.QueryTree(), query.OldFromNew(), estimations);
+}
+
 template<typename KernelType,
          typename MetricType,
          typename MatType,
@@ -598,6 +706,20 @@ Evaluate(arma::vec& estimations)
   estimations.set_size(referenceTree->Dataset().n_cols);
   estimations.fill(arma::fill::zeros);
 
+  if (mode == BINNED_MODE)
+  {
+    Timer::Start("computing_kde");
+    BinnedEvaluate(referenceTree->Dataset(), estimations);
+
+    // Leave out the contribution of each point to its own estimation, which is
+    // K(0) = 1 for the Gaussian kernel up to the binning error.
+    estimations = arma::clamp(estimations - 1.0, 0.0, DBL_MAX);
+    estimations /= referenceTree->Dataset().n_cols;
+    RearrangeEstimations(*oldFromNewReferences, estimations);
+    Timer::Stop("computing_kde");
+    return;
+  }
+
   // Clean accumulated alpha if Monte Carlo estimations are available.
   if (monteCarlo && std::is_same<KernelType, kernel::GaussianKernel>::value)
   {
@@ -628,9 +750,7 @@ Evaluate(arma::vec& estimations)
 
   if (mode == DUAL_TREE_MODE)
   {
-    // Create traverser.
-    DualTreeTraversalType<RuleType> traverser(rules);
-    traverser.Traverse(*referenceTree, *referenceTree);
+    DualTreeTraverse(*referenceTree, rules);
   }
   else if (mode == SINGLE_TREE_MODE)
   {
@@ -808,6 +928,94 @@ serialize(Archive& ar, const uint32_t /* version */)
   ar(CEREAL_POINTER(oldFromNewReferences));
 }
 
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+template<typename RuleType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+DualTreeTraverse(Tree& queryTree, RuleType& rules)
+{
+  #ifdef HAS_OPENMP
+  // Monte Carlo estimation draws from the shared random number generator and
+  // caches alpha values in the statistics of the reference tree, so it is
+  // never split between threads.
+  const size_t numThreads = omp_get_max_threads();
+  const bool useMonteCarlo = monteCarlo &&
+      std::is_same<KernelType, kernel::GaussianKernel>::value;
+  if (parallelDepth > 0 && numThreads > 1 && !useMonteCarlo)
+  {
+    std::vector<Tree*> tasks;
+    tree::CollectTaskNodes(queryTree, parallelDepth, tasks);
+
+    if (tasks.size() > 1)
+    {
+      // Each thread other than the first gets its own copy of the rules, so
+      // that the traversal information and the single-tree error accumulators
+      // are never shared.  The error tolerance of each query node lives in its
+      // own statistic, which only the thread traversing that node modifies;
+      // likewise each task only adds to the estimations of its own points.
+      std::vector<RuleType> threadRules(numThreads - 1, rules);
+
+      #pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+      for (omp_size_t i = 0; i < (omp_size_t) tasks.size(); ++i)
+      {
+        const size_t thread = omp_get_thread_num();
+        RuleType& threadRule = (thread == 0) ? rules : threadRules[thread - 1];
+
+        // The last visited nodes belong to another subtree.
+        threadRule.TraversalInfo() = typename RuleType::TraversalInfoType();
+
+        DualTreeTraversalType<RuleType> traverser(threadRule);
+        traverser.Traverse(*tasks[i], *referenceTree);
+      }
+
+      tree::MergeTraversalCounts(rules, threadRules);
+
+      return;
+    }
+  }
+  #endif
+
+  DualTreeTraversalType<RuleType> traverser(rules);
+  traverser.Traverse(queryTree, *referenceTree);
+}
+
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+BinnedEvaluate(const MatType& querySet, arma::vec& estimations) const
+{
+  if (!std::is_same<MetricType, metric::EuclideanDistance>::value)
+  {
+    throw std::invalid_argument("cannot evaluate KDE model: binned mode is "
+                                "only available for the Euclidean distance");
+  }
+
+  BinnedKDE binned(BinnedBandwidth(kernel), binnedGridSize);
+  binned.Evaluate(referenceTree->Dataset(), querySet, estimations);
+}
+
 template<typename KernelType,
          typename MetricType,
          typename MatType,
@@ -56,6 +56,15 @@ BINDING_LONG_DESC(
     "use dual-tree algorithm or single-tree algorithm using the " +
     PRINT_PARAM_STRING("algorithm") + " option."
     "\n\n"
+    "For low-dimensional data (up to about five dimensions) and the Gaussian "
+    "kernel, the 'binned' algorithm can be much faster: the reference points "
+    "are binned onto a regular grid, which is convolved with the kernel, and "
+    "the estimation at each query point is interpolated from the grid.  The "
+    "error tolerances do not apply to it; instead, the error decreases as the "
+    "grid gets finer.  The maximum number of grid points in each dimension "
+    "can be set with " + PRINT_PARAM_STRING("grid_size") + "; if it is 0, it "
+    "is chosen from the dimensionality of the data."
+    "\n\n"
     "Monte Carlo estimations can be used to accelerate the KDE estimate when "
     "the Gaussian Kernel is used. This provides a probabilistic guarantee on "
     "the the error of the resulting KDE instead of an absolute guarantee."
@@ -152,8 +161,11 @@ PARAM_STRING_IN("tree", "Tree to use for the prediction."
     "('kd-tree', 'ball-tree', 'cover-tree', 'octree', 'r-tree').",
     "t", "kd-tree");
 PARAM_STRING_IN("algorithm", "Algorithm to use for the prediction."
-    "('dual-tree', 'single-tree').",
+    "('dual-tree', 'single-tree', 'binned').",
     "a", "dual-tree");
+PARAM_INT_IN("grid_size", "Maximum number of grid points in each dimension "
+    "for the binned algorithm (0 chooses it automatically).", "g",
+    KDEDefaultParams::binnedGridSize);
 PARAM_DOUBLE_IN("rel_error",
                 "Relative error tolerance for the prediction.",
                 "e",
@@ -206,6 +218,7 @@ static void mlpackMain()
   const int initialSampleSize = IO::GetParam<int>("initial_sample_size");
   const double mcEntryCoef = IO::GetParam<double>("mc_entry_coef");
   const double mcBreakCoef = IO::GetParam<double>("mc_break_coef");
+  const int gridSize = IO::GetParam<int>("grid_size");
 
   // Initialize results vector.
   arma::vec estimations;
@@ -226,13 +239,20 @@ static void mlpackMain()
                        "Monte Carlo only works with Gaussian kernel");
   }
 
+  if (IO::HasParam("reference") && modeStr == "binned" &&
+      kernelStr != "gaussian")
+  {
+    Log::Fatal << "The binned algorithm only works with the Gaussian kernel."
+        << std::endl;
+  }
+
   // Requirements for parameter values.
   RequireParamInSet<string>("kernel", { "gaussian", "epanechnikov",
       "laplacian", "spherical", "triangular" }, true, "unknown kernel type");
   RequireParamInSet<string>("tree", { "kd-tree", "ball-tree", "cover-tree",
       "octree", "r-tree"}, true, "unknown tree type");
-  RequireParamInSet<string>("algorithm", { "dual-tree", "single-tree"},
-      true, "unknown algorithm");
+  RequireParamInSet<string>("algorithm", { "dual-tree", "single-tree",
+      "binned" }, true, "unknown algorithm");
   RequireParamValue<double>("rel_error", [](double x){return x >= 0 && x <= 1;},
       true, "relative error must be between 0 and 1");
   RequireParamValue<double>("abs_error", [](double x){return x >= 0;},
@@ -249,6 +269,8 @@ static void mlpackMain()
       [](double x){return x > 0 && x <= 1;}, true,
       "Monte Carlo break coefficient must be greater than 0 and less than "
       "or equal to 1");
+  RequireParamValue<int>("grid_size", [](int x){return x == 0 || x >= 2;},
+      true, "grid size must be 0 or at least 2");
 
   KDEModel* kde;
 
@@ -290,6 +312,8 @@ static void mlpackMain()
       kde->Mode() = KDEMode::DUAL_TREE_MODE;
     else if (modeStr == "single-tree")
       kde->Mode() = KDEMode::SINGLE_TREE_MODE;
+    else if (modeStr == "binned")
+      kde->Mode() = KDEMode::BINNED_MODE;
   }
   else
   {
@@ -306,6 +330,7 @@ static void mlpackMain()
   kde->MCInitialSampleSize(initialSampleSize);
   kde->MCEntryCoefficient(mcEntryCoef);
   kde->MCBreakCoefficient(mcBreakCoef);
+  kde->BinnedGridSize() = (size_t) gridSize;
 
   // Evaluation.
   if (IO::HasParam("query"))
@@ -115,6 +115,11 @@ class KDEWrapperBase
   //! Modify the search mode.
   virtual KDEMode& Mode() = 0;
 
+  //! Get the grid size of the binned mode.
+  virtual size_t BinnedGridSize() const = 0;
+  //! Modify the grid size of the binned mode.
+  virtual size_t& BinnedGridSize() = 0;
+
   //! Train the model (build the tree).
   virtual void Train(arma::mat&& referenceSet) = 0;
 
@@ -193,6 +198,11 @@ class KDEWrapper : public KDEWrapperBase
   //! Modify the search mode.
   virtual KDEMode& Mode() { return kde.Mode(); }
 
+  //! Get the grid size of the binned mode.
+  virtual size_t BinnedGridSize() const { return kde.BinnedGridSize(); }
+  //! Modify the grid size of the binned mode.
+  virtual size_t& BinnedGridSize() { return kde.BinnedGridSize(); }
+
   //! Train the model (build the tree).
   virtual void Train(arma::mat&& referenceSet);
 
@@ -225,6 +235,10 @@ class KDEWrapper : public KDEWrapperBase
  * KernelType and TreeType parameters and allowing those to be specified at
  * runtime.  This class is written for the sake of the `kde` binding, but it is
  * not necessarily restricted to that usage.
+ *
+ * KDEModel holds double-precision data, like the bindings; to estimate
+ * densities on single-precision data, use KDE<KernelType, MetricType,
+ * arma::fmat> directly.
  */
 class KDEModel
 {
@@ -414,6 +428,14 @@ class KDEModel
   //! Modify the mode of the model.
   KDEMode& Mode() { return kdeModel->Mode(); }
 
+  //! Get the maximum number of grid points in each dimension for the binned
+  //! mode (0 means it is chosen automatically).
+  size_t BinnedGridSize() const { return kdeModel->BinnedGridSize(); }
+
+  //! Modify the maximum number of grid points in each dimension for the binned
+  //! mode.
+  size_t& BinnedGridSize() { return kdeModel->BinnedGridSize(); }
+
   /**
    * Initialize the KDE model.
    */
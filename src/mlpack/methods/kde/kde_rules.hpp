@@ -14,6 +14,10 @@
 #define MLPACK_METHODS_KDE_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/tree_traits.hpp>
+#include <mlpack/core/tree/hrectbound.hpp>
+#include <mlpack/core/kernels/gaussian_kernel.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
 
 namespace mlpack {
 namespace kde {
@@ -26,6 +30,9 @@ template<typename MetricType, typename KernelType, typename TreeType>
 class KDERules
 {
  public:
+  //! The type of the elements of the data.
+  typedef typename TreeType::ElemType ElemType;
+
   /**
    * Construct KDERules.
    *
@@ -46,8 +53,8 @@ class KDERules
    * @param sameSet True if query and reference sets are the same
    *                (monochromatic evaluation).
    */
-  KDERules(const arma::mat& referenceSet,
-           const arma::mat& querySet,
+  KDERules(const typename TreeType::Mat& referenceSet,
+           const typename TreeType::Mat& querySet,
            arma::vec& densities,
            const double relError,
            const double absError,
@@ -63,6 +70,24 @@ class KDERules
   //! Base Case.
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
+  /**
+   * Compute the base cases between all of the points held in a query leaf and
+   * a reference leaf at once.  Each query point is first scored against the
+   * reference node (as with Score(queryIndex, referenceNode)), which may
+   * estimate its contribution; then, for LMetric, the distances between the
+   * remaining query points and the reference points are computed as one block
+   * with LMetric::BatchEvaluate(), and turned into kernel values with
+   * kernel::TransformDistances(), which is vectorized for the Gaussian,
+   * Epanechnikov and triangular kernels.  Other metrics fall back to calling
+   * BaseCase() for every pair.  This is used by the dual-tree traverser of
+   * BinarySpaceTree when both nodes are leaves.
+   *
+   * @param queryNode Query leaf.
+   * @param referenceNode Reference leaf.
+   * @return The number of (query, reference) pairs that were evaluated.
+   */
+  size_t LeafBaseCases(TreeType& queryNode, TreeType& referenceNode);
+
   //! SingleTree Rescore.
   double Score(const size_t queryIndex, TreeType& referenceNode);
 
@@ -90,9 +115,15 @@ class KDERules
   //! Get the number of base cases.
   size_t BaseCases() const { return baseCases; }
 
+  //! Modify the number of base cases.
+  size_t& BaseCases() { return baseCases; }
+
   //! Get the number of scores.
   size_t Scores() const { return scores; }
 
+  //! Modify the number of scores.
+  size_t& Scores() { return scores; }
+
   //! Get the minimum number of base cases we need to perform to have acceptable
   //! results.
   size_t MinimumBaseCases() const { return 0; }
@@ -103,17 +134,35 @@ class KDERules
                         const size_t referenceIndex) const;
 
   //! Evaluate kernel value of 2 points.
-  double EvaluateKernel(const arma::vec& query,
-                        const arma::vec& reference) const;
+  double EvaluateKernel(const arma::Col<ElemType>& query,
+                        const arma::Col<ElemType>& reference) const;
 
   //! Calculate depth alpha for some node.
   double CalculateAlpha(TreeType* node);
 
+  //! Evaluate the base cases between the given query points and the points of
+  //! the reference node with one block of distances.
+  template<typename MT = MetricType>
+  void BatchBaseCases(
+      const std::vector<size_t>& queries,
+      TreeType& referenceNode,
+      const typename std::enable_if<
+          bound::meta::IsLMetric<MT>::Value>::type* = 0);
+
+  //! Evaluate the base cases between the given query points and the points of
+  //! the reference node one pair at a time.
+  template<typename MT = MetricType>
+  void BatchBaseCases(
+      const std::vector<size_t>& queries,
+      TreeType& referenceNode,
+      const typename std::enable_if<
+          !bound::meta::IsLMetric<MT>::Value>::type* = 0);
+
   //! The reference set.
-  const arma::mat& referenceSet;
+  const typename TreeType::Mat& referenceSet;
 
   //! The query set.
-  const arma::mat& querySet;
+  const typename TreeType::Mat& querySet;
 
   //! Density values.
   arma::vec& densities;
@@ -225,6 +274,23 @@ class KDECleanRules
 };
 
 } // namespace kde
+
+namespace tree {
+
+//! KDERules only touch the estimations of their query points and the
+//! statistics of their query nodes, except for Monte Carlo estimation, which
+//! draws from the shared random number generator and caches alpha values in
+//! the reference tree.  Monte Carlo estimation is only done with the Gaussian
+//! kernel.
+template<typename MetricType, typename KernelType, typename TreeType>
+class RuleTraits<kde::KDERules<MetricType, KernelType, TreeType>>
+{
+ public:
+  static const bool HasThreadSafeScoring =
+      !std::is_same<KernelType, kernel::GaussianKernel>::value;
+};
+
+} // namespace tree
 } // namespace mlpack
 
 // Include implementation.
@@ -24,8 +24,8 @@ namespace kde {
 
 template<typename MetricType, typename KernelType, typename TreeType>
 KDERules<MetricType, KernelType, TreeType>::KDERules(
-    const arma::mat& referenceSet,
-    const arma::mat& querySet,
+    const typename TreeType::Mat& referenceSet,
+    const typename TreeType::Mat& querySet,
     arma::vec& densities,
     const double relError,
     const double absError,
@@ -96,13 +96,112 @@ double KDERules<MetricType, KernelType, TreeType>::BaseCase(
   return distance;
 }
 
+template<typename MetricType, typename KernelType, typename TreeType>
+size_t KDERules<MetricType, KernelType, TreeType>::LeafBaseCases(
+    TreeType& queryNode,
+    TreeType& referenceNode)
+{
+  // Score each query point against the reference node first, as the traverser
+  // would; only the points that were not estimated need their base cases.
+  const TraversalInfoType leafTraversalInfo = traversalInfo;
+  std::vector<size_t> queries;
+  queries.reserve(queryNode.NumPoints());
+  for (size_t i = 0; i < queryNode.NumPoints(); ++i)
+  {
+    traversalInfo = leafTraversalInfo;
+    const size_t queryIndex = queryNode.Point(i);
+    if (Score(queryIndex, referenceNode) != DBL_MAX)
+      queries.push_back(queryIndex);
+  }
+
+  if (queries.empty())
+    return 0;
+
+  BatchBaseCases(queries, referenceNode);
+  return queries.size() * referenceNode.NumPoints();
+}
+
+template<typename MetricType, typename KernelType, typename TreeType>
+template<typename MT>
+void KDERules<MetricType, KernelType, TreeType>::BatchBaseCases(
+    const std::vector<size_t>& queries,
+    TreeType& referenceNode,
+    const typename std::enable_if<
+        bound::meta::IsLMetric<MT>::Value>::type*)
+{
+  const size_t numRefs = referenceNode.NumPoints();
+  arma::uvec refIndices(numRefs);
+  for (size_t j = 0; j < numRefs; ++j)
+    refIndices[j] = referenceNode.Point(j);
+
+  const arma::uvec queryIndices = arma::conv_to<arma::uvec>::from(queries);
+  // The blocks are always in double precision, like the kernel values.
+  const arma::mat queryBlock =
+      arma::conv_to<arma::mat>::from(querySet.cols(queryIndices));
+  const arma::mat refBlock =
+      arma::conv_to<arma::mat>::from(referenceSet.cols(refIndices));
+
+  // Compute all of the distances, then all of the kernel values.
+  arma::mat kernelValues;
+  MetricType::BatchEvaluate(queryBlock, refBlock, kernelValues);
+  kernel::TransformDistances(kernel, kernelValues);
+
+  size_t lastQuery = 0, lastRef = 0;
+  bool evaluated = false;
+  for (size_t i = 0; i < queries.size(); ++i)
+  {
+    double kernelSum = 0.0;
+    for (size_t j = 0; j < numRefs; ++j)
+    {
+      // Skip the same pairs as BaseCase().
+      if ((sameSet && (queries[i] == refIndices[j])) ||
+          ((lastQueryIndex == queries[i]) &&
+           (lastReferenceIndex == refIndices[j])))
+        continue;
+
+      kernelSum += kernelValues(i, j);
+      ++baseCases;
+      lastQuery = i;
+      lastRef = j;
+      evaluated = true;
+    }
+
+    densities(queries[i]) += kernelSum;
+
+    // Update accumulated relative error tolerance for single-tree pruning.
+    accumError(queries[i]) += 2 * relError * kernelSum;
+  }
+
+  // Leave the same information as the last call to BaseCase() would.
+  if (evaluated)
+  {
+    lastQueryIndex = queries[lastQuery];
+    lastReferenceIndex = refIndices[lastRef];
+    traversalInfo.LastBaseCase() = metric.Evaluate(queryBlock.col(lastQuery),
+        refBlock.col(lastRef));
+  }
+}
+
+template<typename MetricType, typename KernelType, typename TreeType>
+template<typename MT>
+void KDERules<MetricType, KernelType, TreeType>::BatchBaseCases(
+    const std::vector<size_t>& queries,
+    TreeType& referenceNode,
+    const typename std::enable_if<
+        !bound::meta::IsLMetric<MT>::Value>::type*)
+{
+  for (size_t i = 0; i < queries.size(); ++i)
+    for (size_t j = 0; j < referenceNode.NumPoints(); ++j)
+      BaseCase(queries[i], referenceNode.Point(j));
+}
+
 //! Single-tree scoring function.
 template<typename MetricType, typename KernelType, typename TreeType>
 inline double KDERules<MetricType, KernelType, TreeType>::
 Score(const size_t queryIndex, TreeType& referenceNode)
 {
   // Auxiliary variables.
-  const arma::vec& queryPoint = querySet.unsafe_col(queryIndex);
+  const arma::Col<ElemType>& queryPoint = querySet.unsafe_col(queryIndex);
   const size_t refNumDesc = referenceNode.NumDescendants();
   double score, minDistance, maxDistance, depthAlpha;
   // Calculations are not duplicated.
@@ -539,7 +638,8 @@ EvaluateKernel(const size_t queryIndex,
 
 template<typename MetricType, typename KernelType, typename TreeType>
 inline force_inline double KDERules<MetricType, KernelType, TreeType>::
-EvaluateKernel(const arma::vec& query, const arma::vec& reference) const
+EvaluateKernel(const arma::Col<ElemType>& query,
+               const arma::Col<ElemType>& reference) const
 {
   return kernel.Evaluate(metric.Evaluate(query, reference));
 }
@@ -0,0 +1,176 @@
+/**
+ * @file methods/kde/sliding_window_kde.hpp
+ *
+ * Kernel density estimation over a sliding window of reference points, which
+ * are inserted and expired without retraining the whole model.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KDE_SLIDING_WINDOW_KDE_HPP
+#define MLPACK_METHODS_KDE_SLIDING_WINDOW_KDE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/prepared_query.hpp>
+#include <deque>
+#include <memory>
+
+#include "kde.hpp"
+
+namespace mlpack {
+namespace kde {
+
+/**
+ * SlidingWindowKDE estimates densities with respect to a window of reference
+ * points that changes over time, such as the events of the last day in a
+ * streaming anomaly detector.  Each point is inserted with a timestamp, and
+ * Expire() removes the points older than a given time.
+ *
+ * The window is split into blocks of a fixed number of points.  Inserted
+ * points are kept in a buffer until a block is full; the block then gets its
+ * own reference tree and KDE model, which are never rebuilt.  When the oldest
+ * block starts to expire, its points go to a second buffer, from which they
+ * are removed one by one; a block whose points have all expired is dropped at
+ * once.  So insertions and expirations never rebuild a tree, and the trees are
+ * built for blockSize points at a time.
+ *
+ * The density of a query point is the average of the densities given by the
+ * blocks (weighted by their numbers of points) and of the kernel sums over the
+ * two buffers, which are computed exactly.  The error tolerances of the KDE
+ * models therefore apply to the whole estimate.  In dual-tree mode the query
+ * tree is built once per call to Evaluate() and reused for every block.
+ *
+ * @code
+ * SlidingWindowKDE<> window(4096, KDE<>(0.01, 0.0, GaussianKernel(0.5)));
+ * // For each batch of events:
+ * window.Insert(events, times);
+ * window.Expire(times.max() - 24 * 3600);
+ * arma::vec densities;
+ * window.Evaluate(events, densities);
+ * @endcode
+ *
+ * Timestamps must not decrease from one inserted point to the next.
+ *
+ * @tparam KDEType Type of the KDE models of the blocks.
+ */
+template<typename KDEType = KDE<>>
+class SlidingWindowKDE
+{
+ public:
+  //! The type of the reference trees.
+  typedef typename KDEType::Tree Tree;
+  //! The type of the points.
+  typedef typename Tree::Mat MatType;
+
+  /**
+   * Create an empty window.
+   *
+   * @param blockSize Number of points in each block with its own tree.
+   * @param prototype KDE model whose parameters (kernel, metric, error
+   *     tolerances, mode) are used for every block.
+   */
+  SlidingWindowKDE(const size_t blockSize = 4096,
+                   const KDEType& prototype = KDEType());
+
+  /**
+   * Insert the given points in the window.  Every full block of points gets
+   * its own tree.
+   *
+   * @param points Points to insert, one per column.
+   * @param timestamps Timestamps of the points, which must not decrease and
+   *     must not be older than the last inserted point.
+   */
+  void Insert(const MatType& points, const arma::vec& timestamps);
+
+  /**
+   * Remove the points of the window whose timestamp is older than the given
+   * time.
+   *
+   * @param time The oldest timestamp to keep.
+   */
+  void Expire(const double time);
+
+  /**
+   * Estimate the density of each query point with respect to the points of
+   * the window.
+   *
+   * @param querySet Set of query points to get the density of.
+   * @param estimations Object which will hold the density of each query point.
+   */
+  void Evaluate(const MatType& querySet, arma::vec& estimations);
+
+  //! Get the number of points in the window.
+  size_t NumPoints() const
+  {
+    return tail.n_cols + blockPoints + head.n_cols;
+  }
+
+  //! Get the number of blocks with a tree.
+  size_t NumBlocks() const { return blocks.size(); }
+
+  //! Get the number of points in each block.
+  size_t BlockSize() const { return blockSize; }
+
+  //! Get the KDE model whose parameters are used for every block.
+  const KDEType& Prototype() const { return prototype; }
+
+ private:
+  //! A block of points with its own tree and KDE model.
+  struct Block
+  {
+    //! The reference tree.
+    std::unique_ptr<Tree> tree;
+    //! The mapping from the points of the tree to the inserted points.
+    std::unique_ptr<std::vector<size_t>> oldFromNew;
+    //! The KDE model trained on the tree.
+    std::unique_ptr<KDEType> kde;
+    //! The timestamps of the points, in the order of the tree's dataset.
+    arma::vec timestamps;
+    //! The newest timestamp of the block.
+    double newest;
+  };
+
+  //! Build a block with the first blockSize points of the head buffer.
+  void SealBlock();
+
+  //! Remove the points of the tail buffer older than the given time.
+  void ExpireTail(const double time);
+
+  //! Add the kernel sums of the query points over the given points.
+  void AddKernelSums(const MatType& points,
+                     const MatType& querySet,
+                     arma::vec& sums);
+
+  //! The number of points in each block.
+  size_t blockSize;
+  //! The KDE model whose parameters are used for every block.
+  KDEType prototype;
+
+  //! The points of the oldest block, once some of them have expired.
+  MatType tail;
+  //! The timestamps of the points of the tail buffer.
+  arma::vec tailTimestamps;
+  //! The blocks, from the oldest to the newest.
+  std::deque<Block> blocks;
+  //! The total number of points in the blocks.
+  size_t blockPoints;
+  //! The newest points, which do not fill a block yet.
+  MatType head;
+  //! The timestamps of the points of the head buffer.
+  arma::vec headTimestamps;
+
+  //! The dimensionality of the points (0 until the first insertion).
+  size_t dimensionality;
+  //! The timestamp of the last inserted point.
+  double lastTimestamp;
+};
+
+} // namespace kde
+} // namespace mlpack
+
+// Include implementation.
+#include "sliding_window_kde_impl.hpp"
+
+#endif
@@ -0,0 +1,241 @@
+/**
+ * @file methods/kde/sliding_window_kde_impl.hpp
+ *
+ * Implementation of SlidingWindowKDE.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KDE_SLIDING_WINDOW_KDE_IMPL_HPP
+#define MLPACK_METHODS_KDE_SLIDING_WINDOW_KDE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "sliding_window_kde.hpp"
+
+namespace mlpack {
+namespace kde {
+
+template<typename KDEType>
+SlidingWindowKDE<KDEType>::SlidingWindowKDE(const size_t blockSize,
+                                            const KDEType& prototype) :
+    blockSize(blockSize),
+    prototype(prototype),
+    blockPoints(0),
+    dimensionality(0),
+    lastTimestamp(-DBL_MAX)
+{
+  if (blockSize == 0)
+  {
+    throw std::invalid_argument("SlidingWindowKDE::SlidingWindowKDE(): block "
+        "size must be positive!");
+  }
+}
+
+template<typename KDEType>
+void SlidingWindowKDE<KDEType>::Insert(const MatType& points,
+                                       const arma::vec& timestamps)
+{
+  if (points.n_cols != timestamps.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "SlidingWindowKDE::Insert(): number of points (" << points.n_cols
+        << ") does not match number of timestamps (" << timestamps.n_elem
+        << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (points.n_cols == 0)
+    return;
+
+  if (dimensionality != 0 && points.n_rows != dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "SlidingWindowKDE::Insert(): dimensionality of points ("
+        << points.n_rows << ") does not match dimensionality of the window ("
+        << dimensionality << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (timestamps[0] < lastTimestamp ||
+      arma::any(arma::diff(timestamps) < 0.0))
+  {
+    throw std::invalid_argument("SlidingWindowKDE::Insert(): timestamps must "
+        "not decrease!");
+  }
+
+  dimensionality = points.n_rows;
+  lastTimestamp = timestamps[timestamps.n_elem - 1];
+
+  head = arma::join_rows(head, points);
+  headTimestamps = arma::join_cols(headTimestamps, timestamps);
+
+  while (head.n_cols >= blockSize)
+    SealBlock();
+}
+
+template<typename KDEType>
+void SlidingWindowKDE<KDEType>::Expire(const double time)
+{
+  // The points are ordered by age from the tail buffer to the blocks to the
+  // head buffer, so the blocks only expire once the tail buffer is empty, and
+  // the head buffer once there are no blocks.
+  ExpireTail(time);
+
+  while (tail.n_cols == 0 && !blocks.empty() &&
+         blocks.front().timestamps.min() < time)
+  {
+    Block& block = blocks.front();
+    blockPoints -= block.timestamps.n_elem;
+    if (block.newest >= time)
+    {
+      // Only some of the points have expired; the others are moved to the
+      // tail buffer, where they can be removed one by one.
+      tail = std::move(block.tree->Dataset());
+      tailTimestamps = std::move(block.timestamps);
+      blocks.pop_front();
+      ExpireTail(time);
+    }
+    else
+    {
+      blocks.pop_front();
+    }
+  }
+
+  if (tail.n_cols == 0 && blocks.empty() && head.n_cols > 0)
+  {
+    // The head buffer is sorted by timestamp.
+    const arma::uvec expired = arma::find(headTimestamps < time);
+    if (expired.n_elem > 0)
+    {
+      head.shed_cols(0, expired.n_elem - 1);
+      headTimestamps.shed_rows(0, expired.n_elem - 1);
+    }
+  }
+}
+
+template<typename KDEType>
+void SlidingWindowKDE<KDEType>::Evaluate(const MatType& querySet,
+                                         arma::vec& estimations)
+{
+  if (NumPoints() == 0)
+  {
+    throw std::runtime_error("SlidingWindowKDE::Evaluate(): there are no "
+        "points in the window!");
+  }
+
+  if (querySet.n_rows != dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "SlidingWindowKDE::Evaluate(): dimensionality of query points ("
+        << querySet.n_rows << ") does not match dimensionality of the window ("
+        << dimensionality << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  estimations.zeros(querySet.n_cols);
+  if (querySet.n_cols == 0)
+    return;
+
+  // The KDE models of the blocks give average kernel values, which are
+  // weighted by the number of points of each block.
+  if (!blocks.empty())
+  {
+    arma::vec blockEstimations;
+    if (prototype.Mode() == DUAL_TREE_MODE)
+    {
+      tree::PreparedQuery<Tree> query(querySet);
+      for (size_t i = 0; i < blocks.size(); ++i)
+      {
+        blocks[i].kde->Evaluate(query, blockEstimations);
+        estimations += blocks[i].timestamps.n_elem * blockEstimations;
+      }
+    }
+    else
+    {
+      for (size_t i = 0; i < blocks.size(); ++i)
+      {
+        blocks[i].kde->Evaluate(querySet, blockEstimations);
+        estimations += blocks[i].timestamps.n_elem * blockEstimations;
+      }
+    }
+  }
+
+  AddKernelSums(tail, querySet, estimations);
+  AddKernelSums(head, querySet, estimations);
+
+  estimations /= NumPoints();
+}
+
+template<typename KDEType>
+void SlidingWindowKDE<KDEType>::SealBlock()
+{
+  Block block;
+  block.oldFromNew.reset(new std::vector<size_t>());
+  block.tree.reset(BuildTree<Tree>(MatType(head.cols(0, blockSize - 1)),
+      *block.oldFromNew));
+
+  // Put the timestamps in the order of the points of the tree.
+  const arma::vec timestamps = headTimestamps.subvec(0, blockSize - 1);
+  block.newest = timestamps[blockSize - 1];
+  if (block.oldFromNew->empty())
+  {
+    block.timestamps = timestamps;
+  }
+  else
+  {
+    block.timestamps.set_size(blockSize);
+    for (size_t i = 0; i < blockSize; ++i)
+      block.timestamps[i] = timestamps[(*block.oldFromNew)[i]];
+  }
+
+  block.kde.reset(new KDEType(prototype));
+  block.kde->Train(block.tree.get(), block.oldFromNew.get());
+
+  blocks.push_back(std::move(block));
+  blockPoints += blockSize;
+
+  head.shed_cols(0, blockSize - 1);
+  headTimestamps.shed_rows(0, blockSize - 1);
+}
+
+template<typename KDEType>
+void SlidingWindowKDE<KDEType>::ExpireTail(const double time)
+{
+  if (tail.n_cols == 0)
+    return;
+
+  const arma::uvec kept = arma::find(tailTimestamps >= time);
+  if (kept.n_elem == tail.n_cols)
+    return;
+
+  tail = tail.cols(kept);
+  tailTimestamps = tailTimestamps.elem(kept);
+}
+
+template<typename KDEType>
+void SlidingWindowKDE<KDEType>::AddKernelSums(const MatType& points,
+                                              const MatType& querySet,
+                                              arma::vec& sums)
+{
+  if (points.n_cols == 0)
+    return;
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+  {
+    double sum = 0.0;
+    for (size_t j = 0; j < points.n_cols; ++j)
+    {
+      sum += prototype.Kernel().Evaluate(prototype.Metric().Evaluate(
+          querySet.col(i), points.col(j)));
+    }
+    sums[i] += sum;
+  }
+}
+
+} // namespace kde
+} // namespace mlpack
+
+#endif
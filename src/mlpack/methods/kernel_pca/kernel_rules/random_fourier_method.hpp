@@ -0,0 +1,97 @@
+/**
+ * @file methods/kernel_pca/kernel_rules/random_fourier_method.hpp
+ *
+ * Use random Fourier features to approximate the kernel matrix of a
+ * shift-invariant kernel.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KERNEL_PCA_RANDOM_FOURIER_METHOD_HPP
+#define MLPACK_METHODS_KERNEL_PCA_RANDOM_FOURIER_METHOD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/random_fourier_features.hpp>
+
+namespace mlpack {
+namespace kpca {
+
+/**
+ * Approximate kernel PCA with random Fourier features ("Random Features for
+ * Large-Scale Kernel Machines", Rahimi and Recht, 2007).  Each point x is
+ * mapped to z(x) = sqrt(2 / D) cos(W x + b), where the D rows of W are drawn
+ * from the spectrum of the kernel and b is uniform in [0, 2 pi), so that
+ * z(x)^T z(y) approximates K(x, y).  PCA is then performed on the D x D
+ * covariance of the features, so neither time nor memory are quadratic in the
+ * number of points.  The returned eigenvectors are those of the feature
+ * covariance, not of the kernel matrix.
+ *
+ * Only shift-invariant kernels for which kernel::FourierSpectrum is
+ * specialized can be used; the features are computed by
+ * kernel::RandomFourierFeatures.
+ *
+ * @tparam KernelType Shift-invariant kernel to approximate.
+ * @tparam NumFeatures Number of random features D; if the requested rank is
+ *     larger, that many features are used instead.
+ */
+template<typename KernelType, size_t NumFeatures = 512>
+class RandomFourierKernelRule
+{
+ public:
+  /**
+   * Construct the random features and perform PCA on them.
+   *
+   * @param data Input data points.
+   * @param transformedData Matrix to output results into.
+   * @param eigval KPCA eigenvalues will be written to this vector.
+   * @param eigvec Eigenvectors of the feature covariance will be written to
+   *     this matrix.
+   * @param rank Rank to be used for matrix approximation.
+   * @param kernel Kernel to be used for computation.
+   */
+  static void ApplyKernelMatrix(const arma::mat& data,
+                                arma::mat& transformedData,
+                                arma::vec& eigval,
+                                arma::mat& eigvec,
+                                const size_t rank,
+                                KernelType kernel = KernelType())
+  {
+    const size_t numFeatures = std::max(NumFeatures, rank);
+
+    kernel::RandomFourierFeatures<KernelType> map(numFeatures, kernel);
+    map.Train(data);
+
+    // Map the points to the feature space.
+    arma::mat features;
+    map.Transform(data, features);
+
+    // In the feature space the data can be centered directly.
+    features.each_col() -= arma::mean(features, 1);
+
+    // The nonzero eigenvalues of the covariance of the features are those of
+    // the (centered) approximate kernel matrix.
+    arma::mat covariance = features * features.t();
+    if (!arma::eig_sym(eigval, eigvec, covariance))
+    {
+      Log::Fatal << "Failed to eigendecompose the feature covariance."
+          << std::endl;
+    }
+
+    // Swap the eigenvalues since they are ordered backwards (we need largest
+    // to smallest).
+    for (size_t i = 0; i < floor(eigval.n_elem / 2.0); ++i)
+      eigval.swap_rows(i, (eigval.n_elem - 1) - i);
+
+    // Flip the coefficients to produce the same effect.
+    eigvec = arma::fliplr(eigvec);
+
+    transformedData = eigvec.t() * features;
+  }
+};
+
+} // namespace kpca
+} // namespace mlpack
+
+#endif
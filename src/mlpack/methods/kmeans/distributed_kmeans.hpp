@@ -0,0 +1,146 @@
+/**
+ * @file methods/kmeans/distributed_kmeans.hpp
+ *
+ * K-Means clustering of a dataset sharded over several processes.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_DISTRIBUTED_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_DISTRIBUTED_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/distributed/local_communicator.hpp>
+#include <mlpack/core/distributed/mpi_communicator.hpp>
+#include <mlpack/core/distributed/ring_all_reduce.hpp>
+
+#include "kmeans.hpp"
+
+namespace mlpack {
+namespace kmeans /** K-Means clustering. */ {
+
+/**
+ * This class implements K-Means clustering of a dataset whose points are
+ * sharded over several processes.  Every process holds a shard of the points
+ * and runs the given Lloyd step on it; the sums and the counts of the points of
+ * each cluster are then summed over the processes with
+ * distributed::RingAllReduce(), so that every process computes the same new
+ * centroids.  The initial centroids are computed by the first process from its
+ * shard with the initial partition policy, and broadcast to the others.
+ *
+ * Every process must call Cluster() at the same time, with the same number of
+ * clusters.  For example, with MPI:
+ *
+ * @code
+ * extern arma::mat shard; // The points of this process.
+ * distributed::MPICommunicator communicator;
+ * DistributedKMeans<distributed::MPICommunicator> k(communicator);
+ * arma::mat centroids;
+ * k.Cluster(shard, 10, centroids); // Same centroids in every process.
+ * @endcode
+ *
+ * The Lloyd step object is rebuilt for every iteration, since the state that
+ * steps like ElkanKMeans or DualTreeKMeans keep between iterations only holds
+ * when they computed the previous centroids themselves.  An empty cluster keeps
+ * its centroid of the previous iteration.
+ *
+ * @tparam CommunicatorType Type of the communicator between the processes (see
+ *     distributed::LocalCommunicator).
+ * @tparam MetricType The distance metric to use.
+ * @tparam InitialPartitionPolicy Initial partitioning policy, run by the first
+ *     process on its shard.
+ * @tparam LloydStepType Implementation of single Lloyd step to use.
+ * @tparam MatType Type of the shards.
+ */
+template<typename CommunicatorType,
+         typename MetricType = metric::EuclideanDistance,
+         typename InitialPartitionPolicy = SampleInitialization,
+         template<class, class> class LloydStepType = NaiveKMeans,
+         typename MatType = arma::mat>
+class DistributedKMeans
+{
+ public:
+  /**
+   * Create the DistributedKMeans object.
+   *
+   * @param communicator Communicator between the processes; it must outlive
+   *     this object.
+   * @param maxIterations Maximum number of iterations allowed before giving up
+   *     (0 is valid, but the algorithm may never terminate).
+   * @param metric Optional MetricType object.
+   * @param partitioner Optional InitialPartitionPolicy object.
+   */
+  DistributedKMeans(CommunicatorType& communicator,
+                    const size_t maxIterations = 1000,
+                    const MetricType metric = MetricType(),
+                    const InitialPartitionPolicy partitioner =
+                        InitialPartitionPolicy());
+
+  /**
+   * Cluster the points of all the processes, and return the centroids of the
+   * clusters (the same in every process).  If initialGuess is true, the
+   * centroids given to the first process are used as the initial centroids.
+   *
+   * @param data Shard of this process.
+   * @param clusters Number of clusters to compute.
+   * @param centroids Matrix in which the centroids are stored.
+   * @param initialGuess If true, the centroids of the first process are the
+   *     initial centroids.
+   */
+  void Cluster(const MatType& data,
+               const size_t clusters,
+               arma::mat& centroids,
+               const bool initialGuess = false);
+
+  /**
+   * Cluster the points of all the processes, and return the centroids of the
+   * clusters and the assignments of the points of this process.
+   *
+   * @param data Shard of this process.
+   * @param clusters Number of clusters to compute.
+   * @param assignments Vector to store the assignments of the shard in.
+   * @param centroids Matrix in which the centroids are stored.
+   * @param initialGuess If true, the centroids of the first process are the
+   *     initial centroids.
+   */
+  void Cluster(const MatType& data,
+               const size_t clusters,
+               arma::Row<size_t>& assignments,
+               arma::mat& centroids,
+               const bool initialGuess = false);
+
+  //! Get the maximum number of iterations.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Set the maximum number of iterations.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the distance metric.
+  const MetricType& Metric() const { return metric; }
+  //! Modify the distance metric.
+  MetricType& Metric() { return metric; }
+
+  //! Get the initial partitioning policy.
+  const InitialPartitionPolicy& Partitioner() const { return partitioner; }
+  //! Modify the initial partitioning policy.
+  InitialPartitionPolicy& Partitioner() { return partitioner; }
+
+ private:
+  //! The communicator between the processes.
+  CommunicatorType& communicator;
+  //! Maximum number of iterations before giving up.
+  size_t maxIterations;
+  //! Instantiated distance metric.
+  MetricType metric;
+  //! Instantiated initial partitioning policy.
+  InitialPartitionPolicy partitioner;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "distributed_kmeans_impl.hpp"
+
+#endif
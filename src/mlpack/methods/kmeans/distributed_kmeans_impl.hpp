@@ -0,0 +1,224 @@
+/**
+ * @file methods/kmeans/distributed_kmeans_impl.hpp
+ *
+ * Implementation of K-Means clustering of a dataset sharded over several
+ * processes.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_DISTRIBUTED_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_DISTRIBUTED_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "distributed_kmeans.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename CommunicatorType,
+         typename MetricType,
+         typename InitialPartitionPolicy,
+         template<class, class> class LloydStepType,
+         typename MatType>
+DistributedKMeans<
+    CommunicatorType,
+    MetricType,
+    InitialPartitionPolicy,
+    LloydStepType,
+    MatType>::
+DistributedKMeans(CommunicatorType& communicator,
+                  const size_t maxIterations,
+                  const MetricType metric,
+                  const InitialPartitionPolicy partitioner) :
+    communicator(communicator),
+    maxIterations(maxIterations),
+    metric(metric),
+    partitioner(partitioner)
+{
+  // Nothing to do.
+}
+
+template<typename CommunicatorType,
+         typename MetricType,
+         typename InitialPartitionPolicy,
+         template<class, class> class LloydStepType,
+         typename MatType>
+void DistributedKMeans<
+    CommunicatorType,
+    MetricType,
+    InitialPartitionPolicy,
+    LloydStepType,
+    MatType>::
+Cluster(const MatType& data,
+        const size_t clusters,
+        arma::mat& centroids,
+        const bool initialGuess)
+{
+  const size_t dimensionality = data.n_rows;
+
+  // The first process computes the initial centroids from its shard.
+  if (communicator.Rank() == 0)
+  {
+    if (initialGuess)
+    {
+      if (centroids.n_cols != clusters || centroids.n_rows != dimensionality)
+      {
+        std::ostringstream oss;
+        oss << "DistributedKMeans::Cluster(): initial centroids have size "
+            << centroids.n_rows << "x" << centroids.n_cols << ", should be "
+            << dimensionality << "x" << clusters << "!";
+        throw std::invalid_argument(oss.str());
+      }
+    }
+    else
+    {
+      if (clusters > data.n_cols)
+      {
+        Log::Warn << "DistributedKMeans::Cluster(): more clusters requested "
+            << "than points in the shard of the first process." << std::endl;
+      }
+
+      arma::Row<size_t> assignments;
+      if (GetInitialAssignmentsOrCentroids(partitioner, data, clusters,
+          assignments, centroids))
+      {
+        arma::Row<size_t> counts;
+        counts.zeros(clusters);
+        centroids.zeros(dimensionality, clusters);
+        for (size_t i = 0; i < data.n_cols; ++i)
+        {
+          centroids.col(assignments[i]) += arma::vec(data.col(i));
+          counts[assignments[i]]++;
+        }
+
+        for (size_t i = 0; i < clusters; ++i)
+          if (counts[i] != 0)
+            centroids.col(i) /= counts[i];
+      }
+    }
+  }
+  else
+  {
+    centroids.set_size(dimensionality, clusters);
+  }
+  communicator.Broadcast(centroids.memptr(), centroids.n_elem * sizeof(double),
+      0);
+
+  // The sums of the points of each cluster, with the number of points in the
+  // last row, so that a single all-reduce combines everything.
+  arma::mat sums(dimensionality + 1, clusters);
+  arma::Col<size_t> counts(clusters);
+  arma::mat newCentroids;
+  size_t iteration = 0;
+  size_t distanceCalculations = 0;
+  double cNorm;
+
+  do
+  {
+    LloydStepType<MetricType, MatType> lloydStep(data, metric);
+    lloydStep.Iterate(centroids, newCentroids, counts);
+    distanceCalculations += lloydStep.DistanceCalculations();
+
+    for (size_t i = 0; i < clusters; ++i)
+    {
+      if (counts[i] == 0)
+        sums.col(i).zeros();
+      else
+        sums.submat(0, i, dimensionality - 1, i) = newCentroids.col(i) *
+            (double) counts[i];
+      sums(dimensionality, i) = (double) counts[i];
+    }
+    distributed::RingAllReduce(communicator, sums.memptr(), sums.n_elem);
+
+    cNorm = 0.0;
+    for (size_t i = 0; i < clusters; ++i)
+    {
+      if (sums(dimensionality, i) == 0.0)
+      {
+        Log::Info << "Cluster " << i << " is empty.\n";
+        newCentroids.col(i) = centroids.col(i);
+      }
+      else
+      {
+        newCentroids.col(i) = sums.submat(0, i, dimensionality - 1, i) /
+            sums(dimensionality, i);
+      }
+
+      cNorm += std::pow(metric.Evaluate(centroids.col(i),
+          newCentroids.col(i)), 2.0);
+    }
+    cNorm = std::sqrt(cNorm);
+    centroids.swap(newCentroids);
+
+    iteration++;
+    Log::Info << "DistributedKMeans::Cluster(): iteration " << iteration
+        << ", residual " << cNorm << ".\n";
+    if (std::isnan(cNorm) || std::isinf(cNorm))
+      cNorm = 1e-4; // Keep iterating.
+  } while (cNorm > 1e-5 && iteration != maxIterations);
+
+  if (iteration != maxIterations)
+  {
+    Log::Info << "DistributedKMeans::Cluster(): converged after " << iteration
+        << " iterations." << std::endl;
+  }
+  else
+  {
+    Log::Info << "DistributedKMeans::Cluster(): terminated after limit of "
+        << iteration << " iterations." << std::endl;
+  }
+  Log::Info << distanceCalculations << " distance calculations in this "
+      << "process." << std::endl;
+}
+
+template<typename CommunicatorType,
+         typename MetricType,
+         typename InitialPartitionPolicy,
+         template<class, class> class LloydStepType,
+         typename MatType>
+void DistributedKMeans<
+    CommunicatorType,
+    MetricType,
+    InitialPartitionPolicy,
+    LloydStepType,
+    MatType>::
+Cluster(const MatType& data,
+        const size_t clusters,
+        arma::Row<size_t>& assignments,
+        arma::mat& centroids,
+        const bool initialGuess)
+{
+  Cluster(data, clusters, centroids, initialGuess);
+
+  // Assign the points of the shard to the closest centroid.
+  assignments.set_size(data.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  {
+    double minDistance = std::numeric_limits<double>::infinity();
+    size_t closestCluster = centroids.n_cols; // Invalid value.
+
+    for (size_t j = 0; j < centroids.n_cols; ++j)
+    {
+      const double distance = metric.Evaluate(data.col(i), centroids.col(j));
+
+      if (distance < minDistance)
+      {
+        minDistance = distance;
+        closestCluster = j;
+      }
+    }
+
+    Log::Assert(closestCluster != centroids.n_cols);
+    assignments[i] = closestCluster;
+  }
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
@@ -2,7 +2,8 @@
  * @file methods/kmeans/elkan_kmeans_impl.hpp
  * @author Ryan Curtin
  *
- * An implementation of Elkan's algorithm for exact Lloyd iterations.
+ * An implementation of Elkan's algorithm for exact Lloyd iterations, using
+ * OpenMP for parallelization over multiple threads.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
@@ -46,9 +47,6 @@ double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
   // being the closest cluster centroid.
   clusterDistances.diag().fill(DBL_MAX);
 
-  // Initially set r(x) to true.
-  std::vector<bool> mustRecalculate(dataset.n_cols, true);
-
   // If this is the first iteration, we must reset all the bounds.
   if (lowerBounds.n_rows != centroids.n_cols)
   {
@@ -62,36 +60,49 @@ double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
   }
 
   // Step 1: for all centers, compute between-cluster distances.  For all
-  // centers, compute s(c) = 1/2 min d(c, c').
-  for (size_t i = 0; i < centroids.n_cols; ++i)
+  // centers, compute s(c) = 1/2 min d(c, c').  The rows get shorter, so they
+  // are handed out to the threads dynamically.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) centroids.n_cols; ++i)
   {
     for (size_t j = i + 1; j < centroids.n_cols; ++j)
     {
       const double distance = metric.Evaluate(centroids.col(i),
                                               centroids.col(j));
-      distanceCalculations++;
       clusterDistances(i, j) = distance;
       clusterDistances(j, i) = distance;
     }
   }
+  distanceCalculations += centroids.n_cols * (centroids.n_cols - 1) / 2;
 
   // Now find the closest cluster to each other cluster.  We multiply by 0.5 so
   // that this is equivalent to s(c) for each cluster c.
   minClusterDistances = 0.5 * arma::min(clusterDistances).t();
 
-  // Now loop over all points, and see which ones need to be updated.
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  // Now loop over all points, and see which ones need to be updated.  The
+  // points are split between the threads; the bounds of each point are only
+  // touched by its thread, and each thread sums its own centroids.
+  omp_size_t pointDistances = 0;
+  #pragma omp parallel reduction(+:pointDistances) MLPACK_OMP_PROC_BIND
   {
-    // Step 2: identify all points such that u(x) <= s(c(x)).
-    if (upperBounds(i) <= minClusterDistances(assignments[i]))
-    {
-      // No change needed.  This point must still belong to that cluster.
-      counts(assignments[i])++;
-      newCentroids.col(assignments[i]) += arma::vec(dataset.col(i));
-      continue;
-    }
-    else
+    arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
+        arma::fill::zeros);
+    arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+
+    #pragma omp for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
     {
+      // Step 2: identify all points such that u(x) <= s(c(x)).
+      if (upperBounds(i) <= minClusterDistances(assignments[i]))
+      {
+        // No change needed.  This point must still belong to that cluster.
+        localCounts(assignments[i])++;
+        localCentroids.col(assignments[i]) += arma::vec(dataset.col(i));
+        continue;
+      }
+
+      // Initially set r(x) to true.
+      bool mustRecalculate = true;
       for (size_t c = 0; c < centroids.n_cols; ++c)
       {
         // Step 3: for all remaining points x and centers c such that c != c(x),
@@ -108,13 +119,13 @@ double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
         // Step 3a: if r(x) then compute d(x, c(x)) and assign r(x) = false.
         // Otherwise, d(x, c(x)) = u(x).
         double dist;
-        if (mustRecalculate[i])
+        if (mustRecalculate)
         {
-          mustRecalculate[i] = false;
+          mustRecalculate = false;
           dist = metric.Evaluate(dataset.col(i), centroids.col(assignments[i]));
           lowerBounds(assignments[i], i) = dist;
           upperBounds(i) = dist;
-          distanceCalculations++;
+          pointDistances++;
 
           // Check if we can prune again.
           if (upperBounds(i) <= lowerBounds(c, i))
@@ -136,7 +147,7 @@ double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
           const double pointDist = metric.Evaluate(dataset.col(i),
                                                    centroids.col(c));
           lowerBounds(c, i) = pointDist;
-          distanceCalculations++;
+          pointDistances++;
           if (pointDist < dist)
           {
             upperBounds(i) = pointDist;
@@ -144,14 +155,22 @@ double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
           }
         }
       }
+
+      // At this point, we know the new cluster assignment.
+      // Step 4: for each center c, let m(c) be the mean of the points assigned
+      // to c.
+      localCentroids.col(assignments[i]) += arma::vec(dataset.col(i));
+      localCounts[assignments[i]]++;
     }
 
-    // At this point, we know the new cluster assignment.
-    // Step 4: for each center c, let m(c) be the mean of the points assigned to
-    // c.
-    newCentroids.col(assignments[i]) += arma::vec(dataset.col(i));
-    counts[assignments[i]]++;
+    // Combine the sums of each thread.
+    #pragma omp critical
+    {
+      newCentroids += localCentroids;
+      counts += localCounts;
+    }
   }
+  distanceCalculations += pointDistances;
 
   // Now, normalize and calculate the distance each cluster has moved.
   arma::vec moveDistances(centroids.n_cols);
@@ -166,13 +185,13 @@ double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
     distanceCalculations++;
   }
 
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
   {
     // Step 5: for each point x and center c, assign
     //   l(x, c) = max { l(x, c) - d(c, m(c)), 0 }.
     // But it doesn't actually matter if l(x, c) is positive.
-    for (size_t c = 0; c < centroids.n_cols; ++c)
-      lowerBounds(c, i) -= moveDistances(c);
+    lowerBounds.col(i) -= moveDistances;
 
     // Step 6: for each point x, assign
     //   u(x) = u(x) + d(m(c(x)), c(x))
@@ -2,7 +2,8 @@
  * @file methods/kmeans/hamerly_kmeans_impl.hpp
  * @author Ryan Curtin
  *
- * An implementation of Greg Hamerly's algorithm for k-means clustering.
+ * An implementation of Greg Hamerly's algorithm for k-means clustering, using
+ * OpenMP for parallelization over multiple threads.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
@@ -33,8 +34,6 @@ double HamerlyKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
                                                    arma::mat& newCentroids,
                                                    arma::Col<size_t>& counts)
 {
-  size_t hamerlyPruned = 0;
-
   // If this is the first iteration, we need to set all the bounds.
   if (minClusterDistances.n_elem != centroids.n_cols)
   {
@@ -49,82 +48,105 @@ double HamerlyKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
   newCentroids.zeros(centroids.n_rows, centroids.n_cols);
   counts.zeros(centroids.n_cols);
 
-  // Calculate minimum intra-cluster distance for each cluster.
-  minClusterDistances.fill(DBL_MAX);
-  for (size_t i = 0; i < centroids.n_cols; ++i)
+  // Calculate minimum intra-cluster distance for each cluster.  Each distance
+  // is computed once and stored in both entries of the (symmetric) distance
+  // matrix; the rows get shorter, so they are handed out dynamically.
+  arma::mat clusterDistances(centroids.n_cols, centroids.n_cols);
+  clusterDistances.diag().fill(DBL_MAX);
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) centroids.n_cols; ++i)
   {
     for (size_t j = i + 1; j < centroids.n_cols; ++j)
     {
       const double dist = metric.Evaluate(centroids.col(i), centroids.col(j)) /
           2.0;
-      ++distanceCalculations;
-
-      // Update bounds, if this intra-cluster distance is smaller.
-      if (dist < minClusterDistances(i))
-        minClusterDistances(i) = dist;
-      if (dist < minClusterDistances(j))
-        minClusterDistances(j) = dist;
+      clusterDistances(i, j) = dist;
+      clusterDistances(j, i) = dist;
     }
   }
-
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  minClusterDistances = arma::min(clusterDistances).t();
+  distanceCalculations += centroids.n_cols * (centroids.n_cols - 1) / 2;
+
+  // The points are split between the threads; the bounds of each point are
+  // only touched by its thread, and each thread sums its own centroids.
+  omp_size_t hamerlyPruned = 0;
+  omp_size_t pointDistances = 0;
+  #pragma omp parallel reduction(+:hamerlyPruned, pointDistances) \
+      MLPACK_OMP_PROC_BIND
   {
-    const double m = std::max(minClusterDistances(assignments[i]),
-                              lowerBounds(i));
+    arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
+        arma::fill::zeros);
+    arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
 
-    // First bound test.
-    if (upperBounds(i) <= m)
+    #pragma omp for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
     {
-      ++hamerlyPruned;
-      newCentroids.col(assignments[i]) += dataset.col(i);
-      ++counts(assignments[i]);
-      continue;
-    }
-
-    // Tighten upper bound.
-    upperBounds(i) = metric.Evaluate(dataset.col(i),
-                                     centroids.col(assignments[i]));
-    ++distanceCalculations;
-
-    // Second bound test.
-    if (upperBounds(i) <= m)
-    {
-      newCentroids.col(assignments[i]) += dataset.col(i);
-      ++counts(assignments[i]);
-      continue;
-    }
+      const double m = std::max(minClusterDistances(assignments[i]),
+                                lowerBounds(i));
 
-    // The bounds failed.  So test against all other clusters.
-    // This is Hamerly's Point-All-Ctrs() function from the paper.
-    // We have to reset the lower bound first.
-    lowerBounds(i) = DBL_MAX;
-    for (size_t c = 0; c < centroids.n_cols; ++c)
-    {
-      if (c == assignments[i])
+      // First bound test.
+      if (upperBounds(i) <= m)
+      {
+        ++hamerlyPruned;
+        localCentroids.col(assignments[i]) += dataset.col(i);
+        ++localCounts(assignments[i]);
         continue;
+      }
 
-      const double dist = metric.Evaluate(dataset.col(i), centroids.col(c));
+      // Tighten upper bound.
+      upperBounds(i) = metric.Evaluate(dataset.col(i),
+                                       centroids.col(assignments[i]));
+      ++pointDistances;
 
-      // Is this a better cluster?  At this point, upperBounds[i] = d(i, c(i)).
-      if (dist < upperBounds(i))
+      // Second bound test.
+      if (upperBounds(i) <= m)
       {
-        // lowerBounds holds the second closest cluster.
-        lowerBounds(i) = upperBounds(i);
-        upperBounds(i) = dist;
-        assignments[i] = c;
+        localCentroids.col(assignments[i]) += dataset.col(i);
+        ++localCounts(assignments[i]);
+        continue;
       }
-      else if (dist < lowerBounds(i))
+
+      // The bounds failed.  So test against all other clusters.
+      // This is Hamerly's Point-All-Ctrs() function from the paper.
+      // We have to reset the lower bound first.
+      lowerBounds(i) = DBL_MAX;
+      for (size_t c = 0; c < centroids.n_cols; ++c)
       {
-        // This is a closer second-closest cluster.
-        lowerBounds(i) = dist;
+        if (c == assignments[i])
+          continue;
+
+        const double dist = metric.Evaluate(dataset.col(i), centroids.col(c));
+
+        // Is this a better cluster?  At this point, upperBounds[i] = d(i,
+        // c(i)).
+        if (dist < upperBounds(i))
+        {
+          // lowerBounds holds the second closest cluster.
+          lowerBounds(i) = upperBounds(i);
+          upperBounds(i) = dist;
+          assignments[i] = c;
+        }
+        else if (dist < lowerBounds(i))
+        {
+          // This is a closer second-closest cluster.
+          lowerBounds(i) = dist;
+        }
       }
+      pointDistances += centroids.n_cols - 1;
+
+      // Update new centroids.
+      localCentroids.col(assignments[i]) += dataset.col(i);
+      ++localCounts(assignments[i]);
     }
-    distanceCalculations += centroids.n_cols - 1;
 
-    // Update new centroids.
-    newCentroids.col(assignments[i]) += dataset.col(i);
-    ++counts(assignments[i]);
+    // Combine the sums of each thread.
+    #pragma omp critical
+    {
+      newCentroids += localCentroids;
+      counts += localCounts;
+    }
   }
+  distanceCalculations += pointDistances;
 
   // Normalize centroids and calculate cluster movement (contains parts of
   // Move-Centers() and Update-Bounds()).
@@ -158,7 +180,8 @@ double HamerlyKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
   }
 
   // Now update bounds (lines 3-8 of Update-Bounds()).
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
   {
     upperBounds(i) += centroidMovements(assignments[i]);
     if (assignments[i] == furthestMovingCluster)
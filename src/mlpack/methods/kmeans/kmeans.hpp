@@ -13,6 +13,7 @@
 #define MLPACK_METHODS_KMEANS_KMEANS_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <functional>
 
 #include <mlpack/core/metrics/lmetric.hpp>
 #include "sample_initialization.hpp"
@@ -73,6 +74,10 @@ template<typename MetricType = metric::EuclideanDistance,
 class KMeans
 {
  public:
+  //! The type of the function called after each iteration.
+  using IterationCallbackType = std::function<void(const size_t,
+                                                   const arma::mat&)>;
+
   /**
    * Create a K-Means object and (optionally) set the parameters which K-Means
    * will be run with.
@@ -176,6 +181,17 @@ class KMeans
   //! Modify the empty cluster policy.
   EmptyClusterPolicy& EmptyClusterAction() { return emptyClusterAction; }
 
+  /**
+   * Get the function called after each iteration of Lloyd's algorithm, if any.
+   * It is called with the number of iterations done so far and the current
+   * centroids, so it can save them (for instance with data::Checkpointer) and
+   * clustering can be resumed from them with initialGuess = true.
+   */
+  const IterationCallbackType& IterationCallback() const
+  { return iterationCallback; }
+  //! Modify the function called after each iteration of Lloyd's algorithm.
+  IterationCallbackType& IterationCallback() { return iterationCallback; }
+
   //! Serialize the k-means object.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t version);
@@ -189,6 +205,8 @@ class KMeans
   InitialPartitionPolicy partitioner;
   //! Instantiated empty cluster policy.
   EmptyClusterPolicy emptyClusterAction;
+  //! Function called after each iteration (not serialized).
+  IterationCallbackType iterationCallback;
 };
 
 } // namespace kmeans
@@ -207,7 +207,15 @@ Cluster(const MatType& data,
 
   size_t iteration = 0;
 
+  // With MLPACK_USE_NUMA, the Lloyd steps read a copy of the points that is
+  // placed in memory by the threads that process them.
+  #ifdef MLPACK_USE_NUMA
+  MatType placedData;
+  util::FirstTouchCopy(data, placedData);
+  LloydStepType<MetricType, MatType> lloydStep(placedData, metric);
+  #else
   LloydStepType<MetricType, MatType> lloydStep(data, metric);
+  #endif
   arma::mat centroidsOther;
   double cNorm;
 
@@ -241,6 +249,12 @@ Cluster(const MatType& data,
         << cNorm << ".\n";
     if (std::isnan(cNorm) || std::isinf(cNorm))
       cNorm = 1e-4; // Keep iterating.
+
+    if (iterationCallback)
+    {
+      iterationCallback(iteration, (iteration % 2 == 1) ? centroidsOther :
+          centroids);
+    }
   } while (cNorm > 1e-5 && iteration != maxIterations);
 
   // If we ended on an even iteration, then the centroids are in the
@@ -314,7 +328,7 @@ Cluster(const MatType& data,
   // Calculate final assignments in parallel over the entire dataset.
   assignments.set_size(data.n_cols);
 
-  #pragma omp parallel for
+  #pragma omp parallel for MLPACK_OMP_PROC_BIND
   for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
   {
     // Find the closest centroid to this point.
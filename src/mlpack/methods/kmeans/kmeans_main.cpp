@@ -11,6 +11,7 @@
  */
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/util/io.hpp>
+#include <mlpack/core/data/space_filling_curve.hpp>
 #include <mlpack/core/util/mlpack_main.hpp>
 
 #include "kmeans.hpp"
@@ -22,6 +23,7 @@
 #include "hamerly_kmeans.hpp"
 #include "pelleg_moore_kmeans.hpp"
 #include "dual_tree_kmeans.hpp"
+#include "distributed_kmeans.hpp"
 
 using namespace mlpack;
 using namespace mlpack::kmeans;
@@ -64,7 +66,8 @@ BINDING_LONG_DESC(
     "Elkan's triangle-inequality based algorithm ('elkan'), Hamerly's "
     "modification to Elkan's algorithm ('hamerly'), the dual-tree k-means "
     "algorithm ('dualtree'), and the dual-tree k-means algorithm using the "
-    "cover tree ('dualtree-covertree')."
+    "cover tree ('dualtree-covertree').  The 'naive', 'elkan' and 'hamerly' "
+    "algorithms split the points of each iteration between OpenMP threads."
     "\n\n"
     "The behavior for when an empty cluster is encountered can be modified with"
     " the " + PRINT_PARAM_STRING("allow_empty_clusters") + " option.  When "
@@ -82,7 +85,16 @@ BINDING_LONG_DESC(
     "Initial clustering assignments may be specified using the " +
     PRINT_PARAM_STRING("initial_centroids") + " parameter, and the maximum "
     "number of iterations may be specified with the " +
-    PRINT_PARAM_STRING("max_iterations") + " parameter.");
+    PRINT_PARAM_STRING("max_iterations") + " parameter."
+    "\n\n"
+    "If mlpack is built with MPI support (the USE_MPI CMake option), the " +
+    PRINT_PARAM_STRING("distributed") + " option clusters the dataset with "
+    "every process launched by mpirun: each process runs the Lloyd iterations "
+    "on its slice of the points, and the centroids are combined over the "
+    "processes after each iteration.  Every process loads the same input "
+    "dataset, and only the first one saves the results.  In this mode empty "
+    "clusters keep their centroid, as with " +
+    PRINT_PARAM_STRING("allow_empty_clusters") + ".");
 
 // Example.
 BINDING_EXAMPLE(
@@ -159,6 +171,14 @@ PARAM_STRING_IN("algorithm", "Algorithm to use for the Lloyd iteration "
     "('naive', 'pelleg-moore', 'elkan', 'hamerly', 'dualtree', or "
     "'dualtree-covertree').", "a", "naive");
 
+PARAM_FLAG("distributed", "Cluster the dataset with all the MPI processes, "
+    "each one working on a slice of the points (requires mlpack built with "
+    "USE_MPI).", "D");
+PARAM_STRING_IN("reorder", "Reorder the points along a space-filling curve "
+    "('hilbert' or 'z-order') before clustering, for better memory locality; "
+    "the outputs are in the original order ('none' keeps the order).", "",
+    "none");
+
 // Given the type of initial partition policy, figure out the empty cluster
 // policy and run k-means.
 template<typename InitialPartitionPolicy>
@@ -175,8 +195,32 @@ template<typename InitialPartitionPolicy,
          template<class, class> class LloydStepType>
 void RunKMeans(const InitialPartitionPolicy& ipp);
 
+#ifdef MLPACK_USE_MPI
+// Run k-means on the slice of the dataset of this MPI process, and gather the
+// assignments of all the points if needed.
+template<typename InitialPartitionPolicy,
+         template<class, class> class LloydStepType>
+void RunDistributedKMeans(const InitialPartitionPolicy& ipp,
+                          const arma::mat& dataset,
+                          const size_t clusters,
+                          const size_t maxIterations,
+                          const bool computeAssignments,
+                          arma::Row<size_t>& assignments,
+                          arma::mat& centroids,
+                          const bool initialCentroidGuess);
+#endif
+
 static void mlpackMain()
 {
+#ifndef MLPACK_USE_MPI
+  if (IO::HasParam("distributed"))
+  {
+    Log::Fatal << "Cannot use " << PRINT_PARAM_STRING("distributed") << ": "
+        << "mlpack was not built with MPI support (USE_MPI)." << endl;
+  }
+#endif
+
+
   // Initialize random seed.
   if (IO::GetParam<int>("seed") != 0)
     math::RandomSeed((size_t) IO::GetParam<int>("seed"));
@@ -222,7 +266,10 @@ void FindEmptyClusterPolicy(const InitialPartitionPolicy& ipp)
     RequireOnlyOnePassed({ "allow_empty_clusters", "kill_empty_clusters" },
                          true);
 
-  if (IO::HasParam("allow_empty_clusters"))
+  // Distributed k-means always keeps the centroids of empty clusters.
+  ReportIgnoredParam({{ "distributed", true }}, "kill_empty_clusters");
+  if (IO::HasParam("distributed") ||
+      IO::HasParam("allow_empty_clusters"))
     FindLloydStepType<InitialPartitionPolicy, AllowEmptyClusters>(ipp);
   else if (IO::HasParam("kill_empty_clusters"))
     FindLloydStepType<InitialPartitionPolicy, KillEmptyClusters>(ipp);
@@ -238,6 +285,8 @@ void FindLloydStepType(const InitialPartitionPolicy& ipp)
   RequireParamInSet<string>("algorithm", { "elkan", "hamerly", "pelleg-moore",
       "dualtree", "dualtree-covertree", "naive" }, true, "unknown k-means "
       "algorithm");
+  RequireParamInSet<string>("reorder", { "none", "hilbert", "z-order" }, true,
+      "unknown space-filling curve");
 
   const string algorithm = IO::GetParam<string>("algorithm");
   if (algorithm == "elkan")
@@ -292,6 +341,13 @@ void RunKMeans(const InitialPartitionPolicy& ipp)
   arma::mat dataset = IO::GetParam<arma::mat>("input");  // Load our dataset.
   arma::mat centroids;
 
+  // Points that are close to each other are also close in memory after they
+  // are reordered along a space-filling curve.
+  const string reorder = IO::GetParam<string>("reorder");
+  arma::uvec order;
+  if (reorder != "none")
+    order = data::ReorderPoints(dataset, data::CurveTypeFromString(reorder));
+
   const bool initialCentroidGuess = IO::HasParam("initial_centroids");
   // Load initial centroids if the user asked for it.
   if (initialCentroidGuess)
@@ -307,18 +363,47 @@ void RunKMeans(const InitialPartitionPolicy& ipp)
   }
 
   Timer::Start("clustering");
-  KMeans<metric::EuclideanDistance,
-         InitialPartitionPolicy,
-         EmptyClusterPolicy,
-         LloydStepType> kmeans(maxIterations, metric::EuclideanDistance(), ipp);
+  // We need to get the assignments if we save labels.
+  const bool computeAssignments = IO::HasParam("output") ||
+      IO::HasParam("in_place");
+  arma::Row<size_t> assignments;
+  if (IO::HasParam("distributed"))
+  {
+#ifdef MLPACK_USE_MPI
+    RunDistributedKMeans<InitialPartitionPolicy, LloydStepType>(ipp, dataset,
+        clusters, maxIterations, computeAssignments, assignments, centroids,
+        initialCentroidGuess);
+#endif
+  }
+  else
+  {
+    KMeans<metric::EuclideanDistance,
+           InitialPartitionPolicy,
+           EmptyClusterPolicy,
+           LloydStepType> kmeans(maxIterations, metric::EuclideanDistance(),
+        ipp);
 
+    if (computeAssignments)
+    {
+      kmeans.Cluster(dataset, clusters, assignments, centroids, false,
+          initialCentroidGuess);
+    }
+    else
+    {
+      // Just compute the centroids.
+      kmeans.Cluster(dataset, clusters, centroids, initialCentroidGuess);
+    }
+  }
+  Timer::Stop("clustering");
+
+  // In distributed mode, only the first process still has outputs to save.
   if (IO::HasParam("output") || IO::HasParam("in_place"))
   {
-    // We need to get the assignments.
-    arma::Row<size_t> assignments;
-    kmeans.Cluster(dataset, clusters, assignments, centroids,
-        false, initialCentroidGuess);
-    Timer::Stop("clustering");
+    if (reorder != "none")
+    {
+      data::RestoreOrder(dataset, order);
+      data::RestoreOrder(assignments, order);
+    }
 
     // Now figure out what to do with our results.
     if (IO::HasParam("in_place"))
@@ -358,14 +443,72 @@ void RunKMeans(const InitialPartitionPolicy& ipp)
       }
     }
   }
-  else
-  {
-    // Just save the centroids.
-    kmeans.Cluster(dataset, clusters, centroids, initialCentroidGuess);
-    Timer::Stop("clustering");
-  }
 
   // Should we write the centroids to a file?
   if (IO::HasParam("centroid"))
     IO::GetParam<arma::mat>("centroid") = std::move(centroids);
 }
+
+#ifdef MLPACK_USE_MPI
+// Run k-means on the slice of the dataset of this MPI process, and gather the
+// assignments of all the points if needed.
+template<typename InitialPartitionPolicy,
+         template<class, class> class LloydStepType>
+void RunDistributedKMeans(const InitialPartitionPolicy& ipp,
+                          const arma::mat& dataset,
+                          const size_t clusters,
+                          const size_t maxIterations,
+                          const bool computeAssignments,
+                          arma::Row<size_t>& assignments,
+                          arma::mat& centroids,
+                          const bool initialCentroidGuess)
+{
+  distributed::MPICommunicator::Initialize();
+  distributed::MPICommunicator communicator;
+  Log::Info << "Distributed k-means with " << communicator.Size()
+      << " processes." << endl;
+
+  // Every process loaded the whole dataset, and keeps a contiguous slice of it
+  // (without copying it).
+  const size_t begin = communicator.Rank() * dataset.n_cols /
+      communicator.Size();
+  const size_t end = (communicator.Rank() + 1) * dataset.n_cols /
+      communicator.Size();
+  const arma::mat shard(const_cast<double*>(dataset.memptr()) + begin *
+      dataset.n_rows, dataset.n_rows, end - begin, false, true);
+
+  DistributedKMeans<distributed::MPICommunicator,
+                    metric::EuclideanDistance,
+                    InitialPartitionPolicy,
+                    LloydStepType> kmeans(communicator, maxIterations,
+      metric::EuclideanDistance(), ipp);
+
+  if (computeAssignments)
+  {
+    arma::Row<size_t> shardAssignments;
+    kmeans.Cluster(shard, clusters, shardAssignments, centroids,
+        initialCentroidGuess);
+
+    // Each process fills the assignments of its slice, and the sum over the
+    // processes gives all of them.
+    arma::rowvec allAssignments(dataset.n_cols, arma::fill::zeros);
+    for (size_t i = begin; i < end; ++i)
+      allAssignments[i] = (double) shardAssignments[i - begin];
+    distributed::RingAllReduce(communicator, allAssignments.memptr(),
+        allAssignments.n_elem);
+    assignments = arma::conv_to<arma::Row<size_t>>::from(allAssignments);
+  }
+  else
+  {
+    kmeans.Cluster(shard, clusters, centroids, initialCentroidGuess);
+  }
+
+  // Only the first process saves the results.
+  if (communicator.Rank() != 0)
+  {
+    IO::Parameters()["in_place"].wasPassed = false;
+    IO::Parameters()["output"].wasPassed = false;
+    IO::Parameters()["centroid"].wasPassed = false;
+  }
+}
+#endif
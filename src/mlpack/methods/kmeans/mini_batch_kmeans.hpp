@@ -0,0 +1,114 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans.hpp
+ *
+ * An implementation of a mini-batch step for k-means clustering, which updates
+ * the centroids from a random sample of the dataset in each iteration instead
+ * of a full pass over it.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * This is an implementation of mini-batch k-means, as described in the
+ * following paper:
+ *
+ * @code
+ * @inproceedings{sculley2010web,
+ *   title={Web-scale k-means clustering},
+ *   author={Sculley, D.},
+ *   booktitle={Proceedings of the 19th International Conference on World Wide
+ *       Web (WWW '10)},
+ *   pages={1177--1178},
+ *   year={2010}
+ * }
+ * @endcode
+ *
+ * Each iteration samples BatchSize() points of the dataset (with replacement),
+ * assigns them to their closest centroid (in parallel with OpenMP), and then
+ * moves each centroid towards each of its sampled points with a learning rate
+ * of 1 / (number of points assigned to that centroid so far).  The cost of an
+ * iteration therefore does not depend on the size of the dataset.  Because the
+ * centroids keep moving a little with every batch, KMeans will usually stop at
+ * its maximum number of iterations rather than at convergence.
+ *
+ * The counts given by Iterate() are the number of sampled points assigned to
+ * each cluster over all iterations, so a cluster is only empty if no sampled
+ * point has ever been assigned to it.
+ *
+ * To use this with the KMeans class, give it as the LloydStepType:
+ *
+ * @code
+ * KMeans<EuclideanDistance, KMeansPlusPlusInitialization,
+ *     AllowEmptyClusters, MiniBatchKMeans> k(200);
+ * @endcode
+ *
+ * For datasets that do not fit in memory, see StreamingKMeans.
+ *
+ * @param MetricType Type of metric used with this implementation.
+ * @param MatType Matrix type (arma::mat or arma::sp_mat).
+ */
+template<typename MetricType, typename MatType>
+class MiniBatchKMeans
+{
+ public:
+  /**
+   * Construct the MiniBatchKMeans object with the given dataset and metric.
+   *
+   * @param dataset Dataset.
+   * @param metric Instantiated metric.
+   * @param batchSize Number of points sampled in each iteration.
+   */
+  MiniBatchKMeans(const MatType& dataset,
+                  MetricType& metric,
+                  const size_t batchSize = 1024);
+
+  /**
+   * Run a single mini-batch iteration, updating the given centroids into the
+   * newCentroids matrix.
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Number of sampled points assigned to each cluster so far.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+  //! Get the number of points sampled in each iteration.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of points sampled in each iteration.
+  size_t& BatchSize() { return batchSize; }
+
+ private:
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated metric.
+  MetricType& metric;
+  //! The number of points sampled in each iteration.
+  size_t batchSize;
+  //! The number of sampled points assigned to each cluster so far.
+  arma::Col<size_t> clusterCounts;
+
+  //! Number of distance calculations.
+  size_t distanceCalculations;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "mini_batch_kmeans_impl.hpp"
+
+#endif
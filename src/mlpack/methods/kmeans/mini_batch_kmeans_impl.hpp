@@ -0,0 +1,101 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans_impl.hpp
+ *
+ * Implementation of the mini-batch step for k-means clustering.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mini_batch_kmeans.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MetricType, typename MatType>
+MiniBatchKMeans<MetricType, MatType>::MiniBatchKMeans(const MatType& dataset,
+                                                      MetricType& metric,
+                                                      const size_t batchSize) :
+    dataset(dataset),
+    metric(metric),
+    batchSize(batchSize),
+    distanceCalculations(0)
+{ /* Nothing to do. */ }
+
+template<typename MetricType, typename MatType>
+double MiniBatchKMeans<MetricType, MatType>::Iterate(
+    const arma::mat& centroids,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts)
+{
+  if (clusterCounts.n_elem != centroids.n_cols)
+    clusterCounts.zeros(centroids.n_cols);
+
+  // Sample the batch.  Sampling with replacement keeps this independent of the
+  // size of the dataset.
+  const size_t batch = std::max(std::min(batchSize, (size_t) dataset.n_cols),
+      (size_t) 1);
+  arma::Col<size_t> points(batch);
+  for (size_t i = 0; i < batch; ++i)
+    points[i] = math::RandInt(0, dataset.n_cols);
+
+  // Find the closest centroid to each point of the batch, with the centroids
+  // from the start of the iteration.
+  arma::Col<size_t> assignments(batch);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) batch; ++i)
+  {
+    double minDistance = std::numeric_limits<double>::infinity();
+    size_t closestCluster = centroids.n_cols; // Invalid value.
+
+    for (size_t j = 0; j < centroids.n_cols; ++j)
+    {
+      const double distance = metric.Evaluate(dataset.col(points[i]),
+          centroids.unsafe_col(j));
+      if (distance < minDistance)
+      {
+        minDistance = distance;
+        closestCluster = j;
+      }
+    }
+
+    Log::Assert(closestCluster != centroids.n_cols);
+    assignments[i] = closestCluster;
+  }
+  distanceCalculations += centroids.n_cols * batch;
+
+  // Move each centroid towards its points, with a learning rate that decays
+  // with the number of points the centroid has seen.
+  newCentroids = centroids;
+  for (size_t i = 0; i < batch; ++i)
+  {
+    const size_t cluster = assignments[i];
+    ++clusterCounts[cluster];
+    const double learningRate = 1.0 / clusterCounts[cluster];
+    newCentroids.col(cluster) += learningRate *
+        (arma::vec(dataset.col(points[i])) - newCentroids.col(cluster));
+  }
+
+  counts = clusterCounts;
+
+  // Calculate how far the centroids moved in this iteration.
+  double cNorm = 0.0;
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+  {
+    cNorm += std::pow(metric.Evaluate(centroids.col(i), newCentroids.col(i)),
+        2.0);
+  }
+  distanceCalculations += centroids.n_cols;
+
+  return std::sqrt(cNorm);
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
@@ -41,14 +41,14 @@ double NaiveKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
 
   // Find the closest centroid to each point and update the new centroids.
   // Computed in parallel over the complete dataset
-  #pragma omp parallel
+  #pragma omp parallel MLPACK_OMP_PROC_BIND
   {
     // The current state of the K-means is private for each thread
     arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
         arma::fill::zeros);
     arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
 
-    #pragma omp for
+    #pragma omp for schedule(static)
     for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
     {
       // Find the closest centroid to this point.
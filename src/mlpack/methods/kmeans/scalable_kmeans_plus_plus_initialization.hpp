@@ -0,0 +1,152 @@
+/**
+ * @file methods/kmeans/scalable_kmeans_plus_plus_initialization.hpp
+ *
+ * An implementation of the k-means|| (scalable k-means++) initialization
+ * strategy, which oversamples candidate centroids in a few parallel rounds and
+ * then reclusters the weighted candidates down to k centroids.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_SCALABLE_KMEANS_PLUS_PLUS_INITIALIZATION_HPP
+#define MLPACK_METHODS_KMEANS_SCALABLE_KMEANS_PLUS_PLUS_INITIALIZATION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * This class implements the k-means|| initialization, as described in the
+ * following paper:
+ *
+ * @code
+ * @article{bahmani2012scalable,
+ *   title={Scalable k-means++},
+ *   author={Bahmani, Bahman and Moseley, Benjamin and Vattani, Andrea and
+ *       Kumar, Ravi and Vassilvitskii, Sergei},
+ *   journal={Proceedings of the VLDB Endowment},
+ *   volume={5},
+ *   number={7},
+ *   pages={622--633},
+ *   year={2012}
+ * }
+ * @endcode
+ *
+ * Where k-means++ needs k passes over the data to pick k centroids, k-means||
+ * performs a small, fixed number of rounds.  In each round every point is
+ * sampled independently with probability proportional to its squared distance
+ * to the closest candidate so far, so that about (oversamplingFactor * k) new
+ * candidates are added per round.  Each candidate is then weighted by the
+ * number of points closest to it, and the weighted candidates are reclustered
+ * into k centroids with k-means++ seeding followed by a few weighted Lloyd
+ * iterations.  The distance computations are parallelized with OpenMP.
+ *
+ * This class satisfies the InitialPartitionPolicy template type of KMeans, so
+ * it can be used as
+ *
+ * @code
+ * KMeans<EuclideanDistance, ScalableKMeansPlusPlusInitialization> k;
+ * @endcode
+ */
+class ScalableKMeansPlusPlusInitialization
+{
+ public:
+  /**
+   * Create the initialization object, optionally specifying the parameters of
+   * the algorithm.
+   *
+   * @param oversamplingFactor Expected number of candidates sampled in each
+   *     round, as a multiple of the number of clusters.
+   * @param rounds Number of sampling rounds.
+   * @param reclusterIterations Maximum number of weighted Lloyd iterations
+   *     used to recluster the candidates.
+   */
+  ScalableKMeansPlusPlusInitialization(const double oversamplingFactor = 2.0,
+                                       const size_t rounds = 5,
+                                       const size_t reclusterIterations = 10) :
+      oversamplingFactor(oversamplingFactor),
+      rounds(rounds),
+      reclusterIterations(reclusterIterations) { }
+
+  /**
+   * Initialize the centroids matrix with the k-means|| algorithm.
+   *
+   * @tparam MatType Type of data (arma::mat or arma::sp_mat).
+   * @param data Dataset.
+   * @param clusters Number of clusters.
+   * @param centroids Matrix to put initial centroids into.
+   */
+  template<typename MatType>
+  void Cluster(const MatType& data,
+               const size_t clusters,
+               arma::mat& centroids) const;
+
+  //! Get the oversampling factor.
+  double OversamplingFactor() const { return oversamplingFactor; }
+  //! Modify the oversampling factor.
+  double& OversamplingFactor() { return oversamplingFactor; }
+
+  //! Get the number of sampling rounds.
+  size_t Rounds() const { return rounds; }
+  //! Modify the number of sampling rounds.
+  size_t& Rounds() { return rounds; }
+
+  //! Get the maximum number of reclustering iterations.
+  size_t ReclusterIterations() const { return reclusterIterations; }
+  //! Modify the maximum number of reclustering iterations.
+  size_t& ReclusterIterations() { return reclusterIterations; }
+
+  //! Serialize the object.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(oversamplingFactor));
+    ar(CEREAL_NVP(rounds));
+    ar(CEREAL_NVP(reclusterIterations));
+  }
+
+ private:
+  /**
+   * Update the squared distance of every point to its closest candidate, and
+   * the index of that candidate, with the candidates starting at the given
+   * index.
+   */
+  template<typename MatType>
+  static void UpdateDistances(const MatType& data,
+                              const std::vector<size_t>& candidates,
+                              const size_t firstCandidate,
+                              arma::vec& distances,
+                              arma::Col<size_t>& owners);
+
+  /**
+   * Reduce the weighted candidates to the given number of centroids, using
+   * weighted k-means++ seeding and weighted Lloyd iterations.
+   */
+  void Recluster(const arma::mat& candidates,
+                 const arma::vec& weights,
+                 const size_t clusters,
+                 arma::mat& centroids) const;
+
+  //! Sample an index with probability proportional to the given weights.
+  static size_t SampleIndex(const arma::vec& weights);
+
+  //! The expected number of candidates per round, as a multiple of k.
+  double oversamplingFactor;
+  //! The number of sampling rounds.
+  size_t rounds;
+  //! The maximum number of weighted Lloyd iterations for reclustering.
+  size_t reclusterIterations;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "scalable_kmeans_plus_plus_initialization_impl.hpp"
+
+#endif
@@ -0,0 +1,208 @@
+/**
+ * @file methods/kmeans/scalable_kmeans_plus_plus_initialization_impl.hpp
+ *
+ * Implementation of the k-means|| (scalable k-means++) initialization
+ * strategy.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_SCALABLE_KMEANS_PLUS_PLUS_INITIALIZATION_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_SCALABLE_KMEANS_PLUS_PLUS_INITIALIZATION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "scalable_kmeans_plus_plus_initialization.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MatType>
+void ScalableKMeansPlusPlusInitialization::Cluster(const MatType& data,
+                                                   const size_t clusters,
+                                                   arma::mat& centroids) const
+{
+  // The indices of the candidates, and for each point the squared distance to
+  // its closest candidate and the index of that candidate.
+  std::vector<size_t> candidates;
+  arma::vec distances(data.n_cols);
+  distances.fill(DBL_MAX);
+  arma::Col<size_t> owners(data.n_cols, arma::fill::zeros);
+
+  // The first candidate is sampled fully randomly.
+  candidates.push_back(math::RandInt(0, data.n_cols));
+  UpdateDistances(data, candidates, 0, distances, owners);
+
+  const double expected = oversamplingFactor * clusters;
+  for (size_t r = 0; r < rounds; ++r)
+  {
+    const double cost = arma::accu(distances);
+    if (cost == 0.0)
+      break; // Every point coincides with a candidate.
+
+    // Sample every point independently.  The random number generator is not
+    // thread-safe, so this pass is serial; it is cheap next to the distance
+    // updates.  Points that are already candidates have zero cost and can't be
+    // sampled twice.
+    const size_t firstCandidate = candidates.size();
+    for (size_t i = 0; i < data.n_cols; ++i)
+      if (math::Random() < expected * distances[i] / cost)
+        candidates.push_back(i);
+
+    UpdateDistances(data, candidates, firstCandidate, distances, owners);
+  }
+
+  // Top up with random points in the unlikely case that too few candidates
+  // were sampled.
+  if (candidates.size() < clusters)
+  {
+    const size_t firstCandidate = candidates.size();
+    while (candidates.size() < clusters)
+      candidates.push_back(math::RandInt(0, data.n_cols));
+
+    UpdateDistances(data, candidates, firstCandidate, distances, owners);
+  }
+
+  arma::mat candidatePoints(data.n_rows, candidates.size());
+  for (size_t c = 0; c < candidates.size(); ++c)
+    candidatePoints.col(c) = data.col(candidates[c]);
+
+  if (candidates.size() == clusters)
+  {
+    centroids = std::move(candidatePoints);
+    return;
+  }
+
+  // Weight each candidate by the number of points it is closest to.
+  arma::vec weights(candidates.size(), arma::fill::zeros);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    weights[owners[i]] += 1.0;
+
+  Recluster(candidatePoints, weights, clusters, centroids);
+}
+
+template<typename MatType>
+void ScalableKMeansPlusPlusInitialization::UpdateDistances(
+    const MatType& data,
+    const std::vector<size_t>& candidates,
+    const size_t firstCandidate,
+    arma::vec& distances,
+    arma::Col<size_t>& owners)
+{
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  {
+    for (size_t c = firstCandidate; c < candidates.size(); ++c)
+    {
+      const double distance = metric::SquaredEuclideanDistance::Evaluate(
+          data.col(i), data.col(candidates[c]));
+      if (distance < distances[i])
+      {
+        distances[i] = distance;
+        owners[i] = c;
+      }
+    }
+  }
+}
+
+inline void ScalableKMeansPlusPlusInitialization::Recluster(
+    const arma::mat& candidates,
+    const arma::vec& weights,
+    const size_t clusters,
+    arma::mat& centroids) const
+{
+  centroids.set_size(candidates.n_rows, clusters);
+
+  // Weighted k-means++ seeding: the first centroid is sampled according to the
+  // weights, and each further one according to weight times squared distance
+  // to the closest centroid chosen so far.
+  centroids.col(0) = candidates.col(SampleIndex(weights));
+  arma::vec distances(candidates.n_cols);
+  distances.fill(DBL_MAX);
+  for (size_t k = 1; k < clusters; ++k)
+  {
+    #pragma omp parallel for
+    for (omp_size_t c = 0; c < (omp_size_t) candidates.n_cols; ++c)
+    {
+      const double distance = metric::SquaredEuclideanDistance::Evaluate(
+          candidates.col(c), centroids.col(k - 1));
+      distances[c] = std::min(distances[c], distance);
+    }
+
+    arma::vec probabilities = weights % distances;
+    if (arma::accu(probabilities) == 0.0)
+      probabilities = weights;
+    centroids.col(k) = candidates.col(SampleIndex(probabilities));
+  }
+
+  // Refine with weighted Lloyd iterations on the candidates.
+  arma::Col<size_t> assignments(candidates.n_cols);
+  assignments.fill(clusters);
+  for (size_t iteration = 0; iteration < reclusterIterations; ++iteration)
+  {
+    arma::mat newCentroids(centroids.n_rows, clusters, arma::fill::zeros);
+    arma::vec totalWeights(clusters, arma::fill::zeros);
+    omp_size_t changed = 0;
+
+    #pragma omp parallel reduction(+:changed)
+    {
+      arma::mat localCentroids(centroids.n_rows, clusters, arma::fill::zeros);
+      arma::vec localWeights(clusters, arma::fill::zeros);
+
+      #pragma omp for
+      for (omp_size_t c = 0; c < (omp_size_t) candidates.n_cols; ++c)
+      {
+        double minDistance = DBL_MAX;
+        size_t closest = 0;
+        for (size_t k = 0; k < clusters; ++k)
+        {
+          const double distance = metric::SquaredEuclideanDistance::Evaluate(
+              candidates.col(c), centroids.col(k));
+          if (distance < minDistance)
+          {
+            minDistance = distance;
+            closest = k;
+          }
+        }
+
+        if (assignments[c] != closest)
+        {
+          assignments[c] = closest;
+          ++changed;
+        }
+
+        localCentroids.col(closest) += weights[c] * candidates.col(c);
+        localWeights[closest] += weights[c];
+      }
+
+      #pragma omp critical
+      {
+        newCentroids += localCentroids;
+        totalWeights += localWeights;
+      }
+    }
+
+    if (changed == 0)
+      break;
+
+    // Clusters that lost all their weight keep their previous centroid.
+    for (size_t k = 0; k < clusters; ++k)
+      if (totalWeights[k] > 0.0)
+        centroids.col(k) = newCentroids.col(k) / totalWeights[k];
+  }
+}
+
+inline size_t ScalableKMeansPlusPlusInitialization::SampleIndex(
+    const arma::vec& weights)
+{
+  const arma::vec cdf = arma::cumsum(weights);
+  const double sampleValue = math::Random() * cdf[cdf.n_elem - 1];
+  const double* elem = std::upper_bound(cdf.begin(), cdf.end(), sampleValue);
+  return std::min((size_t) (elem - cdf.begin()), (size_t) cdf.n_elem - 1);
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
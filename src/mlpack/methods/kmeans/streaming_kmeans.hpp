@@ -0,0 +1,142 @@
+/**
+ * @file methods/kmeans/streaming_kmeans.hpp
+ *
+ * An implementation of streaming (online mini-batch) k-means clustering, which
+ * consumes the dataset in chunks and never holds more than one chunk in
+ * memory.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_STREAMING_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_STREAMING_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+#include "kmeans.hpp"
+#include "sample_initialization.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * StreamingKMeans clusters a dataset that is given one chunk at a time, with
+ * the same centroid updates as MiniBatchKMeans: the points of each chunk are
+ * assigned to their closest centroid (in parallel with OpenMP), and each
+ * centroid is then moved towards each of its points with a learning rate of
+ * 1 / (number of points assigned to that centroid so far).  Each chunk is used
+ * once and can be discarded afterwards, so datasets much larger than memory
+ * can be clustered in a single pass.
+ *
+ * The centroids are initialized from the first chunk with the
+ * InitialPartitionPolicy, unless they were given to the constructor.
+ *
+ * Chunks can be passed to Update() one by one, or Cluster() can be given a
+ * loader: any callable object that takes an arma::mat& (or MatType&), fills it
+ * with the next chunk, and returns false once there are no more chunks.
+ *
+ * @code
+ * StreamingKMeans<> k(1000);
+ * k.Cluster([&](arma::mat& chunk) { return reader.NextChunk(chunk); });
+ * const arma::mat& centroids = k.Centroids();
+ * @endcode
+ *
+ * @tparam MetricType The distance metric to use.
+ * @tparam InitialPartitionPolicy Initial partitioning policy, used on the
+ *     first chunk.
+ */
+template<typename MetricType = metric::EuclideanDistance,
+         typename InitialPartitionPolicy = SampleInitialization>
+class StreamingKMeans
+{
+ public:
+  /**
+   * Create the StreamingKMeans object.
+   *
+   * @param clusters Number of clusters to compute.
+   * @param metric Optional MetricType object; for when the metric has state
+   *     it needs to store.
+   * @param partitioner Optional InitialPartitionPolicy object; for when a
+   *     specially initialized partitioning policy is required.
+   */
+  StreamingKMeans(const size_t clusters,
+                  const MetricType metric = MetricType(),
+                  const InitialPartitionPolicy partitioner =
+                      InitialPartitionPolicy());
+
+  /**
+   * Create the StreamingKMeans object with the given initial centroids.
+   *
+   * @param centroids Initial centroids, one in each column.
+   * @param metric Optional MetricType object; for when the metric has state
+   *     it needs to store.
+   */
+  StreamingKMeans(const arma::mat& centroids,
+                  const MetricType metric = MetricType());
+
+  /**
+   * Update the centroids with the points of the given chunk.  If the centroids
+   * are not initialized yet, they are initialized from this chunk first.
+   *
+   * @param chunk Points to update the centroids with.
+   */
+  template<typename MatType>
+  void Update(const MatType& chunk);
+
+  /**
+   * Update the centroids with every chunk the given loader gives, until it
+   * returns false.  The number of points used is returned.
+   *
+   * @param loader Callable object that fills the given matrix with the next
+   *     chunk, and returns false when there are no more chunks.
+   */
+  template<typename MatType = arma::mat, typename LoaderType>
+  size_t Cluster(LoaderType&& loader);
+
+  /**
+   * Assign each point of the given data to its closest centroid.
+   *
+   * @param data Points to assign.
+   * @param assignments Vector to store cluster assignments in.
+   */
+  template<typename MatType>
+  void Assign(const MatType& data, arma::Row<size_t>& assignments) const;
+
+  //! Get the number of clusters.
+  size_t Clusters() const { return clusters; }
+  //! Get the centroids.
+  const arma::mat& Centroids() const { return centroids; }
+  //! Get the number of points assigned to each cluster so far.
+  const arma::Col<size_t>& Counts() const { return counts; }
+
+  //! Get the distance metric.
+  const MetricType& Metric() const { return metric; }
+  //! Modify the distance metric.
+  MetricType& Metric() { return metric; }
+
+  //! Serialize the state of the clustering, so it can be resumed.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  //! The number of clusters.
+  size_t clusters;
+  //! The distance metric.
+  MetricType metric;
+  //! The initial partitioning policy.
+  InitialPartitionPolicy partitioner;
+  //! The centroids, one in each column.
+  arma::mat centroids;
+  //! The number of points assigned to each cluster so far.
+  arma::Col<size_t> counts;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "streaming_kmeans_impl.hpp"
+
+#endif
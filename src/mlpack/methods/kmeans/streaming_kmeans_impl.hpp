@@ -0,0 +1,187 @@
+/**
+ * @file methods/kmeans/streaming_kmeans_impl.hpp
+ *
+ * Implementation of streaming k-means clustering.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_STREAMING_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_STREAMING_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "streaming_kmeans.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MetricType, typename InitialPartitionPolicy>
+StreamingKMeans<MetricType, InitialPartitionPolicy>::StreamingKMeans(
+    const size_t clusters,
+    const MetricType metric,
+    const InitialPartitionPolicy partitioner) :
+    clusters(clusters),
+    metric(metric),
+    partitioner(partitioner)
+{
+  if (clusters == 0)
+  {
+    throw std::invalid_argument("StreamingKMeans: number of clusters must be "
+        "greater than 0");
+  }
+}
+
+template<typename MetricType, typename InitialPartitionPolicy>
+StreamingKMeans<MetricType, InitialPartitionPolicy>::StreamingKMeans(
+    const arma::mat& centroids,
+    const MetricType metric) :
+    clusters(centroids.n_cols),
+    metric(metric),
+    centroids(centroids),
+    counts(centroids.n_cols, arma::fill::zeros)
+{
+  if (clusters == 0)
+  {
+    throw std::invalid_argument("StreamingKMeans: number of clusters must be "
+        "greater than 0");
+  }
+}
+
+template<typename MetricType, typename InitialPartitionPolicy>
+template<typename MatType>
+void StreamingKMeans<MetricType, InitialPartitionPolicy>::Update(
+    const MatType& chunk)
+{
+  if (chunk.n_cols == 0)
+    return;
+
+  if (centroids.is_empty())
+  {
+    if (chunk.n_cols < clusters)
+    {
+      std::ostringstream oss;
+      oss << "StreamingKMeans::Update(): the first chunk has " << chunk.n_cols
+          << " points, but at least " << clusters << " (the number of "
+          << "clusters) are needed to initialize the centroids";
+      throw std::invalid_argument(oss.str());
+    }
+
+    // Use the partitioner on the first chunk, the same way KMeans does.
+    arma::Row<size_t> assignments;
+    if (GetInitialAssignmentsOrCentroids(partitioner, chunk, clusters,
+        assignments, centroids))
+    {
+      arma::Row<size_t> initialCounts(clusters, arma::fill::zeros);
+      centroids.zeros(chunk.n_rows, clusters);
+      for (size_t i = 0; i < chunk.n_cols; ++i)
+      {
+        centroids.col(assignments[i]) += arma::vec(chunk.col(i));
+        initialCounts[assignments[i]]++;
+      }
+
+      for (size_t i = 0; i < clusters; ++i)
+        if (initialCounts[i] != 0)
+          centroids.col(i) /= initialCounts[i];
+    }
+
+    counts.zeros(clusters);
+  }
+
+  if (chunk.n_rows != centroids.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "StreamingKMeans::Update(): chunk has dimensionality "
+        << chunk.n_rows << ", but the centroids have dimensionality "
+        << centroids.n_rows;
+    throw std::invalid_argument(oss.str());
+  }
+
+  arma::Row<size_t> assignments;
+  Assign(chunk, assignments);
+
+  // Move each centroid towards its points, with a learning rate that decays
+  // with the number of points the centroid has seen.
+  for (size_t i = 0; i < chunk.n_cols; ++i)
+  {
+    const size_t cluster = assignments[i];
+    ++counts[cluster];
+    const double learningRate = 1.0 / counts[cluster];
+    centroids.col(cluster) += learningRate *
+        (arma::vec(chunk.col(i)) - centroids.col(cluster));
+  }
+}
+
+template<typename MetricType, typename InitialPartitionPolicy>
+template<typename MatType, typename LoaderType>
+size_t StreamingKMeans<MetricType, InitialPartitionPolicy>::Cluster(
+    LoaderType&& loader)
+{
+  size_t points = 0;
+  size_t chunks = 0;
+  MatType chunk;
+  while (loader(chunk))
+  {
+    Update(chunk);
+    points += chunk.n_cols;
+    ++chunks;
+  }
+
+  Log::Info << "StreamingKMeans::Cluster(): used " << points << " points in "
+      << chunks << " chunks." << std::endl;
+  return points;
+}
+
+template<typename MetricType, typename InitialPartitionPolicy>
+template<typename MatType>
+void StreamingKMeans<MetricType, InitialPartitionPolicy>::Assign(
+    const MatType& data,
+    arma::Row<size_t>& assignments) const
+{
+  if (centroids.is_empty())
+  {
+    throw std::invalid_argument("StreamingKMeans::Assign(): centroids are not "
+        "initialized");
+  }
+
+  assignments.set_size(data.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  {
+    double minDistance = std::numeric_limits<double>::infinity();
+    size_t closestCluster = centroids.n_cols; // Invalid value.
+
+    for (size_t j = 0; j < centroids.n_cols; ++j)
+    {
+      const double distance = metric.Evaluate(data.col(i),
+          centroids.unsafe_col(j));
+      if (distance < minDistance)
+      {
+        minDistance = distance;
+        closestCluster = j;
+      }
+    }
+
+    Log::Assert(closestCluster != centroids.n_cols);
+    assignments[i] = closestCluster;
+  }
+}
+
+template<typename MetricType, typename InitialPartitionPolicy>
+template<typename Archive>
+void StreamingKMeans<MetricType, InitialPartitionPolicy>::serialize(
+    Archive& ar,
+    const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(clusters));
+  ar(CEREAL_NVP(metric));
+  ar(CEREAL_NVP(centroids));
+  ar(CEREAL_NVP(counts));
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
@@ -203,6 +203,8 @@ double LARS::Train(const arma::mat& matX,
   beta = arma::zeros(dataRef.n_cols);
   arma::vec yHat = arma::zeros(dataRef.n_rows);
   arma::vec yHatDirection(dataRef.n_rows);
+  // Correlations of each dimension with yHatDirection.
+  arma::vec dirCorrs(dataRef.n_cols);
 
   bool lassocond = false;
 
@@ -231,8 +233,13 @@ double LARS::Train(const arma::mat& matX,
   }
 
   // Compute the Gram matrix.  If this is the elastic net problem, we will add
-  // lambda2 * I_n to the matrix.
-  if (matGram->n_elem != dataRef.n_cols * dataRef.n_cols)
+  // lambda2 * I_n to the matrix.  The Cholesky updates only need the inner
+  // products of each new active dimension with the active set, so in that case
+  // the (possibly very large) Gram matrix is not formed, and the needed entries
+  // are computed as the dimensions become active.
+  const bool lazyGram = useCholesky &&
+      (matGram->n_elem != dataRef.n_cols * dataRef.n_cols);
+  if (!lazyGram && matGram->n_elem != dataRef.n_cols * dataRef.n_cols)
   {
     // In this case, matGram should reference matGramInternal.
     matGramInternal = trans(dataRef) * dataRef;
@@ -266,10 +273,21 @@ double LARS::Train(const arma::mat& matX,
         //   newGramCol[i] = dot(matX.col(activeSet[i]), matX.col(changeInd));
         // }
         // This is equivalent to the above 5 lines.
-        arma::vec newGramCol = matGram->elem(changeInd * dataRef.n_cols +
-            arma::conv_to<arma::uvec>::from(activeSet));
+        if (lazyGram)
+        {
+          const arma::vec newGramCol = trans(dataRef.cols(
+              arma::conv_to<arma::uvec>::from(activeSet))) *
+              dataRef.col(changeInd);
+          CholeskyInsert(dot(dataRef.col(changeInd), dataRef.col(changeInd)),
+              newGramCol);
+        }
+        else
+        {
+          arma::vec newGramCol = matGram->elem(changeInd * dataRef.n_cols +
+              arma::conv_to<arma::uvec>::from(activeSet));
 
-        CholeskyInsert((*matGram)(changeInd, changeInd), newGramCol);
+          CholeskyInsert((*matGram)(changeInd, changeInd), newGramCol);
+        }
       }
 
       // Add variable to active set.
@@ -364,13 +382,21 @@ double LARS::Train(const arma::mat& matX,
     // If not all variables are active.
     if ((activeSet.size() + ignoreSet.size()) < dataRef.n_cols)
     {
-      // Compute correlations with direction.
+      // Compute correlations with direction.  The correlations are independent,
+      // so they are computed in parallel.
+      #pragma omp parallel for
+      for (omp_size_t ind = 0; ind < (omp_size_t) dataRef.n_cols; ind++)
+      {
+        if (!isActive[ind] && !isIgnored[ind])
+          dirCorrs[ind] = dot(dataRef.col(ind), yHatDirection);
+      }
+
       for (size_t ind = 0; ind < dataRef.n_cols; ind++)
       {
         if (isActive[ind] || isIgnored[ind])
           continue;
 
-        const double dirCorr = dot(dataRef.col(ind), yHatDirection);
+        const double dirCorr = dirCorrs[ind];
         const double val1 = (maxCorr - corr(ind)) / (normalization - dirCorr);
         const double val2 = (maxCorr + corr(ind)) / (normalization + dirCorr);
         if ((val1 > 0.0) && (val1 < gamma))
@@ -435,7 +461,11 @@ double LARS::Train(const arma::mat& matX,
       Deactivate(changeInd);
     }
 
-    corr = vecXTy - trans(dataRef) * yHat;
+    // Update the correlations of all dimensions with the residual, in
+    // parallel.
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) dataRef.n_cols; ++i)
+      corr[i] = vecXTy[i] - dot(dataRef.col(i), yHat);
     if (elasticNet)
       corr -= lambda2 * beta;
 
@@ -473,6 +503,71 @@ double LARS::Train(const arma::mat& data,
   return Train(data, responses, beta, transposeData);
 }
 
+void LARS::TrainPath(const arma::mat& data,
+                     const arma::rowvec& responses,
+                     const arma::vec& lambdas,
+                     arma::mat& betas,
+                     const bool transposeData)
+{
+  if (lambdas.n_elem == 0 || arma::min(lambdas) <= 0.0)
+  {
+    throw std::invalid_argument("LARS::TrainPath(): at least one value of "
+        "lambda1 must be given, and all values must be positive!");
+  }
+
+  // A single run down to the smallest value gives the whole path.
+  lambda1 = arma::min(lambdas);
+  arma::vec beta;
+  Train(data, responses, beta, transposeData);
+
+  betas.set_size(beta.n_elem, lambdas.n_elem);
+  for (size_t i = 0; i < lambdas.n_elem; ++i)
+  {
+    PathSolution(lambdas[i], beta);
+    betas.col(i) = beta;
+  }
+}
+
+void LARS::PathSolution(const double lambda, arma::vec& beta) const
+{
+  if (betaPath.empty())
+  {
+    throw std::invalid_argument("LARS::PathSolution(): the model has not been "
+        "trained!");
+  }
+
+  if (lasso && lambda < lambda1)
+  {
+    std::stringstream ss;
+    ss << "LARS::PathSolution(): the path was only computed down to lambda1 = "
+        << lambda1 << ", but the solution for " << lambda << " was requested!";
+    throw std::invalid_argument(ss.str());
+  }
+
+  // The values of lambda1 decrease along the path; find the first knot at or
+  // below the requested value.
+  size_t k = 0;
+  while (k < lambdaPath.size() && lambdaPath[k] > lambda)
+    ++k;
+
+  if (k == 0)
+  {
+    beta = betaPath.front();
+  }
+  else if (k == lambdaPath.size())
+  {
+    // The path ended before reaching lambda (for instance, because all
+    // dimensions became active), so the last solution holds.
+    beta = betaPath.back();
+  }
+  else
+  {
+    const double interp = (lambdaPath[k - 1] - lambda) /
+        (lambdaPath[k - 1] - lambdaPath[k]);
+    beta = (1 - interp) * betaPath[k - 1] + interp * betaPath[k];
+  }
+}
+
 void LARS::Predict(const arma::mat& points,
                    arma::rowvec& predictions,
                    const bool rowMajor) const
@@ -236,6 +236,42 @@ class LARS
                const arma::rowvec& responses,
                const bool transposeData = true);
 
+  /**
+   * Compute the solutions for several values of lambda1 with a single run of
+   * LARS.  The LASSO (and elastic net, for a fixed lambda2) solution is a
+   * piecewise linear function of lambda1, and LARS computes it at each knot of
+   * the path, so the solution for any value of lambda1 along the path is
+   * found by interpolation.  Training stops at the smallest of the given
+   * values, which becomes the value of Lambda1(); afterwards, Beta() is the
+   * solution for that value and PathSolution() can be used for any larger
+   * value.
+   *
+   * @param data Input data.
+   * @param responses A vector of targets.
+   * @param lambdas Values of lambda1 to compute solutions for; all must be
+   *     positive.
+   * @param betas Matrix to store the solutions in, one column for each value
+   *     of lambda1.
+   * @param transposeData Should be true if the input data is column-major and
+   *     false otherwise.
+   */
+  void TrainPath(const arma::mat& data,
+                 const arma::rowvec& responses,
+                 const arma::vec& lambdas,
+                 arma::mat& betas,
+                 const bool transposeData = true);
+
+  /**
+   * Get the solution for the given value of lambda1 from the solution path
+   * computed by the last call to Train() or TrainPath(), by interpolating
+   * between the knots of the path.  The value must not be smaller than
+   * Lambda1().
+   *
+   * @param lambda Value of lambda1 to get the solution for.
+   * @param beta Vector to store the solution in.
+   */
+  void PathSolution(const double lambda, arma::vec& beta) const;
+
   /**
    * Predict y_i for each data point in the given data matrix using the
    * currently-trained LARS model.
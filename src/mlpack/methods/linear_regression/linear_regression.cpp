@@ -88,6 +88,55 @@ double LinearRegression::Train(const arma::mat& predictors,
   return ComputeError(predictors, responses);
 }
 
+double LinearRegression::Train(const RegressionStatistics& statistics,
+                               const bool intercept)
+{
+  if (statistics.WeightSum() == 0.0)
+  {
+    throw std::invalid_argument("LinearRegression::Train(): statistics do not "
+        "hold any (weighted) points!");
+  }
+
+  this->intercept = intercept;
+
+  // Rebuild the normal equations a * (X X^T) = y X^T from the centered
+  // statistics.  With an intercept, the first row of X is all ones.
+  const double n = statistics.WeightSum();
+  const arma::vec& means = statistics.Means();
+  const double responsesMean = statistics.ResponsesMean();
+  const size_t offset = intercept ? 1 : 0;
+  const size_t dims = means.n_elem + offset;
+
+  arma::mat cov(dims, dims);
+  arma::vec cross(dims);
+  cov.submat(offset, offset, dims - 1, dims - 1) = statistics.Scatter() +
+      n * means * means.t();
+  cross.subvec(offset, dims - 1) = statistics.CrossScatter() +
+      n * responsesMean * means;
+  if (intercept)
+  {
+    cov(0, 0) = n;
+    cov.submat(1, 0, dims - 1, 0) = n * means;
+    cov.submat(0, 1, 0, dims - 1) = n * means.t();
+    cross(0) = n * responsesMean;
+  }
+
+  parameters = arma::solve(cov +
+      lambda * arma::eye<arma::mat>(dims, dims), cross);
+
+  // The squared error splits into the error of the centered points and the
+  // error at the means, which avoids cancellation between large sums.
+  const arma::vec slopes = parameters.subvec(offset, dims - 1);
+  const double meanError = responsesMean - arma::dot(slopes, means) -
+      (intercept ? parameters(0) : 0.0);
+  const double error = statistics.ResponsesScatter() -
+      2 * arma::dot(slopes, statistics.CrossScatter()) +
+      arma::as_scalar(slopes.t() * statistics.Scatter() * slopes) +
+      n * meanError * meanError;
+
+  return std::max(error, 0.0) / n;
+}
+
 void LinearRegression::Predict(const arma::mat& points,
     arma::rowvec& predictions) const
 {
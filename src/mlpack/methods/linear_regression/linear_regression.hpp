@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_LINEAR_REGRESSION_LINEAR_REGRESSION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include "regression_statistics.hpp"
 
 namespace mlpack {
 namespace regression /** Regression methods. */ {
@@ -95,6 +96,19 @@ class LinearRegression
                const arma::rowvec& weights,
                const bool intercept = true);
 
+  /**
+   * Train the LinearRegression model on the points summarized by the given
+   * statistics, which can be accumulated in chunks (see RegressionStatistics);
+   * the result is the same as training on all the points at once.  Careful!
+   * This will completely ignore and overwrite the existing model.
+   *
+   * @param statistics Statistics of the points to train the model on.
+   * @param intercept Whether or not to fit an intercept term.
+   * @return The (weighted) least squares error after training.
+   */
+  double Train(const RegressionStatistics& statistics,
+               const bool intercept = true);
+
   /**
    * Calculate y_i for each data point in points.
    *
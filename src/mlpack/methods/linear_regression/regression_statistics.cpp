@@ -0,0 +1,173 @@
+/**
+ * @file methods/linear_regression/regression_statistics.cpp
+ *
+ * Implementation of the RegressionStatistics class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "regression_statistics.hpp"
+
+using namespace mlpack;
+using namespace mlpack::regression;
+
+RegressionStatistics::RegressionStatistics() :
+    count(0),
+    weightSum(0.0),
+    responsesMean(0.0),
+    responsesScatter(0.0)
+{
+  // Nothing to do.
+}
+
+void RegressionStatistics::Update(const arma::mat& predictors,
+                                  const arma::rowvec& responses)
+{
+  Update(predictors, responses, NULL);
+}
+
+void RegressionStatistics::Update(const arma::mat& predictors,
+                                  const arma::rowvec& responses,
+                                  const arma::rowvec& weights)
+{
+  if (weights.n_elem != predictors.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "RegressionStatistics::Update(): number of weights ("
+        << weights.n_elem << ") does not match number of points ("
+        << predictors.n_cols << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  Update(predictors, responses, &weights);
+}
+
+RegressionStatistics& RegressionStatistics::operator+=(
+    const RegressionStatistics& other)
+{
+  if (other.count == 0)
+    return *this;
+
+  if (count == 0)
+  {
+    *this = other;
+    return *this;
+  }
+
+  if (other.Dimensionality() != Dimensionality())
+  {
+    std::ostringstream oss;
+    oss << "RegressionStatistics::operator+=(): dimensionality of statistics ("
+        << other.Dimensionality() << ") does not match dimensionality of "
+        << "these statistics (" << Dimensionality() << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Points without weight change nothing but the count.
+  if (other.weightSum == 0.0)
+  {
+    count += other.count;
+    return *this;
+  }
+  else if (weightSum == 0.0)
+  {
+    const size_t oldCount = count;
+    *this = other;
+    count += oldCount;
+    return *this;
+  }
+
+  // The pairwise update of Chan et al.: the scatter of the union is the sum of
+  // the scatters plus a correction for the distance between the means.
+  const double nA = weightSum;
+  const double nB = other.weightSum;
+  const double n = nA + nB;
+  const arma::vec delta = other.means - means;
+  const double responsesDelta = other.responsesMean - responsesMean;
+
+  scatter += other.scatter + delta * delta.t() * (nA * nB / n);
+  crossScatter += other.crossScatter + delta * (responsesDelta * nA * nB / n);
+  responsesScatter += other.responsesScatter +
+      responsesDelta * responsesDelta * (nA * nB / n);
+  means += delta * (nB / n);
+  responsesMean += responsesDelta * (nB / n);
+
+  count += other.count;
+  weightSum = n;
+  return *this;
+}
+
+void RegressionStatistics::Update(const arma::mat& predictors,
+                                  const arma::rowvec& responses,
+                                  const arma::rowvec* weights)
+{
+  if (responses.n_elem != predictors.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "RegressionStatistics::Update(): number of responses ("
+        << responses.n_elem << ") does not match number of points ("
+        << predictors.n_cols << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  if (predictors.n_cols == 0)
+    return;
+
+  if (count > 0 && predictors.n_rows != Dimensionality())
+  {
+    std::ostringstream oss;
+    oss << "RegressionStatistics::Update(): dimensionality of points ("
+        << predictors.n_rows << ") does not match dimensionality of "
+        << "statistics (" << Dimensionality() << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Summarize each block of points on its own, then merge the blocks in order
+  // so that the result does not depend on the number of threads.
+  const size_t numBlocks = (predictors.n_cols + BlockSize - 1) / BlockSize;
+  std::vector<RegressionStatistics> blocks(numBlocks);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const size_t begin = b * BlockSize;
+    const size_t end = std::min(begin + BlockSize,
+        (size_t) predictors.n_cols) - 1;
+    RegressionStatistics& block = blocks[b];
+
+    arma::rowvec w;
+    if (weights != NULL)
+      w = weights->subvec(begin, end);
+    else
+      w.ones(end - begin + 1);
+
+    block.count = end - begin + 1;
+    block.weightSum = arma::accu(w);
+    if (block.weightSum == 0.0)
+    {
+      block.means.zeros(predictors.n_rows);
+      block.scatter.zeros(predictors.n_rows, predictors.n_rows);
+      block.crossScatter.zeros(predictors.n_rows);
+      continue;
+    }
+
+    block.means = predictors.cols(begin, end) * w.t() / block.weightSum;
+    block.responsesMean = arma::dot(responses.subvec(begin, end), w) /
+        block.weightSum;
+
+    const arma::mat centered = predictors.cols(begin, end).each_col() -
+        block.means;
+    const arma::rowvec centeredResponses = responses.subvec(begin, end) -
+        block.responsesMean;
+
+    block.scatter = (centered.each_row() % w) * centered.t();
+    block.crossScatter = centered * (centeredResponses % w).t();
+    block.responsesScatter = arma::dot(centeredResponses % w,
+        centeredResponses);
+  }
+
+  for (size_t b = 0; b < numBlocks; ++b)
+    *this += blocks[b];
+}
@@ -0,0 +1,144 @@
+/**
+ * @file methods/linear_regression/regression_statistics.hpp
+ *
+ * Definition of the RegressionStatistics class, which accumulates the
+ * sufficient statistics of a linear regression over chunks of data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_LINEAR_REGRESSION_REGRESSION_STATISTICS_HPP
+#define MLPACK_METHODS_LINEAR_REGRESSION_REGRESSION_STATISTICS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace regression {
+
+/**
+ * RegressionStatistics holds everything LinearRegression and
+ * BayesianLinearRegression need to know about a training set: the (weighted)
+ * number of points, the means of the predictors and of the responses, and the
+ * centered sums of products of the predictors and responses.  This takes
+ * O(d^2) memory however many points are added, so a dataset that does not fit
+ * in memory can be streamed through Update() in chunks, and the model trained
+ * afterwards from the statistics:
+ *
+ * @code
+ * RegressionStatistics stats;
+ * while (ReadChunk(predictors, responses)) // Some way of reading the data.
+ *   stats.Update(predictors, responses);
+ *
+ * LinearRegression lr;
+ * lr.Train(stats);
+ * @endcode
+ *
+ * The points of each chunk are split in blocks that are summarized in
+ * parallel.  The statistics are kept centered and merged with the pairwise
+ * update of Chan et al., which is much more accurate than summing raw
+ * products.  Statistics collected separately (for instance by different
+ * processes, which can send them to each other with serialization) can be
+ * merged with operator+=().
+ */
+class RegressionStatistics
+{
+ public:
+  /**
+   * Create empty statistics.  The dimensionality is set by the first call to
+   * Update().
+   */
+  RegressionStatistics();
+
+  /**
+   * Add the given points to the statistics.
+   *
+   * @param predictors Matrix of points, one per column.
+   * @param responses The response of each point.
+   */
+  void Update(const arma::mat& predictors, const arma::rowvec& responses);
+
+  /**
+   * Add the given weighted points to the statistics.
+   *
+   * @param predictors Matrix of points, one per column.
+   * @param responses The response of each point.
+   * @param weights The weight of each point.
+   */
+  void Update(const arma::mat& predictors,
+              const arma::rowvec& responses,
+              const arma::rowvec& weights);
+
+  /**
+   * Merge other statistics into these, as if the points of the other
+   * statistics had been added to these.
+   *
+   * @param other Statistics to merge.
+   */
+  RegressionStatistics& operator+=(const RegressionStatistics& other);
+
+  //! Get the dimensionality of the points (0 if there are none yet).
+  size_t Dimensionality() const { return means.n_elem; }
+  //! Get the number of points.
+  size_t Count() const { return count; }
+  //! Get the sum of the weights of the points (the number of points if no
+  //! weights were given).
+  double WeightSum() const { return weightSum; }
+
+  //! Get the weighted mean of the predictors.
+  const arma::vec& Means() const { return means; }
+  //! Get the weighted mean of the responses.
+  double ResponsesMean() const { return responsesMean; }
+
+  //! Get the weighted sum of the outer products of the centered predictors.
+  const arma::mat& Scatter() const { return scatter; }
+  //! Get the weighted sum of the centered predictors times the centered
+  //! responses.
+  const arma::vec& CrossScatter() const { return crossScatter; }
+  //! Get the weighted sum of squares of the centered responses.
+  double ResponsesScatter() const { return responsesScatter; }
+
+  //! Serialize the statistics.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(count));
+    ar(CEREAL_NVP(weightSum));
+    ar(CEREAL_NVP(means));
+    ar(CEREAL_NVP(responsesMean));
+    ar(CEREAL_NVP(scatter));
+    ar(CEREAL_NVP(crossScatter));
+    ar(CEREAL_NVP(responsesScatter));
+  }
+
+ private:
+  //! The number of points.
+  size_t count;
+  //! The sum of the weights of the points.
+  double weightSum;
+  //! The weighted mean of the predictors.
+  arma::vec means;
+  //! The weighted mean of the responses.
+  double responsesMean;
+  //! The weighted sum of outer products of the centered predictors.
+  arma::mat scatter;
+  //! The weighted sum of the centered predictors times the centered responses.
+  arma::vec crossScatter;
+  //! The weighted sum of squares of the centered responses.
+  double responsesScatter;
+
+  //! The number of points summarized by each thread at once.
+  static const size_t BlockSize = 8192;
+
+  //! Add the given points, with the given weights if there are any, to the
+  //! statistics.
+  void Update(const arma::mat& predictors,
+              const arma::rowvec& responses,
+              const arma::rowvec* weights);
+};
+
+} // namespace regression
+} // namespace mlpack
+
+#endif
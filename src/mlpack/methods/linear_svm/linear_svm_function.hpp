@@ -122,6 +122,26 @@ class LinearSVMFunction
                 GradType& gradient,
                 const size_t batchSize = 1);
 
+  /**
+   * Evaluate the gradient of the hinge loss function on the given batch,
+   * storing only the rows of the parameters that the batch touches (the rows
+   * of its nonzero features, and the intercept row) in a sparse matrix.  This
+   * is the overload used by lock-free parallel optimizers such as
+   * ens::ParallelSGD, where each thread only writes the coordinates that its
+   * gradient touches.  The L2 penalty is only applied to the touched rows, so
+   * for a batch without zero values the result is the same as the dense
+   * gradient.
+   *
+   * @param parameters The parameters of the SVM.
+   * @param firstId Index of the datapoint to use for the gradient evaluation.
+   * @param gradient Sparse matrix to output the gradient into.
+   * @param batchSize Size of the batch to process.
+   */
+  void Gradient(const arma::mat& parameters,
+                const size_t firstId,
+                arma::sp_mat& gradient,
+                const size_t batchSize = 1);
+
   /**
    * Evaluate the gradient of the hinge loss function, following
    * the LinearFunctionType requirements on the Gradient function
@@ -163,9 +183,9 @@ class LinearSVMFunction
   arma::mat& InitialPoint() { return initialPoint; }
 
   //! Get the dataset.
-  const arma::sp_mat& Dataset() const { return dataset; }
+  const MatType& Dataset() const { return dataset; }
   //! Modify the dataset.
-  arma::sp_mat& Dataset() { return dataset; }
+  MatType& Dataset() { return dataset; }
 
   //! Sets the regularization parameter.
   double& Lambda() { return lambda; }
@@ -110,36 +110,23 @@ void LinearSVMFunction<MatType>::GetGroundTruthMatrix(
 template <typename MatType>
 void LinearSVMFunction<MatType>::Shuffle()
 {
-  // Determine new ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      dataset.n_cols - 1, dataset.n_cols));
-
-  // Re-sort data.
-  arma::mat newData = dataset.cols(ordering);
+  // Recover the labels from the ground truth matrix, so that the data and the
+  // labels can be shuffled together (this also works for sparse data, which
+  // must not be densified).
+  arma::Row<size_t> labels(dataset.n_cols);
+  for (arma::sp_mat::const_iterator it = groundTruth.begin();
+       it != groundTruth.end(); ++it)
+    labels[it.col()] = it.row();
+
+  MatType newData;
+  arma::Row<size_t> newLabels;
+  math::ShuffleData(dataset, labels, newData, newLabels);
+
+  // If we are an alias, make sure we don't write to the original data.
   math::ClearAlias(dataset);
   dataset = std::move(newData);
 
-  // Assemble data for batch constructor.  We need reverse orderings though...
-  arma::uvec reverseOrdering(ordering.n_elem);
-  for (size_t i = 0; i < ordering.n_elem; ++i)
-    reverseOrdering[ordering[i]] = i;
-
-  arma::umat newLocations(2, groundTruth.n_nonzero);
-  arma::vec values(groundTruth.n_nonzero);
-  arma::sp_mat::const_iterator it = groundTruth.begin();
-  size_t loc = 0;
-  while (it != groundTruth.end())
-  {
-    newLocations(0, loc) = reverseOrdering(it.col());
-    newLocations(1, loc) = it.row();
-    values(loc) = (*it);
-
-    ++it;
-    ++loc;
-  }
-
-  groundTruth = arma::sp_mat(newLocations, values, groundTruth.n_rows,
-                             groundTruth.n_cols);
+  GetGroundTruthMatrix(newLabels, groundTruth);
 }
 
 template <typename MatType>
@@ -355,6 +342,76 @@ void LinearSVMFunction<MatType>::Gradient(
   gradient += lambda * parameters;
 }
 
+template <typename MatType>
+void LinearSVMFunction<MatType>::Gradient(
+    const arma::mat& parameters,
+    const size_t firstId,
+    arma::sp_mat& gradient,
+    const size_t batchSize)
+{
+  const size_t lastId = firstId + batchSize - 1;
+  const arma::sp_mat batch(dataset.cols(firstId, lastId));
+  const arma::mat truth(groundTruth.cols(firstId, lastId));
+
+  // Scores for each class are evaluated using only the nonzero values of the
+  // batch.
+  arma::mat scores(numClasses, batchSize);
+  if (fitIntercept)
+    scores.each_col() = arma::trans(parameters.row(dataset.n_rows));
+  else
+    scores.zeros();
+
+  for (arma::sp_mat::const_iterator it = batch.begin(); it != batch.end(); ++it)
+    scores.col(it.col()) += (*it) * arma::trans(parameters.row(it.row()));
+
+  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
+      * (scores % truth), numClasses, 1)) + delta - (delta * truth);
+
+  // For each sample, find the total number of classes where
+  // ( margin > 0 ).
+  arma::mat mask = margin.for_each([](arma::mat::elem_type& val)
+      { val = (val > 0) ? 1: 0; });
+
+  const arma::mat difference = truth
+      % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
+
+  // Each nonzero value of the batch contributes to one row of the gradient,
+  // and each point contributes to the intercept row.  Entries at the same
+  // location are summed when the sparse matrix is built.
+  const size_t numEntries = (batch.n_nonzero + (fitIntercept ? batchSize : 0))
+      * numClasses;
+  arma::umat locations(2, numEntries);
+  arma::vec values(numEntries);
+  size_t entry = 0;
+  for (arma::sp_mat::const_iterator it = batch.begin(); it != batch.end(); ++it)
+  {
+    for (size_t c = 0; c < numClasses; ++c, ++entry)
+    {
+      locations(0, entry) = it.row();
+      locations(1, entry) = c;
+      values[entry] = ((*it) * difference(c, it.col()) +
+          lambda * parameters(it.row(), c)) / batchSize;
+    }
+  }
+
+  if (fitIntercept)
+  {
+    for (size_t i = 0; i < batchSize; ++i)
+    {
+      for (size_t c = 0; c < numClasses; ++c, ++entry)
+      {
+        locations(0, entry) = dataset.n_rows;
+        locations(1, entry) = c;
+        values[entry] = (difference(c, i) +
+            lambda * parameters(dataset.n_rows, c)) / batchSize;
+      }
+    }
+  }
+
+  gradient = arma::sp_mat(true, locations, values, parameters.n_rows,
+      parameters.n_cols);
+}
+
 template <typename MatType>
 template <typename GradType>
 double LinearSVMFunction<MatType>::EvaluateWithGradient(
@@ -26,6 +26,9 @@ namespace lmnn {
  * of each data point), Impostors() (used for calculating impostors of each
  * data point) and Triplets() (Generates sets of {dataset, target neighbors,
  * impostors} tripltets.)
+ *
+ * If mlpack is compiled with OpenMP, the dual-tree neighbor searches are split
+ * into parallel tasks at depth ParallelDepth() of the query trees.
  */
 template<typename MetricType = metric::SquaredEuclideanDistance>
 class Constraints
@@ -191,6 +194,13 @@ class Constraints
   //! Modify the value of precalculated.
   bool& PreCalulated() { return precalculated; }
 
+  //! Get the depth of the query trees at which the neighbor searches are split
+  //! into parallel tasks (0 means they are not split).
+  size_t ParallelDepth() const { return parallelDepth; }
+  //! Modify the depth of the query trees at which the neighbor searches are
+  //! split into parallel tasks.
+  size_t& ParallelDepth() { return parallelDepth; }
+
  private:
   //! Number of target neighbors & impostors to calulate.
   size_t k;
@@ -207,6 +217,10 @@ class Constraints
   //! False if nothing has ever been precalculated.
   bool precalculated;
 
+  //! The depth of the query trees at which the neighbor searches are split
+  //! into parallel tasks.
+  size_t parallelDepth;
+
   /**
   * Precalculate the unique labels, and indices of similar
   * and different datapoints on the basis of labels.
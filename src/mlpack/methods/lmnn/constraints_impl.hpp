@@ -24,7 +24,8 @@ Constraints<MetricType>::Constraints(
     const arma::Row<size_t>& labels,
     const size_t k) :
     k(k),
-    precalculated(false)
+    precalculated(false),
+    parallelDepth(4)
 {
   // Ensure a valid k is passed.
   size_t minCount = arma::min(arma::histc(labels, arma::unique(labels)));
@@ -89,6 +90,7 @@ void Constraints<MetricType>::TargetNeighbors(arma::Mat<size_t>& outputMatrix,
 
   // KNN instance.
   KNN knn;
+  knn.ParallelDepth() = parallelDepth;
 
   arma::Mat<size_t> neighbors;
   arma::mat distances;
@@ -131,6 +133,7 @@ void Constraints<MetricType>::TargetNeighbors(arma::Mat<size_t>& outputMatrix,
 
   // KNN instance.
   KNN knn;
+  knn.ParallelDepth() = parallelDepth;
 
   arma::Mat<size_t> neighbors;
   arma::mat distances;
@@ -173,6 +176,7 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputMatrix,
 
   // KNN instance.
   KNN knn;
+  knn.ParallelDepth() = parallelDepth;
 
   arma::Mat<size_t> neighbors;
   arma::mat distances;
@@ -211,6 +215,7 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputNeighbors,
 
   // KNN instance.
   KNN knn;
+  knn.ParallelDepth() = parallelDepth;
 
   arma::Mat<size_t> neighbors;
   arma::mat distances;
@@ -254,6 +259,7 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputMatrix,
 
   // KNN instance.
   KNN knn;
+  knn.ParallelDepth() = parallelDepth;
 
   arma::Mat<size_t> neighbors;
   arma::mat distances;
@@ -303,6 +309,7 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputNeighbors,
 
   // KNN instance.
   KNN knn;
+  knn.ParallelDepth() = parallelDepth;
 
   arma::Mat<size_t> neighbors;
   arma::mat distances;
@@ -350,6 +357,7 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputNeighbors,
 
   // KNN instance.
   KNN knn;
+  knn.ParallelDepth() = parallelDepth;
 
   arma::Mat<size_t> neighbors;
   arma::mat distances;
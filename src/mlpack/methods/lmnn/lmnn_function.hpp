@@ -246,6 +246,22 @@ class LMNNFunction
   inline void UpdateCache(const arma::mat& transformation,
                           const size_t begin,
                           const size_t batchSize);
+  /**
+   * Add to the given matrix the outer products of the differences between each
+   * point in [begin, begin + weights.n_cols) and its neighbors, each weighted by
+   * the corresponding element of weights.  The products for each row of
+   * neighbors are computed with a single matrix multiplication.
+   *
+   * @param outerProducts Matrix to add the weighted outer products to.
+   * @param neighbors Neighbors of each point; only the first weights.n_rows
+   *     rows are used.
+   * @param weights Weight of each neighbor of each point in the range.
+   * @param begin Index of the first point.
+   */
+  inline void AddOuterProducts(arma::mat& outerProducts,
+                               const arma::Mat<size_t>& neighbors,
+                               const arma::mat& weights,
+                               const size_t begin) const;
   //! Calculate norm of change in transformation.
   inline void TransDiff(std::map<size_t, double>& transformationDiffs,
                         const arma::mat& transformation,
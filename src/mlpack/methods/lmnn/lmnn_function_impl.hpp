@@ -257,7 +257,8 @@ double LMNNFunction<MetricType>::Evaluate(const arma::mat& transformation)
     constraint.Impostors(impostors, distance, transformedDataset, labels, norm);
   }
 
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  #pragma omp parallel for schedule(dynamic, 64) reduction(+: cost)
+  for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
   {
     for (size_t j = 0; j < k ; ++j)
     {
@@ -384,7 +385,8 @@ double LMNNFunction<MetricType>::Evaluate(const arma::mat& transformation,
         norm, begin, batchSize);
   }
 
-  for (size_t i = begin; i < begin + batchSize; ++i)
+  #pragma omp parallel for schedule(dynamic, 64) reduction(+: cost)
+  for (omp_size_t i = begin; i < (omp_size_t) (begin + batchSize); ++i)
   {
     for (size_t j = 0; j < k ; ++j)
     {
@@ -411,7 +413,7 @@ double LMNNFunction<MetricType>::Evaluate(const arma::mat& transformation,
           maxImpNorm(l, i) = std::max(maxImpNorm(l, i), norm(impostors(l, i)));
 
           eval = evalOld(l, j, i) +
-              transformationDiffs[lastTransformationIndices[i]] *
+              transformationDiffs.at(lastTransformationIndices[i]) *
               (norm(targetNeighbors(j, i)) + maxImpNorm(l, i) + 2 * norm(i));
         }
 
@@ -452,6 +454,7 @@ double LMNNFunction<MetricType>::Evaluate(const arma::mat& transformation,
           // update bound.
           evalOld(l, j, i) = 0;
           maxImpNorm(l, i) = 0;
+          #pragma omp atomic
           --oldTransformationCounts[lastTransformationIndices(i)];
           lastTransformationIndices(i) = 0;
         }
@@ -517,10 +520,13 @@ void LMNNFunction<MetricType>::Gradient(const arma::mat& transformation,
   // Calculate gradient due to target neighbors.
   arma::mat cij = pCij;
 
-  // Calculate gradient due to impostors.
-  arma::mat cil = arma::zeros(dataset.n_rows, dataset.n_rows);
+  // Count the triplets that each target neighbor and each impostor of each
+  // point is part of; the gradient due to impostors is computed from these.
+  arma::mat targetWeights(k, dataset.n_cols, arma::fill::zeros);
+  arma::mat impostorWeights(k, dataset.n_cols, arma::fill::zeros);
 
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
   {
     for (int j = k - 1; j >= 0; j--)
     {
@@ -580,15 +586,17 @@ void LMNNFunction<MetricType>::Gradient(const arma::mat& transformation,
         }
 
         // Caculate gradient due to impostors.
-        arma::vec diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
-        cil += diff * arma::trans(diff);
-
-        diff = dataset.col(i) - dataset.col(impostors(l, i));
-        cil -= diff * arma::trans(diff);
+        targetWeights(j, i) += 1;
+        impostorWeights(l, i) += 1;
       }
     }
   }
 
+  // Calculate gradient due to impostors.
+  arma::mat cil = arma::zeros(dataset.n_rows, dataset.n_rows);
+  AddOuterProducts(cil, targetNeighbors, targetWeights, 0);
+  AddOuterProducts(cil, impostors, -impostorWeights, 0);
+
   gradient = 2 * transformation * ((1 - regularization) * cij +
       regularization * cil);
 
@@ -646,18 +654,14 @@ void LMNNFunction<MetricType>::Gradient(const arma::mat& transformation,
 
   gradient.zeros(transformation.n_rows, transformation.n_cols);
 
-  arma::mat cij = arma::zeros(dataset.n_rows, dataset.n_rows);
-  arma::mat cil = arma::zeros(dataset.n_rows, dataset.n_rows);
+  // Count the triplets that each target neighbor and each impostor of each
+  // point is part of; the gradient due to impostors is computed from these.
+  arma::mat targetWeights(k, batchSize, arma::fill::zeros);
+  arma::mat impostorWeights(k, batchSize, arma::fill::zeros);
 
-  for (size_t i = begin; i < begin + batchSize; ++i)
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (omp_size_t i = begin; i < (omp_size_t) (begin + batchSize); ++i)
   {
-    for (size_t j = 0; j < k ; ++j)
-    {
-      // Calculate gradient due to target neighbors.
-      arma::vec diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
-      cij += diff * arma::trans(diff);
-    }
-
     for (int j = k - 1; j >= 0; j--)
     {
       // Bound constraints to avoid uneccesary computation.
@@ -674,7 +678,7 @@ void LMNNFunction<MetricType>::Gradient(const arma::mat& transformation,
           maxImpNorm(l, i) = std::max(maxImpNorm(l, i), norm(impostors(l, i)));
 
           eval = evalOld(l, j, i) +
-              transformationDiffs[lastTransformationIndices[i]] *
+              transformationDiffs.at(lastTransformationIndices[i]) *
               (norm(targetNeighbors(j, i)) + maxImpNorm(l, i) + 2 * norm(i));
         }
 
@@ -713,20 +717,28 @@ void LMNNFunction<MetricType>::Gradient(const arma::mat& transformation,
           // update bound.
           evalOld(l, j, i) = 0;
           maxImpNorm(l, i) = 0;
+          #pragma omp atomic
           --oldTransformationCounts[lastTransformationIndices(i)];
           lastTransformationIndices(i) = 0;
         }
 
         // Caculate gradient due to impostors.
-        arma::vec diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
-        cil += diff * arma::trans(diff);
-
-        diff = dataset.col(i) - dataset.col(impostors(l, i));
-        cil -= diff * arma::trans(diff);
+        targetWeights(j, i - begin) += 1;
+        impostorWeights(l, i - begin) += 1;
       }
     }
   }
 
+  // Calculate gradient due to target neighbors.
+  arma::mat cij = arma::zeros(dataset.n_rows, dataset.n_rows);
+  AddOuterProducts(cij, targetNeighbors, arma::ones<arma::mat>(k, batchSize),
+      begin);
+
+  // Calculate gradient due to impostors.
+  arma::mat cil = arma::zeros(dataset.n_rows, dataset.n_rows);
+  AddOuterProducts(cil, targetNeighbors, targetWeights, begin);
+  AddOuterProducts(cil, impostors, -impostorWeights, begin);
+
   gradient = 2 * transformation * ((1 - regularization) * cij +
       regularization * cil);
 
@@ -792,10 +804,13 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
   // Calculate gradient due to target neighbors.
   arma::mat cij = pCij;
 
-  // Calculate gradient due to impostors.
-  arma::mat cil = arma::zeros(dataset.n_rows, dataset.n_rows);
+  // Count the triplets that each target neighbor and each impostor of each
+  // point is part of; the gradient due to impostors is computed from these.
+  arma::mat targetWeights(k, dataset.n_cols, arma::fill::zeros);
+  arma::mat impostorWeights(k, dataset.n_cols, arma::fill::zeros);
 
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  #pragma omp parallel for schedule(dynamic, 64) reduction(+: cost)
+  for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
   {
     for (size_t j = 0; j < k ; ++j)
     {
@@ -857,15 +872,17 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
         cost += regularization * (1 + eval);
 
         // Caculate gradient due to impostors.
-        arma::vec diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
-        cil += diff * arma::trans(diff);
-
-        diff = dataset.col(i) - dataset.col(impostors(l, i));
-        cil -= diff * arma::trans(diff);
+        targetWeights(j, i) += 1;
+        impostorWeights(l, i) += 1;
       }
     }
   }
 
+  // Calculate gradient due to impostors.
+  arma::mat cil = arma::zeros(dataset.n_rows, dataset.n_rows);
+  AddOuterProducts(cil, targetNeighbors, targetWeights, 0);
+  AddOuterProducts(cil, impostors, -impostorWeights, 0);
+
   gradient = 2 * transformation * ((1 - regularization) * cij +
       regularization * cil);
 
@@ -928,10 +945,13 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
 
   gradient.zeros(transformation.n_rows, transformation.n_cols);
 
-  arma::mat cij = arma::zeros(dataset.n_rows, dataset.n_rows);
-  arma::mat cil = arma::zeros(dataset.n_rows, dataset.n_rows);
+  // Count the triplets that each target neighbor and each impostor of each
+  // point is part of; the gradient due to impostors is computed from these.
+  arma::mat targetWeights(k, batchSize, arma::fill::zeros);
+  arma::mat impostorWeights(k, batchSize, arma::fill::zeros);
 
-  for (size_t i = begin; i < begin + batchSize; ++i)
+  #pragma omp parallel for schedule(dynamic, 64) reduction(+: cost)
+  for (omp_size_t i = begin; i < (omp_size_t) (begin + batchSize); ++i)
   {
     for (size_t j = 0; j < k ; ++j)
     {
@@ -939,10 +959,6 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
       double eval = metric.Evaluate(transformedDataset.col(i),
                         transformedDataset.col(targetNeighbors(j, i)));
       cost += (1 - regularization) * eval;
-
-      // Calculate gradient due to target neighbors.
-      arma::vec diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
-      cij += diff * arma::trans(diff);
     }
 
     for (int j = k - 1; j >= 0; j--)
@@ -961,7 +977,7 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
           maxImpNorm(l, i) = std::max(maxImpNorm(l, i), norm(impostors(l, i)));
 
           eval = evalOld(l, j, i) +
-              transformationDiffs[lastTransformationIndices[i]] *
+              transformationDiffs.at(lastTransformationIndices[i]) *
               (norm(targetNeighbors(j, i)) + maxImpNorm(l, i) + 2 * norm(i));
         }
 
@@ -997,15 +1013,22 @@ double LMNNFunction<MetricType>::EvaluateWithGradient(
         cost += regularization * (1 + eval);
 
         // Caculate gradient due to impostors.
-        arma::vec diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
-        cil += diff * arma::trans(diff);
-
-        diff = dataset.col(i) - dataset.col(impostors(l, i));
-        cil -= diff * arma::trans(diff);
+        targetWeights(j, i - begin) += 1;
+        impostorWeights(l, i - begin) += 1;
       }
     }
   }
 
+  // Calculate gradient due to target neighbors.
+  arma::mat cij = arma::zeros(dataset.n_rows, dataset.n_rows);
+  AddOuterProducts(cij, targetNeighbors, arma::ones<arma::mat>(k, batchSize),
+      begin);
+
+  // Calculate gradient due to impostors.
+  arma::mat cil = arma::zeros(dataset.n_rows, dataset.n_rows);
+  AddOuterProducts(cil, targetNeighbors, targetWeights, begin);
+  AddOuterProducts(cil, impostors, -impostorWeights, begin);
+
   gradient = 2 * transformation * ((1 - regularization) * cij +
       regularization * cil);
 
@@ -1020,14 +1043,32 @@ inline void LMNNFunction<MetricType>::Precalculate()
 {
   pCij.zeros(dataset.n_rows, dataset.n_rows);
 
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  // Calculate gradient due to target neighbors.
+  AddOuterProducts(pCij, targetNeighbors,
+      arma::ones<arma::mat>(k, dataset.n_cols), 0);
+}
+
+template<typename MetricType>
+inline void LMNNFunction<MetricType>::AddOuterProducts(
+    arma::mat& outerProducts,
+    const arma::Mat<size_t>& neighbors,
+    const arma::mat& weights,
+    const size_t begin) const
+{
+  if (weights.n_cols == 0)
+    return;
+
+  const size_t end = begin + weights.n_cols - 1;
+  for (size_t j = 0; j < weights.n_rows; ++j)
   {
-    for (size_t j = 0; j < k ; ++j)
-    {
-      // Calculate gradient due to target neighbors.
-      arma::vec diff = dataset.col(i) - dataset.col(targetNeighbors(j, i));
-      pCij += diff * arma::trans(diff);
-    }
+    // Skip neighbors that are not part of any triplet.
+    if (!arma::any(weights.row(j)))
+      continue;
+
+    const arma::uvec indices = arma::conv_to<arma::uvec>::from(
+        neighbors.submat(j, begin, j, end));
+    const arma::mat diff = dataset.cols(begin, end) - dataset.cols(indices);
+    outerProducts += (diff.each_row() % weights.row(j)) * diff.t();
   }
 }
 
@@ -35,190 +35,133 @@ void LocalCoordinateCoding::Encode(const arma::mat& data, arma::mat& codes)
       * data);
 
   arma::mat dictGram = trans(dictionary) * dictionary;
-  arma::mat dictGramTD(dictGram.n_rows, dictGram.n_cols);
 
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
-  {
-    // Report progress.
-    if ((i % 100) == 0)
-    {
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
-    }
-
-    arma::vec invW = invSqDists.unsafe_col(i);
-    arma::mat dictPrime = dictionary * diagmat(invW);
-
-    arma::mat dictGramTD = diagmat(invW) * dictGram * diagmat(invW);
-
-    bool useCholesky = false;
-    regression::LARS lars(useCholesky, dictGramTD, 0.5 * lambda);
-
-    // Run LARS for this point, by making an alias of the point and passing
-    // that.
-    arma::vec beta = codes.unsafe_col(i);
-    arma::rowvec responses = data.unsafe_col(i).t();
-    lars.Train(dictPrime, responses, beta, false);
-    beta %= invW; // Remember, beta is an alias of codes.col(i).
-  }
-}
+  Log::Debug << "Encoding " << data.n_cols << " points." << std::endl;
 
-void LocalCoordinateCoding::OptimizeDictionary(const arma::mat& data,
-                                               const arma::mat& codes,
-                                               const arma::uvec& adjacencies)
-{
-  // Count number of atomic neighbors for each point x^i.
-  arma::uvec neighborCounts = arma::zeros<arma::uvec>(data.n_cols, 1);
-  if (adjacencies.n_elem > 0)
+  // Each point is encoded independently, so the points are split among the
+  // threads.  Each thread keeps its own weighted dictionary, weighted Gram
+  // matrix, and LARS object as workspace; the LARS object holds a reference to
+  // the weighted Gram matrix, which is overwritten in place for each point.
+  #pragma omp parallel
   {
-    // This gets the column index.  Intentional integer division.
-    size_t curPointInd = (size_t) (adjacencies(0) / atoms);
-    ++neighborCounts(curPointInd);
+    arma::mat dictPrime(dictionary.n_rows, dictionary.n_cols);
+    arma::mat dictGramTD(dictGram.n_rows, dictGram.n_cols);
 
-    size_t nextColIndex = (curPointInd + 1) * atoms;
-    for (size_t l = 1; l < adjacencies.n_elem; l++)
-    {
-      // If l no longer refers to an element in this column, advance the column
-      // number accordingly.
-      if (adjacencies(l) >= nextColIndex)
-      {
-        curPointInd = (size_t) (adjacencies(l) / atoms);
-        nextColIndex = (curPointInd + 1) * atoms;
-      }
-
-      ++neighborCounts(curPointInd);
-    }
-  }
-
-  // Build dataPrime := [X x^1 ... x^1 ... x^n ... x^n]
-  // where each x^i is repeated for the number of neighbors x^i has.
-  arma::mat dataPrime = arma::zeros(data.n_rows,
-      data.n_cols + adjacencies.n_elem);
-
-  dataPrime(arma::span::all, arma::span(0, data.n_cols - 1)) = data;
+    const bool useCholesky = false;
+    regression::LARS lars(useCholesky, dictGramTD, 0.5 * lambda);
 
-  size_t curCol = data.n_cols;
-  for (size_t i = 0; i < data.n_cols; ++i)
-  {
-    if (neighborCounts(i) > 0)
+    #pragma omp for schedule(dynamic, 16)
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
     {
-      dataPrime(arma::span::all, arma::span(curCol, curCol + neighborCounts(i)
-          - 1)) = repmat(data.col(i), 1, neighborCounts(i));
+      arma::vec invW = invSqDists.unsafe_col(i);
+      dictPrime = dictionary * diagmat(invW);
+      dictGramTD = dictGram % (invW * trans(invW));
+
+      // Run LARS for this point, by making an alias of the point and passing
+      // that.
+      arma::vec beta = codes.unsafe_col(i);
+      arma::rowvec responses = data.unsafe_col(i).t();
+      lars.Train(dictPrime, responses, beta, false);
+      beta %= invW; // Remember, beta is an alias of codes.col(i).
     }
-    curCol += neighborCounts(i);
   }
+}
 
+void LocalCoordinateCoding::OptimizeDictionary(
+    const arma::mat& data,
+    const arma::mat& codes,
+    const arma::uvec& /* adjacencies */)
+{
   // Handle the case of inactive atoms (atoms not used in the given coding).
   std::vector<size_t> inactiveAtoms;
+  std::vector<arma::uword> activeAtoms;
   for (size_t j = 0; j < atoms; ++j)
+  {
     if (accu(codes.row(j) != 0) == 0)
       inactiveAtoms.push_back(j);
+    else
+      activeAtoms.push_back(j);
+  }
 
   const size_t nInactiveAtoms = inactiveAtoms.size();
-  const size_t nActiveAtoms = atoms - nInactiveAtoms;
-
-  // Efficient construction of codes restricted to active atoms.
-  arma::mat codesPrime = arma::zeros(nActiveAtoms, data.n_cols +
-      adjacencies.n_elem);
-  arma::vec wSquared = arma::ones(data.n_cols + adjacencies.n_elem, 1);
+  const size_t nActiveAtoms = activeAtoms.size();
 
   if (nInactiveAtoms > 0)
   {
     Log::Warn << "There are " << nInactiveAtoms
         << " inactive atoms.  They will be re-initialized randomly.\n";
+  }
 
-    // Create matrix holding only active codes.
-    arma::mat activeCodes;
-    math::RemoveRows(codes, inactiveAtoms, activeCodes);
-
-    // Create reverse atom lookup for active atoms.
-    arma::uvec atomReverseLookup(atoms);
-    size_t inactiveOffset = 0;
-    for (size_t i = 0; i < atoms; ++i)
-    {
-      if (inactiveAtoms[inactiveOffset] == i)
-        ++inactiveOffset;
-      else
-        atomReverseLookup(i - inactiveOffset) = i;
-    }
-
-    codesPrime(arma::span::all, arma::span(0, data.n_cols - 1)) = activeCodes;
+  // The dictionary step is a weighted least squares problem: each point x^i
+  // is fit by D z^i with weight 1, and each nonzero code z_j^i pulls atom d_j
+  // towards x^i with weight lambda |z_j^i| (these are the nonzero entries of
+  // the codes, given by the adjacencies).  With Z the codes of the active
+  // atoms, its normal equations A D^T = B are
+  //
+  //   A = Z Z^T + diag(lambda |Z| 1),  B = (Z + lambda |Z|) X^T,
+  //
+  // which are accumulated over blocks of points in parallel, so the repeated
+  // points and weights never need to be formed.
+  const arma::uvec active(activeAtoms);
+  const arma::mat activeCodes = codes.rows(active);
+
+  arma::mat A(nActiveAtoms, nActiveAtoms, arma::fill::zeros);
+  arma::mat B(nActiveAtoms, data.n_rows, arma::fill::zeros);
+
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+  #pragma omp parallel
+  {
+    arma::mat localA(nActiveAtoms, nActiveAtoms, arma::fill::zeros);
+    arma::mat localB(nActiveAtoms, data.n_rows, arma::fill::zeros);
 
-    // Fill the rest of codesPrime.
-    for (size_t l = 0; l < adjacencies.n_elem; ++l)
+    #pragma omp for schedule(static)
+    for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
     {
-      // Recover the location in the codes matrix that this adjacency refers to.
-      size_t atomInd = adjacencies(l) % atoms;
-      size_t pointInd = (size_t) (adjacencies(l) / atoms);
+      const size_t begin = b * blockSize;
+      const size_t end = std::min(begin + blockSize, (size_t) data.n_cols) - 1;
 
-      // Fill matrix.
-      codesPrime(atomReverseLookup(atomInd), data.n_cols + l) = 1.0;
-      wSquared(data.n_cols + l) = codes(atomInd, pointInd);
+      const arma::mat blockCodes = activeCodes.cols(begin, end);
+      localA += blockCodes * trans(blockCodes);
+      localB += (blockCodes + lambda * abs(blockCodes)) *
+          trans(data.cols(begin, end));
     }
-  }
-  else
-  {
-    // All atoms are active.
-    codesPrime(arma::span::all, arma::span(0, data.n_cols - 1)) = codes;
 
-    for (size_t l = 0; l < adjacencies.n_elem; ++l)
+    #pragma omp critical
     {
-      // Recover the location in the codes matrix that this adjacency refers to.
-      size_t atomInd = adjacencies(l) % atoms;
-      size_t pointInd = (size_t) (adjacencies(l) / atoms);
-
-      // Fill matrix.
-      codesPrime(atomInd, data.n_cols + l) = 1.0;
-      wSquared(data.n_cols + l) = codes(atomInd, pointInd);
+      A += localA;
+      B += localB;
     }
   }
 
-  wSquared.subvec(data.n_cols, wSquared.n_elem - 1) = lambda *
-      abs(wSquared.subvec(data.n_cols, wSquared.n_elem - 1));
+  A.diag() += lambda * sum(abs(activeCodes), 1);
 
   // Solve system.
+  arma::mat dictionaryActive;
+  if (nActiveAtoms > 0)
+    dictionaryActive = trans(solve(A, B));
+
   if (nInactiveAtoms == 0)
   {
-    // No inactive atoms.  We can solve directly.
-    arma::mat A = codesPrime * diagmat(wSquared) * trans(codesPrime);
-    arma::mat B = codesPrime * diagmat(wSquared) * trans(dataPrime);
-
-    dictionary = trans(solve(A, B));
-    /*
-    dictionary = trans(solve(codesPrime * diagmat(wSquared) * trans(codesPrime),
-        codesPrime * diagmat(wSquared) * trans(dataPrime)));
-    */
+    // No inactive atoms.  The solution is the entire dictionary.
+    dictionary = dictionaryActive;
   }
   else
   {
-    // Inactive atoms must be reinitialized randomly, so we cannot solve
-    // directly for the entire dictionary estimate.
-    arma::mat dictionaryActive =
-      trans(solve(codesPrime * diagmat(wSquared) * trans(codesPrime),
-                  codesPrime * diagmat(wSquared) * trans(dataPrime)));
-
-    // Update all atoms.
-    size_t currentInactiveIndex = 0;
-    for (size_t i = 0; i < atoms; ++i)
+    // Inactive atoms must be reinitialized randomly.
+    for (size_t i = 0; i < nActiveAtoms; ++i)
+      dictionary.col(activeAtoms[i]) = dictionaryActive.col(i);
+
+    for (size_t i = 0; i < nInactiveAtoms; ++i)
     {
-      if (inactiveAtoms[currentInactiveIndex] == i)
-      {
-        // This atom is inactive.  Reinitialize it randomly.
-        dictionary.col(i) = (data.col(math::RandInt(data.n_cols)) +
-                             data.col(math::RandInt(data.n_cols)) +
-                             data.col(math::RandInt(data.n_cols)));
-
-        // Now normalize the atom.
-        dictionary.col(i) /= norm(dictionary.col(i), 2);
-
-        // Increment inactive atom counter.
-        ++currentInactiveIndex;
-      }
-      else
-      {
-        // Update estimate.
-        dictionary.col(i) = dictionaryActive.col(i - currentInactiveIndex);
-      }
+      const size_t atom = inactiveAtoms[i];
+      dictionary.col(atom) = (data.col(math::RandInt(data.n_cols)) +
+                              data.col(math::RandInt(data.n_cols)) +
+                              data.col(math::RandInt(data.n_cols)));
+
+      // Now normalize the atom.
+      dictionary.col(atom) /= norm(dictionary.col(atom), 2);
     }
   }
 }
@@ -145,7 +145,8 @@ class LocalCoordinateCoding
                    DictionaryInitializer());
 
   /**
-   * Code each point via distance-weighted LARS.
+   * Code each point via distance-weighted LARS.  The points are encoded in
+   * parallel.
    *
    * @param data Matrix containing points to encode.
    * @param codes Output matrix to store codes in.
@@ -153,13 +154,15 @@ class LocalCoordinateCoding
   void Encode(const arma::mat& data, arma::mat& codes);
 
   /**
-   * Learn dictionary by solving linear system.
+   * Learn dictionary by solving linear system.  The normal equations are
+   * accumulated over blocks of points in parallel.
    *
    * @param data Matrix containing points to encode.
    * @param codes Output matrix to store codes in.
    * @param adjacencies Indices of entries (unrolled column by column) of
    *    the coding matrix Z that are non-zero (the adjacency matrix for the
-   *    bipartite graph of points and atoms)
+   *    bipartite graph of points and atoms); these are implied by the codes,
+   *    and are not used.
    */
   void OptimizeDictionary(const arma::mat& data,
                           const arma::mat& codes,
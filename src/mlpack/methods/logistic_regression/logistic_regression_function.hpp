@@ -52,8 +52,11 @@ class LogisticRegressionFunction
   const arma::Row<size_t>& Responses() const { return responses; }
 
   /**
-  * Shuffle the order of function visitation.  This may be called by the optimizer.
-  */
+   * Shuffle the order of function visitation.  This may be called by the
+   * optimizer.  The data is not moved: the batches of the separable functions
+   * are gathered through the shuffled order, and are the same as if the data
+   * itself had been shuffled with math::ShuffleData().
+   */
   void Shuffle();
 
   /**
@@ -118,6 +121,28 @@ class LogisticRegressionFunction
                 GradType& gradient,
                 const size_t batchSize = 1) const;
 
+  /**
+   * Evaluate the gradient of the logistic regression log-likelihood function
+   * for the given batch, storing only the coordinates that the batch touches
+   * (the intercept and the nonzero features of the batch) in a sparse matrix.
+   * This is the overload used by lock-free parallel optimizers such as
+   * ens::ParallelSGD, where each thread only writes the coordinates that its
+   * gradient touches.  The L2 penalty is only applied to the touched
+   * coordinates, so for a batch without zero values the result is the same as
+   * the dense gradient.
+   *
+   * @param parameters Vector of logistic regression parameters.
+   * @param begin Index of the starting point to use for objective function
+   *     gradient evaluation.
+   * @param gradient Sparse matrix to output gradient into.
+   * @param batchSize Number of points to be processed as a batch for objective
+   *     function gradient evaluation.
+   */
+  void Gradient(const arma::mat& parameters,
+                const size_t begin,
+                arma::sp_mat& gradient,
+                const size_t batchSize = 1) const;
+
   /**
    * Evaluate the gradient of the logistic regression log-likelihood function
    * with the given parameters, and with respect to only one feature in the
@@ -159,12 +184,15 @@ class LogisticRegressionFunction
   size_t NumFeatures() const { return predictors.n_rows + 1; }
 
  private:
-  //! The matrix of data points (predictors).  This is an alias until shuffling
-  //! is done.
+  //! The matrix of data points (predictors).  This may be an alias of the
+  //! given data.
   MatType predictors;
-  //! The vector of responses to the input data points.  This is an alias until
-  //! shuffling is done.
+  //! The vector of responses to the input data points.  This may be an alias
+  //! of the given responses.
   arma::Row<size_t> responses;
+  //! The order in which the points are visited; empty until Shuffle() is
+  //! called.
+  arma::uvec ordering;
   //! The regularization parameter for L2-regularization.
   double lambda;
 };
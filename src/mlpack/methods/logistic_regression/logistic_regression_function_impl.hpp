@@ -47,18 +47,9 @@ LogisticRegressionFunction<MatType>::LogisticRegressionFunction(
 template<typename MatType>
 void LogisticRegressionFunction<MatType>::Shuffle()
 {
-  MatType newPredictors;
-  arma::Row<size_t> newResponses;
-
-  math::ShuffleData(predictors, responses, newPredictors, newResponses);
-
-  // If we are an alias, make sure we don't write to the original data.
-  math::ClearAlias(predictors);
-  math::ClearAlias(responses);
-
-  // Take ownership of the new data.
-  predictors = std::move(newPredictors);
-  responses = std::move(newResponses);
+  // Only the visitation order is shuffled; the batches are gathered through
+  // it when they are used.
+  math::ShuffleOrder(predictors, ordering);
 }
 
 /**
@@ -120,11 +111,11 @@ double LogisticRegressionFunction<MatType>::Evaluate(
   // Calculate the sigmoid function values.
   const arma::rowvec sigmoid = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
       parameters.tail_cols(parameters.n_elem - 1) *
-      predictors.cols(begin, begin + batchSize - 1))));
+      math::GatherColumns(predictors, ordering, begin, batchSize))));
 
   // Compute the objective for the given batch size from a given point.
-  arma::rowvec respD = arma::conv_to<arma::rowvec>::from(responses.subvec(begin,
-      begin + batchSize - 1));
+  arma::rowvec respD = arma::conv_to<arma::rowvec>::from(
+      math::GatherColumns(responses, ordering, begin, batchSize));
   const double result = arma::accu(arma::log(1.0 - respD + sigmoid %
       (2 * respD - 1.0)));
 
@@ -166,18 +157,63 @@ void LogisticRegressionFunction<MatType>::Gradient(
   regularization = lambda * parameters.tail_cols(parameters.n_elem - 1)
       / predictors.n_cols * batchSize;
 
+  const MatType batch = math::GatherColumns(predictors, ordering, begin,
+      batchSize);
+  const arma::Row<size_t> batchResponses = math::GatherColumns(responses,
+      ordering, begin, batchSize);
+
   const arma::rowvec exponents = parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) *
-      predictors.cols(begin, begin + batchSize - 1);
+      parameters.tail_cols(parameters.n_elem - 1) * batch;
   // Calculating the sigmoid function values.
   const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-exponents));
 
   gradient.set_size(parameters.n_rows, parameters.n_cols);
-  gradient[0] = -arma::accu(responses.subvec(begin, begin + batchSize - 1) -
-      sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids -
-      responses.subvec(begin, begin + batchSize - 1)) *
-      predictors.cols(begin, begin + batchSize - 1).t() + regularization;
+  gradient[0] = -arma::accu(batchResponses - sigmoids);
+  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - batchResponses) *
+      batch.t() + regularization;
+}
+
+//! Evaluate the sparse gradient of the logistic regression objective function
+//! for a given batch size.
+template<typename MatType>
+void LogisticRegressionFunction<MatType>::Gradient(
+                const arma::mat& parameters,
+                const size_t begin,
+                arma::sp_mat& gradient,
+                const size_t batchSize) const
+{
+  const arma::sp_mat batch(math::GatherColumns(predictors, ordering, begin,
+      batchSize));
+
+  // Calculate the sigmoid function values using only the nonzero values of
+  // the batch.
+  arma::rowvec exponents(batchSize);
+  exponents.fill(parameters(0, 0));
+  for (arma::sp_mat::const_iterator it = batch.begin(); it != batch.end(); ++it)
+    exponents[it.col()] += parameters[it.row() + 1] * (*it);
+
+  const arma::rowvec diffs = 1.0 / (1.0 + arma::exp(-exponents)) -
+      arma::conv_to<arma::rowvec>::from(math::GatherColumns(responses,
+      ordering, begin, batchSize));
+
+  // The first entry is the intercept, and each nonzero value of the batch
+  // contributes to the coordinate of its feature.  Entries at the same
+  // location are summed when the sparse matrix is built.
+  arma::umat locations(2, batch.n_nonzero + 1, arma::fill::zeros);
+  arma::vec values(batch.n_nonzero + 1);
+  values[0] = arma::accu(diffs);
+  size_t entry = 1;
+  for (arma::sp_mat::const_iterator it = batch.begin(); it != batch.end();
+       ++it, ++entry)
+  {
+    const size_t feature = it.row() + 1;
+    locations(1, entry) = feature;
+    values[entry] = (*it) * diffs[it.col()] +
+        lambda * parameters[feature] / predictors.n_cols;
+  }
+
+  gradient = arma::sp_mat(true, locations, values, parameters.n_rows,
+      parameters.n_cols);
 }
 
 /**
@@ -256,21 +292,22 @@ double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
       arma::dot(parameters.tail_cols(parameters.n_elem - 1),
                 parameters.tail_cols(parameters.n_elem - 1));
 
+  const MatType batch = math::GatherColumns(predictors, ordering, begin,
+      batchSize);
+  const arma::Row<size_t> batchResponses = math::GatherColumns(responses,
+      ordering, begin, batchSize);
+
   // Calculate the sigmoid function values.
   const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
-      parameters.tail_cols(parameters.n_elem - 1) *
-      predictors.cols(begin, begin + batchSize - 1))));
+      parameters.tail_cols(parameters.n_elem - 1) * batch)));
 
   gradient.set_size(parameters.n_rows, parameters.n_cols);
-  gradient[0] = -arma::accu(responses.subvec(begin, begin + batchSize - 1) -
-      sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids -
-      responses.subvec(begin, begin + batchSize - 1)) *
-      predictors.cols(begin, begin + batchSize - 1).t() + regularization;
+  gradient[0] = -arma::accu(batchResponses - sigmoids);
+  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - batchResponses) *
+      batch.t() + regularization;
 
   // Now compute the objective function using the sigmoids.
-  arma::rowvec respD = arma::conv_to<arma::rowvec>::from(responses.subvec(begin,
-      begin + batchSize - 1));
+  arma::rowvec respD = arma::conv_to<arma::rowvec>::from(batchResponses);
   const double result = arma::accu(arma::log(1.0 - respD + sigmoids %
       (2 * respD - 1.0)));
 
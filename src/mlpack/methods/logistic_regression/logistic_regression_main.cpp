@@ -61,12 +61,14 @@ BINDING_LONG_DESC(
     PRINT_PARAM_STRING("lambda") + " option, and the "
     "optimizer used to train the model can be specified with the " +
     PRINT_PARAM_STRING("optimizer") + " parameter.  Available options are "
-    "'sgd' (stochastic gradient descent) and 'lbfgs' (the L-BFGS optimizer).  "
+    "'sgd' (stochastic gradient descent), 'psgd' (lock-free parallel "
+    "stochastic gradient descent, which is well suited to sparse, "
+    "high-dimensional data), and 'lbfgs' (the L-BFGS optimizer).  "
     "There are also various parameters for the optimizer; the " +
     PRINT_PARAM_STRING("max_iterations") + " parameter specifies the maximum "
     "number of allowed iterations, and the " +
     PRINT_PARAM_STRING("tolerance") + " parameter specifies the tolerance for "
-    "convergence.  For the SGD optimizer, the " +
+    "convergence.  For the SGD and parallel SGD optimizers, the " +
     PRINT_PARAM_STRING("step_size") + " parameter controls the step size taken "
     "at each iteration by the optimizer.  The batch size for SGD is controlled "
     "with the " + PRINT_PARAM_STRING("batch_size") + " parameter. If the "
@@ -76,7 +78,9 @@ BINDING_LONG_DESC(
     "\n\n"
     "For SGD, an iteration refers to a single point. So to take a single pass "
     "over the dataset with SGD, " + PRINT_PARAM_STRING("max_iterations") +
-    " should be set to the number of points in the dataset."
+    " should be set to the number of points in the dataset.  For parallel "
+    "SGD, an iteration refers to a full pass over the dataset, split between "
+    "the available threads."
     "\n\n"
     "Optionally, the model can be used to predict the responses for another "
     "matrix of data points, if " + PRINT_PARAM_STRING("test") + " is "
@@ -135,13 +139,13 @@ PARAM_UROW_IN("labels", "A matrix containing labels (0 or 1) for the points "
 // Optimizer parameters.
 PARAM_DOUBLE_IN("lambda", "L2-regularization parameter for training.", "L",
     0.0);
-PARAM_STRING_IN("optimizer", "Optimizer to use for training ('lbfgs' or "
-    "'sgd').", "O", "lbfgs");
+PARAM_STRING_IN("optimizer", "Optimizer to use for training ('lbfgs', "
+    "'sgd' or 'psgd').", "O", "lbfgs");
 PARAM_DOUBLE_IN("tolerance", "Convergence tolerance for optimizer.", "e",
     1e-10);
 PARAM_INT_IN("max_iterations", "Maximum iterations for optimizer (0 indicates "
     "no limit).", "n", 10000);
-PARAM_DOUBLE_IN("step_size", "Step size for SGD optimizer.",
+PARAM_DOUBLE_IN("step_size", "Step size for SGD and parallel SGD optimizers.",
     "s", 0.01);
 PARAM_INT_IN("batch_size", "Batch size for SGD.", "b", 64);
 
@@ -217,8 +221,8 @@ static void mlpackMain()
   RequireParamValue<double>("tolerance", [](double x) { return x >= 0.0; },
       true, "tolerance must be positive or zero");
 
-  // Optimizer has to be L-BFGS or SGD.
-  RequireParamInSet<string>("optimizer", { "lbfgs", "sgd" },
+  // Optimizer has to be L-BFGS, SGD or parallel SGD.
+  RequireParamInSet<string>("optimizer", { "lbfgs", "sgd", "psgd" },
       true, "unknown optimizer");
 
   // Lambda must be positive.
@@ -233,18 +237,15 @@ static void mlpackMain()
   RequireParamValue<double>("step_size", [](double x) { return x >= 0.0; },
       true, "step size must be positive");
 
-  if (optimizerType != "sgd")
+  if (optimizerType == "lbfgs" && IO::HasParam("step_size"))
   {
-    if (IO::HasParam("step_size"))
-    {
-      Log::Warn << PRINT_PARAM_STRING("step_size") << " ignored because "
-          << "optimizer type is not 'sgd'." << std::endl;
-    }
-    if (IO::HasParam("batch_size"))
-    {
-      Log::Warn << PRINT_PARAM_STRING("batch_size") << " ignored because "
-          << "optimizer type is not 'sgd'." << std::endl;
-    }
+    Log::Warn << PRINT_PARAM_STRING("step_size") << " ignored because "
+        << "optimizer type is 'lbfgs'." << std::endl;
+  }
+  if (optimizerType != "sgd" && IO::HasParam("batch_size"))
+  {
+    Log::Warn << PRINT_PARAM_STRING("batch_size") << " ignored because "
+        << "optimizer type is not 'sgd'." << std::endl;
   }
 
   // These are the matrices we might use.
@@ -333,6 +334,24 @@ static void mlpackMain()
       // This will train the model.
       model->Train(regressors, responses, sgdOpt);
     }
+    else if (optimizerType == "psgd")
+    {
+      #ifdef HAS_OPENMP
+      size_t threads = omp_get_max_threads();
+      #else
+      size_t threads = 1;
+      Log::Warn << "Using parallel SGD, but OpenMP support is "
+                << "not available!" << endl;
+      #endif
+
+      ens::ConstantStep decayPolicy(stepSize);
+      ens::ParallelSGD<ens::ConstantStep> psgdOpt(maxIterations, std::ceil(
+        (float) regressors.n_cols / threads), tolerance, true, decayPolicy);
+      Log::Info << "Training model with parallel SGD optimizer." << endl;
+
+      // This will train the model.
+      model->Train(regressors, responses, psgdOpt);
+    }
     else if (optimizerType == "lbfgs")
     {
       ens::L_BFGS lbfgsOpt;
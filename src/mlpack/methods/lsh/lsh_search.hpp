@@ -290,9 +290,17 @@ class LSHSearch
   //! Get the bucket size of the second hash.
   size_t BucketSize() const { return bucketSize; }
 
-  //! Get the second hash table.
-  const std::vector<arma::Col<size_t>>& SecondHashTable() const
-      { return secondHashTable; }
+  //! Get the start of each row of the second hash table in BucketContents();
+  //! row i holds the elements BucketOffsets()[i] to BucketOffsets()[i + 1] - 1.
+  const arma::Col<size_t>& BucketOffsets() const { return bucketOffsets; }
+
+  //! Get the contents of all rows of the second hash table, stored row after
+  //! row.
+  const arma::Col<size_t>& BucketContents() const { return bucketContents; }
+
+  //! Get the second hash table as one vector per row.  This copies the table;
+  //! use BucketOffsets() and BucketContents() instead.
+  mlpack_deprecated std::vector<arma::Col<size_t>> SecondHashTable() const;
 
   //! Get the projection tables.
   const arma::cube& Projections() { return projections; }
@@ -320,12 +328,16 @@ class LSHSearch
    *    0, all tables are searched.
    * @param T The number of additional probing bins for multiprobe LSH. If 0,
    *    single-probe is used.
+   * @param visited Scratch space of one flag for each reference point, used to
+   *    avoid returning the same candidate twice.  All flags must be false on
+   *    entry, and they are all false again on exit.
    */
   template<typename VecType>
   void ReturnIndicesFromTable(const VecType& queryPoint,
                               arma::uvec& referenceIndices,
                               size_t numTablesToSearch,
-                              const size_t T) const;
+                              const size_t T,
+                              std::vector<bool>& visited) const;
 
   /**
    * This is a helper function that computes the distance of the query to the
@@ -450,15 +462,16 @@ class LSHSearch
   //! The bucket size of the second hash.
   size_t bucketSize;
 
-  //! The final hash table; should be (< secondHashSize) vectors each with
-  //! (<= bucketSize) elements.
-  std::vector<arma::Col<size_t>> secondHashTable;
+  //! The final hash table has (< secondHashSize) rows each with (<=
+  //! bucketSize) elements, stored in compressed sparse row layout: row i
+  //! starts at bucketOffsets[i] in bucketContents, and bucketOffsets has one
+  //! more element than there are rows.
+  arma::Col<size_t> bucketOffsets;
 
-  //! The number of elements present in each hash bucket; should be
-  //! secondHashSize.
-  arma::Col<size_t> bucketContentSize;
+  //! The contents of all rows of the final hash table, row after row.
+  arma::Col<size_t> bucketContents;
 
-  //! For a particular hash value, points to the row in secondHashTable
+  //! For a particular hash value, points to the row in the second hash table
   //! corresponding to this value. Length secondHashSize.
   arma::Col<size_t> bucketRowInHashTable;
 
@@ -83,8 +83,8 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(const LSHSearch& other) :
     secondHashSize(other.secondHashSize),
     secondHashWeights(other.secondHashWeights),
     bucketSize(other.bucketSize),
-    secondHashTable(other.secondHashTable),
-    bucketContentSize(other.bucketContentSize),
+    bucketOffsets(other.bucketOffsets),
+    bucketContents(other.bucketContents),
     bucketRowInHashTable(other.bucketRowInHashTable),
     distanceEvaluations(other.distanceEvaluations)
 {
@@ -103,8 +103,8 @@ LSHSearch<SortPolicy, MatType>::LSHSearch(LSHSearch&& other) :
     secondHashSize(other.secondHashSize),
     secondHashWeights(std::move(other.secondHashWeights)),
     bucketSize(other.bucketSize),
-    secondHashTable(std::move(other.secondHashTable)),
-    bucketContentSize(std::move(other.bucketContentSize)),
+    bucketOffsets(std::move(other.bucketOffsets)),
+    bucketContents(std::move(other.bucketContents)),
     bucketRowInHashTable(std::move(other.bucketRowInHashTable)),
     distanceEvaluations(other.distanceEvaluations)
 {
@@ -131,8 +131,8 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   secondHashSize = other.secondHashSize;
   secondHashWeights = other.secondHashWeights;
   bucketSize = other.bucketSize;
-  secondHashTable = other.secondHashTable;
-  bucketContentSize = other.bucketContentSize;
+  bucketOffsets = other.bucketOffsets;
+  bucketContents = other.bucketContents;
   bucketRowInHashTable = other.bucketRowInHashTable;
   distanceEvaluations = other.distanceEvaluations;
 
@@ -153,8 +153,8 @@ LSHSearch<SortPolicy, MatType>& LSHSearch<SortPolicy, MatType>::operator=(
   secondHashSize = other.secondHashSize;
   secondHashWeights = std::move(other.secondHashWeights);
   bucketSize = other.bucketSize;
-  secondHashTable = std::move(other.secondHashTable);
-  bucketContentSize = std::move(other.bucketContentSize);
+  bucketOffsets = std::move(other.bucketOffsets);
+  bucketContents = std::move(other.bucketContents);
   bucketRowInHashTable = std::move(other.bucketRowInHashTable);
   distanceEvaluations = other.distanceEvaluations;
 
@@ -258,7 +258,9 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
   // size_t, otherwise negative numbers are cast to 0.
   arma::Mat<size_t> secondHashVectors(numTables, this->referenceSet.n_cols);
 
-  for (size_t i = 0; i < numTables; ++i)
+  // The tables are independent, so they are hashed in parallel.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) numTables; ++i)
   {
     // Step IV: create the 'numProj'-dimensional key for each point in each
     // table.
@@ -271,13 +273,11 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
     // and the corresponding offset be 'offset_i'.  Then the key of a single
     // point is obtained as:
     // key = { floor((<proj_i, point> + offset_i) / 'hashWidth') forall i }
-    arma::mat offsetMat = arma::repmat(offsets.unsafe_col(i), 1,
-                                       this->referenceSet.n_cols);
     arma::mat hashMat = projections.slice(i).t() * (this->referenceSet);
-    hashMat += offsetMat;
+    hashMat.each_col() += offsets.col(i);
     hashMat /= hashWidth;
 
-    // Step V: Putting the points in the 'secondHashTable' by hashing the key.
+    // Step V: Putting the points in the second hash table by hashing the key.
     // Now we hash every key, point ID to its corresponding bucket.  We must
     // also normalize the hashes to the range [0, secondHashSize).
     arma::rowvec unmodVector = secondHashWeights.t() * arma::floor(hashMat);
@@ -309,37 +309,43 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
   secondHashBinCounts.transform([effectiveBucketSize](size_t val)
       { return std::min(val, effectiveBucketSize); });
 
+  // Rows of the second hash table are numbered in the order their buckets are
+  // first seen, and each row holds at most the (capped) count of its bucket.
+  // The counts give the start of each row, so the table can be filled in
+  // place.
   const size_t numRowsInTable = arma::accu(secondHashBinCounts > 0);
-  bucketContentSize.zeros(numRowsInTable);
-  secondHashTable.resize(numRowsInTable);
-
-  // Next we must assign each point in each table to the right second hash
-  // table.
+  bucketOffsets.set_size(numRowsInTable + 1);
+  bucketOffsets[0] = 0;
   size_t currentRow = 0;
   for (size_t i = 0; i < numTables; ++i)
   {
-    // Insert the point in the corresponding row to its bucket in the
-    // 'secondHashTable'.
     for (size_t j = 0; j < secondHashVectors.n_cols; ++j)
     {
-      // This is the bucket number.
-      size_t hashInd = (size_t) secondHashVectors(i, j);
-      // The point ID is 'j'.
-
-      // If this is currently an empty bucket, start a new row keep track of
-      // which row corresponds to the bucket.
-      const size_t maxSize = secondHashBinCounts[hashInd];
+      const size_t hashInd = secondHashVectors(i, j);
       if (bucketRowInHashTable[hashInd] == secondHashSize)
       {
         bucketRowInHashTable[hashInd] = currentRow;
-        secondHashTable[currentRow].set_size(maxSize);
+        bucketOffsets[currentRow + 1] = bucketOffsets[currentRow] +
+            secondHashBinCounts[hashInd];
         currentRow++;
       }
+    }
+  }
 
-      // If this vector in the hash table is not full, add the point.
-      const size_t index = bucketRowInHashTable[hashInd];
-      if (bucketContentSize[index] < maxSize)
-        secondHashTable[index](bucketContentSize[index]++) = j;
+  // Next we must assign each point in each table to the right row of the
+  // second hash table.  Rows that are full (because of the maximum bucket
+  // size) keep the first points hashed to them.
+  bucketContents.set_size(bucketOffsets[numRowsInTable]);
+  arma::Col<size_t> rowFill(numRowsInTable, arma::fill::zeros);
+  for (size_t i = 0; i < numTables; ++i)
+  {
+    for (size_t j = 0; j < secondHashVectors.n_cols; ++j)
+    {
+      // This is the bucket number; the point ID is 'j'.
+      const size_t row = bucketRowInHashTable[secondHashVectors(i, j)];
+      const size_t start = bucketOffsets[row];
+      if (start + rowFill[row] < bucketOffsets[row + 1])
+        bucketContents[start + rowFill[row]++] = j;
     } // Loop over all points in the reference set.
   } // Loop over tables.
 
@@ -708,7 +714,8 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
     const VecType& queryPoint,
     arma::uvec& referenceIndices,
     size_t numTablesToSearch,
-    const size_t T) const
+    const size_t T,
+    std::vector<bool>& visited) const
 {
   // Decide on the number of tables to look into.
   if (numTablesToSearch == 0) // If no user input is given, search all.
@@ -739,7 +746,7 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
   hashMat.set_size(T + 1, numTablesToSearch);
 
   // Compute the primary hash value of each key of the query into a bucket of
-  // the secondHashTable using the secondHashWeights.
+  // the second hash table using the secondHashWeights.
   hashMat.row(0) = arma::conv_to<arma::Row<size_t>> // Floor by typecasting
       ::from(secondHashWeights.t() * allProjInTables);
   // Mod to compute 2nd-level codes.
@@ -758,8 +765,8 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
                                 T,
                                 additionalProbingBins);
 
-      // Map each probing bin to a bin in secondHashTable (just like we did for
-      // the primary hash table).
+      // Map each probing bin to a bin in the second hash table (just like we
+      // did for the primary hash table).
       hashMat(arma::span(1, T), i) = // Compute code of rows 1:end of column i
         arma::conv_to< arma::Col<size_t> >:: // floor by typecasting to size_t
         from(secondHashWeights.t() * additionalProbingBins);
@@ -776,82 +783,62 @@ void LSHSearch<SortPolicy, MatType>::ReturnIndicesFromTable(
     {
       const size_t hashInd = hashMat(p, i); // find query's bucket
       const size_t tableRow = bucketRowInHashTable[hashInd];
-      if (tableRow < secondHashSize)
-        maxNumPoints += bucketContentSize[tableRow]; // count bucket contents
+      if (tableRow < secondHashSize) // count bucket contents
+        maxNumPoints += bucketOffsets[tableRow + 1] - bucketOffsets[tableRow];
     }
   }
 
-  // There are two ways to proceed here:
-  // Either allocate a maxNumPoints-size vector, place all candidates, and run
-  // unique on the vector to discard duplicates.
-  // Or allocate a referenceSet.n_cols size vector (i.e. number of reference
-  // points) of zeros, and mark found indices as 1.
-  // Option 1 runs faster for small maxNumPoints but worse for larger values, so
-  // we choose based on a heuristic.
-  const float cutoff = 0.1;
-  const float selectivity = static_cast<float>(maxNumPoints) /
-      static_cast<float>(referenceSet.n_cols);
-
-  if (selectivity > cutoff)
+  // Collect the points in the query's buckets, using the visited flags to keep
+  // only one copy of each candidate.
+  referenceIndices.set_size(std::min(maxNumPoints,
+      (size_t) referenceSet.n_cols));
+  size_t found = 0;
+  for (size_t i = 0; i < numTablesToSearch; ++i) // For all tables.
   {
-    // Heuristic: larger maxNumPoints means we should use find() because it
-    // should be faster.
-    // Reference points hashed in the same bucket as the query are set to >0.
-    arma::Col<size_t> refPointsConsidered;
-    refPointsConsidered.zeros(referenceSet.n_cols);
-
-    for (size_t i = 0; i < numTablesToSearch; ++i) // for all tables
+    for (size_t p = 0; p < T + 1; ++p) // For entire probing sequence.
     {
-      for (size_t p = 0; p < T + 1; ++p) // For entire probing sequence.
-      {
-        // get the sequence code
-        size_t hashInd = hashMat(p, i);
-        size_t tableRow = bucketRowInHashTable[hashInd];
+      const size_t hashInd = hashMat(p, i); // Find the query's bucket.
+      const size_t tableRow = bucketRowInHashTable[hashInd];
+      if (tableRow >= secondHashSize)
+        continue;
 
-        if (tableRow < secondHashSize && bucketContentSize[tableRow] > 0)
+      for (size_t j = bucketOffsets[tableRow]; j < bucketOffsets[tableRow + 1];
+          ++j)
+      {
+        const size_t index = bucketContents[j];
+        if (!visited[index])
         {
-          // Pick the indices in the bucket corresponding to hashInd.
-          for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
-            refPointsConsidered[ secondHashTable[tableRow](j) ]++;
+          visited[index] = true;
+          referenceIndices[found++] = index;
         }
       }
     }
-
-    // Only keep reference points found in at least one bucket.
-    referenceIndices = arma::find(refPointsConsidered > 0);
-    return;
   }
-  else
-  {
-    // Heuristic: smaller maxNumPoints means we should use unique() because it
-    // should be faster.
-    // Allocate space for the query's potential neighbors.
-    arma::uvec refPointsConsideredSmall;
-    refPointsConsideredSmall.zeros(maxNumPoints);
 
-    // Retrieve candidates.
-    size_t start = 0;
+  referenceIndices.resize(found);
 
-    for (size_t i = 0; i < numTablesToSearch; ++i) // For all tables
-    {
-      for (size_t p = 0; p < T + 1; ++p)
-      {
-        const size_t hashInd =  hashMat(p, i); // Find the query's bucket.
-        const size_t tableRow = bucketRowInHashTable[hashInd];
+  // Clear the flags for the next query; this only touches the candidates.
+  for (size_t i = 0; i < found; ++i)
+    visited[referenceIndices[i]] = false;
 
-        if (tableRow < secondHashSize)
-        {
-          // Store all secondHashTable points in the candidates set.
-          for (size_t j = 0; j < bucketContentSize[tableRow]; ++j)
-            refPointsConsideredSmall(start++) = secondHashTable[tableRow](j);
-       }
-      }
-    }
+  // The base case sees the candidates in increasing order, so that ties
+  // between equally distant candidates are broken by index.
+  std::sort(referenceIndices.begin(), referenceIndices.end());
+}
 
-    // Keep only one copy of each candidate.
-    referenceIndices = arma::unique(refPointsConsideredSmall);
-    return;
+template<typename SortPolicy, typename MatType>
+std::vector<arma::Col<size_t>>
+LSHSearch<SortPolicy, MatType>::SecondHashTable() const
+{
+  std::vector<arma::Col<size_t>> table(bucketOffsets.n_elem == 0 ? 0 :
+      bucketOffsets.n_elem - 1);
+  for (size_t i = 0; i < table.size(); ++i)
+  {
+    table[i] = bucketContents.subvec(bucketOffsets[i],
+        bucketOffsets[i + 1] - 1);
   }
+
+  return table;
 }
 
 // Search for nearest neighbors in a given query set.
@@ -905,29 +892,31 @@ void LSHSearch<SortPolicy, MatType>::Search(
 
   Timer::Start("computing_neighbors");
 
-  // Parallelization to process more than one query at a time.
-  #pragma omp parallel for \
-      shared(resultingNeighbors, distances) \
-      schedule(dynamic)\
+  // Parallelization to process more than one query at a time.  Each thread
+  // has its own flags to deduplicate candidates with.
+  #pragma omp parallel shared(resultingNeighbors, distances) \
       reduction(+:avgIndicesReturned)
-  for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
   {
-    // Go through every query point.
-    // Hash every query into every hash table and eventually into the
-    // 'secondHashTable' to obtain the neighbor candidates.
-    arma::uvec refIndices;
-    ReturnIndicesFromTable(querySet.col(i), refIndices, numTablesToSearch,
-        Teffective);
-
-    // An informative book-keeping for the number of neighbor candidates
-    // returned on average.
-    // Make atomic to avoid race conditions when multiple threads are running
-    // #pragma omp atomic
-    avgIndicesReturned = avgIndicesReturned + refIndices.n_elem;
-
-    // Sequentially go through all the candidates and save the best 'k'
-    // candidates.
-    BaseCase(i, refIndices, k, querySet, resultingNeighbors, distances);
+    std::vector<bool> visited(referenceSet.n_cols, false);
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+    {
+      // Go through every query point.
+      // Hash every query into every hash table and eventually into the
+      // second hash table to obtain the neighbor candidates.
+      arma::uvec refIndices;
+      ReturnIndicesFromTable(querySet.col(i), refIndices, numTablesToSearch,
+          Teffective, visited);
+
+      // An informative book-keeping for the number of neighbor candidates
+      // returned on average.
+      avgIndicesReturned = avgIndicesReturned + refIndices.n_elem;
+
+      // Sequentially go through all the candidates and save the best 'k'
+      // candidates.
+      BaseCase(i, refIndices, k, querySet, resultingNeighbors, distances);
+    }
   }
 
   Timer::Stop("computing_neighbors");
@@ -971,29 +960,31 @@ Search(const size_t k,
 
   Timer::Start("computing_neighbors");
 
-  // Parallelization to process more than one query at a time.
-  #pragma omp parallel for \
-      shared(resultingNeighbors, distances) \
-      schedule(dynamic)\
+  // Parallelization to process more than one query at a time.  Each thread
+  // has its own flags to deduplicate candidates with.
+  #pragma omp parallel shared(resultingNeighbors, distances) \
       reduction(+:avgIndicesReturned)
-  for (omp_size_t i = 0; i < (omp_size_t) referenceSet.n_cols; ++i)
   {
-    // Go through every query point.
-    // Hash every query into every hash table and eventually into the
-    // 'secondHashTable' to obtain the neighbor candidates.
-    arma::uvec refIndices;
-    ReturnIndicesFromTable(referenceSet.col(i), refIndices, numTablesToSearch,
-        Teffective);
-
-    // An informative book-keeping for the number of neighbor candidates
-    // returned on average.
-    // Make atomic to avoid race conditions when multiple threads are running.
-    // #pragma omp atomic
-    avgIndicesReturned += refIndices.n_elem;
-
-    // Sequentially go through all the candidates and save the best 'k'
-    // candidates.
-    BaseCase(i, refIndices, k, resultingNeighbors, distances);
+    std::vector<bool> visited(referenceSet.n_cols, false);
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) referenceSet.n_cols; ++i)
+    {
+      // Go through every query point.
+      // Hash every query into every hash table and eventually into the
+      // second hash table to obtain the neighbor candidates.
+      arma::uvec refIndices;
+      ReturnIndicesFromTable(referenceSet.col(i), refIndices,
+          numTablesToSearch, Teffective, visited);
+
+      // An informative book-keeping for the number of neighbor candidates
+      // returned on average.
+      avgIndicesReturned += refIndices.n_elem;
+
+      // Sequentially go through all the candidates and save the best 'k'
+      // candidates.
+      BaseCase(i, refIndices, k, resultingNeighbors, distances);
+    }
   }
 
   Timer::Stop("computing_neighbors");
@@ -1034,7 +1025,7 @@ double LSHSearch<SortPolicy, MatType>::ComputeRecall(
 template<typename SortPolicy, typename MatType>
 template<typename Archive>
 void LSHSearch<SortPolicy, MatType>::serialize(Archive& ar,
-                                               const uint32_t /* version */)
+                                               const uint32_t version)
 {
   ar(CEREAL_NVP(referenceSet));
   ar(CEREAL_NVP(numProj));
@@ -1050,8 +1041,33 @@ void LSHSearch<SortPolicy, MatType>::serialize(Archive& ar,
   ar(CEREAL_NVP(secondHashSize));
   ar(CEREAL_NVP(secondHashWeights));
   ar(CEREAL_NVP(bucketSize));
-  ar(CEREAL_NVP(secondHashTable));
-  ar(CEREAL_NVP(bucketContentSize));
+  if (cereal::is_loading<Archive>() && version == 0)
+  {
+    // Older models store each row of the second hash table in its own vector,
+    // with the number of points of each row; convert them to the compressed
+    // layout.
+    std::vector<arma::Col<size_t>> secondHashTable;
+    arma::Col<size_t> bucketContentSize;
+    ar(CEREAL_NVP(secondHashTable));
+    ar(CEREAL_NVP(bucketContentSize));
+
+    bucketOffsets.set_size(bucketContentSize.n_elem + 1);
+    bucketOffsets[0] = 0;
+    for (size_t i = 0; i < bucketContentSize.n_elem; ++i)
+      bucketOffsets[i + 1] = bucketOffsets[i] + bucketContentSize[i];
+
+    bucketContents.set_size(bucketOffsets[bucketContentSize.n_elem]);
+    for (size_t i = 0; i < bucketContentSize.n_elem; ++i)
+    {
+      for (size_t j = 0; j < bucketContentSize[i]; ++j)
+        bucketContents[bucketOffsets[i] + j] = secondHashTable[i][j];
+    }
+  }
+  else
+  {
+    ar(CEREAL_NVP(bucketOffsets));
+    ar(CEREAL_NVP(bucketContents));
+  }
   ar(CEREAL_NVP(bucketRowInHashTable));
   ar(CEREAL_NVP(distanceEvaluations));
 }
@@ -1059,4 +1075,9 @@ void LSHSearch<SortPolicy, MatType>::serialize(Archive& ar,
 } // namespace neighbor
 } // namespace mlpack
 
+// Version 1 stores the second hash table in compressed sparse row layout.
+CEREAL_TEMPLATE_CLASS_VERSION((template<typename SortPolicy,
+    typename MatType>), (mlpack::neighbor::LSHSearch<SortPolicy, MatType>),
+    (1));
+
 #endif
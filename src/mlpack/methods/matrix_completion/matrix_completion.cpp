@@ -98,6 +98,99 @@ void MatrixCompletion::Recover(arma::mat& recovered)
   recovered = recovered(arma::span(0, m - 1), arma::span(m, m + n - 1));
 }
 
+void MatrixCompletion::RecoverALS(arma::mat& recovered,
+                                  const double lambda,
+                                  const size_t maxIterations,
+                                  const double tolerance)
+{
+  if (lambda <= 0.0)
+  {
+    Log::Fatal << "MatrixCompletion::RecoverALS(): lambda must be positive!"
+        << std::endl;
+  }
+
+  // Keep the factors transposed, so that each row of U and V is a contiguous
+  // column.
+  const arma::mat& initialPoint = sdp.Function().GetInitialPoint();
+  const size_t r = initialPoint.n_cols;
+  arma::mat u = trans(initialPoint.rows(0, m - 1));
+  arma::mat v = trans(initialPoint.rows(m, m + n - 1));
+
+  // Group the known entries by row and by column.
+  const size_t p = indices.n_cols;
+  std::vector<std::vector<arma::uword>> rowEntries(m), colEntries(n);
+  for (size_t k = 0; k < p; ++k)
+  {
+    rowEntries[indices(0, k)].push_back(k);
+    colEntries[indices(1, k)].push_back(k);
+  }
+
+  // Solve for the factor of every row (or column) with its known entries,
+  // given the other factor.
+  auto solveFactors = [&](arma::mat& factor,
+                          const arma::mat& other,
+                          const std::vector<std::vector<arma::uword>>& entries,
+                          const size_t otherIndexRow)
+  {
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) factor.n_cols; ++i)
+    {
+      const arma::uvec known(entries[i]);
+      if (known.n_elem == 0)
+      {
+        factor.col(i).zeros();
+        continue;
+      }
+
+      arma::uvec otherIndices(known.n_elem);
+      for (size_t j = 0; j < known.n_elem; ++j)
+        otherIndices[j] = indices(otherIndexRow, known[j]);
+
+      const arma::mat otherFactors = other.cols(otherIndices);
+      const arma::mat gram = otherFactors * trans(otherFactors) +
+          lambda * arma::eye<arma::mat>(r, r);
+      const arma::vec rhs = otherFactors * values.elem(known);
+
+      // The system is positive definite since lambda > 0.
+      factor.col(i) = arma::solve(gram, rhs);
+    }
+  };
+
+  auto objective = [&]()
+  {
+    double residual = 0.0;
+    #pragma omp parallel for reduction(+:residual)
+    for (omp_size_t k = 0; k < (omp_size_t) p; ++k)
+    {
+      const double diff = arma::dot(u.col(indices(0, k)),
+          v.col(indices(1, k))) - values[k];
+      residual += diff * diff;
+    }
+
+    return 0.5 * residual + 0.5 * lambda * (arma::accu(arma::square(u)) +
+        arma::accu(arma::square(v)));
+  };
+
+  double lastObjective = objective();
+  for (size_t iteration = 0; iteration != maxIterations; ++iteration)
+  {
+    solveFactors(u, v, rowEntries, 1);
+    solveFactors(v, u, colEntries, 0);
+
+    const double currentObjective = objective();
+    Log::Debug << "MatrixCompletion::RecoverALS(): iteration " << iteration
+        << ", objective " << currentObjective << "." << std::endl;
+
+    if (std::abs(lastObjective - currentObjective) <=
+        tolerance * std::max(lastObjective, 1.0))
+      break;
+
+    lastObjective = currentObjective;
+  }
+
+  recovered = trans(u) * v;
+}
+
 size_t MatrixCompletion::DefaultRank(const size_t m,
                                      const size_t n,
                                      const size_t p)
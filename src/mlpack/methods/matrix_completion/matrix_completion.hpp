@@ -48,6 +48,9 @@ namespace matrix_completion {
  * mc.Recover(recovered);
  * @endcode
  *
+ * For large problems, RecoverALS() solves a regularized low-rank factorization
+ * of the matrix with alternating least squares instead of the SDP.
+ *
  * @see LRSDP
  */
 class MatrixCompletion
@@ -111,6 +114,33 @@ class MatrixCompletion
    */
   void Recover(arma::mat& recovered);
 
+  /**
+   * Fill in the remaining values with alternating least squares (the
+   * "soft-impute-ALS" approach) instead of solving the SDP.  The completed
+   * matrix is X = U V^T, where U (m x r) and V (n x r) are the two blocks of the
+   * initial point of the SDP, and the regularized problem
+   *
+   *   min 1/2 sum_{(i, j) known} (X_ij - M_ij)^2 + lambda/2 (||U||_F^2 +
+   *       ||V||_F^2)
+   *
+   * is solved by alternately solving for each row of U and each row of V, which
+   * is an r x r linear system built from only the known entries of that row or
+   * column.  The rows (and columns) are solved in parallel, and one iteration
+   * costs O(p r^2 + (m + n) r^3), so this scales to far more known entries than
+   * the SDP.  For small lambda and a large enough rank, the solution is close to
+   * the nuclear norm minimizer.
+   *
+   * @param recovered Will contain the completed matrix.
+   * @param lambda Regularization parameter (must be positive).
+   * @param maxIterations Maximum number of iterations (0 means no limit).
+   * @param tolerance The iterations stop when the relative change of the
+   *    objective is below this value.
+   */
+  void RecoverALS(arma::mat& recovered,
+                  const double lambda = 1e-4,
+                  const size_t maxIterations = 1000,
+                  const double tolerance = 1e-10);
+
   //! Return the underlying SDP.
   const ens::LRSDP<ens::SDP<arma::sp_mat>>& Sdp() const
   {
@@ -113,7 +113,8 @@ class MeanShift
    * them as initial centroids rather than all the points in the data set.  The
    * basic idea here is that we will place our points into hypercube bins of
    * side length binSize, and any bins that contain fewer than minFreq points
-   * will be removed as possible seeds.  Usually, 1 is a sufficient parameter
+   * will be removed as possible seeds.  The occupied bins are counted in a
+   * hash table.  Usually, 1 is a sufficient parameter
    * for minFreq, and the bin size can be set equal to the estimated radius.
    *
    * @param data The reference data set.
@@ -166,6 +167,9 @@ class MeanShift
   //! Maximum number of iterations before giving up.
   size_t maxIterations;
 
+  //! Number of seeds searched for with each range search.
+  static const size_t SearchBatchSize = 65536;
+
   //! Instantiated kernel.
   KernelType kernel;
 };
@@ -18,7 +18,7 @@
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 #include <mlpack/methods/range_search/range_search.hpp>
 
-#include "map"
+#include <unordered_map>
 
 // In case it hasn't been included yet.
 #include "mean_shift.hpp"
@@ -71,20 +71,19 @@ EstimateRadius(const MatType& data, double ratio)
   return arma::sum(maxDistances) / (double) data.n_cols;
 }
 
-// Class to compare two vectors.
-template <typename VecType>
-class less
+// Class to hash the integer coordinates of a grid cell.
+class BinHash
 {
  public:
-  bool operator()(const VecType& first, const VecType& second) const
+  size_t operator()(const std::vector<arma::sword>& bin) const
   {
-    for (size_t i = 0; i < first.n_rows; ++i)
+    size_t hash = bin.size();
+    for (size_t i = 0; i < bin.size(); ++i)
     {
-      if (first[i] == second[i])
-        continue;
-      return first(i) < second(i);
+      hash ^= std::hash<arma::sword>()(bin[i]) + 0x9e3779b9 + (hash << 6) +
+          (hash >> 2);
     }
-    return false;
+    return hash;
   }
 };
 
@@ -96,37 +95,32 @@ void MeanShift<UseKernel, KernelType, MatType>::GenSeeds(
     const int minFreq,
     MatType& seeds)
 {
-  typedef arma::colvec VecType;
-  std::map<VecType, int, less<VecType> > allSeeds;
+  // Count the points in each occupied grid cell.  Only occupied cells are
+  // stored, so this is linear in the number of points whatever the extent of
+  // the data.
+  typedef std::vector<arma::sword> BinType;
+  std::unordered_map<BinType, int, BinHash> allSeeds;
+  allSeeds.reserve(data.n_cols);
+  BinType bin(data.n_rows);
   for (size_t i = 0; i < data.n_cols; ++i)
   {
-    VecType binnedPoint = arma::floor(data.unsafe_col(i) / binSize);
-    if (allSeeds.find(binnedPoint) == allSeeds.end())
-      allSeeds[binnedPoint] = 1;
-    else
-      allSeeds[binnedPoint]++;
+    for (size_t d = 0; d < data.n_rows; ++d)
+      bin[d] = (arma::sword) std::floor(data(d, i) / binSize);
+    ++allSeeds[bin];
   }
 
-  // Remove seeds with too few points.  First we count the number of seeds we
-  // end up with, then we add them.
-  std::map<VecType, int, less<VecType> >::iterator it;
-  size_t count = 0;
-  for (it = allSeeds.begin(); it != allSeeds.end(); ++it)
-    if (it->second >= minFreq)
-      ++count;
-
-  seeds.set_size(data.n_rows, count);
-  count = 0;
-  for (it = allSeeds.begin(); it != allSeeds.end(); ++it)
-  {
+  // Remove seeds with too few points.  The remaining cells are sorted, so that
+  // the order of the seeds doesn't depend on the hash table.
+  std::vector<BinType> bins;
+  for (auto it = allSeeds.begin(); it != allSeeds.end(); ++it)
     if (it->second >= minFreq)
-    {
-      seeds.col(count) = it->first;
-      ++count;
-    }
-  }
+      bins.push_back(it->first);
+  std::sort(bins.begin(), bins.end());
 
-  seeds *= binSize;
+  seeds.set_size(data.n_rows, bins.size());
+  for (size_t i = 0; i < bins.size(); ++i)
+    for (size_t d = 0; d < data.n_rows; ++d)
+      seeds(d, i) = bins[i][d] * binSize;
 }
 
 // Calculate new centroid with given kernel.
@@ -202,8 +196,10 @@ inline void MeanShift<UseKernel, KernelType, MatType>::Cluster(
     pSeeds = &seeds;
   }
 
-  // Holds all centroids before removing duplicate ones.
-  arma::mat allCentroids(pSeeds->n_rows, pSeeds->n_cols);
+  // Holds all centroids before removing duplicate ones.  The initial centroid
+  // of each seed is the seed itself.
+  arma::mat allCentroids(*pSeeds);
+  arma::Col<size_t> converged(pSeeds->n_cols, arma::fill::zeros);
 
   assignments.set_size(data.n_cols);
 
@@ -212,53 +208,84 @@ inline void MeanShift<UseKernel, KernelType, MatType>::Cluster(
   std::vector<std::vector<size_t> > neighbors;
   std::vector<std::vector<double> > distances;
 
-  // For each seed, perform mean shift algorithm.
-  for (size_t i = 0; i < pSeeds->n_cols; ++i)
+  // All seeds are shifted together.  In each iteration the seeds that are
+  // still moving are searched for with dual-tree range searches (in batches,
+  // to bound the memory used by the results), and then shifted in parallel.
+  std::vector<size_t> active(pSeeds->n_cols);
+  for (size_t i = 0; i < active.size(); ++i)
+    active[i] = i;
+
+  for (size_t completedIterations = 0; !active.empty() &&
+      (completedIterations < maxIterations || forceConvergence);
+      completedIterations++)
   {
-    // Initial centroid is the seed itself.
-    allCentroids.col(i) = pSeeds->unsafe_col(i);
-    for (size_t completedIterations = 0; completedIterations < maxIterations
-        || forceConvergence; completedIterations++)
+    std::vector<size_t> stillActive;
+    for (size_t batchStart = 0; batchStart < active.size();
+        batchStart += SearchBatchSize)
     {
-      // Store new centroid in this.
-      arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
+      const size_t batchSize = std::min((size_t) SearchBatchSize,
+          active.size() - batchStart);
+      arma::mat queries(allCentroids.n_rows, batchSize);
+      for (size_t b = 0; b < batchSize; ++b)
+        queries.col(b) = allCentroids.col(active[batchStart + b]);
 
-      rangeSearcher.Search(allCentroids.unsafe_col(i), validRadius,
-          neighbors, distances);
-      if (neighbors[0].size() == 0) // There are no points in the cluster.
-        break;
-
-      // Calculate new centroid.
-      if (!CalculateCentroid(data, neighbors[0], distances[0], newCentroid))
-        newCentroid = allCentroids.unsafe_col(i);
+      rangeSearcher.Search(queries, validRadius, neighbors, distances);
 
-      // If the mean shift vector is small enough, it has converged.
-      if (metric::EuclideanDistance::Evaluate(newCentroid,
-          allCentroids.unsafe_col(i)) < 1e-3 * radius)
+      arma::Col<size_t> moved(batchSize, arma::fill::zeros);
+      #pragma omp parallel for
+      for (omp_size_t b = 0; b < (omp_size_t) batchSize; ++b)
       {
-        // Determine if the new centroid is duplicate with old ones.
-        bool isDuplicated = false;
-        for (size_t k = 0; k < centroids.n_cols; ++k)
+        const size_t i = active[batchStart + b];
+        if (neighbors[b].size() == 0) // There are no points in the cluster.
+          continue;
+
+        // Calculate new centroid.
+        arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
+        if (!CalculateCentroid(data, neighbors[b], distances[b], newCentroid))
+          newCentroid = allCentroids.unsafe_col(i);
+
+        // If the mean shift vector is small enough, it has converged.
+        if (metric::EuclideanDistance::Evaluate(newCentroid,
+            allCentroids.unsafe_col(i)) < 1e-3 * radius)
         {
-          const double distance = metric::EuclideanDistance::Evaluate(
-              allCentroids.unsafe_col(i), centroids.unsafe_col(k));
-          if (distance < radius)
-          {
-            isDuplicated = true;
-            break;
-          }
+          converged[i] = 1;
+          continue;
         }
 
-        if (!isDuplicated)
-          centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
+        // Update the centroid.
+        allCentroids.col(i) = newCentroid;
+        moved[b] = 1;
+      }
 
-        // Get out of the loop.
+      for (size_t b = 0; b < batchSize; ++b)
+        if (moved[b])
+          stillActive.push_back(active[batchStart + b]);
+    }
+
+    active.swap(stillActive);
+  }
+
+  // Determine, in seed order, if each converged centroid is duplicate with
+  // old ones.
+  for (size_t i = 0; i < pSeeds->n_cols; ++i)
+  {
+    if (!converged[i])
+      continue;
+
+    bool isDuplicated = false;
+    for (size_t k = 0; k < centroids.n_cols; ++k)
+    {
+      const double distance = metric::EuclideanDistance::Evaluate(
+          allCentroids.unsafe_col(i), centroids.unsafe_col(k));
+      if (distance < radius)
+      {
+        isDuplicated = true;
         break;
       }
-
-      // Update the centroid.
-      allCentroids.col(i) = newCentroid;
     }
+
+    if (!isDuplicated)
+      centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
   }
 
   // If no centroid has converged due to too little iterations and without
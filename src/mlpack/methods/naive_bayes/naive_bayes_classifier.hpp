@@ -4,8 +4,9 @@
  * @author Shihao Jing (shihao.jing810@gmail.com)
  *
  * A Naive Bayes Classifier which parametrically estimates the distribution of
- * the features.  It is assumed that the features have been sampled from a
- * Gaussian PDF.
+ * the features.  It is assumed that numeric features have been sampled from a
+ * Gaussian PDF, and that categorical features have been sampled from a
+ * categorical distribution.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
@@ -16,6 +17,7 @@
 #define MLPACK_METHODS_NAIVE_BAYES_NAIVE_BAYES_CLASSIFIER_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/dataset_mapper.hpp>
 
 namespace mlpack {
 namespace naive_bayes /** The Naive Bayes Classifier. */ {
@@ -34,6 +36,18 @@ namespace naive_bayes /** The Naive Bayes Classifier. */ {
  * For classifying a data point (x_1, x_2, ..., x_n), it computes the following:
  * arg max_y(P(Y = y)*P(X_1 = x_1 | Y = y) * ... * P(X_n = x_n | Y = y))
  *
+ * Numeric features are modeled with a Gaussian for each class.  If a
+ * data::DatasetInfo is given to the constructor or to Train(), categorical
+ * features are modeled with a categorical distribution for each class, which
+ * is stored as a dense lookup table of log-probabilities (with add-one
+ * smoothing of the counts).
+ *
+ * Training on a batch accumulates the per-class counts, means and centered
+ * sums of squares of the batch in parallel, and merges them into the model, so
+ * a large stream can be learned chunk by chunk with the incremental Train().
+ * Classification of a batch computes the Gaussian log-likelihoods of all
+ * points with matrix multiplications.
+ *
  * Example use:
  *
  * @code
@@ -87,6 +101,30 @@ class NaiveBayesClassifier
                        const bool incrementalVariance = false,
                        const double epsilon = 1e-10);
 
+  /**
+   * Initializes the classifier as per the input and then trains it, modeling
+   * the dimensions that are categorical in the given DatasetInfo with
+   * categorical distributions.  The values of a categorical dimension should
+   * be in [0, datasetInfo.NumMappings(dimension)), as produced by
+   * data::Load().
+   *
+   * @param data Training data points.
+   * @param datasetInfo Information on the type of each dimension.
+   * @param labels Labels corresponding to training data points.
+   * @param numClasses Number of classes in this classifier.
+   * @param incrementalVariance If true, an incremental algorithm is used to
+   *     calculate the variance; this can prevent loss of precision in some
+   *     cases, but will be somewhat slower to calculate.
+   * @param epsilon Small value to prevent log of zero.
+   */
+  template<typename MatType>
+  NaiveBayesClassifier(const MatType& data,
+                       const data::DatasetInfo& datasetInfo,
+                       const arma::Row<size_t>& labels,
+                       const size_t numClasses,
+                       const bool incrementalVariance = false,
+                       const double epsilon = 1e-10);
+
   /**
    * Initialize the Naive Bayes classifier without performing training.  All of
    * the parameters of the model will be initialized to zero.  Be sure to use
@@ -108,6 +146,11 @@ class NaiveBayesClassifier
    * classes, either re-initialize or call Means(), Variances(), and
    * Probabilities() individually to set them to the right size.
    *
+   * The statistics of the given batch are computed in parallel and then merged
+   * into the model, so training on a stream chunk by chunk gives the same model
+   * as training on all of the data at once.  Dimensions that were given as
+   * categorical to an earlier call with a DatasetInfo stay categorical.
+   *
    * @param data The dataset to train on.
    * @param labels The labels for the dataset.
    * @param numClasses The numbe of classes in the dataset.
@@ -120,6 +163,28 @@ class NaiveBayesClassifier
              const size_t numClasses,
              const bool incremental = true);
 
+  /**
+   * Train the Naive Bayes classifier on the given dataset, modeling the
+   * dimensions that are categorical in the given DatasetInfo with categorical
+   * distributions.  When training incrementally, the DatasetInfo may have more
+   * mappings than the one used before (for instance, if new categories appeared
+   * in a later chunk of a stream); the lookup tables are grown accordingly.
+   * The type of a dimension cannot change during incremental training.
+   *
+   * @param data The dataset to train on.
+   * @param datasetInfo Information on the type of each dimension.
+   * @param labels The labels for the dataset.
+   * @param numClasses The number of classes in the dataset.
+   * @param incremental Whether or not to use the incremental algorithm for
+   *      training.
+   */
+  template<typename MatType>
+  void Train(const MatType& data,
+             const data::DatasetInfo& datasetInfo,
+             const arma::Row<size_t>& labels,
+             const size_t numClasses,
+             const bool incremental = true);
+
   /**
    * Train the Naive Bayes classifier on the given point.  This will use the
    * incremental algorithm for updating the model parameters.  The data must be
@@ -199,12 +264,14 @@ class NaiveBayesClassifier
                 arma::Row<size_t>& predictions,
                 ProbabilitiesMatType& probabilities) const;
 
-  //! Get the sample means for each class.
+  //! Get the sample means for each class.  Only rows of numeric dimensions are
+  //! used.
   const ModelMatType& Means() const { return means; }
   //! Modify the sample means for each class.
   ModelMatType& Means() { return means; }
 
-  //! Get the sample variances for each class.
+  //! Get the sample variances for each class.  Only rows of numeric dimensions
+  //! are used.
   const ModelMatType& Variances() const { return variances; }
   //! Modify the sample variances for each class.
   ModelMatType& Variances() { return variances; }
@@ -214,6 +281,18 @@ class NaiveBayesClassifier
   //! Modify the prior probabilities for each class.
   ModelMatType& Probabilities() { return probabilities; }
 
+  //! Get the number of categories of each dimension (0 for numeric ones).
+  const arma::Col<size_t>& NumCategories() const { return numCategories; }
+
+  //! Get the log-probability lookup table of the categorical dimensions.  The
+  //! column CategoryOffsets()[d] + v holds log P(X_d = v | Y = y) for each
+  //! class y.
+  const ModelMatType& LogCategoryProbabilities() const
+  { return logCategoryProbabilities; }
+
+  //! Get the first column of each dimension in the categorical tables.
+  const arma::Col<size_t>& CategoryOffsets() const { return categoryOffsets; }
+
   //! Serialize the classifier.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -229,6 +308,52 @@ class NaiveBayesClassifier
   size_t trainingPoints;
   //! Small value to prevent log of zero.
   double epsilon;
+  //! Number of categories of each dimension; 0 for numeric dimensions.
+  arma::Col<size_t> numCategories;
+  //! First column of each dimension in the categorical tables.
+  arma::Col<size_t> categoryOffsets;
+  //! Indices of the categorical dimensions.
+  arma::uvec categoricalDimensions;
+  //! Counts of each category of each categorical dimension for each class
+  //! (classes x total categories).
+  ModelMatType categoryCounts;
+  //! Log-probabilities of each category of each categorical dimension for each
+  //! class (classes x total categories).
+  ModelMatType logCategoryProbabilities;
+
+  /**
+   * Set the types of the dimensions, growing the categorical tables if there
+   * are new categories.  If the model has no dimension types of the right
+   * dimensionality yet, the tables are created empty.
+   *
+   * @param newNumCategories Number of categories of each dimension.
+   */
+  void SetCategories(const arma::Col<size_t>& newNumCategories);
+
+  /**
+   * Train on the given batch once the types of the dimensions are set.  The
+   * per-class statistics of the batch are accumulated in parallel and merged
+   * into the model.
+   *
+   * @param data The dataset to train on.
+   * @param labels The labels for the dataset.
+   * @param numClasses The number of classes in the dataset.
+   * @param incremental Whether or not to keep the current model.
+   */
+  template<typename MatType>
+  void TrainBatch(const MatType& data,
+                  const arma::Row<size_t>& labels,
+                  const size_t numClasses,
+                  const bool incremental);
+
+  /**
+   * Compute the log-probability lookup table of the given range of classes
+   * from the category counts.
+   *
+   * @param begin First class to update.
+   * @param end One past the last class to update.
+   */
+  void UpdateLogCategoryProbabilities(const size_t begin, const size_t end);
 
   /**
    * Compute the unnormalized posterior log probability of given points (log
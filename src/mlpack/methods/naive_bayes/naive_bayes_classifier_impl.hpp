@@ -6,8 +6,9 @@
  *
  * A Naive Bayes Classifier which parametrically estimates the distribution of
  * the features.  This classifier makes its predictions based on the assumption
- * that the features have been sampled from a set of Gaussians with diagonal
- * covariance.
+ * that the numeric features have been sampled from a set of Gaussians with
+ * diagonal covariance, and the categorical features from a set of categorical
+ * distributions.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
@@ -40,25 +41,30 @@ NaiveBayesClassifier<ModelMatType>::NaiveBayesClassifier(
       "NaiveBayesClassifier: element type of given data must match the element "
       "type of the model!");
 
-  // Perform training, after initializing the model to 0 (that is, if Train()
-  // won't do that for us, which it won't if we're using the incremental
-  // algorithm).
-  if (incremental)
-  {
-    probabilities.zeros(numClasses);
-    means.zeros(data.n_rows, numClasses);
-    variances.zeros(data.n_rows, numClasses);
-  }
-  else
-  {
-    probabilities.set_size(numClasses);
-    means.set_size(data.n_rows, numClasses);
-    variances.set_size(data.n_rows, numClasses);
-  }
-
+  // Train() will initialize the model to the right size.
   Train(data, labels, numClasses, incremental);
 }
 
+template<typename ModelMatType>
+template<typename MatType>
+NaiveBayesClassifier<ModelMatType>::NaiveBayesClassifier(
+    const MatType& data,
+    const data::DatasetInfo& datasetInfo,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const bool incremental,
+    const double epsilon) :
+    trainingPoints(0), // Set when we call Train().
+    epsilon(epsilon)
+{
+  static_assert(std::is_same<ElemType, typename MatType::elem_type>::value,
+      "NaiveBayesClassifier: element type of given data must match the element "
+      "type of the model!");
+
+  // Train() will initialize the model to the right size.
+  Train(data, datasetInfo, labels, numClasses, incremental);
+}
+
 template<typename ModelMatType>
 NaiveBayesClassifier<ModelMatType>::NaiveBayesClassifier(
     const size_t dimensionality,
@@ -71,12 +77,36 @@ NaiveBayesClassifier<ModelMatType>::NaiveBayesClassifier(
   probabilities.zeros(numClasses);
   means.zeros(dimensionality, numClasses);
   variances.zeros(dimensionality, numClasses);
+
+  // All dimensions are numeric.
+  SetCategories(arma::zeros<arma::Col<size_t>>(dimensionality));
+}
+
+template<typename ModelMatType>
+template<typename MatType>
+void NaiveBayesClassifier<ModelMatType>::Train(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const bool incremental)
+{
+  static_assert(std::is_same<ElemType, typename MatType::elem_type>::value,
+      "NaiveBayesClassifier: element type of given data must match the element "
+      "type of the model!");
+
+  // Any dimension types that were set before are kept; otherwise, all
+  // dimensions are numeric.
+  if (numCategories.n_elem != data.n_rows)
+    SetCategories(arma::zeros<arma::Col<size_t>>(data.n_rows));
+
+  TrainBatch(data, labels, numClasses, incremental);
 }
 
 template<typename ModelMatType>
 template<typename MatType>
 void NaiveBayesClassifier<ModelMatType>::Train(
     const MatType& data,
+    const data::DatasetInfo& datasetInfo,
     const arma::Row<size_t>& labels,
     const size_t numClasses,
     const bool incremental)
@@ -85,94 +115,156 @@ void NaiveBayesClassifier<ModelMatType>::Train(
       "NaiveBayesClassifier: element type of given data must match the element "
       "type of the model!");
 
-  // Do we need to resize the model?
-  if (probabilities.n_elem != numClasses)
+  if (datasetInfo.Dimensionality() != data.n_rows)
   {
-    // Perform training, after initializing the model to 0 (that is, if Train()
-    // won't do that for us, which it won't if we're using the incremental
-    // algorithm).
-    if (incremental)
-    {
-      probabilities.zeros(numClasses);
-      means.zeros(data.n_rows, numClasses);
-      variances.zeros(data.n_rows, numClasses);
-    }
-    else
-    {
-      probabilities.set_size(numClasses);
-      means.set_size(data.n_rows, numClasses);
-      variances.set_size(data.n_rows, numClasses);
-    }
+    std::ostringstream oss;
+    oss << "NaiveBayesClassifier::Train(): dimensionality of DatasetInfo ("
+        << datasetInfo.Dimensionality() << ") does not match dimensionality "
+        << "of data (" << data.n_rows << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  arma::Col<size_t> newNumCategories(data.n_rows);
+  for (size_t d = 0; d < data.n_rows; ++d)
+  {
+    newNumCategories[d] =
+        (datasetInfo.Type(d) == data::Datatype::categorical) ?
+        datasetInfo.NumMappings(d) : 0;
+  }
+
+  // Without the incremental algorithm, the old dimension types are forgotten
+  // along with the rest of the model.
+  if (!incremental)
+    numCategories.reset();
+  SetCategories(newNumCategories);
+
+  TrainBatch(data, labels, numClasses, incremental);
+}
+
+template<typename ModelMatType>
+template<typename MatType>
+void NaiveBayesClassifier<ModelMatType>::TrainBatch(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const bool incremental)
+{
+  // Do we need to reset the model?  This is also the case if the number of
+  // classes or the dimensionality has changed.
+  if (!incremental || probabilities.n_elem != numClasses ||
+      means.n_rows != data.n_rows)
+  {
+    probabilities.zeros(numClasses);
+    means.zeros(data.n_rows, numClasses);
+    variances.zeros(data.n_rows, numClasses);
+    categoryCounts.zeros(numClasses, categoryCounts.n_cols);
+    logCategoryProbabilities.zeros(numClasses, categoryCounts.n_cols);
+    trainingPoints = 0;
   }
 
-  // Calculate the class probabilities as well as the sample mean and variance
-  // for each of the features with respect to each of the labels.
-  if (incremental)
+  // Calculate the class counts as well as the sample mean and the sum of
+  // squared deviations from it for each of the features with respect to each
+  // of the labels, in two passes over the batch.  Each thread accumulates its
+  // own statistics, which are then summed.
+  ModelMatType batchCounts(numClasses, 1, arma::fill::zeros);
+  ModelMatType batchMeans(data.n_rows, numClasses, arma::fill::zeros);
+  ModelMatType batchCategoryCounts(numClasses, categoryCounts.n_cols,
+      arma::fill::zeros);
+
+  #pragma omp parallel
   {
-    // Use incremental algorithm.
-    // Fist, de-normalize probabilities.
-    probabilities *= trainingPoints;
+    ModelMatType localCounts(numClasses, 1, arma::fill::zeros);
+    ModelMatType localSums(data.n_rows, numClasses, arma::fill::zeros);
+    ModelMatType localCategoryCounts(numClasses, categoryCounts.n_cols,
+        arma::fill::zeros);
 
-    for (size_t j = 0; j < data.n_cols; ++j)
+    #pragma omp for
+    for (omp_size_t j = 0; j < (omp_size_t) data.n_cols; ++j)
     {
       const size_t label = labels[j];
-      ++probabilities[label];
-
-      arma::vec delta = data.col(j) - means.col(label);
-      means.col(label) += delta / probabilities[label];
-      variances.col(label) += delta % (data.col(j) - means.col(label));
+      ++localCounts[label];
+      localSums.col(label) += data.col(j);
+
+      // Values that are not a known category are ignored.
+      for (size_t k = 0; k < categoricalDimensions.n_elem; ++k)
+      {
+        const size_t d = categoricalDimensions[k];
+        const ElemType value = data(d, j);
+        if (value >= 0 && value < (ElemType) numCategories[d])
+          ++localCategoryCounts(label, categoryOffsets[d] + (size_t) value);
+      }
     }
 
-    for (size_t i = 0; i < probabilities.n_elem; ++i)
+    #pragma omp critical
     {
-      if (probabilities[i] > 2)
-        variances.col(i) /= (probabilities[i] - 1);
+      batchCounts += localCounts;
+      batchMeans += localSums;
+      batchCategoryCounts += localCategoryCounts;
     }
   }
-  else
+
+  for (size_t i = 0; i < numClasses; ++i)
+    if (batchCounts[i] != 0)
+      batchMeans.col(i) /= batchCounts[i];
+
+  ModelMatType batchSquares(data.n_rows, numClasses, arma::fill::zeros);
+  #pragma omp parallel
   {
-    // Set all parameters to zero.
-    probabilities.zeros();
-    means.zeros();
-    variances.zeros();
-
-    // Don't use incremental algorithm.  This is a two-pass algorithm.  It is
-    // possible to calculate the means and variances using a faster one-pass
-    // algorithm but there are some precision and stability issues.  If this is
-    // too slow, it's an option to use the faster algorithm by default and then
-    // have this (and the incremental algorithm) be other options.
-
-    // Calculate the means.
-    for (size_t j = 0; j < data.n_cols; ++j)
+    ModelMatType localSquares(data.n_rows, numClasses, arma::fill::zeros);
+
+    #pragma omp for
+    for (omp_size_t j = 0; j < (omp_size_t) data.n_cols; ++j)
     {
       const size_t label = labels[j];
-      ++probabilities[label];
-      means.col(label) += data.col(j);
+      localSquares.col(label) += arma::square(data.col(j) -
+          batchMeans.col(label));
     }
 
-    // Normalize means.
-    for (size_t i = 0; i < probabilities.n_elem; ++i)
-      if (probabilities[i] != 0.0)
-        means.col(i) /= probabilities[i];
+    #pragma omp critical
+    batchSquares += localSquares;
+  }
+
+  // Now merge the statistics of the batch into the model with the pairwise
+  // update of Chan et al.  The sum of squared deviations of the model is
+  // recovered from the variances (without epsilon).
+  ModelMatType classCounts = probabilities * trainingPoints;
+  for (size_t i = 0; i < numClasses; ++i)
+  {
+    const ElemType nB = batchCounts[i];
+    const ElemType nA = classCounts[i];
+    if (nB == 0)
+    {
+      // Add epsilon to prevent log of zero for classes without any points.
+      if (nA == 0)
+        variances.col(i).fill(epsilon);
+      continue;
+    }
 
-    // Calculate variances.
-    for (size_t j = 0; j < data.n_cols; ++j)
+    const ElemType n = nA + nB;
+    const arma::Col<ElemType> delta = batchMeans.col(i) - means.col(i);
+    arma::Col<ElemType> squares = batchSquares.col(i) +
+        arma::square(delta) * (nA * nB / n);
+    if (nA > 1)
     {
-      const size_t label = labels[j];
-      variances.col(label) += square(data.col(j) - means.col(label));
+      squares += arma::clamp(variances.col(i) - epsilon, 0,
+          std::numeric_limits<ElemType>::max()) * (nA - 1);
     }
 
-    // Normalize variances.
-    for (size_t i = 0; i < probabilities.n_elem; ++i)
-      if (probabilities[i] > 1)
-        variances.col(i) /= (probabilities[i] - 1);
-  }
+    means.col(i) += delta * (nB / n);
+    if (n > 1)
+      squares /= (n - 1);
 
-  // Add epsilon to prevent log of zero.
-  variances += epsilon;
+    // Add epsilon to prevent log of zero.
+    variances.col(i) = squares + epsilon;
+    classCounts[i] = n;
+  }
 
-  probabilities /= data.n_cols;
+  categoryCounts += batchCategoryCounts;
   trainingPoints += data.n_cols;
+  if (trainingPoints > 0)
+    probabilities = classCounts / trainingPoints;
+
+  UpdateLogCategoryProbabilities(0, numClasses);
 }
 
 template<typename ModelMatType>
@@ -198,6 +290,97 @@ void NaiveBayesClassifier<ModelMatType>::Train(const VecType& point,
 
   trainingPoints++;
   probabilities /= trainingPoints;
+
+  if (categoricalDimensions.n_elem > 0)
+  {
+    for (size_t k = 0; k < categoricalDimensions.n_elem; ++k)
+    {
+      const size_t d = categoricalDimensions[k];
+      const ElemType value = point[d];
+      if (value >= 0 && value < (ElemType) numCategories[d])
+        ++categoryCounts(label, categoryOffsets[d] + (size_t) value);
+    }
+
+    UpdateLogCategoryProbabilities(label, label + 1);
+  }
+}
+
+template<typename ModelMatType>
+void NaiveBayesClassifier<ModelMatType>::SetCategories(
+    const arma::Col<size_t>& newNumCategories)
+{
+  const bool keepCounts = (numCategories.n_elem == newNumCategories.n_elem);
+  arma::Col<size_t> mergedNumCategories = newNumCategories;
+  if (keepCounts)
+  {
+    for (size_t d = 0; d < numCategories.n_elem; ++d)
+    {
+      if ((numCategories[d] == 0) != (newNumCategories[d] == 0))
+      {
+        std::ostringstream oss;
+        oss << "NaiveBayesClassifier::Train(): type of dimension " << d
+            << " cannot change during incremental training!";
+        throw std::invalid_argument(oss.str());
+      }
+
+      // Never shrink the tables.
+      mergedNumCategories[d] = std::max(numCategories[d],
+          newNumCategories[d]);
+    }
+  }
+
+  arma::Col<size_t> newOffsets(mergedNumCategories.n_elem);
+  size_t totalCategories = 0;
+  for (size_t d = 0; d < mergedNumCategories.n_elem; ++d)
+  {
+    newOffsets[d] = totalCategories;
+    totalCategories += mergedNumCategories[d];
+  }
+
+  // Copy the counts of the known categories to their new positions.
+  ModelMatType newCounts(probabilities.n_elem, totalCategories,
+      arma::fill::zeros);
+  if (keepCounts && categoryCounts.n_rows == probabilities.n_elem)
+  {
+    for (size_t d = 0; d < numCategories.n_elem; ++d)
+    {
+      if (numCategories[d] > 0)
+      {
+        newCounts.cols(newOffsets[d], newOffsets[d] + numCategories[d] - 1) =
+            categoryCounts.cols(categoryOffsets[d],
+            categoryOffsets[d] + numCategories[d] - 1);
+      }
+    }
+  }
+
+  numCategories = std::move(mergedNumCategories);
+  categoryOffsets = std::move(newOffsets);
+  categoricalDimensions = arma::find(numCategories > 0);
+  categoryCounts = std::move(newCounts);
+  logCategoryProbabilities.zeros(categoryCounts.n_rows, categoryCounts.n_cols);
+  UpdateLogCategoryProbabilities(0, categoryCounts.n_rows);
+}
+
+template<typename ModelMatType>
+void NaiveBayesClassifier<ModelMatType>::UpdateLogCategoryProbabilities(
+    const size_t begin,
+    const size_t end)
+{
+  // With add-one smoothing, P(X_d = v | Y = c) = (count + 1) / (total + K).
+  for (size_t k = 0; k < categoricalDimensions.n_elem; ++k)
+  {
+    const size_t d = categoricalDimensions[k];
+    const size_t first = categoryOffsets[d];
+    const size_t last = first + numCategories[d] - 1;
+    for (size_t c = begin; c < end; ++c)
+    {
+      const ElemType total = arma::accu(categoryCounts.row(c).cols(first,
+          last)) + numCategories[d];
+      logCategoryProbabilities.row(c).cols(first, last) =
+          arma::log(categoryCounts.row(c).cols(first, last) + 1) -
+          std::log(total);
+    }
+  }
 }
 
 template<typename ModelMatType>
@@ -210,23 +393,47 @@ void NaiveBayesClassifier<ModelMatType>::LogLikelihood(
       "NaiveBayesClassifier: element type of given data must match the element "
       "type of the model!");
 
-  logLikelihoods = arma::log(arma::repmat(probabilities, 1, data.n_cols));
+  // This is an adaptation of gmm::phi() for the case where the covariance is a
+  // diagonal matrix.  Expanding (x - mu)^2 / sigma^2, the only terms that
+  // depend on the points are matrix products, so the log likelihoods of all
+  // points and classes are computed at once.  Categorical dimensions do not
+  // contribute to the Gaussian terms.
   ModelMatType invVar = 1.0 / variances;
+  ModelMatType logVar = arma::log(variances);
+  if (categoricalDimensions.n_elem > 0)
+  {
+    invVar.rows(categoricalDimensions).zeros();
+    logVar.rows(categoricalDimensions).zeros();
+  }
+  const ModelMatType scaledMeans = means % invVar;
+  const size_t numericDimensions = data.n_rows - categoricalDimensions.n_elem;
 
-  // Calculate the joint log likelihood of point for each of the
-  // means.n_cols.
+  // The terms that depend only on the class, as a column.
+  const ModelMatType classTerms = arma::log(probabilities) + (numericDimensions
+      / -2.0 * log(2 * M_PI) - 0.5 * (arma::sum(logVar, 0) +
+      arma::sum(means % scaledMeans, 0))).t();
 
-  // Loop over every class.
-  for (size_t i = 0; i < means.n_cols; ++i)
+  logLikelihoods = scaledMeans.t() * data - 0.5 * (invVar.t() *
+      arma::square(data));
+  logLikelihoods.each_col() += classTerms;
+
+  // Add the log-probabilities of the categories from the lookup table.
+  if (categoricalDimensions.n_elem > 0)
   {
-    // This is an adaptation of gmm::phi() for the case where the covariance is
-    // a diagonal matrix.
-    ModelMatType diffs = data - arma::repmat(means.col(i), 1, data.n_cols);
-    ModelMatType rhs = -0.5 * arma::diagmat(invVar.col(i)) * diffs;
-    arma::Mat<ElemType> exponents = arma::sum(diffs % rhs, 0);
-
-    logLikelihoods.row(i) += (data.n_rows / -2.0 * log(2 * M_PI) - 0.5 *
-        arma::accu(arma::log(variances.col(i))) + exponents);
+    #pragma omp parallel for
+    for (omp_size_t j = 0; j < (omp_size_t) data.n_cols; ++j)
+    {
+      for (size_t k = 0; k < categoricalDimensions.n_elem; ++k)
+      {
+        const size_t d = categoricalDimensions[k];
+        const ElemType value = data(d, j);
+        if (value >= 0 && value < (ElemType) numCategories[d])
+        {
+          logLikelihoods.col(j) += logCategoryProbabilities.col(
+              categoryOffsets[d] + (size_t) value);
+        }
+      }
+    }
   }
 }
 
@@ -296,7 +503,8 @@ void NaiveBayesClassifier<ModelMatType>::Classify(
   ModelMatType logLikelihoods;
   LogLikelihood(data, logLikelihoods);
 
-  for (size_t i = 0; i < data.n_cols; ++i)
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
   {
     arma::uword maxIndex = 0;
     logLikelihoods.unsafe_col(i).max(maxIndex);
@@ -325,21 +533,22 @@ void NaiveBayesClassifier<ModelMatType>::Classify(
   LogLikelihood(data, logLikelihoods);
 
   predictionProbs.set_size(arma::size(logLikelihoods));
-  double maxValue, logProbX;
-  for (size_t j = 0; j < data.n_cols; ++j)
+  #pragma omp parallel for
+  for (omp_size_t j = 0; j < (omp_size_t) data.n_cols; ++j)
   {
     // The LogLikelihood() gives us the unnormalized log likelihood which is
     // Log(Prob(X|Y)) + Log(Prob(Y)), so we subtract the normalization term.
     // Besides, to prevent underflow in log of sum of exp of x operation (where
     // x is a small negative value), we use logsumexp(x - max(x)) + max(x).
-    maxValue = arma::max(logLikelihoods.col(j));
-    logProbX = log(arma::accu(exp(logLikelihoods.col(j) -
+    const double maxValue = arma::max(logLikelihoods.col(j));
+    const double logProbX = log(arma::accu(exp(logLikelihoods.col(j) -
         maxValue))) + maxValue;
     predictionProbs.col(j) = arma::exp(logLikelihoods.col(j) - logProbX);
   }
 
   // Now calculate maximum probabilities for each point.
-  for (size_t i = 0; i < data.n_cols; ++i)
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
   {
     arma::uword maxIndex = 0;
     logLikelihoods.unsafe_col(i).max(maxIndex);
@@ -351,14 +560,50 @@ template<typename ModelMatType>
 template<typename Archive>
 void NaiveBayesClassifier<ModelMatType>::serialize(
     Archive& ar,
-    const uint32_t /* version */)
+    const uint32_t version)
 {
   ar(CEREAL_NVP(means));
   ar(CEREAL_NVP(variances));
   ar(CEREAL_NVP(probabilities));
+  if (version >= 1)
+  {
+    ar(CEREAL_NVP(trainingPoints));
+    ar(CEREAL_NVP(epsilon));
+    ar(CEREAL_NVP(numCategories));
+    ar(CEREAL_NVP(categoryCounts));
+  }
+  else if (cereal::is_loading<Archive>())
+  {
+    // Older models only have numeric dimensions, and the number of points
+    // they were trained on is unknown.
+    trainingPoints = 0;
+    numCategories.zeros(means.n_rows);
+    categoryCounts.set_size(probabilities.n_elem, 0);
+  }
+
+  // The lookup table and offsets are recomputed from the counts.
+  if (cereal::is_loading<Archive>())
+  {
+    categoryOffsets.set_size(numCategories.n_elem);
+    size_t totalCategories = 0;
+    for (size_t d = 0; d < numCategories.n_elem; ++d)
+    {
+      categoryOffsets[d] = totalCategories;
+      totalCategories += numCategories[d];
+    }
+    categoricalDimensions = arma::find(numCategories > 0);
+    logCategoryProbabilities.zeros(categoryCounts.n_rows,
+        categoryCounts.n_cols);
+    UpdateLogCategoryProbabilities(0, categoryCounts.n_rows);
+  }
 }
 
 } // namespace naive_bayes
 } // namespace mlpack
 
+// Version 1 adds the number of training points, epsilon and the categorical
+// dimensions.
+CEREAL_TEMPLATE_CLASS_VERSION((template<typename ModelMatType>),
+    (mlpack::naive_bayes::NaiveBayesClassifier<ModelMatType>), (1));
+
 #endif
@@ -86,6 +86,13 @@ class NCA
   const OptimizerType& Optimizer() const { return optimizer; }
   OptimizerType& Optimizer() { return optimizer; }
 
+  //! Get the number of nearest neighbors the softmax of each point is
+  //! restricted to (0 means all the other points are used).
+  size_t NumNeighbors() const { return errorFunction.NumNeighbors(); }
+  //! Modify the number of nearest neighbors the softmax of each point is
+  //! restricted to (0 means all the other points are used).
+  size_t& NumNeighbors() { return errorFunction.NumNeighbors(); }
+
  private:
   //! Dataset reference.
   const arma::mat& dataset;
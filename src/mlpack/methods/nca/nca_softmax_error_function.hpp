@@ -17,6 +17,7 @@
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/math/make_alias.hpp>
 #include <mlpack/core/math/shuffle_data.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 
 namespace mlpack {
 namespace nca {
@@ -38,8 +39,17 @@ namespace nca {
  *
  * In addition to the standard Evaluate() and Gradient() functions which mlpack
  * optimizers use, overloads of Evaluate() and Gradient() are given which only
- * operate on one point in the dataset.  This is useful for optimizers like
- * stochastic gradient descent (see mlpack::optimization::SGD).
+ * operate on a batch of points in the dataset.  This is useful for optimizers
+ * like stochastic gradient descent (see mlpack::optimization::SGD).  The points
+ * of a batch are handled in parallel if mlpack is compiled with OpenMP, and the
+ * gradient is assembled with matrix multiplications.
+ *
+ * Each evaluation still scans the whole dataset for each point of the batch.
+ * For large datasets the softmax of each point can instead be restricted to its
+ * NumNeighbors() nearest neighbors in the stretched space, which are found with
+ * a dual-tree search; the contributions of farther points are exponentially
+ * small and are dropped.  The tree is rebuilt at each evaluation, so this is
+ * worth it for large batches and for the non-separable functions.
  */
 template<typename MetricType = metric::SquaredEuclideanDistance>
 class SoftmaxErrorFunction
@@ -120,6 +130,35 @@ class SoftmaxErrorFunction
                 GradType& gradient,
                 const size_t batchSize = 1);
 
+  /**
+   * Evaluate the softmax function and its gradient for the given covariance
+   * matrix.  This is the non-separable implementation, where the objective
+   * function is not decomposed into the sum of several objective functions.
+   *
+   * @param covariance Covariance matrix of Mahalanobis distance.
+   * @param gradient Matrix to store the calculated gradient in.
+   */
+  double EvaluateWithGradient(const arma::mat& covariance,
+                              arma::mat& gradient);
+
+  /**
+   * Evaluate the softmax objective function and its gradient for the given
+   * covariance matrix on the given batch size, from a given initial point of
+   * the dataset.  This is the separable implementation, where the objective
+   * function is decomposed into the sum of many objective functions.
+   *
+   * @tparam GradType The type of the gradient out-param.
+   * @param covariance Covariance matrix of Mahalanobis distance.
+   * @param begin Index of the initial point to use for objective function.
+   * @param gradient Matrix to store the calculated gradient in.
+   * @param batchSize Number of points to use for objective function.
+   */
+  template <typename GradType>
+  double EvaluateWithGradient(const arma::mat& covariance,
+                              const size_t begin,
+                              GradType& gradient,
+                              const size_t batchSize = 1);
+
   /**
    * Get the initial point.
    */
@@ -131,7 +170,18 @@ class SoftmaxErrorFunction
    */
   size_t NumFunctions() const { return dataset.n_cols; }
 
+  //! Get the number of nearest neighbors each softmax is restricted to (0
+  //! means all the other points are used).
+  size_t NumNeighbors() const { return numNeighbors; }
+  //! Modify the number of nearest neighbors each softmax is restricted to (0
+  //! means all the other points are used).
+  size_t& NumNeighbors() { return numNeighbors; }
+
  private:
+  //! Convenience typedef for the nearest neighbor search.
+  typedef neighbor::NeighborSearch<neighbor::NearestNeighborSort, MetricType>
+      KNN;
+
   //! The dataset.  This is an alias until Shuffle() is called.
   arma::mat dataset;
   //! Labels for each point in the dataset.  This is an alias until Shuffle() is
@@ -141,33 +191,32 @@ class SoftmaxErrorFunction
   //! The instantiated metric.
   MetricType metric;
 
-  //! Last coordinates.  Used for the non-separable Evaluate() and Gradient().
-  arma::mat lastCoordinates;
   //! Stretched dataset.  Kept internal to avoid memory reallocations.
   arma::mat stretchedDataset;
-  //! Holds calculated p_i, for the non-separable Evaluate() and Gradient().
-  arma::vec p;
-  //! Holds denominators for calculation of p_ij, for the non-separable
-  //! Evaluate() and Gradient().
-  arma::vec denominators;
 
-  //! False if nothing has ever been precalculated (only at construction time).
-  bool precalculated;
+  //! The number of nearest neighbors each softmax is restricted to (0 means
+  //! no restriction).
+  size_t numNeighbors;
+
+  //! The number of points whose probabilities are held in memory at once when
+  //! the softmax is not restricted.
+  static constexpr size_t BlockSize = 128;
 
   /**
-   * Precalculate the denominators and numerators that will make up the p_ij,
-   * but only if the coordinates matrix is different than the last coordinates
-   * the Precalculate() method was run with.  This method is only called by the
-   * non-separable Evaluate() and Gradient().
+   * Compute the sum of p_i over the points [begin, begin + batchSize) of the
+   * stretched dataset, which must be up to date.  If sum is not NULL, it is set
+   * to
+   *
+   * sum_i sum_k p_ik (p_i - [x_k in class of x_i]) x_ik x_ik^T,
    *
-   * This will update last_coordinates_ and stretched_dataset_, and also
-   * calculate the p_i and denominators_ which are used in the calculation of
-   * p_i or p_ij.  The calculation will be O((n * (n + 1)) / 2), which is not
-   * great.
+   * so that the gradient of the sum of p_i is 2 * A * sum.  The points are
+   * handled in blocks of BlockSize, each block in parallel.
    *
-   * @param coordinates Coordinates matrix to use for precalculation.
+   * @param begin Index of the first point.
+   * @param batchSize Number of points.
+   * @param sum Matrix to store the weighted sum of outer products in, or NULL.
    */
-  void Precalculate(const arma::mat& coordinates);
+  double Softmax(const size_t begin, const size_t batchSize, arma::mat* sum);
 };
 
 } // namespace nca
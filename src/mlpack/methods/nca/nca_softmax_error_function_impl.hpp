@@ -17,6 +17,10 @@
 
 #include <mlpack/core.hpp>
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace nca {
 
@@ -29,7 +33,7 @@ SoftmaxErrorFunction<MetricType>::SoftmaxErrorFunction(
     dataset(math::MakeAlias(const_cast<arma::mat&>(dataset), false)),
     labels(math::MakeAlias(const_cast<arma::Row<size_t>&>(labels), false)),
     metric(metric),
-    precalculated(false)
+    numNeighbors(0)
 { /* nothing to do */ }
 
 //! Shuffle the dataset.
@@ -48,111 +52,33 @@ void SoftmaxErrorFunction<MetricType>::Shuffle()
   labels = std::move(newLabels);
 }
 
-//! The non-separable implementation, which uses Precalculate() to save time.
+//! The non-separable implementation.
 template<typename MetricType>
 double SoftmaxErrorFunction<MetricType>::Evaluate(const arma::mat& coordinates)
 {
-  // Calculate the denominators and numerators, if necessary.
-  Precalculate(coordinates);
-
-  return -accu(p); // Sum of p_i for all i.  We negate because our solver
-                   // minimizes, not maximizes.
-};
+  return Evaluate(coordinates, 0, dataset.n_cols);
+}
 
-//! The separated objective function, which does not use Precalculate(),
-//! for a given batch size and from an initial index.
+//! The separated objective function, for a given batch size and from an
+//! initial index.
 template<typename MetricType>
 double SoftmaxErrorFunction<MetricType>::Evaluate(const arma::mat& coordinates,
                                                   const size_t begin,
                                                   const size_t batchSize)
 {
-  // Unfortunately each evaluation will take O(N) time because it requires a
-  // scan over all points in the dataset.  Our objective is to compute p_i.
-  double denominator = 0;
-  double numerator = 0;
-  double result = 0;
-
   // It's quicker to do this now than one point at a time later.
   stretchedDataset = coordinates * dataset;
-  for (size_t i = begin; i < begin + batchSize; ++i)
-  {
-    for (size_t k = 0; k < dataset.n_cols; ++k)
-    {
-      // Don't consider the case where the points are the same.
-      if (k == i)
-        continue;
-
-      // We want to evaluate exp(-D(A x_i, A x_k)).
-      double eval = std::exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                              stretchedDataset.unsafe_col(k)));
-
-      // If they are in the same class, update the numerator.
-      if (labels[i] == labels[k])
-        numerator += eval;
 
-      denominator += eval;
-    }
-
-    // Now the result is just a simple division, but we have to be sure that the
-    // denominator is not 0.
-    if (denominator == 0.0)
-    {
-      Log::Warn << "Denominator of p_" << i << " is 0!" << std::endl;
-      continue;
-    }
-
-    result += -(numerator / denominator); // Negate because the optimizer is a
-                                          // minimizer.
-  }
-  return result;
+  // Negate because the optimizer is a minimizer.
+  return -Softmax(begin, batchSize, NULL);
 }
 
-//! The non-separable implementation, where Precalculate() is used.
+//! The non-separable implementation.
 template<typename MetricType>
 void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
                                                 arma::mat& gradient)
 {
-  // Calculate the denominators and numerators, if necessary.
-  Precalculate(coordinates);
-
-  // Now, we handle the summation over i:
-  //   sum_i (p_i sum_k (p_ik x_ik x_ik^T) -
-  //       sum_{j in class of i} (p_ij x_ij x_ij^T)
-  // We can algebraically manipulate the whole thing to produce a more
-  // memory-friendly way to calculate this.  Looping over each i and k (again
-  // O((n * (n + 1)) / 2) as with the last step, we can add the following to the
-  // sum:
-  //
-  //   if class of i is the same as the class of k, add
-  //     (((p_i - (1 / p_i)) p_ik) + ((p_k - (1 / p_k)) p_ki)) x_ik x_ik^T
-  //   otherwise, add
-  //     (p_i p_ik + p_k p_ki) x_ik x_ik^T
-  arma::mat sum;
-  sum.zeros(stretchedDataset.n_rows, stretchedDataset.n_rows);
-  for (size_t i = 0; i < stretchedDataset.n_cols; ++i)
-  {
-    for (size_t k = (i + 1); k < stretchedDataset.n_cols; ++k)
-    {
-      // Calculate p_ik and p_ki first.
-      double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                         stretchedDataset.unsafe_col(k)));
-      double p_ik = 0, p_ki = 0;
-      p_ik = eval / denominators(i);
-      p_ki = eval / denominators(k);
-
-      // Subtract x_i from x_k.  We are not using stretched points here.
-      arma::vec x_ik = dataset.col(i) - dataset.col(k);
-      arma::mat secondTerm = (x_ik * trans(x_ik));
-
-      if (labels[i] == labels[k])
-        sum += ((p[i] - 1) * p_ik + (p[k] - 1) * p_ki) * secondTerm;
-      else
-        sum += (p[i] * p_ik + p[k] * p_ki) * secondTerm;
-    }
-  }
-
-  // Assemble the final gradient.
-  gradient = -2 * coordinates * sum;
+  EvaluateWithGradient(coordinates, 0, gradient, dataset.n_cols);
 }
 
 //! The separable implementation for a given batch size and an initial index.
@@ -163,72 +89,36 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
                                                 GradType& gradient,
                                                 const size_t batchSize)
 {
-  // The gradient involves two matrix terms which are eventually combined into
-  // one.
-  GradType firstTerm, secondTerm;
-  // We will need to calculate p_i before this evaluation is done, so
-  // these two variables will hold the information necessary for that.
-  double numerator, denominator;
+  EvaluateWithGradient(coordinates, begin, gradient, batchSize);
+}
 
-  gradient.zeros(coordinates.n_rows, coordinates.n_rows);
+//! The non-separable implementation.
+template<typename MetricType>
+double SoftmaxErrorFunction<MetricType>::EvaluateWithGradient(
+    const arma::mat& coordinates,
+    arma::mat& gradient)
+{
+  return EvaluateWithGradient(coordinates, 0, gradient, dataset.n_cols);
+}
 
+//! The separable implementation for a given batch size and an initial index.
+template <typename MetricType>
+template <typename GradType>
+double SoftmaxErrorFunction<MetricType>::EvaluateWithGradient(
+    const arma::mat& coordinates,
+    const size_t begin,
+    GradType& gradient,
+    const size_t batchSize)
+{
   // Compute the stretched dataset.
   stretchedDataset = coordinates * dataset;
-  for (size_t i = begin; i < begin + batchSize; ++i)
-  {
-    numerator = 0;
-    denominator = 0;
-
-    firstTerm.zeros(coordinates.n_rows, coordinates.n_cols);
-    secondTerm.zeros(coordinates.n_rows, coordinates.n_cols);
-
-    for (size_t k = 0; k < dataset.n_cols; ++k)
-    {
-      // Don't consider the case where the points are the same.
-      if (i == k)
-        continue;
-
-      // Calculate the numerator of p_ik.
-      double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                         stretchedDataset.unsafe_col(k)));
-
-      // If the points are in the same class, we must add to the second term of
-      // the gradient as well as the numerator of p_i.  We will divide by the
-      // denominator of p_ik later.  For x_ik we are not using stretched points.
-      GradType x_ik = dataset.col(i) - dataset.col(k);
-      if (labels[i] == labels[k])
-      {
-        numerator += eval;
-        secondTerm += eval * x_ik * trans(x_ik);
-      }
-
-      // We always have to add to the denominator of p_i
-      // and the first term of the gradient computation.
-      // We will divide by the denominator of p_ik later.
-      denominator += eval;
-      firstTerm += eval * x_ik * trans(x_ik);
-    }
 
-    // Calculate p_i.
-    double p = 0;
-    if (denominator == 0)
-    {
-      Log::Warn << "Denominator of p_" << i << " is 0!" << std::endl;
-      // If the denominator is zero, then all p_ik should be zero and there is
-      // no gradient contribution from this point.
-      continue;
-    }
-    else
-    {
-      p = numerator / denominator;
-      firstTerm /= denominator;
-      secondTerm /= denominator;
-    }
+  arma::mat sum;
+  const double objective = -Softmax(begin, batchSize, &sum);
 
-    // Now multiply the first term by p_i, and add the two together and multiply
-    // all by 2 * A.  We negate it though, because our optimizer is a minimizer.
-    gradient += -2 * coordinates * (p * firstTerm - secondTerm);
-  }
+  // We negate the gradient too, because our optimizer is a minimizer.
+  gradient = -2 * coordinates * sum;
+  return objective;
 }
 
 template<typename MetricType>
@@ -238,72 +128,167 @@ const arma::mat SoftmaxErrorFunction<MetricType>::GetInitialPoint() const
 }
 
 template<typename MetricType>
-void SoftmaxErrorFunction<MetricType>::Precalculate(
-    const arma::mat& coordinates)
+double SoftmaxErrorFunction<MetricType>::Softmax(const size_t begin,
+                                                 const size_t batchSize,
+                                                 arma::mat* sum)
 {
-  // Ensure it is the right size.
-  if (lastCoordinates.n_rows != coordinates.n_rows ||
-      lastCoordinates.n_cols != coordinates.n_cols)
+  // If the softmax is restricted, find the candidate neighbors of all points at
+  // once.  Each point is usually its own nearest neighbor, so one more neighbor
+  // is searched for.
+  const bool restricted = (numNeighbors > 0) &&
+      (numNeighbors + 1 < dataset.n_cols);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  if (restricted && batchSize > 0)
   {
-    lastCoordinates.set_size(coordinates.n_rows, coordinates.n_cols);
+    KNN knn(stretchedDataset, neighbor::DUAL_TREE_MODE, 0.0, metric);
+    knn.ParallelDepth() = 4;
+    knn.Search(stretchedDataset.cols(begin, begin + batchSize - 1),
+        numNeighbors + 1, neighbors, distances);
   }
-  else if ((accu(coordinates == lastCoordinates) == coordinates.n_elem) &&
-      precalculated)
+
+  // The gradient is a sum of outer products of differences between points,
+  // which we expand into products of whole matrices.  Centering the points
+  // first avoids cancellation in the expansion.
+  arma::mat centered;
+  arma::vec referenceWeights;
+  if (sum != NULL)
   {
-    return; // No need to calculate; we already have this stuff saved.
+    centered = dataset.each_col() - arma::mean(dataset, 1);
+    referenceWeights.zeros(dataset.n_cols);
+    sum->zeros(dataset.n_rows, dataset.n_rows);
   }
 
-  // Coordinates are different; save the new ones, and stretch the dataset.
-  lastCoordinates = coordinates;
-  stretchedDataset = coordinates * dataset;
-
-  // For each point i, we must evaluate the softmax function:
-  //   p_ij = exp( -K(x_i, x_j) ) / ( sum_{k != i} ( exp( -K(x_i, x_k) )))
-  //   p_i = sum_{j in class of i} p_ij
-  // We will do this by keeping track of the denominators for each i as well as
-  // the numerators (the sum for all j in class of i).  This will be on the
-  // order of O((n * (n + 1)) / 2), which really isn't all that great.
-  p.zeros(stretchedDataset.n_cols);
-  denominators.zeros(stretchedDataset.n_cols);
-  for (size_t i = 0; i < stretchedDataset.n_cols; ++i)
+  double result = 0;
+  size_t zeroDenominators = 0;
+  const size_t blockSize = restricted ? std::max(batchSize, (size_t) 1) :
+      BlockSize;
+  for (size_t blockBegin = begin; blockBegin < begin + batchSize;
+       blockBegin += blockSize)
   {
-    for (size_t j = (i + 1); j < stretchedDataset.n_cols; ++j)
+    const size_t numPoints = std::min(blockSize,
+        begin + batchSize - blockBegin);
+
+    // Column b holds p_ik for the b'th point of the block, for each candidate
+    // neighbor k; then, if the gradient is needed, the weight of x_ik x_ik^T.
+    arma::mat probabilities(restricted ? neighbors.n_rows : dataset.n_cols,
+        numPoints);
+    arma::vec pointProbabilities(numPoints);
+
+    #pragma omp parallel for reduction(+: zeroDenominators)
+    for (omp_size_t b = 0; b < (omp_size_t) numPoints; ++b)
     {
-      // Evaluate exp(-d(x_i, x_j)).
-      double eval = exp(-metric.Evaluate(stretchedDataset.unsafe_col(i),
-                                         stretchedDataset.unsafe_col(j)));
+      const size_t i = blockBegin + b;
+      double* column = probabilities.colptr(b);
+
+      // Compute the distance to each candidate.  Don't consider the case where
+      // the points are the same.
+      double minDistance = DBL_MAX;
+      for (size_t c = 0; c < probabilities.n_rows; ++c)
+      {
+        const size_t k = restricted ? neighbors(c, i - begin) : c;
+        if (k == i)
+          continue;
+
+        column[c] = restricted ? distances(c, i - begin) :
+            metric.Evaluate(stretchedDataset.unsafe_col(i),
+                            stretchedDataset.unsafe_col(k));
+        minDistance = std::min(minDistance, column[c]);
+      }
+
+      // We want exp(-D(A x_i, A x_k)), but p_ik does not change if every
+      // distance is shifted by the smallest one, and that keeps the largest
+      // term from underflowing.
+      double numerator = 0;
+      double denominator = 0;
+      for (size_t c = 0; c < probabilities.n_rows; ++c)
+      {
+        const size_t k = restricted ? neighbors(c, i - begin) : c;
+        column[c] = (k == i) ? 0.0 : std::exp(minDistance - column[c]);
+
+        // If they are in the same class, update the numerator.
+        if (labels[i] == labels[k])
+          numerator += column[c];
+        denominator += column[c];
+      }
+
+      // The denominator can only be 0 if there are no other points.
+      if (denominator == 0.0)
+      {
+        ++zeroDenominators;
+        pointProbabilities[b] = 0.0;
+        probabilities.col(b).zeros();
+        continue;
+      }
 
-      // Add this to the denominators of both p_i and p_j: K(i, j) = K(j, i).
-      denominators[i] += eval;
-      denominators[j] += eval;
+      const double p = numerator / denominator;
+      pointProbabilities[b] = p;
+      if (sum == NULL)
+        continue;
 
-      // If i and j are the same class, add to numerator of both.
-      if (labels[i] == labels[j])
+      for (size_t c = 0; c < probabilities.n_rows; ++c)
       {
-        p[i] += eval;
-        p[j] += eval;
+        const size_t k = restricted ? neighbors(c, i - begin) : c;
+        column[c] *= (p - ((labels[i] == labels[k]) ? 1.0 : 0.0)) /
+            denominator;
       }
     }
-  }
 
-  // Divide p_i by their denominators.
-  p /= denominators;
+    result += arma::accu(pointProbabilities);
+    if (sum == NULL)
+      continue;
 
-  // Clean up any bad values.
-  for (size_t i = 0; i < stretchedDataset.n_cols; ++i)
-  {
-    if (denominators[i] == 0.0)
+    // Now probabilities holds the weight w_ik of each x_ik x_ik^T, and
+    //   sum_i sum_k w_ik x_ik x_ik^T = sum_i (sum_k w_ik) x_i x_i^T +
+    //       sum_k (sum_i w_ik) x_k x_k^T - sum_i x_i (sum_k w_ik x_k)^T -
+    //       sum_i (sum_k w_ik x_k) x_i^T.
+    // The second term is accumulated over all blocks and added at the end.
+    const arma::mat points = centered.cols(blockBegin,
+        blockBegin + numPoints - 1);
+    arma::mat weightedNeighbors;
+    if (restricted)
     {
-      Log::Debug << "Denominator of p_{" << i << ", j} is 0." << std::endl;
+      weightedNeighbors.zeros(dataset.n_rows, numPoints);
+      #pragma omp parallel for
+      for (omp_size_t b = 0; b < (omp_size_t) numPoints; ++b)
+      {
+        for (size_t c = 0; c < probabilities.n_rows; ++c)
+        {
+          weightedNeighbors.col(b) += probabilities(c, b) *
+              centered.col(neighbors(c, blockBegin + b - begin));
+        }
+      }
 
-      // Set to usable values.
-      denominators[i] = std::numeric_limits<double>::infinity();
-      p[i] = 0;
+      for (size_t b = 0; b < numPoints; ++b)
+      {
+        for (size_t c = 0; c < probabilities.n_rows; ++c)
+        {
+          referenceWeights[neighbors(c, blockBegin + b - begin)] +=
+              probabilities(c, b);
+        }
+      }
+    }
+    else
+    {
+      weightedNeighbors = centered * probabilities;
+      referenceWeights += arma::sum(probabilities, 1);
     }
+
+    const arma::mat cross = points * weightedNeighbors.t();
+    *sum += (points.each_row() % arma::sum(probabilities, 0)) * points.t() -
+        cross - cross.t();
   }
 
-  // We've done a precalculation.  Mark it as done.
-  precalculated = true;
+  if (zeroDenominators > 0)
+  {
+    Log::Warn << "Denominator of p_i is 0 for " << zeroDenominators
+        << " points!" << std::endl;
+  }
+
+  if (sum != NULL)
+    *sum += (centered.each_row() % referenceWeights.t()) * centered.t();
+
+  return result;
 }
 
 } // namespace nca
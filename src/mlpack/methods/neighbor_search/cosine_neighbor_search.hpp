@@ -0,0 +1,156 @@
+/**
+ * @file methods/neighbor_search/cosine_neighbor_search.hpp
+ *
+ * Defines the CosineNeighborSearch class, which performs k-nearest (or
+ * furthest) neighbor search with the cosine distance by searching the points
+ * normalized to unit length with the Euclidean distance.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_COSINE_NEIGHBOR_SEARCH_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_COSINE_NEIGHBOR_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "neighbor_search.hpp"
+
+namespace mlpack {
+namespace neighbor /** Neighbor-search routines. */ {
+
+/**
+ * CosineNeighborSearch finds the neighbors of points with the cosine distance
+ *
+ * @f[
+ * d(a, b) = 1 - \frac{a^T b}{|| a || || b ||}.
+ * @f]
+ *
+ * For points a and b of unit length, the Euclidean distance satisfies
+ * ||a - b||^2 = 2 - 2 a^T b, so the cosine distance is ||a - b||^2 / 2, and
+ * ordering the points by cosine distance is the same as ordering them by
+ * Euclidean distance.  The reference points are thus normalized to unit length
+ * once, when the object is trained, and searched with NeighborSearch and the
+ * Euclidean distance; this uses the same tree pruning and the same batched
+ * leaf computations as Euclidean search, instead of evaluating the cosine
+ * distance pair by pair.  The query points are normalized before each search,
+ * and the Euclidean distances are converted back to cosine distances.
+ *
+ * Points of zero length have no direction; their distances are not meaningful.
+ *
+ * @code
+ * extern arma::mat referenceSet, querySet;
+ * CosineNeighborSearch<> search(std::move(referenceSet));
+ * arma::Mat<size_t> neighbors;
+ * arma::mat distances; // 1 - cos(query, neighbor).
+ * search.Search(querySet, 5, neighbors, distances);
+ * @endcode
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = tree::KDTree>
+class CosineNeighborSearch
+{
+ public:
+  //! The type of the Euclidean search on the normalized points.
+  typedef NeighborSearch<SortPolicy, metric::EuclideanDistance, arma::mat,
+      TreeType> SearchType;
+
+  /**
+   * Initialize the object without any reference points; Train() must be
+   * called before searching.
+   *
+   * @param mode Neighbor search mode.
+   * @param epsilon Relative approximate error (non-negative) of the Euclidean
+   *     distances between the normalized points.
+   */
+  CosineNeighborSearch(const NeighborSearchMode mode = DUAL_TREE_MODE,
+                       const double epsilon = 0);
+
+  /**
+   * Initialize the object with the given reference points, which are
+   * normalized to unit length.  Use std::move() to normalize the points in
+   * place instead of copying them.
+   *
+   * @param referenceSet Set of reference points.
+   * @param mode Neighbor search mode.
+   * @param epsilon Relative approximate error (non-negative) of the Euclidean
+   *     distances between the normalized points.
+   */
+  CosineNeighborSearch(arma::mat referenceSet,
+                       const NeighborSearchMode mode = DUAL_TREE_MODE,
+                       const double epsilon = 0);
+
+  /**
+   * Set the reference points, which are normalized to unit length, and build
+   * the tree.  Use std::move() to normalize the points in place instead of
+   * copying them.
+   *
+   * @param referenceSet Set of reference points.
+   */
+  void Train(arma::mat referenceSet);
+
+  /**
+   * For each point in the query set, find the k best neighbors in the reference
+   * set by cosine distance.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing the list of neighbors of each query point.
+   * @param distances Matrix storing the cosine distances to the neighbors.
+   */
+  void Search(const arma::mat& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
+  /**
+   * For each point in the reference set, find the k best neighbors in the
+   * reference set (excluding the point itself) by cosine distance.
+   *
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing the list of neighbors of each point.
+   * @param distances Matrix storing the cosine distances to the neighbors.
+   */
+  void Search(const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
+  /**
+   * Normalize every column of the given matrix to unit length, in place.
+   * Columns of zero length are left unchanged.
+   *
+   * @param points Points to normalize.
+   */
+  static void Normalize(arma::mat& points);
+
+  //! Get the normalized reference points.
+  const arma::mat& ReferenceSet() const { return search.ReferenceSet(); }
+
+  //! Get the Euclidean search on the normalized points.
+  const SearchType& EuclideanSearch() const { return search; }
+  //! Modify the Euclidean search on the normalized points.  Points given to it
+  //! directly must already be normalized.
+  SearchType& EuclideanSearch() { return search; }
+
+ private:
+  //! Convert Euclidean distances between points of unit length to cosine
+  //! distances, in place.
+  static void ToCosineDistances(arma::mat& distances);
+
+  //! The Euclidean search on the normalized points.
+  SearchType search;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "cosine_neighbor_search_impl.hpp"
+
+#endif
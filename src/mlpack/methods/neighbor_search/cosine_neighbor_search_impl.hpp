@@ -0,0 +1,106 @@
+/**
+ * @file methods/neighbor_search/cosine_neighbor_search_impl.hpp
+ *
+ * Implementation of the CosineNeighborSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_COSINE_NEIGHBOR_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_COSINE_NEIGHBOR_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "cosine_neighbor_search.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename SortPolicy,
+         template<typename, typename, typename> class TreeType>
+CosineNeighborSearch<SortPolicy, TreeType>::CosineNeighborSearch(
+    const NeighborSearchMode mode,
+    const double epsilon) :
+    search(mode, epsilon)
+{
+  // Nothing to do.
+}
+
+template<typename SortPolicy,
+         template<typename, typename, typename> class TreeType>
+CosineNeighborSearch<SortPolicy, TreeType>::CosineNeighborSearch(
+    arma::mat referenceSet,
+    const NeighborSearchMode mode,
+    const double epsilon) :
+    search(mode, epsilon)
+{
+  Train(std::move(referenceSet));
+}
+
+template<typename SortPolicy,
+         template<typename, typename, typename> class TreeType>
+void CosineNeighborSearch<SortPolicy, TreeType>::Train(arma::mat referenceSet)
+{
+  Normalize(referenceSet);
+  search.Train(std::move(referenceSet));
+}
+
+template<typename SortPolicy,
+         template<typename, typename, typename> class TreeType>
+void CosineNeighborSearch<SortPolicy, TreeType>::Search(
+    const arma::mat& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  arma::mat normalizedQuerySet(querySet);
+  Normalize(normalizedQuerySet);
+
+  search.Search(normalizedQuerySet, k, neighbors, distances);
+  ToCosineDistances(distances);
+}
+
+template<typename SortPolicy,
+         template<typename, typename, typename> class TreeType>
+void CosineNeighborSearch<SortPolicy, TreeType>::Search(
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  search.Search(k, neighbors, distances);
+  ToCosineDistances(distances);
+}
+
+template<typename SortPolicy,
+         template<typename, typename, typename> class TreeType>
+void CosineNeighborSearch<SortPolicy, TreeType>::Normalize(arma::mat& points)
+{
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) points.n_cols; ++i)
+  {
+    const double norm = arma::norm(points.col(i), 2);
+    if (norm > 0.0)
+      points.col(i) /= norm;
+  }
+}
+
+template<typename SortPolicy,
+         template<typename, typename, typename> class TreeType>
+void CosineNeighborSearch<SortPolicy, TreeType>::ToCosineDistances(
+    arma::mat& distances)
+{
+  // For unit vectors a and b, ||a - b||^2 = 2 - 2 cos(a, b).  Rounding may
+  // push the result slightly out of [0, 2].  Neighbors that were not found
+  // keep the worst distance.
+  distances.transform([](const double d)
+  {
+    return (d == SortPolicy::WorstDistance()) ? d :
+        std::min(std::max(d * d / 2.0, 0.0), 2.0);
+  });
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
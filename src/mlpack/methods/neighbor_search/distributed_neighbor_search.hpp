@@ -0,0 +1,123 @@
+/**
+ * @file methods/neighbor_search/distributed_neighbor_search.hpp
+ *
+ * Defines the DistributedNeighborSearch class, which performs k-nearest (or
+ * furthest) neighbor search in a reference set sharded over several processes.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_DISTRIBUTED_NEIGHBOR_SEARCH_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_DISTRIBUTED_NEIGHBOR_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/distributed/local_communicator.hpp>
+#include <mlpack/core/distributed/mpi_communicator.hpp>
+#include <mlpack/core/distributed/ring_all_gather.hpp>
+#include <mlpack/core/distributed/ring_all_reduce.hpp>
+
+#include "neighbor_search.hpp"
+
+namespace mlpack {
+namespace neighbor /** Neighbor-search routines. */ {
+
+/**
+ * DistributedNeighborSearch searches the neighbors of a set of query points in
+ * a reference set whose points are sharded over several processes.  Every
+ * process holds a NeighborSearch object (with its own tree) built on its shard
+ * of the reference set.  The query points, given to the first process, are
+ * broadcast to all the processes in batches; every process searches the batch
+ * in its shard, and the best k neighbors of each query point are merged from
+ * the results of all the processes.
+ *
+ * The indices of the neighbors are indices in the concatenation of the shards,
+ * in the order of the ranks of the processes.  Every process must call Search()
+ * at the same time, with the same k, and gets the same results.
+ *
+ * @code
+ * extern arma::mat shard; // The reference points of this process.
+ * distributed::MPICommunicator communicator;
+ * KNN knn(shard);
+ * DistributedNeighborSearch<KNN, distributed::MPICommunicator> search(knn,
+ *     communicator);
+ * arma::Mat<size_t> neighbors;
+ * arma::mat distances;
+ * search.Search(queries, 5, neighbors, distances); // queries only on rank 0.
+ * @endcode
+ *
+ * @tparam SearchType Type of the neighbor search object of each process, such
+ *     as KNN; it must have ReferenceSet() and Search(querySet, k, neighbors,
+ *     distances).
+ * @tparam CommunicatorType Type of the communicator between the processes (see
+ *     distributed::LocalCommunicator).
+ * @tparam SortPolicy The sort policy of SearchType.
+ */
+template<typename SearchType,
+         typename CommunicatorType,
+         typename SortPolicy = NearestNeighborSort>
+class DistributedNeighborSearch
+{
+ public:
+  /**
+   * Create the DistributedNeighborSearch object.  Every process must create
+   * its object at the same time.
+   *
+   * @param search Neighbor search object built on the shard of this process;
+   *     it must outlive this object.
+   * @param communicator Communicator between the processes; it must outlive
+   *     this object.
+   * @param batchSize Number of query points broadcast at once.
+   */
+  DistributedNeighborSearch(SearchType& search,
+                            CommunicatorType& communicator,
+                            const size_t batchSize = 1024);
+
+  /**
+   * Search the k best neighbors of each query point in the reference points of
+   * all the processes.
+   *
+   * @param querySet Query points; only the set of the first process is used.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing the list of neighbors of each query point.
+   * @param distances Matrix storing the distances to the neighbors.
+   */
+  void Search(const arma::mat& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
+  //! Get the total number of reference points.
+  size_t NumReferencePoints() const { return numReferencePoints; }
+
+  //! Get the index of the first reference point of this process.
+  size_t Offset() const { return offset; }
+
+  //! Get the number of query points broadcast at once.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of query points broadcast at once.
+  size_t& BatchSize() { return batchSize; }
+
+ private:
+  //! The neighbor search object of this process.
+  SearchType& search;
+  //! The communicator between the processes.
+  CommunicatorType& communicator;
+  //! The number of query points broadcast at once.
+  size_t batchSize;
+  //! The number of reference points of each process.
+  std::vector<size_t> sizes;
+  //! The total number of reference points.
+  size_t numReferencePoints;
+  //! The index of the first reference point of this process.
+  size_t offset;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "distributed_neighbor_search_impl.hpp"
+
+#endif
@@ -0,0 +1,152 @@
+/**
+ * @file methods/neighbor_search/distributed_neighbor_search_impl.hpp
+ *
+ * Implementation of the DistributedNeighborSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_DISTRIBUTED_NEIGHBOR_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_DISTRIBUTED_NEIGHBOR_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "distributed_neighbor_search.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename SearchType, typename CommunicatorType, typename SortPolicy>
+DistributedNeighborSearch<SearchType, CommunicatorType, SortPolicy>::
+DistributedNeighborSearch(SearchType& search,
+                          CommunicatorType& communicator,
+                          const size_t batchSize) :
+    search(search),
+    communicator(communicator),
+    batchSize(batchSize)
+{
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("DistributedNeighborSearch: the batch size "
+        "must be positive!");
+  }
+
+  // Gather the size of the shard of every process.
+  arma::vec shardSizes(communicator.Size(), arma::fill::zeros);
+  shardSizes[communicator.Rank()] = (double) search.ReferenceSet().n_cols;
+  distributed::RingAllReduce(communicator, shardSizes.memptr(),
+      shardSizes.n_elem);
+
+  sizes.resize(communicator.Size());
+  numReferencePoints = 0;
+  offset = 0;
+  for (size_t r = 0; r < communicator.Size(); ++r)
+  {
+    sizes[r] = (size_t) shardSizes[r];
+    if (r == communicator.Rank())
+      offset = numReferencePoints;
+    numReferencePoints += sizes[r];
+  }
+}
+
+template<typename SearchType, typename CommunicatorType, typename SortPolicy>
+void DistributedNeighborSearch<SearchType, CommunicatorType, SortPolicy>::
+Search(const arma::mat& querySet,
+       const size_t k,
+       arma::Mat<size_t>& neighbors,
+       arma::mat& distances)
+{
+  if (k > numReferencePoints)
+  {
+    std::ostringstream oss;
+    oss << "DistributedNeighborSearch::Search(): requested value of k (" << k
+        << ") is greater than the number of points in the reference set ("
+        << numReferencePoints << ")";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Every process learns the size of the query set of the first process.
+  uint64_t header[2] = { 0, 0 };
+  if (communicator.Rank() == 0)
+  {
+    header[0] = querySet.n_rows;
+    header[1] = querySet.n_cols;
+  }
+  communicator.Broadcast(header, sizeof(header), 0);
+  const size_t dimensionality = (size_t) header[0];
+  const size_t numQueries = (size_t) header[1];
+
+  neighbors.set_size(k, numQueries);
+  distances.set_size(k, numQueries);
+
+  const size_t localSize = sizes[communicator.Rank()];
+  const size_t localK = std::min(k, localSize);
+
+  arma::mat batch;
+  arma::Mat<size_t> localNeighbors;
+  arma::mat localDistances;
+  std::vector<char> block;
+  std::vector<std::vector<char>> blocks;
+  std::vector<std::pair<double, size_t>> candidates;
+  for (size_t begin = 0; begin < numQueries; begin += batchSize)
+  {
+    const size_t count = std::min(batchSize, numQueries - begin);
+    if (communicator.Rank() == 0)
+      batch = querySet.cols(begin, begin + count - 1);
+    else
+      batch.set_size(dimensionality, count);
+    communicator.Broadcast(batch.memptr(), batch.n_elem * sizeof(double), 0);
+
+    // Search the batch in the shard of this process, and send the results (the
+    // indices, then the distances) to every process.
+    block.resize(localK * count * (sizeof(size_t) + sizeof(double)));
+    if (localK > 0)
+    {
+      search.Search(batch, localK, localNeighbors, localDistances);
+      localNeighbors += offset;
+      std::memcpy(block.data(), localNeighbors.memptr(),
+          localNeighbors.n_elem * sizeof(size_t));
+      std::memcpy(block.data() + localNeighbors.n_elem * sizeof(size_t),
+          localDistances.memptr(), localDistances.n_elem * sizeof(double));
+    }
+    distributed::RingAllGather(communicator, block, blocks);
+
+    // Merge the results of all the processes, breaking ties by index so that
+    // the result does not depend on the order of the processes.
+    for (size_t q = 0; q < count; ++q)
+    {
+      candidates.clear();
+      for (size_t r = 0; r < blocks.size(); ++r)
+      {
+        const size_t rankK = std::min(k, sizes[r]);
+        const size_t* rankNeighbors = (const size_t*) blocks[r].data();
+        const double* rankDistances = (const double*) (blocks[r].data() +
+            rankK * count * sizeof(size_t));
+        for (size_t i = q * rankK; i < (q + 1) * rankK; ++i)
+          candidates.push_back(std::make_pair(rankDistances[i],
+              rankNeighbors[i]));
+      }
+
+      std::partial_sort(candidates.begin(), candidates.begin() + k,
+          candidates.end(), [](const std::pair<double, size_t>& a,
+                               const std::pair<double, size_t>& b)
+          {
+            if (a.first != b.first)
+              return SortPolicy::IsBetter(a.first, b.first);
+            return a.second < b.second;
+          });
+
+      for (size_t i = 0; i < k; ++i)
+      {
+        neighbors(i, begin + q) = candidates[i].second;
+        distances(i, begin + q) = candidates[i].first;
+      }
+    }
+  }
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
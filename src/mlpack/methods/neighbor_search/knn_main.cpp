@@ -23,6 +23,7 @@
 #include "neighbor_search.hpp"
 #include "unmap.hpp"
 #include "ns_model.hpp"
+#include "distributed_neighbor_search.hpp"
 
 using namespace std;
 using namespace mlpack;
@@ -50,7 +51,15 @@ BINDING_LONG_DESC(
     "points using kd-trees or cover trees (cover tree support is experimental "
     "and may be slow). You may specify a separate set of "
     "reference points and query points, or just a reference set which will be "
-    "used as both the reference and query set.");
+    "used as both the reference and query set."
+    "\n\n"
+    "If mlpack is built with MPI support (the USE_MPI CMake option), the " +
+    PRINT_PARAM_STRING("distributed") + " option searches with every process "
+    "launched by mpirun: each process builds a kd-tree on its slice of the "
+    "reference set, the query points are sent to all the processes in "
+    "batches, and the nearest neighbors found by the processes are merged.  "
+    "Every process loads the same reference and query sets, and only the first "
+    "one saves the results.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -122,9 +131,25 @@ PARAM_STRING_IN("algorithm", "Type of neighbor search: 'naive', 'single_tree', "
     "'dual_tree', 'greedy'.", "a", "dual_tree");
 PARAM_DOUBLE_IN("epsilon", "If specified, will do approximate nearest neighbor "
     "search with given relative error.", "e", 0);
+PARAM_FLAG("distributed", "Search with all the MPI processes, each one holding "
+    "a slice of the reference set (requires mlpack built with USE_MPI).", "");
+
+#ifdef MLPACK_USE_MPI
+// Search the neighbors of the query set with all the MPI processes.
+static void RunDistributedKNN(const NeighborSearchMode searchMode,
+                              const double epsilon);
+#endif
 
 static void mlpackMain()
 {
+#ifndef MLPACK_USE_MPI
+  if (IO::HasParam("distributed"))
+  {
+    Log::Fatal << "Cannot use " << PRINT_PARAM_STRING("distributed") << ": "
+        << "mlpack was not built with MPI support (USE_MPI)." << endl;
+  }
+#endif
+
   if (IO::GetParam<int>("seed") != 0)
     math::RandomSeed((size_t) IO::GetParam<int>("seed"));
   else
@@ -206,6 +231,14 @@ static void mlpackMain()
   else if (algorithm == "greedy")
     searchMode = GREEDY_SINGLE_TREE_MODE;
 
+  if (IO::HasParam("distributed"))
+  {
+#ifdef MLPACK_USE_MPI
+    RunDistributedKNN(searchMode, epsilon);
+#endif
+    return;
+  }
+
   if (IO::HasParam("reference"))
   {
     // Get all the parameters.
@@ -397,3 +430,78 @@ static void mlpackMain()
 
   IO::GetParam<KNNModel*>("output_model") = knn;
 }
+
+#ifdef MLPACK_USE_MPI
+// Search the neighbors of the query set with all the MPI processes.
+static void RunDistributedKNN(const NeighborSearchMode searchMode,
+                              const double epsilon)
+{
+  if (!IO::HasParam("reference") || !IO::HasParam("query") ||
+      !IO::HasParam("k"))
+  {
+    Log::Fatal << PRINT_PARAM_STRING("distributed") << " requires "
+        << PRINT_PARAM_STRING("reference") << ", "
+        << PRINT_PARAM_STRING("query") << " and " << PRINT_PARAM_STRING("k")
+        << "." << endl;
+  }
+
+  ReportIgnoredParam("tree_type", "the distributed search uses kd-trees");
+  ReportIgnoredParam("leaf_size", "the distributed search uses kd-trees with "
+      "the default leaf size");
+  ReportIgnoredParam("random_basis", "the search is distributed");
+  ReportIgnoredParam("output_model", "the search is distributed");
+  ReportIgnoredParam("true_distances", "the search is distributed");
+  ReportIgnoredParam("true_neighbors", "the search is distributed");
+  IO::Parameters()["output_model"].wasPassed = false;
+
+  distributed::MPICommunicator::Initialize();
+  distributed::MPICommunicator communicator;
+  Log::Info << "Distributed search with " << communicator.Size()
+      << " processes." << endl;
+
+  // Every process loads the whole reference set, and keeps a contiguous slice
+  // of it.
+  const arma::mat& referenceSet = IO::GetParam<arma::mat>("reference");
+  const arma::mat& querySet = IO::GetParam<arma::mat>("query");
+  const size_t k = (size_t) IO::GetParam<int>("k");
+  if (querySet.n_rows != referenceSet.n_rows)
+  {
+    Log::Fatal << "Query has invalid dimensions(" << querySet.n_rows <<
+        "); should be " << referenceSet.n_rows << "!" << endl;
+  }
+  if (k > referenceSet.n_cols)
+  {
+    Log::Fatal << "Invalid k: " << k << "; must be greater than 0 and less "
+        << "than or equal to the number of reference points ("
+        << referenceSet.n_cols << ")." << endl;
+  }
+
+  const size_t begin = communicator.Rank() * referenceSet.n_cols /
+      communicator.Size();
+  const size_t end = (communicator.Rank() + 1) * referenceSet.n_cols /
+      communicator.Size();
+  arma::mat shard = (end > begin) ? arma::mat(referenceSet.cols(begin,
+      end - 1)) : arma::mat(referenceSet.n_rows, 0);
+
+  // A process with no reference points does not need a tree.
+  KNN knn(std::move(shard), (end > begin) ? searchMode : NAIVE_MODE, epsilon);
+  DistributedNeighborSearch<KNN, distributed::MPICommunicator> search(knn,
+      communicator);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  search.Search(querySet, k, neighbors, distances);
+  Log::Info << "Search complete." << endl;
+
+  // Only the first process saves the results.
+  if (communicator.Rank() != 0)
+  {
+    IO::Parameters()["neighbors"].wasPassed = false;
+    IO::Parameters()["distances"].wasPassed = false;
+    return;
+  }
+
+  IO::GetParam<arma::Mat<size_t>>("neighbors") = std::move(neighbors);
+  IO::GetParam<arma::mat>("distances") = std::move(distances);
+}
+#endif
@@ -0,0 +1,172 @@
+/**
+ * @file methods/neighbor_search/mahalanobis_neighbor_search.hpp
+ *
+ * Defines the MahalanobisNeighborSearch class, which performs k-nearest (or
+ * furthest) neighbor search with a Mahalanobis distance by searching the
+ * transformed points with the Euclidean distance.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_MAHALANOBIS_NEIGHBOR_SEARCH_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_MAHALANOBIS_NEIGHBOR_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/mahalanobis_distance.hpp>
+
+#include "neighbor_search.hpp"
+
+namespace mlpack {
+namespace neighbor /** Neighbor-search routines. */ {
+
+/**
+ * MahalanobisNeighborSearch finds the neighbors of points with the Mahalanobis
+ * distance
+ *
+ * @f[
+ * d(a, b) = \sqrt{(a - b)^T Q (a - b)} = || L a - L b ||
+ * @f]
+ *
+ * where Q = L^T L.  Evaluating the distance with Q takes O(d^2) time for each
+ * pair of points, and the distance cannot be used with the HRectBound of the
+ * default KDTree.  Instead, the reference points are multiplied by L once, when
+ * the object is trained, and searched with NeighborSearch and the Euclidean
+ * distance, which takes O(d) time for each pair and prunes as well as any
+ * Euclidean search.  The query points are multiplied by L before each search.
+ *
+ * The transformation matrix L may have fewer rows than columns, to search in a
+ * space of lower dimensionality; this is the form of the matrices learned by
+ * LMNN and NCA, which can be given directly.  For a covariance matrix Q, use
+ * MahalanobisDistance::Transformation().
+ *
+ * @code
+ * extern arma::mat referenceSet, querySet, transformation; // e.g. from LMNN.
+ * MahalanobisNeighborSearch<> search(referenceSet, transformation);
+ * arma::Mat<size_t> neighbors;
+ * arma::mat distances;
+ * search.Search(querySet, 5, neighbors, distances);
+ * @endcode
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = tree::KDTree>
+class MahalanobisNeighborSearch
+{
+ public:
+  //! The type of the Euclidean search on the transformed points.
+  typedef NeighborSearch<SortPolicy, metric::EuclideanDistance, arma::mat,
+      TreeType> SearchType;
+
+  /**
+   * Initialize the object with the given transformation and without any
+   * reference points; Train() must be called before searching.
+   *
+   * @param transformation Transformation matrix L, with one column for each
+   *     dimension of the points.
+   * @param mode Neighbor search mode.
+   * @param epsilon Relative approximate error (non-negative).
+   */
+  MahalanobisNeighborSearch(arma::mat transformation,
+                            const NeighborSearchMode mode = DUAL_TREE_MODE,
+                            const double epsilon = 0);
+
+  /**
+   * Initialize the object with the given reference points and transformation,
+   * and build the tree on the transformed reference points.
+   *
+   * @param referenceSet Set of reference points.
+   * @param transformation Transformation matrix L, with one column for each
+   *     dimension of the points.
+   * @param mode Neighbor search mode.
+   * @param epsilon Relative approximate error (non-negative).
+   */
+  MahalanobisNeighborSearch(const arma::mat& referenceSet,
+                            arma::mat transformation,
+                            const NeighborSearchMode mode = DUAL_TREE_MODE,
+                            const double epsilon = 0);
+
+  /**
+   * Initialize the object with the given reference points and Mahalanobis
+   * distance, whose covariance matrix is decomposed with Transformation().
+   * The returned distances always take the root, whatever TakeRoot is.
+   *
+   * @param referenceSet Set of reference points.
+   * @param metric Mahalanobis distance to search with.
+   * @param mode Neighbor search mode.
+   * @param epsilon Relative approximate error (non-negative).
+   */
+  template<bool TakeRoot>
+  MahalanobisNeighborSearch(const arma::mat& referenceSet,
+                            const metric::MahalanobisDistance<TakeRoot>& metric,
+                            const NeighborSearchMode mode = DUAL_TREE_MODE,
+                            const double epsilon = 0);
+
+  /**
+   * Set the reference points, which are transformed, and build the tree.
+   *
+   * @param referenceSet Set of reference points.
+   */
+  void Train(const arma::mat& referenceSet);
+
+  /**
+   * For each point in the query set, find the k best neighbors in the reference
+   * set by Mahalanobis distance.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing the list of neighbors of each query point.
+   * @param distances Matrix storing the Mahalanobis distances to the neighbors.
+   */
+  void Search(const arma::mat& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
+  /**
+   * For each point in the reference set, find the k best neighbors in the
+   * reference set (excluding the point itself) by Mahalanobis distance.
+   *
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing the list of neighbors of each point.
+   * @param distances Matrix storing the Mahalanobis distances to the neighbors.
+   */
+  void Search(const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
+  //! Get the transformation matrix L.
+  const arma::mat& Transformation() const { return transformation; }
+
+  //! Get the transformed reference points.
+  const arma::mat& ReferenceSet() const { return search.ReferenceSet(); }
+
+  //! Get the Euclidean search on the transformed points.
+  const SearchType& EuclideanSearch() const { return search; }
+  //! Modify the Euclidean search on the transformed points.  Points given to it
+  //! directly must already be transformed.
+  SearchType& EuclideanSearch() { return search; }
+
+ private:
+  //! Multiply the given points by the transformation, checking their
+  //! dimensionality.
+  arma::mat Transform(const arma::mat& points, const char* method) const;
+
+  //! The transformation matrix L.
+  arma::mat transformation;
+  //! The Euclidean search on the transformed points.
+  SearchType search;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "mahalanobis_neighbor_search_impl.hpp"
+
+#endif
@@ -0,0 +1,110 @@
+/**
+ * @file methods/neighbor_search/mahalanobis_neighbor_search_impl.hpp
+ *
+ * Implementation of the MahalanobisNeighborSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_MAHALANOBIS_NEIGHBOR_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_MAHALANOBIS_NEIGHBOR_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mahalanobis_neighbor_search.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename SortPolicy,
+         template<typename, typename, typename> class TreeType>
+MahalanobisNeighborSearch<SortPolicy, TreeType>::MahalanobisNeighborSearch(
+    arma::mat transformation,
+    const NeighborSearchMode mode,
+    const double epsilon) :
+    transformation(std::move(transformation)),
+    search(mode, epsilon)
+{
+  // Nothing to do.
+}
+
+template<typename SortPolicy,
+         template<typename, typename, typename> class TreeType>
+MahalanobisNeighborSearch<SortPolicy, TreeType>::MahalanobisNeighborSearch(
+    const arma::mat& referenceSet,
+    arma::mat transformation,
+    const NeighborSearchMode mode,
+    const double epsilon) :
+    transformation(std::move(transformation)),
+    search(mode, epsilon)
+{
+  Train(referenceSet);
+}
+
+template<typename SortPolicy,
+         template<typename, typename, typename> class TreeType>
+template<bool TakeRoot>
+MahalanobisNeighborSearch<SortPolicy, TreeType>::MahalanobisNeighborSearch(
+    const arma::mat& referenceSet,
+    const metric::MahalanobisDistance<TakeRoot>& metric,
+    const NeighborSearchMode mode,
+    const double epsilon) :
+    transformation(metric.Transformation()),
+    search(mode, epsilon)
+{
+  Train(referenceSet);
+}
+
+template<typename SortPolicy,
+         template<typename, typename, typename> class TreeType>
+void MahalanobisNeighborSearch<SortPolicy, TreeType>::Train(
+    const arma::mat& referenceSet)
+{
+  search.Train(Transform(referenceSet, "Train"));
+}
+
+template<typename SortPolicy,
+         template<typename, typename, typename> class TreeType>
+void MahalanobisNeighborSearch<SortPolicy, TreeType>::Search(
+    const arma::mat& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  search.Search(Transform(querySet, "Search"), k, neighbors, distances);
+}
+
+template<typename SortPolicy,
+         template<typename, typename, typename> class TreeType>
+void MahalanobisNeighborSearch<SortPolicy, TreeType>::Search(
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  search.Search(k, neighbors, distances);
+}
+
+template<typename SortPolicy,
+         template<typename, typename, typename> class TreeType>
+arma::mat MahalanobisNeighborSearch<SortPolicy, TreeType>::Transform(
+    const arma::mat& points,
+    const char* method) const
+{
+  if (points.n_rows != transformation.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "MahalanobisNeighborSearch::" << method << "(): dimensionality of "
+        << "the points (" << points.n_rows << ") does not match the "
+        << "transformation matrix (" << transformation.n_rows << " x "
+        << transformation.n_cols << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  return transformation * points;
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -20,6 +20,7 @@
 #include <mlpack/core/tree/binary_space_tree.hpp>
 #include <mlpack/core/tree/rectangle_tree.hpp>
 #include <mlpack/core/tree/binary_space_tree/binary_space_tree.hpp>
+#include <mlpack/core/tree/prepared_query.hpp>
 
 #include "neighbor_search_stat.hpp"
 #include "sort_policies/nearest_neighbor_sort.hpp"
@@ -30,13 +31,23 @@ namespace mlpack {
 // all-furthest-neighbors searches.
 namespace neighbor  {
 
-// Forward declaration.
+// Forward declarations.
 template<typename SortPolicy,
          template<typename TreeMetricType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename RuleType> class DualTreeTraversalType,
-         template<typename RuleType> class SingleTreeTraversalType>
+         template<typename RuleType> class SingleTreeTraversalType,
+         typename MatType>
+class NSWrapper;
+
+template<typename SortPolicy,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename RuleType> class DualTreeTraversalType,
+         template<typename RuleType> class SingleTreeTraversalType,
+         typename MatType>
 class LeafSizeNSWrapper;
 
 //! NeighborSearchMode represents the different neighbor search modes available.
@@ -211,6 +222,55 @@ class NeighborSearch
    */
   void Train(Tree referenceTree);
 
+  /**
+   * Add the given points to the reference set.  The new points get the indices
+   * after the last existing reference point, in order; the indices of existing
+   * points do not change.  For rectangle trees (R trees, R* trees, X trees,
+   * Hilbert R trees and R+/R++ trees) the points are inserted into the existing
+   * reference tree, and the tree stays balanced through node splits.  For all
+   * other tree types, and in naive mode, the reference tree is rebuilt on the
+   * extended reference set.
+   *
+   * @param points Points to add to the reference set.
+   */
+  void Insert(const MatType& points);
+
+  /**
+   * Remove the reference point with the given index, so that it is never
+   * returned as a neighbor again.  This is only supported for rectangle trees,
+   * where the point is removed from the tree but kept in the reference set, so
+   * that the indices of the other points do not change.  When the reference
+   * set is also used as the query set, removed points are not searched for:
+   * their neighbors have index SIZE_MAX and distance
+   * SortPolicy::WorstDistance().  For other tree types std::invalid_argument is
+   * thrown, and the model should be retrained instead.
+   *
+   * @param index Index of the reference point to remove.
+   */
+  void Delete(const size_t index);
+
+  /**
+   * Give a mask to each reference point, for filtered search: once masks are
+   * given, every search only returns the reference points whose mask shares a
+   * bit with Filter().  A mask can hold a label (use 1 << label, for labels
+   * below 64) or a set of categories.  The union of the masks of the points of
+   * each node of the reference tree is stored in its statistic, so that the
+   * search prunes the nodes without any eligible point instead of searching
+   * them.  If there are fewer than k eligible points, the missing neighbors
+   * have index SIZE_MAX and distance SortPolicy::WorstDistance().
+   *
+   * The masks are forgotten by Train(), by Insert() (so they must be given
+   * again for the new points), and when the model is loaded.  Deleted points
+   * keep their masks.  Give an empty vector to stop filtering.
+   *
+   * Greedy single-tree search does not prune with the masks, so it may return
+   * fewer eligible points.
+   *
+   * @param masks Mask of each reference point, in the original order of the
+   *     points.
+   */
+  void SetReferenceMasks(const arma::Col<uint64_t>& masks);
+
   /**
    * For each point in the query set, compute the nearest neighbors and store
    * the output in the given matrices.  The matrices will be set to the size of
@@ -220,7 +280,8 @@ class NeighborSearch
    * If querySet contains only a few query points, the extra cost of building a
    * tree on the points for dual-tree search may not be warranted, and it may be
    * worthwhile to set singleMode = false (either in the constructor or with
-   * SingleMode()).
+   * SingleMode()).  When mlpack is compiled with OpenMP, single-tree search
+   * splits the query points between threads.
    *
    * @param querySet Set of query points (can be just one point).
    * @param k Number of neighbors to search for.
@@ -233,6 +294,41 @@ class NeighborSearch
               arma::Mat<size_t>& neighbors,
               arma::mat& distances);
 
+  /**
+   * Search for the best neighbors of each query point within a budget: the
+   * reference tree is traversed best-first for each query point (the most
+   * promising nodes first, so early results are good), and the traversal stops
+   * after maxBaseCases base cases or maxTime microseconds, whichever comes
+   * first.  This is useful when answers are needed within a deadline, and
+   * approximate answers are acceptable.  The budget of a query point may be
+   * exceeded by the points of one leaf.  This cannot be used in naive mode.
+   *
+   * For each query point, bounds holds the best distance that any point not
+   * seen by the search can have (computed from the nodes left unvisited), so
+   * the results are exact (up to the epsilon of approximate search) when the
+   * found distances are at least as good as the bound.  If the search of a
+   * query point was finished, its bound is SortPolicy::WorstDistance().
+   *
+   * @param querySet Set of query points (can be just one point).
+   * @param k Number of neighbors to search for.
+   * @param maxBaseCases Maximum number of base cases for each query point (0
+   *     means no limit).
+   * @param maxTime Maximum time of the search of each query point, in
+   *     microseconds (0 means no limit).
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   * @param bounds Vector storing, for each query point, the best distance of
+   *     the reference points that were not seen.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              const size_t maxBaseCases,
+              const double maxTime,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances,
+              arma::vec& bounds);
+
   /**
    * Given a pre-built query tree, search for the nearest neighbors of each
    * point in the query tree, storing the output in the given matrices.  The
@@ -259,6 +355,24 @@ class NeighborSearch
               arma::mat& distances,
               bool sameSet = false);
 
+  /**
+   * Search for the nearest neighbors of each point of the given prepared query,
+   * reusing its query tree instead of building a new one.  The statistics of
+   * the query tree are reset first, and the results are in the original order
+   * of the query points, as with the overload that takes a query set.  This
+   * can only be used in dual-tree mode.
+   *
+   * @param query Query tree built on the query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *      point.
+   */
+  void Search(tree::PreparedQuery<Tree>& query,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
   /**
    * Search for the nearest neighbors of every point in the reference set.  This
    * is basically equivalent to calling any other overload of Search() with the
@@ -326,6 +440,28 @@ class NeighborSearch
   //! Modify the relative error to be considered in approximate search.
   double& Epsilon() { return epsilon; }
 
+  /**
+   * Get the depth of the query tree at which the dual-tree search is split into
+   * independent parallel tasks.  If this is 0 (the default), or if mlpack was
+   * compiled without OpenMP, dual-tree search is performed on a single thread.
+   */
+  size_t ParallelDepth() const { return parallelDepth; }
+  /**
+   * Modify the depth of the query tree at which the dual-tree search is split
+   * into independent parallel tasks.  Each query node at this depth (or each
+   * leaf above it) is traversed against the reference tree as a separate task.
+   * Each thread keeps its own set of candidate neighbors, so this requires
+   * O(k * n) extra memory per thread, where n is the number of query points.
+   * Spill trees are always searched on a single thread.
+   */
+  size_t& ParallelDepth() { return parallelDepth; }
+
+  //! Get the filter of the search: only the reference points whose mask (see
+  //! SetReferenceMasks()) shares a bit with it are returned.
+  uint64_t Filter() const { return filter; }
+  //! Modify the filter of the search.
+  uint64_t& Filter() { return filter; }
+
   //! Access the reference dataset.
   const MatType& ReferenceSet() const { return *referenceSet; }
 
@@ -363,9 +499,62 @@ class NeighborSearch
   //! Search() without a query set.
   bool treeNeedsReset;
 
+  //! The depth of the query tree at which dual-tree search is split into
+  //! parallel tasks (0 means no parallelism).
+  size_t parallelDepth;
+
+  //! The mask of each reference point, in the order of the reference set held
+  //! by this object (empty if the search is not filtered).
+  arma::Col<uint64_t> referenceMasks;
+  //! The filter of the search.
+  uint64_t filter;
+
+  /**
+   * Store the union of the masks of the points held by each node of the given
+   * subtree in its statistic.
+   *
+   * @param node Root of the subtree.
+   * @return The union of the masks of the points of the subtree.
+   */
+  uint64_t UpdateLabelMasks(Tree& node);
+
+  /**
+   * Perform the dual-tree traversal of the given query tree against the
+   * reference tree, storing the results in the given rules object.  If
+   * parallelDepth is nonzero and OpenMP is available, the query tree is split
+   * into independent subtrees that are traversed in parallel with separate
+   * rules objects, and the results are merged back into the given rules.
+   *
+   * @param queryTree Tree built on query points.
+   * @param rules Rules object to use for the traversal.
+   */
+  template<typename RuleType>
+  void DualTreeTraverse(Tree& queryTree, RuleType& rules);
+
+  /**
+   * Perform a single-tree traversal of the reference tree for each of the
+   * given number of query points, storing the results in the given rules
+   * object.  If OpenMP is available, the query points are split between
+   * threads, each of which uses a separate rules object; the results are then
+   * merged back into the given rules object.  Trees with self-children (like
+   * the cover tree) are always searched on a single thread.
+   *
+   * @param numQueries Number of query points.
+   * @param rules Rules object to use for the traversal.
+   * @param queries If not empty, the indices of the query points to search
+   *     for; otherwise the query points are 0 to numQueries - 1.
+   */
+  template<typename RuleType>
+  void SingleTreeTraverse(const size_t numQueries,
+                          RuleType& rules,
+                          const std::vector<size_t>& queries =
+                              std::vector<size_t>());
+
   //! The NSModel class should have access to internal members.
-  friend class LeafSizeNSWrapper<SortPolicy, TreeType, DualTreeTraversalType,
-      SingleTreeTraversalType>;
+  friend class NSWrapper<SortPolicy, TreeType,
+      DualTreeTraversalType, SingleTreeTraversalType, MatType>;
+  friend class LeafSizeNSWrapper<SortPolicy, TreeType,
+      DualTreeTraversalType, SingleTreeTraversalType, MatType>;
 }; // class NeighborSearch
 
 } // namespace neighbor
@@ -15,8 +15,11 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/tree/greedy_single_tree_traverser.hpp>
+#include <mlpack/core/tree/best_first_single_tree_traverser.hpp>
+#include <mlpack/core/tree/traversal_tasks.hpp>
 #include "neighbor_search_rules.hpp"
 #include <mlpack/core/tree/spill_tree/is_spill_tree.hpp>
+#include <mlpack/core/tree/rectangle_tree/is_rectangle_tree.hpp>
 
 namespace mlpack {
 namespace neighbor {
@@ -45,6 +48,79 @@ TreeType* BuildTree(
   return new TreeType(std::forward<MatType>(dataset));
 }
 
+//! Append the given points to the dataset of a tree that supports insertion,
+//! and insert them into the tree.
+template<typename TreeType, typename MatType>
+void InsertIntoTree(
+    TreeType& tree,
+    const MatType& points,
+    typename std::enable_if_t<
+        tree::IsRectangleTree<TreeType>::value, TreeType
+    >* = 0)
+{
+  const size_t firstIndex = tree.Dataset().n_cols;
+  tree.Dataset().insert_cols(firstIndex, points);
+  for (size_t i = firstIndex; i < tree.Dataset().n_cols; ++i)
+    tree.InsertPoint(i);
+}
+
+//! Trees that don't support insertion are rebuilt instead; this is never
+//! called.
+template<typename TreeType, typename MatType>
+void InsertIntoTree(
+    TreeType& /* tree */,
+    const MatType& /* points */,
+    typename std::enable_if_t<
+        !tree::IsRectangleTree<TreeType>::value, TreeType
+    >* = 0)
+{
+  throw std::logic_error("cannot insert points into this type of tree");
+}
+
+//! Delete the given point from a tree that supports deletion; returns false
+//! if the point is not in the tree.
+template<typename TreeType>
+bool DeleteFromTree(
+    TreeType& tree,
+    const size_t index,
+    typename std::enable_if_t<
+        tree::IsRectangleTree<TreeType>::value, TreeType
+    >* = 0)
+{
+  return tree.DeletePoint(index);
+}
+
+//! Trees that don't support deletion are rejected before this is called.
+template<typename TreeType>
+bool DeleteFromTree(
+    TreeType& /* tree */,
+    const size_t /* index */,
+    typename std::enable_if_t<
+        !tree::IsRectangleTree<TreeType>::value, TreeType
+    >* = 0)
+{
+  throw std::logic_error("cannot delete points from this type of tree");
+}
+
+//! Mark the points held by the given rectangle tree; deleted points are not
+//! held by any leaf.
+template<typename TreeType>
+void MarkTreePoints(const TreeType& tree, std::vector<bool>& held)
+{
+  std::stack<const TreeType*> nodes;
+  nodes.push(&tree);
+  while (!nodes.empty())
+  {
+    const TreeType* node = nodes.top();
+    nodes.pop();
+
+    for (size_t i = 0; i < node->NumPoints(); ++i)
+      held[node->Point(i)] = true;
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+      nodes.push(&node->Child(i));
+  }
+}
+
 // Construct the object.
 template<typename SortPolicy,
          typename MetricType,
@@ -68,10 +144,16 @@ SingleTreeTraversalType>::NeighborSearch(MatType referenceSetIn,
     metric(metric),
     baseCases(0),
     scores(0),
-    treeNeedsReset(false)
+    treeNeedsReset(false),
+    parallelDepth(0),
+    filter(~uint64_t(0))
 {
   if (epsilon < 0)
     throw std::invalid_argument("epsilon must be non-negative");
+
+  // Every thread of the search reads the reference points, so spread them
+  // over the memory of the machine (only with MLPACK_USE_NUMA).
+  util::FirstTouch(const_cast<MatType&>(*referenceSet));
 }
 
 // Construct the object.
@@ -95,7 +177,9 @@ SingleTreeTraversalType>::NeighborSearch(Tree referenceTree,
     metric(metric),
     baseCases(0),
     scores(0),
-    treeNeedsReset(false)
+    treeNeedsReset(false),
+    parallelDepth(0),
+    filter(~uint64_t(0))
 {
   if (epsilon < 0)
     throw std::invalid_argument("epsilon must be non-negative");
@@ -121,7 +205,9 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearchMode mode,
     metric(metric),
     baseCases(0),
     scores(0),
-    treeNeedsReset(false)
+    treeNeedsReset(false),
+    parallelDepth(0),
+    filter(~uint64_t(0))
 {
   if (epsilon < 0)
     throw std::invalid_argument("epsilon must be non-negative");
@@ -129,7 +215,7 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearchMode mode,
   // Build the tree on the empty dataset, if necessary.
   if (mode != NAIVE_MODE)
   {
-    referenceTree = BuildTree<Tree>(std::move(arma::mat()),
+    referenceTree = BuildTree<Tree>(std::move(MatType()),
         oldFromNewReferences);
     referenceSet = &referenceTree->Dataset();
   }
@@ -155,7 +241,10 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearch& other) :
     metric(other.metric),
     baseCases(other.baseCases),
     scores(other.scores),
-    treeNeedsReset(false)
+    treeNeedsReset(false),
+    parallelDepth(other.parallelDepth),
+    referenceMasks(other.referenceMasks),
+    filter(other.filter)
 {
   // Nothing else to do.
 }
@@ -179,7 +268,10 @@ SingleTreeTraversalType>::NeighborSearch(NeighborSearch&& other) :
     metric(std::move(other.metric)),
     baseCases(other.baseCases),
     scores(other.scores),
-    treeNeedsReset(other.treeNeedsReset)
+    treeNeedsReset(other.treeNeedsReset),
+    parallelDepth(other.parallelDepth),
+    referenceMasks(std::move(other.referenceMasks)),
+    filter(other.filter)
 {
   // Clear the other model.
   other.referenceTree = BuildTree<Tree>(std::move(MatType()),
@@ -233,6 +325,9 @@ NeighborSearch<SortPolicy,
   baseCases = other.baseCases;
   scores = other.scores;
   treeNeedsReset = false;
+  parallelDepth = other.parallelDepth;
+  referenceMasks = other.referenceMasks;
+  filter = other.filter;
 }
 
 // Move operator.
@@ -275,12 +370,15 @@ NeighborSearch<SortPolicy,
   baseCases = other.baseCases;
   scores = other.scores;
   treeNeedsReset = other.treeNeedsReset;
+  parallelDepth = other.parallelDepth;
+  referenceMasks = std::move(other.referenceMasks);
+  filter = other.filter;
 
   // Reset the other object.  Clean memory if needed.
   if (!other.referenceTree)
     delete other.referenceSet;
 
-  other.referenceTree = BuildTree<Tree>(std::move(arma::mat()),
+  other.referenceTree = BuildTree<Tree>(std::move(MatType()),
       other.oldFromNewReferences);
   other.referenceSet = &other.referenceTree->Dataset();
   other.searchMode = DUAL_TREE_MODE,
@@ -319,6 +417,9 @@ template<typename SortPolicy,
 void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
 DualTreeTraversalType, SingleTreeTraversalType>::Train(MatType referenceSetIn)
 {
+  // The masks were given for the old reference points.
+  referenceMasks.clear();
+
   // Clean up the old tree, if we built one.
   if (referenceTree)
   {
@@ -342,6 +443,10 @@ DualTreeTraversalType, SingleTreeTraversalType>::Train(MatType referenceSetIn)
   {
     referenceSet = new MatType(std::move(referenceSetIn));
   }
+
+  // Every thread of the search reads the reference points, so spread them
+  // over the memory of the machine (only with MLPACK_USE_NUMA).
+  util::FirstTouch(const_cast<MatType&>(*referenceSet));
 }
 
 template<typename SortPolicy,
@@ -359,6 +464,9 @@ DualTreeTraversalType, SingleTreeTraversalType>::Train(Tree referenceTree)
     throw std::invalid_argument("cannot train on given reference tree when "
         "naive search (without trees) is desired");
 
+  // The masks were given for the old reference points.
+  referenceMasks.clear();
+
   if (this->referenceTree)
   {
     oldFromNewReferences.clear();
@@ -373,6 +481,161 @@ DualTreeTraversalType, SingleTreeTraversalType>::Train(Tree referenceTree)
   this->referenceSet = &this->referenceTree->Dataset();
 }
 
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Insert(const MatType& points)
+{
+  if (points.n_cols == 0)
+    return;
+
+  // Inserting into an empty model is the same as training it.
+  if (referenceSet->n_cols == 0)
+  {
+    Train(points);
+    return;
+  }
+
+  if (points.n_rows != referenceSet->n_rows)
+  {
+    std::stringstream ss;
+    ss << "NeighborSearch::Insert(): dimensionality of new points ("
+        << points.n_rows << ") does not match dimensionality of reference set ("
+        << referenceSet->n_rows << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  if (searchMode != NAIVE_MODE && tree::IsRectangleTree<Tree>::value)
+  {
+    InsertIntoTree(*referenceTree, points);
+
+    // Node statistics of the monochromatic search are stale now, and the new
+    // points have no masks.
+    treeNeedsReset = true;
+    referenceMasks.clear();
+    return;
+  }
+
+  // Otherwise rebuild on the extended reference set, in the original order of
+  // the points so that their indices are kept.
+  MatType newReferenceSet(referenceSet->n_rows,
+      referenceSet->n_cols + points.n_cols);
+  if (referenceTree && tree::TreeTraits<Tree>::RearrangesDataset &&
+      oldFromNewReferences.size() == referenceSet->n_cols)
+  {
+    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+      newReferenceSet.col(oldFromNewReferences[i]) = referenceSet->col(i);
+  }
+  else
+  {
+    newReferenceSet.cols(0, referenceSet->n_cols - 1) = *referenceSet;
+  }
+  newReferenceSet.cols(referenceSet->n_cols, newReferenceSet.n_cols - 1) =
+      points;
+
+  Train(std::move(newReferenceSet));
+  treeNeedsReset = false;
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Delete(const size_t index)
+{
+  if (searchMode == NAIVE_MODE || !tree::IsRectangleTree<Tree>::value)
+  {
+    throw std::invalid_argument("NeighborSearch::Delete(): points can only be "
+        "deleted from rectangle trees; retrain the model instead");
+  }
+
+  if (index >= referenceSet->n_cols || !DeleteFromTree(*referenceTree, index))
+  {
+    std::stringstream ss;
+    ss << "NeighborSearch::Delete(): reference point " << index << " is not "
+        << "in the reference tree";
+    throw std::invalid_argument(ss.str());
+  }
+
+  treeNeedsReset = true;
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::SetReferenceMasks(
+    const arma::Col<uint64_t>& masks)
+{
+  if (masks.is_empty())
+  {
+    referenceMasks.clear();
+    return;
+  }
+
+  if (masks.n_elem != referenceSet->n_cols)
+  {
+    std::stringstream ss;
+    ss << "NeighborSearch::SetReferenceMasks(): number of masks ("
+        << masks.n_elem << ") does not match number of reference points ("
+        << referenceSet->n_cols << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  // Store the masks in the order of the points of the tree.
+  if (tree::TreeTraits<Tree>::RearrangesDataset &&
+      !oldFromNewReferences.empty())
+  {
+    referenceMasks.set_size(masks.n_elem);
+    for (size_t i = 0; i < masks.n_elem; ++i)
+      referenceMasks[i] = masks[oldFromNewReferences[i]];
+  }
+  else
+  {
+    referenceMasks = masks;
+  }
+
+  if (referenceTree)
+    UpdateLabelMasks(*referenceTree);
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+uint64_t NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::UpdateLabelMasks(Tree& node)
+{
+  uint64_t mask = 0;
+  for (size_t i = 0; i < node.NumPoints(); ++i)
+    mask |= referenceMasks[node.Point(i)];
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    mask |= UpdateLabelMasks(node.Child(i));
+
+  node.Stat().LabelMask() = mask;
+  return mask;
+}
+
 /**
  * Computes the best neighbors and stores them in resultingNeighbors and
  * distances.
@@ -439,6 +702,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     {
       // Create the helper object for the tree traversal.
       RuleType rules(*referenceSet, querySet, k, metric, epsilon);
+      rules.Filter(referenceMasks, filter);
 
       // The naive brute-force traversal.
       for (size_t i = 0; i < querySet.n_cols; ++i)
@@ -454,13 +718,10 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     {
       // Create the helper object for the tree traversal.
       RuleType rules(*referenceSet, querySet, k, metric, epsilon);
+      rules.Filter(referenceMasks, filter);
 
-      // Create the traverser.
-      SingleTreeTraversalType<RuleType> traverser(rules);
-
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+      // Now traverse for each point.
+      SingleTreeTraverse(querySet.n_cols, rules);
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
@@ -484,11 +745,9 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
       // Create the helper object for the tree traversal.
       RuleType rules(*referenceSet, queryTree->Dataset(), k, metric, epsilon);
+      rules.Filter(referenceMasks, filter);
 
-      // Create the traverser.
-      DualTreeTraversalType<RuleType> traverser(rules);
-
-      traverser.Traverse(*queryTree, *referenceTree);
+      DualTreeTraverse(*queryTree, rules);
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
@@ -507,6 +766,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     {
       // Create the helper object for the tree traversal.
       RuleType rules(*referenceSet, querySet, k, metric);
+      rules.Filter(referenceMasks, filter);
 
       // Create the traverser.
       tree::GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
@@ -590,6 +850,134 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   }
 } // Search()
 
+/**
+ * Computes the best neighbors within the given budget for each query point,
+ * and stores them in neighbors and distances, with a bound on the distance of
+ * the points that were not seen in bounds.
+ */
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    const size_t maxBaseCases,
+    const double maxTime,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances,
+    arma::vec& bounds)
+{
+  if (k > referenceSet->n_cols)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set (" << referenceSet->n_cols << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  if (searchMode == NAIVE_MODE)
+  {
+    throw std::invalid_argument("NeighborSearch::Search(): a search with a "
+        "budget needs a reference tree, and cannot be done in naive mode");
+  }
+
+  Timer::Start("computing_neighbors");
+
+  baseCases = 0;
+  scores = 0;
+
+  // Reference indices need to be mapped if the tree rearranged the points.
+  arma::Mat<size_t>* neighborPtr = &neighbors;
+  if (tree::TreeTraits<Tree>::RearrangesDataset &&
+      !oldFromNewReferences.empty())
+    neighborPtr = new arma::Mat<size_t>;
+
+  neighborPtr->set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+  bounds.set_size(querySet.n_cols);
+
+  typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
+  typedef tree::BestFirstSingleTreeTraverser<Tree, RuleType> TraverserType;
+
+  RuleType rules(*referenceSet, querySet, k, metric, epsilon);
+  rules.Filter(referenceMasks, filter);
+
+  // A traversal that was not finished leaves nodes whose points may be better
+  // than the results; the best of them bounds the distance of those points.
+  // The results of a finished traversal are exact.
+  #ifdef HAS_OPENMP
+  // As in SingleTreeTraverse(), trees with self-children cannot be shared
+  // between threads.
+  const size_t numThreads = omp_get_max_threads();
+  if (numThreads > 1 && querySet.n_cols > 1 &&
+      !tree::TreeTraits<Tree>::HasSelfChildren)
+  {
+    // The copies of the rules share the candidate lists, and each query point
+    // is searched by one thread only.
+    std::vector<RuleType> threadRules(numThreads - 1, rules);
+
+    #pragma omp parallel num_threads(numThreads) MLPACK_OMP_PROC_BIND
+    {
+      const size_t thread = omp_get_thread_num();
+      RuleType& threadRule = (thread == 0) ? rules : threadRules[thread - 1];
+      TraverserType traverser(threadRule, maxBaseCases, maxTime);
+
+      #pragma omp for schedule(dynamic, 16)
+      for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+      {
+        traverser.Traverse(i, *referenceTree);
+        bounds[i] = (traverser.RemainingScore() == DBL_MAX) ?
+            SortPolicy::WorstDistance() :
+            SortPolicy::ConvertToDistance(traverser.RemainingScore());
+      }
+    }
+
+    tree::MergeTraversalCounts(rules, threadRules);
+  }
+  else
+  #endif
+  {
+    TraverserType traverser(rules, maxBaseCases, maxTime);
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+    {
+      traverser.Traverse(i, *referenceTree);
+      bounds[i] = (traverser.RemainingScore() == DBL_MAX) ?
+          SortPolicy::WorstDistance() :
+          SortPolicy::ConvertToDistance(traverser.RemainingScore());
+    }
+  }
+
+  scores += rules.Scores();
+  baseCases += rules.BaseCases();
+
+  Log::Info << rules.Scores() << " node combinations were scored."
+      << std::endl;
+  Log::Info << rules.BaseCases() << " base cases were calculated."
+      << std::endl;
+
+  rules.GetResults(*neighborPtr, distances);
+
+  Timer::Stop("computing_neighbors");
+
+  // Map points back to original indices, if necessary.
+  if (neighborPtr != &neighbors)
+  {
+    neighbors.set_size(k, querySet.n_cols);
+    for (size_t i = 0; i < neighbors.n_cols; ++i)
+      for (size_t j = 0; j < neighbors.n_rows; ++j)
+        neighbors(j, i) = oldFromNewReferences[(*neighborPtr)(j, i)];
+
+    // Finished with temporary matrix.
+    delete neighborPtr;
+  }
+} // Search()
+
 template<typename SortPolicy,
          typename MetricType,
          typename MatType,
@@ -640,10 +1028,9 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   // Create the helper object for the traversal.
   typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
   RuleType rules(*referenceSet, querySet, k, metric, epsilon, sameSet);
+  rules.Filter(referenceMasks, filter);
 
-  // Create the traverser.
-  DualTreeTraversalType<RuleType> traverser(rules);
-  traverser.Traverse(queryTree, *referenceTree);
+  DualTreeTraverse(queryTree, rules);
 
   scores += rules.Scores();
   baseCases += rules.BaseCases();
@@ -685,22 +1072,63 @@ template<typename SortPolicy,
          template<typename> class SingleTreeTraversalType>
 void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
 DualTreeTraversalType, SingleTreeTraversalType>::Search(
+    tree::PreparedQuery<Tree>& query,
     const size_t k,
     arma::Mat<size_t>& neighbors,
     arma::mat& distances)
 {
-  if (k > referenceSet->n_cols)
+  // Forget the bounds of the last search with this query tree.
+  query.ResetStatistics();
+
+  Search(query.QueryTree(), k, neighbors, distances);
+
+  query.Unmap(neighbors);
+  query.Unmap(distances);
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::Search(
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  // Points deleted from a rectangle tree keep their columns in the reference
+  // set, but they are not searched for; only the points still held by the tree
+  // are queries.
+  std::vector<bool> held;
+  std::vector<size_t> queries;
+  if (tree::IsRectangleTree<Tree>::value && referenceTree &&
+      referenceTree->NumDescendants() < referenceSet->n_cols)
+  {
+    held.resize(referenceSet->n_cols, false);
+    MarkTreePoints(*referenceTree, held);
+    for (size_t i = 0; i < held.size(); ++i)
+      if (held[i])
+        queries.push_back(i);
+  }
+  const size_t numPoints = held.empty() ? referenceSet->n_cols :
+      queries.size();
+
+  if (k > numPoints)
   {
     std::stringstream ss;
     ss << "Requested value of k (" << k << ") is greater than the number of "
-        << "points in the reference set (" << referenceSet->n_cols << ")";
+        << "points in the reference set (" << numPoints << ")";
     throw std::invalid_argument(ss.str());
   }
-  if (k == referenceSet->n_cols)
+  if (k == numPoints)
   {
     std::stringstream ss;
     ss << "Requested value of k (" << k << ") is equal to the number of "
-        << "points in the reference set (" << referenceSet->n_cols << ") and "
+        << "points in the reference set (" << numPoints << ") and "
         << "no query set has been provided.";
     throw std::invalid_argument(ss.str());
   }
@@ -729,27 +1157,27 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
   RuleType rules(*referenceSet, *referenceSet, k, metric, epsilon,
       true /* don't return the same point as nearest neighbor */);
+  rules.Filter(referenceMasks, filter);
 
   switch (searchMode)
   {
     case NAIVE_MODE:
     {
       // The naive brute-force solution.
-      for (size_t i = 0; i < referenceSet->n_cols; ++i)
-        for (size_t j = 0; j < referenceSet->n_cols; ++j)
-          rules.BaseCase(i, j);
+      for (size_t i = 0; i < numPoints; ++i)
+      {
+        const size_t query = held.empty() ? i : queries[i];
+        for (size_t j = 0; j < numPoints; ++j)
+          rules.BaseCase(query, held.empty() ? j : queries[j]);
+      }
 
-      baseCases += referenceSet->n_cols * referenceSet->n_cols;
+      baseCases += numPoints * numPoints;
       break;
     }
     case SINGLE_TREE_MODE:
     {
-      // Create the traverser.
-      SingleTreeTraversalType<RuleType> traverser(rules);
-
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < referenceSet->n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+      // Now traverse for each point.
+      SingleTreeTraverse(numPoints, rules, queries);
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
@@ -782,19 +1210,16 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
         }
       }
 
-      // Create the traverser.
-      DualTreeTraversalType<RuleType> traverser(rules);
-
       if (tree::IsSpillTree<Tree>::value)
       {
         // For Dual Tree Search on SpillTree, the queryTree must be built with
         // non overlapping (tau = 0).
         Tree queryTree(*referenceSet);
-        traverser.Traverse(queryTree, *referenceTree);
+        DualTreeTraverse(queryTree, rules);
       }
       else
       {
-        traverser.Traverse(*referenceTree, *referenceTree);
+        DualTreeTraverse(*referenceTree, rules);
         // Next time we perform this search, we'll need to reset the tree.
         treeNeedsReset = true;
       }
@@ -817,8 +1242,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       tree::GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
 
       // Now have it traverse for each point.
-      for (size_t i = 0; i < referenceSet->n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+      for (size_t i = 0; i < numPoints; ++i)
+        traverser.Traverse(held.empty() ? i : queries[i], *referenceTree);
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
@@ -833,6 +1258,16 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
   rules.GetResults(*neighborPtr, *distancePtr);
 
+  // Deleted points have no neighbors.
+  for (size_t i = 0; i < held.size(); ++i)
+  {
+    if (!held[i])
+    {
+      neighborPtr->col(i).fill(size_t() - 1);
+      distancePtr->col(i).fill(SortPolicy::WorstDistance());
+    }
+  }
+
   Timer::Stop("computing_neighbors");
 
   // Do we need to map the reference indices?
@@ -859,6 +1294,110 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   }
 }
 
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+template<typename RuleType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::DualTreeTraverse(
+    Tree& queryTree,
+    RuleType& rules)
+{
+  #ifdef HAS_OPENMP
+  // Spill trees may hold a query point in more than one node, so their query
+  // subtrees do not partition the query set; we never split them.
+  const size_t numThreads = omp_get_max_threads();
+  if (parallelDepth > 0 && numThreads > 1 && !tree::IsSpillTree<Tree>::value)
+  {
+    std::vector<Tree*> tasks;
+    tree::CollectTaskNodes(queryTree, parallelDepth, tasks);
+
+    if (tasks.size() > 1)
+    {
+      // Each thread other than the first gets its own copy of the rules, so
+      // that base case caches and traversal information are never shared.
+      // The copies share the candidate lists, but the tasks partition the
+      // query points, and the statistics of each query subtree are only
+      // touched by the thread that traverses it.
+      std::vector<RuleType> threadRules(numThreads - 1, rules);
+
+      #pragma omp parallel for schedule(dynamic) num_threads(numThreads) \
+          MLPACK_OMP_PROC_BIND
+      for (omp_size_t i = 0; i < (omp_size_t) tasks.size(); ++i)
+      {
+        const size_t thread = omp_get_thread_num();
+        RuleType& threadRule = (thread == 0) ? rules : threadRules[thread - 1];
+
+        DualTreeTraversalType<RuleType> traverser(threadRule);
+        traverser.Traverse(*tasks[i], *referenceTree);
+      }
+
+      tree::MergeTraversalCounts(rules, threadRules);
+
+      return;
+    }
+  }
+  #endif
+
+  DualTreeTraversalType<RuleType> traverser(rules);
+  traverser.Traverse(queryTree, *referenceTree);
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+template<typename RuleType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::SingleTreeTraverse(
+    const size_t numQueries,
+    RuleType& rules,
+    const std::vector<size_t>& queries)
+{
+  #ifdef HAS_OPENMP
+  // Trees with self-children cache distance evaluations in the statistics of
+  // the reference tree during single-tree search, so they cannot be shared
+  // between threads.
+  const size_t numThreads = omp_get_max_threads();
+  if (numThreads > 1 && numQueries > 1 &&
+      !tree::TreeTraits<Tree>::HasSelfChildren)
+  {
+    // Each thread other than the first gets its own copy of the rules.  The
+    // copies share the candidate lists, but each query point is searched by
+    // one thread only.
+    std::vector<RuleType> threadRules(numThreads - 1, rules);
+
+    #pragma omp parallel num_threads(numThreads) MLPACK_OMP_PROC_BIND
+    {
+      const size_t thread = omp_get_thread_num();
+      RuleType& threadRule = (thread == 0) ? rules : threadRules[thread - 1];
+      SingleTreeTraversalType<RuleType> traverser(threadRule);
+
+      #pragma omp for schedule(dynamic, 16)
+      for (omp_size_t i = 0; i < (omp_size_t) numQueries; ++i)
+        traverser.Traverse(queries.empty() ? i : queries[i], *referenceTree);
+    }
+
+    tree::MergeTraversalCounts(rules, threadRules);
+
+    return;
+  }
+  #endif
+
+  SingleTreeTraversalType<RuleType> traverser(rules);
+  for (size_t i = 0; i < numQueries; ++i)
+    traverser.Traverse(queries.empty() ? i : queries[i], *referenceTree);
+}
+
 //! Calculate the average relative error.
 template<typename SortPolicy,
          typename MetricType,
@@ -994,6 +1533,13 @@ DualTreeTraversalType, SingleTreeTraversalType>::serialize(
   {
     baseCases = 0;
     scores = 0;
+
+    // The masks of the reference points are not saved.
+    referenceMasks.clear();
+
+    // The loaded reference points are spread over the memory of the machine
+    // (only with MLPACK_USE_NUMA).
+    util::FirstTouch(const_cast<MatType&>(*referenceSet));
   }
 }
 
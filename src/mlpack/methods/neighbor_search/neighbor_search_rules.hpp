@@ -14,7 +14,9 @@
 #define MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/hrectbound.hpp>
 
+#include <memory>
 #include <queue>
 
 namespace mlpack {
@@ -27,6 +29,11 @@ namespace neighbor {
  * reference dataset which have the 'best' distance according to a given sorting
  * policy.
  *
+ * Copies of a NeighborSearchRules object share its candidate lists, so that
+ * several threads can each traverse with their own copy and write their results
+ * directly into the same lists.  Such threads must search disjoint sets of
+ * query points.
+ *
  * @tparam SortPolicy The sort policy for distances.
  * @tparam MetricType The metric to use for computation.
  * @tparam TreeType The tree type to use; must adhere to the TreeType API.
@@ -63,6 +70,20 @@ class NeighborSearchRules
    */
   void GetResults(arma::Mat<size_t>& neighbors, arma::mat& distances);
 
+  /**
+   * Only return the reference points whose mask shares a bit with the given
+   * filter.  Reference nodes whose label mask (see NeighborSearchStat) shares
+   * no bit with the filter are pruned, so the label masks of the reference
+   * tree must be up to date.  Base cases with other points are still computed
+   * (the traversal may need their distances), but the points are not
+   * returned.  An empty set of masks disables filtering.
+   *
+   * @param referenceMasks Mask of each reference point; it must outlive the
+   *     search.
+   * @param filter Filter of the search.
+   */
+  void Filter(const arma::Col<uint64_t>& referenceMasks, const uint64_t filter);
+
   /**
    * Get the distance from the query point to the reference point.
    * This will update the list of candidates with the new point if appropriate
@@ -73,6 +94,24 @@ class NeighborSearchRules
    */
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
+  /**
+   * Compute the base cases between all of the points held in a query leaf and
+   * a reference leaf at once.  Query points that cannot be improved by the
+   * reference node are skipped first (as with Score(queryIndex,
+   * referenceNode)); then, for LMetric and dense data with at least
+   * BatchMinDimensionality dimensions and BatchMinPairs pairs, the distances
+   * for the remaining points are computed as one block with
+   * LMetric::BatchEvaluate().  Otherwise, and for other metrics, BaseCase() is
+   * called for every pair, since gathering the block costs more than it saves
+   * for small leaves or low-dimensional data.  This is used by the dual-tree
+   * traverser of BinarySpaceTree when both nodes are leaves.
+   *
+   * @param queryNode Query leaf.
+   * @param referenceNode Reference leaf.
+   * @return The number of (query, reference) pairs that were evaluated.
+   */
+  size_t LeafBaseCases(TreeType& queryNode, TreeType& referenceNode);
+
   /**
    * Get the score for recursion order.  A low score indicates priority for
    * recursion, while DBL_MAX indicates that the node should not be recursed
@@ -161,6 +200,13 @@ class NeighborSearchRules
   //! results.  This is only needed in defeatist search mode.
   size_t MinimumBaseCases() const { return k; }
 
+  //! The minimum dimensionality for which LeafBaseCases() computes a block of
+  //! distances at once.
+  static constexpr size_t BatchMinDimensionality = 16;
+  //! The minimum number of (query, reference) pairs for which LeafBaseCases()
+  //! computes a block of distances at once.
+  static constexpr size_t BatchMinPairs = 32;
+
  protected:
   //! The reference set.
   const typename TreeType::Mat& referenceSet;
@@ -183,8 +229,8 @@ class NeighborSearchRules
   typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
       CandidateList;
 
-  //! Set of candidate neighbors for each point.
-  std::vector<CandidateList> candidates;
+  //! Set of candidate neighbors for each point; copies of the rules share it.
+  std::shared_ptr<std::vector<CandidateList>> candidates;
 
   //! Number of neighbors to search for.
   const size_t k;
@@ -198,6 +244,11 @@ class NeighborSearchRules
   //! Relative error to be considered in approximate search.
   const double epsilon;
 
+  //! The mask of each reference point, or NULL if the search is not filtered.
+  const uint64_t* referenceMasks;
+  //! The filter of the search.
+  uint64_t filter;
+
   //! The last query point BaseCase() was called with.
   size_t lastQueryIndex;
   //! The last reference point BaseCase() was called with.
@@ -214,11 +265,44 @@ class NeighborSearchRules
   //! traversal before each call to Score().
   TraversalInfoType traversalInfo;
 
+  //! The query points of the current leaf that LeafBaseCases() evaluates.
+  std::vector<size_t> leafQueries;
+  //! Indices of the query points of the current block of base cases.
+  arma::uvec batchQueryIndices;
+  //! Indices of the reference points of the current block of base cases.
+  arma::uvec batchReferenceIndices;
+  //! The query points of the current block of base cases.
+  arma::Mat<typename TreeType::ElemType> batchQueries;
+  //! The reference points of the current block of base cases.
+  arma::Mat<typename TreeType::ElemType> batchReferences;
+  //! The distances of the current block of base cases.
+  arma::Mat<typename TreeType::ElemType> batchDistances;
+
   /**
    * Recalculate the bound for a given query node.
    */
   double CalculateBound(TreeType& queryNode) const;
 
+  //! Compute the leaf base cases in one block, for LMetric and dense data.
+  template<typename MT = MetricType, typename MatType = typename TreeType::Mat>
+  void BatchBaseCases(const std::vector<size_t>& queries,
+                      TreeType& referenceNode,
+                      const typename std::enable_if<
+                          bound::meta::IsLMetric<MT>::Value &&
+                          arma::is_Mat<MatType>::value>::type* = 0);
+
+  //! Compute the leaf base cases one pair at a time.
+  void PairBaseCases(const std::vector<size_t>& queries,
+                     TreeType& referenceNode);
+
+  //! Compute the leaf base cases one pair at a time, for any other metric.
+  template<typename MT = MetricType, typename MatType = typename TreeType::Mat>
+  void BatchBaseCases(const std::vector<size_t>& queries,
+                      TreeType& referenceNode,
+                      const typename std::enable_if<
+                          !(bound::meta::IsLMetric<MT>::Value &&
+                          arma::is_Mat<MatType>::value)>::type* = 0);
+
   /**
    * Helper function to insert a point into the list of candidate points.
    *
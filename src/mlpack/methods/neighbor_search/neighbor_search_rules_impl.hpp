@@ -33,6 +33,8 @@ NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
     metric(metric),
     sameSet(sameSet),
     epsilon(epsilon),
+    referenceMasks(NULL),
+    filter(0),
     lastQueryIndex(querySet.n_cols),
     lastReferenceIndex(referenceSet.n_cols),
     baseCases(0),
@@ -54,9 +56,7 @@ NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
   std::vector<Candidate> vect(k, def);
   CandidateList pqueue(CandidateCmp(), std::move(vect));
 
-  candidates.reserve(querySet.n_cols);
-  for (size_t i = 0; i < querySet.n_cols; ++i)
-    candidates.push_back(pqueue);
+  candidates.reset(new std::vector<CandidateList>(querySet.n_cols, pqueue));
 }
 
 template<typename SortPolicy, typename MetricType, typename TreeType>
@@ -69,7 +69,7 @@ void NeighborSearchRules<SortPolicy, MetricType, TreeType>::GetResults(
 
   for (size_t i = 0; i < querySet.n_cols; ++i)
   {
-    CandidateList& pqueue = candidates[i];
+    CandidateList& pqueue = (*candidates)[i];
     for (size_t j = 1; j <= k; ++j)
     {
       neighbors(k - j, i) = pqueue.top().second;
@@ -79,6 +79,16 @@ void NeighborSearchRules<SortPolicy, MetricType, TreeType>::GetResults(
   }
 };
 
+template<typename SortPolicy, typename MetricType, typename TreeType>
+void NeighborSearchRules<SortPolicy, MetricType, TreeType>::Filter(
+    const arma::Col<uint64_t>& referenceMasks,
+    const uint64_t filter)
+{
+  this->referenceMasks = referenceMasks.is_empty() ? NULL :
+      referenceMasks.memptr();
+  this->filter = filter;
+}
+
 template<typename SortPolicy, typename MetricType, typename TreeType>
 inline force_inline // Absolutely MUST be inline so optimizations can happen.
 double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
@@ -97,7 +107,9 @@ BaseCase(const size_t queryIndex, const size_t referenceIndex)
                                     referenceSet.col(referenceIndex));
   ++baseCases;
 
-  InsertNeighbor(queryIndex, referenceIndex, distance);
+  // Points that do not pass the filter are not returned.
+  if (!referenceMasks || (referenceMasks[referenceIndex] & filter))
+    InsertNeighbor(queryIndex, referenceIndex, distance);
 
   // Cache this information for the next time BaseCase() is called.
   lastQueryIndex = queryIndex;
@@ -107,12 +119,124 @@ BaseCase(const size_t queryIndex, const size_t referenceIndex)
   return distance;
 }
 
+template<typename SortPolicy, typename MetricType, typename TreeType>
+size_t NeighborSearchRules<SortPolicy, MetricType, TreeType>::LeafBaseCases(
+    TreeType& queryNode,
+    TreeType& referenceNode)
+{
+  // Only the query points that can still be improved by this reference node
+  // need to be considered.
+  leafQueries.clear();
+  for (size_t i = 0; i < queryNode.NumPoints(); ++i)
+  {
+    const size_t queryIndex = queryNode.Point(i);
+    if (Score(queryIndex, referenceNode) != DBL_MAX)
+      leafQueries.push_back(queryIndex);
+  }
+
+  if (leafQueries.empty())
+    return 0;
+
+  BatchBaseCases(leafQueries, referenceNode);
+  return leafQueries.size() * referenceNode.NumPoints();
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+void NeighborSearchRules<SortPolicy, MetricType, TreeType>::PairBaseCases(
+    const std::vector<size_t>& queries,
+    TreeType& referenceNode)
+{
+  for (size_t i = 0; i < queries.size(); ++i)
+    for (size_t j = 0; j < referenceNode.NumPoints(); ++j)
+      BaseCase(queries[i], referenceNode.Point(j));
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+template<typename MT, typename MatType>
+void NeighborSearchRules<SortPolicy, MetricType, TreeType>::BatchBaseCases(
+    const std::vector<size_t>& queries,
+    TreeType& referenceNode,
+    const typename std::enable_if<
+        bound::meta::IsLMetric<MT>::Value &&
+        arma::is_Mat<MatType>::value>::type*)
+{
+  // Gathering the points into blocks only pays off when there are enough
+  // dimensions and pairs.
+  const size_t numRefs = referenceNode.NumPoints();
+  if (querySet.n_rows < BatchMinDimensionality ||
+      queries.size() * numRefs < BatchMinPairs)
+  {
+    PairBaseCases(queries, referenceNode);
+    return;
+  }
+
+  // The buffers are members, so their memory is reused between leaves.
+  batchReferenceIndices.set_size(numRefs);
+  for (size_t j = 0; j < numRefs; ++j)
+    batchReferenceIndices[j] = referenceNode.Point(j);
+
+  batchQueryIndices.set_size(queries.size());
+  for (size_t i = 0; i < queries.size(); ++i)
+    batchQueryIndices[i] = queries[i];
+
+  batchQueries = querySet.cols(batchQueryIndices);
+  batchReferences = referenceSet.cols(batchReferenceIndices);
+  MetricType::BatchEvaluate(batchQueries, batchReferences, batchDistances);
+
+  for (size_t i = 0; i < queries.size(); ++i)
+  {
+    for (size_t j = 0; j < numRefs; ++j)
+    {
+      const size_t queryIndex = queries[i];
+      const size_t referenceIndex = batchReferenceIndices[j];
+
+      // Identical points are not returned when the sets are the same, and a
+      // pair that BaseCase() has just evaluated must not be inserted twice.
+      if (sameSet && (queryIndex == referenceIndex))
+        continue;
+      if ((lastQueryIndex == queryIndex) &&
+          (lastReferenceIndex == referenceIndex))
+        continue;
+
+      if (!referenceMasks || (referenceMasks[referenceIndex] & filter))
+        InsertNeighbor(queryIndex, referenceIndex, batchDistances(i, j));
+      ++baseCases;
+    }
+  }
+
+  // Keep the cache of BaseCase() consistent with the last evaluated pair.
+  const size_t lastRef = batchReferenceIndices[numRefs - 1];
+  if (!(sameSet && (queries.back() == lastRef)))
+  {
+    lastQueryIndex = queries.back();
+    lastReferenceIndex = lastRef;
+    lastBaseCase = batchDistances(queries.size() - 1, numRefs - 1);
+  }
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+template<typename MT, typename MatType>
+void NeighborSearchRules<SortPolicy, MetricType, TreeType>::BatchBaseCases(
+    const std::vector<size_t>& queries,
+    TreeType& referenceNode,
+    const typename std::enable_if<
+        !(bound::meta::IsLMetric<MT>::Value &&
+        arma::is_Mat<MatType>::value)>::type*)
+{
+  PairBaseCases(queries, referenceNode);
+}
+
 template<typename SortPolicy, typename MetricType, typename TreeType>
 inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
     const size_t queryIndex,
     TreeType& referenceNode)
 {
   ++scores; // Count number of Score() calls.
+
+  // Prune nodes without any point that passes the filter.
+  if (referenceMasks && !(referenceNode.Stat().LabelMask() & filter))
+    return DBL_MAX;
+
   double distance;
   if (tree::TreeTraits<TreeType>::FirstPointIsCentroid)
   {
@@ -143,7 +267,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
   }
 
   // Compare against the best k'th distance for this query point so far.
-  double bestDistance = candidates[queryIndex].top().first;
+  double bestDistance = (*candidates)[queryIndex].top().first;
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
   return (SortPolicy::IsBetter(distance, bestDistance)) ?
@@ -179,7 +303,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Rescore(
   const double distance = SortPolicy::ConvertToDistance(oldScore);
 
   // Just check the score again against the distances.
-  double bestDistance = candidates[queryIndex].top().first;
+  double bestDistance = (*candidates)[queryIndex].top().first;
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
   return (SortPolicy::IsBetter(distance, bestDistance)) ? oldScore : DBL_MAX;
@@ -192,6 +316,10 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
 {
   ++scores; // Count number of Score() calls.
 
+  // Prune nodes without any point that passes the filter.
+  if (referenceMasks && !(referenceNode.Stat().LabelMask() & filter))
+    return DBL_MAX;
+
   // Update our bound.
   const double bestDistance = CalculateBound(queryNode);
 
@@ -404,7 +532,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
   // Loop over points held in the node.
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double distance = candidates[queryNode.Point(i)].top().first;
+    const double distance = (*candidates)[queryNode.Point(i)].top().first;
     if (SortPolicy::IsBetter(worstDistance, distance))
       worstDistance = distance;
     if (SortPolicy::IsBetter(distance, bestPointDistance))
@@ -499,7 +627,7 @@ InsertNeighbor(
     const size_t neighbor,
     const double distance)
 {
-  CandidateList& pqueue = candidates[queryIndex];
+  CandidateList& pqueue = (*candidates)[queryIndex];
   Candidate c = std::make_pair(distance, neighbor);
 
   if (CandidateCmp()(c, pqueue.top()))
@@ -39,6 +39,9 @@ class NeighborSearchStat
   double auxBound;
   //! The last distance evaluation.
   double lastDistance;
+  //! The union of the masks of the reference points held by this node and its
+  //! descendants, used by filtered search.
+  uint64_t labelMask;
 
  public:
   /**
@@ -49,7 +52,8 @@ class NeighborSearchStat
       firstBound(SortPolicy::WorstDistance()),
       secondBound(SortPolicy::WorstDistance()),
       auxBound(SortPolicy::WorstDistance()),
-      lastDistance(0.0) { }
+      lastDistance(0.0),
+      labelMask(~uint64_t(0)) { }
 
   /**
    * Initialization for a fully initialized node.  In this case, we don't need
@@ -60,10 +64,12 @@ class NeighborSearchStat
       firstBound(SortPolicy::WorstDistance()),
       secondBound(SortPolicy::WorstDistance()),
       auxBound(SortPolicy::WorstDistance()),
-      lastDistance(0.0) { }
+      lastDistance(0.0),
+      labelMask(~uint64_t(0)) { }
 
   /**
-   * Reset statistic parameters to initial values.
+   * Reset statistic parameters to initial values.  The label mask is not
+   * reset, since it depends only on the reference points.
    */
   void Reset()
   {
@@ -89,6 +95,10 @@ class NeighborSearchStat
   double LastDistance() const { return lastDistance; }
   //! Modify the last distance calculation.
   double& LastDistance() { return lastDistance; }
+  //! Get the union of the masks of the reference points of this node.
+  uint64_t LabelMask() const { return labelMask; }
+  //! Modify the union of the masks of the reference points of this node.
+  uint64_t& LabelMask() { return labelMask; }
 
   //! Serialize the statistic to/from an archive.
   template<typename Archive>
@@ -98,6 +108,11 @@ class NeighborSearchStat
     ar(CEREAL_NVP(secondBound));
     ar(CEREAL_NVP(auxBound));
     ar(CEREAL_NVP(lastDistance));
+
+    // The label mask is not saved; the masks must be given again after
+    // loading.
+    if (cereal::is_loading<Archive>())
+      labelMask = ~uint64_t(0);
   }
 };
 
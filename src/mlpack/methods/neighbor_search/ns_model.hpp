@@ -31,7 +31,10 @@ namespace neighbor {
  * supported by NSModel.  All NeighborSearch type wrappers inherit from this
  * class, allowing a simple interface via inheritance for all the different
  * types we want to support.
+ *
+ * @tparam MatType Type of data matrix (e.g. arma::mat or arma::fmat).
  */
+template<typename MatType = arma::mat>
 class NSWrapperBase
 {
  public:
@@ -47,7 +50,7 @@ class NSWrapperBase
   virtual ~NSWrapperBase() { };
 
   //! Return a reference to the dataset.
-  virtual const arma::mat& Dataset() const = 0;
+  virtual const MatType& Dataset() const = 0;
 
   //! Get the search mode.
   virtual NeighborSearchMode SearchMode() const = 0;
@@ -60,14 +63,24 @@ class NSWrapperBase
   virtual double& Epsilon() = 0;
 
   //! Train the NeighborSearch model with the given parameters.
-  virtual void Train(arma::mat&& referenceSet,
+  virtual void Train(MatType&& referenceSet,
                      const size_t leafSize,
                      const double tau,
                      const double rho) = 0;
 
+  //! Add the given points to the reference set, rebuilding the tree with the
+  //! given parameters if it doesn't support insertion.
+  virtual void Insert(MatType&& points,
+                      const size_t leafSize,
+                      const double tau,
+                      const double rho) = 0;
+
+  //! Remove the reference point with the given index.
+  virtual void Delete(const size_t index) = 0;
+
   //! Perform bichromatic neighbor search (i.e. search with a separate query
   //! set).
-  virtual void Search(arma::mat&& querySet,
+  virtual void Search(MatType&& querySet,
                       const size_t k,
                       arma::Mat<size_t>& neighbors,
                       arma::mat& distances,
@@ -83,6 +96,9 @@ class NSWrapperBase
 
 /**
  * NSWrapper is a wrapper class for most NeighborSearch types.
+ *
+ * The default traversal types are those of trees built on arma::mat; for
+ * another MatType, they must be given too (see DefaultNSWrapper).
  */
 template<typename SortPolicy,
          template<typename TreeMetricType,
@@ -95,8 +111,9 @@ template<typename SortPolicy,
          template<typename RuleType> class SingleTreeTraversalType =
              TreeType<metric::EuclideanDistance,
                       NeighborSearchStat<SortPolicy>,
-                      arma::mat>::template SingleTreeTraverser>
-class NSWrapper : public NSWrapperBase
+                      arma::mat>::template SingleTreeTraverser,
+         typename MatType = arma::mat>
+class NSWrapper : public NSWrapperBase<MatType>
 {
  public:
   //! Construct the NSWrapper object, initializing the internally-held
@@ -116,7 +133,7 @@ class NSWrapper : public NSWrapperBase
   virtual NSWrapper* Clone() const { return new NSWrapper(*this); }
 
   //! Get a reference to the reference set.
-  const arma::mat& Dataset() const { return ns.ReferenceSet(); }
+  const MatType& Dataset() const { return ns.ReferenceSet(); }
 
   //! Get the search mode.
   NeighborSearchMode SearchMode() const { return ns.SearchMode(); }
@@ -130,14 +147,26 @@ class NSWrapper : public NSWrapperBase
 
   //! Train the model with the given options.  For NSWrapper, we ignore the
   //! extra parameters.
-  virtual void Train(arma::mat&& referenceSet,
+  virtual void Train(MatType&& referenceSet,
                      const size_t /* leafSize */,
                      const double /* tau */,
                      const double /* rho */);
 
+  //! Add the given points to the reference set.  Rectangle trees insert the
+  //! points directly; other trees are rebuilt on the extended reference set
+  //! with the given parameters (through Train()).
+  virtual void Insert(MatType&& points,
+                      const size_t leafSize,
+                      const double tau,
+                      const double rho);
+
+  //! Remove the reference point with the given index.  This is only supported
+  //! by rectangle trees.
+  virtual void Delete(const size_t index) { ns.Delete(index); }
+
   //! Perform bichromatic neighbor search (i.e. search with a separate query
   //! set).  For NSWrapper, we ignore the extra parameters.
-  virtual void Search(arma::mat&& querySet,
+  virtual void Search(MatType&& querySet,
                       const size_t k,
                       arma::Mat<size_t>& neighbors,
                       arma::mat& distances,
@@ -161,7 +190,7 @@ class NSWrapper : public NSWrapperBase
   // Convenience typedef for the neighbor search type held by this class.
   typedef NeighborSearch<SortPolicy,
                          metric::EuclideanDistance,
-                         arma::mat,
+                         MatType,
                          TreeType,
                          DualTreeTraversalType,
                          SingleTreeTraversalType> NSType;
@@ -186,12 +215,14 @@ template<typename SortPolicy,
          template<typename RuleType> class SingleTreeTraversalType =
              TreeType<metric::EuclideanDistance,
                       NeighborSearchStat<SortPolicy>,
-                      arma::mat>::template SingleTreeTraverser>
+                      arma::mat>::template SingleTreeTraverser,
+         typename MatType = arma::mat>
 class LeafSizeNSWrapper :
     public NSWrapper<SortPolicy,
                      TreeType,
                      DualTreeTraversalType,
-                     SingleTreeTraversalType>
+                     SingleTreeTraversalType,
+                     MatType>
 {
  public:
   //! Construct the LeafSizeNSWrapper by delegating to the NSWrapper
@@ -201,7 +232,8 @@ class LeafSizeNSWrapper :
       NSWrapper<SortPolicy,
                 TreeType,
                 DualTreeTraversalType,
-                SingleTreeTraversalType>(searchMode, epsilon)
+                SingleTreeTraversalType,
+                MatType>(searchMode, epsilon)
   {
     // Nothing to do.
   }
@@ -217,14 +249,14 @@ class LeafSizeNSWrapper :
 
   //! Train a model with the given parameters.  This overload uses leafSize but
   //! ignores the other parameters.
-  virtual void Train(arma::mat&& referenceSet,
+  virtual void Train(MatType&& referenceSet,
                      const size_t leafSize,
                      const double /* tau */,
                      const double /* rho */);
 
   //! Perform bichromatic search (e.g. search with a separate query set).  This
   //! overload uses the leaf size, but ignores the other parameters.
-  virtual void Search(arma::mat&& querySet,
+  virtual void Search(MatType&& querySet,
                       const size_t k,
                       arma::Mat<size_t>& neighbors,
                       arma::mat& distances,
@@ -242,24 +274,64 @@ class LeafSizeNSWrapper :
   using NSWrapper<SortPolicy,
                   TreeType,
                   DualTreeTraversalType,
-                  SingleTreeTraversalType>::ns;
+                  SingleTreeTraversalType,
+                  MatType>::ns;
 };
 
+/**
+ * The NSWrapper for the given tree type and matrix type, using the default
+ * traversers of the tree built on that matrix type.
+ */
+template<typename SortPolicy,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         typename MatType = arma::mat>
+using DefaultNSWrapper = NSWrapper<SortPolicy,
+    TreeType,
+    TreeType<metric::EuclideanDistance,
+             NeighborSearchStat<SortPolicy>,
+             MatType>::template DualTreeTraverser,
+    TreeType<metric::EuclideanDistance,
+             NeighborSearchStat<SortPolicy>,
+             MatType>::template SingleTreeTraverser,
+    MatType>;
+
+/**
+ * The LeafSizeNSWrapper for the given tree type and matrix type, using the
+ * default traversers of the tree built on that matrix type.
+ */
+template<typename SortPolicy,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         typename MatType = arma::mat>
+using DefaultLeafSizeNSWrapper = LeafSizeNSWrapper<SortPolicy,
+    TreeType,
+    TreeType<metric::EuclideanDistance,
+             NeighborSearchStat<SortPolicy>,
+             MatType>::template DualTreeTraverser,
+    TreeType<metric::EuclideanDistance,
+             NeighborSearchStat<SortPolicy>,
+             MatType>::template SingleTreeTraverser,
+    MatType>;
+
 /**
  * The SpillNSWrapper class wraps the NeighborSearch class when the spill tree
  * is used.
  */
-template<typename SortPolicy>
+template<typename SortPolicy, typename MatType = arma::mat>
 class SpillNSWrapper :
     public NSWrapper<
         SortPolicy,
         tree::SPTree,
         tree::SPTree<metric::EuclideanDistance,
                      NeighborSearchStat<SortPolicy>,
-                     arma::mat>::template DefeatistDualTreeTraverser,
+                     MatType>::template DefeatistDualTreeTraverser,
         tree::SPTree<metric::EuclideanDistance,
                      NeighborSearchStat<SortPolicy>,
-                     arma::mat>::template DefeatistSingleTreeTraverser>
+                     MatType>::template DefeatistSingleTreeTraverser,
+        MatType>
 {
  public:
   //! Construct the SpillNSWrapper.
@@ -270,10 +342,11 @@ class SpillNSWrapper :
           tree::SPTree,
           tree::SPTree<metric::EuclideanDistance,
                        NeighborSearchStat<SortPolicy>,
-                       arma::mat>::template DefeatistDualTreeTraverser,
+                       MatType>::template DefeatistDualTreeTraverser,
           tree::SPTree<metric::EuclideanDistance,
                        NeighborSearchStat<SortPolicy>,
-                       arma::mat>::template DefeatistSingleTreeTraverser>(
+                       MatType>::template DefeatistSingleTreeTraverser,
+          MatType>(
           searchMode, epsilon)
   {
     // Nothing to do.
@@ -286,14 +359,14 @@ class SpillNSWrapper :
   virtual SpillNSWrapper* Clone() const { return new SpillNSWrapper(*this); }
 
   //! Train the model using the given parameters.
-  virtual void Train(arma::mat&& referenceSet,
+  virtual void Train(MatType&& referenceSet,
                      const size_t leafSize,
                      const double tau,
                      const double rho);
 
   //! Perform bichromatic search (i.e. search with a different query set) using
   //! the given parameters.
-  virtual void Search(arma::mat&& querySet,
+  virtual void Search(MatType&& querySet,
                       const size_t k,
                       arma::Mat<size_t>& neighbors,
                       arma::mat& distances,
@@ -313,10 +386,11 @@ class SpillNSWrapper :
       tree::SPTree,
       tree::SPTree<metric::EuclideanDistance,
                    NeighborSearchStat<SortPolicy>,
-                   arma::mat>::template DefeatistDualTreeTraverser,
+                   MatType>::template DefeatistDualTreeTraverser,
       tree::SPTree<metric::EuclideanDistance,
                    NeighborSearchStat<SortPolicy>,
-                   arma::mat>::template DefeatistSingleTreeTraverser>::ns;
+                   MatType>::template DefeatistSingleTreeTraverser,
+      MatType>::ns;
 };
 
 /**
@@ -328,8 +402,10 @@ class SpillNSWrapper :
  * mlpack_knn and mlpack_kfn, be aware that it is limited!
  *
  * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam MatType Type of data matrix; use arma::fmat to store and search the
+ *     data in single precision.
  */
-template<typename SortPolicy>
+template<typename SortPolicy, typename MatType = arma::mat>
 class NSModel
 {
  public:
@@ -360,7 +436,7 @@ class NSModel
   //! If true, random projections are used.
   bool randomBasis;
   //! This is the random projection matrix; only used if randomBasis is true.
-  arma::mat q;
+  MatType q;
 
   size_t leafSize;
   double tau;
@@ -370,7 +446,7 @@ class NSModel
    * nSearch holds an instance of the NeighborSearch class for the current
    * treeType. It is initialized every time BuildModel is executed.
    */
-  NSWrapperBase* nSearch;
+  NSWrapperBase<MatType>* nSearch;
 
  public:
   /**
@@ -419,7 +495,7 @@ class NSModel
   void serialize(Archive& ar, const uint32_t /* version */);
 
   //! Expose the dataset.
-  const arma::mat& Dataset() const;
+  const MatType& Dataset() const;
 
   //! Expose SearchMode.
   NeighborSearchMode SearchMode() const;
@@ -454,16 +530,49 @@ class NSModel
                        const double epsilon);
 
   //! Build the reference tree.
-  void BuildModel(arma::mat&& referenceSet,
+  void BuildModel(MatType&& referenceSet,
                   const NeighborSearchMode searchMode,
                   const double epsilon = 0);
 
+  /**
+   * Add the given points to the reference set, projecting them onto the random
+   * basis if one is used.  The new points get the indices after the last
+   * existing reference point.  With R trees, R* trees, X trees, Hilbert R
+   * trees, R+ trees and R++ trees the points are inserted into the existing
+   * tree; with the other tree types the tree is rebuilt on the extended
+   * reference set.
+   *
+   * @param points Points to add to the reference set.
+   */
+  void Insert(MatType&& points);
+
+  /**
+   * Remove the reference point with the given index, so that it is never
+   * returned as a neighbor again; the indices of the other points do not
+   * change.  This is only supported with R trees, R* trees, X trees, Hilbert R
+   * trees, R+ trees and R++ trees, in tree-based search modes; otherwise
+   * std::invalid_argument is thrown.
+   *
+   * @param index Index of the reference point to remove.
+   */
+  void Delete(const size_t index);
+
   //! Perform neighbor search.  The query set will be reordered.
-  void Search(arma::mat&& querySet,
+  void Search(MatType&& querySet,
               const size_t k,
               arma::Mat<size_t>& neighbors,
               arma::mat& distances);
 
+  //! Perform neighbor search with a copy of the given query set (the Python
+  //! binding calls this directly; see bindings/python/print_model_methods.hpp).
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances)
+  {
+    Search(MatType(querySet), k, neighbors, distances);
+  }
+
   //! Perform monochromatic neighbor search.
   void Search(const size_t k,
               arma::Mat<size_t>& neighbors,
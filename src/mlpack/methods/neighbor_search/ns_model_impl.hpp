@@ -28,10 +28,12 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename RuleType> class DualTreeTraversalType,
-         template<typename RuleType> class SingleTreeTraversalType>
+         template<typename RuleType> class SingleTreeTraversalType,
+         typename MatType>
 void NSWrapper<
-    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
->::Train(arma::mat&& referenceSet,
+    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType,
+    MatType
+>::Train(MatType&& referenceSet,
          const size_t /* leafSize */,
          const double /* tau */,
          const double /* rho */)
@@ -39,6 +41,58 @@ void NSWrapper<
   ns.Train(std::move(referenceSet));
 }
 
+//! Add points to the reference set.  Trees that can't insert points are
+//! rebuilt through Train(), so that derived wrappers use their own parameters.
+template<typename SortPolicy,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename RuleType> class DualTreeTraversalType,
+         template<typename RuleType> class SingleTreeTraversalType,
+         typename MatType>
+void NSWrapper<
+    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType,
+    MatType
+>::Insert(MatType&& points,
+          const size_t leafSize,
+          const double tau,
+          const double rho)
+{
+  const MatType& oldReferenceSet = ns.ReferenceSet();
+  if (ns.SearchMode() == NAIVE_MODE || oldReferenceSet.n_cols == 0 ||
+      tree::IsRectangleTree<typename NSType::Tree>::value)
+  {
+    ns.Insert(points);
+    return;
+  }
+
+  if (points.n_rows != oldReferenceSet.n_rows)
+  {
+    std::stringstream ss;
+    ss << "NSModel::Insert(): dimensionality of new points (" << points.n_rows
+        << ") does not match dimensionality of reference set ("
+        << oldReferenceSet.n_rows << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  // Restore the original order of the reference points, so that their
+  // indices are kept, and append the new points.
+  const size_t oldSize = oldReferenceSet.n_cols;
+  MatType referenceSet(oldReferenceSet.n_rows, oldSize + points.n_cols);
+  if (ns.oldFromNewReferences.size() == oldSize)
+  {
+    for (size_t i = 0; i < oldSize; ++i)
+      referenceSet.col(ns.oldFromNewReferences[i]) = oldReferenceSet.col(i);
+  }
+  else
+  {
+    referenceSet.cols(0, oldSize - 1) = oldReferenceSet;
+  }
+  referenceSet.cols(oldSize, referenceSet.n_cols - 1) = points;
+
+  Train(std::move(referenceSet), leafSize, tau, rho);
+}
+
 //! Perform bichromatic neighbor search (i.e. search with a separate query
 //! set).  For NSWrapper, we ignore the extra parameters.
 template<typename SortPolicy,
@@ -46,10 +100,12 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename RuleType> class DualTreeTraversalType,
-         template<typename RuleType> class SingleTreeTraversalType>
+         template<typename RuleType> class SingleTreeTraversalType,
+         typename MatType>
 void NSWrapper<
-    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
->::Search(arma::mat&& querySet,
+    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType,
+    MatType
+>::Search(MatType&& querySet,
           const size_t k,
           arma::Mat<size_t>& neighbors,
           arma::mat& distances,
@@ -66,9 +122,11 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename RuleType> class DualTreeTraversalType,
-         template<typename RuleType> class SingleTreeTraversalType>
+         template<typename RuleType> class SingleTreeTraversalType,
+         typename MatType>
 void NSWrapper<
-    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
+    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType,
+    MatType
 >::Search(const size_t k,
           arma::Mat<size_t>& neighbors,
           arma::mat& distances)
@@ -83,10 +141,12 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename RuleType> class DualTreeTraversalType,
-         template<typename RuleType> class SingleTreeTraversalType>
+         template<typename RuleType> class SingleTreeTraversalType,
+         typename MatType>
 void LeafSizeNSWrapper<
-    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
->::Train(arma::mat&& referenceSet,
+    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType,
+    MatType
+>::Train(MatType&& referenceSet,
          const size_t leafSize,
          const double /* tau */,
          const double /* rho */)
@@ -113,10 +173,12 @@ template<typename SortPolicy,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType,
          template<typename RuleType> class DualTreeTraversalType,
-         template<typename RuleType> class SingleTreeTraversalType>
+         template<typename RuleType> class SingleTreeTraversalType,
+         typename MatType>
 void LeafSizeNSWrapper<
-    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType
->::Search(arma::mat&& querySet,
+    SortPolicy, TreeType, DualTreeTraversalType, SingleTreeTraversalType,
+    MatType
+>::Search(MatType&& querySet,
           const size_t k,
           arma::Mat<size_t>& neighbors,
           arma::mat& distances,
@@ -153,11 +215,11 @@ void LeafSizeNSWrapper<
 }
 
 //! Train the model using the given parameters.
-template<typename SortPolicy>
-void SpillNSWrapper<SortPolicy>::Train(arma::mat&& referenceSet,
-                                       const size_t leafSize,
-                                       const double tau,
-                                       const double rho)
+template<typename SortPolicy, typename MatType>
+void SpillNSWrapper<SortPolicy, MatType>::Train(MatType&& referenceSet,
+                                                const size_t leafSize,
+                                                const double tau,
+                                                const double rho)
 {
   typename decltype(ns)::Tree tree(std::move(referenceSet), tau, leafSize,
       rho);
@@ -166,13 +228,13 @@ void SpillNSWrapper<SortPolicy>::Train(arma::mat&& referenceSet,
 
 //! Perform bichromatic search (i.e. search with a different query set) using
 //! the given parameters.
-template<typename SortPolicy>
-void SpillNSWrapper<SortPolicy>::Search(arma::mat&& querySet,
-                                        const size_t k,
-                                        arma::Mat<size_t>& neighbors,
-                                        arma::mat& distances,
-                                        const size_t leafSize,
-                                        const double rho)
+template<typename SortPolicy, typename MatType>
+void SpillNSWrapper<SortPolicy, MatType>::Search(MatType&& querySet,
+                                                 const size_t k,
+                                                 arma::Mat<size_t>& neighbors,
+                                                 arma::mat& distances,
+                                                 const size_t leafSize,
+                                                 const double rho)
 {
   if (ns.SearchMode() == DUAL_TREE_MODE)
   {
@@ -192,8 +254,8 @@ void SpillNSWrapper<SortPolicy>::Search(arma::mat&& querySet,
  * Initialize the NSModel with the given type and whether or not a random
  * basis should be used.
  */
-template<typename SortPolicy>
-NSModel<SortPolicy>::NSModel(TreeTypes treeType, bool randomBasis) :
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>::NSModel(TreeTypes treeType, bool randomBasis) :
     treeType(treeType),
     randomBasis(randomBasis),
     leafSize(20),
@@ -204,8 +266,8 @@ NSModel<SortPolicy>::NSModel(TreeTypes treeType, bool randomBasis) :
   // Nothing to do.
 }
 
-template<typename SortPolicy>
-NSModel<SortPolicy>::NSModel(const NSModel& other) :
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>::NSModel(const NSModel& other) :
     treeType(other.treeType),
     randomBasis(other.randomBasis),
     q(other.q),
@@ -217,8 +279,8 @@ NSModel<SortPolicy>::NSModel(const NSModel& other) :
   // Nothing to do.
 }
 
-template<typename SortPolicy>
-NSModel<SortPolicy>::NSModel(NSModel&& other) :
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>::NSModel(NSModel&& other) :
     treeType(other.treeType),
     randomBasis(other.randomBasis),
     q(std::move(other.q)),
@@ -236,8 +298,9 @@ NSModel<SortPolicy>::NSModel(NSModel&& other) :
   other.nSearch = NULL;
 }
 
-template<typename SortPolicy>
-NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(const NSModel& other)
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>&
+NSModel<SortPolicy, MatType>::operator=(const NSModel& other)
 {
   if (this != &other)
   {
@@ -255,8 +318,9 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(const NSModel& other)
   return *this;
 }
 
-template<typename SortPolicy>
-NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>&
+NSModel<SortPolicy, MatType>::operator=(NSModel&& other)
 {
   if (this != &other)
   {
@@ -283,16 +347,17 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
 }
 
 //! Clean memory, if necessary.
-template<typename SortPolicy>
-NSModel<SortPolicy>::~NSModel()
+template<typename SortPolicy, typename MatType>
+NSModel<SortPolicy, MatType>::~NSModel()
 {
   delete nSearch;
 }
 
 //! Serialize the kNN model.
-template<typename SortPolicy>
+template<typename SortPolicy, typename MatType>
 template<typename Archive>
-void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
+void NSModel<SortPolicy, MatType>::serialize(Archive& ar,
+                                             const uint32_t /* version */)
 {
   ar(CEREAL_NVP(treeType));
   ar(CEREAL_NVP(randomBasis));
@@ -310,110 +375,115 @@ void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
   {
     case KD_TREE:
       {
-        LeafSizeNSWrapper<SortPolicy, tree::KDTree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy,
-                         tree::KDTree>&>(*nSearch);
+        typedef DefaultLeafSizeNSWrapper<SortPolicy, tree::KDTree, MatType>
+            WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case COVER_TREE:
       {
-        NSWrapper<SortPolicy, tree::StandardCoverTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy,
-                                   tree::StandardCoverTree>&>(*nSearch);
+        typedef DefaultNSWrapper<SortPolicy, tree::StandardCoverTree, MatType>
+            WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case R_TREE:
       {
-        NSWrapper<SortPolicy, tree::RTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, tree::RTree>&>(*nSearch);
+        typedef DefaultNSWrapper<SortPolicy, tree::RTree, MatType> WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case R_STAR_TREE:
       {
-        NSWrapper<SortPolicy, tree::RStarTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, tree::RStarTree>&>(*nSearch);
+        typedef DefaultNSWrapper<SortPolicy, tree::RStarTree, MatType>
+            WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case BALL_TREE:
       {
-        LeafSizeNSWrapper<SortPolicy, tree::BallTree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy,
-                                           tree::BallTree>&>(*nSearch);
+        typedef DefaultLeafSizeNSWrapper<SortPolicy, tree::BallTree, MatType>
+            WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case X_TREE:
       {
-        NSWrapper<SortPolicy, tree::XTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, tree::XTree>&>(*nSearch);
+        typedef DefaultNSWrapper<SortPolicy, tree::XTree, MatType> WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case HILBERT_R_TREE:
       {
-        NSWrapper<SortPolicy, tree::HilbertRTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, tree::HilbertRTree>&>(*nSearch);
+        typedef DefaultNSWrapper<SortPolicy, tree::HilbertRTree, MatType>
+            WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case R_PLUS_TREE:
       {
-        NSWrapper<SortPolicy, tree::RPlusTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, tree::RPlusTree>&>(*nSearch);
+        typedef DefaultNSWrapper<SortPolicy, tree::RPlusTree, MatType>
+            WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case R_PLUS_PLUS_TREE:
       {
-        NSWrapper<SortPolicy, tree::RPlusPlusTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, tree::RPlusPlusTree>&>(*nSearch);
+        typedef DefaultNSWrapper<SortPolicy, tree::RPlusPlusTree, MatType>
+            WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case SPILL_TREE:
       {
-        SpillNSWrapper<SortPolicy>& typedSearch =
-            dynamic_cast<SpillNSWrapper<SortPolicy>&>(*nSearch);
+        SpillNSWrapper<SortPolicy, MatType>& typedSearch =
+            dynamic_cast<SpillNSWrapper<SortPolicy, MatType>&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case VP_TREE:
       {
-        NSWrapper<SortPolicy, tree::VPTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, tree::VPTree>&>(*nSearch);
+        typedef DefaultNSWrapper<SortPolicy, tree::VPTree, MatType> WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case RP_TREE:
       {
-        NSWrapper<SortPolicy, tree::RPTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, tree::RPTree>&>(*nSearch);
+        typedef DefaultNSWrapper<SortPolicy, tree::RPTree, MatType> WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case MAX_RP_TREE:
       {
-        NSWrapper<SortPolicy, tree::MaxRPTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, tree::MaxRPTree>&>(*nSearch);
+        typedef DefaultNSWrapper<SortPolicy, tree::MaxRPTree, MatType>
+            WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case UB_TREE:
       {
-        NSWrapper<SortPolicy, tree::UBTree>& typedSearch =
-            dynamic_cast<NSWrapper<SortPolicy, tree::UBTree>&>(*nSearch);
+        typedef DefaultNSWrapper<SortPolicy, tree::UBTree, MatType> WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
     case OCTREE:
       {
-        LeafSizeNSWrapper<SortPolicy, tree::Octree>& typedSearch =
-            dynamic_cast<LeafSizeNSWrapper<SortPolicy,
-                                           tree::Octree>&>(*nSearch);
+        typedef DefaultLeafSizeNSWrapper<SortPolicy, tree::Octree, MatType>
+            WrapperType;
+        WrapperType& typedSearch = dynamic_cast<WrapperType&>(*nSearch);
         ar(CEREAL_NVP(typedSearch));
         break;
       }
@@ -421,42 +491,43 @@ void NSModel<SortPolicy>::serialize(Archive& ar, const uint32_t /* version */)
 }
 
 //! Expose the dataset.
-template<typename SortPolicy>
-const arma::mat& NSModel<SortPolicy>::Dataset() const
+template<typename SortPolicy, typename MatType>
+const MatType& NSModel<SortPolicy, MatType>::Dataset() const
 {
   return nSearch->Dataset();
 }
 
 //! Access the search mode.
-template<typename SortPolicy>
-NeighborSearchMode NSModel<SortPolicy>::SearchMode() const
+template<typename SortPolicy, typename MatType>
+NeighborSearchMode NSModel<SortPolicy, MatType>::SearchMode() const
 {
   return nSearch->SearchMode();
 }
 
 //! Modify the search mode.
-template<typename SortPolicy>
-NeighborSearchMode& NSModel<SortPolicy>::SearchMode()
+template<typename SortPolicy, typename MatType>
+NeighborSearchMode& NSModel<SortPolicy, MatType>::SearchMode()
 {
   return nSearch->SearchMode();
 }
 
-template<typename SortPolicy>
-double NSModel<SortPolicy>::Epsilon() const
+template<typename SortPolicy, typename MatType>
+double NSModel<SortPolicy, MatType>::Epsilon() const
 {
   return nSearch->Epsilon();
 }
 
-template<typename SortPolicy>
-double& NSModel<SortPolicy>::Epsilon()
+template<typename SortPolicy, typename MatType>
+double& NSModel<SortPolicy, MatType>::Epsilon()
 {
   return nSearch->Epsilon();
 }
 
 //! Initialize a model given the tree type.  (No training happens here.)
-template<typename SortPolicy>
-void NSModel<SortPolicy>::InitializeModel(const NeighborSearchMode searchMode,
-                                          const double epsilon)
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::InitializeModel(
+    const NeighborSearchMode searchMode,
+    const double epsilon)
 {
   // Clear existing memory.
   if (nSearch)
@@ -465,65 +536,75 @@ void NSModel<SortPolicy>::InitializeModel(const NeighborSearchMode searchMode,
   switch (treeType)
   {
     case KD_TREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, tree::KDTree>(searchMode,
-          epsilon);
+      nSearch = new DefaultLeafSizeNSWrapper<SortPolicy, tree::KDTree, MatType>(
+          searchMode, epsilon);
       break;
     case COVER_TREE:
-      nSearch = new NSWrapper<SortPolicy, tree::StandardCoverTree>(searchMode,
-          epsilon);
+      nSearch = new DefaultNSWrapper<SortPolicy, tree::StandardCoverTree,
+          MatType>(searchMode, epsilon);
       break;
     case R_TREE:
-      nSearch = new NSWrapper<SortPolicy, tree::RTree>(searchMode, epsilon);
+      nSearch = new DefaultNSWrapper<SortPolicy, tree::RTree, MatType>(
+          searchMode, epsilon);
       break;
     case R_STAR_TREE:
-      nSearch = new NSWrapper<SortPolicy, tree::RStarTree>(searchMode, epsilon);
+      nSearch = new DefaultNSWrapper<SortPolicy, tree::RStarTree, MatType>(
+          searchMode, epsilon);
       break;
     case BALL_TREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, tree::BallTree>(searchMode,
-          epsilon);
+      nSearch = new DefaultLeafSizeNSWrapper<SortPolicy, tree::BallTree,
+          MatType>(searchMode, epsilon);
       break;
     case X_TREE:
-      nSearch = new NSWrapper<SortPolicy, tree::XTree>(searchMode, epsilon);
+      nSearch = new DefaultNSWrapper<SortPolicy, tree::XTree, MatType>(
+          searchMode, epsilon);
       break;
     case HILBERT_R_TREE:
-      nSearch = new NSWrapper<SortPolicy, tree::HilbertRTree>(searchMode,
-          epsilon);
+      nSearch = new DefaultNSWrapper<SortPolicy, tree::HilbertRTree, MatType>(
+          searchMode, epsilon);
       break;
     case R_PLUS_TREE:
-      nSearch = new NSWrapper<SortPolicy, tree::RPlusTree>(searchMode, epsilon);
+      nSearch = new DefaultNSWrapper<SortPolicy, tree::RPlusTree, MatType>(
+          searchMode, epsilon);
       break;
     case R_PLUS_PLUS_TREE:
-      nSearch = new NSWrapper<SortPolicy, tree::RPlusPlusTree>(searchMode,
-          epsilon);
+      nSearch = new DefaultNSWrapper<SortPolicy, tree::RPlusPlusTree, MatType>(
+          searchMode, epsilon);
       break;
     case VP_TREE:
-      nSearch = new NSWrapper<SortPolicy, tree::VPTree>(searchMode, epsilon);
+      nSearch = new DefaultNSWrapper<SortPolicy, tree::VPTree, MatType>(
+          searchMode, epsilon);
       break;
     case RP_TREE:
-      nSearch = new NSWrapper<SortPolicy, tree::RPTree>(searchMode, epsilon);
+      nSearch = new DefaultNSWrapper<SortPolicy, tree::RPTree, MatType>(
+          searchMode, epsilon);
       break;
     case MAX_RP_TREE:
-      nSearch = new NSWrapper<SortPolicy, tree::MaxRPTree>(searchMode, epsilon);
+      nSearch = new DefaultNSWrapper<SortPolicy, tree::MaxRPTree, MatType>(
+          searchMode, epsilon);
       break;
     case SPILL_TREE:
-      nSearch = new SpillNSWrapper<SortPolicy>(searchMode, epsilon);
+      nSearch = new SpillNSWrapper<SortPolicy, MatType>(searchMode,
+          epsilon);
       break;
     case UB_TREE:
-      nSearch = new NSWrapper<SortPolicy, tree::UBTree>(searchMode, epsilon);
+      nSearch = new DefaultNSWrapper<SortPolicy, tree::UBTree, MatType>(
+          searchMode, epsilon);
       break;
     case OCTREE:
-      nSearch = new LeafSizeNSWrapper<SortPolicy, tree::Octree>(searchMode,
-          epsilon);
+      nSearch = new DefaultLeafSizeNSWrapper<SortPolicy, tree::Octree, MatType>(
+          searchMode, epsilon);
       break;
   }
 
 }
 
 //! Build the reference tree.
-template<typename SortPolicy>
-void NSModel<SortPolicy>::BuildModel(arma::mat&& referenceSet,
-                                     const NeighborSearchMode searchMode,
-                                     const double epsilon)
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::BuildModel(
+    MatType&& referenceSet,
+    const NeighborSearchMode searchMode,
+    const double epsilon)
 {
   // Initialize random basis if necessary.
   if (randomBasis)
@@ -533,11 +614,11 @@ void NSModel<SortPolicy>::BuildModel(arma::mat&& referenceSet,
     {
       // [Q, R] = qr(randn(d, d));
       // Q = Q * diag(sign(diag(R)));
-      arma::mat r;
-      if (arma::qr(q, r, arma::randn<arma::mat>(referenceSet.n_rows,
+      MatType r;
+      if (arma::qr(q, r, arma::randn<MatType>(referenceSet.n_rows,
               referenceSet.n_rows)))
       {
-        arma::vec rDiag(r.n_rows);
+        arma::Col<typename MatType::elem_type> rDiag(r.n_rows);
         for (size_t i = 0; i < rDiag.n_elem; ++i)
         {
           if (r(i, i) < 0)
@@ -577,12 +658,34 @@ void NSModel<SortPolicy>::BuildModel(arma::mat&& referenceSet,
   }
 }
 
+//! Add points to the reference set.
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::Insert(MatType&& points)
+{
+  // The new points live in the same space as the reference set.
+  if (randomBasis)
+    points = q * points;
+
+  Timer::Start("tree_building");
+  Log::Info << "Inserting " << points.n_cols << " points into the "
+      << TreeName() << "..." << std::endl;
+  nSearch->Insert(std::move(points), leafSize, tau, rho);
+  Timer::Stop("tree_building");
+}
+
+//! Remove a point from the reference set.
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::Delete(const size_t index)
+{
+  nSearch->Delete(index);
+}
+
 //! Perform neighbor search.  The query set will be reordered.
-template<typename SortPolicy>
-void NSModel<SortPolicy>::Search(arma::mat&& querySet,
-                                 const size_t k,
-                                 arma::Mat<size_t>& neighbors,
-                                 arma::mat& distances)
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::Search(MatType&& querySet,
+                                          const size_t k,
+                                          arma::Mat<size_t>& neighbors,
+                                          arma::mat& distances)
 {
   // We may need to map the query set randomly.
   if (randomBasis)
@@ -611,10 +714,10 @@ void NSModel<SortPolicy>::Search(arma::mat&& querySet,
 }
 
 //! Perform neighbor search.
-template<typename SortPolicy>
-void NSModel<SortPolicy>::Search(const size_t k,
-                                 arma::Mat<size_t>& neighbors,
-                                 arma::mat& distances)
+template<typename SortPolicy, typename MatType>
+void NSModel<SortPolicy, MatType>::Search(const size_t k,
+                                          arma::Mat<size_t>& neighbors,
+                                          arma::mat& distances)
 {
   Log::Info << "Searching for " << k << " neighbors with ";
 
@@ -643,8 +746,8 @@ void NSModel<SortPolicy>::Search(const size_t k,
 }
 
 //! Get the name of the tree type.
-template<typename SortPolicy>
-std::string NSModel<SortPolicy>::TreeName() const
+template<typename SortPolicy, typename MatType>
+std::string NSModel<SortPolicy, MatType>::TreeName() const
 {
   switch (treeType)
   {
@@ -0,0 +1,122 @@
+/**
+ * @file methods/neighbor_search/spill_tau_calibration.hpp
+ *
+ * Choose the overlapping size (tau) of the spill tree used by SpillKNN from the
+ * recall of the defeatist search on a sample of query points.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SPILL_TAU_CALIBRATION_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SPILL_TAU_CALIBRATION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "neighbor_search.hpp"
+
+namespace mlpack {
+namespace neighbor /** Neighbor-search routines. */ {
+
+/**
+ * Find the smallest overlapping size tau of a spill tree for which the
+ * defeatist single-tree search of SpillKNN finds at least the given fraction
+ * of the true k nearest neighbors of the query points.  A larger tau puts more
+ * points in the overlapping buffers, which gives a better recall, but a deeper
+ * tree that takes longer to build and to search; so tau is best chosen on a
+ * sample of the queries before the whole set is searched.
+ *
+ * A spill tree is built on the reference set for each candidate tau, and the
+ * recall of its search is compared with an exact search.  In the search, the
+ * traversal only goes to the best child of the overlapping nodes, and
+ * backtracks normally into the non-overlapping nodes (see
+ * SpillSingleTreeTraverser); the recall usually rises with tau, and the search
+ * is exact once tau is so large that no buffer stays under the balance
+ * threshold rho.
+ *
+ * @code
+ * extern arma::mat referenceSet, querySet;
+ * arma::vec recalls;
+ * const arma::mat sample = querySet.cols(arma::randperm(querySet.n_cols, 100));
+ * const double tau = CalibrateSpillTau(referenceSet, sample, 5, 0.9,
+ *     arma::linspace<arma::vec>(0, 1, 11), recalls);
+ * SpillKNN knn(SpillKNN::Tree(referenceSet, tau), SINGLE_TREE_MODE);
+ * @endcode
+ *
+ * @param referenceSet Set of reference points.
+ * @param querySet Set of query points (usually a sample of the queries).
+ * @param k Number of neighbors to search for.
+ * @param targetRecall Fraction of the true neighbors to find, in [0, 1].
+ * @param taus Candidate values of tau (non-negative).
+ * @param recalls Vector to store the recall of each candidate tau in.
+ * @param maxLeafSize Maximum number of points held in a leaf of the trees.
+ * @param rho Balance threshold of the trees.
+ * @return The smallest candidate tau that reaches the target recall, or the
+ *     candidate with the best recall if none does.
+ */
+inline double CalibrateSpillTau(const arma::mat& referenceSet,
+                                const arma::mat& querySet,
+                                const size_t k,
+                                const double targetRecall,
+                                const arma::vec& taus,
+                                arma::vec& recalls,
+                                const size_t maxLeafSize = 20,
+                                const double rho = 0.7)
+{
+  if (taus.is_empty())
+  {
+    throw std::invalid_argument("CalibrateSpillTau(): no candidate values of "
+        "tau given!");
+  }
+
+  if (targetRecall < 0.0 || targetRecall > 1.0)
+  {
+    throw std::invalid_argument("CalibrateSpillTau(): target recall must be in "
+        "the range [0, 1]!");
+  }
+
+  if (arma::any(taus < 0.0))
+  {
+    throw std::invalid_argument("CalibrateSpillTau(): candidate values of tau "
+        "must be non-negative!");
+  }
+
+  // Find the true neighbors of the query points.
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  KNN exact(referenceSet);
+  exact.Search(querySet, k, trueNeighbors, trueDistances);
+
+  recalls.set_size(taus.n_elem);
+  for (size_t i = 0; i < taus.n_elem; ++i)
+  {
+    SpillKNN::Tree tree(referenceSet, taus[i], maxLeafSize, rho);
+    SpillKNN spill(std::move(tree), SINGLE_TREE_MODE);
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    spill.Search(querySet, k, neighbors, distances);
+
+    recalls[i] = SpillKNN::Recall(neighbors, trueNeighbors);
+  }
+
+  // Take the smallest tau that reaches the target, if any.
+  double bestTau = 0.0;
+  bool found = false;
+  for (size_t i = 0; i < taus.n_elem; ++i)
+  {
+    if (recalls[i] >= targetRecall && (!found || taus[i] < bestTau))
+    {
+      bestTau = taus[i];
+      found = true;
+    }
+  }
+
+  return found ? bestTau : taus[recalls.index_max()];
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,174 @@
+/**
+ * @file methods/nystroem_method/nystroem_features.hpp
+ *
+ * An explicit feature map whose dot products approximate a kernel, built with
+ * the Nystroem method.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NYSTROEM_METHOD_NYSTROEM_FEATURES_HPP
+#define MLPACK_METHODS_NYSTROEM_METHOD_NYSTROEM_FEATURES_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
+#include "kmeans_selection.hpp"
+
+namespace mlpack {
+namespace kernel {
+
+/**
+ * The Nystroem feature map.  Given m landmark points L selected from the
+ * training data, each point x is mapped to the m-dimensional vector
+ *
+ *   z(x) = S^(-1/2) U^T K(L, x),
+ *
+ * where K_LL = U S U^T is the kernel matrix of the landmarks, so that
+ * z(x)^T z(y) = K(x, L) K_LL^+ K(L, y) is the Nystroem approximation of
+ * K(x, y), as computed by NystroemMethod for the training points.  Unlike
+ * NystroemMethod, the map can be applied to new points, so that a linear model
+ * trained on the features approximates a kernel machine at both training and
+ * prediction time.  Mapping a batch of points is the kernel matrix between the
+ * landmarks and the points (one matrix product for the kernels declared in
+ * KernelMatrixTraits) followed by one more matrix product.
+ *
+ * @code
+ * extern arma::mat data;
+ * NystroemFeatures<GaussianKernel> features(100, GaussianKernel(2.0));
+ * features.Train(data);
+ * arma::mat mapped;
+ * features.Transform(data, mapped);
+ * @endcode
+ *
+ * @tparam KernelType Kernel to approximate.
+ * @tparam PointSelectionPolicy Policy used to select the landmarks.
+ */
+template<typename KernelType,
+         typename PointSelectionPolicy = KMeansSelection<>>
+class NystroemFeatures
+{
+ public:
+  /**
+   * Create the feature map; the landmarks are selected by Train().
+   *
+   * @param rank Number of landmarks (and of features).
+   * @param kernel Kernel to approximate.
+   */
+  NystroemFeatures(const size_t rank = 100,
+                   const KernelType& kernel = KernelType()) :
+      rank(rank),
+      kernel(kernel)
+  {
+    if (rank == 0)
+    {
+      throw std::invalid_argument("NystroemFeatures::NystroemFeatures(): rank "
+          "must be positive!");
+    }
+  }
+
+  /**
+   * Select the landmarks from the given data and compute the normalization of
+   * the features.
+   *
+   * @param data Training points, one per column.
+   */
+  void Train(const arma::mat& data)
+  {
+    if (rank > data.n_cols)
+    {
+      std::ostringstream oss;
+      oss << "NystroemFeatures::Train(): rank (" << rank << ") is greater "
+          << "than the number of points (" << data.n_cols << ")!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    SetLandmarks(data, PointSelectionPolicy::Select(data, rank));
+
+    arma::mat miniKernel;
+    KernelMatrix(landmarks, kernel, miniKernel);
+
+    // The features are S^(-1/2) U^T K(L, x); directions of K_LL with a
+    // vanishing singular value are dropped, as in NystroemMethod.
+    arma::mat u, v;
+    arma::vec s;
+    arma::svd(u, s, v, miniKernel);
+    arma::vec normalization = 1.0 / arma::sqrt(s);
+    normalization.elem(arma::find(arma::abs(s) <= 1e-20)).zeros();
+
+    projection = arma::diagmat(normalization) * u.t();
+  }
+
+  /**
+   * Map the given points to the feature space.
+   *
+   * @param input Points to map, one per column.
+   * @param output Matrix to store the features in (rank x number of points).
+   */
+  void Transform(const arma::mat& input, arma::mat& output) const
+  {
+    if (input.n_rows != landmarks.n_rows)
+    {
+      std::ostringstream oss;
+      oss << "NystroemFeatures::Transform(): dimensionality of points ("
+          << input.n_rows << ") does not match the dimensionality of the "
+          << "landmarks (" << landmarks.n_rows << ")!";
+      throw std::invalid_argument(oss.str());
+    }
+
+    // KernelMatrix() takes a non-const kernel.
+    KernelType k(kernel);
+    arma::mat semiKernel;
+    KernelMatrix(landmarks, input, k, semiKernel);
+    output = projection * semiKernel;
+  }
+
+  //! Get the number of features.
+  size_t NumFeatures() const { return rank; }
+  //! Get the kernel.
+  const KernelType& Kernel() const { return kernel; }
+  //! Get the landmarks.
+  const arma::mat& Landmarks() const { return landmarks; }
+  //! Get the projection of the kernel values onto the features.
+  const arma::mat& Projection() const { return projection; }
+
+  //! Serialize the feature map.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(rank));
+    ar(CEREAL_NVP(kernel));
+    ar(CEREAL_NVP(landmarks));
+    ar(CEREAL_NVP(projection));
+  }
+
+ private:
+  //! Store the points selected as landmarks (given as a matrix of points).
+  void SetLandmarks(const arma::mat& /* data */, const arma::mat* selected)
+  {
+    landmarks = *selected;
+    delete selected;
+  }
+
+  //! Store the points selected as landmarks (given as indices of points).
+  void SetLandmarks(const arma::mat& data,
+                    const arma::Col<size_t>& selectedPoints)
+  {
+    landmarks = data.cols(selectedPoints);
+  }
+
+  //! The number of landmarks.
+  size_t rank;
+  //! The kernel to approximate.
+  KernelType kernel;
+  //! The landmarks, one per column.
+  arma::mat landmarks;
+  //! The projection S^(-1/2) U^T of the kernel values onto the features.
+  arma::mat projection;
+};
+
+} // namespace kernel
+} // namespace mlpack
+
+#endif
@@ -65,8 +65,11 @@ class RandomizedSVDPolicy
     arma::mat v;
 
     // Do singular value decomposition using the randomized SVD algorithm.
+    // The centered data is used so that scaling is taken into account; its
+    // mean is (numerically) zero, so the implicit centering of RandomizedSVD
+    // doesn't change it.
     svd::RandomizedSVD rsvd(iteratedPower, maxIterations);
-    rsvd.Apply(data, eigvec, eigVal, v, rank);
+    rsvd.Apply(centeredData, eigvec, eigVal, v, rank);
 
     // Now we must square the singular values to get the eigenvalues.
     // In addition we must divide by the number of points, because the
@@ -45,7 +45,8 @@ class PCA
 
   /**
    * Apply Principal Component Analysis to the provided data set. It is safe
-   * to pass the same matrix reference for both data and transformedData.
+   * to pass the same matrix reference for both data and transformedData; in
+   * that case the data is centered in place, so no copy of it is made.
    *
    * @param data Data matrix.
    * @param transformedData Matrix to put results of PCA into.
@@ -83,6 +84,7 @@ class PCA
    * rest. The parameter returned is the amount of variance of the data that
    * is retained; this is a value between 0 and 1.  For instance, a value of
    * 0.9 indicates that 90% of the variance present in the data was retained.
+   * The data is centered in place, so no copy of it is made.
    *
    * @param data Data matrix.
    * @param newDimension New dimension of the data.
@@ -137,7 +139,7 @@ class PCA
         if (stdDev[i] == 0)
           stdDev[i] = 1e-50;
 
-      centeredData /= arma::repmat(stdDev, 1, centeredData.n_cols);
+      centeredData.each_col() /= stdDev;
     }
   }
 
@@ -46,15 +46,29 @@ void PCA<DecompositionPolicy>::Apply(const arma::mat& data,
 {
   Timer::Start("pca");
 
-  // Center the data into a temporary matrix.
-  arma::mat centeredData;
-  math::Center(data, centeredData);
+  if (&data == &transformedData)
+  {
+    // The data will be overwritten anyway, so center it in place.
+    math::Center(transformedData, transformedData);
 
-  // Scale the data if the user ask for.
-  ScaleData(centeredData);
+    // Scale the data if the user ask for.
+    ScaleData(transformedData);
 
-  decomposition.Apply(data, centeredData, transformedData, eigVal, eigvec,
-      data.n_rows);
+    decomposition.Apply(transformedData, transformedData, transformedData,
+        eigVal, eigvec, transformedData.n_rows);
+  }
+  else
+  {
+    // Center the data into a temporary matrix.
+    arma::mat centeredData;
+    math::Center(data, centeredData);
+
+    // Scale the data if the user ask for.
+    ScaleData(centeredData);
+
+    decomposition.Apply(data, centeredData, transformedData, eigVal, eigvec,
+        data.n_rows);
+  }
 
   Timer::Stop("pca");
 }
@@ -119,14 +133,13 @@ double PCA<DecompositionPolicy>::Apply(arma::mat& data,
 
   Timer::Start("pca");
 
-  // Center the data into a temporary matrix.
-  arma::mat centeredData;
-  math::Center(data, centeredData);
+  // The data will be overwritten anyway, so center it in place.
+  math::Center(data, data);
 
   // Scale the data if the user ask for.
-  ScaleData(centeredData);
+  ScaleData(data);
 
-  decomposition.Apply(data, centeredData, data, eigVal, eigvec, newDimension);
+  decomposition.Apply(data, data, data, eigVal, eigvec, newDimension);
 
   if (newDimension < eigvec.n_rows)
     // Drop unnecessary rows.
@@ -0,0 +1,218 @@
+/**
+ * @file methods/pca/streaming_pca.hpp
+ *
+ * Defines the StreamingPCA class, which performs principal components analysis
+ * on a dataset that is given one chunk of points at a time, so that datasets
+ * larger than memory can be used.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PCA_STREAMING_PCA_HPP
+#define MLPACK_METHODS_PCA_STREAMING_PCA_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace pca {
+
+/**
+ * StreamingPCA computes the principal components of a dataset without ever
+ * holding more than one chunk of it in memory.  Two methods are available.
+ *
+ *  - The covariance method makes a single pass over the data.  The mean and
+ *    the d x d scatter matrix are updated with each chunk (merging the
+ *    statistics of the chunk with the statistics so far, which is numerically
+ *    stable), and the covariance matrix is decomposed at the end.  This needs
+ *    O(d^2) memory, so it is the method of choice when the dimensionality d
+ *    is modest.  Chunks can be passed to Update() one by one, followed by a
+ *    call to Decompose(), or Apply() can be given a loader.
+ *
+ *  - The randomized method finds only the first `rank` components, with a
+ *    randomized range finder and subspace iteration on the covariance matrix,
+ *    as in RandomizedSVD, but each product with the covariance matrix is one
+ *    pass over the data.  This needs O(d * rank) memory and
+ *    powerIterations + 3 passes.
+ *
+ * A loader is any callable object that takes a MatType&, fills it with the
+ * next chunk of points (one point per column), and returns false once a pass
+ * over the data is complete.  For the randomized method, the next call after
+ * that must start a new pass from the first chunk, and every pass must give
+ * the same points.
+ *
+ * @code
+ * data::MappedMatrix<double> points("points.bin", 100, 100000000);
+ * const arma::mat& all = points.Matrix();
+ * size_t next = 0;
+ * auto loader = [&](arma::mat& chunk)
+ * {
+ *   if (next == all.n_cols)
+ *   {
+ *     next = 0; // The next pass starts from the top.
+ *     return false;
+ *   }
+ *
+ *   const size_t last = std::min(next + 100000, (size_t) all.n_cols);
+ *   chunk = all.cols(next, last - 1);
+ *   next = last;
+ *   return true;
+ * };
+ *
+ * StreamingPCA<> pca;
+ * arma::vec eigVal;
+ * arma::mat eigvec;
+ * pca.Apply(loader, eigVal, eigvec);
+ * @endcode
+ *
+ * Once the components are found, Transform() projects chunks onto them.
+ *
+ * @tparam MatType Type of the chunks (usually arma::mat).
+ */
+template<typename MatType = arma::mat>
+class StreamingPCA
+{
+ public:
+  /**
+   * Create the StreamingPCA object, specifying if the data should be scaled
+   * in each dimension by standard deviation when PCA is performed.
+   *
+   * @param scaleData Whether or not to scale the data.
+   */
+  StreamingPCA(const bool scaleData = false);
+
+  /**
+   * Update the mean and the scatter matrix with the points of the given
+   * chunk, for the covariance method.
+   *
+   * @param chunk Points to update the statistics with.
+   */
+  void Update(const MatType& chunk);
+
+  /**
+   * Decompose the covariance matrix of all the points given to Update() so
+   * far.  The eigenvalues are sorted in decreasing order.
+   *
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   */
+  void Decompose(arma::vec& eigVal, arma::mat& eigvec);
+
+  /**
+   * Find all the principal components of the data given by the loader with
+   * the covariance method, in a single pass.  Any previous statistics are
+   * discarded.
+   *
+   * @param loader Callable object that fills the given matrix with the next
+   *     chunk, and returns false when there are no more chunks.
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   */
+  template<typename LoaderType>
+  void Apply(LoaderType&& loader, arma::vec& eigVal, arma::mat& eigvec);
+
+  /**
+   * Find the first rank principal components of the data given by the loader
+   * with the randomized method, in powerIterations + 3 passes.  Any previous
+   * statistics are discarded.
+   *
+   * @param loader Callable object that fills the given matrix with the next
+   *     chunk, and returns false at the end of each pass.
+   * @param rank Number of principal components to find.
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   * @param powerIterations Number of subspace iterations; more iterations
+   *     give more accurate components when the eigenvalues decay slowly.
+   * @param oversampling Number of extra random directions used by the range
+   *     finder.
+   */
+  template<typename LoaderType>
+  void Apply(LoaderType&& loader,
+             const size_t rank,
+             arma::vec& eigVal,
+             arma::mat& eigvec,
+             const size_t powerIterations = 2,
+             const size_t oversampling = 10);
+
+  /**
+   * Project the given points onto the first newDimension principal
+   * components found by the last call to Decompose() or Apply().
+   *
+   * @param chunk Points to project.
+   * @param transformedData Matrix to store the projected points in.
+   * @param newDimension Number of components to project onto (0 means all of
+   *     the components that were found).
+   */
+  void Transform(const MatType& chunk,
+                 arma::mat& transformedData,
+                 const size_t newDimension = 0) const;
+
+  //! Get whether or not the data is scaled by standard deviation.
+  bool ScaleData() const { return scaleData; }
+  //! Modify whether or not the data is scaled by standard deviation.
+  bool& ScaleData() { return scaleData; }
+
+  //! Get the number of points seen so far.
+  size_t Count() const { return count; }
+  //! Get the mean of the points seen so far.
+  const arma::vec& Mean() const { return mean; }
+  //! Get the eigenvalues found by the last decomposition.
+  const arma::vec& Eigenvalues() const { return eigenvalues; }
+  //! Get the eigenvectors found by the last decomposition.
+  const arma::mat& Eigenvectors() const { return eigenvectors; }
+
+  //! Serialize the statistics and the components, so a stream can be resumed.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */);
+
+ private:
+  /**
+   * Update the count, the mean and the sum of squared deviations of each
+   * dimension with the given chunk; if full is true, the whole scatter matrix
+   * is updated too.
+   */
+  void Accumulate(const MatType& chunk, const bool full);
+
+  //! Discard all statistics and components.
+  void Reset();
+
+  //! Compute the standard deviation used to scale each dimension.
+  void ComputeScale();
+
+  //! Center (and scale, if requested) the given chunk.
+  arma::mat Standardize(const MatType& chunk) const;
+
+  /**
+   * Compute the product of the covariance matrix with the given matrix, in
+   * one pass over the data given by the loader.
+   */
+  template<typename LoaderType>
+  arma::mat CovarianceProduct(LoaderType& loader, const arma::mat& q) const;
+
+  //! Whether or not the data will be scaled by standard deviation.
+  bool scaleData;
+  //! Number of points seen so far.
+  size_t count;
+  //! Mean of the points seen so far.
+  arma::vec mean;
+  //! Sum of squared deviations from the mean of each dimension.
+  arma::vec squares;
+  //! Scatter matrix (sum of outer products of deviations from the mean), used
+  //! by the covariance method only.
+  arma::mat scatter;
+  //! Standard deviation of each dimension (ones if the data is not scaled).
+  arma::vec scale;
+  //! Eigenvalues found by the last decomposition.
+  arma::vec eigenvalues;
+  //! Eigenvectors found by the last decomposition.
+  arma::mat eigenvectors;
+}; // class StreamingPCA
+
+} // namespace pca
+} // namespace mlpack
+
+// Include implementation.
+#include "streaming_pca_impl.hpp"
+
+#endif
@@ -0,0 +1,307 @@
+/**
+ * @file methods/pca/streaming_pca_impl.hpp
+ *
+ * Implementation of the StreamingPCA class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_PCA_STREAMING_PCA_IMPL_HPP
+#define MLPACK_METHODS_PCA_STREAMING_PCA_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "streaming_pca.hpp"
+
+namespace mlpack {
+namespace pca {
+
+template<typename MatType>
+StreamingPCA<MatType>::StreamingPCA(const bool scaleData) :
+    scaleData(scaleData),
+    count(0)
+{
+  // Nothing to do.
+}
+
+template<typename MatType>
+void StreamingPCA<MatType>::Update(const MatType& chunk)
+{
+  Accumulate(chunk, true);
+}
+
+template<typename MatType>
+void StreamingPCA<MatType>::Accumulate(const MatType& chunk, const bool full)
+{
+  if (chunk.n_cols == 0)
+    return;
+
+  if (count == 0)
+  {
+    mean.zeros(chunk.n_rows);
+    squares.zeros(chunk.n_rows);
+    if (full)
+      scatter.zeros(chunk.n_rows, chunk.n_rows);
+  }
+  else if (chunk.n_rows != mean.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "StreamingPCA::Update(): chunk has dimensionality " << chunk.n_rows
+        << ", but the previous chunks have dimensionality " << mean.n_elem;
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Merge the statistics of the chunk with the statistics so far.
+  const size_t chunkCount = chunk.n_cols;
+  const size_t total = count + chunkCount;
+  const arma::vec chunkMean = arma::mean(chunk, 1);
+  arma::mat centered(chunk);
+  centered.each_col() -= chunkMean;
+
+  const arma::vec delta = chunkMean - mean;
+  const double weight = (double) count * chunkCount / total;
+  squares += arma::sum(arma::square(centered), 1) +
+      weight * arma::square(delta);
+  if (full)
+    scatter += centered * centered.t() + weight * delta * delta.t();
+
+  mean += delta * ((double) chunkCount / total);
+  count = total;
+}
+
+template<typename MatType>
+void StreamingPCA<MatType>::Reset()
+{
+  count = 0;
+  mean.reset();
+  squares.reset();
+  scatter.reset();
+  scale.reset();
+  eigenvalues.reset();
+  eigenvectors.reset();
+}
+
+template<typename MatType>
+void StreamingPCA<MatType>::ComputeScale()
+{
+  if (scaleData)
+  {
+    scale = arma::sqrt(squares / (count - 1));
+
+    // Dimensions with no variance are left as they are; their centered values
+    // are all zero anyway.
+    scale.replace(0.0, 1.0);
+  }
+  else
+  {
+    scale.ones(mean.n_elem);
+  }
+}
+
+template<typename MatType>
+arma::mat StreamingPCA<MatType>::Standardize(const MatType& chunk) const
+{
+  if (chunk.n_rows != mean.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "StreamingPCA: chunk has dimensionality " << chunk.n_rows << ", but "
+        << "the data has dimensionality " << mean.n_elem;
+    throw std::invalid_argument(oss.str());
+  }
+
+  arma::mat standardized(chunk);
+  standardized.each_col() -= mean;
+  if (scaleData)
+    standardized.each_col() /= scale;
+
+  return standardized;
+}
+
+template<typename MatType>
+void StreamingPCA<MatType>::Decompose(arma::vec& eigVal, arma::mat& eigvec)
+{
+  if (count < 2 || scatter.n_elem == 0)
+  {
+    throw std::invalid_argument("StreamingPCA::Decompose(): at least two "
+        "points must be given to Update() first!");
+  }
+
+  Timer::Start("pca");
+
+  ComputeScale();
+  arma::mat covariance = scatter / (count - 1);
+  if (scaleData)
+    covariance /= scale * scale.t();
+
+  if (!arma::eig_sym(eigVal, eigvec, covariance))
+  {
+    Timer::Stop("pca");
+    throw std::runtime_error("StreamingPCA::Decompose(): eigendecomposition "
+        "of the covariance matrix failed!");
+  }
+
+  // eig_sym() sorts the eigenvalues in increasing order.
+  eigVal = arma::flipud(eigVal);
+  eigvec = arma::fliplr(eigvec);
+
+  eigenvalues = eigVal;
+  eigenvectors = eigvec;
+
+  Timer::Stop("pca");
+}
+
+template<typename MatType>
+template<typename LoaderType>
+void StreamingPCA<MatType>::Apply(LoaderType&& loader,
+                                  arma::vec& eigVal,
+                                  arma::mat& eigvec)
+{
+  Reset();
+
+  size_t chunks = 0;
+  MatType chunk;
+  while (loader(chunk))
+  {
+    Update(chunk);
+    ++chunks;
+  }
+
+  Log::Info << "StreamingPCA::Apply(): used " << count << " points in "
+      << chunks << " chunks." << std::endl;
+
+  Decompose(eigVal, eigvec);
+}
+
+template<typename MatType>
+template<typename LoaderType>
+arma::mat StreamingPCA<MatType>::CovarianceProduct(LoaderType& loader,
+                                                   const arma::mat& q) const
+{
+  arma::mat product(q.n_rows, q.n_cols, arma::fill::zeros);
+  size_t points = 0;
+  MatType chunk;
+  while (loader(chunk))
+  {
+    const arma::mat standardized = Standardize(chunk);
+    product += standardized * (standardized.t() * q);
+    points += chunk.n_cols;
+  }
+
+  if (points != count)
+  {
+    std::ostringstream oss;
+    oss << "StreamingPCA::Apply(): the loader gave " << points << " points in "
+        << "a pass, but " << count << " points in the first pass; every pass "
+        << "must give the same points!";
+    throw std::runtime_error(oss.str());
+  }
+
+  return product / (count - 1);
+}
+
+template<typename MatType>
+template<typename LoaderType>
+void StreamingPCA<MatType>::Apply(LoaderType&& loader,
+                                  const size_t rank,
+                                  arma::vec& eigVal,
+                                  arma::mat& eigvec,
+                                  const size_t powerIterations,
+                                  const size_t oversampling)
+{
+  Reset();
+
+  // The first pass finds the mean (and the scale) of the data.
+  MatType chunk;
+  while (loader(chunk))
+    Accumulate(chunk, false);
+
+  if (count < 2)
+  {
+    throw std::invalid_argument("StreamingPCA::Apply(): the loader must give "
+        "at least two points!");
+  }
+
+  if (rank == 0 || rank > mean.n_elem)
+  {
+    std::ostringstream oss;
+    oss << "StreamingPCA::Apply(): rank (" << rank << ") must be between 1 "
+        << "and the dimensionality of the data (" << mean.n_elem << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  ComputeScale();
+
+  // Find an orthonormal basis of the range of the covariance matrix applied
+  // to a random matrix, and refine it with subspace iterations; each product
+  // with the covariance matrix is one pass over the data.
+  const size_t l = std::min(rank + oversampling, (size_t) mean.n_elem);
+  arma::mat q, r;
+  arma::qr_econ(q, r, arma::mat(mean.n_elem, l, arma::fill::randn));
+  for (size_t i = 0; i <= powerIterations; ++i)
+    arma::qr_econ(q, r, CovarianceProduct(loader, q));
+
+  // Decompose the covariance matrix restricted to the basis.
+  arma::mat small = q.t() * CovarianceProduct(loader, q);
+  small = 0.5 * (small + small.t());
+
+  arma::vec values;
+  arma::mat vectors;
+  if (!arma::eig_sym(values, vectors, small))
+  {
+    throw std::runtime_error("StreamingPCA::Apply(): eigendecomposition "
+        "failed!");
+  }
+
+  // eig_sym() sorts the eigenvalues in increasing order.
+  eigVal = arma::flipud(values.tail(rank));
+  eigvec = q * arma::fliplr(vectors.tail_cols(rank));
+
+  eigenvalues = eigVal;
+  eigenvectors = eigvec;
+}
+
+template<typename MatType>
+void StreamingPCA<MatType>::Transform(const MatType& chunk,
+                                      arma::mat& transformedData,
+                                      const size_t newDimension) const
+{
+  if (eigenvectors.n_cols == 0)
+  {
+    throw std::invalid_argument("StreamingPCA::Transform(): Decompose() or "
+        "Apply() must be called first!");
+  }
+
+  if (newDimension > eigenvectors.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "StreamingPCA::Transform(): newDimension (" << newDimension
+        << ") cannot be greater than the number of components found ("
+        << eigenvectors.n_cols << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const size_t dimension = (newDimension == 0) ? eigenvectors.n_cols :
+      newDimension;
+  transformedData = eigenvectors.head_cols(dimension).t() * Standardize(chunk);
+}
+
+template<typename MatType>
+template<typename Archive>
+void StreamingPCA<MatType>::serialize(Archive& ar,
+                                      const uint32_t /* version */)
+{
+  ar(CEREAL_NVP(scaleData));
+  ar(CEREAL_NVP(count));
+  ar(CEREAL_NVP(mean));
+  ar(CEREAL_NVP(squares));
+  ar(CEREAL_NVP(scatter));
+  ar(CEREAL_NVP(scale));
+  ar(CEREAL_NVP(eigenvalues));
+  ar(CEREAL_NVP(eigenvectors));
+}
+
+} // namespace pca
+} // namespace mlpack
+
+#endif
@@ -60,6 +60,44 @@ class SimpleWeightUpdate
     weights.col(correctClass) += instanceWeight * trainingPoint;
     biases(correctClass) += instanceWeight;
   }
+
+  /**
+   * Update the weightVectors matrix for a block of points at once, as if the
+   * function above was called for each misclassified point of the block.  The
+   * updates of all the points are gathered in a matrix with one column per
+   * point, and applied with a single matrix multiplication.
+   *
+   * @tparam MatType Type of matrix (should be an Armadillo matrix like
+   *      arma::mat or arma::sp_mat or something similar).
+   * @param trainingPoints Block of points.
+   * @param weights Matrix of weights.
+   * @param biases Vector of biases.
+   * @param predictedClasses Classes that the points were classified as.
+   * @param correctClasses True classes of the points.
+   * @param instanceWeights Weights to be given to the points during training.
+   */
+  template<typename MatType>
+  void UpdateWeights(const MatType& trainingPoints,
+                     arma::mat& weights,
+                     arma::vec& biases,
+                     const arma::Row<size_t>& predictedClasses,
+                     const arma::Row<size_t>& correctClasses,
+                     const arma::rowvec& instanceWeights)
+  {
+    arma::mat updates(weights.n_cols, trainingPoints.n_cols,
+        arma::fill::zeros);
+    for (size_t i = 0; i < trainingPoints.n_cols; ++i)
+    {
+      if (predictedClasses[i] != correctClasses[i])
+      {
+        updates(predictedClasses[i], i) -= instanceWeights[i];
+        updates(correctClasses[i], i) += instanceWeights[i];
+      }
+    }
+
+    weights += trainingPoints * updates.t();
+    biases += arma::sum(updates, 1);
+  }
 };
 
 } // namespace perceptron
@@ -95,6 +95,15 @@ class Perceptron
    * This training does not reset the model weights, so you can call Train() on
    * multiple datasets sequentially.
    *
+   * If BatchSize() is greater than one, the points are classified in blocks of
+   * that many points with a single matrix multiplication, and the updates of
+   * all the misclassified points of a block are applied at once, with the
+   * batch version of LearnPolicy::UpdateWeights().  If Average() is true, the
+   * weights and biases at the end of training are the average of their values
+   * after each point (the averaged perceptron), which generalizes better when
+   * the data is not separable.  The average is kept lazily, so it costs one
+   * extra update per update.
+   *
    * @param data Dataset on which training should be performed.
    * @param labels Labels of the dataset.
    * @param numClasses Number of classes in the data.
@@ -120,13 +129,23 @@ class Perceptron
    * Serialize the perceptron.
    */
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */);
+  void serialize(Archive& ar, const uint32_t version);
 
   //! Get the maximum number of iterations.
   size_t MaxIterations() const { return maxIterations; }
   //! Modify the maximum number of iterations.
   size_t& MaxIterations() { return maxIterations; }
 
+  //! Get the number of points whose updates are applied at once.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of points whose updates are applied at once.
+  size_t& BatchSize() { return batchSize; }
+
+  //! Get whether training gives the averaged weights.
+  bool Average() const { return average; }
+  //! Modify whether training gives the averaged weights.
+  bool& Average() { return average; }
+
   //! Get the number of classes this perceptron has been trained for.
   size_t NumClasses() const { return weights.n_cols; }
 
@@ -144,6 +163,12 @@ class Perceptron
   //! The maximum number of iterations during training.
   size_t maxIterations;
 
+  //! The number of points whose updates are applied at once.
+  size_t batchSize;
+
+  //! Whether training gives the averaged weights.
+  bool average;
+
   /**
    * Stores the weights for each of the input class labels.  Each column
    * corresponds to the weights for one class label, and each row corresponds to
@@ -30,7 +30,9 @@ Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Perceptron(
     const size_t numClasses,
     const size_t dimensionality,
     const size_t maxIterations) :
-    maxIterations(maxIterations)
+    maxIterations(maxIterations),
+    batchSize(1),
+    average(false)
 {
   WeightInitializationPolicy wip;
   wip.Initialize(weights, biases, dimensionality, numClasses);
@@ -56,7 +58,9 @@ Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Perceptron(
     const arma::Row<size_t>& labels,
     const size_t numClasses,
     const size_t maxIterations) :
-    maxIterations(maxIterations)
+    maxIterations(maxIterations),
+    batchSize(1),
+    average(false)
 {
   // Start training.
   Train(data, labels, numClasses);
@@ -84,7 +88,9 @@ Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Perceptron(
     const arma::Row<size_t>& labels,
     const size_t numClasses,
     const arma::rowvec& instanceWeights) :
-    maxIterations(other.maxIterations)
+    maxIterations(other.maxIterations),
+    batchSize(other.batchSize),
+    average(other.average)
 {
   Train(data, labels, numClasses, instanceWeights);
 }
@@ -106,16 +112,12 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Classify(
     const MatType& test,
     arma::Row<size_t>& predictedLabels)
 {
-  arma::vec tempLabelMat;
-  arma::uword maxIndex = 0;
-
-  // Could probably be faster if done in batch.
-  for (size_t i = 0; i < test.n_cols; ++i)
-  {
-    tempLabelMat = weights.t() * test.col(i) + biases;
-    tempLabelMat.max(maxIndex);
-    predictedLabels(0, i) = maxIndex;
-  }
+  // Score all the points at once; the class with the largest score (the first
+  // one, in case of ties) is the prediction.
+  arma::mat scores = weights.t() * test;
+  scores.each_col() += biases;
+  predictedLabels = arma::conv_to<arma::Row<size_t>>::from(
+      arma::index_max(scores, 0));
 }
 
 /**
@@ -145,7 +147,13 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Train(
     wip.Initialize(weights, biases, data.n_rows, numClasses);
   }
 
-  size_t j, i = 0;
+  if (batchSize == 0)
+  {
+    throw std::invalid_argument("Perceptron::Train(): batch size must be "
+        "positive!");
+  }
+
+  size_t i = 0;
   bool converged = false;
   size_t tempLabel;
   arma::uword maxIndexRow = 0, maxIndexCol = 0;
@@ -155,6 +163,22 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Train(
 
   const bool hasWeights = (instanceWeights.n_elem > 0);
 
+  // For the averaged perceptron, each update made after s points is also made,
+  // scaled by (s - 1), to these accumulators; then the average of the weights
+  // after each of the T points is weights - accumulatedWeights / T.
+  arma::mat accumulatedWeights;
+  arma::vec accumulatedBiases;
+  if (average)
+  {
+    accumulatedWeights.zeros(weights.n_rows, weights.n_cols);
+    accumulatedBiases.zeros(biases.n_elem);
+  }
+  size_t steps = 0;
+
+  arma::mat scores;
+  arma::Row<size_t> predictions, blockLabels;
+  arma::rowvec blockWeights;
+
   while ((i < maxIterations) && (!converged))
   {
     // This outer loop is for each iteration, and we use the 'converged'
@@ -162,34 +186,81 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Train(
     ++i;
     converged = true;
 
-    // Now this inner loop is for going through the dataset in each iteration.
-    for (j = 0; j < data.n_cols; ++j)
+    // Now this inner loop is for going through the dataset in each iteration,
+    // one block of points at a time.
+    for (size_t begin = 0; begin < data.n_cols; begin += batchSize)
     {
-      // Multiply for each variable and check whether the current weight vector
-      // correctly classifies this.
-      tempLabelMat = weights.t() * data.col(j) + biases;
-
-      tempLabelMat.max(maxIndexRow, maxIndexCol);
+      const size_t end = std::min(begin + batchSize, (size_t) data.n_cols);
+      steps += end - begin;
 
-      // Check whether prediction is correct.
-      if (maxIndexRow != labels(0, j))
+      if (end - begin == 1)
       {
-        // Due to incorrect prediction, convergence set to false.
-        converged = false;
-        tempLabel = labels(0, j);
-
-        // Send maxIndexRow for knowing which weight to update, send j to know
-        // the value of the vector to update it with.  Send tempLabel to know
-        // the correct class.
-        if (hasWeights)
-          LP.UpdateWeights(data.col(j), weights, biases, maxIndexRow, tempLabel,
-              instanceWeights(j));
-        else
+        const size_t j = begin;
+
+        // Multiply for each variable and check whether the current weight
+        // vector correctly classifies this.
+        tempLabelMat = weights.t() * data.col(j) + biases;
+
+        tempLabelMat.max(maxIndexRow, maxIndexCol);
+
+        // Check whether prediction is correct.
+        if (maxIndexRow != labels(0, j))
+        {
+          // Due to incorrect prediction, convergence set to false.
+          converged = false;
+          tempLabel = labels(0, j);
+
+          // Send maxIndexRow for knowing which weight to update, send j to
+          // know the value of the vector to update it with.  Send tempLabel to
+          // know the correct class.
+          const double instanceWeight = hasWeights ? instanceWeights(j) : 1.0;
           LP.UpdateWeights(data.col(j), weights, biases, maxIndexRow,
-              tempLabel);
+              tempLabel, instanceWeight);
+          if (average)
+          {
+            LP.UpdateWeights(data.col(j), accumulatedWeights,
+                accumulatedBiases, maxIndexRow, tempLabel,
+                (steps - 1) * instanceWeight);
+          }
+        }
+
+        continue;
+      }
+
+      // Classify the whole block with one matrix multiplication.
+      scores = weights.t() * data.cols(begin, end - 1);
+      scores.each_col() += biases;
+      predictions = arma::conv_to<arma::Row<size_t>>::from(
+          arma::index_max(scores, 0));
+      blockLabels = labels.subvec(begin, end - 1);
+
+      if (arma::all(predictions == blockLabels))
+        continue;
+
+      // Due to incorrect predictions, convergence set to false.
+      converged = false;
+
+      if (hasWeights)
+        blockWeights = instanceWeights.subvec(begin, end - 1);
+      else
+        blockWeights.ones(end - begin);
+
+      LP.UpdateWeights(data.cols(begin, end - 1), weights, biases,
+          predictions, blockLabels, blockWeights);
+      if (average)
+      {
+        LP.UpdateWeights(data.cols(begin, end - 1), accumulatedWeights,
+            accumulatedBiases, predictions, blockLabels,
+            (steps - 1) * blockWeights);
       }
     }
   }
+
+  if (average && steps > 0)
+  {
+    weights -= accumulatedWeights / steps;
+    biases -= accumulatedBiases / steps;
+  }
 }
 
 //! Serialize the perceptron.
@@ -199,16 +270,36 @@ template<typename LearnPolicy,
 template<typename Archive>
 void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::serialize(
     Archive& ar,
-    const uint32_t /* version */)
+    const uint32_t version)
 {
   // We just need to serialize the maximum number of iterations, the weights,
   // and the biases.
   ar(CEREAL_NVP(maxIterations));
   ar(CEREAL_NVP(weights));
   ar(CEREAL_NVP(biases));
+
+  // Since version 1, the training options are saved too.
+  if (version >= 1)
+  {
+    ar(CEREAL_NVP(batchSize));
+    ar(CEREAL_NVP(average));
+  }
+  else if (cereal::is_loading<Archive>())
+  {
+    batchSize = 1;
+    average = false;
+  }
 }
 
 } // namespace perceptron
 } // namespace mlpack
 
+// Set the version of the serialization of all perceptrons.
+CEREAL_TEMPLATE_CLASS_VERSION((template<
+    typename LearnPolicy,
+    typename WeightInitializationPolicy,
+    typename MatType>),
+    (mlpack::perceptron::Perceptron<LearnPolicy, WeightInitializationPolicy,
+        MatType>), (1));
+
 #endif
@@ -12,6 +12,7 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/util/io.hpp>
 #include <mlpack/core/util/mlpack_main.hpp>
+#include <mlpack/core/math/descriptive_statistics.hpp>
 
 #include <boost/format.hpp>
 #include <boost/lexical_cast.hpp>
@@ -45,7 +46,14 @@ BINDING_LONG_DESC(
     "specific dimension to analyze if there are too many dimensions. The " +
     PRINT_PARAM_STRING("population") + " parameter can be specified when the "
     "dataset should be considered as a population.  Otherwise, the dataset "
-    "will be considered as a sample.");
+    "will be considered as a sample."
+    "\n\n"
+    "The statistics of all dimensions are computed in a single parallel pass "
+    "over the data.  The medians are estimated with quantile sketches, whose "
+    "rank error is about 1.7 / k for a sketch size of k (given by the " +
+    PRINT_PARAM_STRING("sketch_size") + " parameter); if the " +
+    PRINT_PARAM_STRING("exact_median") + " flag is specified, the exact "
+    "medians are computed instead, at the cost of sorting each dimension.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -78,97 +86,10 @@ PARAM_FLAG("population", "If specified, the program will calculate statistics "
 PARAM_FLAG("row_major", "If specified, the program will calculate statistics "
     "across rows, not across columns.  (Remember that in mlpack, a column "
     "represents a point, so this option is generally not necessary.)", "r");
-
-/**
- * Calculates the sum of deviations to the Nth Power.
- *
- * @param input Vector that captures a dimension of a dataset.
- * @param rowMean Mean of the given vector.
- * @param n Degree of power.
- * @return sum of nth power deviations.
- */
-double SumNthPowerDeviations(const arma::rowvec& input,
-                             const double& fMean,
-                             size_t n)
-{
-  return arma::sum(arma::pow(input - fMean, static_cast<double>(n)));
-}
-
-/**
- * Calculates Skewness of the given vector.
- *
- * @param input Vector that captures a dimension of a dataset
- * @param rowStd Standard Deviation of the given vector.
- * @param rowMean Mean of the given vector.
- * @return Skewness of the given vector.
- */
-double Skewness(const arma::rowvec& input,
-                const double& fStd,
-                const double& fMean,
-                const bool population)
-{
-  double skewness = 0;
-  const double S3 = pow(fStd, 3);
-  const double M3 = SumNthPowerDeviations(input, fMean, 3);
-  const double n = input.n_elem;
-  if (population)
-  {
-    // Calculate population skewness
-    skewness = M3 / (n * S3);
-  }
-  else
-  {
-    // Calculate sample skewness.
-    skewness = n * M3 / ((n - 1) * (n - 2) * S3);
-  }
-  return skewness;
-}
-
-/**
- * Calculates excess kurtosis of the given vector.
- *
- * @param input Vector that captures a dimension of a dataset
- * @param rowStd Standard Deviation of the given vector.
- * @param rowMean Mean of the given vector.
- * @return Kurtosis of the given vector.
- */
-double Kurtosis(const arma::rowvec& input,
-                const double& fStd,
-                const double& fMean,
-                const bool population)
-{
-  double kurtosis = 0;
-  const double M4 = SumNthPowerDeviations(input, fMean, 4);
-  const double n = input.n_elem;
-  if (population)
-  {
-    // Calculate population excess kurtosis.
-    const double M2 = SumNthPowerDeviations(input, fMean, 2);
-    kurtosis = n * (M4 / pow(M2, 2)) - 3;
-  }
-  else
-  {
-    // Calculate sample excess kurtosis.
-    const double S4 = pow(fStd, 4);
-    const double norm3 = (3 * (n - 1) * (n - 1)) / ((n - 2) * (n - 3));
-    const double normC = (n * (n + 1)) / ((n - 1) * (n - 2) * (n - 3));
-    const double normM = M4 / S4;
-    kurtosis = normC * normM - norm3;
-  }
-  return kurtosis;
-}
-
-/**
- * Calculates standard error of standard deviation.
- *
- * @param input Vector that captures a dimension of a dataset
- * @param rowStd Standard Deviation of the given vector.
- * @return Standard error of the stanrdard devation of the given vector.
- */
-double StandardError(const size_t size, const double& fStd)
-{
-  return fStd / sqrt(size);
-}
+PARAM_FLAG("exact_median", "If specified, the exact median of each dimension "
+    "is computed, instead of an estimate from a quantile sketch.", "e");
+PARAM_INT_IN("sketch_size", "Size of the quantile sketches used to estimate "
+    "the medians; larger sketches are more accurate.", "k", 200);
 
 static void mlpackMain()
 {
@@ -178,8 +99,17 @@ static void mlpackMain()
   const bool population = IO::HasParam("population");
   const bool rowMajor = IO::HasParam("row_major");
 
+  RequireParamValue<int>("sketch_size", [](int x) { return x >= 2; }, true,
+      "sketch size must be at least 2");
+
   // Load the data.
-  arma::mat& data = IO::GetParam<arma::mat>("input");
+  const arma::mat& data = IO::GetParam<arma::mat>("input");
+  const size_t dimensions = rowMajor ? data.n_cols : data.n_rows;
+  if (IO::HasParam("dimension") && dimension >= dimensions)
+  {
+    Log::Fatal << "Invalid dimension " << dimension << "; the data has only "
+        << dimensions << " dimensions!" << endl;
+  }
 
   // Generate boost format recipe.
   const string widthPrecision("%-" + to_string(width) + "." +
@@ -196,55 +126,69 @@ static void mlpackMain()
   }
 
   Timer::Start("statistics");
-  // Print the headers.
-  Log::Info << boost::format(stringFormat)
-      % "dim" % "var" % "mean" % "std" % "median" % "min" % "max"
-      % "range" % "skew" % "kurt" % "SE" << endl;
-
-  // Lambda function to print out the results.
-  auto PrintStatResults = [&](size_t dim, bool rowMajor)
-  {
-    arma::rowvec feature;
-    if (rowMajor)
-      feature = arma::conv_to<arma::rowvec>::from(data.col(dim));
-    else
-      feature = data.row(dim);
-
-    // f at the front of the variable names means "feature".
-    const double fMax = arma::max(feature);
-    const double fMin = arma::min(feature);
-    const double fMean = arma::mean(feature);
-    const double fStd = arma::stddev(feature, population);
-
-    // Print statistics of the given dimension.
-    Log::Info << boost::format(numberFormat)
-        % dim
-        % arma::var(feature, population)
-        % fMean
-        % fStd
-        % arma::median(feature)
-        % fMin
-        % fMax
-        % (fMax - fMin) // range
-        % Skewness(feature, fStd, fMean, population)
-        % Kurtosis(feature, fStd, fMean, population)
-        % StandardError(feature.n_elem, fStd)
-        << endl;
-  };
 
   // If the user specified dimension, describe statistics of the given
   // dimension. If a dimension is not specified, describe all dimensions.
+  // Either way the data is only read once.
+  math::DescriptiveStatistics stats(
+      (size_t) IO::GetParam<int>("sketch_size"));
+  arma::uvec dims;
   if (IO::HasParam("dimension"))
   {
-    PrintStatResults(dimension, rowMajor);
+    dims = { (arma::uword) dimension };
+    if (rowMajor)
+      stats.Update(data.col(dimension), true);
+    else
+      stats.Update(data.row(dimension));
   }
   else
   {
-    const size_t dimensions = rowMajor ? data.n_cols : data.n_rows;
-    for (size_t i = 0; i < dimensions; ++i)
+    dims = arma::linspace<arma::uvec>(0, dimensions - 1, dimensions);
+    stats.Update(data, rowMajor);
+  }
+
+  arma::vec medians;
+  if (IO::HasParam("exact_median"))
+  {
+    medians.set_size(dims.n_elem);
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) dims.n_elem; ++i)
     {
-      PrintStatResults(i, rowMajor);
+      medians[i] = rowMajor ? arma::median(data.col(dims[i])) :
+          arma::median(data.row(dims[i]));
     }
   }
+  else
+  {
+    medians = stats.Quantile(0.5);
+  }
+
+  const arma::vec variances = stats.Variance(population);
+  const arma::vec stds = stats.StandardDeviation(population);
+  const arma::vec skewness = stats.Skewness(population);
+  const arma::vec kurtosis = stats.Kurtosis(population);
+
+  // Print the headers.
+  Log::Info << boost::format(stringFormat)
+      % "dim" % "var" % "mean" % "std" % "median" % "min" % "max"
+      % "range" % "skew" % "kurt" % "SE" << endl;
+
+  // Print the statistics of each dimension.
+  for (size_t i = 0; i < dims.n_elem; ++i)
+  {
+    Log::Info << boost::format(numberFormat)
+        % dims[i]
+        % variances[i]
+        % stats.Mean()[i]
+        % stds[i]
+        % medians[i]
+        % stats.Min()[i]
+        % stats.Max()[i]
+        % (stats.Max()[i] - stats.Min()[i]) // range
+        % skewness[i]
+        % kurtosis[i]
+        % (stds[i] / sqrt((double) stats.Count())) // standard error
+        << endl;
+  }
   Timer::Stop("statistics");
 }
@@ -65,7 +65,7 @@ static void mlpackMain()
   const arma::mat& data = IO::GetParam<arma::mat>("input");
   vector<int>& indices = IO::GetParam<vector<int> >("dimensions");
   vector<size_t> copyIndices(indices.size());
-  RequireParamValue<std::vector<int>>("dimensions", [data](std::vector<int> x)
+  RequireParamValue<std::vector<int>>("dimensions", [&data](std::vector<int> x)
       {
         for (int dim : x)
         {
@@ -81,8 +81,11 @@ static void mlpackMain()
   {
     copyIndices[i] = (size_t)indices[i];
   }
-  arma::mat output;
-  data::OneHotEncoding(data, (arma::Col<size_t>)(copyIndices), output);
+  // Encode directly into the output parameter, so that the encoded matrix is
+  // not copied.
   if (IO::HasParam("output"))
-    IO::GetParam<arma::mat>("output") = std::move(output);
+  {
+    data::OneHotEncoding(data, (arma::Col<size_t>)(copyIndices),
+        IO::GetParam<arma::mat>("output"));
+  }
 }
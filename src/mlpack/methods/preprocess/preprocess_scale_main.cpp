@@ -52,7 +52,14 @@ BINDING_LONG_DESC(
     "\n\n"
     "The model to scale features can be saved using " +
     PRINT_PARAM_STRING("output_model") + " and later can be loaded back using"
-    + PRINT_PARAM_STRING("input_model") + ".");
+    + PRINT_PARAM_STRING("input_model") + "."
+    "\n\n"
+    "A dataset too large to load at once can be scaled in chunks: if " +
+    PRINT_PARAM_STRING("partial_fit") + " is specified, the model given with " +
+    PRINT_PARAM_STRING("input_model") + " is updated with the points of " +
+    PRINT_PARAM_STRING("input") + " before they are scaled, as if all the "
+    "chunks had been given at once.  This is supported by all the scalers "
+    "except 'pca_whitening' and 'zca_whitening'.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -106,6 +113,8 @@ PARAM_INT_IN("min_value", "Starting value of range for min_max_scaler.",
 PARAM_INT_IN("max_value", "Ending value of range for min_max_scaler.",
     "e", 1);
 PARAM_FLAG("inverse_scaling", "Inverse Scaling to get original dataset", "f");
+PARAM_FLAG("partial_fit", "Update the input model with the input points "
+    "before scaling them.", "P");
 // Loading/saving of a model.
 PARAM_MODEL_IN(ScalingModel, "input_model", "Input Scaling model.", "m");
 PARAM_MODEL_OUT(ScalingModel, "output_model", "Output scaling model.", "M");
@@ -128,14 +137,20 @@ static void mlpackMain()
     "standard_scaler", "max_abs_scaler", "mean_normalization", "pca_whitening",
     "zca_whitening" }, true, "unknown scaler type");
 
+  ReportIgnoredParam({{ "input_model", false }}, "partial_fit");
+  ReportIgnoredParam({{ "inverse_scaling", true }}, "partial_fit");
+
   // Load the data.
   arma::mat& input = IO::GetParam<arma::mat>("input");
-  arma::mat output;
   ScalingModel* m;
   Timer::Start("feature_scaling");
   if (IO::HasParam("input_model"))
   {
     m = IO::GetParam<ScalingModel*>("input_model");
+
+    // Continue fitting the model with this chunk of the data.
+    if (IO::HasParam("partial_fit") && !IO::HasParam("inverse_scaling"))
+      m->PartialFit(input);
   }
   else
   {
@@ -180,9 +195,11 @@ static void mlpackMain()
     }
   }
 
+  // Scale the data in place, so that no second copy of it is needed.
+  arma::mat output = std::move(input);
   if (!IO::HasParam("inverse_scaling"))
   {
-    m->Transform(input, output);
+    m->Transform(output, output);
   }
   else
   {
@@ -191,7 +208,7 @@ static void mlpackMain()
       delete m;
       throw std::runtime_error("Please provide a saved model.");
     }
-    m->InverseTransform(input, output);
+    m->InverseTransform(output, output);
   }
 
   // Save the output.
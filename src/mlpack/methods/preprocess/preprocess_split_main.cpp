@@ -144,6 +144,12 @@ static void mlpackMain()
   // Load the data.
   arma::mat& data = IO::GetParam<arma::mat>("input");
 
+  // Only compute which points go to each set; each output is then gathered
+  // directly from the input, and only if it was requested, so no intermediate
+  // copies of the dataset are made.
+  arma::uvec trainIndices;
+  arma::uvec testIndices;
+
   // If parameters for labels exist, we must split the labels too.
   if (IO::HasParam("input_labels"))
   {
@@ -152,40 +158,40 @@ static void mlpackMain()
     arma::Row<size_t> labelsRow = labels.row(0);
 
     Timer::Start("splitting_data");
-    const auto value =
-        data::Split(data, labelsRow, testRatio, !shuffleData, stratifyData);
+    if (stratifyData)
+    {
+      data::StratifiedSplitIndices(labelsRow, trainIndices, testIndices,
+          testRatio, !shuffleData);
+    }
+    else
+    {
+      data::SplitIndices(data.n_cols, trainIndices, testIndices, testRatio,
+          !shuffleData);
+    }
     Timer::Stop("splitting_data");
 
-    Log::Info << "Training data contains "
-        << get<0>(value).n_cols << " points." << endl;
-    Log::Info << "Test data contains "
-        << get<1>(value).n_cols << " points." << endl;
-
-    if (IO::HasParam("training"))
-      IO::GetParam<arma::mat>("training") = std::move(get<0>(value));
-    if (IO::HasParam("test"))
-      IO::GetParam<arma::mat>("test") = std::move(get<1>(value));
     if (IO::HasParam("training_labels"))
       IO::GetParam<arma::Mat<size_t>>("training_labels") =
-          std::move(get<2>(value));
+          labelsRow.cols(trainIndices);
     if (IO::HasParam("test_labels"))
       IO::GetParam<arma::Mat<size_t>>("test_labels") =
-          std::move(get<3>(value));
+          labelsRow.cols(testIndices);
   }
   else // We have no labels, so just split the dataset.
   {
     Timer::Start("splitting_data");
-    const auto value = data::Split(data, testRatio, !shuffleData);
+    data::SplitIndices(data.n_cols, trainIndices, testIndices, testRatio,
+        !shuffleData);
     Timer::Stop("splitting_data");
+  }
 
-    Log::Info << "Training data contains " << get<0>(value).n_cols << " points."
-        << endl;
-    Log::Info << "Test data contains " << get<1>(value).n_cols << " points."
-        << endl;
+  Log::Info << "Training data contains " << trainIndices.n_elem << " points."
+      << endl;
+  Log::Info << "Test data contains " << testIndices.n_elem << " points."
+      << endl;
 
-    if (IO::HasParam("training"))
-      IO::GetParam<arma::mat>("training") = std::move(get<0>(value));
-    if (IO::HasParam("test"))
-      IO::GetParam<arma::mat>("test") = std::move(get<1>(value));
-  }
+  if (IO::HasParam("training"))
+    IO::GetParam<arma::mat>("training") = data.cols(trainIndices);
+  if (IO::HasParam("test"))
+    IO::GetParam<arma::mat>("test") = data.cols(testIndices);
 }
@@ -84,6 +84,14 @@ class ScalingModel
   template<typename MatType>
   void Fit(const MatType& input);
 
+  /**
+   * Update the scaling parameters with the points of the given chunk, as if
+   * all the chunks given since the last call to Fit() had been given to Fit()
+   * at once.  PCA and ZCA whitening cannot be fit in chunks.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input);
+
   // Scale back the dataset to their original values.
   template<typename MatType>
   void InverseTransform(const MatType& input, MatType& output);
@@ -204,6 +204,40 @@ void ScalingModel::Fit(const MatType& input)
   }
 }
 
+template<typename MatType>
+void ScalingModel::PartialFit(const MatType& input)
+{
+  if (scalerType == ScalerTypes::STANDARD_SCALER)
+  {
+    if (!standardscale)
+      standardscale = new data::StandardScaler();
+    standardscale->PartialFit(input);
+  }
+  else if (scalerType == ScalerTypes::MIN_MAX_SCALER)
+  {
+    if (!minmaxscale)
+      minmaxscale = new data::MinMaxScaler(minValue, maxValue);
+    minmaxscale->PartialFit(input);
+  }
+  else if (scalerType == ScalerTypes::MEAN_NORMALIZATION)
+  {
+    if (!meanscale)
+      meanscale = new data::MeanNormalization();
+    meanscale->PartialFit(input);
+  }
+  else if (scalerType == ScalerTypes::MAX_ABS_SCALER)
+  {
+    if (!maxabsscale)
+      maxabsscale = new data::MaxAbsScaler();
+    maxabsscale->PartialFit(input);
+  }
+  else
+  {
+    throw std::invalid_argument("ScalingModel::PartialFit(): PCA and ZCA "
+        "whitening cannot be fit in chunks; use Fit()");
+  }
+}
+
 template<typename MatType>
 void ScalingModel::Transform(const MatType& input, MatType& output)
 {
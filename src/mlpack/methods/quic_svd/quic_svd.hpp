@@ -66,13 +66,17 @@ class QUIC_SVD
    * @param sigma Diagonal matrix of singular values.
    * @param epsilon Error tolerance fraction for calculated subspace.
    * @param delta Cumulative probability for Monte Carlo error lower bound.
+   * @param expansionsPerRound Maximum number of cosine tree nodes to split in
+   *     each round of the tree construction (in parallel, when OpenMP is
+   *     available).
    */
   QUIC_SVD(const arma::mat& dataset,
            arma::mat& u,
            arma::mat& v,
            arma::mat& sigma,
            const double epsilon = 0.03,
-           const double delta = 0.1);
+           const double delta = 0.1,
+           const size_t expansionsPerRound = 1);
 
   /**
    * This function uses the vector subspace created using a cosine tree to
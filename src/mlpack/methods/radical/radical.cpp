@@ -13,6 +13,9 @@
 #include "radical.hpp"
 #include <mlpack/core/util/log.hpp>
 #include <mlpack/core/util/timers.hpp>
+#include <mlpack/core/math/random.hpp>
+
+#include <numeric>
 
 using namespace std;
 using namespace arma;
@@ -37,15 +40,18 @@ Radical::Radical(const double noiseStdDev,
 void Radical::CopyAndPerturb(mat& xNew, const mat& x) const
 {
   Timer::Start("radical_copy_and_perturb");
-  xNew = repmat(x, replicates, 1) + noiseStdDev * randn(replicates * x.n_rows,
-      x.n_cols);
+  xNew.set_size(replicates * x.n_rows, x.n_cols);
+  xNew.imbue([&]() { return noiseStdDev * math::RandNormal(); });
+  for (size_t r = 0; r < replicates; ++r)
+    xNew.rows(r * x.n_rows, (r + 1) * x.n_rows - 1) += x;
   Timer::Stop("radical_copy_and_perturb");
 }
 
 
 double Radical::Vasicek(vec& z) const
 {
-  z = sort(z);
+  // Sort in place, so that the caller's buffer is reused.
+  std::sort(z.begin(), z.end());
 
   // Apparently slower.
   /*
@@ -70,26 +76,34 @@ double Radical::DoRadical2D(const mat& matX)
 {
   CopyAndPerturb(perturbed, matX);
 
-  mat::fixed<2, 2> matJacobi;
+  return OptimalAngle(perturbed);
+}
+
 
+double Radical::OptimalAngle(const mat& perturbed) const
+{
   vec values(angles);
 
-  for (size_t i = 0; i < angles; ++i)
+  #pragma omp parallel
   {
-    const double theta = (i / (double) angles) * M_PI / 2.0;
-    const double cosTheta = cos(theta);
-    const double sinTheta = sin(theta);
+    // The buffers of the rotated coordinates are reused for every angle
+    // evaluated by this thread.
+    vec candidateY1(perturbed.n_rows);
+    vec candidateY2(perturbed.n_rows);
 
-    matJacobi(0, 0) = cosTheta;
-    matJacobi(1, 0) = -sinTheta;
-    matJacobi(0, 1) = sinTheta;
-    matJacobi(1, 1) = cosTheta;
+    #pragma omp for
+    for (omp_size_t i = 0; i < (omp_size_t) angles; ++i)
+    {
+      const double theta = (i / (double) angles) * M_PI / 2.0;
+      const double cosTheta = cos(theta);
+      const double sinTheta = sin(theta);
 
-    candidate = perturbed * matJacobi;
-    vec candidateY1 = candidate.unsafe_col(0);
-    vec candidateY2 = candidate.unsafe_col(1);
+      // Rotate the data by the Jacobi rotation of angle theta.
+      candidateY1 = cosTheta * perturbed.col(0) - sinTheta * perturbed.col(1);
+      candidateY2 = sinTheta * perturbed.col(0) + cosTheta * perturbed.col(1);
 
-    values(i) = Vasicek(candidateY1) + Vasicek(candidateY2);
+      values(i) = Vasicek(candidateY1) + Vasicek(candidateY2);
+    }
   }
 
   uword indOpt = 0;
@@ -132,42 +146,73 @@ void Radical::DoRadical(const mat& matXT, mat& matY, mat& matW)
   Timer::Start("radical_do_radical");
   matW = matWhitening;
 
-  mat matYSubspace(nPoints, 2);
-
-  mat matJ = eye(nDims, nDims);
+  // Each sweep visits every pair of dimensions once, in rounds of disjoint
+  // pairs given by a round-robin tournament: dimension 0 stays in place, and
+  // the others rotate by one position each round.  With an odd number of
+  // dimensions, a dummy dimension (nDims) pairs with the one resting.
+  const size_t nSlots = nDims + (nDims % 2);
+  std::vector<size_t> slots(nSlots);
+  std::iota(slots.begin(), slots.end(), 0);
 
+  std::vector<std::pair<size_t, size_t>> pairs;
+  std::vector<double> thetas;
   for (size_t sweepNum = 0; sweepNum < sweeps; sweepNum++)
   {
     Log::Info << "RADICAL: sweep " << sweepNum << "." << std::endl;
 
-    for (size_t i = 0; i < nDims - 1; ++i)
+    for (size_t round = 0; round + 1 < nSlots; ++round)
     {
-      for (size_t j = i + 1; j < nDims; ++j)
+      pairs.clear();
+      for (size_t k = 0; k < nSlots / 2; ++k)
       {
-        Log::Debug << "RADICAL 2D on dimensions " << i << " and " << j << "."
-            << std::endl;
-
-        matYSubspace.col(0) = matY.col(i);
-        matYSubspace.col(1) = matY.col(j);
-
-        const double thetaOpt = DoRadical2D(matYSubspace);
-
-        const double cosThetaOpt = cos(thetaOpt);
-        const double sinThetaOpt = sin(thetaOpt);
+        const size_t i = std::min(slots[k], slots[nSlots - 1 - k]);
+        const size_t j = std::max(slots[k], slots[nSlots - 1 - k]);
+        if (j < nDims)
+        {
+          Log::Debug << "RADICAL 2D on dimensions " << i << " and " << j
+              << "." << std::endl;
+          pairs.push_back(std::make_pair(i, j));
+        }
+      }
+      std::rotate(slots.begin() + 1, slots.end() - 1, slots.end());
+
+      // The pairs of a round share no dimension, so their angles can be found
+      // in parallel; each pair perturbs its data with its own random stream.
+      // When there is a single pair, its angles are evaluated in parallel
+      // instead.
+      thetas.resize(pairs.size());
+      const size_t seed = math::RandomStreamSeed();
+      #pragma omp parallel for if (pairs.size() > 1)
+      for (omp_size_t p = 0; p < (omp_size_t) pairs.size(); ++p)
+      {
+        math::RandomStream stream(seed, p);
 
-        // Set elements of transformation matrix.
-        matJ(i, i) = cosThetaOpt;
-        matJ(j, i) = -sinThetaOpt;
-        matJ(i, j) = sinThetaOpt;
-        matJ(j, j) = cosThetaOpt;
+        mat matYSubspace(nPoints, 2);
+        matYSubspace.col(0) = matY.col(pairs[p].first);
+        matYSubspace.col(1) = matY.col(pairs[p].second);
 
-        matY *= matJ;
+        mat pairPerturbed;
+        CopyAndPerturb(pairPerturbed, matYSubspace);
+        thetas[p] = OptimalAngle(pairPerturbed);
+      }
 
-        // Unset elements of transformation matrix, so matJ = eye() again.
-        matJ(i, i) = 1;
-        matJ(j, i) = 0;
-        matJ(i, j) = 0;
-        matJ(j, j) = 1;
+      // Apply the Jacobi rotations to the two columns of each pair, in the
+      // data and in the unmixing matrix.
+      #pragma omp parallel for
+      for (omp_size_t p = 0; p < (omp_size_t) pairs.size(); ++p)
+      {
+        const size_t i = pairs[p].first;
+        const size_t j = pairs[p].second;
+        const double cosThetaOpt = cos(thetas[p]);
+        const double sinThetaOpt = sin(thetas[p]);
+
+        const vec yi = matY.col(i);
+        matY.col(i) = cosThetaOpt * yi - sinThetaOpt * matY.col(j);
+        matY.col(j) = sinThetaOpt * yi + cosThetaOpt * matY.col(j);
+
+        const vec wi = matW.col(i);
+        matW.col(i) = cosThetaOpt * wi - sinThetaOpt * matW.col(j);
+        matW.col(j) = sinThetaOpt * wi + cosThetaOpt * matW.col(j);
       }
     }
   }
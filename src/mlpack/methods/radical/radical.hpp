@@ -91,6 +91,17 @@ class Radical
   //! Two-dimensional version of RADICAL.
   double DoRadical2D(const arma::mat& matX);
 
+  /**
+   * Find the rotation of the given perturbed two-dimensional data (one point
+   * per row) that minimizes the sum of the entropies of its two coordinates,
+   * among the 'angles' angles in [0, pi / 2).  The angles are evaluated in
+   * parallel when OpenMP is available.
+   *
+   * @param perturbed Perturbed two-dimensional data, from CopyAndPerturb().
+   * @return The optimal angle.
+   */
+  double OptimalAngle(const arma::mat& perturbed) const;
+
   //! Get the standard deviation of the additive Gaussian noise.
   double NoiseStdDev() const { return noiseStdDev; }
   //! Modify the standard deviation of the additive Gaussian noise.
@@ -123,7 +134,8 @@ class Radical
   size_t angles;
 
   //! Number of sweeps; each sweep calls Radical2D once for each pair of
-  //! dimensions.
+  //! dimensions.  The pairs are visited in rounds of disjoint pairs, which
+  //! are processed in parallel.
   size_t sweeps;
 
   //! Value of m to use for Vasicek's m-spacing estimator of entropy.
@@ -131,8 +143,6 @@ class Radical
 
   //! Internal matrix, held as member variable to prevent memory reallocations.
   arma::mat perturbed;
-  //! Internal matrix, held as member variable to prevent memory reallocations.
-  arma::mat candidate;
 };
 
 void WhitenFeatureMajorMatrix(const arma::mat& matX,
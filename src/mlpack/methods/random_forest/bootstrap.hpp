@@ -16,6 +16,124 @@
 namespace mlpack {
 namespace tree {
 
+/**
+ * A bootstrapped view of a dataset: the columns of the view are the columns of
+ * the original dataset given by a vector of indices, so a bootstrap sample
+ * doesn't need a copy of the data.  The view provides the (small) part of the
+ * Armadillo matrix interface that DecisionTree needs during training;
+ * swapping two columns only swaps their indices, and the original dataset is
+ * never modified.  The original dataset must outlive the view.
+ */
+template<typename MatType>
+class BootstrapView
+{
+ public:
+  //! The element type of the dataset.
+  typedef typename MatType::elem_type elem_type;
+
+  /**
+   * A range of columns of a BootstrapView, from which single rows can be
+   * extracted.
+   */
+  class ColumnRange
+  {
+   public:
+    //! Create the range [first, last] of columns of the given view.
+    ColumnRange(const BootstrapView& view,
+                const size_t first,
+                const size_t last) :
+        view(view), first(first), last(last) { }
+
+    //! Return a copy of the given row of the columns in the range.
+    arma::Row<elem_type> row(const size_t r) const
+    {
+      arma::Row<elem_type> values(last - first + 1);
+      for (size_t i = first; i <= last; ++i)
+        values[i - first] = view(r, i);
+      return values;
+    }
+
+   private:
+    const BootstrapView& view;
+    const size_t first;
+    const size_t last;
+  };
+
+  /**
+   * Create a view of the given dataset holding the columns with the given
+   * indices.
+   *
+   * @param dataset Dataset to view.
+   * @param indices Indices of the columns of the view.
+   */
+  BootstrapView(const MatType& dataset, arma::uvec indices) :
+      dataset(&dataset),
+      indices(std::move(indices)),
+      n_rows(dataset.n_rows),
+      n_cols(this->indices.n_elem)
+  { }
+
+  //! Get the element at the given row and column of the view.
+  elem_type operator()(const size_t row, const size_t col) const
+  {
+    return (*dataset)(row, indices[col]);
+  }
+
+  //! Get the columns [first, last] of the view.
+  ColumnRange cols(const size_t first, const size_t last) const
+  {
+    return ColumnRange(*this, first, last);
+  }
+
+  //! Swap two columns of the view (without modifying the dataset).
+  void swap_cols(const size_t first, const size_t second)
+  {
+    std::swap(indices[first], indices[second]);
+  }
+
+  //! Get the indices of the columns of the view in the dataset.
+  const arma::uvec& Indices() const { return indices; }
+
+ private:
+  //! The viewed dataset.
+  const MatType* dataset;
+  //! The indices of the columns of the view.
+  arma::uvec indices;
+
+ public:
+  //! The number of rows of the view.
+  size_t n_rows;
+  //! The number of columns of the view.
+  size_t n_cols;
+};
+
+/**
+ * Draw the indices of a bootstrap sample of the given dataset, and create the
+ * labels and weights of the sampled points.  The sampled points themselves can
+ * then be accessed through a BootstrapView without copying the dataset.
+ */
+template<bool UseWeights,
+         typename MatType,
+         typename LabelsType,
+         typename WeightsType>
+void BootstrapIndices(const MatType& dataset,
+                      const LabelsType& labels,
+                      const WeightsType& weights,
+                      arma::uvec& indices,
+                      LabelsType& bootstrapLabels,
+                      WeightsType& bootstrapWeights)
+{
+  // Random sampling with replacement.  The indices are drawn with
+  // math::RandInt() so that they come from the current math::RandomStream of
+  // the thread, if there is one.
+  indices.set_size(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    indices[i] = math::RandInt(dataset.n_cols);
+  bootstrapLabels = labels.cols(indices);
+  if (UseWeights)
+    bootstrapWeights = weights.cols(indices);
+}
+
 /**
  * Given a dataset, create another dataset via bootstrap sampling, with labels.
  */
@@ -13,7 +13,12 @@
 #define MLPACK_METHODS_RANDOM_FOREST_RANDOM_FOREST_HPP
 
 #include <mlpack/methods/decision_tree/decision_tree.hpp>
+#include <mlpack/methods/decision_tree/compiled_tree_ensemble.hpp>
 #include <mlpack/methods/decision_tree/multiple_random_dimension_select.hpp>
+#include <mlpack/core/distributed/local_communicator.hpp>
+#include <mlpack/core/distributed/mpi_communicator.hpp>
+#include <mlpack/core/distributed/ring_all_gather.hpp>
+#include <mlpack/core/distributed/ring_all_reduce.hpp>
 #include "bootstrap.hpp"
 
 namespace mlpack {
@@ -35,11 +40,16 @@ namespace tree {
  *   publisher={Springer}
  * }
  * @endcode
+ *
+ * Each tree is trained on a bootstrap sample of the points, unless
+ * UseBootstrap is false; then each tree is trained on all the points, and the
+ * trees only differ by their random splits (as in ExtraTrees).
  */
 template<typename FitnessFunction = GiniGain,
          typename DimensionSelectionType = MultipleRandomDimensionSelect,
          template<typename> class NumericSplitType = BestBinaryNumericSplit,
-         template<typename> class CategoricalSplitType = AllCategoricalSplit>
+         template<typename> class CategoricalSplitType = AllCategoricalSplit,
+         bool UseBootstrap = true>
 class RandomForest
 {
  public:
@@ -304,14 +314,63 @@ class RandomForest
                DimensionSelectionType dimensionSelector =
                    DimensionSelectionType());
 
+  /**
+   * Train the random forest on the given labeled training data with several
+   * processes, which share the work of training the trees.  Every process
+   * holds the whole dataset and trains a contiguous range of the numTrees
+   * trees; the trees are then exchanged, so that every process ends up with
+   * the same forest, which is the forest that a single process would train
+   * with the random seed of the first process.  Every process must call this
+   * method at the same time, with the same data and parameters (and the same
+   * forest, with warmStart).
+   *
+   * @code
+   * distributed::MPICommunicator communicator;
+   * RandomForest<> rf;
+   * rf.Train(communicator, data, labels, numClasses, 5000);
+   * @endcode
+   *
+   * @param communicator Communicator between the processes (see
+   *     distributed::LocalCommunicator).
+   * @param data Dataset to train on.
+   * @param labels Labels for dataset.
+   * @param numClasses Number of classes in dataset.
+   * @param numTrees Number of trees in the forest.
+   * @param minimumLeafSize Minimum number of points in each tree's leaf nodes.
+   * @param minimumGainSplit Minimum gain for splitting a decision tree node.
+   * @param maximumDepth Maximum depth for the tree.
+   * @param warmStart When set to `true`, it adds `numTrees` new trees to the
+   *     existing random forest otherwise a new forest is trained from scratch.
+   * @param dimensionSelector Instantiated dimension selection policy.
+   * @return The average entropy of all the decision trees trained under forest.
+   */
+  template<typename CommunicatorType, typename MatType>
+  double Train(CommunicatorType& communicator,
+               const MatType& data,
+               const arma::Row<size_t>& labels,
+               const size_t numClasses,
+               const size_t numTrees = 20,
+               const size_t minimumLeafSize = 1,
+               const double minimumGainSplit = 1e-7,
+               const size_t maximumDepth = 0,
+               const bool warmStart = false,
+               DimensionSelectionType dimensionSelector =
+                   DimensionSelectionType());
+
   /**
    * Predict the class of the given point.  If the random forest has not been
    * trained, this will throw an exception.
    *
+   * Only the first numTrees trees may be used, for instance to meet a latency
+   * budget; with a cereal::EnsembleLoadLimit, only these trees need to be
+   * loaded.
+   *
    * @param point Point to be classified.
+   * @param numTrees Number of trees to use (the first ones); 0 (the default)
+   *     or more than NumTrees() means all trees.
    */
   template<typename VecType>
-  size_t Classify(const VecType& point) const;
+  size_t Classify(const VecType& point, const size_t numTrees = 0) const;
 
   /**
    * Predict the class of the given point and return the predicted class
@@ -321,11 +380,14 @@ class RandomForest
    * @param point Point to be classified.
    * @param prediction size_t to store predicted class in.
    * @param probabilities Output vector of class probabilities.
+   * @param numTrees Number of trees to use (the first ones); 0 (the default)
+   *     or more than NumTrees() means all trees.
    */
   template<typename VecType>
   void Classify(const VecType& point,
                 size_t& prediction,
-                arma::vec& probabilities) const;
+                arma::vec& probabilities,
+                const size_t numTrees = 0) const;
 
   /**
    * Predict the classes of each point in the given dataset.  If the random
@@ -333,10 +395,13 @@ class RandomForest
    *
    * @param data Dataset to be classified.
    * @param predictions Output predictions for each point in the dataset.
+   * @param numTrees Number of trees to use (the first ones); 0 (the default)
+   *     or more than NumTrees() means all trees.
    */
   template<typename MatType>
   void Classify(const MatType& data,
-                arma::Row<size_t>& predictions) const;
+                arma::Row<size_t>& predictions,
+                const size_t numTrees = 0) const;
 
   /**
    * Predict the classes of each point in the given dataset, also returning the
@@ -346,11 +411,21 @@ class RandomForest
    * @param data Dataset to be classified.
    * @param predictions Output predictions for each point in the dataset.
    * @param probabilities Output matrix of class probabilities for each point.
+   * @param numTrees Number of trees to use (the first ones); 0 (the default)
+   *     or more than NumTrees() means all trees.
    */
   template<typename MatType>
   void Classify(const MatType& data,
                 arma::Row<size_t>& predictions,
-                arma::mat& probabilities) const;
+                arma::mat& probabilities,
+                const size_t numTrees = 0) const;
+
+  /**
+   * Compile the trees of the forest into a CompiledTreeEnsemble, which gives
+   * the same predictions as Classify() but scores batches of points faster.
+   * If the random forest has not been trained, this will throw an exception.
+   */
+  CompiledTreeEnsemble Compile() const;
 
   //! Access a tree in the forest.
   const DecisionTreeType& Tree(const size_t i) const { return trees[i]; }
@@ -361,17 +436,21 @@ class RandomForest
   size_t NumTrees() const { return trees.size(); }
 
   /**
-   * Serialize the random forest.
+   * Serialize the random forest.  While a cereal::EnsembleLoadLimit exists,
+   * only the first trees are loaded.
    */
   template<typename Archive>
-  void serialize(Archive& ar, const uint32_t /* version */);
+  void serialize(Archive& ar, const uint32_t version);
 
  private:
   /**
    * Perform the training of the decision tree.  The template bool parameters
    * control whether or not the datasetInfo or weights arguments should be
-   * ignored.
+   * ignored.  The new trees are split between the processes of the
+   * communicator, which is a distributed::LocalCommunicator unless the forest
+   * is trained with several processes.
    *
+   * @param communicator Communicator between the processes.
    * @param data Dataset to train on.
    * @param datasetInfo Dimension information for the dataset (may be ignored).
    * @param labels Labels for the dataset.
@@ -387,10 +466,15 @@ class RandomForest
    * @tparam UseWeights Whether or not to use the weights parameter.
    * @tparam UseDatasetInfo Whether or not to use the datasetInfo parameter.
    * @tparam MatType The type of data matrix (i.e. arma::mat).
+   * @tparam CommunicatorType The type of the communicator.
    * @return The average entropy of all the decision trees trained under forest.
    */
-  template<bool UseWeights, bool UseDatasetInfo, typename MatType>
-  double Train(const MatType& data,
+  template<bool UseWeights,
+           bool UseDatasetInfo,
+           typename MatType,
+           typename CommunicatorType>
+  double Train(CommunicatorType&& communicator,
+               const MatType& data,
                const data::DatasetInfo& datasetInfo,
                const arma::Row<size_t>& labels,
                const size_t numClasses,
@@ -400,7 +484,7 @@ class RandomForest
                const double minimumGainSplit,
                const size_t maximumDepth,
                DimensionSelectionType& dimensionSelector,
-               const bool warmStart = false);
+               const bool warmStart);
 
   //! The trees in the forest.
   std::vector<DecisionTreeType> trees;
@@ -409,6 +493,23 @@ class RandomForest
   double avgGain;
 };
 
+/**
+ * Convenience typedef for extremely randomized trees: each node is split on
+ * the best of one random split value of each of the randomly selected
+ * dimensions (see RandomBinaryNumericSplit), which trains much faster than
+ * searching for the best split value.  As in the extremely randomized trees of
+ * Geurts et al., each tree is trained on all the points, without bootstrap
+ * sampling.
+ */
+template<typename FitnessFunction = GiniGain,
+         typename DimensionSelectionType = MultipleRandomDimensionSelect,
+         template<typename> class CategoricalSplitType = AllCategoricalSplit>
+using ExtraTrees = RandomForest<FitnessFunction,
+                                DimensionSelectionType,
+                                RandomBinaryNumericSplit,
+                                CategoricalSplitType,
+                                false>;
+
 } // namespace tree
 } // namespace mlpack
 
@@ -22,13 +22,15 @@ template<
     typename FitnessFunction,
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
-    template<typename> class CategoricalSplitType
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
 >
 RandomForest<
     FitnessFunction,
     DimensionSelectionType,
     NumericSplitType,
-    CategoricalSplitType
+    CategoricalSplitType,
+    UseBootstrap
 >::RandomForest() :
     avgGain(0.0)
 {
@@ -39,14 +41,16 @@ template<
     typename FitnessFunction,
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
-    template<typename> class CategoricalSplitType
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
 >
 template<typename MatType>
 RandomForest<
     FitnessFunction,
     DimensionSelectionType,
     NumericSplitType,
-    CategoricalSplitType
+    CategoricalSplitType,
+    UseBootstrap
 >::RandomForest(const MatType& dataset,
                 const arma::Row<size_t>& labels,
                 const size_t numClasses,
@@ -60,23 +64,25 @@ RandomForest<
   // Pass off work to the Train() method.
   data::DatasetInfo info; // Ignored.
   arma::rowvec weights; // Fake weights, not used.
-  Train<false, false>(dataset, info, labels, numClasses, weights, numTrees,
-      minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector,
-      false);
+  Train<false, false>(distributed::LocalCommunicator(), dataset, info, labels,
+      numClasses, weights, numTrees, minimumLeafSize, minimumGainSplit,
+      maximumDepth, dimensionSelector, false);
 }
 
 template<
     typename FitnessFunction,
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
-    template<typename> class CategoricalSplitType
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
 >
 template<typename MatType>
 RandomForest<
     FitnessFunction,
     DimensionSelectionType,
     NumericSplitType,
-    CategoricalSplitType
+    CategoricalSplitType,
+    UseBootstrap
 >::RandomForest(const MatType& dataset,
                 const data::DatasetInfo& datasetInfo,
                 const arma::Row<size_t>& labels,
@@ -90,23 +96,25 @@ RandomForest<
 {
   // Pass off work to the Train() method.
   arma::rowvec weights; // Fake weights, not used.
-  Train<false, true>(dataset, datasetInfo, labels, numClasses, weights,
-      numTrees, minimumLeafSize, minimumGainSplit, maximumDepth,
-      dimensionSelector, false);
+  Train<false, true>(distributed::LocalCommunicator(), dataset, datasetInfo,
+      labels, numClasses, weights, numTrees, minimumLeafSize, minimumGainSplit,
+      maximumDepth, dimensionSelector, false);
 }
 
 template<
     typename FitnessFunction,
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
-    template<typename> class CategoricalSplitType
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
 >
 template<typename MatType>
 RandomForest<
     FitnessFunction,
     DimensionSelectionType,
     NumericSplitType,
-    CategoricalSplitType
+    CategoricalSplitType,
+    UseBootstrap
 >::RandomForest(const MatType& dataset,
                 const arma::Row<size_t>& labels,
                 const size_t numClasses,
@@ -120,23 +128,25 @@ RandomForest<
 {
   // Pass off work to the Train() method.
   data::DatasetInfo info; // Ignored by Train().
-  Train<true, false>(dataset, info, labels, numClasses, weights, numTrees,
-      minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector,
-      false);
+  Train<true, false>(distributed::LocalCommunicator(), dataset, info, labels,
+      numClasses, weights, numTrees, minimumLeafSize, minimumGainSplit,
+      maximumDepth, dimensionSelector, false);
 }
 
 template<
     typename FitnessFunction,
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
-    template<typename> class CategoricalSplitType
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
 >
 template<typename MatType>
 RandomForest<
     FitnessFunction,
     DimensionSelectionType,
     NumericSplitType,
-    CategoricalSplitType
+    CategoricalSplitType,
+    UseBootstrap
 >::RandomForest(const MatType& dataset,
                 const data::DatasetInfo& datasetInfo,
                 const arma::Row<size_t>& labels,
@@ -150,23 +160,25 @@ RandomForest<
     avgGain(0.0)
 {
   // Pass off work to the Train() method.
-  Train<true, true>(dataset, datasetInfo, labels, numClasses, weights,
-      numTrees, minimumLeafSize, minimumGainSplit, maximumDepth,
-      dimensionSelector, false);
+  Train<true, true>(distributed::LocalCommunicator(), dataset, datasetInfo,
+      labels, numClasses, weights, numTrees, minimumLeafSize, minimumGainSplit,
+      maximumDepth, dimensionSelector, false);
 }
 
 template<
     typename FitnessFunction,
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
-    template<typename> class CategoricalSplitType
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
 >
 template<typename MatType>
 double RandomForest<
     FitnessFunction,
     DimensionSelectionType,
     NumericSplitType,
-    CategoricalSplitType
+    CategoricalSplitType,
+    UseBootstrap
 >::Train(const MatType& dataset,
          const arma::Row<size_t>& labels,
          const size_t numClasses,
@@ -180,23 +192,25 @@ double RandomForest<
   // Pass off to Train().
   data::DatasetInfo datasetInfo; // Ignored by Train().
   arma::rowvec weights; // Ignored by Train().
-  return Train<false, false>(dataset, datasetInfo, labels, numClasses, weights,
-      numTrees, minimumLeafSize, minimumGainSplit, maximumDepth,
-      dimensionSelector, warmStart);
+  return Train<false, false>(distributed::LocalCommunicator(), dataset,
+      datasetInfo, labels, numClasses, weights, numTrees, minimumLeafSize,
+      minimumGainSplit, maximumDepth, dimensionSelector, warmStart);
 }
 
 template<
     typename FitnessFunction,
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
-    template<typename> class CategoricalSplitType
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
 >
 template<typename MatType>
 double RandomForest<
     FitnessFunction,
     DimensionSelectionType,
     NumericSplitType,
-    CategoricalSplitType
+    CategoricalSplitType,
+    UseBootstrap
 >::Train(const MatType& dataset,
          const data::DatasetInfo& datasetInfo,
          const arma::Row<size_t>& labels,
@@ -210,23 +224,25 @@ double RandomForest<
 {
   // Pass off to Train().
   arma::rowvec weights; // Ignored by Train().
-  return Train<false, true>(dataset, datasetInfo, labels, numClasses, weights,
-      numTrees, minimumLeafSize, minimumGainSplit, maximumDepth,
-      dimensionSelector, warmStart);
+  return Train<false, true>(distributed::LocalCommunicator(), dataset,
+      datasetInfo, labels, numClasses, weights, numTrees, minimumLeafSize,
+      minimumGainSplit, maximumDepth, dimensionSelector, warmStart);
 }
 
 template<
     typename FitnessFunction,
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
-    template<typename> class CategoricalSplitType
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
 >
 template<typename MatType>
 double RandomForest<
     FitnessFunction,
     DimensionSelectionType,
     NumericSplitType,
-    CategoricalSplitType
+    CategoricalSplitType,
+    UseBootstrap
 >::Train(const MatType& dataset,
          const arma::Row<size_t>& labels,
          const size_t numClasses,
@@ -240,23 +256,25 @@ double RandomForest<
 {
   // Pass off to Train().
   data::DatasetInfo datasetInfo; // Ignored by Train().
-  return Train<false, false>(dataset, datasetInfo, labels, numClasses, weights,
-      numTrees, minimumLeafSize, minimumGainSplit, maximumDepth,
-      dimensionSelector, warmStart);
+  return Train<false, false>(distributed::LocalCommunicator(), dataset,
+      datasetInfo, labels, numClasses, weights, numTrees, minimumLeafSize,
+      minimumGainSplit, maximumDepth, dimensionSelector, warmStart);
 }
 
 template<
     typename FitnessFunction,
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
-    template<typename> class CategoricalSplitType
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
 >
 template<typename MatType>
 double RandomForest<
     FitnessFunction,
     DimensionSelectionType,
     NumericSplitType,
-    CategoricalSplitType
+    CategoricalSplitType,
+    UseBootstrap
 >::Train(const MatType& dataset,
          const data::DatasetInfo& datasetInfo,
          const arma::Row<size_t>& labels,
@@ -270,29 +288,64 @@ double RandomForest<
          DimensionSelectionType dimensionSelector)
 {
   // Pass off to Train().
-  return Train<true, true>(dataset, datasetInfo, labels, numClasses, weights,
-      numTrees, minimumLeafSize, minimumGainSplit, maximumDepth,
-      dimensionSelector, warmStart);
+  return Train<true, true>(distributed::LocalCommunicator(), dataset,
+      datasetInfo, labels, numClasses, weights, numTrees, minimumLeafSize,
+      minimumGainSplit, maximumDepth, dimensionSelector, warmStart);
 }
 
 template<
     typename FitnessFunction,
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
-    template<typename> class CategoricalSplitType
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+template<typename CommunicatorType, typename MatType>
+double RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::Train(CommunicatorType& communicator,
+         const MatType& dataset,
+         const arma::Row<size_t>& labels,
+         const size_t numClasses,
+         const size_t numTrees,
+         const size_t minimumLeafSize,
+         const double minimumGainSplit,
+         const size_t maximumDepth,
+         const bool warmStart,
+         DimensionSelectionType dimensionSelector)
+{
+  // Pass off to Train().
+  data::DatasetInfo datasetInfo; // Ignored by Train().
+  arma::rowvec weights; // Ignored by Train().
+  return Train<false, false>(communicator, dataset, datasetInfo, labels,
+      numClasses, weights, numTrees, minimumLeafSize, minimumGainSplit,
+      maximumDepth, dimensionSelector, warmStart);
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
 >
 template<typename VecType>
 size_t RandomForest<
     FitnessFunction,
     DimensionSelectionType,
     NumericSplitType,
-    CategoricalSplitType
->::Classify(const VecType& point) const
+    CategoricalSplitType,
+    UseBootstrap
+>::Classify(const VecType& point, const size_t numTrees) const
 {
   // Pass off to another Classify() overload.
   size_t predictedClass;
   arma::vec probabilities;
-  Classify(point, predictedClass, probabilities);
+  Classify(point, predictedClass, probabilities, numTrees);
 
   return predictedClass;
 }
@@ -301,17 +354,20 @@ template<
     typename FitnessFunction,
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
-    template<typename> class CategoricalSplitType
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
 >
 template<typename VecType>
 void RandomForest<
     FitnessFunction,
     DimensionSelectionType,
     NumericSplitType,
-    CategoricalSplitType
+    CategoricalSplitType,
+    UseBootstrap
 >::Classify(const VecType& point,
             size_t& prediction,
-            arma::vec& probabilities) const
+            arma::vec& probabilities,
+            const size_t numTrees) const
 {
   // Check edge case.
   if (trees.size() == 0)
@@ -323,8 +379,11 @@ void RandomForest<
         "trained!");
   }
 
+  const size_t usedTrees = (numTrees == 0) ? trees.size() :
+      std::min(numTrees, trees.size());
+
   probabilities.zeros(trees[0].NumClasses());
-  for (size_t i = 0; i < trees.size(); ++i)
+  for (size_t i = 0; i < usedTrees; ++i)
   {
     arma::vec treeProbs;
     size_t treePrediction; // Ignored.
@@ -334,7 +393,7 @@ void RandomForest<
   }
 
   // Find maximum element after renormalizing probabilities.
-  probabilities /= trees.size();
+  probabilities /= usedTrees;
   arma::uword maxIndex = 0;
   probabilities.max(maxIndex);
 
@@ -346,16 +405,19 @@ template<
     typename FitnessFunction,
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
-    template<typename> class CategoricalSplitType
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
 >
 template<typename MatType>
 void RandomForest<
     FitnessFunction,
     DimensionSelectionType,
     NumericSplitType,
-    CategoricalSplitType
+    CategoricalSplitType,
+    UseBootstrap
 >::Classify(const MatType& data,
-            arma::Row<size_t>& predictions) const
+            arma::Row<size_t>& predictions,
+            const size_t numTrees) const
 {
   // Check edge case.
   if (trees.size() == 0)
@@ -368,10 +430,10 @@ void RandomForest<
 
   predictions.set_size(data.n_cols);
 
-  #pragma omp parallel for
+  #pragma omp parallel for MLPACK_OMP_PROC_BIND
   for (omp_size_t i = 0; i < data.n_cols; ++i)
   {
-    predictions[i] = Classify(data.col(i));
+    predictions[i] = Classify(data.col(i), numTrees);
   }
 }
 
@@ -379,17 +441,20 @@ template<
     typename FitnessFunction,
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
-    template<typename> class CategoricalSplitType
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
 >
 template<typename MatType>
 void RandomForest<
     FitnessFunction,
     DimensionSelectionType,
     NumericSplitType,
-    CategoricalSplitType
+    CategoricalSplitType,
+    UseBootstrap
 >::Classify(const MatType& data,
             arma::Row<size_t>& predictions,
-            arma::mat& probabilities) const
+            arma::mat& probabilities,
+            const size_t numTrees) const
 {
   // Check edge case.
   if (trees.size() == 0)
@@ -403,28 +468,68 @@ void RandomForest<
 
   probabilities.set_size(trees[0].NumClasses(), data.n_cols);
   predictions.set_size(data.n_cols);
-  #pragma omp parallel for
+  #pragma omp parallel for MLPACK_OMP_PROC_BIND
   for (omp_size_t i = 0; i < data.n_cols; ++i)
   {
     arma::vec probs = probabilities.unsafe_col(i);
-    Classify(data.col(i), predictions[i], probs);
+    Classify(data.col(i), predictions[i], probs, numTrees);
+  }
+}
+
+template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
+>
+CompiledTreeEnsemble RandomForest<
+    FitnessFunction,
+    DimensionSelectionType,
+    NumericSplitType,
+    CategoricalSplitType,
+    UseBootstrap
+>::Compile() const
+{
+  // Check edge case.
+  if (trees.size() == 0)
+  {
+    throw std::invalid_argument("RandomForest::Compile(): no random forest "
+        "trained!");
   }
+
+  CompiledTreeEnsemble compiled;
+  for (size_t i = 0; i < trees.size(); ++i)
+    compiled.Add(trees[i]);
+
+  return compiled;
 }
 
 template<
     typename FitnessFunction,
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
-    template<typename> class CategoricalSplitType
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
 >
 template<typename Archive>
 void RandomForest<
     FitnessFunction,
     DimensionSelectionType,
     NumericSplitType,
-    CategoricalSplitType
->::serialize(Archive& ar, const uint32_t /* version */)
+    CategoricalSplitType,
+    UseBootstrap
+>::serialize(Archive& ar, const uint32_t version)
 {
+  // Since version 1, the trees come last, and only the first trees are loaded
+  // under a cereal::EnsembleLoadLimit.
+  if (version >= 1)
+  {
+    ar(CEREAL_NVP(avgGain));
+    ar(cereal::make_nvp("trees", CEREAL_ENSEMBLE(trees)));
+    return;
+  }
+
   size_t numTrees;
   if (cereal::is_loading<Archive>())
     trees.clear();
@@ -439,21 +544,31 @@ void RandomForest<
 
   ar(CEREAL_NVP(trees));
   ar(CEREAL_NVP(avgGain));
+
+  if (cereal::is_loading<Archive>() &&
+      trees.size() > cereal::EnsembleLoadLimit::Get())
+    trees.resize(cereal::EnsembleLoadLimit::Get());
 }
 
 template<
     typename FitnessFunction,
     typename DimensionSelectionType,
     template<typename> class NumericSplitType,
-    template<typename> class CategoricalSplitType
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap
 >
-template<bool UseWeights, bool UseDatasetInfo, typename MatType>
+template<bool UseWeights,
+         bool UseDatasetInfo,
+         typename MatType,
+         typename CommunicatorType>
 double RandomForest<
     FitnessFunction,
     DimensionSelectionType,
     NumericSplitType,
-    CategoricalSplitType
->::Train(const MatType& dataset,
+    CategoricalSplitType,
+    UseBootstrap
+>::Train(CommunicatorType&& communicator,
+         const MatType& dataset,
          const data::DatasetInfo& datasetInfo,
          const arma::Row<size_t>& labels,
          const size_t numClasses,
@@ -469,21 +584,58 @@ double RandomForest<
   if (!warmStart)
     trees.clear();
   const size_t oldNumTrees = trees.size();
-  trees.resize(trees.size() + numTrees);
-
-  // Convert avgGain to total gain.
-  double totalGain = avgGain * oldNumTrees;
 
-  // Train each tree individually.
-  #pragma omp parallel for reduction( + : totalGain)
-  for (omp_size_t i = 0; i < numTrees; ++i)
+  // Each process trains a contiguous range of the new trees.
+  const size_t rank = communicator.Rank();
+  const size_t size = communicator.Size();
+  const size_t begin = rank * numTrees / size;
+  const size_t localNumTrees = (rank + 1) * numTrees / size - begin;
+  trees.resize(oldNumTrees + localNumTrees);
+
+  // Train each tree individually.  Each tree draws its bootstrap sample and
+  // its random dimensions from its own random stream, so the forest does not
+  // depend on the number of threads or on the number of processes (which all
+  // use the seed of the first process).
+  uint64_t seed = math::RandomStreamSeed();
+  communicator.Broadcast(&seed, sizeof(seed), 0);
+
+  // Every thread reads random points of the dataset, so with MLPACK_USE_NUMA
+  // the trees are trained on a copy spread over the memory of the machine.
+  #ifdef MLPACK_USE_NUMA
+  MatType placedDataset;
+  util::FirstTouchCopy(dataset, placedDataset);
+  const MatType& trainDataset = placedDataset;
+  #else
+  const MatType& trainDataset = dataset;
+  #endif
+
+  double newGain = 0.0;
+  #pragma omp parallel for reduction( + : newGain) MLPACK_OMP_PROC_BIND
+  for (omp_size_t i = 0; i < (omp_size_t) localNumTrees; ++i)
   {
+    math::RandomStream stream((size_t) seed, oldNumTrees + begin + i);
+
+    // Only the indices of the bootstrap sample are drawn; each tree reads its
+    // points through a view of the dataset instead of a copy of them.  Without
+    // bootstrap sampling, every tree sees all the points.
     Timer::Start("bootstrap");
-    MatType bootstrapDataset;
+    arma::uvec indices;
     arma::Row<size_t> bootstrapLabels;
     arma::rowvec bootstrapWeights;
-    Bootstrap<UseWeights>(dataset, labels, weights, bootstrapDataset,
-        bootstrapLabels, bootstrapWeights);
+    if (UseBootstrap)
+    {
+      BootstrapIndices<UseWeights>(trainDataset, labels, weights, indices,
+          bootstrapLabels, bootstrapWeights);
+    }
+    else
+    {
+      indices = arma::linspace<arma::uvec>(0, trainDataset.n_cols - 1,
+          trainDataset.n_cols);
+      bootstrapLabels = labels;
+      if (UseWeights)
+        bootstrapWeights = weights;
+    }
+    BootstrapView<MatType> bootstrapDataset(trainDataset, std::move(indices));
     Timer::Stop("bootstrap");
 
     Timer::Start("train_tree");
@@ -491,42 +643,96 @@ double RandomForest<
     {
       if (UseDatasetInfo)
       {
-        totalGain += trees[oldNumTrees + i].Train(bootstrapDataset,
-            datasetInfo, bootstrapLabels, numClasses, bootstrapWeights,
-            minimumLeafSize, minimumGainSplit, maximumDepth,
-            dimensionSelector);
+        newGain += trees[oldNumTrees + i].Train(std::move(bootstrapDataset),
+            datasetInfo, std::move(bootstrapLabels), numClasses,
+            std::move(bootstrapWeights), minimumLeafSize, minimumGainSplit,
+            maximumDepth, dimensionSelector);
       }
       else
       {
-        totalGain += trees[oldNumTrees + i].Train(bootstrapDataset,
-            bootstrapLabels, numClasses, bootstrapWeights, minimumLeafSize,
-            minimumGainSplit, maximumDepth, dimensionSelector);
+        newGain += trees[oldNumTrees + i].Train(std::move(bootstrapDataset),
+            std::move(bootstrapLabels), numClasses,
+            std::move(bootstrapWeights), minimumLeafSize, minimumGainSplit,
+            maximumDepth, dimensionSelector);
       }
     }
     else
     {
       if (UseDatasetInfo)
       {
-        totalGain += trees[oldNumTrees + i].Train(bootstrapDataset,
-            datasetInfo, bootstrapLabels, numClasses, minimumLeafSize,
-            minimumGainSplit, maximumDepth, dimensionSelector);
+        newGain += trees[oldNumTrees + i].Train(std::move(bootstrapDataset),
+            datasetInfo, std::move(bootstrapLabels), numClasses,
+            minimumLeafSize, minimumGainSplit, maximumDepth,
+            dimensionSelector);
       }
       else
       {
-        totalGain += trees[oldNumTrees + i].Train(bootstrapDataset,
-            bootstrapLabels, numClasses, minimumLeafSize, minimumGainSplit,
-            maximumDepth, dimensionSelector);
+        newGain += trees[oldNumTrees + i].Train(std::move(bootstrapDataset),
+            std::move(bootstrapLabels), numClasses, minimumLeafSize,
+            minimumGainSplit, maximumDepth, dimensionSelector);
       }
     }
 
     Timer::Stop("train_tree");
   }
 
-  avgGain = totalGain / trees.size();
+  if (size > 1)
+  {
+    // Give the new trees of every process to every process, in the order of
+    // the ranks.
+    std::ostringstream oss;
+    {
+      cereal::BinaryOutputArchive ar(oss);
+      for (size_t i = oldNumTrees; i < trees.size(); ++i)
+        ar(trees[i]);
+    }
+    const std::string localTrees = oss.str();
+    std::vector<std::vector<char>> blocks;
+    distributed::RingAllGather(communicator,
+        std::vector<char>(localTrees.begin(), localTrees.end()), blocks);
+
+    std::vector<DecisionTreeType> ownTrees(
+        std::make_move_iterator(trees.begin() + oldNumTrees),
+        std::make_move_iterator(trees.end()));
+    trees.resize(oldNumTrees);
+    trees.reserve(oldNumTrees + numTrees);
+    for (size_t r = 0; r < size; ++r)
+    {
+      if (r == rank)
+      {
+        std::move(ownTrees.begin(), ownTrees.end(), std::back_inserter(trees));
+        continue;
+      }
+
+      const size_t rankNumTrees = (r + 1) * numTrees / size - r * numTrees /
+          size;
+      std::istringstream iss(std::string(blocks[r].begin(), blocks[r].end()));
+      cereal::BinaryInputArchive ar(iss);
+      for (size_t i = 0; i < rankNumTrees; ++i)
+      {
+        trees.push_back(DecisionTreeType());
+        ar(trees.back());
+      }
+    }
+
+    distributed::RingAllReduce(communicator, &newGain, 1);
+  }
+
+  avgGain = (avgGain * oldNumTrees + newGain) / trees.size();
   return avgGain;
 }
 
 } // namespace tree
 } // namespace mlpack
 
+// Set the version of the serialization of all random forests.
+CEREAL_TEMPLATE_CLASS_VERSION((template<
+    typename FitnessFunction,
+    typename DimensionSelectionType,
+    template<typename> class NumericSplitType,
+    template<typename> class CategoricalSplitType,
+    bool UseBootstrap>),
+    (mlpack::tree::RandomForest<FitnessFunction, DimensionSelectionType,
+        NumericSplitType, CategoricalSplitType, UseBootstrap>), (1));
+
 #endif
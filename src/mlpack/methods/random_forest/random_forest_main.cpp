@@ -69,7 +69,14 @@ BINDING_LONG_DESC(
     PRINT_PARAM_STRING("test_labels") + " parameter.  Predictions for each "
     "test point may be saved via the " + PRINT_PARAM_STRING("predictions") +
     "output parameter.  Class probabilities for each prediction may be saved "
-    "with the " + PRINT_PARAM_STRING("probabilities") + " output parameter.");
+    "with the " + PRINT_PARAM_STRING("probabilities") + " output parameter."
+    "\n\n"
+    "If mlpack is built with MPI support (the USE_MPI CMake option), the " +
+    PRINT_PARAM_STRING("distributed") + " option trains the forest with every "
+    "process launched by mpirun: each process loads the same training set and "
+    "trains its share of the trees, and the trees are then exchanged so that "
+    "the forest is the same as if one process had trained it.  Only the first "
+    "process saves the model and the predictions.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -132,6 +139,8 @@ PARAM_INT_IN("subspace_dim", "Dimensionality of random subspace to use for "
 PARAM_INT_IN("seed", "Random seed.  If 0, 'std::time(NULL)' is used.", "s", 0);
 PARAM_FLAG("warm_start", "If true and passed along with `training` and "
     "`input_model` then trains more trees on top of existing model.", "w");
+PARAM_FLAG("distributed", "Share the training of the trees between all the MPI "
+    "processes (requires mlpack built with USE_MPI).", "");
 
 /**
  * This is the class that we will serialize.  It is a pretty simple wrapper
@@ -147,6 +156,15 @@ class RandomForestModel
   // Create the model.
   RandomForestModel() { /* Nothing to do. */ }
 
+  // Classify the given points; the Python binding calls this directly (see
+  // bindings/python/print_model_methods.hpp).
+  void Classify(const arma::mat& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const
+  {
+    rf.Classify(data, predictions, probabilities);
+  }
+
   // Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
@@ -162,6 +180,15 @@ PARAM_MODEL_OUT(RandomForestModel, "output_model", "Model to save trained "
 
 static void mlpackMain()
 {
+#ifndef MLPACK_USE_MPI
+  if (IO::HasParam("distributed"))
+  {
+    Log::Fatal << "Cannot use " << PRINT_PARAM_STRING("distributed") << ": "
+        << "mlpack was not built with MPI support (USE_MPI)." << endl;
+  }
+#endif
+  ReportIgnoredParam({{ "training", false }}, "distributed");
+
   // Initialize random seed if needed.
   if (IO::GetParam<int>("seed") != 0)
     math::RandomSeed((size_t) IO::GetParam<int>("seed"));
@@ -245,8 +272,33 @@ static void mlpackMain()
     const size_t numClasses = arma::max(labels) + 1;
 
     // Train the model.
-    rfModel->rf.Train(data, labels, numClasses, numTrees, minimumLeafSize,
-        minimumGainSplit, maxDepth, IO::HasParam("warm_start"), mrds);
+    if (IO::HasParam("distributed"))
+    {
+#ifdef MLPACK_USE_MPI
+      distributed::MPICommunicator::Initialize();
+      distributed::MPICommunicator communicator;
+      Log::Info << "Sharing the trees between " << communicator.Size()
+          << " processes." << endl;
+      rfModel->rf.Train(communicator, data, labels, numClasses, numTrees,
+          minimumLeafSize, minimumGainSplit, maxDepth,
+          IO::HasParam("warm_start"), mrds);
+
+      // Only the first process uses and saves the forest.
+      if (communicator.Rank() != 0)
+      {
+        IO::Parameters()["print_training_accuracy"].wasPassed = false;
+        IO::Parameters()["test"].wasPassed = false;
+        IO::Parameters()["predictions"].wasPassed = false;
+        IO::Parameters()["probabilities"].wasPassed = false;
+        IO::Parameters()["output_model"].wasPassed = false;
+      }
+#endif
+    }
+    else
+    {
+      rfModel->rf.Train(data, labels, numClasses, numTrees, minimumLeafSize,
+          minimumGainSplit, maxDepth, IO::HasParam("warm_start"), mrds);
+    }
 
     Timer::Stop("rf_training");
 
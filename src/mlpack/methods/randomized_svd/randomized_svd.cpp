@@ -22,10 +22,12 @@ RandomizedSVD::RandomizedSVD(const arma::mat& data,
                              const size_t iteratedPower,
                              const size_t maxIterations,
                              const size_t rank,
-                             const double eps) :
+                             const double eps,
+                             const OrthogonalizationType orthogonalization) :
     iteratedPower(iteratedPower),
     maxIterations(maxIterations),
-    eps(eps)
+    eps(eps),
+    orthogonalization(orthogonalization)
 {
   if (rank == 0)
   {
@@ -39,38 +41,15 @@ RandomizedSVD::RandomizedSVD(const arma::mat& data,
 
 RandomizedSVD::RandomizedSVD(const size_t iteratedPower,
                              const size_t maxIterations,
-                             const double eps) :
+                             const double eps,
+                             const OrthogonalizationType orthogonalization) :
     iteratedPower(iteratedPower),
     maxIterations(maxIterations),
-    eps(eps)
+    eps(eps),
+    orthogonalization(orthogonalization)
 {
   /* Nothing to do here */
 }
 
-
-void RandomizedSVD::Apply(const arma::sp_mat& data,
-                          arma::mat& u,
-                          arma::vec& s,
-                          arma::mat& v,
-                          const size_t rank)
-{
-  // Center the data into a temporary matrix for sparse matrix.
-  arma::sp_mat rowMean = arma::sum(data, 1) / data.n_cols;
-
-  Apply(data, u, s, v, rank, rowMean);
-}
-
-void RandomizedSVD::Apply(const arma::mat& data,
-                          arma::mat& u,
-                          arma::vec& s,
-                          arma::mat& v,
-                          const size_t rank)
-{
-  // Center the data into a temporary matrix.
-  arma::mat rowMean = arma::sum(data, 1) / data.n_cols + eps;
-
-  Apply(data, u, s, v, rank, rowMean);
-}
-
 } // namespace svd
 } // namespace mlpack
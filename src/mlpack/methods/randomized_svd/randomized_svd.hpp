@@ -15,6 +15,8 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "randomized_svd_utils.hpp"
+
 namespace mlpack {
 namespace svd {
 
@@ -80,6 +82,8 @@ class RandomizedSVD
    * @param rank Rank of the approximation (Default: number of rows.)
    * @param eps The eps coefficient to avoid division by zero (numerical
    *        stability).
+   * @param orthogonalization Strategy used to orthogonalize the sampled range
+   *        between and after the power iterations.
    */
   RandomizedSVD(const arma::mat& data,
                 arma::mat& u,
@@ -88,7 +92,9 @@ class RandomizedSVD
                 const size_t iteratedPower = 0,
                 const size_t maxIterations = 2,
                 const size_t rank = 0,
-                const double eps = 1e-7);
+                const double eps = 1e-7,
+                const OrthogonalizationType orthogonalization =
+                    LU_ORTHOGONALIZATION);
 
   /**
    * Create object for the randomized SVD method.
@@ -99,14 +105,20 @@ class RandomizedSVD
    *        (Default: 2).
    * @param eps The eps coefficient to avoid division by zero (numerical
    *        stability).
+   * @param orthogonalization Strategy used to orthogonalize the sampled range
+   *        between and after the power iterations.
    */
   RandomizedSVD(const size_t iteratedPower = 0,
                 const size_t maxIterations = 2,
-                const double eps = 1e-7);
+                const double eps = 1e-7,
+                const OrthogonalizationType orthogonalization =
+                    LU_ORTHOGONALIZATION);
 
-/**
+  /**
    * Center the data to apply Principal Component Analysis on given sparse
-   * matrix dataset using randomized SVD.
+   * matrix dataset using randomized SVD.  Both arma::sp_mat and arma::sp_fmat
+   * are supported; the products of the sparse data with the dense blocks are
+   * multithreaded when OpenMP is available.
    *
    * @param data Sparse data matrix.
    * @param u First unitary matrix.
@@ -114,15 +126,17 @@ class RandomizedSVD
    * @param s Diagonal "Sigma" matrix of singular values.
    * @param rank Rank of the approximation.
    */
-  void Apply(const arma::sp_mat& data,
-             arma::mat& u,
-             arma::vec& s,
-             arma::mat& v,
+  template<typename eT>
+  void Apply(const arma::SpMat<eT>& data,
+             arma::Mat<eT>& u,
+             arma::Col<eT>& s,
+             arma::Mat<eT>& v,
              const size_t rank);
 
-/**
+  /**
    * Center the data to apply Principal Component Analysis on given matrix
-   * dataset using randomized SVD.
+   * dataset using randomized SVD.  Both arma::mat and arma::fmat are
+   * supported.
    *
    * @param data Data matrix.
    * @param u First unitary matrix.
@@ -130,10 +144,11 @@ class RandomizedSVD
    * @param s Diagonal "Sigma" matrix of singular values.
    * @param rank Rank of the approximation.
    */
-  void Apply(const arma::mat& data,
-             arma::mat& u,
-             arma::vec& s,
-             arma::mat& v,
+  template<typename eT>
+  void Apply(const arma::Mat<eT>& data,
+             arma::Mat<eT>& u,
+             arma::Col<eT>& s,
+             arma::Mat<eT>& v,
              const size_t rank);
 
   /**
@@ -149,87 +164,11 @@ class RandomizedSVD
    */
   template<typename MatType>
   void Apply(const MatType& data,
-             arma::mat& u,
-             arma::vec& s,
-             arma::mat& v,
+             arma::Mat<typename MatType::elem_type>& u,
+             arma::Col<typename MatType::elem_type>& s,
+             arma::Mat<typename MatType::elem_type>& v,
              const size_t rank,
-             MatType rowMean)
-  {
-    if (iteratedPower == 0)
-      iteratedPower = rank + 2;
-
-    arma::mat R, Q, Qdata;
-
-    // Apply the centered data matrix to a random matrix, obtaining Q.
-    if (data.n_cols >= data.n_rows)
-    {
-      R = arma::randn<arma::mat>(data.n_rows, iteratedPower);
-      Q = (data.t() * R) - arma::repmat(arma::trans(R.t() * rowMean),
-          data.n_cols, 1);
-    }
-    else
-    {
-      R = arma::randn<arma::mat>(data.n_cols, iteratedPower);
-      Q = (data * R) - (rowMean * (arma::ones(1, data.n_cols) * R));
-    }
-
-    // Form a matrix Q whose columns constitute a
-    // well-conditioned basis for the columns of the earlier Q.
-    if (maxIterations == 0)
-    {
-      arma::qr_econ(Q, v, Q);
-    }
-    else
-    {
-      arma::lu(Q, v, Q);
-    }
-
-    // Perform normalized power iterations.
-    for (size_t i = 0; i < maxIterations; ++i)
-    {
-      if (data.n_cols >= data.n_rows)
-      {
-        Q = (data * Q) - rowMean * (arma::ones(1, data.n_cols) * Q);
-        arma::lu(Q, v, Q);
-        Q = (data.t() * Q) - arma::repmat(rowMean.t() * Q, data.n_cols, 1);
-      }
-      else
-      {
-        Q = (data.t() * Q) - arma::repmat(rowMean.t() * Q, data.n_cols, 1);
-        arma::lu(Q, v, Q);
-        Q = (data * Q) - (rowMean * (arma::ones(1, data.n_cols) * Q));
-      }
-
-      // Computing the LU decomposition is more efficient than computing the QR
-      // decomposition, so we only use it in the last iteration, a pivoted QR
-      // decomposition which renormalizes Q, ensuring that the columns of Q are
-      // orthonormal.
-      if (i < (maxIterations - 1))
-      {
-        arma::lu(Q, v, Q);
-      }
-      else
-      {
-        arma::qr_econ(Q, v, Q);
-      }
-    }
-
-    // Do economical singular value decomposition and compute only the
-    // approximations of the left singular vectors by using the centered data
-    // applied to Q.
-    if (data.n_cols >= data.n_rows)
-    {
-      Qdata = (data * Q) - rowMean * (arma::ones(1, data.n_cols) * Q);
-      arma::svd_econ(u, s, v, Qdata);
-      v = Q * v;
-    }
-    else
-    {
-      Qdata = (Q.t() * data) - arma::repmat(Q.t() * rowMean, 1,  data.n_cols);
-      arma::svd_econ(u, s, v, Qdata);
-      u = Q * u;
-    }
-  }
+             MatType rowMean);
 
   //! Get the size of the normalized power iterations.
   size_t IteratedPower() const { return iteratedPower; }
@@ -246,7 +185,30 @@ class RandomizedSVD
   //! Modify the value used for decomposition stability.
   double& Epsilon() { return eps; }
 
+  //! Get the orthogonalization strategy.
+  OrthogonalizationType Orthogonalization() const { return orthogonalization; }
+  //! Modify the orthogonalization strategy.
+  OrthogonalizationType& Orthogonalization() { return orthogonalization; }
+
  private:
+  /**
+   * Compute the product of the centered data with the given block, that is,
+   * (data - rowMean * 1') * x.
+   */
+  template<typename MatType, typename eT>
+  static arma::Mat<eT> CenteredTimes(const MatType& data,
+                                     const arma::Mat<eT>& rowMean,
+                                     const arma::Mat<eT>& x);
+
+  /**
+   * Compute the product of the transposed centered data with the given block,
+   * that is, (data - rowMean * 1')' * x.
+   */
+  template<typename MatType, typename eT>
+  static arma::Mat<eT> CenteredTransTimes(const MatType& data,
+                                          const arma::Mat<eT>& rowMean,
+                                          const arma::Mat<eT>& x);
+
   //! Locally stored size of the normalized power iterations.
   size_t iteratedPower;
 
@@ -255,9 +217,15 @@ class RandomizedSVD
 
   //! The value used for numerical stability.
   double eps;
+
+  //! The strategy used to orthogonalize the sampled range.
+  OrthogonalizationType orthogonalization;
 };
 
 } // namespace svd
 } // namespace mlpack
 
+// Include implementation.
+#include "randomized_svd_impl.hpp"
+
 #endif
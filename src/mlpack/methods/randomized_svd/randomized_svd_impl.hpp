@@ -0,0 +1,146 @@
+/**
+ * @file methods/randomized_svd/randomized_svd_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the templated parts of the randomized SVD method.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOMIZED_SVD_RANDOMIZED_SVD_IMPL_HPP
+#define MLPACK_METHODS_RANDOMIZED_SVD_RANDOMIZED_SVD_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "randomized_svd.hpp"
+
+namespace mlpack {
+namespace svd {
+
+template<typename eT>
+void RandomizedSVD::Apply(const arma::SpMat<eT>& data,
+                          arma::Mat<eT>& u,
+                          arma::Col<eT>& s,
+                          arma::Mat<eT>& v,
+                          const size_t rank)
+{
+  // Center the data into a temporary matrix for sparse matrix.
+  arma::SpMat<eT> rowMean = arma::sum(data, 1) / data.n_cols;
+
+  Apply(data, u, s, v, rank, rowMean);
+}
+
+template<typename eT>
+void RandomizedSVD::Apply(const arma::Mat<eT>& data,
+                          arma::Mat<eT>& u,
+                          arma::Col<eT>& s,
+                          arma::Mat<eT>& v,
+                          const size_t rank)
+{
+  // Center the data into a temporary matrix.
+  arma::Mat<eT> rowMean = arma::sum(data, 1) / data.n_cols + eps;
+
+  Apply(data, u, s, v, rank, rowMean);
+}
+
+template<typename MatType>
+void RandomizedSVD::Apply(const MatType& data,
+                          arma::Mat<typename MatType::elem_type>& u,
+                          arma::Col<typename MatType::elem_type>& s,
+                          arma::Mat<typename MatType::elem_type>& v,
+                          const size_t rank,
+                          MatType rowMean)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  if (iteratedPower == 0)
+    iteratedPower = rank + 2;
+
+  // The mean is dense, even for sparse data.
+  const arma::Mat<ElemType> mean(rowMean);
+
+  arma::Mat<ElemType> R, Q, Qdata;
+
+  // Apply the centered data matrix to a random matrix, obtaining Q.
+  if (data.n_cols >= data.n_rows)
+  {
+    R = arma::randn<arma::Mat<ElemType>>(data.n_rows, iteratedPower);
+    Q = CenteredTransTimes(data, mean, R);
+  }
+  else
+  {
+    R = arma::randn<arma::Mat<ElemType>>(data.n_cols, iteratedPower);
+    Q = CenteredTimes(data, mean, R);
+  }
+
+  // Form a matrix Q whose columns constitute a well-conditioned basis for the
+  // columns of the earlier Q; it must be orthonormal if there are no power
+  // iterations.
+  OrthogonalizeBlock(Q, orthogonalization, maxIterations == 0);
+
+  // Perform normalized power iterations.
+  for (size_t i = 0; i < maxIterations; ++i)
+  {
+    if (data.n_cols >= data.n_rows)
+    {
+      Q = CenteredTimes(data, mean, Q);
+      OrthogonalizeBlock(Q, orthogonalization, false);
+      Q = CenteredTransTimes(data, mean, Q);
+    }
+    else
+    {
+      Q = CenteredTransTimes(data, mean, Q);
+      OrthogonalizeBlock(Q, orthogonalization, false);
+      Q = CenteredTimes(data, mean, Q);
+    }
+
+    // Only the last iteration needs an orthonormal basis; with the default LU
+    // strategy, the cheaper LU decomposition is used before that, and a
+    // pivoted QR decomposition renormalizes Q in the last iteration.
+    OrthogonalizeBlock(Q, orthogonalization, i == (maxIterations - 1));
+  }
+
+  // Do economical singular value decomposition and compute only the
+  // approximations of the left singular vectors by using the centered data
+  // applied to Q.
+  if (data.n_cols >= data.n_rows)
+  {
+    Qdata = CenteredTimes(data, mean, Q);
+    arma::svd_econ(u, s, v, Qdata);
+    v = Q * v;
+  }
+  else
+  {
+    Qdata = CenteredTransTimes(data, mean, Q).t();
+    arma::svd_econ(u, s, v, Qdata);
+    u = Q * u;
+  }
+}
+
+template<typename MatType, typename eT>
+arma::Mat<eT> RandomizedSVD::CenteredTimes(const MatType& data,
+                                           const arma::Mat<eT>& rowMean,
+                                           const arma::Mat<eT>& x)
+{
+  arma::Mat<eT> output;
+  BlockTimes(data, x, output);
+  output -= rowMean * arma::sum(x, 0);
+  return output;
+}
+
+template<typename MatType, typename eT>
+arma::Mat<eT> RandomizedSVD::CenteredTransTimes(const MatType& data,
+                                                const arma::Mat<eT>& rowMean,
+                                                const arma::Mat<eT>& x)
+{
+  arma::Mat<eT> output;
+  BlockTransTimes(data, x, output);
+  output.each_row() -= rowMean.t() * x;
+  return output;
+}
+
+} // namespace svd
+} // namespace mlpack
+
+#endif
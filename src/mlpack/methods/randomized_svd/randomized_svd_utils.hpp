@@ -0,0 +1,173 @@
+/**
+ * @file methods/randomized_svd/randomized_svd_utils.hpp
+ *
+ * Building blocks shared by the randomized SVD methods: the orthogonalization
+ * of the range of the sampled matrix, and products of the (dense or sparse)
+ * data matrix with dense blocks, which are multithreaded for sparse data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOMIZED_SVD_RANDOMIZED_SVD_UTILS_HPP
+#define MLPACK_METHODS_RANDOMIZED_SVD_RANDOMIZED_SVD_UTILS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace svd {
+
+/**
+ * The strategies to orthogonalize the blocks of the randomized SVD methods.
+ *
+ *  - LU_ORTHOGONALIZATION: blocks that only need to be well-conditioned (those
+ *    between power iterations) are normalized with a pivoted LU decomposition,
+ *    which is cheaper than QR; the final basis is computed with a Householder
+ *    QR decomposition.
+ *  - QR_ORTHOGONALIZATION: every block is orthonormalized with a Householder
+ *    QR decomposition.
+ *  - CHOLESKY_QR_ORTHOGONALIZATION: every block is orthonormalized with two
+ *    passes of Cholesky-QR (Q = Y * inv(chol(Y' * Y))), which only needs a
+ *    small Gram matrix and is mostly matrix products.  If the Gram matrix is
+ *    too ill-conditioned, the block falls back to Householder QR.
+ */
+enum OrthogonalizationType
+{
+  LU_ORTHOGONALIZATION,
+  QR_ORTHOGONALIZATION,
+  CHOLESKY_QR_ORTHOGONALIZATION
+};
+
+/**
+ * Replace the given block by a well-conditioned (if orthonormal is false) or
+ * orthonormal (if orthonormal is true) basis of its range, with the given
+ * strategy.
+ *
+ * @param block Block to orthogonalize in place.
+ * @param type Orthogonalization strategy.
+ * @param orthonormal Whether the result must have orthonormal columns.
+ */
+template<typename eT>
+void OrthogonalizeBlock(arma::Mat<eT>& block,
+                        const OrthogonalizationType type,
+                        const bool orthonormal)
+{
+  arma::Mat<eT> r;
+  if (type == LU_ORTHOGONALIZATION && !orthonormal)
+  {
+    arma::lu(block, r, block);
+    return;
+  }
+
+  if (type == CHOLESKY_QR_ORTHOGONALIZATION)
+  {
+    // The second pass restores the orthogonality lost to rounding in the
+    // first one.  Cholesky-QR is only accurate if the block is reasonably
+    // well-conditioned, which the diagonal of the first factor tells us.
+    arma::Mat<eT> q = block;
+    bool success = true;
+    for (size_t pass = 0; pass < 2 && success; ++pass)
+    {
+      success = arma::chol(r, q.t() * q);
+      if (success && pass == 0)
+      {
+        const arma::Col<eT> d = arma::abs(r.diag());
+        success = (d.min() > std::sqrt(std::numeric_limits<eT>::epsilon()) *
+            d.max());
+      }
+
+      if (success)
+        q *= arma::inv(arma::trimatu(r));
+    }
+
+    if (success)
+    {
+      block = std::move(q);
+      return;
+    }
+  }
+
+  arma::qr_econ(block, r, block);
+}
+
+/**
+ * Compute data * x.
+ */
+template<typename eT>
+void BlockTimes(const arma::Mat<eT>& data,
+                const arma::Mat<eT>& x,
+                arma::Mat<eT>& output)
+{
+  output = data * x;
+}
+
+/**
+ * Compute data * x for sparse data.  The columns of the output are computed in
+ * parallel, when OpenMP is available.
+ */
+template<typename eT>
+void BlockTimes(const arma::SpMat<eT>& data,
+                const arma::Mat<eT>& x,
+                arma::Mat<eT>& output)
+{
+  data.sync();
+  output.zeros(data.n_rows, x.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t j = 0; j < (omp_size_t) x.n_cols; ++j)
+  {
+    eT* out = output.colptr(j);
+    for (size_t c = 0; c < data.n_cols; ++c)
+    {
+      const eT xc = x(c, j);
+      if (xc == eT(0))
+        continue;
+
+      for (size_t p = data.col_ptrs[c]; p < data.col_ptrs[c + 1]; ++p)
+        out[data.row_indices[p]] += data.values[p] * xc;
+    }
+  }
+}
+
+/**
+ * Compute data.t() * x.
+ */
+template<typename eT>
+void BlockTransTimes(const arma::Mat<eT>& data,
+                     const arma::Mat<eT>& x,
+                     arma::Mat<eT>& output)
+{
+  output = data.t() * x;
+}
+
+/**
+ * Compute data.t() * x for sparse data.  The rows of the output (one for each
+ * column of the data) are computed in parallel, when OpenMP is available.
+ */
+template<typename eT>
+void BlockTransTimes(const arma::SpMat<eT>& data,
+                     const arma::Mat<eT>& x,
+                     arma::Mat<eT>& output)
+{
+  data.sync();
+  output.set_size(data.n_cols, x.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t c = 0; c < (omp_size_t) data.n_cols; ++c)
+  {
+    for (size_t j = 0; j < x.n_cols; ++j)
+    {
+      const eT* xj = x.colptr(j);
+      eT sum = 0;
+      for (size_t p = data.col_ptrs[c]; p < data.col_ptrs[c + 1]; ++p)
+        sum += data.values[p] * xj[data.row_indices[p]];
+      output(c, j) = sum;
+    }
+  }
+}
+
+} // namespace svd
+} // namespace mlpack
+
+#endif
@@ -16,6 +16,7 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
+#include <mlpack/core/tree/prepared_query.hpp>
 #include "range_search_stat.hpp"
 
 namespace mlpack {
@@ -235,6 +236,25 @@ class RangeSearch
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<double>>& distances);
 
+  /**
+   * Search for all reference points in the given range for each point of the
+   * given prepared query, reusing its query tree instead of building a new
+   * one.  The results are in the original order of the query points, as with
+   * the overload that takes a query set.  This can only be used in dual-tree
+   * mode.
+   *
+   * @param query Query tree built on the query points.
+   * @param range Range of distances in which to search.
+   * @param neighbors Object which will hold the list of neighbors for each
+   *      point which fell into the given range, for each query point.
+   * @param distances Object which will hold the list of distances for each
+   *      point which fell into the given range, for each query point.
+   */
+  void Search(tree::PreparedQuery<Tree>& query,
+              const math::Range& range,
+              std::vector<std::vector<size_t>>& neighbors,
+              std::vector<std::vector<double>>& distances);
+
   /**
    * Search for all points in the given range for each point in the reference
    * set (which was passed to the constructor), returning the results in the
@@ -268,6 +288,92 @@ class RangeSearch
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<double>>& distances);
 
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, storing the results in compressed sparse row form: the
+   * neighbors of query point i are neighbors[offsets[i]] to
+   * neighbors[offsets[i + 1] - 1], and their distances are stored at the same
+   * positions of distances.  offsets has one element more than the number of
+   * query points.  Unlike the vector-of-vectors version of Search(), no memory
+   * is allocated per query point.
+   *
+   * The query points are searched in parallel when OpenMP is available: naive
+   * and single-tree searches use one task per query point (trees whose
+   * single-tree scoring updates node statistics, like the cover tree, are
+   * searched by one thread), and dual-tree searches split the query tree at
+   * ParallelDepth().  Each thread collects its results in its own buffer, and
+   * the buffers are scattered into the output (mapping the indices back to
+   * the original dataset) in one pass.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param offsets Vector which will hold the start of the results of each
+   *      query point, followed by the total number of results.
+   * @param neighbors Vector which will hold the indices of the reference
+   *      points found for each query point.
+   * @param distances Vector which will hold the distance to each reference
+   *      point found for each query point.
+   */
+  void Search(const MatType& querySet,
+              const math::Range& range,
+              arma::Col<size_t>& offsets,
+              arma::Col<size_t>& neighbors,
+              arma::vec& distances);
+
+  /**
+   * Search for all the points in the given range for each point in the
+   * reference set (which was passed to the constructor), storing the results
+   * in compressed sparse row form, as in the other CSR overload of Search().  A
+   * point is not returned in its own range.
+   *
+   * @param range Range of distances in which to search.
+   * @param offsets Vector which will hold the start of the results of each
+   *      point, followed by the total number of results.
+   * @param neighbors Vector which will hold the indices of the points found
+   *      for each point.
+   * @param distances Vector which will hold the distance to each point found
+   *      for each point.
+   */
+  void Search(const math::Range& range,
+              arma::Col<size_t>& offsets,
+              arma::Col<size_t>& neighbors,
+              arma::vec& distances);
+
+  /**
+   * Count the reference points in the given range of each point in the query
+   * set, without storing the neighbors.  If a threshold is given, the search
+   * for a query point stops as soon as that many neighbors are found, which is
+   * useful when only "at least maxCount neighbors" matters; counts that reach
+   * the threshold may then be larger than it, but are not exact.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param counts Vector which will hold the number of reference points in the
+   *      range of each query point.
+   * @param maxCount Count at which the search for a query point stops
+   *      (SIZE_MAX means all neighbors are counted).
+   */
+  void Count(const MatType& querySet,
+             const math::Range& range,
+             arma::Col<size_t>& counts,
+             const size_t maxCount = SIZE_MAX);
+
+  /**
+   * Count the points in the given range of each point in the reference set
+   * (which was passed to the constructor), without storing the neighbors.  A
+   * point is not counted in its own range.  If a threshold is given, the
+   * search for a point stops as soon as that many neighbors are found.
+   *
+   * @param range Range of distances in which to search.
+   * @param counts Vector which will hold the number of points in the range of
+   *      each point.
+   * @param maxCount Count at which the search for a point stops (SIZE_MAX
+   *      means all neighbors are counted).
+   */
+  void Count(const math::Range& range,
+             arma::Col<size_t>& counts,
+             const size_t maxCount = SIZE_MAX);
+
   //! Get whether single-tree search is being used.
   bool SingleMode() const { return singleMode; }
   //! Modify whether single-tree search is being used.
@@ -278,6 +384,12 @@ class RangeSearch
   //! Modify whether naive search is being used.
   bool& Naive() { return naive; }
 
+  //! Get the depth at which the query tree is split into parallel tasks by
+  //! the CSR overloads of Search() in dual-tree mode (0 means no splitting).
+  size_t ParallelDepth() const { return parallelDepth; }
+  //! Modify the depth at which the query tree is split into parallel tasks.
+  size_t& ParallelDepth() { return parallelDepth; }
+
   //! Get the number of base cases during the last search.
   size_t BaseCases() const { return baseCases; }
   //! Get the number of scores during the last search.
@@ -310,6 +422,9 @@ class RangeSearch
   //! If true, single-tree computation is used.
   bool singleMode;
 
+  //! The depth at which the query tree is split into parallel tasks.
+  size_t parallelDepth;
+
   //! Instantiated distance metric.
   MetricType metric;
 
@@ -318,6 +433,18 @@ class RangeSearch
   //! The total number of scores during the last search.
   size_t scores;
 
+  /**
+   * Run the search for the CSR overloads of Search().  If sameSet is true, the
+   * query set is the reference set and the reference tree is used as the query
+   * tree.
+   */
+  void SearchCSR(const MatType& querySet,
+                 const bool sameSet,
+                 const math::Range& range,
+                 arma::Col<size_t>& offsets,
+                 arma::Col<size_t>& neighbors,
+                 arma::vec& distances);
+
   //! For access to mappings when building models.
   friend class LeafSizeRSWrapper<TreeType>;
 };
@@ -18,6 +18,8 @@
 // The rules for traversal.
 #include "range_search_rules.hpp"
 
+#include <mlpack/core/tree/traversal_tasks.hpp>
+
 namespace mlpack {
 namespace range {
 
@@ -59,6 +61,7 @@ RangeSearch<MetricType, MatType, TreeType>::RangeSearch(
     treeOwner(!naive),
     naive(naive),
     singleMode(!naive && singleMode),
+    parallelDepth(0),
     metric(metric),
     baseCases(0),
     scores(0)
@@ -80,6 +83,7 @@ RangeSearch<MetricType, MatType, TreeType>::RangeSearch(
     treeOwner(false),
     naive(false),
     singleMode(singleMode),
+    parallelDepth(0),
     metric(metric),
     baseCases(0),
     scores(0)
@@ -101,6 +105,7 @@ RangeSearch<MetricType, MatType, TreeType>::RangeSearch(
     treeOwner(false),
     naive(naive),
     singleMode(singleMode),
+    parallelDepth(0),
     metric(metric),
     baseCases(0),
     scores(0)
@@ -108,7 +113,7 @@ RangeSearch<MetricType, MatType, TreeType>::RangeSearch(
   // Build the tree on the empty dataset, if necessary.
   if (!naive)
   {
-    referenceTree = BuildTree<Tree>(std::move(arma::mat()),
+    referenceTree = BuildTree<Tree>(std::move(MatType()),
         oldFromNewReferences);
     referenceSet = &referenceTree->Dataset();
     treeOwner = true;
@@ -129,6 +134,7 @@ RangeSearch<MetricType, MatType, TreeType>::RangeSearch(
     treeOwner(other.referenceTree),
     naive(other.naive),
     singleMode(other.singleMode),
+    parallelDepth(other.parallelDepth),
     metric(other.metric),
     baseCases(other.baseCases),
     scores(other.scores)
@@ -148,13 +154,14 @@ RangeSearch<MetricType, MatType, TreeType>::RangeSearch(RangeSearch&& other) :
     treeOwner(other.treeOwner),
     naive(other.naive),
     singleMode(other.singleMode),
+    parallelDepth(other.parallelDepth),
     metric(std::move(other.metric)),
     baseCases(other.baseCases),
     scores(other.scores)
 {
   // Clear other object.
   other.referenceTree =
-      BuildTree<Tree>(std::move(arma::mat()), other.oldFromNewReferences);
+      BuildTree<Tree>(std::move(MatType()), other.oldFromNewReferences);
   other.referenceSet = &other.referenceTree->Dataset();
   other.treeOwner = true;
   other.naive = false;
@@ -180,6 +187,7 @@ RangeSearch<MetricType, MatType, TreeType>::operator=(const RangeSearch& other)
     treeOwner = other.referenceTree;
     naive = other.naive;
     singleMode = other.singleMode;
+    parallelDepth = other.parallelDepth;
     metric = other.metric;
     baseCases = other.baseCases;
     scores = other.scores;
@@ -210,6 +218,7 @@ RangeSearch<MetricType, MatType, TreeType>::operator=(RangeSearch&& other)
     treeOwner = other.treeOwner;
     naive = other.naive;
     singleMode = other.singleMode;
+    parallelDepth = other.parallelDepth;
     metric = std::move(other.metric);
     baseCases = other.baseCases;
     scores = other.scores;
@@ -550,6 +559,23 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   }
 }
 
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    tree::PreparedQuery<Tree>& query,
+    const math::Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances)
+{
+  Search(&query.QueryTree(), range, neighbors, distances);
+
+  query.Unmap(neighbors);
+  query.Unmap(distances);
+}
+
 template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
@@ -651,6 +677,409 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   }
 }
 
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const math::Range& range,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::vec& distances)
+{
+  util::CheckSameDimensionality(querySet, *referenceSet,
+      "RangeSearch::Search()", "query set");
+
+  SearchCSR(querySet, false, range, offsets, neighbors, distances);
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const math::Range& range,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::vec& distances)
+{
+  SearchCSR(*referenceSet, true, range, offsets, neighbors, distances);
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::SearchCSR(
+    const MatType& querySet,
+    const bool sameSet,
+    const math::Range& range,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::vec& distances)
+{
+  offsets.zeros(querySet.n_cols + 1);
+  neighbors.reset();
+  distances.reset();
+  baseCases = 0;
+  scores = 0;
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+    return;
+
+  Timer::Start("range_search/computing_neighbors");
+
+  typedef RangeSearchRules<MetricType, Tree> RuleType;
+
+  #ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  #else
+  const size_t numThreads = 1;
+  #endif
+
+  // Each thread appends its results to its own buffers.  Every query point is
+  // handled by exactly one thread, so all of its results end up in the same
+  // buffer.
+  std::vector<std::vector<size_t>> resultQueries(numThreads);
+  std::vector<std::vector<size_t>> resultNeighbors(numThreads);
+  std::vector<std::vector<double>> resultDistances(numThreads);
+  std::vector<size_t> threadBaseCases(numThreads, 0);
+  std::vector<size_t> threadScores(numThreads, 0);
+
+  // The query tree, if we build one, and the mappings of its points.
+  Tree* queryTree = NULL;
+  std::vector<size_t> oldFromNewQueries;
+
+  if (naive)
+  {
+    #pragma omp parallel num_threads(numThreads)
+    {
+      #ifdef HAS_OPENMP
+      const size_t thread = omp_get_thread_num();
+      #else
+      const size_t thread = 0;
+      #endif
+
+      RuleType rules(*referenceSet, querySet, range, resultQueries[thread],
+          resultNeighbors[thread], resultDistances[thread], metric, sameSet);
+
+      #pragma omp for schedule(dynamic, 16)
+      for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+        for (size_t j = 0; j < referenceSet->n_cols; ++j)
+          rules.BaseCase(i, j);
+
+      threadBaseCases[thread] = rules.BaseCases();
+    }
+  }
+  else if (singleMode)
+  {
+    // The single-tree scores of trees whose first point is the centroid store
+    // the last distance in the statistic of each reference node, so those
+    // trees cannot be traversed by several threads at once.
+    const size_t searchThreads =
+        tree::TreeTraits<Tree>::FirstPointIsCentroid ? 1 : numThreads;
+
+    #pragma omp parallel num_threads(searchThreads)
+    {
+      #ifdef HAS_OPENMP
+      const size_t thread = omp_get_thread_num();
+      #else
+      const size_t thread = 0;
+      #endif
+
+      RuleType rules(*referenceSet, querySet, range, resultQueries[thread],
+          resultNeighbors[thread], resultDistances[thread], metric, sameSet);
+      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+      #pragma omp for schedule(dynamic, 16)
+      for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+        traverser.Traverse(i, *referenceTree);
+
+      threadBaseCases[thread] = rules.BaseCases();
+      threadScores[thread] = rules.Scores();
+    }
+  }
+  else // Dual-tree recursion.
+  {
+    if (!sameSet)
+    {
+      Timer::Stop("range_search/computing_neighbors");
+      Timer::Start("range_search/tree_building");
+      queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
+      Timer::Stop("range_search/tree_building");
+      Timer::Start("range_search/computing_neighbors");
+    }
+
+    Tree& queryNode = sameSet ? *referenceTree : *queryTree;
+    const MatType& queryData = queryNode.Dataset();
+
+    // The descendants of the task nodes partition the query points, and the
+    // dual-tree scores of range search never modify the trees, so the tasks
+    // can be traversed independently.
+    std::vector<Tree*> tasks;
+    if (parallelDepth > 0 && numThreads > 1)
+      tree::CollectTaskNodes(queryNode, parallelDepth, tasks);
+    else
+      tasks.push_back(&queryNode);
+
+    #pragma omp parallel num_threads(std::min(numThreads, tasks.size()))
+    {
+      #ifdef HAS_OPENMP
+      const size_t thread = omp_get_thread_num();
+      #else
+      const size_t thread = 0;
+      #endif
+
+      RuleType rules(*referenceSet, queryData, range, resultQueries[thread],
+          resultNeighbors[thread], resultDistances[thread], metric, sameSet);
+
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t i = 0; i < (omp_size_t) tasks.size(); ++i)
+      {
+        typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+        traverser.Traverse(*tasks[i], *referenceTree);
+      }
+
+      threadBaseCases[thread] = rules.BaseCases();
+      threadScores[thread] = rules.Scores();
+    }
+  }
+
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    baseCases += threadBaseCases[t];
+    scores += threadScores[t];
+  }
+
+  // Query indices must be mapped if we built the query tree, or if the query
+  // set is the rearranged reference set; reference indices must be mapped if
+  // we built the reference tree.
+  const bool mapReferences = treeOwner &&
+      tree::TreeTraits<Tree>::RearrangesDataset;
+  const bool mapQueries = tree::TreeTraits<Tree>::RearrangesDataset &&
+      ((queryTree != NULL) || (sameSet && treeOwner));
+  const std::vector<size_t>& queryMapping = (queryTree != NULL) ?
+      oldFromNewQueries : oldFromNewReferences;
+
+  // Count the results of each query point, and turn the counts into offsets.
+  for (size_t t = 0; t < numThreads; ++t)
+  {
+    for (size_t i = 0; i < resultQueries[t].size(); ++i)
+    {
+      const size_t q = resultQueries[t][i];
+      ++offsets[(mapQueries ? queryMapping[q] : q) + 1];
+    }
+  }
+
+  for (size_t i = 1; i < offsets.n_elem; ++i)
+    offsets[i] += offsets[i - 1];
+
+  neighbors.set_size(offsets[querySet.n_cols]);
+  distances.set_size(offsets[querySet.n_cols]);
+
+  // Scatter each buffer into the output, mapping the indices as we go.  Since
+  // the results of each query point are all in one buffer, the buffers can be
+  // scattered in parallel.
+  arma::Col<size_t> positions(offsets.subvec(0, querySet.n_cols));
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
+  {
+    for (size_t i = 0; i < resultQueries[t].size(); ++i)
+    {
+      const size_t q = resultQueries[t][i];
+      const size_t r = resultNeighbors[t][i];
+      const size_t position = positions[mapQueries ? queryMapping[q] : q]++;
+
+      neighbors[position] = mapReferences ? oldFromNewReferences[r] : r;
+      distances[position] = resultDistances[t][i];
+    }
+
+    // Release the buffer now that it has been copied.
+    std::vector<size_t>().swap(resultQueries[t]);
+    std::vector<size_t>().swap(resultNeighbors[t]);
+    std::vector<double>().swap(resultDistances[t]);
+  }
+
+  delete queryTree;
+
+  Timer::Stop("range_search/computing_neighbors");
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Count(
+    const MatType& querySet,
+    const math::Range& range,
+    arma::Col<size_t>& counts,
+    const size_t maxCount)
+{
+  util::CheckSameDimensionality(querySet, *referenceSet,
+      "RangeSearch::Count()", "query set");
+
+  counts.zeros(querySet.n_cols);
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+    return;
+
+  Timer::Start("range_search/computing_neighbors");
+
+  // Create the helper object for the traversal.
+  typedef RangeSearchRules<MetricType, Tree> RuleType;
+
+  if (naive)
+  {
+    RuleType rules(*referenceSet, querySet, range, counts, maxCount, metric);
+
+    // The naive brute-force solution, which can stop early for each point.
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+    {
+      for (size_t j = 0; j < referenceSet->n_cols && counts[i] < maxCount; ++j)
+        rules.BaseCase(i, j);
+    }
+
+    baseCases = rules.BaseCases();
+    scores = 0;
+  }
+  else if (singleMode)
+  {
+    // Create the traverser.
+    RuleType rules(*referenceSet, querySet, range, counts, maxCount, metric);
+    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+    // Now have it traverse for each point.
+    for (size_t i = 0; i < querySet.n_cols; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    baseCases = rules.BaseCases();
+    scores = rules.Scores();
+  }
+  else // Dual-tree recursion.
+  {
+    // Build the query tree.
+    Timer::Stop("range_search/computing_neighbors");
+    Timer::Start("range_search/tree_building");
+    std::vector<size_t> oldFromNewQueries;
+    Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
+    Timer::Stop("range_search/tree_building");
+    Timer::Start("range_search/computing_neighbors");
+
+    // The counts are found in the order of the query tree.
+    arma::Col<size_t> treeCounts(querySet.n_cols, arma::fill::zeros);
+    RuleType rules(*referenceSet, queryTree->Dataset(), range, treeCounts,
+        maxCount, metric);
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+    traverser.Traverse(*queryTree, *referenceTree);
+
+    baseCases = rules.BaseCases();
+    scores = rules.Scores();
+
+    // Only the query indices need to be mapped.
+    if (tree::TreeTraits<Tree>::RearrangesDataset)
+    {
+      for (size_t i = 0; i < treeCounts.n_elem; ++i)
+        counts[oldFromNewQueries[i]] = treeCounts[i];
+    }
+    else
+    {
+      counts = treeCounts;
+    }
+
+    delete queryTree;
+  }
+
+  Timer::Stop("range_search/computing_neighbors");
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Count(
+    const math::Range& range,
+    arma::Col<size_t>& counts,
+    const size_t maxCount)
+{
+  counts.zeros(referenceSet->n_cols);
+
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+    return;
+
+  Timer::Start("range_search/computing_neighbors");
+
+  // The counts are found in the order of the reference set, which may have
+  // been rearranged by the tree.
+  const bool mapped = (treeOwner && tree::TreeTraits<Tree>::RearrangesDataset);
+  arma::Col<size_t> treeCounts;
+  if (mapped)
+    treeCounts.zeros(referenceSet->n_cols);
+  arma::Col<size_t>& searchCounts = mapped ? treeCounts : counts;
+
+  // Create the helper object for the traversal.
+  typedef RangeSearchRules<MetricType, Tree> RuleType;
+  RuleType rules(*referenceSet, *referenceSet, range, searchCounts, maxCount,
+      metric, true /* don't count the query in its own range */);
+
+  if (naive)
+  {
+    // The naive brute-force solution, which can stop early for each point.
+    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+    {
+      for (size_t j = 0; j < referenceSet->n_cols; ++j)
+      {
+        if (searchCounts[i] >= maxCount)
+          break;
+
+        rules.BaseCase(i, j);
+      }
+    }
+
+    baseCases = rules.BaseCases();
+    scores = 0;
+  }
+  else if (singleMode)
+  {
+    // Create the traverser.
+    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+    // Now have it traverse for each point.
+    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+      traverser.Traverse(i, *referenceTree);
+
+    baseCases = rules.BaseCases();
+    scores = rules.Scores();
+  }
+  else // Dual-tree recursion.
+  {
+    // Create the traverser.
+    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+    traverser.Traverse(*referenceTree, *referenceTree);
+
+    baseCases = rules.BaseCases();
+    scores = rules.Scores();
+  }
+
+  Timer::Stop("range_search/computing_neighbors");
+
+  if (mapped)
+  {
+    for (size_t i = 0; i < treeCounts.n_elem; ++i)
+      counts[oldFromNewReferences[i]] = treeCounts[i];
+  }
+}
+
 template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
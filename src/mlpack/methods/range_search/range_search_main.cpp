@@ -69,7 +69,15 @@ BINDING_EXAMPLE(
     " resultant CSV-like files may not be loadable by many programs.  However, "
     "at this time a better way to store this non-square result is not known.  "
     "As a result, any output files will be written as CSVs in this manner, "
-    "regardless of the given extension.");
+    "regardless of the given extension."
+    "\n\n"
+    "The results are also available in compressed sparse row form, which is "
+    "more convenient from languages other than the command line: the "
+    "neighbors of query point i are the elements " + PRINT_PARAM_STRING(
+    "offsets") + "[i] up to (but not including) " + PRINT_PARAM_STRING(
+    "offsets") + "[i + 1] of " + PRINT_PARAM_STRING("neighbors") + ", and "
+    "their distances are the same elements of " +
+    PRINT_PARAM_STRING("distances") + ".");
 
 // See also...
 BINDING_SEE_ALSO("@knn", "#knn");
@@ -84,6 +92,13 @@ BINDING_SEE_ALSO("mlpack::range::RangeSearch C++ class documentation",
 PARAM_MATRIX_IN("reference", "Matrix containing the reference dataset.", "r");
 PARAM_STRING_OUT("distances_file", "File to output distances into.", "d");
 PARAM_STRING_OUT("neighbors_file", "File to output neighbors into.", "n");
+PARAM_UCOL_OUT("offsets", "Start of the results of each query point in the "
+    "compressed sparse row output, followed by the total number of results.",
+    "o");
+PARAM_UCOL_OUT("neighbors", "Neighbors of all query points in compressed "
+    "sparse row form.", "");
+PARAM_COL_OUT("distances", "Distances to the neighbors of all query points in "
+    "compressed sparse row form.", "");
 
 // The option exists to load or save models.
 PARAM_MODEL_IN(RSModel, "input_model", "File containing pre-trained range "
@@ -136,7 +151,8 @@ static void mlpackMain()
   // If the user specifies a range but not output files, they should be warned.
   if (IO::HasParam("min") || IO::HasParam("max"))
   {
-    RequireAtLeastOnePassed({ "neighbors_file", "distances_file" }, false,
+    RequireAtLeastOnePassed({ "neighbors_file", "distances_file", "offsets",
+        "neighbors", "distances" }, false,
         "no range search results will be saved");
   }
 
@@ -144,6 +160,9 @@ static void mlpackMain()
   {
     ReportIgnoredParam("neighbors_file", "no range is specified for searching");
     ReportIgnoredParam("distances_file", "no range is specified for searching");
+    ReportIgnoredParam("offsets", "no range is specified for searching");
+    ReportIgnoredParam("neighbors", "no range is specified for searching");
+    ReportIgnoredParam("distances", "no range is specified for searching");
   }
 
   if (IO::HasParam("input_model") &&
@@ -253,14 +272,15 @@ static void mlpackMain()
       Log::Warn << PRINT_PARAM_STRING("single_mode") << " ignored because "
           << PRINT_PARAM_STRING("naive") << " is present." << endl;
 
-    // Now run the search.
-    vector<vector<size_t>> neighbors;
-    vector<vector<double>> distances;
+    // Now run the search.  The results are stored contiguously, and the output
+    // files are written from the same arrays.
+    arma::Col<size_t> offsets, neighbors;
+    arma::vec distances;
 
     if (IO::HasParam("query"))
-      rs->Search(std::move(queryData), r, neighbors, distances);
+      rs->Search(std::move(queryData), r, offsets, neighbors, distances);
     else
-      rs->Search(r, neighbors, distances);
+      rs->Search(r, offsets, neighbors, distances);
 
     Log::Info << "Search complete." << endl;
 
@@ -277,15 +297,16 @@ static void mlpackMain()
       else
       {
         // Loop over each point.
-        for (size_t i = 0; i < distances.size(); ++i)
+        for (size_t i = 0; i + 1 < offsets.n_elem; ++i)
         {
           // Store the distances of each point.  We may have 0 points to store,
           // so we must account for that possibility.
-          for (size_t j = 0; j + 1 < distances[i].size(); ++j)
-            distancesStr << distances[i][j] << ", ";
-
-          if (distances[i].size() > 0)
-            distancesStr << distances[i][distances[i].size() - 1];
+          for (size_t j = offsets[i]; j < offsets[i + 1]; ++j)
+          {
+            distancesStr << distances[j];
+            if (j + 1 < offsets[i + 1])
+              distancesStr << ", ";
+          }
 
           distancesStr << endl;
         }
@@ -306,15 +327,16 @@ static void mlpackMain()
       else
       {
         // Loop over each point.
-        for (size_t i = 0; i < neighbors.size(); ++i)
+        for (size_t i = 0; i + 1 < offsets.n_elem; ++i)
         {
           // Store the neighbors of each point.  We may have 0 points to store,
           // so we must account for that possibility.
-          for (size_t j = 0; j + 1 < neighbors[i].size(); ++j)
-            neighborsStr << neighbors[i][j] << ", ";
-
-          if (neighbors[i].size() > 0)
-            neighborsStr << neighbors[i][neighbors[i].size() - 1];
+          for (size_t j = offsets[i]; j < offsets[i + 1]; ++j)
+          {
+            neighborsStr << neighbors[j];
+            if (j + 1 < offsets[i + 1])
+              neighborsStr << ", ";
+          }
 
           neighborsStr << endl;
         }
@@ -322,6 +344,10 @@ static void mlpackMain()
         neighborsStr.close();
       }
     }
+
+    IO::GetParam<arma::Col<size_t>>("offsets") = std::move(offsets);
+    IO::GetParam<arma::Col<size_t>>("neighbors") = std::move(neighbors);
+    IO::GetParam<arma::vec>("distances") = std::move(distances);
   }
 
   // Save the output model.
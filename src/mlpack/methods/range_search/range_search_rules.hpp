@@ -21,6 +21,12 @@ namespace range {
  * The RangeSearchRules class is a template helper class used by RangeSearch
  * class when performing range searches.
  *
+ * The rules either store the neighbors (and distances) found for each query
+ * point, append them to flat result buffers, or only count them.  When
+ * counting, a threshold can be given: once a query point has that many
+ * neighbors, the nodes it is scored against are pruned and no more base cases
+ * are computed for it.
+ *
  * @tparam MetricType The metric to use for computation.
  * @tparam TreeType The tree type to use; must adhere to the TreeType API.
  */
@@ -41,14 +47,67 @@ class RangeSearchRules
    * @param sameSet If true, the query and reference set are taken to be the
    *      same, and a query point will not return itself in the results.
    */
-  RangeSearchRules(const arma::mat& referenceSet,
-                   const arma::mat& querySet,
+  RangeSearchRules(const typename TreeType::Mat& referenceSet,
+                   const typename TreeType::Mat& querySet,
                    const math::Range& range,
                    std::vector<std::vector<size_t> >& neighbors,
                    std::vector<std::vector<double> >& distances,
                    MetricType& metric,
                    const bool sameSet = false);
 
+  /**
+   * Construct the RangeSearchRules object to count the neighbors of each query
+   * point instead of storing them.  Nothing is allocated per neighbor.  If a
+   * threshold is given, the search for a query point stops once the count
+   * reaches it; the final count is then only known to be at least the
+   * threshold (counts below the threshold are exact).
+   *
+   * @param referenceSet Set of reference data.
+   * @param querySet Set of query data.
+   * @param range Range to search for.
+   * @param counts Number of neighbors of each query point; this must be
+   *      initialized (usually to zeros) with one element per query point.
+   * @param maxCount Count at which the search for a query point stops
+   *      (SIZE_MAX means the neighbors are always all counted).
+   * @param metric Instantiated metric.
+   * @param sameSet If true, the query and reference set are taken to be the
+   *      same, and a query point will not be counted in its own range.
+   */
+  RangeSearchRules(const typename TreeType::Mat& referenceSet,
+                   const typename TreeType::Mat& querySet,
+                   const math::Range& range,
+                   arma::Col<size_t>& counts,
+                   const size_t maxCount,
+                   MetricType& metric,
+                   const bool sameSet = false);
+
+  /**
+   * Construct the RangeSearchRules object to append each result to flat
+   * buffers instead of storing it with its query point; result i is the
+   * reference point resultNeighbors[i] at distance resultDistances[i] from the
+   * query point resultQueries[i].  This avoids allocating memory for each query
+   * point, and lets several rules objects (used by different threads) collect
+   * results separately.
+   *
+   * @param referenceSet Set of reference data.
+   * @param querySet Set of query data.
+   * @param range Range to search for.
+   * @param resultQueries Vector to append the query index of each result to.
+   * @param resultNeighbors Vector to append the neighbor of each result to.
+   * @param resultDistances Vector to append the distance of each result to.
+   * @param metric Instantiated metric.
+   * @param sameSet If true, the query and reference set are taken to be the
+   *      same, and a query point will not return itself in the results.
+   */
+  RangeSearchRules(const typename TreeType::Mat& referenceSet,
+                   const typename TreeType::Mat& querySet,
+                   const math::Range& range,
+                   std::vector<size_t>& resultQueries,
+                   std::vector<size_t>& resultNeighbors,
+                   std::vector<double>& resultDistances,
+                   MetricType& metric,
+                   const bool sameSet = false);
+
   /**
    * Compute the base case between the given query point and reference point.
    *
@@ -123,19 +182,37 @@ class RangeSearchRules
 
  private:
   //! The reference set.
-  const arma::mat& referenceSet;
+  const typename TreeType::Mat& referenceSet;
 
   //! The query set.
-  const arma::mat& querySet;
+  const typename TreeType::Mat& querySet;
 
   //! The range of distances for which we are searching.
   const math::Range& range;
 
-  //! The vector the resultant neighbor indices should be stored in.
-  std::vector<std::vector<size_t> >& neighbors;
+  //! The vector the resultant neighbor indices should be stored in (NULL when
+  //! counting).
+  std::vector<std::vector<size_t> >* neighbors;
 
-  //! The vector the resultant neighbor distances should be stored in.
-  std::vector<std::vector<double> >& distances;
+  //! The vector the resultant neighbor distances should be stored in (NULL
+  //! when counting).
+  std::vector<std::vector<double> >* distances;
+
+  //! The buffer the query index of each result is appended to (NULL unless
+  //! using flat buffers).
+  std::vector<size_t>* resultQueries;
+
+  //! The buffer the neighbor of each result is appended to.
+  std::vector<size_t>* resultNeighbors;
+
+  //! The buffer the distance of each result is appended to.
+  std::vector<double>* resultDistances;
+
+  //! The number of neighbors of each query point (NULL unless counting).
+  arma::Col<size_t>* counts;
+
+  //! The count at which the search for a query point stops.
+  size_t maxCount;
 
   //! The instantiated metric.
   MetricType& metric;
@@ -154,6 +231,21 @@ class RangeSearchRules
   void AddResult(const size_t queryIndex,
                  TreeType& referenceNode);
 
+  //! Store a single result, in whichever form this object stores results.
+  void Store(const size_t queryIndex,
+             const size_t referenceIndex,
+             const double distance);
+
+  //! Return whether the given query point has reached the count threshold.
+  bool Saturated(const size_t queryIndex) const
+  {
+    return (counts != NULL) && ((*counts)[queryIndex] >= maxCount);
+  }
+
+  //! Return whether all descendants of the given query node have reached the
+  //! count threshold.
+  bool Saturated(TreeType& queryNode) const;
+
   TraversalInfoType traversalInfo;
 
   //! The number of base cases.
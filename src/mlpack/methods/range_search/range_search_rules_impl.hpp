@@ -20,8 +20,8 @@ namespace range {
 
 template<typename MetricType, typename TreeType>
 RangeSearchRules<MetricType, TreeType>::RangeSearchRules(
-    const arma::mat& referenceSet,
-    const arma::mat& querySet,
+    const typename TreeType::Mat& referenceSet,
+    const typename TreeType::Mat& querySet,
     const math::Range& range,
     std::vector<std::vector<size_t> >& neighbors,
     std::vector<std::vector<double> >& distances,
@@ -30,8 +30,72 @@ RangeSearchRules<MetricType, TreeType>::RangeSearchRules(
     referenceSet(referenceSet),
     querySet(querySet),
     range(range),
-    neighbors(neighbors),
-    distances(distances),
+    neighbors(&neighbors),
+    distances(&distances),
+    resultQueries(NULL),
+    resultNeighbors(NULL),
+    resultDistances(NULL),
+    counts(NULL),
+    maxCount(SIZE_MAX),
+    metric(metric),
+    sameSet(sameSet),
+    lastQueryIndex(querySet.n_cols),
+    lastReferenceIndex(referenceSet.n_cols),
+    baseCases(0),
+    scores(0)
+{
+  // Nothing to do.
+}
+
+template<typename MetricType, typename TreeType>
+RangeSearchRules<MetricType, TreeType>::RangeSearchRules(
+    const typename TreeType::Mat& referenceSet,
+    const typename TreeType::Mat& querySet,
+    const math::Range& range,
+    arma::Col<size_t>& counts,
+    const size_t maxCount,
+    MetricType& metric,
+    const bool sameSet) :
+    referenceSet(referenceSet),
+    querySet(querySet),
+    range(range),
+    neighbors(NULL),
+    distances(NULL),
+    resultQueries(NULL),
+    resultNeighbors(NULL),
+    resultDistances(NULL),
+    counts(&counts),
+    maxCount(maxCount),
+    metric(metric),
+    sameSet(sameSet),
+    lastQueryIndex(querySet.n_cols),
+    lastReferenceIndex(referenceSet.n_cols),
+    baseCases(0),
+    scores(0)
+{
+  // Nothing to do.
+}
+
+template<typename MetricType, typename TreeType>
+RangeSearchRules<MetricType, TreeType>::RangeSearchRules(
+    const typename TreeType::Mat& referenceSet,
+    const typename TreeType::Mat& querySet,
+    const math::Range& range,
+    std::vector<size_t>& resultQueries,
+    std::vector<size_t>& resultNeighbors,
+    std::vector<double>& resultDistances,
+    MetricType& metric,
+    const bool sameSet) :
+    referenceSet(referenceSet),
+    querySet(querySet),
+    range(range),
+    neighbors(NULL),
+    distances(NULL),
+    resultQueries(&resultQueries),
+    resultNeighbors(&resultNeighbors),
+    resultDistances(&resultDistances),
+    counts(NULL),
+    maxCount(SIZE_MAX),
     metric(metric),
     sameSet(sameSet),
     lastQueryIndex(querySet.n_cols),
@@ -58,6 +122,12 @@ double RangeSearchRules<MetricType, TreeType>::BaseCase(
   if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
     return 0.0; // No value to return... this shouldn't do anything bad.
 
+  // A query point with enough neighbors needs no more base cases, unless the
+  // tree uses the result of the base case for its bounds.
+  if (!tree::TreeTraits<TreeType>::FirstPointIsCentroid &&
+      Saturated(queryIndex))
+    return 0.0;
+
   const double distance = metric.Evaluate(querySet.unsafe_col(queryIndex),
       referenceSet.unsafe_col(referenceIndex));
   ++baseCases;
@@ -67,10 +137,7 @@ double RangeSearchRules<MetricType, TreeType>::BaseCase(
   lastReferenceIndex = referenceIndex;
 
   if (range.Contains(distance))
-  {
-    neighbors[queryIndex].push_back(referenceIndex);
-    distances[queryIndex].push_back(distance);
-  }
+    Store(queryIndex, referenceIndex, distance);
 
   return distance;
 }
@@ -80,6 +147,10 @@ template<typename MetricType, typename TreeType>
 double RangeSearchRules<MetricType, TreeType>::Score(const size_t queryIndex,
                                                      TreeType& referenceNode)
 {
+  // A query point with enough neighbors needs no more searching.
+  if (Saturated(queryIndex))
+    return DBL_MAX;
+
   // We must get the minimum and maximum distances and store them in this
   // object.
   math::Range distances;
@@ -151,6 +222,10 @@ template<typename MetricType, typename TreeType>
 double RangeSearchRules<MetricType, TreeType>::Score(TreeType& queryNode,
                                                      TreeType& referenceNode)
 {
+  // If every query point in the node has enough neighbors, prune.
+  if (counts != NULL && maxCount != SIZE_MAX && Saturated(queryNode))
+    return DBL_MAX;
+
   math::Range distances;
   if (tree::TreeTraits<TreeType>::FirstPointIsCentroid)
   {
@@ -236,14 +311,32 @@ void RangeSearchRules<MetricType, TreeType>::AddResult(const size_t queryIndex,
     baseCaseMod = 1;
   }
 
+  // When counting, only the number of points is needed.
+  if (counts != NULL)
+  {
+    size_t added = referenceNode.NumDescendants() - baseCaseMod;
+    if (&referenceSet == &querySet)
+    {
+      for (size_t i = baseCaseMod; i < referenceNode.NumDescendants(); ++i)
+        if (queryIndex == referenceNode.Descendant(i))
+          --added;
+    }
+
+    (*counts)[queryIndex] += added;
+    return;
+  }
+
   // Resize distances and neighbors vectors appropriately.  We have to use
   // reserve() and not resize(), because we don't know if we will encounter the
   // case where the datasets and points are the same (and we skip in that case).
-  const size_t oldSize = neighbors[queryIndex].size();
-  neighbors[queryIndex].reserve(oldSize + referenceNode.NumDescendants() -
-      baseCaseMod);
-  distances[queryIndex].reserve(oldSize + referenceNode.NumDescendants() -
-      baseCaseMod);
+  if (neighbors != NULL)
+  {
+    const size_t oldSize = (*neighbors)[queryIndex].size();
+    (*neighbors)[queryIndex].reserve(oldSize + referenceNode.NumDescendants() -
+        baseCaseMod);
+    (*distances)[queryIndex].reserve(oldSize + referenceNode.NumDescendants() -
+        baseCaseMod);
+  }
 
   for (size_t i = baseCaseMod; i < referenceNode.NumDescendants(); ++i)
   {
@@ -254,11 +347,47 @@ void RangeSearchRules<MetricType, TreeType>::AddResult(const size_t queryIndex,
     const double distance = metric.Evaluate(querySet.unsafe_col(queryIndex),
         referenceNode.Dataset().unsafe_col(referenceNode.Descendant(i)));
 
-    neighbors[queryIndex].push_back(referenceNode.Descendant(i));
-    distances[queryIndex].push_back(distance);
+    Store(queryIndex, referenceNode.Descendant(i), distance);
   }
 }
 
+//! Store a single result.
+template<typename MetricType, typename TreeType>
+inline force_inline
+void RangeSearchRules<MetricType, TreeType>::Store(
+    const size_t queryIndex,
+    const size_t referenceIndex,
+    const double distance)
+{
+  if (counts != NULL)
+  {
+    ++(*counts)[queryIndex];
+  }
+  else if (neighbors != NULL)
+  {
+    (*neighbors)[queryIndex].push_back(referenceIndex);
+    (*distances)[queryIndex].push_back(distance);
+  }
+  else
+  {
+    resultQueries->push_back(queryIndex);
+    resultNeighbors->push_back(referenceIndex);
+    resultDistances->push_back(distance);
+  }
+}
+
+//! Check whether all query points in the node have enough neighbors.
+template<typename MetricType, typename TreeType>
+bool RangeSearchRules<MetricType, TreeType>::Saturated(
+    TreeType& queryNode) const
+{
+  for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
+    if (!Saturated(queryNode.Descendant(i)))
+      return false;
+
+  return true;
+}
+
 } // namespace range
 } // namespace mlpack
 
@@ -237,6 +237,47 @@ void RSModel::Search(const math::Range& range,
   rSearch->Search(range, neighbors, distances);
 }
 
+// Perform range search with CSR output.
+void RSModel::Search(arma::mat&& querySet,
+                     const math::Range& range,
+                     arma::Col<size_t>& offsets,
+                     arma::Col<size_t>& neighbors,
+                     arma::vec& distances)
+{
+  // We may need to map the query set randomly.
+  if (randomBasis)
+    querySet = q * querySet;
+
+  Log::Info << "Search for points in the range [" << range.Lo() << ", "
+      << range.Hi() << "] with ";
+  if (!Naive() && !SingleMode())
+    Log::Info << "dual-tree " << TreeName() << " search..." << std::endl;
+  else if (!Naive())
+    Log::Info << "single-tree " << TreeName() << " search..." << std::endl;
+  else
+    Log::Info << "brute-force (naive) search..." << std::endl;
+
+  rSearch->Search(std::move(querySet), range, offsets, neighbors, distances);
+}
+
+// Perform range search with CSR output (monochromatic case).
+void RSModel::Search(const math::Range& range,
+                     arma::Col<size_t>& offsets,
+                     arma::Col<size_t>& neighbors,
+                     arma::vec& distances)
+{
+  Log::Info << "Search for points in the range [" << range.Lo() << ", "
+      << range.Hi() << "] with ";
+  if (!Naive() && !SingleMode())
+    Log::Info << "dual-tree " << TreeName() << " search..." << std::endl;
+  else if (!Naive())
+    Log::Info << "single-tree " << TreeName() << " search..." << std::endl;
+  else
+    Log::Info << "brute-force (naive) search..." << std::endl;
+
+  rSearch->Search(range, offsets, neighbors, distances);
+}
+
 // Get the name of the tree type.
 std::string RSModel::TreeName() const
 {
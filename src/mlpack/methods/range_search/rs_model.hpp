@@ -75,6 +75,21 @@ class RSWrapperBase
   virtual void Search(const math::Range& range,
                       std::vector<std::vector<size_t>>& neighbors,
                       std::vector<std::vector<double>>& distances) = 0;
+
+  //! Perform bichromatic range search, storing the results in compressed
+  //! sparse row form.
+  virtual void Search(arma::mat&& querySet,
+                      const math::Range& range,
+                      arma::Col<size_t>& offsets,
+                      arma::Col<size_t>& neighbors,
+                      arma::vec& distances) = 0;
+
+  //! Perform monochromatic range search, storing the results in compressed
+  //! sparse row form.
+  virtual void Search(const math::Range& range,
+                      arma::Col<size_t>& offsets,
+                      arma::Col<size_t>& neighbors,
+                      arma::vec& distances) = 0;
 };
 
 /**
@@ -132,6 +147,21 @@ class RSWrapper : public RSWrapperBase
                       std::vector<std::vector<size_t>>& neighbors,
                       std::vector<std::vector<double>>& distances);
 
+  //! Perform bichromatic range search, storing the results in compressed
+  //! sparse row form.  Any query tree is built with the default leaf size.
+  virtual void Search(arma::mat&& querySet,
+                      const math::Range& range,
+                      arma::Col<size_t>& offsets,
+                      arma::Col<size_t>& neighbors,
+                      arma::vec& distances);
+
+  //! Perform monochromatic range search, storing the results in compressed
+  //! sparse row form.
+  virtual void Search(const math::Range& range,
+                      arma::Col<size_t>& offsets,
+                      arma::Col<size_t>& neighbors,
+                      arma::vec& distances);
+
   //! Serialize the RangeSearch model.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */)
@@ -202,6 +232,9 @@ class LeafSizeRSWrapper : public RSWrapper<TreeType>
  * abstracting away the TreeType parameter and allowing it to be specified at
  * runtime.  This class is written for the sake of the `range_search` binding,
  * but is not necessarily restricted to that usage.
+ *
+ * RSModel holds double-precision data, like the bindings; to search
+ * single-precision data, use RangeSearch<MetricType, arma::fmat> directly.
  */
 class RSModel
 {
@@ -347,6 +380,41 @@ class RSModel
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<double>>& distances);
 
+  /**
+   * Perform range search, storing the results in compressed sparse row form:
+   * the neighbors of query point i are neighbors[offsets[i]] to
+   * neighbors[offsets[i + 1] - 1].  This takes possession of the query set, so
+   * the query set will not be usable after the search.  For more information,
+   * see RangeSearch<>::Search().
+   *
+   * @param querySet Set of query points.
+   * @param range Range to search for.
+   * @param offsets Output: start of the results of each query point, followed
+   *     by the total number of results.
+   * @param neighbors Output: neighbors falling within the desired range.
+   * @param distances Output: distances of neighbors.
+   */
+  void Search(arma::mat&& querySet,
+              const math::Range& range,
+              arma::Col<size_t>& offsets,
+              arma::Col<size_t>& neighbors,
+              arma::vec& distances);
+
+  /**
+   * Perform monochromatic range search, with the reference set as the query
+   * set, storing the results in compressed sparse row form.
+   *
+   * @param range Range to search for.
+   * @param offsets Output: start of the results of each point, followed by the
+   *     total number of results.
+   * @param neighbors Output: neighbors falling within the desired range.
+   * @param distances Output: distances of neighbors.
+   */
+  void Search(const math::Range& range,
+              arma::Col<size_t>& offsets,
+              arma::Col<size_t>& neighbors,
+              arma::vec& distances);
+
  private:
   //! The type of tree we are using.
   TreeTypes treeType;
@@ -51,6 +51,29 @@ void RSWrapper<TreeType>::Search(const math::Range& range,
   rs.Search(range, neighbors, distances);
 }
 
+template<template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RSWrapper<TreeType>::Search(arma::mat&& querySet,
+                                 const math::Range& range,
+                                 arma::Col<size_t>& offsets,
+                                 arma::Col<size_t>& neighbors,
+                                 arma::vec& distances)
+{
+  rs.Search(std::move(querySet), range, offsets, neighbors, distances);
+}
+
+template<template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RSWrapper<TreeType>::Search(const math::Range& range,
+                                 arma::Col<size_t>& offsets,
+                                 arma::Col<size_t>& neighbors,
+                                 arma::vec& distances)
+{
+  rs.Search(range, offsets, neighbors, distances);
+}
+
 template<template<typename TreeMetricType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType>
@@ -358,6 +358,22 @@ class RASearch
   //! Modify the limit on the size of a node that can be approximation.
   size_t& SingleSampleLimit() { return singleSampleLimit; }
 
+  /**
+   * Get the depth of the query tree at which the dual-tree search is split into
+   * independent parallel tasks.  If this is 0 (the default), dual-tree search
+   * is performed on a single thread.  Naive and single-tree search are always split between threads by query
+   * point.
+   */
+  size_t ParallelDepth() const { return parallelDepth; }
+  /**
+   * Modify the depth of the query tree at which the dual-tree search is split
+   * into independent parallel tasks.  Each query node at this depth (or each
+   * leaf above it) is traversed against the reference tree as a separate task
+   * with its own random stream, so the results do not depend on the number of
+   * threads.
+   */
+  size_t& ParallelDepth() { return parallelDepth; }
+
   //! Serialize the object.
   template<typename Archive>
   void serialize(Archive& ar, const uint32_t /* version */);
@@ -395,6 +411,41 @@ class RASearch
   //! Instantiation of kernel.
   MetricType metric;
 
+  //! The depth of the query tree at which dual-tree search is split into
+  //! parallel tasks (0 means no parallelism).
+  size_t parallelDepth;
+
+  /**
+   * Call the given function for each of the given number of query points,
+   * storing the results in the given rules object.  If OpenMP is available,
+   * the query points are split between threads, each of which uses a separate
+   * rules object; the results are then merged back into the given rules.  The
+   * random number generator of the rules is reseeded for each query point.
+   *
+   * @param numQueries Number of query points.
+   * @param rules Rules object to use for the search.
+   * @param query Function taking the rules to use and the index of a query
+   *     point, that searches for the neighbors of that query point.
+   */
+  template<typename RuleType, typename QueryFunction>
+  void SearchQueries(const size_t numQueries,
+                     RuleType& rules,
+                     const QueryFunction& query);
+
+  /**
+   * Perform the dual-tree traversal of the given query tree against the
+   * reference tree, storing the results in the given rules object.  If
+   * parallelDepth is nonzero, the query tree is split into independent
+   * subtrees, each sampled with its own random stream; if OpenMP is available
+   * they are traversed in parallel with separate rules objects, and the
+   * results are merged back into the given rules.
+   *
+   * @param queryTree Tree built on query points.
+   * @param rules Rules object to use for the traversal.
+   */
+  template<typename RuleType>
+  void DualTreeTraverse(Tree& queryTree, RuleType& rules);
+
   //! For access to mappings when building models.
   friend class LeafSizeRAWrapper<TreeType>;
 }; // class RASearch
@@ -14,9 +14,14 @@
 #define MLPACK_METHODS_RANN_RA_SEARCH_IMPL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/traversal_tasks.hpp>
 
 #include "ra_search_rules.hpp"
 
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace neighbor {
 
@@ -76,7 +81,8 @@ RASearch(MatType referenceSetIn,
     sampleAtLeaves(sampleAtLeaves),
     firstLeafExact(firstLeafExact),
     singleSampleLimit(singleSampleLimit),
-    metric(metric)
+    metric(metric),
+    parallelDepth(0)
 {
   // Nothing to do.
 }
@@ -108,7 +114,8 @@ RASearch(Tree* referenceTree,
     sampleAtLeaves(sampleAtLeaves),
     firstLeafExact(firstLeafExact),
     singleSampleLimit(singleSampleLimit),
-    metric(metric)
+    metric(metric),
+    parallelDepth(0)
 // Nothing else to initialize.
 {  }
 
@@ -139,7 +146,8 @@ RASearch(const bool naive,
     sampleAtLeaves(sampleAtLeaves),
     firstLeafExact(firstLeafExact),
     singleSampleLimit(singleSampleLimit),
-    metric(metric)
+    metric(metric),
+    parallelDepth(0)
 {
   // Build the tree on the empty dataset, if necessary.
   if (!naive)
@@ -293,7 +301,9 @@ Search(const MatType& querySet,
 
   if (naive)
   {
-    RuleType rules(*referenceSet, querySet, k, metric, tau, alpha, naive,
+    // The samples of each query point are drawn in SearchQueries() rather than
+    // in the constructor of the rules, so that they can be drawn in parallel.
+    RuleType rules(*referenceSet, querySet, k, metric, tau, alpha, false,
         sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
 
     // Find how many samples from the reference set we need and sample uniformly
@@ -304,11 +314,15 @@ Search(const MatType& querySet,
     math::ObtainDistinctSamples(0, referenceSet->n_cols, numSamples,
         distinctSamples);
 
-    // Run the base case on each combination of query point and sampled
-    // reference point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
+    // Sample for each query point, and run the base case on each combination
+    // of query point and sampled reference point.
+    SearchQueries(querySet.n_cols, rules, [&](RuleType& queryRules,
+                                              const size_t i)
+    {
+      queryRules.SampleNaively(i);
       for (size_t j = 0; j < distinctSamples.n_elem; ++j)
-        rules.BaseCase(i, (size_t) distinctSamples[j]);
+        queryRules.BaseCase(i, (size_t) distinctSamples[j]);
+    });
 
     rules.GetResults(*neighborPtr, *distancePtr);
   }
@@ -323,12 +337,14 @@ Search(const MatType& querySet,
     {
       Log::Info << "Performing single-tree traversal..." << std::endl;
 
-      // Create the traverser.
-      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
-
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
+      // Have each query point traverse the reference tree.
+      SearchQueries(querySet.n_cols, rules, [&](RuleType& queryRules,
+                                                const size_t i)
+      {
+        typename Tree::template SingleTreeTraverser<RuleType>
+            traverser(queryRules);
         traverser.Traverse(i, *referenceTree);
+      });
 
       Log::Info << "Single-tree traversal complete." << std::endl;
       Log::Info << "Average number of distance calculations per query point: "
@@ -352,12 +368,11 @@ Search(const MatType& querySet,
 
     RuleType rules(*referenceSet, queryTree->Dataset(), k, metric, tau, alpha,
         naive, sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
-    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
 
     Log::Info << "Query statistic pre-search: "
         << queryTree->Stat().NumSamplesMade() << std::endl;
 
-    traverser.Traverse(*queryTree, *referenceTree);
+    DualTreeTraverse(*queryTree, rules);
 
     Log::Info << "Dual-tree traversal complete." << std::endl;
     Log::Info << "Average number of distance calculations per query point: "
@@ -466,9 +481,7 @@ void RASearch<SortPolicy, MetricType, MatType, TreeType>::Search(
   RuleType rules(*referenceSet, queryTree->Dataset(), k, metric, tau, alpha,
       naive, sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
 
-  // Create the traverser.
-  typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-  traverser.Traverse(*queryTree, *referenceTree);
+  DualTreeTraverse(*queryTree, rules);
 
   rules.GetResults(*neighborPtr, distances);
 
@@ -519,39 +532,35 @@ void RASearch<SortPolicy, MetricType, MatType, TreeType>::Search(
 
   // Create the helper object for the tree traversal.
   typedef RASearchRules<SortPolicy, MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, *referenceSet, k, metric, tau, alpha, naive,
+  // Naive search is brute-force here, so the rules need not sample anything at
+  // construction time.
+  RuleType rules(*referenceSet, *referenceSet, k, metric, tau, alpha, false,
       sampleAtLeaves, firstLeafExact, singleSampleLimit, true /* same sets */);
 
   if (naive)
   {
-    // Find how many samples from the reference set we need and sample uniformly
-    // from the reference set without replacement.
-    const size_t numSamples = RAUtil::MinimumSamplesReqd(referenceSet->n_cols,
-        k, tau, alpha);
-    arma::uvec distinctSamples;
-    math::ObtainDistinctSamples(0, referenceSet->n_cols, numSamples,
-        distinctSamples);
-
     // The naive brute-force solution.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+    SearchQueries(referenceSet->n_cols, rules, [&](RuleType& queryRules,
+                                                   const size_t i)
+    {
       for (size_t j = 0; j < referenceSet->n_cols; ++j)
-        rules.BaseCase(i, j);
+        queryRules.BaseCase(i, j);
+    });
   }
   else if (singleMode)
   {
-    // Create the traverser.
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
-
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
+    // Have each point traverse the reference tree.
+    SearchQueries(referenceSet->n_cols, rules, [&](RuleType& queryRules,
+                                                   const size_t i)
+    {
+      typename Tree::template SingleTreeTraverser<RuleType>
+          traverser(queryRules);
       traverser.Traverse(i, *referenceTree);
+    });
   }
   else
   {
-    // Create the traverser.
-    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-
-    traverser.Traverse(*referenceTree, *referenceTree);
+    DualTreeTraverse(*referenceTree, rules);
   }
 
   rules.GetResults(*neighborPtr, *distancePtr);
@@ -581,6 +590,133 @@ void RASearch<SortPolicy, MetricType, MatType, TreeType>::Search(
   }
 }
 
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename RuleType, typename QueryFunction>
+void RASearch<SortPolicy, MetricType, MatType, TreeType>::SearchQueries(
+    const size_t numQueries,
+    RuleType& rules,
+    const QueryFunction& query)
+{
+  // Each query point samples from its own random stream, so the results only
+  // depend on the state of the random generator, not on the number of threads.
+  const size_t seed = math::RandGen()();
+
+  #ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  if (numThreads > 1 && numQueries > 1)
+  {
+    // Each thread other than the first gets its own copy of the rules, so no
+    // candidate lists or random number generators are shared between threads.
+    std::vector<RuleType> threadRules(numThreads - 1, rules);
+    std::vector<size_t> owners(numQueries);
+
+    #pragma omp parallel for schedule(dynamic, 16) num_threads(numThreads)
+    for (omp_size_t i = 0; i < (omp_size_t) numQueries; ++i)
+    {
+      const size_t thread = omp_get_thread_num();
+      RuleType& threadRule = (thread == 0) ? rules : threadRules[thread - 1];
+      threadRule.Generator().seed(seed + i);
+      query(threadRule, i);
+      owners[i] = thread;
+    }
+
+    // Collect the results of each query point in the given rules object.
+    for (size_t i = 0; i < numQueries; ++i)
+      if (owners[i] != 0)
+        rules.MergeResults(threadRules[owners[i] - 1], i);
+
+    for (size_t t = 0; t < threadRules.size(); ++t)
+      rules.NumDistComputations() += threadRules[t].NumDistComputations();
+
+    return;
+  }
+  #endif
+
+  for (size_t i = 0; i < numQueries; ++i)
+  {
+    rules.Generator().seed(seed + i);
+    query(rules, i);
+  }
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+template<typename RuleType>
+void RASearch<SortPolicy, MetricType, MatType, TreeType>::DualTreeTraverse(
+    Tree& queryTree,
+    RuleType& rules)
+{
+  if (parallelDepth > 0)
+  {
+    std::vector<Tree*> tasks;
+    tree::CollectTaskNodes(queryTree, parallelDepth, tasks);
+
+    if (tasks.size() > 1)
+    {
+      // Each task samples from its own random stream, so the results do not
+      // depend on the number of threads.
+      const size_t seed = math::RandGen()();
+
+      #ifdef HAS_OPENMP
+      const size_t numThreads = omp_get_max_threads();
+      if (numThreads > 1)
+      {
+        // Each thread other than the first gets its own copy of the rules.
+        // The statistics of each query subtree are only touched by the thread
+        // that traverses it.
+        std::vector<RuleType> threadRules(numThreads - 1, rules);
+        std::vector<size_t> owners(tasks.size());
+
+        #pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+        for (omp_size_t i = 0; i < (omp_size_t) tasks.size(); ++i)
+        {
+          const size_t thread = omp_get_thread_num();
+          RuleType& threadRule = (thread == 0) ? rules :
+              threadRules[thread - 1];
+          threadRule.Generator().seed(seed + i);
+
+          typename Tree::template DualTreeTraverser<RuleType>
+              traverser(threadRule);
+          traverser.Traverse(*tasks[i], *referenceTree);
+          owners[i] = thread;
+        }
+
+        // Merge the results of each task back into the given rules object.
+        tree::MergeTaskResults(rules, threadRules, tasks, owners,
+            [](RuleType& to, RuleType& from, const size_t point)
+            { to.MergeResults(from, point); });
+
+        for (size_t t = 0; t < threadRules.size(); ++t)
+          rules.NumDistComputations() += threadRules[t].NumDistComputations();
+
+        return;
+      }
+      #endif
+
+      for (size_t i = 0; i < tasks.size(); ++i)
+      {
+        rules.Generator().seed(seed + i);
+        typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+        traverser.Traverse(*tasks[i], *referenceTree);
+      }
+
+      return;
+    }
+  }
+
+  typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+  traverser.Traverse(queryTree, *referenceTree);
+}
+
 template<typename SortPolicy,
          typename MetricType,
          typename MatType,
@@ -75,6 +75,26 @@ class RASearchRules
    */
   void GetResults(arma::Mat<size_t>& neighbors, arma::mat& distances);
 
+  /**
+   * Sample enough reference points directly from the whole reference set for
+   * the given query point, as is done for each query point at construction
+   * time in naive mode.
+   *
+   * @param queryIndex Index of the query point.
+   */
+  void SampleNaively(const size_t queryIndex);
+
+  /**
+   * Merge the candidates found for the given query point by another set of
+   * rules (for instance, the copy used by another thread) into the candidates
+   * of these rules, along with the number of samples made for it.  The
+   * candidates of the other rules for that point are emptied.
+   *
+   * @param other Rules to merge the results of.
+   * @param queryIndex Index of the query point.
+   */
+  void MergeResults(RASearchRules& other, const size_t queryIndex);
+
   /**
    * Get the distance from the query point to the reference point.
    * This will update the list of candidates with the new point if appropriate.
@@ -227,7 +247,11 @@ class RASearchRules
                  const double oldScore);
 
 
-  size_t NumDistComputations() { return numDistComputations; }
+  //! Get the number of distance calculations performed.
+  size_t NumDistComputations() const { return numDistComputations; }
+  //! Modify the number of distance calculations performed.
+  size_t& NumDistComputations() { return numDistComputations; }
+
   size_t NumEffectiveSamples()
   {
     if (numSamplesMade.n_elem == 0)
@@ -241,6 +265,12 @@ class RASearchRules
   const TraversalInfoType& TraversalInfo() const { return traversalInfo; }
   TraversalInfoType& TraversalInfo() { return traversalInfo; }
 
+  //! Get the random number generator used for sampling.
+  const std::mt19937& Generator() const { return generator; }
+  //! Modify the random number generator used for sampling.  Each copy of the
+  //! rules has its own generator, so copies can sample on different threads.
+  std::mt19937& Generator() { return generator; }
+
   //! Get the minimum number of base cases that must be performed for each query
   //! point for an acceptable result.  This is only needed in defeatist search
   //! mode.
@@ -303,6 +333,9 @@ class RASearchRules
 
   TraversalInfoType traversalInfo;
 
+  //! The random number generator used for sampling.
+  std::mt19937 generator;
+
   /**
    * Helper function to insert a point into the list of candidate points.
    *
@@ -38,7 +38,8 @@ RASearchRules(const arma::mat& referenceSet,
     sampleAtLeaves(sampleAtLeaves),
     firstLeafExact(firstLeafExact),
     singleSampleLimit(singleSampleLimit),
-    sameSet(sameSet)
+    sameSet(sameSet),
+    generator(math::RandGen()())
 {
   // Validate tau to make sure that the rank approximation is greater than the
   // number of neighbors requested.
@@ -86,15 +87,36 @@ RASearchRules(const arma::mat& referenceSet,
 
   if (naive) // No tree traversal; just do naive sampling here.
   {
-    // Sample enough points.
-    arma::uvec distinctSamples;
     for (size_t i = 0; i < querySet.n_cols; ++i)
-    {
-      math::ObtainDistinctSamples(0, n, numSamplesReqd, distinctSamples);
-      for (size_t j = 0; j < distinctSamples.n_elem; ++j)
-        BaseCase(i, (size_t) distinctSamples[j]);
-    }
+      SampleNaively(i);
+  }
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+void RASearchRules<SortPolicy, MetricType, TreeType>::SampleNaively(
+    const size_t queryIndex)
+{
+  // Sample enough points.
+  arma::uvec distinctSamples;
+  math::ObtainDistinctSamples(0, referenceSet.n_cols, numSamplesReqd,
+      distinctSamples, generator);
+  for (size_t j = 0; j < distinctSamples.n_elem; ++j)
+    BaseCase(queryIndex, (size_t) distinctSamples[j]);
+}
+
+template<typename SortPolicy, typename MetricType, typename TreeType>
+void RASearchRules<SortPolicy, MetricType, TreeType>::MergeResults(
+    RASearchRules& other,
+    const size_t queryIndex)
+{
+  CandidateList& pqueue = other.candidates[queryIndex];
+  while (!pqueue.empty())
+  {
+    InsertNeighbor(queryIndex, pqueue.top().second, pqueue.top().first);
+    pqueue.pop();
   }
+
+  numSamplesMade[queryIndex] += other.numSamplesMade[queryIndex];
 }
 
 template<typename SortPolicy, typename MetricType, typename TreeType>
@@ -205,7 +227,7 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
           // Hence, approximate the node by sampling enough number of points.
           arma::uvec distinctSamples;
           math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-              samplesReqd, distinctSamples);
+              samplesReqd, distinctSamples, generator);
           for (size_t i = 0; i < distinctSamples.n_elem; ++i)
             // The counting of the samples are done in the 'BaseCase' function
             // so no book-keeping is required here.
@@ -221,7 +243,7 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
             // Approximate node by sampling enough number of points.
             arma::uvec distinctSamples;
             math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-                samplesReqd, distinctSamples);
+                samplesReqd, distinctSamples, generator);
             for (size_t i = 0; i < distinctSamples.n_elem; ++i)
               // The counting of the samples are done in the 'BaseCase' function
               // so no book-keeping is required here.
@@ -309,7 +331,7 @@ Rescore(const size_t queryIndex,
         // by sampling enough number of points.
         arma::uvec distinctSamples;
         math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-            samplesReqd, distinctSamples);
+            samplesReqd, distinctSamples, generator);
         for (size_t i = 0; i < distinctSamples.n_elem; ++i)
           // The counting of the samples are done in the 'BaseCase' function so
           // no book-keeping is required here.
@@ -325,7 +347,7 @@ Rescore(const size_t queryIndex,
           // Approximate node by sampling enough points.
           arma::uvec distinctSamples;
           math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-              samplesReqd, distinctSamples);
+              samplesReqd, distinctSamples, generator);
           for (size_t i = 0; i < distinctSamples.n_elem; ++i)
             // The counting of the samples are done in the 'BaseCase' function
             // so no book-keeping is required here.
@@ -512,7 +534,7 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
           {
             const size_t queryIndex = queryNode.Descendant(i);
             math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-                samplesReqd, distinctSamples);
+                samplesReqd, distinctSamples, generator);
             for (size_t j = 0; j < distinctSamples.n_elem; ++j)
               // The counting of the samples are done in the 'BaseCase' function
               // so no book-keeping is required here.
@@ -542,7 +564,7 @@ inline double RASearchRules<SortPolicy, MetricType, TreeType>::Score(
             {
               const size_t queryIndex = queryNode.Descendant(i);
               math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-                  samplesReqd, distinctSamples);
+                  samplesReqd, distinctSamples, generator);
               for (size_t j = 0; j < distinctSamples.n_elem; ++j)
                 // The counting of the samples are done in the 'BaseCase'
                 // function so no book-keeping is required here.
@@ -717,7 +739,7 @@ Rescore(TreeType& queryNode,
         {
           const size_t queryIndex = queryNode.Descendant(i);
           math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-              samplesReqd, distinctSamples);
+              samplesReqd, distinctSamples, generator);
           for (size_t j = 0; j < distinctSamples.n_elem; ++j)
             // The counting of the samples are done in the 'BaseCase'
             // function so no book-keeping is required here.
@@ -746,7 +768,7 @@ Rescore(TreeType& queryNode,
           {
             const size_t queryIndex = queryNode.Descendant(i);
             math::ObtainDistinctSamples(0, referenceNode.NumDescendants(),
-                samplesReqd, distinctSamples);
+                samplesReqd, distinctSamples, generator);
             for (size_t j = 0; j < distinctSamples.n_elem; ++j)
               // The counting of the samples are done in BaseCase() so no
               // book-keeping is required here.
@@ -18,6 +18,7 @@
 #include "worker/one_step_q_learning_worker.hpp"
 #include "worker/one_step_sarsa_worker.hpp"
 #include "worker/n_step_q_learning_worker.hpp"
+#include "worker/parameter_stripes.hpp"
 #include "training_config.hpp"
 
 namespace mlpack {
@@ -73,7 +74,14 @@ class AsyncLearning
                 EnvironmentType environment = EnvironmentType());
 
   /**
-   * Starting async training.
+   * Starting async training.  Each thread runs a fixed set of workers for the
+   * whole of the training.  Every worker accumulates the gradients of
+   * config.UpdateInterval() steps (the gradient accumulation horizon) before
+   * adding the resulting update to the shared network; the parameters of the
+   * shared network are split into stripes that are each guarded by their own
+   * lock, so workers only wait for each other when they write the same stripe
+   * at the same time.  Since the workers run asynchronously, the results of
+   * training are not reproducible when more than one thread is used.
    *
    * @tparam Measure The type of the measurement. It should be a
    *   callable object like
@@ -113,6 +121,28 @@ class AsyncLearning
   //! Modify the environment.
   const EnvironmentType& Environment() const { return environment; }
 
+  //! Get the number of steps taken by each worker during the last call to
+  //! Train().  Worker 0 is the deterministic evaluation worker.
+  const arma::Col<size_t>& WorkerSteps() const { return workerSteps; }
+  //! Get the time (in seconds) each worker spent taking steps during the last
+  //! call to Train().
+  const arma::vec& WorkerSeconds() const { return workerSeconds; }
+
+  /**
+   * Get the throughput of each worker during the last call to Train(), in
+   * steps per second.  Workers that took no time have a throughput of 0.
+   */
+  arma::vec WorkerStepsPerSecond() const
+  {
+    arma::vec stepsPerSecond(workerSteps.n_elem, arma::fill::zeros);
+    for (size_t i = 0; i < workerSteps.n_elem; ++i)
+    {
+      if (workerSeconds[i] > 0.0)
+        stepsPerSecond[i] = workerSteps[i] / workerSeconds[i];
+    }
+    return stepsPerSecond;
+  }
+
  private:
   //! Locally-stored hyper-parameters.
   TrainingConfig config;
@@ -128,6 +158,12 @@ class AsyncLearning
 
   //! Locally-stored task.
   EnvironmentType environment;
+
+  //! The number of steps taken by each worker during the last training.
+  arma::Col<size_t> workerSteps;
+
+  //! The time spent by each worker during the last training.
+  arma::vec workerSeconds;
 };
 
 /**
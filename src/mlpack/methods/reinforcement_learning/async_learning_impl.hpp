@@ -14,7 +14,8 @@
 #define MLPACK_METHODS_RL_ASYNC_LEARNING_IMPL_HPP
 
 #include <mlpack/prereqs.hpp>
-#include "queue"
+#include <atomic>
+#include <chrono>
 
 namespace mlpack {
 namespace rl {
@@ -71,7 +72,6 @@ void AsyncLearning<
   NetworkType targetNetwork = learningNetwork;
   size_t totalSteps = 0;
   PolicyType policy = this->policy;
-  bool stop = false;
 
   // Set up worker pool, worker 0 will be deterministic for evaluation.
   std::vector<WorkerType> workers;
@@ -80,10 +80,6 @@ void AsyncLearning<
     workers.push_back(WorkerType(updater, environment, config, !i));
     workers.back().Initialize(learningNetwork);
   }
-  // Set up task queue corresponding to worker pool.
-  std::queue<size_t> tasks;
-  for (size_t i = 0; i <= config.NumWorkers(); ++i)
-    tasks.push(i);
 
   /**
    * Compute the number of threads for the for-loop. In general, we should use
@@ -95,9 +91,20 @@ void AsyncLearning<
   numThreads++;
   Log::Debug << numThreads << " threads will be used in total." << std::endl;
 
-  #pragma omp parallel for shared(stop, workers, tasks, learningNetwork, \
-      targetNetwork, totalSteps, policy)
-  for (omp_size_t i = 0; i < numThreads; ++i)
+  // The parameters of the shared networks are guarded by a few locks per
+  // thread, so that workers rarely wait for each other.
+  ParameterStripes stripes(4 * numThreads);
+  std::atomic<bool> stop(false);
+  const size_t numWorkers = workers.size();
+  arma::Col<size_t> workerSteps(numWorkers, arma::fill::zeros);
+  arma::vec workerSeconds(numWorkers, arma::fill::zeros);
+
+  // Each thread persistently runs the workers t, t + numThreads, ... in turn
+  // until training stops, so no worker is ever moved between threads.
+  #pragma omp parallel for schedule(static, 1) shared(stop, workers, \
+      learningNetwork, targetNetwork, totalSteps, policy, stripes, \
+      workerSteps, workerSeconds)
+  for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
   {
     #pragma omp critical
     {
@@ -106,39 +113,35 @@ void AsyncLearning<
             " started." << std::endl;
       #endif
     }
-    size_t task = std::numeric_limits<size_t>::max();
+
+    // This may happen when threads are more than workers.
+    if ((size_t) t >= numWorkers)
+      continue;
+
     while (!stop)
     {
-      // Assign task to current thread from queue.
-      #pragma omp critical
+      for (size_t task = t; task < numWorkers && !stop; task += numThreads)
       {
-        if (task != std::numeric_limits<size_t>::max())
-          tasks.push(task);
+        WorkerType& worker = workers[task];
+        double episodeReturn;
+        const std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+        const bool finished = worker.Step(learningNetwork, targetNetwork,
+            totalSteps, policy, episodeReturn, stripes);
+        workerSeconds[task] += std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        ++workerSteps[task];
 
-        if (!tasks.empty())
-        {
-          task = tasks.front();
-          tasks.pop();
-        }
-      };
-
-      // This may happen when threads are more than workers.
-      if (task == std::numeric_limits<size_t>::max())
-        continue;
-
-      // Get corresponding worker.
-      WorkerType& worker = workers[task];
-      double episodeReturn;
-      if (worker.Step(learningNetwork, targetNetwork, totalSteps,
-          policy, episodeReturn) && !task)
-      {
-        stop = measure(episodeReturn);
+        if (finished && !task)
+          stop = measure(episodeReturn);
       }
     }
   }
 
-  // Write back the learning network.
+  // Write back the learning network and the throughput of the workers.
   this->learningNetwork = std::move(learningNetwork);
+  this->workerSteps = std::move(workerSteps);
+  this->workerSeconds = std::move(workerSeconds);
 };
 
 } // namespace rl
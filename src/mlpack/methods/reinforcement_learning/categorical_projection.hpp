@@ -0,0 +1,102 @@
+/**
+ * @file methods/reinforcement_learning/categorical_projection.hpp
+ *
+ * The projection of the distributional Bellman target onto the fixed support
+ * of a categorical (C51) value distribution.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_CATEGORICAL_PROJECTION_HPP
+#define MLPACK_METHODS_RL_CATEGORICAL_PROJECTION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace rl {
+
+/**
+ * Project the distributions of the next states, shifted by the rewards and
+ * shrunk by the discount, back onto the support of atomSize evenly spaced
+ * atoms between vMin and vMax.  The mass of each atom is split between the two
+ * atoms of the support around its target position, in proportion to how close
+ * it is to each of them.
+ *
+ * The target positions (in units of atoms) of the whole batch are computed at
+ * once; the mass is then scattered one column at a time.  The output matrices
+ * are only resized when the size of the batch changes, so that they can be
+ * kept between training steps.
+ *
+ * @param nextDist Distributions of the next states (one column per sample).
+ * @param rewards Rewards of the samples.
+ * @param isTerminal Whether the samples ended an episode.
+ * @param discount Discount factor.
+ * @param vMin Smallest value of the support.
+ * @param vMax Largest value of the support.
+ * @param positions Matrix to store the target positions of the atoms in.
+ * @param projDist Matrix to store the projected distributions in.
+ */
+inline void CategoricalProjection(const arma::mat& nextDist,
+                                  const arma::rowvec& rewards,
+                                  const arma::irowvec& isTerminal,
+                                  const double discount,
+                                  const double vMin,
+                                  const double vMax,
+                                  arma::mat& positions,
+                                  arma::mat& projDist)
+{
+  const size_t atomSize = nextDist.n_rows;
+  const size_t batchSize = nextDist.n_cols;
+  if (atomSize < 2)
+  {
+    throw std::invalid_argument("CategoricalProjection(): the support needs at "
+        "least two atoms!");
+  }
+
+  if (rewards.n_elem != batchSize || isTerminal.n_elem != batchSize)
+  {
+    std::ostringstream oss;
+    oss << "CategoricalProjection(): number of rewards (" << rewards.n_elem
+        << ") or terminal indicators (" << isTerminal.n_elem << ") does not "
+        << "match number of distributions (" << batchSize << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // The target value of atom j of sample i is r_i + g_i z_j, with
+  // g_i = gamma (1 - t_i) and z_j = vMin + j dz; as a position on the support
+  // that is (r_i + (g_i - 1) vMin) / dz + g_i j, clamped to [0, atomSize - 1].
+  const double deltaZ = (vMax - vMin) / (atomSize - 1);
+  const arma::rowvec scales = discount * (1.0 -
+      arma::conv_to<arma::rowvec>::from(isTerminal));
+  const arma::rowvec offsets = (rewards + (scales - 1.0) * vMin) / deltaZ;
+  const arma::colvec atoms = arma::linspace<arma::colvec>(0, atomSize - 1,
+      atomSize);
+
+  positions = atoms * scales;
+  positions.each_row() += offsets;
+  positions.clamp(0.0, atomSize - 1.0);
+
+  projDist.zeros(atomSize, batchSize);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    const double* position = positions.colptr(i);
+    const double* mass = nextDist.colptr(i);
+    double* proj = projDist.colptr(i);
+    for (size_t j = 0; j < atomSize; ++j)
+    {
+      // A position on the last atom (or exactly on any atom) keeps all of its
+      // mass there.
+      const size_t lower = std::min((size_t) position[j], atomSize - 2);
+      const double upperWeight = position[j] - lower;
+      proj[lower] += mass[j] * (1.0 - upperWeight);
+      proj[lower + 1] += mass[j] * upperWeight;
+    }
+  }
+}
+
+} // namespace rl
+} // namespace mlpack
+
+#endif
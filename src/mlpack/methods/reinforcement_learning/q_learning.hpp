@@ -18,6 +18,7 @@
 #include "replay/random_replay.hpp"
 #include "replay/prioritized_replay.hpp"
 #include "training_config.hpp"
+#include "categorical_projection.hpp"
 
 namespace mlpack {
 namespace rl {
@@ -104,12 +105,40 @@ class QLearning
    */
   void SelectAction();
 
+  /**
+   * Select an action for each of the given states, with one batched forward
+   * pass of the learning network.
+   *
+   * @param states States to select actions for.
+   * @param actions Selected actions, one for each state.
+   */
+  void SelectActions(const std::vector<StateType>& states,
+                     std::vector<ActionType>& actions);
+
   /**
    * Execute an episode.
    * @return Return of the episode.
    */
   double Episode();
 
+  /**
+   * Execute episodes with several copies of the environment that are stepped
+   * in lockstep, until the given number of episodes has finished.  At each
+   * step, the actions of all copies are selected with one batched forward pass
+   * (see SelectActions()), and the transitions of all copies are stored in the
+   * replay at once; a copy whose episode has finished starts a new one.  The
+   * agent is trained once per transition, as in Episode(), so the number of
+   * updates per stored transition does not depend on the number of copies.
+   * Episodes that are still running when the last episode finishes are
+   * dropped.
+   *
+   * @param numEnvironments Number of copies of the environment to step.
+   * @param numEpisodes Number of episodes to finish.
+   * @return Return of each finished episode, in the order they finished.
+   */
+  std::vector<double> VectorizedEpisodes(const size_t numEnvironments,
+                                         const size_t numEpisodes);
+
   //! Modify total steps from beginning.
   size_t& TotalSteps() { return totalSteps; }
   //! Get total steps from beginning.
@@ -181,6 +210,39 @@ class QLearning
 
   //! Locally-stored flag indicating training mode or test mode.
   bool deterministic;
+
+  //! Locally-stored encoded states of the last sampled batch.
+  arma::mat sampledStates;
+
+  //! Locally-stored actions of the last sampled batch.
+  std::vector<ActionType> sampledActions;
+
+  //! Locally-stored rewards of the last sampled batch.
+  arma::rowvec sampledRewards;
+
+  //! Locally-stored encoded next states of the last sampled batch.
+  arma::mat sampledNextStates;
+
+  //! Locally-stored terminal indicators of the last sampled batch.
+  arma::irowvec isTerminal;
+
+  //! Locally-stored distributions of all actions at the next states.
+  arma::mat nextDists;
+
+  //! Locally-stored distributions of the best actions at the next states.
+  arma::mat nextDist;
+
+  //! Locally-stored target positions of the atoms, for the projection.
+  arma::mat positions;
+
+  //! Locally-stored projected target distributions.
+  arma::mat projDist;
+
+  //! Locally-stored distributions of all actions at the sampled states.
+  arma::mat dists;
+
+  //! Locally-stored gradients of the loss with respect to the distributions.
+  arma::mat lossGradients;
 };
 
 } // namespace rl
@@ -134,13 +134,9 @@ void QLearning<
 {
   // Start experience replay.
 
-  // Sample from previous experience.
-  arma::mat sampledStates;
-  std::vector<ActionType> sampledActions;
-  arma::rowvec sampledRewards;
-  arma::mat sampledNextStates;
-  arma::irowvec isTerminal;
-
+  // Sample from previous experience.  The batch objects are kept between
+  // steps, so their memory is reused.
+  sampledActions.clear();
   replayMethod.Sample(sampledStates, sampledActions, sampledRewards,
       sampledNextStates, isTerminal);
 
@@ -221,19 +217,13 @@ void QLearning<
 {
   // Start experience replay.
 
-  // Sample from previous experience.
-  arma::mat sampledStates;
-  std::vector<ActionType> sampledActions;
-  arma::rowvec sampledRewards;
-  arma::mat sampledNextStates;
-  arma::irowvec isTerminal;
-
+  // Sample from previous experience.  The batch objects are kept between
+  // steps, so their memory is reused.
+  sampledActions.clear();
   replayMethod.Sample(sampledStates, sampledActions, sampledRewards,
       sampledNextStates, isTerminal);
 
   size_t atomSize = config.AtomSize();
-  arma::colvec support = arma::linspace<arma::colvec>(config.VMin(),
-      config.VMax(), atomSize);
 
   size_t batchSize = sampledNextStates.n_cols;
 
@@ -254,7 +244,7 @@ void QLearning<
     nextAction = BestAction(nextActionValues);
   }
 
-  arma::mat nextDists, nextDist(atomSize, batchSize);
+  nextDist.set_size(atomSize, batchSize);
   targetNetwork.Forward(sampledNextStates, nextDists);
   for (size_t i = 0; i < batchSize; ++i)
   {
@@ -262,29 +252,11 @@ void QLearning<
         arma::size(atomSize, 1));
   }
 
-  arma::mat tZ = (arma::conv_to<arma::mat>::from(config.Discount() *
-      (support * (1 - isTerminal))).each_row() + sampledRewards);
-  tZ = arma::clamp(tZ, config.VMin(), config.VMax());
-  arma::mat b = (tZ - config.VMin()) / (config.VMax() - config.VMin()) *
-      (atomSize - 1);
-  arma::mat l = arma::floor(b);
-  arma::mat u = arma::ceil(b);
+  CategoricalProjection(nextDist, sampledRewards, isTerminal,
+      config.Discount(), config.VMin(), config.VMax(), positions, projDist);
 
-  arma::mat projDistUpper = nextDist % (u - b);
-  arma::mat projDistLower = nextDist % (b - l);
-
-  arma::mat projDist = arma::zeros<arma::mat>(arma::size(nextDist));
-  for (size_t batchNo = 0; batchNo < batchSize; batchNo++)
-  {
-    for (size_t j = 0; j < atomSize; j++)
-    {
-      projDist(l(j, batchNo), batchNo) += projDistUpper(j, batchNo);
-      projDist(u(j, batchNo), batchNo) += projDistLower(j, batchNo);
-    }
-  }
-  arma::mat dists;
   learningNetwork.Forward(sampledStates, dists);
-  arma::mat lossGradients = arma::zeros<arma::mat>(arma::size(dists));
+  lossGradients.zeros(arma::size(dists));
   for (size_t i = 0; i < batchSize; ++i)
   {
     lossGradients(sampledActions[i].action * atomSize, i,
@@ -338,6 +310,42 @@ void QLearning<
   action = policy.Sample(actionValue, deterministic, config.NoisyQLearning());
 }
 
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+void QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::SelectActions(const std::vector<StateType>& states,
+                 std::vector<ActionType>& actions)
+{
+  actions.resize(states.size());
+  if (states.empty())
+    return;
+
+  // Get the action values of all states with one forward pass.
+  arma::mat encodedStates(states[0].Encode().n_elem, states.size());
+  for (size_t i = 0; i < states.size(); ++i)
+    encodedStates.col(i) = states[i].Encode();
+
+  arma::mat actionValues;
+  learningNetwork.Predict(encodedStates, actionValues);
+
+  // Select an action for each state according to the behavior policy.
+  for (size_t i = 0; i < states.size(); ++i)
+  {
+    actions[i] = policy.Sample(actionValues.col(i), deterministic,
+        config.NoisyQLearning());
+  }
+}
+
 template <
   typename EnvironmentType,
   typename NetworkType,
@@ -387,6 +395,96 @@ double QLearning<
   return totalReturn;
 }
 
+template <
+  typename EnvironmentType,
+  typename NetworkType,
+  typename UpdaterType,
+  typename BehaviorPolicyType,
+  typename ReplayType
+>
+std::vector<double> QLearning<
+  EnvironmentType,
+  NetworkType,
+  UpdaterType,
+  BehaviorPolicyType,
+  ReplayType
+>::VectorizedEpisodes(const size_t numEnvironments,
+                      const size_t numEpisodes)
+{
+  if (numEnvironments == 0)
+  {
+    throw std::invalid_argument("QLearning::VectorizedEpisodes(): the number "
+        "of environments must be positive!");
+  }
+
+  // Each copy keeps its own episode state (like the number of steps taken).
+  std::vector<EnvironmentType> environments(numEnvironments, environment);
+  std::vector<StateType> states(numEnvironments);
+  std::vector<StateType> nextStates(numEnvironments);
+  std::vector<ActionType> actions;
+  arma::rowvec rewards(numEnvironments);
+  arma::irowvec isEnd(numEnvironments);
+  arma::vec returns(numEnvironments, arma::fill::zeros);
+
+  for (size_t i = 0; i < numEnvironments; ++i)
+    states[i] = environments[i].InitialSample();
+
+  std::vector<double> finishedReturns;
+  while (finishedReturns.size() < numEpisodes)
+  {
+    SelectActions(states, actions);
+
+    // Interact with each environment to advance to the next states.
+    for (size_t i = 0; i < numEnvironments; ++i)
+    {
+      rewards[i] = environments[i].Sample(states[i], actions[i],
+          nextStates[i]);
+      isEnd[i] = environments[i].IsTerminal(nextStates[i]);
+      returns[i] += rewards[i];
+    }
+
+    // Store the transitions for replay.
+    replayMethod.Store(states, actions, rewards, nextStates, isEnd,
+        config.Discount());
+
+    // Train once for each transition.
+    for (size_t i = 0; i < numEnvironments; ++i)
+    {
+      totalSteps++;
+      if (deterministic || totalSteps < config.ExplorationSteps())
+        continue;
+      if (config.IsCategorical())
+        TrainCategoricalAgent();
+      else
+        TrainAgent();
+    }
+
+    // Update the current states, and restart the finished episodes.
+    for (size_t i = 0; i < numEnvironments; ++i)
+    {
+      if (isEnd[i])
+      {
+        if (finishedReturns.size() < numEpisodes)
+          finishedReturns.push_back(returns[i]);
+
+        returns[i] = 0.0;
+        states[i] = environments[i].InitialSample();
+      }
+      else
+      {
+        states[i] = nextStates[i];
+      }
+    }
+  }
+
+  // Keep the accessors of the agent meaningful.
+  state = states[0];
+  if (!actions.empty())
+    action = actions[0];
+
+  return finishedReturns;
+}
+
 } // namespace rl
 } // namespace mlpack
 
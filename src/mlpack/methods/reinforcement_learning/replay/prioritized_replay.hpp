@@ -111,6 +111,8 @@ class PrioritizedReplay
 
   /**
    * Store the given experience and set the priorities for the given experience.
+   * Store() may be called from several threads at once (for instance by
+   * workers that share one replay), and concurrently with Sample().
    *
    * @param state Given state.
    * @param action Given action.
@@ -126,37 +128,42 @@ class PrioritizedReplay
              bool isEnd,
              const double& discount)
   {
-    nStepBuffer.push_back({state, action, reward, nextState, isEnd});
-
-    // Single step transition is not ready.
-    if (nStepBuffer.size() < nSteps)
-      return;
-
-    // To keep the queue size fixed to nSteps.
-    if (nStepBuffer.size() > nSteps)
-      nStepBuffer.pop_front();
-
-    // Before moving ahead, lets confirm if our fixed size buffer works.
-    assert(nStepBuffer.size() == nSteps);
-
-    // Make a n-step transition.
-    GetNStepInfo(reward, nextState, isEnd, discount);
-
-    state = nStepBuffer.front().state;
-    action = nStepBuffer.front().action;
-    states.col(position) = state.Encode();
-    actions[position] = action;
-    rewards(position) = reward;
-    nextStates.col(position) = nextState.Encode();
-    isTerminal(position) = isEnd;
-
-    idxSum.Set(position, maxPriority * alpha);
+    #pragma omp critical(mlpackReplayAccess)
+    StoreTransition(state, action, reward, nextState, isEnd, discount);
+  }
 
-    position++;
-    if (position == capacity)
+  /**
+   * Store one transition of each of several copies of the environment that
+   * are stepped in lockstep.  Each copy has its own n-step buffer, so the
+   * n-step transitions of different copies are never mixed.
+   *
+   * @param states The state of each copy.
+   * @param actions The action taken in each copy.
+   * @param rewards The reward of each copy.
+   * @param nextStates The next state of each copy.
+   * @param isEnd Whether the next state of each copy is a terminal state.
+   * @param discount The discount parameter.
+   */
+  void Store(const std::vector<StateType>& states,
+             const std::vector<ActionType>& actions,
+             const arma::rowvec& rewards,
+             const std::vector<StateType>& nextStates,
+             const arma::irowvec& isEnd,
+             const double& discount)
+  {
+    #pragma omp critical(mlpackReplayAccess)
     {
-      full = true;
-      position = 0;
+      if (environmentBuffers.size() < states.size())
+        environmentBuffers.resize(states.size());
+
+      for (size_t i = 0; i < states.size(); ++i)
+      {
+        // Use the n-step buffer of this copy for the transition.
+        std::swap(nStepBuffer, environmentBuffers[i]);
+        StoreTransition(states[i], actions[i], rewards[i], nextStates[i],
+            isEnd[i], discount);
+        std::swap(nStepBuffer, environmentBuffers[i]);
+      }
     }
   }
 
@@ -197,14 +204,23 @@ class PrioritizedReplay
    */
   arma::ucolvec SampleProportional()
   {
-    arma::ucolvec idxes(batchSize);
-    double totalSum = idxSum.Sum(0, (full ? capacity : position));
-    double sumPerRange = totalSum / batchSize;
+    // Only stored transitions have nonzero priorities, so the total of the
+    // tree is the sum over the stored transitions.
+    const double sumPerRange = idxSum.Total() / batchSize;
+
+    // Draw one mass from each of batchSize equal ranges, and search for all of
+    // them at once.
+    const arma::colvec masses = (arma::randu<arma::colvec>(batchSize) +
+        arma::linspace<arma::colvec>(0, batchSize - 1, batchSize)) *
+        sumPerRange;
+    arma::ucolvec idxes;
+    idxSum.FindPrefixSums(masses, idxes);
+
+    // Rounding could otherwise select an unused slot at the end.
+    const size_t upperBound = full ? capacity : position;
     for (size_t bt = 0; bt < batchSize; bt++)
-    {
-      const double mass = arma::randu() * sumPerRange + bt * sumPerRange;
-      idxes(bt) = idxSum.FindPrefixSum(mass);
-    }
+      idxes(bt) = std::min((size_t) idxes(bt), upperBound - 1);
+
     return idxes;
   }
 
@@ -224,27 +240,32 @@ class PrioritizedReplay
               arma::mat& sampledNextStates,
               arma::irowvec& isTerminal)
   {
-    sampledIndices = SampleProportional();
-    BetaAnneal();
-
-    sampledStates = states.cols(sampledIndices);
-    for (size_t t = 0; t < sampledIndices.n_rows; t ++)
-      sampledActions.push_back(actions[sampledIndices[t]]);
-    sampledRewards = rewards.elem(sampledIndices).t();
-    sampledNextStates = nextStates.cols(sampledIndices);
-    isTerminal = this->isTerminal.elem(sampledIndices).t();
-
-    // Calculate the weights of sampled transitions.
-
-    size_t numSample = full ? capacity : position;
-    weights = arma::rowvec(sampledIndices.n_rows);
-
-    for (size_t i = 0; i < sampledIndices.n_rows; ++i)
+    #pragma omp critical(mlpackReplayAccess)
     {
-      double p_sample = idxSum.Get(sampledIndices(i)) / idxSum.Sum();
-      weights(i) = pow(numSample * p_sample, -beta);
+      sampledIndices = SampleProportional();
+      BetaAnneal();
+
+      // Output objects that already have the right size are reused.
+      sampledStates = states.cols(sampledIndices);
+      sampledActions.resize(sampledIndices.n_rows);
+      for (size_t t = 0; t < sampledIndices.n_rows; t ++)
+        sampledActions[t] = actions[sampledIndices[t]];
+      sampledRewards = rewards.elem(sampledIndices).t();
+      sampledNextStates = nextStates.cols(sampledIndices);
+      isTerminal = this->isTerminal.elem(sampledIndices).t();
+
+      // Calculate the weights of sampled transitions.
+      size_t numSample = full ? capacity : position;
+      const double totalSum = idxSum.Total();
+      weights.set_size(sampledIndices.n_rows);
+
+      for (size_t i = 0; i < sampledIndices.n_rows; ++i)
+      {
+        double p_sample = idxSum.Get(sampledIndices(i)) / totalSum;
+        weights(i) = pow(numSample * p_sample, -beta);
+      }
+      weights /= weights.max();
     }
-    weights /= weights.max();
   }
 
   /**
@@ -256,8 +277,11 @@ class PrioritizedReplay
   void UpdatePriorities(arma::ucolvec& indices, arma::colvec& priorities)
   {
       arma::colvec alphaPri = alpha * priorities;
-      maxPriority = std::max(maxPriority, arma::max(priorities));
-      idxSum.BatchUpdate(indices, alphaPri);
+      #pragma omp critical(mlpackReplayAccess)
+      {
+        maxPriority = std::max(maxPriority, arma::max(priorities));
+        idxSum.BatchUpdate(indices, alphaPri);
+      }
   }
 
   /**
@@ -308,6 +332,51 @@ class PrioritizedReplay
   const size_t& NSteps() const { return nSteps; }
 
  private:
+  /**
+   * Store the given experience; see Store().  The caller must hold the replay
+   * access lock.
+   */
+  void StoreTransition(StateType state,
+                       ActionType action,
+                       double reward,
+                       StateType nextState,
+                       bool isEnd,
+                       const double& discount)
+  {
+    nStepBuffer.push_back({state, action, reward, nextState, isEnd});
+
+    // Single step transition is not ready.
+    if (nStepBuffer.size() < nSteps)
+      return;
+
+    // To keep the queue size fixed to nSteps.
+    if (nStepBuffer.size() > nSteps)
+      nStepBuffer.pop_front();
+
+    // Before moving ahead, lets confirm if our fixed size buffer works.
+    assert(nStepBuffer.size() == nSteps);
+
+    // Make a n-step transition.
+    GetNStepInfo(reward, nextState, isEnd, discount);
+
+    state = nStepBuffer.front().state;
+    action = nStepBuffer.front().action;
+    states.col(position) = state.Encode();
+    actions[position] = action;
+    rewards(position) = reward;
+    nextStates.col(position) = nextState.Encode();
+    isTerminal(position) = isEnd;
+
+    idxSum.Set(position, maxPriority * alpha);
+
+    position++;
+    if (position == capacity)
+    {
+      full = true;
+      position = 0;
+    }
+  }
+
   //! Locally-stored number of examples of each sample.
   size_t batchSize;
 
@@ -351,6 +420,10 @@ class PrioritizedReplay
   //! Locally-stored buffer containing n consecutive steps.
   std::deque<Transition> nStepBuffer;
 
+  //! Locally-stored n-step buffers of the copies of the environment given to
+  //! the vectorized Store().
+  std::vector<std::deque<Transition>> environmentBuffers;
+
   //! Locally-stored encoded previous states.
   arma::mat states;
 
@@ -92,7 +92,9 @@ class RandomReplay
   { /* Nothing to do here. */ }
 
   /**
-   * Store the given experience.
+   * Store the given experience.  Store() may be called from several threads
+   * at once (for instance by workers that share one replay), and concurrently
+   * with Sample().
    *
    * @param state Given state.
    * @param action Given action.
@@ -108,35 +110,42 @@ class RandomReplay
              bool isEnd,
              const double& discount)
   {
-    nStepBuffer.push_back({state, action, reward, nextState, isEnd});
-
-    // Single step transition is not ready.
-    if (nStepBuffer.size() < nSteps)
-      return;
-
-    // To keep the queue size fixed to nSteps.
-    if (nStepBuffer.size() > nSteps)
-      nStepBuffer.pop_front();
-
-    // Before moving ahead, lets confirm if our fixed size buffer works.
-    assert(nStepBuffer.size() == nSteps);
-
-    // Make a n-step transition.
-    GetNStepInfo(reward, nextState, isEnd, discount);
-
-    state = nStepBuffer.front().state;
-    action = nStepBuffer.front().action;
+    #pragma omp critical(mlpackReplayAccess)
+    StoreTransition(state, action, reward, nextState, isEnd, discount);
+  }
 
-    states.col(position) = state.Encode();
-    actions[position] = action;
-    rewards(position) = reward;
-    nextStates.col(position) = nextState.Encode();
-    isTerminal(position) = isEnd;
-    position++;
-    if (position == capacity)
+  /**
+   * Store one transition of each of several copies of the environment that
+   * are stepped in lockstep.  Each copy has its own n-step buffer, so the
+   * n-step transitions of different copies are never mixed.
+   *
+   * @param states The state of each copy.
+   * @param actions The action taken in each copy.
+   * @param rewards The reward of each copy.
+   * @param nextStates The next state of each copy.
+   * @param isEnd Whether the next state of each copy is a terminal state.
+   * @param discount The discount parameter.
+   */
+  void Store(const std::vector<StateType>& states,
+             const std::vector<ActionType>& actions,
+             const arma::rowvec& rewards,
+             const std::vector<StateType>& nextStates,
+             const arma::irowvec& isEnd,
+             const double& discount)
+  {
+    #pragma omp critical(mlpackReplayAccess)
     {
-      full = true;
-      position = 0;
+      if (environmentBuffers.size() < states.size())
+        environmentBuffers.resize(states.size());
+
+      for (size_t i = 0; i < states.size(); ++i)
+      {
+        // Use the n-step buffer of this copy for the transition.
+        std::swap(nStepBuffer, environmentBuffers[i]);
+        StoreTransition(states[i], actions[i], rewards[i], nextStates[i],
+            isEnd[i], discount);
+        std::swap(nStepBuffer, environmentBuffers[i]);
+      }
     }
   }
 
@@ -186,16 +195,21 @@ class RandomReplay
               arma::mat& sampledNextStates,
               arma::irowvec& isTerminal)
   {
-    size_t upperBound = full ? capacity : position;
-    arma::uvec sampledIndices = arma::randi<arma::uvec>(
-        batchSize, arma::distr_param(0, upperBound - 1));
-
-    sampledStates = states.cols(sampledIndices);
-    for (size_t t = 0; t < sampledIndices.n_rows; t ++)
-      sampledActions.push_back(actions[sampledIndices[t]]);
-    sampledRewards = rewards.elem(sampledIndices).t();
-    sampledNextStates = nextStates.cols(sampledIndices);
-    isTerminal = this->isTerminal.elem(sampledIndices).t();
+    #pragma omp critical(mlpackReplayAccess)
+    {
+      size_t upperBound = full ? capacity : position;
+      arma::uvec sampledIndices = arma::randi<arma::uvec>(
+          batchSize, arma::distr_param(0, upperBound - 1));
+
+      // Output objects that already have the right size are reused.
+      sampledStates = states.cols(sampledIndices);
+      sampledActions.resize(sampledIndices.n_rows);
+      for (size_t t = 0; t < sampledIndices.n_rows; t ++)
+        sampledActions[t] = actions[sampledIndices[t]];
+      sampledRewards = rewards.elem(sampledIndices).t();
+      sampledNextStates = nextStates.cols(sampledIndices);
+      isTerminal = this->isTerminal.elem(sampledIndices).t();
+    }
   }
 
   /**
@@ -228,6 +242,49 @@ class RandomReplay
   const size_t& NSteps() const { return nSteps; }
 
  private:
+  /**
+   * Store the given experience; see Store().  The caller must hold the replay
+   * access lock.
+   */
+  void StoreTransition(StateType state,
+                       ActionType action,
+                       double reward,
+                       StateType nextState,
+                       bool isEnd,
+                       const double& discount)
+  {
+    nStepBuffer.push_back({state, action, reward, nextState, isEnd});
+
+    // Single step transition is not ready.
+    if (nStepBuffer.size() < nSteps)
+      return;
+
+    // To keep the queue size fixed to nSteps.
+    if (nStepBuffer.size() > nSteps)
+      nStepBuffer.pop_front();
+
+    // Before moving ahead, lets confirm if our fixed size buffer works.
+    assert(nStepBuffer.size() == nSteps);
+
+    // Make a n-step transition.
+    GetNStepInfo(reward, nextState, isEnd, discount);
+
+    state = nStepBuffer.front().state;
+    action = nStepBuffer.front().action;
+
+    states.col(position) = state.Encode();
+    actions[position] = action;
+    rewards(position) = reward;
+    nextStates.col(position) = nextState.Encode();
+    isTerminal(position) = isEnd;
+    position++;
+    if (position == capacity)
+    {
+      full = true;
+      position = 0;
+    }
+  }
+
   //! Locally-stored number of examples of each sample.
   size_t batchSize;
 
@@ -246,6 +303,10 @@ class RandomReplay
   //! Locally-stored buffer containing n consecutive steps.
   std::deque<Transition> nStepBuffer;
 
+  //! Locally-stored n-step buffers of the copies of the environment given to
+  //! the vectorized Store().
+  std::vector<std::deque<Transition>> environmentBuffers;
+
   //! Locally-stored encoded previous states.
   arma::mat states;
 
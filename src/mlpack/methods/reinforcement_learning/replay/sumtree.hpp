@@ -78,10 +78,19 @@ class SumTree
     {
       element[indices[i] + capacity] = data[i];
     }
-    // update the total tree with bottom-up technique.
-    for (size_t i = capacity - 1; i > 0; i--)
+
+    // Only the ancestors of the changed elements need to be updated, which
+    // takes O(log n) time per element instead of rebuilding the whole tree.
+    // The last update of each ancestor happens after all of its changed
+    // descendants have been updated, so its final value is correct.
+    for (size_t i = 0; i < indices.n_rows; ++i)
     {
-      element[i] = element[2 * i] + element[2 * i + 1];
+      size_t idx = (indices[i] + capacity) / 2;
+      while (idx >= 1)
+      {
+        element[idx] = element[2 * idx] + element[2 * idx + 1];
+        idx /= 2;
+      }
     }
   }
 
@@ -154,6 +163,15 @@ class SumTree
     return Sum(0, capacity);
   }
 
+  /**
+   * Get the sum of the whole array in constant time; this is the value stored
+   * at the root of the tree.
+   */
+  T Total() const
+  {
+    return (capacity == 0) ? T(0) : element[1];
+  }
+
   /**
    * Find the highest index `idx` in the array such that
    * sum(arr[0] + arr[1] + ... + arr[idx]) <= mass.
@@ -178,6 +196,39 @@ class SumTree
     return idx - capacity;
   }
 
+  /**
+   * Find, for each of the given masses, the highest index `idx` in the array
+   * such that sum(arr[0] + arr[1] + ... + arr[idx]) <= mass, as in
+   * FindPrefixSum().  All masses descend the tree together, one level at a
+   * time, which is faster than searching for each mass separately when many
+   * masses are given.  The capacity must be a power of two.
+   *
+   * @param masses The upper bounds of segment array sums.
+   * @param indices The found index for each mass.
+   */
+  void FindPrefixSums(const arma::Col<T>& masses, arma::ucolvec& indices)
+  {
+    arma::Col<T> remaining(masses);
+    indices.ones(masses.n_elem);
+    for (size_t width = 1; width < capacity; width *= 2)
+    {
+      for (size_t i = 0; i < indices.n_elem; ++i)
+      {
+        const size_t left = 2 * indices[i];
+        if (element[left] > remaining[i])
+        {
+          indices[i] = left;
+        }
+        else
+        {
+          remaining[i] -= element[left];
+          indices[i] = left + 1;
+        }
+      }
+    }
+    indices -= capacity;
+  }
+
  private:
   //! The capacity of the data array.
   size_t capacity;
@@ -19,6 +19,7 @@
 #include <mlpack/methods/ann/activation_functions/tanh_function.hpp>
 #include <mlpack/methods/ann/loss_functions/mean_squared_error.hpp>
 #include <mlpack/methods/ann/visitor/parameters_visitor.hpp>
+#include <mlpack/methods/ann/visitor/delta_visitor.hpp>
 #include "training_config.hpp"
 
 namespace mlpack {
@@ -140,8 +141,28 @@ class SAC
   //! Get the indicator of training mode / test mode.
   const bool& Deterministic() const { return deterministic; }
 
+  //! Get the learning Q2 network.
+  const QNetworkType& LearningQ2Network() const { return learningQ2Network; }
+  //! Modify the learning Q2 network.
+  QNetworkType& LearningQ2Network() { return learningQ2Network; }
+
 
  private:
+  /**
+   * Backpropagate lossGradients (the error of each point of the batch) through
+   * the given Q network, and add the resulting gradients with respect to the
+   * actions (the first actionSize rows of the input) to policyGradients.  The
+   * first layer of the Q network must be linear.
+   *
+   * @param qNetwork Q network to backpropagate through; Forward() must have
+   *     been called on the input.
+   * @param input Input of the Q network.
+   * @param actionSize Number of dimensions of the actions.
+   */
+  void ActionGradients(QNetworkType& qNetwork,
+                       const arma::mat& input,
+                       const size_t actionSize);
+
   //! Locally-stored hyper-parameters.
   TrainingConfig& config;
 
@@ -190,6 +211,42 @@ class SAC
 
   //! Locally-stored loss function.
   mlpack::ann::MeanSquaredError<> lossFunction;
+
+  //! Locally-stored encoded states of the last sampled batch.
+  arma::mat sampledStates;
+
+  //! Locally-stored actions of the last sampled batch.
+  std::vector<ActionType> sampledActions;
+
+  //! Locally-stored rewards of the last sampled batch.
+  arma::rowvec sampledRewards;
+
+  //! Locally-stored encoded next states of the last sampled batch.
+  arma::mat sampledNextStates;
+
+  //! Locally-stored terminal indicators of the last sampled batch.
+  arma::irowvec isTerminal;
+
+  //! Locally-stored actions of the policy at the next states.
+  arma::mat nextStateActions;
+
+  //! Locally-stored actions of the policy at the sampled states.
+  arma::mat pi;
+
+  //! Locally-stored input of the Q networks.
+  arma::mat qInput;
+
+  //! Locally-stored outputs of the Q1 and Q2 networks.
+  arma::rowvec q1, q2;
+
+  //! Locally-stored errors of the outputs of the last backward pass.
+  arma::mat lossGradients;
+
+  //! Locally-stored parameter gradients of the last backward pass.
+  arma::mat gradients;
+
+  //! Locally-stored gradients of the critics with respect to the actions.
+  arma::mat policyGradients;
 };
 
 } // namespace rl
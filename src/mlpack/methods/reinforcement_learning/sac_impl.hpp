@@ -136,10 +136,11 @@ void SAC<
   ReplayType
 >::SoftUpdate(double rho)
 {
-  targetQ1Network.Parameters() = (1 - rho) * targetQ1Network.Parameters() +
-      rho * learningQ1Network.Parameters();
-  targetQ2Network.Parameters() = (1 - rho) * targetQ2Network.Parameters() +
-      rho * learningQ2Network.Parameters();
+  // Average in place, so that no temporary parameter matrices are needed.
+  targetQ1Network.Parameters() *= (1 - rho);
+  targetQ1Network.Parameters() += rho * learningQ1Network.Parameters();
+  targetQ2Network.Parameters() *= (1 - rho);
+  targetQ2Network.Parameters() += rho * learningQ2Network.Parameters();
 }
 
 template <
@@ -157,118 +158,80 @@ void SAC<
   ReplayType
 >::Update()
 {
-  // Sample from previous experience.
-  arma::mat sampledStates;
-  std::vector<ActionType> sampledActions;
-  arma::rowvec sampledRewards;
-  arma::mat sampledNextStates;
-  arma::irowvec isTerminal;
-
+  // Sample from previous experience.  The batch objects are kept between
+  // updates, so their memory is reused.
+  sampledActions.clear();
   replayMethod.Sample(sampledStates, sampledActions, sampledRewards,
       sampledNextStates, isTerminal);
 
   // Critic network update.
 
   // Get the actions for sampled next states, from policy.
-  arma::mat nextStateActions;
   policyNetwork.Predict(sampledNextStates, nextStateActions);
 
-  arma::mat targetQInput = arma::join_vert(nextStateActions,
-      sampledNextStates);
-  arma::rowvec Q1, Q2;
-  targetQ1Network.Predict(targetQInput, Q1);
-  targetQ2Network.Predict(targetQInput, Q2);
-  arma::rowvec nextQ = sampledRewards + config.Discount() * ((1 - isTerminal)
-      % arma::min(Q1, Q2));
+  qInput = arma::join_vert(nextStateActions, sampledNextStates);
+  targetQ1Network.Predict(qInput, q1);
+  targetQ2Network.Predict(qInput, q2);
+  const arma::rowvec nextQ = sampledRewards + config.Discount() *
+      ((1 - isTerminal) % arma::min(q1, q2));
 
-  arma::mat sampledActionValues(action.size, sampledActions.size());
+  // Both critics are trained on the same input, which is built only once.
+  qInput.set_size(action.size + sampledStates.n_rows, sampledActions.size());
   for (size_t i = 0; i < sampledActions.size(); i++)
-    sampledActionValues.col(i) = arma::conv_to<arma::colvec>::from
-                                 (sampledActions[i].action);
-  arma::mat learningQInput = arma::join_vert(sampledActionValues,
-      sampledStates);
-  learningQ1Network.Forward(learningQInput, Q1);
-  learningQ2Network.Forward(learningQInput, Q2);
-
-  arma::mat gradQ1Loss, gradQ2Loss;
-  lossFunction.Backward(Q1, nextQ, gradQ1Loss);
-  lossFunction.Backward(Q2, nextQ, gradQ2Loss);
-
-  // Update the critic networks.
-  arma::mat gradientQ1, gradientQ2;
-  learningQ1Network.Backward(learningQInput, gradQ1Loss, gradientQ1);
+  {
+    for (size_t j = 0; j < action.size; ++j)
+      qInput(j, i) = sampledActions[i].action[j];
+  }
+  qInput.tail_rows(sampledStates.n_rows) = sampledStates;
+  learningQ1Network.Forward(qInput, q1);
+  learningQ2Network.Forward(qInput, q2);
+
+  lossFunction.Backward(q1, nextQ, lossGradients);
+  learningQ1Network.Backward(qInput, lossGradients, gradients);
   #if ENS_VERSION_MAJOR == 1
   qNetworkUpdater.Update(learningQ1Network.Parameters(), config.StepSize(),
-      gradientQ1);
+      gradients);
   #else
   qNetworkUpdatePolicy->Update(learningQ1Network.Parameters(),
-      config.StepSize(), gradientQ1);
+      config.StepSize(), gradients);
   #endif
-  learningQ2Network.Backward(learningQInput, gradQ2Loss, gradientQ2);
+  lossFunction.Backward(q2, nextQ, lossGradients);
+  learningQ2Network.Backward(qInput, lossGradients, gradients);
   #if ENS_VERSION_MAJOR == 1
   qNetworkUpdater.Update(learningQ2Network.Parameters(), config.StepSize(),
-      gradientQ2);
+      gradients);
   #else
   qNetworkUpdatePolicy->Update(learningQ2Network.Parameters(),
-      config.StepSize(), gradientQ2);
+      config.StepSize(), gradients);
   #endif
 
   // Actor network update.
 
-  arma::mat pi;
-  policyNetwork.Predict(sampledStates, pi);
-
-  arma::mat qInput = arma::join_vert(pi, sampledStates);
-  learningQ1Network.Predict(qInput, Q1);
-  learningQ2Network.Predict(qInput, Q2);
-
-  // Get the size of the first hidden layer in the Q network.
-  size_t hidden1 = boost::get<mlpack::ann::Linear<> *>
-      (learningQ1Network.Model()[0])->OutputSize();
-
-  arma::mat gradient;
-  for (size_t i = 0; i < sampledStates.n_cols; i++)
-  {
-    arma::mat grad, gradQ, q;
-    arma::colvec singleState = sampledStates.col(i);
-    arma::colvec singlePi;
-    policyNetwork.Forward(singleState, singlePi);
-    arma::colvec input = arma::join_vert(singlePi, singleState);
-    arma::mat weightLastLayer;
-
-    if (Q1(i) < Q2(i))
-    {
-      learningQ1Network.Forward(input, q);
-      learningQ1Network.Backward(input, -1, gradQ);
-      weightLastLayer = arma::reshape(learningQ1Network.Parameters().
-          rows(0, hidden1 * singlePi.n_rows - 1), hidden1, singlePi.n_rows);
-    }
-    else
-    {
-      learningQ2Network.Forward(input, q);
-      learningQ2Network.Backward(input, -1, gradQ);
-      weightLastLayer = arma::reshape(learningQ2Network.Parameters().
-          rows(0, hidden1 * singlePi.n_rows - 1), hidden1, singlePi.n_rows);
-    }
-
-    arma::colvec gradQBias = gradQ(input.n_rows * hidden1, 0,
-        arma::size(hidden1, 1));
-    arma::mat gradPolicy = weightLastLayer.t() * gradQBias;
-    policyNetwork.Backward(singleState, gradPolicy, grad);
-    if (i == 0)
-    {
-      gradient.copy_size(grad);
-      gradient.fill(0.0);
-    }
-    gradient += grad;
-  }
-  gradient /= sampledStates.n_cols;
+  // The whole batch goes through the policy and the critics at once.  The
+  // policy is trained towards the smaller of the two critics for each state,
+  // so each critic is given an error of -1 on the states where it is the
+  // smaller one and 0 elsewhere.
+  policyNetwork.Forward(sampledStates, pi);
+  qInput = arma::join_vert(pi, sampledStates);
+  learningQ1Network.Forward(qInput, q1);
+  learningQ2Network.Forward(qInput, q2);
+
+  const arma::rowvec q1Smaller = arma::conv_to<arma::rowvec>::from(q1 < q2);
+  policyGradients.zeros(pi.n_rows, pi.n_cols);
+  lossGradients = -q1Smaller;
+  ActionGradients(learningQ1Network, qInput, pi.n_rows);
+  lossGradients = q1Smaller - 1;
+  ActionGradients(learningQ2Network, qInput, pi.n_rows);
+
+  policyNetwork.Backward(sampledStates, policyGradients, gradients);
+  gradients /= sampledStates.n_cols;
 
   #if ENS_VERSION_MAJOR == 1
-  policyUpdater.Update(policyNetwork.Parameters(), config.StepSize(), gradient);
+  policyNetworkUpdater.Update(policyNetwork.Parameters(), config.StepSize(),
+      gradients);
   #else
   policyNetworkUpdatePolicy->Update(policyNetwork.Parameters(),
-      config.StepSize(), gradient);
+      config.StepSize(), gradients);
   #endif
 
   // Update target network
@@ -276,6 +239,36 @@ void SAC<
     SoftUpdate(config.Rho());
 }
 
+template <
+  typename EnvironmentType,
+  typename QNetworkType,
+  typename PolicyNetworkType,
+  typename UpdaterType,
+  typename ReplayType
+>
+void SAC<
+  EnvironmentType,
+  QNetworkType,
+  PolicyNetworkType,
+  UpdaterType,
+  ReplayType
+>::ActionGradients(QNetworkType& qNetwork,
+                   const arma::mat& input,
+                   const size_t actionSize)
+{
+  qNetwork.Backward(input, lossGradients, gradients);
+
+  // The delta of the second layer is the gradient with respect to the output
+  // of the first (linear) layer, for every point of the batch; the weights of
+  // the action inputs take it back to the actions.
+  const arma::mat& delta = boost::apply_visitor(ann::DeltaVisitor(),
+      qNetwork.Model()[1]);
+  const size_t hidden1 = delta.n_rows;
+  const arma::mat actionWeights(qNetwork.Parameters().memptr(), hidden1,
+      actionSize, false, true);
+  policyGradients += actionWeights.t() * delta;
+}
+
 template <
   typename EnvironmentType,
   typename QNetworkType,
@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_RL_WORKER_ONE_STEP_SARSA_WORKER_HPP
 
 #include <mlpack/methods/reinforcement_learning/training_config.hpp>
+#include "parameter_stripes.hpp"
 
 namespace mlpack {
 namespace rl {
@@ -243,13 +244,15 @@ class OneStepSarsaWorker
    * @param policy The shared behavior policy.
    * @param totalReward This will be the episode return if the episode ends
    *     after this step. Otherwise this is invalid.
+   * @param stripes The locks guarding the parameters of the shared networks.
    * @return Indicate whether current episode ends after this step.
    */
   bool Step(NetworkType& learningNetwork,
             NetworkType& targetNetwork,
             size_t& totalSteps,
             PolicyType& policy,
-            double& totalReward)
+            double& totalReward,
+            ParameterStripes& stripes)
   {
     // Interact with the environment.
     if (action.action == ActionType::size)
@@ -277,7 +280,7 @@ class OneStepSarsaWorker
         totalReward = episodeReturn;
         Reset();
         // Sync with latest learning network.
-        network = learningNetwork;
+        stripes.Copy(learningNetwork.Parameters(), network.Parameters());
         return true;
       }
       state = nextState;
@@ -332,17 +335,20 @@ class OneStepSarsaWorker
           { return std::min(std::max(gradient, -config.GradientLimit()),
           config.GradientLimit()); });
 
-      // Perform async update of the global network.
+      // Compute the step of the optimizer on a copy of the local parameters,
+      // which were synced with the global network at the last update.
+      arma::mat parameters = network.Parameters();
       #if ENS_VERSION_MAJOR == 1
-      updater.Update(learningNetwork.Parameters(), config.StepSize(),
-          totalGradients);
+      updater.Update(parameters, config.StepSize(), totalGradients);
       #else
-      updatePolicy->Update(learningNetwork.Parameters(),
-          config.StepSize(), totalGradients);
+      updatePolicy->Update(parameters, config.StepSize(), totalGradients);
       #endif
 
-      // Sync the local network with the global network.
-      network = learningNetwork;
+      // Perform async update of the global network, and sync the local
+      // network with it.  Only one stripe of the parameters is locked at a
+      // time, so other workers can update the rest meanwhile.
+      stripes.Apply(learningNetwork.Parameters(),
+          parameters - network.Parameters(), network.Parameters());
 
       pendingIndex = 0;
     }
@@ -351,9 +357,13 @@ class OneStepSarsaWorker
     if (totalSteps % config.TargetNetworkSyncInterval() == 0)
     {
       #pragma omp critical
-      { targetNetwork = learningNetwork; }
+      {
+        stripes.Copy(learningNetwork.Parameters(),
+            targetNetwork.Parameters());
+      }
     }
 
+    #pragma omp critical(asyncLearningPolicy)
     policy.Anneal();
 
     if (terminal)
@@ -0,0 +1,150 @@
+/**
+ * @file methods/reinforcement_learning/worker/parameter_stripes.hpp
+ *
+ * A set of locks that each guard one stripe of the parameters of the network
+ * shared by the asynchronous workers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_WORKER_PARAMETER_STRIPES_HPP
+#define MLPACK_METHODS_RL_WORKER_PARAMETER_STRIPES_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace rl {
+
+/**
+ * ParameterStripes splits the parameters of the shared network into a number
+ * of contiguous stripes, each guarded by its own lock.  A worker that applies
+ * an update only holds the lock of the stripe it is writing, so several
+ * workers can update different parts of the parameters at the same time, and
+ * no worker ever sees a half-written element.  When OpenMP is not available,
+ * locking does nothing.
+ */
+class ParameterStripes
+{
+ public:
+  /**
+   * Create the locks.
+   *
+   * @param numStripes Number of stripes to split the parameters into.
+   */
+  ParameterStripes(const size_t numStripes = 16) :
+      numStripes(std::max(numStripes, (size_t) 1))
+  {
+    #ifdef HAS_OPENMP
+    locks.resize(this->numStripes);
+    for (size_t i = 0; i < locks.size(); ++i)
+      omp_init_lock(&locks[i]);
+    #endif
+  }
+
+  // The locks can't be copied.
+  ParameterStripes(const ParameterStripes& other) = delete;
+  ParameterStripes& operator=(const ParameterStripes& other) = delete;
+
+  //! Destroy the locks.
+  ~ParameterStripes()
+  {
+    #ifdef HAS_OPENMP
+    for (size_t i = 0; i < locks.size(); ++i)
+      omp_destroy_lock(&locks[i]);
+    #endif
+  }
+
+  //! Get the number of stripes.
+  size_t NumStripes() const { return numStripes; }
+
+  /**
+   * Add the given update to the shared parameters, one stripe at a time, and
+   * copy the result into the local parameters.
+   *
+   * @param shared Parameters of the shared network.
+   * @param update The update to add; it must have as many elements as shared.
+   * @param local Parameters to copy the updated shared parameters into.
+   */
+  void Apply(arma::mat& shared, const arma::mat& update, arma::mat& local)
+  {
+    for (size_t s = 0; s < numStripes; ++s)
+    {
+      const size_t begin = StripeBegin(s, shared.n_elem);
+      const size_t end = StripeBegin(s + 1, shared.n_elem);
+      if (begin == end)
+        continue;
+
+      Lock(s);
+      for (size_t i = begin; i < end; ++i)
+      {
+        shared[i] += update[i];
+        local[i] = shared[i];
+      }
+      Unlock(s);
+    }
+  }
+
+  /**
+   * Copy the shared parameters into the local parameters, one stripe at a
+   * time.
+   *
+   * @param shared Parameters of the shared network.
+   * @param local Parameters to copy into; it must have as many elements as
+   *     shared.
+   */
+  void Copy(const arma::mat& shared, arma::mat& local)
+  {
+    for (size_t s = 0; s < numStripes; ++s)
+    {
+      const size_t begin = StripeBegin(s, shared.n_elem);
+      const size_t end = StripeBegin(s + 1, shared.n_elem);
+      if (begin == end)
+        continue;
+
+      Lock(s);
+      for (size_t i = begin; i < end; ++i)
+        local[i] = shared[i];
+      Unlock(s);
+    }
+  }
+
+ private:
+  //! Get the first element of the given stripe.
+  size_t StripeBegin(const size_t stripe, const size_t n) const
+  { return stripe * n / numStripes; }
+
+  //! Acquire the lock of the given stripe.
+  void Lock(const size_t stripe)
+  {
+    #ifdef HAS_OPENMP
+    omp_set_lock(&locks[stripe]);
+    #else
+    (void) stripe;
+    #endif
+  }
+
+  //! Release the lock of the given stripe.
+  void Unlock(const size_t stripe)
+  {
+    #ifdef HAS_OPENMP
+    omp_unset_lock(&locks[stripe]);
+    #else
+    (void) stripe;
+    #endif
+  }
+
+  //! Number of stripes.
+  size_t numStripes;
+
+  #ifdef HAS_OPENMP
+  //! The lock of each stripe.
+  std::vector<omp_lock_t> locks;
+  #endif
+};
+
+} // namespace rl
+} // namespace mlpack
+
+#endif
@@ -32,6 +32,9 @@ namespace regression {
  *
  * http://ufldl.stanford.edu/wiki/index.php/Softmax_Regression
  *
+ * Training and classification are templated on the type of the data matrix,
+ * so sparse data can be used directly by passing an arma::sp_mat.
+ *
  * An example on how to use the interface is shown below:
  *
  * @code
@@ -85,8 +88,8 @@ class SoftmaxRegression
    * @param lambda L2-regularization constant.
    * @param fitIntercept add intercept term or not.
    */
-  template<typename OptimizerType = ens::L_BFGS>
-  SoftmaxRegression(const arma::mat& data,
+  template<typename OptimizerType = ens::L_BFGS, typename MatType = arma::mat>
+  SoftmaxRegression(const MatType& data,
                     const arma::Row<size_t>& labels,
                     const size_t numClasses,
                     const double lambda = 0.0001,
@@ -109,8 +112,10 @@ class SoftmaxRegression
    * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
    *        See https://www.ensmallen.org/docs.html#callback-documentation.
    */
-  template<typename OptimizerType, typename... CallbackTypes>
-  SoftmaxRegression(const arma::mat& data,
+  template<typename OptimizerType,
+           typename MatType = arma::mat,
+           typename... CallbackTypes>
+  SoftmaxRegression(const MatType& data,
                     const arma::Row<size_t>& labels,
                     const size_t numClasses,
                     const double lambda,
@@ -125,7 +130,8 @@ class SoftmaxRegression
    * @param dataset Set of points to classify.
    * @param labels Predicted labels for each point.
    */
-  void Classify(const arma::mat& dataset, arma::Row<size_t>& labels) const;
+  template<typename MatType = arma::mat>
+  void Classify(const MatType& dataset, arma::Row<size_t>& labels) const;
   /**
    * Classify the given point. The predicted class label is returned.
    * The function calculates the probabilites for every class, given the point.
@@ -147,7 +153,8 @@ class SoftmaxRegression
    * @param labels Predicted labels for each point.
    * @param probabilities Class probabilities for each point.
    */
-  void Classify(const arma::mat& dataset,
+  template<typename MatType = arma::mat>
+  void Classify(const MatType& dataset,
                 arma::Row<size_t>& labels,
                 arma::mat& probabilities) const;
 
@@ -157,7 +164,8 @@ class SoftmaxRegression
    * @param dataset Matrix of data points to be classified.
    * @param probabilities Class probabilities for each point.
    */
-  void Classify(const arma::mat& dataset,
+  template<typename MatType = arma::mat>
+  void Classify(const MatType& dataset,
                 arma::mat& probabilities) const;
 
   /**
@@ -168,7 +176,8 @@ class SoftmaxRegression
    * @param testData Matrix of data points using which predictions are made.
    * @param labels Vector of labels associated with the data.
    */
-  double ComputeAccuracy(const arma::mat& testData,
+  template<typename MatType = arma::mat>
+  double ComputeAccuracy(const MatType& testData,
                          const arma::Row<size_t>& labels) const;
   /**
    * Train the softmax regression with the given training data.
@@ -180,8 +189,8 @@ class SoftmaxRegression
    * @param optimizer Desired optimizer.
    * @return Objective value of the final point.
    */
-  template<typename OptimizerType = ens::L_BFGS>
-  double Train(const arma::mat& data,
+  template<typename OptimizerType = ens::L_BFGS, typename MatType = arma::mat>
+  double Train(const MatType& data,
                const arma::Row<size_t>& labels,
                const size_t numClasses,
                OptimizerType optimizer = OptimizerType());
@@ -198,8 +207,10 @@ class SoftmaxRegression
    *      See https://www.ensmallen.org/docs.html#callback-documentation.
    * @return Objective value of the final point.
    */
-  template<typename OptimizerType = ens::L_BFGS, typename... CallbackTypes>
-  double Train(const arma::mat& data,
+  template<typename OptimizerType = ens::L_BFGS,
+           typename MatType = arma::mat,
+           typename... CallbackTypes>
+  double Train(const MatType& data,
                const arma::Row<size_t>& labels,
                const size_t numClasses,
                OptimizerType optimizer,
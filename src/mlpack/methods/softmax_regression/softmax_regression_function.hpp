@@ -18,7 +18,15 @@
 namespace mlpack {
 namespace regression {
 
-class SoftmaxRegressionFunction
+/**
+ * The objective function of softmax regression.  The data can be dense or
+ * sparse: with arma::sp_mat as MatType, the data is only used in sparse-dense
+ * matrix products, so it is never densified.
+ *
+ * @tparam MatType Type of data matrix.
+ */
+template<typename MatType = arma::mat>
+class SoftmaxRegressionFunctionType
 {
  public:
   /**
@@ -31,17 +39,21 @@ class SoftmaxRegressionFunction
    * @param lambda L2-regularization constant.
    * @param fitIntercept Intercept term flag.
    */
-  SoftmaxRegressionFunction(const arma::mat& data,
-                            const arma::Row<size_t>& labels,
-                            const size_t numClasses,
-                            const double lambda = 0.0001,
-                            const bool fitIntercept = false);
+  SoftmaxRegressionFunctionType(const MatType& data,
+                                const arma::Row<size_t>& labels,
+                                const size_t numClasses,
+                                const double lambda = 0.0001,
+                                const bool fitIntercept = false);
 
   //! Initializes the parameters of the model to suitable values.
   const arma::mat InitializeWeights();
 
   /**
-   * Shuffle the dataset.
+   * Shuffle the dataset.  The data is not moved: only the order in which the
+   * points are visited by the separable Evaluate() and Gradient() overloads is
+   * shuffled, and their batches are gathered through that order.  The batches
+   * are the same as if the data itself had been shuffled with
+   * math::ShuffleData().
    */
   void Shuffle();
 
@@ -89,7 +101,7 @@ class SoftmaxRegressionFunction
    *
    * @param parameters Current values of the model parameters.
    * @param probabilities Pointer to arma::mat which stores the probabilities.
-   * @param start Index of point to start at.
+   * @param start Index of point to start at (in the shuffled order).
    * @param batchSize Number of points to calculate probabilities for.
    */
   void GetProbabilitiesMatrix(const arma::mat& parameters,
@@ -97,6 +109,18 @@ class SoftmaxRegressionFunction
                               const size_t start,
                               const size_t batchSize) const;
 
+  /**
+   * Evaluate the probabilities matrix of the given points with the passed
+   * parameters.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param points Points to calculate probabilities for.
+   * @param probabilities Pointer to arma::mat which stores the probabilities.
+   */
+  void GetProbabilitiesMatrix(const arma::mat& parameters,
+                              const MatType& points,
+                              arma::mat& probabilities) const;
+
   /**
    * Evaluates the objective function of the softmax regression model using the
    * given parameters. The cost function has terms for the log likelihood error
@@ -188,10 +212,12 @@ class SoftmaxRegressionFunction
   bool FitIntercept() const { return fitIntercept; }
 
  private:
-  //! Training data matrix.  This is an alias until the data is shuffled.
-  arma::mat data;
+  //! Training data matrix.  This may be an alias of the given data.
+  MatType data;
   //! Label matrix for the provided data.
   arma::sp_mat groundTruth;
+  //! Order in which the points are visited; empty until Shuffle() is called.
+  arma::uvec ordering;
   //! Initial parameter point.
   arma::mat initialPoint;
   //! Number of classes.
@@ -202,7 +228,13 @@ class SoftmaxRegressionFunction
   bool fitIntercept;
 };
 
+//! The objective function of softmax regression on dense data.
+using SoftmaxRegressionFunction = SoftmaxRegressionFunctionType<arma::mat>;
+
 } // namespace regression
 } // namespace mlpack
 
+// Include implementation.
+#include "softmax_regression_function_impl.hpp"
+
 #endif
@@ -1,5 +1,5 @@
 /**
- * @file methods/softmax_regression/softmax_regression_function.cpp
+ * @file methods/softmax_regression/softmax_regression_function_impl.hpp
  * @author Siddharth Agrawal
  *
  * Implementation of function to be optimized for softmax regression.
@@ -9,19 +9,26 @@
  * 3-clause BSD license along with mlpack.  If not, see
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
+#ifndef MLPACK_METHODS_SOFTMAX_REGRESSION_SOFTMAX_REGRESSION_FUNCTION_IMPL_HPP
+#define MLPACK_METHODS_SOFTMAX_REGRESSION_SOFTMAX_REGRESSION_FUNCTION_IMPL_HPP
+
+// In case it hasn't been included yet.
 #include "softmax_regression_function.hpp"
+
 #include <mlpack/core/math/make_alias.hpp>
+#include <mlpack/core/math/shuffle_data.hpp>
 
-using namespace mlpack;
-using namespace mlpack::regression;
+namespace mlpack {
+namespace regression {
 
-SoftmaxRegressionFunction::SoftmaxRegressionFunction(
-    const arma::mat& data,
+template<typename MatType>
+SoftmaxRegressionFunctionType<MatType>::SoftmaxRegressionFunctionType(
+    const MatType& data,
     const arma::Row<size_t>& labels,
     const size_t numClasses,
     const double lambda,
     const bool fitIntercept) :
-    data(math::MakeAlias(const_cast<arma::mat&>(data), false)),
+    data(math::MakeAlias(const_cast<MatType&>(data), false)),
     numClasses(numClasses),
     lambda(lambda),
     fitIntercept(fitIntercept)
@@ -34,40 +41,13 @@ SoftmaxRegressionFunction::SoftmaxRegressionFunction(
 }
 
 /**
- * Shuffle the data.
+ * Shuffle the data.  Only the visitation order is shuffled; the batches are
+ * gathered from the data through the order when they are used.
  */
-void SoftmaxRegressionFunction::Shuffle()
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::Shuffle()
 {
-  // Determine new ordering.
-  arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
-      data.n_cols - 1, data.n_cols));
-
-  // Re-sort data.
-  arma::mat newData = data.cols(ordering);
-  math::ClearAlias(data);
-  data = std::move(newData);
-
-  // Assemble data for batch constructor.  We need reverse orderings though...
-  arma::uvec reverseOrdering(ordering.n_elem);
-  for (size_t i = 0; i < ordering.n_elem; ++i)
-    reverseOrdering[ordering[i]] = i;
-
-  arma::umat newLocations(2, groundTruth.n_nonzero);
-  arma::vec values(groundTruth.n_nonzero);
-  arma::sp_mat::const_iterator it = groundTruth.begin();
-  size_t loc = 0;
-  while (it != groundTruth.end())
-  {
-    newLocations(0, loc) = reverseOrdering(it.col());
-    newLocations(1, loc) = it.row();
-    values(loc) = (*it);
-
-    ++it;
-    ++loc;
-  }
-
-  groundTruth = arma::sp_mat(newLocations, values, groundTruth.n_rows,
-      groundTruth.n_cols);
+  math::ShuffleOrder(data, ordering);
 }
 
 /**
@@ -75,12 +55,14 @@ void SoftmaxRegressionFunction::Shuffle()
  * normal distribution. The weights cannot be initialized to zero, as that will
  * lead to each class output being the same.
  */
-const arma::mat SoftmaxRegressionFunction::InitializeWeights()
+template<typename MatType>
+const arma::mat SoftmaxRegressionFunctionType<MatType>::InitializeWeights()
 {
   return InitializeWeights(data.n_rows, numClasses, fitIntercept);
 }
 
-const arma::mat SoftmaxRegressionFunction::InitializeWeights(
+template<typename MatType>
+const arma::mat SoftmaxRegressionFunctionType<MatType>::InitializeWeights(
     const size_t featureSize,
     const size_t numClasses,
     const bool fitIntercept)
@@ -90,7 +72,8 @@ const arma::mat SoftmaxRegressionFunction::InitializeWeights(
     return parameters;
 }
 
-void SoftmaxRegressionFunction::InitializeWeights(
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::InitializeWeights(
     arma::mat &weights,
     const size_t featureSize,
     const size_t numClasses,
@@ -111,7 +94,8 @@ void SoftmaxRegressionFunction::InitializeWeights(
  * labels. The output is in the form of a matrix, which leads to simpler
  * calculations in the Evaluate() and Gradient() methods.
  */
-void SoftmaxRegressionFunction::GetGroundTruthMatrix(
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::GetGroundTruthMatrix(
     const arma::Row<size_t>& labels, arma::sp_mat& groundTruth)
 {
   // Calculate the ground truth matrix according to the labels passed. The
@@ -144,14 +128,29 @@ void SoftmaxRegressionFunction::GetGroundTruthMatrix(
 }
 
 /**
- * Evaluate the probabilities matrix. If fitIntercept flag is true,
- * it should consider the parameters.cols(0) intercept term.
+ * Evaluate the probabilities matrix for the given batch of the (shuffled)
+ * data.
  */
-void SoftmaxRegressionFunction::GetProbabilitiesMatrix(
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::GetProbabilitiesMatrix(
     const arma::mat& parameters,
     arma::mat& probabilities,
     const size_t start,
     const size_t batchSize) const
+{
+  GetProbabilitiesMatrix(parameters,
+      math::GatherColumns(data, ordering, start, batchSize), probabilities);
+}
+
+/**
+ * Evaluate the probabilities matrix. If fitIntercept flag is true,
+ * it should consider the parameters.cols(0) intercept term.
+ */
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::GetProbabilitiesMatrix(
+    const arma::mat& parameters,
+    const MatType& points,
+    arma::mat& probabilities) const
 {
   arma::mat hypothesis;
 
@@ -164,14 +163,12 @@ void SoftmaxRegressionFunction::GetProbabilitiesMatrix(
     // Since the cost of join may be high due to the copy of original data,
     // split the hypothesis computation to two components.
     hypothesis = arma::exp(
-        arma::repmat(parameters.col(0), 1, batchSize) +
-        parameters.cols(1, parameters.n_cols - 1) *
-        data.cols(start, start + batchSize - 1));
+        arma::repmat(parameters.col(0), 1, points.n_cols) +
+        parameters.cols(1, parameters.n_cols - 1) * points);
   }
   else
   {
-    hypothesis = arma::exp(parameters *
-        data.cols(start, start + batchSize - 1));
+    hypothesis = arma::exp(parameters * points);
   }
 
   probabilities = hypothesis / arma::repmat(arma::sum(hypothesis, 0),
@@ -181,7 +178,9 @@ void SoftmaxRegressionFunction::GetProbabilitiesMatrix(
 /**
  * Evaluates the objective function given the parameters.
  */
-double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters) const
+template<typename MatType>
+double SoftmaxRegressionFunctionType<MatType>::Evaluate(
+    const arma::mat& parameters) const
 {
   // The objective function is the negative log likelihood of the model
   // calculated over all the training examples. Mathematically it is as follows:
@@ -200,7 +199,7 @@ double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters) const
   // x_i is the input vector for a particular training example.
   // theta_j is the parameter vector associated with a particular class.
   arma::mat probabilities;
-  GetProbabilitiesMatrix(parameters, probabilities, 0, data.n_cols);
+  GetProbabilitiesMatrix(parameters, data, probabilities);
 
   // Calculate the log likelihood and regularization terms.
   double logLikelihood, weightDecay, cost;
@@ -219,19 +218,22 @@ double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters) const
 /**
  * Evaluate the objective function for the given points given the parameters.
  */
-double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters,
-                                           const size_t start,
-                                           const size_t batchSize) const
+template<typename MatType>
+double SoftmaxRegressionFunctionType<MatType>::Evaluate(
+    const arma::mat& parameters,
+    const size_t start,
+    const size_t batchSize) const
 {
   arma::mat probabilities;
-  GetProbabilitiesMatrix(parameters, probabilities, start, batchSize);
+  GetProbabilitiesMatrix(parameters, math::GatherColumns(data, ordering, start,
+      batchSize), probabilities);
 
   // Calculate the log likelihood and regularization terms.
   double logLikelihood, weightDecay;
 
-  logLikelihood = arma::accu(groundTruth.cols(start, start + batchSize - 1) %
-      arma::log(probabilities)) / batchSize;
-  weightDecay = 0.5 * lambda * arma::accu(parameters * parameters);
+  logLikelihood = arma::accu(math::GatherColumns(groundTruth, ordering, start,
+      batchSize) % arma::log(probabilities)) / batchSize;
+  weightDecay = 0.5 * lambda * arma::accu(parameters % parameters);
 
   return -logLikelihood + weightDecay;
 }
@@ -239,8 +241,10 @@ double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters,
 /**
  * Calculates and stores the gradient values given a set of parameters.
  */
-void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
-                                         arma::mat& gradient) const
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::Gradient(
+    const arma::mat& parameters,
+    arma::mat& gradient) const
 {
   // Calculate the class probabilities for each training example. The
   // probabilities for each of the classes are given by:
@@ -249,7 +253,7 @@ void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
   // x_i is the input vector for a particular training example.
   // theta_j is the parameter vector associated with a particular class.
   arma::mat probabilities;
-  GetProbabilitiesMatrix(parameters, probabilities, 0, data.n_cols);
+  GetProbabilitiesMatrix(parameters, data, probabilities);
 
   // Calculate the parameter gradients.
   gradient.set_size(parameters.n_rows, parameters.n_cols);
@@ -261,54 +265,61 @@ void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
     gradient.col(0) =
       inner * arma::ones<arma::mat>(data.n_cols, 1) / data.n_cols +
       lambda * parameters.col(0);
+    // The product is taken as (data * inner^T)^T, so that sparse data is
+    // never transposed.
     gradient.cols(1, parameters.n_cols - 1) =
-      inner * data.t() / data.n_cols +
+      arma::trans(data * arma::trans(inner)) / data.n_cols +
       lambda * parameters.cols(1, parameters.n_cols - 1);
   }
   else
   {
-    gradient = (probabilities - groundTruth) * data.t() / data.n_cols +
+    const arma::mat inner = probabilities - groundTruth;
+    gradient = arma::trans(data * arma::trans(inner)) / data.n_cols +
                lambda * parameters;
   }
 }
 
-void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
-                                         const size_t start,
-                                         arma::mat& gradient,
-                                         const size_t batchSize) const
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::Gradient(
+    const arma::mat& parameters,
+    const size_t start,
+    arma::mat& gradient,
+    const size_t batchSize) const
 {
+  const MatType batch = math::GatherColumns(data, ordering, start, batchSize);
   arma::mat probabilities;
-  GetProbabilitiesMatrix(parameters, probabilities, start, batchSize);
+  GetProbabilitiesMatrix(parameters, batch, probabilities);
 
   // Calculate the parameter gradients.
+  const arma::mat inner = probabilities - math::GatherColumns(groundTruth,
+      ordering, start, batchSize);
   gradient.set_size(parameters.n_rows, parameters.n_cols);
   if (fitIntercept)
   {
-    arma::mat inner = probabilities - groundTruth.cols(start, start +
-        batchSize - 1);
     gradient.col(0) =
         inner * arma::ones<arma::mat>(batchSize, 1) / batchSize +
         lambda * parameters.col(0);
     gradient.cols(1, parameters.n_cols - 1) =
-        inner * data.cols(start, start + batchSize - 1).t() / batchSize +
+        arma::trans(batch * arma::trans(inner)) / batchSize +
         lambda * parameters.cols(1, parameters.n_cols - 1);
   }
   else
   {
-    gradient = (probabilities - groundTruth.cols(start, start + batchSize - 1))
-        * data.cols(start, start + batchSize - 1).t() / batchSize
-        + lambda * parameters;
+    gradient = arma::trans(batch * arma::trans(inner)) / batchSize +
+        lambda * parameters;
   }
 }
 
-void SoftmaxRegressionFunction::PartialGradient(const arma::mat& parameters,
-                                                const size_t j,
-                                                arma::sp_mat& gradient) const
+template<typename MatType>
+void SoftmaxRegressionFunctionType<MatType>::PartialGradient(
+    const arma::mat& parameters,
+    const size_t j,
+    arma::sp_mat& gradient) const
 {
   gradient.zeros(arma::size(parameters));
 
   arma::mat probabilities;
-  GetProbabilitiesMatrix(parameters, probabilities, 0, data.n_cols);
+  GetProbabilitiesMatrix(parameters, data, probabilities);
 
   // Calculate the required part of the gradient.
   arma::mat inner = probabilities - groundTruth;
@@ -322,7 +333,8 @@ void SoftmaxRegressionFunction::PartialGradient(const arma::mat& parameters,
     }
     else
     {
-      gradient.col(j) = inner * data.row(j).t() / data.n_cols + lambda *
+      // Column j of the parameters corresponds to dimension j - 1 of the data.
+      gradient.col(j) = inner * data.row(j - 1).t() / data.n_cols + lambda *
           parameters.col(j);
     }
   }
@@ -332,3 +344,8 @@ void SoftmaxRegressionFunction::PartialGradient(const arma::mat& parameters,
         parameters.col(j);
   }
 }
+
+} // namespace regression
+} // namespace mlpack
+
+#endif
@@ -18,9 +18,9 @@
 namespace mlpack {
 namespace regression {
 
-template<typename OptimizerType>
+template<typename OptimizerType, typename MatType>
 SoftmaxRegression::SoftmaxRegression(
-    const arma::mat& data,
+    const MatType& data,
     const arma::Row<size_t>& labels,
     const size_t numClasses,
     const double lambda,
@@ -33,9 +33,9 @@ SoftmaxRegression::SoftmaxRegression(
   Train(data, labels, numClasses, optimizer);
 }
 
-template<typename OptimizerType, typename... CallbackTypes>
+template<typename OptimizerType, typename MatType, typename... CallbackTypes>
 SoftmaxRegression::SoftmaxRegression(
-    const arma::mat& data,
+    const MatType& data,
     const arma::Row<size_t>& labels,
     const size_t numClasses,
     const double lambda,
@@ -57,14 +57,127 @@ size_t SoftmaxRegression::Classify(const VecType& point) const
   return size_t(label(0));
 }
 
-template<typename OptimizerType>
-double SoftmaxRegression::Train(const arma::mat& data,
+template<typename MatType>
+void SoftmaxRegression::Classify(const MatType& dataset,
+                                 arma::Row<size_t>& labels)
+    const
+{
+  arma::mat probabilities;
+  Classify(dataset, probabilities);
+
+  // Prepare necessary data.
+  labels.zeros(dataset.n_cols);
+  double maxProbability = 0;
+
+  // For each test input.
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    // For each class.
+    for (size_t j = 0; j < numClasses; ++j)
+    {
+      // If a higher class probability is encountered, change prediction.
+      if (probabilities(j, i) > maxProbability)
+      {
+        maxProbability = probabilities(j, i);
+        labels(i) = j;
+      }
+    }
+
+    // Set maximum probability to zero for the next input.
+    maxProbability = 0;
+  }
+}
+
+template<typename MatType>
+void SoftmaxRegression::Classify(const MatType& dataset,
+                                 arma::Row<size_t>& labels,
+                                 arma::mat& probabilities)
+    const
+{
+  Classify(dataset, probabilities);
+
+  // Prepare necessary data.
+  labels.zeros(dataset.n_cols);
+  double maxProbability = 0;
+
+  // For each test input.
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    // For each class.
+    for (size_t j = 0; j < numClasses; ++j)
+    {
+      // If a higher class probability is encountered, change prediction.
+      if (probabilities(j, i) > maxProbability)
+      {
+        maxProbability = probabilities(j, i);
+        labels(i) = j;
+      }
+    }
+
+    // Set maximum probability to zero for the next input.
+    maxProbability = 0;
+  }
+}
+
+template<typename MatType>
+void SoftmaxRegression::Classify(const MatType& dataset,
+                                 arma::mat& probabilities)
+    const
+{
+  util::CheckSameDimensionality(dataset, FeatureSize(),
+      "SoftmaxRegression::Classify()");
+
+  // Calculate the probabilities for each test input.
+  arma::mat hypothesis;
+  if (fitIntercept)
+  {
+    // In order to add the intercept term, we should compute following matrix:
+    //     [1; data] = arma::join_cols(ones(1, data.n_cols), data)
+    //     hypothesis = arma::exp(parameters * [1; data]).
+    //
+    // Since the cost of join maybe high due to the copy of original data,
+    // split the hypothesis computation to two components.
+    hypothesis = arma::exp(
+      arma::repmat(parameters.col(0), 1, dataset.n_cols) +
+      parameters.cols(1, parameters.n_cols - 1) * dataset);
+  }
+  else
+  {
+    hypothesis = arma::exp(parameters * dataset);
+  }
+
+  probabilities = hypothesis / arma::repmat(arma::sum(hypothesis, 0),
+                                            numClasses, 1);
+}
+
+template<typename MatType>
+double SoftmaxRegression::ComputeAccuracy(
+    const MatType& testData,
+    const arma::Row<size_t>& labels) const
+{
+  arma::Row<size_t> predictions;
+
+  // Get predictions for the provided data.
+  Classify(testData, predictions);
+
+  // Increment count for every correctly predicted label.
+  size_t count = 0;
+  for (size_t i = 0; i < predictions.n_elem; ++i)
+    if (predictions(i) == labels(i))
+      count++;
+
+  // Return percentage accuracy.
+  return (count * 100.0) / predictions.n_elem;
+}
+
+template<typename OptimizerType, typename MatType>
+double SoftmaxRegression::Train(const MatType& data,
                                 const arma::Row<size_t>& labels,
                                 const size_t numClasses,
                                 OptimizerType optimizer)
 {
-  SoftmaxRegressionFunction regressor(data, labels, numClasses, lambda,
-                                      fitIntercept);
+  SoftmaxRegressionFunctionType<MatType> regressor(data, labels, numClasses,
+                                               lambda, fitIntercept);
   if (parameters.n_elem != regressor.GetInitialPoint().n_elem)
     parameters = regressor.GetInitialPoint();
 
@@ -79,15 +192,15 @@ double SoftmaxRegression::Train(const arma::mat& data,
   return out;
 }
 
-template<typename OptimizerType, typename... CallbackTypes>
-double SoftmaxRegression::Train(const arma::mat& data,
+template<typename OptimizerType, typename MatType, typename... CallbackTypes>
+double SoftmaxRegression::Train(const MatType& data,
                                 const arma::Row<size_t>& labels,
                                 const size_t numClasses,
                                 OptimizerType optimizer,
                                 CallbackTypes&&... callbacks)
 {
-  SoftmaxRegressionFunction regressor(data, labels, numClasses, lambda,
-                                      fitIntercept);
+  SoftmaxRegressionFunctionType<MatType> regressor(data, labels, numClasses,
+                                               lambda, fitIntercept);
   if (parameters.n_elem != regressor.GetInitialPoint().n_elem)
     parameters = regressor.GetInitialPoint();
 
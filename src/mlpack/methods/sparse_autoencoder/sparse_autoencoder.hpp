@@ -57,7 +57,9 @@ namespace nn {
  * @endcode
  *
  * This implementation allows the use of arbitrary mlpack optimizers via the
- * OptimizerType template parameter.
+ * OptimizerType template parameter, including mini-batch optimizers like
+ * ens::Adam, which train on batches of points with a running estimate of the
+ * average activations of the hidden neurons (see SparseAutoencoderFunction).
  *
  */
 class SparseAutoencoder
@@ -11,6 +11,8 @@
  */
 #include "sparse_autoencoder_function.hpp"
 
+#include <mlpack/core/math/shuffle_data.hpp>
+
 using namespace mlpack;
 using namespace mlpack::nn;
 using namespace std;
@@ -26,7 +28,8 @@ SparseAutoencoderFunction::SparseAutoencoderFunction(const arma::mat& data,
     hiddenSize(hiddenSize),
     lambda(lambda),
     beta(beta),
-    rho(rho)
+    rho(rho),
+    sparsityMomentum(0.9)
 {
   // Initialize the parameters to suitable values.
   initialPoint = InitializeWeights();
@@ -71,6 +74,13 @@ const arma::mat SparseAutoencoderFunction::InitializeWeights()
   return parameters;
 }
 
+/** Shuffles the order in which the separable functions visit the points.
+  */
+void SparseAutoencoderFunction::Shuffle()
+{
+  math::ShuffleOrder(data, ordering);
+}
+
 /** Evaluates the objective function given the parameters.
   */
 double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters) const
@@ -83,29 +93,14 @@ double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters) const
   // The cost also takes into account the regularization and KL divergence terms
   // to control the parameter weights and sparsity of the model respectively.
 
-  // Compute the limits for the parameters w1, w2, b1 and b2.
-  const size_t l1 = hiddenSize;
+  // Compute the limits for the parameters w1 and w2.
   const size_t l2 = visibleSize;
   const size_t l3 = 2 * hiddenSize;
 
-  // w1, w2, b1 and b2 are not extracted separately, 'parameters' is directly
-  // used in their place to avoid copying data. The following representations
-  // are used:
-  // w1 <- parameters.submat(0, 0, l1-1, l2-1)
-  // w2 <- parameters.submat(l1, 0, l3-1, l2-1).t()
-  // b1 <- parameters.submat(0, l2, l1-1, l2)
-  // b2 <- parameters.submat(l3, 0, l3, l2-1).t()
-
   arma::mat hiddenLayer, outputLayer;
 
   // Compute activations of the hidden and output layers.
-  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * data +
-      arma::repmat(parameters.submat(0, l2, l1 - 1, l2), 1, data.n_cols),
-      hiddenLayer);
-
-  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
-      arma::repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, data.n_cols),
-      outputLayer);
+  Activations(parameters, data, hiddenLayer, outputLayer);
 
   arma::mat rhoCap, diff;
 
@@ -155,24 +150,10 @@ void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
   const size_t l2 = visibleSize;
   const size_t l3 = 2 * hiddenSize;
 
-  // w1, w2, b1 and b2 are not extracted separately, 'parameters' is directly
-  // used in their place to avoid copying data. The following representations
-  // are used:
-  // w1 <- parameters.submat(0, 0, l1-1, l2-1)
-  // w2 <- parameters.submat(l1, 0, l3-1, l2-1).t()
-  // b1 <- parameters.submat(0, l2, l1-1, l2)
-  // b2 <- parameters.submat(l3, 0, l3, l2-1).t()
-
   arma::mat hiddenLayer, outputLayer;
 
   // Compute activations of the hidden and output layers.
-  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * data +
-      arma::repmat(parameters.submat(0, l2, l1 - 1, l2), 1, data.n_cols),
-      hiddenLayer);
-
-  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
-      arma::repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, data.n_cols),
-      outputLayer);
+  Activations(parameters, data, hiddenLayer, outputLayer);
 
   arma::mat rhoCap, diff;
 
@@ -208,3 +189,114 @@ void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
   gradient.submat(0, l2, l1 - 1, l2) = arma::sum(delHid, 1) / data.n_cols;
   gradient.submat(l3, 0, l3, l2 - 1) = (arma::sum(delOut, 1) / data.n_cols).t();
 }
+
+/** Evaluates the objective function on a batch of points, using the running
+  * estimate of the average activations for the sparsity term.
+  */
+double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters,
+                                           const size_t begin,
+                                           const size_t batchSize) const
+{
+  // The terms of the objective are computed as in the full-batch Evaluate(),
+  // with the average over the batch instead of over the whole dataset.
+  const size_t l2 = visibleSize;
+  const size_t l3 = 2 * hiddenSize;
+
+  const arma::mat points = math::GatherColumns(data, ordering, begin,
+      batchSize);
+
+  arma::mat hiddenLayer, outputLayer;
+  Activations(parameters, points, hiddenLayer, outputLayer);
+
+  const arma::vec rhoCap = BlendAverageActivations(hiddenLayer);
+  const arma::mat diff = outputLayer - points;
+
+  const double wL2SquaredNorm = arma::accu(
+      parameters.submat(0, 0, l3 - 1, l2 - 1) %
+      parameters.submat(0, 0, l3 - 1, l2 - 1));
+
+  const double sumOfSquaresError = 0.5 * arma::accu(diff % diff) / batchSize;
+  const double weightDecay = 0.5 * lambda * wL2SquaredNorm;
+  const double klDivergence = beta * arma::accu(rho * arma::log(rho / rhoCap) +
+      (1 - rho) * arma::log((1 - rho) / (1 - rhoCap)));
+
+  return sumOfSquaresError + weightDecay + klDivergence;
+}
+
+/** Calculates the gradient on a batch of points, and updates the running
+  * estimate of the average activations.
+  */
+void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
+                                         const size_t begin,
+                                         arma::mat& gradient,
+                                         const size_t batchSize)
+{
+  const size_t l1 = hiddenSize;
+  const size_t l2 = visibleSize;
+  const size_t l3 = 2 * hiddenSize;
+
+  const arma::mat points = math::GatherColumns(data, ordering, begin,
+      batchSize);
+
+  arma::mat hiddenLayer, outputLayer;
+  Activations(parameters, points, hiddenLayer, outputLayer);
+
+  // The running estimate is treated as the average activation of each hidden
+  // neuron, as in the full-batch gradient.
+  averageActivations = BlendAverageActivations(hiddenLayer);
+  const arma::vec& rhoCap = averageActivations;
+  const arma::mat diff = outputLayer - points;
+
+  const arma::vec klDivGrad = beta * (-(rho / rhoCap) + (1 - rho) /
+      (1 - rhoCap));
+  const arma::mat delOut = diff % outputLayer % (1 - outputLayer);
+  const arma::mat delHid = (parameters.submat(l1, 0, l3 - 1, l2 - 1) * delOut +
+      arma::repmat(klDivGrad, 1, batchSize)) % hiddenLayer % (1 - hiddenLayer);
+
+  gradient.zeros(2 * hiddenSize + 1, visibleSize + 1);
+
+  gradient.submat(0, 0, l1 - 1, l2 - 1) = delHid * points.t() / batchSize +
+      lambda * parameters.submat(0, 0, l1 - 1, l2 - 1);
+  gradient.submat(l1, 0, l3 - 1, l2 - 1) =
+      (delOut * hiddenLayer.t() / batchSize +
+      lambda * parameters.submat(l1, 0, l3 - 1, l2 - 1).t()).t();
+  gradient.submat(0, l2, l1 - 1, l2) = arma::sum(delHid, 1) / batchSize;
+  gradient.submat(l3, 0, l3, l2 - 1) = (arma::sum(delOut, 1) / batchSize).t();
+}
+
+void SparseAutoencoderFunction::Activations(const arma::mat& parameters,
+                                            const arma::mat& points,
+                                            arma::mat& hiddenLayer,
+                                            arma::mat& outputLayer) const
+{
+  // Compute the limits for the parameters w1, w2, b1 and b2.
+  const size_t l1 = hiddenSize;
+  const size_t l2 = visibleSize;
+  const size_t l3 = 2 * hiddenSize;
+
+  // w1, w2, b1 and b2 are not extracted separately, 'parameters' is directly
+  // used in their place to avoid copying data. The following representations
+  // are used:
+  // w1 <- parameters.submat(0, 0, l1-1, l2-1)
+  // w2 <- parameters.submat(l1, 0, l3-1, l2-1).t()
+  // b1 <- parameters.submat(0, l2, l1-1, l2)
+  // b2 <- parameters.submat(l3, 0, l3, l2-1).t()
+  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * points +
+      arma::repmat(parameters.submat(0, l2, l1 - 1, l2), 1, points.n_cols),
+      hiddenLayer);
+
+  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
+      arma::repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, points.n_cols),
+      outputLayer);
+}
+
+arma::vec SparseAutoencoderFunction::BlendAverageActivations(
+    const arma::mat& hiddenLayer) const
+{
+  const arma::vec batchAverage = arma::sum(hiddenLayer, 1) / hiddenLayer.n_cols;
+  if (averageActivations.n_elem != hiddenLayer.n_rows)
+    return batchAverage;
+
+  return sparsityMomentum * averageActivations +
+      (1 - sparsityMomentum) * batchAverage;
+}
@@ -47,6 +47,13 @@ class SparseAutoencoderFunction
   //! Initializes the parameters of the model to suitable values.
   const arma::mat InitializeWeights();
 
+  /**
+   * Shuffle the dataset.  The data is not moved: only the order in which the
+   * points are visited by the separable Evaluate() and Gradient() overloads is
+   * shuffled.
+   */
+  void Shuffle();
+
   /**
    * Evaluates the objective function of the sparse autoencoder model using the
    * given parameters. The cost function has terms for the reconstruction
@@ -70,6 +77,47 @@ class SparseAutoencoderFunction
    */
   void Gradient(const arma::mat& parameters, arma::mat& gradient) const;
 
+  /**
+   * Evaluate the objective function of the sparse autoencoder model on the
+   * given batch of points, for optimizers like SGD and Adam.  The
+   * reconstruction error is averaged over the batch.  The sparsity term needs
+   * the average activations of the hidden neurons over the whole dataset, so
+   * it uses a running estimate of them instead: the average activations of the
+   * batch, blended with the estimate kept by the separable Gradient() as
+   *
+   *   rhoCap = momentum * estimate + (1 - momentum) * batch average.
+   *
+   * The estimate is not updated.  Before the first call to the separable
+   * Gradient(), or with a momentum of 0, the batch average is used alone, so a
+   * single batch of all the points gives the same objective as the full-batch
+   * Evaluate().
+   *
+   * @param parameters Current values of the model parameters.
+   * @param begin Index of the first point of the batch.
+   * @param batchSize Number of points in the batch.
+   */
+  double Evaluate(const arma::mat& parameters,
+                  const size_t begin,
+                  const size_t batchSize = 1) const;
+
+  /**
+   * Evaluate the gradient of the objective function on the given batch of
+   * points, as the separable Evaluate() computes it, and update the running
+   * estimate of the average activations of the hidden neurons.
+   *
+   * @param parameters Current values of the model parameters.
+   * @param begin Index of the first point of the batch.
+   * @param gradient Matrix where gradient values will be stored.
+   * @param batchSize Number of points in the batch.
+   */
+  void Gradient(const arma::mat& parameters,
+                const size_t begin,
+                arma::mat& gradient,
+                const size_t batchSize = 1);
+
+  //! Return the number of separable functions (the number of points).
+  size_t NumFunctions() const { return data.n_cols; }
+
   /**
    * Returns the elementwise sigmoid of the passed matrix, where the sigmoid
    * function of a real number 'x' is [1 / (1 + exp(-x))].
@@ -145,9 +193,49 @@ class SparseAutoencoderFunction
     return rho;
   }
 
+  //! Sets the momentum of the running estimate of the average activations.
+  void SparsityMomentum(const double momentum)
+  {
+    this->sparsityMomentum = momentum;
+  }
+
+  //! Gets the momentum of the running estimate of the average activations.
+  double SparsityMomentum() const
+  {
+    return sparsityMomentum;
+  }
+
+  //! Gets the running estimate of the average activations of the hidden
+  //! neurons; empty until the separable Gradient() is called.
+  const arma::vec& AverageActivations() const
+  {
+    return averageActivations;
+  }
+
+  //! Forget the running estimate of the average activations.
+  void ResetAverageActivations()
+  {
+    averageActivations.reset();
+  }
+
  private:
+  /**
+   * Compute the activations of the hidden and output layers for the given
+   * points.
+   */
+  void Activations(const arma::mat& parameters,
+                   const arma::mat& points,
+                   arma::mat& hiddenLayer,
+                   arma::mat& outputLayer) const;
+
+  //! Blend the average activations of the given hidden layer into the running
+  //! estimate, without updating it.
+  arma::vec BlendAverageActivations(const arma::mat& hiddenLayer) const;
+
   //! The matrix of data points.
   const arma::mat& data;
+  //! Order in which the points are visited; empty until Shuffle() is called.
+  arma::uvec ordering;
   //! Initial parameter vector.
   arma::mat initialPoint;
   //! Size of the visible layer.
@@ -160,6 +248,10 @@ class SparseAutoencoderFunction
   double beta;
   //! Sparsity parameter.
   double rho;
+  //! Momentum of the running estimate of the average activations.
+  double sparsityMomentum;
+  //! Running estimate of the average activations of the hidden neurons.
+  arma::vec averageActivations;
 };
 
 } // namespace nn
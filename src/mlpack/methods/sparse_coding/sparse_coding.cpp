@@ -36,25 +36,29 @@ SparseCoding::SparseCoding(
 void SparseCoding::Encode(const arma::mat& data, arma::mat& codes)
 {
   // When using the Cholesky version of LARS, this is correct even if
-  // lambda2 > 0.
+  // lambda2 > 0.  The Gram matrix is shared (read-only) by all threads.
   arma::mat matGram = trans(dictionary) * dictionary;
 
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
-  {
-    // Report progress.
-    if ((i % 100) == 0)
-      Log::Debug << "Optimization at point " << i << "." << std::endl;
+  Log::Debug << "Encoding " << data.n_cols << " points." << std::endl;
 
-    bool useCholesky = true;
+  // Each point is encoded independently, so the points are split among the
+  // threads.  Each thread keeps its own LARS object as workspace.
+  #pragma omp parallel
+  {
+    const bool useCholesky = true;
     regression::LARS lars(useCholesky, matGram, lambda1, lambda2);
 
-    // Create an alias of the code (using the same memory), and then LARS will
-    // place the result directly into that; then we will not need to have an
-    // extra copy.
-    arma::vec code = codes.unsafe_col(i);
-    arma::rowvec responses = data.unsafe_col(i).t();
-    lars.Train(dictionary, responses, code, false);
+    #pragma omp for schedule(dynamic, 16)
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    {
+      // Create an alias of the code (using the same memory), and then LARS
+      // will place the result directly into that; then we will not need to
+      // have an extra copy.
+      arma::vec code = codes.unsafe_col(i);
+      arma::rowvec responses = data.unsafe_col(i).t();
+      lars.Train(dictionary, responses, code, false);
+    }
   }
 }
 
@@ -15,6 +15,7 @@
 
 #include "svdplusplus_function.hpp"
 #include <mlpack/core/math/make_alias.hpp>
+#include <mlpack/methods/cf/rating_blocks.hpp>
 
 namespace mlpack {
 namespace svd {
@@ -402,19 +403,33 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
   double overallObjective = DBL_MAX;
   double lastObjective;
 
-  // The order in which the functions will be visited.
-  arma::Col<size_t> visitationOrder = arma::linspace<arma::Col<size_t>>(0,
-      (function.NumFunctions() - 1), function.NumFunctions());
-
-  const arma::mat data = function.Dataset();
-  const arma::sp_mat implicitData = function.ImplicitDataset();
+  const arma::sp_mat& implicitData = function.ImplicitDataset();
   const size_t numUsers = function.NumUsers();
   const size_t numItems = function.NumItems();
+  const size_t implicitStart = numUsers + numItems;
   const double lambda = function.Lambda();
 
   // Rank of decomposition.
   const size_t rank = function.Rank();
 
+  // Partition the ratings into a grid of blocks, one row and one column of
+  // blocks per thread.  The threads process the blocks of one stratum at a
+  // time; these share no user or item, so the user and item parameters need no
+  // synchronization.  Only the implicit item vectors, which are shared by all
+  // the users that interacted with an item, are updated atomically.
+  #ifdef HAS_OPENMP
+    const size_t numBlocks = omp_get_max_threads();
+  #else
+    const size_t numBlocks = 1;
+  #endif
+  const mlpack::cf::RatingBlocks blocks(function.Dataset(), numUsers, numItems,
+      numBlocks);
+  const arma::mat& data = blocks.Ratings();
+
+  // The order in which the strata will be visited.
+  std::vector<size_t> strata(numBlocks);
+  std::iota(strata.begin(), strata.end(), 0);
+
   // Iterate till the objective is within tolerance or the maximum number of
   // allowed iterations is reached. If maxIterations is 0, this will iterate
   // till convergence.
@@ -453,96 +468,71 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
     double stepSize = decayPolicy.StepSize(i);
 
     if (shuffle) // Determine order of visitation.
-      std::shuffle(visitationOrder.begin(), visitationOrder.end(),
-          mlpack::math::randGen);
+      std::shuffle(strata.begin(), strata.end(), mlpack::math::RandGen());
 
-    #pragma omp parallel
+    for (size_t s = 0; s < numBlocks; ++s)
     {
-      // Each processor gets a subset of the instances.
-      // Each subset is of size threadShareSize.
-      size_t threadId = 0;
-      #ifdef HAS_OPENMP
-        threadId = omp_get_thread_num();
-      #endif
-
-      for (size_t j = threadId * threadShareSize;
-          j < (threadId + 1) * threadShareSize && j < visitationOrder.n_elem;
-          ++j)
+      #pragma omp parallel for
+      for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
       {
-        // Indices for accessing the the correct parameter columns.
-        const size_t user = data(0, visitationOrder[j]);
-        const size_t item = data(1, visitationOrder[j]) + numUsers;
-        const size_t implicitStart = numUsers + numItems;
-
-        // Prediction error for the example.
-        const double rating = data(2, visitationOrder[j]);
-        const double userBias = iterate(rank, user);
-        const double itemBias = iterate(rank, item);
-        // Iterate through each item which the user interacted with to calculate
-        // user vector.
-        arma::vec userVec(rank, arma::fill::zeros);
-        arma::sp_mat::const_iterator it = implicitData.begin_col(user);
-        arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
-        size_t implicitCount = 0;
-        for (; it != it_end; ++it)
+        const size_t itemBlock = (b + strata[s]) % numBlocks;
+        for (size_t j = blocks.BlockBegin(b, itemBlock);
+            j < blocks.BlockEnd(b, itemBlock); ++j)
         {
-          userVec += iterate.col(implicitStart + it.row()).subvec(0, rank - 1);
-          implicitCount += 1;
-        }
-        if (implicitCount != 0)
-          userVec /= std::sqrt(implicitCount);
-        userVec += iterate.col(user).subvec(0, rank - 1);
-
-        double ratingError = rating - userBias - itemBias -
-        arma::dot(userVec, iterate.col(item).subvec(0, rank - 1));
-
-        arma::mat userVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(user).subvec(0, rank - 1) -
-            ratingError * iterate.col(item).subvec(0, rank - 1));
-        arma::mat itemVecUpdate = stepSize * 2 * (
-            lambda * iterate.col(item).subvec(0, rank - 1) -
-            ratingError * userVec);
-        double userBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, user) - ratingError);
-        double itemBiasUpdate = stepSize * 2 * (
-            lambda * iterate(rank, item) - ratingError);
-
-        // Update of item implicit vectors.
-        arma::mat itemImplicitUpdate(rank, implicitCount);
-        arma::Col<size_t> implicitItems(implicitCount);
-        it = implicitData.begin_col(user);
-        it_end = implicitData.end_col(user);
-        size_t implicitIndex = 0;
-        for (; it != it_end; ++it, ++implicitIndex)
-        {
-          itemImplicitUpdate.col(implicitIndex) =
-              stepSize * 2.0 * (lambda / implicitCount *
-              iterate.col(implicitStart + it.row()).subvec(0, rank - 1) -
-              ratingError / std::sqrt(implicitCount) *
-              iterate.col(item).subvec(0, rank - 1));
-          implicitItems(implicitIndex) = it.row();
-        }
-
-        // Gradient is non-zero only for the parameter columns corresponding to
-        // the example.
-        for (size_t i = 0; i < rank; ++i)
-        {
-          #pragma omp atomic
-          iterate(i, user) -= userVecUpdate(i);
-          #pragma omp atomic
-          iterate(i, item) -= itemVecUpdate(i);
-        }
-        #pragma omp atomic
-        iterate(rank, user) -= userBiasUpdate;
-        #pragma omp atomic
-        iterate(rank, item) -= itemBiasUpdate;
-        for (size_t k = 0; k < implicitCount; ++k)
-        {
-          for (size_t i = 0; i < rank; ++i)
+          // Indices for accessing the the correct parameter columns.
+          const size_t user = data(0, j);
+          const size_t item = data(1, j) + numUsers;
+
+          // Prediction error for the example.
+          const double rating = data(2, j);
+          const double userBias = iterate(rank, user);
+          const double itemBias = iterate(rank, item);
+          // Iterate through each item which the user interacted with to
+          // calculate user vector.
+          arma::vec userVec(rank, arma::fill::zeros);
+          arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+          arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
+          size_t implicitCount = 0;
+          for (; it != it_end; ++it)
+          {
+            userVec += iterate.col(implicitStart + it.row()).subvec(0,
+                rank - 1);
+            implicitCount += 1;
+          }
+          if (implicitCount != 0)
+            userVec /= std::sqrt(implicitCount);
+          userVec += iterate.col(user).subvec(0, rank - 1);
+
+          double ratingError = rating - userBias - itemBias -
+              arma::dot(userVec, iterate.col(item).subvec(0, rank - 1));
+
+          const arma::vec itemVec = iterate.col(item).subvec(0, rank - 1);
+
+          // Gradient is non-zero only for the parameter columns corresponding
+          // to the example.
+          iterate.col(user).subvec(0, rank - 1) -= stepSize * 2 * (
+              lambda * iterate.col(user).subvec(0, rank - 1) -
+              ratingError * itemVec);
+          iterate.col(item).subvec(0, rank - 1) -= stepSize * 2 * (
+              lambda * itemVec - ratingError * userVec);
+          iterate(rank, user) -= stepSize * 2 * (
+              lambda * userBias - ratingError);
+          iterate(rank, item) -= stepSize * 2 * (
+              lambda * itemBias - ratingError);
+
+          // Update of item implicit vectors.
+          it = implicitData.begin_col(user);
+          for (; it != it_end; ++it)
           {
-            #pragma omp atomic
-            iterate(i, implicitStart + implicitItems(k)) -=
-                itemImplicitUpdate(i, k);
+            double* implicitVec = iterate.colptr(implicitStart + it.row());
+            for (size_t k = 0; k < rank; ++k)
+            {
+              const double update = stepSize * 2.0 * (lambda /
+                  implicitCount * implicitVec[k] - ratingError /
+                  std::sqrt(implicitCount) * itemVec[k]);
+              #pragma omp atomic
+              implicitVec[k] -= update;
+            }
           }
         }
       }
@@ -1,6 +1,6 @@
  
 /**
- * @file mothods/time_series_models/seasonal_naive.hpp
+ * @file methods/time_series/seasonal_naive.hpp
  * @author Ashwin
  *
  * Definition of the Seasonal Naive Model for time series data.
@@ -22,15 +22,36 @@ namespace ts /* Time Series methods. */ {
  * Persistence model is the simplest time series model. This is sometimes also
  * called as the naive forecasting method. It simply outputs the value of the
  * previous timestamp as the prediction for the current timestamp.
+ *
+ * With a season of length m, the seasonal naive forecast is the value of the
+ * same timestamp one season earlier, y_hat(t) = y(t - m); a season of 1 (the
+ * default) gives the persistence forecast.  All the forecasts of the model,
+ * including those of Predict(), use the same season.  The first season of a
+ * series has no forecast, and is set to NaN.  Many series of the same length can be forecast at
+ * once with PredictBatch() and ForecastBatch(), which take a matrix with one
+ * series per column (or per row), and a set of series can be followed as new
+ * observations arrive with Update() and Forecast():
+ *
+ * @code
+ * PersistenceModel model(7); // Weekly season.
+ * model.Update(history);     // One row per timestamp, one column per series.
+ * while (ReadObservations(observations)) // One value per series.
+ * {
+ *   model.Update(observations);
+ *   model.Forecast(14, forecasts);
+ * }
+ * @endcode
  */
 class PersistenceModel
 {
  public:
   /**
    * Creates the model.
+   *
+   * @param season Length of the season (1 for the persistence forecast).
    */
-  PersistenceModel();
-  
+  PersistenceModel(const size_t season = 1);
+
   /**
    * This overload can be used to make predictions on train dataset.
    *
@@ -39,8 +60,9 @@ class PersistenceModel
    * @param predictions To store the predictions made on input data.
    */
   template<typename InputType,
-           typename = std::enable_if_t<arma::is_Row<InputType>::value ||
-               arma::is_Col<InputType>::value>>
+           typename = typename std::enable_if<
+               arma::is_Row<InputType>::value ||
+               arma::is_Col<InputType>::value>::type>
   void Predict(const InputType& input, InputType& predictions);
 
   /**
@@ -54,8 +76,9 @@ class PersistenceModel
    * @param predictions To store the predictions made on test data.
    */
   template<typename InputType,
-           typename = std::enable_if_t<arma::is_Row<InputType>::value ||
-               arma::is_Col<InputType>::value>>
+           typename = typename std::enable_if<
+               arma::is_Row<InputType>::value ||
+               arma::is_Col<InputType>::value>::type>
   void Predict(const InputType& train, const InputType& test,
                InputType& predictions);
 
@@ -78,17 +101,98 @@ class PersistenceModel
    *
    * @param train Train data.
    * @param test Test data.
-   * @param presictions To store the predictions made on test data.
+   * @param predictions To store the predictions made on test data.
    */
   void Predict(const arma::mat& train, const arma::mat& test,
                arma::rowvec& predictions);
 
+  /**
+   * Make the in-sample forecasts of many series of the same length at once:
+   * each value is forecast by the value one season earlier.  The first season
+   * of each series has no forecast, and is set to NaN.  The series are handled
+   * in parallel.
+   *
+   * @param series Series, one per column (or one per row, if rowMajor is
+   *     true).
+   * @param predictions To store the forecasts in, with the shape of series.
+   * @param rowMajor If true, each row of series is a series.
+   */
+  void PredictBatch(const arma::mat& series,
+                    arma::mat& predictions,
+                    const bool rowMajor = false) const;
+
+  /**
+   * Forecast the next values of many series of the same length at once.  The
+   * series must be at least one season long.
+   *
+   * @param series Series, one per column (or one per row, if rowMajor is
+   *     true).
+   * @param horizon Number of values to forecast for each series.
+   * @param forecasts To store the forecasts in: horizon rows with one column
+   *     per series (or the transpose, if rowMajor is true).
+   * @param rowMajor If true, each row of series is a series.
+   */
+  void ForecastBatch(const arma::mat& series,
+                     const size_t horizon,
+                     arma::mat& forecasts,
+                     const bool rowMajor = false) const;
+
+  /**
+   * Add new observations of the followed series.  The first call sets the
+   * number of series; only the last season of observations is kept.
+   *
+   * @param observations New observations: one row per timestamp, with one
+   *     column per series.
+   */
+  void Update(const arma::mat& observations);
+
+  /**
+   * Forecast the next values of the series followed with Update(), which must
+   * have seen at least one season of observations.
+   *
+   * @param horizon Number of values to forecast for each series.
+   * @param forecasts To store the forecasts in: horizon rows with one column
+   *     per series.
+   */
+  void Forecast(const size_t horizon, arma::mat& forecasts) const;
+
+  //! Get the length of the season.
+  size_t Season() const { return season; }
+  //! Get the number of series followed with Update().
+  size_t NumSeries() const { return recent.n_cols; }
+  //! Get the number of observations of each series given to Update().
+  size_t NumObservations() const { return numObservations; }
+
+  //! Serialize the model.
+  template<typename Archive>
+  void serialize(Archive& ar, const uint32_t /* version */)
+  {
+    ar(CEREAL_NVP(season));
+    ar(CEREAL_NVP(recent));
+    ar(CEREAL_NVP(numObservations));
+  }
+
+ private:
+  //! The length of the season.
+  size_t season;
+  //! The last season of observations given to Update(); observation t is in
+  //! row t % season.
+  arma::mat recent;
+  //! The number of observations of each series given to Update().
+  size_t numObservations;
+
+  /**
+   * Shift the given series by one season: each value is forecast by the value
+   * one season earlier, and the first season is set to NaN.
+   */
+  template<typename InputType>
+  void Shift(const InputType& input, InputType& predictions) const;
 }; // class PersistenceModel
 
 } // namespace ts
 } // namespace mlpack
 
 // Include implementation.
-#include "persistence_impl.hpp"
+#include "seasonal_naive_impl.hpp"
 
-#endif
\ No newline at end of file
+#endif
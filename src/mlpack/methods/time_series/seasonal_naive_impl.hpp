@@ -1,5 +1,5 @@
 /**
- * @file methods/time_series_models/seasonal_naive_impl.hpp
+ * @file methods/time_series/seasonal_naive_impl.hpp
  * @author Ashwin Ramgopal
  *
  * Implementation of the Seasonal Persistence Model for time series data.
@@ -14,18 +14,26 @@
 
 // In case it hasn't yet been included.
 #include "seasonal_naive.hpp"
-#include "util/lag.hpp"
 
 namespace mlpack {
 namespace ts /* Time Series methods. */ {
 
-PersistenceModel::PersistenceModel() { /* Nothing to do here. */ }
+inline PersistenceModel::PersistenceModel(const size_t season) :
+    season(season),
+    numObservations(0)
+{
+    if (season == 0)
+    {
+        throw std::invalid_argument("PersistenceModel::PersistenceModel(): "
+            "season must be positive!");
+    }
+}
 
 template<typename InputType, typename>
 void PersistenceModel::Predict(const InputType& input,
     InputType& predictions)
 {
-    predictions = Lag(input, 365);
+    Shift(input, predictions);
 }
 
 template<typename InputType, typename>
@@ -51,17 +59,17 @@ void PersistenceModel::Predict(const InputType& train, const InputType& test,
     predictions = concat_pred.tail(test.n_elem);
 }
 
-void PersistenceModel::Predict(const arma::mat& input,
+inline void PersistenceModel::Predict(const arma::mat& input,
     arma::rowvec& predictions)
 {
     // Extracting the last column from the input as arma::rowvec.
     arma::colvec temp = input.col(input.n_cols - 1);
     arma::rowvec temp1 = temp.t();
 
-    predictions = Lag(temp1, 1);
+    Shift(temp1, predictions);
 }
 
-void PersistenceModel::Predict(const arma::mat& train, const arma::mat& test,
+inline void PersistenceModel::Predict(const arma::mat& train, const arma::mat& test,
              arma::rowvec& predictions)
 {
     // Concatenating train and test.
@@ -74,6 +82,145 @@ void PersistenceModel::Predict(const arma::mat& train, const arma::mat& test,
     predictions = concat_pred.tail(test.n_rows);
 }
 
+inline void PersistenceModel::PredictBatch(const arma::mat& series,
+    arma::mat& predictions,
+    const bool rowMajor) const
+{
+    predictions.set_size(series.n_rows, series.n_cols);
+    const size_t length = rowMajor ? series.n_cols : series.n_rows;
+    const size_t first = std::min(season, length);
+
+    if (rowMajor)
+    {
+        // Each timestamp is a contiguous column, so whole columns are shifted.
+        if (first > 0)
+        {
+            predictions.cols(0, first - 1).fill(
+                std::numeric_limits<double>::quiet_NaN());
+        }
+        if (length > season)
+        {
+            predictions.cols(season, length - 1) =
+                series.cols(0, length - 1 - season);
+        }
+    }
+    else
+    {
+        // Each series is a contiguous column; shift them in parallel.
+        #pragma omp parallel for schedule(static)
+        for (omp_size_t s = 0; s < (omp_size_t) series.n_cols; ++s)
+        {
+            const double* in = series.colptr(s);
+            double* out = predictions.colptr(s);
+            std::fill(out, out + first,
+                std::numeric_limits<double>::quiet_NaN());
+            if (length > season)
+                std::copy(in, in + length - season, out + season);
+        }
+    }
+}
+
+inline void PersistenceModel::ForecastBatch(const arma::mat& series,
+    const size_t horizon,
+    arma::mat& forecasts,
+    const bool rowMajor) const
+{
+    const size_t length = rowMajor ? series.n_cols : series.n_rows;
+    if (length < season)
+    {
+        std::ostringstream oss;
+        oss << "PersistenceModel::ForecastBatch(): the series have " << length
+            << " values, but at least one season (" << season << ") is "
+            << "needed!";
+        throw std::invalid_argument(oss.str());
+    }
+
+    // The k-th forecast (starting from 0) repeats the value at the same
+    // position of the last season.
+    const size_t lastSeason = length - season;
+    if (rowMajor)
+    {
+        forecasts.set_size(series.n_rows, horizon);
+        for (size_t k = 0; k < horizon; ++k)
+            forecasts.col(k) = series.col(lastSeason + k % season);
+    }
+    else
+    {
+        forecasts.set_size(horizon, series.n_cols);
+        #pragma omp parallel for schedule(static)
+        for (omp_size_t s = 0; s < (omp_size_t) series.n_cols; ++s)
+        {
+            const double* in = series.colptr(s) + lastSeason;
+            double* out = forecasts.colptr(s);
+            for (size_t k = 0; k < horizon; ++k)
+                out[k] = in[k % season];
+        }
+    }
+}
+
+inline void PersistenceModel::Update(const arma::mat& observations)
+{
+    if (numObservations == 0)
+    {
+        recent.set_size(season, observations.n_cols);
+    }
+    else if (observations.n_cols != recent.n_cols)
+    {
+        std::ostringstream oss;
+        oss << "PersistenceModel::Update(): number of series ("
+            << observations.n_cols << ") does not match number of series "
+            << "seen before (" << recent.n_cols << ")!";
+        throw std::invalid_argument(oss.str());
+    }
+
+    // Only the last season of the observations can be needed.
+    const size_t skip = (observations.n_rows > season) ?
+        observations.n_rows - season : 0;
+    numObservations += skip;
+    for (size_t t = skip; t < observations.n_rows; ++t)
+    {
+        recent.row(numObservations % season) = observations.row(t);
+        ++numObservations;
+    }
+}
+
+inline void PersistenceModel::Forecast(const size_t horizon,
+    arma::mat& forecasts) const
+{
+    if (numObservations < season)
+    {
+        std::ostringstream oss;
+        oss << "PersistenceModel::Forecast(): " << numObservations
+            << " observations were given to Update(), but at least one season "
+            << "(" << season << ") is needed!";
+        throw std::invalid_argument(oss.str());
+    }
+
+    // The k-th forecast repeats observation numObservations - season + k %
+    // season, which is in row (numObservations + k) % season.
+    forecasts.set_size(horizon, recent.n_cols);
+    for (size_t k = 0; k < horizon; ++k)
+        forecasts.row(k) = recent.row((numObservations + k) % season);
+}
+
+template<typename InputType>
+void PersistenceModel::Shift(const InputType& input,
+    InputType& predictions) const
+{
+    predictions.set_size(input.n_elem);
+    const size_t first = std::min(season, (size_t) input.n_elem);
+    if (first > 0)
+    {
+        predictions.head(first).fill(
+            std::numeric_limits<double>::quiet_NaN());
+    }
+    if (input.n_elem > season)
+    {
+        predictions.tail(input.n_elem - season) =
+            input.head(input.n_elem - season);
+    }
+}
+
 } // namespace ts
 } // namespace mlpack
 
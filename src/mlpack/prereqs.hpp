@@ -99,10 +99,12 @@ using enable_if_t = typename enable_if<B, T>::type;
 #include <mlpack/core/cereal/is_saving.hpp>
 #include <mlpack/core/arma_extend/serialize_armadillo.hpp>
 #include <mlpack/core/cereal/array_wrapper.hpp>
+#include <mlpack/core/cereal/ensemble_wrapper.hpp>
 #include <mlpack/core/cereal/pointer_variant_wrapper.hpp>
 #include <mlpack/core/cereal/pointer_vector_variant_wrapper.hpp>
 #include <mlpack/core/cereal/pointer_vector_wrapper.hpp>
 #include <mlpack/core/cereal/pointer_wrapper.hpp>
+#include <mlpack/core/cereal/template_class_version.hpp>
 #include <mlpack/core/data/has_serialize.hpp>
 
 // If we have Boost 1.58 or older and are using C++14, the compilation is likely
@@ -128,6 +130,7 @@ or upgrade Boost to 1.59 or newer.
 // All code should have access to logging.
 #include <mlpack/core/util/log.hpp>
 #include <mlpack/core/util/timers.hpp>
+#include <mlpack/core/util/trace.hpp>
 
 // This can be removed with Visual Studio supports an OpenMP version with
 // unsigned loop variables.
@@ -13,6 +13,7 @@
 #include <mlpack/core.hpp>
 
 #include <mlpack/methods/ann/layer/layer.hpp>
+#include <mlpack/methods/ann/activation_functions/activation_math.hpp>
 #include <mlpack/methods/ann/activation_functions/logistic_function.hpp>
 #include <mlpack/methods/ann/activation_functions/identity_function.hpp>
 #include <mlpack/methods/ann/activation_functions/softsign_function.hpp>
@@ -1241,3 +1242,27 @@ TEST_CASE("TanhExpFunctionTest", "[ActivationFunctionsTest]")
   CheckActivationCorrect<TanhExpFunction>(activationData, desiredActivations);
   CheckDerivativeCorrect<TanhExpFunction>(desiredActivations, desiredDerivatives);
 }
+
+/**
+ * Check the error bounds of the approximate exponential and hyperbolic tangent
+ * used by the activation functions.
+ */
+TEST_CASE("ApproximateActivationMathTest", "[ActivationFunctionsTest]")
+{
+  const arma::vec x = arma::linspace<arma::vec>(-700, 700, 100001);
+  for (size_t i = 0; i < x.n_elem; ++i)
+  {
+    const double exact = std::exp(x[i]);
+    REQUIRE(std::abs(ApproximateExp(x[i]) - exact) <= 1e-8 * exact);
+  }
+
+  const arma::vec t = arma::linspace<arma::vec>(-30, 30, 100001);
+  for (size_t i = 0; i < t.n_elem; ++i)
+    REQUIRE(std::abs(ApproximateTanh(t[i]) - std::tanh(t[i])) <= 1e-8);
+
+  // Inputs outside of the range of a double are clamped.
+  REQUIRE(std::isfinite(ApproximateExp(1000.0)));
+  REQUIRE(ApproximateExp(-1000.0) >= 0.0);
+  REQUIRE(ApproximateTanh(1000.0) == Approx(1.0));
+  REQUIRE(ApproximateTanh(-1000.0) == Approx(-1.0));
+}
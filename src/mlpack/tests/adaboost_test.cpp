@@ -789,6 +789,57 @@ TEST_CASE("TrainTest", "[AdaBoostTest]")
   REQUIRE(lError <= 0.30);
 }
 
+/**
+ * Make sure that classifying a set spanning several blocks gives the same
+ * results as combining the predictions of each weak learner by hand.
+ */
+TEST_CASE("ClassifyBlocksTest", "[AdaBoostTest]")
+{
+  arma::mat inputData;
+  if (!data::Load("iris_train.csv", inputData))
+    FAIL("Cannot load test dataset iris_train.csv!");
+
+  arma::Mat<size_t> labels;
+  if (!data::Load("iris_train_labels.csv", labels))
+    FAIL("Cannot load labels for iris_train_labels.csv");
+
+  const size_t numClasses = max(labels.row(0)) + 1;
+  const arma::Row<size_t> labelsvec = labels.row(0);
+
+  ID3DecisionStump ds(inputData, labelsvec, numClasses);
+  AdaBoost<ID3DecisionStump> a(inputData, labelsvec, numClasses, ds, 20,
+      1e-10);
+
+  // Perturb copies of the training set to get a few blocks of test points.
+  arma::mat testData = arma::repmat(inputData, 1, 100);
+  testData += 0.1 * arma::randn<arma::mat>(testData.n_rows, testData.n_cols);
+
+  arma::Row<size_t> predictedLabels;
+  arma::mat probabilities;
+  a.Classify(testData, predictedLabels, probabilities);
+
+  arma::mat expected(numClasses, testData.n_cols, arma::fill::zeros);
+  arma::Row<size_t> weakPredictions;
+  for (size_t i = 0; i < a.WeakLearners(); ++i)
+  {
+    a.WeakLearner(i).Classify(testData, weakPredictions);
+    for (size_t j = 0; j < testData.n_cols; ++j)
+      expected(weakPredictions[j], j) += a.Alpha(i);
+  }
+
+  REQUIRE(predictedLabels.n_elem == testData.n_cols);
+  for (size_t j = 0; j < testData.n_cols; ++j)
+  {
+    expected.col(j) /= arma::accu(expected.col(j));
+    REQUIRE(predictedLabels[j] == expected.col(j).index_max());
+    for (size_t k = 0; k < numClasses; ++k)
+    {
+      REQUIRE(probabilities(k, j) ==
+          Approx(expected(k, j)).epsilon(1e-10).margin(1e-10));
+    }
+  }
+}
+
 TEST_CASE("PerceptronSerializationTest", "[AdaBoostTest]")
 {
   // Build an AdaBoost object.
@@ -842,6 +893,54 @@ TEST_CASE("PerceptronSerializationTest", "[AdaBoostTest]")
   }
 }
 
+/**
+ * Make sure that only the first weak learners are loaded under an
+ * EnsembleLoadLimit, even when the model is followed by other data.
+ */
+TEST_CASE("AdaBoostPartialLoadTest", "[AdaBoostTest]")
+{
+  mat data = randu<mat>(10, 500);
+  Row<size_t> labels(500);
+  for (size_t i = 0; i < 250; ++i)
+    labels[i] = 0;
+  for (size_t i = 250; i < 500; ++i)
+    labels[i] = 1;
+
+  Perceptron<> p(data, labels, 2, 800);
+  AdaBoost<> ab(data, labels, 2, p, 50, 1e-10);
+  REQUIRE(ab.WeakLearners() > 1);
+  const size_t kept = ab.WeakLearners() / 2;
+
+  Row<size_t> firstPredictions;
+  mat firstProbabilities;
+  ab.Classify(data, firstPredictions, firstProbabilities, kept);
+
+  // The model is saved with a value after it, which must still be read.
+  std::stringstream stream;
+  {
+    cereal::BinaryOutputArchive ar(stream);
+    const size_t after = 12345;
+    ar(CEREAL_NVP(ab), CEREAL_NVP(after));
+  }
+
+  AdaBoost<> partial;
+  size_t after = 0;
+  {
+    cereal::EnsembleLoadLimit limit(kept);
+    cereal::BinaryInputArchive ar(stream);
+    ar(cereal::make_nvp("ab", partial), CEREAL_NVP(after));
+  }
+
+  REQUIRE(after == 12345);
+  REQUIRE(partial.WeakLearners() == kept);
+
+  Row<size_t> predictions;
+  mat probabilities;
+  partial.Classify(data, predictions, probabilities);
+  CheckMatrices(firstPredictions, predictions);
+  CheckMatrices(firstProbabilities, probabilities);
+}
+
 TEST_CASE("ID3DecisionStumpSerializationTest", "[AdaBoostTest]")
 {
   // Build an AdaBoost object.
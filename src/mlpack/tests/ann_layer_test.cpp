@@ -22,6 +22,7 @@
 #include <mlpack/methods/ann/loss_functions/binary_cross_entropy_loss.hpp>
 #include <mlpack/methods/ann/ffn.hpp>
 #include <mlpack/methods/ann/rnn.hpp>
+#include <mlpack/methods/ann/sparse_update/sparse_update.hpp>
 
 #include "test_catch_tools.hpp"
 #include "catch.hpp"
@@ -410,6 +411,51 @@ TEST_CASE("NoAlphaDropoutTest", "[ANNLayerTest]")
   REQUIRE(arma::accu(output) == arma::accu(input));
 }
 
+/**
+ * Make sure that a DropoutMask drops about the right number of elements, and
+ * that a mask can be drawn again from its seed and index.
+ */
+TEST_CASE("DropoutMaskTest", "[ANNLayerTest]")
+{
+  const size_t n = 10000;
+  DropoutMask mask(42);
+  mask.Generate(n, 0.3);
+  const uint64_t stream = mask.Stream();
+
+  size_t kept = 0;
+  for (size_t i = 0; i < n; ++i)
+    kept += mask.Kept(i);
+  REQUIRE(std::abs(kept / (double) n - 0.7) <= 0.02);
+
+  arma::mat input = arma::randu<arma::mat>(100, 100);
+  arma::mat output;
+  mask.Apply(input, output, 2.0);
+  arma::mat unpacked;
+  mask.Unpack(100, 100, unpacked);
+  CheckMatrices(output, 2.0 * (input % unpacked));
+
+  // The next mask is different, but the first one can be drawn again.
+  mask.Generate(n, 0.3);
+  arma::mat other;
+  mask.Unpack(100, 100, other);
+  REQUIRE(arma::accu(arma::abs(other - unpacked)) > 0);
+
+  DropoutMask copy(42);
+  copy.Generate(n, 0.3, stream);
+  arma::mat regenerated;
+  copy.Unpack(100, 100, regenerated);
+  CheckMatrices(regenerated, unpacked);
+
+  // Nothing is dropped with a ratio of zero, and everything with a ratio of
+  // one.
+  mask.Generate(n, 0.0);
+  for (size_t i = 0; i < n; ++i)
+    REQUIRE(mask.Kept(i));
+  mask.Generate(n, 1.0);
+  for (size_t i = 0; i < n; ++i)
+    REQUIRE(!mask.Kept(i));
+}
+
 /**
  * Simple linear module test.
  */
@@ -495,6 +541,173 @@ TEST_CASE("GradientLinearLayerTest", "[ANNLayerTest]")
   REQUIRE(CheckGradient(function) <= 1e-4);
 }
 
+/**
+ * Make sure that the fused LinearActivation layers give the same results as a
+ * Linear layer followed by the activation layer.
+ */
+template<typename FusedType, typename ActivationLayerType>
+void CheckLinearActivation()
+{
+  arma::mat input = arma::randn(10, 5);
+  arma::mat gy = arma::randn(4, 5);
+
+  Linear<> linear(10, 4);
+  linear.Reset();
+  linear.Parameters().randn();
+  ActivationLayerType activation;
+
+  FusedType fused(10, 4);
+  fused.Reset();
+  fused.Parameters() = linear.Parameters();
+
+  arma::mat linearOutput, output, fusedOutput;
+  linear.Forward(input, linearOutput);
+  activation.Forward(linearOutput, output);
+  fused.Forward(input, fusedOutput);
+  CheckMatrices(output, fusedOutput);
+
+  arma::mat activationDelta, delta, fusedDelta;
+  activation.Backward(output, gy, activationDelta);
+  linear.Backward(linearOutput, activationDelta, delta);
+  fused.Backward(fusedOutput, gy, fusedDelta);
+  CheckMatrices(delta, fusedDelta);
+
+  arma::mat gradient(linear.WeightSize(), 1), fusedGradient(fused.WeightSize(),
+      1);
+  linear.Gradient(input, activationDelta, gradient);
+  fused.Gradient(input, gy, fusedGradient);
+  CheckMatrices(gradient, fusedGradient);
+}
+
+TEST_CASE("LinearActivationLayerTest", "[ANNLayerTest]")
+{
+  CheckLinearActivation<LinearReLU<>, ReLULayer<>>();
+  CheckLinearActivation<LinearSigmoid<>, SigmoidLayer<>>();
+}
+
+/**
+ * LinearActivation layer numerical gradient test.
+ */
+TEST_CASE("GradientLinearActivationLayerTest", "[ANNLayerTest]")
+{
+  // LinearActivation function gradient instantiation.
+  struct GradientFunction
+  {
+    GradientFunction() :
+        input(arma::randu(10, 1)),
+        target(arma::mat("0"))
+    {
+      model = new FFN<NegativeLogLikelihood<>, NguyenWidrowInitialization>();
+      model->Predictors() = input;
+      model->Responses() = target;
+      model->Add<IdentityLayer<> >();
+      model->Add<LinearSigmoid<> >(10, 10);
+      model->Add<LinearReLU<> >(10, 5);
+      model->Add<Linear<> >(5, 2);
+      model->Add<LogSoftMax<> >();
+    }
+
+    ~GradientFunction()
+    {
+      delete model;
+    }
+
+    double Gradient(arma::mat& gradient) const
+    {
+      double error = model->Evaluate(model->Parameters(), 0, 1);
+      model->Gradient(model->Parameters(), 0, gradient, 1);
+      return error;
+    }
+
+    arma::mat& Parameters() { return model->Parameters(); }
+
+    FFN<NegativeLogLikelihood<>, NguyenWidrowInitialization>* model;
+    arma::mat input, target;
+  } function;
+
+  REQUIRE(CheckGradient(function) <= 1e-4);
+}
+
+/**
+ * Check that a layer gives the same results in single precision as in double
+ * precision.
+ */
+template<typename LayerType, typename FloatLayerType>
+void CheckFloatLayer(LayerType& layer,
+                     FloatLayerType& floatLayer,
+                     const arma::mat& input)
+{
+  const arma::fmat floatInput = arma::conv_to<arma::fmat>::from(input);
+
+  arma::mat output, delta;
+  arma::fmat floatOutput, floatDelta;
+  layer.Forward(input, output);
+  floatLayer.Forward(floatInput, floatOutput);
+  CheckMatrices(output, arma::conv_to<arma::mat>::from(floatOutput), 1e-1);
+
+  const arma::mat error = arma::randn(output.n_rows, output.n_cols);
+  layer.Backward(output, error, delta);
+  floatLayer.Backward(floatOutput, arma::conv_to<arma::fmat>::from(error),
+      floatDelta);
+  CheckMatrices(delta, arma::conv_to<arma::mat>::from(floatDelta), 1e-1);
+}
+
+/**
+ * Make sure that layers with weights, pooling layers and normalization layers
+ * can be used with arma::fmat.
+ */
+TEST_CASE("FloatLayerTest", "[ANNLayerTest]")
+{
+  const arma::mat input = arma::randn(36, 4);
+
+  Linear<> linear(36, 5);
+  Linear<arma::fmat, arma::fmat> floatLinear(36, 5);
+  linear.Parameters().randn();
+  floatLinear.Parameters() = arma::conv_to<arma::fmat>::from(
+      linear.Parameters());
+  linear.Reset();
+  floatLinear.Reset();
+  CheckFloatLayer(linear, floatLinear, input);
+
+  Convolution<> conv(1, 2, 3, 3, 1, 1, 1, 1, 6, 6);
+  Convolution<NaiveConvolution<ValidConvolution>,
+      NaiveConvolution<FullConvolution>, NaiveConvolution<ValidConvolution>,
+      arma::fmat, arma::fmat> floatConv(1, 2, 3, 3, 1, 1, 1, 1, 6, 6);
+  conv.Parameters().randn();
+  floatConv.Parameters() = arma::conv_to<arma::fmat>::from(conv.Parameters());
+  conv.Reset();
+  floatConv.Reset();
+  CheckFloatLayer(conv, floatConv, input);
+
+  MeanPooling<> meanPooling(2, 2, 2, 2);
+  MeanPooling<arma::fmat, arma::fmat> floatMeanPooling(2, 2, 2, 2);
+  meanPooling.InputWidth() = floatMeanPooling.InputWidth() = 6;
+  meanPooling.InputHeight() = floatMeanPooling.InputHeight() = 6;
+  CheckFloatLayer(meanPooling, floatMeanPooling, input);
+
+  MaxPooling<> maxPooling(2, 2, 2, 2);
+  MaxPooling<arma::fmat, arma::fmat> floatMaxPooling(2, 2, 2, 2);
+  maxPooling.InputWidth() = floatMaxPooling.InputWidth() = 6;
+  maxPooling.InputHeight() = floatMaxPooling.InputHeight() = 6;
+  CheckFloatLayer(maxPooling, floatMaxPooling, input);
+
+  BatchNorm<> batchNorm(36);
+  BatchNorm<arma::fmat, arma::fmat> floatBatchNorm(36);
+  batchNorm.Reset();
+  floatBatchNorm.Reset();
+  CheckFloatLayer(batchNorm, floatBatchNorm, input);
+
+  LayerNorm<> layerNorm(36);
+  LayerNorm<arma::fmat, arma::fmat> floatLayerNorm(36);
+  layerNorm.Reset();
+  floatLayerNorm.Reset();
+  CheckFloatLayer(layerNorm, floatLayerNorm, input);
+
+  LogSoftMax<> logSoftMax;
+  LogSoftMax<arma::fmat, arma::fmat> floatLogSoftMax;
+  CheckFloatLayer(logSoftMax, floatLogSoftMax, input);
+}
+
 /**
  * Simple Linear3D layer test.
  */
@@ -1238,6 +1451,118 @@ TEST_CASE("GradientFastLSTMLayerTest", "[ANNLayerTest]")
   REQUIRE(CheckGradient(function) <= 0.2);
 }
 
+/**
+ * The sigmoid approximation of FastLSTM, applied to every element.
+ */
+arma::mat FastLSTMSigmoid(const arma::mat& input)
+{
+  arma::mat output(arma::size(input));
+  for (size_t i = 0; i < input.n_elem; ++i)
+  {
+    const double x = 0.5 * std::abs(input[i]);
+    double z;
+    if (x < 1.7)
+      z = 1.5 * x / (1 + x);
+    else if (x < 3)
+      z = 0.935409070603099 + 0.0458812946797165 * (x - 1.7);
+    else
+      z = 0.99505475368673;
+
+    output[i] = 0.5 * (((input[i] >= 0) ? z : -z) + 1.0);
+  }
+
+  return output;
+}
+
+/**
+ * Make sure that the fused forward and backward passes of FastLSTM give the
+ * results of the LSTM equations written with Armadillo expressions, over
+ * several steps with a batch of several sequences.
+ */
+TEST_CASE("FastLSTMFusedKernelTest", "[ANNLayerTest]")
+{
+  const size_t inSize = 4, outSize = 5, rho = 3, batchSize = 3;
+
+  FastLSTM<> layer(inSize, outSize, rho);
+  layer.Parameters().randn();
+  layer.Reset();
+
+  const arma::mat& parameters = layer.Parameters();
+  const arma::mat inputWeight(parameters.memptr(), 4 * outSize, inSize);
+  const arma::vec inputBias(parameters.memptr() + inputWeight.n_elem,
+      4 * outSize);
+  const arma::mat outputWeight(parameters.memptr() + inputWeight.n_elem +
+      inputBias.n_elem, 4 * outSize, outSize);
+
+  std::vector<arma::mat> inputs(rho), outputs(rho);
+  std::vector<arma::mat> gates(rho), states(rho), cells(rho);
+  arma::mat prevOutput(outSize, batchSize, arma::fill::zeros);
+  arma::mat prevCell(outSize, batchSize, arma::fill::zeros);
+  for (size_t t = 0; t < rho; ++t)
+  {
+    inputs[t] = arma::randn(inSize, batchSize);
+    layer.Forward(inputs[t], outputs[t]);
+
+    // The rows of the gates are the input, output and forget gates.
+    arma::mat z = inputWeight * inputs[t] + outputWeight * prevOutput;
+    z.each_col() += inputBias;
+    gates[t] = FastLSTMSigmoid(z.rows(0, 3 * outSize - 1));
+    states[t] = arma::tanh(z.rows(3 * outSize, 4 * outSize - 1));
+    cells[t] = gates[t].rows(0, outSize - 1) % states[t] +
+        gates[t].rows(2 * outSize, 3 * outSize - 1) % prevCell;
+    const arma::mat expected = arma::tanh(cells[t]) %
+        gates[t].rows(outSize, 2 * outSize - 1);
+
+    CheckMatrices(outputs[t], expected, 1e-6);
+    prevOutput = expected;
+    prevCell = cells[t];
+  }
+
+  // Backpropagate through time from the last step.
+  arma::mat prevError, cellError(outSize, batchSize, arma::fill::zeros);
+  for (size_t s = 0; s < rho; ++s)
+  {
+    const size_t t = rho - 1 - s;
+    const arma::mat gy = arma::randn(outSize, batchSize);
+    arma::mat g;
+    layer.Backward(inputs[t], gy, g);
+
+    const arma::mat i = gates[t].rows(0, outSize - 1);
+    const arma::mat o = gates[t].rows(outSize, 2 * outSize - 1);
+    const arma::mat f = gates[t].rows(2 * outSize, 3 * outSize - 1);
+    const arma::mat cellActivation = arma::tanh(cells[t]);
+
+    arma::mat error = gy;
+    if (s > 0)
+      error += outputWeight.t() * prevError;
+    const arma::mat nextCellError = cellError;
+    cellError = error % o % (1 - arma::square(cellActivation));
+    if (s > 0)
+      cellError += nextCellError;
+
+    prevError.set_size(4 * outSize, batchSize);
+    prevError.rows(0, outSize - 1) = states[t] % cellError % i % (1 - i);
+    prevError.rows(outSize, 2 * outSize - 1) = cellActivation % error % o %
+        (1 - o);
+    if (t > 0)
+    {
+      prevError.rows(2 * outSize, 3 * outSize - 1) = cells[t - 1] %
+          cellError % f % (1 - f);
+    }
+    else
+    {
+      prevError.rows(2 * outSize, 3 * outSize - 1).zeros();
+    }
+    prevError.rows(3 * outSize, 4 * outSize - 1) = i % cellError %
+        (1 - arma::square(states[t]));
+
+    CheckMatrices(g, inputWeight.t() * prevError, 1e-6);
+
+    // The forget gate takes the cell error back to the previous step.
+    cellError = f % cellError;
+  }
+}
+
 /**
  * Test that the functions that can modify and access the parameters of the
  * Fast LSTM layer work.
@@ -1995,6 +2320,87 @@ TEST_CASE("LookupLayerParametersTest", "[ANNLayerTest]")
   REQUIRE(layer.EmbeddingSize() == 8);
 }
 
+/**
+ * Make sure the compact gradient of the Lookup layer matches its dense
+ * gradient, and that the sparse update rules only touch the embeddings of the
+ * batch.
+ */
+TEST_CASE("LookupLayerSparseGradientTest", "[ANNLayerTest]")
+{
+  const size_t vocabSize = 50;
+  const size_t embeddingSize = 4;
+  const size_t seqLength = 5;
+  const size_t batchSize = 3;
+
+  Lookup<> module(vocabSize, embeddingSize);
+  module.Parameters().randu();
+
+  // Repeated tokens must have their errors summed.
+  arma::mat input(seqLength, batchSize);
+  for (size_t i = 0; i < input.n_elem; ++i)
+    input(i) = math::RandInt(1, 10);
+
+  arma::mat output, gradient;
+  module.Forward(input, output);
+  arma::mat error = arma::randu(embeddingSize * seqLength, batchSize);
+  module.Gradient(input, error, gradient);
+
+  const arma::uvec& indices = module.GradientIndices();
+  REQUIRE(indices.n_elem == arma::unique(input).eval().n_elem);
+  REQUIRE(module.SparseGradient().n_rows == embeddingSize);
+  REQUIRE(module.SparseGradient().n_cols == indices.n_elem);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+  {
+    for (size_t j = 0; j < embeddingSize; ++j)
+    {
+      REQUIRE(module.SparseGradient()(j, i) ==
+          Approx(gradient(j, indices[i])).epsilon(1e-10));
+    }
+  }
+
+  // Columns of tokens that are not in the batch have no gradient.
+  arma::mat touched = gradient.cols(indices);
+  REQUIRE(arma::accu(arma::abs(gradient)) ==
+      Approx(arma::accu(arma::abs(touched))).epsilon(1e-10));
+
+  // A sparse layer leaves the dense gradient as it is.
+  module.Sparse() = true;
+  arma::mat sparseGradient = arma::ones(embeddingSize, vocabSize);
+  module.Gradient(input, error, sparseGradient);
+  REQUIRE(arma::all(arma::vectorise(sparseGradient) == 1.0));
+
+  // A sparse SGD step is the dense SGD step.
+  arma::mat parameters = module.Parameters();
+  SparseSGDUpdate<> sgd(0.1);
+  sgd.Update(parameters, indices, module.SparseGradient());
+  CheckMatrices(parameters, module.Parameters() - 0.1 * gradient);
+
+  // Adagrad and Adam only touch the columns of the batch.
+  arma::uvec untouched(vocabSize - indices.n_elem);
+  for (size_t c = 0, k = 0; c < vocabSize; ++c)
+    if (!arma::any(indices == c))
+      untouched[k++] = c;
+
+  parameters = module.Parameters();
+  SparseAdagradUpdate<> adagrad(0.1);
+  SparseAdamUpdate<> adam(0.1);
+  for (size_t i = 0; i < 3; ++i)
+  {
+    adagrad.Update(parameters, indices, module.SparseGradient());
+    adam.Update(parameters, indices, module.SparseGradient());
+  }
+
+  CheckMatrices(parameters.cols(untouched),
+      module.Parameters().cols(untouched));
+  REQUIRE(adam.Iteration() == 3);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+  {
+    // Both steps move against the (positive) gradient.
+    REQUIRE(arma::all(parameters.col(indices[i]) <
+        module.Parameters().col(indices[i])));
+  }
+}
+
 /**
  * Simple LogSoftMax module test.
  */
@@ -3736,6 +4142,133 @@ TEST_CASE("ConvolutionLayerPaddingTest", "[ANNLayerTest]")
   module2.Backward(input, output, delta);
 }
 
+/**
+ * Make sure that a Convolution layer using Im2ColConvolution computes the same
+ * results as the default convolution rules, with several input and output maps
+ * and points, and that its results are the exact derivatives when the stride is
+ * larger than one.
+ */
+TEST_CASE("Im2ColConvolutionLayerTest", "[ANNLayerTest]")
+{
+  typedef Convolution<Im2ColConvolution<ValidConvolution>,
+                      Im2ColConvolution<FullConvolution>,
+                      Im2ColConvolution<ValidConvolution>> Im2ColLayer;
+
+  // Parameter order: inSize, outSize, kW, kH, dW, dH, padW, padH, inputWidth,
+  // inputHeight.
+  Convolution<> naive(2, 3, 3, 2, 1, 1, 1, 1, 6, 5);
+  Im2ColLayer im2col(2, 3, 3, 2, 1, 1, 1, 1, 6, 5);
+
+  arma::mat parameters = arma::randn(3 * 2 * 3 * 2 + 3, 1);
+  naive.Parameters() = parameters;
+  naive.Reset();
+  im2col.Parameters() = parameters;
+  im2col.Reset();
+
+  arma::mat input = arma::randn(6 * 5 * 2, 4);
+  arma::mat naiveOutput, im2colOutput;
+  naive.Forward(input, naiveOutput);
+  im2col.Forward(input, im2colOutput);
+  CheckMatrices(naiveOutput, im2colOutput, 1e-5);
+
+  arma::mat error = arma::randn(naiveOutput.n_rows, naiveOutput.n_cols);
+  arma::mat naiveDelta, im2colDelta;
+  naive.Backward(input, error, naiveDelta);
+  im2col.Backward(input, error, im2colDelta);
+  CheckMatrices(naiveDelta, im2colDelta, 1e-5);
+
+  // The filter gradients match; the bias gradient is summed over all points.
+  arma::mat naiveGradient, im2colGradient;
+  naive.Gradient(input, error, naiveGradient);
+  im2col.Gradient(input, error, im2colGradient);
+  CheckMatrices(arma::mat(naiveGradient.rows(0, 3 * 2 * 3 * 2 - 1)),
+      arma::mat(im2colGradient.rows(0, 3 * 2 * 3 * 2 - 1)), 1e-5);
+  const size_t mapSize = naiveOutput.n_rows / 3;
+  for (size_t o = 0; o < 3; ++o)
+  {
+    const double biasGradient = arma::accu(error.rows(o * mapSize,
+        (o + 1) * mapSize - 1));
+    REQUIRE(im2colGradient(3 * 2 * 3 * 2 + o) ==
+        Approx(biasGradient).epsilon(1e-5));
+  }
+
+  // With a stride of 2, check the derivatives of sum(output % error) against
+  // finite differences.
+  Im2ColLayer strided(2, 3, 3, 2, 2, 2, 1, 1, 6, 5);
+  strided.Parameters() = parameters;
+  strided.Reset();
+
+  arma::mat output, delta, gradient;
+  strided.Forward(input, output);
+  error = arma::randn(output.n_rows, output.n_cols);
+  strided.Backward(input, error, delta);
+  strided.Gradient(input, error, gradient);
+
+  const double eps = 1e-6;
+  for (size_t i = 0; i < input.n_elem; i += 7)
+  {
+    arma::mat perturbed = input;
+    perturbed[i] += eps;
+    strided.Forward(perturbed, output);
+    const double upper = arma::accu(output % error);
+    perturbed[i] -= 2 * eps;
+    strided.Forward(perturbed, output);
+    const double lower = arma::accu(output % error);
+    REQUIRE((upper - lower) / (2 * eps) ==
+        Approx(delta[i]).epsilon(1e-4).margin(1e-6));
+  }
+
+  for (size_t i = 0; i < parameters.n_elem; ++i)
+  {
+    strided.Parameters()[i] += eps;
+    strided.Forward(input, output);
+    const double upper = arma::accu(output % error);
+    strided.Parameters()[i] -= 2 * eps;
+    strided.Forward(input, output);
+    const double lower = arma::accu(output % error);
+    strided.Parameters()[i] += eps;
+    REQUIRE((upper - lower) / (2 * eps) ==
+        Approx(gradient[i]).epsilon(1e-4).margin(1e-6));
+  }
+}
+
+/**
+ * Make sure that a Convolution layer with 3x3 kernels, which uses the Winograd
+ * algorithm, computes the same results as one using Im2ColConvolution, also
+ * when the output has an odd size.
+ */
+TEST_CASE("WinogradConvolutionLayerTest", "[ANNLayerTest]")
+{
+  typedef Convolution<Im2ColConvolution<ValidConvolution>,
+                      Im2ColConvolution<FullConvolution>,
+                      Im2ColConvolution<ValidConvolution>> Im2ColLayer;
+
+  // Parameter order: inSize, outSize, kW, kH, dW, dH, padW, padH, inputWidth,
+  // inputHeight.
+  Convolution<> winograd(3, 4, 3, 3, 1, 1, 1, 0, 7, 6);
+  Im2ColLayer im2col(3, 4, 3, 3, 1, 1, 1, 0, 7, 6);
+
+  arma::mat parameters = arma::randn(4 * 3 * 3 * 3 + 4, 1);
+  winograd.Parameters() = parameters;
+  winograd.Reset();
+  im2col.Parameters() = parameters;
+  im2col.Reset();
+
+  arma::mat input = arma::randn(7 * 6 * 3, 5);
+  arma::mat winogradOutput, im2colOutput;
+  winograd.Forward(input, winogradOutput);
+  im2col.Forward(input, im2colOutput);
+  REQUIRE(winograd.OutputWidth() == 7);
+  REQUIRE(winograd.OutputHeight() == 4);
+  CheckMatrices(winogradOutput, im2colOutput, 1e-5);
+
+  arma::mat error = arma::randn(winogradOutput.n_rows, winogradOutput.n_cols);
+  arma::mat winogradDelta, im2colDelta;
+  winograd.Backward(input, error, winogradDelta);
+  im2col.Backward(input, error, im2colDelta);
+  CheckMatrices(winogradDelta, im2colDelta, 1e-5);
+}
+
 /**
  * Test that the padding options in Transposed Convolution layer.
  */
@@ -4019,6 +4552,97 @@ TEST_CASE("MaxPoolingTestCase", "[ANNLayerTest]")
   REQUIRE(output.n_cols == 1);
 }
 
+/**
+ * Make sure the unrolled and generic MaxPooling kernels match a direct
+ * computation on several channels and points, forward and backward.
+ */
+TEST_CASE("MaxPoolingBatchTest", "[ANNLayerTest]")
+{
+  const size_t width = 9, height = 7, channels = 3, points = 2;
+  // Kernel width, kernel height, stride width, stride height.
+  const size_t configurations[3][4] = { { 2, 2, 2, 2 }, { 3, 3, 2, 2 },
+      { 3, 2, 1, 1 } };
+
+  for (size_t c = 0; c < 3; ++c)
+  {
+    const size_t kw = configurations[c][0], kh = configurations[c][1];
+    const size_t sw = configurations[c][2], sh = configurations[c][3];
+    const size_t outWidth = (width - kw) / sw + 1;
+    const size_t outHeight = (height - kh) / sh + 1;
+
+    // Integer values, so that there are ties.
+    arma::mat input = arma::floor(5 * arma::randu<arma::mat>(
+        width * height * channels, points));
+
+    MaxPooling<> module(kw, kh, sw, sh);
+    module.InputWidth() = width;
+    module.InputHeight() = height;
+    arma::mat output;
+    module.Forward(input, output);
+    REQUIRE(output.n_rows == outWidth * outHeight * channels);
+    REQUIRE(output.n_cols == points);
+
+    arma::mat gy(output.n_rows, output.n_cols, arma::fill::randu);
+    arma::mat g;
+    module.Backward(input, gy, g);
+    REQUIRE(g.n_rows == input.n_rows);
+
+    arma::mat expectedG(input.n_rows, input.n_cols, arma::fill::zeros);
+    for (size_t p = 0; p < points; ++p)
+    {
+      for (size_t ch = 0; ch < channels; ++ch)
+      {
+        const size_t inOffset = ch * width * height;
+        const size_t outOffset = ch * outWidth * outHeight;
+        for (size_t j = 0; j < outHeight; ++j)
+        {
+          for (size_t i = 0; i < outWidth; ++i)
+          {
+            // The first maximum in column-major order.
+            size_t best = inOffset + i * sw + j * sh * width;
+            for (size_t y = j * sh; y < j * sh + kh; ++y)
+            {
+              for (size_t x = i * sw; x < i * sw + kw; ++x)
+              {
+                if (input(inOffset + x + y * width, p) > input(best, p))
+                  best = inOffset + x + y * width;
+              }
+            }
+
+            const size_t o = outOffset + i + j * outWidth;
+            REQUIRE(output(o, p) == input(best, p));
+            expectedG(best, p) += gy(o, p);
+          }
+        }
+      }
+    }
+
+    CheckMatrices(g, expectedG, 1e-10);
+  }
+}
+
+/**
+ * Jacobian test for the MeanPooling and LpPooling layers, with the unrolled
+ * 2x2 kernel and a generic overlapping kernel.
+ */
+TEST_CASE("MeanLpPoolingJacobianTest", "[ANNLayerTest]")
+{
+  for (size_t k = 2; k <= 3; ++k)
+  {
+    arma::mat input(6 * 5 * 2, 1);
+
+    MeanPooling<> meanPooling(k, k, 2, 1);
+    meanPooling.InputWidth() = 6;
+    meanPooling.InputHeight() = 5;
+    REQUIRE(JacobianTest(meanPooling, input) <= 1e-5);
+
+    LpPooling<> lpPooling(2, k, k, 2, 1);
+    lpPooling.InputWidth() = 6;
+    lpPooling.InputHeight() = 5;
+    REQUIRE(JacobianTest(lpPooling, input) <= 1e-5);
+  }
+}
+
 /**
  * Test that the functions that can modify and access the parameters of the
  * Glimpse layer work.
@@ -4962,6 +5586,71 @@ TEST_CASE("SimpleMultiheadAttentionTest", "[ANNLayerTest]")
   REQUIRE(gradient.n_cols == module.Parameters().n_cols);
 }
 
+/**
+ * Check that the incremental forward pass with the key/value cache gives the
+ * same output as attending over the whole sequence with a causal mask.
+ */
+TEST_CASE("MultiheadAttentionCacheTest", "[ANNLayerTest]")
+{
+  const size_t seqLen = 5;
+  const size_t embedDim = 4;
+  const size_t numHeads = 2;
+
+  arma::mat sequence = arma::randu(embedDim * seqLen, 1);
+  arma::mat attnMask = arma::zeros(seqLen, seqLen);
+  for (size_t i = 0; i < seqLen; ++i)
+  {
+    for (size_t j = i + 1; j < seqLen; ++j)
+      attnMask(i, j) = std::numeric_limits<double>::lowest();
+  }
+
+  MultiheadAttention<> module(seqLen, seqLen, embedDim, numHeads);
+  module.AttentionMask() = attnMask;
+  module.Reset();
+  module.Parameters().randu();
+
+  arma::mat input = arma::join_cols(arma::join_cols(sequence, sequence),
+      sequence);
+  arma::mat output;
+  module.Forward(input, output);
+
+  module.UseCache() = true;
+  module.ResetCache();
+  for (size_t t = 0; t < seqLen; ++t)
+  {
+    const arma::mat token = sequence.rows(t * embedDim,
+        (t + 1) * embedDim - 1);
+    arma::mat stepOutput;
+    module.Forward(arma::mat(arma::join_cols(arma::join_cols(token, token),
+        token)), stepOutput);
+
+    REQUIRE(module.CacheLength() == t + 1);
+    REQUIRE(stepOutput.n_rows == embedDim);
+    REQUIRE(stepOutput.n_cols == 1);
+    CheckMatrices(stepOutput, arma::mat(output.rows(t * embedDim,
+        (t + 1) * embedDim - 1)), 1e-6);
+  }
+
+  // A new sequence starts from an empty cache again.
+  module.ResetCache();
+  REQUIRE(module.CacheLength() == 0);
+
+  // The batch size can't change in the middle of a sequence, but it can for a
+  // new sequence.
+  arma::mat stepOutput;
+  module.Forward(arma::mat(3 * embedDim, 1, arma::fill::randu), stepOutput);
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(module.Forward(arma::mat(3 * embedDim, 2,
+      arma::fill::randu), stepOutput), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+  REQUIRE(module.CacheLength() == 1);
+
+  module.ResetCache();
+  module.Forward(arma::mat(3 * embedDim, 2, arma::fill::randu), stepOutput);
+  REQUIRE(stepOutput.n_cols == 2);
+  REQUIRE(module.CacheLength() == 1);
+}
+
 /**
  * Jacobian MultiheadAttention module test.
  */
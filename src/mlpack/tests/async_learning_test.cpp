@@ -25,6 +25,7 @@
 #include <ensmallen.hpp>
 
 #include "catch.hpp"
+#include "test_catch_tools.hpp"
 
 using namespace mlpack;
 using namespace mlpack::ann;
@@ -246,4 +247,34 @@ TEST_CASE("NStepQLearningTest", "[AsyncLearningTest]")
 
   agent.Train(measure);
   Log::Debug << "Total test episodes: " << testEpisodes << std::endl;
+
+  // Every worker, including the evaluation worker, should have taken steps.
+  REQUIRE(agent.WorkerSteps().n_elem == 17);
+  REQUIRE(agent.WorkerSeconds().n_elem == 17);
+  REQUIRE(arma::all(agent.WorkerSteps() > 0));
+  REQUIRE(arma::all(agent.WorkerStepsPerSecond() >= 0.0));
+}
+
+//! Make sure that striped updates of the shared parameters are correct, even
+//! when there are more stripes than parameters.
+TEST_CASE("ParameterStripesTest", "[AsyncLearningTest]")
+{
+  for (size_t numStripes = 1; numStripes <= 20; ++numStripes)
+  {
+    ParameterStripes stripes(numStripes);
+    REQUIRE(stripes.NumStripes() == numStripes);
+
+    arma::mat shared(7, 1, arma::fill::randu);
+    const arma::mat original = shared;
+    const arma::mat update(7, 1, arma::fill::randu);
+    arma::mat local(7, 1, arma::fill::zeros);
+
+    stripes.Apply(shared, update, local);
+    CheckMatrices(shared, original + update);
+    CheckMatrices(local, shared);
+
+    arma::mat copy(7, 1, arma::fill::zeros);
+    stripes.Copy(shared, copy);
+    CheckMatrices(copy, shared);
+  }
 }
@@ -193,3 +193,40 @@ TEST_CASE("EqualtoRidge", "[BayesianLinearRegressionTest]")
 
   REQUIRE(trial <= 3);
 }
+
+// Check that training on statistics accumulated in chunks gives the same
+// model as training on the whole dataset.
+TEST_CASE("TrainOnStatistics", "[BayesianLinearRegressionTest]")
+{
+  arma::mat matX;
+  arma::rowvec y;
+  GenerateProblem(matX, y, 500, 8, 0.5);
+  matX.row(0) += 3.0;
+  y += 2.0;
+
+  RegressionStatistics stats;
+  for (size_t i = 0; i < 500; i += 120)
+  {
+    const size_t end = std::min(i + 120, (size_t) 500) - 1;
+    stats.Update(matX.cols(i, end), y.subvec(i, end));
+  }
+
+  for (size_t i = 0; i < 4; ++i)
+  {
+    const bool centerData = (i % 2 == 0);
+    const bool scaleData = (i / 2 == 0);
+
+    BayesianLinearRegression blr(centerData, scaleData);
+    const double rmse = blr.Train(matX, y);
+    BayesianLinearRegression streamBlr(centerData, scaleData);
+    const double streamRmse = streamBlr.Train(stats);
+
+    REQUIRE(streamRmse == Approx(rmse).epsilon(1e-5));
+    REQUIRE(streamBlr.Alpha() == Approx(blr.Alpha()).epsilon(1e-5));
+    REQUIRE(streamBlr.Beta() == Approx(blr.Beta()).epsilon(1e-5));
+    REQUIRE(streamBlr.ResponsesOffset() ==
+        Approx(blr.ResponsesOffset()).margin(1e-8));
+    for (size_t j = 0; j < blr.Omega().n_elem; ++j)
+      REQUIRE(streamBlr.Omega()[j] == Approx(blr.Omega()[j]).margin(1e-6));
+  }
+}
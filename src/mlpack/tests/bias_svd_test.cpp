@@ -374,4 +374,55 @@ TEST_CASE("BiasSVDFunctionParallelOptimize", "[BiasSVDTest]")
   REQUIRE(relativeError == Approx(0.0).margin(1e-2));
 }
 
+// Test Bias SVD with block-stratified parallel SGD.
+TEST_CASE("BiasSVDFunctionBlockParallelOptimize", "[BiasSVDTest]")
+{
+  const size_t numUsers = 50;
+  const size_t numItems = 50;
+  const size_t numRatings = 100;
+  const size_t rank = 10;
+  const double lambda = 0.01;
+
+  // Make a random rating dataset, with ratings given by random parameters.
+  arma::mat parameters = arma::randu(rank + 1, numUsers + numItems);
+  arma::mat data = arma::randu(3, numRatings);
+  data.row(0) = floor(data.row(0) * numUsers);
+  data.row(1) = floor(data.row(1) * numItems);
+  data(0, numRatings - 1) = numUsers - 1;
+  data(1, numRatings - 1) = numItems - 1;
+  for (size_t i = 0; i < numRatings; ++i)
+  {
+    const size_t user = data(0, i);
+    const size_t item = data(1, i) + numUsers;
+    data(2, i) = parameters(rank, user) + parameters(rank, item) +
+        arma::dot(parameters.col(user).subvec(0, rank - 1),
+                  parameters.col(item).subvec(0, rank - 1));
+  }
+
+  // The ExponentialBackoff specialization of ParallelSGD processes the
+  // ratings in conflict-free blocks.
+  BiasSVDFunction<arma::mat> biasSVDFunc(data, rank, lambda);
+  ens::ExponentialBackoff decayPolicy(1000000, 0.01, 0.5);
+  ens::ParallelSGD<ens::ExponentialBackoff> optimizer(0, numRatings, 1e-5,
+      true, decayPolicy);
+
+  arma::mat optParameters = arma::randu(rank + 1, numUsers + numItems);
+  optimizer.Optimize(biasSVDFunc, optParameters);
+
+  arma::mat predictedData(1, numRatings);
+  for (size_t i = 0; i < numRatings; ++i)
+  {
+    const size_t user = data(0, i);
+    const size_t item = data(1, i) + numUsers;
+    predictedData(0, i) = optParameters(rank, user) +
+        optParameters(rank, item) +
+        arma::dot(optParameters.col(user).subvec(0, rank - 1),
+                  optParameters.col(item).subvec(0, rank - 1));
+  }
+
+  const double relativeError = arma::norm(data.row(2) - predictedData, "frob") /
+                               arma::norm(data, "frob");
+  REQUIRE(relativeError == Approx(0.0).margin(1e-2));
+}
+
 #endif
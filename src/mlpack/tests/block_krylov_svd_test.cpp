@@ -106,3 +106,36 @@ TEST_CASE("RandomizedBlockKrylovSVDNoisyLowRankTest", "[BlockKrylovSVDTest]")
   double error = arma::max(arma::abs(s1.subvec(0, rank) - s2.subvec(0, rank)));
   REQUIRE(error == Approx(0.0).margin(1e-4));
 }
+
+/**
+ * The method should reconstruct sparse single precision data of low rank, with
+ * every orthogonalization strategy.
+ */
+TEST_CASE("RandomizedBlockKrylovSVDSparseFloatTest", "[BlockKrylovSVDTest]")
+{
+  // Make a low rank matrix with only one row in ten filled.
+  arma::fmat lowRank = arma::randn<arma::fmat>(200, 4) *
+      arma::randn<arma::fmat>(4, 400);
+  for (size_t i = 0; i < lowRank.n_rows; ++i)
+  {
+    if (i % 10 != 0)
+      lowRank.row(i).zeros();
+  }
+  const arma::sp_fmat data(lowRank);
+
+  const svd::OrthogonalizationType types[] = { svd::LU_ORTHOGONALIZATION,
+      svd::QR_ORTHOGONALIZATION, svd::CHOLESKY_QR_ORTHOGONALIZATION };
+  for (const svd::OrthogonalizationType type : types)
+  {
+    arma::fmat U, V;
+    arma::fvec s;
+    svd::RandomizedBlockKrylovSVD rSVD(2, 0, type);
+    rSVD.Apply(data, U, s, V, 4);
+
+    const arma::fmat reconstruct = U.cols(0, 3) *
+        arma::diagmat(s.subvec(0, 3)) * V.cols(0, 3).t();
+    const double error = arma::norm(lowRank - reconstruct, "fro") /
+        arma::norm(lowRank, "fro");
+    REQUIRE(error == Approx(0.0).margin(1e-3));
+  }
+}
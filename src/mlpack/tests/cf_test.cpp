@@ -13,6 +13,8 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/methods/cf/cf.hpp>
+#include <mlpack/methods/cf/rating_blocks.hpp>
+#include <mlpack/methods/cf/decomposition_policies/als_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/batch_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/bias_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/randomized_svd_method.hpp>
@@ -578,6 +580,15 @@ TEST_CASE("CFGetRecommendationsAllUsersSVDPPTest", "[CFTest]")
   GetRecommendationsAllUsers<SVDPlusPlusPolicy>();
 }
 
+/**
+ * Make sure that correct number of recommendations are generated when query
+ * set for alternating least squares.
+ */
+TEST_CASE("CFGetRecommendationsAllUsersALSTest", "[CFTest]")
+{
+  GetRecommendationsAllUsers<ALSPolicy>();
+}
+
 /**
  * Make sure that the recommendations are generated for queried users only
  * for randomized SVD.
@@ -786,6 +797,13 @@ TEST_CASE("CFPredictSVDPPTest", "[CFTest]")
   CFPredict<SVDPlusPlusPolicy>();
 }
 
+// Make sure that Predict() is returning reasonable results for alternating
+// least squares.
+TEST_CASE("CFPredictALSTest", "[CFTest]")
+{
+  CFPredict<ALSPolicy>();
+}
+
 // Compare batch Predict() and individual Predict() for randomized SVD.
 TEST_CASE("CFBatchPredictRandSVDTest", "[CFTest]")
 {
@@ -838,6 +856,13 @@ TEST_CASE("CFBatchPredictSVDPPTest", "[CFTest]")
   BatchPredict<SVDPlusPlusPolicy>();
 }
 
+// Make sure that batch Predict() matches the individual Predict() calls for
+// alternating least squares.
+TEST_CASE("CFBatchPredictALSTest", "[CFTest]")
+{
+  BatchPredict<ALSPolicy>();
+}
+
 /**
  * Make sure we can train an already-trained model and it works okay for
  * randomized SVD.
@@ -1225,3 +1250,288 @@ TEST_CASE("CFPredictRegressionInterpolation", "[CFTest]")
             EuclideanSearch,
             RegressionInterpolation>(2.0);
 }
+
+// Make sure that GetRatingOfUsers() gives the same ratings as
+// GetRatingOfUser(), with all the items or a subset of them.
+template<typename DecompositionPolicy>
+void GetRatingOfUsers()
+{
+  DecompositionPolicy decomposition;
+
+  arma::mat dataset;
+  arma::mat savedCols;
+  GetDatasets(dataset, savedCols);
+
+  CFType<DecompositionPolicy> c(dataset, decomposition, 5, 5, 30);
+
+  arma::Col<size_t> users("3 0 17 3 199");
+  arma::mat ratings;
+  c.Decomposition().GetRatingOfUsers(users, ratings);
+
+  REQUIRE(ratings.n_cols == users.n_elem);
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    arma::vec rating;
+    c.Decomposition().GetRatingOfUser(users[i], rating);
+    REQUIRE(ratings.n_rows == rating.n_elem);
+    for (size_t j = 0; j < rating.n_elem; ++j)
+      REQUIRE(ratings(j, i) == Approx(rating[j]).epsilon(1e-10).margin(1e-10));
+  }
+
+  // The ratings of a subset of the items, in any order, must be the matching
+  // rows.
+  arma::Col<size_t> items("7 2 7 0 41");
+  arma::mat itemRatings;
+  c.Decomposition().GetRatingOfUsers(users, items, itemRatings);
+
+  REQUIRE(itemRatings.n_rows == items.n_elem);
+  REQUIRE(itemRatings.n_cols == users.n_elem);
+  for (size_t i = 0; i < users.n_elem; ++i)
+  {
+    for (size_t j = 0; j < items.n_elem; ++j)
+    {
+      REQUIRE(itemRatings(j, i) ==
+          Approx(ratings(items[j], i)).epsilon(1e-10).margin(1e-10));
+    }
+  }
+}
+
+// Make sure that GetRatingOfUsers() is correct for regularized SVD.
+TEST_CASE("CFGetRatingOfUsersRegSVDTest", "[CFTest]")
+{
+  GetRatingOfUsers<RegSVDPolicy>();
+}
+
+// Make sure that GetRatingOfUsers() is correct for Bias SVD.
+TEST_CASE("CFGetRatingOfUsersBiasSVDTest", "[CFTest]")
+{
+  GetRatingOfUsers<BiasSVDPolicy>();
+}
+
+// Make sure that GetRatingOfUsers() is correct for SVDPlusPlus.
+TEST_CASE("CFGetRatingOfUsersSVDPPTest", "[CFTest]")
+{
+  GetRatingOfUsers<SVDPlusPlusPolicy>();
+}
+
+/**
+ * Make sure that the block size used by GetRecommendations() doesn't change
+ * the recommendations (up to rounding, which may swap items with nearly equal
+ * ratings at the end of the list).
+ */
+TEST_CASE("CFGetRecommendationsBlockSizeTest", "[CFTest]")
+{
+  RegSVDPolicy decomposition;
+
+  arma::mat dataset;
+  arma::mat savedCols;
+  GetDatasets(dataset, savedCols);
+
+  CFType<RegSVDPolicy> c(dataset, decomposition, 5, 5, 30);
+
+  arma::Col<size_t> users = arma::linspace<arma::Col<size_t> >(0,
+      c.CleanedData().n_cols - 1, c.CleanedData().n_cols);
+  arma::Mat<size_t> recommendations, blockRecommendations;
+  c.GetRecommendations(10, recommendations, users, 1);
+  c.GetRecommendations(10, blockRecommendations, users, 1000);
+
+  REQUIRE(recommendations.n_rows == blockRecommendations.n_rows);
+  REQUIRE(recommendations.n_cols == blockRecommendations.n_cols);
+
+  for (size_t i = 0; i < recommendations.n_cols; ++i)
+  {
+    size_t common = 0;
+    for (size_t j = 0; j < recommendations.n_rows; ++j)
+    {
+      if (arma::any(blockRecommendations.col(i) == recommendations(j, i)))
+        ++common;
+
+      // No item the user already rated may be recommended.
+      REQUIRE((double) c.CleanedData()(recommendations(j, i), users[i]) ==
+          0.0);
+    }
+
+    REQUIRE(common >= recommendations.n_rows - 1);
+  }
+}
+
+/**
+ * Make sure that folding in a copy of an existing user gives the same latent
+ * vector that alternating least squares found for that user, since the last
+ * half-step of ALS solves the same least squares problem.
+ */
+TEST_CASE("CFFoldInUserALSTest", "[CFTest]")
+{
+  ALSPolicy decomposition;
+
+  arma::mat dataset;
+  arma::mat savedCols;
+  GetDatasets(dataset, savedCols);
+
+  CFType<ALSPolicy> c(dataset, decomposition, 5, 5, 30);
+  const size_t numUsers = c.CleanedData().n_cols;
+  const size_t user = 7;
+
+  arma::Col<size_t> items;
+  arma::vec ratings;
+  arma::sp_mat::const_iterator it = c.CleanedData().begin_col(user);
+  for (; it != c.CleanedData().end_col(user); ++it)
+  {
+    items.resize(items.n_elem + 1);
+    ratings.resize(ratings.n_elem + 1);
+    items[items.n_elem - 1] = it.row();
+    ratings[ratings.n_elem - 1] = *it;
+  }
+
+  const size_t newUser = c.FoldInUser(items, ratings,
+      c.Decomposition().Lambda());
+
+  REQUIRE(newUser == numUsers);
+  REQUIRE(c.CleanedData().n_cols == numUsers + 1);
+  REQUIRE(c.Decomposition().H().n_cols == numUsers + 1);
+  REQUIRE(c.CleanedData().col(newUser).n_nonzero == items.n_elem);
+
+  for (size_t i = 0; i < c.Decomposition().H().n_rows; ++i)
+  {
+    REQUIRE(c.Decomposition().H()(i, newUser) ==
+        Approx(c.Decomposition().H()(i, user)).epsilon(1e-5).margin(1e-8));
+  }
+
+  // The new user can be queried, and is never recommended an item it rated.
+  arma::Col<size_t> users(2);
+  users[0] = user;
+  users[1] = newUser;
+  arma::Mat<size_t> recommendations;
+  c.GetRecommendations(5, recommendations, users);
+  REQUIRE(recommendations.n_cols == 2);
+  for (size_t i = 0; i < recommendations.n_rows; ++i)
+  {
+    REQUIRE(recommendations(i, 1) < c.CleanedData().n_rows);
+    REQUIRE(c.CleanedData()(recommendations(i, 1), newUser) == 0.0);
+  }
+}
+
+/**
+ * Make sure that a new item can be folded into a model with biases and user
+ * mean normalization, and that the predictions for it are reasonable.
+ */
+TEST_CASE("CFFoldInItemBiasSVDTest", "[CFTest]")
+{
+  BiasSVDPolicy decomposition;
+
+  arma::mat dataset;
+  arma::mat savedCols;
+  GetDatasets(dataset, savedCols);
+
+  CFType<BiasSVDPolicy, UserMeanNormalization> c(dataset, decomposition, 5,
+      5, 30);
+  const size_t numItems = c.CleanedData().n_rows;
+  const size_t numUsers = c.CleanedData().n_cols;
+
+  // Give every third user a rating of 4 for the new item.
+  arma::Col<size_t> users = arma::regspace<arma::Col<size_t>>(0, 3,
+      numUsers - 1);
+  arma::vec ratings(users.n_elem);
+  ratings.fill(4.0);
+
+  const size_t newItem = c.FoldInItem(users, ratings);
+  REQUIRE(newItem == numItems);
+  REQUIRE(c.CleanedData().n_rows == numItems + 1);
+  REQUIRE(c.Decomposition().W().n_rows == numItems + 1);
+
+  double totalError = 0.0;
+  for (size_t i = 0; i < users.n_elem; ++i)
+    totalError += std::pow(c.Predict(users[i], newItem) - 4.0, 2.0);
+  REQUIRE(std::sqrt(totalError / users.n_elem) < 1.5);
+
+  // A user who rated the new item never gets it recommended.
+  arma::Mat<size_t> recommendations;
+  c.GetRecommendations(10, recommendations, users);
+  REQUIRE(arma::accu(recommendations == newItem) == 0);
+}
+
+/**
+ * Make sure that NonNegativeFoldIn() finds the nonnegative least squares
+ * solution, and that a user folded into an NMF model has no negative factors.
+ */
+TEST_CASE("CFFoldInUserNMFNonNegativeTest", "[CFTest]")
+{
+  // Ratings that the unconstrained solution can only fit with negative
+  // factors.
+  arma::mat factors = arma::randu<arma::mat>(20, 4);
+  arma::vec ratings = factors * arma::vec({ 2.0, -1.0, 0.5, -3.0 });
+
+  arma::vec x;
+  NonNegativeFoldIn(factors, ratings, 0.01, x);
+  REQUIRE(x.n_elem == 4);
+  REQUIRE(arma::all(x >= 0.0));
+
+  // Check the optimality conditions: the gradient is zero on the positive
+  // coordinates and nonnegative on the zero ones.
+  arma::mat gram = factors.t() * factors;
+  gram.diag() += 0.01 * ratings.n_elem;
+  const arma::vec gradient = gram * x - factors.t() * ratings;
+  for (size_t j = 0; j < x.n_elem; ++j)
+  {
+    if (x[j] > 0.0)
+      REQUIRE(gradient[j] == Approx(0.0).margin(1e-6));
+    else
+      REQUIRE(gradient[j] >= -1e-6);
+  }
+
+  NMFPolicy decomposition;
+
+  arma::mat dataset;
+  arma::mat savedCols;
+  GetDatasets(dataset, savedCols);
+
+  CFType<NMFPolicy> c(dataset, decomposition, 5, 5, 30);
+  const size_t numUsers = c.CleanedData().n_cols;
+
+  // Rate the first items very differently.
+  arma::Col<size_t> items = arma::regspace<arma::Col<size_t>>(0, 9);
+  arma::vec newRatings(items.n_elem);
+  for (size_t i = 0; i < items.n_elem; ++i)
+    newRatings[i] = (i % 2 == 0) ? 5.0 : 0.5;
+
+  const size_t newUser = c.FoldInUser(items, newRatings, 0.01);
+  REQUIRE(newUser == numUsers);
+  REQUIRE(c.Decomposition().H().n_cols == numUsers + 1);
+  REQUIRE(arma::all(c.Decomposition().H().col(newUser) >= 0.0));
+}
+
+/**
+ * Make sure that RatingBlocks keeps every rating, that each block only holds
+ * the ratings of its users and items, and that blocks are sorted by user.
+ */
+TEST_CASE("RatingBlocksPartitionTest", "[CFTest]")
+{
+  const size_t numUsers = 40;
+  const size_t numItems = 30;
+  const size_t numBlocks = 4;
+
+  arma::mat data = arma::randu(3, 500);
+  data.row(0) = arma::floor(data.row(0) * numUsers);
+  data.row(1) = arma::floor(data.row(1) * numItems);
+
+  RatingBlocks blocks(data, numUsers, numItems, numBlocks);
+  const arma::mat& ratings = blocks.Ratings();
+
+  REQUIRE(ratings.n_cols == data.n_cols);
+  REQUIRE(blocks.BlockEnd(numBlocks - 1, numBlocks - 1) == data.n_cols);
+  REQUIRE(arma::accu(ratings.row(2)) == Approx(arma::accu(data.row(2))));
+
+  for (size_t u = 0; u < numBlocks; ++u)
+  {
+    for (size_t v = 0; v < numBlocks; ++v)
+    {
+      for (size_t j = blocks.BlockBegin(u, v); j < blocks.BlockEnd(u, v); ++j)
+      {
+        REQUIRE(blocks.UserBlock(ratings(0, j)) == u);
+        REQUIRE(blocks.ItemBlock(ratings(1, j)) == v);
+        if (j > blocks.BlockBegin(u, v))
+          REQUIRE(ratings(0, j - 1) <= ratings(0, j));
+      }
+    }
+  }
+}
@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/bindings/cli/cli_option.hpp>
+#include <mlpack/bindings/cli/serve.hpp>
 #include <mlpack/core/kernels/gaussian_kernel.hpp>
 
 #include "catch.hpp"
@@ -628,3 +629,46 @@ TEST_CASE("DeleteAllocatedMemoryModelTest", "[CLIOptionTest]")
   DeleteAllocatedMemory<GaussianKernel*>((util::ParamData&) d,
       (const void*) NULL, (void*) NULL);
 }
+
+/**
+ * Make sure that a Server runs the program once per request, starting each
+ * request from the options given on the command line.
+ */
+TEST_CASE("ServerHandleTest", "[CLIOptionTest]")
+{
+  IO::ClearSettings();
+  CLIOption<double> in(1.0, "in", "in", "", "double", false, true, false);
+  CLIOption<double> out(0.0, "out", "out", "", "double", false, false, false);
+
+  // Pretend that --in 2 was given on the command line.
+  IO::GetParam<double>("in") = 2.0;
+  IO::SetPassed("in");
+
+  size_t runs = 0;
+  {
+    Server server([&runs]()
+    {
+      ++runs;
+      IO::GetParam<double>("out") = 2 * IO::GetParam<double>("in");
+    });
+
+    REQUIRE(server.Handle("") == "out: 4\nok\n");
+    REQUIRE(server.Handle("--in 3.5") == "out: 7\nok\n");
+    REQUIRE(server.Handle("") == "out: 4\nok\n");
+
+    // An invalid request gives an error, and does not stop the server.
+    REQUIRE(server.Handle("--unknown 1").substr(0, 7) == "error: ");
+    REQUIRE(server.Handle("--in 1") == "out: 2\nok\n");
+
+    // Requests can also be read from a stream.
+    std::istringstream requests("--in 5\n--in 6\n");
+    std::ostringstream replies;
+    server.Serve(requests, replies);
+    REQUIRE(replies.str() == "out: 10\nok\nout: 12\nok\n");
+  }
+
+  REQUIRE(runs == 6);
+  REQUIRE(IO::GetParam<double>("in") == 2.0);
+
+  IO::ClearSettings();
+}
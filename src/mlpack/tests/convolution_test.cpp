@@ -16,6 +16,8 @@
 #include <mlpack/methods/ann/convolution_rules/naive_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/fft_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/svd_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/im2col_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/winograd_convolution.hpp>
 
 #include "serialization.hpp"
 #include "catch.hpp"
@@ -148,6 +150,13 @@ TEST_CASE("ValidConvolution2DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution2DMethodTest<SVDConvolution<ValidConvolution> >(input, filter,
       output);
+
+  // Perform the convolution through im2col and a matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<ValidConvolution> >(input,
+      filter, output);
+  // Perform the convolution with the Winograd algorithm.
+  Convolution2DMethodTest<WinogradConvolution<ValidConvolution> >(input,
+      filter, output);
 }
 
 /**
@@ -185,6 +194,13 @@ TEST_CASE("FullConvolution2DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution2DMethodTest<SVDConvolution<FullConvolution> >(input, filter,
       output);
+
+  // Perform the convolution through im2col and a matrix multiplication.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input,
+      filter, output);
+  // Perform the convolution with the Winograd algorithm.
+  Convolution2DMethodTest<WinogradConvolution<FullConvolution> >(input,
+      filter, output);
 }
 
 /**
@@ -230,6 +246,10 @@ TEST_CASE("ValidConvolution3DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution3DMethodTest<SVDConvolution<ValidConvolution> >(inputCube,
       filterCube, outputCube);
+
+  // Perform the convolution through im2col and a matrix multiplication.
+  Convolution3DMethodTest<Im2ColConvolution<ValidConvolution> >(inputCube,
+      filterCube, outputCube);
 }
 
 /**
@@ -279,6 +299,10 @@ TEST_CASE("FullConvolution3DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution3DMethodTest<SVDConvolution<FullConvolution> >(inputCube,
       filterCube, outputCube);
+
+  // Perform the convolution through im2col and a matrix multiplication.
+  Convolution3DMethodTest<Im2ColConvolution<FullConvolution> >(inputCube,
+      filterCube, outputCube);
 }
 
 /**
@@ -321,6 +345,10 @@ TEST_CASE("ValidConvolutionBatchTest", "[ConvolutionTest]")
   // speed up the computation.
   ConvolutionMethodBatchTest<SVDConvolution<ValidConvolution> >(input,
       filterCube, outputCube);
+
+  // Perform the convolution through im2col and a matrix multiplication.
+  ConvolutionMethodBatchTest<Im2ColConvolution<ValidConvolution> >(input,
+      filterCube, outputCube);
 }
 
 /**
@@ -367,4 +395,8 @@ TEST_CASE("FullConvolutionBatchTest", "[ConvolutionTest]")
   // speed up the computation.
   ConvolutionMethodBatchTest<SVDConvolution<FullConvolution> >(input,
       filterCube, outputCube);
+
+  // Perform the convolution through im2col and a matrix multiplication.
+  ConvolutionMethodBatchTest<Im2ColConvolution<FullConvolution> >(input,
+      filterCube, outputCube);
 }
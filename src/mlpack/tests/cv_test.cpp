@@ -531,6 +531,34 @@ TEST_CASE("KFoldCVAccuracyTest", "[CVTest]")
   REQUIRE_NOTHROW(cv.Model());
 }
 
+/**
+ * Make sure that training the folds in parallel gives the same result as
+ * training them serially.
+ */
+TEST_CASE("KFoldCVParallelTest", "[CVTest]")
+{
+  arma::mat data("0 1 2 3 100 101 102 103 104 5");
+  arma::Row<size_t> labels("0 0 0 0 1 1 1 1 1 1");
+  size_t numClasses = 2;
+
+  KFoldCV<NaiveBayesClassifier<>, Accuracy> cv(10, data, labels, numClasses,
+      false);
+  KFoldCV<NaiveBayesClassifier<>, Accuracy> parallelCV(10, data, labels,
+      numClasses, false);
+  REQUIRE(parallelCV.Parallel() == false);
+  parallelCV.Parallel() = true;
+
+  REQUIRE(parallelCV.Evaluate() == Approx(cv.Evaluate()).epsilon(1e-7));
+
+  // The model of the last fold should be kept.
+  REQUIRE(parallelCV.Model().Means().n_elem == cv.Model().Means().n_elem);
+  for (size_t i = 0; i < cv.Model().Means().n_elem; ++i)
+  {
+    REQUIRE(parallelCV.Model().Means()[i] ==
+        Approx(cv.Model().Means()[i]).epsilon(1e-7));
+  }
+}
+
 /**
  * Test k-fold cross-validation with weighted linear regression.
  */
@@ -779,3 +807,69 @@ TEST_CASE("SilhouetteScoreTest", "[CVTest]")
   double silhouetteScore = SilhouetteScore::Overall(X, labels, metric);
   REQUIRE(silhouetteScore == Approx(0.1121684822489150).epsilon(1e-7));
 }
+
+/**
+ * Make sure the streamed silhouette scores match the scores computed from the
+ * full pairwise distance matrix.
+ */
+TEST_CASE("SilhouetteScoreStreamingTest", "[CVTest]")
+{
+  // More points than one block of the streamed computation.
+  arma::mat X(3, 1500, arma::fill::randu);
+  X.cols(0, 499) += 2.0;
+  X.cols(1000, 1499) -= 2.0;
+  arma::Row<size_t> labels(1500);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    labels[i] = (i < 500) ? 3 : ((i < 1000) ? 7 : 11);
+  // A cluster with a single element.
+  labels[42] = 20;
+
+  metric::EuclideanDistance metric;
+  const arma::mat distances = PairwiseDistances(X, metric);
+  const arma::rowvec expected = SilhouetteScore::SamplesScore(distances,
+      labels);
+  const arma::rowvec scores = SilhouetteScore::SamplesScore(X, labels,
+      metric);
+
+  REQUIRE(scores.n_elem == expected.n_elem);
+  REQUIRE(scores[42] == 0.0);
+  for (size_t i = 0; i < scores.n_elem; ++i)
+    REQUIRE(scores[i] == Approx(expected[i]).epsilon(1e-7).margin(1e-10));
+}
+
+/**
+ * Make sure the sampled silhouette score estimate is close to the exact score
+ * and its confidence interval contains it.
+ */
+TEST_CASE("SilhouetteScoreEstimateTest", "[CVTest]")
+{
+  arma::mat X(2, 2000, arma::fill::randu);
+  X.cols(1000, 1999) += 1.5;
+  arma::Row<size_t> labels(2000);
+  labels.head(1000).fill(0);
+  labels.tail(1000).fill(1);
+
+  metric::EuclideanDistance metric;
+  const double exact = SilhouetteScore::Overall(X, labels, metric);
+
+  double lower, upper;
+  const double estimate = SilhouetteScore::OverallEstimate(X, labels, metric,
+      400, lower, upper, 0.999);
+  REQUIRE(lower <= estimate);
+  REQUIRE(estimate <= upper);
+  REQUIRE(lower <= exact);
+  REQUIRE(exact <= upper);
+  REQUIRE(upper - lower < 0.1);
+
+  // With as many samples as points, the estimate is exact.
+  const double full = SilhouetteScore::OverallEstimate(X, labels, metric,
+      2000, lower, upper);
+  REQUIRE(full == Approx(exact).epsilon(1e-10));
+  REQUIRE(lower == full);
+  REQUIRE(upper == full);
+
+  REQUIRE_THROWS_AS(SilhouetteScore::OverallEstimate(X, labels, metric, 0,
+      lower, upper), std::invalid_argument);
+  REQUIRE_THROWS_AS(SilhouetteScore::OverallEstimate(X, labels, metric, 10,
+      lower, upper, 1.0), std::invalid_argument);
+}
@@ -0,0 +1,180 @@
+/**
+ * @file tests/data_parallel_test.cpp
+ *
+ * Tests for the data-parallel training of neural networks, with processes
+ * simulated by threads.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+
+#include <mlpack/methods/ann/layer/layer.hpp>
+#include <mlpack/methods/ann/ffn.hpp>
+#include <mlpack/methods/ann/distributed/data_parallel.hpp>
+
+#include <ensmallen.hpp>
+#include <thread>
+
+#include "catch.hpp"
+#include "test_catch_tools.hpp"
+#include "thread_communicator.hpp"
+
+using namespace mlpack;
+using namespace mlpack::ann;
+using namespace mlpack::distributed;
+
+/**
+ * Check the conversions to and from half precision.
+ */
+TEST_CASE("HalfPrecisionConversionTest", "[DataParallelTest]")
+{
+  // Every half precision number (except NaNs) is converted back exactly.
+  for (size_t h = 0; h < 65536; ++h)
+  {
+    const float value = FromHalf((uint16_t) h);
+    if (!std::isnan(value))
+      REQUIRE(ToHalf(value) == h);
+  }
+
+  REQUIRE(FromHalf(ToHalf(1.0f)) == 1.0f);
+  REQUIRE(FromHalf(ToHalf(-0.1f)) == Approx(-0.1).epsilon(1e-3));
+  REQUIRE(FromHalf(ToHalf(65504.0f)) == 65504.0f);
+  REQUIRE(std::isinf(FromHalf(ToHalf(70000.0f))));
+  REQUIRE(FromHalf(ToHalf(1e-9f)) == 0.0f);
+}
+
+/**
+ * Check that the ring all-reduce sums the vectors of all the threads, with and
+ * without compression, and that every thread gets the same result.
+ */
+TEST_CASE("RingAllReduceTest", "[DataParallelTest]")
+{
+  for (size_t size = 1; size <= 4; ++size)
+  {
+    for (const size_t n : { 1, 3, 100 })
+    {
+      for (const bool compress : { false, true })
+      {
+        std::vector<arma::vec> data(size);
+        arma::vec sum(n, arma::fill::zeros);
+        for (size_t r = 0; r < size; ++r)
+        {
+          data[r] = arma::randu<arma::vec>(n) - 0.5;
+          sum += data[r];
+        }
+
+        ThreadCommunicator::Mailboxes mailboxes(size);
+        std::vector<std::thread> threads;
+        for (size_t r = 0; r < size; ++r)
+        {
+          threads.push_back(std::thread([&mailboxes, &data, r, n, compress]()
+          {
+            ThreadCommunicator communicator(mailboxes, r);
+            RingAllReduce(communicator, data[r].memptr(), n, compress);
+          }));
+        }
+        for (size_t r = 0; r < size; ++r)
+          threads[r].join();
+
+        const double tolerance = (compress && size > 1) ? 5e-3 : 1e-12;
+        for (size_t r = 0; r < size; ++r)
+        {
+          REQUIRE(arma::abs(data[r] - sum).max() <= tolerance);
+          REQUIRE(arma::all(data[r] == data[0]));
+        }
+      }
+    }
+  }
+}
+
+/**
+ * With a single process, data-parallel training is plain training.
+ */
+TEST_CASE("DataParallelLocalTest", "[DataParallelTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(5, 64);
+  arma::mat labels = arma::randi<arma::mat>(1, 64, arma::distr_param(0, 2));
+
+  FFN<NegativeLogLikelihood<>, RandomInitialization> model;
+  model.Add<Linear<>>(5, 8);
+  model.Add<SigmoidLayer<>>();
+  model.Add<Linear<>>(8, 3);
+  model.Add<LogSoftMax<>>();
+  model.ResetParameters();
+  // Predicting once keeps Train() from initializing the parameters again.
+  arma::mat predictions;
+  model.Predict(data, predictions);
+  FFN<NegativeLogLikelihood<>, RandomInitialization> parallelModel(model);
+
+  ens::StandardSGD sgd(0.1, 8, 64 * 3, -1, false);
+  model.Train(data, labels, sgd);
+
+  LocalCommunicator communicator;
+  DataParallel<ens::StandardSGD, LocalCommunicator> parallelSgd(
+      ens::StandardSGD(0.1, 8, 64 * 3, -1, false), communicator);
+  parallelModel.Train(data, labels, parallelSgd);
+
+  CheckMatrices(model.Parameters(), parallelModel.Parameters(), 1e-12);
+}
+
+/**
+ * Train a network on three shards in three threads, and make sure that every
+ * thread ends up with the same parameters, which fit the data.
+ */
+TEST_CASE("DataParallelThreadsTest", "[DataParallelTest]")
+{
+  const size_t size = 3;
+  arma::mat data = arma::randu<arma::mat>(4, 3 * 200);
+  arma::mat labels = arma::conv_to<arma::mat>::from(
+      arma::sum(data.rows(0, 1)) > arma::sum(data.rows(2, 3)));
+
+  for (const bool compress : { false, true })
+  {
+    // Each thread starts from different parameters.
+    std::vector<FFN<NegativeLogLikelihood<>, RandomInitialization>> models(
+        size);
+    for (size_t r = 0; r < size; ++r)
+    {
+      models[r].Add<Linear<>>(4, 8);
+      models[r].Add<SigmoidLayer<>>();
+      models[r].Add<Linear<>>(8, 2);
+      models[r].Add<LogSoftMax<>>();
+      models[r].ResetParameters();
+      arma::mat predictions;
+      models[r].Predict(data.cols(0, 0), predictions);
+    }
+
+    ThreadCommunicator::Mailboxes mailboxes(size);
+    std::vector<std::thread> threads;
+    for (size_t r = 0; r < size; ++r)
+    {
+      threads.push_back(std::thread([&, r]()
+      {
+        ThreadCommunicator communicator(mailboxes, r);
+        DataParallel<ens::Adam, ThreadCommunicator> optimizer(
+            ens::Adam(0.05, 16, 0.9, 0.999, 1e-8, 200 * 20, -1, false),
+            communicator, compress);
+        models[r].Train(data.cols(r * 200, (r + 1) * 200 - 1),
+            labels.cols(r * 200, (r + 1) * 200 - 1), optimizer);
+      }));
+    }
+    for (size_t r = 0; r < size; ++r)
+      threads[r].join();
+
+    for (size_t r = 1; r < size; ++r)
+    {
+      REQUIRE(arma::all(arma::vectorise(models[r].Parameters() ==
+          models[0].Parameters())));
+    }
+
+    arma::mat predictions;
+    models[0].Predict(data, predictions);
+    const arma::urowvec predictedLabels = arma::index_max(predictions, 0);
+    const double accuracy = arma::accu(arma::conv_to<arma::rowvec>::from(
+        predictedLabels) == labels) / (double) labels.n_elem;
+    REQUIRE(accuracy >= 0.85);
+  }
+}
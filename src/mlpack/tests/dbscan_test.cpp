@@ -306,3 +306,132 @@ TEST_CASE("RandomPointSelectionTest", "[DBSCANTest]")
   // The number of assignments returned should be the same as points.
   REQUIRE(assignments.n_elem == points.n_cols);
 }
+
+/**
+ * Check that two clusterings give the same partition of the points (the
+ * cluster labels may be assigned in a different order).
+ */
+void CheckSamePartition(const arma::Row<size_t>& a, const arma::Row<size_t>& b)
+{
+  REQUIRE(a.n_elem == b.n_elem);
+  std::map<size_t, size_t> aToB, bToA;
+  for (size_t i = 0; i < a.n_elem; ++i)
+  {
+    REQUIRE((a[i] == SIZE_MAX) == (b[i] == SIZE_MAX));
+    if (a[i] == SIZE_MAX)
+      continue;
+
+    if (aToB.count(a[i]) == 0)
+      aToB[a[i]] = b[i];
+    if (bToA.count(b[i]) == 0)
+      bToA[b[i]] = a[i];
+
+    REQUIRE(aToB[a[i]] == b[i]);
+    REQUIRE(bToA[b[i]] == a[i]);
+  }
+}
+
+/**
+ * The low-memory mode should give the same clusters as the batch mode, both
+ * with the epsilon-grid (low dimensions) and with blocks of range searches
+ * (high dimensions).
+ */
+TEST_CASE("LowMemoryTest", "[DBSCANTest]")
+{
+  const size_t dimensions[4] = { 1, 2, 4, 10 };
+  for (size_t d = 0; d < 4; ++d)
+  {
+    arma::mat points(dimensions[d], 1000, arma::fill::randu);
+    const double epsilon = 0.03 * std::sqrt((double) dimensions[d]);
+
+    DBSCAN<> batch(epsilon, 3);
+    arma::Row<size_t> batchAssignments;
+    const size_t batchClusters = batch.Cluster(points, batchAssignments);
+
+    DBSCAN<> lowMemory(epsilon, 3);
+    lowMemory.LowMemory() = true;
+    lowMemory.BlockSize() = 77;
+    arma::Row<size_t> assignments;
+    const size_t clusters = lowMemory.Cluster(points, assignments);
+
+    REQUIRE(clusters == batchClusters);
+    CheckSamePartition(assignments, batchAssignments);
+  }
+}
+
+/**
+ * Outliers should still be noise in low-memory mode, and when epsilon is too
+ * small for the grid, the range searches should be used.
+ */
+TEST_CASE("LowMemoryOutlierTest", "[DBSCANTest]")
+{
+  arma::mat points(2, 200, arma::fill::randu);
+  points.col(15) = arma::vec("10.3 1.6");
+  points.col(45) = arma::vec("-100 0.0");
+  points.col(101) = arma::vec("1.5 1.5");
+
+  DBSCAN<> d(0.1, 3);
+  d.LowMemory() = true;
+
+  arma::Row<size_t> assignments;
+  const size_t clusters = d.Cluster(points, assignments);
+
+  REQUIRE(clusters > 0);
+  REQUIRE(assignments[15] == SIZE_MAX);
+  REQUIRE(assignments[45] == SIZE_MAX);
+  REQUIRE(assignments[101] == SIZE_MAX);
+
+  DBSCAN<> tiny(1e-50, 2);
+  tiny.LowMemory() = true;
+  REQUIRE(tiny.Cluster(points, assignments) == 0);
+  for (size_t i = 0; i < assignments.n_elem; ++i)
+    REQUIRE(assignments[i] == SIZE_MAX);
+}
+
+/**
+ * Check the cells of the epsilon-grid: every pair of points in a cell must be
+ * within epsilon, and every pair of points within epsilon must be in the same
+ * cell or in neighboring cells.
+ */
+TEST_CASE("EpsilonGridTest", "[DBSCANTest]")
+{
+  const arma::mat points(3, 300, arma::fill::randu);
+  const double epsilon = 0.2;
+  EpsilonGrid grid(points, epsilon);
+
+  arma::Col<size_t> cellOf(points.n_cols);
+  size_t total = 0;
+  for (size_t c = 0; c < grid.NumCells(); ++c)
+  {
+    for (size_t i = grid.CellBegin(c); i < grid.CellEnd(c); ++i)
+    {
+      cellOf[grid.Point(i)] = c;
+      for (size_t j = grid.CellBegin(c); j < grid.CellEnd(c); ++j)
+      {
+        REQUIRE(arma::norm(points.col(grid.Point(i)) -
+            points.col(grid.Point(j))) <= epsilon);
+      }
+    }
+    total += grid.CellEnd(c) - grid.CellBegin(c);
+  }
+  REQUIRE(total == points.n_cols);
+
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    for (size_t j = 0; j < points.n_cols; ++j)
+    {
+      if (cellOf[i] == cellOf[j] ||
+          arma::norm(points.col(i) - points.col(j)) > epsilon)
+        continue;
+
+      bool neighbors = false;
+      for (size_t o = 0; o < grid.NumOffsets(); ++o)
+      {
+        if (grid.NeighborCell(cellOf[i], o) == cellOf[j] ||
+            grid.NeighborCell(cellOf[j], o) == cellOf[i])
+          neighbors = true;
+      }
+      REQUIRE(neighbors);
+    }
+  }
+}
@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/decision_tree/decision_tree.hpp>
+#include <mlpack/methods/decision_tree/compiled_tree_ensemble.hpp>
 #include <mlpack/methods/decision_tree/information_gain.hpp>
 #include <mlpack/methods/decision_tree/gini_gain.hpp>
 #include <mlpack/methods/decision_tree/random_dimension_select.hpp>
@@ -376,6 +377,238 @@ TEST_CASE("BestBinaryNumericSplitNoGainTest", "[DecisionTreeTest]")
   REQUIRE(classProbabilities.n_elem == 0);
 }
 
+/**
+ * Check that the HistogramNumericSplit finds the same split as the
+ * BestBinaryNumericSplit on integer data with fewer than 256 distinct values,
+ * where every value gets its own bin.
+ */
+TEST_CASE("HistogramNumericSplitExactTest", "[DecisionTreeTest]")
+{
+  arma::rowvec values = arma::floor(100 * arma::randu<arma::rowvec>(500));
+  arma::Row<size_t> labels(500);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    labels[i] = (values[i] > 37 && values[i] < 80) ? 1 : 0;
+  arma::rowvec weights(labels.n_elem, arma::fill::randu);
+
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double weightedBestGain = GiniGain::Evaluate<true>(labels, 2, weights);
+
+  arma::vec classProbabilities, histClassProbabilities;
+  BestBinaryNumericSplit<GiniGain>::AuxiliarySplitInfo aux;
+  HistogramNumericSplit<GiniGain>::AuxiliarySplitInfo histAux;
+
+  const double gain = BestBinaryNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 5, 1e-7, classProbabilities, aux);
+  const double histGain =
+      HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(bestGain, values,
+      labels, 2, weights, 5, 1e-7, histClassProbabilities, histAux);
+
+  REQUIRE(gain != DBL_MAX);
+  REQUIRE(histGain == Approx(gain).epsilon(1e-7));
+  REQUIRE(histClassProbabilities.n_elem == 1);
+  REQUIRE(histClassProbabilities[0] == classProbabilities[0]);
+
+  const double weightedGain =
+      BestBinaryNumericSplit<GiniGain>::SplitIfBetter<true>(weightedBestGain,
+      values, labels, 2, weights, 5, 1e-7, classProbabilities, aux);
+  const double weightedHistGain =
+      HistogramNumericSplit<GiniGain>::SplitIfBetter<true>(weightedBestGain,
+      values, labels, 2, weights, 5, 1e-7, histClassProbabilities, histAux);
+
+  REQUIRE(weightedHistGain == Approx(weightedGain).epsilon(1e-7));
+  REQUIRE(histClassProbabilities[0] == classProbabilities[0]);
+
+  // The same must hold when the data is already quantized to 8 bits.
+  const arma::Row<unsigned char> quantized =
+      arma::conv_to<arma::Row<unsigned char>>::from(values);
+  const double quantizedGain =
+      HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+      quantized, labels, 2, weights, 5, 1e-7, histClassProbabilities, histAux);
+  REQUIRE(quantizedGain == Approx(gain).epsilon(1e-7));
+}
+
+/**
+ * Check that the HistogramNumericSplit will split on an obviously splittable
+ * dimension, and that it won't split if not enough points are given.
+ */
+TEST_CASE("HistogramNumericSplitSimpleSplitTest", "[DecisionTreeTest]")
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem, arma::fill::ones);
+
+  arma::vec classProbabilities;
+  HistogramNumericSplit<GiniGain>::AuxiliarySplitInfo aux;
+
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 3, 1e-7, classProbabilities, aux);
+
+  // The split is perfect, and lies between the two classes.
+  REQUIRE(gain == Approx(0.0).margin(1e-7));
+  REQUIRE(classProbabilities.n_elem == 1);
+  REQUIRE(classProbabilities[0] > 0.4);
+  REQUIRE(classProbabilities[0] < 0.5);
+
+  classProbabilities.clear();
+  const double noGain = HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 8, 1e-7, classProbabilities, aux);
+  REQUIRE(noGain == DBL_MAX);
+  REQUIRE(classProbabilities.n_elem == 0);
+}
+
+/**
+ * Test that a decision tree with the HistogramNumericSplit generalizes
+ * reasonably.
+ */
+TEST_CASE("HistogramSplitGeneralizationTest", "[DecisionTreeTest]")
+{
+  arma::mat inputData;
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load test dataset vc2.csv!");
+
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  DecisionTree<GiniGain, HistogramNumericSplit> d(inputData, labels, 3, 10);
+
+  arma::mat testData;
+  if (!data::Load("vc2_test.csv", testData))
+    FAIL("Cannot load test dataset vc2_test.csv!");
+
+  arma::Mat<size_t> trueTestLabels;
+  if (!data::Load("vc2_test_labels.txt", trueTestLabels))
+    FAIL("Cannot load labels for vc2_test_labels.txt");
+
+  arma::Row<size_t> predictions;
+  d.Classify(testData, predictions);
+  REQUIRE(predictions.n_elem == testData.n_cols);
+
+  double correct = 0.0;
+  for (size_t i = 0; i < predictions.n_elem; ++i)
+    if (predictions[i] == trueTestLabels[i])
+      ++correct;
+  correct /= predictions.n_elem;
+
+  REQUIRE(correct > 0.75);
+}
+
+/**
+ * Check that the RandomBinaryNumericSplit draws split values between the
+ * smallest and largest values, and that it won't split if not enough points
+ * are given.
+ */
+TEST_CASE("RandomBinaryNumericSplitSimpleSplitTest", "[DecisionTreeTest]")
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem, arma::fill::ones);
+
+  RandomBinaryNumericSplit<GiniGain>::AuxiliarySplitInfo aux;
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+
+  size_t splits = 0;
+  for (size_t trial = 0; trial < 50; ++trial)
+  {
+    arma::vec classProbabilities;
+    const double gain =
+        RandomBinaryNumericSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+        values, labels, 2, weights, 1, 1e-7, classProbabilities, aux);
+    if (gain == DBL_MAX)
+    {
+      REQUIRE(classProbabilities.n_elem == 0);
+      continue;
+    }
+
+    ++splits;
+    REQUIRE(gain > bestGain);
+    REQUIRE(gain <= 0.0);
+    REQUIRE(classProbabilities.n_elem == 1);
+    REQUIRE(classProbabilities[0] >= 0.0);
+    REQUIRE(classProbabilities[0] < 1.0);
+
+    // The gain is the one of the split at the drawn value.
+    arma::Row<size_t> directions(values.n_elem);
+    for (size_t i = 0; i < values.n_elem; ++i)
+    {
+      directions[i] = RandomBinaryNumericSplit<GiniGain>::CalculateDirection(
+          values[i], classProbabilities, aux);
+    }
+    const arma::Row<size_t> leftLabels = labels.cols(
+        arma::find(directions == 0));
+    const arma::Row<size_t> rightLabels = labels.cols(
+        arma::find(directions == 1));
+    const double expectedGain = (leftLabels.n_elem *
+        GiniGain::Evaluate<false>(leftLabels, 2, weights) + rightLabels.n_elem *
+        GiniGain::Evaluate<false>(rightLabels, 2, weights)) / values.n_elem;
+    REQUIRE(gain == Approx(expectedGain).epsilon(1e-7));
+
+    // The weighted split with unit weights gives the same gain.
+    arma::vec weightedClassProbabilities;
+    math::RandomSeed(trial);
+    const double weightedGain =
+        RandomBinaryNumericSplit<GiniGain>::SplitIfBetter<true>(bestGain,
+        values, labels, 2, weights, 1, 1e-7, weightedClassProbabilities, aux);
+    math::RandomSeed(trial);
+    const double unweightedGain =
+        RandomBinaryNumericSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+        values, labels, 2, weights, 1, 1e-7, classProbabilities, aux);
+    REQUIRE(weightedGain == Approx(unweightedGain).epsilon(1e-7));
+  }
+  REQUIRE(splits > 0);
+
+  arma::vec classProbabilities;
+  const double noGain =
+      RandomBinaryNumericSplit<GiniGain>::SplitIfBetter<false>(bestGain,
+      values, labels, 2, weights, 8, 1e-7, classProbabilities, aux);
+  REQUIRE(noGain == DBL_MAX);
+  REQUIRE(classProbabilities.n_elem == 0);
+}
+
+/**
+ * A tree with random splits must only depend on the random seed, and not on
+ * the number of threads that search the dimensions of its nodes.
+ */
+TEST_CASE("RandomBinaryNumericSplitThreadIndependenceTest",
+          "[DecisionTreeTest]")
+{
+  // The root has enough points and dimensions to be searched in parallel.
+  arma::mat dataset(10, 3000, arma::fill::randu);
+  arma::Row<size_t> labels(3000);
+  for (size_t i = 0; i < 3000; ++i)
+    labels[i] = (dataset(0, i) + dataset(5, i) > 1.0) ? 1 : 0;
+
+  math::RandomSeed(21);
+  DecisionTree<GiniGain, RandomBinaryNumericSplit> parallelTree(dataset,
+      labels, 2, 5);
+
+  #ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  math::RandomSeed(21);
+  DecisionTree<GiniGain, RandomBinaryNumericSplit> sequentialTree(dataset,
+      labels, 2, 5);
+
+  #ifdef HAS_OPENMP
+  omp_set_num_threads(numThreads);
+  #endif
+
+  REQUIRE(parallelTree.NumChildren() == sequentialTree.NumChildren());
+  REQUIRE(parallelTree.SplitDimension() == sequentialTree.SplitDimension());
+
+  arma::Row<size_t> parallelPredictions, sequentialPredictions;
+  arma::mat parallelProbabilities, sequentialProbabilities;
+  parallelTree.Classify(dataset, parallelPredictions, parallelProbabilities);
+  sequentialTree.Classify(dataset, sequentialPredictions,
+      sequentialProbabilities);
+  REQUIRE(arma::all(parallelPredictions == sequentialPredictions));
+  REQUIRE(arma::approx_equal(parallelProbabilities, sequentialProbabilities,
+      "absdiff", 0.0));
+}
+
 /**
  * Check that the AllCategoricalSplit will split when the split is obviously
  * better.
@@ -1301,3 +1534,107 @@ TEST_CASE("DifferentMaximumDepthTest", "[DecisionTreeTest]")
   REQUIRE(d2.Child(0).NumChildren() == 2);
   REQUIRE(d2.Child(1).NumChildren() == 2);
 }
+
+/**
+ * Make sure a compiled decision tree gives the same predictions and
+ * probabilities as the tree, on numeric and categorical data.
+ */
+TEST_CASE("CompiledDecisionTreeTest", "[DecisionTreeTest]")
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load test dataset vc2.csv!");
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt!");
+
+  DecisionTree<> tree(dataset, labels, 3, 5);
+  CompiledTreeEnsemble compiled(tree, 7 /* Not a divisor of the points. */);
+  REQUIRE(compiled.NumTrees() == 1);
+  REQUIRE(compiled.NumClasses() == 3);
+
+  arma::Row<size_t> predictions, compiledPredictions;
+  arma::mat probabilities, compiledProbabilities;
+  tree.Classify(dataset, predictions, probabilities);
+  compiled.Classify(dataset, compiledPredictions, compiledProbabilities);
+
+  CheckMatrices(predictions, compiledPredictions);
+  CheckMatrices(probabilities, compiledProbabilities);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    REQUIRE(compiled.Classify(dataset.col(i)) == predictions[i]);
+
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  DecisionTree<> categoricalTree(d, di, l, 5, 10);
+  CompiledTreeEnsemble categoricalCompiled(categoricalTree);
+
+  categoricalTree.Classify(d, predictions, probabilities);
+  categoricalCompiled.Classify(d, compiledPredictions, compiledProbabilities);
+
+  CheckMatrices(predictions, compiledPredictions);
+  CheckMatrices(probabilities, compiledProbabilities);
+
+  // Trees with different numbers of classes cannot be combined.
+  REQUIRE_THROWS_AS(categoricalCompiled.Add(tree), std::invalid_argument);
+}
+
+/**
+ * Make sure that the dimensions of a node with enough work to be searched in
+ * parallel still give the best split.
+ */
+TEST_CASE("ParallelSplitSearchTest", "[DecisionTreeTest]")
+{
+  // Only dimension 137 carries information about the labels.
+  arma::mat dataset(200, 1000, arma::fill::randu);
+  arma::Row<size_t> labels(1000);
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    labels[i] = i % 2;
+    dataset(137, i) = labels[i] + 0.5 * arma::randu();
+  }
+
+  DecisionTree<> tree(dataset, labels, 2, 10, 1e-7, 3);
+  REQUIRE(tree.NumChildren() == 2);
+  REQUIRE(tree.SplitDimension() == 137);
+
+  // The same search gives the same tree.
+  DecisionTree<> tree2(dataset, labels, 2, 10, 1e-7, 3);
+  arma::Row<size_t> predictions, predictions2;
+  tree.Classify(dataset, predictions);
+  tree2.Classify(dataset, predictions2);
+  CheckMatrices(predictions, predictions2);
+  REQUIRE(arma::accu(predictions == labels) == 1000);
+}
+
+/**
+ * Make sure that a dimension is only chosen over an earlier one if it improves
+ * the gain by at least minimumGainSplit, as in a serial search.
+ */
+TEST_CASE("SplitSearchMinimumGainTest", "[DecisionTreeTest]")
+{
+  // Dimension 0 separates the classes except for one point, with a Gini gain
+  // of -1 / 11; dimension 1 separates them perfectly, with a gain of 0.
+  arma::mat dataset(2, 20);
+  arma::Row<size_t> labels(20);
+  for (size_t i = 0; i < 20; ++i)
+  {
+    labels[i] = (i < 10) ? 0 : 1;
+    dataset(0, i) = i;
+    dataset(1, i) = i;
+  }
+  dataset(0, 10) = 4.5;
+
+  // With a minimum gain of 0.1, dimension 1 does not improve enough on
+  // dimension 0.
+  DecisionTree<> tree(dataset, labels, 2, 1, 0.1);
+  REQUIRE(tree.NumChildren() == 2);
+  REQUIRE(tree.SplitDimension() == 0);
+
+  // With a smaller minimum gain, the perfect split is chosen.
+  DecisionTree<> tree2(dataset, labels, 2, 1, 0.01);
+  REQUIRE(tree2.NumChildren() == 2);
+  REQUIRE(tree2.SplitDimension() == 1);
+}
@@ -782,3 +782,79 @@ TEST_CASE("MoveOperatorTest", "[DETTest]")
   REQUIRE(testDTree2.Right()->SplitDim() == 1);
   REQUIRE(testDTree2.Right()->SplitValue() == Approx(0.5).epsilon(1e-7));
 }
+
+//! Check that two density estimation trees have the same structure.
+template<typename MatType>
+void CheckSameDTree(const DTree<MatType>& a, const DTree<MatType>& b)
+{
+  REQUIRE(a.Start() == b.Start());
+  REQUIRE(a.End() == b.End());
+  REQUIRE(a.SubtreeLeaves() == b.SubtreeLeaves());
+  REQUIRE(a.NumChildren() == b.NumChildren());
+  if (a.NumChildren() == 0)
+    return;
+
+  REQUIRE(a.SplitDim() == b.SplitDim());
+  REQUIRE(a.SplitValue() == b.SplitValue());
+  CheckSameDTree(*a.Left(), *b.Left());
+  CheckSameDTree(*a.Right(), *b.Right());
+}
+
+/**
+ * Grow a tree large enough for its subtrees to be grown in parallel, and make
+ * sure it is the same as a tree grown on one thread.
+ */
+TEST_CASE("ParallelGrowTest", "[DETTest]")
+{
+  arma::mat dataset(3, 30000, arma::fill::randu);
+  dataset.row(1) = arma::square(dataset.row(1));
+
+  arma::mat parallelData(dataset);
+  arma::Col<size_t> parallelOldFromNew =
+      arma::regspace<arma::Col<size_t>>(0, dataset.n_cols - 1);
+  DTree<arma::mat> parallelTree(parallelData);
+  const double parallelAlpha = parallelTree.Grow(parallelData,
+      parallelOldFromNew, false, 10, 5);
+
+  #ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  arma::mat sequentialData(dataset);
+  arma::Col<size_t> sequentialOldFromNew =
+      arma::regspace<arma::Col<size_t>>(0, dataset.n_cols - 1);
+  DTree<arma::mat> sequentialTree(sequentialData);
+  const double sequentialAlpha = sequentialTree.Grow(sequentialData,
+      sequentialOldFromNew, false, 10, 5);
+
+  #ifdef HAS_OPENMP
+  omp_set_num_threads(numThreads);
+  #endif
+
+  REQUIRE(parallelAlpha == sequentialAlpha);
+  CheckSameDTree(parallelTree, sequentialTree);
+  REQUIRE(arma::all(parallelOldFromNew == sequentialOldFromNew));
+  REQUIRE(arma::approx_equal(parallelData, sequentialData, "absdiff", 0.0));
+}
+
+/**
+ * Cross-validated training must not depend on the order in which the folds
+ * finish.
+ */
+TEST_CASE("TrainerDeterminismTest", "[DETTest]")
+{
+  arma::mat dataset(2, 2000, arma::fill::randn);
+
+  arma::mat first(dataset), second(dataset);
+  DTree<arma::mat>* firstTree = Trainer<arma::mat, int>(first, 5, false, 30,
+      5, false);
+  DTree<arma::mat>* secondTree = Trainer<arma::mat, int>(second, 5, false, 30,
+      5, false);
+
+  CheckSameDTree(*firstTree, *secondTree);
+  REQUIRE(firstTree->SubtreeLeaves() > 1);
+
+  delete firstTree;
+  delete secondTree;
+}
@@ -163,3 +163,32 @@ TEST_CASE("SparseTest", "[DrusillaSelectTest]")
   REQUIRE(distances.n_cols == 1000);
   REQUIRE(distances.n_rows == 3);
 }
+
+// Searching a whole query set at once must give the same results as searching
+// each query point on its own.
+TEST_CASE("DrusillaSelectBatchSearchTest", "[DrusillaSelectTest]")
+{
+  arma::mat dataset(5, 800, arma::fill::randu);
+  arma::mat querySet(5, 600, arma::fill::randu);
+
+  DrusillaSelect<> ds(dataset, 5, 8);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  ds.Search(querySet, 3, neighbors, distances);
+
+  for (size_t q = 0; q < querySet.n_cols; q += 37)
+  {
+    arma::Mat<size_t> singleNeighbors;
+    arma::mat singleDistances;
+    ds.Search(arma::mat(querySet.col(q)), 3, singleNeighbors, singleDistances);
+
+    for (size_t j = 0; j < 3; ++j)
+    {
+      REQUIRE(neighbors(j, q) == singleNeighbors(j, 0));
+      REQUIRE(distances(j, q) == Approx(singleDistances(j, 0)).epsilon(1e-7));
+      REQUIRE(distances(j, q) == Approx(metric::EuclideanDistance::Evaluate(
+          querySet.col(q), dataset.col(neighbors(j, q)))).epsilon(1e-7));
+    }
+  }
+}
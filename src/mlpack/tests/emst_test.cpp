@@ -218,6 +218,77 @@ TEST_CASE("DualTreeVsNaive", "[EMSTTest]")
   }
 }
 
+/**
+ * Test the parallel dual tree method against the naive computation, with
+ * several depths at which the traversal is split into tasks.
+ */
+TEST_CASE("ParallelDualTreeVsNaive", "[EMSTTest]")
+{
+  arma::mat inputData;
+  if (!data::Load("test_data_3_1000.csv", inputData))
+    FAIL("Cannot load test dataset test_data_3_1000.csv!");
+
+  DualTreeBoruvka<> dtbNaive(inputData, true);
+  arma::mat naiveResults;
+  dtbNaive.ComputeMST(naiveResults);
+
+  for (size_t depth = 1; depth < 6; depth += 2)
+  {
+    DualTreeBoruvka<> dtb(inputData);
+    dtb.ParallelDepth() = depth;
+
+    arma::mat dualResults;
+    dtb.ComputeMST(dualResults);
+
+    REQUIRE(dualResults.n_cols == naiveResults.n_cols);
+    REQUIRE(dualResults.n_rows == naiveResults.n_rows);
+
+    for (size_t i = 0; i < dualResults.n_cols; ++i)
+    {
+      REQUIRE(dualResults(0, i) == naiveResults(0, i));
+      REQUIRE(dualResults(1, i) == naiveResults(1, i));
+      REQUIRE(dualResults(2, i) == Approx(naiveResults(2, i)).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Test the mutual reachability MST of the dual tree method against the naive
+ * computation.  Many mutual reachability distances are equal to a core
+ * distance, so the trees are only compared by their total length.
+ */
+TEST_CASE("MutualReachabilityDualTreeVsNaive", "[EMSTTest]")
+{
+  arma::mat inputData;
+  if (!data::Load("test_data_3_1000.csv", inputData))
+    FAIL("Cannot load test dataset test_data_3_1000.csv!");
+
+  const arma::vec coreDistances(inputData.n_cols, arma::fill::randu);
+
+  DualTreeBoruvka<> dtbNaive(inputData, true);
+  arma::mat naiveResults;
+  dtbNaive.ComputeMST(coreDistances, naiveResults);
+
+  DualTreeBoruvka<> dtb(inputData);
+  arma::mat dualResults;
+  dtb.ComputeMST(coreDistances, dualResults);
+
+  REQUIRE(dualResults.n_cols == naiveResults.n_cols);
+  REQUIRE(dualResults.n_rows == naiveResults.n_rows);
+  REQUIRE(arma::accu(dualResults.row(2)) ==
+      Approx(arma::accu(naiveResults.row(2))).epsilon(1e-7));
+
+  // Each edge must have the mutual reachability distance of its points.
+  for (size_t i = 0; i < dualResults.n_cols; ++i)
+  {
+    const size_t a = (size_t) dualResults(0, i);
+    const size_t b = (size_t) dualResults(1, i);
+    const double distance = std::max(arma::norm(inputData.col(a) -
+        inputData.col(b)), std::max(coreDistances[a], coreDistances[b]));
+    REQUIRE(dualResults(2, i) == Approx(distance).epsilon(1e-7));
+  }
+}
+
 /**
  * Make sure the cover tree works fine.
  */
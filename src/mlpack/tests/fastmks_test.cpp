@@ -126,6 +126,50 @@ TEST_CASE("DualTreeVsSingleTree", "[FastMKSTest]")
   }
 }
 
+/**
+ * Make sure that the parallel dual-tree search gives the same results as naive
+ * search, both with a separate query set and in monochromatic mode.
+ */
+TEST_CASE("ParallelDualTreeVsNaive", "[FastMKSTest]")
+{
+  arma::mat referenceData;
+  referenceData.randn(6, 1500);
+  arma::mat queryData;
+  queryData.randn(6, 500);
+  LinearKernel lk;
+
+  FastMKS<LinearKernel> naive(referenceData, lk, false, true);
+  FastMKS<LinearKernel> tree(referenceData, lk);
+  tree.ParallelDepth() = 3;
+
+  arma::Mat<size_t> naiveIndices, treeIndices;
+  arma::mat naiveProducts, treeProducts;
+  for (size_t trial = 0; trial < 2; ++trial)
+  {
+    if (trial == 0)
+    {
+      naive.Search(queryData, 7, naiveIndices, naiveProducts);
+      tree.Search(queryData, 7, treeIndices, treeProducts);
+    }
+    else
+    {
+      naive.Search(7, naiveIndices, naiveProducts);
+      tree.Search(7, treeIndices, treeProducts);
+    }
+
+    REQUIRE(treeIndices.n_cols == naiveIndices.n_cols);
+    for (size_t q = 0; q < treeIndices.n_cols; ++q)
+    {
+      for (size_t r = 0; r < treeIndices.n_rows; ++r)
+      {
+        REQUIRE(treeIndices(r, q) == naiveIndices(r, q));
+        REQUIRE(treeProducts(r, q) ==
+            Approx(naiveProducts(r, q)).epsilon(1e-7));
+      }
+    }
+  }
+}
+
 /**
  * Test sparse FastMKS (how useful is this, I'm not sure).
  */
@@ -1134,3 +1178,97 @@ TEST_CASE("CopyAssignmentTest", "[FastMKSTest]")
       REQUIRE(newKernels[i] == Approx(0.0).margin(1e-5));
   }
 }
+
+/**
+ * Make sure that approximate maximum inner product search finds most of the
+ * true maximum inner products, and that the returned inner products are exact.
+ */
+TEST_CASE("ApproximateMIPSRecallTest", "[FastMKSTest]")
+{
+  arma::mat referenceData;
+  referenceData.randn(32, 2000);
+  // Give the points different norms, so the extra coordinate matters.
+  referenceData.each_row() %= arma::randu<arma::rowvec>(2000) + 0.5;
+  arma::mat queryData;
+  queryData.randn(32, 200);
+
+  LinearKernel lk;
+  FastMKS<LinearKernel> naive(referenceData, lk, false, true);
+  arma::Mat<size_t> trueIndices;
+  arma::mat trueKernels;
+  naive.Search(queryData, 10, trueIndices, trueKernels);
+
+  ApproximateMIPS<> mips(referenceData, 16, 200, 200);
+  arma::Mat<size_t> indices;
+  arma::mat kernels;
+  mips.Search(queryData, 10, indices, kernels);
+
+  REQUIRE(indices.n_rows == 10);
+  REQUIRE(indices.n_cols == 200);
+
+  size_t found = 0;
+  for (size_t i = 0; i < indices.n_cols; ++i)
+  {
+    for (size_t j = 0; j < indices.n_rows; ++j)
+    {
+      REQUIRE(indices(j, i) < referenceData.n_cols);
+      REQUIRE(kernels(j, i) == Approx(arma::dot(queryData.col(i),
+          referenceData.col(indices(j, i)))).epsilon(1e-7));
+      if (arma::any(trueIndices.col(i) == indices(j, i)))
+        ++found;
+    }
+  }
+
+  REQUIRE(double(found) / trueIndices.n_elem >= 0.9);
+}
+
+/**
+ * Test approximate search through FastMKSModel, in monochromatic mode and after
+ * serialization.
+ */
+TEST_CASE("FastMKSModelApproximateTest", "[FastMKSTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(16, 500);
+
+  FastMKSModel m(FastMKSModel::LINEAR_KERNEL);
+  m.BuildApproximateModel(arma::mat(referenceData), 12, 100, 100);
+  REQUIRE(m.Approximate());
+  REQUIRE(m.EfSearch() == 100);
+  const FastMKSModel& constModel = m;
+  REQUIRE(!constModel.Naive());
+  REQUIRE_THROWS_AS(m.SingleMode() = true, std::invalid_argument);
+
+  arma::Mat<size_t> indices;
+  arma::mat kernels;
+  m.Search(5, indices, kernels);
+
+  REQUIRE(indices.n_rows == 5);
+  REQUIRE(indices.n_cols == 500);
+  for (size_t i = 0; i < indices.n_cols; ++i)
+  {
+    for (size_t j = 0; j < indices.n_rows; ++j)
+      REQUIRE(indices(j, i) != i);
+  }
+
+  FastMKSModel xmlModel, jsonModel, binaryModel;
+  SerializeObjectAll(m, xmlModel, jsonModel, binaryModel);
+  REQUIRE(xmlModel.Approximate());
+  REQUIRE(jsonModel.Approximate());
+  REQUIRE(binaryModel.Approximate());
+
+  arma::mat queryData = arma::randu<arma::mat>(16, 50);
+  arma::Mat<size_t> xmlIndices, jsonIndices, binaryIndices;
+  arma::mat xmlKernels, jsonKernels, binaryKernels;
+  m.Search(queryData, 5, indices, kernels, 2.0);
+  xmlModel.Search(queryData, 5, xmlIndices, xmlKernels, 2.0);
+  jsonModel.Search(queryData, 5, jsonIndices, jsonKernels, 2.0);
+  binaryModel.Search(queryData, 5, binaryIndices, binaryKernels, 2.0);
+
+  CheckMatrices(indices, xmlIndices, jsonIndices, binaryIndices);
+  CheckMatrices(kernels, xmlKernels, jsonKernels, binaryKernels);
+
+  // Only the linear kernel can be used.
+  FastMKSModel polynomial(FastMKSModel::POLYNOMIAL_KERNEL);
+  REQUIRE_THROWS_AS(polynomial.BuildApproximateModel(arma::mat(referenceData),
+      12, 100, 100), std::invalid_argument);
+}
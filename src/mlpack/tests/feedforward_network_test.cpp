@@ -14,9 +14,14 @@
 
 #include <mlpack/methods/ann/layer/layer.hpp>
 #include <mlpack/methods/ann/loss_functions/mean_squared_error.hpp>
+#include <mlpack/methods/ann/regularizer/regularizer.hpp>
 #include <mlpack/methods/ann/ffn.hpp>
+#include <mlpack/methods/ann/static_ffn.hpp>
+#include <mlpack/methods/ann/quantized_ffn.hpp>
+#include <mlpack/methods/ann/pruning.hpp>
 
 #include <ensmallen.hpp>
+#include <thread>
 
 #include "catch.hpp"
 #include "serialization.hpp"
@@ -459,6 +464,121 @@ TEST_CASE("FFVanillaNetworkTest", "[FeedForwardNetworkTest]")
   TestNetwork<>(model1, dataset, labels, dataset, labels, 10, 0.2);
 }
 
+/**
+ * Make sure that a StaticFFN computes the same predictions, objective and
+ * gradient as an FFN with the same layers and parameters.
+ */
+TEST_CASE("StaticFFNMatchesFFNTest", "[FeedForwardNetworkTest]")
+{
+  FFN<NegativeLogLikelihood<>, RandomInitialization> model;
+  model.Add<Linear<>>(10, 8);
+  model.Add<SigmoidLayer<>>();
+  model.Add<Linear<>>(8, 3);
+  model.Add<LogSoftMax<>>();
+
+  StaticFFN<NegativeLogLikelihood<>, RandomInitialization, Linear<>,
+      SigmoidLayer<>, Linear<>, LogSoftMax<>> staticModel(Linear<>(10, 8),
+      SigmoidLayer<>(), Linear<>(8, 3), LogSoftMax<>());
+
+  arma::mat data = arma::randu<arma::mat>(10, 30);
+  arma::mat labels = arma::floor(arma::randu<arma::mat>(1, 30) * 3);
+
+  model.ResetParameters();
+  staticModel.ResetParameters();
+  REQUIRE(staticModel.Parameters().n_elem == model.Parameters().n_elem);
+  staticModel.Parameters() = model.Parameters();
+
+  arma::mat predictions, staticPredictions;
+  model.Predict(data, predictions);
+  staticModel.Predict(data, staticPredictions);
+  CheckMatrices(predictions, staticPredictions);
+
+  model.Predictors() = data;
+  model.Responses() = labels;
+  staticModel.Predictors() = data;
+  staticModel.Responses() = labels;
+
+  arma::mat gradient, staticGradient;
+  const double objective = model.EvaluateWithGradient(model.Parameters(), 0,
+      gradient, 30);
+  const double staticObjective = staticModel.EvaluateWithGradient(
+      staticModel.Parameters(), 0, staticGradient, 30);
+  REQUIRE(staticObjective == Approx(objective).epsilon(1e-7));
+  CheckMatrices(gradient, staticGradient);
+
+  // A copy uses its own parameters.
+  auto copy(staticModel);
+  REQUIRE(copy.Parameters().memptr() != staticModel.Parameters().memptr());
+  copy.Parameters().zeros();
+  arma::mat copyPredictions;
+  staticModel.Predict(data, staticPredictions);
+  copy.Predict(data, copyPredictions);
+  CheckMatrices(predictions, staticPredictions);
+  REQUIRE(arma::norm(copyPredictions - predictions) > 1e-5);
+}
+
+/**
+ * Train a StaticFFN in single precision on the thyroid dataset.
+ */
+TEST_CASE("StaticFFNFloatNetworkTest", "[FeedForwardNetworkTest]")
+{
+  arma::fmat trainData;
+  if (!data::Load("thyroid_train.csv", trainData))
+    FAIL("Cannot open thyroid_train.csv");
+
+  arma::fmat trainLabels = trainData.row(trainData.n_rows - 1);
+  trainData.shed_row(trainData.n_rows - 1);
+  trainLabels -= 1; // Labels should be from 0 to numClasses - 1.
+
+  arma::fmat testData;
+  if (!data::Load("thyroid_test.csv", testData))
+    FAIL("Cannot load dataset thyroid_test.csv");
+
+  arma::fmat testLabels = testData.row(testData.n_rows - 1);
+  testData.shed_row(testData.n_rows - 1);
+  testLabels -= 1; // Labels should be from 0 to numClasses - 1.
+
+  StaticFFN<NegativeLogLikelihood<arma::fmat, arma::fmat>,
+      RandomInitialization, LinearSigmoid<arma::fmat, arma::fmat>,
+      Linear<arma::fmat, arma::fmat>, LogSoftMax<arma::fmat, arma::fmat>>
+      model(LinearSigmoid<arma::fmat, arma::fmat>(trainData.n_rows, 8),
+      Linear<arma::fmat, arma::fmat>(8, 3),
+      LogSoftMax<arma::fmat, arma::fmat>());
+
+  REQUIRE(std::is_same<decltype(model)::MatType, arma::fmat>::value);
+  TestNetwork<arma::fmat>(model, trainData, trainLabels, testData, testLabels,
+      10, 0.1);
+}
+
+/**
+ * Train a StaticFFN on the thyroid dataset.
+ */
+TEST_CASE("StaticFFNVanillaNetworkTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat trainData;
+  if (!data::Load("thyroid_train.csv", trainData))
+    FAIL("Cannot open thyroid_train.csv");
+
+  arma::mat trainLabels = trainData.row(trainData.n_rows - 1);
+  trainData.shed_row(trainData.n_rows - 1);
+  trainLabels -= 1; // Labels should be from 0 to numClasses - 1.
+
+  arma::mat testData;
+  if (!data::Load("thyroid_test.csv", testData))
+    FAIL("Cannot load dataset thyroid_test.csv");
+
+  arma::mat testLabels = testData.row(testData.n_rows - 1);
+  testData.shed_row(testData.n_rows - 1);
+  testLabels -= 1; // Labels should be from 0 to numClasses - 1.
+
+  StaticFFN<NegativeLogLikelihood<>, RandomInitialization, Linear<>,
+      SigmoidLayer<>, Linear<>, LogSoftMax<>> model(
+      Linear<>(trainData.n_rows, 8), SigmoidLayer<>(), Linear<>(8, 3),
+      LogSoftMax<>());
+
+  TestNetwork<>(model, trainData, trainLabels, testData, testLabels, 10, 0.1);
+}
+
 TEST_CASE("ForwardBackwardTest", "[FeedForwardNetworkTest]")
 {
   arma::mat dataset;
@@ -729,6 +849,368 @@ TEST_CASE("FFNMiscTest", "[FeedForwardNetworkTest]")
   auto moveOperator = std::move(copiedModel);
 }
 
+/**
+ * Make sure that batched prediction gives the same results as passing each
+ * point through the network separately, for any batch size.
+ */
+TEST_CASE("FFNBatchPredictTest", "[FeedForwardNetworkTest]")
+{
+  FFN<NegativeLogLikelihood<>, RandomInitialization> model;
+  model.Add<Linear<>>(10, 8);
+  model.Add<SigmoidLayer<>>();
+  model.Add<Linear<>>(8, 3);
+  model.Add<LogSoftMax<>>();
+
+  arma::mat data = arma::randu<arma::mat>(10, 50);
+
+  arma::mat singlePredictions;
+  model.Predict(data, singlePredictions, 1);
+  REQUIRE(singlePredictions.n_rows == 3);
+  REQUIRE(singlePredictions.n_cols == 50);
+
+  // Try batch sizes that do and do not divide the number of points, and one
+  // that is larger than the number of points.  The results matrix is reused.
+  arma::mat predictions;
+  const size_t batchSizes[] = { 7, 10, 50, 128 };
+  for (const size_t batchSize : batchSizes)
+  {
+    model.Predict(data, predictions, batchSize);
+    REQUIRE(predictions.n_rows == 3);
+    REQUIRE(predictions.n_cols == 50);
+    for (size_t i = 0; i < predictions.n_elem; ++i)
+      REQUIRE(predictions[i] == Approx(singlePredictions[i]).epsilon(1e-7));
+  }
+
+  // Predicting on no points gives no predictions.
+  model.Predict(arma::mat(10, 0), predictions);
+  REQUIRE(predictions.n_elem == 0);
+
+  REQUIRE_THROWS_AS(model.Predict(data, predictions, 0),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that replicas made with ShareParameters() use the parameters of the
+ * original network without copying them, and can predict concurrently.
+ */
+TEST_CASE("FFNShareParametersTest", "[FeedForwardNetworkTest]")
+{
+  FFN<NegativeLogLikelihood<>, RandomInitialization> model;
+  model.Add<Linear<>>(10, 8);
+  model.Add<SigmoidLayer<>>();
+  model.Add<Linear<>>(8, 3);
+  model.Add<LogSoftMax<>>();
+
+  arma::mat data = arma::randu<arma::mat>(10, 40);
+  arma::mat predictions;
+  model.Predict(data, predictions);
+
+  std::vector<FFN<NegativeLogLikelihood<>, RandomInitialization>> replicas(4);
+  for (size_t i = 0; i < replicas.size(); ++i)
+  {
+    replicas[i].ShareParameters(model);
+    REQUIRE(replicas[i].Parameters().memptr() == model.Parameters().memptr());
+  }
+
+  std::vector<arma::mat> replicaPredictions(replicas.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < replicas.size(); ++i)
+  {
+    threads.push_back(std::thread([&, i]()
+    {
+      for (size_t j = 0; j < 10; ++j)
+        replicas[i].Predict(data, replicaPredictions[i], 1 + i);
+    }));
+  }
+  for (std::thread& t : threads)
+    t.join();
+
+  for (size_t i = 0; i < replicas.size(); ++i)
+  {
+    REQUIRE(replicaPredictions[i].n_rows == predictions.n_rows);
+    REQUIRE(replicaPredictions[i].n_cols == predictions.n_cols);
+    for (size_t j = 0; j < predictions.n_elem; ++j)
+    {
+      REQUIRE(replicaPredictions[i][j] ==
+          Approx(predictions[j]).epsilon(1e-7));
+    }
+  }
+
+  // Changing the parameters of the original network changes the replicas.
+  model.Parameters() *= 2;
+  arma::mat newPredictions, newReplicaPredictions;
+  model.Predict(data, newPredictions);
+  replicas[0].Predict(data, newReplicaPredictions);
+  CheckMatrices(newPredictions, newReplicaPredictions);
+}
+
+/**
+ * Make sure that folding BatchNorm layers into the Linear and Convolution
+ * layers before them doesn't change the predictions of the network.
+ */
+TEST_CASE("FFNFoldBatchNormTest", "[FeedForwardNetworkTest]")
+{
+  FFN<NegativeLogLikelihood<>, RandomInitialization> model;
+  model.Add<Convolution<>>(1, 4, 3, 3, 1, 1, 0, 0, 6, 6);
+  model.Add<BatchNorm<>>(4);
+  model.Add<ReLULayer<>>();
+  model.Add<Linear<>>(64, 10);
+  model.Add<BatchNorm<>>(10);
+  model.Add<SigmoidLayer<>>();
+  // This one can't be folded.
+  model.Add<BatchNorm<>>(10);
+  model.Add<Linear<>>(10, 3);
+  model.Add<LogSoftMax<>>();
+  model.ResetParameters();
+
+  // Give the BatchNorm layers non-trivial statistics and parameters.
+  for (size_t i = 0; i < model.Model().size(); ++i)
+  {
+    BatchNorm<>* const* batchNorm = boost::get<BatchNorm<>*>(&model.Model()[i]);
+    if (batchNorm)
+    {
+      (*batchNorm)->Parameters().randu();
+      (*batchNorm)->Parameters() += 0.5;
+      (*batchNorm)->TrainingMean().randn();
+      (*batchNorm)->TrainingVariance().randu();
+      (*batchNorm)->TrainingVariance() += 0.5;
+    }
+  }
+
+  arma::mat data = arma::randu<arma::mat>(36, 20);
+  arma::mat predictions, foldedPredictions;
+  model.Predict(data, predictions);
+
+  const size_t numParameters = model.Parameters().n_elem;
+  REQUIRE(model.FoldBatchNorm() == 2);
+  REQUIRE(model.Model().size() == 7);
+  REQUIRE(model.Parameters().n_elem == numParameters - 4 * 2 - 10 * 2);
+
+  model.Predict(data, foldedPredictions);
+  CheckMatrices(predictions, foldedPredictions, 1e-6);
+
+  // There is nothing left to fold.
+  REQUIRE(model.FoldBatchNorm() == 0);
+}
+
+/**
+ * Make sure that the int8 quantized version of a network gives predictions
+ * close to the original network, with smaller weights, and that it can be
+ * serialized.
+ */
+TEST_CASE("QuantizedFFNTest", "[FeedForwardNetworkTest]")
+{
+  FFN<NegativeLogLikelihood<>, RandomInitialization> model;
+  model.Add<Linear<>>(10, 32);
+  model.Add<ReLULayer<>>();
+  model.Add<Dropout<>>();
+  model.Add<Linear<>>(32, 3);
+  model.Add<LogSoftMax<>>();
+  model.ResetParameters();
+
+  FFN<NegativeLogLikelihood<>, RandomInitialization> convModel;
+  convModel.Add<Convolution<>>(1, 4, 3, 3, 1, 1, 1, 1, 8, 8);
+  convModel.Add<ReLULayer<>>();
+  convModel.Add<Linear<>>(4 * 8 * 8, 5);
+  convModel.Add<Softmax<>>();
+  convModel.ResetParameters();
+
+  arma::mat data = arma::randu<arma::mat>(10, 200);
+  arma::mat convData = arma::randu<arma::mat>(64, 200);
+
+  for (size_t m = 0; m < 2; ++m)
+  {
+    FFN<NegativeLogLikelihood<>, RandomInitialization>& network =
+        (m == 0) ? model : convModel;
+    const arma::mat& input = (m == 0) ? data : convData;
+
+    QuantizedFFN quantized(network, input.cols(0, 99));
+    REQUIRE(quantized.NumLayers() == network.Model().size());
+    REQUIRE(quantized.WeightBytes() <
+        network.Parameters().n_elem * sizeof(double));
+
+    arma::mat predictions, quantizedPredictions;
+    network.Predict(input, predictions);
+    // Use a batch size that does not divide the number of points.
+    quantized.Predict(input, quantizedPredictions, 64);
+
+    REQUIRE(quantizedPredictions.n_rows == predictions.n_rows);
+    REQUIRE(quantizedPredictions.n_cols == predictions.n_cols);
+    const double tolerance = 0.05 *
+        std::max(1.0, arma::abs(predictions).max());
+    REQUIRE(arma::abs(quantizedPredictions - predictions).max() <= tolerance);
+
+    QuantizedFFN xmlQuantized, jsonQuantized, binaryQuantized;
+    SerializeObjectAll(quantized, xmlQuantized, jsonQuantized,
+        binaryQuantized);
+
+    arma::mat xmlPredictions, jsonPredictions, binaryPredictions;
+    xmlQuantized.Predict(input, xmlPredictions);
+    jsonQuantized.Predict(input, jsonPredictions);
+    binaryQuantized.Predict(input, binaryPredictions);
+    CheckMatrices(quantizedPredictions, xmlPredictions);
+    CheckMatrices(quantizedPredictions, jsonPredictions);
+    CheckMatrices(quantizedPredictions, binaryPredictions);
+  }
+
+  // BatchNorm layers have to be folded before quantization.
+  FFN<NegativeLogLikelihood<>, RandomInitialization> batchNormModel;
+  batchNormModel.Add<Linear<>>(10, 5);
+  batchNormModel.Add<BatchNorm<>>(5);
+  batchNormModel.Add<LogSoftMax<>>();
+  batchNormModel.ResetParameters();
+  REQUIRE_THROWS_AS(QuantizedFFN(batchNormModel, data),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that sharing buffers between the layers does not change the
+ * predictions or the gradient, and that it reduces the estimated memory.
+ */
+TEST_CASE("FFNReuseBuffersTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat input = arma::randu<arma::mat>(10, 30);
+  arma::mat labels = arma::floor(arma::randu<arma::mat>(1, 30) * 3);
+
+  FFN<NegativeLogLikelihood<>, RandomInitialization> model;
+  model.Add<Linear<>>(10, 16);
+  model.Add<ReLULayer<>>();
+  model.Add<Linear<>>(16, 16);
+  model.Add<SigmoidLayer<>>();
+  model.Add<Linear<>>(16, 3);
+  model.Add<LogSoftMax<>>();
+  model.ResetParameters();
+  model.Predictors() = input;
+  model.Responses() = labels;
+
+  FFN<NegativeLogLikelihood<>, RandomInitialization> sharedModel(model);
+  sharedModel.ReuseBuffers() = true;
+
+  // The last batch is smaller than the others.
+  arma::mat predictions, sharedPredictions;
+  model.Predict(input, predictions, 7);
+  sharedModel.Predict(input, sharedPredictions, 7);
+  CheckMatrices(predictions, sharedPredictions);
+
+  // The first call plans the buffers, and the next ones use them.
+  for (size_t trial = 0; trial < 3; ++trial)
+  {
+    arma::mat gradient, sharedGradient;
+    const double objective = model.EvaluateWithGradient(model.Parameters(),
+        5 * trial, gradient, 10);
+    const double sharedObjective = sharedModel.EvaluateWithGradient(
+        sharedModel.Parameters(), 5 * trial, sharedGradient, 10);
+
+    REQUIRE(sharedObjective == Approx(objective).epsilon(1e-10));
+    CheckMatrices(gradient, sharedGradient);
+  }
+
+  // Predictions still work after training steps.
+  sharedModel.Predict(input, sharedPredictions, 4);
+  CheckMatrices(predictions, sharedPredictions);
+
+  REQUIRE(sharedModel.PeakMemory(input, 32, false) <
+      model.PeakMemory(input, 32, false));
+  REQUIRE(sharedModel.PeakMemory(input, 32, true) <
+      model.PeakMemory(input, 32, true));
+  // Without shared buffers, the outputs of all layers are kept: 16 + 16 + 16
+  // + 16 + 3 + 3 elements per point.
+  REQUIRE(model.PeakMemory(input, 32, false) == 70 * 32 * sizeof(double));
+}
+
+/**
+ * Check that splitting a batch of the given model across threads gives the
+ * same objective and gradient as computing it with one thread.
+ */
+template<typename ModelType>
+void CheckParallelGradient(ModelType& model)
+{
+  arma::mat gradient;
+  const double objective = model.EvaluateWithGradient(model.Parameters(), 5,
+      gradient, 40);
+
+  model.NumThreads() = 4;
+  arma::mat parallelGradient;
+  const double parallelObjective = model.EvaluateWithGradient(
+      model.Parameters(), 5, parallelGradient, 40);
+  model.NumThreads() = 1;
+
+  REQUIRE(parallelObjective == Approx(objective).epsilon(1e-7));
+  CheckMatrices(gradient, parallelGradient);
+}
+
+/**
+ * Make sure that splitting a batch across threads gives the same objective and
+ * gradient as computing it with one thread, whether the loss is summed
+ * (NegativeLogLikelihood) or averaged (MeanSquaredError) over the batch, and
+ * with regularized layers.  The parts of the batch have different sizes.
+ */
+TEST_CASE("FFNParallelGradientTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat input = arma::randu<arma::mat>(10, 50);
+  arma::mat labels = arma::floor(arma::randu<arma::mat>(1, 50) * 3);
+
+  FFN<NegativeLogLikelihood<>, RandomInitialization> model;
+  model.Add<Linear<>>(10, 8);
+  model.Add<SigmoidLayer<>>();
+  model.Add<Linear<>>(8, 3);
+  model.Add<LogSoftMax<>>();
+  model.ResetParameters();
+  model.Predictors() = input;
+  model.Responses() = labels;
+  CheckParallelGradient(model);
+
+  // The mean squared error is averaged over the batch.
+  arma::mat responses = arma::randu<arma::mat>(2, 50);
+  FFN<MeanSquaredError<>, RandomInitialization> mseModel;
+  mseModel.Add<Linear<>>(10, 8);
+  mseModel.Add<SigmoidLayer<>>();
+  mseModel.Add<Linear<>>(8, 2);
+  mseModel.ResetParameters();
+  mseModel.Predictors() = input;
+  mseModel.Responses() = responses;
+  CheckParallelGradient(mseModel);
+
+  // The regularizers add to the gradient once per batch.
+  typedef Linear<arma::mat, arma::mat, L2Regularizer> RegularizedLinear;
+  FFN<MeanSquaredError<>, RandomInitialization, RegularizedLinear>
+      regularizedModel;
+  regularizedModel.Add<RegularizedLinear>(10, 8, L2Regularizer(0.5));
+  regularizedModel.Add<SigmoidLayer<>>();
+  regularizedModel.Add<RegularizedLinear>(8, 2, L2Regularizer(0.5));
+  regularizedModel.ResetParameters();
+  regularizedModel.Predictors() = input;
+  regularizedModel.Responses() = responses;
+  CheckParallelGradient(regularizedModel);
+
+  // Training with several threads should still give a good model.
+  arma::mat trainData;
+  if (!data::Load("thyroid_train.csv", trainData))
+    FAIL("Cannot open thyroid_train.csv");
+
+  arma::mat trainLabels = trainData.row(trainData.n_rows - 1);
+  trainData.shed_row(trainData.n_rows - 1);
+  trainLabels -= 1; // Labels should be from 0 to numClasses - 1.
+
+  arma::mat testData;
+  if (!data::Load("thyroid_test.csv", testData))
+    FAIL("Cannot load dataset thyroid_test.csv");
+
+  arma::mat testLabels = testData.row(testData.n_rows - 1);
+  testData.shed_row(testData.n_rows - 1);
+  testLabels -= 1; // Labels should be from 0 to numClasses - 1.
+
+  FFN<NegativeLogLikelihood<>> thyroidModel;
+  thyroidModel.Add<Linear<>>(trainData.n_rows, 8);
+  thyroidModel.Add<SigmoidLayer<>>();
+  thyroidModel.Add<Linear<>>(8, 3);
+  thyroidModel.Add<LogSoftMax<>>();
+  thyroidModel.NumThreads() = 2;
+
+  TestNetwork<>(thyroidModel, trainData, trainLabels, testData, testLabels, 10,
+      0.1);
+}
+
 /**
  * Test that serialization works ok.
  */
@@ -904,6 +1386,84 @@ TEST_CASE("FFNTrainReturnObjective", "[FeedForwardNetworkTest]")
   REQUIRE(std::isfinite(objVal) == true);
 }
 
+/**
+ * Make sure that a DataPipeline returns its batches in order, can be reset, and
+ * rethrows the errors of its source; and that training on its batches gives
+ * the same model as training on each batch in turn.
+ */
+TEST_CASE("FFNDataPipelineTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat input = arma::randu<arma::mat>(10, 100);
+  arma::mat labels = arma::floor(arma::randu<arma::mat>(1, 100) * 3);
+  const size_t batchSize = 30;
+  auto source = [&](const size_t b, arma::mat& predictors,
+                    arma::mat& responses)
+  {
+    if (b * batchSize >= input.n_cols)
+      return false;
+
+    const size_t last = std::min((b + 1) * batchSize, (size_t) input.n_cols)
+        - 1;
+    predictors = input.cols(b * batchSize, last);
+    responses = labels.cols(b * batchSize, last);
+    return true;
+  };
+
+  data::DataPipeline<> pipeline(source, 1);
+  arma::mat predictors, responses;
+  for (size_t pass = 0; pass < 2; ++pass)
+  {
+    size_t numBatches = 0;
+    while (pipeline.Next(predictors, responses))
+    {
+      arma::mat expectedPredictors, expectedResponses;
+      source(numBatches, expectedPredictors, expectedResponses);
+      CheckMatrices(predictors, expectedPredictors);
+      CheckMatrices(responses, expectedResponses);
+      ++numBatches;
+    }
+
+    REQUIRE(numBatches == 4);
+    pipeline.Reset();
+  }
+
+  data::DataPipeline<> failingPipeline([](const size_t b, arma::mat& p,
+                                          arma::mat& /* r */)
+  {
+    if (b == 1)
+      throw std::runtime_error("cannot load batch");
+
+    p.ones(2, 2);
+    return true;
+  });
+  REQUIRE(failingPipeline.Next(predictors, responses) == true);
+  REQUIRE_THROWS_AS(failingPipeline.Next(predictors, responses),
+      std::runtime_error);
+
+  FFN<NegativeLogLikelihood<>, RandomInitialization> model;
+  model.Add<Linear<>>(10, 8);
+  model.Add<SigmoidLayer<>>();
+  model.Add<Linear<>>(8, 3);
+  model.Add<LogSoftMax<>>();
+  model.ResetParameters();
+  FFN<NegativeLogLikelihood<>, RandomInitialization> batchModel = model;
+
+  ens::StandardSGD opt(0.01, 10, batchSize, 1e-8, false);
+  pipeline.Reset();
+  const double objective = model.Train(pipeline, opt, 2);
+
+  double batchObjective = 0.0;
+  for (size_t epoch = 0; epoch < 2; ++epoch)
+  {
+    batchObjective = 0.0;
+    for (size_t b = 0; source(b, predictors, responses); ++b)
+      batchObjective += batchModel.Train(predictors, responses, opt);
+  }
+
+  REQUIRE(objective == Approx(batchObjective).epsilon(1e-7));
+  CheckMatrices(model.Parameters(), batchModel.Parameters());
+}
+
 /**
  * Test that FFN::Model() allows us to access the instantiated network.
  */
@@ -1008,3 +1568,57 @@ TEST_CASE("FFNCheckInputShapeTest", "[FeedForwardNetworkTest]")
 
   REQUIRE_THROWS_AS(model.Train(trainData, trainLabels, opt), std::logic_error);
 }
+
+/**
+ * Make sure that pruned Linear layers are converted to SparseLinear layers
+ * with the same predictions, and that the sparse network can be serialized.
+ */
+TEST_CASE("FFNPruneSparsifyLinearTest", "[FeedForwardNetworkTest]")
+{
+  FFN<NegativeLogLikelihood<>, RandomInitialization> model;
+  model.Add<Linear<>>(10, 40);
+  model.Add<SigmoidLayer<>>();
+  model.Add<Linear<>>(40, 3);
+  model.Add<LogSoftMax<>>();
+  model.ResetParameters();
+
+  // Prune 90% of the weights of each layer, then 70% of the units of each
+  // layer, after giving the last layer new weights.
+  REQUIRE(PruneLinear(model, 0.9) == 360 + 108);
+  Linear<>* last = boost::get<Linear<>*>(model.Model()[2]);
+  arma::mat lastWeight(last->Parameters().memptr(), 3, 40, false, true);
+  lastWeight.randu();
+  REQUIRE(PruneLinear(model, 0.7, true) == 28 * 10 + 2 * 40);
+
+  arma::mat data = arma::randu<arma::mat>(10, 50);
+  arma::mat predictions, sparsePredictions;
+  model.Predict(data, predictions);
+
+  // Both layers are sparse enough to be converted.
+  REQUIRE(model.SparsifyLinear() == 2);
+  REQUIRE(model.Model().size() == 4);
+  REQUIRE(model.Parameters().n_elem == 0);
+  SparseLinear<>* first = boost::get<SparseLinear<>*>(
+      boost::get<MoreTypes>(model.Model()[0]));
+  REQUIRE(first->NonZeros() <= 40);
+
+  model.Predict(data, sparsePredictions);
+  CheckMatrices(predictions, sparsePredictions, 1e-10);
+
+  // There is nothing left to convert.
+  REQUIRE(model.SparsifyLinear() == 0);
+
+  FFN<NegativeLogLikelihood<>, RandomInitialization> xmlModel, jsonModel,
+      binaryModel;
+  SerializeObjectAll(model, xmlModel, jsonModel, binaryModel);
+
+  arma::mat xmlPredictions, jsonPredictions, binaryPredictions;
+  xmlModel.Predict(data, xmlPredictions);
+  jsonModel.Predict(data, jsonPredictions);
+  binaryModel.Predict(data, binaryPredictions);
+  CheckMatrices(sparsePredictions, xmlPredictions, 1e-10);
+  CheckMatrices(sparsePredictions, jsonPredictions, 1e-10);
+  CheckMatrices(sparsePredictions, binaryPredictions, 1e-10);
+
+  REQUIRE_THROWS_AS(PruneLinear(xmlModel, 1.5), std::invalid_argument);
+}
@@ -345,3 +345,54 @@ TEST_CASE("GANMemorySharingTest", "[GANNetworkTest]")
   CheckMatricesNotEqual(gan.Predictors().head_cols(trainData.n_cols),
       trainData);
 }
+
+/**
+ * Noise function that fills a whole batch of noise at once.
+ */
+class BatchedUniformNoise
+{
+ public:
+  void operator()(arma::mat& noise) const
+  {
+    noise.randu();
+    noise = noise * 16 - 8;
+  }
+};
+
+/**
+ * Make sure that a GAN can be trained with a noise function that fills whole
+ * batches, and that the training data is left untouched.
+ */
+TEST_CASE("GANBatchedNoiseTest", "[GANNetworkTest]")
+{
+  const size_t batchSize = 8;
+  const size_t noiseDim = 2;
+
+  arma::mat trainData(1, 1000);
+  trainData.imbue( [&]() { return arma::as_scalar(RandNormal(4, 0.5));});
+  const arma::mat originalData = trainData;
+
+  FFN<SigmoidCrossEntropyError<> > discriminator;
+  discriminator.Add<Linear<> >(1, 8);
+  discriminator.Add<ReLULayer<> >();
+  discriminator.Add<Linear<> >(8, 1);
+
+  FFN<SigmoidCrossEntropyError<> > generator;
+  generator.Add<Linear<> >(noiseDim, 8);
+  generator.Add<SoftPlusLayer<> >();
+  generator.Add<Linear<> >(8, 1);
+
+  GaussianInitialization gaussian(0, 0.1);
+  ens::Adam optimizer(0.0003, batchSize, 0.9, 0.999, 1e-8, 200, 1e-5, true);
+  BatchedUniformNoise noiseFunction;
+  GAN<FFN<SigmoidCrossEntropyError<> >,
+      GaussianInitialization,
+      BatchedUniformNoise>
+  gan(generator, discriminator, gaussian, noiseFunction, noiseDim, batchSize,
+      1, 0, 1);
+
+  const double objective = gan.Train(trainData, optimizer);
+  REQUIRE(std::isfinite(objective));
+  CheckMatrices(trainData, originalData);
+  CheckMatrices(gan.Predictors().head_cols(trainData.n_cols), trainData);
+}
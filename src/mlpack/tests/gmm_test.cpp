@@ -407,6 +407,77 @@ TEST_CASE("GMMTrainEMMultipleGaussiansWithProbability", "[GMMTest]")
   }
 }
 
+/**
+ * Make sure that one iteration of EMFit, whose E-step works on blocks of points
+ * in parallel, gives the model computed directly from the responsibilities of
+ * every point, with and without probabilities for the points.  There are enough
+ * points for several blocks.
+ */
+TEST_CASE("EMFitSingleIterationTest", "[GMMTest]")
+{
+  const size_t gaussians = 3;
+  const size_t points = 3500;
+  arma::mat data(2, points, arma::fill::randn);
+  data.cols(0, 999) += 4.0;
+  data.cols(1000, 1999) -= 3.0;
+  const arma::vec probabilities = arma::randu<arma::vec>(points) + 0.5;
+
+  std::vector<distribution::GaussianDistribution> initialDists;
+  initialDists.push_back(distribution::GaussianDistribution("3.0 3.5",
+      "1.5 0.2; 0.2 1.0"));
+  initialDists.push_back(distribution::GaussianDistribution("-2.5 -3.0",
+      "1.0 0.0; 0.0 2.0"));
+  initialDists.push_back(distribution::GaussianDistribution("0.5 0.0",
+      "2.0 -0.3; -0.3 1.0"));
+  const arma::vec initialWeights("0.3 0.3 0.4");
+
+  for (size_t weighted = 0; weighted < 2; ++weighted)
+  {
+    // Compute the responsibilities of each point directly.
+    arma::mat responsibilities(points, gaussians);
+    for (size_t j = 0; j < gaussians; ++j)
+    {
+      for (size_t i = 0; i < points; ++i)
+      {
+        responsibilities(i, j) = initialWeights[j] *
+            initialDists[j].Probability(data.col(i));
+      }
+    }
+    responsibilities.each_col() /= arma::sum(responsibilities, 1);
+    if (weighted == 1)
+      responsibilities.each_col() %= probabilities;
+
+    // The second iteration stops the fit, so there is one update.
+    std::vector<distribution::GaussianDistribution> dists(initialDists);
+    arma::vec weights(initialWeights);
+    EMFit<kmeans::KMeans<>, NoConstraint> fitter(2, 1e-10);
+    if (weighted == 1)
+      fitter.Estimate(data, probabilities, dists, weights, true);
+    else
+      fitter.Estimate(data, dists, weights, true);
+
+    const double total = (weighted == 1) ? arma::accu(probabilities) :
+        (double) points;
+    for (size_t j = 0; j < gaussians; ++j)
+    {
+      const double sum = arma::accu(responsibilities.col(j));
+      const arma::vec mean = data * responsibilities.col(j) / sum;
+      const arma::mat centered = data.each_col() - mean;
+      const arma::mat covariance = (centered.each_row() %
+          responsibilities.col(j).t()) * centered.t() / sum;
+
+      REQUIRE(weights[j] == Approx(sum / total).epsilon(1e-7));
+      for (size_t k = 0; k < mean.n_elem; ++k)
+        REQUIRE(dists[j].Mean()[k] == Approx(mean[k]).epsilon(1e-7));
+      for (size_t k = 0; k < covariance.n_elem; ++k)
+      {
+        REQUIRE(dists[j].Covariance()[k] ==
+            Approx(covariance[k]).epsilon(1e-7).margin(1e-10));
+      }
+    }
+  }
+}
+
 /**
  * Make sure generating observations randomly works.  We'll do this by
  * generating a bunch of random observations and then re-training on them, and
@@ -838,6 +909,61 @@ TEST_CASE("UseExistingModelTest", "[GMMTest]")
   }
 }
 
+/**
+ * Make sure that online EM updates recover a mixture from a stream of
+ * mini-batches, starting from a rough model.
+ */
+TEST_CASE("GMMOnlineEMUpdateTest", "[GMMTest]")
+{
+  const arma::mat trueMeans("-5 5; -5 5");
+  const arma::vec trueWeights("0.3 0.7");
+
+  // Start from a model with the means and weights off.
+  std::vector<distribution::GaussianDistribution> dists;
+  dists.push_back(distribution::GaussianDistribution(arma::vec("-3 -4"),
+      arma::eye<arma::mat>(2, 2)));
+  dists.push_back(distribution::GaussianDistribution(arma::vec("4 3"),
+      arma::eye<arma::mat>(2, 2)));
+  GMM gmm(dists, arma::vec("0.5 0.5"));
+
+  OnlineEMFit<> fitter;
+  double firstLikelihood = 0.0, lastLikelihood = 0.0;
+  for (size_t batch = 0; batch < 100; ++batch)
+  {
+    arma::mat data(2, 200, arma::fill::randn);
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      const size_t component = (math::Random() < trueWeights[0]) ? 0 : 1;
+      data.col(i) += trueMeans.col(component);
+    }
+
+    const double likelihood = gmm.Update(data, fitter);
+    if (batch == 0)
+      firstLikelihood = likelihood;
+    lastLikelihood = likelihood;
+  }
+
+  REQUIRE(fitter.Steps() == 100);
+  REQUIRE(lastLikelihood > firstLikelihood);
+  for (size_t i = 0; i < 2; ++i)
+  {
+    REQUIRE(gmm.Weights()[i] == Approx(trueWeights[i]).margin(0.05));
+    for (size_t j = 0; j < 2; ++j)
+    {
+      REQUIRE(gmm.Component(i).Mean()[j] ==
+          Approx(trueMeans(j, i)).margin(0.3));
+      REQUIRE(gmm.Component(i).Covariance()(j, j) ==
+          Approx(1.0).margin(0.3));
+    }
+  }
+
+  // Invalid step sizes and mismatched batches are rejected.
+  REQUIRE_THROWS_AS(OnlineEMFit<>(0.5), std::invalid_argument);
+  REQUIRE_THROWS_AS(OnlineEMFit<>(0.6, 0.5), std::invalid_argument);
+  arma::mat wrongData(3, 10, arma::fill::randn);
+  REQUIRE_THROWS_AS(gmm.Update(wrongData, fitter), std::invalid_argument);
+}
+
 /********************************************************/
 /** Diagonal Gaussian Mixture Model(DiagonalGMM) Tests **/
 /********************************************************/
@@ -0,0 +1,277 @@
+/**
+ * @file tests/gradient_boosting_test.cpp
+ *
+ * Tests for the GradientBoosting and GradientBoostingTree classes.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/gradient_boosting/gradient_boosting.hpp>
+
+#include "serialization.hpp"
+#include "test_catch_tools.hpp"
+#include "catch.hpp"
+#include "mock_categorical_data.hpp"
+
+using namespace mlpack;
+using namespace mlpack::tree;
+
+/**
+ * Make sure a single tree fitted to the gradients of a step function splits at
+ * the step and predicts the Newton step in each leaf.
+ */
+TEST_CASE("GradientBoostingTreeStepTest", "[GradientBoostingTest]")
+{
+  // One dimension with 10 bins; the gradient is -1 in the first 5 bins and 1
+  // in the others.
+  arma::Mat<unsigned char> bins(100, 1);
+  arma::vec gradients(100), hessians(100, arma::fill::ones);
+  for (size_t i = 0; i < 100; ++i)
+  {
+    bins(i, 0) = i / 10;
+    gradients[i] = (i < 50) ? -1.0 : 1.0;
+  }
+
+  std::vector<arma::vec> splitValues(1,
+      arma::regspace<arma::vec>(0.5, 9.5));
+  std::vector<bool> categorical(1, false);
+
+  GradientBoostingTree::TrainingParameters parameters;
+  parameters.maximumDepth = 1;
+  parameters.minimumLeafSize = 1;
+  parameters.minimumChildWeight = 0.0;
+  parameters.lambda = 0.0;
+  parameters.gamma = 0.0;
+  parameters.learningRate = 1.0;
+
+  GradientBoostingTree tree;
+  tree.Train(bins, splitValues, categorical, gradients, hessians,
+      arma::regspace<arma::uvec>(0, 99), arma::uvec({ 0 }), parameters);
+
+  REQUIRE(tree.NumNodes() == 3);
+  REQUIRE(tree.NumLeaves() == 2);
+  REQUIRE(tree.Predict(arma::vec({ 3.0 })) == Approx(1.0));
+  REQUIRE(tree.Predict(arma::vec({ 4.5 })) == Approx(1.0));
+  REQUIRE(tree.Predict(arma::vec({ 4.6 })) == Approx(-1.0));
+  REQUIRE(tree.Predict(arma::vec({ 9.0 })) == Approx(-1.0));
+}
+
+/**
+ * Make sure that an untrained model throws when classifying.
+ */
+TEST_CASE("GradientBoostingEmptyClassifyTest", "[GradientBoostingTest]")
+{
+  GradientBoosting gb; // No training.
+
+  arma::mat points(10, 100, arma::fill::randu);
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  size_t prediction;
+  arma::vec pointProbabilities;
+  REQUIRE_THROWS_AS(gb.Classify(points, predictions), std::invalid_argument);
+  REQUIRE_THROWS_AS(gb.Classify(points.col(0)), std::invalid_argument);
+  REQUIRE_THROWS_AS(gb.Classify(points, predictions, probabilities),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(gb.Classify(points.col(0), prediction,
+      pointProbabilities), std::invalid_argument);
+}
+
+/**
+ * Test binary classification on two Gaussians.
+ */
+TEST_CASE("GradientBoostingBinaryTest", "[GradientBoostingTest]")
+{
+  arma::mat data(2, 2000, arma::fill::randn);
+  arma::Row<size_t> labels(2000);
+  for (size_t i = 0; i < 2000; ++i)
+  {
+    labels[i] = i % 2;
+    if (labels[i] == 1)
+      data.col(i) += 3.0;
+  }
+
+  const arma::mat trainData = data.cols(0, 999);
+  const arma::Row<size_t> trainLabels = labels.subvec(0, 999);
+  const arma::mat testData = data.cols(1000, 1999);
+  const arma::Row<size_t> testLabels = labels.subvec(1000, 1999);
+
+  GradientBoosting gb(50, 0.3, 3);
+  const double loss = gb.Train(trainData, trainLabels, 2);
+  REQUIRE(std::isfinite(loss));
+  REQUIRE(gb.NumTrees() == 50);
+
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  gb.Classify(testData, predictions, probabilities);
+
+  REQUIRE(probabilities.n_rows == 2);
+  REQUIRE(probabilities.n_cols == 1000);
+  for (size_t i = 0; i < probabilities.n_cols; ++i)
+    REQUIRE(arma::accu(probabilities.col(i)) == Approx(1.0));
+
+  const size_t correct = arma::accu(predictions == testLabels);
+  REQUIRE(correct >= 950);
+}
+
+/**
+ * Test multi-class classification on the vc2 dataset.
+ */
+TEST_CASE("GradientBoostingNumericLearningTest", "[GradientBoostingTest]")
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2.csv");
+
+  GradientBoosting gb(50, 0.1, 4);
+  gb.Subsample() = 0.8;
+  gb.ColumnSubsample() = 0.8;
+  gb.Train(dataset, labels, 3);
+  REQUIRE(gb.NumClasses() == 3);
+  REQUIRE(gb.NumTrees() == 150);
+
+  arma::mat testDataset;
+  if (!data::Load("vc2_test.csv", testDataset))
+    FAIL("Cannot load dataset vc2_test.csv");
+  arma::Row<size_t> testLabels;
+  if (!data::Load("vc2_test_labels.txt", testLabels))
+    FAIL("Cannot load dataset vc2_test_labels.txt");
+
+  arma::Row<size_t> predictions;
+  gb.Classify(testDataset, predictions);
+
+  const size_t correct = arma::accu(predictions == testLabels);
+  REQUIRE(correct >= size_t(0.75 * testDataset.n_cols));
+}
+
+/**
+ * Test learning on a dataset with categorical dimensions.
+ */
+TEST_CASE("GradientBoostingCategoricalLearningTest", "[GradientBoostingTest]")
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  // Split into a training set and a test set.
+  arma::mat trainingData = d.cols(0, 1999);
+  arma::mat testData = d.cols(2000, 3999);
+  arma::Row<size_t> trainingLabels = l.subvec(0, 1999);
+  arma::Row<size_t> testLabels = l.subvec(2000, 3999);
+
+  GradientBoosting gb(50, 0.2, 4);
+  gb.Train(trainingData, di, trainingLabels, 5);
+
+  arma::Row<size_t> predictions;
+  gb.Classify(testData, predictions);
+
+  const size_t correct = arma::accu(predictions == testLabels);
+  REQUIRE(correct >= size_t(0.7 * testData.n_cols));
+}
+
+/**
+ * Make sure that a categorical dimension with more categories than bins is
+ * rejected.
+ */
+TEST_CASE("GradientBoostingTooManyCategoriesTest", "[GradientBoostingTest]")
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  GradientBoosting gb(5);
+  gb.MaxBins() = 2;
+  REQUIRE_THROWS_AS(gb.Train(d, di, l, 5), std::invalid_argument);
+}
+
+/**
+ * Make sure that early stopping keeps the rounds with the lowest validation
+ * loss when the training labels are noisy.
+ */
+TEST_CASE("GradientBoostingEarlyStoppingTest", "[GradientBoostingTest]")
+{
+  arma::mat data(2, 1000, arma::fill::randn);
+  arma::Row<size_t> labels(1000);
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    labels[i] = (data(0, i) > 0.0) ? 1 : 0;
+    // Flip a third of the training labels.
+    if (i < 500 && i % 3 == 0)
+      labels[i] = 1 - labels[i];
+  }
+
+  const arma::mat trainData = data.cols(0, 499);
+  const arma::Row<size_t> trainLabels = labels.subvec(0, 499);
+  const arma::mat validationData = data.cols(500, 999);
+  const arma::Row<size_t> validationLabels = labels.subvec(500, 999);
+
+  GradientBoosting gb(500, 0.5, 0);
+  gb.EarlyStoppingRounds() = 10;
+  const double loss = gb.Train(trainData, trainLabels, 2, validationData,
+      validationLabels);
+
+  // The deep trees overfit the noise quickly, so training stops long before
+  // all the rounds are used.
+  REQUIRE(gb.NumTrees() < 500);
+
+  // The returned loss is the validation loss of the kept model.
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  gb.Classify(validationData, predictions, probabilities);
+  double validationLoss = 0.0;
+  for (size_t i = 0; i < validationLabels.n_elem; ++i)
+  {
+    validationLoss -= std::log(std::max(probabilities(validationLabels[i], i),
+        1e-15));
+  }
+  validationLoss /= validationLabels.n_elem;
+  REQUIRE(loss == Approx(validationLoss).epsilon(1e-5));
+
+  const size_t correct = arma::accu(predictions == validationLabels);
+  REQUIRE(correct >= 400);
+}
+
+/**
+ * Make sure serialization works.
+ */
+TEST_CASE("GradientBoostingSerializationTest", "[GradientBoostingTest]")
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2.csv");
+
+  GradientBoosting gb(10, 0.3, 3);
+  gb.Train(dataset, labels, 3);
+
+  arma::Row<size_t> beforePredictions;
+  arma::mat beforeProbabilities;
+  gb.Classify(dataset, beforePredictions, beforeProbabilities);
+
+  GradientBoosting xmlModel, jsonModel, binaryModel(3, 0.5, 2);
+  binaryModel.Train(dataset, labels, 3);
+  SerializeObjectAll(gb, xmlModel, jsonModel, binaryModel);
+
+  arma::Row<size_t> xmlPredictions, jsonPredictions, binaryPredictions;
+  arma::mat xmlProbabilities, jsonProbabilities, binaryProbabilities;
+
+  xmlModel.Classify(dataset, xmlPredictions, xmlProbabilities);
+  jsonModel.Classify(dataset, jsonPredictions, jsonProbabilities);
+  binaryModel.Classify(dataset, binaryPredictions, binaryProbabilities);
+
+  CheckMatrices(beforePredictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+  CheckMatrices(beforeProbabilities, xmlProbabilities, jsonProbabilities,
+      binaryProbabilities);
+}
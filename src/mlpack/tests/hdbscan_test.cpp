@@ -0,0 +1,189 @@
+/**
+ * @file tests/hdbscan_test.cpp
+ *
+ * Test the HDBSCAN implementation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/hdbscan/hdbscan.hpp>
+
+#include "test_catch_tools.hpp"
+#include "catch.hpp"
+
+using namespace mlpack;
+using namespace mlpack::hdbscan;
+
+/**
+ * Create three Gaussian clusters of different densities, with 100 points
+ * each, followed by the given number of far away outliers.
+ */
+arma::mat HDBSCANTestData(const size_t numOutliers = 0)
+{
+  arma::mat points(2, 300 + numOutliers);
+  points.cols(0, 99) = 0.5 * arma::randn<arma::mat>(2, 100);
+  points.cols(100, 199) = 1.5 * arma::randn<arma::mat>(2, 100);
+  points.cols(100, 199).each_col() += arma::vec("20.0 20.0");
+  points.cols(200, 299) = 0.2 * arma::randn<arma::mat>(2, 100);
+  points.cols(200, 299).each_col() += arma::vec("-20.0 20.0");
+
+  for (size_t i = 0; i < numOutliers; ++i)
+  {
+    points(0, 300 + i) = 100.0 + 50.0 * i;
+    points(1, 300 + i) = -100.0 - 50.0 * i;
+  }
+
+  return points;
+}
+
+/**
+ * Make sure that clusters of different densities are all found, which is not
+ * possible with any single value of epsilon for DBSCAN.
+ */
+TEST_CASE("HDBSCANThreeClustersTest", "[HDBSCANTest]")
+{
+  const arma::mat points = HDBSCANTestData();
+
+  HDBSCAN h(10);
+  arma::Row<size_t> assignments;
+  const size_t clusters = h.Cluster(points, assignments);
+
+  REQUIRE(clusters == 3);
+  REQUIRE(assignments.n_elem == points.n_cols);
+
+  // Most points of each blob should be in the same cluster, and no point
+  // should be in the cluster of another blob.
+  arma::Row<size_t> blobClusters(3);
+  for (size_t b = 0; b < 3; ++b)
+  {
+    arma::Row<size_t> counts(clusters, arma::fill::zeros);
+    for (size_t i = 100 * b; i < 100 * (b + 1); ++i)
+      if (assignments[i] != SIZE_MAX)
+        ++counts[assignments[i]];
+
+    blobClusters[b] = counts.index_max();
+    REQUIRE(counts[blobClusters[b]] >= 70);
+    REQUIRE(arma::accu(counts) == counts[blobClusters[b]]);
+  }
+
+  REQUIRE(blobClusters[0] != blobClusters[1]);
+  REQUIRE(blobClusters[0] != blobClusters[2]);
+  REQUIRE(blobClusters[1] != blobClusters[2]);
+}
+
+/**
+ * Check that outliers are labeled as noise.
+ */
+TEST_CASE("HDBSCANOutlierTest", "[HDBSCANTest]")
+{
+  const arma::mat points = HDBSCANTestData(3);
+
+  HDBSCAN h(10);
+  arma::Row<size_t> assignments;
+  const size_t clusters = h.Cluster(points, assignments);
+
+  REQUIRE(clusters == 3);
+  REQUIRE(assignments[300] == SIZE_MAX);
+  REQUIRE(assignments[301] == SIZE_MAX);
+  REQUIRE(assignments[302] == SIZE_MAX);
+}
+
+/**
+ * Check the core distances against a brute-force computation, and make sure
+ * the spanning tree of the mutual reachability distances has the right size.
+ */
+TEST_CASE("HDBSCANCoreDistancesTest", "[HDBSCANTest]")
+{
+  const arma::mat points(3, 200, arma::fill::randu);
+
+  HDBSCAN h(5, 7);
+  arma::Row<size_t> assignments;
+  h.Cluster(points, assignments);
+
+  REQUIRE(h.CoreDistances().n_elem == points.n_cols);
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    arma::vec distances(points.n_cols);
+    for (size_t j = 0; j < points.n_cols; ++j)
+      distances[j] = arma::norm(points.col(i) - points.col(j));
+    distances = arma::sort(distances);
+
+    // The point itself is the first of the 7 neighbors.
+    REQUIRE(h.CoreDistances()[i] == Approx(distances[6]).epsilon(1e-7));
+  }
+
+  REQUIRE(h.SpanningTree().n_rows == 3);
+  REQUIRE(h.SpanningTree().n_cols == points.n_cols - 1);
+}
+
+/**
+ * Splitting the searches into parallel tasks should give the same clusters.
+ */
+TEST_CASE("HDBSCANParallelDepthTest", "[HDBSCANTest]")
+{
+  const arma::mat points = HDBSCANTestData(3);
+
+  HDBSCAN h(10);
+  arma::Row<size_t> assignments;
+  const size_t clusters = h.Cluster(points, assignments);
+  const arma::vec coreDistances = h.CoreDistances();
+  const double length = arma::accu(h.SpanningTree().row(2));
+
+  h.ParallelDepth() = 3;
+  arma::Row<size_t> parallelAssignments;
+  const size_t parallelClusters = h.Cluster(points, parallelAssignments);
+
+  REQUIRE(parallelClusters == clusters);
+  REQUIRE(arma::approx_equal(h.CoreDistances(), coreDistances, "absdiff",
+      1e-10));
+  REQUIRE(arma::accu(h.SpanningTree().row(2)) ==
+      Approx(length).epsilon(1e-7));
+}
+
+/**
+ * With a minimum cluster size larger than the dataset, everything is noise;
+ * with allowSingleCluster, a single tight cluster is returned as one cluster.
+ */
+TEST_CASE("HDBSCANClusterSizeTest", "[HDBSCANTest]")
+{
+  const arma::mat points = 0.1 * arma::randn<arma::mat>(2, 50);
+  arma::Row<size_t> assignments;
+
+  HDBSCAN large(60, 5);
+  REQUIRE(large.Cluster(points, assignments) == 0);
+  REQUIRE(assignments.n_elem == points.n_cols);
+  for (size_t i = 0; i < assignments.n_elem; ++i)
+    REQUIRE(assignments[i] == SIZE_MAX);
+
+  HDBSCAN single(30, 5, true);
+  REQUIRE(single.Cluster(points, assignments) == 1);
+
+  HDBSCAN invalid(1);
+  REQUIRE_THROWS_AS(invalid.Cluster(points, assignments),
+      std::invalid_argument);
+}
+
+/**
+ * Check that the centroids are the means of the points of each cluster.
+ */
+TEST_CASE("HDBSCANCentroidsTest", "[HDBSCANTest]")
+{
+  const arma::mat points = HDBSCANTestData(3);
+
+  HDBSCAN h(10);
+  arma::Row<size_t> assignments;
+  arma::mat centroids;
+  const size_t clusters = h.Cluster(points, assignments, centroids);
+
+  REQUIRE(centroids.n_rows == points.n_rows);
+  REQUIRE(centroids.n_cols == clusters);
+  for (size_t c = 0; c < clusters; ++c)
+  {
+    const arma::uvec members = arma::find(assignments == c);
+    const arma::vec mean = arma::mean(points.cols(members), 1);
+    REQUIRE(arma::approx_equal(centroids.col(c), mean, "absdiff", 1e-10));
+  }
+}
@@ -10,6 +10,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/hmm/hmm.hpp>
+#include <mlpack/methods/hmm/streaming_viterbi.hpp>
 #include <mlpack/methods/gmm/gmm.hpp>
 #include <mlpack/methods/gmm/diagonal_gmm.hpp>
 
@@ -60,6 +61,63 @@ TEST_CASE("SimpleDiscreteHMMTestViterbi", "[HMMTest]")
   REQUIRE(states[4] == 0); // Rain.
 }
 
+/**
+ * Make sure that the streaming Viterbi decoder finds the same states as
+ * HMM::Predict() when the lag covers the whole sequence, and that it commits
+ * one state per step after the lag otherwise.
+ */
+TEST_CASE("StreamingViterbiTest", "[HMMTest]")
+{
+  arma::vec initial("0.4 0.3 0.3");
+  arma::mat transition("0.8 0.1 0.1; 0.1 0.8 0.1; 0.1 0.1 0.8");
+  std::vector<GaussianDistribution> emission(3);
+  emission[0] = GaussianDistribution("0.0", "1.0");
+  emission[1] = GaussianDistribution("2.0", "1.0");
+  emission[2] = GaussianDistribution("4.0", "1.0");
+  HMM<GaussianDistribution> hmm(initial, transition, emission);
+
+  arma::mat observations;
+  arma::Row<size_t> hiddenStates;
+  hmm.Generate(200, observations, hiddenStates);
+
+  arma::Row<size_t> expected;
+  const double expectedLogLikelihood = hmm.Predict(observations, expected);
+
+  // With a lag as long as the sequence, nothing is committed before the end.
+  StreamingViterbi<GaussianDistribution> full(hmm, observations.n_cols);
+  size_t state;
+  for (size_t t = 0; t < observations.n_cols; ++t)
+    REQUIRE(!full.Step(observations.col(t), state));
+
+  arma::Row<size_t> states;
+  const double logLikelihood = full.Flush(states);
+  REQUIRE(logLikelihood == Approx(expectedLogLikelihood).epsilon(1e-7));
+  REQUIRE(states.n_elem == expected.n_elem);
+  for (size_t t = 0; t < expected.n_elem; ++t)
+    REQUIRE(states[t] == expected[t]);
+
+  // With a short lag, one state is committed for each step after the lag.
+  const size_t lag = 10;
+  StreamingViterbi<GaussianDistribution> decoder(hmm, lag);
+  arma::Row<size_t> committed;
+  for (size_t t = 0; t < observations.n_cols; ++t)
+  {
+    if (decoder.Step(observations.col(t), state))
+      committed.insert_cols(committed.n_elem, arma::Row<size_t>({ state }));
+  }
+  REQUIRE(committed.n_elem == observations.n_cols - lag);
+
+  decoder.Flush(states);
+  REQUIRE(states.n_elem == lag);
+  REQUIRE(decoder.Steps() == 0);
+
+  // The committed states should almost always agree with the full decoding.
+  size_t agree = 0;
+  for (size_t t = 0; t < committed.n_elem; ++t)
+    agree += (committed[t] == expected[t]);
+  REQUIRE(agree >= 0.95 * committed.n_elem);
+}
+
 /**
  * This example is from Borodovsky & Ekisheva, p. 80-81.  It is just slightly
  * more complex.
@@ -528,6 +586,138 @@ TEST_CASE("DiscreteHMMLogLikelihoodTest", "[HMMTest]")
       Approx(-24.51556128368).epsilon(1e-7));
 }
 
+/**
+ * Make sure the batched Predict(), LogLikelihood() and LogEstimate() give the
+ * same results as the single-sequence versions.
+ */
+TEST_CASE("DiscreteHMMBatchedSequencesTest", "[HMMTest]")
+{
+  arma::vec initial("0.5 0.2 0.3");
+  arma::mat transition("0.5 0.0 0.1;"
+                       "0.2 0.6 0.2;"
+                       "0.3 0.4 0.7");
+  std::vector<DiscreteDistribution> emission(3);
+  emission[0].Probabilities() = "0.75 0.25 0.00 0.00";
+  emission[1].Probabilities() = "0.00 0.25 0.25 0.50";
+  emission[2].Probabilities() = "0.10 0.40 0.40 0.10";
+
+  HMM<DiscreteDistribution> hmm(initial, transition, emission);
+
+  // Generate sequences of different lengths.
+  std::vector<arma::mat> sequences(50);
+  for (size_t i = 0; i < sequences.size(); ++i)
+  {
+    arma::Row<size_t> states;
+    hmm.Generate(1 + math::RandInt(30), sequences[i], states,
+        math::RandInt(3));
+  }
+
+  std::vector<arma::Row<size_t>> stateSeqs;
+  arma::vec viterbiLogLikelihoods;
+  hmm.Predict(sequences, stateSeqs, viterbiLogLikelihoods);
+
+  arma::vec logLikelihoods;
+  const double total = hmm.LogLikelihood(sequences, logLikelihoods);
+
+  std::vector<arma::mat> stateLogProbs;
+  arma::vec estimateLogLikelihoods;
+  hmm.LogEstimate(sequences, stateLogProbs, estimateLogLikelihoods);
+
+  REQUIRE(stateSeqs.size() == sequences.size());
+  REQUIRE(stateLogProbs.size() == sequences.size());
+  REQUIRE(total == Approx(arma::accu(logLikelihoods)).epsilon(1e-10));
+  for (size_t i = 0; i < sequences.size(); ++i)
+  {
+    arma::Row<size_t> stateSeq;
+    const double viterbi = hmm.Predict(sequences[i], stateSeq);
+    REQUIRE(viterbiLogLikelihoods[i] == Approx(viterbi).epsilon(1e-10));
+    REQUIRE(arma::all(stateSeqs[i] == stateSeq));
+
+    const double logLikelihood = hmm.LogLikelihood(sequences[i]);
+    REQUIRE(logLikelihoods[i] == Approx(logLikelihood).epsilon(1e-10));
+    REQUIRE(estimateLogLikelihoods[i] == Approx(logLikelihood).epsilon(1e-10));
+
+    arma::mat stateLogProb, forwardLogProb, backwardLogProb;
+    arma::vec logScales;
+    hmm.LogEstimate(sequences[i], stateLogProb, forwardLogProb,
+        backwardLogProb, logScales);
+    // Some log-probabilities are -inf, so compare the probabilities.
+    REQUIRE(arma::approx_equal(arma::exp(stateLogProbs[i]),
+        arma::exp(stateLogProb), "absdiff", 1e-10));
+  }
+}
+
+/**
+ * Baum-Welch training splits the sequences between threads.  Make sure that it
+ * gives the same model as training with one thread, and that the returned
+ * log-likelihood is the sum of the log-likelihoods of the sequences under the
+ * trained model.
+ */
+TEST_CASE("DiscreteHMMParallelTrainTest", "[HMMTest]")
+{
+  arma::vec initial("0.5 0.2 0.3");
+  arma::mat transition("0.5 0.0 0.1;"
+                       "0.2 0.6 0.2;"
+                       "0.3 0.4 0.7");
+  std::vector<DiscreteDistribution> emission(3);
+  emission[0].Probabilities() = "0.75 0.25 0.00 0.00";
+  emission[1].Probabilities() = "0.00 0.25 0.25 0.50";
+  emission[2].Probabilities() = "0.10 0.40 0.40 0.10";
+
+  HMM<DiscreteDistribution> hmm(initial, transition, emission);
+
+  // Generate sequences of different lengths, so the threads get uneven work.
+  std::vector<arma::mat> sequences(60);
+  for (size_t i = 0; i < sequences.size(); ++i)
+  {
+    arma::Row<size_t> states;
+    hmm.Generate(1 + math::RandInt(40), sequences[i], states,
+        math::RandInt(3));
+  }
+
+  // Both models start from the same guess.
+  std::vector<DiscreteDistribution> guess(3, DiscreteDistribution(4));
+  guess[0].Probabilities() = "0.4 0.3 0.2 0.1";
+  guess[1].Probabilities() = "0.1 0.2 0.3 0.4";
+  guess[2].Probabilities() = "0.25 0.25 0.25 0.25";
+  const arma::vec guessInitial("0.3 0.3 0.4");
+  const arma::mat guessTransition("0.4 0.3 0.3;"
+                                  "0.3 0.4 0.3;"
+                                  "0.3 0.3 0.4");
+
+  HMM<DiscreteDistribution> parallelHMM(guessInitial, guessTransition, guess,
+      1e-8);
+  const double parallelLogLikelihood = parallelHMM.Train(sequences);
+
+  #ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  HMM<DiscreteDistribution> sequentialHMM(guessInitial, guessTransition, guess,
+      1e-8);
+  const double sequentialLogLikelihood = sequentialHMM.Train(sequences);
+
+  #ifdef HAS_OPENMP
+  omp_set_num_threads(numThreads);
+  #endif
+
+  REQUIRE(parallelLogLikelihood ==
+      Approx(sequentialLogLikelihood).epsilon(1e-8));
+  arma::vec logLikelihoods;
+  REQUIRE(parallelLogLikelihood ==
+      Approx(parallelHMM.LogLikelihood(sequences, logLikelihoods))
+      .epsilon(1e-6));
+
+  CheckMatrices(parallelHMM.Initial(), sequentialHMM.Initial(), 1e-4);
+  CheckMatrices(parallelHMM.Transition(), sequentialHMM.Transition(), 1e-4);
+  for (size_t j = 0; j < 3; ++j)
+  {
+    CheckMatrices(parallelHMM.Emission()[j].Probabilities(),
+        sequentialHMM.Emission()[j].Probabilities(), 1e-4);
+  }
+}
+
 /**
  * A simple test to make sure HMMs with Gaussian output distributions work.
  */
@@ -0,0 +1,170 @@
+/**
+ * @file tests/hnsw_test.cpp
+ *
+ * Unit tests for the 'HNSWSearch' class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/hnsw/hnsw_search.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+
+#include "catch.hpp"
+#include "serialization.hpp"
+#include "test_catch_tools.hpp"
+
+using namespace mlpack;
+using namespace mlpack::neighbor;
+
+/**
+ * Make sure that HNSW finds most of the true nearest neighbors on
+ * moderately high-dimensional data, and that a wider search beam does not
+ * decrease the recall.
+ */
+TEST_CASE("HNSWRecallTest", "[HNSWTest]")
+{
+  arma::mat referenceData(32, 2000, arma::fill::randu);
+  arma::mat queryData(32, 200, arma::fill::randu);
+  const size_t k = 10;
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  knn.Search(queryData, k, trueNeighbors, trueDistances);
+
+  HNSWSearch<> hnsw(referenceData, 16, 100, 20);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  hnsw.Search(queryData, k, neighbors, distances);
+  const double lowRecall = HNSWSearch<>::ComputeRecall(neighbors,
+      trueNeighbors);
+
+  hnsw.EfSearch() = 200;
+  hnsw.Search(queryData, k, neighbors, distances);
+  const double highRecall = HNSWSearch<>::ComputeRecall(neighbors,
+      trueNeighbors);
+
+  REQUIRE(neighbors.n_rows == k);
+  REQUIRE(neighbors.n_cols == queryData.n_cols);
+  REQUIRE(highRecall >= 0.9);
+  REQUIRE(highRecall >= lowRecall - 0.02);
+
+  // The distances must be correct for the returned neighbors, and sorted.
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+  {
+    for (size_t j = 0; j < k; ++j)
+    {
+      REQUIRE(distances(j, i) == Approx(metric::EuclideanDistance::Evaluate(
+          queryData.col(i), referenceData.col(neighbors(j, i)))).epsilon(1e-7));
+      if (j > 0)
+        REQUIRE(distances(j, i) >= distances(j - 1, i));
+    }
+  }
+}
+
+/**
+ * Make sure that searching the reference set with itself never returns a
+ * point as its own neighbor.
+ */
+TEST_CASE("HNSWMonochromaticTest", "[HNSWTest]")
+{
+  arma::mat referenceData(5, 500, arma::fill::randu);
+
+  HNSWSearch<> hnsw(referenceData);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  hnsw.Search(5, neighbors, distances);
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  knn.Search(5, trueNeighbors, trueDistances);
+
+  REQUIRE(neighbors.n_rows == 5);
+  REQUIRE(neighbors.n_cols == 500);
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+      REQUIRE(neighbors(j, i) != i);
+
+  REQUIRE(HNSWSearch<>::ComputeRecall(neighbors, trueNeighbors) >= 0.95);
+}
+
+/**
+ * Make sure that the graph respects the limit on the number of links, and
+ * that every link points to a node in the same layer.
+ */
+TEST_CASE("HNSWGraphStructureTest", "[HNSWTest]")
+{
+  arma::mat referenceData(8, 1000, arma::fill::randu);
+
+  HNSWSearch<> hnsw(referenceData, 6, 50);
+  for (size_t i = 0; i < referenceData.n_cols; ++i)
+  {
+    REQUIRE(hnsw.Levels()[i] <= hnsw.MaxLevel());
+    for (size_t l = 0; l <= hnsw.Levels()[i]; ++l)
+    {
+      const std::vector<size_t>& links = hnsw.Links(i, l);
+      REQUIRE(links.size() <= ((l == 0) ? 12 : 6));
+      for (size_t j = 0; j < links.size(); ++j)
+      {
+        REQUIRE(links[j] != i);
+        REQUIRE(hnsw.Levels()[links[j]] >= l);
+      }
+    }
+  }
+}
+
+/**
+ * Make sure that invalid parameters and queries are rejected.
+ */
+TEST_CASE("HNSWInvalidParametersTest", "[HNSWTest]")
+{
+  arma::mat referenceData(3, 10, arma::fill::randu);
+
+  REQUIRE_THROWS_AS(HNSWSearch<>(1), std::invalid_argument);
+  REQUIRE_THROWS_AS(HNSWSearch<>(referenceData, 16, 0),
+      std::invalid_argument);
+
+  HNSWSearch<> hnsw(referenceData);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  arma::mat wrongQuery(4, 5, arma::fill::randu);
+  REQUIRE_THROWS_AS(hnsw.Search(wrongQuery, 2, neighbors, distances),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(hnsw.Search(referenceData, 11, neighbors, distances),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(hnsw.Search(10, neighbors, distances),
+      std::invalid_argument);
+
+  // An untrained model can't be searched.
+  HNSWSearch<> empty;
+  REQUIRE_THROWS_AS(empty.Search(referenceData, 1, neighbors, distances),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that a serialized model returns the same results.
+ */
+TEST_CASE("HNSWSerializationTest", "[HNSWTest]")
+{
+  arma::mat referenceData(10, 300, arma::fill::randu);
+  arma::mat queryData(10, 50, arma::fill::randu);
+
+  HNSWSearch<> hnsw(referenceData, 8, 100, 40);
+  HNSWSearch<> xmlHnsw, jsonHnsw, binaryHnsw;
+  SerializeObjectAll(hnsw, xmlHnsw, jsonHnsw, binaryHnsw);
+
+  arma::Mat<size_t> neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors;
+  arma::mat distances, xmlDistances, jsonDistances, binaryDistances;
+  hnsw.Search(queryData, 5, neighbors, distances);
+  xmlHnsw.Search(queryData, 5, xmlNeighbors, xmlDistances);
+  jsonHnsw.Search(queryData, 5, jsonNeighbors, jsonDistances);
+  binaryHnsw.Search(queryData, 5, binaryNeighbors, binaryDistances);
+
+  REQUIRE(xmlHnsw.EfSearch() == 40);
+  CheckMatrices(neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors);
+  CheckMatrices(distances, xmlDistances, jsonDistances, binaryDistances);
+}
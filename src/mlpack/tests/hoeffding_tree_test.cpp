@@ -16,6 +16,7 @@
 #include <mlpack/methods/hoeffding_trees/hoeffding_categorical_split.hpp>
 #include <mlpack/methods/hoeffding_trees/binary_numeric_split.hpp>
 #include <mlpack/methods/hoeffding_trees/hoeffding_tree_model.hpp>
+#include <mlpack/methods/hoeffding_trees/hoeffding_forest.hpp>
 
 #include "catch.hpp"
 #include "test_catch_tools.hpp"
@@ -877,6 +878,55 @@ TEST_CASE("NumericHoeffdingTreeTest", "[HoeffdingTreeTest]")
   REQUIRE(batchCorrect > 6000);
 }
 
+/**
+ * Make sure that streaming training on mini-batches gives the same tree as
+ * streaming training on one point at a time.
+ */
+TEST_CASE("MiniBatchStreamingTrainingTest", "[HoeffdingTreeTest]")
+{
+  // Generate data with a numeric and a categorical feature.
+  arma::mat dataset(2, 9000);
+  arma::Row<size_t> labels(9000);
+  data::DatasetInfo info(2);
+  info.MapString<size_t>("cat0", 1);
+  info.MapString<size_t>("cat1", 1);
+  info.MapString<size_t>("cat2", 1);
+  for (size_t i = 0; i < 9000; ++i)
+  {
+    const size_t category = RandInt(3);
+    dataset(0, i) = mlpack::math::Random() + ((i % 2 == 0) ? 0.5 : 0.0);
+    dataset(1, i) = category;
+    labels[i] = (category == 2) ? 2 : (i % 2);
+  }
+
+  typedef HoeffdingTree<GiniImpurity, HoeffdingDoubleNumericSplit> TreeType;
+  TreeType pointTree(info, 3, 0.95, 5000, 100);
+  TreeType miniBatchTree(info, 3, 0.95, 5000, 100);
+  for (size_t i = 0; i < 9000; ++i)
+    pointTree.Train(dataset.col(i), labels[i]);
+  for (size_t i = 0; i < 9000; i += 750)
+  {
+    miniBatchTree.Train(dataset.cols(i, i + 749), labels.cols(i, i + 749),
+        false);
+  }
+
+  REQUIRE(pointTree.NumChildren() > 0);
+  REQUIRE(miniBatchTree.NumDescendants() == pointTree.NumDescendants());
+  REQUIRE(miniBatchTree.SplitDimension() == pointTree.SplitDimension());
+
+  arma::Row<size_t> pointPredictions, miniBatchPredictions;
+  arma::rowvec pointProbabilities, miniBatchProbabilities;
+  pointTree.Classify(dataset, pointPredictions, pointProbabilities);
+  miniBatchTree.Classify(dataset, miniBatchPredictions,
+      miniBatchProbabilities);
+  for (size_t i = 0; i < 9000; ++i)
+  {
+    REQUIRE(miniBatchPredictions[i] == pointPredictions[i]);
+    REQUIRE(miniBatchProbabilities[i] ==
+        Approx(pointProbabilities[i]).epsilon(1e-10));
+  }
+}
+
 /**
  * The same as the previous test, but with the numeric binary split, and with a
  * categorical feature.
@@ -1475,3 +1525,160 @@ TEST_CASE("HoeffdingTreeModelSerializationTest", "[HoeffdingTreeTest]")
     }
   }
 }
+
+// Make sure the drift detection method only signals a drift when the error
+// rate grows.
+TEST_CASE("DriftDetectionMethodTest", "[HoeffdingTreeTest]")
+{
+  DriftDetectionMethod ddm;
+
+  // A steady error rate of 10% is not a drift.
+  for (size_t i = 0; i < 2000; ++i)
+    REQUIRE(ddm.Update(i % 10 == 0) != DriftDetectionMethod::DRIFT);
+  REQUIRE(ddm.Samples() == 2000);
+  REQUIRE(ddm.Errors() == 200);
+
+  // But an error rate of 60% is, and there should be a warning first.
+  bool warned = false;
+  size_t i = 0;
+  DriftDetectionMethod::Status status = DriftDetectionMethod::STABLE;
+  for (; i < 500 && status != DriftDetectionMethod::DRIFT; ++i)
+  {
+    status = ddm.Update(i % 5 < 3);
+    if (status == DriftDetectionMethod::WARNING)
+      warned = true;
+  }
+
+  REQUIRE(status == DriftDetectionMethod::DRIFT);
+  REQUIRE(warned);
+  REQUIRE(i < 500);
+
+  // The detector is reset after a drift.
+  REQUIRE(ddm.Samples() == 0);
+}
+
+// Generate points from three classes like the tests above; if permute is true,
+// the labels of the classes are rotated.
+void GenerateHoeffdingForestData(arma::mat& dataset,
+                                 arma::Row<size_t>& labels,
+                                 const size_t n,
+                                 const bool permute)
+{
+  dataset.set_size(3, n);
+  labels.set_size(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    const size_t c = mlpack::math::RandInt(3);
+    dataset(0, i) = mlpack::math::Random();
+    dataset(1, i) = mlpack::math::Random() + (c == 0 ? 0.0 :
+        (c == 1 ? 1.0 : -1.0));
+    dataset(2, i) = mlpack::math::Random() + (c == 0 ? 0.0 :
+        (c == 1 ? 0.8 : 0.5));
+    labels[i] = permute ? (c + 1) % 3 : c;
+  }
+}
+
+// Train a HoeffdingForest on a stream in mini-batches, and make sure the
+// results are reasonable.
+TEST_CASE("HoeffdingForestTest", "[HoeffdingTreeTest]")
+{
+  data::DatasetInfo info(3);
+  arma::mat dataset, testDataset;
+  arma::Row<size_t> labels, testLabels;
+  GenerateHoeffdingForestData(dataset, labels, 6000, false);
+  GenerateHoeffdingForestData(testDataset, testLabels, 1000, false);
+
+  for (size_t t = 0; t < 2; ++t)
+  {
+    HoeffdingForest forest((t == 0) ? HoeffdingTreeModel::GINI_HOEFFDING :
+        HoeffdingTreeModel::INFO_BINARY, 5);
+    forest.BuildModel(info, 3, 0.99, 1000, 100, 100, 4, 100);
+    REQUIRE(forest.NumTrees() == 5);
+
+    for (size_t i = 0; i < dataset.n_cols; i += 200)
+    {
+      forest.Train(dataset.cols(i, i + 199), labels.cols(i, i + 199));
+    }
+
+    arma::Row<size_t> predictions, predictions2;
+    arma::rowvec probabilities;
+    forest.Classify(testDataset, predictions);
+    forest.Classify(testDataset, predictions2, probabilities);
+
+    CheckMatrices(predictions, predictions2);
+    REQUIRE(arma::all(probabilities >= 1.0 / 3.0 - 1e-10));
+    REQUIRE(arma::all(probabilities <= 1.0 + 1e-10));
+
+    // Require at least 95% accuracy.
+    REQUIRE(arma::accu(predictions == testLabels) > 950);
+  }
+}
+
+// Make sure that a HoeffdingForest replaces its trees after the concept of
+// the stream changes, and then learns the new concept.
+TEST_CASE("HoeffdingForestDriftTest", "[HoeffdingTreeTest]")
+{
+  data::DatasetInfo info(3);
+  arma::mat dataset, driftedDataset, testDataset;
+  arma::Row<size_t> labels, driftedLabels, testLabels;
+  GenerateHoeffdingForestData(dataset, labels, 6000, false);
+  GenerateHoeffdingForestData(driftedDataset, driftedLabels, 10000, true);
+  GenerateHoeffdingForestData(testDataset, testLabels, 1000, true);
+
+  HoeffdingForest forest(HoeffdingTreeModel::GINI_HOEFFDING, 5);
+  forest.BuildModel(info, 3, 0.99, 1000, 100, 100, 4, 100);
+  for (size_t i = 0; i < dataset.n_cols; i += 100)
+    forest.Train(dataset.cols(i, i + 99), labels.cols(i, i + 99));
+
+  const size_t driftsBefore = forest.Drifts();
+  for (size_t i = 0; i < driftedDataset.n_cols; i += 100)
+  {
+    forest.Train(driftedDataset.cols(i, i + 99),
+        driftedLabels.cols(i, i + 99));
+  }
+
+  // Every tree was wrong about the new concept, so every tree should have been
+  // replaced.
+  REQUIRE(forest.Drifts() >= driftsBefore + forest.NumTrees());
+
+  arma::Row<size_t> predictions;
+  forest.Classify(testDataset, predictions);
+  REQUIRE(arma::accu(predictions == testLabels) > 900);
+}
+
+// Make sure that a HoeffdingForest can be serialized.
+TEST_CASE("HoeffdingForestSerializationTest", "[HoeffdingTreeTest]")
+{
+  data::DatasetInfo info(3);
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  GenerateHoeffdingForestData(dataset, labels, 3000, false);
+
+  HoeffdingForest forest(HoeffdingTreeModel::GINI_BINARY, 3), xmlForest,
+      jsonForest, binaryForest;
+  forest.BuildModel(info, 3);
+  for (size_t i = 0; i < dataset.n_cols; i += 500)
+    forest.Train(dataset.cols(i, i + 499), labels.cols(i, i + 499));
+
+  SerializeObjectAll(forest, xmlForest, jsonForest, binaryForest);
+
+  REQUIRE(xmlForest.NumTrees() == 3);
+  REQUIRE(jsonForest.NumTrees() == 3);
+  REQUIRE(binaryForest.NumTrees() == 3);
+
+  arma::Row<size_t> predictions, xmlPredictions, jsonPredictions,
+      binaryPredictions;
+  arma::rowvec probabilities, xmlProbabilities, jsonProbabilities,
+      binaryProbabilities;
+  forest.Classify(dataset, predictions, probabilities);
+  xmlForest.Classify(dataset, xmlPredictions, xmlProbabilities);
+  jsonForest.Classify(dataset, jsonPredictions, jsonProbabilities);
+  binaryForest.Classify(dataset, binaryPredictions, binaryProbabilities);
+
+  CheckMatrices(predictions, xmlPredictions);
+  CheckMatrices(predictions, jsonPredictions);
+  CheckMatrices(predictions, binaryPredictions);
+  CheckMatrices(probabilities, xmlProbabilities);
+  CheckMatrices(probabilities, jsonProbabilities);
+  CheckMatrices(probabilities, binaryProbabilities);
+}
@@ -15,6 +15,7 @@
 #include <mlpack/core/hpt/cv_function.hpp>
 #include <mlpack/core/hpt/fixed.hpp>
 #include <mlpack/core/hpt/hpt.hpp>
+#include <mlpack/core/hpt/successive_halving.hpp>
 #include <mlpack/methods/lars/lars.hpp>
 #include <mlpack/methods/logistic_regression/logistic_regression.hpp>
 
@@ -118,10 +119,12 @@ class QuadraticFunction
                     double xMin = 0.0,
                     double yMin = 0.0,
                     double zMin = 0.0) :
-      a(a), b(b), c(c), d(d), xMin(xMin), yMin(yMin), zMin(zMin) {}
+      a(a), b(b), c(c), d(d), xMin(xMin), yMin(yMin), zMin(zMin),
+      evaluations(0) {}
 
   double Evaluate(double x, double y, double z)
   {
+    ++evaluations;
     return a * pow(x - xMin, 2)  + b * pow(y - yMin, 2) + c * pow(z - zMin, 2)
         + d;
   }
@@ -133,8 +136,12 @@ class QuadraticFunction
     return MLAlgorithm();
   }
 
+  //! Get the number of times the function has been evaluated.
+  size_t Evaluations() const { return evaluations; }
+
  private:
   double a, b, c, d, xMin, yMin, zMin;
+  size_t evaluations;
 };
 
 /**
@@ -399,3 +406,150 @@ TEST_CASE("HPTGradientDescentTest", "[HPTTest]")
   REQUIRE(xOptimized == Approx(xMin).epsilon(1e-6));
   REQUIRE(zOptimized == Approx(zMin).epsilon(1e-6));
 }
+
+/**
+ * Test that CVFunction::EvaluateCandidates() gives the same objectives as
+ * evaluating each candidate separately, and keeps the best model.
+ */
+TEST_CASE("CVFunctionEvaluateCandidatesTest", "[HPTTest]")
+{
+  arma::mat xs;
+  arma::rowvec ys;
+  double validationSize;
+  InitProneToOverfittingData(xs, ys, validationSize);
+
+  bool transposeData = true;
+  bool useCholesky = false;
+  arma::vec lambda1Set("0 0.001 0.01 0.1 1.0 10.0 100.0");
+
+  IncrementPolicy policy(true);
+  DatasetMapper<IncrementPolicy, double> datasetInfo(policy, 2);
+
+  SimpleCV<LARS, MSE> cv(validationSize, xs, ys);
+  CVFunction<decltype(cv), LARS, 4, FixedArg<bool, 0>, FixedArg<bool, 1>>
+      cvFun(cv, datasetInfo, 0.0, 0.0, {transposeData}, {useCholesky});
+
+  arma::mat candidates(2, lambda1Set.n_elem);
+  candidates.row(0) = lambda1Set.t();
+  candidates.row(1).fill(0.05);
+
+  arma::vec objectives;
+  cvFun.EvaluateCandidates(candidates, objectives);
+
+  REQUIRE(objectives.n_elem == lambda1Set.n_elem);
+  for (size_t i = 0; i < lambda1Set.n_elem; ++i)
+  {
+    REQUIRE(objectives[i] == Approx(cv.Evaluate(transposeData, useCholesky,
+        lambda1Set[i], 0.05)).epsilon(1e-7));
+  }
+
+  size_t validationFirstColumn = round(xs.n_cols * (1.0 - validationSize));
+  arma::mat validationXs = xs.cols(validationFirstColumn, xs.n_cols - 1);
+  arma::rowvec validationYs = ys.cols(validationFirstColumn, ys.n_cols - 1);
+  double objective = MSE::Evaluate(cvFun.BestModel(), validationXs,
+      validationYs);
+  REQUIRE(objective == Approx(objectives.min()).epsilon(1e-7));
+
+  // The objectives and the best model are the same when the candidates are
+  // assessed in parallel.
+  CVFunction<decltype(cv), LARS, 4, FixedArg<bool, 0>, FixedArg<bool, 1>>
+      parallelCVFun(cv, datasetInfo, 0.0, 0.0, {transposeData},
+      {useCholesky});
+  arma::vec parallelObjectives;
+  parallelCVFun.EvaluateCandidates(candidates, parallelObjectives, true);
+
+  REQUIRE(parallelObjectives.n_elem == lambda1Set.n_elem);
+  for (size_t i = 0; i < lambda1Set.n_elem; ++i)
+    REQUIRE(parallelObjectives[i] == Approx(objectives[i]).epsilon(1e-7));
+  REQUIRE(MSE::Evaluate(parallelCVFun.BestModel(), validationXs,
+      validationYs) == Approx(objective).epsilon(1e-7));
+}
+
+/**
+ * Test that SuccessiveHalving finds the same parameters as a grid search when
+ * all candidates are assessed on all of the training data, and that a search
+ * started on a part of the data returns the objective of the full data.
+ */
+TEST_CASE("SuccessiveHalvingTest", "[HPTTest]")
+{
+  arma::mat xs;
+  arma::rowvec ys;
+  double validationSize;
+  InitProneToOverfittingData(xs, ys, validationSize);
+
+  bool transposeData = true;
+  bool useCholesky = false;
+  arma::vec lambda1Set("0 0.001 0.01 0.1 1.0 10.0 100.0");
+  arma::vec lambda2Set("0.0 0.05 0.5 5.0");
+
+  double expectedLambda1, expectedLambda2, expectedObjective;
+  FindLARSBestLambdas(xs, ys, validationSize, transposeData, useCholesky,
+      lambda1Set, lambda2Set, expectedLambda1, expectedLambda2,
+      expectedObjective);
+
+  double actualLambda1, actualLambda2;
+  HyperParameterTuner<LARS, MSE, SimpleCV, SuccessiveHalving>
+      hpt(validationSize, xs, ys);
+  hpt.Optimizer().MinFraction() = 1.0;
+  std::tie(actualLambda1, actualLambda2) = hpt.Optimize(Fixed(transposeData),
+      Fixed(useCholesky), lambda1Set, lambda2Set);
+
+  REQUIRE(expectedObjective == Approx(hpt.BestObjective()).epsilon(1e-7));
+  REQUIRE(expectedLambda1 == Approx(actualLambda1).epsilon(1e-7));
+  REQUIRE(expectedLambda2 == Approx(actualLambda2).epsilon(1e-7));
+
+  // Now start on half of the training data.  The result may not be the best
+  // candidate, but its objective must be the one on all of the training data.
+  hpt.Optimizer().MinFraction() = 0.5;
+  hpt.Optimizer().Eta() = 2.0;
+  std::tie(actualLambda1, actualLambda2) = hpt.Optimize(Fixed(transposeData),
+      Fixed(useCholesky), lambda1Set, lambda2Set);
+
+  SimpleCV<LARS, MSE> cv(validationSize, xs, ys);
+  REQUIRE(hpt.BestObjective() == Approx(cv.Evaluate(transposeData,
+      useCholesky, actualLambda1, actualLambda2)).epsilon(1e-7));
+  REQUIRE(hpt.BestObjective() >= expectedObjective - 1e-7);
+
+  // Numeric hyper-parameters are not supported.
+  REQUIRE_THROWS_AS(hpt.Optimize(Fixed(transposeData), Fixed(useCholesky),
+      1.0, lambda2Set), std::invalid_argument);
+}
+
+/**
+ * Test that CVFunction runs cross-validation only once for each distinct set
+ * of arguments.
+ */
+TEST_CASE("CVFunctionCacheTest", "[HPTTest]")
+{
+  QuadraticFunction<LARS> lf(1.0, -1.5, 2.5, 3.0);
+
+  // The first dimension is categorical with two categories.
+  IncrementPolicy policy(true);
+  DatasetMapper<IncrementPolicy, double> datasetInfo(policy, 3);
+  datasetInfo.MapString<size_t>(0.0, 0);
+  datasetInfo.MapString<size_t>(2.0, 0);
+
+  CVFunction<decltype(lf), LARS, 3> cvFun(lf, datasetInfo, 0.01, 0.001);
+
+  const double objective = cvFun.Evaluate(arma::vec("1.0 -1.0 2.0"));
+  REQUIRE(lf.Evaluations() == 1);
+
+  // The same point, and a point that maps to the same category.
+  REQUIRE(cvFun.Evaluate(arma::vec("1.0 -1.0 2.0")) == objective);
+  REQUIRE(cvFun.Evaluate(arma::vec("1.4 -1.0 2.0")) == objective);
+  REQUIRE(lf.Evaluations() == 1);
+
+  // The gradient reuses the objective of the point itself, and the increased
+  // categorical parameter still maps to the same category.
+  arma::mat gradient;
+  cvFun.Gradient(arma::vec("1.0 -1.0 2.0"), gradient);
+  REQUIRE(lf.Evaluations() == 3);
+
+  // Only the new and distinct candidates are evaluated.
+  arma::mat candidates("1.0 0.0 0.0; -1.0 -1.0 -1.0; 2.0 2.0 2.0");
+  arma::vec objectives;
+  cvFun.EvaluateCandidates(candidates, objectives);
+  REQUIRE(lf.Evaluations() == 4);
+  REQUIRE(objectives[0] == objective);
+  REQUIRE(objectives[1] == objectives[2]);
+}
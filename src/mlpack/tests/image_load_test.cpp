@@ -109,6 +109,78 @@ TEST_CASE("LoadVectorImageAPITest", "[ImageLoadTest]")
   REQUIRE(matrix.n_cols == 2);
 }
 
+/**
+ * Test that loading several images in parallel puts each image in its own
+ * column, and that an image with different dimensions makes the load fail.
+ */
+TEST_CASE("LoadVectorImageOrderTest", "[ImageLoadTest]")
+{
+  data::ImageInfo info(5, 5, 3, 90);
+  arma::Mat<unsigned char> images =
+      arma::randi<arma::Mat<unsigned char>>(5 * 5 * 3, 4);
+  std::vector<std::string> files;
+  for (size_t i = 0; i < images.n_cols; ++i)
+  {
+    files.push_back("OrderTest" + std::to_string(i) + ".bmp");
+    arma::Mat<unsigned char> image = images.col(i);
+    REQUIRE(data::Save(files[i], image, info, false) == true);
+  }
+
+  arma::mat matrix;
+  data::ImageInfo loadInfo;
+  REQUIRE(data::Load(files, matrix, loadInfo, false) == true);
+  CheckMatrices(arma::conv_to<arma::mat>::from(images), matrix);
+
+  // An image of another size.
+  files.push_back("test_image.png");
+  Log::Warn.ignoreInput = true;
+  REQUIRE(data::Load(files, matrix, loadInfo, false) == false);
+  Log::Warn.ignoreInput = false;
+
+  for (size_t i = 0; i < images.n_cols; ++i)
+    remove(files[i].c_str());
+}
+
+/**
+ * Test that ImageBatchLoader returns the same images as loading all files at
+ * once.
+ */
+TEST_CASE("ImageBatchLoaderTest", "[ImageLoadTest]")
+{
+  std::vector<std::string> files(5, "test_image.png");
+  data::ImageInfo info;
+  arma::mat matrix;
+  REQUIRE(data::Load(files, matrix, info, false) == true);
+
+  data::ImageBatchLoader<> loader(files, data::ImageInfo(), 2);
+  for (size_t pass = 0; pass < 2; ++pass)
+  {
+    arma::mat batch;
+    size_t numBatches = 0;
+    while (loader.Next(batch))
+    {
+      REQUIRE(loader.BatchBegin() == 2 * numBatches);
+      REQUIRE(batch.n_cols == ((numBatches == 2) ? 1 : 2));
+      CheckMatrices(batch, matrix.cols(loader.BatchBegin(),
+          loader.BatchBegin() + batch.n_cols - 1));
+      ++numBatches;
+    }
+
+    REQUIRE(numBatches == 3);
+    REQUIRE(loader.Info().Width() == 50);
+    loader.Reset();
+  }
+
+  // A missing file makes Next() throw.
+  files[3] = "missing_image.png";
+  Log::Fatal.ignoreInput = true;
+  data::ImageBatchLoader<> badLoader(files, data::ImageInfo(), 2);
+  arma::mat batch;
+  REQUIRE(badLoader.Next(batch) == true);
+  REQUIRE_THROWS_AS(badLoader.Next(batch), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
+
 /**
  * Test if the image is saved correctly using API for arma mat.
  */
@@ -313,3 +313,67 @@ TEST_CASE("DatasetMapperPointerMapping", "[ImputationTest]")
   REQUIRE(dm.UnmapString(1, 0) == &b);
   REQUIRE(dm.UnmapString(2, 0) == &c);
 }
+
+/**
+ * Make sure MedianImputation takes the average of the two middle values when
+ * the number of non-missing values is even, and that the reservoir-sampled
+ * median is close to the exact median.
+ */
+TEST_CASE("MedianImputationSelectionTest", "[ImputationTest]")
+{
+  arma::mat input("0.0 4.0 1.0 3.0 0.0 10.0");
+  MedianImputation<double> imputer;
+  imputer.Impute(input, 0.0, 0, true);
+  REQUIRE(input(0, 0) == Approx(3.5).epsilon(1e-7));
+  REQUIRE(input(0, 4) == Approx(3.5).epsilon(1e-7));
+
+  // Uniform values in [0, 1), so the median is about 0.5.
+  arma::mat large(1, 100001, arma::fill::randu);
+  large(0, 0) = -1.0;
+  MedianImputation<double> approximate(2000);
+  approximate.Impute(large, -1.0, 0, true);
+  REQUIRE(large(0, 0) == Approx(0.5).margin(0.05));
+
+  arma::mat allMissing(1, 3, arma::fill::zeros);
+  REQUIRE_THROWS_AS(imputer.Impute(allMissing, 0.0, 0, true),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure imputing several dimensions at once gives the same result as
+ * imputing them one after another.
+ */
+TEST_CASE("ImputerMultipleDimensionsTest", "[ImputationTest]")
+{
+  arma::mat input(20, 500, arma::fill::randu);
+  for (size_t i = 0; i < 1000; ++i)
+    input(math::RandInt(20), math::RandInt(500)) = arma::datum::nan;
+
+  MissingPolicy policy({"a"});
+  DatasetMapper<MissingPolicy> info(policy, 20);
+  std::vector<size_t> dimensions;
+  for (size_t d = 0; d < 20; ++d)
+  {
+    info.MapString<double>("a", d);
+    dimensions.push_back(d);
+  }
+
+  arma::mat serialInput(input);
+  Imputer<double, DatasetMapper<MissingPolicy>, MedianImputation<double>>
+      imputer(info);
+  for (const size_t d : dimensions)
+    imputer.Impute(serialInput, "a", d);
+  imputer.Impute(input, "a", dimensions);
+
+  REQUIRE(input.has_nan() == false);
+  CheckMatrices(input, serialInput);
+
+  // ListwiseDeletion is applied one dimension after another.
+  arma::mat deletionInput(serialInput);
+  deletionInput(3, 7) = arma::datum::nan;
+  deletionInput(5, 9) = arma::datum::nan;
+  Imputer<double, DatasetMapper<MissingPolicy>, ListwiseDeletion<double>>
+      deletion(info);
+  deletion.Impute(deletionInput, "a", dimensions);
+  REQUIRE(deletionInput.n_cols == 498);
+}
@@ -29,6 +29,8 @@ static const std::string testName = "";
 #include <mlpack/bindings/cli/parse_command_line.hpp>
 #include <mlpack/bindings/cli/end_program.hpp>
 
+#include <thread>
+
 #include "catch.hpp"
 
 using namespace mlpack;
@@ -1240,3 +1242,52 @@ TEST_CASE_METHOD(IOTestDestroyer, "CppNameTest",
   REQUIRE(IO::Parameters().at("help").cppType == "bool");
   REQUIRE(IO::Parameters().at("double").cppType == "double");
 }
+
+/**
+ * Make sure that threads with a context each have their own parameters, and
+ * do not change the global ones.
+ */
+TEST_CASE_METHOD(IOTestDestroyer, "ContextTest", "[IOTest]")
+{
+  PARAM_DOUBLE_IN("double", "Test double", "d", 1.0);
+  PARAM_DOUBLE_OUT("double_out", "Test output double");
+  IO::StoreSettings("context_test");
+
+  // Catch assertions are not thread-safe, so the results are checked after the
+  // threads finish.
+  std::vector<double> results(8, 0.0);
+  std::vector<char> notPassed(8, 0);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < results.size(); ++t)
+  {
+    threads.emplace_back([&results, &notPassed, t]()
+    {
+      IO::BeginContext("context_test");
+      notPassed[t] = !IO::HasParam("double");
+
+      IO::GetParam<double>("double") = (double) t;
+      IO::SetPassed("double");
+      IO::GetParam<double>("double_out") = 2 * IO::GetParam<double>("double");
+      results[t] = IO::GetParam<double>("double_out");
+
+      IO::EndContext();
+    });
+  }
+
+  for (std::thread& thread : threads)
+    thread.join();
+
+  for (size_t t = 0; t < results.size(); ++t)
+  {
+    REQUIRE(notPassed[t]);
+    REQUIRE(results[t] == Approx(2.0 * t));
+  }
+
+  // The stored settings were not modified.
+  IO::RestoreSettings("context_test");
+  REQUIRE(!IO::HasParam("double"));
+  REQUIRE(IO::GetParam<double>("double") == Approx(1.0));
+
+  REQUIRE_THROWS_AS(IO::BeginContext("unknown_settings"),
+      std::invalid_argument);
+}
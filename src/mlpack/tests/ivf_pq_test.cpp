@@ -0,0 +1,184 @@
+/**
+ * @file tests/ivf_pq_test.cpp
+ *
+ * Unit tests for the 'IVFPQSearch' class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/ivf_pq/ivf_pq_search.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
+
+#include "catch.hpp"
+#include "serialization.hpp"
+#include "test_catch_tools.hpp"
+
+using namespace mlpack;
+using namespace mlpack::neighbor;
+
+/**
+ * Generate a dataset of Gaussian clusters, which product quantization can
+ * represent well.
+ */
+void GetClusteredData(const size_t dimensionality,
+                      const size_t points,
+                      arma::mat& data)
+{
+  const arma::mat centers = 10.0 * arma::randu<arma::mat>(dimensionality, 20);
+  data.set_size(dimensionality, points);
+  for (size_t i = 0; i < points; ++i)
+  {
+    data.col(i) = centers.col(i % 20) +
+        arma::randn<arma::vec>(dimensionality);
+  }
+}
+
+/**
+ * Make sure that the index is laid out as expected: every point is in exactly
+ * one list, and the codebooks have the right sizes.
+ */
+TEST_CASE("IVFPQStructureTest", "[IVFPQTest]")
+{
+  arma::mat data;
+  GetClusteredData(12, 1000, data);
+
+  IVFPQSearch<> index(data, 10, 4, 32);
+
+  REQUIRE(index.Centroids().n_rows == 12);
+  REQUIRE(index.Centroids().n_cols == 10);
+
+  arma::Col<size_t> counts(1000, arma::fill::zeros);
+  for (size_t l = 0; l < index.NumLists(); ++l)
+  {
+    REQUIRE(index.ListCodes(l).n_rows == 4);
+    REQUIRE(index.ListCodes(l).n_cols == index.ListIndices(l).n_elem);
+    for (size_t j = 0; j < index.ListIndices(l).n_elem; ++j)
+    {
+      ++counts[index.ListIndices(l)[j]];
+      for (size_t s = 0; s < 4; ++s)
+        REQUIRE(index.ListCodes(l)(s, j) < 32);
+    }
+  }
+
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    REQUIRE(counts[i] == 1);
+
+  for (size_t s = 0; s < 4; ++s)
+  {
+    REQUIRE(index.Codebook(s).n_rows == 3);
+    REQUIRE(index.Codebook(s).n_cols == 32);
+  }
+
+  // The reference set was not kept.
+  REQUIRE(index.ReferenceSet().n_elem == 0);
+}
+
+/**
+ * Make sure that visiting every list and re-ranking against the raw vectors
+ * finds most of the true nearest neighbors, and that re-ranking does not
+ * reduce the recall of the compressed distances.
+ */
+TEST_CASE("IVFPQRecallTest", "[IVFPQTest]")
+{
+  arma::mat data, queries;
+  GetClusteredData(16, 2000, data);
+  queries = data.cols(0, 99) + 0.1 * arma::randn<arma::mat>(16, 100);
+
+  KNN knn(data);
+  arma::Mat<size_t> trueNeighbors;
+  arma::mat trueDistances;
+  knn.Search(queries, 5, trueNeighbors, trueDistances);
+
+  IVFPQSearch<> index(data, 8, 8, 64, true);
+  index.NumProbes() = 8;
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  index.Search(queries, 5, neighbors, distances);
+  REQUIRE(neighbors.n_rows == 5);
+  REQUIRE(neighbors.n_cols == 100);
+
+  size_t approxFound = 0;
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+      if (arma::any(trueNeighbors.col(i) == neighbors(j, i)))
+        ++approxFound;
+
+  index.ReRank() = 100;
+  index.Search(queries, 5, neighbors, distances);
+
+  size_t exactFound = 0;
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+  {
+    for (size_t j = 0; j < neighbors.n_rows; ++j)
+    {
+      if (arma::any(trueNeighbors.col(i) == neighbors(j, i)))
+        ++exactFound;
+
+      // Re-ranked distances are exact.
+      REQUIRE(distances(j, i) == Approx(arma::norm(queries.col(i) -
+          data.col(neighbors(j, i)))).epsilon(1e-7));
+    }
+  }
+
+  REQUIRE(exactFound >= approxFound);
+  REQUIRE(exactFound >= 0.9 * neighbors.n_elem);
+}
+
+/**
+ * Make sure that invalid parameters and searches are rejected.
+ */
+TEST_CASE("IVFPQInvalidParametersTest", "[IVFPQTest]")
+{
+  arma::mat data(6, 100, arma::fill::randu);
+
+  REQUIRE_THROWS_AS(IVFPQSearch<>(data, 0, 2), std::invalid_argument);
+  REQUIRE_THROWS_AS(IVFPQSearch<>(data, 101, 2), std::invalid_argument);
+  REQUIRE_THROWS_AS(IVFPQSearch<>(data, 4, 7), std::invalid_argument);
+  REQUIRE_THROWS_AS(IVFPQSearch<>(data, 4, 2, 257), std::invalid_argument);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  IVFPQSearch<> empty;
+  REQUIRE_THROWS_AS(empty.Search(data, 1, neighbors, distances),
+      std::invalid_argument);
+
+  IVFPQSearch<> index(data, 4, 3, 16);
+  arma::mat wrongQuery(5, 10, arma::fill::randu);
+  REQUIRE_THROWS_AS(index.Search(wrongQuery, 1, neighbors, distances),
+      std::invalid_argument);
+
+  // Re-ranking needs the reference set.
+  index.ReRank() = 10;
+  REQUIRE_THROWS_AS(index.Search(data, 1, neighbors, distances),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that a serialized index returns the same results.
+ */
+TEST_CASE("IVFPQSerializationTest", "[IVFPQTest]")
+{
+  arma::mat data, queries;
+  GetClusteredData(8, 500, data);
+  GetClusteredData(8, 50, queries);
+
+  IVFPQSearch<> index(data, 5, 4, 16);
+  index.NumProbes() = 3;
+  IVFPQSearch<> xmlIndex, jsonIndex, binaryIndex;
+  SerializeObjectAll(index, xmlIndex, jsonIndex, binaryIndex);
+
+  arma::Mat<size_t> neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors;
+  arma::mat distances, xmlDistances, jsonDistances, binaryDistances;
+  index.Search(queries, 4, neighbors, distances);
+  xmlIndex.Search(queries, 4, xmlNeighbors, xmlDistances);
+  jsonIndex.Search(queries, 4, jsonNeighbors, jsonDistances);
+  binaryIndex.Search(queries, 4, binaryNeighbors, binaryDistances);
+
+  REQUIRE(xmlIndex.NumProbes() == 3);
+  CheckMatrices(neighbors, xmlNeighbors, jsonNeighbors, binaryNeighbors);
+  CheckMatrices(distances, xmlDistances, jsonDistances, binaryDistances);
+}
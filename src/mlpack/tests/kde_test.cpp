@@ -10,6 +10,7 @@
 #include <mlpack/core.hpp>
 
 #include <mlpack/methods/kde/kde.hpp>
+#include <mlpack/methods/kde/sliding_window_kde.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
 #include <mlpack/core/tree/octree.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
@@ -593,6 +594,216 @@ TEST_CASE("BreadthFirstKDETest", "[KDETest]")
     REQUIRE(bfEstimations[i] == Approx(treeEstimations[i]).epsilon(relError));
 }
 
+/**
+ * Test that breadth-first dual-tree evaluation, whose levels are split between
+ * threads when the kernel is not Gaussian, gives the same results as brute
+ * force with different tree types.
+ */
+TEST_CASE("ParallelBreadthFirstKDETest", "[KDETest]")
+{
+  // Only the Gaussian kernel can use Monte Carlo estimation, which can't be
+  // done in parallel.
+  REQUIRE(RuleTraits<KDERules<EuclideanDistance, EpanechnikovKernel,
+      KDTree<EuclideanDistance, KDEStat, arma::mat>>>::HasThreadSafeScoring);
+  REQUIRE(!RuleTraits<KDERules<EuclideanDistance, GaussianKernel,
+      KDTree<EuclideanDistance, KDEStat, arma::mat>>>::HasThreadSafeScoring);
+
+  arma::mat reference = arma::randu(2, 500);
+  arma::mat query = arma::randu(2, 200);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec treeEstimations, octreeEstimations, rTreeEstimations;
+  const double kernelBandwidth = 0.3;
+  const double relError = 0.01;
+
+  // Brute force KDE.
+  EpanechnikovKernel kernel(kernelBandwidth);
+  BruteForceKDE<EpanechnikovKernel>(reference,
+                                    query,
+                                    bfEstimations,
+                                    kernel);
+
+  // Breadth-first KDE with a kd-tree, an octree and an R tree.
+  metric::EuclideanDistance metric;
+  KDE<EpanechnikovKernel,
+      metric::EuclideanDistance,
+      arma::mat,
+      tree::KDTree,
+      tree::KDTree<metric::EuclideanDistance,
+                   kde::KDEStat,
+                   arma::mat>::template BreadthFirstDualTreeTraverser>
+      kde(relError, 0.0, kernel, KDEMode::DUAL_TREE_MODE, metric);
+  kde.Train(reference);
+  kde.Evaluate(query, treeEstimations);
+
+  KDE<EpanechnikovKernel,
+      metric::EuclideanDistance,
+      arma::mat,
+      tree::Octree,
+      tree::Octree<metric::EuclideanDistance,
+                   kde::KDEStat,
+                   arma::mat>::template BreadthFirstDualTreeTraverser>
+      octreeKDE(relError, 0.0, kernel, KDEMode::DUAL_TREE_MODE, metric);
+  octreeKDE.Train(reference);
+  octreeKDE.Evaluate(query, octreeEstimations);
+
+  KDE<EpanechnikovKernel,
+      metric::EuclideanDistance,
+      arma::mat,
+      tree::RTree,
+      tree::RTree<metric::EuclideanDistance,
+                  kde::KDEStat,
+                  arma::mat>::template BreadthFirstDualTreeTraverser>
+      rTreeKDE(relError, 0.0, kernel, KDEMode::DUAL_TREE_MODE, metric);
+  rTreeKDE.Train(reference);
+  rTreeKDE.Evaluate(query, rTreeEstimations);
+
+  // Check whether results are equal.
+  for (size_t i = 0; i < query.n_cols; ++i)
+  {
+    REQUIRE(bfEstimations[i] == Approx(treeEstimations[i]).epsilon(relError));
+    REQUIRE(bfEstimations[i] ==
+        Approx(octreeEstimations[i]).epsilon(relError));
+    REQUIRE(bfEstimations[i] == Approx(rTreeEstimations[i]).epsilon(relError));
+  }
+}
+
+/**
+ * Test that dual-tree evaluation split into parallel query subtrees stays
+ * within the error tolerance, both with a query set and with the reference set
+ * as query set.
+ */
+TEST_CASE("ParallelDualTreeKDETest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 500);
+  arma::mat query = arma::randu(2, 300);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec treeEstimations;
+  const double kernelBandwidth = 0.1;
+  const double relError = 0.05;
+
+  // Brute force KDE.
+  GaussianKernel kernel(kernelBandwidth);
+  BruteForceKDE<GaussianKernel>(reference,
+                                query,
+                                bfEstimations,
+                                kernel);
+
+  metric::EuclideanDistance metric;
+  KDE<GaussianKernel,
+      metric::EuclideanDistance,
+      arma::mat,
+      tree::KDTree>
+      kde(relError, 0.0, kernel, KDEMode::DUAL_TREE_MODE, metric);
+  kde.ParallelDepth() = 3;
+  kde.Train(reference);
+  kde.Evaluate(query, treeEstimations);
+
+  REQUIRE(treeEstimations.n_elem == query.n_cols);
+  for (size_t i = 0; i < query.n_cols; ++i)
+    REQUIRE(bfEstimations[i] == Approx(treeEstimations[i]).epsilon(relError));
+
+  // Now estimate the density of the reference points, leaving each point out.
+  arma::vec bfSelfEstimations(reference.n_cols, arma::fill::zeros);
+  for (size_t i = 0; i < reference.n_cols; ++i)
+  {
+    for (size_t j = 0; j < reference.n_cols; ++j)
+    {
+      if (i != j)
+        bfSelfEstimations[i] += kernel.Evaluate(
+            metric.Evaluate(reference.col(i), reference.col(j)));
+    }
+  }
+  bfSelfEstimations /= reference.n_cols;
+
+  kde.Evaluate(treeEstimations);
+  REQUIRE(treeEstimations.n_elem == reference.n_cols);
+  for (size_t i = 0; i < reference.n_cols; ++i)
+  {
+    REQUIRE(bfSelfEstimations[i] ==
+        Approx(treeEstimations[i]).epsilon(relError));
+  }
+}
+
+/**
+ * Test binned estimation results against brute force results, with a query set
+ * and with the reference set as query set.
+ */
+TEST_CASE("GaussianBinnedKDETest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 400);
+  arma::mat query = arma::randu(2, 100);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec binnedEstimations;
+  const double kernelBandwidth = 0.1;
+
+  // Brute force KDE.
+  GaussianKernel kernel(kernelBandwidth);
+  BruteForceKDE<GaussianKernel>(reference,
+                                query,
+                                bfEstimations,
+                                kernel);
+
+  metric::EuclideanDistance metric;
+  KDE<GaussianKernel,
+      metric::EuclideanDistance,
+      arma::mat,
+      tree::KDTree>
+      kde(0.0, 0.0, kernel, KDEMode::BINNED_MODE, metric);
+  kde.Train(reference);
+  kde.Evaluate(query, binnedEstimations);
+
+  REQUIRE(binnedEstimations.n_elem == query.n_cols);
+  for (size_t i = 0; i < query.n_cols; ++i)
+    REQUIRE(bfEstimations[i] == Approx(binnedEstimations[i]).epsilon(0.01));
+
+  // A coarse grid must still be reasonably close.
+  kde.BinnedGridSize() = 40;
+  kde.Evaluate(query, binnedEstimations);
+  for (size_t i = 0; i < query.n_cols; ++i)
+    REQUIRE(bfEstimations[i] == Approx(binnedEstimations[i]).epsilon(0.05));
+
+  // Leave-one-out estimation on the reference set.
+  arma::vec bfSelfEstimations(reference.n_cols, arma::fill::zeros);
+  for (size_t i = 0; i < reference.n_cols; ++i)
+  {
+    for (size_t j = 0; j < reference.n_cols; ++j)
+    {
+      if (i != j)
+        bfSelfEstimations[i] += kernel.Evaluate(
+            metric.Evaluate(reference.col(i), reference.col(j)));
+    }
+  }
+  bfSelfEstimations /= reference.n_cols;
+
+  kde.BinnedGridSize() = 0;
+  kde.Evaluate(binnedEstimations);
+  REQUIRE(binnedEstimations.n_elem == reference.n_cols);
+  for (size_t i = 0; i < reference.n_cols; ++i)
+  {
+    REQUIRE(bfSelfEstimations[i] ==
+        Approx(binnedEstimations[i]).epsilon(0.01));
+  }
+}
+
+/**
+ * Make sure the binned mode refuses kernels it can't handle.
+ */
+TEST_CASE("BinnedKDEWrongKernelTest", "[KDETest]")
+{
+  arma::mat reference = arma::randu(2, 50);
+  arma::mat query = arma::randu(2, 10);
+  arma::vec estimations;
+
+  KDE<EpanechnikovKernel,
+      metric::EuclideanDistance,
+      arma::mat,
+      tree::KDTree>
+      kde(0.05, 0.0, EpanechnikovKernel(0.5), KDEMode::BINNED_MODE);
+  kde.Train(reference);
+
+  REQUIRE_THROWS_AS(kde.Evaluate(query, estimations), std::invalid_argument);
+}
+
 /**
  * Test 1-dimensional implementation results against brute force results.
  */
@@ -1297,3 +1508,165 @@ TEST_CASE("GaussianBreadthDualKDTreeMonteCarloKDE", "[KDETest]")
 
   REQUIRE(correctResults > 70);
 }
+
+/**
+ * Make sure that evaluating a prepared query several times gives the same
+ * estimations as evaluating the query set.
+ */
+TEST_CASE("KDEPreparedQueryTest", "[KDETest]")
+{
+  arma::mat reference(2, 300, arma::fill::randu);
+  arma::mat query(2, 100, arma::fill::randu);
+
+  KDE<> kde(0.01, 0.0, GaussianKernel(0.5));
+  kde.Train(reference);
+
+  arma::vec estimations, preparedEstimations;
+  kde.Evaluate(query, estimations);
+
+  PreparedQuery<KDE<>::Tree> prepared(query);
+  for (size_t run = 0; run < 2; ++run)
+  {
+    kde.Evaluate(prepared, preparedEstimations);
+
+    REQUIRE(preparedEstimations.n_elem == estimations.n_elem);
+    for (size_t i = 0; i < estimations.n_elem; ++i)
+      REQUIRE(preparedEstimations[i] == Approx(estimations[i]).epsilon(1e-7));
+  }
+}
+
+/**
+ * Make sure that exact dual-tree KDE with kd-trees, whose leaves are evaluated
+ * in blocks, gives the brute-force results for kernels with vectorized and
+ * with pairwise kernel evaluation.
+ */
+template<typename KernelType>
+void CheckExactLeafBaseCases(KernelType& kernel)
+{
+  arma::mat reference = arma::randu(3, 700);
+  arma::mat query = arma::randu(3, 300);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  arma::vec treeEstimations;
+
+  BruteForceKDE<KernelType>(reference, query, bfEstimations, kernel);
+
+  metric::EuclideanDistance metric;
+  KDE<KernelType, metric::EuclideanDistance, arma::mat, tree::KDTree>
+      kde(0.0, 0.0, kernel, KDEMode::DUAL_TREE_MODE, metric);
+  kde.Train(reference);
+  kde.Evaluate(query, treeEstimations);
+
+  for (size_t i = 0; i < query.n_cols; ++i)
+    REQUIRE(bfEstimations[i] == Approx(treeEstimations[i]).epsilon(1e-8));
+}
+
+TEST_CASE("KDELeafBaseCasesTest", "[KDETest]")
+{
+  GaussianKernel gaussian(0.3);
+  CheckExactLeafBaseCases(gaussian);
+  EpanechnikovKernel epanechnikov(0.4);
+  CheckExactLeafBaseCases(epanechnikov);
+  TriangularKernel triangular(0.4);
+  CheckExactLeafBaseCases(triangular);
+  LaplacianKernel laplacian(0.3);
+  CheckExactLeafBaseCases(laplacian);
+}
+
+/**
+ * Make sure that the sliding window KDE gives the brute-force results for the
+ * points of the window, after insertions and expirations that drop whole
+ * blocks and parts of blocks, in both dual-tree and single-tree mode.
+ */
+TEST_CASE("SlidingWindowKDETest", "[KDETest]")
+{
+  const arma::mat points = arma::randu(3, 1000);
+  const arma::vec timestamps = arma::regspace<arma::vec>(0, 999);
+  const arma::mat query = arma::randu(3, 200);
+  GaussianKernel kernel(0.3);
+
+  for (size_t mode = 0; mode < 2; ++mode)
+  {
+    const KDEMode kdeMode = (mode == 0) ? KDEMode::DUAL_TREE_MODE :
+        KDEMode::SINGLE_TREE_MODE;
+    SlidingWindowKDE<> window(128, KDE<>(0.0, 0.0, kernel, kdeMode));
+
+    // Insert the points in batches, and keep the 400 newest ones.
+    for (size_t start = 0; start < 1000; start += 250)
+    {
+      window.Insert(points.cols(start, start + 249),
+          timestamps.subvec(start, start + 249));
+      window.Expire(timestamps[start + 249] - 399);
+      REQUIRE(window.NumPoints() == std::min(start + 250, (size_t) 400));
+
+      const size_t first = (start + 250 > 400) ? start + 250 - 400 : 0;
+      arma::vec bfEstimations(query.n_cols, arma::fill::zeros);
+      BruteForceKDE<GaussianKernel>(points.cols(first, start + 249), query,
+          bfEstimations, kernel);
+
+      arma::vec estimations;
+      window.Evaluate(query, estimations);
+      REQUIRE(estimations.n_elem == query.n_cols);
+      for (size_t i = 0; i < query.n_cols; ++i)
+        REQUIRE(estimations[i] == Approx(bfEstimations[i]).epsilon(1e-8));
+    }
+
+    REQUIRE(window.NumBlocks() > 0);
+
+    // Expire everything.
+    window.Expire(1000.0);
+    REQUIRE(window.NumPoints() == 0);
+    arma::vec estimations;
+    REQUIRE_THROWS_AS(window.Evaluate(query, estimations), std::runtime_error);
+  }
+}
+
+/**
+ * Make sure that the sliding window KDE rejects decreasing timestamps.
+ */
+TEST_CASE("SlidingWindowKDETimestampsTest", "[KDETest]")
+{
+  SlidingWindowKDE<> window(16);
+  const arma::mat points = arma::randu(2, 10);
+
+  window.Insert(points, arma::regspace<arma::vec>(10, 19));
+  REQUIRE_THROWS_AS(window.Insert(points, arma::regspace<arma::vec>(0, 9)),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(window.Insert(points, arma::regspace<arma::vec>(29, -1,
+      20)), std::invalid_argument);
+  REQUIRE_THROWS_AS(window.Insert(arma::randu(3, 10),
+      arma::regspace<arma::vec>(20, 29)), std::invalid_argument);
+  REQUIRE(window.NumPoints() == 10);
+}
+
+/**
+ * Make sure that KDE can work on single-precision data, and that it gives the
+ * brute-force results on the same points in double precision.
+ */
+TEST_CASE("KDEFloatTest", "[KDETest]")
+{
+  arma::fmat reference = arma::randu<arma::fmat>(3, 500);
+  arma::fmat query = arma::randu<arma::fmat>(3, 200);
+  GaussianKernel kernel(0.4);
+
+  arma::vec bfEstimations(query.n_cols, arma::fill::zeros);
+  BruteForceKDE<GaussianKernel>(arma::conv_to<arma::mat>::from(reference),
+                                arma::conv_to<arma::mat>::from(query),
+                                bfEstimations,
+                                kernel);
+
+  const KDEMode modes[] = { KDEMode::DUAL_TREE_MODE,
+                            KDEMode::SINGLE_TREE_MODE };
+  for (size_t m = 0; m < 2; ++m)
+  {
+    KDE<GaussianKernel, EuclideanDistance, arma::fmat, KDTree>
+        kde(0.0, 0.0, kernel, modes[m]);
+    kde.Train(reference);
+
+    arma::vec estimations;
+    kde.Evaluate(query, estimations);
+
+    REQUIRE(estimations.n_elem == query.n_cols);
+    for (size_t i = 0; i < query.n_cols; ++i)
+      REQUIRE(estimations[i] == Approx(bfEstimations[i]).epsilon(1e-4));
+  }
+}
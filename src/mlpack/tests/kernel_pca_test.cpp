@@ -12,6 +12,7 @@
 #include <mlpack/core.hpp>
 #include <mlpack/core/kernels/gaussian_kernel.hpp>
 #include <mlpack/methods/kernel_pca/kernel_rules/nystroem_method.hpp>
+#include <mlpack/methods/kernel_pca/kernel_rules/random_fourier_method.hpp>
 #include <mlpack/methods/kernel_pca/kernel_pca.hpp>
 
 #include "catch.hpp"
@@ -147,3 +148,65 @@ TEST_CASE("CircleTransformationTestNystroem", "[KernelPCATest]")
   REQUIRE(ranges[0].Contains(ranges[2]) == false);
   REQUIRE(ranges[1].Contains(ranges[2]) == false);
 }
+
+/**
+ * With random Fourier features, KernelPCA should also turn a circle dataset
+ * into a linearly separable dataset in one dimension.
+ */
+TEST_CASE("CircleTransformationTestRandomFourier", "[KernelPCATest]")
+{
+  // The dataset, which will have three concentric rings in three dimensions.
+  arma::mat dataset;
+  dataset.randn(3, 750);
+  dataset *= 0.05;
+
+  // Push the second 250 points away from the origin by 2, and the last 250 by
+  // 5.
+  for (size_t i = 250; i < 750; ++i)
+  {
+    const double pointNorm = norm(dataset.col(i), 2);
+    const double radius = (i < 500) ? 2.0 : 5.0;
+    dataset.col(i) += radius * (dataset.col(i) / pointNorm);
+  }
+
+  KernelPCA<GaussianKernel, RandomFourierKernelRule<GaussianKernel>> p;
+  p.Apply(dataset, 1);
+  REQUIRE(dataset.n_rows == 1);
+
+  // Get the ranges of each "class".
+  Range ranges[3];
+  for (size_t i = 0; i < 250; ++i)
+    ranges[0] |= dataset(0, i);
+  for (size_t i = 250; i < 500; ++i)
+    ranges[1] |= dataset(0, i);
+  for (size_t i = 500; i < 750; ++i)
+    ranges[2] |= dataset(0, i);
+
+  // None of these ranges should overlap -- the classes should be linearly
+  // separable.
+  REQUIRE(ranges[0].Contains(ranges[1]) == false);
+  REQUIRE(ranges[0].Contains(ranges[2]) == false);
+  REQUIRE(ranges[1].Contains(ranges[2]) == false);
+}
+
+/**
+ * The eigenvalues found with random Fourier features for the LaplacianKernel
+ * should be close to those of the exact kernel matrix.
+ */
+TEST_CASE("RandomFourierLaplacianEigenvaluesTest", "[KernelPCATest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(2, 200);
+
+  arma::mat transformedData, eigvec;
+  arma::vec eigval, approxEigval;
+  KernelPCA<LaplacianKernel> exact;
+  exact.Apply(dataset, transformedData, eigval, eigvec, 2);
+
+  KernelPCA<LaplacianKernel, RandomFourierKernelRule<LaplacianKernel, 4096>>
+      approx;
+  approx.Apply(dataset, transformedData, approxEigval, eigvec, 2);
+
+  REQUIRE(transformedData.n_cols == 200);
+  REQUIRE(approxEigval[0] == Approx(eigval[0]).epsilon(0.2));
+  REQUIRE(approxEigval[1] == Approx(eigval[1]).epsilon(0.3));
+}
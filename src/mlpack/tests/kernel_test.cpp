@@ -20,6 +20,9 @@
 #include <mlpack/core/kernels/spherical_kernel.hpp>
 #include <mlpack/core/kernels/pspectrum_string_kernel.hpp>
 #include <mlpack/core/kernels/cauchy_kernel.hpp>
+#include <mlpack/core/kernels/kernel_matrix.hpp>
+#include <mlpack/core/kernels/triangular_kernel.hpp>
+#include <mlpack/core/kernels/random_fourier_features.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/metrics/mahalanobis_distance.hpp>
 
@@ -213,6 +216,34 @@ TEST_CASE("MDFullCovarianceTest", "[KernelTest]")
   REQUIRE(md.Evaluate(b, a) == Approx(15.7).epsilon(1e-7));
 }
 
+/**
+ * Make sure that the transformation of the Mahalanobis distance gives the same
+ * distances as the covariance matrix.
+ */
+TEST_CASE("MDTransformationTest", "[KernelTest]")
+{
+  // A random positive semidefinite matrix of rank 3.
+  arma::mat x(3, 5, arma::fill::randn);
+  MahalanobisDistance<true> md(x.t() * x);
+  const arma::mat l = md.Transformation();
+  REQUIRE(l.n_rows == 5);
+  REQUIRE(l.n_cols == 5);
+
+  for (size_t i = 0; i < 10; ++i)
+  {
+    arma::vec a(5, arma::fill::randn);
+    arma::vec b(5, arma::fill::randn);
+    REQUIRE(arma::norm(l * a - l * b) ==
+        Approx(md.Evaluate(a, b)).epsilon(1e-7));
+  }
+
+  // Matrices that are not square or not positive semidefinite are rejected.
+  md.Covariance() = arma::mat(3, 4, arma::fill::ones);
+  REQUIRE_THROWS_AS(md.Transformation(), std::invalid_argument);
+  md.Covariance() = -arma::eye<arma::mat>(3, 3);
+  REQUIRE_THROWS_AS(md.Transformation(), std::invalid_argument);
+}
+
 /**
  * Simple test case for the cosine distance.
  */
@@ -632,3 +663,145 @@ TEST_CASE("CauchyKernelTest", "[KernelTest]")
   REQUIRE(ck.Evaluate(a, b) == Approx(0.92592588).epsilon(1e-7));
   REQUIRE(ck.Evaluate(b, a) == Approx(0.92592588).epsilon(1e-7));
 }
+
+/**
+ * Check the kernel matrices computed by KernelMatrix() against evaluations of
+ * the kernel on each pair of points.
+ */
+template<typename KernelType>
+void CheckKernelMatrix(KernelType& kernel)
+{
+  // Neither set has a multiple of the block size as number of points.
+  arma::mat a = arma::randu<arma::mat>(4, 150);
+  arma::mat b = arma::randu<arma::mat>(4, 70);
+  b.col(3).zeros();
+
+  arma::mat kernelMatrix;
+  KernelMatrix(a, b, kernel, kernelMatrix);
+  REQUIRE(kernelMatrix.n_rows == 150);
+  REQUIRE(kernelMatrix.n_cols == 70);
+  for (size_t i = 0; i < a.n_cols; ++i)
+    for (size_t j = 0; j < b.n_cols; ++j)
+      REQUIRE(kernelMatrix(i, j) ==
+          Approx(kernel.Evaluate(a.col(i), b.col(j))).margin(1e-10));
+
+  KernelMatrix(a, kernel, kernelMatrix);
+  REQUIRE(kernelMatrix.n_rows == 150);
+  REQUIRE(kernelMatrix.n_cols == 150);
+  for (size_t i = 0; i < a.n_cols; ++i)
+    for (size_t j = 0; j < a.n_cols; ++j)
+      REQUIRE(kernelMatrix(i, j) ==
+          Approx(kernel.Evaluate(a.col(i), a.col(j))).margin(1e-10));
+}
+
+/**
+ * Make sure KernelMatrix() gives the same results as pairwise evaluations for
+ * dot-product kernels, distance kernels and other kernels.
+ */
+TEST_CASE("KernelMatrixTest", "[KernelTest]")
+{
+  LinearKernel linear;
+  CheckKernelMatrix(linear);
+  PolynomialKernel polynomial(3.0, 1.0);
+  CheckKernelMatrix(polynomial);
+  HyperbolicTangentKernel hyperbolicTangent(0.5, 1.0);
+  CheckKernelMatrix(hyperbolicTangent);
+  CosineDistance cosine;
+  CheckKernelMatrix(cosine);
+
+  GaussianKernel gaussian(0.5);
+  CheckKernelMatrix(gaussian);
+  LaplacianKernel laplacian(0.7);
+  CheckKernelMatrix(laplacian);
+  EpanechnikovKernel epanechnikov(1.2);
+  CheckKernelMatrix(epanechnikov);
+
+  TriangularKernel triangular(0.9);
+  CheckKernelMatrix(triangular);
+
+  // The Cauchy kernel is evaluated pair by pair.
+  CauchyKernel cauchy(0.8);
+  CheckKernelMatrix(cauchy);
+}
+
+/**
+ * Make sure TransformDistances() gives the same results as evaluating the
+ * kernel on each distance, for the vectorized overloads and the default.
+ */
+template<typename KernelType>
+void CheckTransformDistances(const KernelType& kernel)
+{
+  const arma::mat distances = 2.0 * arma::randu<arma::mat>(40, 30);
+  arma::mat kernelValues = distances;
+  TransformDistances(kernel, kernelValues);
+
+  REQUIRE(kernelValues.n_rows == 40);
+  REQUIRE(kernelValues.n_cols == 30);
+  for (size_t i = 0; i < distances.n_elem; ++i)
+  {
+    REQUIRE(kernelValues[i] ==
+        Approx(kernel.Evaluate(distances[i])).margin(1e-12));
+  }
+}
+
+TEST_CASE("TransformDistancesTest", "[KernelTest]")
+{
+  CheckTransformDistances(GaussianKernel(0.7));
+  CheckTransformDistances(EpanechnikovKernel(1.3));
+  CheckTransformDistances(TriangularKernel(1.5));
+  CheckTransformDistances(LaplacianKernel(0.6));
+  CheckTransformDistances(SphericalKernel(1.1));
+}
+
+/**
+ * The triangular kernel gives the same value for two points as for the
+ * distance between them.
+ */
+TEST_CASE("TriangularKernelDistanceTest", "[KernelTest]")
+{
+  TriangularKernel tk(2.0);
+  arma::vec a("0.5 1.0");
+  arma::vec b("1.0 0.0");
+  const double distance = EuclideanDistance::Evaluate(a, b);
+
+  REQUIRE(tk.Evaluate(distance) == Approx(1 - distance / 2.0).epsilon(1e-12));
+  REQUIRE(tk.Evaluate(a, b) == Approx(tk.Evaluate(distance)).epsilon(1e-12));
+  REQUIRE(tk.Evaluate(3.0) == 0.0);
+}
+
+/**
+ * Make sure that the dot products of random Fourier features approximate the
+ * Gaussian kernel, and that the feature map survives serialization.
+ */
+TEST_CASE("RandomFourierFeaturesTest", "[KernelTest]")
+{
+  arma::mat data(4, 30, arma::fill::randu);
+  GaussianKernel gk(0.8);
+
+  RandomFourierFeatures<GaussianKernel> features(20000, gk);
+  features.Train(data);
+
+  arma::mat mapped;
+  features.Transform(data, mapped);
+  REQUIRE(mapped.n_rows == 20000);
+  REQUIRE(mapped.n_cols == 30);
+
+  arma::mat kernel;
+  KernelMatrix(data, gk, kernel);
+  const arma::mat approximation = mapped.t() * mapped;
+  REQUIRE(arma::abs(kernel - approximation).max() < 0.05);
+
+  // Points of another dimensionality cannot be mapped.
+  arma::mat wrong(5, 10, arma::fill::randu);
+  REQUIRE_THROWS_AS(features.Transform(wrong, mapped), std::invalid_argument);
+
+  RandomFourierFeatures<GaussianKernel> xmlFeatures, jsonFeatures,
+      binaryFeatures;
+  SerializeObjectAll(features, xmlFeatures, jsonFeatures, binaryFeatures);
+
+  arma::mat xmlMapped, jsonMapped, binaryMapped;
+  xmlFeatures.Transform(data, xmlMapped);
+  jsonFeatures.Transform(data, jsonMapped);
+  binaryFeatures.Transform(data, binaryMapped);
+  CheckMatrices(mapped, xmlMapped, jsonMapped, binaryMapped);
+}
@@ -13,19 +13,26 @@
 #include <mlpack/methods/kmeans/allow_empty_clusters.hpp>
 #include <mlpack/methods/kmeans/refined_start.hpp>
 #include <mlpack/methods/kmeans/kmeans_plus_plus_initialization.hpp>
+#include <mlpack/methods/kmeans/scalable_kmeans_plus_plus_initialization.hpp>
 #include <mlpack/methods/kmeans/elkan_kmeans.hpp>
 #include <mlpack/methods/kmeans/hamerly_kmeans.hpp>
 #include <mlpack/methods/kmeans/pelleg_moore_kmeans.hpp>
 #include <mlpack/methods/kmeans/dual_tree_kmeans.hpp>
+#include <mlpack/methods/kmeans/mini_batch_kmeans.hpp>
+#include <mlpack/methods/kmeans/streaming_kmeans.hpp>
 #include <mlpack/methods/kmeans/sample_initialization.hpp>
 #include <mlpack/methods/kmeans/random_partition.hpp>
+#include <mlpack/methods/kmeans/distributed_kmeans.hpp>
 
 #include <mlpack/core/tree/cover_tree/cover_tree.hpp>
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 
 #include "catch.hpp"
+#include "thread_communicator.hpp"
 #include <mlpack/methods/kmeans/kill_empty_clusters.hpp>
 
+#include <thread>
+
 using namespace mlpack;
 using namespace mlpack::kmeans;
 using namespace mlpack::metric;
@@ -553,6 +560,61 @@ TEST_CASE("KMeansPlusPlusTest", "[KMeansTest]")
   REQUIRE(distortion < 14500.0);
 }
 
+/**
+ * Test that the k-means|| initialization strategy returns decent initial
+ * cluster estimates, and that it can be used by KMeans.
+ */
+TEST_CASE("ScalableKMeansPlusPlusTest", "[KMeansTest]")
+{
+  // The same five Gaussians as in the k-means++ test.
+  arma::mat data(3, 3000);
+  data.randn();
+
+  arma::mat centroids(" 0  5 -2 -6  1;"
+                      " 0  0 -2  8  6;"
+                      " 0 -2 -2  8  1");
+
+  for (size_t i = 1000; i < 1200; ++i)
+    data.col(i) += centroids.col(1);
+  for (size_t i = 1200; i < 1700; ++i)
+    data.col(i) += centroids.col(2);
+  for (size_t i = 1700; i < 1800; ++i)
+    data.col(i) += centroids.col(3);
+  for (size_t i = 1800; i < 3000; ++i)
+    data.col(i) += centroids.col(4);
+
+  ScalableKMeansPlusPlusInitialization k;
+  arma::mat resultingCentroids;
+  k.Cluster(data, 5, resultingCentroids);
+  REQUIRE(resultingCentroids.n_rows == 3);
+  REQUIRE(resultingCentroids.n_cols == 5);
+
+  // Calculate sum of distances from the closest centroid.
+  double distortion = 0;
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    double bestDist = DBL_MAX;
+    for (size_t j = 0; j < 5; ++j)
+    {
+      bestDist = std::min(bestDist, metric::EuclideanDistance::Evaluate(
+          data.col(i), resultingCentroids.col(j)));
+    }
+    distortion += bestDist;
+  }
+
+  // The reclustering step makes k-means|| at least as good as k-means++ here,
+  // so use the same bound.
+  REQUIRE(distortion < 14500.0);
+
+  // Now make sure that KMeans accepts it as an initial partition policy.
+  KMeans<metric::EuclideanDistance, ScalableKMeansPlusPlusInitialization>
+      kmeans;
+  arma::Row<size_t> assignments;
+  kmeans.Cluster(data, 5, assignments);
+  REQUIRE(assignments.n_elem == data.n_cols);
+  REQUIRE(arma::max(assignments) < 5);
+}
+
 #ifdef ARMA_HAS_SPMAT
 /**
  * Make sure sparse k-means works okay.
@@ -767,6 +829,107 @@ TEST_CASE("DTNNCoverTreeTest", "[KMeansTest]")
   }
 }
 
+/**
+ * Generate points around three well-separated centers, interleaved so that any
+ * contiguous chunk holds points of every cluster.
+ */
+static void MiniBatchKMeansData(arma::mat& dataset,
+                                arma::Row<size_t>& labels,
+                                arma::mat& centers)
+{
+  centers = arma::mat("0.0 10.0 -10.0; 0.0 10.0 5.0");
+  dataset.randn(2, 3000);
+  dataset *= 0.5;
+  labels.set_size(3000);
+  for (size_t i = 0; i < 3000; ++i)
+  {
+    labels[i] = i % 3;
+    dataset.col(i) += centers.col(labels[i]);
+  }
+}
+
+/**
+ * Make sure that mini-batch k-means finds well-separated clusters.
+ */
+TEST_CASE("MiniBatchKMeansTest", "[KMeansTest]")
+{
+  arma::mat dataset, centers;
+  arma::Row<size_t> labels;
+  MiniBatchKMeansData(dataset, labels, centers);
+
+  // Start from one point of each cluster.
+  arma::mat centroids(2, 3);
+  for (size_t i = 0; i < 3; ++i)
+    centroids.col(i) = dataset.col(i);
+
+  KMeans<EuclideanDistance, SampleInitialization, AllowEmptyClusters,
+      MiniBatchKMeans> kmeans(50);
+  arma::Row<size_t> assignments;
+  kmeans.Cluster(dataset, 3, assignments, centroids, false, true);
+
+  // The sampled points follow the true clusters, so each centroid ends up
+  // close to its center.
+  for (size_t i = 0; i < 3; ++i)
+    REQUIRE(EuclideanDistance::Evaluate(centroids.col(i), centers.col(i)) <
+        0.2);
+
+  REQUIRE(arma::accu(assignments == labels) == 3000);
+}
+
+/**
+ * Make sure that streaming k-means finds well-separated clusters from chunks
+ * given by a loader, and that it agrees with feeding the chunks by hand.
+ */
+TEST_CASE("StreamingKMeansTest", "[KMeansTest]")
+{
+  arma::mat dataset, centers;
+  arma::Row<size_t> labels;
+  MiniBatchKMeansData(dataset, labels, centers);
+
+  arma::mat initialCentroids(2, 3);
+  for (size_t i = 0; i < 3; ++i)
+    initialCentroids.col(i) = dataset.col(i);
+
+  // Hand out the dataset in chunks of 250 points.
+  size_t next = 0;
+  auto loader = [&](arma::mat& chunk)
+  {
+    if (next >= dataset.n_cols)
+      return false;
+
+    const size_t last = std::min(next + 250, (size_t) dataset.n_cols) - 1;
+    chunk = dataset.cols(next, last);
+    next = last + 1;
+    return true;
+  };
+
+  StreamingKMeans<> kmeans(initialCentroids);
+  REQUIRE(kmeans.Cluster(loader) == 3000);
+  REQUIRE(arma::accu(kmeans.Counts()) == 3000);
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    REQUIRE(EuclideanDistance::Evaluate(kmeans.Centroids().col(i),
+        centers.col(i)) < 0.1);
+  }
+
+  arma::Row<size_t> assignments;
+  kmeans.Assign(dataset, assignments);
+  REQUIRE(arma::accu(assignments == labels) == 3000);
+
+  StreamingKMeans<> manual(initialCentroids);
+  for (size_t i = 0; i < dataset.n_cols; i += 250)
+    manual.Update(dataset.cols(i, i + 249));
+
+  for (size_t i = 0; i < manual.Centroids().n_elem; ++i)
+    REQUIRE(manual.Centroids()[i] == Approx(kmeans.Centroids()[i]));
+
+  // Without initial centroids, the first chunk must hold enough points.
+  StreamingKMeans<> uninitialized(3);
+  REQUIRE_THROWS_AS(uninitialized.Update(dataset.cols(0, 1)),
+      std::invalid_argument);
+}
+
 /**
  * Make sure that the sample initialization strategy successfully samples points
  * from the dataset.
@@ -800,3 +963,124 @@ TEST_CASE("SampleInitializationTest", "[KMeansTest]")
     REQUIRE(j < dataset.n_cols);
   }
 }
+
+/**
+ * Run DistributedKMeans in three threads, with shards of different sizes, and
+ * make sure that every thread finds the same centroids as KMeans on the whole
+ * dataset, with the naive and Elkan Lloyd steps.
+ */
+template<template<class, class> class LloydStepType>
+void CheckDistributedKMeans()
+{
+  const size_t size = 3;
+  arma::mat dataset = arma::randu<arma::mat>(3, 300);
+  const arma::mat initialCentroids = dataset.cols(0, 5);
+  const size_t bounds[] = { 0, 80, 190, 300 };
+
+  KMeans<EuclideanDistance, SampleInitialization, AllowEmptyClusters,
+      LloydStepType> kmeans;
+  arma::Row<size_t> assignments;
+  arma::mat centroids = initialCentroids;
+  kmeans.Cluster(dataset, 6, assignments, centroids, false, true);
+
+  ThreadCommunicator::Mailboxes mailboxes(size);
+  std::vector<arma::Row<size_t>> shardAssignments(size);
+  std::vector<arma::mat> shardCentroids(size);
+  std::vector<std::thread> threads;
+  for (size_t r = 0; r < size; ++r)
+  {
+    // Only the first thread has the initial centroids.
+    if (r == 0)
+      shardCentroids[r] = initialCentroids;
+
+    threads.push_back(std::thread([&, r]()
+    {
+      ThreadCommunicator communicator(mailboxes, r);
+      DistributedKMeans<ThreadCommunicator, EuclideanDistance,
+          SampleInitialization, LloydStepType> distributedKMeans(communicator);
+      distributedKMeans.Cluster(dataset.cols(bounds[r], bounds[r + 1] - 1), 6,
+          shardAssignments[r], shardCentroids[r], true);
+    }));
+  }
+  for (size_t r = 0; r < size; ++r)
+    threads[r].join();
+
+  for (size_t r = 0; r < size; ++r)
+  {
+    REQUIRE(arma::approx_equal(shardCentroids[r], centroids, "absdiff",
+        1e-8));
+    REQUIRE(arma::all(shardAssignments[r] ==
+        assignments.subvec(bounds[r], bounds[r + 1] - 1)));
+  }
+}
+
+TEST_CASE("DistributedKMeansTest", "[KMeansTest]")
+{
+  CheckDistributedKMeans<NaiveKMeans>();
+  CheckDistributedKMeans<ElkanKMeans>();
+}
+
+/**
+ * Without an initial guess, the centroids found by the first thread on its
+ * shard are used by every thread.
+ */
+TEST_CASE("DistributedKMeansInitializationTest", "[KMeansTest]")
+{
+  const size_t size = 2;
+  arma::mat dataset = arma::randu<arma::mat>(2, 200);
+
+  ThreadCommunicator::Mailboxes mailboxes(size);
+  std::vector<arma::mat> shardCentroids(size);
+  std::vector<std::thread> threads;
+  for (size_t r = 0; r < size; ++r)
+  {
+    threads.push_back(std::thread([&, r]()
+    {
+      ThreadCommunicator communicator(mailboxes, r);
+      DistributedKMeans<ThreadCommunicator> distributedKMeans(communicator);
+      distributedKMeans.Cluster(dataset.cols(r * 100, r * 100 + 99), 4,
+          shardCentroids[r]);
+    }));
+  }
+  for (size_t r = 0; r < size; ++r)
+    threads[r].join();
+
+  REQUIRE(shardCentroids[0].n_rows == 2);
+  REQUIRE(shardCentroids[0].n_cols == 4);
+  REQUIRE(arma::all(arma::vectorise(shardCentroids[0] == shardCentroids[1])));
+}
+
+/**
+ * Make sure that the iteration callback sees the centroids of every iteration,
+ * and that clustering resumed from the centroids it saved gives the same
+ * result.
+ */
+TEST_CASE("KMeansIterationCallbackTest", "[KMeansTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(3, 500);
+
+  KMeans<> kmeans(20);
+  std::vector<arma::mat> snapshots;
+  size_t lastIteration = 0;
+  kmeans.IterationCallback() = [&](const size_t iteration,
+                                   const arma::mat& centroids)
+  {
+    REQUIRE(iteration == lastIteration + 1);
+    lastIteration = iteration;
+    snapshots.push_back(centroids);
+  };
+
+  arma::mat centroids;
+  kmeans.Cluster(dataset, 5, centroids);
+
+  REQUIRE(snapshots.size() > 1);
+  REQUIRE(arma::approx_equal(snapshots.back(), centroids, "absdiff", 0.0));
+
+  // Resume from the centroids of the first iteration, as if training had been
+  // interrupted after it.
+  KMeans<> resumed(20 - 1);
+  arma::mat resumedCentroids = snapshots.front();
+  resumed.Cluster(dataset, 5, resumedCentroids, true);
+
+  REQUIRE(arma::approx_equal(resumedCentroids, centroids, "absdiff", 1e-10));
+}
@@ -12,11 +12,19 @@
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 #include <mlpack/methods/neighbor_search/unmap.hpp>
 #include <mlpack/methods/neighbor_search/ns_model.hpp>
+#include <mlpack/methods/neighbor_search/distributed_neighbor_search.hpp>
+#include <mlpack/methods/neighbor_search/cosine_neighbor_search.hpp>
+#include <mlpack/methods/neighbor_search/mahalanobis_neighbor_search.hpp>
+#include <mlpack/methods/neighbor_search/spill_tau_calibration.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
 #include <mlpack/core/tree/example_tree.hpp>
+#include <mlpack/core/tree/binary_space_tree/flat_tree_index.hpp>
 #include "test_catch_tools.hpp"
+#include "thread_communicator.hpp"
 #include "catch.hpp"
 
+#include <thread>
+
 using namespace mlpack;
 using namespace mlpack::neighbor;
 using namespace mlpack::tree;
@@ -718,6 +726,59 @@ TEST_CASE("KNNDualTreeVsNaive2", "[KNNTest]")
   }
 }
 
+/**
+ * Test the parallel dual-tree nearest-neighbors method with the naive method,
+ * for both the bichromatic and monochromatic cases.  When OpenMP is not
+ * available this is the same as the regular dual-tree search.
+ */
+TEST_CASE("KNNParallelDualTreeVsNaive", "[KNNTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("test_data_3_1000.csv", dataset))
+    FAIL("Cannot load test dataset test_data_3_1000.csv!");
+
+  KNN knn(dataset);
+  knn.ParallelDepth() = 4;
+
+  KNN naive(dataset, NAIVE_MODE);
+
+  arma::Mat<size_t> neighborsTree, neighborsNaive;
+  arma::mat distancesTree, distancesNaive;
+  knn.Search(dataset, 15, neighborsTree, distancesTree);
+  naive.Search(dataset, 15, neighborsNaive, distancesNaive);
+
+  for (size_t i = 0; i < neighborsTree.n_elem; ++i)
+  {
+    REQUIRE(neighborsTree(i) == neighborsNaive(i));
+    REQUIRE(distancesTree(i) == Approx(distancesNaive(i)).epsilon(1e-7));
+  }
+
+  knn.Search(15, neighborsTree, distancesTree);
+  naive.Search(15, neighborsNaive, distancesNaive);
+
+  for (size_t i = 0; i < neighborsTree.n_elem; ++i)
+  {
+    REQUIRE(neighborsTree(i) == neighborsNaive(i));
+    REQUIRE(distancesTree(i) == Approx(distancesNaive(i)).epsilon(1e-7));
+  }
+
+  // Now try with a cover tree, which holds points in non-leaf nodes.
+  NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+      StandardCoverTree> coverTreeSearch(dataset);
+  coverTreeSearch.ParallelDepth() = 2;
+
+  arma::Mat<size_t> coverNeighbors;
+  arma::mat coverDistances;
+  coverTreeSearch.Search(dataset, 15, coverNeighbors, coverDistances);
+  naive.Search(dataset, 15, neighborsNaive, distancesNaive);
+
+  for (size_t i = 0; i < coverNeighbors.n_elem; ++i)
+  {
+    REQUIRE(coverNeighbors(i) == neighborsNaive(i));
+    REQUIRE(coverDistances(i) == Approx(distancesNaive(i)).epsilon(1e-7));
+  }
+}
+
 /**
  * Test the single-tree nearest-neighbors method with the naive method.  This
  * uses only a reference dataset.
@@ -753,6 +814,78 @@ TEST_CASE("KNNSingleTreeVsNaive", "[KNNTest]")
   }
 }
 
+/**
+ * Test the single-tree nearest-neighbors method with the naive method when
+ * separate query and reference sets are given.  When compiled with OpenMP, the
+ * query points are split between threads.
+ */
+TEST_CASE("KNNParallelSingleTreeVsNaive", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(5, 800);
+  arma::mat querySet = arma::randu<arma::mat>(5, 300);
+
+  KNN knn(referenceSet, SINGLE_TREE_MODE);
+  KNN naive(referenceSet, NAIVE_MODE);
+
+  arma::Mat<size_t> neighborsTree, neighborsNaive;
+  arma::mat distancesTree, distancesNaive;
+  knn.Search(querySet, 10, neighborsTree, distancesTree);
+  naive.Search(querySet, 10, neighborsNaive, distancesNaive);
+
+  REQUIRE(knn.BaseCases() > 0);
+  for (size_t i = 0; i < neighborsTree.n_elem; ++i)
+  {
+    REQUIRE(neighborsTree(i) == neighborsNaive(i));
+    REQUIRE(distancesTree(i) == Approx(distancesNaive(i)).epsilon(1e-7));
+  }
+}
+
+/**
+ * Make sure that the batched leaf base cases used by the dual-tree traversal
+ * give the same results as the naive method on high-dimensional data, for
+ * several LMetrics.
+ */
+template<typename MetricType>
+void CheckLeafBaseCases(const arma::mat& referenceSet,
+                        const arma::mat& querySet)
+{
+  NeighborSearch<NearestNeighborSort, MetricType> knn(referenceSet);
+  NeighborSearch<NearestNeighborSort, MetricType> naive(referenceSet,
+      NAIVE_MODE);
+
+  arma::Mat<size_t> neighborsTree, neighborsNaive;
+  arma::mat distancesTree, distancesNaive;
+  knn.Search(querySet, 5, neighborsTree, distancesTree);
+  naive.Search(querySet, 5, neighborsNaive, distancesNaive);
+
+  for (size_t i = 0; i < neighborsTree.n_elem; ++i)
+  {
+    REQUIRE(neighborsTree(i) == neighborsNaive(i));
+    REQUIRE(distancesTree(i) == Approx(distancesNaive(i)).epsilon(1e-7));
+  }
+
+  // Also check the monochromatic case, where points must not be their own
+  // neighbors.
+  knn.Search(5, neighborsTree, distancesTree);
+  naive.Search(5, neighborsNaive, distancesNaive);
+
+  for (size_t i = 0; i < neighborsTree.n_elem; ++i)
+  {
+    REQUIRE(neighborsTree(i) == neighborsNaive(i));
+    REQUIRE(distancesTree(i) == Approx(distancesNaive(i)).epsilon(1e-7));
+  }
+}
+
+TEST_CASE("KNNLeafBaseCasesTest", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(128, 500);
+  arma::mat querySet = arma::randu<arma::mat>(128, 100);
+
+  CheckLeafBaseCases<EuclideanDistance>(referenceSet, querySet);
+  CheckLeafBaseCases<SquaredEuclideanDistance>(referenceSet, querySet);
+  CheckLeafBaseCases<ManhattanDistance>(referenceSet, querySet);
+}
+
 /**
  * Test the cover tree single-tree nearest-neighbors method against the naive
  * method.  This uses only a random reference dataset.
@@ -889,6 +1022,36 @@ TEST_CASE("KNNDualBallTreeTest", "[KNNTest]")
   }
 }
 
+/**
+ * Test single-tree and dual-tree nearest neighbor search with the quantized
+ * kd-tree against naive search; the looser bounds should not change results.
+ */
+TEST_CASE("KNNQuantizedKDTreeTest", "[KNNTest]")
+{
+  arma::mat data;
+  data.randu(50, 1000); // 50 dimensional, 1000 points.
+
+  NeighborSearch<NearestNeighborSort, LMetric<2>, arma::mat, QuantizedKDTree>
+      singleSearch(data, SINGLE_TREE_MODE);
+  NeighborSearch<NearestNeighborSort, LMetric<2>, arma::mat, QuantizedKDTree>
+      dualSearch(data, DUAL_TREE_MODE);
+  KNN naive(data, NAIVE_MODE);
+
+  arma::Mat<size_t> singleNeighbors, dualNeighbors, naiveNeighbors;
+  arma::mat singleDistances, dualDistances, naiveDistances;
+  singleSearch.Search(10, singleNeighbors, singleDistances);
+  dualSearch.Search(10, dualNeighbors, dualDistances);
+  naive.Search(10, naiveNeighbors, naiveDistances);
+
+  for (size_t i = 0; i < naiveNeighbors.n_elem; ++i)
+  {
+    REQUIRE(singleNeighbors[i] == naiveNeighbors[i]);
+    REQUIRE(singleDistances[i] == Approx(naiveDistances[i]).epsilon(1e-7));
+    REQUIRE(dualNeighbors[i] == naiveNeighbors[i]);
+    REQUIRE(dualDistances[i] == Approx(naiveDistances[i]).epsilon(1e-7));
+  }
+}
+
 /**
  * Test the spill tree hybrid sp-tree search (defeatist search on overlapping
  * nodes, and backtracking in non-overlapping nodes) against the naive method.
@@ -981,6 +1144,54 @@ TEST_CASE("KNNDuplicatedSpillSearchTest", "[KNNTest]")
   }
 }
 
+/**
+ * Make sure that the calibration of tau for the spill tree reports the recall
+ * of each candidate, and picks the smallest one that reaches the target.
+ */
+TEST_CASE("KNNSpillTauCalibrationTest", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(5, 1000);
+  arma::mat querySet = arma::randu<arma::mat>(5, 100);
+
+  const arma::vec taus = { 0.0, 0.1, 0.2, 10.0 };
+  arma::vec recalls;
+
+  // With a tau larger than the dataset, the overlapping buffers hold too many
+  // points, so every node is split without overlap and the search backtracks
+  // everywhere, which is exact.  With tau = 0 the search is defeatist.
+  const double tau = CalibrateSpillTau(referenceSet, querySet, 3, 1.0, taus,
+      recalls);
+
+  REQUIRE(recalls.n_elem == taus.n_elem);
+  for (size_t i = 0; i < recalls.n_elem; ++i)
+  {
+    REQUIRE(recalls[i] >= 0.0);
+    REQUIRE(recalls[i] <= 1.0);
+  }
+  REQUIRE(recalls[3] == Approx(1.0));
+  REQUIRE(recalls[0] < 1.0);
+
+  size_t first = 3;
+  for (size_t i = 0; i < taus.n_elem; ++i)
+  {
+    if (recalls[i] == 1.0)
+    {
+      first = i;
+      break;
+    }
+  }
+  REQUIRE(tau == taus[first]);
+
+  // A target of zero is reached by the smallest candidate.
+  REQUIRE(CalibrateSpillTau(referenceSet, querySet, 3, 0.0, taus, recalls) ==
+      0.0);
+
+  REQUIRE_THROWS_AS(CalibrateSpillTau(referenceSet, querySet, 3, 1.5, taus,
+      recalls), std::invalid_argument);
+  REQUIRE_THROWS_AS(CalibrateSpillTau(referenceSet, querySet, 3, 0.5,
+      arma::vec(), recalls), std::invalid_argument);
+}
+
 /**
  * Make sure sparse nearest neighbors works with kd trees.
  */
@@ -1227,6 +1438,202 @@ TEST_CASE("KNNModelMonochromaticTest", "[KNNTest]")
   }
 }
 
+/**
+ * Ensure that an NSModel can hold single-precision data, and that it gives the
+ * same results as a double-precision search on the same points.
+ */
+TEST_CASE("KNNModelFloatTest", "[KNNTest]")
+{
+  typedef NSModel<NearestNeighborSort, arma::fmat> KNNModel;
+
+  arma::fmat queryData = arma::randu<arma::fmat>(10, 50);
+  arma::fmat referenceData = arma::randu<arma::fmat>(10, 200);
+
+  // Get a baseline in double precision.
+  KNN knn(arma::conv_to<arma::mat>::from(referenceData));
+  arma::Mat<size_t> baselineNeighbors;
+  arma::mat baselineDistances;
+  knn.Search(arma::conv_to<arma::mat>::from(queryData), 3, baselineNeighbors,
+      baselineDistances);
+
+  KNNModel::TreeTypes treeTypes[] = { KNNModel::KD_TREE, KNNModel::COVER_TREE,
+      KNNModel::R_TREE, KNNModel::BALL_TREE, KNNModel::VP_TREE,
+      KNNModel::OCTREE };
+  NeighborSearchMode modes[] = { DUAL_TREE_MODE, SINGLE_TREE_MODE,
+      NAIVE_MODE };
+
+  for (size_t t = 0; t < 6; ++t)
+  {
+    for (size_t m = 0; m < 3; ++m)
+    {
+      KNNModel model(treeTypes[t]);
+      arma::fmat referenceCopy(referenceData);
+      arma::fmat queryCopy(queryData);
+      model.BuildModel(std::move(referenceCopy), modes[m]);
+      REQUIRE(model.Dataset().n_cols == referenceData.n_cols);
+
+      arma::Mat<size_t> neighbors;
+      arma::mat distances;
+      model.Search(std::move(queryCopy), 3, neighbors, distances);
+
+      REQUIRE(neighbors.n_rows == baselineNeighbors.n_rows);
+      REQUIRE(neighbors.n_cols == baselineNeighbors.n_cols);
+      for (size_t k = 0; k < distances.n_elem; ++k)
+      {
+        REQUIRE(neighbors[k] == baselineNeighbors[k]);
+        REQUIRE(distances[k] == Approx(baselineDistances[k]).epsilon(1e-4));
+      }
+    }
+  }
+}
+
+/**
+ * Ensure that points inserted into an NSModel give the same results as a model
+ * built on all the points at once, both for trees that insert the points
+ * directly and for trees that are rebuilt.
+ */
+TEST_CASE("KNNModelInsertTest", "[KNNTest]")
+{
+  typedef NSModel<NearestNeighborSort> KNNModel;
+
+  arma::mat queryData = arma::randu<arma::mat>(5, 50);
+  arma::mat referenceData = arma::randu<arma::mat>(5, 200);
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> baselineNeighbors;
+  arma::mat baselineDistances;
+  knn.Search(queryData, 3, baselineNeighbors, baselineDistances);
+
+  KNNModel::TreeTypes treeTypes[] = { KNNModel::KD_TREE, KNNModel::COVER_TREE,
+      KNNModel::R_TREE, KNNModel::R_STAR_TREE, KNNModel::BALL_TREE,
+      KNNModel::OCTREE };
+  NeighborSearchMode modes[] = { DUAL_TREE_MODE, SINGLE_TREE_MODE,
+      NAIVE_MODE };
+
+  for (size_t t = 0; t < 6; ++t)
+  {
+    for (size_t m = 0; m < 3; ++m)
+    {
+      KNNModel model(treeTypes[t]);
+      arma::mat initialData = referenceData.cols(0, 119);
+      model.BuildModel(std::move(initialData), modes[m]);
+
+      // Insert the rest in two batches.
+      arma::mat firstBatch = referenceData.cols(120, 159);
+      arma::mat secondBatch = referenceData.cols(160, 199);
+      model.Insert(std::move(firstBatch));
+      model.Insert(std::move(secondBatch));
+      REQUIRE(model.Dataset().n_cols == referenceData.n_cols);
+
+      arma::Mat<size_t> neighbors;
+      arma::mat distances;
+      arma::mat queryCopy(queryData);
+      model.Search(std::move(queryCopy), 3, neighbors, distances);
+
+      REQUIRE(neighbors.n_rows == baselineNeighbors.n_rows);
+      REQUIRE(neighbors.n_cols == baselineNeighbors.n_cols);
+      for (size_t k = 0; k < distances.n_elem; ++k)
+      {
+        REQUIRE(neighbors[k] == baselineNeighbors[k]);
+        REQUIRE(distances[k] == Approx(baselineDistances[k]).epsilon(1e-7));
+      }
+    }
+  }
+}
+
+/**
+ * Ensure that points deleted from an NSModel backed by a rectangle tree are
+ * never returned, and that the other points keep their indices.
+ */
+TEST_CASE("KNNModelDeleteTest", "[KNNTest]")
+{
+  typedef NSModel<NearestNeighborSort> KNNModel;
+
+  arma::mat queryData = arma::randu<arma::mat>(5, 50);
+  arma::mat referenceData = arma::randu<arma::mat>(5, 200);
+
+  // Every third point will be deleted.
+  std::vector<size_t> kept;
+  for (size_t i = 0; i < referenceData.n_cols; ++i)
+    if (i % 3 != 0)
+      kept.push_back(i);
+
+  arma::mat keptData(referenceData.n_rows, kept.size());
+  for (size_t i = 0; i < kept.size(); ++i)
+    keptData.col(i) = referenceData.col(kept[i]);
+
+  KNN knn(keptData);
+  arma::Mat<size_t> baselineNeighbors;
+  arma::mat baselineDistances;
+  knn.Search(queryData, 3, baselineNeighbors, baselineDistances);
+  arma::Mat<size_t> baselineMonoNeighbors;
+  arma::mat baselineMonoDistances;
+  knn.Search(3, baselineMonoNeighbors, baselineMonoDistances);
+
+  KNNModel::TreeTypes treeTypes[] = { KNNModel::R_TREE, KNNModel::R_STAR_TREE,
+      KNNModel::X_TREE };
+  NeighborSearchMode modes[] = { DUAL_TREE_MODE, SINGLE_TREE_MODE };
+
+  for (size_t t = 0; t < 3; ++t)
+  {
+    for (size_t m = 0; m < 2; ++m)
+    {
+      KNNModel model(treeTypes[t]);
+      arma::mat referenceCopy(referenceData);
+      model.BuildModel(std::move(referenceCopy), modes[m]);
+
+      for (size_t i = 0; i < referenceData.n_cols; i += 3)
+        model.Delete(i);
+
+      // A point can't be deleted twice.
+      REQUIRE_THROWS_AS(model.Delete(0), std::invalid_argument);
+
+      arma::Mat<size_t> neighbors;
+      arma::mat distances;
+      arma::mat queryCopy(queryData);
+      model.Search(std::move(queryCopy), 3, neighbors, distances);
+
+      REQUIRE(neighbors.n_rows == baselineNeighbors.n_rows);
+      REQUIRE(neighbors.n_cols == baselineNeighbors.n_cols);
+      for (size_t k = 0; k < distances.n_elem; ++k)
+      {
+        REQUIRE(neighbors[k] == kept[baselineNeighbors[k]]);
+        REQUIRE(distances[k] == Approx(baselineDistances[k]).epsilon(1e-7));
+      }
+
+      // Deleted points are not searched for when the reference set is the
+      // query set.
+      model.Search(3, neighbors, distances);
+
+      REQUIRE(neighbors.n_rows == 3);
+      REQUIRE(neighbors.n_cols == referenceData.n_cols);
+      for (size_t i = 0; i < referenceData.n_cols; i += 3)
+      {
+        for (size_t j = 0; j < 3; ++j)
+        {
+          REQUIRE(neighbors(j, i) == SIZE_MAX);
+          REQUIRE(distances(j, i) == DBL_MAX);
+        }
+      }
+      for (size_t i = 0; i < kept.size(); ++i)
+      {
+        for (size_t j = 0; j < 3; ++j)
+        {
+          REQUIRE(neighbors(j, kept[i]) == kept[baselineMonoNeighbors(j, i)]);
+          REQUIRE(distances(j, kept[i]) ==
+              Approx(baselineMonoDistances(j, i)).epsilon(1e-7));
+        }
+      }
+    }
+  }
+
+  // Other trees can't delete points.
+  KNNModel kdModel(KNNModel::KD_TREE);
+  arma::mat referenceCopy(referenceData);
+  kdModel.BuildModel(std::move(referenceCopy), DUAL_TREE_MODE);
+  REQUIRE_THROWS_AS(kdModel.Delete(0), std::invalid_argument);
+}
+
 /**
  * If we search twice with the same reference tree, the bounds need to be reset
  * before the second search.  This test ensures that that happens, by making
@@ -1816,3 +2223,432 @@ TEST_CASE("KNNSpillTreeSearchEnoughResults", "[KNNTest]")
   REQUIRE(arma::accu(distancesGreedy < 0.0 || distancesGreedy > std::sqrt(3.0))
       == 0);
 }
+
+#ifndef _WIN32
+/**
+ * Make sure that a kd-tree stored as a flat tree index gives the same search
+ * results as the original tree.
+ */
+TEST_CASE("KNNFlatTreeIndexTest", "[KNNTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(4, 1000);
+  arma::mat querySet = arma::randu<arma::mat>(4, 100);
+
+  std::vector<size_t> oldFromNew;
+  KNN::Tree tree(dataset, oldFromNew, 10);
+  FlatTreeIndex<KNN::Tree>::Save("flat_tree_index.bin", tree, oldFromNew);
+
+  KNN knn(tree);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(querySet, 5, neighbors, distances);
+
+  {
+    FlatTreeIndex<KNN::Tree> index("flat_tree_index.bin");
+    REQUIRE(index.OldFromNew() == oldFromNew);
+    REQUIRE(index.Tree().NumDescendants() == 1000);
+    REQUIRE(index.Tree().Bound().Dim() == 4);
+
+    KNN flatKnn(std::move(index.Tree()));
+    arma::Mat<size_t> flatNeighbors;
+    arma::mat flatDistances;
+    flatKnn.Search(querySet, 5, flatNeighbors, flatDistances);
+
+    CheckMatrices(neighbors, flatNeighbors);
+    CheckMatrices(distances, flatDistances);
+  }
+
+  // An index whose root points to a child record that does not exist, or that
+  // holds more points than the dataset, must be rejected.  The record of the
+  // root follows the 64-byte header, and holds begin, count, left and right.
+  const uint64_t badValues[2] = { 1000000, 1001 };
+  const size_t badOffsets[2] = { 64 + 2 * sizeof(uint64_t),
+                                 64 + sizeof(uint64_t) };
+  for (size_t i = 0; i < 2; ++i)
+  {
+    FlatTreeIndex<KNN::Tree>::Save("flat_tree_index.bin", tree, oldFromNew);
+    {
+      std::fstream file("flat_tree_index.bin",
+          std::ios::in | std::ios::out | std::ios::binary);
+      file.seekp(badOffsets[i]);
+      file.write((const char*) &badValues[i], sizeof(uint64_t));
+    }
+
+    REQUIRE_THROWS_AS(FlatTreeIndex<KNN::Tree>("flat_tree_index.bin"),
+        std::runtime_error);
+  }
+
+  remove("flat_tree_index.bin");
+}
+#endif
+
+/**
+ * Search with the reference set sharded over four threads (one of them with no
+ * points), and make sure that every thread finds the same neighbors as KNN on
+ * the whole reference set.
+ */
+TEST_CASE("DistributedKNNTest", "[KNNTest]")
+{
+  const size_t size = 4;
+  arma::mat referenceSet = arma::randu<arma::mat>(3, 200);
+  arma::mat querySet = arma::randu<arma::mat>(3, 77);
+  const size_t bounds[] = { 0, 0, 50, 120, 200 };
+
+  KNN knn(referenceSet, NAIVE_MODE);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(querySet, 5, neighbors, distances);
+
+  ThreadCommunicator::Mailboxes mailboxes(size);
+  std::vector<arma::Mat<size_t>> shardNeighbors(size);
+  std::vector<arma::mat> shardDistances(size);
+  std::vector<size_t> numReferencePoints(size), offsets(size);
+  std::vector<std::thread> threads;
+  for (size_t r = 0; r < size; ++r)
+  {
+    threads.push_back(std::thread([&, r]()
+    {
+      ThreadCommunicator communicator(mailboxes, r);
+      arma::mat shard(3, 0);
+      if (bounds[r + 1] > bounds[r])
+        shard = referenceSet.cols(bounds[r], bounds[r + 1] - 1);
+      KNN shardKnn(std::move(shard), (bounds[r + 1] > bounds[r]) ?
+          DUAL_TREE_MODE : NAIVE_MODE);
+
+      DistributedNeighborSearch<KNN, ThreadCommunicator> search(shardKnn,
+          communicator, 10);
+      numReferencePoints[r] = search.NumReferencePoints();
+      offsets[r] = search.Offset();
+
+      // Only the query set of the first thread is used.
+      search.Search((r == 0) ? querySet : arma::mat(), 5, shardNeighbors[r],
+          shardDistances[r]);
+    }));
+  }
+  for (size_t r = 0; r < size; ++r)
+    threads[r].join();
+
+  for (size_t r = 0; r < size; ++r)
+  {
+    REQUIRE(numReferencePoints[r] == 200);
+    REQUIRE(offsets[r] == bounds[r]);
+    REQUIRE(arma::all(arma::vectorise(shardNeighbors[r] == neighbors)));
+    CheckMatrices(shardDistances[r], distances, 1e-10);
+  }
+}
+
+/**
+ * Make sure that placing the reference points in memory (with USE_NUMA) keeps
+ * them, and does not change the results of the search.
+ */
+TEST_CASE("KNNFirstTouchTest", "[KNNTest]")
+{
+  arma::mat dataset(4, 2000, arma::fill::randu);
+
+  arma::mat placed(dataset);
+  util::FirstTouch(placed);
+  CheckMatrices(placed, dataset);
+
+  arma::mat copy;
+  util::FirstTouchCopy(dataset, copy);
+  CheckMatrices(copy, dataset);
+
+  arma::sp_mat sparse = arma::sprandu<arma::sp_mat>(100, 100, 0.1);
+  arma::sp_mat sparseCopy;
+  util::FirstTouchCopy(sparse, sparseCopy);
+  util::FirstTouch(sparseCopy);
+  REQUIRE(arma::accu(sparseCopy != sparse) == 0);
+
+  // An alias is left alone.
+  arma::mat alias(dataset.memptr(), dataset.n_rows, dataset.n_cols, false,
+      true);
+  util::FirstTouch(alias);
+  REQUIRE(alias.memptr() == dataset.memptr());
+
+  KNN knn(dataset);
+  KNN naive(dataset, NAIVE_MODE);
+  arma::Mat<size_t> neighbors, naiveNeighbors;
+  arma::mat distances, naiveDistances;
+  knn.Search(5, neighbors, distances);
+  naive.Search(5, naiveNeighbors, naiveDistances);
+
+  CheckMatrices(neighbors, naiveNeighbors);
+  CheckMatrices(distances, naiveDistances);
+}
+
+/**
+ * Make sure that a search with no budget gives the exact results, and that the
+ * bounds of a search with a small budget hold.
+ */
+TEST_CASE("KNNBudgetedSearchTest", "[KNNTest]")
+{
+  arma::mat dataset(3, 1000, arma::fill::randu);
+  arma::mat queries(3, 100, arma::fill::randu);
+
+  KNN naive(dataset, NAIVE_MODE);
+  arma::Mat<size_t> naiveNeighbors;
+  arma::mat naiveDistances;
+  naive.Search(queries, 5, naiveNeighbors, naiveDistances);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  arma::vec bounds;
+  REQUIRE_THROWS_AS(naive.Search(queries, 5, 10, 0.0, neighbors, distances,
+      bounds), std::invalid_argument);
+
+  KNN knn(dataset);
+  knn.Search(queries, 5, 0, 0.0, neighbors, distances, bounds);
+  CheckMatrices(neighbors, naiveNeighbors);
+  CheckMatrices(distances, naiveDistances);
+  REQUIRE(arma::all(bounds == DBL_MAX));
+
+  // The cover tree has self-children.
+  NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+      StandardCoverTree> coverKnn(dataset);
+  coverKnn.Search(queries, 5, 0, 0.0, neighbors, distances, bounds);
+  CheckMatrices(neighbors, naiveNeighbors);
+  CheckMatrices(distances, naiveDistances);
+
+  knn.Search(queries, 5, 30, 0.0, neighbors, distances, bounds);
+  REQUIRE(knn.BaseCases() < 100 * 1000);
+  for (size_t i = 0; i < queries.n_cols; ++i)
+  {
+    // The results cannot be better than the true neighbors, and a true
+    // neighbor that was missed cannot be better than the bound.
+    for (size_t j = 0; j < 5; ++j)
+      REQUIRE(distances(j, i) >= naiveDistances(j, i) - 1e-10);
+    if (distances(4, i) > naiveDistances(4, i) + 1e-10)
+      REQUIRE(bounds[i] <= naiveDistances(4, i) + 1e-10);
+  }
+}
+
+/**
+ * Make sure that filtered search returns the neighbors among the eligible
+ * reference points only, in every search mode.
+ */
+TEST_CASE("KNNFilteredSearchTest", "[KNNTest]")
+{
+  arma::mat dataset(3, 1000, arma::fill::randu);
+  arma::mat queries(3, 100, arma::fill::randu);
+
+  // Each point gets one of four labels; the points of labels 1 and 3 pass the
+  // filter.
+  arma::Col<uint64_t> masks(dataset.n_cols);
+  std::vector<size_t> eligible;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    masks[i] = uint64_t(1) << (i % 4);
+    if (i % 2 == 1)
+      eligible.push_back(i);
+  }
+  const uint64_t filter = (uint64_t(1) << 1) | (uint64_t(1) << 3);
+
+  arma::mat eligibleSet(dataset.n_rows, eligible.size());
+  for (size_t i = 0; i < eligible.size(); ++i)
+    eligibleSet.col(i) = dataset.col(eligible[i]);
+
+  KNN naive(eligibleSet, NAIVE_MODE);
+  arma::Mat<size_t> naiveNeighbors;
+  arma::mat naiveDistances;
+  naive.Search(queries, 5, naiveNeighbors, naiveDistances);
+  for (size_t i = 0; i < naiveNeighbors.n_elem; ++i)
+    naiveNeighbors[i] = eligible[naiveNeighbors[i]];
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  NeighborSearchMode modes[] = { NAIVE_MODE, SINGLE_TREE_MODE, DUAL_TREE_MODE };
+  for (size_t m = 0; m < 3; ++m)
+  {
+    KNN knn(dataset, modes[m]);
+    knn.SetReferenceMasks(masks);
+    knn.Filter() = filter;
+    knn.Search(queries, 5, neighbors, distances);
+
+    CheckMatrices(neighbors, naiveNeighbors);
+    CheckMatrices(distances, naiveDistances);
+  }
+
+  NeighborSearch<NearestNeighborSort, EuclideanDistance, arma::mat,
+      StandardCoverTree> coverKnn(dataset);
+  coverKnn.SetReferenceMasks(masks);
+  coverKnn.Filter() = filter;
+  coverKnn.Search(queries, 5, neighbors, distances);
+  CheckMatrices(neighbors, naiveNeighbors);
+  CheckMatrices(distances, naiveDistances);
+
+  // Without masks, nothing is filtered.
+  KNN knn(dataset);
+  knn.SetReferenceMasks(masks);
+  knn.SetReferenceMasks(arma::Col<uint64_t>());
+  knn.Filter() = filter;
+  knn.Search(queries, 5, neighbors, distances);
+  KNN unfiltered(dataset, NAIVE_MODE);
+  unfiltered.Search(queries, 5, naiveNeighbors, naiveDistances);
+  CheckMatrices(neighbors, naiveNeighbors);
+
+  REQUIRE_THROWS_AS(knn.SetReferenceMasks(arma::Col<uint64_t>(10)),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that searching a prepared query several times gives the same
+ * results as searching the query set.
+ */
+TEST_CASE("KNNPreparedQueryTest", "[KNNTest]")
+{
+  arma::mat dataset(3, 1000, arma::fill::randu);
+  arma::mat queries(3, 200, arma::fill::randu);
+
+  KNN knn(dataset);
+  PreparedQuery<KNN::Tree> query(queries);
+  REQUIRE(query.NumQueries() == 200);
+
+  arma::Mat<size_t> neighbors, preparedNeighbors;
+  arma::mat distances, preparedDistances;
+  const size_t ks[] = { 5, 3, 10 };
+  for (size_t i = 0; i < 3; ++i)
+  {
+    knn.Search(queries, ks[i], neighbors, distances);
+    knn.Search(query, ks[i], preparedNeighbors, preparedDistances);
+
+    CheckMatrices(preparedNeighbors, neighbors);
+    CheckMatrices(preparedDistances, distances);
+  }
+
+  // The same query against a new reference set.
+  knn.Train(arma::mat(3, 500, arma::fill::randu));
+  knn.Search(queries, 5, neighbors, distances);
+  knn.Search(query, 5, preparedNeighbors, preparedDistances);
+  CheckMatrices(preparedNeighbors, neighbors);
+  CheckMatrices(preparedDistances, distances);
+}
+
+/**
+ * Make sure that CosineNeighborSearch returns the same neighbors and distances
+ * as a brute-force search with the cosine distance.
+ */
+TEST_CASE("CosineKNNTest", "[KNNTest]")
+{
+  // Scale the points differently; the cosine distance ignores the length.
+  arma::mat dataset(4, 300, arma::fill::randn);
+  arma::mat queries(4, 50, arma::fill::randn);
+  dataset.each_row() %= arma::randu<arma::rowvec>(300) + 0.5;
+  queries *= 10.0;
+
+  arma::mat cosineDistances(dataset.n_cols, queries.n_cols);
+  for (size_t i = 0; i < queries.n_cols; ++i)
+  {
+    for (size_t j = 0; j < dataset.n_cols; ++j)
+    {
+      cosineDistances(j, i) = 1.0 - arma::dot(dataset.col(j), queries.col(i)) /
+          (arma::norm(dataset.col(j)) * arma::norm(queries.col(i)));
+    }
+  }
+
+  const NeighborSearchMode modes[] = { NAIVE_MODE, SINGLE_TREE_MODE,
+      DUAL_TREE_MODE };
+  for (size_t m = 0; m < 3; ++m)
+  {
+    CosineNeighborSearch<> search(dataset, modes[m]);
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+    search.Search(queries, 5, neighbors, distances);
+
+    REQUIRE(neighbors.n_rows == 5);
+    REQUIRE(neighbors.n_cols == 50);
+    for (size_t i = 0; i < queries.n_cols; ++i)
+    {
+      const arma::uvec order = arma::sort_index(cosineDistances.col(i));
+      for (size_t j = 0; j < 5; ++j)
+      {
+        REQUIRE(neighbors(j, i) == order[j]);
+        REQUIRE(distances(j, i) ==
+            Approx(cosineDistances(order[j], i)).epsilon(1e-7).margin(1e-10));
+      }
+    }
+  }
+
+  // The normalized reference points have unit length.
+  CosineNeighborSearch<> search(dataset);
+  for (size_t i = 0; i < search.ReferenceSet().n_cols; ++i)
+    REQUIRE(arma::norm(search.ReferenceSet().col(i)) == Approx(1.0));
+
+  // Monochromatic search should not return the point itself.
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  search.Search(3, neighbors, distances);
+  for (size_t i = 0; i < neighbors.n_cols; ++i)
+    for (size_t j = 0; j < 3; ++j)
+      REQUIRE(neighbors(j, i) != i);
+}
+
+/**
+ * Make sure that MahalanobisNeighborSearch returns the same results as a
+ * brute-force search with the MahalanobisDistance metric.
+ */
+TEST_CASE("MahalanobisKNNTest", "[KNNTest]")
+{
+  arma::mat dataset(4, 300, arma::fill::randu);
+  arma::mat queries(4, 50, arma::fill::randu);
+  arma::mat x(4, 4, arma::fill::randn);
+  arma::mat covariance = x.t() * x + 0.1 * arma::eye<arma::mat>(4, 4);
+
+  typedef NeighborSearch<NearestNeighborSort, MahalanobisDistance<true>,
+      arma::mat, tree::StandardCoverTree> MahalanobisKNN;
+  MahalanobisKNN naive(dataset, NAIVE_MODE, 0.0,
+      MahalanobisDistance<true>(covariance));
+  arma::Mat<size_t> naiveNeighbors, neighbors;
+  arma::mat naiveDistances, distances;
+  naive.Search(queries, 5, naiveNeighbors, naiveDistances);
+
+  MahalanobisNeighborSearch<> search(dataset,
+      MahalanobisDistance<true>(covariance));
+  search.Search(queries, 5, neighbors, distances);
+  CheckMatrices(neighbors, naiveNeighbors);
+  CheckMatrices(distances, naiveDistances, 1e-5);
+
+  // A transformation that reduces the dimensionality can be given directly.
+  arma::mat transformation(2, 4, arma::fill::randn);
+  MahalanobisNeighborSearch<> reduced(dataset, transformation,
+      SINGLE_TREE_MODE);
+  REQUIRE(reduced.ReferenceSet().n_rows == 2);
+
+  KNN knn(transformation * dataset, NAIVE_MODE);
+  knn.Search(transformation * queries, 5, naiveNeighbors, naiveDistances);
+  reduced.Search(queries, 5, neighbors, distances);
+  CheckMatrices(neighbors, naiveNeighbors);
+  CheckMatrices(distances, naiveDistances, 1e-5);
+
+  // Points of the wrong dimensionality are rejected.
+  REQUIRE_THROWS_AS(reduced.Search(arma::mat(3, 10, arma::fill::randu), 5,
+      neighbors, distances), std::invalid_argument);
+}
+
+/**
+ * Make sure that NSModel::Search() with a const query set gives the same
+ * results as with a moved one, and leaves the query set unchanged.
+ */
+TEST_CASE("KNNModelConstQueryTest", "[KNNTest]")
+{
+  typedef NSModel<NearestNeighborSort> KNNModel;
+
+  const arma::mat queryData = arma::randu<arma::mat>(5, 40);
+  arma::mat referenceData = arma::randu<arma::mat>(5, 300);
+
+  KNN knn(referenceData);
+  arma::Mat<size_t> baselineNeighbors;
+  arma::mat baselineDistances;
+  knn.Search(queryData, 4, baselineNeighbors, baselineDistances);
+
+  KNNModel model(KNNModel::TreeTypes::KD_TREE, false);
+  model.BuildModel(std::move(referenceData), DUAL_TREE_MODE);
+
+  const arma::mat queryCopy(queryData);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  model.Search(queryData, 4, neighbors, distances);
+
+  REQUIRE(arma::all(arma::vectorise(neighbors == baselineNeighbors)));
+  REQUIRE(arma::approx_equal(distances, baselineDistances, "absdiff", 1e-12));
+  REQUIRE(arma::approx_equal(queryData, queryCopy, "absdiff", 0.0));
+}
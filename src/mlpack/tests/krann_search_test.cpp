@@ -727,3 +727,62 @@ TEST_CASE("RAModelTest", "[KRANNTest]")
     }
   }
 }
+
+/**
+ * Make sure that every search mode returns the same results whatever the number
+ * of threads, given the same random seed.
+ */
+TEST_CASE("KRANNParallelSearchTest", "[KRANNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(3, 1000);
+  arma::mat queryData = arma::randu<arma::mat>(3, 300);
+
+  for (size_t mode = 0; mode < 3; ++mode)
+  {
+    RASearch<> rann(referenceData, mode == 0, mode == 1, 5.0, 0.95);
+    rann.ParallelDepth() = 3;
+
+    // Search with all threads, then with a single thread.
+    arma::Mat<size_t> parallelNeighbors, sequentialNeighbors;
+    arma::mat parallelDistances, sequentialDistances;
+    math::RandomSeed(42);
+    rann.Search(queryData, 3, parallelNeighbors, parallelDistances);
+
+    #ifdef HAS_OPENMP
+    const size_t numThreads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    #endif
+
+    math::RandomSeed(42);
+    rann.Search(queryData, 3, sequentialNeighbors, sequentialDistances);
+
+    #ifdef HAS_OPENMP
+    omp_set_num_threads(numThreads);
+    #endif
+
+    REQUIRE(arma::all(arma::vectorise(parallelNeighbors ==
+        sequentialNeighbors)));
+    REQUIRE(arma::approx_equal(parallelDistances, sequentialDistances,
+        "absdiff", 0.0));
+
+    // The monochromatic search must not depend on the threads either.
+    math::RandomSeed(42);
+    rann.Search(3, parallelNeighbors, parallelDistances);
+
+    #ifdef HAS_OPENMP
+    omp_set_num_threads(1);
+    #endif
+
+    math::RandomSeed(42);
+    rann.Search(3, sequentialNeighbors, sequentialDistances);
+
+    #ifdef HAS_OPENMP
+    omp_set_num_threads(numThreads);
+    #endif
+
+    REQUIRE(arma::all(arma::vectorise(parallelNeighbors ==
+        sequentialNeighbors)));
+    REQUIRE(arma::approx_equal(parallelDistances, sequentialDistances,
+        "absdiff", 0.0));
+  }
+}
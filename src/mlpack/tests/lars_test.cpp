@@ -469,3 +469,66 @@ TEST_CASE("LARSCopyConstructorTest", "[LARSTest]")
   // The output of both models should be the same.
   CheckMatrices(predictions, predictionsFromCopiedModel);
 }
+
+/**
+ * Make sure that the solutions computed by TrainPath() match the solutions of
+ * separate calls to Train() for each value of lambda1.
+ */
+void LARSPathTest(const bool useCholesky, const double lambda2)
+{
+  arma::mat X;
+  arma::rowvec y;
+  GenerateProblem(X, y, 200, 30);
+
+  const arma::vec sortedAbsCorr = arma::sort(arma::abs(X * y.t()));
+  arma::vec lambdas(5);
+  for (size_t i = 0; i < lambdas.n_elem; ++i)
+    lambdas[i] = sortedAbsCorr(5 * i + 2);
+  // Values larger than every correlation give the zero solution.
+  lambdas[lambdas.n_elem - 1] = 2 * sortedAbsCorr.max();
+
+  LARS pathLars(useCholesky, 0.0, lambda2);
+  arma::mat betas;
+  pathLars.TrainPath(X, y, lambdas, betas);
+
+  REQUIRE(betas.n_rows == 30);
+  REQUIRE(betas.n_cols == lambdas.n_elem);
+  REQUIRE(pathLars.Lambda1() == Approx(arma::min(lambdas)));
+
+  for (size_t i = 0; i < lambdas.n_elem; ++i)
+  {
+    LARS lars(useCholesky, lambdas[i], lambda2);
+    arma::vec beta;
+    lars.Train(X, y, beta);
+
+    for (size_t j = 0; j < beta.n_elem; ++j)
+      REQUIRE(betas(j, i) == Approx(beta[j]).margin(1e-6));
+
+    // The path solutions are optimal as well.
+    arma::vec errCorr = (X * trans(X) + lambda2 * arma::eye(30, 30)) *
+        betas.col(i) - X * y.t();
+    LARSVerifyCorrectness(betas.col(i), errCorr, lambdas[i]);
+  }
+
+  REQUIRE(arma::accu(arma::abs(betas.col(lambdas.n_elem - 1))) == 0.0);
+
+  // A smaller value than the path was computed for can't be given.
+  arma::vec beta;
+  REQUIRE_THROWS_AS(pathLars.PathSolution(arma::min(lambdas) / 2, beta),
+      std::invalid_argument);
+}
+
+TEST_CASE("LARSPathCholeskyTest", "[LARSTest]")
+{
+  LARSPathTest(true, 0.0);
+}
+
+TEST_CASE("LARSPathGramTest", "[LARSTest]")
+{
+  LARSPathTest(false, 0.0);
+}
+
+TEST_CASE("LARSPathElasticNetTest", "[LARSTest]")
+{
+  LARSPathTest(true, 0.5);
+}
@@ -86,6 +86,44 @@ TEST_CASE("TestCenterB", "[LinAlgTest]")
   }
 }
 
+/**
+ * Make sure that centering a matrix in place gives the same result as
+ * centering it into another matrix.
+ */
+TEST_CASE("TestCenterInPlace", "[LinAlgTest]")
+{
+  mat tmp(4, 7, fill::randu);
+  mat tmpOut;
+  Center(tmp, tmpOut);
+
+  Center(tmp, tmp);
+  CheckMatrices(tmp, tmpOut);
+}
+
+/**
+ * Make sure that multiplying a matrix in place in blocks gives the same result
+ * as the ordinary product, for block sizes that do and do not divide the
+ * number of columns.
+ */
+TEST_CASE("TestMultiplyInPlace", "[LinAlgTest]")
+{
+  const mat transformation(4, 4, fill::randu);
+  const mat x(4, 10, fill::randu);
+  const mat expected = transformation * x;
+
+  for (size_t blockSize = 1; blockSize <= 12; ++blockSize)
+  {
+    mat result(x);
+    MultiplyInPlace(transformation, result, blockSize);
+    CheckMatrices(result, expected);
+  }
+
+  // A transformation that is not square should throw.
+  mat result(x);
+  REQUIRE_THROWS_AS(MultiplyInPlace(mat(3, 4, fill::randu), result),
+      std::invalid_argument);
+}
+
 TEST_CASE("TestOrthogonalize", "[LinAlgTest]")
 {
   // Generate a random matrix; then, orthogonalize it and test if it's
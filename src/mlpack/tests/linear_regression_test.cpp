@@ -266,3 +266,90 @@ TEST_CASE("LinearRegressionTrainReturnObjective", "[LinearRegressionTest]")
 
   REQUIRE(std::isfinite(error) == true);
 }
+
+/**
+ * Make sure that training on statistics accumulated in chunks gives the same
+ * model as training on the whole dataset, with and without weights.
+ */
+TEST_CASE("LinearRegressionStatisticsTest", "[LinearRegressionTest]")
+{
+  arma::mat data;
+  data.randn(5, 1000);
+  data.row(2) += 10.0; // Make sure the predictors are not centered.
+  arma::rowvec responses = arma::randu<arma::rowvec>(5) * data + 3.0 +
+      0.1 * arma::randn<arma::rowvec>(1000);
+  arma::rowvec weights = arma::randu<arma::rowvec>(1000);
+
+  RegressionStatistics stats, weightedStats;
+  for (size_t i = 0; i < 1000; i += 150)
+  {
+    const size_t end = std::min(i + 150, (size_t) 1000) - 1;
+    stats.Update(data.cols(i, end), responses.subvec(i, end));
+    weightedStats.Update(data.cols(i, end), responses.subvec(i, end),
+        weights.subvec(i, end));
+  }
+
+  REQUIRE(stats.Count() == 1000);
+  REQUIRE(stats.WeightSum() == Approx(1000.0).epsilon(1e-10));
+  REQUIRE(weightedStats.WeightSum() ==
+      Approx(arma::accu(weights)).epsilon(1e-10));
+
+  for (size_t i = 0; i < 2; ++i)
+  {
+    const bool intercept = (i == 0);
+
+    LinearRegression lr(data, responses, 0.1, intercept);
+    LinearRegression streamLr;
+    streamLr.Lambda() = 0.1;
+    streamLr.Train(stats, intercept);
+    CheckMatrices(lr.Parameters(), streamLr.Parameters(), 1e-5);
+
+    LinearRegression weightedLr(data, responses, weights, 0.1, intercept);
+    streamLr.Train(weightedStats, intercept);
+    CheckMatrices(weightedLr.Parameters(), streamLr.Parameters(), 1e-5);
+  }
+}
+
+/**
+ * Make sure that merging statistics gives the same result as accumulating all
+ * the points at once, and that the statistics can be serialized.
+ */
+TEST_CASE("RegressionStatisticsMergeTest", "[LinearRegressionTest]")
+{
+  arma::mat data;
+  data.randn(4, 600);
+  data += 5.0;
+  arma::rowvec responses;
+  responses.randn(600);
+
+  RegressionStatistics all, first, second, empty;
+  all.Update(data, responses);
+  first.Update(data.cols(0, 199), responses.subvec(0, 199));
+  second.Update(data.cols(200, 599), responses.subvec(200, 599));
+
+  first += empty;
+  first += second;
+  empty += first;
+
+  REQUIRE(first.Count() == 600);
+  REQUIRE(first.ResponsesMean() ==
+      Approx(all.ResponsesMean()).epsilon(1e-10));
+  REQUIRE(first.ResponsesScatter() ==
+      Approx(all.ResponsesScatter()).epsilon(1e-10));
+  CheckMatrices(first.Means(), all.Means(), 1e-8);
+  CheckMatrices(first.Scatter(), all.Scatter(), 1e-8);
+  CheckMatrices(first.CrossScatter(), all.CrossScatter(), 1e-8);
+  CheckMatrices(empty.Scatter(), all.Scatter(), 1e-8);
+
+  RegressionStatistics xmlStats, jsonStats, binaryStats;
+  SerializeObjectAll(all, xmlStats, jsonStats, binaryStats);
+  REQUIRE(xmlStats.Count() == 600);
+  REQUIRE(binaryStats.WeightSum() == Approx(600.0).epsilon(1e-10));
+  CheckMatrices(all.Scatter(), xmlStats.Scatter(), jsonStats.Scatter(),
+      binaryStats.Scatter());
+
+  // Statistics of points of a different dimensionality can't be merged.
+  RegressionStatistics other;
+  other.Update(arma::randn<arma::mat>(3, 10), arma::randn<arma::rowvec>(10));
+  REQUIRE_THROWS_AS(all += other, std::invalid_argument);
+}
@@ -1181,3 +1181,51 @@ TEST_CASE("LinearSVMCallbackTest", "[LinearSVMTest]")
 
   REQUIRE(cb.calledEndOptimization == true);
 }
+
+/**
+ * Make sure that the sparse batch gradient used by parallel SGD is the same as
+ * the dense batch gradient when the batch has no zero values, and that it only
+ * touches the rows of the nonzero features otherwise.
+ */
+TEST_CASE("LinearSVMFunctionSparseGradient", "[LinearSVMTest]")
+{
+  const size_t numClasses = 3;
+
+  arma::mat data(8, 100, arma::fill::randu);
+  data += 0.1;
+  arma::Row<size_t> labels(100);
+  for (size_t i = 0; i < 100; ++i)
+    labels[i] = math::RandInt(0, numClasses);
+
+  for (size_t fitIntercept = 0; fitIntercept < 2; ++fitIntercept)
+  {
+    LinearSVMFunction<arma::mat> svmf(data, labels, numClasses, 0.3, 1.0,
+        (bool) fitIntercept);
+    arma::mat parameters(data.n_rows + fitIntercept, numClasses,
+        arma::fill::randn);
+
+    arma::mat gradient;
+    arma::sp_mat sparseGradient;
+    svmf.Gradient(parameters, 20, gradient, 5);
+    svmf.Gradient(parameters, 20, sparseGradient, 5);
+
+    REQUIRE(arma::approx_equal(gradient, arma::mat(sparseGradient), "absdiff",
+        1e-10));
+  }
+
+  // With sparse data, the rows of the features that are zero in the batch
+  // must not be touched.
+  arma::sp_mat sparseData;
+  sparseData.sprandu(30, 100, 0.05);
+  LinearSVMFunction<arma::sp_mat> sparseSvmf(sparseData, labels, numClasses,
+      0.3, 1.0, true);
+  arma::mat parameters(31, numClasses, arma::fill::randn);
+  arma::sp_mat sparseGradient;
+  sparseSvmf.Gradient(parameters, 0, sparseGradient, 1);
+
+  for (arma::sp_mat::const_iterator it = sparseGradient.begin();
+       it != sparseGradient.end(); ++it)
+  {
+    REQUIRE((it.row() == 30 || sparseData(it.row(), 0) != 0.0));
+  }
+}
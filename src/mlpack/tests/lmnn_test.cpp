@@ -97,6 +97,42 @@ TEST_CASE("LMNNImpostorsTest", "[LMNNTest]")
   REQUIRE(impostors(0, 5) == 2);
 }
 
+/**
+ * Splitting the neighbor searches into parallel tasks should not change the
+ * target neighbors or the impostors.
+ */
+TEST_CASE("LMNNParallelConstraintsTest", "[LMNNTest]")
+{
+  // Random points have no ties between distances.
+  arma::mat dataset(4, 1000, arma::fill::randu);
+  arma::Row<size_t> labels(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    labels[i] = i % 3;
+
+  arma::vec norm(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    norm(i) = arma::norm(dataset.col(i));
+
+  Constraints<> serialConstraint(dataset, labels, 3);
+  serialConstraint.ParallelDepth() = 0;
+  Constraints<> parallelConstraint(dataset, labels, 3);
+  parallelConstraint.ParallelDepth() = 2;
+
+  arma::Mat<size_t> serialNeighbors, parallelNeighbors;
+  serialConstraint.TargetNeighbors(serialNeighbors, dataset, labels, norm);
+  parallelConstraint.TargetNeighbors(parallelNeighbors, dataset, labels, norm);
+  CheckMatrices(serialNeighbors, parallelNeighbors);
+
+  arma::Mat<size_t> serialImpostors, parallelImpostors;
+  arma::mat serialDistances, parallelDistances;
+  serialConstraint.Impostors(serialImpostors, serialDistances, dataset, labels,
+      norm);
+  parallelConstraint.Impostors(parallelImpostors, parallelDistances, dataset,
+      labels, norm);
+  CheckMatrices(serialImpostors, parallelImpostors);
+  CheckMatrices(serialDistances, parallelDistances);
+}
+
 //
 // Tests for the LMNNFunction
 //
@@ -732,3 +768,40 @@ TEST_CASE("LMNNFunctionGradientTest4", "[LMNNTest]")
     CheckGradient(lmnnfn, coordinates);
   }
 }
+
+/**
+ * The gradient over one batch holding the whole dataset should match the
+ * gradient over the whole dataset, and computing the objective along with the
+ * gradient should not change either of them.
+ */
+TEST_CASE("LMNNFullBatchGradientTest", "[LMNNTest]")
+{
+  arma::mat dataset;
+  arma::Row<size_t> labels;
+  if (!data::Load("iris.csv", dataset))
+    FAIL("Cannot load dataset iris.csv");
+  if (!data::Load("iris_labels.txt", labels))
+    FAIL("Cannot load dataset iris_labels.txt");
+
+  for (size_t trial = 0; trial < 5; ++trial)
+  {
+    arma::mat coordinates(dataset.n_rows, dataset.n_rows, arma::fill::randn);
+
+    LMNNFunction<> fullFunction(dataset, labels, 3, 0.6, 1);
+    LMNNFunction<> batchFunction(dataset, labels, 3, 0.6, 1);
+    LMNNFunction<> combinedFunction(dataset, labels, 3, 0.6, 1);
+
+    arma::mat fullGradient, batchGradient, combinedGradient;
+    fullFunction.Gradient(coordinates, fullGradient);
+    batchFunction.Gradient(coordinates, 0, batchGradient, dataset.n_cols);
+    const double objective = combinedFunction.EvaluateWithGradient(
+        coordinates, combinedGradient);
+
+    LMNNFunction<> evaluateFunction(dataset, labels, 3, 0.6, 1);
+    REQUIRE(objective == Approx(evaluateFunction.Evaluate(coordinates)).
+        epsilon(1e-7));
+
+    CheckMatrices(fullGradient, batchGradient, 1e-5);
+    CheckMatrices(fullGradient, combinedGradient, 1e-5);
+  }
+}
@@ -12,7 +12,13 @@
 #include <sstream>
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/data/checkpointer.hpp>
+#include <mlpack/core/data/columnar.hpp>
+#include <mlpack/core/data/libsvm.hpp>
 #include <mlpack/core/data/load_arff.hpp>
+#include <mlpack/core/data/load_csv.hpp>
+#include <mlpack/core/data/mapped_matrix.hpp>
+#include <mlpack/core/tree/binary_space_tree.hpp>
 #include <mlpack/core/data/map_policies/missing_policy.hpp>
 #include "catch.hpp"
 #include "test_catch_tools.hpp"
@@ -1021,6 +1027,50 @@ TEST_CASE("LoadRawBinaryTest", "[LoadSaveTest]")
   remove("test_file.bin");
 }
 
+#ifndef _WIN32
+/**
+ * Make sure a raw binary file can be memory-mapped, and that a tree can be
+ * built in place over a writable mapping.
+ */
+TEST_CASE("MappedMatrixTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(4, 200, arma::fill::randu);
+  REQUIRE(dataset.quiet_save("test_file.bin", arma::raw_binary) == true);
+
+  {
+    MappedMatrix<double> mapped("test_file.bin", 4, 200);
+    arma::mat m = mapped.Matrix();
+
+    REQUIRE(m.n_rows == 4);
+    REQUIRE(m.n_cols == 200);
+    for (size_t i = 0; i < m.n_elem; ++i)
+      REQUIRE(m[i] == dataset[i]);
+  }
+
+  // Build a tree over the mapping; the points should be reordered in the file
+  // itself.
+  {
+    MappedMatrix<double> mapped("test_file.bin", 4, 200, true);
+    std::vector<size_t> oldFromNew;
+    tree::KDTree<metric::EuclideanDistance, tree::EmptyStatistic, arma::mat>
+        tree(mapped.Matrix(), oldFromNew, 5);
+
+    REQUIRE(tree.Dataset().memptr() == mapped.Matrix().memptr());
+    for (size_t i = 0; i < oldFromNew.size(); ++i)
+      for (size_t d = 0; d < 4; ++d)
+        REQUIRE(tree.Dataset()(d, i) == dataset(d, oldFromNew[i]));
+
+    mapped.Sync();
+  }
+
+  // Too many elements must be rejected.
+  REQUIRE_THROWS_AS(MappedMatrix<double>("test_file.bin", 4, 201),
+      std::invalid_argument);
+
+  remove("test_file.bin");
+}
+#endif
+
 /**
  * Make sure load as PGM is successful.
  */
@@ -1348,6 +1398,87 @@ TEST_CASE("LoadJsonTest", "[LoadSaveTest]")
   REQUIRE(y.inb.s == x.inb.s);
 }
 
+// Test structure with matrices, some large enough to be stored as blobs.
+class MatrixTest
+{
+ public:
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar(CEREAL_NVP(large));
+    ar(CEREAL_NVP(small));
+    ar(CEREAL_NVP(column));
+    ar(CEREAL_NVP(empty));
+  }
+
+  arma::mat large;
+  arma::vec small;
+  arma::Col<size_t> column;
+  arma::mat empty;
+};
+
+/**
+ * Make sure matrices survive the blob format, when loaded normally and when
+ * memory-mapped.
+ */
+TEST_CASE("LoadBlobTest", "[LoadSaveTest]")
+{
+  MatrixTest x;
+  x.large.randu(100, 100);
+  x.small.randu(3);
+  x.column = arma::randi<arma::Col<size_t>>(1000, arma::distr_param(0, 50));
+
+  REQUIRE(data::Save("test.blob", "x", x, false) == true);
+
+  MatrixTest y;
+  REQUIRE(data::Load("test.blob", "x", y, false) == true);
+  CheckMatrices(x.large, y.large);
+  CheckMatrices(x.small, y.small);
+  CheckMatrices(x.column, y.column);
+  REQUIRE(y.empty.n_elem == 0);
+
+  {
+    data::ModelMapping mapping;
+    MatrixTest z;
+    REQUIRE(data::LoadMapped("test.blob", "x", z, mapping, false) == true);
+    CheckMatrices(x.large, z.large);
+    CheckMatrices(x.small, z.small);
+    CheckMatrices(x.column, z.column);
+    REQUIRE(z.column.n_cols == 1);
+
+    // The large matrices use the mapped memory, aligned.
+    if (data::ModelMapping::Supported())
+    {
+      const char* begin = mapping.Data();
+      const char* end = mapping.Data() + mapping.Size();
+      const char* large = (const char*) z.large.memptr();
+      const char* column = (const char*) z.column.memptr();
+      REQUIRE(large >= begin);
+      REQUIRE(large < end);
+      REQUIRE(column >= begin);
+      REQUIRE(column < end);
+      REQUIRE(((size_t) large) % 64 == 0);
+      REQUIRE(((size_t) column) % 64 == 0);
+
+      // Changes to the model must not reach the file.
+      z.large(0, 0) = -1.0;
+    }
+  }
+
+  MatrixTest w;
+  REQUIRE(data::Load("test.blob", "x", w, false) == true);
+  CheckMatrices(x.large, w.large);
+
+  // A file in another format is rejected.
+  REQUIRE(data::Save("test.bin", "x", x, false) == true);
+  data::ModelMapping mapping;
+  MatrixTest v;
+  REQUIRE(data::LoadMapped("test.bin", "x", v, mapping, false) == false);
+
+  remove("test.blob");
+  remove("test.bin");
+}
+
 /**
  * Test DatasetInfo by making a map for a dimension.
  */
@@ -2463,6 +2594,356 @@ TEST_CASE("LoadCSVNoTransposeTXTTest", "[LoadSaveTest]")
   remove("test.txt");
 }
 
+/**
+ * Make sure that a dimension that only turns out to be categorical after some
+ * numeric values have been read is mapped the same way as if the whole file had
+ * been seen first.
+ */
+TEST_CASE("LoadCSVLateCategoricalTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.csv", fstream::out);
+  f << "1, a" << endl;
+  f << "2, 3" << endl;
+  f << "b, 4" << endl;
+  f << "1, a" << endl;
+  f.close();
+
+  arma::mat dataset;
+  DatasetInfo di;
+
+  REQUIRE(data::Load("test.csv", dataset, di));
+
+  REQUIRE(dataset.n_rows == 2);
+  REQUIRE(dataset.n_cols == 4);
+  REQUIRE(di.Type(0) == Datatype::categorical);
+  REQUIRE(di.Type(1) == Datatype::categorical);
+  REQUIRE(di.NumMappings(0) == 3);
+  REQUIRE(di.NumMappings(1) == 3);
+
+  // Mappings are given in order of appearance.
+  REQUIRE(dataset(0, 0) == 0);
+  REQUIRE(dataset(0, 1) == 1);
+  REQUIRE(dataset(0, 2) == 2);
+  REQUIRE(dataset(0, 3) == 0);
+  REQUIRE(dataset(1, 0) == 0);
+  REQUIRE(dataset(1, 1) == 1);
+  REQUIRE(dataset(1, 2) == 2);
+  REQUIRE(dataset(1, 3) == 0);
+  REQUIRE(di.UnmapString(2, 0) == "b");
+  REQUIRE(di.UnmapString(1, 1) == "3");
+
+  remove("test.csv");
+}
+
+/**
+ * Make sure that a CSV with many categorical dimensions, which are mapped in
+ * parallel, gets the same mappings (in order of appearance) whether or not it
+ * is transposed.
+ */
+TEST_CASE("LoadCSVManyCategoricalDimensionsTest", "[LoadSaveTest]")
+{
+  // Each dimension has its own set of categories, except that every third one
+  // is numeric.
+  const size_t dimensions = 30;
+  const size_t points = 500;
+  arma::Mat<size_t> categories = arma::randi<arma::Mat<size_t>>(dimensions,
+      points, arma::distr_param(0, 9));
+  fstream f, g;
+  f.open("test.csv", fstream::out);
+  g.open("test_nt.csv", fstream::out);
+  for (size_t i = 0; i < points; ++i)
+  {
+    for (size_t d = 0; d < dimensions; ++d)
+    {
+      f << categories(d, i);
+      if (d % 3 != 0)
+        f << "_" << d;
+      f << ((d + 1 == dimensions) ? "\n" : ", ");
+    }
+  }
+  for (size_t d = 0; d < dimensions; ++d)
+  {
+    for (size_t i = 0; i < points; ++i)
+    {
+      g << categories(d, i);
+      if (d % 3 != 0)
+        g << "_" << d;
+      g << ((i + 1 == points) ? "\n" : ", ");
+    }
+  }
+  f.close();
+  g.close();
+
+  arma::mat dataset, ntDataset;
+  DatasetInfo info, ntInfo;
+  REQUIRE(data::Load("test.csv", dataset, info));
+  REQUIRE(data::Load("test_nt.csv", ntDataset, ntInfo, true, false));
+
+  REQUIRE(dataset.n_rows == dimensions);
+  REQUIRE(dataset.n_cols == points);
+  CheckMatrices(dataset, ntDataset);
+
+  for (size_t d = 0; d < dimensions; ++d)
+  {
+    if (d % 3 == 0)
+    {
+      REQUIRE(info.Type(d) == Datatype::numeric);
+      REQUIRE(ntInfo.Type(d) == Datatype::numeric);
+      for (size_t i = 0; i < points; ++i)
+        REQUIRE(dataset(d, i) == categories(d, i));
+      continue;
+    }
+
+    REQUIRE(info.Type(d) == Datatype::categorical);
+    REQUIRE(ntInfo.Type(d) == Datatype::categorical);
+    REQUIRE(info.NumMappings(d) == ntInfo.NumMappings(d));
+
+    // The first value of each dimension is mapped to 0, the next distinct one
+    // to 1, and so on.
+    std::map<size_t, size_t> expected;
+    for (size_t i = 0; i < points; ++i)
+    {
+      if (expected.count(categories(d, i)) == 0)
+      {
+        const size_t mapping = expected.size();
+        expected[categories(d, i)] = mapping;
+      }
+
+      REQUIRE(dataset(d, i) == expected[categories(d, i)]);
+    }
+
+    REQUIRE(info.NumMappings(d) == expected.size());
+    for (size_t i = 0; i < info.NumMappings(d); ++i)
+      REQUIRE(info.UnmapString(i, d) == ntInfo.UnmapString(i, d));
+  }
+
+  remove("test.csv");
+  remove("test_nt.csv");
+}
+
+/**
+ * Make sure that a CSV can be loaded in chunks with LoadCSV::LoadChunk(), and
+ * that the chunks match the full dataset.
+ */
+TEST_CASE("LoadCSVChunkTest", "[LoadSaveTest]")
+{
+  arma::mat original = arma::randu<arma::mat>(3, 25);
+  original.row(1) = arma::floor(original.row(1) * 5);
+
+  fstream f;
+  f.open("test.csv", fstream::out);
+  f.precision(17);
+  for (size_t i = 0; i < original.n_cols; ++i)
+  {
+    f << original(0, i) << ", " << (original(1, i) < 2 ? "x" : "y") << ", "
+        << original(2, i) << endl;
+  }
+  f.close();
+
+  arma::mat full;
+  DatasetInfo fullInfo;
+  REQUIRE(data::Load("test.csv", full, fullInfo));
+
+  LoadCSV loader("test.csv");
+  DatasetInfo info;
+  arma::mat chunk;
+  size_t points = 0;
+  size_t chunks = 0;
+  while (loader.LoadChunk(chunk, info, 10))
+  {
+    REQUIRE(chunk.n_rows == 3);
+    REQUIRE(chunk.n_cols <= 10);
+    for (size_t i = 0; i < chunk.n_cols; ++i)
+    {
+      REQUIRE(chunk(0, i) == Approx(original(0, points + i)).epsilon(1e-7));
+      REQUIRE(chunk(1, i) == full(1, points + i));
+      REQUIRE(chunk(2, i) == Approx(original(2, points + i)).epsilon(1e-7));
+    }
+
+    points += chunk.n_cols;
+    ++chunks;
+  }
+
+  REQUIRE(points == original.n_cols);
+  REQUIRE(chunks == 3);
+  REQUIRE(chunk.n_cols == 0);
+  REQUIRE(info.Type(1) == Datatype::categorical);
+  REQUIRE(info.NumMappings(1) == fullInfo.NumMappings(1));
+
+  // A chunk size of zero is not allowed.
+  REQUIRE_THROWS_AS(loader.LoadChunk(chunk, info, 0), std::invalid_argument);
+
+  remove("test.csv");
+}
+
+/**
+ * Make sure a dataset with numeric and categorical dimensions survives a round
+ * trip through the columnar format, with and without transposing.
+ */
+TEST_CASE("ColumnarRoundTripTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.csv", fstream::out);
+  f << "1.5, red, 3" << endl;
+  f << "2.25, blue, 4" << endl;
+  f << "-1, red, 5" << endl;
+  f << "0, green, 6" << endl;
+  f.close();
+
+  arma::mat original;
+  DatasetInfo originalInfo;
+  REQUIRE(data::Load("test.csv", original, originalInfo));
+  REQUIRE(originalInfo.Type(1) == Datatype::categorical);
+
+  REQUIRE_NOTHROW(data::SaveColumnar("test.mlcol", original, originalInfo));
+
+  arma::mat loaded;
+  DatasetInfo info;
+  REQUIRE(data::Load("test.mlcol", loaded, info));
+  REQUIRE(loaded.n_rows == 3);
+  REQUIRE(loaded.n_cols == 4);
+  REQUIRE(info.Dimensionality() == 3);
+  REQUIRE(info.Type(0) == Datatype::numeric);
+  REQUIRE(info.Type(1) == Datatype::categorical);
+  REQUIRE(info.Type(2) == Datatype::numeric);
+  REQUIRE(info.NumMappings(1) == 3);
+  for (size_t i = 0; i < original.n_cols; ++i)
+  {
+    REQUIRE(loaded(0, i) == original(0, i));
+    REQUIRE(loaded(2, i) == original(2, i));
+    REQUIRE(info.UnmapString(loaded(1, i), 1) ==
+        originalInfo.UnmapString(original(1, i), 1));
+  }
+
+  // Loading without transposing gives one dimension per column.
+  arma::mat loadedTrans;
+  DatasetInfo infoTrans;
+  REQUIRE(data::Load("test.mlcol", loadedTrans, infoTrans, false, false));
+  REQUIRE(loadedTrans.n_rows == 4);
+  REQUIRE(loadedTrans.n_cols == 3);
+  CheckMatrices(loadedTrans, arma::mat(loaded.t()));
+
+  // Reusing the DatasetInfo keeps the existing mappings.
+  arma::fmat loadedFloat;
+  REQUIRE(data::Load("test.mlcol", loadedFloat, info));
+  REQUIRE(info.NumMappings(1) == 3);
+  CheckMatrices(arma::conv_to<arma::mat>::from(loadedFloat), loaded);
+
+  // A DatasetInfo with the wrong dimensionality cannot be used.
+  DatasetInfo wrongInfo(2);
+  REQUIRE_THROWS_AS(data::LoadColumnar("test.mlcol", loaded, wrongInfo),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(data::SaveColumnar("test.mlcol", original, wrongInfo),
+      std::invalid_argument);
+
+  // Categorical values without a mapping cannot be saved.
+  original(1, 2) = 7;
+  REQUIRE_THROWS_AS(data::SaveColumnar("test.mlcol", original, originalInfo),
+      std::invalid_argument);
+
+  remove("test.csv");
+  remove("test.mlcol");
+}
+
+/**
+ * Make sure a libsvm file with comments, query ids and unsorted indices is
+ * loaded correctly, and that a random sparse matrix survives a round trip.
+ */
+TEST_CASE("LibSVMRoundTripTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.svm", fstream::out);
+  f << "# A comment." << endl;
+  f << "+1 qid:3 1:0.5 4:-2 # Another comment." << endl;
+  f << endl;
+  f << "-1 3:1.25 2:7" << endl;
+  f << "1 5:0" << endl;
+  f.close();
+
+  arma::sp_mat matrix;
+  arma::Row<int> labels;
+  data::LoadLibSVM("test.svm", matrix, labels);
+  REQUIRE(matrix.n_rows == 5);
+  REQUIRE(matrix.n_cols == 3);
+  REQUIRE(matrix.n_nonzero == 4);
+  REQUIRE(labels.n_elem == 3);
+  REQUIRE(labels[0] == 1);
+  REQUIRE(labels[1] == -1);
+  REQUIRE(labels[2] == 1);
+  REQUIRE(matrix(0, 0) == Approx(0.5).epsilon(1e-7));
+  REQUIRE(matrix(3, 0) == Approx(-2.0).epsilon(1e-7));
+  REQUIRE(matrix(1, 1) == Approx(7.0).epsilon(1e-7));
+  REQUIRE(matrix(2, 1) == Approx(1.25).epsilon(1e-7));
+
+  // data::Load() gives one point per column too (and drops the labels).
+  arma::sp_mat loaded;
+  REQUIRE(data::Load("test.svm", loaded));
+  REQUIRE(loaded.n_rows == 5);
+  REQUIRE(loaded.n_cols == 3);
+  REQUIRE(arma::accu(arma::abs(loaded - matrix)) == 0.0);
+
+  // Negative labels cannot be loaded as unsigned labels.
+  arma::Row<size_t> unsignedLabels;
+  REQUIRE_THROWS_AS(data::LoadLibSVM("test.svm", matrix, unsignedLabels),
+      std::runtime_error);
+
+  // Round trip a random matrix, with a given number of dimensions.
+  arma::sp_mat original;
+  original.sprandu(20, 50, 0.2);
+  arma::Row<size_t> originalLabels =
+      arma::randi<arma::Row<size_t>>(50, arma::distr_param(0, 3));
+  data::SaveLibSVM("test.svm", original, originalLabels);
+
+  arma::Row<size_t> loadedLabels;
+  data::LoadLibSVM("test.svm", loaded, loadedLabels, 20);
+  REQUIRE(loaded.n_rows == 20);
+  REQUIRE(loaded.n_cols == 50);
+  REQUIRE(loaded.n_nonzero == original.n_nonzero);
+  REQUIRE(arma::all(loadedLabels == originalLabels));
+  REQUIRE(arma::accu(arma::abs(loaded - original)) == 0.0);
+
+  // Fewer dimensions than the largest index is an error.
+  REQUIRE_THROWS_AS(data::LoadLibSVM("test.svm", loaded, loadedLabels, 2),
+      std::runtime_error);
+
+  remove("test.svm");
+}
+
+/**
+ * Make sure malformed libsvm files are reported.
+ */
+TEST_CASE("LibSVMMalformedTest", "[LoadSaveTest]")
+{
+  const std::vector<std::string> lines = { "1 0:1.0", "1 a:1.0", "1 2:x",
+      "x 1:1.0", "1 2:1.0 1:3.0 2:4.0", "1 2" };
+
+  arma::sp_mat matrix;
+  arma::rowvec labels;
+  for (size_t i = 0; i < lines.size(); ++i)
+  {
+    fstream f;
+    f.open("test.svm", fstream::out);
+    f << "1 1:1.0" << endl;
+    f << lines[i] << endl;
+    f.close();
+
+    REQUIRE_THROWS_AS(data::LoadLibSVM("test.svm", matrix, labels),
+        std::runtime_error);
+  }
+
+  REQUIRE_THROWS_AS(data::LoadLibSVM("nonexistent.svm", matrix, labels),
+      std::runtime_error);
+
+  // Labels must match the points to save.
+  arma::sp_mat points(3, 4);
+  arma::rowvec wrongLabels(3);
+  REQUIRE_THROWS_AS(data::SaveLibSVM("test.svm", points, wrongLabels),
+      std::invalid_argument);
+
+  remove("test.svm");
+}
+
 /**
  * Make sure DatasetMapper properly unmaps from non-unique strings.
  */
@@ -2504,3 +2985,43 @@ TEST_CASE("LoadCSVHeaderTest", "[LoadSaveTest]")
   REQUIRE(dataset.n_rows == 4);
   REQUIRE(dataset.n_cols == 2);
 }
+
+/**
+ * Make sure that the Checkpointer writes the snapshot taken by Save(), even if
+ * the object changes afterwards, and skips snapshots while a write is running.
+ */
+TEST_CASE("CheckpointerTest", "[LoadSaveTest]")
+{
+  arma::mat m = arma::randu<arma::mat>(50, 40);
+  const arma::mat original = m;
+
+  {
+    data::Checkpointer<arma::mat> checkpointer("checkpoint.bin", "m");
+    REQUIRE(checkpointer.Save(m));
+    m.zeros();
+    checkpointer.Wait();
+
+    // A snapshot taken after the write finished is never skipped.
+    REQUIRE(checkpointer.Save(m) == true);
+    checkpointer.Wait();
+    REQUIRE(checkpointer.Saved() == 2);
+    REQUIRE(checkpointer.Skipped() == 0);
+  }
+
+  arma::mat loaded;
+  REQUIRE(data::Load("checkpoint.bin", "m", loaded));
+  REQUIRE(arma::approx_equal(loaded, m, "absdiff", 0.0));
+
+  {
+    data::Checkpointer<arma::mat> checkpointer("checkpoint.bin", "m");
+    checkpointer.Save(original);
+    // The destructor waits for the write.
+  }
+
+  REQUIRE(data::Load("checkpoint.bin", "m", loaded));
+  REQUIRE(arma::approx_equal(loaded, original, "absdiff", 0.0));
+  remove("checkpoint.bin");
+
+  REQUIRE_THROWS_AS(data::Checkpointer<arma::mat>("checkpoint", "m"),
+      std::invalid_argument);
+}
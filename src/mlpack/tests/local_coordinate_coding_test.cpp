@@ -16,6 +16,7 @@
 #include <mlpack/methods/local_coordinate_coding/lcc.hpp>
 
 #include "catch.hpp"
+#include "test_catch_tools.hpp"
 #include "serialization.hpp"
 
 using namespace arma;
@@ -86,6 +87,53 @@ TEST_CASE("LocalCoordinateCodingTestCodingStep",
   }
 }
 
+/**
+ * Encode() splits the points among threads, each reusing its weighted
+ * dictionary, weighted Gram matrix, and LARS object.  Make sure the codes are
+ * the ones found with new ones for each point.
+ */
+TEST_CASE("LocalCoordinateCodingParallelEncodeTest",
+          "[LocalCoordinateCodingTest]")
+{
+  double lambda1 = 0.1;
+  uword nAtoms = 10;
+
+  mat X;
+  X.load("mnist_first250_training_4s_and_9s.arm");
+  uword nPoints = X.n_cols;
+
+  // normalize each point since these are images
+  for (uword i = 0; i < nPoints; ++i)
+  {
+    X.col(i) /= norm(X.col(i), 2);
+  }
+
+  mat Z;
+  LocalCoordinateCoding lcc(X, nAtoms, lambda1, 10);
+  lcc.Encode(X, Z);
+
+  const mat& D = lcc.Dictionary();
+  const mat gram = trans(D) * D;
+  const mat invSqDists = 1.0 / (repmat(trans(sum(square(D))), 1, nPoints) +
+      repmat(sum(square(X)), nAtoms, 1) - 2 * trans(D) * X);
+
+  REQUIRE(Z.n_rows == nAtoms);
+  REQUIRE(Z.n_cols == nPoints);
+  for (uword i = 0; i < nPoints; ++i)
+  {
+    const vec invW = invSqDists.col(i);
+    mat dictPrime = D * diagmat(invW);
+    mat gramPrime = diagmat(invW) * gram * diagmat(invW);
+    LARS lars(false, gramPrime, 0.5 * lambda1);
+    vec code;
+    rowvec responses = trans(X.col(i));
+    lars.Train(dictPrime, responses, code, false);
+    code %= invW;
+
+    CheckMatrices(Z.unsafe_col(i), code, 1e-6);
+  }
+}
+
 TEST_CASE("LocalCoordinateCodingTestDictionaryStep",
           "[LocalCoordinateCodingTest]")
 {
@@ -123,6 +171,45 @@ TEST_CASE("LocalCoordinateCodingTestDictionaryStep",
   REQUIRE(norm(grad, "fro") == Approx(0.0).margin(tol));
 }
 
+/**
+ * Make sure that the dictionary step solves the normal equations exactly when
+ * they are accumulated over several blocks of points, and that inactive atoms
+ * are reinitialized.
+ */
+TEST_CASE("LocalCoordinateCodingDictionaryStepBlocks",
+          "[LocalCoordinateCodingTest]")
+{
+  const double lambda = 0.1;
+  const uword nAtoms = 6;
+
+  mat X = randu<mat>(8, 2500);
+  mat Z = randn<mat>(nAtoms, X.n_cols);
+  Z.elem(find(randu<mat>(nAtoms, X.n_cols) < 0.5)).zeros();
+  Z.row(4).zeros();
+
+  LocalCoordinateCoding lcc(nAtoms, lambda);
+  lcc.Dictionary() = randu<mat>(X.n_rows, nAtoms);
+  uvec adjacencies = find(Z);
+  lcc.OptimizeDictionary(X, Z, adjacencies);
+
+  const mat& D = lcc.Dictionary();
+
+  // The inactive atom is a normalized sum of points.
+  REQUIRE(norm(D.col(4), 2) == Approx(1.0).epsilon(1e-7));
+
+  // The gradient is zero for the active atoms.
+  mat grad = zeros(D.n_rows, D.n_cols);
+  for (uword i = 0; i < X.n_cols; ++i)
+  {
+    grad += (D - repmat(X.unsafe_col(i), 1, nAtoms)) *
+        diagmat(abs(Z.unsafe_col(i)));
+  }
+  grad = lambda * grad + (D * Z - X) * trans(Z);
+  grad.shed_col(4);
+
+  REQUIRE(norm(grad, "fro") == Approx(0.0).margin(1e-6));
+}
+
 TEST_CASE("LocalCoordinateCodingSerializationTest",
           "[LocalCoordinateCodingTest]")
 {
@@ -1081,3 +1081,126 @@ TEST_CASE("IncrementalTraining", "[LogisticRegressionTest]")
 
   REQUIRE(acc == Approx(100.0).epsilon(0.03)); // 3% error tolerance.
 }
+
+/**
+ * Make sure that the sparse batch gradient used by parallel SGD matches the
+ * dense batch gradient on the coordinates it touches.
+ */
+TEST_CASE("LogisticRegressionFunctionSparseGradient",
+          "[LogisticRegressionTest]")
+{
+  arma::sp_mat data;
+  data.sprandu(20, 200, 0.1);
+  arma::Row<size_t> responses(200);
+  for (size_t i = 0; i < 200; ++i)
+    responses[i] = math::RandInt(0, 2);
+
+  LogisticRegressionFunction<arma::sp_mat> lrf(data, responses, 0.5);
+
+  arma::mat parameters(1, 21, arma::fill::randu);
+  for (size_t begin = 0; begin < 200; begin += 40)
+  {
+    arma::mat gradient;
+    arma::sp_mat sparseGradient;
+    lrf.Gradient(parameters, begin, gradient, 10);
+    lrf.Gradient(parameters, begin, sparseGradient, 10);
+
+    REQUIRE(sparseGradient.n_rows == gradient.n_rows);
+    REQUIRE(sparseGradient.n_cols == gradient.n_cols);
+
+    // The intercept is always touched.
+    REQUIRE(sparseGradient(0, 0) == Approx(gradient(0, 0)).epsilon(1e-7));
+
+    // Only features that are nonzero in the batch can be touched.
+    const arma::mat batch(data.cols(begin, begin + 9));
+    for (size_t j = 1; j < parameters.n_cols; ++j)
+    {
+      const size_t count = arma::accu(batch.row(j - 1) != 0);
+      if (count == 0)
+      {
+        REQUIRE(sparseGradient(0, j) == 0.0);
+      }
+      else
+      {
+        // The penalty is applied once for each point that touches the
+        // feature.
+        const double penalty = 0.5 * parameters(0, j) / 200 * (10.0 - count);
+        REQUIRE(sparseGradient(0, j) + penalty ==
+            Approx(gradient(0, j)).epsilon(1e-7));
+      }
+    }
+  }
+}
+
+#ifdef HAS_OPENMP
+
+/**
+ * Train logistic regression on sparse data with the lock-free parallel SGD
+ * optimizer.
+ */
+TEST_CASE("LogisticRegressionParallelSGDSparseTest",
+          "[LogisticRegressionTest]")
+{
+  // Each point has a few active features; the label is determined by
+  // whether feature 0 or feature 1 is active.
+  const size_t points = 1000;
+  arma::sp_mat data(100, points);
+  arma::Row<size_t> responses(points);
+  for (size_t i = 0; i < points; ++i)
+  {
+    responses[i] = i % 2;
+    data(responses[i], i) = 1.0;
+    for (size_t j = 0; j < 3; ++j)
+      data(math::RandInt(2, 100), i) = math::Random();
+  }
+
+  ens::ConstantStep decayPolicy(0.1);
+  ens::ParallelSGD<ens::ConstantStep> optimizer(20,
+      std::ceil((float) points / omp_get_max_threads()), 1e-5, true,
+      decayPolicy);
+  LogisticRegression<arma::sp_mat> lr(data, responses, optimizer, 0.0001);
+
+  REQUIRE(lr.ComputeAccuracy(data, responses) >= 99.0);
+}
+
+#endif
+
+/**
+ * Make sure that shuffling the visitation order gives exactly the same batches
+ * as shuffling the data itself.
+ */
+TEST_CASE("LogisticRegressionFunctionShuffleTest", "[LogisticRegressionTest]")
+{
+  arma::mat data(5, 100, arma::fill::randu);
+  arma::Row<size_t> responses(100);
+  for (size_t i = 0; i < 100; ++i)
+    responses[i] = math::RandInt(0, 2);
+
+  arma::mat shuffledData(data);
+  arma::Row<size_t> shuffledResponses(responses);
+  LogisticRegressionFunction<> lrf(data, responses, 0.1);
+  arma::mat parameters(1, 6, arma::fill::randu);
+
+  // Shuffle a few times, to make sure the orderings are composed correctly.
+  for (size_t trial = 0; trial < 3; ++trial)
+  {
+    math::RandomSeed(trial + 1);
+    math::ShuffleData(shuffledData, shuffledResponses, shuffledData,
+        shuffledResponses);
+    math::RandomSeed(trial + 1);
+    lrf.Shuffle();
+
+    LogisticRegressionFunction<> reference(shuffledData, shuffledResponses,
+        0.1);
+    for (size_t begin = 0; begin < 100; begin += 25)
+    {
+      REQUIRE(lrf.Evaluate(parameters, begin, 25) ==
+          reference.Evaluate(parameters, begin, 25));
+
+      arma::mat gradient, referenceGradient;
+      lrf.Gradient(parameters, begin, gradient, 25);
+      reference.Gradient(parameters, begin, referenceGradient, 25);
+      REQUIRE(arma::approx_equal(gradient, referenceGradient, "absdiff", 0.0));
+    }
+  }
+}
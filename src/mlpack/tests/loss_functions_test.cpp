@@ -21,6 +21,7 @@
 #include <mlpack/methods/ann/loss_functions/earth_mover_distance.hpp>
 #include <mlpack/methods/ann/loss_functions/mean_squared_error.hpp>
 #include <mlpack/methods/ann/loss_functions/sigmoid_cross_entropy_error.hpp>
+#include <mlpack/methods/ann/loss_functions/softmax_cross_entropy_loss.hpp>
 #include <mlpack/methods/ann/loss_functions/binary_cross_entropy_loss.hpp>
 #include <mlpack/methods/ann/loss_functions/reconstruction_loss.hpp>
 #include <mlpack/methods/ann/loss_functions/margin_ranking_loss.hpp>
@@ -380,6 +381,51 @@ TEST_CASE("SimpleSigmoidCrossEntropyErrorTest", "[LossFunctionsTest]")
   REQUIRE(output.n_cols == input3.n_cols);
 }
 
+/**
+ * Make sure that the fused softmax cross-entropy loss matches a LogSoftMax
+ * layer followed by the negative log likelihood, and stays finite for large
+ * logits.
+ */
+TEST_CASE("SoftmaxCrossEntropyLossTest", "[LossFunctionsTest]")
+{
+  arma::mat input = arma::randn<arma::mat>(7, 20) * 3;
+  arma::mat target = arma::floor(arma::randu<arma::mat>(1, 20) * 7);
+
+  SoftmaxCrossEntropyLoss<> module;
+  LogSoftMax<> logSoftMax;
+  NegativeLogLikelihood<> nll;
+
+  arma::mat logProbabilities;
+  logSoftMax.Forward(input, logProbabilities);
+  const double expected = nll.Forward(logProbabilities, target);
+  REQUIRE(module.Forward(input, target) == Approx(expected).epsilon(1e-10));
+
+  arma::mat nllError, expectedGradient, gradient;
+  nll.Backward(logProbabilities, target, nllError);
+  logSoftMax.Backward(logProbabilities, nllError, expectedGradient);
+  module.Backward(input, target, gradient);
+  REQUIRE(gradient.n_rows == input.n_rows);
+  REQUIRE(gradient.n_cols == input.n_cols);
+  CheckMatrices(gradient, expectedGradient, 1e-8);
+
+  // The gradient of each point sums to zero.
+  for (size_t i = 0; i < gradient.n_cols; ++i)
+    REQUIRE(arma::accu(gradient.col(i)) == Approx(0.0).margin(1e-10));
+
+  // Large logits must not overflow.
+  arma::mat large("1000 0; 0 1000; -1000 -1000");
+  arma::mat largeTarget("0 0");
+  const double largeLoss = module.Forward(large, largeTarget);
+  REQUIRE(std::isfinite(largeLoss));
+  REQUIRE(largeLoss == Approx(1000.0).epsilon(1e-10));
+
+  module.Backward(large, largeTarget, gradient);
+  REQUIRE(gradient.is_finite());
+  REQUIRE(gradient(0, 0) == Approx(0.0).margin(1e-10));
+  REQUIRE(gradient(0, 1) == Approx(-1.0).epsilon(1e-10));
+  REQUIRE(gradient(1, 1) == Approx(1.0).epsilon(1e-10));
+}
+
 /**
  * Simple test for the Earth Mover Distance Layer.
  */
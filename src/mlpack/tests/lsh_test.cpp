@@ -654,6 +654,42 @@ TEST_CASE("LSHTrainTest", "[LSHTest]")
   REQUIRE(distances.n_rows == 3);
 }
 
+/**
+ * Make sure that the second hash table is laid out correctly: the rows are
+ * not empty and respect the bucket size, and each point is stored at most once
+ * per table.
+ */
+TEST_CASE("LSHTableLayoutTest", "[LSHTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(4, 500);
+  const size_t numTables = 6;
+  const size_t bucketSize = 20;
+
+  LSHSearch<> lsh(referenceData, 3, numTables, 0.5, 997, bucketSize);
+
+  const arma::Col<size_t>& offsets = lsh.BucketOffsets();
+  const arma::Col<size_t>& contents = lsh.BucketContents();
+  REQUIRE(offsets.n_elem >= 2);
+  REQUIRE(offsets[0] == 0);
+  REQUIRE(offsets[offsets.n_elem - 1] == contents.n_elem);
+  REQUIRE(contents.n_elem <= numTables * referenceData.n_cols);
+
+  arma::Col<size_t> appearances(referenceData.n_cols, arma::fill::zeros);
+  for (size_t i = 0; i + 1 < offsets.n_elem; ++i)
+  {
+    REQUIRE(offsets[i + 1] > offsets[i]);
+    REQUIRE(offsets[i + 1] - offsets[i] <= bucketSize);
+
+    for (size_t j = offsets[i]; j < offsets[i + 1]; ++j)
+    {
+      REQUIRE(contents[j] < referenceData.n_cols);
+      ++appearances[contents[j]];
+    }
+  }
+
+  REQUIRE(appearances.max() <= numTables);
+}
+
 /**
  * Test: this verifies ComputeRecall works correctly by providing two identical
  * vectors and requiring that Recall is equal to 1.
@@ -475,3 +475,53 @@ TEST_CASE_METHOD(DBSCANTestFixture, "DBSCANRandomSelectionFlagTest",
 
   REQUIRE(arma::accu(orderedOutput != randomOutput) > 0);
 }
+
+/**
+ * Check that reordering the points along a space-filling curve finds the same
+ * clusters (possibly with other labels), in the original order of the points.
+ */
+TEST_CASE_METHOD(DBSCANTestFixture, "DBSCANReorderTest",
+                 "[DBSCANMainTest][BindingTests]")
+{
+  arma::mat inputData;
+  if (!data::Load("iris.csv", inputData))
+    FAIL("Unable to load dataset iris.csv!");
+
+  // With a minimum size of 1, every point is a core point, so the clusters do
+  // not depend on the order the points are visited in.
+  SetInputParam("input", inputData);
+  SetInputParam("epsilon", (double) 0.358);
+  SetInputParam("min_size", 1);
+
+  mlpackMain();
+
+  const arma::Row<size_t> output =
+      std::move(IO::GetParam<arma::Row<size_t>>("assignments"));
+
+  const std::vector<std::string> curves = { "hilbert", "z-order" };
+  for (const std::string& curve : curves)
+  {
+    bindings::tests::CleanMemory();
+
+    SetInputParam("input", inputData);
+    SetInputParam("epsilon", (double) 0.358);
+    SetInputParam("min_size", 1);
+    SetInputParam("reorder", curve);
+
+    mlpackMain();
+
+    const arma::Row<size_t> reordered =
+        std::move(IO::GetParam<arma::Row<size_t>>("assignments"));
+    REQUIRE(reordered.n_elem == output.n_elem);
+
+    // The labels must map one-to-one.
+    std::map<size_t, size_t> forward, backward;
+    for (size_t i = 0; i < output.n_elem; ++i)
+    {
+      forward.insert(std::make_pair(output[i], reordered[i]));
+      backward.insert(std::make_pair(reordered[i], output[i]));
+      REQUIRE(forward[output[i]] == reordered[i]);
+      REQUIRE(backward[reordered[i]] == output[i]);
+    }
+  }
+}
@@ -708,3 +708,38 @@ TEST_CASE_METHOD(FastMKSTestFixture, "FastMKSBandwidthTest",
   CheckMatricesNotEqual(triKernel,
       IO::GetParam<arma::mat>("kernels"));
 }
+
+/**
+ * Make sure approximate search gives output of the right size, and that it can
+ * only be used with the linear kernel.
+ */
+TEST_CASE_METHOD(FastMKSTestFixture, "FastMKSApproximateTest",
+                 "[FastMKSMainTest][BindingTests]")
+{
+  arma::mat referenceData(10, 200, arma::fill::randu);
+  arma::mat queryData(10, 50, arma::fill::randu);
+
+  SetInputParam("reference", referenceData);
+  SetInputParam("query", std::move(queryData));
+  SetInputParam("k", (int) 5);
+  SetInputParam("approximate", true);
+  SetInputParam("ef_search", (int) 100);
+
+  mlpackMain();
+
+  REQUIRE(IO::GetParam<arma::Mat<size_t>>("indices").n_rows == 5);
+  REQUIRE(IO::GetParam<arma::Mat<size_t>>("indices").n_cols == 50);
+  REQUIRE(IO::GetParam<arma::mat>("kernels").n_rows == 5);
+  REQUIRE(IO::GetParam<arma::mat>("kernels").n_cols == 50);
+  REQUIRE(IO::GetParam<FastMKSModel*>("output_model")->Approximate());
+
+  bindings::tests::CleanMemory();
+
+  IO::GetSingleton().Parameters()["query"].wasPassed = false;
+  SetInputParam("reference", std::move(referenceData));
+  SetInputParam("kernel", (std::string) "polynomial");
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(mlpackMain(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
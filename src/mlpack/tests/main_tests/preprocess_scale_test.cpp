@@ -365,3 +365,49 @@ TEST_CASE_METHOD(PreprocessScaleTestFixture, "MeanNormalizationBindingTest",
   SetInputParam("inverse_scaling", true);
   REQUIRE_NOTHROW(mlpackMain());
 }
+
+/**
+ * Check that a model fit on chunks of the data with partial_fit scales the
+ * data as a model fit on all of it does.
+ */
+TEST_CASE_METHOD(PreprocessScaleTestFixture, "PartialFitBindingTest",
+                 "[PreprocessScaleMainTest][BindingTests]")
+{
+  SetInputParam("input", dataset);
+  SetInputParam("scaler_method", std::string("standard_scaler"));
+
+  mlpackMain();
+  arma::mat scaled = IO::GetParam<arma::mat>("output");
+
+  bindings::tests::CleanMemory();
+
+  // Fit on the first two points only.
+  SetInputParam("input", arma::mat(dataset.cols(0, 1)));
+  SetInputParam("scaler_method", std::string("standard_scaler"));
+
+  mlpackMain();
+
+  // Update the model with the last two points.
+  SetInputParam("input", arma::mat(dataset.cols(2, 3)));
+  SetInputParam("input_model",
+                IO::GetParam<ScalingModel*>("output_model"));
+  SetInputParam("partial_fit", true);
+
+  mlpackMain();
+  arma::mat lastScaled = IO::GetParam<arma::mat>("output");
+  CheckMatrices(arma::mat(scaled.cols(2, 3)), lastScaled);
+
+  // Whitening cannot be fit in chunks.
+  bindings::tests::CleanMemory();
+  IO::ClearSettings();
+  IO::RestoreSettings(testName);
+
+  SetInputParam("input", dataset);
+  SetInputParam("scaler_method", std::string("pca_whitening"));
+  mlpackMain();
+
+  SetInputParam("input", dataset);
+  SetInputParam("input_model", IO::GetParam<ScalingModel*>("output_model"));
+  SetInputParam("partial_fit", true);
+  REQUIRE_THROWS_AS(mlpackMain(), std::invalid_argument);
+}
@@ -598,3 +598,58 @@ TEST_CASE_METHOD(RangeSearchTestFixture, "SingleModeTest",
   remove(neighborsFile.c_str());
   remove(distanceFile.c_str());
 }
+
+/**
+ * Check that the compressed sparse row output holds the same results as the
+ * output files.
+ */
+TEST_CASE_METHOD(RangeSearchTestFixture, "RangeSearchCSROutputTest",
+                 "[RangeSearchMainTest][BindingTests]")
+{
+  arma::mat x = {{0, 3, 3, 4, 3, 1},
+                 {4, 4, 4, 5, 5, 2},
+                 {0, 1, 2, 2, 3, 3}};
+
+  vector<vector<size_t>> neighborVal = {{},
+                                        {2, 3, 4},
+                                        {1, 3, 4, 5},
+                                        {1, 2, 4},
+                                        {1, 2, 3},
+                                        {2}};
+  vector<vector<double>> distanceVal = {{},
+                                        {1, 1.73205, 2.23607},
+                                        {1, 1.41421, 1.41421, 3},
+                                        {1.73205, 1.41421, 1.41421},
+                                        {2.23607, 1.41421, 1.41421},
+                                        {3}};
+
+  SetInputParam("reference", move(x));
+  SetInputParam("min", 0.0);
+  SetInputParam("max", 3.0);
+
+  mlpackMain();
+
+  const arma::Col<size_t>& offsets =
+      IO::GetParam<arma::Col<size_t>>("offsets");
+  const arma::Col<size_t>& neighborsOut =
+      IO::GetParam<arma::Col<size_t>>("neighbors");
+  const arma::vec& distancesOut = IO::GetParam<arma::vec>("distances");
+
+  REQUIRE(offsets.n_elem == 7);
+  REQUIRE(offsets[6] == neighborsOut.n_elem);
+  REQUIRE(offsets[6] == distancesOut.n_elem);
+
+  vector<vector<size_t>> neighbors(6);
+  vector<vector<double>> distances(6);
+  for (size_t i = 0; i < 6; ++i)
+  {
+    for (size_t j = offsets[i]; j < offsets[i + 1]; ++j)
+    {
+      neighbors[i].push_back(neighborsOut[j]);
+      distances[i].push_back(distancesOut[j]);
+    }
+  }
+
+  CheckMatrices(neighbors, neighborVal);
+  CheckMatrices(distances, distanceVal);
+}
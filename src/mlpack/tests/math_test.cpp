@@ -10,6 +10,8 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/core/math/clamp.hpp>
+#include <mlpack/core/math/descriptive_statistics.hpp>
+#include <mlpack/core/math/quantile_sketch.hpp>
 #include <mlpack/core/math/random.hpp>
 #include <mlpack/core/math/range.hpp>
 #include "catch.hpp"
@@ -1006,3 +1008,157 @@ TEST_CASE("InplaceSparseShuffleWeightsTest", "[MathTest]")
     REQUIRE(weightCounts[i] == 1);
   }
 }
+
+/**
+ * Make sure that the quantiles estimated by a QuantileSketch have a small rank
+ * error, also when sketches of different parts of the stream are merged.
+ */
+TEST_CASE("QuantileSketchRankErrorTest", "[MathTest]")
+{
+  arma::vec values = arma::randn<arma::vec>(100000);
+
+  QuantileSketch sketch, first(200, 1), second(200, 2);
+  for (size_t i = 0; i < values.n_elem; ++i)
+  {
+    sketch.Update(values[i]);
+    if (i < 30000)
+      first.Update(values[i]);
+    else
+      second.Update(values[i]);
+  }
+  first += second;
+
+  REQUIRE(sketch.Count() == values.n_elem);
+  REQUIRE(first.Count() == values.n_elem);
+  REQUIRE(sketch.Size() < 1000);
+  REQUIRE(first.Size() < 1000);
+
+  const arma::vec sorted = arma::sort(values);
+  for (const double q : { 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99 })
+  {
+    const double rank = arma::accu(sorted < sketch.Quantile(q)) /
+        (double) values.n_elem;
+    const double mergedRank = arma::accu(sorted < first.Quantile(q)) /
+        (double) values.n_elem;
+    REQUIRE(rank == Approx(q).margin(0.02));
+    REQUIRE(mergedRank == Approx(q).margin(0.02));
+  }
+}
+
+/**
+ * Make sure that a QuantileSketch that has not compacted anything gives the
+ * exact quantiles, and that invalid quantiles are rejected.
+ */
+TEST_CASE("QuantileSketchExactTest", "[MathTest]")
+{
+  QuantileSketch sketch;
+  REQUIRE(std::isnan(sketch.Quantile(0.5)));
+
+  for (size_t i = 0; i < 100; ++i)
+    sketch.Update(99 - (double) i);
+
+  REQUIRE(sketch.Quantile(0.0) == 0.0);
+  REQUIRE(sketch.Quantile(0.5) == 49.0);
+  REQUIRE(sketch.Quantile(1.0) == 99.0);
+  REQUIRE_THROWS_AS(sketch.Quantile(1.5), std::invalid_argument);
+
+  QuantileSketch other(100);
+  REQUIRE_THROWS_AS(sketch += other, std::invalid_argument);
+}
+
+/**
+ * Make sure that DescriptiveStatistics gives the same moments and extremes as
+ * computing them directly, for both sample and population statistics.
+ */
+TEST_CASE("DescriptiveStatisticsMomentsTest", "[MathTest]")
+{
+  // Enough points for several blocks, with a large offset to check the
+  // accuracy of the moments.
+  arma::mat data = arma::randu<arma::mat>(5, 50000);
+  data.row(1) = arma::exp(data.row(1)) + 1e6;
+  data.row(2) = arma::square(data.row(2));
+
+  DescriptiveStatistics stats;
+  stats.Update(data);
+
+  REQUIRE(stats.Dimensionality() == 5);
+  REQUIRE(stats.Count() == 50000);
+
+  for (const bool population : { false, true })
+  {
+    const arma::vec variance = stats.Variance(population);
+    const arma::vec skewness = stats.Skewness(population);
+    const arma::vec kurtosis = stats.Kurtosis(population);
+    for (size_t d = 0; d < data.n_rows; ++d)
+    {
+      const arma::rowvec row = data.row(d);
+      const double n = row.n_elem;
+      const double mean = arma::mean(row);
+      const double m2 = arma::accu(arma::pow(row - mean, 2));
+      const double m3 = arma::accu(arma::pow(row - mean, 3));
+      const double m4 = arma::accu(arma::pow(row - mean, 4));
+      const double var = arma::var(row, population);
+      const double s = std::sqrt(var);
+
+      const double skew = population ? m3 / (n * std::pow(s, 3)) :
+          n * m3 / ((n - 1) * (n - 2) * std::pow(s, 3));
+      const double kurt = population ? n * m4 / (m2 * m2) - 3 :
+          (n * (n + 1)) / ((n - 1) * (n - 2) * (n - 3)) * m4 / (var * var) -
+          3 * (n - 1) * (n - 1) / ((n - 2) * (n - 3));
+
+      REQUIRE(stats.Mean()[d] == Approx(mean).epsilon(1e-10));
+      REQUIRE(stats.Min()[d] == arma::min(row));
+      REQUIRE(stats.Max()[d] == arma::max(row));
+      REQUIRE(variance[d] == Approx(var).epsilon(1e-7));
+      REQUIRE(skewness[d] == Approx(skew).epsilon(1e-5).margin(1e-6));
+      REQUIRE(kurtosis[d] == Approx(kurt).epsilon(1e-5).margin(1e-6));
+    }
+  }
+}
+
+/**
+ * Make sure that DescriptiveStatistics gives the same results for row-major
+ * data, for data given in chunks, and for merged statistics.
+ */
+TEST_CASE("DescriptiveStatisticsMergeTest", "[MathTest]")
+{
+  arma::mat data = arma::randn<arma::mat>(3, 20000);
+  data.row(0) += 10.0;
+
+  DescriptiveStatistics stats, rowMajorStats, chunkedStats, first, second;
+  stats.Update(data);
+  rowMajorStats.Update(arma::mat(data.t()), true);
+  chunkedStats.Update(data.cols(0, 6999));
+  chunkedStats.Update(data.cols(7000, 19999));
+  first.Update(data.cols(0, 12344));
+  second.Update(data.cols(12345, 19999));
+  first += second;
+
+  for (const DescriptiveStatistics* other :
+      { &rowMajorStats, &chunkedStats, &first })
+  {
+    REQUIRE(other->Count() == stats.Count());
+    CheckMatrices(other->Mean(), stats.Mean(), 1e-8);
+    CheckMatrices(other->Min(), stats.Min());
+    CheckMatrices(other->Max(), stats.Max());
+    CheckMatrices(other->Variance(), stats.Variance(), 1e-8);
+    CheckMatrices(other->Skewness(), stats.Skewness(), 1e-6);
+    CheckMatrices(other->Kurtosis(), stats.Kurtosis(), 1e-6);
+
+    // The sketches make different random choices, but the medians should be
+    // close.
+    const arma::vec medians = other->Quantile(0.5);
+    for (size_t d = 0; d < data.n_rows; ++d)
+    {
+      const double rank = arma::accu(data.row(d) < medians[d]) /
+          (double) data.n_cols;
+      REQUIRE(rank == Approx(0.5).margin(0.02));
+    }
+  }
+
+  DescriptiveStatistics wrongDimensionality;
+  wrongDimensionality.Update(arma::randu<arma::mat>(4, 10));
+  REQUIRE_THROWS_AS(stats += wrongDimensionality, std::invalid_argument);
+  REQUIRE_THROWS_AS(stats.Update(arma::randu<arma::mat>(4, 10)),
+      std::invalid_argument);
+}
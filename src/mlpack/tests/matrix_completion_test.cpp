@@ -60,3 +60,44 @@ TEST_CASE("UniformMatrixCompletionSDP", "[MatrixCompletionTest]")
        Approx(Xorig(indices(0, i), indices(1, i))).epsilon(1e-7));
   }
 }
+
+/**
+ * Recover a random rank-2 matrix from 60% of its entries with alternating least
+ * squares.
+ */
+TEST_CASE("LowRankMatrixCompletionALS", "[MatrixCompletionTest]")
+{
+  const size_t m = 40, n = 30, r = 2;
+  const arma::mat Xorig = arma::randu<arma::mat>(m, r) *
+      arma::randu<arma::mat>(r, n);
+
+  // Take a random subset of the entries.
+  const size_t p = (size_t) (0.6 * m * n);
+  const arma::uvec known = arma::randperm(m * n, p);
+  arma::umat indices(2, p);
+  arma::vec values(p);
+  for (size_t i = 0; i < p; ++i)
+  {
+    indices(0, i) = known[i] % m;
+    indices(1, i) = known[i] / m;
+    values[i] = Xorig[known[i]];
+  }
+
+  arma::mat recovered;
+  MatrixCompletion mc(m, n, indices, values, r);
+  mc.RecoverALS(recovered, 1e-6);
+
+  REQUIRE(recovered.n_rows == m);
+  REQUIRE(recovered.n_cols == n);
+
+  const double err =
+    arma::norm(Xorig - recovered, "fro") /
+    arma::norm(Xorig, "fro");
+  REQUIRE(err == Approx(0.0).margin(1e-3));
+
+  for (size_t i = 0; i < p; ++i)
+  {
+    REQUIRE(recovered(indices(0, i), indices(1, i)) ==
+       Approx(values[i]).margin(1e-3));
+  }
+}
@@ -162,3 +162,137 @@ TEST_CASE("GaussianClustering", "[MeanShiftTest]")
 
   REQUIRE(success == true);
 }
+
+/**
+ * Run the flat-kernel mean shift algorithm one seed at a time, with a
+ * brute-force search for the points in the radius of each centroid, and remove
+ * the duplicate centroids in seed order.
+ */
+arma::mat SerialMeanShiftCentroids(const arma::mat& data,
+                                   const arma::mat& seeds,
+                                   const double radius,
+                                   const size_t maxIterations)
+{
+  arma::mat centroids;
+  for (size_t i = 0; i < seeds.n_cols; ++i)
+  {
+    arma::vec centroid = seeds.col(i);
+    bool converged = false;
+    for (size_t iteration = 0; iteration < maxIterations; ++iteration)
+    {
+      arma::vec newCentroid(data.n_rows, arma::fill::zeros);
+      size_t count = 0;
+      for (size_t j = 0; j < data.n_cols; ++j)
+      {
+        if (metric::EuclideanDistance::Evaluate(centroid, data.col(j)) <=
+            radius)
+        {
+          newCentroid += data.col(j);
+          ++count;
+        }
+      }
+
+      if (count == 0)
+        break;
+      newCentroid /= count;
+
+      if (metric::EuclideanDistance::Evaluate(newCentroid, centroid) <
+          1e-3 * radius)
+      {
+        converged = true;
+        break;
+      }
+
+      centroid = newCentroid;
+    }
+
+    if (!converged)
+      continue;
+
+    bool isDuplicated = false;
+    for (size_t k = 0; k < centroids.n_cols; ++k)
+    {
+      if (metric::EuclideanDistance::Evaluate(centroid, centroids.col(k)) <
+          radius)
+      {
+        isDuplicated = true;
+        break;
+      }
+    }
+
+    if (!isDuplicated)
+      centroids.insert_cols(centroids.n_cols, centroid);
+  }
+
+  return centroids;
+}
+
+/**
+ * The seeds are shifted together, with one range search for all of them in
+ * each iteration.  Make sure that this finds the centroids of shifting each
+ * seed on its own, in the same order, both when every point is a seed and when
+ * the seeds are the occupied bins of a grid.
+ */
+TEST_CASE("MeanShiftSerialSeedsTest", "[MeanShiftTest]")
+{
+  GaussianDistribution g1("0.0 0.0", 0.5 * arma::eye<arma::mat>(2, 2));
+  GaussianDistribution g2("6.0 6.0", 0.5 * arma::eye<arma::mat>(2, 2));
+  GaussianDistribution g3("-6.0 4.0", 0.5 * arma::eye<arma::mat>(2, 2));
+
+  arma::mat dataset(2, 600);
+  for (size_t i = 0; i < 200; ++i)
+  {
+    dataset.col(i) = g1.Random();
+    dataset.col(i + 200) = g2.Random();
+    dataset.col(i + 400) = g3.Random();
+  }
+
+  const double radius = 2.0;
+
+  // The seeds of the grid are the lower corners of the occupied bins, in
+  // lexicographic order of their coordinates.
+  std::map<std::vector<arma::sword>, size_t> bins;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    std::vector<arma::sword> bin(dataset.n_rows);
+    for (size_t d = 0; d < dataset.n_rows; ++d)
+      bin[d] = (arma::sword) std::floor(dataset(d, i) / radius);
+    ++bins[bin];
+  }
+
+  arma::mat gridSeeds(dataset.n_rows, bins.size());
+  size_t seed = 0;
+  for (auto it = bins.begin(); it != bins.end(); ++it, ++seed)
+    for (size_t d = 0; d < dataset.n_rows; ++d)
+      gridSeeds(d, seed) = it->first[d] * radius;
+
+  for (size_t useSeeds = 0; useSeeds < 2; ++useSeeds)
+  {
+    MeanShift<> meanShift(radius, 100);
+
+    arma::Row<size_t> assignments;
+    arma::mat centroids;
+    meanShift.Cluster(dataset, assignments, centroids, false, useSeeds == 1);
+
+    const arma::mat expected = SerialMeanShiftCentroids(dataset,
+        (useSeeds == 1) ? gridSeeds : dataset, radius, 100);
+
+    // A different summation order may let a seed stop one iteration earlier
+    // or later, which moves its centroid by less than 1e-3 * radius.
+    REQUIRE(centroids.n_rows == expected.n_rows);
+    REQUIRE(centroids.n_cols == expected.n_cols);
+    REQUIRE(arma::approx_equal(centroids, expected, "absdiff", 1e-3 * radius));
+
+    // Each point is assigned to its closest centroid.
+    for (size_t i = 0; i < dataset.n_cols; ++i)
+    {
+      arma::vec distances(centroids.n_cols);
+      for (size_t k = 0; k < centroids.n_cols; ++k)
+      {
+        distances[k] = metric::EuclideanDistance::Evaluate(dataset.col(i),
+            centroids.col(k));
+      }
+      REQUIRE(assignments[i] == distances.index_min());
+    }
+  }
+}
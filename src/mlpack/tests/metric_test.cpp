@@ -97,6 +97,87 @@ TEST_CASE("LINFMetricTest", "[MetricTest]")
       Approx(lMetric.Evaluate(a2, b2)).epsilon(1e-7));
 }
 
+/**
+ * Make sure that LMetric::BatchEvaluate() gives the same results as calling
+ * Evaluate() on every pair of points.
+ */
+template<typename MetricType>
+void CheckBatchEvaluate(const arma::mat& a, const arma::mat& b)
+{
+  arma::mat distances;
+  MetricType::BatchEvaluate(a, b, distances);
+
+  REQUIRE(distances.n_rows == a.n_cols);
+  REQUIRE(distances.n_cols == b.n_cols);
+  for (size_t i = 0; i < a.n_cols; ++i)
+  {
+    for (size_t j = 0; j < b.n_cols; ++j)
+    {
+      REQUIRE(distances(i, j) ==
+          Approx(MetricType::Evaluate(a.col(i), b.col(j))).epsilon(1e-7));
+    }
+  }
+}
+
+TEST_CASE("LMetricBatchEvaluateTest", "[MetricTest]")
+{
+  // Offset the points from the origin to exercise the numerical stability of
+  // the L2 expansion.
+  arma::mat a(128, 13, arma::fill::randu);
+  arma::mat b(128, 20, arma::fill::randu);
+  a += 1000.0;
+  b += 1000.0;
+
+  CheckBatchEvaluate<ManhattanDistance>(a, b);
+  CheckBatchEvaluate<SquaredEuclideanDistance>(a, b);
+  CheckBatchEvaluate<EuclideanDistance>(a, b);
+  CheckBatchEvaluate<ChebyshevDistance>(a, b);
+  CheckBatchEvaluate<LMetric<3, true>>(a, b);
+
+  // The distance between a point and itself should be zero.
+  arma::mat distances;
+  EuclideanDistance::BatchEvaluate(a, a, distances);
+  for (size_t i = 0; i < a.n_cols; ++i)
+    REQUIRE(distances(i, i) == Approx(0.0).margin(1e-5));
+
+  // Mismatched dimensionalities should throw.
+  arma::mat c(10, 5, arma::fill::randu);
+  REQUIRE_THROWS_AS(EuclideanDistance::BatchEvaluate(a, c, distances),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that the fixed-dimension kernels used by LMetric::Evaluate() for
+ * low-dimensional points match the general formulas.
+ */
+TEST_CASE("LMetricLowDimensionTest", "[MetricTest]")
+{
+  for (size_t d = 1; d <= 6; ++d)
+  {
+    arma::vec a(d, arma::fill::randn);
+    arma::vec b(d, arma::fill::randn);
+    const arma::vec diff = arma::abs(a - b);
+
+    REQUIRE(ManhattanDistance::Evaluate(a, b) ==
+        Approx(arma::accu(diff)).epsilon(1e-7));
+    REQUIRE(SquaredEuclideanDistance::Evaluate(a, b) ==
+        Approx(arma::accu(arma::square(diff))).epsilon(1e-7));
+    REQUIRE(EuclideanDistance::Evaluate(a, b) ==
+        Approx(std::sqrt(arma::accu(arma::square(diff)))).epsilon(1e-7));
+    REQUIRE(ChebyshevDistance::Evaluate(a, b) ==
+        Approx(arma::max(diff)).epsilon(1e-7));
+    REQUIRE((LMetric<3, true>::Evaluate(a, b)) ==
+        Approx(std::cbrt(arma::accu(arma::pow(diff, 3)))).epsilon(1e-7));
+    REQUIRE((LMetric<3, false>::Evaluate(a, b)) ==
+        Approx(arma::accu(arma::pow(diff, 3))).epsilon(1e-7));
+
+    // Columns of a matrix should work too.
+    arma::mat m = arma::join_rows(a, b);
+    REQUIRE(EuclideanDistance::Evaluate(m.col(0), m.col(1)) ==
+        Approx(EuclideanDistance::Evaluate(a, b)).epsilon(1e-7));
+  }
+}
+
 /**
  * Simple test for IoU metric.
  */
@@ -301,6 +382,104 @@ TEST_CASE("NMSMetricTest", "[MetricTest]")
   CheckMatrices(desiredBoundingBox, selectedBoundingBox);
 }
 
+/**
+ * Make sure that the IoU of every pair of two sets of bounding boxes matches
+ * the IoU of each pair.
+ */
+TEST_CASE("IoUPairwiseTest", "[MetricTest]")
+{
+  // Random boxes in the {x0, y0, x1, y1} representation.
+  arma::mat a(4, 30, arma::fill::randu), b(4, 20, arma::fill::randu);
+  a.rows(0, 1) *= 50;
+  a.rows(2, 3) = a.rows(0, 1) + 1 + 30 * a.rows(2, 3);
+  b.rows(0, 1) *= 50;
+  b.rows(2, 3) = b.rows(0, 1) + 1 + 30 * b.rows(2, 3);
+
+  arma::mat ious;
+  IoU<true>::Evaluate(a, b, ious);
+
+  REQUIRE(ious.n_rows == a.n_cols);
+  REQUIRE(ious.n_cols == b.n_cols);
+  for (size_t i = 0; i < a.n_cols; ++i)
+  {
+    for (size_t j = 0; j < b.n_cols; ++j)
+    {
+      const arma::vec boxA = a.col(i), boxB = b.col(j);
+      REQUIRE(ious(i, j) ==
+          Approx(IoU<true>::Evaluate(boxA, boxB)).epsilon(1e-10));
+    }
+  }
+
+  // Now the same boxes in the {x0, y0, h, w} representation.
+  a.rows(2, 3) -= a.rows(0, 1);
+  b.rows(2, 3) -= b.rows(0, 1);
+  arma::mat hwIous;
+  IoU<>::Evaluate(a, b, hwIous);
+
+  CheckMatrices(ious, hwIous, 1e-8);
+}
+
+/**
+ * Compare non-maximal suppression with a simple implementation on many
+ * overlapping boxes, and make sure that the batched version gives the same
+ * results for each image.
+ */
+TEST_CASE("NMSManyBoxesTest", "[MetricTest]")
+{
+  std::vector<arma::mat> boxes(5);
+  std::vector<arma::vec> scores(5);
+  for (size_t k = 0; k < boxes.size(); ++k)
+  {
+    // Many more boxes than fit in a word of the bitmask.
+    boxes[k].randu(4, 300);
+    boxes[k].rows(0, 1) *= 100;
+    boxes[k].rows(2, 3) = 5 + 20 * boxes[k].rows(2, 3);
+    scores[k].randu(300);
+  }
+
+  std::vector<arma::uvec> batchIndices;
+  NMS<>::Evaluate(boxes, scores, batchIndices, 0.3);
+  REQUIRE(batchIndices.size() == boxes.size());
+
+  for (size_t k = 0; k < boxes.size(); ++k)
+  {
+    arma::uvec selectedIndices;
+    NMS<>::Evaluate(boxes[k], scores[k], selectedIndices, 0.3);
+
+    // Greedy suppression, one box at a time.
+    const arma::uvec order = arma::sort_index(scores[k], "descend");
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < order.n_elem; ++i)
+    {
+      const arma::vec box = boxes[k].col(order[i]);
+      bool keep = true;
+      for (size_t j = 0; j < expected.size() && keep; ++j)
+      {
+        const arma::vec other = boxes[k].col(expected[j]);
+        const double width = std::min(box[0] + box[2], other[0] + other[2]) -
+            std::max(box[0], other[0]);
+        const double height = std::min(box[1] + box[3], other[1] + other[3]) -
+            std::max(box[1], other[1]);
+        const double intersection = std::max(width, 0.0) *
+            std::max(height, 0.0);
+        const double iou = intersection / (box[2] * box[3] +
+            other[2] * other[3] - intersection);
+        keep = (iou <= 0.3);
+      }
+      if (keep)
+        expected.push_back(order[i]);
+    }
+
+    REQUIRE(selectedIndices.n_elem == expected.size());
+    REQUIRE(batchIndices[k].n_elem == expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+      REQUIRE(selectedIndices[i] == expected[i]);
+      REQUIRE(batchIndices[k][i] == expected[i]);
+    }
+  }
+}
+
 /**
  *
  */
@@ -358,3 +537,66 @@ TEST_CASE("BLEUScoreTest", "[MetricTest]")
         Approx(expectedPrecision[i]).epsilon(1e-4));
   }
 }
+
+/**
+ * Make sure that BLEU gives the same results for a corpus of words and for the
+ * same corpus tokenized to integer IDs, on a corpus large enough to be split
+ * across threads.
+ */
+TEST_CASE("BLEUIntegerTokensTest", "[MetricTest]")
+{
+  typedef typename std::vector<std::string> WordVector;
+  typedef typename std::vector<size_t> IDVector;
+  std::vector<std::vector<WordVector>> referenceCorpus;
+  std::vector<WordVector> translationCorpus;
+  std::vector<std::vector<IDVector>> referenceIDs;
+  std::vector<IDVector> translationIDs;
+
+  const std::vector<std::string> words = {"a", "b", "c", "d", "e", "f"};
+  for (size_t s = 0; s < 2000; ++s)
+  {
+    referenceCorpus.push_back(std::vector<WordVector>());
+    referenceIDs.push_back(std::vector<IDVector>());
+    const size_t numReferences = 1 + mlpack::math::RandInt(3);
+    for (size_t r = 0; r < numReferences + 1; ++r)
+    {
+      WordVector sentence;
+      IDVector ids;
+      const size_t length = mlpack::math::RandInt(12);
+      for (size_t i = 0; i < length; ++i)
+      {
+        ids.push_back(mlpack::math::RandInt(words.size()));
+        sentence.push_back(words[ids.back()]);
+      }
+
+      // The last sentence is the translation.
+      if (r < numReferences)
+      {
+        referenceCorpus.back().push_back(sentence);
+        referenceIDs.back().push_back(ids);
+      }
+      else
+      {
+        translationCorpus.push_back(sentence);
+        translationIDs.push_back(ids);
+      }
+    }
+  }
+
+  for (size_t smooth = 0; smooth < 2; ++smooth)
+  {
+    BLEU<double> bleu(4), idBLEU(4);
+    bleu.Evaluate(referenceCorpus, translationCorpus, smooth == 1);
+    idBLEU.Evaluate(referenceIDs, translationIDs, smooth == 1);
+
+    REQUIRE(bleu.BLEUScore() > 0.0);
+    REQUIRE(idBLEU.BLEUScore() == Approx(bleu.BLEUScore()).epsilon(1e-10));
+    REQUIRE(idBLEU.TranslationLength() == bleu.TranslationLength());
+    REQUIRE(idBLEU.ReferenceLength() == bleu.ReferenceLength());
+    for (size_t i = 0; i < bleu.Precisions().size(); ++i)
+    {
+      REQUIRE(idBLEU.Precisions()[i] ==
+          Approx(bleu.Precisions()[i]).epsilon(1e-10));
+    }
+  }
+}
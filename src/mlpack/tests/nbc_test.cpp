@@ -398,3 +398,106 @@ TEST_CASE("NaiveBayesClassifierHighDimensionsTest", "[NBCTest]")
   for (size_t i = 0; i < calcVec.n_cols; ++i)
     REQUIRE(calcVec(i) == testLabels(i));
 }
+
+/**
+ * Ensure that training incrementally on chunks gives the same model as
+ * training on all of the data at once.
+ */
+TEST_CASE("NaiveBayesClassifierChunkedTrainTest", "[NBCTest]")
+{
+  const char* trainFilename = "trainSet.csv";
+  size_t classes = 2;
+
+  arma::mat trainData;
+  if (!data::Load(trainFilename, trainData))
+    FAIL("Cannot load dataset");
+
+  // Get the labels out.
+  arma::Row<size_t> labels(trainData.n_cols);
+  for (size_t i = 0; i < trainData.n_cols; ++i)
+    labels[i] = trainData(trainData.n_rows - 1, i);
+  trainData.shed_row(trainData.n_rows - 1);
+
+  NaiveBayesClassifier<> nbc(trainData, labels, classes);
+  NaiveBayesClassifier<> nbcChunks(trainData.n_rows, classes);
+  const size_t chunkSize = 7;
+  for (size_t i = 0; i < trainData.n_cols; i += chunkSize)
+  {
+    const size_t last = std::min(i + chunkSize, (size_t) trainData.n_cols) - 1;
+    nbcChunks.Train(trainData.cols(i, last), labels.cols(i, last), classes);
+  }
+
+  for (size_t i = 0; i < nbc.Means().n_elem; ++i)
+  {
+    REQUIRE(nbcChunks.Means()[i] ==
+        Approx(nbc.Means()[i]).epsilon(1e-7).margin(1e-10));
+    REQUIRE(nbcChunks.Variances()[i] ==
+        Approx(nbc.Variances()[i]).epsilon(1e-7).margin(1e-10));
+  }
+
+  for (size_t i = 0; i < nbc.Probabilities().n_elem; ++i)
+  {
+    REQUIRE(nbcChunks.Probabilities()[i] ==
+        Approx(nbc.Probabilities()[i]).epsilon(1e-7));
+  }
+}
+
+/**
+ * Make sure that categorical dimensions are modeled with lookup tables, and
+ * that they can be learned incrementally.
+ */
+TEST_CASE("NaiveBayesClassifierCategoricalTest", "[NBCTest]")
+{
+  // The first dimension is categorical with three categories; the class is
+  // determined by it.  The second dimension is numeric noise.
+  const size_t points = 600;
+  arma::mat dataset(2, points);
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; ++i)
+  {
+    const size_t category = i % 3;
+    dataset(0, i) = category;
+    dataset(1, i) = math::Random();
+    labels[i] = (category == 2) ? 1 : 0;
+  }
+
+  data::DatasetInfo info(2);
+  info.Type(0) = data::Datatype::categorical;
+  info.MapString<double>("a", 0);
+  info.MapString<double>("b", 0);
+  info.MapString<double>("c", 0);
+
+  NaiveBayesClassifier<> nbc(dataset, info, labels, 2);
+
+  REQUIRE(nbc.NumCategories()[0] == 3);
+  REQUIRE(nbc.NumCategories()[1] == 0);
+  REQUIRE(nbc.LogCategoryProbabilities().n_rows == 2);
+  REQUIRE(nbc.LogCategoryProbabilities().n_cols == 3);
+
+  // Class 1 has 200 points, all in category 2; with add-one smoothing that
+  // gives (200 + 1) / (200 + 3).
+  REQUIRE(nbc.LogCategoryProbabilities()(1, 2) ==
+      Approx(std::log(201.0 / 203.0)).epsilon(1e-7));
+  REQUIRE(nbc.LogCategoryProbabilities()(1, 0) ==
+      Approx(std::log(1.0 / 203.0)).epsilon(1e-7));
+
+  arma::Row<size_t> predictions;
+  nbc.Classify(dataset, predictions);
+  REQUIRE(arma::accu(predictions != labels) == 0);
+
+  // Now train the same model in two chunks.
+  NaiveBayesClassifier<> nbcChunks(dataset.cols(0, 299), info,
+      labels.cols(0, 299), 2);
+  nbcChunks.Train(dataset.cols(300, points - 1), labels.cols(300, points - 1),
+      2);
+
+  for (size_t i = 0; i < nbc.LogCategoryProbabilities().n_elem; ++i)
+  {
+    REQUIRE(nbcChunks.LogCategoryProbabilities()[i] ==
+        Approx(nbc.LogCategoryProbabilities()[i]).epsilon(1e-7));
+  }
+
+  arma::Row<size_t> chunkPredictions;
+  nbcChunks.Classify(dataset, chunkPredictions);
+  REQUIRE(arma::accu(chunkPredictions != labels) == 0);
+}
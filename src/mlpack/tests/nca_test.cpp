@@ -246,6 +246,80 @@ TEST_CASE("SoftmaxSeparableGradient", "[NCATesT]")
   REQUIRE(gradient(1, 1) == Approx(-2.0 * -0.1435886).epsilon(0.0001));
 }
 
+/**
+ * A batch holding the whole dataset should give the same objective and
+ * gradient as the non-separable functions, and the sum of the objectives and
+ * gradients of single points.
+ */
+TEST_CASE("SoftmaxBatchConsistency", "[NCATesT]")
+{
+  arma::mat data(3, 300, arma::fill::randu);
+  arma::Row<size_t> labels(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    labels[i] = (data(0, i) + 0.2 * data(2, i) > 0.6) ? 1 : 0;
+
+  SoftmaxErrorFunction<SquaredEuclideanDistance> sef(data, labels);
+  arma::mat coordinates(3, 3, arma::fill::randn);
+
+  arma::mat fullGradient, batchGradient;
+  const double fullObjective = sef.EvaluateWithGradient(coordinates,
+      fullGradient);
+  const double batchObjective = sef.EvaluateWithGradient(coordinates, 0,
+      batchGradient, data.n_cols);
+
+  REQUIRE(batchObjective == Approx(fullObjective).epsilon(1e-10));
+  REQUIRE(sef.Evaluate(coordinates) == Approx(fullObjective).epsilon(1e-10));
+  REQUIRE(arma::norm(batchGradient - fullGradient) <=
+      1e-10 * arma::norm(fullGradient));
+
+  double objectiveSum = 0.0;
+  arma::mat gradientSum(3, 3, arma::fill::zeros);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    arma::mat gradient;
+    objectiveSum += sef.Evaluate(coordinates, i, 1);
+    sef.Gradient(coordinates, i, gradient, 1);
+    gradientSum += gradient;
+  }
+
+  REQUIRE(objectiveSum == Approx(fullObjective).epsilon(1e-8));
+  REQUIRE(arma::norm(gradientSum - fullGradient) <=
+      1e-8 * arma::norm(fullGradient));
+}
+
+/**
+ * Restricting the softmax to many nearest neighbors should barely change the
+ * objective and the gradient, since the other points contribute almost
+ * nothing.
+ */
+TEST_CASE("SoftmaxNearestNeighborsApproximation", "[NCATesT]")
+{
+  arma::mat data(2, 500, arma::fill::randu);
+  data *= 20.0;
+  arma::Row<size_t> labels(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    labels[i] = (data(0, i) > 10.0) ? 1 : 0;
+
+  SoftmaxErrorFunction<SquaredEuclideanDistance> sef(data, labels);
+  arma::mat coordinates = arma::eye<arma::mat>(2, 2);
+
+  arma::mat exactGradient, approxGradient;
+  const double exactObjective = sef.EvaluateWithGradient(coordinates,
+      exactGradient);
+
+  sef.NumNeighbors() = 100;
+  const double approxObjective = sef.EvaluateWithGradient(coordinates,
+      approxGradient);
+
+  REQUIRE(approxObjective == Approx(exactObjective).epsilon(1e-6));
+  REQUIRE(arma::norm(approxGradient - exactGradient) <=
+      1e-5 * arma::norm(exactGradient));
+
+  // Asking for more neighbors than there are points uses all of them.
+  sef.NumNeighbors() = data.n_cols;
+  REQUIRE(sef.Evaluate(coordinates) == Approx(exactObjective).epsilon(1e-12));
+}
+
 //
 // Tests for the NCA algorithm.
 //
@@ -16,6 +16,8 @@
 #include <mlpack/methods/amf/update_rules/nmf_mult_div.hpp>
 #include <mlpack/methods/amf/update_rules/nmf_als.hpp>
 #include <mlpack/methods/amf/update_rules/nmf_mult_dist.hpp>
+#include <mlpack/methods/amf/update_rules/parallel_als.hpp>
+#include <mlpack/methods/amf/termination_policies/max_iteration_termination.hpp>
 
 #include "catch.hpp"
 
@@ -301,3 +303,51 @@ TEST_CASE("NonNegNMFALSTest", "[NMFTest]")
   REQUIRE((arma::all(arma::vectorise(w) >= 0)
       && arma::all(arma::vectorise(h) >= 0)));
 }
+
+/**
+ * Check that the parallel ALS update rule fits the observed entries of a
+ * sparse low-rank matrix, and that a dense input with the same nonzero entries
+ * gives the same factorization.
+ */
+TEST_CASE("ParallelALSObservedEntriesTest", "[NMFTest]")
+{
+  const mat w = randu<mat>(40, 3) + 0.5;
+  const mat h = randu<mat>(3, 30) + 0.5;
+  const mat full = w * h;
+
+  // Observe about half of the entries, and every diagonal entry so that no row
+  // or column is empty.
+  sp_mat v(40, 30);
+  for (size_t j = 0; j < 30; ++j)
+    for (size_t i = 0; i < 40; ++i)
+      if (i == j || math::Random() < 0.5)
+        v(i, j) = full(i, j);
+  const mat dv(v);
+
+  mat iw, ih;
+  RandomInitialization::Initialize(v, 3, iw, ih);
+
+  AMF<MaxIterationTermination, GivenInitialization, ParallelALSUpdate> als(
+      MaxIterationTermination(100), GivenInitialization(iw, ih),
+      ParallelALSUpdate(1e-6));
+  mat sw, sh, dw, dh;
+  als.Apply(v, 3, sw, sh);
+  als.Apply(dv, 3, dw, dh);
+
+  const mat sp = sw * sh;
+  double error = 0.0, norm = 0.0;
+  for (sp_mat::const_iterator it = v.begin(); it != v.end(); ++it)
+  {
+    error += std::pow(sp(it.row(), it.col()) - (*it), 2.0);
+    norm += std::pow(*it, 2.0);
+  }
+  REQUIRE(std::sqrt(error / norm) == Approx(0.0).margin(0.01));
+
+  // The missing entries are not fitted as zeros, so the low-rank matrix is
+  // recovered.
+  REQUIRE(arma::norm(sp - full, "fro") / arma::norm(full, "fro") ==
+      Approx(0.0).margin(0.05));
+
+  REQUIRE(arma::norm(sp - dw * dh, "fro") / arma::norm(sp, "fro") ==
+      Approx(0.0).margin(1e-8));
+}
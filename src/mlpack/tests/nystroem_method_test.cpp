@@ -18,9 +18,15 @@
 #include <mlpack/methods/nystroem_method/random_selection.hpp>
 #include <mlpack/methods/nystroem_method/kmeans_selection.hpp>
 #include <mlpack/methods/nystroem_method/nystroem_method.hpp>
+#include <mlpack/methods/nystroem_method/nystroem_features.hpp>
+#include <mlpack/methods/logistic_regression/logistic_regression.hpp>
+#include <mlpack/core/kernels/kernel_feature_model.hpp>
+#include <mlpack/core/kernels/random_fourier_features.hpp>
+#include "serialization.hpp"
 
 using namespace mlpack;
 using namespace mlpack::kernel;
+using namespace mlpack::regression;
 
 /**
  * Make sure that if the rank is the same and we do a full-rank approximation,
@@ -199,3 +205,100 @@ TEST_CASE("GermanTest", "[NystroemMethodTest]")
     REQUIRE(avgError == Approx(0.0).margin(results[trial]));
   }
 }
+
+/**
+ * With all the points as landmarks, the dot products of the Nystroem features
+ * of the training points are the exact kernel matrix.
+ */
+TEST_CASE("NystroemFeaturesFullRankTest", "[NystroemMethodTest]")
+{
+  arma::mat data;
+  data.randu(5, 100);
+
+  GaussianKernel gk;
+  NystroemFeatures<GaussianKernel, OrderedSelection> features(100, gk);
+  features.Train(data);
+
+  arma::mat mapped;
+  features.Transform(data, mapped);
+  REQUIRE(mapped.n_rows == 100);
+  REQUIRE(mapped.n_cols == 100);
+
+  arma::mat kernel;
+  KernelMatrix(data, gk, kernel);
+  const arma::mat approximation = mapped.t() * mapped;
+  for (size_t i = 0; i < kernel.n_elem; ++i)
+  {
+    if (kernel[i] < 1e-5)
+      REQUIRE(approximation[i] == Approx(0.0).margin(1e-4));
+    else
+      REQUIRE(kernel[i] == Approx(approximation[i]).epsilon(1e-5));
+  }
+
+  // More landmarks than points cannot be selected.
+  NystroemFeatures<GaussianKernel, OrderedSelection> tooMany(101, gk);
+  REQUIRE_THROWS_AS(tooMany.Train(data), std::invalid_argument);
+}
+
+/**
+ * Generate two concentric rings of points, which are not linearly separable:
+ * label 0 within radius 1 of the origin, label 1 between radius 2 and 3.
+ */
+static void GenerateRings(const size_t n,
+                          arma::mat& data,
+                          arma::Row<size_t>& labels)
+{
+  data.set_size(2, n);
+  labels.set_size(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    labels[i] = i % 2;
+    const double radius = (labels[i] == 0) ? math::Random() :
+        math::Random(2.0, 3.0);
+    const double angle = math::Random(0.0, 2.0 * M_PI);
+    data(0, i) = radius * std::cos(angle);
+    data(1, i) = radius * std::sin(angle);
+  }
+}
+
+/**
+ * Train logistic regression on Nystroem features and on random Fourier features
+ * of data that is not linearly separable, and make sure that the models
+ * classify new points well and survive serialization.
+ */
+TEST_CASE("KernelFeatureModelTest", "[NystroemMethodTest]")
+{
+  arma::mat data, testData;
+  arma::Row<size_t> labels, testLabels;
+  GenerateRings(1000, data, labels);
+  GenerateRings(500, testData, testLabels);
+
+  typedef KernelFeatureModel<NystroemFeatures<GaussianKernel, RandomSelection>,
+      LogisticRegression<>> NystroemModel;
+  NystroemModel nystroem(NystroemFeatures<GaussianKernel, RandomSelection>(
+      50, GaussianKernel(1.0)), LogisticRegression<>(0, 0.001));
+  nystroem.Train(data, labels);
+
+  arma::Row<size_t> predictions;
+  nystroem.Classify(testData, predictions);
+  REQUIRE(arma::accu(predictions == testLabels) >= 0.95 * testData.n_cols);
+
+  NystroemModel xmlNystroem, jsonNystroem, binaryNystroem;
+  SerializeObjectAll(nystroem, xmlNystroem, jsonNystroem, binaryNystroem);
+
+  arma::Row<size_t> xmlPredictions, jsonPredictions, binaryPredictions;
+  xmlNystroem.Classify(testData, xmlPredictions);
+  jsonNystroem.Classify(testData, jsonPredictions);
+  binaryNystroem.Classify(testData, binaryPredictions);
+  CheckMatrices(predictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+
+  typedef KernelFeatureModel<RandomFourierFeatures<GaussianKernel>,
+      LogisticRegression<>> FourierModel;
+  FourierModel fourier(RandomFourierFeatures<GaussianKernel>(500,
+      GaussianKernel(1.0)), LogisticRegression<>(0, 0.001));
+  fourier.Train(data, labels);
+
+  fourier.Classify(testData, predictions);
+  REQUIRE(arma::accu(predictions == testLabels) >= 0.95 * testData.n_cols);
+}
@@ -295,6 +295,41 @@ TEST_CASE("CopyConstructorTest", "[OctreeTest]")
   CheckSameNode(t, t2);
 }
 
+/**
+ * Build an octree large enough that its children are built in parallel, and
+ * make sure it does not depend on the number of threads.
+ */
+TEST_CASE("ParallelOctreeConstructionTest", "[OctreeTest]")
+{
+  arma::mat dataset(3, 40000, arma::fill::randu);
+
+  std::vector<size_t> oldFromNew;
+  Octree<> t(dataset, oldFromNew);
+
+  for (size_t i = 0; i < oldFromNew.size(); ++i)
+  {
+    REQUIRE(arma::norm(dataset.col(oldFromNew[i]) - t.Dataset().col(i)) ==
+        Approx(0.0).margin(1e-12));
+  }
+  CheckOverlap(t);
+  CheckFurthestDistances(t);
+
+  #ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  std::vector<size_t> sequentialOldFromNew;
+  Octree<> t2(dataset, sequentialOldFromNew);
+
+  #ifdef HAS_OPENMP
+  omp_set_num_threads(numThreads);
+  #endif
+
+  REQUIRE(oldFromNew == sequentialOldFromNew);
+  CheckSameNode(t, t2);
+}
+
 /**
  * Test the move constructor.
  */
@@ -346,3 +381,151 @@ TEST_CASE("OctreeSerializationTest", "[OctreeTest]")
   delete binaryTree;
   delete jsonTree;
 }
+
+/**
+ * Check the results of a MortonOctree radius search against a brute-force
+ * search.  Points within the tolerance of the radius may or may not be found,
+ * since the tree computes distances in its own precision.
+ */
+template<size_t Dimensionality, typename ElemType>
+void CheckMortonOctreeRadiusSearch(const arma::mat& data,
+                                   const arma::mat& queries,
+                                   const double radius,
+                                   const size_t maxLeafSize)
+{
+  MortonOctree<Dimensionality, ElemType> tree(data, maxLeafSize);
+
+  arma::Col<size_t> offsets, neighbors, offsetsNoDistances,
+      neighborsNoDistances;
+  arma::Col<ElemType> distances;
+  tree.RadiusSearch(queries, radius, offsets, neighbors, distances);
+  tree.RadiusSearch(queries, radius, offsetsNoDistances, neighborsNoDistances);
+
+  REQUIRE(offsets.n_elem == queries.n_cols + 1);
+  REQUIRE(offsets[queries.n_cols] == neighbors.n_elem);
+  REQUIRE(distances.n_elem == neighbors.n_elem);
+  REQUIRE(offsetsNoDistances.n_elem == queries.n_cols + 1);
+
+  const double tolerance = 1e-4;
+  for (size_t q = 0; q < queries.n_cols; ++q)
+  {
+    std::vector<bool> found(data.n_cols, false);
+    for (size_t i = offsets[q]; i < offsets[q + 1]; ++i)
+    {
+      // Each neighbor is reported once, at the right distance.
+      REQUIRE(!found[neighbors[i]]);
+      found[neighbors[i]] = true;
+
+      const double distance = arma::norm(data.col(neighbors[i]) -
+          queries.col(q));
+      REQUIRE(distance <= radius + tolerance);
+      REQUIRE(distances[i] == Approx(distance).margin(tolerance));
+    }
+
+    std::vector<bool> foundNoDistances(data.n_cols, false);
+    for (size_t i = offsetsNoDistances[q]; i < offsetsNoDistances[q + 1]; ++i)
+    {
+      REQUIRE(!foundNoDistances[neighborsNoDistances[i]]);
+      foundNoDistances[neighborsNoDistances[i]] = true;
+    }
+
+    for (size_t p = 0; p < data.n_cols; ++p)
+    {
+      const double distance = arma::norm(data.col(p) - queries.col(q));
+      if (distance < radius - tolerance)
+      {
+        REQUIRE(found[p]);
+        REQUIRE(foundNoDistances[p]);
+      }
+      else if (distance > radius + tolerance)
+      {
+        REQUIRE(!foundNoDistances[p]);
+      }
+    }
+  }
+}
+
+/**
+ * Make sure the Morton-ordered octree holds every point once, in Morton order,
+ * and that its nodes bound their points.
+ */
+TEST_CASE("MortonOctreeStructureTest", "[OctreeTest]")
+{
+  arma::mat dataset(3, 3000, arma::fill::randu);
+  MortonOctree<> tree(dataset, 20);
+
+  REQUIRE(tree.Points().n_rows == dataset.n_cols);
+  REQUIRE(tree.Points().n_cols == 3);
+
+  arma::Col<size_t> sorted = arma::sort(tree.OldFromNew());
+  for (size_t i = 0; i < sorted.n_elem; ++i)
+    REQUIRE(sorted[i] == i);
+
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    for (size_t d = 0; d < 3; ++d)
+      REQUIRE(tree.Points()(i, d) ==
+          Approx(float(dataset(d, tree.OldFromNew()[i]))).epsilon(1e-7));
+
+  const std::vector<MortonOctree<>::Node>& nodes = tree.Nodes();
+  REQUIRE(nodes[0].begin == 0);
+  REQUIRE(nodes[0].count == dataset.n_cols);
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    const MortonOctree<>::Node& node = nodes[i];
+    if (node.numChildren == 0)
+    {
+      REQUIRE(node.count <= 20);
+    }
+    else
+    {
+      // The children partition the points of the node.
+      REQUIRE(node.numChildren <= 8);
+      REQUIRE(nodes[node.firstChild].begin == node.begin);
+      size_t count = 0;
+      for (size_t c = 0; c < node.numChildren; ++c)
+      {
+        REQUIRE(nodes[node.firstChild + c].begin == node.begin + count);
+        count += nodes[node.firstChild + c].count;
+      }
+      REQUIRE(count == node.count);
+    }
+
+    for (size_t p = node.begin; p < node.begin + node.count; ++p)
+    {
+      for (size_t d = 0; d < 3; ++d)
+      {
+        REQUIRE(tree.Points()(p, d) >= node.lo[d]);
+        REQUIRE(tree.Points()(p, d) <= node.hi[d]);
+      }
+    }
+  }
+
+  REQUIRE_THROWS_AS(MortonOctree<>(arma::mat(2, 10, arma::fill::randu)),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure batched radius queries on a Morton-ordered octree find the same
+ * points as a brute-force search.
+ */
+TEST_CASE("MortonOctreeRadiusSearchTest", "[OctreeTest]")
+{
+  arma::mat dataset(3, 2000, arma::fill::randu);
+  arma::mat queries(3, 300, arma::fill::randu);
+  // Some queries are outside the bounding box of the data.
+  queries.cols(0, 49) *= 1.5;
+
+  CheckMortonOctreeRadiusSearch<3, float>(dataset, queries, 0.15, 16);
+  CheckMortonOctreeRadiusSearch<3, double>(dataset, queries, 0.3, 1);
+  CheckMortonOctreeRadiusSearch<3, float>(dataset, queries, 2.0, 64);
+
+  // A 2-dimensional quadtree.
+  arma::mat dataset2(2, 1000, arma::fill::randu);
+  arma::mat queries2(2, 100, arma::fill::randu);
+  CheckMortonOctreeRadiusSearch<2, double>(dataset2, queries2, 0.1, 8);
+
+  // Duplicate points can't be split, but are stored in one leaf.
+  arma::mat duplicates(3, 200);
+  duplicates.each_col() = arma::vec("0.5 0.5 0.5");
+  CheckMortonOctreeRadiusSearch<3, float>(duplicates, queries, 0.2, 4);
+}
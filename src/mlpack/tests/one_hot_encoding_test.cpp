@@ -230,3 +230,66 @@ TEST_CASE("OneHotEncodingDatasetinfoTest", "[OneHotEncodingTest]")
 
   remove("test.csv");
 }
+
+/**
+ * Make sure that the sparse output gives the same encoding as the dense
+ * output.
+ */
+TEST_CASE("OneHotEncodingSparseOutputTest", "[OneHotEncodingTest]")
+{
+  arma::mat matrix = arma::randi<arma::mat>(5, 100, arma::distr_param(0, 7));
+  matrix.row(1).randu();
+  matrix(1, 3) = 0.0;
+  arma::Col<size_t> indices("0 2 4");
+
+  arma::mat output;
+  arma::sp_mat sparseOutput;
+  data::OneHotEncoding(matrix, indices, output);
+  data::OneHotEncoding(matrix, indices, sparseOutput);
+
+  REQUIRE(sparseOutput.n_rows == output.n_rows);
+  REQUIRE(sparseOutput.n_cols == output.n_cols);
+  CheckMatrices(output, arma::mat(sparseOutput));
+}
+
+/**
+ * Make sure that encoding chunks of points with a DatasetInfo gives the same
+ * result as encoding all points, with both the dense and the sparse output.
+ */
+TEST_CASE("OneHotEncodingDatasetInfoChunkTest", "[OneHotEncodingTest]")
+{
+  DatasetInfo info(3);
+  info.Type(1) = Datatype::categorical;
+  info.MapString<double>("a", 1);
+  info.MapString<double>("b", 1);
+  info.MapString<double>("c", 1);
+
+  arma::mat matrix = arma::randu<arma::mat>(3, 50);
+  // The first chunk does not contain the last category.
+  matrix.submat(1, 0, 1, 24) = arma::randi<arma::rowvec>(25,
+      arma::distr_param(0, 1));
+  matrix.submat(1, 25, 1, 49) = arma::randi<arma::rowvec>(25,
+      arma::distr_param(0, 2));
+
+  arma::mat output;
+  data::OneHotEncoding(matrix, output, info);
+  REQUIRE(output.n_rows == 5);
+  REQUIRE(output.n_cols == 50);
+
+  arma::mat firstChunk, secondChunk;
+  data::OneHotEncoding(arma::mat(matrix.cols(0, 24)), firstChunk, info);
+  data::OneHotEncoding(arma::mat(matrix.cols(25, 49)), secondChunk, info);
+  CheckMatrices(output, arma::join_rows(firstChunk, secondChunk));
+
+  arma::sp_mat sparseOutput;
+  data::OneHotEncoding(matrix, sparseOutput, info);
+  CheckMatrices(output, arma::mat(sparseOutput));
+
+  // A value which is not a mapped category is an error.
+  matrix(1, 10) = 3.0;
+  REQUIRE_THROWS_AS(data::OneHotEncoding(matrix, output, info),
+      std::invalid_argument);
+  matrix(1, 10) = 0.5;
+  REQUIRE_THROWS_AS(data::OneHotEncoding(matrix, sparseOutput, info),
+      std::invalid_argument);
+}
@@ -16,8 +16,10 @@
 #include <mlpack/methods/pca/decomposition_policies/quic_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/randomized_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/randomized_block_krylov_method.hpp>
+#include <mlpack/methods/pca/streaming_pca.hpp>
 
 #include "catch.hpp"
+#include "test_catch_tools.hpp"
 
 using namespace arma;
 using namespace mlpack;
@@ -336,3 +338,142 @@ TEST_CASE("PCAScalingTest", "[PCATest]")
   // The eigenvalues should sum to three.
   REQUIRE(accu(eigval) == Approx(3.0).epsilon(0.001));
 }
+
+/**
+ * Make sure that PCA gives the same results when the data is transformed in
+ * place, with and without scaling.
+ */
+TEST_CASE("PCAInPlaceTest", "[PCATest]")
+{
+  const arma::mat data = arma::randu<arma::mat>(4, 4) *
+      arma::randu<arma::mat>(4, 200);
+
+  for (size_t s = 0; s < 2; ++s)
+  {
+    PCA<> pca(s == 1);
+
+    arma::mat transformed, eigvec;
+    arma::vec eigVal;
+    pca.Apply(data, transformed, eigVal, eigvec);
+
+    arma::mat inPlace(data), inPlaceEigvec;
+    arma::vec inPlaceEigVal;
+    pca.Apply(inPlace, inPlace, inPlaceEigVal, inPlaceEigvec);
+
+    CheckMatrices(eigVal, inPlaceEigVal);
+    CheckMatrices(eigvec, inPlaceEigvec);
+    CheckMatrices(transformed, inPlace);
+  }
+}
+
+/**
+ * A loader that gives the columns of a matrix in chunks, and starts over after
+ * each pass.
+ */
+class ChunkLoader
+{
+ public:
+  ChunkLoader(const arma::mat& data, const size_t chunkSize) :
+      data(data), chunkSize(chunkSize), next(0) { }
+
+  bool operator()(arma::mat& chunk)
+  {
+    if (next == data.n_cols)
+    {
+      next = 0;
+      return false;
+    }
+
+    const size_t last = std::min(next + chunkSize, (size_t) data.n_cols);
+    chunk = data.cols(next, last - 1);
+    next = last;
+    return true;
+  }
+
+ private:
+  const arma::mat& data;
+  size_t chunkSize;
+  size_t next;
+};
+
+/**
+ * Make sure that the covariance method of StreamingPCA gives the same results
+ * as PCA on the whole dataset, with and without scaling.
+ */
+TEST_CASE("StreamingPCACovarianceTest", "[PCATest]")
+{
+  arma::mat data = arma::randu<arma::mat>(5, 5) *
+      arma::randn<arma::mat>(5, 1003) + 10.0;
+
+  for (size_t s = 0; s < 2; ++s)
+  {
+    const bool scaleData = (s == 1);
+
+    arma::mat transformed, eigvec;
+    arma::vec eigVal;
+    PCA<> pca(scaleData);
+    pca.Apply(data, transformed, eigVal, eigvec);
+
+    arma::mat streamingEigvec;
+    arma::vec streamingEigVal;
+    StreamingPCA<> streamingPCA(scaleData);
+    streamingPCA.Apply(ChunkLoader(data, 100), streamingEigVal,
+        streamingEigvec);
+
+    REQUIRE(streamingPCA.Count() == data.n_cols);
+    REQUIRE(streamingEigVal.n_elem == eigVal.n_elem);
+    for (size_t i = 0; i < eigVal.n_elem; ++i)
+      REQUIRE(streamingEigVal[i] == Approx(eigVal[i]).epsilon(1e-6));
+
+    // The components may only differ in sign, so the projections of the
+    // points may too.
+    arma::mat streamingTransformed;
+    streamingPCA.Transform(data, streamingTransformed);
+    for (size_t i = 0; i < eigVal.n_elem; ++i)
+    {
+      const double sign = (arma::dot(eigvec.col(i),
+          streamingEigvec.col(i)) < 0.0) ? -1.0 : 1.0;
+      for (size_t j = 0; j < data.n_cols; ++j)
+      {
+        REQUIRE(sign * streamingTransformed(i, j) ==
+            Approx(transformed(i, j)).margin(1e-6));
+      }
+    }
+  }
+}
+
+/**
+ * Make sure that the randomized method of StreamingPCA finds the leading
+ * components of nearly low-rank data.
+ */
+TEST_CASE("StreamingPCARandomizedTest", "[PCATest]")
+{
+  arma::mat data = arma::randn<arma::mat>(30, 3) *
+      arma::diagmat(arma::vec("10 5 2")) * arma::randn<arma::mat>(3, 2000) +
+      0.01 * arma::randn<arma::mat>(30, 2000);
+
+  arma::mat transformed, eigvec;
+  arma::vec eigVal;
+  PCA<> pca;
+  pca.Apply(data, transformed, eigVal, eigvec);
+
+  arma::mat streamingEigvec;
+  arma::vec streamingEigVal;
+  StreamingPCA<> streamingPCA;
+  streamingPCA.Apply(ChunkLoader(data, 300), 3, streamingEigVal,
+      streamingEigvec);
+
+  REQUIRE(streamingEigVal.n_elem == 3);
+  REQUIRE(streamingEigvec.n_rows == 30);
+  REQUIRE(streamingEigvec.n_cols == 3);
+  for (size_t i = 0; i < 3; ++i)
+  {
+    REQUIRE(streamingEigVal[i] == Approx(eigVal[i]).epsilon(1e-4));
+    REQUIRE(std::abs(arma::dot(eigvec.col(i), streamingEigvec.col(i))) ==
+        Approx(1.0).epsilon(1e-4));
+  }
+
+  // An invalid rank should throw.
+  REQUIRE_THROWS_AS(streamingPCA.Apply(ChunkLoader(data, 300), 31,
+      streamingEigVal, streamingEigvec), std::invalid_argument);
+}
@@ -245,3 +245,129 @@ TEST_CASE("SecondaryConstructor", "[PerceptronTest]")
 
   Perceptron<> p2(p1);
 }
+
+/**
+ * Make sure that the batch update of SimpleWeightUpdate is the same as the
+ * updates of each misclassified point.
+ */
+TEST_CASE("SimpleWeightUpdateBatch", "[PerceptronTest]")
+{
+  SimpleWeightUpdate wip;
+
+  mat points(5, 4, fill::randu);
+  mat weights(5, 3, fill::randu);
+  vec biases(3, fill::randu);
+  Row<size_t> predictedClasses = { 0, 1, 2, 1 };
+  Row<size_t> correctClasses = { 2, 1, 0, 0 };
+  rowvec instanceWeights = { 0.5, 2.0, 1.0, 3.0 };
+
+  mat pointWeights(weights);
+  vec pointBiases(biases);
+  for (size_t i = 0; i < points.n_cols; ++i)
+  {
+    if (predictedClasses[i] != correctClasses[i])
+    {
+      wip.UpdateWeights(points.col(i), pointWeights, pointBiases,
+          predictedClasses[i], correctClasses[i], instanceWeights[i]);
+    }
+  }
+
+  wip.UpdateWeights(points, weights, biases, predictedClasses, correctClasses,
+      instanceWeights);
+
+  for (size_t i = 0; i < weights.n_elem; ++i)
+    REQUIRE(weights[i] == Approx(pointWeights[i]).epsilon(1e-10));
+  for (size_t i = 0; i < biases.n_elem; ++i)
+    REQUIRE(biases[i] == Approx(pointBiases[i]).epsilon(1e-10));
+}
+
+/**
+ * This tests the convergence of mini-batch training on a set of linearly
+ * separable data with 3 classes.
+ */
+TEST_CASE("MiniBatchRandom3", "[PerceptronTest]")
+{
+  mat trainData;
+  trainData = { { 0, 1, 1, 4, 5, 4, 1, 2, 1 },
+                { 1, 0, 1, 1, 1, 2, 4, 5, 4 } };
+
+  Mat<size_t> labels;
+  labels = { 0, 0, 0, 1, 1, 1, 2, 2, 2 };
+
+  Perceptron<> p(3, 2, 1000);
+  p.BatchSize() = 4;
+  p.Train(trainData, labels.row(0), 3);
+
+  Row<size_t> predictedLabels;
+  p.Classify(trainData, predictedLabels);
+
+  for (size_t i = 0; i < predictedLabels.n_cols; ++i)
+    CHECK(predictedLabels(0, i) == labels(0, i));
+
+  p.BatchSize() = 0;
+  REQUIRE_THROWS_AS(p.Train(trainData, labels.row(0), 3),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that the lazy averaged perceptron gives the average of the weights
+ * after each point, for single points and for mini-batches.
+ */
+TEST_CASE("AveragedPerceptron", "[PerceptronTest]")
+{
+  mat trainData;
+  trainData = { { 1, 2, 3, 4, 5, 6, 7, 8, 1, 2, 3, 4, 5, 6, 7, 8 },
+                { 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2 } };
+
+  Row<size_t> labels;
+  labels = { 0, 0, 0, 1, 0, 1, 1, 1, 0, 0, 0, 1, 0, 1, 1, 1 };
+
+  // The data is not linearly separable, so all the iterations are done.
+  const size_t iterations = 5;
+  for (const size_t batchSize : { 1, 3 })
+  {
+    Perceptron<> p(2, 2, iterations);
+    p.BatchSize() = batchSize;
+    p.Average() = true;
+    p.Train(trainData, labels, 2);
+
+    // Compute the average directly.  Inside a block, the weights after each
+    // point are the weights before the block, except after the last point.
+    SimpleWeightUpdate wip;
+    mat weights(2, 2, fill::zeros), sumWeights(2, 2, fill::zeros);
+    vec biases(2, fill::zeros), sumBiases(2, fill::zeros);
+    size_t steps = 0;
+    for (size_t it = 0; it < iterations; ++it)
+    {
+      for (size_t begin = 0; begin < trainData.n_cols; begin += batchSize)
+      {
+        const size_t end = std::min(begin + batchSize,
+            (size_t) trainData.n_cols);
+        mat scores = weights.t() * trainData.cols(begin, end - 1);
+        scores.each_col() += biases;
+        const Row<size_t> predictions =
+            conv_to<Row<size_t>>::from(index_max(scores, 0));
+
+        sumWeights += (end - begin - 1) * weights;
+        sumBiases += (end - begin - 1) * biases;
+        wip.UpdateWeights(trainData.cols(begin, end - 1), weights, biases,
+            predictions, Row<size_t>(labels.subvec(begin, end - 1)),
+            rowvec(end - begin, fill::ones));
+        sumWeights += weights;
+        sumBiases += biases;
+        steps += end - begin;
+      }
+    }
+
+    for (size_t i = 0; i < sumWeights.n_elem; ++i)
+    {
+      REQUIRE(p.Weights()[i] ==
+          Approx(sumWeights[i] / steps).epsilon(1e-10).margin(1e-10));
+    }
+    for (size_t i = 0; i < sumBiases.n_elem; ++i)
+    {
+      REQUIRE(p.Biases()[i] ==
+          Approx(sumBiases[i] / steps).epsilon(1e-10).margin(1e-10));
+    }
+  }
+}
@@ -123,6 +123,67 @@ TEST_CASE("CartPoleWithDQN", "[QLearningTest]")
   REQUIRE(converged);
 }
 
+//! Test DQN in Cart Pole task with several environments stepped in lockstep.
+TEST_CASE("CartPoleWithVectorizedDQN", "[QLearningTest]")
+{
+  // Set up the network.
+  SimpleDQN<> network(4, 128, 128, 2);
+
+  // Set up the policy and replay method.
+  GreedyPolicy<CartPole> policy(1.0, 1000, 0.1, 0.99);
+  RandomReplay<CartPole> replayMethod(10, 10000);
+
+  // Setting all training hyperparameters.
+  TrainingConfig config;
+  config.StepSize() = 0.01;
+  config.Discount() = 0.9;
+  config.TargetNetworkSyncInterval() = 100;
+  config.ExplorationSteps() = 100;
+  config.DoubleQLearning() = false;
+  config.StepLimit() = 200;
+
+  // Set up DQN agent.
+  QLearning<CartPole, decltype(network), AdamUpdate, decltype(policy)>
+      agent(config, network, policy, replayMethod);
+
+  bool converged = false;
+  for (size_t trial = 0; trial < 50; ++trial)
+  {
+    const std::vector<double> returns = agent.VectorizedEpisodes(4, 20);
+    REQUIRE(returns.size() == 20);
+
+    const double averageReturn = std::accumulate(returns.begin(),
+        returns.end(), 0.0) / returns.size();
+    Log::Debug << "Average return in last " << returns.size()
+        << " episodes: " << averageReturn << std::endl;
+
+    if (averageReturn > 40)
+    {
+      converged = true;
+      break;
+    }
+  }
+
+  REQUIRE(converged);
+
+  // The batched action selection must agree with the single-state one.
+  agent.Deterministic() = true;
+  CartPole env;
+  std::vector<CartPole::State> states;
+  for (size_t i = 0; i < 10; ++i)
+    states.push_back(env.InitialSample());
+
+  std::vector<CartPole::Action> actions;
+  agent.SelectActions(states, actions);
+  REQUIRE(actions.size() == states.size());
+  for (size_t i = 0; i < states.size(); ++i)
+  {
+    agent.State() = states[i];
+    agent.SelectAction();
+    REQUIRE(agent.Action().action == actions[i].action);
+  }
+}
+
 //! Test DQN in Cart Pole task with Prioritized Replay.
 TEST_CASE("CartPoleWithDQNPrioritizedReplay", "[QLearningTest]")
 {
@@ -504,6 +565,61 @@ TEST_CASE("CartPoleWithCategoricalDQN", "[QLearningTest]")
   REQUIRE(converged);
 }
 
+//! Check the categorical projection against a direct computation.
+TEST_CASE("CategoricalProjectionTest", "[QLearningTest]")
+{
+  const size_t atomSize = 11;
+  const size_t batchSize = 20;
+  const double vMin = -5.0, vMax = 5.0, discount = 0.9;
+  const double deltaZ = (vMax - vMin) / (atomSize - 1);
+
+  arma::mat nextDist(atomSize, batchSize, arma::fill::randu);
+  nextDist.each_row() /= arma::sum(nextDist);
+  arma::rowvec rewards(batchSize, arma::fill::randn);
+  rewards *= 3.0;
+  // Rewards that land exactly on atoms, and beyond the support.
+  rewards[0] = 1.0;
+  rewards[1] = 20.0;
+  rewards[2] = -20.0;
+  arma::irowvec isTerminal = arma::randi<arma::irowvec>(batchSize,
+      arma::distr_param(0, 1));
+  isTerminal[0] = 1;
+
+  arma::mat positions, projDist;
+  CategoricalProjection(nextDist, rewards, isTerminal, discount, vMin, vMax,
+      positions, projDist);
+
+  REQUIRE(projDist.n_rows == atomSize);
+  REQUIRE(projDist.n_cols == batchSize);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    // No mass may be lost.
+    REQUIRE(arma::accu(projDist.col(i)) == Approx(1.0).epsilon(1e-10));
+
+    arma::vec expected(atomSize, arma::fill::zeros);
+    for (size_t j = 0; j < atomSize; ++j)
+    {
+      const double z = vMin + j * deltaZ;
+      double tZ = rewards[i] + discount * (1 - isTerminal[i]) * z;
+      tZ = std::min(vMax, std::max(vMin, tZ));
+      const double b = (tZ - vMin) / deltaZ;
+      const size_t l = (size_t) std::floor(b + 1e-9);
+      const double frac = std::max(0.0, b - l);
+      expected[l] += nextDist(j, i) * (1.0 - frac);
+      if (l + 1 < atomSize)
+        expected[l + 1] += nextDist(j, i) * frac;
+    }
+
+    for (size_t j = 0; j < atomSize; ++j)
+      REQUIRE(projDist(j, i) == Approx(expected[j]).margin(1e-8));
+  }
+
+  // A terminal reward on an atom puts all of the mass there.
+  REQUIRE(projDist(6, 0) == Approx(1.0));
+  REQUIRE(projDist(atomSize - 1, 1) == Approx(1.0));
+  REQUIRE(projDist(0, 2) == Approx(1.0));
+}
+
 //! Test SAC on Pendulum task.
 TEST_CASE("PendulumWithSAC", "[QLearningTest]")
 {
@@ -591,3 +707,109 @@ TEST_CASE("SACForMultipleActions", "[QLearningTest]")
   // If the agent is able to reach till this point of the test, it is assured
   // that the agent can handle multiple actions in continuous space.
 }
+
+/**
+ * Make sure that the batched SAC actor update gives the same policy gradient as
+ * a separate forward and backward pass through the policy and the smaller
+ * critic for each sampled state.
+ */
+TEST_CASE("SACBatchedPolicyGradientTest", "[QLearningTest]")
+{
+  const size_t stateSize = 3;
+  const size_t actionSize = 2;
+  const size_t hidden = 8;
+  ContinuousActionEnv::State::dimension = stateSize;
+  ContinuousActionEnv::Action::size = actionSize;
+
+  FFN<EmptyLoss<>, GaussianInitialization>
+      policyNetwork(EmptyLoss<>(), GaussianInitialization(0, 0.1));
+  policyNetwork.Add(new Linear<>(stateSize, hidden));
+  policyNetwork.Add(new ReLULayer<>());
+  policyNetwork.Add(new Linear<>(hidden, actionSize));
+  policyNetwork.Add(new TanHLayer<>());
+
+  FFN<EmptyLoss<>, GaussianInitialization>
+      qNetwork(EmptyLoss<>(), GaussianInitialization(0, 0.1));
+  qNetwork.Add(new Linear<>(stateSize + actionSize, hidden));
+  qNetwork.Add(new ReLULayer<>());
+  qNetwork.Add(new Linear<>(hidden, 1));
+
+  RandomReplay<ContinuousActionEnv> replayMethod(16, 100);
+  for (size_t i = 0; i < 32; ++i)
+  {
+    ContinuousActionEnv::State state(arma::randu<arma::colvec>(stateSize));
+    ContinuousActionEnv::State nextState(arma::randu<arma::colvec>(stateSize));
+    ContinuousActionEnv::Action action;
+    for (size_t j = 0; j < actionSize; ++j)
+      action.action[j] = math::Random(-1.0, 1.0);
+    replayMethod.Store(state, action, math::Random(), nextState, false, 0.99);
+  }
+
+  TrainingConfig config;
+  config.StepSize() = 0.01;
+  config.TargetNetworkSyncInterval() = 1;
+
+  // With vanilla updates, the change of the policy parameters is the step size
+  // times the policy gradient.
+  SAC<ContinuousActionEnv, decltype(qNetwork), decltype(policyNetwork),
+      VanillaUpdate>
+      agent(config, qNetwork, policyNetwork, replayMethod);
+  const arma::mat policyParameters = policyNetwork.Parameters();
+
+  // Update() samples the same batch as this call, since the seed is the same.
+  arma::mat sampledStates, sampledNextStates;
+  std::vector<ContinuousActionEnv::Action> sampledActions;
+  arma::rowvec sampledRewards;
+  arma::irowvec isTerminal;
+  math::RandomSeed(42);
+  replayMethod.Sample(sampledStates, sampledActions, sampledRewards,
+      sampledNextStates, isTerminal);
+  math::RandomSeed(42);
+  agent.Update();
+  const arma::mat updatedParameters = policyNetwork.Parameters();
+
+  // Compute the policy gradient one state at a time, with the updated critics
+  // and the original policy.
+  policyNetwork.Parameters() = policyParameters;
+  arma::mat pi, q1, q2;
+  policyNetwork.Predict(sampledStates, pi);
+  const arma::mat qInput = arma::join_vert(pi, sampledStates);
+  qNetwork.Predict(qInput, q1);
+  agent.LearningQ2Network().Predict(qInput, q2);
+
+  const arma::mat error = -arma::ones(1, 1);
+  arma::mat policyGradient(arma::size(policyParameters), arma::fill::zeros);
+  for (size_t i = 0; i < sampledStates.n_cols; ++i)
+  {
+    const arma::mat state = sampledStates.col(i);
+    arma::mat statePi;
+    policyNetwork.Forward(state, statePi);
+    const arma::mat input = arma::join_vert(statePi, state);
+
+    decltype(qNetwork)& critic = (q1(i) < q2(i)) ? qNetwork :
+        agent.LearningQ2Network();
+    arma::mat q, criticGradient;
+    critic.Forward(input, q);
+    critic.Backward(input, error, criticGradient);
+
+    // The gradient of the biases of the first layer is the gradient with
+    // respect to its output.
+    const arma::mat actionWeights = arma::reshape(critic.Parameters().rows(0,
+        hidden * actionSize - 1), hidden, actionSize);
+    const arma::mat biasGradient = criticGradient.rows(input.n_rows * hidden,
+        input.n_rows * hidden + hidden - 1);
+
+    arma::mat gradient;
+    policyNetwork.Backward(state, arma::mat(actionWeights.t() * biasGradient),
+        gradient);
+    policyGradient += gradient;
+  }
+  policyGradient /= sampledStates.n_cols;
+
+  REQUIRE(updatedParameters.n_elem == policyParameters.n_elem);
+  for (size_t i = 0; i < policyParameters.n_elem; ++i)
+  {
+    REQUIRE(updatedParameters[i] == Approx(policyParameters[i] -
+        config.StepSize() * policyGradient[i]).margin(1e-10));
+  }
+}
@@ -241,3 +241,38 @@ TEST_CASE("QDAFNSparseTest", "[QDAFNTest]")
   REQUIRE(distances.n_rows == 3);
   REQUIRE(distances.n_cols == 1000);
 }
+
+/**
+ * Make sure that each query point gets distinct neighbors, sorted by
+ * decreasing distance, and that the distances are correct.
+ */
+TEST_CASE("QDAFNDistinctNeighborsTest", "[QDAFNTest]")
+{
+  arma::mat refSet(4, 300, arma::fill::randu);
+  arma::mat querySet(4, 500, arma::fill::randu);
+
+  // Few tables, so the same points are at the top of several of them.
+  QDAFN<> qdafn(refSet, 3, 30);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  qdafn.Search(querySet, 5, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == 5);
+  REQUIRE(neighbors.n_cols == 500);
+
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    for (size_t j = 0; j < 5; ++j)
+    {
+      REQUIRE(neighbors(j, q) < refSet.n_cols);
+      REQUIRE(distances(j, q) == Approx(metric::EuclideanDistance::Evaluate(
+          querySet.col(q), refSet.col(neighbors(j, q)))).epsilon(1e-7));
+
+      if (j > 0)
+        REQUIRE(distances(j, q) <= distances(j - 1, q));
+      for (size_t i = 0; i < j; ++i)
+        REQUIRE(neighbors(i, q) != neighbors(j, q));
+    }
+  }
+}
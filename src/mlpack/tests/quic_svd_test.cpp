@@ -50,6 +50,38 @@ TEST_CASE("QUICSVDReconstructionError", "[QUICSVDTest]")
   REQUIRE(successes > 0);
 }
 
+/**
+ * The reconstruction error should still be small when several cosine tree
+ * nodes are split in each round.
+ */
+TEST_CASE("QUICSVDMultipleExpansionsReconstructionError", "[QUICSVDTest]")
+{
+  // Make a tall matrix of rank 5.
+  arma::mat dataset = arma::randu<arma::mat>(200, 5) *
+      arma::randu<arma::mat>(5, 40);
+
+  // As above, the Monte Carlo error calculation is random, so we require at
+  // least one success.
+  size_t successes = 0;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    arma::mat u, v, sigma;
+    svd::QUIC_SVD quicsvd(dataset, u, v, sigma, 0.03, 0.1, 4);
+
+    const double relativeError = arma::norm(dataset - u * sigma * v.t(),
+        "frob") / arma::norm(dataset, "frob");
+    if (relativeError < 1e-5)
+      ++successes;
+  }
+
+  REQUIRE(successes > 0);
+
+  // Splitting no nodes per round is not allowed.
+  arma::mat u, v, sigma;
+  REQUIRE_THROWS_AS(svd::QUIC_SVD(dataset, u, v, sigma, 0.03, 0.1, 0),
+      std::invalid_argument);
+}
+
 /**
  * The singular value error of the obtained SVD should be small.
  */
@@ -56,3 +56,34 @@ TEST_CASE("Radical_Test_Radical3D", "[RadicalTest]")
   // Larger tolerance is sometimes needed.
   REQUIRE(valBest == Approx(valEst).epsilon(0.02));
 }
+
+/**
+ * The unmixing matrix should map the data to the independent components, and
+ * the result should not depend on the number of threads.
+ */
+TEST_CASE("Radical_Test_UnmixingMatrix", "[RadicalTest]")
+{
+  mat matX;
+  if (!data::Load("data_3d_mixed.txt", matX))
+    FAIL("Cannot load dataset data_3d_mixed.txt");
+
+  Radical rad(0.175, 5, 100, matX.n_rows - 1);
+
+  mat matY, matW;
+  math::RandomSeed(7);
+  rad.DoRadical(matX, matY, matW);
+
+  REQUIRE(arma::approx_equal(matY, matW * matX, "absdiff", 1e-8));
+
+  #ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+
+  mat matY1, matW1;
+  math::RandomSeed(7);
+  rad.DoRadical(matX, matY1, matW1);
+  omp_set_num_threads(numThreads);
+
+  REQUIRE(arma::approx_equal(matW, matW1, "absdiff", 1e-10));
+  #endif
+}
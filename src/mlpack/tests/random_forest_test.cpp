@@ -15,9 +15,12 @@
 
 #include "serialization.hpp"
 #include "test_catch_tools.hpp"
+#include "thread_communicator.hpp"
 #include "catch.hpp"
 #include "mock_categorical_data.hpp"
 
+#include <thread>
+
 using namespace mlpack;
 using namespace mlpack::tree;
 
@@ -94,6 +97,45 @@ TEST_CASE("BootstrapWeightsTest", "[RandomForestTest]")
   }
 }
 
+/**
+ * Make sure a decision tree trained on a BootstrapView is the same as one
+ * trained on the bootstrapped copy of the dataset.
+ */
+TEST_CASE("BootstrapViewTest", "[RandomForestTest]")
+{
+  arma::mat dataset(3, 500, arma::fill::randu);
+  arma::Row<size_t> labels(500);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    labels[i] = (dataset(0, i) + dataset(2, i) > 1.0) ? 1 : 0;
+  arma::rowvec weights(500, arma::fill::randu);
+
+  arma::uvec indices;
+  arma::Row<size_t> bootstrapLabels;
+  arma::rowvec bootstrapWeights;
+  BootstrapIndices<true>(dataset, labels, weights, indices, bootstrapLabels,
+      bootstrapWeights);
+
+  BootstrapView<arma::mat> view(dataset, indices);
+  REQUIRE(view.n_rows == dataset.n_rows);
+  REQUIRE(view.n_cols == dataset.n_cols);
+  for (size_t i = 0; i < view.n_cols; ++i)
+    REQUIRE(view(1, i) == dataset(1, indices[i]));
+
+  const arma::mat bootstrapDataset = dataset.cols(indices);
+  DecisionTree<> tree(bootstrapDataset, bootstrapLabels, 2, bootstrapWeights,
+      5);
+  DecisionTree<> viewTree(view, bootstrapLabels, 2, bootstrapWeights, 5);
+
+  // Training works on a copy of the view, so the view is unchanged.
+  REQUIRE(arma::all(view.Indices() == indices));
+
+  arma::Row<size_t> predictions, viewPredictions;
+  tree.Classify(dataset, predictions);
+  viewTree.Classify(dataset, viewPredictions);
+  REQUIRE(tree.NumChildren() == viewTree.NumChildren());
+  CheckMatrices(predictions, viewPredictions);
+}
+
 /**
  * Make sure an empty forest cannot predict.
  */
@@ -378,6 +420,124 @@ TEST_CASE("RandomForestSerializationTest", "[RandomForestTest]")
       binaryProbabilities);
 }
 
+/**
+ * Make sure that only the first trees of a forest are loaded under an
+ * EnsembleLoadLimit, and that they predict as the first trees of the whole
+ * forest.
+ */
+TEST_CASE("RandomForestPartialLoadTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2.csv");
+
+  RandomForest<> rf(dataset, labels, 3, 10 /* 10 trees */, 1);
+
+  arma::Row<size_t> firstPredictions;
+  arma::mat firstProbabilities;
+  rf.Classify(dataset, firstPredictions, firstProbabilities, 4);
+
+  RandomForest<> xmlForest, jsonForest, binaryForest;
+  {
+    cereal::EnsembleLoadLimit limit(4);
+    SerializeObjectAll(rf, xmlForest, jsonForest, binaryForest);
+  }
+
+  REQUIRE(xmlForest.NumTrees() == 4);
+  REQUIRE(jsonForest.NumTrees() == 4);
+  REQUIRE(binaryForest.NumTrees() == 4);
+
+  arma::Row<size_t> xmlPredictions, jsonPredictions, binaryPredictions;
+  arma::mat xmlProbabilities, jsonProbabilities, binaryProbabilities;
+  xmlForest.Classify(dataset, xmlPredictions, xmlProbabilities);
+  jsonForest.Classify(dataset, jsonPredictions, jsonProbabilities);
+  binaryForest.Classify(dataset, binaryPredictions, binaryProbabilities);
+
+  CheckMatrices(firstPredictions, xmlPredictions, jsonPredictions,
+      binaryPredictions);
+  CheckMatrices(firstProbabilities, xmlProbabilities, jsonProbabilities,
+      binaryProbabilities);
+
+  // Without a limit, all trees are loaded again.
+  SerializeObjectAll(rf, xmlForest, jsonForest, binaryForest);
+  REQUIRE(xmlForest.NumTrees() == 10);
+  REQUIRE(jsonForest.NumTrees() == 10);
+  REQUIRE(binaryForest.NumTrees() == 10);
+}
+
+/**
+ * Make sure a compiled random forest gives the same predictions and
+ * probabilities as the forest.
+ */
+TEST_CASE("RandomForestCompileTest", "[RandomForestTest]")
+{
+  arma::mat d;
+  arma::Row<size_t> l;
+  data::DatasetInfo di;
+  MockCategoricalData(d, l, di);
+
+  RandomForest<> rf;
+  REQUIRE_THROWS_AS(rf.Compile(), std::invalid_argument);
+
+  rf.Train(d, di, l, 5, 10 /* 10 trees */, 5);
+  CompiledTreeEnsemble compiled = rf.Compile();
+  REQUIRE(compiled.NumTrees() == 10);
+
+  arma::Row<size_t> predictions, compiledPredictions;
+  arma::mat probabilities, compiledProbabilities;
+  rf.Classify(d, predictions, probabilities);
+  compiled.Classify(d, compiledPredictions, compiledProbabilities);
+
+  CheckMatrices(predictions, compiledPredictions);
+  CheckMatrices(probabilities, compiledProbabilities);
+}
+
+/**
+ * Make sure that extremely randomized trees learn the vc2 dataset about as well
+ * as a random forest, and can be compiled.
+ */
+TEST_CASE("ExtraTreesNumericLearningTest", "[RandomForestTest]")
+{
+  arma::mat dataset;
+  if (!data::Load("vc2.csv", dataset))
+    FAIL("Cannot load dataset vc2.csv");
+  arma::Row<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load dataset vc2_labels.txt");
+
+  arma::mat testDataset;
+  if (!data::Load("vc2_test.csv", testDataset))
+    FAIL("Cannot load dataset vc2_test.csv");
+  arma::Row<size_t> testLabels;
+  if (!data::Load("vc2_test_labels.txt", testLabels))
+    FAIL("Cannot load dataset vc2_test_labels.txt");
+
+  ExtraTrees<> et(dataset, labels, 3, 50 /* 50 trees */, 1, 1e-7);
+  RandomForest<> rf(dataset, labels, 3, 50 /* 50 trees */, 1, 1e-7);
+  REQUIRE(et.NumTrees() == 50);
+
+  arma::Row<size_t> etPredictions, rfPredictions;
+  et.Classify(testDataset, etPredictions);
+  rf.Classify(testDataset, rfPredictions);
+
+  const size_t etCorrect = arma::accu(etPredictions == testLabels);
+  const size_t rfCorrect = arma::accu(rfPredictions == testLabels);
+  REQUIRE(etCorrect >= size_t(0.85 * rfCorrect));
+  REQUIRE(etCorrect >= size_t(0.7 * testDataset.n_cols));
+
+  // The random split values are thresholds, so the forest can be compiled.
+  CompiledTreeEnsemble compiled = et.Compile();
+  arma::Row<size_t> compiledPredictions;
+  arma::mat probabilities, compiledProbabilities;
+  et.Classify(testDataset, etPredictions, probabilities);
+  compiled.Classify(testDataset, compiledPredictions, compiledProbabilities);
+  CheckMatrices(etPredictions, compiledPredictions);
+  CheckMatrices(probabilities, compiledProbabilities);
+}
+
 /**
  * Test that RandomForest::Train() returns finite average entropy on numeric
  * dataset.
@@ -499,6 +659,106 @@ TEST_CASE("DifferentTreesTest", "[RandomForestTest]")
   REQUIRE(success == true);
 }
 
+/**
+ * Test that the trees of a forest only depend on the random seed, not on the
+ * number of threads that train them.
+ */
+TEST_CASE("RandomForestThreadIndependenceTest", "[RandomForestTest]")
+{
+  arma::mat d(10, 500, arma::fill::randu);
+  arma::Row<size_t> l(500);
+  for (size_t i = 0; i < 500; ++i)
+    l(i) = (d(0, i) + d(3, i) > 1.0) ? 1 : 0;
+
+  math::RandomSeed(17);
+  RandomForest<GiniGain, MultipleRandomDimensionSelect> parallelForest(d, l, 2,
+      20);
+
+  #ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  math::RandomSeed(17);
+  RandomForest<GiniGain, MultipleRandomDimensionSelect> sequentialForest(d, l,
+      2, 20);
+
+  #ifdef HAS_OPENMP
+  omp_set_num_threads(numThreads);
+  #endif
+
+  arma::mat parallelProbabilities, sequentialProbabilities;
+  arma::Row<size_t> parallelPredictions, sequentialPredictions;
+  parallelForest.Classify(d, parallelPredictions, parallelProbabilities);
+  sequentialForest.Classify(d, sequentialPredictions, sequentialProbabilities);
+
+  REQUIRE(arma::all(parallelPredictions == sequentialPredictions));
+  REQUIRE(arma::approx_equal(parallelProbabilities, sequentialProbabilities,
+      "absdiff", 0.0));
+  for (size_t i = 0; i < 20; ++i)
+  {
+    REQUIRE(parallelForest.Tree(i).SplitDimension() ==
+        sequentialForest.Tree(i).SplitDimension());
+  }
+}
+
+/**
+ * Train a forest with three processes simulated by threads, and make sure that
+ * every process gets the forest that one process trains with the same seed.
+ */
+TEST_CASE("RandomForestDistributedTrainTest", "[RandomForestTest]")
+{
+  const size_t size = 3;
+  arma::mat d(10, 500, arma::fill::randu);
+  arma::Row<size_t> l(500);
+  for (size_t i = 0; i < 500; ++i)
+    l(i) = (d(0, i) + d(3, i) > 1.0) ? 1 : 0;
+
+  // The threads draw from their own random streams; only the seed of the
+  // first one matters.
+  RandomForest<GiniGain, MultipleRandomDimensionSelect> forest;
+  {
+    math::RandomStream stream(17, 0);
+    forest.Train(d, l, 2, 10);
+  }
+
+  ThreadCommunicator::Mailboxes mailboxes(size);
+  std::vector<RandomForest<GiniGain, MultipleRandomDimensionSelect>> forests(
+      size);
+  std::vector<std::thread> threads;
+  for (size_t r = 0; r < size; ++r)
+  {
+    threads.push_back(std::thread([&, r]()
+    {
+      math::RandomStream stream(17, r);
+      ThreadCommunicator communicator(mailboxes, r);
+      forests[r].Train(communicator, d, l, 2, 10);
+    }));
+  }
+  for (size_t r = 0; r < size; ++r)
+    threads[r].join();
+
+  arma::mat probabilities;
+  arma::Row<size_t> predictions;
+  forest.Classify(d, predictions, probabilities);
+  for (size_t r = 0; r < size; ++r)
+  {
+    REQUIRE(forests[r].NumTrees() == 10);
+    for (size_t i = 0; i < 10; ++i)
+    {
+      REQUIRE(forests[r].Tree(i).SplitDimension() ==
+          forest.Tree(i).SplitDimension());
+    }
+
+    arma::mat distributedProbabilities;
+    arma::Row<size_t> distributedPredictions;
+    forests[r].Classify(d, distributedPredictions, distributedProbabilities);
+    REQUIRE(arma::all(distributedPredictions == predictions));
+    REQUIRE(arma::approx_equal(distributedProbabilities, probabilities,
+        "absdiff", 0.0));
+  }
+}
+
 /**
  * Test that RandomForest::Train() when passed warmStart = True trains on top
  * of exixting forest and adds the newly trained trees to the previously
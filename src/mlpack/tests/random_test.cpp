@@ -94,3 +94,53 @@ TEST_CASE("WeightedRandomTest", "[RandomTest]")
     }
   }
 }
+
+// Random streams must give the same numbers whatever the thread that draws them,
+// and must not touch the global generator.
+TEST_CASE("RandomStreamTest", "[RandomTest]")
+{
+  RandomSeed(42);
+  const size_t seed = RandomStreamSeed();
+  const double next = Random();
+
+  arma::mat parallelDraws(10, 100);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < 100; ++i)
+  {
+    RandomStream stream(seed, i);
+    for (size_t j = 0; j < 5; ++j)
+    {
+      parallelDraws(j, i) = Random();
+      parallelDraws(j + 5, i) = RandNormal();
+    }
+  }
+
+  RandomSeed(42);
+  REQUIRE(RandomStreamSeed() == seed);
+
+  arma::mat sequentialDraws(10, 100);
+  for (size_t i = 0; i < 100; ++i)
+  {
+    RandomStream stream(seed, i);
+    for (size_t j = 0; j < 5; ++j)
+    {
+      sequentialDraws(j, i) = Random();
+      sequentialDraws(j + 5, i) = RandNormal();
+    }
+
+    // A nested stream must not change the draws of the enclosing one.
+    {
+      RandomStream nested(seed, i + 1);
+      Random();
+    }
+  }
+
+  // The global generator continues where it was.
+  REQUIRE(Random() == next);
+
+  REQUIRE(arma::approx_equal(parallelDraws, sequentialDraws, "absdiff", 0.0));
+
+  // Different tasks get different streams.
+  for (size_t i = 1; i < 100; ++i)
+    REQUIRE(sequentialDraws(0, i) != sequentialDraws(0, i - 1));
+}
@@ -60,3 +60,71 @@ TEST_CASE("RandomizedSVDReconstructionError", "[RandomizedSVDTest]")
       arma::norm(centeredData, "frob");
   REQUIRE(error == Approx(0.0).margin(1e-5));
 }
+
+/**
+ * Every orthogonalization strategy should recover the singular values of a low
+ * rank matrix.
+ */
+TEST_CASE("RandomizedSVDOrthogonalizationTest", "[RandomizedSVDTest]")
+{
+  arma::mat data = arma::randn<arma::mat>(100, 5) *
+      arma::randn<arma::mat>(5, 300);
+
+  arma::mat centeredData;
+  math::Center(data, centeredData);
+
+  arma::mat U1, V1;
+  arma::vec s1;
+  arma::svd_econ(U1, s1, V1, centeredData);
+
+  const svd::OrthogonalizationType types[] = { svd::LU_ORTHOGONALIZATION,
+      svd::QR_ORTHOGONALIZATION, svd::CHOLESKY_QR_ORTHOGONALIZATION };
+  for (const svd::OrthogonalizationType type : types)
+  {
+    arma::mat U2, V2;
+    arma::vec s2;
+    svd::RandomizedSVD rSVD(0, 3, 1e-7, type);
+    rSVD.Apply(data, U2, s2, V2, 5);
+
+    const double error = arma::norm(s2.subvec(0, 4) - s1.subvec(0, 4)) /
+        arma::norm(s1.subvec(0, 4));
+    REQUIRE(error == Approx(0.0).margin(1e-5));
+  }
+}
+
+/**
+ * Sparse single precision data should give the same singular values as the
+ * equivalent dense double precision data.
+ */
+TEST_CASE("RandomizedSVDSparseFloatTest", "[RandomizedSVDTest]")
+{
+  // Make a low rank matrix with only one row in ten filled.
+  arma::fmat lowRank = arma::randn<arma::fmat>(200, 3) *
+      arma::randn<arma::fmat>(3, 400);
+  for (size_t i = 0; i < lowRank.n_rows; ++i)
+  {
+    if (i % 10 != 0)
+      lowRank.row(i).zeros();
+  }
+  const arma::sp_fmat data(lowRank);
+
+  arma::mat centeredData;
+  math::Center(arma::conv_to<arma::mat>::from(lowRank), centeredData);
+
+  arma::mat U1, V1;
+  arma::vec s1;
+  arma::svd_econ(U1, s1, V1, centeredData);
+
+  arma::fmat U2, V2;
+  arma::fvec s2;
+  svd::RandomizedSVD rSVD(0, 3, 1e-7, svd::CHOLESKY_QR_ORTHOGONALIZATION);
+  rSVD.Apply(data, U2, s2, V2, 3);
+
+  REQUIRE(U2.n_rows == 200);
+  REQUIRE(V2.n_rows == 400);
+
+  const arma::vec s3 = arma::conv_to<arma::vec>::from(s2.subvec(0, 2));
+  const double error = arma::norm(s3 - s1.subvec(0, 2)) /
+      arma::norm(s1.subvec(0, 2));
+  REQUIRE(error == Approx(0.0).margin(1e-3));
+}
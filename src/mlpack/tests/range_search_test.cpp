@@ -1714,3 +1714,295 @@ TEST_CASE("MoveOperatorNaiveTest", "[RangeSearchTest]")
     }
   }
 }
+
+/**
+ * Check the counts of a RangeSearch object against the sizes of the results of
+ * a full search with the same object, with and without a threshold.
+ */
+template<typename RangeSearchType>
+void CheckRangeCounts(RangeSearchType& rs,
+                      const arma::mat& querySet,
+                      const Range& range)
+{
+  vector<vector<size_t>> neighbors;
+  vector<vector<double>> distances;
+  rs.Search(querySet, range, neighbors, distances);
+
+  arma::Col<size_t> counts;
+  rs.Count(querySet, range, counts);
+  REQUIRE(counts.n_elem == querySet.n_cols);
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    REQUIRE(counts[i] == neighbors[i].size());
+
+  // Counts below the threshold are exact; the others must reach it.
+  const size_t maxCount = 5;
+  rs.Count(querySet, range, counts, maxCount);
+  REQUIRE(counts.n_elem == querySet.n_cols);
+  for (size_t i = 0; i < counts.n_elem; ++i)
+  {
+    if (neighbors[i].size() < maxCount)
+      REQUIRE(counts[i] == neighbors[i].size());
+    else
+      REQUIRE(counts[i] >= maxCount);
+  }
+
+  // The same holds when the query set is the reference set.
+  rs.Search(range, neighbors, distances);
+  rs.Count(range, counts);
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    REQUIRE(counts[i] == neighbors[i].size());
+
+  rs.Count(range, counts, maxCount);
+  for (size_t i = 0; i < counts.n_elem; ++i)
+  {
+    if (neighbors[i].size() < maxCount)
+      REQUIRE(counts[i] == neighbors[i].size());
+    else
+      REQUIRE(counts[i] >= maxCount);
+  }
+}
+
+/**
+ * Make sure that counting gives the sizes of the search results, for naive,
+ * single-tree and dual-tree search with several types of trees.
+ */
+TEST_CASE("RangeCountTest", "[RangeSearchTest]")
+{
+  arma::mat queryData(3, 300, arma::fill::randu);
+  arma::mat referenceData(3, 500, arma::fill::randu);
+  const Range range(0.05, 0.3);
+
+  RangeSearch<> naive(referenceData, true);
+  CheckRangeCounts(naive, queryData, range);
+
+  RangeSearch<> single(referenceData, false, true);
+  CheckRangeCounts(single, queryData, range);
+
+  RangeSearch<> dual(referenceData);
+  CheckRangeCounts(dual, queryData, range);
+
+  RangeSearch<EuclideanDistance, arma::mat, StandardCoverTree>
+      coverSingle(referenceData, false, true);
+  CheckRangeCounts(coverSingle, queryData, range);
+
+  RangeSearch<EuclideanDistance, arma::mat, StandardCoverTree>
+      coverDual(referenceData);
+  CheckRangeCounts(coverDual, queryData, range);
+
+  RangeSearch<EuclideanDistance, arma::mat, BallTree> ball(referenceData);
+  CheckRangeCounts(ball, queryData, range);
+}
+
+/**
+ * A threshold should save base cases.
+ */
+TEST_CASE("RangeCountThresholdTest", "[RangeSearchTest]")
+{
+  arma::mat data(2, 1000, arma::fill::randu);
+  RangeSearch<> rs(data, false, true);
+
+  arma::Col<size_t> counts;
+  rs.Count(Range(0.0, 0.5), counts);
+  const size_t fullBaseCases = rs.BaseCases();
+
+  rs.Count(Range(0.0, 0.5), counts, 3);
+  REQUIRE(rs.BaseCases() < fullBaseCases);
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    REQUIRE(counts[i] >= 3);
+}
+
+/**
+ * Check that the CSR results of a RangeSearch object hold the same neighbors
+ * and distances as the vector-of-vectors results of the same object.
+ */
+void CheckSameCSRResults(const vector<vector<size_t>>& neighbors,
+                         const vector<vector<double>>& distances,
+                         const arma::Col<size_t>& offsets,
+                         const arma::Col<size_t>& csrNeighbors,
+                         const arma::vec& csrDistances)
+{
+  REQUIRE(offsets.n_elem == neighbors.size() + 1);
+  REQUIRE(offsets[0] == 0);
+  REQUIRE(csrNeighbors.n_elem == offsets[neighbors.size()]);
+  REQUIRE(csrDistances.n_elem == offsets[neighbors.size()]);
+
+  for (size_t i = 0; i < neighbors.size(); ++i)
+  {
+    REQUIRE(offsets[i + 1] - offsets[i] == neighbors[i].size());
+
+    vector<pair<size_t, double>> expected, found;
+    for (size_t j = 0; j < neighbors[i].size(); ++j)
+    {
+      expected.push_back(make_pair(neighbors[i][j], distances[i][j]));
+      found.push_back(make_pair(csrNeighbors[offsets[i] + j],
+          csrDistances[offsets[i] + j]));
+    }
+
+    sort(expected.begin(), expected.end());
+    sort(found.begin(), found.end());
+    for (size_t j = 0; j < expected.size(); ++j)
+    {
+      REQUIRE(found[j].first == expected[j].first);
+      REQUIRE(found[j].second == Approx(expected[j].second).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Check the CSR search of a RangeSearch object against its regular search, with
+ * a separate query set and with the reference set as the query set.
+ */
+template<typename RangeSearchType>
+void CheckCSRSearch(RangeSearchType& rs,
+                    const arma::mat& querySet,
+                    const Range& range)
+{
+  vector<vector<size_t>> neighbors;
+  vector<vector<double>> distances;
+  arma::Col<size_t> offsets, csrNeighbors;
+  arma::vec csrDistances;
+
+  rs.Search(querySet, range, neighbors, distances);
+  rs.Search(querySet, range, offsets, csrNeighbors, csrDistances);
+  CheckSameCSRResults(neighbors, distances, offsets, csrNeighbors,
+      csrDistances);
+
+  rs.Search(range, neighbors, distances);
+  rs.Search(range, offsets, csrNeighbors, csrDistances);
+  CheckSameCSRResults(neighbors, distances, offsets, csrNeighbors,
+      csrDistances);
+}
+
+/**
+ * Make sure that the CSR search gives the same results as the regular search,
+ * for naive, single-tree and dual-tree search with several types of trees, with
+ * and without splitting the query tree into parallel tasks.
+ */
+TEST_CASE("RangeSearchCSRTest", "[RangeSearchTest]")
+{
+  arma::mat queryData(3, 300, arma::fill::randu);
+  arma::mat referenceData(3, 500, arma::fill::randu);
+  const Range range(0.05, 0.3);
+
+  RangeSearch<> naive(referenceData, true);
+  CheckCSRSearch(naive, queryData, range);
+
+  RangeSearch<> single(referenceData, false, true);
+  CheckCSRSearch(single, queryData, range);
+
+  RangeSearch<> dual(referenceData);
+  CheckCSRSearch(dual, queryData, range);
+  dual.ParallelDepth() = 3;
+  CheckCSRSearch(dual, queryData, range);
+
+  RangeSearch<EuclideanDistance, arma::mat, StandardCoverTree>
+      coverSingle(referenceData, false, true);
+  CheckCSRSearch(coverSingle, queryData, range);
+
+  RangeSearch<EuclideanDistance, arma::mat, StandardCoverTree>
+      coverDual(referenceData);
+  coverDual.ParallelDepth() = 2;
+  CheckCSRSearch(coverDual, queryData, range);
+
+  RangeSearch<EuclideanDistance, arma::mat, BallTree> ball(referenceData);
+  ball.ParallelDepth() = 3;
+  CheckCSRSearch(ball, queryData, range);
+}
+
+/**
+ * A CSR search with an empty range should give no results but valid offsets.
+ */
+TEST_CASE("RangeSearchCSREmptyTest", "[RangeSearchTest]")
+{
+  arma::mat data(2, 100, arma::fill::randu);
+  RangeSearch<> rs(data);
+
+  arma::Col<size_t> offsets, neighbors;
+  arma::vec distances;
+  rs.Search(Range(5.0, 6.0), offsets, neighbors, distances);
+
+  REQUIRE(offsets.n_elem == 101);
+  REQUIRE(arma::all(offsets == 0));
+  REQUIRE(neighbors.n_elem == 0);
+  REQUIRE(distances.n_elem == 0);
+}
+
+/**
+ * Make sure that searching a prepared query several times gives the same
+ * results as searching the query set.
+ */
+TEST_CASE("RangeSearchPreparedQueryTest", "[RangeSearchTest]")
+{
+  arma::mat referenceData(3, 500, arma::fill::randu);
+  arma::mat queryData(3, 100, arma::fill::randu);
+
+  RangeSearch<> rs(referenceData);
+  PreparedQuery<RangeSearch<>::Tree> query(queryData);
+
+  const Range ranges[] = { Range(0.0, 0.2), Range(0.1, 0.3) };
+  for (size_t r = 0; r < 2; ++r)
+  {
+    vector<vector<size_t>> neighbors, preparedNeighbors;
+    vector<vector<double>> distances, preparedDistances;
+    rs.Search(queryData, ranges[r], neighbors, distances);
+    rs.Search(query, ranges[r], preparedNeighbors, preparedDistances);
+
+    REQUIRE(preparedNeighbors.size() == queryData.n_cols);
+    for (size_t i = 0; i < queryData.n_cols; ++i)
+    {
+      sort(neighbors[i].begin(), neighbors[i].end());
+      sort(preparedNeighbors[i].begin(), preparedNeighbors[i].end());
+      REQUIRE(preparedNeighbors[i] == neighbors[i]);
+      REQUIRE(preparedDistances[i].size() == distances[i].size());
+    }
+  }
+}
+
+/**
+ * Make sure that range search can work on single-precision data, and that it
+ * finds the same neighbors as a naive search on the same points in double
+ * precision.  Pairs whose distance is within rounding error of the bounds of
+ * the range are not checked.
+ */
+TEST_CASE("RangeSearchFloatTest", "[RangeSearchTest]")
+{
+  arma::fmat referenceData = arma::randu<arma::fmat>(3, 500);
+  arma::fmat queryData = arma::randu<arma::fmat>(3, 100);
+  const Range range(0.1, 0.3);
+
+  RangeSearch<> baseline(arma::conv_to<arma::mat>::from(referenceData), true);
+  vector<vector<size_t>> baselineNeighbors;
+  vector<vector<double>> baselineDistances;
+  baseline.Search(arma::conv_to<arma::mat>::from(queryData), range,
+      baselineNeighbors, baselineDistances);
+
+  // Naive, single-tree and dual-tree search.
+  for (size_t m = 0; m < 3; ++m)
+  {
+    RangeSearch<EuclideanDistance, arma::fmat> rs(referenceData, (m == 0),
+        (m == 1));
+    vector<vector<size_t>> neighbors;
+    vector<vector<double>> distances;
+    rs.Search(queryData, range, neighbors, distances);
+
+    REQUIRE(neighbors.size() == queryData.n_cols);
+    for (size_t i = 0; i < queryData.n_cols; ++i)
+    {
+      for (size_t j = 0; j < distances[i].size(); ++j)
+      {
+        REQUIRE(distances[i][j] >= range.Lo() - 1e-5);
+        REQUIRE(distances[i][j] <= range.Hi() + 1e-5);
+      }
+
+      for (size_t j = 0; j < baselineNeighbors[i].size(); ++j)
+      {
+        if (baselineDistances[i][j] < range.Lo() + 1e-5 ||
+            baselineDistances[i][j] > range.Hi() - 1e-5)
+          continue;
+
+        REQUIRE(find(neighbors[i].begin(), neighbors[i].end(),
+            baselineNeighbors[i][j]) != neighbors[i].end());
+      }
+    }
+  }
+}
@@ -251,3 +251,99 @@ TEST_CASE("MiscTest", "[RBMNetworkTest]")
   X = X.t();
   BuildVanillaNetwork<arma::Mat<float>>(X, 2);
 }
+
+/**
+ * Make sure the matrix-product forms of the spike and slab RBM means match
+ * their per-hidden-unit definitions.
+ */
+TEST_CASE("ssRBMMeansTest", "[RBMNetworkTest]")
+{
+  const size_t visibleSize = 5, hiddenSize = 4, poolSize = 3;
+  arma::mat data(visibleSize, 6, arma::fill::randu);
+  GaussianInitialization gaussian(0, 0.5);
+  RBM<GaussianInitialization, arma::mat, SpikeSlabRBM> model(data, gaussian,
+      visibleSize, hiddenSize, 6, 1, 1, poolSize, 8.0, 100.0);
+  model.Reset();
+  model.VisiblePenalty()(0) = 2.0;
+  const arma::cube& weight = model.Weight();
+  const double slabPenalty = 8.0;
+
+  // Spike means.
+  arma::mat spikeMean;
+  model.SpikeMean(data, spikeMean);
+  for (size_t i = 0; i < hiddenSize; ++i)
+  {
+    const double expected = 1.0 / (1.0 + std::exp(-(0.5 / slabPenalty *
+        arma::accu(data.t() * (weight.slice(i) * weight.slice(i).t()) * data)
+        / std::pow(data.n_cols, 2) + model.SpikeBias()(i))));
+    REQUIRE(spikeMean(i) == Approx(expected).epsilon(1e-10));
+  }
+
+  // Slab means.
+  arma::mat spike = arma::round(arma::randu<arma::mat>(hiddenSize, 1));
+  arma::mat slabMean;
+  model.SlabMean(data, spike, slabMean);
+  for (size_t i = 0; i < hiddenSize; ++i)
+  {
+    const arma::vec expected = arma::mean((1.0 / slabPenalty) * spike(i) *
+        weight.slice(i).t() * data, 1);
+    for (size_t j = 0; j < poolSize; ++j)
+      REQUIRE(slabMean(j, i) == Approx(expected(j)).margin(1e-10));
+  }
+
+  // Visible means.
+  arma::mat hidden(hiddenSize + poolSize * hiddenSize, 1, arma::fill::randn);
+  arma::mat visibleMean;
+  model.VisibleMean(hidden, visibleMean);
+  arma::vec expected(visibleSize, arma::fill::zeros);
+  for (size_t i = 0; i < hiddenSize; ++i)
+  {
+    expected += weight.slice(i) * hidden.submat(hiddenSize + i * poolSize, 0,
+        hiddenSize + (i + 1) * poolSize - 1, 0) * hidden(i);
+  }
+  expected /= 2.0;
+  for (size_t j = 0; j < visibleSize; ++j)
+    REQUIRE(visibleMean(j) == Approx(expected(j)).margin(1e-10));
+
+  // Free energy.
+  double freeEnergy = 0.5 * 2.0 * arma::dot(data, data) - 0.5 * hiddenSize *
+      poolSize * std::log((2.0 * M_PI) / slabPenalty);
+  for (size_t i = 0; i < hiddenSize; ++i)
+  {
+    const double sum = arma::accu(arma::square(data.t() * weight.slice(i))) /
+        (2.0 * slabPenalty);
+    freeEnergy -= SoftplusFunction::Fn(model.SpikeBias()(i) - sum);
+  }
+  REQUIRE(model.FreeEnergy(data) == Approx(freeEnergy).epsilon(1e-10));
+}
+
+/**
+ * Make sure Gibbs sampling gives the same chains for any number of threads.
+ */
+TEST_CASE("RBMGibbsThreadIndependenceTest", "[RBMNetworkTest]")
+{
+  arma::mat data = arma::round(arma::randu<arma::mat>(20, 50));
+  GaussianInitialization gaussian(0, 0.1);
+  RBM<GaussianInitialization, arma::mat> model(data, gaussian, 20, 10, 50, 5);
+  model.Reset();
+
+  #ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  arma::mat samples1;
+  math::RandomSeed(11);
+  model.Gibbs(data, samples1);
+
+  #ifdef HAS_OPENMP
+  omp_set_num_threads(numThreads);
+  #endif
+
+  arma::mat samples2;
+  math::RandomSeed(11);
+  model.Gibbs(data, samples2);
+
+  REQUIRE(samples1.n_cols == 50);
+  REQUIRE(arma::all(arma::vectorise(samples1 == samples2)));
+}
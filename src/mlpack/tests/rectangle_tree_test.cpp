@@ -1359,3 +1359,139 @@ TEST_CASE("RectangleTreeMoveDatasetTest", "[RectangleTreeTraitsTest]")
   REQUIRE(tree.Dataset().n_rows == 3);
   REQUIRE(tree.Dataset().n_cols == 1000);
 }
+
+/**
+ * Build a tree of the given type by bulk loading, check that it is valid and
+ * balanced, insert some more points into it, and check that nearest neighbor
+ * search with it gives the same results as a naive search.
+ */
+template<template<typename, typename, typename> class TreeType>
+void CheckBulkLoad(const BulkLoadType bulkLoad)
+{
+  typedef TreeType<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> Tree;
+
+  const size_t numIter = 50;
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+
+  Tree tree(dataset, bulkLoad, 20, 6, 5, 2);
+
+  REQUIRE(tree.NumDescendants() == 1000);
+  CheckContainment(tree);
+  CheckExactContainment(tree);
+  CheckHierarchy(tree);
+  CheckFills(tree);
+  CheckNumDescendants(tree);
+  REQUIRE(GetMinLevel(tree) == GetMaxLevel(tree));
+  REQUIRE(tree.TreeDepth() == GetMinLevel(tree));
+
+  // Points can still be inserted.
+  tree.Dataset().reshape(8, 1000 + numIter);
+  dataset.reshape(8, 1000 + numIter);
+  arma::mat tmpData;
+  tmpData.randu(8, numIter);
+  for (size_t i = 0; i < numIter; ++i)
+  {
+    tree.Dataset().col(1000 + i) = tmpData.col(i);
+    dataset.col(1000 + i) = tmpData.col(i);
+    tree.InsertPoint(1000 + i);
+  }
+
+  REQUIRE(tree.NumDescendants() == 1000 + numIter);
+  CheckContainment(tree);
+  CheckExactContainment(tree);
+  CheckHierarchy(tree);
+  CheckNumDescendants(tree);
+  REQUIRE(GetMinLevel(tree) == GetMaxLevel(tree));
+
+  arma::Mat<size_t> neighbors1;
+  arma::mat distances1;
+  arma::Mat<size_t> neighbors2;
+  arma::mat distances2;
+
+  NeighborSearch<NearestNeighborSort, metric::LMetric<2, true>, arma::mat,
+      TreeType> knn1(std::move(tree), SINGLE_TREE_MODE);
+  knn1.Search(5, neighbors1, distances1);
+
+  KNN knn2(dataset, NAIVE_MODE);
+  knn2.Search(5, neighbors2, distances2);
+
+  for (size_t i = 0; i < neighbors1.size(); ++i)
+  {
+    REQUIRE(neighbors1[i] == neighbors2[i]);
+    REQUIRE(distances1[i] == distances2[i]);
+  }
+}
+
+// Test that every tree type can be bulk-loaded with the methods it supports.
+TEST_CASE("RectangleTreeBulkLoadTest", "[RectangleTreeTraitsTest]")
+{
+  CheckBulkLoad<RTree>(STR_BULK_LOAD);
+  CheckBulkLoad<RTree>(HILBERT_BULK_LOAD);
+  CheckBulkLoad<RStarTree>(STR_BULK_LOAD);
+  CheckBulkLoad<RStarTree>(HILBERT_BULK_LOAD);
+  CheckBulkLoad<XTree>(STR_BULK_LOAD);
+  CheckBulkLoad<XTree>(HILBERT_BULK_LOAD);
+  CheckBulkLoad<HilbertRTree>(HILBERT_BULK_LOAD);
+  CheckBulkLoad<RPlusTree>(STR_BULK_LOAD);
+  CheckBulkLoad<RPlusPlusTree>(STR_BULK_LOAD);
+}
+
+// Test that the auxiliary information of bulk-loaded trees is set up.
+TEST_CASE("RectangleTreeBulkLoadAuxiliaryInfoTest",
+          "[RectangleTreeTraitsTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+
+  typedef HilbertRTree<EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>, arma::mat> HilbertTreeType;
+  HilbertTreeType hilbertRTree(dataset, HILBERT_BULK_LOAD, 20, 6, 5, 2);
+
+  CheckHilbertValue(hilbertRTree);
+  CheckDiscreteHilbertValueSync(hilbertRTree);
+  CheckHilbertOrdering(hilbertRTree);
+
+  typedef RPlusTree<EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>, arma::mat> RPlusTreeType;
+  RPlusTreeType rPlusTree(dataset, STR_BULK_LOAD, 20, 6, 5, 2);
+
+  CheckOverlap(rPlusTree);
+
+  typedef RPlusPlusTree<EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>, arma::mat> RPlusPlusTreeType;
+  RPlusPlusTreeType rPlusPlusTree(dataset, STR_BULK_LOAD, 20, 6, 5, 2);
+
+  CheckRPlusPlusTreeBound(rPlusPlusTree);
+
+  // A tree with a single leaf.
+  HilbertTreeType smallTree(arma::mat(dataset.cols(0, 9)), HILBERT_BULK_LOAD);
+
+  REQUIRE(smallTree.IsLeaf());
+  REQUIRE(smallTree.NumDescendants() == 10);
+  CheckDiscreteHilbertValueSync(smallTree);
+  CheckHilbertOrdering(smallTree);
+}
+
+// Test that an exception is thrown if a tree type does not support a bulk
+// loading method.
+TEST_CASE("RectangleTreeBulkLoadInvalidTest", "[RectangleTreeTraitsTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 100);
+
+  typedef HilbertRTree<EuclideanDistance, EmptyStatistic, arma::mat>
+      HilbertTreeType;
+  typedef RPlusTree<EuclideanDistance, EmptyStatistic, arma::mat>
+      RPlusTreeType;
+  typedef RPlusPlusTree<EuclideanDistance, EmptyStatistic, arma::mat>
+      RPlusPlusTreeType;
+
+  REQUIRE_THROWS_AS(HilbertTreeType(dataset, STR_BULK_LOAD),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(RPlusTreeType(dataset, HILBERT_BULK_LOAD),
+      std::invalid_argument);
+  REQUIRE_THROWS_AS(RPlusPlusTreeType(dataset, HILBERT_BULK_LOAD),
+      std::invalid_argument);
+}
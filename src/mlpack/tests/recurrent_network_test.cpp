@@ -22,6 +22,7 @@
 #include "catch.hpp"
 #include "serialization.hpp"
 #include "custom_layer.hpp"
+#include "ann_test_tools.hpp"
 
 using namespace mlpack;
 using namespace mlpack::ann;
@@ -347,6 +348,67 @@ TEST_CASE("GRUBatchSizeTest", "[RecurrentNetworkTest]")
   BatchSizeTest<GRU<>>();
 }
 
+/**
+ * Check that the gradient of an RNN is the same whether the outputs of the
+ * stateless layers are stored or recomputed during the backward pass.
+ */
+template<typename RecurrentLayerType>
+void RecomputeGradientTest()
+{
+  const size_t rho = 10;
+
+  arma::cube input;
+  arma::mat labelsTemp;
+  GenerateNoisySines(input, labelsTemp, rho, 6);
+
+  arma::cube labels = arma::zeros<arma::cube>(1, labelsTemp.n_cols, rho);
+  for (size_t i = 0; i < labelsTemp.n_cols; ++i)
+  {
+    const int value = arma::as_scalar(arma::find(
+        arma::max(labelsTemp.col(i)) == labelsTemp.col(i), 1)) + 1;
+    labels.tube(0, i).fill(value);
+  }
+
+  RNN<> model(rho);
+  model.Add<Linear<>>(1, 10);
+  model.Add<SigmoidLayer<>>();
+  model.Add<RecurrentLayerType>(10, 10);
+  model.Add<SigmoidLayer<>>();
+  model.Add<Linear<>>(10, 10);
+  model.Add<LogSoftMax<>>();
+
+  model.Predictors() = input;
+  model.Responses() = labels;
+  model.Reset();
+
+  arma::mat gradient, recomputedGradient;
+  const double objective = model.EvaluateWithGradient(model.Parameters(), 0,
+      gradient, 4);
+
+  model.Recompute() = true;
+  const double recomputedObjective = model.EvaluateWithGradient(
+      model.Parameters(), 0, recomputedGradient, 4);
+
+  REQUIRE(recomputedObjective == Approx(objective).epsilon(1e-7));
+  CheckMatrices(gradient, recomputedGradient, 1e-5);
+}
+
+/**
+ * Ensure that recomputing layer outputs gives the same LSTM gradient.
+ */
+TEST_CASE("LSTMRecomputeGradientTest", "[RecurrentNetworkTest]")
+{
+  RecomputeGradientTest<LSTM<>>();
+}
+
+/**
+ * Ensure that recomputing layer outputs gives the same GRU gradient.
+ */
+TEST_CASE("GRURecomputeGradientTest", "[RecurrentNetworkTest]")
+{
+  RecomputeGradientTest<GRU<>>();
+}
+
 /**
  * Make sure the RNN can be properly serialized.
  */
@@ -806,6 +868,55 @@ TEST_CASE("BRNNTrainReturnObjective", "[RecurrentNetworkTest]")
   REQUIRE(std::isfinite(objVal) == true);
 }
 
+/**
+ * Check the BRNN gradient, whose two directions are computed concurrently,
+ * against a numerical estimate.
+ */
+TEST_CASE("BRNNGradientTest", "[RecurrentNetworkTest]")
+{
+  // BRNN function gradient instantiation.
+  struct GradientFunction
+  {
+    GradientFunction() : rho(4), model(new BRNN<>(rho))
+    {
+      input = arma::randu<arma::cube>(2, 5, rho);
+      target = arma::floor(arma::randu<arma::cube>(1, 5, rho) * 3);
+
+      Add<> add(4);
+      Linear<> lookup(2, 4);
+      SigmoidLayer<> sigmoidLayer;
+      Linear<> linear(4, 4);
+      Recurrent<>* recurrent = new Recurrent<>(
+          add, lookup, linear, sigmoidLayer, rho);
+
+      model->Predictors() = input;
+      model->Responses() = target;
+      model->Add<IdentityLayer<> >();
+      model->Add(recurrent);
+      model->Add<Linear<> >(4, 3);
+      model->ResetParameters();
+    }
+
+    ~GradientFunction()
+    {
+      delete model;
+    }
+
+    double Gradient(arma::mat& gradient) const
+    {
+      return model->EvaluateWithGradient(model->Parameters(), 0, gradient, 5);
+    }
+
+    arma::mat& Parameters() { return model->Parameters(); }
+
+    size_t rho;
+    BRNN<>* model;
+    arma::cube input, target;
+  } function;
+
+  REQUIRE(CheckGradient(function) <= 1e-4);
+}
+
 /**
  * Test that RNN::Train() does not give an error for large rho.
  */
@@ -931,3 +1042,54 @@ TEST_CASE("RNNCheckInputShapeTest", "[RecurrentNetworkTest]")
 
   REQUIRE_THROWS_AS(model.Train(input, labels, opt), std::logic_error);
 }
+
+/**
+ * Make sure that the predictions of a recurrent layer whose input projections
+ * were computed in one pass by the RNN match the predictions of the layer
+ * when it is run one step at a time.
+ */
+template<typename RecurrentLayerType>
+void ProjectedInputsTestNetwork()
+{
+  const size_t rho = 6;
+  const size_t inSize = 4;
+  const size_t outSize = 5;
+  const size_t points = 7;
+
+  arma::cube input(inSize, points, rho, arma::fill::randn);
+
+  RNN<> model(rho);
+  model.Add<IdentityLayer<> >();
+  RecurrentLayerType* layer = new RecurrentLayerType(inSize, outSize, rho);
+  model.Add(layer);
+
+  // Use a batch size that doesn't divide the number of points, so that the
+  // inputs of the last batch have to be gathered.
+  arma::cube predictions;
+  model.Predict(input, predictions, 3);
+
+  // Now run the layer on its own, one step at a time, without projections.
+  arma::mat output;
+  for (size_t begin = 0; begin < points; begin += 3)
+  {
+    const size_t batchSize = std::min(size_t(3), points - begin);
+    layer->ResetCell(rho);
+    for (size_t seqNum = 0; seqNum < rho; ++seqNum)
+    {
+      layer->Forward(arma::mat(input.slice(seqNum).cols(begin,
+          begin + batchSize - 1)), output);
+      REQUIRE(arma::approx_equal(output, predictions.slice(seqNum).cols(
+          begin, begin + batchSize - 1), "absdiff", 1e-10));
+    }
+  }
+}
+
+/**
+ * Test the input projections of the LSTM, FastLSTM and GRU layers.
+ */
+TEST_CASE("RNNProjectedInputsTest", "[RecurrentNetworkTest]")
+{
+  ProjectedInputsTestNetwork<LSTM<> >();
+  ProjectedInputsTestNetwork<FastLSTM<> >();
+  ProjectedInputsTestNetwork<GRU<> >();
+}
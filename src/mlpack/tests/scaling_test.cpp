@@ -18,6 +18,7 @@
 
 #include "test_catch_tools.hpp"
 #include "catch.hpp"
+#include "serialization.hpp"
 
 using namespace mlpack;
 using namespace mlpack::data;
@@ -172,3 +173,99 @@ TEST_CASE("ZCAWhiteningTest", "[ScalingTest]")
   scale.InverseTransform(output, temp);
   CheckMatrices(dataset, temp);
 }
+
+/**
+ * Make sure that transforming in place gives the same results as transforming
+ * into another matrix, for the scalers that support it without copies.
+ */
+TEST_CASE("InPlaceWhiteningTest", "[ScalingTest]")
+{
+  arma::mat input = arma::randu<arma::mat>(3, 3) *
+      arma::randu<arma::mat>(3, 50);
+  arma::mat output, inPlace;
+
+  data::StandardScaler standard;
+  standard.Fit(input);
+  standard.Transform(input, output);
+  inPlace = input;
+  standard.Transform(inPlace, inPlace);
+  CheckMatrices(output, inPlace);
+  standard.InverseTransform(inPlace, inPlace);
+  CheckMatrices(input, inPlace);
+
+  data::PCAWhitening pca;
+  pca.Fit(input);
+  pca.Transform(input, output);
+  inPlace = input;
+  pca.Transform(inPlace, inPlace);
+  CheckMatrices(output, inPlace);
+
+  data::ZCAWhitening zca;
+  zca.Fit(input);
+  zca.Transform(input, output);
+  inPlace = input;
+  zca.Transform(inPlace, inPlace);
+  CheckMatrices(output, inPlace);
+}
+
+/**
+ * Fit the given scaler on the whole input, in chunks, and on two halves that
+ * are merged, and make sure the three transform the input in the same way.
+ */
+template<typename ScalerType>
+void CheckPartialFit(const arma::mat& input)
+{
+  ScalerType full;
+  full.Fit(input);
+
+  ScalerType chunked;
+  for (size_t begin = 0; begin < input.n_cols; begin += 7)
+  {
+    const size_t end = std::min(begin + 7, (size_t) input.n_cols);
+    chunked.PartialFit(arma::mat(input.cols(begin, end - 1)));
+  }
+
+  ScalerType first, second;
+  first.PartialFit(arma::mat(input.cols(0, 39)));
+  second.PartialFit(arma::mat(input.cols(40, input.n_cols - 1)));
+  first.Merge(second);
+
+  arma::mat fullOutput, chunkedOutput, mergedOutput;
+  full.Transform(input, fullOutput);
+  chunked.Transform(input, chunkedOutput);
+  first.Transform(input, mergedOutput);
+  CheckMatrices(fullOutput, chunkedOutput);
+  CheckMatrices(fullOutput, mergedOutput);
+
+  // Points of another dimensionality cannot be added.
+  REQUIRE_THROWS_AS(chunked.PartialFit(arma::mat(input.n_rows + 1, 3,
+      arma::fill::randu)), std::invalid_argument);
+}
+
+/**
+ * Make sure fitting scalers in chunks gives the same result as fitting them on
+ * all the points at once.
+ */
+TEST_CASE("PartialFitScalerTest", "[ScalingTest]")
+{
+  arma::mat input = arma::randn<arma::mat>(4, 100);
+  input.row(1) *= 1e4;
+  input.row(2) += 1e6;
+
+  CheckPartialFit<data::StandardScaler>(input);
+  CheckPartialFit<data::MinMaxScaler>(input);
+  CheckPartialFit<data::MaxAbsScaler>(input);
+  CheckPartialFit<data::MeanNormalization>(input);
+
+  // A serialized scaler can still be updated.
+  data::StandardScaler scaler, xmlScaler, jsonScaler, binaryScaler;
+  scaler.PartialFit(arma::mat(input.cols(0, 49)));
+  SerializeObjectAll(scaler, xmlScaler, jsonScaler, binaryScaler);
+  binaryScaler.PartialFit(arma::mat(input.cols(50, 99)));
+  REQUIRE(binaryScaler.ItemCount() == 100);
+
+  data::StandardScaler full;
+  full.Fit(input);
+  CheckMatrices(full.ItemMean(), binaryScaler.ItemMean());
+  CheckMatrices(full.ItemStdDev(), binaryScaler.ItemStdDev());
+}
@@ -1073,16 +1073,10 @@ TEST_CASE("LSHTest", "[SerializationTest]")
   REQUIRE(lsh.BucketSize() == jsonLsh.BucketSize());
   REQUIRE(lsh.BucketSize() == binaryLsh.BucketSize());
 
-  REQUIRE(lsh.SecondHashTable().size() ==
-      xmlLsh.SecondHashTable().size());
-  REQUIRE(lsh.SecondHashTable().size() ==
-      jsonLsh.SecondHashTable().size());
-  REQUIRE(lsh.SecondHashTable().size() ==
-      binaryLsh.SecondHashTable().size());
-
-  for (size_t i = 0; i < lsh.SecondHashTable().size(); ++i)
-  CheckMatrices(lsh.SecondHashTable()[i], xmlLsh.SecondHashTable()[i],
-      jsonLsh.SecondHashTable()[i], binaryLsh.SecondHashTable()[i]);
+  CheckMatrices(lsh.BucketOffsets(), xmlLsh.BucketOffsets(),
+      jsonLsh.BucketOffsets(), binaryLsh.BucketOffsets());
+  CheckMatrices(lsh.BucketContents(), xmlLsh.BucketContents(),
+      jsonLsh.BucketContents(), binaryLsh.BucketContents());
 }
 
 // Make sure serialization works for LARS.
@@ -674,3 +674,137 @@ TEST_CASE("SoftmaxRegressionComputeProbabilitiesAndLabelsTest",
     REQUIRE(testLabels(i) == labels(i));
   }
 }
+
+/**
+ * Make sure that the objective function and its gradient are the same for
+ * sparse and dense data.
+ */
+TEST_CASE("SoftmaxRegressionFunctionSparseTest", "[SoftmaxRegressionTest]")
+{
+  const size_t points = 500;
+  const size_t inputSize = 10;
+  const size_t numClasses = 4;
+
+  arma::sp_mat sparseData;
+  sparseData.sprandu(inputSize, points, 0.2);
+  const arma::mat data(sparseData);
+
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; ++i)
+    labels(i) = math::RandInt(0, numClasses);
+
+  for (size_t fitIntercept = 0; fitIntercept < 2; ++fitIntercept)
+  {
+    SoftmaxRegressionFunction srf(data, labels, numClasses, 0.5,
+        (bool) fitIntercept);
+    SoftmaxRegressionFunctionType<arma::sp_mat> sparseSrf(sparseData, labels,
+        numClasses, 0.5, (bool) fitIntercept);
+
+    arma::mat parameters;
+    parameters.randu(numClasses, inputSize + fitIntercept);
+
+    REQUIRE(sparseSrf.Evaluate(parameters) ==
+        Approx(srf.Evaluate(parameters)).epsilon(1e-7));
+    REQUIRE(sparseSrf.Evaluate(parameters, 10, 50) ==
+        Approx(srf.Evaluate(parameters, 10, 50)).epsilon(1e-7));
+
+    arma::mat gradient, sparseGradient;
+    srf.Gradient(parameters, gradient);
+    sparseSrf.Gradient(parameters, sparseGradient);
+    REQUIRE(arma::approx_equal(gradient, sparseGradient, "absdiff", 1e-7));
+
+    srf.Gradient(parameters, 10, gradient, 50);
+    sparseSrf.Gradient(parameters, 10, sparseGradient, 50);
+    REQUIRE(arma::approx_equal(gradient, sparseGradient, "absdiff", 1e-7));
+  }
+}
+
+/**
+ * Train on sparse and dense data and make sure the models are the same.
+ */
+TEST_CASE("SoftmaxRegressionSparseTrainTest", "[SoftmaxRegressionTest]")
+{
+  arma::sp_mat sparseData;
+  sparseData.sprandu(10, 800, 0.3);
+  const arma::mat data(sparseData);
+
+  arma::Row<size_t> labels(800);
+  for (size_t i = 0; i < 800; ++i)
+    labels[i] = math::RandInt(0, 3);
+
+  SoftmaxRegression sr(data, labels, 3, 0.1, true, ens::L_BFGS());
+  SoftmaxRegression sparseSr(sparseData, labels, 3, 0.1, true,
+      ens::L_BFGS());
+
+  REQUIRE(sr.Parameters().n_elem == sparseSr.Parameters().n_elem);
+  for (size_t i = 0; i < sr.Parameters().n_elem; ++i)
+  {
+    REQUIRE(sr.Parameters()[i] ==
+        Approx(sparseSr.Parameters()[i]).epsilon(5e-6));
+  }
+
+  arma::Row<size_t> predictions, sparsePredictions;
+  sr.Classify(data, predictions);
+  sparseSr.Classify(sparseData, sparsePredictions);
+  REQUIRE(arma::accu(predictions != sparsePredictions) == 0);
+  REQUIRE(sparseSr.ComputeAccuracy(sparseData, labels) ==
+      Approx(sr.ComputeAccuracy(data, labels)));
+
+  // Shuffling a sparse function must keep each point with its label.
+  SoftmaxRegressionFunctionType<arma::sp_mat> srf(sparseData, labels, 3, 0.1);
+  arma::mat parameters;
+  parameters.randu(3, 10);
+  const double objective = srf.Evaluate(parameters);
+  srf.Shuffle();
+  REQUIRE(srf.Evaluate(parameters) == Approx(objective).epsilon(1e-7));
+}
+
+/**
+ * Make sure that shuffling the visitation order gives exactly the same batches
+ * as shuffling the data itself, for dense and sparse data.
+ */
+template<typename MatType>
+void CheckSoftmaxRegressionFunctionShuffle(const MatType& data)
+{
+  arma::Row<size_t> labels(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    labels[i] = math::RandInt(0, 3);
+
+  MatType shuffledData(data);
+  arma::Row<size_t> shuffledLabels(labels);
+  SoftmaxRegressionFunctionType<MatType> srf(data, labels, 3, 0.1, true);
+  arma::mat parameters(3, data.n_rows + 1, arma::fill::randu);
+
+  // Shuffle a few times, to make sure the orderings are composed correctly.
+  for (size_t trial = 0; trial < 3; ++trial)
+  {
+    math::RandomSeed(trial + 1);
+    math::ShuffleData(shuffledData, shuffledLabels, shuffledData,
+        shuffledLabels);
+    math::RandomSeed(trial + 1);
+    srf.Shuffle();
+
+    SoftmaxRegressionFunctionType<MatType> reference(shuffledData,
+        shuffledLabels, 3, 0.1, true);
+    for (size_t start = 0; start < data.n_cols; start += 20)
+    {
+      REQUIRE(srf.Evaluate(parameters, start, 20) ==
+          reference.Evaluate(parameters, start, 20));
+
+      arma::mat gradient, referenceGradient;
+      srf.Gradient(parameters, start, gradient, 20);
+      reference.Gradient(parameters, start, referenceGradient, 20);
+      REQUIRE(arma::approx_equal(gradient, referenceGradient, "absdiff", 0.0));
+    }
+  }
+}
+
+TEST_CASE("SoftmaxRegressionFunctionShuffleTest", "[SoftmaxRegressionTest]")
+{
+  arma::mat data(6, 100, arma::fill::randu);
+  CheckSoftmaxRegressionFunctionShuffle(data);
+
+  arma::sp_mat sparseData;
+  sparseData.sprandu(6, 100, 0.3);
+  CheckSoftmaxRegressionFunctionShuffle(sparseData);
+}
@@ -274,3 +274,115 @@ TEST_CASE("SparseAutoencoderFunctionGradient", "[SparseAutoencoderTest]")
     }
   }
 }
+
+/**
+ * Make sure the separable objective over a single batch of all the points is
+ * the full-batch objective, and that the reconstruction errors of the batches
+ * add up to the full-batch one.
+ */
+TEST_CASE("SparseAutoencoderFunctionSeparableTest", "[SparseAutoencoderTest]")
+{
+  const size_t points = 100;
+  const size_t vSize = 8;
+  const size_t hSize = 4;
+
+  arma::mat data;
+  data.randu(vSize, points);
+
+  SparseAutoencoderFunction saf(data, vSize, hSize, 0.01, 3, 0.1);
+  const arma::mat parameters = saf.GetInitialPoint();
+  REQUIRE(saf.NumFunctions() == points);
+
+  REQUIRE(saf.Evaluate(parameters, 0, points) ==
+      Approx(saf.Evaluate(parameters)).epsilon(1e-7));
+
+  arma::mat gradient, batchGradient;
+  saf.Gradient(parameters, gradient);
+  saf.Gradient(parameters, 0, batchGradient, points);
+  CheckMatrices(gradient, batchGradient, 1e-5);
+
+  // The separable gradient keeps the average activations.
+  REQUIRE(saf.AverageActivations().n_elem == hSize);
+
+  // Without the regularization and sparsity terms, the batches add up to the
+  // full-batch objective, however the points are shuffled.
+  SparseAutoencoderFunction safNoTerms(data, vSize, hSize, 0, 0);
+  for (size_t trial = 0; trial < 2; ++trial)
+  {
+    double sum = 0.0;
+    for (size_t i = 0; i < points; i += 25)
+      sum += 25 * safNoTerms.Evaluate(parameters, i, 25) / points;
+
+    REQUIRE(sum == Approx(safNoTerms.Evaluate(parameters)).epsilon(1e-7));
+    safNoTerms.Shuffle();
+  }
+}
+
+/**
+ * Check the separable gradient numerically, on a batch of shuffled points.
+ */
+TEST_CASE("SparseAutoencoderFunctionSeparableGradientTest",
+          "[SparseAutoencoderTest]")
+{
+  const size_t points = 50;
+  const size_t vSize = 6;
+  const size_t hSize = 3;
+  const size_t batchSize = 10;
+
+  arma::mat data;
+  data.randu(vSize, points);
+
+  // With a momentum of 0, the sparsity term of a batch only depends on the
+  // batch, so the gradient is exact.
+  SparseAutoencoderFunction saf(data, vSize, hSize, 0.5, 2, 0.2);
+  saf.SparsityMomentum(0.0);
+  saf.Shuffle();
+
+  arma::mat parameters;
+  parameters.randu(2 * hSize + 1, vSize + 1);
+
+  arma::mat gradient;
+  saf.Gradient(parameters, 20, gradient, batchSize);
+
+  const double epsilon = 0.0001;
+  for (size_t i = 0; i < parameters.n_elem; ++i)
+  {
+    parameters[i] += epsilon;
+    const double costPlus = saf.Evaluate(parameters, 20, batchSize);
+    parameters[i] -= 2 * epsilon;
+    const double costMinus = saf.Evaluate(parameters, 20, batchSize);
+    parameters[i] += epsilon;
+
+    REQUIRE((costPlus - costMinus) / (2 * epsilon) ==
+        Approx(gradient[i]).epsilon(1e-4).margin(1e-8));
+  }
+}
+
+/**
+ * Make sure a sparse autoencoder can be trained with a mini-batch optimizer.
+ */
+TEST_CASE("SparseAutoencoderMiniBatchTrainingTest", "[SparseAutoencoderTest]")
+{
+  const size_t vSize = 10;
+  const size_t hSize = 5;
+
+  arma::mat data;
+  data.randu(vSize, 500);
+
+  SparseAutoencoderFunction saf(data, vSize, hSize);
+  arma::mat parameters = saf.GetInitialPoint();
+  const double initialObjective = saf.Evaluate(parameters);
+
+  ens::Adam adam(0.01, 32, 0.9, 0.999, 1e-8, 20 * data.n_cols);
+  adam.Optimize(saf, parameters);
+
+  REQUIRE(saf.Evaluate(parameters) < initialObjective);
+
+  // The model trains through the usual interface too.
+  SparseAutoencoder encoder(data, vSize, hSize, 0.0001, 3, 0.01,
+      ens::Adam(0.01, 32, 0.9, 0.999, 1e-8, 5 * data.n_cols));
+  arma::mat features;
+  encoder.GetNewFeatures(data, features);
+  REQUIRE(features.n_rows == hSize);
+  REQUIRE(features.n_cols == data.n_cols);
+}
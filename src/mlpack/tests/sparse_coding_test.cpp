@@ -109,6 +109,45 @@ TEST_CASE("SparseCodingTestCodingStepElasticNet", "[SparseCodingTest]")
   }
 }
 
+/**
+ * Encode() splits the points among threads, each reusing one LARS object.
+ * Make sure the codes are the ones found with a new LARS object for each point.
+ */
+TEST_CASE("SparseCodingParallelEncodeTest", "[SparseCodingTest]")
+{
+  double lambda1 = 0.1;
+  double lambda2 = 0.2;
+  uword nAtoms = 25;
+
+  mat X;
+  X.load("mnist_first250_training_4s_and_9s.arm");
+  uword nPoints = X.n_cols;
+
+  // Normalize each point since these are images.
+  for (uword i = 0; i < nPoints; ++i)
+    X.col(i) /= norm(X.col(i), 2);
+
+  SparseCoding sc(nAtoms, lambda1, lambda2);
+  mat Z;
+  DataDependentRandomInitializer::Initialize(X, 25, sc.Dictionary());
+  sc.Encode(X, Z);
+
+  const mat& D = sc.Dictionary();
+  const mat gram = trans(D) * D;
+
+  REQUIRE(Z.n_rows == nAtoms);
+  REQUIRE(Z.n_cols == nPoints);
+  for (uword i = 0; i < nPoints; ++i)
+  {
+    LARS lars(true, gram, lambda1, lambda2);
+    vec code;
+    rowvec responses = trans(X.col(i));
+    lars.Train(D, responses, code, false);
+
+    CheckMatrices(Z.unsafe_col(i), code, 1e-8);
+  }
+}
+
 TEST_CASE("SparseCodingTestDictionaryStep", "[SparseCodingTest]")
 {
   const double tol = 1e-6;
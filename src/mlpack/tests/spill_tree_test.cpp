@@ -304,3 +304,55 @@ TEST_CASE("SpillTreeMoveDatasetTest", "[SpillTreeTest]")
   REQUIRE(tree.Dataset().n_rows == 3);
   REQUIRE(tree.Dataset().n_cols == 1000);
 }
+
+/**
+ * Make sure that the nodes of two spill trees hold the same points.
+ */
+template<typename TreeType>
+void CheckSameSpillNode(TreeType& node1, TreeType& node2)
+{
+  REQUIRE(node1.NumDescendants() == node2.NumDescendants());
+  REQUIRE(node1.NumPoints() == node2.NumPoints());
+  REQUIRE(node1.Overlap() == node2.Overlap());
+  for (size_t i = 0; i < node1.NumPoints(); ++i)
+    REQUIRE(node1.Point(i) == node2.Point(i));
+
+  REQUIRE((node1.Left() == NULL) == (node2.Left() == NULL));
+  REQUIRE((node1.Right() == NULL) == (node2.Right() == NULL));
+  if (node1.Left())
+  {
+    REQUIRE(node1.Left()->Parent() == &node1);
+    CheckSameSpillNode(*node1.Left(), *node2.Left());
+  }
+  if (node1.Right())
+  {
+    REQUIRE(node1.Right()->Parent() == &node1);
+    CheckSameSpillNode(*node1.Right(), *node2.Right());
+  }
+}
+
+/**
+ * Build a spill tree large enough that its children are built in parallel, and
+ * make sure it does not depend on the number of threads.
+ */
+TEST_CASE("ParallelSpillTreeConstructionTest", "[SpillTreeTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(3, 20000);
+  typedef SPTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  TreeType tree(dataset, 0.05);
+
+  #ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  TreeType sequentialTree(dataset, 0.05);
+
+  #ifdef HAS_OPENMP
+  omp_set_num_threads(numThreads);
+  #endif
+
+  REQUIRE(tree.NumDescendants() >= 20000);
+  CheckSameSpillNode(tree, sequentialTree);
+}
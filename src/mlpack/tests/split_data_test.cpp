@@ -421,3 +421,73 @@ TEST_CASE("SplitLabeledDataResultField", "[SplitDataTest]")
   CheckFields(input, inputConcat);
   CheckFields(label, labelConcat);
 }
+
+/**
+ * Check that SplitIndices() and StratifiedSplitIndices() select the same points
+ * as Split() with the same random seed.
+ */
+TEST_CASE("SplitIndicesMatchSplitTest", "[SplitDataTest]")
+{
+  mat input = randu<mat>(4, 101);
+  Row<size_t> labels = randi<Row<size_t>>(101, distr_param(0, 3));
+
+  for (const bool stratify : { false, true })
+  {
+    math::RandomSeed(42);
+    const auto value = Split(input, labels, 0.3, true, stratify);
+
+    math::RandomSeed(42);
+    uvec trainIndices, testIndices;
+    if (stratify)
+      StratifiedSplitIndices(labels, trainIndices, testIndices, 0.3);
+    else
+      SplitIndices(input.n_cols, trainIndices, testIndices, 0.3);
+
+    REQUIRE(trainIndices.n_elem + testIndices.n_elem == input.n_cols);
+    CheckMatrices(std::get<0>(value), input.cols(trainIndices));
+    CheckMatrices(std::get<1>(value), input.cols(testIndices));
+    REQUIRE(accu(std::get<2>(value) != labels.cols(trainIndices)) == 0);
+    REQUIRE(accu(std::get<3>(value) != labels.cols(testIndices)) == 0);
+  }
+}
+
+/**
+ * Check that SplitInPlace() rearranges the data into the same training and test
+ * sets as Split() with the same random seed.
+ */
+TEST_CASE("SplitInPlaceTest", "[SplitDataTest]")
+{
+  mat input = randu<mat>(4, 101);
+  Row<size_t> labels = randi<Row<size_t>>(101, distr_param(0, 3));
+
+  for (const bool stratify : { false, true })
+  {
+    math::RandomSeed(42);
+    const auto value = Split(input, labels, 0.3, true, stratify);
+
+    math::RandomSeed(42);
+    mat permuted = input;
+    Row<size_t> permutedLabels = labels;
+    const size_t trainSize = SplitInPlace(permuted, permutedLabels, 0.3, true,
+        stratify);
+
+    REQUIRE(trainSize == std::get<0>(value).n_cols);
+    CheckMatrices(std::get<0>(value), permuted.cols(0, trainSize - 1));
+    CheckMatrices(std::get<1>(value),
+        permuted.cols(trainSize, permuted.n_cols - 1));
+    REQUIRE(accu(std::get<2>(value) !=
+        permutedLabels.cols(0, trainSize - 1)) == 0);
+    REQUIRE(accu(std::get<3>(value) !=
+        permutedLabels.cols(trainSize, permuted.n_cols - 1)) == 0);
+  }
+
+  // Without labels.
+  math::RandomSeed(7);
+  const auto value = Split(input, 0.2);
+  math::RandomSeed(7);
+  mat permuted = input;
+  const size_t trainSize = SplitInPlace(permuted, 0.2);
+  CheckMatrices(std::get<0>(value), permuted.cols(0, trainSize - 1));
+  CheckMatrices(std::get<1>(value),
+      permuted.cols(trainSize, permuted.n_cols - 1));
+}
@@ -1434,3 +1434,104 @@ TEST_CASE("SplitByAnyOfTfIdfEncodingSerialization", "[StringEncodingTest]")
 
   CheckMatrices(output, xmlOutput, jsonOutput, binaryOutput);
 }
+
+/**
+ * Test that the bag of words and tf-idf encoders give the same result with
+ * sparse and dense outputs.
+ */
+TEST_CASE("SparseOutputEncodingTest", "[StringEncodingTest]")
+{
+  SplitByAnyOf tokenizer(" ,.");
+
+  arma::mat denseOutput;
+  arma::sp_mat sparseOutput;
+  BagOfWordsEncoding<SplitByAnyOf::TokenType> bowEncoder;
+  bowEncoder.Encode(stringEncodingInput, denseOutput, tokenizer);
+  bowEncoder.Encode(stringEncodingInput, sparseOutput, tokenizer);
+
+  REQUIRE(sparseOutput.n_nonzero == arma::accu(denseOutput != 0));
+  CheckMatrices(denseOutput, arma::mat(sparseOutput));
+
+  TfIdfEncoding<SplitByAnyOf::TokenType> tfIdfEncoder;
+  tfIdfEncoder.Encode(stringEncodingInput, denseOutput, tokenizer);
+  tfIdfEncoder.Encode(stringEncodingInput, sparseOutput, tokenizer);
+
+  REQUIRE(sparseOutput.n_nonzero == arma::accu(denseOutput != 0));
+  CheckMatrices(denseOutput, arma::mat(sparseOutput));
+}
+
+/**
+ * Test that the tokens of a larger corpus are labeled in the order of their
+ * first occurrence, whichever thread tokenized them.
+ */
+TEST_CASE("LargeCorpusEncodingLabelsTest", "[StringEncodingTest]")
+{
+  vector<string> input;
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    input.push_back("word" + to_string(i % 37) + " word" +
+        to_string(i / 3) + " word" + to_string((i * 7) % 101));
+  }
+
+  // Compute the expected labels serially.
+  std::unordered_map<string, size_t> expected;
+  for (const string& line : input)
+  {
+    std::istringstream stream(line);
+    string word;
+    while (stream >> word)
+    {
+      if (expected.count(word) == 0)
+      {
+        const size_t label = expected.size() + 1;
+        expected[word] = label;
+      }
+    }
+  }
+
+  arma::sp_mat output;
+  BagOfWordsEncoding<SplitByAnyOf::TokenType> encoder;
+  encoder.Encode(input, output, SplitByAnyOf(" "));
+
+  REQUIRE(encoder.Dictionary().Size() == expected.size());
+  for (const std::pair<const string, size_t>& word : expected)
+    REQUIRE(encoder.Dictionary().Value(word.first) == word.second);
+
+  REQUIRE(output.n_rows == expected.size());
+  REQUIRE(output.n_cols == input.size());
+  REQUIRE(arma::accu(output) == Approx(3 * input.size()));
+}
+
+/**
+ * Test the bag of words encoding with a hashing dictionary.
+ */
+TEST_CASE("HashingBagOfWordsEncodingTest", "[StringEncodingTest]")
+{
+  HashingBagOfWordsEncoding<SplitByAnyOf::TokenType> encoder;
+  encoder.Dictionary().NumFeatures() = 16;
+  SplitByAnyOf tokenizer(" ,.");
+
+  arma::sp_mat output;
+  encoder.Encode(stringEncodingInput, output, tokenizer);
+
+  REQUIRE(output.n_rows == 16);
+  REQUIRE(output.n_cols == stringEncodingInput.size());
+
+  // Each token is counted in the row given by its hash.
+  for (size_t i = 0; i < stringEncodingInput.size(); ++i)
+  {
+    arma::vec expected(16, arma::fill::zeros);
+    boost::string_view line(stringEncodingInput[i]);
+    boost::string_view token = tokenizer(line);
+    while (!tokenizer.IsTokenEmpty(token))
+    {
+      expected[encoder.Dictionary().Value(token) - 1] += 1;
+      token = tokenizer(line);
+    }
+
+    CheckMatrices(arma::mat(output.col(i)), arma::mat(expected));
+  }
+
+  // Nothing is stored in the dictionary.
+  REQUIRE(encoder.Dictionary().Size() == 16);
+}
@@ -88,3 +88,47 @@ TEST_CASE("BatchUpdate", "[SumTreeTest]")
   CHECK(sumtree.FindPrefixSum(2.8) <= 3);
   CHECK(sumtree.FindPrefixSum(3.0) <= 3);
 }
+
+/**
+ * Test that a batch update of some of the elements gives the same sums as
+ * setting them one at a time.
+ */
+TEST_CASE("PartialBatchUpdate", "[SumTreeTest]")
+{
+  SumTree<double> batchTree(16), setTree(16);
+  for (size_t i = 0; i < 16; ++i)
+  {
+    batchTree.Set(i, 1.0 + i);
+    setTree.Set(i, 1.0 + i);
+  }
+
+  arma::ucolvec indices = {3, 4, 11, 3, 15};
+  arma::colvec data = {0.5, 2.0, 7.0, 0.25, 0.0};
+  batchTree.BatchUpdate(indices, data);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+    setTree.Set(indices[i], data[i]);
+
+  REQUIRE(batchTree.Total() == Approx(setTree.Total()));
+  REQUIRE(batchTree.Total() == Approx(batchTree.Sum()));
+  for (size_t i = 0; i < 16; ++i)
+    REQUIRE(batchTree.Sum(0, i + 1) == Approx(setTree.Sum(0, i + 1)));
+}
+
+/**
+ * Test that searching for several masses at once gives the same indices as
+ * searching for each of them.
+ */
+TEST_CASE("FindPrefixSums", "[SumTreeTest]")
+{
+  SumTree<double> sumtree(32);
+  for (size_t i = 0; i < 32; ++i)
+    sumtree.Set(i, (i % 3 == 0) ? 0.0 : 1.0 + (i % 5));
+
+  arma::colvec masses = arma::randu<arma::colvec>(100) * sumtree.Total();
+  arma::ucolvec indices;
+  sumtree.FindPrefixSums(masses, indices);
+
+  REQUIRE(indices.n_elem == masses.n_elem);
+  for (size_t i = 0; i < masses.n_elem; ++i)
+    REQUIRE(indices[i] == sumtree.FindPrefixSum(masses[i]));
+}
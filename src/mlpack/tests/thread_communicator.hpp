@@ -0,0 +1,100 @@
+/**
+ * @file tests/thread_communicator.hpp
+ *
+ * A communicator between threads, to test distributed code without MPI.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_TESTS_THREAD_COMMUNICATOR_HPP
+#define MLPACK_TESTS_THREAD_COMMUNICATOR_HPP
+
+#include <mlpack/core.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+/**
+ * A communicator between threads of one process, to test the distributed code
+ * (such as ann::DataParallel) without MPI.  Each thread has its own
+ * ThreadCommunicator, and all of them share the mailboxes of a
+ * ThreadCommunicator::Mailboxes object.
+ */
+class ThreadCommunicator
+{
+ public:
+  //! The messages between the threads.
+  struct Mailboxes
+  {
+    Mailboxes(const size_t size) : size(size), messages(size * size) { }
+
+    size_t size;
+    std::mutex mutex;
+    std::condition_variable condition;
+    //! The messages from thread i to thread j are in messages[i * size + j].
+    std::vector<std::deque<std::vector<char>>> messages;
+  };
+
+  ThreadCommunicator(Mailboxes& mailboxes, const size_t rank) :
+      mailboxes(mailboxes), rank(rank) { }
+
+  size_t Rank() const { return rank; }
+
+  size_t Size() const { return mailboxes.size; }
+
+  void SendReceive(const void* send,
+                   const size_t sendBytes,
+                   const size_t destination,
+                   void* receive,
+                   const size_t receiveBytes,
+                   const size_t source)
+  {
+    Send(send, sendBytes, destination);
+    Receive(receive, receiveBytes, source);
+  }
+
+  void Broadcast(void* data, const size_t bytes, const size_t root)
+  {
+    if (rank == root)
+    {
+      for (size_t i = 0; i < mailboxes.size; ++i)
+        if (i != root)
+          Send(data, bytes, i);
+    }
+    else
+    {
+      Receive(data, bytes, root);
+    }
+  }
+
+ private:
+  void Send(const void* data, const size_t bytes, const size_t destination)
+  {
+    const char* begin = (const char*) data;
+    {
+      std::lock_guard<std::mutex> lock(mailboxes.mutex);
+      mailboxes.messages[rank * mailboxes.size + destination].emplace_back(
+          begin, begin + bytes);
+    }
+    mailboxes.condition.notify_all();
+  }
+
+  void Receive(void* data, const size_t bytes, const size_t source)
+  {
+    std::unique_lock<std::mutex> lock(mailboxes.mutex);
+    std::deque<std::vector<char>>& queue =
+        mailboxes.messages[source * mailboxes.size + rank];
+    mailboxes.condition.wait(lock, [&queue]() { return !queue.empty(); });
+    std::memcpy(data, queue.front().data(),
+        std::min(bytes, queue.front().size()));
+    queue.pop_front();
+  }
+
+  Mailboxes& mailboxes;
+  size_t rank;
+};
+
+#endif
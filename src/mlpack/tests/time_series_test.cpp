@@ -0,0 +1,142 @@
+/**
+ * @file tests/time_series_test.cpp
+ *
+ * Tests for the time series models.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/methods/time_series/seasonal_naive.hpp>
+
+#include "catch.hpp"
+#include "serialization.hpp"
+
+using namespace mlpack;
+using namespace mlpack::ts;
+
+/**
+ * Make sure that Predict() forecasts each value by the value one season
+ * earlier, and that the first season has no forecast.
+ */
+TEST_CASE("PersistenceModelPredictTest", "[TimeSeriesTest]")
+{
+  arma::rowvec series("1 2 3 4 5 6 7");
+
+  // The default season gives the persistence forecast.
+  PersistenceModel persistence;
+  arma::rowvec predictions;
+  persistence.Predict(series, predictions);
+  REQUIRE(predictions.n_elem == series.n_elem);
+  REQUIRE(std::isnan(predictions[0]));
+  for (size_t i = 1; i < series.n_elem; ++i)
+    REQUIRE(predictions[i] == series[i - 1]);
+
+  PersistenceModel model(3);
+  model.Predict(series, predictions);
+  for (size_t i = 0; i < 3; ++i)
+    REQUIRE(std::isnan(predictions[i]));
+  for (size_t i = 3; i < series.n_elem; ++i)
+    REQUIRE(predictions[i] == series[i - 3]);
+
+  // The forecasts of a test set continue the training set.
+  arma::rowvec train = series.head(5);
+  arma::rowvec test = series.tail(2);
+  model.Predict(train, test, predictions);
+  REQUIRE(predictions.n_elem == 2);
+  REQUIRE(predictions[0] == series[2]);
+  REQUIRE(predictions[1] == series[3]);
+
+  // The last column of a matrix is the series.
+  arma::mat dataset(series.n_elem, 2, arma::fill::randu);
+  dataset.col(1) = series.t();
+  model.Predict(dataset, predictions);
+  for (size_t i = 3; i < series.n_elem; ++i)
+    REQUIRE(predictions[i] == series[i - 3]);
+
+  REQUIRE_THROWS_AS(PersistenceModel(0), std::invalid_argument);
+}
+
+/**
+ * Make sure that the batched forecasts are the same for one series per column
+ * and one series per row, and match Predict() on each series.
+ */
+TEST_CASE("PersistenceModelBatchTest", "[TimeSeriesTest]")
+{
+  arma::mat series(20, 5, arma::fill::randu);
+  PersistenceModel model(4);
+
+  arma::mat predictions, rowPredictions;
+  model.PredictBatch(series, predictions);
+  model.PredictBatch(arma::mat(series.t()), rowPredictions, true);
+  REQUIRE(predictions.n_rows == 20);
+  REQUIRE(predictions.n_cols == 5);
+  REQUIRE(rowPredictions.n_rows == 5);
+  REQUIRE(rowPredictions.n_cols == 20);
+
+  for (size_t s = 0; s < series.n_cols; ++s)
+  {
+    arma::colvec single;
+    model.Predict(arma::colvec(series.col(s)), single);
+    for (size_t t = 0; t < 4; ++t)
+    {
+      REQUIRE(std::isnan(predictions(t, s)));
+      REQUIRE(std::isnan(rowPredictions(s, t)));
+    }
+    for (size_t t = 4; t < series.n_rows; ++t)
+    {
+      REQUIRE(predictions(t, s) == single[t]);
+      REQUIRE(rowPredictions(s, t) == single[t]);
+    }
+  }
+
+  // The forecasts repeat the last season.
+  arma::mat forecasts, rowForecasts;
+  model.ForecastBatch(series, 10, forecasts);
+  model.ForecastBatch(arma::mat(series.t()), 10, rowForecasts, true);
+  REQUIRE(forecasts.n_rows == 10);
+  REQUIRE(forecasts.n_cols == 5);
+  REQUIRE(arma::approx_equal(forecasts, rowForecasts.t(), "absdiff", 0.0));
+  for (size_t k = 0; k < 10; ++k)
+    for (size_t s = 0; s < series.n_cols; ++s)
+      REQUIRE(forecasts(k, s) == series(16 + k % 4, s));
+
+  REQUIRE_THROWS_AS(model.ForecastBatch(series.rows(0, 2), 1, forecasts),
+      std::invalid_argument);
+}
+
+/**
+ * Make sure that the streaming forecasts match the batched forecasts of the
+ * whole series, whatever the size of the updates, and survive serialization.
+ */
+TEST_CASE("PersistenceModelStreamingTest", "[TimeSeriesTest]")
+{
+  arma::mat series(23, 3, arma::fill::randu);
+  PersistenceModel model(5);
+
+  arma::mat forecasts;
+  REQUIRE_THROWS_AS(model.Forecast(1, forecasts), std::invalid_argument);
+
+  model.Update(series.rows(0, 11));
+  model.Update(series.row(12));
+  model.Update(series.rows(13, 22));
+  REQUIRE(model.NumSeries() == 3);
+  REQUIRE(model.NumObservations() == 23);
+  REQUIRE_THROWS_AS(model.Update(arma::mat(1, 2)), std::invalid_argument);
+
+  arma::mat batchForecasts;
+  model.ForecastBatch(series, 7, batchForecasts);
+  model.Forecast(7, forecasts);
+  REQUIRE(arma::approx_equal(forecasts, batchForecasts, "absdiff", 0.0));
+
+  PersistenceModel xmlModel, jsonModel, binaryModel;
+  SerializeObjectAll(model, xmlModel, jsonModel, binaryModel);
+
+  arma::mat xmlForecasts, jsonForecasts, binaryForecasts;
+  xmlModel.Forecast(7, xmlForecasts);
+  jsonModel.Forecast(7, jsonForecasts);
+  binaryModel.Forecast(7, binaryForecasts);
+  CheckMatrices(forecasts, xmlForecasts, jsonForecasts, binaryForecasts);
+}
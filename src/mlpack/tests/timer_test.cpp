@@ -143,3 +143,168 @@ TEST_CASE("DisabledTimingTest", "[TimerTest]")
 
   REQUIRE(Timer::Get("test_timer") == std::chrono::microseconds(0));
 }
+
+/**
+ * Test that the hardware counters of a timer are collected when they are
+ * available, and are all zero otherwise.
+ */
+TEST_CASE("TimerCountersTest", "[TimerTest]")
+{
+  Timer::ResetAll();
+  Timer::EnableTiming();
+  Timer::Start("counter_timer");
+  volatile double sum = 0.0;
+  for (size_t i = 0; i < 1000000; ++i)
+    sum = sum + std::sqrt((double) i);
+  Timer::Stop("counter_timer");
+
+  const PerfCounterValues values = Timer::GetCounters("counter_timer");
+  if (PerfCounters::Available())
+  {
+    REQUIRE(values.cycles > 0);
+    REQUIRE(values.instructions > 1000000);
+    REQUIRE(values.IPC() > 0.0);
+    REQUIRE(IO::GetSingleton().timer.GetAllCounters().count("counter_timer")
+        == 1);
+  }
+  else
+  {
+    REQUIRE(values.cycles == 0);
+    REQUIRE(values.instructions == 0);
+    REQUIRE(values.llcMisses == 0);
+    REQUIRE(values.branchMisses == 0);
+    REQUIRE(IO::GetSingleton().timer.GetAllCounters().empty());
+  }
+
+  Timer::ResetAll();
+  Timer::DisableTiming();
+}
+
+/**
+ * Test that the timers are written as JSON, with their hardware counters when
+ * they are collected.
+ */
+TEST_CASE("TimerWriteJSONTest", "[TimerTest]")
+{
+  Timer::ResetAll();
+  Timer::EnableTiming();
+  Timer::Start("json_timer");
+  Timer::Stop("json_timer");
+  Timer::Start("json_\"quoted\"_timer");
+  Timer::Stop("json_\"quoted\"_timer");
+
+  std::ostringstream stream;
+  IO::GetSingleton().timer.WriteJSON(stream);
+  const std::string json = stream.str();
+
+  REQUIRE(json.front() == '{');
+  REQUIRE(json.find("\"json_timer\": { \"seconds\": 0.") !=
+      std::string::npos);
+  REQUIRE(json.find("\"json_\\\"quoted\\\"_timer\"") != std::string::npos);
+  REQUIRE((json.find("\"cycles\"") != std::string::npos) ==
+      PerfCounters::Available());
+
+  Timer::ResetAll();
+  std::ostringstream emptyStream;
+  IO::GetSingleton().timer.WriteJSON(emptyStream);
+  REQUIRE(emptyStream.str() == "{}\n");
+
+  Timer::DisableTiming();
+}
+
+/**
+ * Test that the memory statistics of a timer count the allocations made while
+ * it runs, when memory tracking is compiled in.
+ */
+TEST_CASE("TimerMemoryTest", "[TimerTest]")
+{
+  Timer::ResetAll();
+  Timer::EnableTiming();
+  Timer::Start("memory_timer_outer");
+  Timer::Start("memory_timer");
+  {
+    arma::mat data(1000, 100, arma::fill::ones);
+    REQUIRE(arma::accu(data) == 100000.0);
+  }
+  Timer::Stop("memory_timer");
+  Timer::Stop("memory_timer_outer");
+
+  const MemoryStats stats = Timer::GetMemory("memory_timer");
+  const MemoryStats outerStats = Timer::GetMemory("memory_timer_outer");
+  if (MemoryTracker::Enabled())
+  {
+    REQUIRE(stats.allocations >= 1);
+    REQUIRE(stats.allocatedBytes >= 800000);
+    REQUIRE(stats.peakBytes >= 800000);
+    REQUIRE(outerStats.peakBytes >= stats.peakBytes);
+    REQUIRE(outerStats.allocations >= stats.allocations);
+  }
+  else
+  {
+    REQUIRE(stats.allocations == 0);
+    REQUIRE(stats.peakBytes == 0);
+    REQUIRE(IO::GetSingleton().timer.GetAllMemory().empty());
+  }
+
+  Timer::ResetAll();
+  Timer::DisableTiming();
+}
+
+/**
+ * Test that traced regions are only recorded while tracing is enabled, that
+ * nested regions and threads are counted separately, and that the trace can be
+ * exported.
+ */
+TEST_CASE("TraceScopeTest", "[TimerTest]")
+{
+  auto traced = []()
+  {
+    MLPACK_TRACE_SCOPE("trace_test_outer");
+    for (size_t i = 0; i < 3; ++i)
+    {
+      MLPACK_TRACE_SCOPE("trace_test_inner");
+      #ifdef _WIN32
+      Sleep(1);
+      #else
+      usleep(1000);
+      #endif
+    }
+  };
+
+  Trace::Reset();
+  traced();
+  REQUIRE(Trace::Totals().count("trace_test_outer") == 0);
+
+  Trace::Enable();
+  traced();
+  std::thread thread(traced);
+  thread.join();
+  Trace::Disable();
+
+  std::map<std::string, Trace::RegionTotal> totals = Trace::Totals();
+  REQUIRE(totals["trace_test_outer"].count == 2);
+  REQUIRE(totals["trace_test_inner"].count == 6);
+  REQUIRE(totals["trace_test_inner"].time >= std::chrono::milliseconds(6));
+  REQUIRE(totals["trace_test_outer"].time >= totals["trace_test_inner"].time);
+
+  size_t threadsWithRegions = 0;
+  for (auto& threadTotals : Trace::ThreadTotals())
+  {
+    if (threadTotals.count("trace_test_outer") > 0)
+    {
+      REQUIRE(threadTotals["trace_test_outer"].count == 1);
+      REQUIRE(threadTotals["trace_test_inner"].count == 3);
+      ++threadsWithRegions;
+    }
+  }
+  REQUIRE(threadsWithRegions == 2);
+
+  std::ostringstream stream;
+  Trace::ExportChromeTrace(stream);
+  const std::string trace = stream.str();
+  REQUIRE(trace.find("\"traceEvents\"") != std::string::npos);
+  REQUIRE(trace.find("\"name\":\"trace_test_inner\"") != std::string::npos);
+
+  Trace::Reset();
+  REQUIRE(Trace::Totals().empty());
+}
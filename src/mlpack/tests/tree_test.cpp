@@ -1040,6 +1040,123 @@ TEST_CASE("HRectBoundDiameter", "[TreeTest]")
   REQUIRE(d.Diameter() == Approx(0.0).margin(1e-5));
 }
 
+/**
+ * Ensure that a QuantizedHRectBound contains the points added to it, and that
+ * it is not much looser than an HRectBound.
+ */
+TEST_CASE("QuantizedHRectBoundOrOperatorPoint", "[TreeTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(10, 1000);
+
+  QuantizedHRectBound<EuclideanDistance> b(10);
+  QuantizedHRectBound<EuclideanDistance, double, uint8_t> c(10);
+  HRectBound<EuclideanDistance> exact(10);
+  b |= data;
+  c |= data;
+  exact |= data;
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    REQUIRE(b.Contains(data.col(i)));
+    REQUIRE(c.Contains(data.col(i)));
+  }
+
+  for (size_t d = 0; d < 10; ++d)
+  {
+    REQUIRE(b[d].Lo() <= exact[d].Lo());
+    REQUIRE(b[d].Hi() >= exact[d].Hi());
+    REQUIRE(c[d].Lo() <= exact[d].Lo());
+    REQUIRE(c[d].Hi() >= exact[d].Hi());
+    REQUIRE(b[d].Width() <= exact[d].Width() * (1.0 + 1e-4));
+    REQUIRE(c[d].Width() <= exact[d].Width() * (1.0 + 1e-2));
+  }
+}
+
+/**
+ * Ensure that distances computed with a QuantizedHRectBound quantized on the
+ * grid of another bound are valid bounds on the distances to its points.
+ */
+TEST_CASE("QuantizedHRectBoundDistances", "[TreeTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(5, 1000);
+
+  QuantizedHRectBound<EuclideanDistance, double, uint8_t> root(5);
+  root |= data;
+
+  QuantizedHRectBound<EuclideanDistance, double, uint8_t> b(5), c(5);
+  b.ShareGrid(root);
+  c.ShareGrid(root);
+  b |= data.cols(0, 49);
+  c |= data.cols(500, 549);
+  REQUIRE(b.GetGrid() == root.GetGrid());
+
+  HRectBound<EuclideanDistance> exactB(5), exactC(5);
+  exactB |= data.cols(0, 49);
+  exactC |= data.cols(500, 549);
+
+  for (size_t i = 0; i < 50; ++i)
+    REQUIRE(b.Contains(data.col(i)));
+
+  for (size_t i = 0; i < 20; ++i)
+  {
+    arma::vec point = 2.0 * arma::randu<arma::vec>(5) - 0.5;
+
+    REQUIRE(b.MinDistance(point) <= exactB.MinDistance(point) + 1e-10);
+    REQUIRE(b.MaxDistance(point) >= exactB.MaxDistance(point) - 1e-10);
+
+    const math::Range range = b.RangeDistance(point);
+    REQUIRE(range.Lo() == Approx(b.MinDistance(point)).epsilon(1e-10));
+    REQUIRE(range.Hi() == Approx(b.MaxDistance(point)).epsilon(1e-10));
+  }
+
+  REQUIRE(b.MinDistance(c) <= exactB.MinDistance(exactC) + 1e-10);
+  REQUIRE(b.MaxDistance(c) >= exactB.MaxDistance(exactC) - 1e-10);
+  const math::Range range = b.RangeDistance(c);
+  REQUIRE(range.Lo() == Approx(b.MinDistance(c)).epsilon(1e-10));
+  REQUIRE(range.Hi() == Approx(b.MaxDistance(c)).epsilon(1e-10));
+
+  // A point outside of the grid makes the bound unbounded in that direction.
+  arma::vec farPoint(5, arma::fill::zeros);
+  farPoint[2] = 10.0;
+  b |= farPoint;
+  REQUIRE(b.Contains(farPoint));
+  REQUIRE(b[2].Hi() == std::numeric_limits<double>::max());
+
+  // Merging bounds keeps the points of both.
+  b |= c;
+  for (size_t i = 500; i < 550; ++i)
+    REQUIRE(b.Contains(data.col(i)));
+}
+
+/**
+ * Ensure that the bound of each node of a QuantizedKDTree contains its points,
+ * and that all the bounds share the grid of the root.
+ */
+template<typename TreeType>
+void CheckQuantizedBounds(const TreeType& node, const TreeType& root)
+{
+  REQUIRE(node.Bound().GetGrid() == root.Bound().GetGrid());
+  for (size_t i = 0; i < node.NumDescendants(); ++i)
+    REQUIRE(node.Bound().Contains(node.Dataset().col(node.Descendant(i))));
+
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    CheckQuantizedBounds(node.Child(i), root);
+}
+
+TEST_CASE("QuantizedKDTreeBoundTest", "[TreeTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(20, 2000);
+  // Add a tight cluster, whose nodes are much smaller than a grid cell.
+  data.cols(0, 99) = 0.5 + 1e-8 * arma::randu<arma::mat>(20, 100);
+
+  typedef QuantizedKDTree<EuclideanDistance, EmptyStatistic, arma::mat>
+      TreeType;
+  TreeType tree(data, 5);
+
+  REQUIRE(tree.NumDescendants() == 2000);
+  CheckQuantizedBounds(tree, tree);
+}
+
 /**
  * It seems as though Bill has stumbled across a bug where
  * BinarySpaceTree<>::count() returns something different than
@@ -1954,6 +2071,41 @@ TEST_CASE("CoverTreeConstructionTest", "[TreeTest]")
   // implementation.
 }
 
+/**
+ * Create a cover tree large enough for its distances to be computed in
+ * parallel, and make sure it's accurate and the same as when built again.
+ */
+TEST_CASE("LargeCoverTreeConstructionTest", "[TreeTest]")
+{
+  arma::mat dataset;
+  dataset.randu(5, 10000);
+
+  typedef StandardCoverTree<EuclideanDistance, EmptyStatistic, arma::mat>
+      TreeType;
+  TreeType tree(dataset);
+
+  arma::vec counts;
+  counts.zeros(10000);
+  RecurseTreeCountLeaves(tree, counts);
+
+  for (size_t i = 0; i < 10000; ++i)
+    REQUIRE(counts[i] == 1);
+
+  CheckSelfChild<TreeType>(tree);
+  CheckCovering<TreeType, LMetric<2, true> >(tree);
+
+  // The construction does not depend on the number of threads.
+  TreeType other(dataset);
+  REQUIRE(other.NumChildren() == tree.NumChildren());
+  REQUIRE(other.DistanceComps() == tree.DistanceComps());
+  for (size_t i = 0; i < tree.NumChildren(); ++i)
+  {
+    REQUIRE(other.Child(i).Point() == tree.Child(i).Point());
+    REQUIRE(other.Child(i).NumDescendants() ==
+        tree.Child(i).NumDescendants());
+  }
+}
+
 /**
  * Create a cover tree on sparse data and make sure it's accurate.
  */
@@ -2172,6 +2324,219 @@ TEST_CASE("BinarySpaceTreeCopyConstructor", "[TreeTest]")
   delete &b.Right()->Dataset();
 }
 
+//! Check that two trees have the same structure, and that parent pointers are
+//! consistent.
+template<typename TreeType>
+void CheckSameStructure(const TreeType& a, const TreeType& b)
+{
+  REQUIRE(a.Begin() == b.Begin());
+  REQUIRE(a.Count() == b.Count());
+  REQUIRE(a.NumChildren() == b.NumChildren());
+  REQUIRE(a.ParentDistance() == Approx(b.ParentDistance()));
+  REQUIRE(a.FurthestDescendantDistance() ==
+      Approx(b.FurthestDescendantDistance()));
+  for (size_t d = 0; d < a.Bound().Dim(); ++d)
+  {
+    REQUIRE(a.Bound()[d].Lo() == Approx(b.Bound()[d].Lo()));
+    REQUIRE(a.Bound()[d].Hi() == Approx(b.Bound()[d].Hi()));
+  }
+
+  for (size_t i = 0; i < a.NumChildren(); ++i)
+  {
+    REQUIRE(a.Child(i).Parent() == &a);
+    REQUIRE(&a.Child(i).Dataset() == &a.Dataset());
+    CheckSameStructure(a.Child(i), b.Child(i));
+  }
+}
+
+/**
+ * Make sure that compacting the nodes of a tree does not change the tree, and
+ * that compacted trees can be copied, moved, and compacted again.
+ */
+TEST_CASE("BinarySpaceTreeCompactNodesTest", "[TreeTest]")
+{
+  arma::mat dataset(5, 1000);
+  dataset.randu();
+
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+  TreeType tree(dataset, 10);
+  TreeType original(tree);
+  REQUIRE(!tree.IsCompacted());
+
+  tree.CompactNodes(VAN_EMDE_BOAS_LAYOUT);
+  REQUIRE(tree.IsCompacted());
+  CheckSameStructure(tree, original);
+
+  // Compacting an already-compacted tree should work too.
+  tree.CompactNodes(BREADTH_FIRST_LAYOUT);
+  REQUIRE(tree.IsCompacted());
+  CheckSameStructure(tree, original);
+
+  // In a breadth-first layout, the children of the root come first.
+  REQUIRE(tree.Right() == tree.Left() + 1);
+
+  // Copies are not compacted.
+  TreeType copy(tree);
+  REQUIRE(!copy.IsCompacted());
+  CheckSameStructure(copy, original);
+
+  // Moving a compacted tree moves the arena.
+  TreeType moved(std::move(tree));
+  REQUIRE(moved.IsCompacted());
+  REQUIRE(!tree.IsCompacted());
+  CheckSameStructure(moved, original);
+
+  copy = std::move(moved);
+  REQUIRE(copy.IsCompacted());
+  CheckSameStructure(copy, original);
+
+  // Only the root can be compacted.
+  REQUIRE_THROWS_AS(copy.Left()->CompactNodes(), std::invalid_argument);
+}
+
+//! A node that counts how many times it was destroyed.
+struct CountedNode
+{
+  CountedNode(size_t& destroyed, const size_t value) :
+      destroyed(destroyed), value(value) { }
+  ~CountedNode() { ++destroyed; }
+
+  size_t& destroyed;
+  size_t value;
+};
+
+/**
+ * Make sure that a NodeArena creates its nodes in blocks and destroys every
+ * node with itself, and that a fixed arena cannot grow.
+ */
+TEST_CASE("NodeArenaTest", "[TreeTest]")
+{
+  size_t destroyed = 0;
+  {
+    NodeArena<CountedNode> arena(100);
+    std::vector<CountedNode*> nodes;
+    for (size_t i = 0; i < 250; ++i)
+      nodes.push_back(arena.Allocate(destroyed, i));
+
+    REQUIRE(arena.Size() == 250);
+    REQUIRE(!arena.Fixed());
+    for (size_t i = 0; i < 250; ++i)
+      REQUIRE(nodes[i]->value == i);
+
+    // Nodes of the same block are contiguous.
+    REQUIRE(nodes[99] == nodes[0] + 99);
+    REQUIRE(nodes[249] == nodes[200] + 49);
+    REQUIRE(destroyed == 0);
+  }
+  REQUIRE(destroyed == 250);
+
+  destroyed = 0;
+  {
+    NodeArena<CountedNode> arena(10, true);
+    for (size_t i = 0; i < 10; ++i)
+      arena.Allocate(destroyed, i);
+    REQUIRE_THROWS_AS(arena.Allocate(destroyed, 10), std::length_error);
+    REQUIRE(arena.Size() == 10);
+  }
+  REQUIRE(destroyed == 10);
+
+  REQUIRE_THROWS_AS(NodeArena<CountedNode>(0), std::invalid_argument);
+}
+
+/**
+ * Make sure that copies of subtrees (whose nodes are not held in an arena) and
+ * trees assigned to each other are freed correctly.
+ */
+TEST_CASE("BinarySpaceTreeArenaCopyTest", "[TreeTest]")
+{
+  arma::mat dataset(3, 500);
+  dataset.randu();
+
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+  TreeType tree(dataset, 5);
+  REQUIRE(tree.Left() != NULL);
+
+  // A copy of a subtree owns its nodes.
+  TreeType* subtree = new TreeType(*tree.Left());
+  REQUIRE(subtree->NumDescendants() == tree.Left()->NumDescendants());
+  REQUIRE(subtree->Left()->Parent() == subtree);
+  delete subtree;
+
+  TreeType other(dataset, 20);
+  other = tree;
+  CheckSameStructure(other, tree);
+  other = TreeType(dataset, 50);
+  REQUIRE(other.NumDescendants() == dataset.n_cols);
+}
+
+//! Check that the points of a tree built with a mapping are the given points.
+template<typename TreeType>
+void CheckMapping(const TreeType& tree,
+                  const arma::mat& dataset,
+                  const std::vector<size_t>& oldFromNew)
+{
+  REQUIRE(oldFromNew.size() == dataset.n_cols);
+  std::vector<bool> seen(dataset.n_cols, false);
+  for (size_t i = 0; i < oldFromNew.size(); ++i)
+  {
+    REQUIRE(!seen[oldFromNew[i]]);
+    seen[oldFromNew[i]] = true;
+    REQUIRE(arma::approx_equal(tree.Dataset().col(i),
+        dataset.col(oldFromNew[i]), "absdiff", 1e-12));
+  }
+}
+
+/**
+ * Build trees large enough that their subtrees are built in parallel, with
+ * each of the splitters, and make sure they are valid.  The trees with
+ * deterministic splitters must not depend on the number of threads.
+ */
+TEST_CASE("ParallelBinarySpaceTreeConstructionTest", "[TreeTest]")
+{
+  arma::mat dataset(4, 40000, arma::fill::randu);
+
+  std::vector<size_t> kdMapping, meanMapping, vpMapping, rpMapping;
+  KDTree<EuclideanDistance, EmptyStatistic, arma::mat> kdTree(dataset,
+      kdMapping);
+  MeanSplitKDTree<EuclideanDistance, EmptyStatistic, arma::mat> meanTree(
+      dataset, meanMapping);
+  VPTree<EuclideanDistance, EmptyStatistic, arma::mat> vpTree(dataset,
+      vpMapping);
+  RPTree<EuclideanDistance, EmptyStatistic, arma::mat> rpTree(dataset,
+      rpMapping);
+
+  CheckMapping(kdTree, dataset, kdMapping);
+  CheckMapping(meanTree, dataset, meanMapping);
+  CheckMapping(vpTree, dataset, vpMapping);
+  CheckMapping(rpTree, dataset, rpMapping);
+  REQUIRE(CheckPointBounds(kdTree));
+  REQUIRE(CheckPointBounds(meanTree));
+  REQUIRE(CheckPointBounds(vpTree));
+  REQUIRE(CheckPointBounds(rpTree));
+  CheckRPTreeSplit<RPTree<EuclideanDistance, EmptyStatistic, arma::mat>,
+      EuclideanDistance>(rpTree);
+
+  #ifdef HAS_OPENMP
+  const size_t numThreads = omp_get_max_threads();
+  omp_set_num_threads(1);
+  #endif
+
+  std::vector<size_t> kdSequentialMapping, meanSequentialMapping;
+  KDTree<EuclideanDistance, EmptyStatistic, arma::mat> kdSequentialTree(
+      dataset, kdSequentialMapping);
+  MeanSplitKDTree<EuclideanDistance, EmptyStatistic, arma::mat>
+      meanSequentialTree(dataset, meanSequentialMapping);
+
+  #ifdef HAS_OPENMP
+  omp_set_num_threads(numThreads);
+  #endif
+
+  CheckSameStructure(kdTree, kdSequentialTree);
+  CheckSameStructure(meanTree, meanSequentialTree);
+  REQUIRE(kdMapping == kdSequentialMapping);
+  REQUIRE(meanMapping == meanSequentialMapping);
+}
+
 //! Count the number of leaves under this node.
 template<typename TreeType>
 size_t NumLeaves(TreeType* node)
@@ -2287,3 +2652,68 @@ TEST_CASE("CoverTreeDescendantTest", "[TreeTest]")
   // using the recursive function above.
   CheckDescendants(&tree);
 }
+
+/**
+ * A rule set that only counts its Score() and BaseCase() calls, to test the
+ * traversal statistics.
+ */
+class CountingRules
+{
+ public:
+  CountingRules() : baseCases(0), scores(0) { }
+
+  size_t BaseCases() const { return baseCases; }
+  size_t Scores() const { return scores; }
+
+  size_t baseCases;
+  size_t scores;
+};
+
+/**
+ * Make sure that the traversal statistics attribute visits, prunes, scores and
+ * base cases to the right recursion level.
+ */
+TEST_CASE("TraversalStatisticsLevelTest", "[TreeTest]")
+{
+  CountingRules rules;
+  size_t numPrunes = 0;
+
+  // Simulate a root that scores its two children, prunes one and recurses
+  // into the other, which is a leaf.
+  auto traverse = [&]()
+  {
+    TraversalLevelGuard<CountingRules> root(rules, numPrunes);
+    rules.scores += 2;
+    ++numPrunes;
+    {
+      TraversalLevelGuard<CountingRules> leaf(rules, numPrunes);
+      rules.baseCases += 5;
+    }
+  };
+
+  // Nothing is collected while disabled.
+  TraversalStatistics::Reset();
+  TraversalStatistics::Disable();
+  traverse();
+  REQUIRE(TraversalStatistics::Levels().empty());
+
+  TraversalStatistics::Enable();
+  traverse();
+  traverse();
+  TraversalStatistics::Disable();
+
+  std::vector<TraversalStatistics::Level> levels =
+      TraversalStatistics::Levels();
+  REQUIRE(levels.size() == 2);
+  REQUIRE(levels[0].visits == 2);
+  REQUIRE(levels[0].prunes == 2);
+  REQUIRE(levels[0].scores == 4);
+  REQUIRE(levels[0].baseCases == 0);
+  REQUIRE(levels[1].visits == 2);
+  REQUIRE(levels[1].prunes == 0);
+  REQUIRE(levels[1].scores == 0);
+  REQUIRE(levels[1].baseCases == 10);
+
+  TraversalStatistics::Reset();
+  REQUIRE(TraversalStatistics::Levels().empty());
+}
@@ -13,6 +13,7 @@
 #include <mlpack/core/tree/bounds.hpp>
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
+#include <mlpack/core/data/space_filling_curve.hpp>
 
 #include "catch.hpp"
 
@@ -354,3 +355,45 @@ TEST_CASE("DualUBTreeTraverserTest", "[UBTreeTest]")
     REQUIRE(distances1[i] == distances2[i]);
   }
 }
+
+/**
+ * Make sure that points reordered along the Z-order and Hilbert curves are
+ * sorted by their addresses and Hilbert values, and that RestoreOrder() puts
+ * them back.
+ */
+TEST_CASE("SpaceFillingCurveOrderTest", "[UBTreeTest]")
+{
+  arma::mat dataset = arma::randn<arma::mat>(3, 500);
+  const arma::mat original = dataset;
+
+  arma::uvec order = data::ReorderPoints(dataset, data::Z_ORDER_CURVE);
+  REQUIRE(order.n_elem == original.n_cols);
+  for (size_t i = 1; i < dataset.n_cols; ++i)
+  {
+    arma::Col<uint64_t> addr1(3, arma::fill::zeros);
+    arma::Col<uint64_t> addr2(3, arma::fill::zeros);
+    addr::PointToAddress(addr1, dataset.col(i - 1));
+    addr::PointToAddress(addr2, dataset.col(i));
+    REQUIRE(addr::CompareAddresses(addr1, addr2) <= 0);
+  }
+
+  data::RestoreOrder(dataset, order);
+  REQUIRE(arma::approx_equal(dataset, original, "absdiff", 0.0));
+
+  order = data::ReorderPoints(dataset, data::HILBERT_CURVE);
+  for (size_t i = 1; i < dataset.n_cols; ++i)
+  {
+    REQUIRE(DiscreteHilbertValue<double>::ComparePoints(dataset.col(i - 1),
+        dataset.col(i)) <= 0);
+    REQUIRE(arma::approx_equal(dataset.col(i), original.col(order[i]),
+        "absdiff", 0.0));
+  }
+
+  // Results computed on the reordered points are mapped back too.
+  arma::Row<size_t> labels(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    labels[i] = order[i];
+  data::RestoreOrder(labels, order);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    REQUIRE(labels[i] == i);
+}
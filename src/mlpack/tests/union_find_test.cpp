@@ -10,6 +10,7 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include <mlpack/methods/emst/union_find.hpp>
+#include <mlpack/methods/emst/concurrent_union_find.hpp>
 
 #include <mlpack/core.hpp>
 #include "catch.hpp"
@@ -47,3 +48,66 @@ TEST_CASE("TestUnion", "[UnionFindTest]")
   REQUIRE(testUnionFind.Find(1) == testUnionFind.Find(5));
   REQUIRE(testUnionFind.Find(6) == testUnionFind.Find(3));
 }
+
+TEST_CASE("TestConcurrentUnionFind", "[UnionFindTest]")
+{
+  static const size_t testSize = 10;
+  ConcurrentUnionFind testUnionFind(testSize);
+
+  for (size_t i = 0; i < testSize; ++i)
+    REQUIRE(testUnionFind.Find(i) == i);
+
+  REQUIRE(testUnionFind.Union(0, 1) == true);
+  REQUIRE(testUnionFind.Union(2, 3) == true);
+  REQUIRE(testUnionFind.Union(0, 2) == true);
+  REQUIRE(testUnionFind.Union(5, 0) == true);
+  REQUIRE(testUnionFind.Union(0, 6) == true);
+  REQUIRE(testUnionFind.Union(3, 5) == false);
+
+  REQUIRE(testUnionFind.Find(0) == testUnionFind.Find(1));
+  REQUIRE(testUnionFind.Find(2) == testUnionFind.Find(3));
+  REQUIRE(testUnionFind.Find(1) == testUnionFind.Find(5));
+  REQUIRE(testUnionFind.Find(6) == testUnionFind.Find(3));
+  REQUIRE(testUnionFind.Find(4) == 4);
+}
+
+/**
+ * Unite many random pairs from several threads, and make sure the components
+ * are the same as with the sequential UnionFind.
+ */
+TEST_CASE("TestConcurrentUnionFindParallel", "[UnionFindTest]")
+{
+  static const size_t testSize = 10000;
+  arma::Mat<size_t> pairs = arma::randi<arma::Mat<size_t>>(2, 8000,
+      arma::distr_param(0, testSize - 1));
+
+  UnionFind unionFind(testSize);
+  ConcurrentUnionFind concurrentUnionFind(testSize);
+
+  size_t successes = 0;
+  #pragma omp parallel for reduction(+:successes)
+  for (omp_size_t i = 0; i < (omp_size_t) pairs.n_cols; ++i)
+  {
+    if (concurrentUnionFind.Union(pairs(0, i), pairs(1, i)))
+      ++successes;
+  }
+
+  size_t components = testSize;
+  for (size_t i = 0; i < pairs.n_cols; ++i)
+  {
+    if (unionFind.Find(pairs(0, i)) != unionFind.Find(pairs(1, i)))
+      --components;
+    unionFind.Union(pairs(0, i), pairs(1, i));
+  }
+
+  // Each successful union removes one component.
+  REQUIRE(testSize - successes == components);
+  for (size_t i = 0; i < testSize; ++i)
+  {
+    for (size_t j = i + 1; j < std::min(testSize, i + 20); ++j)
+    {
+      REQUIRE((unionFind.Find(i) == unionFind.Find(j)) ==
+          (concurrentUnionFind.Find(i) == concurrentUnionFind.Find(j)));
+    }
+  }
+}